@@ -27,7 +27,7 @@
 using namespace nvfuser;
 
 // Return reduction tensor view and output of reduction
-static void setupDivMaxSoftmaxDropoutForward(Fusion* fusion, DataType dtype) {
+void setupDivMaxSoftmaxDropoutForward(Fusion* fusion, DataType dtype) {
   FusionGuard fg(fusion);
 
   bool is_fp16 = dtype == DataType::Half;
@@ -169,7 +169,7 @@ static void NvFuserScheduler_DivMaxSoftDropBwd(
       bytes * int64_t(benchmark_state.iterations()));
 }
 
-static void setupBiasDropoutAddLayernormFwd(Fusion* fusion, DataType dtype) {
+void setupBiasDropoutAddLayernormFwd(Fusion* fusion, DataType dtype) {
   FusionGuard fg(fusion);
 
   bool is_fp16 = dtype == DataType::Half;
@@ -0,0 +1,56 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <codegen.h>
+#include <device_lower/lower2device.h>
+#include <fusion.h>
+#include <ops/all_ops.h>
+#include <options.h>
+#include <scheduler/all_schedulers.h>
+
+#include <benchmark/benchmark.h>
+
+#include <benchmarks/cpp/utils.h>
+#include <tests/cpp/utils.h>
+
+using namespace nvfuser;
+
+// Times only the generation of the kernel string of a lowered pointwise
+// fusion, without NVRTC. The first argument is the number of ops and the
+// second whether EnableOption::FastCodegen is set.
+static void NvFuserScheduler_Codegen(benchmark::State& benchmark_state) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  TensorView* tv1 = tv0;
+  for (int64_t i = 0; i < benchmark_state.range(0); ++i) {
+    tv1 = add(sin(tv1), tv0);
+  }
+  fusion.addOutput(tv1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({1024, 1024}, options);
+  SchedulerEntry::scheduleWith(&fusion, SchedulerType::PointWise, {t0});
+
+  GpuLower gpulw(&fusion);
+  kir::Kernel* kernel = gpulw.run();
+
+  EnableOptionsGuard enable_options_guard;
+  if (benchmark_state.range(1)) {
+    EnableOptionsGuard::getCurOptions().set(EnableOption::FastCodegen);
+  }
+
+  for (auto _ : benchmark_state) {
+    benchmark::DoNotOptimize(codegen::generateCudaKernel(kernel));
+  }
+}
+
+BENCHMARK(NvFuserScheduler_Codegen)
+    ->ArgsProduct({{64, 512, 2048}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,291 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <csrc/exceptions.h>
+#include <fusion.h>
+#include <instrumentation.h>
+#include <ir/all_nodes.h>
+#include <ops/all_ops.h>
+#include <options.h>
+#include <runtime/fusion_executor_cache.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cuda_runtime.h>
+
+#include <benchmarks/cpp/utils.h>
+#include <tests/cpp/utils.h>
+
+using namespace nvfuser;
+
+// Measures the time it takes to compile a fixed corpus of fusions from
+// scratch, broken down into segmentation, scheduling, lowering, code
+// generation, NVRTC and module loading, plus the total time of the first
+// runFusionWithInputs call. Like host_latency.cpp, each stage is the time
+// spent in the perf markers of the code that implements it, summed with
+// inst::TraceAggregator, and is reported as the manual time of its own
+// benchmark, so that tools/compare_benchmark.py tracks compile-time
+// regressions of each stage row by row.
+//
+// Every iteration compiles a new FusionExecutorCache with the kernel binary
+// cache disabled and the kernel database and the persistent kernel cache
+// unset. Segments are compiled serially, so the stages add up to wall time.
+
+namespace {
+
+struct CompileTimeCase {
+  std::unique_ptr<Fusion> fusion;
+  KernelArgumentHolder args;
+};
+
+using MakeCompileTimeCase = CompileTimeCase (*)();
+
+void CompileTime_Base(
+    benchmark::State& benchmark_state,
+    const std::vector<const char*>& markers,
+    MakeCompileTimeCase make_case) {
+  DisableOptionsGuard disable_options_guard;
+  DisableOptionsGuard::getCurOptions().set(DisableOption::ParallelCompile);
+  DisableOptionsGuard::getCurOptions().set(DisableOption::KernelBinaryCache);
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().unset(EnableOption::KernelDb);
+  EnableOptionsGuard::getCurOptions().unset(EnableOption::KernelCache);
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmul);
+
+  for (auto _ : benchmark_state) {
+    CompileTimeCase compile_time_case = make_case();
+    if (compile_time_case.fusion == nullptr) {
+      benchmark_state.SkipWithError("Unsupported arch");
+      return;
+    }
+    FusionExecutorCache executor_cache(std::move(compile_time_case.fusion));
+
+    inst::TraceAggregator aggregator;
+    executor_cache.runFusionWithInputs(compile_time_case.args);
+    double seconds = 0.0;
+    for (const char* marker : markers) {
+      seconds += aggregator.seconds(marker);
+    }
+    benchmark_state.SetIterationTime(seconds);
+  }
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaDeviceSynchronize());
+}
+
+at::TensorOptions optionsFor(DataType dtype) {
+  return at::TensorOptions().dtype(data_type_to_aten(dtype)).device(
+      at::kCUDA, 0);
+}
+
+//------------------------------------------------------------------------------
+
+CompileTimeCase bert_div_max_softmax_dropout_fwd() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  setupDivMaxSoftmaxDropoutForward(c.fusion.get(), DataType::Half);
+  auto options = optionsFor(DataType::Half);
+  c.args = {
+      at::randn({8, 1, 1, 128}, options),
+      at::randn({8, 16, 128, 128}, options)};
+  return c;
+}
+
+CompileTimeCase bert_bias_dropout_add_layernorm_fwd() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  setupBiasDropoutAddLayernormFwd(c.fusion.get(), DataType::Float);
+  auto options = optionsFor(DataType::Float);
+  c.args = {
+      at::randn({1024}, options),
+      at::randn({1024}, options),
+      at::randn({32, 128, 1024}, options),
+      at::randn({32, 128, 1024}, options),
+      at::randn({1024}, options)};
+  return c;
+}
+
+CompileTimeCase timm_vit_base_patch16_224_ln_bwd() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  setup_vit_base_patch16_224_LN_BWD(c.fusion.get(), nullptr);
+  auto fp16_options = optionsFor(DataType::Half);
+  auto fp32_options = optionsFor(DataType::Float);
+  c.args = {
+      at::randn({128, 197, 768}, fp16_options).to(at::kBool),
+      at::randn({128, 197, 768}, fp16_options),
+      at::randn({128, 197, 768}, fp16_options),
+      at::randn({128, 197, 1}, fp32_options),
+      at::randn({128, 197, 1}, fp32_options),
+      at::randn({768}, fp16_options),
+      at::randn({768}, fp16_options),
+      1.0};
+  return c;
+}
+
+CompileTimeCase timm_nhwc_seresnet152d_transpose65() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  nhwc_seresnet152d_transpose65(c.fusion.get(), nullptr);
+  auto options = optionsFor(DataType::Half);
+  const std::vector<int64_t> shape{32, 56, 56, 64};
+  c.args = {
+      at::randn(shape, options),
+      at::randn(shape, options),
+      at::randn(shape, options),
+      at::randn(shape, options),
+      at::randn({2}, options).sum()};
+  return c;
+}
+
+CompileTimeCase layer_norm_fwd() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  setupLayerNorm(c.fusion.get(), DataType::Half);
+  auto options = optionsFor(DataType::Half);
+  c.args = {
+      at::randn({2048, 1024}, options),
+      at::randn({1024}, options),
+      at::randn({1024}, options)};
+  return c;
+}
+
+CompileTimeCase layer_norm_bwd() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  setupLayerNorm_BWD(c.fusion.get(), DataType::Half);
+  auto options = optionsFor(DataType::Half);
+  auto fp32_options = optionsFor(DataType::Float);
+  c.args = {
+      at::randn({2048, 1024}, options),
+      at::randn({2048, 1024}, options),
+      at::randn({1024}, options),
+      at::randn({1024}, options),
+      at::randn({2048, 1}, fp32_options),
+      at::randn({2048, 1}, fp32_options)};
+  return c;
+}
+
+CompileTimeCase rms_norm_fwd() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  setupRMSNorm(c.fusion.get(), DataType::Half);
+  auto options = optionsFor(DataType::Half);
+  c.args = {at::randn({2048, 1024}, options), at::randn({1024}, options)};
+  return c;
+}
+
+// A matmul with a pointwise epilogue, fused by the matmul scheduler
+CompileTimeCase matmul_relu() {
+  if (!deviceMajorMinorCheck(8)) {
+    return {};
+  }
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  FusionGuard fg(c.fusion.get());
+  TensorView* a = makeContigTensor(2, DataType::Half);
+  TensorView* b = makeContigTensor(2, DataType::Half);
+  c.fusion->addInput(a);
+  c.fusion->addInput(b);
+  c.fusion->addOutput(relu(matmul(a, b)));
+  auto options = optionsFor(DataType::Half);
+  c.args = {at::randn({2048, 1024}, options), at::randn({1024, 4096}, options)};
+  return c;
+}
+
+// A pointwise fusion of thousands of expressions inlined into one loop nest,
+// which stresses the expression sorting of the lowering
+CompileTimeCase pointwise_chain() {
+  CompileTimeCase c{std::make_unique<Fusion>(), {}};
+  FusionGuard fg(c.fusion.get());
+  TensorView* a = makeContigTensor(2, DataType::Float);
+  TensorView* b = makeContigTensor(2, DataType::Float);
+  c.fusion->addInput(a);
+  c.fusion->addInput(b);
+  for ([[maybe_unused]] auto i : arange(1024)) {
+    TensorView* next = add(mul(b, IrBuilder::create<Val>(0.5)), a);
+    a = b;
+    b = next;
+  }
+  c.fusion->addOutput(b);
+  auto options = optionsFor(DataType::Float);
+  c.args = {at::randn({1024, 1024}, options), at::randn({1024, 1024}, options)};
+  return c;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+static void NvFuserScheduler_CompileTime_Segmentation(
+    benchmark::State& benchmark_state,
+    MakeCompileTimeCase make_case) {
+  CompileTime_Base(
+      benchmark_state,
+      {"SegmentCandidateFinder::SegmentCandidateFinder"},
+      make_case);
+}
+
+static void NvFuserScheduler_CompileTime_Scheduling(
+    benchmark::State& benchmark_state,
+    MakeCompileTimeCase make_case) {
+  CompileTime_Base(
+      benchmark_state,
+      {"FusionKernelRuntime::lowerKernel::schedule"},
+      make_case);
+}
+
+static void NvFuserScheduler_CompileTime_Lowering(
+    benchmark::State& benchmark_state,
+    MakeCompileTimeCase make_case) {
+  CompileTime_Base(
+      benchmark_state, {"GpuLower::lower", "GpuLower::run"}, make_case);
+}
+
+static void NvFuserScheduler_CompileTime_Codegen(
+    benchmark::State& benchmark_state,
+    MakeCompileTimeCase make_case) {
+  CompileTime_Base(benchmark_state, {"generateCudaKernel"}, make_case);
+}
+
+static void NvFuserScheduler_CompileTime_Nvrtc(
+    benchmark::State& benchmark_state,
+    MakeCompileTimeCase make_case) {
+  CompileTime_Base(
+      benchmark_state,
+      {"executor_utils::NvrtcCreateProgram",
+       "executor_utils::Nvrtc::CompileProgram"},
+      make_case);
+}
+
+static void NvFuserScheduler_CompileTime_ModuleLoad(
+    benchmark::State& benchmark_state,
+    MakeCompileTimeCase make_case) {
+  CompileTime_Base(
+      benchmark_state, {"executor_utils::Nvrtc::LoadPTX"}, make_case);
+}
+
+static void NvFuserScheduler_CompileTime_Total(
+    benchmark::State& benchmark_state,
+    MakeCompileTimeCase make_case) {
+  CompileTime_Base(
+      benchmark_state, {"FusionExecutorCache::runFusionWithInputs"}, make_case);
+}
+
+#define NVFUSER_COMPILE_TIME_BENCHMARK(STAGE, CASE)                    \
+  BENCHMARK_CAPTURE(NvFuserScheduler_CompileTime_##STAGE, CASE, CASE) \
+      ->UseManualTime()                                               \
+      ->Unit(benchmark::kMillisecond)
+
+#define NVFUSER_COMPILE_TIME_BENCHMARKS(CASE)         \
+  NVFUSER_COMPILE_TIME_BENCHMARK(Segmentation, CASE); \
+  NVFUSER_COMPILE_TIME_BENCHMARK(Scheduling, CASE);   \
+  NVFUSER_COMPILE_TIME_BENCHMARK(Lowering, CASE);     \
+  NVFUSER_COMPILE_TIME_BENCHMARK(Codegen, CASE);      \
+  NVFUSER_COMPILE_TIME_BENCHMARK(Nvrtc, CASE);        \
+  NVFUSER_COMPILE_TIME_BENCHMARK(ModuleLoad, CASE);   \
+  NVFUSER_COMPILE_TIME_BENCHMARK(Total, CASE)
+
+NVFUSER_COMPILE_TIME_BENCHMARKS(bert_div_max_softmax_dropout_fwd);
+NVFUSER_COMPILE_TIME_BENCHMARKS(bert_bias_dropout_add_layernorm_fwd);
+NVFUSER_COMPILE_TIME_BENCHMARKS(timm_vit_base_patch16_224_ln_bwd);
+NVFUSER_COMPILE_TIME_BENCHMARKS(timm_nhwc_seresnet152d_transpose65);
+NVFUSER_COMPILE_TIME_BENCHMARKS(layer_norm_fwd);
+NVFUSER_COMPILE_TIME_BENCHMARKS(layer_norm_bwd);
+NVFUSER_COMPILE_TIME_BENCHMARKS(rms_norm_fwd);
+NVFUSER_COMPILE_TIME_BENCHMARKS(matmul_relu);
+NVFUSER_COMPILE_TIME_BENCHMARKS(pointwise_chain);
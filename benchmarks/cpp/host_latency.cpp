@@ -0,0 +1,243 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <csrc/exceptions.h>
+#include <fusion.h>
+#include <instrumentation.h>
+#include <ir/all_nodes.h>
+#include <ops/all_ops.h>
+#include <runtime/fusion_executor_cache.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cuda_runtime.h>
+
+#include <benchmarks/cpp/utils.h>
+#include <tests/cpp/utils.h>
+
+#include <map>
+#include <memory>
+#include <tuple>
+
+using namespace nvfuser;
+
+// Breaks the host latency of FusionExecutorCache::runFusionWithInputs down
+// into stages. Each stage is the time spent in the perf markers of the code
+// that implements it, summed with inst::TraceAggregator, and is reported as
+// the manual time of its own benchmark, so that tools/compare_benchmark.py
+// compares the stages of two builds row by row. The total is reported as
+// well, so the time not attributed to any stage can be told apart.
+//
+// The fusions are chains of pointwise ops split into segments with
+// segment_set. The arguments of the benchmarks are the number of ops, the
+// number of segments and whether the launch parameter cache is enabled;
+// without the cache, every call infers the launch parameters and the output
+// shapes again, like the first call with new input shapes does.
+
+namespace {
+
+struct HostLatencyFusion {
+  std::unique_ptr<FusionExecutorCache> executor_cache;
+  KernelArgumentHolder inputs;
+};
+
+HostLatencyFusion& getHostLatencyFusion(
+    int64_t num_ops,
+    int64_t num_segments,
+    bool launch_param_cache) {
+  // Compiled once for all the stages
+  static std::map<std::tuple<int64_t, int64_t, bool>, HostLatencyFusion>
+      fusions;
+  auto [it, inserted] = fusions.try_emplace(
+      std::make_tuple(num_ops, num_segments, launch_param_cache));
+  HostLatencyFusion& entry = it->second;
+  if (!inserted) {
+    return entry;
+  }
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv = makeContigTensor(2);
+  fusion->addInput(tv);
+  const int64_t ops_per_segment = num_ops / num_segments;
+  for (auto i : arange(num_ops)) {
+    if (i > 0 && i % ops_per_segment == 0 &&
+        i / ops_per_segment < num_segments) {
+      tv = segment_set(tv);
+    }
+    tv = add(tv, IrBuilder::create<Val>(1.0));
+  }
+  fusion->addOutput(tv);
+
+  entry.executor_cache =
+      std::make_unique<FusionExecutorCache>(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  entry.inputs.push(at::randn({8, 32}, options));
+
+  entry.executor_cache->runFusionWithInputs(entry.inputs);
+  if (!launch_param_cache) {
+    entry.executor_cache->disableLaunchParamCache();
+  }
+  return entry;
+}
+
+void HostLatency_Base(
+    benchmark::State& benchmark_state,
+    const std::vector<const char*>& markers) {
+  HostLatencyFusion& fusion = getHostLatencyFusion(
+      benchmark_state.range(0),
+      benchmark_state.range(1),
+      benchmark_state.range(2) != 0);
+
+  for (auto _ : benchmark_state) {
+    inst::TraceAggregator aggregator;
+    fusion.executor_cache->runFusionWithInputs(fusion.inputs);
+    double seconds = 0.0;
+    for (const char* marker : markers) {
+      seconds += aggregator.seconds(marker);
+    }
+    benchmark_state.SetIterationTime(seconds);
+  }
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaDeviceSynchronize());
+}
+
+void setHostLatencyArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t launch_param_cache : {1, 0}) {
+    for (int64_t num_ops : {1, 10, 100, 1000}) {
+      for (int64_t num_segments : {1, 4}) {
+        if (num_segments <= num_ops) {
+          b->Args({num_ops, num_segments, launch_param_cache});
+        }
+      }
+    }
+  }
+  b->ArgNames({"ops", "segments", "launch_param_cache"});
+  b->UseManualTime();
+  b->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace
+
+// Looking up the id of the inputs' shapes and dtypes
+static void NvFuserScheduler_HostLatency_InputIdLookup(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(benchmark_state, {"FusionExecutorCache::setCacheId"});
+}
+
+// Selecting the segmented runtime compiled for the input id
+static void NvFuserScheduler_HostLatency_RuntimeSelection(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(
+      benchmark_state, {"FusionExecutorCache::getKernelRuntimeFor"});
+}
+
+// Gathering the arguments of each segment and the outputs it produces
+static void NvFuserScheduler_HostLatency_ArgumentPreparation(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(
+      benchmark_state,
+      {"ArgumentManager::translateValsToArgs",
+       "ArgumentManager::updateWithSegmentOutputs"});
+}
+
+// Evaluating the launch parameters and the output shapes, which is cached
+// per input id unless the launch parameter cache is disabled
+static void NvFuserScheduler_HostLatency_ShapeInference(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(
+      benchmark_state, {"KernelExecutor::initializeExecutorEntry"});
+}
+
+static void NvFuserScheduler_HostLatency_Allocation(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(
+      benchmark_state,
+      {"fusion_executor::allocations::allocateOutputs",
+       "KernelExecutor::runFusion::intermediates"});
+}
+
+// Encoding the kernel arguments into the launch buffer
+static void NvFuserScheduler_HostLatency_ArgumentPacking(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(
+      benchmark_state,
+      {"KernelExecutor::computeArgs", "KernelExecutor::copyArgsToTable"});
+}
+
+static void NvFuserScheduler_HostLatency_Launch(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(
+      benchmark_state, {"KernelExecutor::runFusion::execute_kernel"});
+}
+
+static void NvFuserScheduler_HostLatency_Total(
+    benchmark::State& benchmark_state) {
+  HostLatency_Base(
+      benchmark_state, {"FusionExecutorCache::runFusionWithInputs"});
+}
+
+BENCHMARK(NvFuserScheduler_HostLatency_InputIdLookup)
+    ->Apply(setHostLatencyArgs);
+BENCHMARK(NvFuserScheduler_HostLatency_RuntimeSelection)
+    ->Apply(setHostLatencyArgs);
+BENCHMARK(NvFuserScheduler_HostLatency_ArgumentPreparation)
+    ->Apply(setHostLatencyArgs);
+BENCHMARK(NvFuserScheduler_HostLatency_ShapeInference)
+    ->Apply(setHostLatencyArgs);
+BENCHMARK(NvFuserScheduler_HostLatency_Allocation)->Apply(setHostLatencyArgs);
+BENCHMARK(NvFuserScheduler_HostLatency_ArgumentPacking)
+    ->Apply(setHostLatencyArgs);
+BENCHMARK(NvFuserScheduler_HostLatency_Launch)->Apply(setHostLatencyArgs);
+BENCHMARK(NvFuserScheduler_HostLatency_Total)->Apply(setHostLatencyArgs);
+
+// Looking up the concretization info of a dynamic fusion for inputs of a new
+// shape. The fusion reshapes one input to sizes given by scalar inputs and
+// adds to another. With reshaped=0 only the other input changes shape, so
+// the info computed for the first inputs is reused; with reshaped=1 the
+// reshaped input changes shape too and the info is computed again.
+static void NvFuserScheduler_HostLatency_Concretization(
+    benchmark::State& benchmark_state) {
+  const bool reshaped = benchmark_state.range(0) != 0;
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  TensorView* tv1 = makeContigTensor(1);
+  Val* s0 = IrBuilder::create<Val>(DataType::Int);
+  Val* s1 = IrBuilder::create<Val>(DataType::Int);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addInput(s0);
+  fusion->addInput(s1);
+  TensorView* tv2 = reshape(tv0, {s0, s1});
+  fusion->addOutput(add(tv2, IrBuilder::create<Val>(1.0)));
+  fusion->addOutput(add(tv1, IrBuilder::create<Val>(1.0)));
+  FusionExecutorCache executor_cache(std::move(fusion));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  int64_t size = 128;
+  for (auto _ : benchmark_state) {
+    size += 128;
+    const int64_t rows = reshaped ? size : 128;
+    at::Tensor t0 = at::randn({rows, 64}, options);
+    at::Tensor t1 = at::randn({size}, options);
+    inst::TraceAggregator aggregator;
+    executor_cache.runFusionWithInputs({t0, t1, rows * 2, 32});
+    benchmark_state.SetIterationTime(
+        aggregator.seconds("FusionExecutorCache::getConcretizationInfo"));
+  }
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaDeviceSynchronize());
+}
+
+BENCHMARK(NvFuserScheduler_HostLatency_Concretization)
+    ->Arg(0)
+    ->Arg(1)
+    ->ArgName("reshaped")
+    ->Iterations(200)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
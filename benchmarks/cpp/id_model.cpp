@@ -0,0 +1,100 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <fusion.h>
+#include <id_model/id_model.h>
+#include <ir/all_nodes.h>
+#include <ops/all_ops.h>
+
+#include <benchmark/benchmark.h>
+#include <benchmarks/cpp/utils.h>
+#include <tests/cpp/utils.h>
+
+using namespace nvfuser;
+
+// Measures the construction of an IdModel with all of its graphs, dominated
+// by the merges of DisjointSets, on fusions shaped like those of test_rope
+// and test_resize. No kernel is compiled or run.
+
+namespace {
+
+// A chain of rotary embeddings as in test_rope: each layer slices the last
+// dimension in halves and concatenates them rotated.
+void setupRopeChain(Fusion* fusion, int64_t num_layers) {
+  FusionGuard fg(fusion);
+  const std::vector<int64_t> shape{1, 32, 4096, 128};
+  TensorView* x = makeContigConcreteTensor(shape, DataType::BFloat16);
+  TensorView* cos = makeContigConcreteTensor({4096, 128}, DataType::BFloat16);
+  TensorView* sin = makeContigConcreteTensor({4096, 128}, DataType::BFloat16);
+  fusion->addInput(x);
+  fusion->addInput(cos);
+  fusion->addInput(sin);
+
+  TensorView* y = castOp(DataType::Float, x);
+  TensorView* cos_b = broadcast(castOp(DataType::Float, cos), {true, true});
+  TensorView* sin_b = broadcast(castOp(DataType::Float, sin), {true, true});
+  for (int64_t i = 0; i < num_layers; ++i) {
+    TensorView* y1 = slice(y, {0, 0, 0, 0}, {1, 32, 4096, 64});
+    TensorView* y2 = slice(y, {0, 0, 0, 64}, {1, 32, 4096, 128});
+    TensorView* rotated = cat({neg(y2), y1}, -1);
+    y = add(mul(y, cos_b), mul(rotated, sin_b));
+  }
+  fusion->addOutput(castOp(DataType::BFloat16, y));
+}
+
+// A chain of pads and slices as in test_resize, each shifting the tensor by
+// one element along alternating dimensions
+void setupResizeChain(Fusion* fusion, int64_t num_layers) {
+  FusionGuard fg(fusion);
+  TensorView* x = makeContigConcreteTensor({1024, 1024});
+  fusion->addInput(x);
+
+  for (int64_t i = 0; i < num_layers; ++i) {
+    std::vector<Val*> pad_widths(4, fusion->zeroVal());
+    pad_widths.at(2 * (i % 2)) = fusion->oneVal();
+    TensorView* padded = pad(x, pad_widths);
+    x = add(
+        x,
+        i % 2 == 0 ? slice(padded, {0, 1}, {1024, 1025})
+                   : slice(padded, {1, 0}, {1025, 1024}));
+  }
+  fusion->addOutput(x);
+}
+
+void IdModel_Build(
+    benchmark::State& benchmark_state,
+    void (*setup)(Fusion*, int64_t)) {
+  Fusion fusion;
+  setup(&fusion, benchmark_state.range(0));
+  for (auto _ : benchmark_state) {
+    IdModel id_model(&fusion, /*build_graphs=*/true);
+    benchmark::DoNotOptimize(id_model);
+  }
+  benchmark_state.SetComplexityN(benchmark_state.range(0));
+}
+
+} // namespace
+
+static void NvFuserScheduler_IdModel_Rope(benchmark::State& benchmark_state) {
+  IdModel_Build(benchmark_state, setupRopeChain);
+}
+
+static void NvFuserScheduler_IdModel_Resize(benchmark::State& benchmark_state) {
+  IdModel_Build(benchmark_state, setupResizeChain);
+}
+
+BENCHMARK(NvFuserScheduler_IdModel_Rope)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+BENCHMARK(NvFuserScheduler_IdModel_Resize)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
@@ -0,0 +1,126 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <csrc/exceptions.h>
+#include <fusion.h>
+#include <ir/all_nodes.h>
+#include <ops/all_ops.h>
+#include <runtime/executor.h>
+#include <runtime/fusion_executor_cache.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cuda_runtime.h>
+
+#include <benchmarks/cpp/utils.h>
+#include <tests/cpp/utils.h>
+
+using namespace nvfuser;
+
+// Measures the host time per launch of a cached kernel with many tensor
+// arguments. Kernel launches are disabled, so the measurement is dominated by
+// preparing the launch, including encoding the kernel arguments. Two sets of
+// inputs with the same shapes are alternated so that data pointers change
+// between launches as they do in practice.
+static void KernelLaunchArgs_Base(
+    benchmark::State& benchmark_state,
+    bool disable_launch_param_cache) {
+  constexpr int64_t num_inputs = 16;
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* out = nullptr;
+  for (auto i : arange(num_inputs)) {
+    (void)i;
+    TensorView* in = makeContigTensor(3);
+    fusion->addInput(in);
+    out = out == nullptr ? in : add(out, in);
+  }
+  fusion->addOutput(out);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  std::vector<KernelArgumentHolder> input_sets(2);
+  for (auto& inputs : input_sets) {
+    for (auto i : arange(num_inputs)) {
+      (void)i;
+      inputs.push(at::randn({8, 32, 64}, options));
+    }
+  }
+
+  executor_cache.runFusionWithInputs(input_sets[0]);
+  executor_cache.disableKernelLaunch();
+  if (disable_launch_param_cache) {
+    executor_cache.disableLaunchParamCache();
+  }
+
+  int64_t iteration = 0;
+  for (auto _ : benchmark_state) {
+    executor_cache.runFusionWithInputs(input_sets[iteration++ % 2]);
+  }
+}
+
+static void NvFuserScheduler_KernelLaunchArgs(
+    benchmark::State& benchmark_state) {
+  KernelLaunchArgs_Base(benchmark_state, false);
+}
+
+static void NvFuserScheduler_KernelLaunchArgs_NoLaunchParamCacheBaseline(
+    benchmark::State& benchmark_state) {
+  KernelLaunchArgs_Base(benchmark_state, true);
+}
+
+BENCHMARK(NvFuserScheduler_KernelLaunchArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(NvFuserScheduler_KernelLaunchArgs_NoLaunchParamCacheBaseline)
+    ->Unit(benchmark::kMicrosecond);
+
+// Measures the host time per run of a fusion of two segments whose kernels
+// take so many arguments that they are passed in tables in device memory.
+// Kernels are launched without synchronizing between runs, so the host runs
+// ahead of the device as it does in practice, while the tables are staged in
+// pinned memory and copied on the stream.
+static void NvFuserScheduler_KernelArgTable(benchmark::State& benchmark_state) {
+  constexpr int64_t num_inputs = 400;
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* out = nullptr;
+  for (auto i : arange(num_inputs)) {
+    TensorView* in = makeContigTensor(1);
+    fusion->addInput(in);
+    out = out == nullptr ? in : add(out, in);
+    if (i == num_inputs / 2) {
+      out = segment_set(out);
+    }
+  }
+  fusion->addOutput(out);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  KernelArgumentHolder inputs;
+  for (auto i : arange(num_inputs)) {
+    (void)i;
+    inputs.push(at::randn({1024}, options));
+  }
+
+  executor_cache.runFusionWithInputs(inputs);
+  NVF_CHECK(
+      executor_cache.getMostRecentKernelRuntime()->isSegmented(),
+      "Expected a segmented fusion");
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaDeviceSynchronize());
+
+  for (auto _ : benchmark_state) {
+    executor_cache.runFusionWithInputs(inputs);
+  }
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaDeviceSynchronize());
+}
+
+BENCHMARK(NvFuserScheduler_KernelArgTable)->Unit(benchmark::kMicrosecond);
@@ -26,7 +26,7 @@ using namespace nvfuser;
 
 //------------------------------------------------------------------------------
 
-static void setupLayerNorm(Fusion* fusion, DataType dtype) {
+void setupLayerNorm(Fusion* fusion, DataType dtype) {
   NVF_ERROR(dtype == DataType::Float || dtype == DataType::Half);
 
   FusionGuard fg(fusion);
@@ -26,7 +26,7 @@ using namespace nvfuser;
 
 //------------------------------------------------------------------------------
 
-static void setupLayerNorm_BWD(Fusion* fusion, DataType dtype) {
+void setupLayerNorm_BWD(Fusion* fusion, DataType dtype) {
   FusionGuard fg(fusion);
 
   NVF_ERROR(dtype == DataType::Float || dtype == DataType::Half);
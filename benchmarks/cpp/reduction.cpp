@@ -10,8 +10,10 @@
 #include <ir/all_nodes.h>
 #include <ir/utils.h>
 #include <ops/arith.h>
+#include <options.h>
 #include <runtime/executor.h>
 #include <scheduler/all_schedulers.h>
+#include <scheduler/tools/inlining.h>
 
 #include <benchmark/benchmark.h>
 
@@ -365,3 +367,82 @@ BENCHMARK(Baseline_Reduction_Inner_fp16)
     ->Ranges({{128, 1024 * 16}, {128, 1024 * 16}})
     ->Unit(benchmark::kMicrosecond)
     ->UseManualTime();
+
+//------------------------------------------------------------------------------
+
+// Inner max reductions of int32 rows with a block of warps per row, so that
+// the reduction is a warp reduction. With use_redux, each warp reduces with a
+// single redux.sync on sm_80 and newer instead of a tree of shuffles.
+static void NvFuser_WarpReduction_Int32(
+    benchmark::State& benchmark_state,
+    bool use_redux) {
+  auto reduction_size = benchmark_state.range(0);
+  auto iter_size = benchmark_state.range(1);
+
+  DisableOptionsGuard options_guard;
+  if (!use_redux) {
+    DisableOptionsGuard::getCurOptions().set(DisableOption::ReduxSync);
+  }
+
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(2, DataType::Int32);
+  fusion.addInput(tv0);
+  TensorView* tv1 = max(tv0, {1});
+  fusion.addOutput(tv1);
+
+  // [I, R] -> [I, R / TIDx, TIDx]
+  tv1->split(1, 256);
+  TensorView* tv2 = tv1->rFactor({1});
+  for (TensorView* tv : {tv1, tv2}) {
+    tv->axis(0)->parallelize(ParallelType::BIDx);
+    tv->axis(-1)->parallelize(ParallelType::TIDx);
+    tv->axis(-1)->padToMultipleOfWarp();
+  }
+  inlineMost();
+
+  at::manual_seed(0);
+  auto options = at::TensorOptions().dtype(at::kInt).device(at::kCUDA, 0);
+  at::Tensor aten_input =
+      at::randint(-1000, 1000, {iter_size, reduction_size}, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {aten_input});
+
+  // Sync everything up before we start
+  clearL2Cache();
+  C10_CUDA_CHECK(cudaDeviceSynchronize());
+  for (auto _ : benchmark_state) {
+    CudaKernelTimer timer;
+    auto outputs = ke.run({aten_input});
+    benchmark_state.SetIterationTime(timer.elapsed() / 1000.0);
+    C10_CUDA_CHECK(cudaDeviceSynchronize());
+    clearL2Cache();
+    C10_CUDA_CHECK(cudaDeviceSynchronize());
+  }
+
+  benchmark_state.SetBytesProcessed(
+      int64_t(benchmark_state.iterations()) *
+      (iter_size * reduction_size + iter_size) * sizeof(int));
+}
+
+static void NvFuser_WarpReduction_Int32_Redux(
+    benchmark::State& benchmark_state) {
+  NvFuser_WarpReduction_Int32(benchmark_state, /*use_redux=*/true);
+}
+
+static void NvFuser_WarpReduction_Int32_Shuffle(
+    benchmark::State& benchmark_state) {
+  NvFuser_WarpReduction_Int32(benchmark_state, /*use_redux=*/false);
+}
+
+BENCHMARK(NvFuser_WarpReduction_Int32_Redux)
+    ->Ranges({{1024, 1024 * 64}, {1024, 1024 * 16}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+BENCHMARK(NvFuser_WarpReduction_Int32_Shuffle)
+    ->Ranges({{1024, 1024 * 64}, {1024, 1024 * 16}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
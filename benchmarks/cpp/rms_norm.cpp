@@ -26,7 +26,7 @@ using namespace nvfuser;
 
 //------------------------------------------------------------------------------
 
-static void setupRMSNorm(Fusion* fusion, DataType dtype) {
+void setupRMSNorm(Fusion* fusion, DataType dtype) {
   NVF_ERROR(
       dtype == DataType::Float || dtype == DataType::Half ||
       dtype == DataType::BFloat16);
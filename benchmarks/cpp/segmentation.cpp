@@ -0,0 +1,69 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <fusion.h>
+#include <fusion_segmenter.h>
+#include <ir/all_nodes.h>
+#include <ops/all_ops.h>
+#include <runtime/executor_kernel_arg.h>
+
+#include <benchmark/benchmark.h>
+#include <benchmarks/cpp/utils.h>
+#include <tests/cpp/utils.h>
+
+using namespace nvfuser;
+
+//------------------------------------------------------------------------------
+
+// A chain of blocks, each normalizing its input along both axes in turn. The
+// two reductions of a block can't be scheduled together, so the fusion is
+// segmented into about two segments per block and the segmenter considers
+// many merges.
+class NvFuserScheduler_SegmentationFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    fusion_ = std::make_unique<Fusion>();
+    FusionGuard fg(fusion_.get());
+
+    TensorView* x = makeContigTensor(2);
+    fusion_->addInput(x);
+
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      x = add(x, broadcast(sum(x, {0}), {true, false}));
+      x = add(x, broadcast(sum(x, {1}), {false, true}));
+    }
+
+    fusion_->addOutput(x);
+
+    auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+    args_ = KernelArgumentHolder({at::randn({1024, 1024}, options)});
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    fusion_.reset();
+    args_ = KernelArgumentHolder();
+  }
+
+  std::unique_ptr<Fusion> fusion_ = nullptr;
+  KernelArgumentHolder args_;
+};
+
+BENCHMARK_DEFINE_F(NvFuserScheduler_SegmentationFixture, Segmentation)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    std::unique_ptr<SegmentedFusion> segmented_fusion =
+        SegmentCandidateFinder::segment(fusion_.get(), args_);
+    benchmark::DoNotOptimize(segmented_fusion);
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_REGISTER_F(NvFuserScheduler_SegmentationFixture, Segmentation)
+    ->RangeMultiplier(2)
+    ->Range(1 << 2, 1 << 8)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
@@ -524,7 +524,7 @@ NVFUSER_BENCHMARK_RUN(
     ->Unit(benchmark::kMicrosecond)
     ->UseManualTime();
 
-static void setup_vit_base_patch16_224_LN_BWD(Fusion* fusion, void* null) {
+void setup_vit_base_patch16_224_LN_BWD(Fusion* fusion, void* null) {
   FusionGuard fg(fusion);
 
   auto t0 = makeContigTensor(3, DataType::Bool);
@@ -662,7 +662,7 @@ NVFUSER_BENCHMARK_RUN(NvFuserScheduler_TIMM_NCHW_vit_base_patch16_224_LN_BWD)
     ->Unit(benchmark::kMicrosecond)
     ->UseManualTime();
 
-static void nhwc_seresnet152d_transpose65(Fusion* fusion, void* null) {
+void nhwc_seresnet152d_transpose65(Fusion* fusion, void* null) {
   FusionGuard fg(fusion);
 
   auto t2 = makeContigTensor(4, DataType::Half);
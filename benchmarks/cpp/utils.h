@@ -223,3 +223,13 @@ FusionKernelRuntime* getLayerForwardNormRuntime(
     KernelArgumentHolder& args,
     const std::vector<int64_t>& shape,
     const std::vector<int64_t>& norm_shape);
+
+//! Fusions of the runtime benchmarks that are also compiled by the
+//! compile-time benchmark (compile_time.cpp)
+void setupDivMaxSoftmaxDropoutForward(Fusion* fusion, DataType dtype);
+void setupBiasDropoutAddLayernormFwd(Fusion* fusion, DataType dtype);
+void setupLayerNorm(Fusion* fusion, DataType dtype);
+void setupLayerNorm_BWD(Fusion* fusion, DataType dtype);
+void setupRMSNorm(Fusion* fusion, DataType dtype);
+void setup_vit_base_patch16_224_LN_BWD(Fusion* fusion, void* null);
+void nhwc_seresnet152d_transpose65(Fusion* fusion, void* null);
@@ -0,0 +1,213 @@
+# SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Measures the time from process start to the first results of the fusions of
+# a model layer, in fresh processes started three ways:
+#   cold:      every fusion is compiled from scratch.
+#   kernel_db: the kernels are loaded from a KernelDb written by a previous
+#              process (NVFUSER_ENABLE=kernel_db).
+#   serde:     the FusionCache is restored from a bundle serialized by a
+#              previous process (NVFUSER_FUSION_CACHE_BUNDLE).
+# Each run reports the time to the first results, the time spent importing
+# nvfuser, the peak host memory and the device memory in use, so that changes
+# to serde and KernelDb can be quantified.
+#
+# "python -m benchmarks.python.cold_start -h" for help.
+
+import argparse
+import json
+import math
+import os
+import resource
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+MODES = ["cold", "kernel_db", "serde"]
+
+
+# The fusions of a llama decoder layer sized by benchmarks/python/model_configs.py.
+# The intermediate size of the MLP follows the llama convention of 8/3 of the
+# hidden size rounded up to a multiple of 256.
+def model_fusions(model: str):
+    import torch
+    from nvfuser import FusionDefinition
+    from nvfuser.pytorch_utils import torch_dtype_to_nvfuser_dtype
+
+    from .model_configs import llama_hf_cfg
+    from .test_rmsnorm_bwd import rmsnorm_bwd_fusion
+    from .test_rmsnorm_fwd import rmsnorm_fwd_fusion
+    from .test_silu_mul_bwd import silu_mul_bwd_fusion
+    from .test_silu_mul_fwd import silu_mul_fwd_fusion
+    from .test_softmax_bwd import softmax_bwd_fusion
+    from .test_softmax_fwd import softmax_fwd_fusion
+
+    config = llama_hf_cfg(model)
+    tokens = config.batches * config.seq_length
+    hidden = config.n_head * config.head_size
+    intermediate = 256 * math.ceil(hidden * 8 / 3 / 256)
+    dtype = torch.bfloat16
+
+    def randn(*shape, dtype=dtype):
+        return torch.randn(*shape, device="cuda", dtype=dtype)
+
+    x = randn(tokens, hidden)
+    rms_eps = randn(tokens, 1, dtype=torch.float).abs() + 1.0
+    gate, up = randn(tokens, intermediate), randn(tokens, intermediate)
+    scores = randn(config.n_head * config.seq_length, config.seq_length)
+    fusions = [
+        (rmsnorm_fwd_fusion, [x, randn(hidden)]),
+        (rmsnorm_bwd_fusion, [x, rms_eps, randn(tokens, hidden), randn(hidden)]),
+        (silu_mul_fwd_fusion, [gate, up]),
+        (silu_mul_bwd_fusion, [randn(tokens, intermediate), gate, up]),
+        (lambda fd, dt: softmax_fwd_fusion(fd, dt, reduction_axis=1), [scores]),
+        (
+            lambda fd, dt: softmax_bwd_fusion(fd, dt, reduction_axis=1),
+            [scores, randn(*scores.shape)],
+        ),
+    ]
+
+    definitions = []
+    for fusion_fn, inputs in fusions:
+        with FusionDefinition() as fd:
+            fusion_fn(fd, torch_dtype_to_nvfuser_dtype(dtype))
+        definitions.append((fd, inputs))
+    return definitions
+
+
+# Runs in the measured process. `start` is the monotonic time at which the
+# parent started the process, which is system-wide on Linux.
+def worker(args) -> None:
+    import_start = time.monotonic()
+    import torch
+    import nvfuser
+
+    import_s = time.monotonic() - import_start
+
+    # The bundle is only loaded with the default workspace, which is otherwise
+    # skipped so that a workspace left by another process isn't used
+    nvfuser.FusionCache.get(load_from_default_workspace=args.mode == "serde")
+    for fd, inputs in model_fusions(args.model):
+        fd.execute(inputs)
+    torch.cuda.synchronize()
+    first_result_s = time.monotonic() - args.start
+
+    if args.serialize_bundle:
+        nvfuser.serialize_bundle(args.serialize_bundle)
+
+    # ru_maxrss is in kilobytes on Linux
+    peak_host_kb = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    free_bytes, total_bytes = torch.cuda.mem_get_info()
+    print(
+        json.dumps(
+            {
+                "time_to_first_result_s": first_result_s,
+                "import_s": import_s,
+                "peak_host_memory_mb": peak_host_kb / 1024,
+                "device_memory_used_mb": (total_bytes - free_bytes) / 2**20,
+            }
+        )
+    )
+
+
+def run_worker(
+    model: str, mode: str, env: dict, serialize_bundle: str | None = None
+) -> dict:
+    command = [
+        sys.executable,
+        "-m",
+        "benchmarks.python.cold_start",
+        "--worker",
+        mode,
+        "--model",
+        model,
+        "--start",
+        str(time.monotonic()),
+    ]
+    if serialize_bundle:
+        command += ["--serialize-bundle", serialize_bundle]
+    output = subprocess.run(
+        command, env=env, check=True, capture_output=True, text=True
+    ).stdout
+    # Warnings may be printed before the result, which is the last line
+    return json.loads(output.strip().splitlines()[-1])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measures the time to the first results of the fusions of a "
+        "model in fresh processes, compiled cold, loaded from KernelDb or "
+        "restored from a serialized FusionCache."
+    )
+    parser.add_argument("--model", default="llama_2_7b_hf")
+    parser.add_argument("--modes", nargs="+", choices=MODES, default=MODES)
+    parser.add_argument(
+        "--repeats",
+        type=int,
+        default=3,
+        help="Processes measured per mode, reporting the medians.",
+    )
+    parser.add_argument("--output", help="Writes the results to this JSON file.")
+    # Arguments of the measured processes
+    parser.add_argument("--worker", choices=MODES, help=argparse.SUPPRESS)
+    parser.add_argument("--start", type=float, help=argparse.SUPPRESS)
+    parser.add_argument("--serialize-bundle", help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.worker:
+        args.mode = args.worker
+        worker(args)
+        return
+
+    results = {}
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        env = dict(os.environ)
+        for name in ["NVFUSER_ENABLE", "NVFUSER_FUSION_CACHE_BUNDLE"]:
+            env.pop(name, None)
+        # KernelDb is kept in the temporary directory, which is isolated from
+        # the one of other processes this way
+        env["TMPDIR"] = tmp_dir
+        bundle_dir = os.path.join(tmp_dir, "bundle")
+        os.makedirs(bundle_dir)
+        mode_envs = {
+            "cold": env,
+            "kernel_db": {**env, "NVFUSER_ENABLE": "kernel_db"},
+            "serde": {**env, "NVFUSER_FUSION_CACHE_BUNDLE": bundle_dir},
+        }
+
+        for mode in args.modes:
+            # A first process writes the KernelDb or the bundle to start from
+            if mode == "kernel_db":
+                run_worker(args.model, "cold", mode_envs[mode])
+            elif mode == "serde":
+                run_worker(args.model, "cold", env, serialize_bundle=bundle_dir)
+
+            runs = [
+                run_worker(args.model, mode, mode_envs[mode])
+                for _ in range(args.repeats)
+            ]
+            results[mode] = {
+                key: statistics.median(run[key] for run in runs) for key in runs[0]
+            }
+
+    print(
+        f"{'Mode':<10} {'First result(s)':>16} {'Import(s)':>10} "
+        f"{'Host peak(MB)':>14} {'Device(MB)':>11}"
+    )
+    for mode, result in results.items():
+        print(
+            f"{mode:<10} {result['time_to_first_result_s']:16.3f} "
+            f"{result['import_s']:10.3f} {result['peak_host_memory_mb']:14.1f} "
+            f"{result['device_memory_used_mb']:11.1f}"
+        )
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"model": args.model, "results": results}, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
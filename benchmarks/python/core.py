@@ -187,6 +187,7 @@ def run_benchmark(
     iobytes: int = None,
     device: str = "cuda",
     fusion_fn: Callable = None,
+    enable_options: List[str] = [],
 ) -> Union[torch.Tensor, List]:
     """
     Benchmarks the target function using torchprofiler and stores metrics as extra information.
@@ -203,6 +204,8 @@ def run_benchmark(
             fusion_fn should only require FusionDefinition() as the input.
             Use functools.partial if fusion_fn accepts additional arguments.
             See test_many_pointwise_ops.py for example.
+        enable_options (Optional): NVFUSER_ENABLE options to execute the
+            fusion with if device = "host".
 
     Returns:
         outputs: Output of the target function
@@ -292,7 +295,7 @@ def run_benchmark(
             with FusionDefinition() as fd:
                 fusion_fn(fd)
             # Execute fd with the first inputs to avoid measuring first time overhead.
-            fd.execute(inputs[0])
+            fd.execute(inputs[0], _enable_options=enable_options)
             counter += 1
         return [inputs[counter % len(inputs)]], {"fd": fd}
 
@@ -303,7 +306,7 @@ def run_benchmark(
     def host_benchmark_fn(inputs, fd):
         # Set the fd variable used to query the profile object
         nvf_benchmark.set_fd(fd)
-        return fd.execute(inputs, profile=True)
+        return fd.execute(inputs, profile=True, _enable_options=enable_options)
 
     benchmark_fn = benchmark_fn if benchmark_fn is not None else host_benchmark_fn
     outputs = nvf_benchmark.pedantic(
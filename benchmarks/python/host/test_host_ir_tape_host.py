@@ -0,0 +1,46 @@
+# SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+import pytest
+from nvfuser import FusionDefinition
+from ..core import run_benchmark
+import torch
+from .test_many_segments_host import many_matmul_fusion
+
+
+# Compares the steady-state host latency of interpreting the host IR lowered
+# by FusionKernelRuntime with running its pre-resolved tape.
+@pytest.mark.parametrize("host_ir_executor", ["interpreter", "tape"])
+def test_host_ir_tape_benchmark(
+    benchmark,
+    host_ir_executor: str,
+    disable_validation: bool,
+    disable_benchmarking: bool,
+):
+    inputs = [torch.randn(5, 5, device="cuda", dtype=torch.float) for _ in range(2)]
+    enable_options = ["host_ir_lowering"]
+    if host_ir_executor == "tape":
+        enable_options.append("host_ir_tape")
+
+    if not disable_validation:
+        with FusionDefinition() as fd:
+            many_matmul_fusion(fd)
+        x, y = inputs
+        eager_output = x + y
+        for _ in range(5):
+            eager_transpose = eager_output.t()
+            matmul_out = torch.matmul(eager_transpose, y)
+            add_out = eager_transpose + y
+            eager_output = matmul_out + add_out
+        (nvf_output,) = fd.execute(inputs, _enable_options=enable_options)
+        torch.testing.assert_close(nvf_output, eager_output)
+
+    if not disable_benchmarking:
+        run_benchmark(
+            benchmark,
+            None,
+            inputs,
+            device="host:steady",
+            fusion_fn=many_matmul_fusion,
+            enable_options=enable_options,
+        )
@@ -0,0 +1,71 @@
+# SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+import pytest
+from nvfuser import FusionDefinition, DataType
+import torch
+
+
+def pointwise_fusion(fd: FusionDefinition) -> None:
+    x = fd.define_tensor(
+        shape=[-1, -1], contiguity=[True, True], dtype=DataType.Float, is_cpu=False
+    )
+    y = fd.define_tensor(
+        shape=[-1, -1], contiguity=[True, True], dtype=DataType.Float, is_cpu=False
+    )
+    fd.add_output(fd.ops.relu(fd.ops.add(x, y)))
+
+
+# The matmul is evaluated with ATen instead of a kernel
+def matmul_fusion(fd: FusionDefinition) -> None:
+    x = fd.define_tensor(
+        shape=[-1, -1], contiguity=[True, True], dtype=DataType.Float, is_cpu=False
+    )
+    y = fd.define_tensor(
+        shape=[-1, -1], contiguity=[True, True], dtype=DataType.Float, is_cpu=False
+    )
+    fd.add_output(fd.ops.relu(fd.ops.add(fd.ops.matmul(x, y), x)))
+
+
+# Measures the host latency of enqueuing many executions on a stream that is
+# kept busy, so that none of them completes while they are enqueued. Since
+# execute doesn't wait for the stream, the latency grows with the number of
+# executions rather than with the time it takes the device to run them.
+@pytest.mark.parametrize("fusion_fn", [pointwise_fusion, matmul_fusion])
+@pytest.mark.parametrize("num_in_flight", [1, 16, 64])
+def test_in_flight_fusions_benchmark(
+    benchmark,
+    fusion_fn,
+    num_in_flight: int,
+    disable_validation: bool,
+    disable_benchmarking: bool,
+):
+    inputs = [torch.randn(64, 64, device="cuda", dtype=torch.float) for _ in range(2)]
+
+    with FusionDefinition() as fd:
+        fusion_fn(fd)
+
+    if not disable_validation:
+        x, y = inputs
+        eager_output = torch.relu(x + y if fusion_fn is pointwise_fusion else x @ y + x)
+        fd.validate(inputs, [eager_output])
+
+    if disable_benchmarking:
+        return
+
+    stream = torch.cuda.Stream()
+
+    def setup():
+        stream.synchronize()
+        with torch.cuda.stream(stream):
+            torch.cuda._sleep(1 << 28)
+        return [], {}
+
+    def enqueue():
+        with torch.cuda.stream(stream):
+            for _ in range(num_in_flight):
+                fd.execute(inputs)
+        assert not stream.query(), "execute waited for the stream"
+
+    benchmark.pedantic(enqueue, setup=setup, rounds=10, warmup_rounds=1)
+    stream.synchronize()
@@ -0,0 +1,90 @@
+# SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+import pytest
+import nvfuser
+from nvfuser import DataType, FusionDefinition
+import torch
+
+
+class SequenceParallelAttention(FusionDefinition):
+    # q, k and v are [d, b, h, s/d, e] and sharded along the sequence. The key
+    # and the value are gathered before the attention, which the ring
+    # attention pass replaces by a ring of send/recv.
+    def __init__(self, b, h, s, e, num_devices):
+        super().__init__(use_multidevice_executor=True)
+        self._b = b
+        self._h = h
+        self._s = s
+        self._e = e
+        self._num_devices = num_devices
+
+    def definition(self) -> None:
+        b, h, s, e, d = self._b, self._h, self._s, self._e, self._num_devices
+        self.q, self.k, self.v = [
+            self.define_tensor(
+                shape=[d, b, h, s // d, e], contiguity=True, dtype=DataType.BFloat16
+            )
+            for _ in range(3)
+        ]
+        self.k_full = self.ops.set(self.k)
+        self.v_full = self.ops.set(self.v)
+        dropout_p = self.define_scalar(0.0, dtype=DataType.Double)
+        is_causal = self.define_scalar(False, dtype=DataType.Bool)
+        self.attn, self.log_sumexp, _, _ = self.ops.sdpfa_fwd(
+            self.q, self.k_full, self.v_full, dropout_p, is_causal, scale=None
+        )
+        self.add_output(self.attn)
+
+    def multidevice_schedule(self) -> None:
+        mesh = nvfuser.DeviceMesh(range(self._num_devices))
+        for tv in [self.q, self.k, self.v, self.k_full, self.v_full, self.attn]:
+            self.sched._set_device_mesh(tv, mesh)
+        for tv in [self.q, self.k, self.v, self.attn]:
+            self.sched.parallelize(tv, 0, nvfuser.ParallelType.mesh_x)
+
+
+# Compares gathering the whole key and value before the attention with
+# circulating their shards in a ring overlapped with partial attentions.
+@pytest.mark.mpi
+@pytest.mark.parametrize("ring_attention", [False, True], ids=["allgather", "ring"])
+def test_ring_attention_benchmark(
+    benchmark,
+    ring_attention: bool,
+    disable_validation: bool,
+    disable_benchmarking: bool,
+):
+    communicator = nvfuser.Communicator.instance()
+    d, rank = communicator.size(), communicator.rank()
+    if d < 2:
+        pytest.skip("Ring attention needs at least 2 ranks.")
+    b, h, s, e = 2, 16, 4096 * d, 128
+    enable_options = ["ring_attention"] if ring_attention else []
+
+    torch.cuda.set_device(communicator.local_rank())
+    torch.manual_seed(0)
+    mesh = nvfuser.DeviceMesh(range(d))
+    unsharded = [
+        torch.randn(d, b, h, s // d, e, dtype=torch.bfloat16) for _ in range(3)
+    ]
+    ins = [mesh.shard_tensor(t, 0, rank).cuda(rank) for t in unsharded]
+
+    nvfuser.FusionCache.reset()
+    fd = SequenceParallelAttention(b, h, s, e, d)
+    (attn,), _ = fd.execute(ins, _enable_options=enable_options)
+
+    if not disable_validation:
+        q, k, v = unsharded
+        # Attend the local query shard to the keys of all devices
+        k, v = [t.permute(1, 2, 0, 3, 4).reshape(b, h, s, e) for t in (k, v)]
+        expected = torch.nn.functional.scaled_dot_product_attention(
+            q[rank].cuda(rank), k.cuda(rank), v.cuda(rank)
+        )
+        torch.testing.assert_close(attn.squeeze(0), expected, rtol=1e-2, atol=1e-2)
+
+    if not disable_benchmarking:
+        benchmark.pedantic(
+            lambda: fd.execute(ins, _enable_options=enable_options),
+            rounds=10,
+            warmup_rounds=2,
+        )
@@ -0,0 +1,228 @@
+# SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Sweeps the inner size of a benchmark fusion and records, for each shape, the
+# kernel time and bandwidth together with what produced them: the scheduler
+# and the HeuristicParams of each segment, the number of segments, and the
+# registers and shared memory of each kernel. Adjacent shapes whose bandwidth
+# drops sharply are reported as heuristic cliffs, noting whether the
+# heuristics changed between them.
+#
+# "python -m benchmarks.python.shape_sweep -h" for help.
+
+import argparse
+from dataclasses import asdict, dataclass
+import functools
+import json
+import statistics
+from typing import Callable
+
+import torch
+from nvfuser import FusionDefinition
+from nvfuser.pytorch_utils import torch_dtype_to_nvfuser_dtype
+
+from .core import clear_l2_cache
+from .test_layernorm_fwd import layernorm_fwd_fusion
+from .test_reduction import reduction_fusion
+from .test_rmsnorm_fwd import rmsnorm_fwd_fusion
+from .test_softmax_fwd import softmax_fwd_fusion
+
+
+@dataclass
+class Sweep:
+    # Defines the fusion for a dtype
+    fusion_fn: Callable
+    # Makes the inputs of the fusion for a size and a dtype
+    inputs_fn: Callable
+
+
+def _randn(*shape, dtype: torch.dtype) -> torch.Tensor:
+    return torch.randn(*shape, device="cuda", dtype=dtype)
+
+
+SWEEPS = {
+    "layernorm_fwd": Sweep(
+        layernorm_fwd_fusion,
+        lambda size, dtype: [
+            _randn(size, dtype=dtype),
+            _randn(size[1], dtype=dtype),
+            _randn(size[1], dtype=dtype),
+        ],
+    ),
+    "rmsnorm_fwd": Sweep(
+        rmsnorm_fwd_fusion,
+        lambda size, dtype: [_randn(size, dtype=dtype), _randn(size[1], dtype=dtype)],
+    ),
+    "softmax_fwd": Sweep(
+        functools.partial(softmax_fwd_fusion, reduction_axis=1),
+        lambda size, dtype: [_randn(size, dtype=dtype)],
+    ),
+    "inner_reduction": Sweep(
+        functools.partial(reduction_fusion, reduction_axis=1),
+        lambda size, dtype: [_randn(size, dtype=dtype)],
+    ),
+    "outer_reduction": Sweep(
+        functools.partial(reduction_fusion, reduction_axis=0),
+        lambda size, dtype: [_randn(size, dtype=dtype)],
+    ),
+}
+
+
+@dataclass
+class SweepPoint:
+    size: list[int]
+    time_ms: float
+    bandwidth_gbs: float
+    num_segments: int
+    schedulers: list[str]
+    heuristic_params: list[str]
+    registers: list[int]
+    shared_mem: list[str]
+
+
+@dataclass
+class Cliff:
+    before: list[int]
+    after: list[int]
+    bandwidth_drop: float
+    heuristics_changed: bool
+
+
+def measure(sweep: Sweep, size: tuple, dtype: torch.dtype, rounds: int) -> SweepPoint:
+    inputs = sweep.inputs_fn(size, dtype)
+    with FusionDefinition() as fd:
+        sweep.fusion_fn(fd, torch_dtype_to_nvfuser_dtype(dtype))
+
+    # The first execution compiles the fusion
+    fd.execute(inputs)
+    times_ms = []
+    for _ in range(rounds):
+        clear_l2_cache()
+        fd.execute(inputs, profile=True)
+        profile = fd.profile()
+        times_ms.append(profile.kernel_time_ms)
+
+    kernels = profile.kernel_profiles
+    time_ms = statistics.median(times_ms)
+    iobytes = profile.input_bytes + profile.output_bytes
+    return SweepPoint(
+        size=list(size),
+        time_ms=time_ms,
+        bandwidth_gbs=iobytes / time_ms * 1e-6,
+        num_segments=profile.segments,
+        schedulers=[kp.scheduler for kp in kernels],
+        heuristic_params=[kp.heuristic_params for kp in kernels],
+        registers=[kp.registers for kp in kernels],
+        shared_mem=[kp.shared_mem_str for kp in kernels],
+    )
+
+
+# Adjacent points are cliffs when the bandwidth drops by more than `threshold`
+# of that of the smaller shape. A cliff with the same heuristics points at the
+# kernel rather than at the heuristic.
+def find_cliffs(points: list[SweepPoint], threshold: float) -> list[Cliff]:
+    cliffs = []
+    for before, after in zip(points, points[1:]):
+        drop = 1.0 - after.bandwidth_gbs / before.bandwidth_gbs
+        if drop <= threshold:
+            continue
+        cliffs.append(
+            Cliff(
+                before=before.size,
+                after=after.size,
+                bandwidth_drop=drop,
+                heuristics_changed=(
+                    before.schedulers != after.schedulers
+                    or before.heuristic_params != after.heuristic_params
+                ),
+            )
+        )
+    return cliffs
+
+
+def print_report(points: list[SweepPoint], cliffs: list[Cliff]) -> None:
+    cliff_sizes = {tuple(cliff.after) for cliff in cliffs}
+    print(
+        f"{'Size':>16} {'Time(ms)':>10} {'BW(GB/s)':>10} {'Segs':>5} "
+        f"{'Regs':>12} {'Smem':>24}  Schedulers"
+    )
+    for point in points:
+        marker = "  <-- cliff" if tuple(point.size) in cliff_sizes else ""
+        print(
+            f"{str(tuple(point.size)):>16} {point.time_ms:10.4f} "
+            f"{point.bandwidth_gbs:10.1f} {point.num_segments:5d} "
+            f"{str(point.registers):>12} {' '.join(point.shared_mem):>24}  "
+            f"{','.join(point.schedulers)}{marker}"
+        )
+
+    for cliff in cliffs:
+        print()
+        print(
+            f"Cliff from {tuple(cliff.before)} to {tuple(cliff.after)}: "
+            f"bandwidth drops by {cliff.bandwidth_drop * 100:.1f}%, heuristics "
+            f"{'changed' if cliff.heuristics_changed else 'unchanged'}"
+        )
+        if cliff.heuristics_changed:
+            for point in points:
+                if point.size in (cliff.before, cliff.after):
+                    print(f"--- {tuple(point.size)}")
+                    print("\n".join(point.heuristic_params))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Sweeps the shapes of a benchmark fusion and reports the "
+        "heuristics of each shape and the heuristic cliffs between them."
+    )
+    parser.add_argument("benchmark", choices=sorted(SWEEPS))
+    parser.add_argument(
+        "--dtype", default="bfloat16", choices=["float32", "float16", "bfloat16"]
+    )
+    parser.add_argument("--outer-size", type=int, default=2048)
+    parser.add_argument(
+        "--inner-sizes",
+        type=int,
+        nargs=3,
+        default=[768, 16384, 256],
+        metavar=("START", "STOP", "STEP"),
+        help="Inner sizes swept, STOP included.",
+    )
+    parser.add_argument("--rounds", type=int, default=10)
+    parser.add_argument(
+        "--cliff-threshold",
+        type=float,
+        default=0.2,
+        help="Bandwidth drop between adjacent shapes reported as a cliff.",
+    )
+    parser.add_argument(
+        "--output", help="Writes the points and the cliffs to this JSON file."
+    )
+    args = parser.parse_args()
+
+    sweep = SWEEPS[args.benchmark]
+    dtype = getattr(torch, args.dtype)
+    start, stop, step = args.inner_sizes
+    points = [
+        measure(sweep, (args.outer_size, inner_size), dtype, args.rounds)
+        for inner_size in range(start, stop + 1, step)
+    ]
+    cliffs = find_cliffs(points, args.cliff_threshold)
+    print_report(points, cliffs)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(
+                {
+                    "benchmark": args.benchmark,
+                    "dtype": args.dtype,
+                    "points": [asdict(point) for point in points],
+                    "cliffs": [asdict(cliff) for cliff in cliffs],
+                },
+                f,
+                indent=2,
+            )
+
+
+if __name__ == "__main__":
+    main()
@@ -2,9 +2,13 @@
 # All rights reserved.
 # SPDX-License-Identifier: BSD-3-Clause
 import pytest
+import torch
+from functools import partial
+from nvfuser import FusionDefinition, DataType
+from nvfuser.pytorch_utils import torch_dtype_to_nvfuser_dtype
 from .core import run_benchmark, with_executor, unary_bwd_torch, clear_dynamo_cache
 
-from .rope_ops import rope_setup, SEQ_LENGTHS
+from .rope_ops import apply_rope, rope_setup, SEQ_LENGTHS
 
 
 @pytest.mark.parametrize(
@@ -100,3 +104,72 @@ def test_rope_bwd_benchmark(
     run_benchmark(
         benchmark, unary_bwd_torch, [output, grad(), *fwd_inputs], iobytes=iobytes()
     )
+
+
+def rope_fusion(
+    fd: FusionDefinition,
+    shape: tuple,
+    dtype: DataType,
+) -> None:
+    batch_size, n_head, seq_length, head_size = shape
+    half = head_size // 2
+    x = fd.define_tensor(
+        shape=[-1, -1, -1, -1], contiguity=[True] * 4, dtype=dtype, is_cpu=False
+    )
+    cos = fd.define_tensor(
+        shape=[-1, -1], contiguity=[True, True], dtype=dtype, is_cpu=False
+    )
+    sin = fd.define_tensor(
+        shape=[-1, -1], contiguity=[True, True], dtype=dtype, is_cpu=False
+    )
+    if dtype != DataType.Float:
+        x = fd.ops.cast(x, dtype=DataType.Float)
+        cos = fd.ops.cast(cos, dtype=DataType.Float)
+        sin = fd.ops.cast(sin, dtype=DataType.Float)
+    x1 = fd.ops.slice(x, [0, 0, 0, 0], [batch_size, n_head, seq_length, half])
+    x2 = fd.ops.slice(
+        x, [0, 0, 0, half], [batch_size, n_head, seq_length, head_size]
+    )
+    rotated = fd.ops.cat([fd.ops.neg(x2), x1], dim=-1)
+    cos = fd.ops.broadcast_in_dim(cos, list(shape), [2, 3])
+    sin = fd.ops.broadcast_in_dim(sin, list(shape), [2, 3])
+    out = fd.ops.add(fd.ops.mul(x, cos), fd.ops.mul(rotated, sin))
+    if dtype != DataType.Float:
+        out = fd.ops.cast(out, dtype=dtype)
+    fd.add_output(out)
+
+
+# Compares the resize scheduler computing both halves of the rotations in
+# the same thread with its generic schedule
+@pytest.mark.parametrize("rotary_pairs", [True, False])
+@pytest.mark.parametrize("seq_length", SEQ_LENGTHS)
+@pytest.mark.resize
+def test_rope_nvf_benchmark(
+    benchmark,
+    seq_length: int,
+    rotary_pairs: bool,
+    disable_validation: bool,
+    disable_benchmarking: bool,
+):
+    dtype = torch.bfloat16
+    shape = (1, 32, seq_length, 128)
+    inputs = [
+        torch.randn(shape, device="cuda", dtype=dtype),
+        torch.randn(shape[2:], device="cuda", dtype=dtype),
+        torch.randn(shape[2:], device="cuda", dtype=dtype),
+    ]
+
+    with FusionDefinition() as fd:
+        rope_fusion(fd, shape, torch_dtype_to_nvfuser_dtype(dtype))
+
+    disable_options = [] if rotary_pairs else ["resize_rotary_pairs"]
+    if not disable_validation:
+        eager_output = apply_rope(*[t.float() for t in inputs])
+        fd.validate(
+            inputs, [eager_output.to(dtype)], _disable_options=disable_options
+        )
+
+    if not disable_benchmarking:
+        run_benchmark(
+            benchmark, partial(fd.execute, _disable_options=disable_options), inputs
+        )
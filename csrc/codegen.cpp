@@ -48,6 +48,52 @@ bool isTmaType(const DataType& dtype) {
       dtype.type);
 }
 
+// Returns whether runtime/helpers.cu defines an approximate float function
+// for op_type, named after it with a "fast_" prefix.
+bool hasFastMathFunction(UnaryOpType op_type) {
+  switch (op_type) {
+    case UnaryOpType::Cos:
+    case UnaryOpType::Exp:
+    case UnaryOpType::Exp2:
+    case UnaryOpType::Log:
+    case UnaryOpType::Log10:
+    case UnaryOpType::Log2:
+    case UnaryOpType::Reciprocal:
+    case UnaryOpType::Sigmoid:
+    case UnaryOpType::Silu:
+    case UnaryOpType::Sin:
+    case UnaryOpType::Tanh:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the functor of runtime/warp.cu that reduces a warp with a single
+// redux.sync on sm_80 and newer, or nullptr if redux.sync can't do the
+// reduction.
+const char* getReduxFunctor(BinaryOpType op_type, DataType data_type) {
+  if (data_type != DataType::Int32 && data_type != DataType::UInt32) {
+    return nullptr;
+  }
+  switch (op_type) {
+    case BinaryOpType::Add:
+      return "warp::ReduxAdd{}";
+    case BinaryOpType::Max:
+      return "warp::ReduxMax{}";
+    case BinaryOpType::Min:
+      return "warp::ReduxMin{}";
+    case BinaryOpType::BitwiseAnd:
+      return "warp::ReduxAnd{}";
+    case BinaryOpType::BitwiseOr:
+      return "warp::ReduxOr{}";
+    case BinaryOpType::BitwiseXor:
+      return "warp::ReduxXor{}";
+    default:
+      return nullptr;
+  }
+}
+
 //! Utility class to build an argument list
 class ArgumentBuilder {
  public:
@@ -172,28 +218,46 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     codegen.genBody();
     codegen.endBlock();
     NVF_CHECK(codegen.block_nest_level_ == 0);
-    std::stringstream final_code;
-    final_code << "// Codegen generated code\n";
+    // Concatenate the sections into one buffer reserved upfront instead of
+    // copying them through another string stream
+    std::vector<std::pair<std::string, std::string>> utilities;
+    utilities.reserve(codegen.utilities_.size());
+    std::string kernel_code = codegen.code_.str();
+    size_t size = kernel_code.size() + 64;
     for (const auto& [ns, code] : codegen.utilities_) {
+      utilities.emplace_back(ns, code.str());
+      size += 2 * ns.size() + utilities.back().second.size() + 64;
+    }
+    std::string final_code;
+    final_code.reserve(size);
+    final_code += "// Codegen generated code\n";
+    for (const auto& [ns, code] : utilities) {
       if (!ns.empty()) {
-        final_code << "namespace " << ns << " {\n"
-                   << code.str() << "} // namespace " << ns << "\n";
+        final_code += "namespace " + ns + " {\n";
+        final_code += code;
+        final_code += "} // namespace " + ns + "\n";
       } else {
-        final_code << code.str() << "\n";
+        final_code += code;
+        final_code += "\n";
       }
     }
-    final_code << codegen.code_.str();
-    return final_code.str();
+    final_code += kernel_code;
+    return final_code;
   }
 
  private:
-  explicit CudaKernelGenerator(const kir::Kernel* kernel) : kernel_(kernel) {
+  explicit CudaKernelGenerator(const kir::Kernel* kernel)
+      : kernel_(kernel),
+        fast_codegen_(isOptionEnabled(EnableOption::FastCodegen)),
+        fast_math_(isOptionEnabled(EnableOption::FastMath)),
+        disable_redux_sync_(isOptionDisabled(DisableOption::ReduxSync)) {
     initStringStreamFormat(code_);
   }
 
   // aligned array of registers used in the kernel
   std::unordered_set<Val*> aligned_array_of_regs_;
 
+  using kir::ConstIrVisitor::dispatch;
   using kir::ConstIrVisitor::handle;
 
   void initStringStreamFormat(std::stringstream& ss) {
@@ -292,6 +356,18 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
 
   // Generates the kernel function declaration
   void genDeclaration(const std::string& kernel_name) {
+    const std::vector<std::string> param_decls = genParamDeclarations();
+
+    // The arguments of the kernel are read from a struct in device memory
+    // instead of parameters, see KernelSummary::uses_kernel_arg_table
+    if (kernel_->summary().uses_kernel_arg_table) {
+      code_ << "struct KernelArgs {\n";
+      for (const auto& decl : param_decls) {
+        code_ << kTab << "alignas(16) " << decl << ";\n";
+      }
+      code_ << "};\n\n";
+    }
+
     code_ << "__global__ void ";
     if (kernel_->hasManaged("enable_register_sharing") &&
         kernel_->getManaged<bool>("enable_register_sharing")) {
@@ -332,10 +408,26 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
             << ") ";
     }
     code_ << kernel_name << "(";
+    if (kernel_->summary().uses_kernel_arg_table) {
+      code_ << "KernelArgs* __restrict__ args";
+    } else {
+      for (auto i : arange(param_decls.size())) {
+        code_ << param_decls[i];
+        if (i + 1 != param_decls.size()) {
+          code_ << ", ";
+        }
+      }
+    }
+    code_ << ") ";
+  }
 
+  // Returns the declaration of each kernel parameter and records its name in
+  // param_names_
+  std::vector<std::string> genParamDeclarations() {
     std::unordered_set<Val*> unique_args;
-
-    std::vector<Val*> params;
+    std::vector<std::string> param_decls;
+    param_decls.reserve(kernel_->parameters().size());
+    param_names_.reserve(kernel_->parameters().size());
 
     // Generate parameter declarations
     kernel_params_.reserve(kernel_->parameters().size());
@@ -357,34 +449,34 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
         var_name_ss << "_duplicate_" << duplicate_counter++;
       }
 
+      std::stringstream decl;
       if (const auto tv = dynamic_cast<TensorView*>(param)) {
         if (tv->isCpuScalar()) {
-          code_ << " CpuScalarTensor<" << param->dtype() << "> "
-                << var_name_ss.str();
+          decl << " CpuScalarTensor<" << param->dtype() << "> "
+               << var_name_ss.str();
         } else {
-          code_ << "Tensor<" << param->dtype() << ", "
-                << TensorDomain::noReductions(tv->getLogicalDomain()).size()
-                << ", "
-                << TensorDomain::noReductions(tv->getMaybeAllocationDomain())
-                       .size()
-                << "> " << var_name_ss.str();
+          const size_t alloc_dims =
+              kernel_->summary().tensors_reading_alloc_stride.count(tv)
+              ? TensorDomain::noReductions(tv->getMaybeAllocationDomain())
+                    .size()
+              : 0;
+          decl << "Tensor<" << param->dtype() << ", "
+               << TensorDomain::noReductions(tv->getLogicalDomain()).size()
+               << ", " << alloc_dims << "> " << var_name_ss.str();
         }
       } else {
         NVF_ERROR(param->isScalar()); // NOLINT (LLVM bug 48525)
         if (isTmaType(param->dtype())) {
-          code_ << "const __grid_constant__ " << param->dtype() << " "
-                << var_name_ss.str();
+          decl << "const __grid_constant__ " << param->dtype() << " "
+               << var_name_ss.str();
         } else {
-          code_ << param->dtype() << " " << var_name_ss.str();
+          decl << param->dtype() << " " << var_name_ss.str();
         }
       }
-
-      if (i + 1 != kernel_->parameters().size()) {
-        code_ << ", ";
-      }
+      param_decls.push_back(decl.str());
+      param_names_.push_back(var_name_ss.str());
     }
-
-    code_ << ") ";
+    return param_decls;
   }
 
   std::string genInlineOrOne(Val* v) {
@@ -395,6 +487,13 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
   void genPrologue() {
     const auto& kernel_summary = kernel_->summary();
 
+    // Bind the names of the parameters to the fields of the argument table
+    if (kernel_summary.uses_kernel_arg_table) {
+      for (const auto& name : param_names_) {
+        indent() << "auto& " << name << " = args->" << name << ";\n";
+      }
+    }
+
     // Do we have any dynamic shared memory buffers?
     const bool has_dynamic_smem =
         !kernel_summary.dynamic_smem_allocations.empty();
@@ -523,12 +622,87 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
   // non-const Expr*.
   void handle(const std::vector<Expr*>& exprs) {
     for (Expr* expr : exprs) {
-      kir::ConstIrVisitor::dispatch(expr);
+      dispatch(expr);
     }
   }
 
   void genBody() {
-    handle(kernel_->topLevelExprs());
+    const auto kernel_entry = profileStageEntry(
+        kir::KernelPerformanceProfile::Stage::Kernel);
+    if (kernel_entry.has_value()) {
+      indent() << "const int64_t kernel_profile_start = readCycleCounter();\n";
+    }
+    if (!kernel_->summary().uses_programmatic_dependent_launch) {
+      handle(kernel_->topLevelExprs());
+    } else {
+      // Overlap the allocations and hoisted scalars preceding the first
+      // access to global memory with the tail of the preceding kernel
+      const auto& exprs = kernel_->topLevelExprs();
+      auto first_access =
+          std::find_if(exprs.begin(), exprs.end(), mayAccessGlobalMemory);
+      for (auto it = exprs.begin(); it != first_access; ++it) {
+        dispatch(*it);
+      }
+      indent() << "grid_sync::waitForPrerequisiteGrids();\n";
+      for (auto it = first_access; it != exprs.end(); ++it) {
+        dispatch(*it);
+      }
+      indent() << "grid_sync::launchDependentGrids();\n";
+    }
+    if (kernel_entry.has_value()) {
+      genProfileStage(kernel_entry.value(), "kernel_profile_start");
+    }
+  }
+
+  //! Whether a top-level expression may access global memory. Only local and
+  //! shared memory allocations and scalar expressions, e.g., hoisted indices,
+  //! are known not to.
+  static bool mayAccessGlobalMemory(const Expr* expr) {
+    if (auto alloc = dynamic_cast<const kir::Allocate*>(expr)) {
+      return alloc->memoryType() == MemoryType::Global;
+    }
+    if (expr->isA<ForLoop>() || expr->isA<kir::IfThenElse>() ||
+        expr->isA<kir::Asm>() || expr->outputs().empty()) {
+      return true;
+    }
+    auto is_tensor = [](const Val* val) {
+      return val->isA<kir::TensorIndex>() || val->isA<TensorView>();
+    };
+    return std::any_of(
+               expr->inputs().begin(), expr->inputs().end(), is_tensor) ||
+        std::any_of(expr->outputs().begin(), expr->outputs().end(), is_tensor);
+  }
+
+  //! Profile entry of a stage of warp-specialized kernels, if profiled
+  std::optional<int64_t> profileStageEntry(
+      kir::KernelPerformanceProfile::Stage stage) const {
+    if (!isOptionEnabled(EnableOption::KernelProfile)) {
+      return std::nullopt;
+    }
+    return kernel_->profile().getStageEntry(stage);
+  }
+
+  void genProfileStage(int64_t entry, const std::string& start) {
+    indent() << "profileStage(&"
+             << genVariableName(kernel_->profile().getBuffer()) << "[0], "
+             << entry << ", " << kir::KernelPerformanceProfile::max_warp_groups
+             << ", " << start << ");\n";
+  }
+
+  //! Expressions profiled as part of a stage are timed individually
+  void dispatch(const Expr* expr) final {
+    std::optional<int64_t> entry;
+    if (auto stage = kernel_->profile().getStage(expr); stage.has_value()) {
+      entry = profileStageEntry(stage.value());
+    }
+    if (!entry.has_value()) {
+      kir::ConstIrVisitor::dispatch(expr);
+      return;
+    }
+    const std::string start = "profile_start_" + std::to_string(expr->name());
+    indent() << "const int64_t " << start << " = readCycleCounter();\n";
+    kir::ConstIrVisitor::dispatch(expr);
+    genProfileStage(entry.value(), start);
   }
 
   void startBlock(bool continuation = false) {
@@ -585,12 +759,36 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
           stmt->isA<Val>(), "Unknown Statement IR type: ", stmt->toString());
     }
 
-    std::stringstream tmp_code;
-    initStringStreamFormat(tmp_code);
+    std::stringstream tmp_code = acquireStringStream();
     std::swap(tmp_code, code_);
     dispatch(stmt);
     std::swap(tmp_code, code_);
-    return tmp_code.str();
+    std::string result = tmp_code.str();
+    releaseStringStream(std::move(tmp_code));
+    return result;
+  }
+
+  // Constructing a string stream and its locale costs more than generating
+  // most inline expressions, so FastCodegen keeps the streams of finished
+  // gen calls for reuse
+  std::stringstream acquireStringStream() {
+    if (!fast_codegen_ || free_string_streams_.empty()) {
+      std::stringstream ss;
+      initStringStreamFormat(ss);
+      return ss;
+    }
+    std::stringstream ss = std::move(free_string_streams_.back());
+    free_string_streams_.pop_back();
+    ss.str(std::string());
+    ss.clear();
+    setPrecision(ss, DataType::Double);
+    return ss;
+  }
+
+  void releaseStringStream(std::stringstream ss) {
+    if (fast_codegen_) {
+      free_string_streams_.push_back(std::move(ss));
+    }
   }
 
   std::string genInline(const Statement* stmt) {
@@ -675,12 +873,29 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     const bool has_alloc = alloc_set_.find(s) != alloc_set_.end();
     const bool is_param = kernel_params_.find(s) != kernel_params_.end();
     if (def != nullptr && !has_alloc && !is_param) {
+      // Inlined scalar expressions only change when an allocation of one of
+      // their values is generated, which clears the cache, or when indices
+      // are replaced
+      const bool cacheable = fast_codegen_ && s->isScalar() &&
+          index_replacement_map_.empty();
+      if (cacheable) {
+        auto cache_it = inline_val_cache_.find(s);
+        if (cache_it != inline_val_cache_.end()) {
+          code_ << cache_it->second;
+          return;
+        }
+      }
+      std::string inline_str;
       if (def->isOneOf<GetAttr, GetItem, GetMetaData>() ||
           (def->isA<UnaryOp>() &&
            !inline_op_str(def->as<UnaryOp>()->getUnaryOpType()).has_value())) {
-        code_ << genInline(def);
+        inline_str = genInline(def);
       } else {
-        code_ << "(" << genInline(def) << ")";
+        inline_str = "(" + genInline(def) + ")";
+      }
+      code_ << inline_str;
+      if (cacheable) {
+        inline_val_cache_.emplace(s, std::move(inline_str));
       }
     } else if (s->isConst()) {
       stringify(s->value(), s->dtype());
@@ -791,6 +1006,16 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     func_args.arg(genInline(gmem_ti->index()));
     func_args.arg(genInline(smem_ti->index()));
 
+    const auto& multicast_dims = kernel_->summary().tma_multicast_dims;
+    if (auto it = multicast_dims.find(out_tv); it != multicast_dims.end()) {
+      NVF_ERROR(is_tensor_tile && smem_ti == out);
+      indent() << genCall(
+                      "Hopper::cpAsyncBulkTensorTileG2SMulticast",
+                      it->second,
+                      func_args)
+               << ";\n";
+      return;
+    }
     indent() << genCall(func_name, func_args) << ";\n";
   }
 
@@ -877,6 +1102,10 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
         code_ << "std::bit_cast<" << uop->out()->dtype() << ">";
       } else if (op_type == UnaryOpType::RefCast) {
         code_ << "(*reinterpret_cast<" << uop->out()->dtype() << "*>(&";
+      } else if (
+          fast_math_ && uop->out()->dtype() == DataType::Float &&
+          hasFastMathFunction(op_type)) {
+        code_ << "fast_" << op_type;
       } else {
         code_ << op_type;
         if (needFloatSuffix(op_type) &&
@@ -1615,7 +1844,13 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     ArgumentBuilder func_args;
     func_args.arg(gen(output));
     func_args.arg(gen(input));
-    func_args.arg(genReductionOp(reduction_op_type, output->dtype()));
+    const char* redux_functor =
+        getReduxFunctor(reduction_op_type, output->dtype());
+    if (redux_functor != nullptr && !disable_redux_sync_) {
+      func_args.arg(redux_functor);
+    } else {
+      func_args.arg(genReductionOp(reduction_op_type, output->dtype()));
+    }
     func_args.arg(genStaticCast(genPtrType(output->dtype()), "shared_mem"));
     NVF_ERROR(read_pred != nullptr && read_pred->hasValue());
     func_args.arg(genInline(read_pred));
@@ -1973,12 +2208,21 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     auto pred_bool = wop->hoistedPredicate()->value();
     bool is_predicated = !(pred_bool.hasValue() && pred_bool.as<bool>());
 
+    // Merges partial results instead of single values
+    const bool is_merge = wop->deltaM2Scale() != nullptr;
+
     ArgumentBuilder func_args;
     func_args.arg(gen(out_avg));
     func_args.arg(gen(out_var));
     func_args.arg(gen(out_N));
     func_args.arg(gen(in_avg));
+    if (is_merge) {
+      func_args.arg(gen(wop->inVar()));
+    }
     func_args.arg(gen(wop->reciprocalOfCount()));
+    if (is_merge) {
+      func_args.arg(gen(wop->deltaM2Scale()));
+    }
     func_args.arg(gen(wop->count()));
     if (is_predicated) {
       func_args.arg(gen(wop->hoistedPredicate()));
@@ -1990,7 +2234,11 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
       template_args.arg(output_gmem);
     }
 
-    indent() << genCall("welfordVectorized", template_args, func_args) << ";\n";
+    indent() << genCall(
+                    is_merge ? "welfordVectorizedCombine" : "welfordVectorized",
+                    template_args,
+                    func_args)
+             << ";\n";
   }
 
   // Support ReductionOp and WelfordOp
@@ -2078,6 +2326,16 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
       return;
     }
 
+    if (grop->isClusterReduction()) {
+      generateClusterReduction(grop);
+      return;
+    }
+
+    if (grop->isAtomic()) {
+      generateAtomicGridReduction(grop);
+      return;
+    }
+
     NVF_ERROR(grop->reduction_buffer()->buffer()->isA<TensorView>());
     NVF_ERROR(grop->sync_buffer()->buffer()->isA<TensorView>());
     const auto work_buffer =
@@ -2130,6 +2388,73 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     indent() << kTab << func_args << ");\n";
   }
 
+  void generateClusterReduction(const kir::GridReduction* grop) {
+    NVF_ERROR(grop->isClusterReduction());
+
+    const auto out = grop->out()->as<kir::TensorIndex>();
+    const auto data_type = grop->out()->dtype();
+    const auto op_type = grop->getReductionOpType();
+
+    const std::string flags_str =
+        generateGridReduceTemplateFlags2(grop, grop->threadPredicate());
+
+    ArgumentBuilder template_args;
+    template_args.arg(flags_str).arg(isAligned()).arg(grop->isAllreduce());
+
+    ArgumentBuilder func_args(block_nest_level_ + 1, kTab);
+    func_args.arg(gen(grop->out()));
+    func_args.arg(gen(grop->in()));
+    func_args.arg(genReductionOp(op_type, out->dtype()));
+    func_args.arg(genCall("static_cast", ptrType(data_type), "shared_mem"));
+    // read and write predicates
+    NVF_ERROR(grop->predicate() != nullptr && grop->predicate()->hasValue());
+    const auto read_pred = genInline(grop->predicate());
+    func_args.arg(read_pred);
+    if (grop->writePredicate() != nullptr) {
+      NVF_ERROR(grop->writePredicate()->hasValue());
+      func_args.arg(genInline(grop->writePredicate()));
+    } else {
+      func_args.arg(read_pred);
+    }
+    // Init val
+    func_args.arg(genCall(data_type, genInline(grop->init())));
+    func_args.arg(genComputeBlockDim());
+
+    indent() << "reduction::clusterReduce<" << template_args << ">(\n";
+    indent() << kTab << func_args << ");\n";
+  }
+
+  void generateAtomicGridReduction(const kir::GridReduction* grop) {
+    NVF_ERROR(grop->isAtomic());
+
+    const auto out = grop->out()->as<kir::TensorIndex>();
+    const int64_t vectorize_size = ir_utils::getVectorizeSize(out->view());
+
+    ArgumentBuilder template_args;
+    template_args.arg("/*vec_size=*/").append(std::to_string(vectorize_size));
+
+    ArgumentBuilder func_args(block_nest_level_ + 1, kTab);
+    func_args.arg("&").append(gen(out));
+    func_args.arg("&").append(gen(grop->in()));
+
+    // read and write predicates
+    NVF_ERROR(grop->predicate() != nullptr && grop->predicate()->hasValue());
+    const auto read_pred = genInline(grop->predicate());
+    func_args.arg(read_pred);
+    if (grop->writePredicate() != nullptr) {
+      NVF_ERROR(grop->writePredicate()->hasValue());
+      func_args.arg(genInline(grop->writePredicate()));
+    } else {
+      func_args.arg(read_pred);
+    }
+
+    const char* step = grop->getReductionOpType() == BinaryOpType::Max
+        ? "atomicMaxReductionStep"
+        : "atomicReductionStep";
+    indent() << "reduction::" << step << "<" << template_args << ">(\n";
+    indent() << kTab << func_args << ");\n";
+  }
+
   std::string genFusedReductionName(const TensorView* reduction_out) {
     return genVariableName(reduction_out) + "_reduction";
   }
@@ -2164,8 +2489,12 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
         ArgumentBuilder().arg("gridDim"));
 
     int64_t vectorize_size = ir_utils::getVectorizeSize(out->view());
+    const int64_t num_chains = grop->serialGridReductionChains();
 
     ArgumentBuilder template_args;
+    if (num_chains > 1) {
+      template_args.append(block_flags);
+    }
     template_args.arg("/*vec_size=*/").append(std::to_string(vectorize_size));
 
     ArgumentBuilder func_args(block_nest_level_ + 1, kTab);
@@ -2173,14 +2502,22 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     func_args.arg("&").append(gen(grop->in()));
     func_args.arg(gen(grop->init()));
     func_args.arg("&").append(gen(grop->serialReductionTensor()));
+    if (num_chains > 1) {
+      // The position of the block in its chain determines the first and last
+      // steps
+      func_args.arg(genInline(grop->serialReductionChainStride()));
+      func_args.arg(num_chains);
+    }
     func_args.arg(genReductionOp(op_type, out->dtype()));
 
     // Whether this is the first or last step
-    func_args.arg(idx_in_segment).append(" == 0");
-    func_args.arg(idx_in_segment)
-        .append(" == ")
-        .append(segment_size)
-        .append(" - 1");
+    if (num_chains == 1) {
+      func_args.arg(idx_in_segment).append(" == 0");
+      func_args.arg(idx_in_segment)
+          .append(" == ")
+          .append(segment_size)
+          .append(" - 1");
+    }
     // TODO: can we hoist the first and last step predicates? We might need to
     // attach them to grop in order to do that?
 
@@ -2195,7 +2532,9 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
       func_args.arg(read_pred);
     }
 
-    indent() << "reduction::serialReductionStep<" << template_args << ">(\n";
+    indent() << (num_chains > 1 ? "reduction::chainedSerialReductionStep<"
+                                : "reduction::serialReductionStep<")
+             << template_args << ">(\n";
     indent() << kTab << func_args << ");\n";
   }
 
@@ -3262,6 +3601,94 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
                     func_args)
              << ";\n";
   }
+  //! Generates a single groupedWarpReduceTIDX or groupedBlockReduce call for
+  //! the block reductions of a horizontally grouped GroupedReductionOp, so
+  //! that they share a shuffle tree and shared memory round trip. Returns
+  //! false if the reductions can't share a call, in which case each of them
+  //! is generated separately.
+  bool genGroupedBlockReduction(const GroupedReductionOp* grouped_rop) {
+    const auto num_grouped_exprs = grouped_rop->numHorizontallyGroupedExprs();
+    const auto output0 = grouped_rop->output(0)->as<kir::TensorIndex>();
+    const auto data_type = output0->dtype();
+    const auto reduction_ids = ir_utils::getMaybeWarpReductionDim(
+        output0, grouped_rop->input(0)->as<kir::TensorIndex>());
+
+    for (const auto i : arange(num_grouped_exprs)) {
+      const auto output = grouped_rop->output(i)->as<kir::TensorIndex>();
+      const auto input = grouped_rop->input(i)->as<kir::TensorIndex>();
+      const auto domain = output->view()->domain();
+      if (!domain->hasBlockReduction() || domain->hasGridReduction() ||
+          output->dtype() != data_type ||
+          ir_utils::getMaybeWarpReductionDim(output, input).has_value() !=
+              reduction_ids.has_value()) {
+        return false;
+      }
+    }
+
+    // Only TIDx warp reductions have a grouped version
+    const bool is_warp_reduction = reduction_ids.has_value();
+    if (is_warp_reduction &&
+        (reduction_ids->first->getParallelType() != ParallelType::TIDx ||
+         reduction_ids->second != nullptr)) {
+      return false;
+    }
+
+    ArgumentBuilder outputs;
+    ArgumentBuilder inputs;
+    ArgumentBuilder init_vals;
+    ArgumentBuilder reduction_ops;
+    for (const auto i : arange(num_grouped_exprs)) {
+      outputs.arg("&").append(gen(grouped_rop->output(i)));
+      inputs.arg(gen(grouped_rop->input(i)));
+      init_vals.arg(
+          genStaticCast(data_type, genInline(grouped_rop->initVal(i))));
+      reduction_ops.arg(
+          genReductionOp(grouped_rop->getReductionOpType(i), data_type));
+    }
+
+    ArgumentBuilder func_args;
+    func_args.arg("{").append(outputs).append("}");
+    func_args.arg("{").append(inputs).append("}");
+    func_args.arg(genStaticCast(genPtrType(data_type), "shared_mem"));
+    kir::Predicate* read_pred = grouped_rop->predicate();
+    NVF_ERROR(read_pred != nullptr && read_pred->hasValue());
+    func_args.arg(genInline(read_pred));
+
+    ArgumentBuilder template_args;
+    std::string func_name;
+    if (is_warp_reduction) {
+      template_args.arg(
+          kernel_->getWarpPaddedParallelInfo().is_tidx_single_warp);
+      template_args.arg(isAligned());
+      func_name = "warp::groupedWarpReduceTIDX";
+    } else {
+      const auto par_domains = ir_utils::getParallelDomains(output0);
+      for (auto pt :
+           {ParallelType::TIDx, ParallelType::TIDy, ParallelType::TIDz}) {
+        auto it = par_domains.find(pt);
+        template_args.arg(
+            it != par_domains.end() && it->second->isReduction());
+      }
+      template_args.arg(isAligned());
+      // The write predicate is the read predicate unless given explicitly
+      kir::Predicate* write_pred = grouped_rop->writePredicate();
+      if (write_pred != nullptr) {
+        NVF_ERROR(write_pred->hasValue());
+        func_args.arg(genInline(write_pred));
+      } else {
+        func_args.arg(genInline(read_pred));
+      }
+      func_name = "groupedBlockReduce";
+    }
+    template_args.arg(num_grouped_exprs);
+    func_args.arg("{").append(init_vals).append("}");
+    func_args.arg(genComputeBlockDim());
+    func_args.arg(reduction_ops);
+
+    indent() << genCall(func_name, template_args, func_args) << ";\n";
+    return true;
+  }
+
   void handle(const GroupedReductionOp* grouped_rop) final {
     const auto num_grouped_iterations =
         getGroupedLoopIndexConcreteIntSets().size();
@@ -3316,6 +3743,10 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
       }
     }
 
+    if (num_grouped_exprs > 1 && genGroupedBlockReduction(grouped_rop)) {
+      return;
+    }
+
     for (const auto i : arange(num_grouped_exprs)) {
       NVF_ERROR(grouped_rop->output(i)->isA<kir::TensorIndex>());
 
@@ -3404,6 +3835,8 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
                              .getCircularBufferOptionsFor(loop->iter_domain())
                              .prefetch;
       indent() << "#pragma unroll " << prefetch << "\n";
+    } else if (loop->isUnrolled() && loop->maxUnrollFactor() > 0) {
+      indent() << "#pragma unroll " << loop->maxUnrollFactor() << "\n";
     } else if (loop->isUnrolled()) {
       indent() << "#pragma unroll\n";
     } else {
@@ -3455,6 +3888,7 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
 
     NVF_ERROR(alloc->buffer() != nullptr);
     alloc_set_.emplace(alloc->buffer());
+    inline_val_cache_.clear();
 
     if (!alloc->buffer()->isA<TensorView>()) {
       // Pointer TensorMap allocation must be const as kernel parametr assigned
@@ -3913,12 +4347,18 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
   }
 
   void handle(const kir::MBarrierInit* init) final {
-    auto call = genCall(
-        "mbarrier::init",
-        ArgumentBuilder()
-            .arg(genInline(init->mbarrier()))
-            .arg(genInline(init->threadCount())));
-    indent() << call << ";\n";
+    ArgumentBuilder func_args;
+    func_args.arg(genInline(init->mbarrier()))
+        .arg(genInline(init->threadCount()));
+    if (init->multicastDims().empty()) {
+      indent() << genCall("mbarrier::init", func_args) << ";\n";
+    } else {
+      indent() << genCall(
+                      "mbarrier::initMulticast",
+                      toDelimitedString(init->multicastDims()),
+                      func_args)
+               << ";\n";
+    }
   }
 
   void handle(const kir::MBarrierInvalidate* inval) final {
@@ -3934,10 +4374,19 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     if (arrive->state() != nullptr) {
       code_ << gen(arrive->state()) << " = ";
     }
-    auto call = genCall(
-        "mbarrier::arrive",
-        ArgumentBuilder().arg(genInline(arrive->mbarrier())));
-    code_ << call;
+    if (arrive->multicastDims().empty()) {
+      code_ << genCall(
+          "mbarrier::arrive",
+          ArgumentBuilder().arg(genInline(arrive->mbarrier())));
+    } else {
+      NVF_ERROR(
+          arrive->state() == nullptr,
+          "Multicast arrives don't return the state of the mbarrier");
+      code_ << genCall(
+          "mbarrier::arriveMulticast",
+          toDelimitedString(arrive->multicastDims()),
+          ArgumentBuilder().arg(genInline(arrive->mbarrier())));
+    }
     if (!print_inline_) {
       code_ << ";\n";
     }
@@ -3996,15 +4445,25 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
         ArgumentBuilder().arg(!bidx).arg(!bidy).arg(!bidz),
         ArgumentBuilder().arg("blockIdx").arg("gridDim"));
 
+    // Each segment has one semaphore per chain
+    const int64_t num_chains = sync->numChains();
+    if (num_chains > 1) {
+      sync_idx += " * " + std::to_string(num_chains);
+    }
+
     ArgumentBuilder sync_call_args;
     sync_call_args.arg("&")
         .append(genVariableName(sync->syncBuffer()))
         .append("[")
         .append(sync_idx)
         .append("]");
+    if (num_chains > 1) {
+      sync_call_args.arg(num_chains);
+    }
 
     auto sync_call = genCall(
-        "grid_sync::blockSerializeWait",
+        num_chains > 1 ? "grid_sync::blockSerializeWaitChained"
+                       : "grid_sync::blockSerializeWait",
         sync_call_template_parms,
         sync_call_args);
 
@@ -4028,15 +4487,25 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
         ArgumentBuilder().arg(!bidx).arg(!bidy).arg(!bidz),
         ArgumentBuilder().arg("blockIdx").arg("gridDim"));
 
+    // Each segment has one semaphore per chain
+    const int64_t num_chains = sync->numChains();
+    if (num_chains > 1) {
+      sync_idx += " * " + std::to_string(num_chains);
+    }
+
     ArgumentBuilder sync_call_args;
     sync_call_args.arg("&")
         .append(genVariableName(sync->syncBuffer()))
         .append("[")
         .append(sync_idx)
         .append("]");
+    if (num_chains > 1) {
+      sync_call_args.arg(num_chains);
+    }
 
     auto sync_call = genCall(
-        "grid_sync::blockSerializeRelease",
+        num_chains > 1 ? "grid_sync::blockSerializeReleaseChained"
+                       : "grid_sync::blockSerializeRelease",
         sync_call_template_parms,
         sync_call_args);
 
@@ -4051,11 +4520,22 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
     indent() << "NVFUSER_UPDATE_MAGIC_ZERO;\n";
   }
 
+  void handle(const kir::IncrementScalar* inc) final {
+    indent() << gen(inc->value()) << " += " << gen(inc->step()) << ";\n";
+  }
+
   void handle(const kir::Continue* cont) final {
     indent() << "continue;\n";
   }
 
   void handle(const kir::Return* ret) final {
+    // Threads returning early, e.g., the producer warp group of
+    // warp-specialized kernels, finish their profile of the kernel here
+    const auto kernel_entry = profileStageEntry(
+        kir::KernelPerformanceProfile::Stage::Kernel);
+    if (kernel_entry.has_value()) {
+      genProfileStage(kernel_entry.value(), "kernel_profile_start");
+    }
     indent() << "return;\n";
   }
 
@@ -4097,12 +4577,24 @@ class CudaKernelGenerator : private kir::ConstIrVisitor {
   std::deque<const ForLoop*> grouped_loops_;
   //! Used to replace symbolic indices with concrete values
   std::unordered_map<const Val*, int64_t> index_replacement_map_;
+  //! Whether EnableOption::FastCodegen is set
+  bool fast_codegen_ = false;
+  //! Whether EnableOption::FastMath is set
+  bool fast_math_ = false;
+  //! Whether DisableOption::ReduxSync is set
+  bool disable_redux_sync_ = false;
+  //! String streams of finished gen calls kept for reuse with FastCodegen
+  std::vector<std::stringstream> free_string_streams_;
+  //! Inline strings of scalar expressions generated with FastCodegen
+  std::unordered_map<const Val*, std::string> inline_val_cache_;
   //! Keep track of thread alignment property
   std::vector<bool> aligned_scope_exprs_;
   //! Keep track of the Val* and its generated variable name
   std::unordered_map<const Val*, std::string> val_to_name_;
   //! basically kernel_->parameters(), but as a set so it's faster to lookup
   std::unordered_set<const Val*> kernel_params_;
+  //! Generated names of kernel_->parameters()
+  std::vector<std::string> param_names_;
   //! Utility names already generated
   std::unordered_set<std::string> generated_utilities_;
   //! iterGroupedStaticWarpAllReduce requires static threads per CTA
@@ -9,12 +9,19 @@
 
 #include <device_lower/utils.h>
 #include <expr_evaluator.h>
+#include <fusion_guard.h>
+#include <ir/cloner.h>
 #include <ir/utils.h>
+#include <iter_visitor.h>
 #include <kernel_ir.h>
 #include <kernel_ir_dispatch.h>
+#include <options.h>
 #include <polymorphic_value.h>
+#include <remarks.h>
 #include <type.h>
 
+#include <algorithm>
+#include <optional>
 #include <unordered_set>
 
 namespace nvfuser {
@@ -280,4 +287,152 @@ std::unordered_map<const Expr*, std::pair<int64_t, int64_t>> getBankConflictInfo
   return BankConflictInfo::get(kernel, launch_params, known_values);
 }
 
+namespace {
+
+int64_t maxConflictWays(
+    const std::pair<std::vector<int64_t>, std::vector<int64_t>>& ways) {
+  auto max_of = [](const std::vector<int64_t>& v) -> int64_t {
+    return v.empty() ? 1 : *std::max_element(v.begin(), v.end());
+  };
+  return std::max(max_of(ways.first), max_of(ways.second));
+}
+
+// MMA operands, ldmatrix/stmatrix and TMA expect a specific shared memory
+// layout, which must not be changed behind their back
+bool isLayoutConstrained(const Expr* expr) {
+  if (expr->isA<MmaOp>()) {
+    return true;
+  }
+  auto ldst = dynamic_cast<const LoadStoreOp*>(expr);
+  return ldst != nullptr && ldst->opType() != LoadStoreOpType::Set;
+}
+
+// Returns the swizzle to apply to the two innermost loop axes of tv, or
+// std::nullopt if tv can't be swizzled. Mirrors the checks of the data
+// swizzle in TensorView::swizzle.
+std::optional<Swizzle2DType> getRepairSwizzle(TensorView* tv) {
+  if (tv->getMemoryType() != MemoryType::Shared || tv->hasAllocation() ||
+      tv->hasSwizzleOp() || tv->isCircularBuffered() || tv->nDims() < 2) {
+    return std::nullopt;
+  }
+  if (tv->definition() == nullptr || isLayoutConstrained(tv->definition()) ||
+      std::any_of(tv->uses().begin(), tv->uses().end(), isLayoutConstrained)) {
+    return std::nullopt;
+  }
+  if (std::any_of(
+          tv->getLoopDomain().begin(),
+          tv->getLoopDomain().end(),
+          [](IterDomain* id) {
+            return isParallelTypeVectorize(id->getParallelType());
+          })) {
+    return std::nullopt;
+  }
+
+  const int64_t x = tv->nDims() - 2;
+  const int64_t y = tv->nDims() - 1;
+  if (x < tv->getMaxComputePosition() ||
+      y < tv->getMaybeMaxProducerPosition()) {
+    return std::nullopt;
+  }
+
+  IterDomain* x_id = tv->axis(x);
+  IterDomain* y_id = tv->axis(y);
+  for (auto id : ir_utils::filterByType<IterDomain>(
+           InputsOf::outputs({x_id, y_id}))) {
+    if (id->isBroadcast() || id->isReduction()) {
+      return std::nullopt;
+    }
+  }
+  for (auto expr : DependencyCheck::getAllExprsBetween(
+           {tv->getLogicalDomain().begin(), tv->getLogicalDomain().end()},
+           {x_id, y_id})) {
+    if (expr->isOneOf<Swizzle, Swizzle2D>()) {
+      return std::nullopt;
+    }
+  }
+
+  if (!x_id->extent()->isConstInt() || !y_id->extent()->isConstInt()) {
+    return std::nullopt;
+  }
+  const int64_t size = x_id->extent()->evaluate().as<int64_t>();
+  if (size <= 1 || size != y_id->extent()->evaluate().as<int64_t>()) {
+    return std::nullopt;
+  }
+  const bool is_pow_of_2 = (size & (size - 1)) == 0;
+  return is_pow_of_2 ? Swizzle2DType::XOR : Swizzle2DType::CyclicShift;
+}
+
+} // namespace
+
+std::vector<TensorView*> repairBankConflicts(
+    Fusion* fusion,
+    const CompileParams& compile_params) {
+  // Swizzle2D is only supported by the legacy indexer, which isn't used for
+  // fusions with MMA or TMA
+  if (isOptionEnabled(EnableOption::IdModel)) {
+    return {};
+  }
+  for (auto expr : fusion->exprs()) {
+    if (expr->isA<MmaOp>() || ir_utils::isCpAsyncBulk(expr)) {
+      return {};
+    }
+  }
+
+  auto info = fusion->bankConflictInfo(compile_params);
+  if (info.empty()) {
+    return {};
+  }
+
+  std::vector<std::pair<TensorView*, Swizzle2DType>> candidates;
+  for (auto tv : fusion->allTvs()) {
+    if (info.count(tv) == 0) {
+      continue;
+    }
+    if (auto swizzle_type = getRepairSwizzle(tv)) {
+      candidates.emplace_back(tv, swizzle_type.value());
+    }
+  }
+  if (candidates.empty()) {
+    return {};
+  }
+
+  // Swizzles can't be undone, so rerun the analysis on a copy to find which
+  // of them actually help
+  Fusion trial;
+  IrCloner ir_cloner = Fusion::copy(fusion, &trial);
+  std::unordered_map<TensorView*, TensorView*> trial_tvs;
+  {
+    FusionGuard fg(&trial);
+    for (auto [tv, swizzle_type] : candidates) {
+      TensorView* trial_tv = ir_cloner.clone(tv);
+      trial_tv->swizzle(swizzle_type, -2, -1);
+      trial_tvs.emplace(tv, trial_tv);
+    }
+  }
+  auto trial_info = trial.bankConflictInfo(compile_params);
+
+  std::vector<TensorView*> repaired;
+  FusionGuard fg(fusion);
+  for (auto [tv, swizzle_type] : candidates) {
+    const int64_t ways = maxConflictWays(info.at(tv));
+    auto it = trial_info.find(trial_tvs.at(tv));
+    const int64_t trial_ways =
+        it == trial_info.end() ? 1 : maxConflictWays(it->second);
+    if (trial_ways >= ways) {
+      continue;
+    }
+    tv->swizzle(swizzle_type, -2, -1);
+    repaired.push_back(tv);
+    remarks::report(
+        "bank_conflict_repair",
+        "swizzled shared memory tensor",
+        {{"tensor", tv->toString()},
+         {"swizzle",
+          swizzle_type == Swizzle2DType::XOR ? "xor" : "cyclic_shift"},
+         {"ways_before", std::to_string(ways)},
+         {"ways_after", std::to_string(trial_ways)}});
+  }
+  return repaired;
+}
+
 } // namespace nvfuser
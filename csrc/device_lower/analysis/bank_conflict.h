@@ -16,6 +16,7 @@
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace nvfuser {
 
@@ -50,4 +51,17 @@ getBankConflictInfo(
     LaunchParams launch_params = {},
     const std::unordered_map<Val*, PolymorphicValue>& known_values = {});
 
+// Swizzles the shared memory tensors of a scheduled fusion that
+// Fusion::bankConflictInfo finds to be accessed with bank conflicts. Only
+// tensors whose layout is not constrained by MMA, ldmatrix or TMA and whose
+// two innermost loop axes are allocated, constant and square are considered.
+// An XOR swizzle is used for power-of-two tiles and a cyclic shift otherwise.
+// The swizzles are tried on a copy of the fusion first, and only those the
+// rerun analysis finds to reduce the conflicts are applied to fusion.
+//
+// Returns the swizzled tensors.
+NVF_API std::vector<TensorView*> repairBankConflicts(
+    Fusion* fusion,
+    const CompileParams& compile_params = CompileParams());
+
 } // namespace nvfuser
@@ -16,6 +16,7 @@
 #include <ops/arith.h>
 #include <options.h>
 #include <predicate_compute.h>
+#include <remarks.h>
 #include <transform_iter.h>
 #include <transform_replay.h>
 
@@ -378,9 +379,12 @@ class ProducerConsumerPairAnalyzer : public OptOutDispatch {
 
 class PredicateChcker : public IterVisitor {
  public:
+  //! If reason is given, it is set to a short description of the first
+  //! condition found to require the predicate.
   static bool needsPredicate(
       Expr* expr,
-      const PredicateElimination& pred_elimination) {
+      const PredicateElimination& pred_elimination,
+      const char** reason = nullptr) {
     if (!ir_utils::isTvOp(expr)) {
       return false;
     }
@@ -396,6 +400,9 @@ class PredicateChcker : public IterVisitor {
 
     PredicateChcker checker(pred_elimination);
     checker.dispatch(expr);
+    if (reason != nullptr) {
+      *reason = checker.reason_;
+    }
     return checker.needs_predicate_;
   }
 
@@ -409,11 +416,22 @@ class PredicateChcker : public IterVisitor {
   void dispatch(Expr* expr) final {
     const bool needs_predicate_smem_access =
         needsPredicateSharedMemAccess(expr);
-    needs_predicate_ = predicateIntDiv(expr) || needs_predicate_smem_access ||
-        predicateProducerConsumerPair(expr) ||
-        predicateNonDivisibleLogicalDomains(expr) ||
-        predicateNonDivisibleSplit(expr) || predicateExpandReduce(expr) ||
-        predicateRNGOp(expr);
+    if (predicateIntDiv(expr)) {
+      reason_ = "integer division";
+    } else if (needs_predicate_smem_access) {
+      reason_ = "shared memory access";
+    } else if (predicateProducerConsumerPair(expr)) {
+      reason_ = "producer-consumer pair";
+    } else if (predicateNonDivisibleLogicalDomains(expr)) {
+      reason_ = "non-divisible logical domain";
+    } else if (predicateNonDivisibleSplit(expr)) {
+      reason_ = "non-divisible split";
+    } else if (predicateExpandReduce(expr)) {
+      reason_ = "reduction of expanded domain";
+    } else if (predicateRNGOp(expr)) {
+      reason_ = "RNG op";
+    }
+    needs_predicate_ = reason_ != nullptr;
 
     if (needs_predicate_) {
       return;
@@ -421,6 +439,9 @@ class PredicateChcker : public IterVisitor {
 
     // Check expr type-specific conditions
     IterVisitor::dispatch(expr);
+    if (needs_predicate_) {
+      reason_ = "uninitialized or mismatched input of reduction";
+    }
   }
 
   // All "predicateXYZ" functions return true if an expr needs to be
@@ -919,6 +940,7 @@ class PredicateChcker : public IterVisitor {
   const PredicateElimination& pred_elimination_;
   const std::unordered_set<const Expr*>& non_predicated_exprs_;
   bool needs_predicate_ = false;
+  const char* reason_ = nullptr;
 };
 
 } // namespace
@@ -936,8 +958,15 @@ void PredicateElimination::dispatch(Expr* expr) {
     return;
   }
 
-  if (needsPredicate(expr)) {
+  const char* reason = nullptr;
+  if (PredicateChcker::needsPredicate(expr, *this, &reason)) {
     assertOnWarpOps(expr);
+    if (remarks::isActive() && reason != nullptr) {
+      remarks::report(
+          "predicate_elimination",
+          "predicate kept",
+          {{"expr", expr->outputs().at(0)->toString()}, {"reason", reason}});
+    }
     return;
   }
 
@@ -14,6 +14,7 @@
 #include <val_graph.h>
 #include <val_graph_visitor.h>
 
+#include <array>
 #include <list>
 #include <unordered_map>
 #include <vector>
@@ -1214,4 +1215,77 @@ MmaInputSmemSwizzle getSwizzle(TensorView* tv) {
       getCpAsyncBulkTensorSwizzleSize(tv) * core_matrix_width_bytes);
 }
 
+std::unordered_map<const TensorView*, int64_t> getTmaMulticastDimsMap(
+    Fusion* fusion) {
+  std::unordered_map<const TensorView*, int64_t> result;
+  if (!fusion->hasManaged("tma_multicast") ||
+      !fusion->getManaged<bool>("tma_multicast") ||
+      !fusion->hasManaged("cluster_dims")) {
+    return result;
+  }
+  const auto [cluster_x, cluster_y, cluster_z] =
+      fusion->getManaged<std::tuple<int64_t, int64_t, int64_t>>(
+          "cluster_dims");
+  const std::array<std::pair<ParallelType, int64_t>, 3> cluster_dims{
+      {{ParallelType::BIDx, cluster_x},
+       {ParallelType::BIDy, cluster_y},
+       {ParallelType::BIDz, cluster_z}}};
+
+  const CircularBufferInfo& cb_info = GpuLower::current()->circularBufferInfo();
+  // The arrivals of independent compute warp groups aren't matched by
+  // iteration across blocks
+  if (cb_info.hasIndependentComputeWarpGroups()) {
+    return result;
+  }
+  for (const TensorView* tv : cb_info.getCircularBufferTvs()) {
+    auto ldst = dynamic_cast<LoadStoreOp*>(tv->definition());
+    if (ldst == nullptr ||
+        ldst->opType() != LoadStoreOpType::CpAsyncBulkTensorTile ||
+        tv->getMemoryType() != MemoryType::Shared) {
+      continue;
+    }
+    const CircularBufferOptions& opt =
+        cb_info.getCircularBufferOptionsFor(cb_info.getCircularBufferAxis(tv));
+    if (!std::holds_alternative<WarpSpecialized>(opt.type)) {
+      continue;
+    }
+    int64_t shared_dims = 0;
+    for (auto i : arange(std::ssize(cluster_dims))) {
+      const auto& [pt, extent] = cluster_dims.at(i);
+      if (extent == 1) {
+        continue;
+      }
+      bool varies = std::any_of(
+          tv->getLoopDomain().begin(),
+          tv->getLoopDomain().end(),
+          [pt = pt](IterDomain* id) {
+            return id->getParallelType() == pt && !id->isBroadcast();
+          });
+      if (!varies) {
+        shared_dims |= 1L << i;
+      }
+    }
+    if (shared_dims != 0) {
+      result.emplace(tv, shared_dims);
+    }
+  }
+  return result;
+}
+
+std::vector<int64_t> getTmaMulticastDims(ForLoop* circular_buffer_loop) {
+  const auto& multicast_dims_map = GpuLower::current()->tmaMulticastDims();
+  std::vector<int64_t> result;
+  for (const TensorView* tv :
+       GpuLower::current()->circularBufferInfo().getCircularBufferTvs(
+           circular_buffer_loop)) {
+    auto it = multicast_dims_map.find(tv);
+    if (it != multicast_dims_map.end()) {
+      result.push_back(it->second);
+    }
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
 } // namespace nvfuser
@@ -94,4 +94,19 @@ std::unordered_map<TensorView*, const TMAInfo> getConsumerToTMAInfoMap(
 
 MmaInputSmemSwizzle getSwizzle(TensorView* tv);
 
+// Returns, for each TMA load circular buffered by a warp specialized loop, the
+// dimensions of the thread block cluster across which its tile is the same,
+// as a bitmask of x (1), y (2) and z (4). These tiles are multicast to the
+// blocks sharing them, see runtime/cluster.cu. Tiles are shared across a
+// dimension when the loop domain of the loaded tensor has no non-broadcast
+// IterDomain parallelized on it. Empty unless the scheduler sets
+// "tma_multicast" and "cluster_dims" as fusion-managed data. Depends on
+// CircularBufferInfo.
+std::unordered_map<const TensorView*, int64_t> getTmaMulticastDimsMap(
+    Fusion* fusion);
+
+// Returns the distinct multicast dimensions of the TMA loads circular buffered
+// by circular_buffer_loop, sorted.
+std::vector<int64_t> getTmaMulticastDims(ForLoop* circular_buffer_loop);
+
 } // namespace nvfuser
@@ -29,6 +29,7 @@
 #include <device_lower/pass/replace_size.h>
 #include <device_lower/pass/rng.h>
 #include <device_lower/pass/unroll.h>
+#include <device_lower/pass/unroll_budget.h>
 #include <device_lower/pass/vectorize_welford.h>
 #include <device_lower/pass/warp_reduce.h>
 #include <device_lower/utils.h>
@@ -39,8 +40,15 @@
 #include <instrumentation.h>
 #include <ir/iostream.h>
 #include <ir/utils.h>
+#include <runtime/compile_thread_pool.h>
+#include <utils.h>
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <iomanip>
 #include <list>
+#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -275,20 +283,27 @@ GpuLower::GpuLower(Fusion* fusion, const CompileParams& cparams)
            {"insertRawThreadSynchronization", insertRawThreadSynchronization},
            {"insertWarThreadSynchronization", insertWarThreadSynchronization},
            {"insertWarAsyncWait", insertWarAsyncWait},
+           {"removeRedundantThreadSynchronization",
+            removeRedundantThreadSynchronization},
            {"rotateLoops", rotateLoops},
            {"UnrollPass", UnrollPass::runPass},
+           {"selectMagicZeroLoops", selectMagicZeroLoops},
            {"IndexLowering", IndexLowering::getIndexedExprs},
+           {"capUnrollFactors", capUnrollFactors},
            {"fuseWarpReduce", fuseWarpReduce},
            {"generateConditionalFromPredicate",
             generateConditionalFromPredicate},
            {"vectorizeWelford", vectorizeWelford},
            {"addRNG", addRNG},
            {"allocateCommonScalars", allocateCommonScalars},
+           {"strengthReduceIndices", strengthReduceIndices},
            {"insertMagicZero", insertMagicZero},
            {"KIRCleaner", KIRCleaner::cleanUp},
-           {"instrumentKernel", instrumentKernel},
-           {"lowerToInlinePtx", lowerToInlinePtx}}),
+           {"lowerToInlinePtx", lowerToInlinePtx},
+           {"instrumentKernel", instrumentKernel}}),
       cparams_(cparams) {
+  profile_passes_ = isProfilerEnabled() ||
+      isDebugDumpEnabled(DebugDumpOption::LowerPassTimes);
   if (isDebugDumpEnabled(DebugDumpOption::FusionIrMath)) {
     fusion->printMath();
   }
@@ -301,23 +316,117 @@ GpuLower::GpuLower(Fusion* fusion, const CompileParams& cparams)
 
 namespace {
 struct LowerGuard {
-  LowerGuard(GpuLower* gpu_lower) {
+  LowerGuard(GpuLower* gpu_lower) : prev_gpu_lower_(active_gpu_lower) {
     active_gpu_lower = gpu_lower;
   }
   ~LowerGuard() {
-    active_gpu_lower = nullptr;
+    active_gpu_lower = prev_gpu_lower_;
   }
+
+ private:
+  GpuLower* prev_gpu_lower_;
+};
+
+// Runs analyses that only read the scheduled fusion concurrently on the
+// thread pool, enabled by EnableOption::ParallelLoweringAnalyses. The calling
+// thread runs the analyses no worker has started yet when waiting, so it
+// never waits for a pool saturated by lowering itself, e.g. in
+// compileFusionParallel. Without the option, add runs the analysis right
+// away.
+class ConcurrentAnalyses {
+ public:
+  ConcurrentAnalyses(GpuLower* gpu_lower, Fusion* fusion)
+      : gpu_lower_(gpu_lower),
+        fusion_(fusion),
+        concurrent_(isOptionEnabled(EnableOption::ParallelLoweringAnalyses)) {}
+
+  ConcurrentAnalyses(const ConcurrentAnalyses&) = delete;
+  ConcurrentAnalyses& operator=(const ConcurrentAnalyses&) = delete;
+
+  ~ConcurrentAnalyses() {
+    // Analyses of the pool may still reference GpuLower if the calling
+    // thread throws before waiting
+    for (const auto& task : tasks_) {
+      if (!task->claimed.exchange(true)) {
+        task->done.set_value();
+      }
+      task->future.wait();
+    }
+  }
+
+  void add(std::function<void()> analysis) {
+    if (!concurrent_) {
+      analysis();
+      return;
+    }
+    auto task = std::make_shared<Task>();
+    task->analysis = std::move(analysis);
+    task->future = task->done.get_future();
+    tasks_.push_back(task);
+    getThreadPool()->run([task, gpu_lower = gpu_lower_, fusion = fusion_]() {
+      if (task->claimed.exchange(true)) {
+        return;
+      }
+      FusionGuard fg(fusion);
+      LowerGuard lower_guard(gpu_lower);
+      run(*task);
+    });
+  }
+
+  //! Waits for all analyses and rethrows the first error
+  void wait() {
+    for (const auto& task : tasks_) {
+      if (!task->claimed.exchange(true)) {
+        run(*task);
+      }
+    }
+    for (const auto& task : tasks_) {
+      task->future.wait();
+    }
+    std::vector<std::shared_ptr<Task>> tasks;
+    std::swap(tasks, tasks_);
+    for (const auto& task : tasks) {
+      task->future.get();
+    }
+  }
+
+ private:
+  struct Task {
+    std::function<void()> analysis;
+    std::atomic<bool> claimed{false};
+    std::promise<void> done;
+    std::future<void> future;
+  };
+
+  static void run(Task& task) {
+    try {
+      task.analysis();
+      task.done.set_value();
+    } catch (...) {
+      task.done.set_exception(std::current_exception());
+    }
+  }
+
+  GpuLower* gpu_lower_;
+  Fusion* fusion_;
+  bool concurrent_;
+  std::vector<std::shared_ptr<Task>> tasks_;
 };
 
 } // namespace
 
 kir::Kernel* GpuLower::run() {
+  FUSER_PERF_SCOPE("GpuLower::run");
   FusionGuard fg(fusion_);
   LowerGuard lower_guard(this);
+  // Index expressions are often the same across the loop nests, so they are
+  // only simplified once per kernel.
+  ExprSimplifierCache expr_simplifier_cache;
+  pass_start_ = std::chrono::steady_clock::now();
   // Reorder expressions for loop-nest generation respecting computeAt
   // relationships
   auto exprs_lowered = reorderExprsForComputeAt();
-  dumpExprsIfEnabled(exprs_lowered, "reorderExprsForComputeAt");
+  finishPass(exprs_lowered, "reorderExprsForComputeAt");
 
   commonScalarMap().initialize(exprs_lowered);
 
@@ -327,10 +436,11 @@ kir::Kernel* GpuLower::run() {
   // computation of offset and seed to be considered as part of fusion
   // definition
   assignRNGOffset(fusion_);
+  finishPass(exprs_lowered, "assignRNGOffset");
 
   for (auto [name, pass] : passes()) {
     exprs_lowered = pass(exprs_lowered);
-    dumpExprsIfEnabled(exprs_lowered, name);
+    finishPass(exprs_lowered, name);
   }
 
   // We now have the lowered expressions, finalize the kernel IR. This function
@@ -338,9 +448,42 @@ kir::Kernel* GpuLower::run() {
   // GpuLower.
   kernel_->finalize(exprs_lowered);
 
+  if (isDebugDumpEnabled(DebugDumpOption::LowerPassTimes)) {
+    std::stringstream ss;
+    ss << "Lowering pass times:" << std::endl << std::fixed;
+    double total_ms = 0.0;
+    for (const LoweringPassProfile& prof : pass_profiles_) {
+      ss << std::setw(10) << std::setprecision(3) << prof.time_ms << " ms"
+         << std::setw(8) << prof.num_exprs << " exprs  " << prof.name
+         << std::endl;
+      total_ms += prof.time_ms;
+    }
+    ss << std::setw(10) << std::setprecision(3) << total_ms << " ms in total"
+       << std::endl;
+    debug() << ss.str();
+  }
+
   return kernel_.get();
 }
 
+void GpuLower::finishPass(
+    const std::vector<Expr*>& exprs,
+    const std::string& pass_name) {
+  if (!profile_passes_) {
+    dumpExprsIfEnabled(exprs, pass_name);
+    return;
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - pass_start_;
+  pass_profiles_.push_back(
+      {pass_name,
+       elapsed.count(),
+       std::ssize(ir_utils::flattenScopedExprs(exprs))});
+  dumpExprsIfEnabled(exprs, pass_name);
+  // Counting and dumping are not part of the next step
+  pass_start_ = std::chrono::steady_clock::now();
+}
+
 namespace {
 
 // Get IdModelOptions set through NVFUSER_ENABLE and overwritten for the
@@ -459,6 +602,7 @@ void GpuLower::analysis(Fusion* fusion) {
       active_gpu_lower == nullptr, "Nested lowering passes are not supported");
 
   LowerGuard lower_guard(this);
+  pass_start_ = std::chrono::steady_clock::now();
 
   // Use int64 by default as the kernel index type
   if (!cparams_.index_type.has_value()) {
@@ -470,11 +614,11 @@ void GpuLower::analysis(Fusion* fusion) {
   // Alias the fusion kernel caries around as a view of itself.
   fusion_ = kernel_.get();
 
-  dumpExprsIfEnabled(fusion_->exprs(), "initialize lowering");
+  finishPass(fusion_->exprs(), "initialize lowering");
 
   segmenterHintCleanup(fusion_);
   FusionGuard fg(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "segmenterHintCleanup");
+  finishPass(fusion_->exprs(), "segmenterHintCleanup");
 
   id_model_options_ = getIdModelOptions(fusion_);
 
@@ -484,25 +628,25 @@ void GpuLower::analysis(Fusion* fusion) {
   // change their use of fusion_->exprs() to only include exprs that are not
   // between inputs and allKnownVals()?
   allKnownVals() = kernel_->inputs();
-  dumpExprsIfEnabled(fusion_->exprs(), "set allKnownVals");
+  finishPass(fusion_->exprs(), "set allKnownVals");
 
   // prepare for lowering
   validateIr(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateIr");
+  finishPass(fusion_->exprs(), "validateIr");
 
   // Determines minimum device version necessary to compile and run this fusion.
   std::tie(min_device_version_, min_device_version_reason_) =
       MinimumDeviceVersion::compute(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "MinimumDeviceVersion");
+  finishPass(fusion_->exprs(), "MinimumDeviceVersion");
 
   // Checks if any TIDx dim is marked as padded to a warp. Also checks if we can
   // determine the padding is explicitly a single warp.
   collectPaddedParallelDims();
-  dumpExprsIfEnabled(fusion_->exprs(), "collectPaddedParallelDims");
+  finishPass(fusion_->exprs(), "collectPaddedParallelDims");
 
   // Replaces integers that are tensor sizes by named scalars as "T0.size[0]"
   replaceSymbolicSizes(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "replaceSymbolicSizes");
+  finishPass(fusion_->exprs(), "replaceSymbolicSizes");
 
   // New IterDomains may be created, so it is expected that generated
   // code may use diffrent variable names
@@ -513,6 +657,7 @@ void GpuLower::analysis(Fusion* fusion) {
         /*allow_self_mapping=*/false,
         /*validate=*/false);
     id_model_->validateAndPropagatePType();
+    finishPass(fusion_->exprs(), "build IdModel");
   }
 
   // Build what's refered to as the compute at map. This map contains the
@@ -522,120 +667,138 @@ void GpuLower::analysis(Fusion* fusion) {
   //
   // Depends on IdModel
   compute_at_map_ = std::make_shared<ComputeAtMap>(fusion_);
+  finishPass(fusion_->exprs(), "build ComputeAtMap");
 
   // Requires IdModel as expression sorting is necessary
   resolveComputeWith(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "resolveComputeWith");
+  finishPass(fusion_->exprs(), "resolveComputeWith");
 
   if (isDebugDumpEnabled(DebugDumpOption::ComputeAtMap)) {
     debug() << compute_at_map_->toString() << std::endl;
   }
   compute_at_map_->validateAndPropagatePType();
-  dumpExprsIfEnabled(fusion_->exprs(), "validateAndPropagatePType");
+  finishPass(fusion_->exprs(), "validateAndPropagatePType");
 
   // Uses compute_at_map, find all splits that are enforced to be divisible
   divisible_splits_ = getAllDivisibleSplits(fusion_, compute_at_map_.get());
-  dumpExprsIfEnabled(fusion_->exprs(), "getAllDivisibleSplits");
+  finishPass(fusion_->exprs(), "getAllDivisibleSplits");
 
   // Used in parallel dimension map
   concretized_broadcast_domains_ =
       std::make_shared<const ConcretizedBroadcastDomains>(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "build ConcretizedBroadcastDomains");
+  finishPass(fusion_->exprs(), "build ConcretizedBroadcastDomains");
 
   parallelDimensionMap().build(fusion_);
   if (isDebugDumpEnabled(DebugDumpOption::ParallelDimensions)) {
     debug() << "Parallel dimension map:" << std::endl;
     debug() << parallel_dimension_map_.toString() << std::endl;
   }
-  dumpExprsIfEnabled(fusion_->exprs(), "build parallelDimensionMap");
+  finishPass(fusion_->exprs(), "build parallelDimensionMap");
 
   validate1dTmaLoad(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validate1dTmaLoad");
+  finishPass(fusion_->exprs(), "validate1dTmaLoad");
 
   // Validate mma data format and compatibility if any on the fusion.
   validateMma(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateMma");
+  finishPass(fusion_->exprs(), "validateMma");
 
   // Validate swizzle usage on the fusion schedule.
   validateSwizzle(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateSwizzle");
+  finishPass(fusion_->exprs(), "validateSwizzle");
 
   validateReductions(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateReductions");
+  finishPass(fusion_->exprs(), "validateReductions");
 
   // Compute thread predicates. Depends on parallel_dimension_map_
   thread_pred_map_.build(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "build thread_pred_map_");
+  finishPass(fusion_->exprs(), "build thread_pred_map_");
 
   // Fuse cetain patterns of reductions, such as a grid reduction
   // followed by a grid broadcast. Only depends on parallelization and
   // thread predicate map.
   fuseReductionsAndBroadcasts(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "fuseReductionsAndBroadcasts");
+  finishPass(fusion_->exprs(), "fuseReductionsAndBroadcasts");
 
   // Depends on ComputeAtMap
   validateAndConvertIterDomainGrouping(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateAndConvertIterDomainGrouping");
+  finishPass(fusion_->exprs(), "validateAndConvertIterDomainGrouping");
 
   // Assumes all grouped reductions are convered to
   // GroupedReductionOp, which is done by
   // validateAndConvertIterDomainGrouping
   validateGroupedReductions(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateGroupedReductions");
+  finishPass(fusion_->exprs(), "validateGroupedReductions");
 
   // Want to run this after parallel map is created.
   // Needs info about grouped reductions.
   // vectorized_accesses_ and vectorized_set_info_ are filled.
   validateAndCollectVectorizeInfo(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateAndCollectVectorizeInfo");
+  finishPass(fusion_->exprs(), "validateAndCollectVectorizeInfo");
 
   // all of the lookup TVs are fusion inputs
   validateLookupTV(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "validateLookupTV");
+  finishPass(fusion_->exprs(), "validateLookupTV");
 
   // Find trivial global to global broadcast, squeeze, and set operations and
   // mark their outputs as aliases of their inputs.
   findTensorProducerAliases(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "findTensorProducerAliases");
+  finishPass(fusion_->exprs(), "findTensorProducerAliases");
+
+  {
+    // SyncMap and CircularBufferInfo only read the fusion and the maps built
+    // above, so they can run next to NonDivisibleSplitInfo, which creates
+    // the divisibility checks of splits on this thread.
+    ConcurrentAnalyses analyses(this, fusion_);
 
-  // Depends on thread_pred_map_, validates parallelization collects which
-  // tensor views need WAR or RAW syncs
-  sync_map_ = std::make_shared<const SyncMap>(fusion_);
+    // Depends on thread_pred_map_, validates parallelization collects which
+    // tensor views need WAR or RAW syncs
+    analyses.add(
+        [this]() { sync_map_ = std::make_shared<const SyncMap>(fusion_); });
+
+    analyses.add([this]() { circularBufferInfo().build(fusion_); });
+
+    non_divisible_split_info_ =
+        std::make_unique<NonDivisibleSplitInfo>(fusion_);
+
+    analyses.wait();
+  }
   if (isDebugDumpEnabled(DebugDumpOption::SyncMap)) {
     debug() << sync_map_->toString() << std::endl;
   }
-  dumpExprsIfEnabled(fusion_->exprs(), "SyncMap");
-
-  non_divisible_split_info_ = std::make_unique<NonDivisibleSplitInfo>(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "build nonDivisibleSplitInfo");
-
-  circularBufferInfo().build(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "build circularBufferInfo");
+  finishPass(
+      fusion_->exprs(),
+      "SyncMap, build nonDivisibleSplitInfo and build circularBufferInfo");
 
   compute_at_map_->allocateIndexVariables();
-  dumpExprsIfEnabled(fusion_->exprs(), "allocateIndexVariables");
+  finishPass(fusion_->exprs(), "allocateIndexVariables");
 
   if (idModelOptions().loop()) {
     // Depends on CircularBufferInfo and compute_at_map_->allocateIndexVariables
     id_model_->allocateLoopIndexVariables();
+    finishPass(fusion_->exprs(), "allocateLoopIndexVariables of IdModel");
   }
 
   if (idModelOptions().buildTensorIndexer()) {
     tensor_indexer_ = std::make_unique<TensorIndexer>(*id_model_);
     non_divisible_predicate_info_ =
         std::make_unique<NonDivisiblePredicateInfo>(fusion_);
+    finishPass(fusion_->exprs(), "build TensorIndexer");
   }
 
   // Detects all exprssions that don't need predicates. Depends on
   // nonDivisibleSplitInfo.
   pred_elimination_ = std::make_unique<PredicateElimination>(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "build predicateElimination");
+  finishPass(fusion_->exprs(), "build predicateElimination");
 
   consumerToTMAInfo() = getConsumerToTMAInfoMap(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "getConsumerToTMAInfoMap");
+  finishPass(fusion_->exprs(), "getConsumerToTMAInfoMap");
+
+  // Depends on CircularBufferInfo
+  tmaMulticastDims() = getTmaMulticastDimsMap(fusion_);
+  finishPass(fusion_->exprs(), "getTmaMulticastDimsMap");
 
   tmemInfo() = computeTMemInfo(fusion_);
-  dumpExprsIfEnabled(fusion_->exprs(), "computeTMemInfo");
+  finishPass(fusion_->exprs(), "computeTMemInfo");
 }
 
 kir::Kernel* GpuLower::kernel() const {
@@ -740,4 +903,19 @@ const AllocationDomainInfo& GpuLower::getAllocationInfo(TensorView* tv) const {
   return it->second;
 }
 
+bool GpuLower::isInt32Indexed(const TensorView* tv) const {
+  if (cparams_.int32_indexed_inputs.empty() ||
+      indexType() != PrimDataType::Int || !tv->isFusionInput()) {
+    return false;
+  }
+  const std::vector<Val*>& inputs = kernel_->inputs();
+  auto it = std::find(inputs.begin(), inputs.end(), tv);
+  NVF_ERROR(it != inputs.end(), "Not a kernel input: ", tv->toString());
+  const int64_t pos = std::distance(inputs.begin(), it);
+  return std::find(
+             cparams_.int32_indexed_inputs.begin(),
+             cparams_.int32_indexed_inputs.end(),
+             pos) != cparams_.int32_indexed_inputs.end();
+}
+
 } // namespace nvfuser
@@ -27,6 +27,7 @@
 #include <device_lower/pass/warp_reduce.h>
 #include <exceptions.h>
 #include <expr_simplifier.h>
+#include <fusion_profiler.h>
 #include <id_model/id_model.h>
 #include <id_model/indexing.h>
 #include <ir/all_nodes.h>
@@ -39,6 +40,7 @@
 #include <vectorization_info.h>
 #include <visibility.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -240,6 +242,11 @@ class GpuLower : public NonCopyable {
     return mbarrier_map_;
   }
 
+  //! Returns whether tv is a fusion input listed in
+  //! CompileParams::int32_indexed_inputs, whose global offsets are computed
+  //! with 32-bit arithmetic in a kernel with 64-bit indexing
+  bool isInt32Indexed(const TensorView* tv) const;
+
   bool isNvFuserZeroEnabled() {
     if (isOptionDisabled(DisableOption::MagicZero)) {
       return false;
@@ -285,6 +292,15 @@ class GpuLower : public NonCopyable {
     return consumer_to_tma_info_;
   }
 
+  std::unordered_map<const TensorView*, int64_t>& tmaMulticastDims() {
+    return tma_multicast_dims_;
+  }
+
+  const std::unordered_map<const TensorView*, int64_t>& tmaMulticastDims()
+      const {
+    return tma_multicast_dims_;
+  }
+
   const TensorMemoryInfo& tmemInfo() const {
     return tmem_info_;
   }
@@ -301,6 +317,22 @@ class GpuLower : public NonCopyable {
     return dec_inc_register_usage;
   }
 
+  int64_t estimatedInstructionCount() const {
+    return estimated_instruction_count_;
+  }
+
+  int64_t& estimatedInstructionCount() {
+    return estimated_instruction_count_;
+  }
+
+  const std::unordered_set<IterDomain*>& magicZeroFreeLoops() const {
+    return magic_zero_free_loops_;
+  }
+
+  std::unordered_set<IterDomain*>& magicZeroFreeLoops() {
+    return magic_zero_free_loops_;
+  }
+
   // Register a boolean Val as a predicate to validate at the run time. Optional
   // validation error messages can be given as args.
   template <typename... Args>
@@ -379,9 +411,23 @@ class GpuLower : public NonCopyable {
     return alias_tv == nullptr ? tv : alias_tv;
   }
 
+  //! Host time and IR size of each step of the analysis and of run, in
+  //! order. Only recorded when the FusionProfiler or
+  //! DebugDumpOption::LowerPassTimes is enabled.
+  const std::vector<LoweringPassProfile>& passProfiles() const {
+    return pass_profiles_;
+  }
+
  private:
   void analysis(Fusion* fusion);
 
+  // Marks the end of the lowering step pass_name, after which the IR consists
+  // of exprs. Dumps exprs if requested and records the time since the end of
+  // the previous step.
+  void finishPass(
+      const std::vector<Expr*>& exprs,
+      const std::string& pass_name);
+
   // Goes through the parallelized iterdomains of the used TVs and find
   //  the parallel dimensions that need to be padded to a multiples of
   //  warp size.
@@ -425,8 +471,16 @@ class GpuLower : public NonCopyable {
   std::unique_ptr<IdModel> id_model_;
   std::unique_ptr<TensorIndexer> tensor_indexer_;
   std::unordered_map<TensorView*, const TMAInfo> consumer_to_tma_info_;
+  std::unordered_map<const TensorView*, int64_t> tma_multicast_dims_;
   std::pair<int64_t, int64_t> dec_inc_register_usage = {-1, -1};
 
+  // Number of SASS instructions of the kernel estimated by capUnrollFactors
+  int64_t estimated_instruction_count_ = 0;
+
+  // Iter domains of the unrolled loops whose indices are not protected with
+  // magic zero, see selectMagicZeroLoops
+  std::unordered_set<IterDomain*> magic_zero_free_loops_;
+
   // Track which tensor views are inputs or outputs of a vectorized operation
   // and their maximum vectorized access size
   // std::unordered_map<TensorView*, VectorizationInfo> vectorized_accesses_;
@@ -459,6 +513,11 @@ class GpuLower : public NonCopyable {
 
   // A temporary option set to selectively enable IdModel usage
   IdModelOptions id_model_options_;
+
+  // See passProfiles()
+  bool profile_passes_ = false;
+  std::chrono::steady_clock::time_point pass_start_;
+  std::vector<LoweringPassProfile> pass_profiles_;
 };
 
 #define NVFUSER_LOWER_VALIDATE(cond, ...) \
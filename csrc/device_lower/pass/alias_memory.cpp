@@ -1188,6 +1188,10 @@ class ReusableAllocationFinder : private kir::IrVisitor {
         }
 
         // Check if this alloc has the same data type
+        const int64_t dtype_size = dataTypeSizeByte(
+            alloc_info->data_type, GpuLower::current()->indexType());
+        const int64_t reuse_dtype_size = dataTypeSizeByte(
+            alloc_to_reuse->data_type, GpuLower::current()->indexType());
         if (alloc_info->mem_type == MemoryType::Local &&
             isOptionDisabled(DisableOption::ReuseMismatchedTypeRegisters)) {
           // With this option, registers must have exactly matching dtypes in
@@ -1195,14 +1199,18 @@ class ReusableAllocationFinder : private kir::IrVisitor {
           if (alloc_info->data_type != alloc_to_reuse->data_type) {
             continue;
           }
-        } else if (
-            dataTypeSizeByte(
-                alloc_info->data_type, GpuLower::current()->indexType()) !=
-            dataTypeSizeByte(
-                alloc_to_reuse->data_type, GpuLower::current()->indexType())) {
-          // Behavior for shared or global memory and default behavior for
-          // registers is to re-use if dtypes have same size.
-          continue;
+        } else if (dtype_size != reuse_dtype_size) {
+          // Behavior for shared or global memory is to re-use if dtypes have
+          // same size. Registers can also hold a tensor with the same number
+          // of elements of a smaller dtype, e.g., the bf16 copy of an fp32
+          // persistent buffer. That's only safe when the live intervals don't
+          // overlap at all. With inner sharing, writing an element of the
+          // smaller dtype would clobber bytes of an element of the larger
+          // dtype that may not be read yet.
+          if (alloc_info->mem_type != MemoryType::Local ||
+              inner_aliasing_pass_ || dtype_size > reuse_dtype_size) {
+            continue;
+          }
         }
 
         // Check if live intervals have any overlap
@@ -1239,7 +1247,7 @@ class ReusableAllocationFinder : private kir::IrVisitor {
 
           // Vectorized allocations require correct alignment so if [this_tv]
           // is vectorized, the [reuse_tv] must be vectorized with the same
-          // or smaller factor.
+          // or a wider access in bytes.
           // No need to check shared memory since it is always aligned to 16
           // Bytes which is also the maximum vectorization width.
           if (this_tv->getMemoryType() == MemoryType::Local) {
@@ -1250,8 +1258,8 @@ class ReusableAllocationFinder : private kir::IrVisitor {
               if (!reuse_tv_vectorized) {
                 return false;
               }
-              int64_t this_tv_alignment = va.at(this_tv);
-              int64_t reuse_tv_alignment = va.at(reuse_tv);
+              int64_t this_tv_alignment = va.at(this_tv) * dtype_size;
+              int64_t reuse_tv_alignment = va.at(reuse_tv) * reuse_dtype_size;
               if (this_tv_alignment > reuse_tv_alignment) {
                 return false;
               }
@@ -1694,6 +1702,12 @@ class StackBasedSharedMemAllocator : kir::IrVisitor {
     sortPushAndAssignWaiting();
   }
 
+  //! Addresses assigned by allocate(). They are set to the Allocate exprs by
+  //! assignSharedMemoryAllocations.
+  const std::unordered_map<AllocationInfo*, Val*>& addresses() const {
+    return addresses_;
+  }
+
  private:
   void dispatch(Expr* expr) final {
     position_ = allocation_info_map_.getScopeMap().getExprPos(expr);
@@ -1763,22 +1777,22 @@ class StackBasedSharedMemAllocator : kir::IrVisitor {
 
   void assignNextAddress(AllocationInfo* alloc_info) {
     auto alloc = alloc_info->alloc_expr;
+    Val* address = nullptr;
     if (alloc_stack_.empty()) {
-      alloc->setAddress(FusionGuard::getCurFusion()->zeroVal());
+      address = FusionGuard::getCurFusion()->zeroVal();
     } else {
-      auto top_alloc = alloc_stack_.back()->alloc_expr;
-      auto top_size = allocSizeBytes(top_alloc);
+      AllocationInfo* top_info = alloc_stack_.back();
+      auto top_size = allocSizeBytes(top_info->alloc_expr);
       auto unaligned_address =
-          SimplifyingIrBuilder::addExpr(top_alloc->address(), top_size);
+          SimplifyingIrBuilder::addExpr(addresses_.at(top_info), top_size);
       // Shared memory allocations must by 128B aligned for cpAsyncBulk
       // operations to avoid CUDA_ERROR_MISALIGNED_ADDRESS.
-      auto aligned_address =
-          alignExpr(unaligned_address, alloc_info->alignment);
       // TODO: hoisting of addresses using for_loops_ recorded at first write
-      alloc->setAddress(aligned_address);
+      address = alignExpr(unaligned_address, alloc_info->alignment);
     }
+    addresses_[alloc_info] = address;
     if (isDebugDumpEnabled(DebugDumpOption::BufferReuseInfo)) {
-      debug() << "Assigned address " << alloc->address()->toInlineString()
+      debug() << "Assigned address " << address->toInlineString()
               << " for T" << alloc->buffer()->name() << " with size "
               << alloc->size()->toInlineString() << " * "
               << dataTypeSizeByte(alloc->buffer()->dtype()) << " bytes"
@@ -1844,7 +1858,8 @@ class StackBasedSharedMemAllocator : kir::IrVisitor {
           auto alloc = alloc_stack_.back()->alloc_expr;
           debug() << "Popping allocation for T" << alloc->buffer()->name()
                   << " which has assigned address "
-                  << alloc->address()->toInlineString() << std::endl;
+                  << addresses_.at(alloc_stack_.back())->toInlineString()
+                  << std::endl;
         }
         alloc_stack_.pop_back();
       } else {
@@ -1881,6 +1896,163 @@ class StackBasedSharedMemAllocator : kir::IrVisitor {
   // At the last moment, i.e. when one of them needs to be popped, we sort these
   // in descending order of their last read, and push them onto the stack.
   std::vector<AllocationInfo*> waiting_to_push_;
+
+  // Assigned address of each allocation that is not an alias
+  std::unordered_map<AllocationInfo*, Val*> addresses_;
+};
+
+//! Assign addresses to shared memory allocations of static sizes by offset
+//! assignment over their live intervals, like a register allocator coloring
+//! an interval graph. Two allocations interfere, i.e., must not overlap in
+//! memory, unless the last read of the earlier one and the first write of the
+//! later one are separated by a block sync. This is the condition under which
+//! StackBasedSharedMemAllocator reclaims memory, so no new syncs are needed.
+//!
+//! Allocations are placed in decreasing order of size at the lowest offset
+//! that is aligned as required, e.g., for TMA and swizzling, and does not
+//! overlap any interfering allocation placed before. In contrast to the stack,
+//! memory below an allocation that is still live can be reused. For example,
+//! when a buffer B is pushed while still live and a long-lived buffer A is
+//! pushed on top of it, the stack cannot reclaim B until A is popped, so a
+//! buffer C written after the last read of B is placed above A. Here, C can
+//! take the memory of B as long as a block sync separates them.
+class IntervalSharedMemAllocator : kir::IrVisitor {
+ public:
+  IntervalSharedMemAllocator(const AllocationInfoMap& allocation_info_map)
+      : allocation_info_map_(allocation_info_map) {}
+
+  //! Returns false if any size is not static, in which case no address is
+  //! assigned
+  bool allocate(const std::vector<Expr*>& exprs) {
+    for (auto& alloc_info : allocation_info_map_.allAllocationInfos()) {
+      if (alloc_info->mem_type != MemoryType::Shared || alloc_info->alias_to) {
+        continue;
+      }
+      Val* size = allocSizeBytes(alloc_info->alloc_expr);
+      if (!size->isConstInt()) {
+        return false;
+      }
+      intervals_.push_back(
+          {alloc_info.get(),
+           alloc_info->outer_live_interval->firstWrite(),
+           alloc_info->getAliasedOuterLastRead(),
+           size->evaluate().as<int64_t>()});
+    }
+
+    handle(exprs);
+
+    std::vector<Interval*> sorted;
+    sorted.reserve(intervals_.size());
+    for (Interval& interval : intervals_) {
+      sorted.push_back(&interval);
+    }
+    // Place large allocations first. Break ties so that allocations will be
+    // deterministic.
+    std::sort(sorted.begin(), sorted.end(), [](Interval* a, Interval* b) {
+      if (a->size != b->size) {
+        return a->size > b->size;
+      }
+      if (a->first_write != b->first_write) {
+        return a->first_write < b->first_write;
+      }
+      return a->alloc_info->alloc_expr->name() <
+          b->alloc_info->alloc_expr->name();
+    });
+
+    std::vector<Interval*> placed;
+    for (Interval* interval : sorted) {
+      place(interval, placed);
+      placed.push_back(interval);
+    }
+    return true;
+  }
+
+  //! Bytes of shared memory used by the assigned addresses
+  int64_t totalBytes() const {
+    int64_t total = 0;
+    for (const Interval& interval : intervals_) {
+      total = std::max(total, interval.offset + interval.size);
+    }
+    return total;
+  }
+
+  std::unordered_map<AllocationInfo*, int64_t> addresses() const {
+    std::unordered_map<AllocationInfo*, int64_t> addresses;
+    for (const Interval& interval : intervals_) {
+      addresses.emplace(interval.alloc_info, interval.offset);
+    }
+    return addresses;
+  }
+
+ private:
+  struct Interval {
+    AllocationInfo* alloc_info = nullptr;
+    int64_t first_write = -1;
+    int64_t last_read = -1;
+    int64_t size = 0;
+    int64_t offset = -1;
+  };
+
+  void dispatch(Expr* expr) final {
+    if (lower_utils::hasBlockSync(expr, GpuLower::current()->threadPredMap())) {
+      sync_positions_.push_back(
+          allocation_info_map_.getScopeMap().getExprPos(expr));
+    }
+    kir::IrVisitor::dispatch(expr);
+  }
+
+  bool interfere(const Interval* a, const Interval* b) const {
+    if (a->first_write > b->first_write) {
+      std::swap(a, b);
+    }
+    if (b->first_write <= a->last_read) {
+      return true;
+    }
+    // Sync positions are recorded in program order
+    auto sync_it = std::lower_bound(
+        sync_positions_.begin(), sync_positions_.end(), a->last_read);
+    return sync_it == sync_positions_.end() || *sync_it >= b->first_write;
+  }
+
+  //! Assign the lowest aligned offset at which interval does not overlap
+  //! any interfering allocation in placed
+  void place(Interval* interval, const std::vector<Interval*>& placed) const {
+    std::vector<const Interval*> interfering;
+    for (const Interval* other : placed) {
+      if (interfere(interval, other)) {
+        interfering.push_back(other);
+      }
+    }
+    std::sort(
+        interfering.begin(),
+        interfering.end(),
+        [](const Interval* a, const Interval* b) {
+          return a->offset < b->offset;
+        });
+
+    const int64_t alignment = interval->alloc_info->alignment;
+    int64_t offset = 0;
+    for (const Interval* other : interfering) {
+      if (offset + interval->size <= other->offset) {
+        break;
+      }
+      offset =
+          std::max(offset, alignUp(other->offset + other->size, alignment));
+    }
+    interval->offset = offset;
+  }
+
+  static int64_t alignUp(int64_t addr, int64_t alignment) {
+    return (addr + alignment - 1) / alignment * alignment;
+  }
+
+ private:
+  const AllocationInfoMap& allocation_info_map_;
+
+  std::vector<Interval> intervals_;
+
+  // Positions of the exprs that synchronize the thread block
+  std::vector<int64_t> sync_positions_;
 };
 
 } // namespace
@@ -2088,7 +2260,39 @@ std::pair<std::vector<Expr*>, bool> promoteReuseSyncs(
 void assignSharedMemoryAllocations(
     const std::vector<Expr*>& exprs,
     AllocationInfoMap& allocation_info_map) {
-  StackBasedSharedMemAllocator(allocation_info_map).allocate(exprs);
+  StackBasedSharedMemAllocator stack_allocator(allocation_info_map);
+  stack_allocator.allocate(exprs);
+  std::unordered_map<AllocationInfo*, Val*> addresses =
+      stack_allocator.addresses();
+
+  // With static sizes, use the interval packing if it needs less memory
+  if (isOptionEnabled(EnableOption::PackSharedMemory)) {
+    IntervalSharedMemAllocator interval_allocator(allocation_info_map);
+    if (interval_allocator.allocate(exprs)) {
+      int64_t stack_bytes = 0;
+      for (auto [alloc_info, address] : addresses) {
+        const int64_t end = address->evaluate().as<int64_t>() +
+            allocSizeBytes(alloc_info->alloc_expr)->evaluate().as<int64_t>();
+        stack_bytes = std::max(stack_bytes, end);
+      }
+      const int64_t packed_bytes = interval_allocator.totalBytes();
+      if (isDebugDumpEnabled(DebugDumpOption::BufferReuseInfo)) {
+        debug() << "Shared memory of the stack allocation: " << stack_bytes
+                << " bytes, of the interval packing: " << packed_bytes
+                << " bytes" << std::endl;
+      }
+      if (packed_bytes < stack_bytes) {
+        for (auto [alloc_info, offset] : interval_allocator.addresses()) {
+          addresses[alloc_info] =
+              IrBuilder::create<Val>(offset, DataType::Index);
+        }
+      }
+    }
+  }
+
+  for (auto [alloc_info, address] : addresses) {
+    alloc_info->alloc_expr->setAddress(address);
+  }
 
   // Verify that all smem allocations have a non-null address now
   for (auto& alloc_info : allocation_info_map.allAllocationInfos()) {
@@ -869,6 +869,26 @@ ForLoop* createStageDepthForLoop(ForLoop* circular_buffer_loop) {
   return ir_utils::createRangeLoop(stage_depth);
 }
 
+// Synchronizes the threads of the thread block cluster. With
+// fence_mbarrier_init, the mbarriers initialized before are visible to the
+// other blocks of the cluster once they are past the synchronization.
+std::vector<Expr*> createClusterSync(bool fence_mbarrier_init) {
+  std::vector<Expr*> exprs;
+  auto add_asm = [&exprs](const std::string& code) {
+    exprs.push_back(IrBuilder::create<kir::Asm>(
+        code,
+        std::vector<Val*>{},
+        std::vector<Val*>{},
+        kir::Asm::Options{/*volatile=*/true, /*memory=*/true}));
+  };
+  if (fence_mbarrier_init) {
+    add_asm("fence.mbarrier_init.release.cluster");
+  }
+  add_asm("barrier.cluster.arrive.aligned");
+  add_asm("barrier.cluster.wait.aligned");
+  return exprs;
+}
+
 // This helper function initializes mbarrier for all circular buffer stage.
 //
 // Expected result:
@@ -905,6 +925,7 @@ Expr* initializeMbarrier(
           circular_buffer_loop);
 
   Val* num_of_arrives = nullptr;
+  std::vector<int64_t> multicast_dims;
   if (wait_type == CircularBufferWaitType::ReadAfterWrite) {
     // The mbarrier of RAW is used to wait for the completion of the TMA
     // load of the circular buffer tensor. The number of arrives is the
@@ -926,14 +947,17 @@ Expr* initializeMbarrier(
         GpuLower::current()
             ->parallelDimensionMap()
             .getNumComputeThreadsEachBlock());
+    // The leaders of tiles multicast across the cluster also wait for the
+    // threads of the blocks they multicast to
+    multicast_dims = getTmaMulticastDims(circular_buffer_loop);
   }
 
   // Initialize mbarrier for each circular buffer stage. Use the thread
   // count from the MBarrierInit created in the allocation pass. The wait
   // condition for mbarrier is a all threads in CTA and the expected number
   // of transaction bytes
-  kir::MBarrierInit* mbarrier_init =
-      IrBuilder::create<kir::MBarrierInit>(stage_mbarrier, num_of_arrives);
+  kir::MBarrierInit* mbarrier_init = IrBuilder::create<kir::MBarrierInit>(
+      stage_mbarrier, num_of_arrives, multicast_dims);
 
   Expr* pred_mbarrier_init = mbarrier_init->withPredicate(
       IrBuilder::create<kir::Predicate>(PredicateType::ElectSync));
@@ -1207,7 +1231,12 @@ class AllocationInserter : public kir::ExprMutator {
             default_val == nullptr,
             "Reduction should not have a default initialization value for "
             "predicate elimination.");
-        init = expr->as<ReductionOp>()->init();
+        // The output of an atomic grid reduction is initialized before the
+        // launch, as the blocks may write to it before others would
+        // initialize it
+        if (!expr->as<ReductionOp>()->atomicGridReductionRequested()) {
+          init = expr->as<ReductionOp>()->init();
+        }
       } else if (expr->isA<GroupedReductionOp>() && out_tv->hasReduction()) {
         NVF_ERROR(
             default_val == nullptr,
@@ -1490,6 +1519,29 @@ class AllocationInserter : public kir::ExprMutator {
       }
       registerInsertBefore(fl, sync, current_scope);
 
+      // The blocks of a cluster multicasting tiles write to the shared memory
+      // of each other and arrive at the mbarriers of each other. The
+      // mbarriers must then be initialized in all of them before the loop,
+      // and none of them may invalidate its mbarriers, or exit, before the
+      // others are done with the loop:
+      //
+      // block_sync();
+      // cluster_sync(); // with a fence of the mbarrier initialization
+      // for (circular_buffer_loop) { ... }
+      // cluster_sync();
+      // inval(mbarrier[stage]);
+      if (!getTmaMulticastDims(fl).empty()) {
+        for (Expr* expr : createClusterSync(/*fence_mbarrier_init=*/true)) {
+          registerInsertBefore(fl, expr, current_scope);
+        }
+        // Each insertion after fl precedes the previous ones
+        std::vector<Expr*> final_sync =
+            createClusterSync(/*fence_mbarrier_init=*/false);
+        for (auto it = final_sync.rbegin(); it != final_sync.rend(); ++it) {
+          registerInsertAfter(fl, *it, current_scope);
+        }
+      }
+
       for (auto tv : circular_buffer_tvs) {
         // short-circuit: circular buffered tv is not defined with TMA load.
         if (!ir_utils::isCpAsyncBulkLoad(tv->definition())) {
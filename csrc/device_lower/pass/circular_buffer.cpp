@@ -1074,9 +1074,13 @@ class CloneTmaCircularBufferLoopAndInsertSync
     kir::TensorIndex* stage_mbarrier = IrBuilder::create<kir::TensorIndex>(
         all_mbarriers,
         SimplifyingIrBuilder::addExpr(currentCompletionStage(), stage_depth));
+    // Tiles multicast across the cluster are also released to the blocks
+    // multicasting them
     kir::MBarrierArrive* mbarrier_arrive =
         IrBuilder::create<kir::MBarrierArrive>(
-            /*state=*/nullptr, stage_mbarrier);
+            /*state=*/nullptr,
+            stage_mbarrier,
+            getTmaMulticastDims(circular_buffer_loop_));
     return mbarrier_arrive;
   }
 
@@ -1474,13 +1478,15 @@ ForLoop* createArrivesForWar(ForLoop* circular_buffer_loop) {
     prefetch_loop->body().push_back(ite);
   }
 
+  std::vector<int64_t> multicast_dims =
+      getTmaMulticastDims(circular_buffer_loop);
   for (auto mbarrier : mbarriers) {
     auto mbarrier_to_arrive = IrBuilder::create<kir::TensorIndex>(
         mbarrier,
         SimplifyingIrBuilder::addExpr(
             prefetch_loop->indexOrStartIfTrivial(), opt.stage));
     auto prefetch = IrBuilder::create<kir::MBarrierArrive>(
-        /*state=*/nullptr, mbarrier_to_arrive);
+        /*state=*/nullptr, mbarrier_to_arrive, multicast_dims);
     if (ite != nullptr) {
       ite->thenBody().push_back(prefetch);
     } else {
@@ -317,6 +317,10 @@ class ExprSegmentationSorter {
 
   bool hasCADomains(const std::unordered_set<IterDomain*>& domains) const;
 
+  // Adds the compute at domains of group to ca_domain_counts_, or removes
+  // them if count is negative
+  void countCADomains(ExprGroup* group, int64_t count);
+
   // Checks if the for loop associated with the concrete ID is ready to be
   // resolved in sorting.
   bool loopReady(IterDomain* concrete_id) const;
@@ -388,6 +392,11 @@ class ExprSegmentationSorter {
   std::unordered_map<IterDomain*, std::unordered_set<IterDomain*>>
       concrete_id_dependencies_;
 
+  // Number of occurrences of each ID in the compute at domains of all
+  // groups, so that loopReady doesn't traverse every group for each merge
+  // candidate, which is quadratic in the number of expressions
+  std::unordered_map<IterDomain*, int64_t> ca_domain_counts_;
+
   // ID representing the outermost scope of the kernel being
   // generated. We may want to have this defined in the Kernel
   // container itself, but for now just define here as it's only used
@@ -606,47 +615,34 @@ void ExprSegmentationSorter::resetTraversal() {
 // Level is maximum distance from inputs. It's the metric used to select what
 // nodes can be merged while maintaining a DAG
 void ExprSegmentationSorter::resetLevels() {
-  std::vector<ExprGroup*> next_to_visit;
+  // Groups are visited once all of their producers are, so that each group
+  // and each edge is traversed only once
+  std::unordered_map<ExprGroup*, size_t> num_unvisited_producers;
+  size_t num_visited = 0;
 
   while (!to_visit_.empty()) {
     auto visit = to_visit_.front();
     to_visit_.pop_front();
 
-    // All inputs processed?
-    bool ready = true;
-    if (!visit->producerEdges().empty()) {
-      ready = std::all_of(
-          visit->producerEdges().begin(),
-          visit->producerEdges().end(),
-          [&](ExprGroupConnections* dep) {
-            return dep->from->payload()->visited;
-          });
-    }
-
-    if (!ready) {
-      // In case traversal doesn't complete because there's an error in the
-      // DAG topology.
-      next_to_visit.push_back(visit);
-      continue;
-    }
-
     visit->payload()->visited = true;
-
-    to_visit_.insert(
-        to_visit_.end(), next_to_visit.begin(), next_to_visit.end());
-    next_to_visit.clear();
-
-    for (auto out : visit->consumerEdges()) {
-      to_visit_.push_back(out->to);
-    }
+    num_visited++;
 
     visit->payload()->level = 0;
     for (auto inp : visit->producerEdges()) {
       visit->payload()->level =
           std::max(visit->payload()->level, inp->from->payload()->level + 1);
     }
+
+    for (auto out : visit->consumerEdges()) {
+      auto it = num_unvisited_producers
+                    .try_emplace(out->to, out->to->producerEdges().size())
+                    .first;
+      if (--it->second == 0) {
+        to_visit_.push_back(out->to);
+      }
+    }
   }
-  NVF_ERROR(next_to_visit.empty(), "Error in graph, is not a DAG.");
+  NVF_ERROR(num_visited == groups_.size(), "Error in graph, is not a DAG.");
 }
 
 ExprGroup* ExprSegmentationSorter::makeEmptyGroup(bool is_scalar_only) {
@@ -688,6 +684,7 @@ ExprGroup* ExprSegmentationSorter::makeEmptyGroup(
       group->payload()->pa_domains.push_back(concrete_id);
     }
   }
+  countCADomains(group, 1);
   return group;
 }
 
@@ -980,6 +977,7 @@ ExprGroup* ExprSegmentationSorter::makeMergedNode(
       joined_groups->payload()->pa_domains.emplace_back(id);
     }
   }
+  countCADomains(joined_groups, 1);
 
   if (isDebugDumpEnabled(DebugDumpOption::ExprSort) ||
       isDebugDumpEnabled(DebugDumpOption::ExprSortVerbose)) {
@@ -1118,6 +1116,7 @@ void ExprSegmentationSorter::mergeNodes() {
   }
 
   for (auto group : clean_up_groups) {
+    countCADomains(group, -1);
     auto disconnected_edges = disconnectGroup(group);
     clean_up_edges.insert(disconnected_edges.begin(), disconnected_edges.end());
   }
@@ -1256,21 +1255,21 @@ void ExprSegmentationSorter::initializeForLoopDependencies() {
 
 bool ExprSegmentationSorter::hasCADomains(
     const std::unordered_set<IterDomain*>& domains) const {
-  for (auto& group : groups_) {
-    if (std::any_of(
-            group->payload()->ca_domains.begin(),
-            group->payload()->ca_domains.end(),
-            [&](auto ca_domain) { return domains.count(ca_domain); })) {
-      return true;
-    }
+  return std::any_of(domains.begin(), domains.end(), [&](IterDomain* id) {
+    auto it = ca_domain_counts_.find(id);
+    return it != ca_domain_counts_.end() && it->second > 0;
+  });
+}
+
+void ExprSegmentationSorter::countCADomains(ExprGroup* group, int64_t count) {
+  for (IterDomain* id : group->payload()->ca_domains) {
+    ca_domain_counts_[id] += count;
   }
-  return false;
 }
 
 // Checks if the for loop associated with the concrete ID is ready to be
-// resolved in sorting. This could be done more efficiently with some
-// additional tracking, however we recreate ca_domain_ when we merge groups,
-// so it's hard to track what is no longer needed.
+// resolved in sorting, i.e., none of the loops it depends on is still in the
+// compute at domain of a group.
 bool ExprSegmentationSorter::loopReady(IterDomain* concrete_id) const {
   NVF_ERROR(
       concrete_id == getConcreteID(concrete_id),
@@ -1515,6 +1514,10 @@ void ExprSegmentationSorter::sort() {
     used_vals.insert(expr->inputs().begin(), expr->inputs().end());
   }
 
+  const std::unordered_set<Val*> known_vals(
+      GpuLower::current()->allKnownVals().begin(),
+      GpuLower::current()->allKnownVals().end());
+
   // Initialize DAG, convert each expr to a segment group
   for (auto expr : all_exprs) {
     bool is_terminating_expr = std::none_of(
@@ -1530,10 +1533,7 @@ void ExprSegmentationSorter::sort() {
     auto expr_group = expr2group.at(expr);
     auto out = expr->outputs()[0];
     for (auto inp : expr->inputs()) {
-      if (std::any_of(
-              GpuLower::current()->allKnownVals().begin(),
-              GpuLower::current()->allKnownVals().end(),
-              [&inp](Val* input) { return input == inp; })) {
+      if (known_vals.count(inp)) {
         continue;
       }
 
@@ -10,6 +10,7 @@
 #include <device_lower/utils.h>
 #include <dispatch.h>
 #include <instrumentation.h>
+#include <ir/builder.h>
 #include <ir/utils.h>
 #include <kernel_ir.h>
 #include <kernel_ir_dispatch.h>
@@ -91,6 +92,20 @@ class GridSerializationSyncInserter : kir::ExprMutator {
       } else {
         cur_expr_sync_pattern_ = sync_pattern;
       }
+
+      if (cur_expr_num_chains_.has_value()) {
+        NVF_ERROR(
+            cur_expr_num_chains_.value() == rop->serialGridReductionChains(),
+            "Reduction op ",
+            rop->toString(),
+            " has requested ",
+            rop->serialGridReductionChains(),
+            " serial reduction chains, which conflicts with previous number "
+            "of chains: ",
+            cur_expr_num_chains_.value());
+      } else {
+        cur_expr_num_chains_ = rop->serialGridReductionChains();
+      }
     }
   }
 
@@ -112,6 +127,7 @@ class GridSerializationSyncInserter : kir::ExprMutator {
     // If a serial grid reduction was found when traversing expr, then
     // cur_expr_sync_pattern_ will be set
     cur_expr_sync_pattern_ = std::nullopt;
+    cur_expr_num_chains_ = std::nullopt;
     kir::ExprMutator::dispatch(expr);
     if (cur_expr_sync_pattern_.has_value()) {
       insertSyncs();
@@ -119,22 +135,27 @@ class GridSerializationSyncInserter : kir::ExprMutator {
     // reset state variables
     cur_top_level_expr_ = nullptr;
     cur_expr_sync_pattern_ = std::nullopt;
+    cur_expr_num_chains_ = std::nullopt;
   }
 
   void insertSyncs() {
     NVF_ERROR(cur_top_level_expr_ != nullptr);
     NVF_ERROR(cur_expr_sync_pattern_.has_value());
+    const int64_t num_chains = cur_expr_num_chains_.value_or(1);
+    // Each reduction segment has one semaphore per chain
     kir::Allocate* alloc = lower_utils::allocGlobalBufferForGridComm(
-        lower_utils::getGridSyncBufferSize(cur_expr_sync_pattern_.value()),
+        SimplifyingIrBuilder::mulExpr(
+            lower_utils::getGridSyncBufferSize(cur_expr_sync_pattern_.value()),
+            num_chains),
         DataType::Int,
         /*zero_init=*/true,
         /*resets_to_zero=*/true);
     auto wait = IrBuilder::create<kir::BlockSerializeWait>(
-        cur_expr_sync_pattern_.value(), alloc->buffer());
+        cur_expr_sync_pattern_.value(), alloc->buffer(), num_chains);
     registerInsertBefore(cur_top_level_expr_, alloc);
     registerInsertBefore(cur_top_level_expr_, wait);
     auto release = IrBuilder::create<kir::BlockSerializeRelease>(
-        cur_expr_sync_pattern_.value(), alloc->buffer());
+        cur_expr_sync_pattern_.value(), alloc->buffer(), num_chains);
     registerInsertAfter(cur_top_level_expr_, release);
   }
 
@@ -170,6 +191,10 @@ class GridSerializationSyncInserter : kir::ExprMutator {
   //! parallel axes that are mapped to reduction domains in the serial
   //! reduction.
   std::optional<ParallelTypeBitmap> cur_expr_sync_pattern_ = std::nullopt;
+
+  //! Number of chains requested by the serial grid reductions of the current
+  //! expr. All of them must use the same number since they share the syncs.
+  std::optional<int64_t> cur_expr_num_chains_ = std::nullopt;
 };
 
 } // namespace
@@ -610,6 +610,43 @@ Val* getEntranceLinIndGridReduce(std::vector<ForLoop*>& for_loops) {
   return linear_index;
 }
 
+// Returns true if the blocks a grid reduction of out_domain reduces across
+// are exactly the blocks of a thread block cluster, as given by the
+// "cluster_dims" the scheduler sets on the fusion. The reduced block
+// dimensions must have static extents equal to the cluster dimensions, and
+// the cluster must not span any other block dimension.
+bool isReducedWithinCluster(const TensorDomain* out_domain) {
+  kir::Kernel* kernel = GpuLower::current()->kernel();
+  if (!kernel->hasManaged("cluster_dims")) {
+    return false;
+  }
+  const auto [cluster_x, cluster_y, cluster_z] =
+      kernel->getManaged<std::tuple<int64_t, int64_t, int64_t>>(
+          "cluster_dims");
+  const std::unordered_map<ParallelType, int64_t> cluster_dims{
+      {ParallelType::BIDx, cluster_x},
+      {ParallelType::BIDy, cluster_y},
+      {ParallelType::BIDz, cluster_z}};
+
+  for (const auto& [pt, cluster_dim] : cluster_dims) {
+    auto it = std::find_if(
+        out_domain->loop().begin(),
+        out_domain->loop().end(),
+        [pt = pt](IterDomain* id) { return id->getParallelType() == pt; });
+    if (it == out_domain->loop().end() || !(*it)->isReduction()) {
+      if (cluster_dim != 1) {
+        return false;
+      }
+      continue;
+    }
+    if (!(*it)->extent()->isConstInt() ||
+        (*it)->extent()->evaluate().as<int64_t>() != cluster_dim) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
 void IndexLowering::handle(const ReductionOp* rop) {
@@ -687,10 +724,28 @@ void IndexLowering::handleSerialGridReduction(
   // of the ReductionOp output. In the future, we may want the allocation
   // domain to be different in order to enable re-use of global output buffers
   // for in-place reduction.
+  //
+  // A chained serial reduction gets one such buffer per chain. They are
+  // placed next to each other by an outer domain of the chains.
+  const int64_t num_chains = rop->serialGridReductionChains();
   std::vector<IterDomain*> work_buffer_root;
-  work_buffer_root.reserve(out_tv->nDims());
+  work_buffer_root.reserve(out_tv->nDims() + 1);
+  if (num_chains > 1) {
+    work_buffer_root.push_back(
+        IterDomainBuilder(
+            GpuLower::current()->kernel()->zeroVal(),
+            IrBuilder::create<Val>(num_chains, DataType::Index))
+            .build());
+  }
+  Val* chain_stride = nullptr;
   for (IterDomain* id : out_tv->getLoopDomain()) {
     work_buffer_root.push_back(IterDomainBuilder(id).build());
+    if (!id->isReduction()) {
+      chain_stride = SimplifyingIrBuilder::mulExpr(chain_stride, id->extent());
+    }
+  }
+  if (chain_stride == nullptr) {
+    chain_stride = GpuLower::current()->kernel()->oneVal();
   }
   auto work_buffer_domain = IrBuilder::create<TensorDomain>(work_buffer_root);
   auto work_buffer_tv = IrBuilder::create<TensorView>(
@@ -728,7 +783,10 @@ void IndexLowering::handleSerialGridReduction(
       nullptr,
       nullptr,
       false,
-      work_buffer_idx);
+      work_buffer_idx,
+      /*is_cluster_reduction=*/false,
+      num_chains > 1 ? chain_stride : nullptr);
+  serial_grid_reduction->setSerialGridReductionChains(num_chains);
 
   serial_grid_reduction =
       serial_grid_reduction->withThreadPredicate(thread_pred);
@@ -748,6 +806,118 @@ void IndexLowering::handleSerialGridReduction(
   GpuLower::current()->propagateExprInfo(rop, back());
 }
 
+void IndexLowering::handleClusterReduction(
+    const ReductionOp* rop,
+    Val* out,
+    Val* in) {
+  const auto out_tv = out->as<kir::TensorIndex>()->view();
+
+  // The thread predicate for GridReduction needs to be set
+  // separately from the main predicate. Do not combine them like
+  // other expressions.
+  const auto& thread_pred =
+      GpuLower::current()->threadPredMap().getPredicatedParallelTypes(out_tv);
+
+  // The partial results are exchanged through the shared memory of the
+  // cluster, so there are no work and sync buffers
+  auto cluster_reduction = IrBuilder::create<kir::GridReduction>(
+      rop->getReductionOpType(),
+      rop->init(),
+      out,
+      in,
+      nullptr,
+      nullptr,
+      GpuLower::current()->kernel()->zeroVal(),
+      GpuLower::current()->kernel()->oneVal(),
+      rop->isAllreduce(),
+      nullptr,
+      true);
+
+  cluster_reduction = cluster_reduction->withThreadPredicate(thread_pred);
+
+  if (rop->predicate()) {
+    cluster_reduction = cluster_reduction->withPredicate(rop->predicate())
+                            ->as<kir::GridReduction>();
+  }
+  if (rop->writePredicate()) {
+    cluster_reduction =
+        cluster_reduction->withWritePredicate(rop->writePredicate())
+            ->as<kir::GridReduction>();
+  }
+
+  pushBack(cluster_reduction);
+  GpuLower::current()->propagateExprInfo(rop, back());
+}
+
+void IndexLowering::handleAtomicGridReduction(
+    const ReductionOp* rop,
+    Val* out,
+    Val* in) {
+  const auto out_tv = out->as<kir::TensorIndex>()->view();
+  const auto out_domain = out_tv->domain();
+
+  NVF_ERROR(
+      rop->getReductionOpType() == BinaryOpType::Add ||
+          rop->getReductionOpType() == BinaryOpType::Max,
+      "Atomic grid reductions are only implemented for sums and maxima: ",
+      rop->toString());
+  NVF_ERROR(!rop->isAllreduce(), "Atomic grid allReduce is not implemented");
+  NVF_ERROR(
+      out_tv->isFusionOutput() && out_tv->getMemoryType() == MemoryType::Global,
+      "The output of an atomic grid reduction must be a fusion output: ",
+      rop->toString());
+  NVF_ERROR(
+      out_tv->dtype() == DataType::Float || out_tv->dtype() == DataType::Double,
+      "Atomic grid reductions are only implemented for float and double: ",
+      rop->toString());
+
+  // The blocks add their partial results directly, so the reduction within
+  // each block must be done by a producer first
+  NVF_ERROR(
+      std::none_of(
+          out_domain->loop().begin(),
+          out_domain->loop().end(),
+          [](IterDomain* id) {
+            return id->isReduction() && !id->isBlockDim() &&
+                !id->extent()->isOneInt();
+          }),
+      "Found a reduction axis of an atomic grid reduction that is not ",
+      "parallelized with blockIdx, please use rfactor to reduce it first. ",
+      rop->toString());
+
+  const auto& thread_pred =
+      GpuLower::current()->threadPredMap().getPredicatedParallelTypes(out_tv);
+
+  // No work and sync buffers are needed
+  auto atomic_grid_reduction = IrBuilder::create<kir::GridReduction>(
+      rop->getReductionOpType(),
+      rop->init(),
+      out,
+      in,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr);
+  atomic_grid_reduction->requestAtomicGridReduction();
+
+  atomic_grid_reduction =
+      atomic_grid_reduction->withThreadPredicate(thread_pred);
+
+  if (rop->predicate()) {
+    atomic_grid_reduction =
+        atomic_grid_reduction->withPredicate(rop->predicate())
+            ->as<kir::GridReduction>();
+  }
+  if (rop->writePredicate()) {
+    atomic_grid_reduction =
+        atomic_grid_reduction->withWritePredicate(rop->writePredicate())
+            ->as<kir::GridReduction>();
+  }
+
+  pushBack(atomic_grid_reduction);
+  GpuLower::current()->propagateExprInfo(rop, back());
+}
+
 void IndexLowering::handleGridReduction(
     const ReductionOp* rop,
     Val* out,
@@ -757,11 +927,21 @@ void IndexLowering::handleGridReduction(
     return;
   }
 
+  if (rop->atomicGridReductionRequested()) {
+    handleAtomicGridReduction(rop, out, in);
+    return;
+  }
+
   const auto out_tv = out->as<kir::TensorIndex>()->view();
   const auto out_domain = out_tv->domain();
 
   NVF_ERROR(out_domain->hasGridReduction());
 
+  if (isReducedWithinCluster(out_domain)) {
+    handleClusterReduction(rop, out, in);
+    return;
+  }
+
   // If we do a grid reduction we can't have a reduction axis that is not bound
   // to a grid or block dim.
   NVF_ERROR(
@@ -1446,7 +1626,7 @@ void IndexLowering::handle(const kir::MBarrierInit* minit) {
     NVF_THROW("Unexpected MBarrierInit value.");
   }
   kir::MBarrierInit* minit_indexed = IrBuilder::create<kir::MBarrierInit>(
-      smem_address_ptr, minit->threadCount());
+      smem_address_ptr, minit->threadCount(), minit->multicastDims());
   pushBack(minit_indexed);
   GpuLower::current()->propagateExprInfo(minit, minit_indexed);
 }
@@ -1479,7 +1659,9 @@ void IndexLowering::handle(const kir::MBarrierArrive* arrive_transaction) {
   Val* smem_address_ptr = lower_utils::u32IndexScalarSmemTv(
       arrive_transaction->mbarrier()->as<kir::TensorIndex>());
   pushBack(IrBuilder::create<kir::MBarrierArrive>(
-      arrive_transaction->state(), smem_address_ptr));
+      arrive_transaction->state(),
+      smem_address_ptr,
+      arrive_transaction->multicastDims()));
 }
 
 void IndexLowering::handle(
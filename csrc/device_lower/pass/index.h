@@ -132,6 +132,12 @@ class IndexLowering : private OptOutConstDispatch {
   //! Called by handleGridReduction, this returns true if rop is lowered as a
   //! serial grid reduction.
   void handleSerialGridReduction(const ReductionOp* rop, Val* out, Val* in);
+  //! Called by handleGridReduction when the blocks of the reduction form a
+  //! thread block cluster
+  void handleClusterReduction(const ReductionOp* rop, Val* out, Val* in);
+  //! Called by handleGridReduction when the blocks add their partial results
+  //! to the output with atomics
+  void handleAtomicGridReduction(const ReductionOp* rop, Val* out, Val* in);
 
   void handleBlockReduction(
       const GroupedReductionOp* rop,
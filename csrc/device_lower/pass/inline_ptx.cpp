@@ -9,13 +9,19 @@
 #include <device_lower/lower2device.h>
 #include <device_lower/pass/inline_ptx.h>
 #include <device_lower/utils.h>
+#include <expr_evaluator.h>
 #include <ir/builder.h>
 #include <ir/utils.h>
 #include <kernel_ir.h>
 #include <kernel_ir_dispatch.h>
+#include <options.h>
 #include <scheduler/mma_utils.h>
 
+#include <ATen/cuda/CUDAContext.h>
+
+#include <optional>
 #include <sstream>
+#include <unordered_map>
 
 namespace nvfuser {
 class LowerToInlinePtx : public kir::ExprMutator {
@@ -27,6 +33,179 @@ class LowerToInlinePtx : public kir::ExprMutator {
     return IrBuilder::create<kir::Predicate>(invert);
   }
 
+  // Vectorized loads of fusion inputs that the kernel doesn't write can go
+  // through the non-coherent path. They are read only once by default, so
+  // they don't need to be allocated in L1 either. Loads that the scheduler
+  // marked as reused keep their cache operator. With megakernels, an input
+  // may be written by an earlier stage of the same launch, so the loads are
+  // kept coherent.
+  void maybeLoadWithoutL1Allocation(LoadStoreOp* ldst) {
+    if (ldst->opType() != LoadStoreOpType::Set ||
+        ldst->cacheOp() != CacheOp::Streaming ||
+        isOptionEnabled(EnableOption::Megakernel)) {
+      return;
+    }
+    auto in = dynamic_cast<kir::TensorIndex*>(ldst->in());
+    auto out = dynamic_cast<kir::TensorIndex*>(ldst->out());
+    if (in == nullptr || out == nullptr || !in->view()->isFusionInput() ||
+        in->view()->getMemoryType() != MemoryType::Global ||
+        out->view()->getMemoryType() != MemoryType::Local) {
+      return;
+    }
+    kir::Kernel* kernel = GpuLower::current()->kernel();
+    for (Val* kernel_out : kernel->outputs()) {
+      if (kernel->getOutputAlias(kernel_out).aliased_io == in->view()) {
+        return;
+      }
+    }
+    const int64_t vec_bytes = ir_utils::getVectorizeSize(out->view()) *
+        dataTypeSizeByte(out->view()->dtype());
+    if (vec_bytes != 8 && vec_bytes != 16) {
+      return;
+    }
+    ldst->setCacheOp(CacheOp::NoAllocate);
+  }
+
+  // Evaluates index with the indices of the enclosing loops set to zero,
+  // except for loop_at_one, which is set to one
+  std::optional<int64_t> evaluateIndex(
+      Val* index,
+      const ForLoop* loop_at_one) const {
+    ExpressionEvaluator expr_eval;
+    expr_eval.bind(kMagicZeroName, 0L);
+    for (const ForLoop* loop : for_loops_) {
+      if (!loop->isTrivial()) {
+        expr_eval.bind(loop->index(), loop == loop_at_one ? 1L : 0L);
+      }
+    }
+    PolymorphicValue value = expr_eval.evaluate(index);
+    if (!value.hasValue()) {
+      return std::nullopt;
+    }
+    return value.as<int64_t>();
+  }
+
+  // Returns true if index, assumed to be affine in the loop indices, is even
+  // in the even iterations of the innermost loop and advances by one per
+  // iteration
+  bool isEvenInEvenIterations(Val* index) const {
+    const std::optional<int64_t> base = evaluateIndex(index, nullptr);
+    if (!base.has_value() || base.value() % 2 != 0) {
+      return false;
+    }
+    for (const ForLoop* loop : for_loops_) {
+      if (loop->isTrivial()) {
+        continue;
+      }
+      const std::optional<int64_t> stepped = evaluateIndex(index, loop);
+      if (!stepped.has_value()) {
+        return false;
+      }
+      const int64_t stride = stepped.value() - base.value();
+      if (loop == for_loops_.back() ? stride != 1 : stride % 2 != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns true if index, assumed to be affine in the loop indices, selects
+  // a different element in each iteration of the innermost loop
+  bool variesWithInnermostLoop(Val* index) const {
+    const std::optional<int64_t> base = evaluateIndex(index, nullptr);
+    const std::optional<int64_t> stepped =
+        evaluateIndex(index, for_loops_.back());
+    return base.has_value() && stepped.has_value() &&
+        base.value() != stepped.value();
+  }
+
+  // Converts elements i-1 and i of an unrolled loop like
+  //   T1[i] = __float2bfloat(T0[i]);
+  // with a single cvt.rn.bf16x2.f32 in the odd iterations, when both inputs
+  // have been computed. The condition on the unrolled loop index is folded
+  // by the compiler. T1 must not be read inside the loop since its element
+  // i-1 is only written in iteration i.
+  void maybePackCast(UnaryOp* uop) {
+    if (uop->getUnaryOpType() != UnaryOpType::Cast ||
+        (uop->predicate() != nullptr &&
+         !(uop->predicate()->hasValue() &&
+           uop->predicate()->value()->isTrue()))) {
+      return;
+    }
+    auto in = dynamic_cast<kir::TensorIndex*>(uop->in());
+    auto out = dynamic_cast<kir::TensorIndex*>(uop->out());
+    if (in == nullptr || out == nullptr || in->dtype() != DataType::Float ||
+        (out->dtype() != DataType::BFloat16 &&
+         out->dtype() != DataType::Half) ||
+        in->view()->getMemoryType() != MemoryType::Local ||
+        out->view()->getMemoryType() != MemoryType::Local) {
+      return;
+    }
+    // cvt.rn.{bf16x2,f16x2}.f32 requires sm_80
+    if (at::cuda::getCurrentDeviceProperties()->major < 8) {
+      return;
+    }
+
+    if (for_loops_.empty()) {
+      return;
+    }
+    ForLoop* loop = for_loops_.back();
+    if (scope_.back() != &loop->body() || loop->isTrivial() ||
+        !loop->isUnrolled() || !loop->start()->isZeroInt() ||
+        !loop->step()->isOneInt() || !loop->stop()->isConstInt() ||
+        loop->stop()->evaluate().as<int64_t>() % 2 != 0) {
+      return;
+    }
+    for (Expr* expr : ir_utils::flattenScopedExprs(loop->body().exprs())) {
+      for (auto ti : ir_utils::filterByType<kir::TensorIndex>(expr->inputs())) {
+        if (ti->view() == out->view()) {
+          return;
+        }
+      }
+    }
+
+    // Local arrays are only aligned beyond their element size when they are
+    // accessed with vectorization
+    const auto& vectorized_accesses =
+        GpuLower::current()->vectorizedAccesses();
+    auto it = vectorized_accesses.find(out->view());
+    // The input of iteration i-1 must still be available in iteration i
+    if (it == vectorized_accesses.end() || it->second % 2 != 0 ||
+        !isEvenInEvenIterations(out->index()) ||
+        !variesWithInnermostLoop(in->index())) {
+      return;
+    }
+
+    kir::Kernel* kernel = GpuLower::current()->kernel();
+    const std::unordered_map<Val*, Val*> to_prev_iteration = {
+        {loop->index(), IrBuilder::subExpr(loop->index(), kernel->oneVal())}};
+    auto prev_in = IrBuilder::create<kir::TensorIndex>(
+        in->view(),
+        ir_utils::replaceValRecursively(in->index(), to_prev_iteration));
+    auto packed_out = IrBuilder::create<kir::TensorIndex>(
+        out->view(),
+        ir_utils::replaceValRecursively(out->index(), to_prev_iteration),
+        DataType::UInt32);
+    // The first source operand is converted into the upper half
+    auto cvt = IrBuilder::create<kir::Asm>(
+        out->dtype() == DataType::BFloat16 ? "cvt.rn.bf16x2.f32"
+                                           : "cvt.rn.f16x2.f32",
+        std::vector<Val*>{packed_out},
+        std::vector<Val*>{in, prev_in});
+
+    Val* is_odd = IrBuilder::eqExpr(
+        IrBuilder::modExpr(
+            loop->index(), IrBuilder::create<Val>(2L, DataType::Index)),
+        kernel->oneVal());
+    auto ite = IrBuilder::create<kir::IfThenElse>(
+        IrBuilder::create<kir::Predicate>(is_odd));
+    ite->thenBody().push_back(cvt);
+    registerReplace(uop, ite);
+  }
+
+  const bool use_ptx_patterns_ =
+      isOptionEnabled(EnableOption::InlinePtxPatterns);
+
  protected:
   using ExprMutator::handle;
 
@@ -171,6 +350,14 @@ class LowerToInlinePtx : public kir::ExprMutator {
               std::vector<Val*>{},
               std::vector<Val*>{},
               kir::Asm::Options{/*volatile=*/true}));
+    } else if (use_ptx_patterns_) {
+      maybeLoadWithoutL1Allocation(ldst);
+    }
+  }
+
+  void handle(UnaryOp* uop) final {
+    if (use_ptx_patterns_) {
+      maybePackCast(uop);
     }
   }
 
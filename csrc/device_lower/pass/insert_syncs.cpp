@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 // clang-format on
+#include <debug.h>
 #include <device_lower/lower2device.h>
 #include <device_lower/pass/insert_syncs.h>
 #include <device_lower/utils.h>
@@ -13,6 +14,7 @@
 #include <ir/utils.h>
 #include <kernel_ir.h>
 #include <kernel_ir_dispatch.h>
+#include <options.h>
 
 #include <unordered_set>
 
@@ -1023,11 +1025,52 @@ class WarAsyncWaitInserter : private kir::ExprMutator {
   //! insert the wait expression for async_op2 at the end of loop 1.
   std::unordered_set<Expr*> async_exprs_to_protect_;
 
+  //! Set by the matmul scheduler as the fusion-managed data
+  //! "overlap_tma_store" to defer the wait of TMA stores. See
+  //! getFirstWriteOfStoreInput.
+  const bool overlap_tma_store_;
+
  private:
-  WarAsyncWaitInserter(const std::vector<Expr*>& exprs) {
+  WarAsyncWaitInserter(const std::vector<Expr*>& exprs)
+      : overlap_tma_store_(
+            GpuLower::current()->kernel()->hasManaged("overlap_tma_store") &&
+            GpuLower::current()->kernel()->getManaged<bool>(
+                "overlap_tma_store")) {
     kir::ExprMutator::traverseAndInsert(exprs);
   }
 
+  // By default, the wait for a TMA store is placed at the end of the loop, as
+  // for other async ops. In a persistent matmul, this stalls each tile until
+  // the output of its epilogue is written to global memory. With
+  // overlap_tma_store_, the wait is instead placed before the expression of
+  // the loop body that writes the shared memory read by the store, i.e.,
+  // before the epilogue of the next tile, so the store overlaps with the
+  // mainloop of the next tile:
+  //   for tile:
+  //     mainloop
+  //     cp.async.bulk.wait_group.read 0
+  //     __syncthreads()
+  //     T_smem = epilogue(...)
+  //     T_gmem = tma_store(T_smem)
+  //     cp.async.bulk.commit_group
+  // The wait of the first iteration returns immediately as no group is
+  // pending, and the last stores are waited for before exiting the kernel.
+  // Returns the expression of the loop body that writes the input of store,
+  // or nullptr if there is none.
+  Expr* getFirstWriteOfStoreInput(ForLoop* for_loop, Expr* store) {
+    Val* smem = store->input(0);
+    for (Expr* expr : for_loop->body().exprs()) {
+      if (std::ranges::any_of(
+              ir_utils::flattenScopedExprs({expr}), [&](Expr* inner_expr) {
+                return std::ranges::find(inner_expr->outputs(), smem) !=
+                    inner_expr->outputs().end();
+              })) {
+        return expr;
+      }
+    }
+    return nullptr;
+  }
+
   // Get the async op types of the use expressions of a value.
   std::unordered_set<AsyncOpType> getUseAsyncOpTypes(Val* v) {
     std::unordered_set<AsyncOpType> async_ops;
@@ -1300,6 +1343,8 @@ class WarAsyncWaitInserter : private kir::ExprMutator {
     // Insert async wait at the end of this for loop
     if (within_iter_loop_) {
       std::unordered_map<AsyncOpType, int64_t> types_and_pending_ops_to_protect;
+      // The expressions before which the wait of TMA stores is deferred
+      std::vector<Expr*> deferred_waits_positions;
 
       // Gather the information on what wait expressions we should insert.
       for (auto it = async_exprs_to_protect_.begin();
@@ -1327,6 +1372,19 @@ class WarAsyncWaitInserter : private kir::ExprMutator {
           continue;
         }
 
+        if (overlap_tma_store_ && ir_utils::isCpAsyncBulkStore(expr) &&
+            for_loop->circularBufferLoopStage() !=
+                CircularBufferLoopStage::Epilog) {
+          if (Expr* write = getFirstWriteOfStoreInput(for_loop, expr)) {
+            if (std::ranges::find(deferred_waits_positions, write) ==
+                deferred_waits_positions.end()) {
+              deferred_waits_positions.push_back(write);
+            }
+            it = async_exprs_to_protect_.erase(it);
+            continue;
+          }
+        }
+
         int64_t pending_ops = getPendingOpsFor(expr, for_loop);
         // If there are multiple async ops of the same type to protect, we will
         // only insert a single wait expressions with the smallest
@@ -1379,6 +1437,29 @@ class WarAsyncWaitInserter : private kir::ExprMutator {
           sync_exprs.pop_back();
         }
       }
+
+      // Commit the deferred TMA stores at the end of the loop, unless already
+      // committed and waited for along with other TMA stores, and wait for
+      // them before their shared memory is written again. The store is issued
+      // by a single thread, so the other threads are synchronized with it.
+      if (!deferred_waits_positions.empty() &&
+          !types_and_pending_ops_to_protect.count(AsyncOpType::CpAsyncBulk)) {
+        registerInsertAfter(
+            for_loop->body().exprs().back(),
+            getAsyncCommit(AsyncOpType::CpAsyncBulk),
+            &for_loop->body());
+        for (Expr* write : deferred_waits_positions) {
+          registerInsertBefore(
+              write,
+              getAsyncWait(AsyncOpType::CpAsyncBulk, /*keep_stages=*/0),
+              &for_loop->body());
+          registerInsertBefore(
+              write,
+              IrBuilder::create<kir::BlockSync>(
+                  /*war_sync=*/true, isOptionalComputeSync(for_loop_stack_)),
+              &for_loop->body());
+        }
+      }
     }
 
     // Pop for loop scope information
@@ -1388,6 +1469,146 @@ class WarAsyncWaitInserter : private kir::ExprMutator {
   }
 };
 
+// Removes block syncs that are made redundant by another block sync. The RAW
+// and WAR passes place syncs for each buffer and loop independently, so the
+// same point of a kernel can end up with several syncs, e.g., the WAR sync at
+// the end of a loop followed by the RAW sync of the next loop nest.
+//
+// Two syncs are merged when only expressions that don't touch shared memory
+// are between them. This is checked within a scope and across the boundary of
+// a for-loop that runs at least once, where a sync right before the loop is
+// covered by the first sync of the loop body and a sync right after the loop
+// by the last sync of the loop body. WAR syncs are kept over RAW syncs.
+class RedundantSyncRemover : private kir::ExprMutator {
+ public:
+  static std::vector<Expr*> remove(const std::vector<Expr*>& exprs) {
+    RedundantSyncRemover remover(exprs);
+    if (isDebugDumpEnabled(DebugDumpOption::SyncMap)) {
+      debug() << "Removed " << remover.num_removed_
+              << " redundant block syncs" << std::endl;
+    }
+    return remover.exprs_;
+  }
+
+ private:
+  RedundantSyncRemover(const std::vector<Expr*>& exprs) {
+    mergeSyncs(exprs, nullptr);
+    kir::ExprMutator::traverseAndInsert(exprs);
+  }
+
+  void handle(ForLoop* for_loop) final {
+    mergeSyncs(for_loop->body().exprs(), &for_loop->body());
+    kir::ExprMutator::handle(for_loop);
+  }
+
+  void handle(kir::IfThenElse* ite) final {
+    mergeSyncs(ite->thenBody().exprs(), &ite->thenBody());
+    mergeSyncs(ite->elseBody().exprs(), &ite->elseBody());
+    kir::ExprMutator::handle(ite);
+  }
+
+  // Returns true if expr neither accesses shared memory nor synchronizes
+  static bool isNeutral(Expr* expr) {
+    if (expr->isA<kir::Allocate>()) {
+      return true;
+    }
+    if (!expr->isOneOf<UnaryOp, BinaryOp, TernaryOp, LoadStoreOp>() ||
+        ir_utils::isCpAsyncOp(expr) || ir_utils::isCpAsyncBulk(expr)) {
+      return false;
+    }
+    auto is_local = [](Val* val) {
+      auto tv = dynamic_cast<TensorView*>(val);
+      return tv == nullptr || tv->getMemoryType() == MemoryType::Local;
+    };
+    return std::all_of(
+               expr->inputs().begin(), expr->inputs().end(), is_local) &&
+        std::all_of(expr->outputs().begin(), expr->outputs().end(), is_local);
+  }
+
+  static bool isMergeable(kir::BlockSync* first, kir::BlockSync* second) {
+    return first->warpSpecializedState() == second->warpSpecializedState();
+  }
+
+  // Returns the first (or last) block sync of scope if only neutral
+  // expressions are before (or after) it
+  static kir::BlockSync* boundarySync(const Scope& scope, bool first) {
+    const auto& exprs = scope.exprs();
+    auto find = [](auto begin, auto end) -> kir::BlockSync* {
+      auto it = std::find_if_not(begin, end, isNeutral);
+      return it == end ? nullptr : dynamic_cast<kir::BlockSync*>(*it);
+    };
+    return first ? find(exprs.begin(), exprs.end())
+                 : find(exprs.rbegin(), exprs.rend());
+  }
+
+  static bool runsAtLeastOnce(ForLoop* for_loop) {
+    if (for_loop->isTrivial()) {
+      return true;
+    }
+    return for_loop->start()->isConstInt() &&
+        for_loop->stop()->isConstInt() &&
+        for_loop->stop()->evaluate().as<int64_t>() >
+        for_loop->start()->evaluate().as<int64_t>();
+  }
+
+  void remove(kir::BlockSync* sync, Scope* scope) {
+    registerRemove(sync, scope);
+    ++num_removed_;
+  }
+
+  void mergeSyncs(const std::vector<Expr*>& exprs, Scope* scope) {
+    // The last sync seen with only neutral expressions after it, and whether
+    // it is in scope. A sync in a nested loop covers the code after the loop
+    // but can't be removed.
+    kir::BlockSync* last_sync = nullptr;
+    bool last_sync_in_scope = false;
+    for (Expr* expr : exprs) {
+      if (auto sync = dynamic_cast<kir::BlockSync*>(expr)) {
+        if (last_sync == nullptr || !isMergeable(last_sync, sync)) {
+          last_sync = sync;
+          last_sync_in_scope = true;
+          continue;
+        }
+        if (last_sync_in_scope && sync->isWarHazardSync() &&
+            !last_sync->isWarHazardSync()) {
+          remove(last_sync, scope);
+          last_sync = sync;
+        } else if (!sync->isWarHazardSync() || last_sync->isWarHazardSync()) {
+          remove(sync, scope);
+        } else {
+          last_sync = sync;
+          last_sync_in_scope = true;
+        }
+        continue;
+      }
+
+      if (isNeutral(expr)) {
+        continue;
+      }
+
+      auto for_loop = dynamic_cast<ForLoop*>(expr);
+      if (for_loop == nullptr || !runsAtLeastOnce(for_loop)) {
+        last_sync = nullptr;
+        continue;
+      }
+      kir::BlockSync* first_body_sync =
+          boundarySync(for_loop->body(), /*first=*/true);
+      if (last_sync != nullptr && last_sync_in_scope &&
+          first_body_sync != nullptr &&
+          isMergeable(last_sync, first_body_sync) &&
+          (!last_sync->isWarHazardSync() ||
+           first_body_sync->isWarHazardSync())) {
+        remove(last_sync, scope);
+      }
+      last_sync = boundarySync(for_loop->body(), /*first=*/false);
+      last_sync_in_scope = false;
+    }
+  }
+
+ private:
+  int64_t num_removed_ = 0;
+};
+
 } // namespace
 
 std::vector<Expr*> insertRawThreadSynchronization(
@@ -1407,4 +1628,13 @@ std::vector<Expr*> insertWarAsyncWait(const std::vector<Expr*>& exprs) {
   return WarAsyncWaitInserter::insert(exprs);
 }
 
+std::vector<Expr*> removeRedundantThreadSynchronization(
+    const std::vector<Expr*>& exprs) {
+  FUSER_PERF_SCOPE("GpuLower::Lower::removeRedundantThreadSynchronization");
+  if (isOptionDisabled(DisableOption::RedundantSyncRemoval)) {
+    return exprs;
+  }
+  return RedundantSyncRemover::remove(exprs);
+}
+
 } // namespace nvfuser
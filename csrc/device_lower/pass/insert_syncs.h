@@ -36,4 +36,11 @@ std::vector<Expr*> insertRawThreadSynchronization(
 //! the buffer before a previous async expression has finished reading it.
 std::vector<Expr*> insertWarAsyncWait(const std::vector<Expr*>& exprs);
 
+//! Remove block syncs that are covered by another block sync with no shared
+//! memory access in between, including across the boundary of for-loops that
+//! run at least once. The number of removed syncs is printed with
+//! DebugDumpOption::SyncMap. Disabled by DisableOption::RedundantSyncRemoval.
+std::vector<Expr*> removeRedundantThreadSynchronization(
+    const std::vector<Expr*>& exprs);
+
 } // namespace nvfuser
@@ -7,6 +7,7 @@
 // clang-format on
 #include <device_lower/lower2device.h>
 #include <device_lower/pass/magic_zero.h>
+#include <device_lower/utils.h>
 #include <iter_visitor.h>
 #include <kernel_ir_dispatch.h>
 
@@ -20,6 +21,7 @@ class Instrumentor : private kir::IrVisitor {
  public:
   Instrumentor(const std::vector<Expr*>& exprs) {
     IrVisitor::handle(exprs);
+    registerStages();
 
     if (profile_.getNumberOfProfileEntries() == 0) {
       exprs_ = exprs;
@@ -62,6 +64,50 @@ class Instrumentor : private kir::IrVisitor {
     profile_.registerExpr(expr);
   }
 
+  //! Profile the stages of warp-specialized kernels per warp group, i.e.,
+  //! waiting for TMA loads, MMAs and stores to global memory
+  void handle(kir::MBarrierWait* expr) final {
+    stage_exprs_.emplace_back(expr, Stage::TmaWait);
+  }
+
+  void handle(kir::MBarrierWaitParity* expr) final {
+    stage_exprs_.emplace_back(expr, Stage::TmaWait);
+  }
+
+  //! MmaOps are lowered to inline PTX before this pass, along with the waits
+  //! for their results
+  void handle(kir::Asm* expr) final {
+    const std::string& code = expr->code();
+    if (code.starts_with("mma.") || code.starts_with("wgmma.") ||
+        code.starts_with("tcgen05.mma")) {
+      stage_exprs_.emplace_back(expr, Stage::Mma);
+      has_tma_or_mma_ = true;
+    }
+  }
+
+  void handle(LoadStoreOp* expr) final {
+    auto out = dynamic_cast<kir::TensorIndex*>(expr->out());
+    if (out != nullptr &&
+        out->view()->getMemoryType() == MemoryType::Global) {
+      stage_exprs_.emplace_back(expr, Stage::Epilogue);
+    }
+    if (ir_utils::isCpAsyncBulkLoad(expr)) {
+      has_tma_or_mma_ = true;
+    }
+  }
+
+  //! Stages are only profiled in kernels with TMA loads or MMAs, as the
+  //! stores of other kernels would be profiled as epilogues too
+  void registerStages() {
+    if (!has_tma_or_mma_) {
+      return;
+    }
+    profile_.registerKernelStage();
+    for (const auto& [expr, stage] : stage_exprs_) {
+      profile_.registerStageExpr(expr, stage);
+    }
+  }
+
   void allocateBuffer() {
     const auto num_profile_entries =
         (int64_t)profile_.getNumberOfProfileEntries();
@@ -93,8 +139,12 @@ class Instrumentor : private kir::IrVisitor {
   }
 
  private:
+  using Stage = kir::KernelPerformanceProfile::Stage;
+
   std::vector<Expr*> exprs_;
   kir::KernelPerformanceProfile profile_;
+  std::vector<std::pair<Expr*, Stage>> stage_exprs_;
+  bool has_tma_or_mma_ = false;
   TensorView* buffer_ = nullptr;
   kir::Allocate* buffer_alloc_ = nullptr;
 };
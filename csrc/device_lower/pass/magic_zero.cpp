@@ -13,6 +13,10 @@
 #include <instrumentation.h>
 #include <ir/utils.h>
 #include <kernel_ir_dispatch.h>
+#include <options.h>
+#include <remarks.h>
+
+#include <string>
 
 namespace nvfuser {
 
@@ -39,7 +43,8 @@ class MagicZeroInserter : public kir::ExprMutator {
   }
 
   void handle(ForLoop* fl) final {
-    if (fl->isUnrolled()) {
+    if (fl->isUnrolled() &&
+        !GpuLower::current()->magicZeroFreeLoops().count(fl->iter_domain())) {
       if (scope_.empty()) {
         kir::ExprMutator::registerInsertAfter(
             fl, IrBuilder::create<kir::UpdateMagicZero>());
@@ -80,6 +85,114 @@ std::vector<Expr*> insertMagicZero(const std::vector<Expr*>& exprs) {
   return MagicZeroInserter::insert(exprs);
 }
 
+namespace {
+
+int64_t magicZeroRegisterBudget() {
+  constexpr int64_t default_budget = 32;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::SelectiveMagicZero);
+  return option_args.empty() ? default_budget : std::stoll(option_args[0]);
+}
+
+// Returns the number of global and shared memory accesses of exprs after
+// unrolling. The start and stop of unrolled loops are constant.
+int64_t countUnrolledAccesses(const std::vector<Expr*>& exprs) {
+  int64_t count = 0;
+  for (Expr* expr : exprs) {
+    if (auto loop = dynamic_cast<ForLoop*>(expr)) {
+      int64_t copies = 1;
+      if (!loop->isTrivial() && loop->isUnrolled()) {
+        copies = std::max(
+            loop->stop()->evaluate().as<int64_t>() -
+                loop->start()->evaluate().as<int64_t>(),
+            (int64_t)1);
+      }
+      count += copies * countUnrolledAccesses(loop->body().exprs());
+    } else if (auto ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+      count += countUnrolledAccesses(ite->thenBody().exprs()) +
+          countUnrolledAccesses(ite->elseBody().exprs());
+    } else {
+      for (auto tv : ir_utils::filterByType<TensorView>(expr->inputs())) {
+        count += tv->getMemoryType() != MemoryType::Local;
+      }
+      for (auto tv : ir_utils::filterByType<TensorView>(expr->outputs())) {
+        count += tv->getMemoryType() != MemoryType::Local;
+      }
+    }
+  }
+  return count;
+}
+
+void collectLoopIds(
+    const std::vector<Expr*>& exprs,
+    std::unordered_set<IterDomain*>& loop_ids) {
+  for (Expr* expr : exprs) {
+    if (auto loop = dynamic_cast<ForLoop*>(expr)) {
+      loop_ids.insert(loop->iter_domain());
+      collectLoopIds(loop->body().exprs(), loop_ids);
+    } else if (auto ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+      collectLoopIds(ite->thenBody().exprs(), loop_ids);
+      collectLoopIds(ite->elseBody().exprs(), loop_ids);
+    }
+  }
+}
+
+// Visits the outermost unrolled loop nests
+void selectMagicZeroFreeNests(
+    const std::vector<Expr*>& exprs,
+    int64_t budget,
+    int64_t registers_per_index) {
+  for (Expr* expr : exprs) {
+    if (auto ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+      selectMagicZeroFreeNests(
+          ite->thenBody().exprs(), budget, registers_per_index);
+      selectMagicZeroFreeNests(
+          ite->elseBody().exprs(), budget, registers_per_index);
+      continue;
+    }
+    auto loop = dynamic_cast<ForLoop*>(expr);
+    if (loop == nullptr) {
+      continue;
+    }
+    if (loop->isTrivial() || !loop->isUnrolled()) {
+      selectMagicZeroFreeNests(
+          loop->body().exprs(), budget, registers_per_index);
+      continue;
+    }
+    const int64_t registers =
+        countUnrolledAccesses({loop}) * registers_per_index;
+    const bool protect = registers > budget;
+    if (!protect) {
+      collectLoopIds({loop}, GpuLower::current()->magicZeroFreeLoops());
+    }
+    if (remarks::isActive()) {
+      remarks::report(
+          "magic_zero",
+          protect ? "protected unrolled loop nest with magic zero"
+                  : "unrolled loop nest fits the register budget",
+          {{"iter_domain", loop->iter_domain()->toString()},
+           {"estimated_registers", std::to_string(registers)},
+           {"budget", std::to_string(budget)}});
+    }
+  }
+}
+
+} // namespace
+
+std::vector<Expr*> selectMagicZeroLoops(const std::vector<Expr*>& exprs) {
+  if (!isOptionEnabled(EnableOption::SelectiveMagicZero) ||
+      !GpuLower::current()->isNvFuserZeroEnabled()) {
+    return exprs;
+  }
+  // Hoisted addresses are kept as offsets of the index type
+  const int64_t registers_per_index = std::max(
+      dataTypeSizeByte(GpuLower::current()->kernel()->indexType()) / 4,
+      (int64_t)1);
+  selectMagicZeroFreeNests(
+      exprs, magicZeroRegisterBudget(), registers_per_index);
+  return exprs;
+}
+
 bool isMagicZero(const Val* val) {
   if (!val->isA<NamedScalar>()) {
     return false;
@@ -117,6 +230,10 @@ bool needsMagicZero(ForLoop* loop, IterDomain* reference_domain, Val* ind) {
     return false;
   }
 
+  if (GpuLower::current()->magicZeroFreeLoops().count(loop->iter_domain())) {
+    return false;
+  }
+
   bool ref_dom_simple = reference_domain->definition() != nullptr;
   bool ind_simple = ind->definition() != nullptr && !ind->isZeroInt();
 
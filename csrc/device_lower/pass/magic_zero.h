@@ -24,6 +24,15 @@ struct IndexFromIdGraph;
 //! This will make sure nvrtc does not aggressively save predicate and indices.
 std::vector<Expr*> insertMagicZero(const std::vector<Expr*>& exprs);
 
+//! With EnableOption::SelectiveMagicZero, estimate the registers nvcc needs to
+//! keep the hoisted addresses of each outermost unrolled loop nest live, i.e.,
+//! one index per global or shared memory access in each unrolled iteration.
+//! Nests that fit the register budget are added to
+//! GpuLower::magicZeroFreeLoops, so that needsMagicZero doesn't protect their
+//! indices and insertMagicZero doesn't update magic zero after them. Must be
+//! called between UnrollPass and IndexLowering.
+std::vector<Expr*> selectMagicZeroLoops(const std::vector<Expr*>& exprs);
+
 //! Check if val is a reference to the magic zero variable
 NVF_API bool isMagicZero(const Val* val);
 
@@ -14,6 +14,9 @@
 #include <ir/utils.h>
 #include <kernel_ir_dispatch.h>
 
+#include <map>
+#include <utility>
+
 namespace nvfuser {
 
 namespace {
@@ -36,9 +39,20 @@ class RNGInserter : public kir::ExprMutator {
   }
 
  private:
-  Val* rng_subseq_ = nullptr;
-  Val* rng_offset_ = nullptr;
-  TensorView* rng_result_ = nullptr;
+  // The RNGOps drawing from the same sequence, i.e., with the same seed and
+  // offset, share the four outputs of their Philox calls. An RNGOp consumes
+  // one or two of them per element, so consecutive elements of a thread,
+  // e.g., those of a vectorized or unrolled loop, reuse the outputs of one
+  // call. Separating the sequences keeps the RNGOps of different sequences
+  // in the same loop, e.g., the masks of two dropouts, from evicting each
+  // other's outputs.
+  struct PhiloxSequence {
+    // The outputs of the last call
+    TensorView* result = nullptr;
+    // The subsequence of the last call, or -1 before the first call
+    Val* subseq = nullptr;
+  };
+  std::map<std::pair<Val*, Val*>, PhiloxSequence> sequences_;
   const std::vector<Expr*>& exprs;
 
   struct InsertionInfo {
@@ -50,46 +64,44 @@ class RNGInserter : public kir::ExprMutator {
     kir::ExprMutator::traverseAndInsert(exprs);
   }
 
+  // Returns the sequence of rop, allocating its state in the prologue of the
+  // kernel on first use.
+  PhiloxSequence& sequenceOf(RNGOp* rop) {
+    PhiloxSequence& sequence =
+        sequences_[{rop->getRNGSeedVal(), rop->getRNGOffsetVal()}];
+    if (sequence.result != nullptr) {
+      return sequence;
+    }
+
+    sequence.result = TensorViewBuilder()
+                          .shape(std::vector<int64_t>{4})
+                          .dtype(DataType::UInt32)
+                          .contiguity(true)
+                          .build();
+    sequence.result->setMemoryType(MemoryType::Local);
+    kir::ExprMutator::registerInsertBefore(
+        exprs.front(),
+        IrBuilder::create<kir::Allocate>(sequence.result, MemoryType::Local),
+        nullptr);
+
+    auto subseq_tuple =
+        createAndAllocNS("rng_subseq_" + std::to_string(sequences_.size()));
+    kir::ExprMutator::registerInsertBefore(
+        exprs.front(), std::get<1>(subseq_tuple), nullptr);
+    kir::ExprMutator::registerInsertBefore(
+        exprs.front(),
+        IrBuilder::create<LoadStoreOp>(
+            LoadStoreOpType::Set,
+            std::get<0>(subseq_tuple),
+            IrBuilder::create<Val>(-1, DataType::Index)),
+        nullptr);
+    sequence.subseq = std::get<0>(subseq_tuple);
+    return sequence;
+  }
+
   void handle(RNGOp* rop) final {
     NVF_ERROR(!exprs.empty());
-
-    // Set prologue if not already set
-    if (rng_result_ == nullptr) {
-      rng_result_ = TensorViewBuilder()
-                        .shape(std::vector<int64_t>{4})
-                        .dtype(DataType::UInt32)
-                        .contiguity(true)
-                        .build();
-      rng_result_->setMemoryType(MemoryType::Local);
-
-      auto rng_result_alloc =
-          IrBuilder::create<kir::Allocate>(rng_result_, MemoryType::Local);
-      kir::ExprMutator::registerInsertBefore(
-          exprs.front(), rng_result_alloc, nullptr);
-
-      auto neg_1 = IrBuilder::create<Val>(-1, DataType::Index);
-      auto subseq_tuple = createAndAllocNS("rng_subseq");
-      kir::ExprMutator::registerInsertBefore(
-          exprs.front(), std::get<1>(subseq_tuple), nullptr);
-      kir::ExprMutator::registerInsertBefore(
-          exprs.front(),
-          IrBuilder::create<LoadStoreOp>(
-              LoadStoreOpType::Set, std::get<0>(subseq_tuple), neg_1),
-          nullptr);
-
-      rng_subseq_ = std::get<0>(subseq_tuple);
-
-      auto offset_tuple = createAndAllocNS("rng_offset");
-      kir::ExprMutator::registerInsertBefore(
-          exprs.front(), std::get<1>(offset_tuple), nullptr);
-      kir::ExprMutator::registerInsertBefore(
-          exprs.front(),
-          IrBuilder::create<LoadStoreOp>(
-              LoadStoreOpType::Set, std::get<0>(offset_tuple), neg_1),
-          nullptr);
-
-      rng_offset_ = std::get<0>(offset_tuple);
-    }
+    PhiloxSequence& sequence = sequenceOf(rop);
 
     auto index_tuple =
         createAndAllocNS("linear_index" + std::to_string(rop->name()));
@@ -137,31 +149,27 @@ class RNGInserter : public kir::ExprMutator {
             std::get<0>(rop_offset_tuple),
             rop->getRNGOffsetVal()));
 
+    // The seed and the offset are those of the sequence, so only the
+    // subsequence tells whether the last outputs can be reused.
     kir::IfThenElse* ite = IrBuilder::create<kir::IfThenElse>(
-        IrBuilder::create<kir::Predicate>(SimplifyingIrBuilder::logicalOrExpr(
-            SimplifyingIrBuilder::neExpr(
-                rng_subseq_, std::get<0>(rop_subseq_tuple)),
-            SimplifyingIrBuilder::neExpr(
-                rng_offset_, std::get<0>(rop_offset_tuple)))));
+        IrBuilder::create<kir::Predicate>(SimplifyingIrBuilder::neExpr(
+            sequence.subseq, std::get<0>(rop_subseq_tuple))));
 
     ite->thenBody().push_back(IrBuilder::create<TernaryOp>(
         TernaryOpType::Philox,
-        rng_result_,
+        sequence.result,
         rop->getRNGSeedVal(),
         std::get<0>(rop_subseq_tuple),
         std::get<0>(rop_offset_tuple)));
 
     ite->thenBody().push_back(IrBuilder::create<LoadStoreOp>(
-        LoadStoreOpType::Set, rng_subseq_, std::get<0>(rop_subseq_tuple)));
-
-    ite->thenBody().push_back(IrBuilder::create<LoadStoreOp>(
-        LoadStoreOpType::Set, rng_offset_, std::get<0>(rop_offset_tuple)));
+        LoadStoreOpType::Set, sequence.subseq, std::get<0>(rop_subseq_tuple)));
 
     kir::ExprMutator::registerInsertBefore(rop, ite);
     if (rop->inputs().size() == 4) {
       auto new_rng_op = IrBuilder::create<kir::RNGOp>(
           rop->output(0),
-          rng_result_,
+          sequence.result,
           std::get<0>(rop_component_tuple),
           rop->dtype(),
           rop->getRNGOpType(),
@@ -170,7 +178,7 @@ class RNGInserter : public kir::ExprMutator {
     } else if (rop->inputs().size() == 2) {
       auto new_rng_op = IrBuilder::create<kir::RNGOp>(
           rop->output(0),
-          rng_result_,
+          sequence.result,
           std::get<0>(rop_component_tuple),
           rop->dtype(),
           rop->getRNGOpType());
@@ -7,6 +7,7 @@
 // clang-format on
 #include <device_lower/lower2device.h>
 #include <device_lower/pass/magic_zero.h>
+#include <device_lower/utils.h>
 #include <expr_simplifier.h>
 #include <ir/utils.h>
 #include <iter_visitor.h>
@@ -572,6 +573,166 @@ class CommonScalarInserter : private kir::ExprMutator {
   const CommonScalarMap& common_scalar_map_;
 };
 
+// Rewrites hoisted scalars of the form x + i * s, where i is the index of a
+// serial loop and x and s are loop invariant, so that they are initialized to
+// x before the loop and incremented by s at the end of each iteration:
+//
+//   for i in 0..N:                       v = x;
+//     v = x + i * s;           =>        for i in 0..N:
+//     ... uses of v ...                    ... uses of v ...
+//                                          v += s;
+//
+// This replaces a multiplication and an addition per iteration with an
+// addition, which matters for 64-bit indices as they are emulated with
+// several 32-bit instructions.
+class IndexStrengthReducer : private kir::ExprMutator {
+ public:
+  static std::vector<Expr*> run(const std::vector<Expr*>& exprs) {
+    IndexStrengthReducer reducer(exprs);
+    return std::move(reducer.exprs_);
+  }
+
+ private:
+  IndexStrengthReducer(const std::vector<Expr*>& exprs) {
+    IrVisitor::handle(exprs);
+    mutate();
+  }
+
+  using kir::ExprMutator::handle;
+
+  void handle(ForLoop* loop) final {
+    Scope* parent_scope = scope_.empty() ? nullptr : scope_.back();
+    kir::ExprMutator::handle(loop);
+    if (!isReducible(loop)) {
+      return;
+    }
+
+    // Values written inside the loop, which the initial value and the step
+    // must not depend on.
+    std::unordered_set<Val*> loop_variant{loop->index()};
+    for (Expr* expr : ir_utils::flattenScopedExprs(loop->body().exprs())) {
+      loop_variant.insert(expr->outputs().begin(), expr->outputs().end());
+      if (auto alloc = dynamic_cast<kir::Allocate*>(expr)) {
+        loop_variant.insert(alloc->buffer());
+      }
+    }
+
+    const std::vector<Expr*>& body = loop->body().exprs();
+    Expr* insert_ref = nullptr;
+    for (auto alloc : ir_utils::filterByType<kir::Allocate>(body)) {
+      Val* value = alloc->buffer();
+      Expr* def = value->definition();
+      if (!value->isIntegralScalar() || def == nullptr ||
+          std::find(body.begin(), body.end(), def) == body.end()) {
+        continue;
+      }
+      auto [init, step] = getInitAndStep(def, loop->index());
+      if (init == nullptr || dependsOn(init, loop_variant) ||
+          dependsOn(step, loop_variant)) {
+        continue;
+      }
+
+      registerRemove(alloc, &loop->body());
+      registerRemove(def, &loop->body());
+      if (insert_ref == nullptr) {
+        registerInsertBefore(loop, alloc, parent_scope);
+      } else {
+        registerInsertAfter(insert_ref, alloc, parent_scope);
+      }
+      insert_ref = IrBuilder::create<LoadStoreOp>(
+          LoadStoreOpType::Set, value, init);
+      registerInsertAfter(alloc, insert_ref, parent_scope);
+      registerInsertAfter(
+          body.back(),
+          IrBuilder::create<kir::IncrementScalar>(value, step),
+          &loop->body());
+    }
+  }
+
+  // Only serial loops that are not unrolled, start at zero, run with a unit
+  // step and always reach the end of their body are considered. Unrolled
+  // loops get constant indices from nvcc anyway.
+  static bool isReducible(ForLoop* loop) {
+    if (loop->isTrivial() || loop->isUnrolled() || loop->vectorize() ||
+        loop->iter_domain()->getParallelType() != ParallelType::Serial ||
+        loop->circularBufferLoopStage() !=
+            CircularBufferLoopStage::NotApplicable ||
+        !loop->start()->isZeroInt() || !loop->step()->isOneInt()) {
+      return false;
+    }
+    return std::none_of(
+        loop->body().exprs().begin(), loop->body().exprs().end(), [](Expr* e) {
+          auto exprs = ir_utils::flattenScopedExprs({e});
+          return std::any_of(exprs.begin(), exprs.end(), [](Expr* expr) {
+            return expr->isOneOf<kir::Continue, kir::Return>();
+          });
+        });
+  }
+
+  // Matches def with x + i * s, x + s * i, x + i, i * s or the operands of
+  // the addition swapped, and returns {x, s}. Returns {nullptr, nullptr} if
+  // def is not linear in index.
+  static std::pair<Val*, Val*> getInitAndStep(Expr* def, Val* index) {
+    Val* one = GpuLower::current()->kernel()->oneVal(index->dtype());
+    Val* zero = GpuLower::current()->kernel()->zeroVal(index->dtype());
+    auto get_step = [&](Val* term) -> Val* {
+      if (term == index) {
+        return one;
+      }
+      auto bop = dynamic_cast<BinaryOp*>(term->definition());
+      if (bop == nullptr || bop->getBinaryOpType() != BinaryOpType::Mul) {
+        return nullptr;
+      }
+      if (bop->lhs() == index) {
+        return bop->rhs();
+      }
+      if (bop->rhs() == index) {
+        return bop->lhs();
+      }
+      return nullptr;
+    };
+
+    auto bop = dynamic_cast<BinaryOp*>(def);
+    if (bop == nullptr) {
+      return {nullptr, nullptr};
+    }
+    if (bop->getBinaryOpType() == BinaryOpType::Mul) {
+      Val* step = get_step(bop->out());
+      return {step == nullptr ? nullptr : zero, step};
+    }
+    if (bop->getBinaryOpType() != BinaryOpType::Add) {
+      return {nullptr, nullptr};
+    }
+    if (Val* step = get_step(bop->rhs())) {
+      return {bop->lhs(), step};
+    }
+    if (Val* step = get_step(bop->lhs())) {
+      return {bop->rhs(), step};
+    }
+    return {nullptr, nullptr};
+  }
+
+  static bool dependsOn(Val* val, const std::unordered_set<Val*>& vals) {
+    std::vector<Val*> to_visit{val};
+    std::unordered_set<Val*> visited;
+    while (!to_visit.empty()) {
+      Val* v = to_visit.back();
+      to_visit.pop_back();
+      if (vals.count(v) != 0) {
+        return true;
+      }
+      if (!visited.insert(v).second || v->definition() == nullptr) {
+        continue;
+      }
+      to_visit.insert(
+          to_visit.end(),
+          v->definition()->inputs().begin(),
+          v->definition()->inputs().end());
+    }
+    return false;
+  }
+};
+
 } // namespace
 
 std::vector<Expr*> allocateCommonScalars(const std::vector<Expr*>& exprs) {
@@ -582,4 +743,12 @@ std::vector<Expr*> allocateCommonScalars(const std::vector<Expr*>& exprs) {
       exprs, GpuLower::current()->commonScalarMap());
 }
 
+std::vector<Expr*> strengthReduceIndices(const std::vector<Expr*>& exprs) {
+  if (!isOptionEnabled(EnableOption::StrengthReduceIndices) ||
+      isOptionDisabled(DisableOption::IndexHoist)) {
+    return exprs;
+  }
+  return IndexStrengthReducer::run(exprs);
+}
+
 } // namespace nvfuser
@@ -112,4 +112,10 @@ class CommonScalarMap {
 //! collecting all common indices.
 std::vector<Expr*> allocateCommonScalars(const std::vector<Expr*>& exprs);
 
+//! Initialize hoisted scalars that are linear in the index of a serial loop
+//! before the loop and increment them at the end of each iteration instead of
+//! recomputing them. Must be called after allocateCommonScalars. Enabled by
+//! EnableOption::StrengthReduceIndices.
+std::vector<Expr*> strengthReduceIndices(const std::vector<Expr*>& exprs);
+
 } // namespace nvfuser
@@ -15,6 +15,7 @@
 #include <ir/iostream.h>
 #include <ir/utils.h>
 #include <ops/arith.h>
+#include <options.h>
 #include <predicate_compute.h>
 
 namespace nvfuser {
@@ -33,6 +34,55 @@ ForLoop* cloneLoopNest(const ForLoop* for_loop) {
   return new_loop;
 }
 
+// Provide a new for loop matching the one provided but iterating over
+// [start, stop)
+ForLoop* cloneLoopNest(const ForLoop* for_loop, Val* start, Val* stop) {
+  const auto new_loop = IrBuilder::create<ForLoop>(
+      for_loop->iter_domain(),
+      for_loop->index(),
+      start,
+      stop,
+      for_loop->step(),
+      for_loop->vectorize(),
+      for_loop->vectorize_shift(),
+      for_loop->isUnrollRequired(),
+      for_loop->circularBufferLoopStage(),
+      for_loop->circularBufferLoopStageDepth());
+  for (auto expr : for_loop->body().exprs()) {
+    if (auto nested_for_loop = dynamic_cast<ForLoop*>(expr)) {
+      expr = cloneLoopNest(nested_for_loop);
+    }
+    new_loop->body().push_back(expr);
+  }
+  return new_loop;
+}
+
+// Returns true if scope only has tensor ops without block syncs, allocations
+// and for-loops with the same property, and sets has_unswitch if any of the
+// for-loops is unswitched or unrolled.
+bool isPeelableScope(const Scope& scope, bool& has_unswitch) {
+  const auto& pred_map = GpuLower::current()->threadPredMap();
+  for (auto expr : scope.exprs()) {
+    if (auto loop = dynamic_cast<ForLoop*>(expr)) {
+      if (loop->circularBufferLoopStage() !=
+          CircularBufferLoopStage::NotApplicable) {
+        return false;
+      }
+      const auto pt = loop->iter_domain()->getParallelType();
+      has_unswitch = has_unswitch || pt == ParallelType::Unswitch ||
+          pt == ParallelType::Unroll;
+      if (!isPeelableScope(loop->body(), has_unswitch)) {
+        return false;
+      }
+    } else if (!expr->isA<kir::Allocate>() &&
+               (!ir_utils::isTvOp(expr) ||
+                lower_utils::hasBlockSync(expr, pred_map))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
 void UnrollPass::registerReplace(Expr* reference, Expr* new_expr) {
@@ -246,9 +296,82 @@ void UnrollPass::dispatch(Expr* expr) {
   }
 }
 
+bool UnrollPass::canPeel(ForLoop* fl) const {
+  if (!look_for_unroll_ || peeling_ ||
+      !isOptionEnabled(EnableOption::PeelSerialLoops)) {
+    return false;
+  }
+  if (fl->iter_domain()->getParallelType() != ParallelType::Serial ||
+      fl->isTrivial() || !fl->start()->isZeroInt() ||
+      !fl->step()->isOneInt() ||
+      fl->circularBufferLoopStage() != CircularBufferLoopStage::NotApplicable) {
+    return false;
+  }
+  bool has_unswitch = false;
+  return isPeelableScope(fl->body(), has_unswitch) && has_unswitch;
+}
+
+// Peel the last iteration of fl as below, where the unswitch predicate of
+// the main loop is only evaluated once instead of at each iteration:
+//
+// if (unswitch predicate of [0, N-1)) {
+//   for (i : [0, N-1))
+//     body without predicates
+//   for (i : [max(0, N-1), N))
+//     body with unswitched loops and inline predicates
+// } else {
+//   for (i : [0, N))
+//     body with unswitched loops and inline predicates
+// }
+//
+// With a non-divisible split, only the last iteration of the outer loop
+// accesses out of bounds, so the main loop runs without predicates.
+void UnrollPass::peel(ForLoop* fl) {
+  Val* main_stop = SimplifyingIrBuilder::subExpr(
+      fl->stop(), GpuLower::current()->kernel()->oneVal());
+  ForLoop* main_loop = cloneLoopNest(fl, fl->start(), main_stop);
+  ForLoop* last_loop = cloneLoopNest(
+      fl, SimplifyingIrBuilder::maxExpr(fl->start(), main_stop), fl->stop());
+  ForLoop* inlined_loop = cloneLoopNest(fl);
+
+  auto peel_ite = IrBuilder::create<kir::IfThenElse>(
+      IrBuilder::create<kir::Predicate>(main_loop));
+  peel_ite->thenBody().push_back(main_loop);
+  peel_ite->thenBody().push_back(last_loop);
+  peel_ite->elseBody().push_back(inlined_loop);
+
+  peeling_ = true;
+
+  scope_.push_back(&peel_ite->thenBody());
+  scope_exprs_.push_back(peel_ite);
+  unswitched_loop_ = true;
+  look_for_unroll_ = false;
+  handle(main_loop);
+  unswitched_loop_ = false;
+  look_for_unroll_ = true;
+  handle(last_loop);
+  scope_.pop_back();
+  scope_exprs_.pop_back();
+
+  scope_.push_back(&peel_ite->elseBody());
+  scope_exprs_.push_back(peel_ite);
+  handle(inlined_loop);
+  scope_.pop_back();
+  scope_exprs_.pop_back();
+
+  peeling_ = false;
+
+  kir::ExprMutator::registerReplace(fl, peel_ite);
+}
+
 // We should factor our actual predicate generation from unrolling but insering
 // IR nodes "unroll_pred" or "inline_pred", then generate those later.
 void UnrollPass::handle(ForLoop* fl) {
+  if (canPeel(fl)) {
+    peel(fl);
+    return;
+  }
+
   // Setup for loop scoping
   const bool is_unroll =
       fl->iter_domain()->getParallelType() == ParallelType::Unroll ||
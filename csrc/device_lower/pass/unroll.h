@@ -77,6 +77,14 @@ class UnrollPass : kir::ExprMutator {
 
   void handle(ForLoop* fl) final;
 
+  //! Returns true if the last iteration of fl should be peeled. See peel.
+  bool canPeel(ForLoop* fl) const;
+
+  //! Peel the last iteration of a serial loop around unswitched loops so that
+  //! a single unswitch predicate covers the other iterations. Enabled by
+  //! EnableOption::PeelSerialLoops.
+  void peel(ForLoop* fl);
+
   void dispatch(Expr* expr) final;
 
  private:
@@ -86,6 +94,10 @@ class UnrollPass : kir::ExprMutator {
   // keep track if we're within an unrolled loop
   bool look_for_unroll_ = true;
 
+  // Set while the clones of a peeled loop are visited to avoid peeling
+  // nested loops
+  bool peeling_ = false;
+
   // Indicates if the currently visited expression is inside a
   // unswitched path
   bool unswitched_loop_ = false;
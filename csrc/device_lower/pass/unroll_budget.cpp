@@ -0,0 +1,344 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <device_lower/pass/unroll_budget.h>
+
+#include <device_lower/lower2device.h>
+#include <ir/utils.h>
+#include <iter_visitor.h>
+#include <kernel_ir.h>
+#include <options.h>
+#include <remarks.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nvfuser {
+
+namespace {
+
+// Rough SASS costs. Only the relative sizes matter since the budget is given
+// in the same unit.
+constexpr int64_t kLoopOverhead = 3; // increment, compare and branch
+constexpr int64_t kBranchCost = 2; // predicate and branch
+constexpr int64_t kSpecialFunctionCost = 8; // MUFU with range reduction
+constexpr int64_t kRuntimeFunctionCost = 64; // block and grid reductions
+constexpr int64_t kSassInstructionBytes = 16;
+
+int64_t unrollBudget() {
+  constexpr int64_t default_budget = 8192;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::UnrollBudget);
+  return option_args.empty() ? default_budget : std::stoll(option_args[0]);
+}
+
+bool isSpecialFunction(const Expr* expr) {
+  if (auto uop = dynamic_cast<const UnaryOp*>(expr)) {
+    switch (uop->getUnaryOpType()) {
+      case UnaryOpType::Acos:
+      case UnaryOpType::Acosh:
+      case UnaryOpType::Asin:
+      case UnaryOpType::Asinh:
+      case UnaryOpType::Atan:
+      case UnaryOpType::Atanh:
+      case UnaryOpType::Cos:
+      case UnaryOpType::Cosh:
+      case UnaryOpType::Exp:
+      case UnaryOpType::Exp2:
+      case UnaryOpType::Expm1:
+      case UnaryOpType::Erf:
+      case UnaryOpType::Erfc:
+      case UnaryOpType::Erfinv:
+      case UnaryOpType::Erfcinv:
+      case UnaryOpType::Gelu:
+      case UnaryOpType::Silu:
+      case UnaryOpType::Lgamma:
+      case UnaryOpType::Log:
+      case UnaryOpType::Log10:
+      case UnaryOpType::Log1p:
+      case UnaryOpType::Log2:
+      case UnaryOpType::Reciprocal:
+      case UnaryOpType::Rsqrt:
+      case UnaryOpType::Sigmoid:
+      case UnaryOpType::Sin:
+      case UnaryOpType::Sinh:
+      case UnaryOpType::Sqrt:
+      case UnaryOpType::Tan:
+      case UnaryOpType::Tanh:
+        return true;
+      default:
+        return false;
+    }
+  }
+  if (auto bop = dynamic_cast<const BinaryOp*>(expr)) {
+    switch (bop->getBinaryOpType()) {
+      case BinaryOpType::Atan2:
+      case BinaryOpType::Div:
+      case BinaryOpType::Fmod:
+      case BinaryOpType::Pow:
+      case BinaryOpType::Remainder:
+      case BinaryOpType::Mod:
+      case BinaryOpType::CeilDiv:
+        return true;
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
+// Reductions, broadcasts and Welford ops across threads call a function of
+// the runtime library, which is inlined into the kernel
+bool callsRuntimeFunction(const Expr* expr) {
+  if (expr->isOneOf<kir::GridBroadcast, kir::GridWelford>()) {
+    return true;
+  }
+  if (!expr->isOneOf<
+          ReductionOp,
+          GroupedReductionOp,
+          WelfordOp,
+          GroupedWelfordOp,
+          BroadcastOp>()) {
+    return false;
+  }
+  TensorView* out = ir_utils::getTvOutput(expr);
+  if (out == nullptr) {
+    return false;
+  }
+  return std::any_of(
+      out->getLoopDomain().begin(),
+      out->getLoopDomain().end(),
+      [](IterDomain* id) {
+        return id->isThread() && (id->isReduction() || id->isBroadcast());
+      });
+}
+
+// Returns the number of iterations of an unrolled loop. isUnrolled()
+// guarantees that its start and stop are constant.
+int64_t tripCount(const ForLoop* loop) {
+  const int64_t start = loop->start()->evaluate().as<int64_t>();
+  const int64_t stop = loop->stop()->evaluate().as<int64_t>();
+  const int64_t step = loop->step()->isConstScalar()
+      ? loop->step()->evaluate().as<int64_t>()
+      : 1;
+  return std::max(ceilDiv(stop - start, step), (int64_t)0);
+}
+
+// Returns the number of copies of the body that the loop is unrolled into
+int64_t unrollFactor(const ForLoop* loop) {
+  const int64_t trip_count = tripCount(loop);
+  return loop->maxUnrollFactor() > 0
+      ? std::min(loop->maxUnrollFactor(), trip_count)
+      : trip_count;
+}
+
+class InstructionCountEstimator {
+ public:
+  int64_t estimate(const std::vector<Expr*>& exprs) {
+    int64_t count = 0;
+    for (Expr* expr : exprs) {
+      if (auto loop = dynamic_cast<ForLoop*>(expr)) {
+        count += estimate(loop);
+      } else if (auto ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+        count += kBranchCost + estimate(ite->thenBody().exprs()) +
+            estimate(ite->elseBody().exprs());
+      } else {
+        count += exprCost(expr);
+      }
+    }
+    return count;
+  }
+
+ private:
+  int64_t estimate(const ForLoop* loop) {
+    const int64_t body = estimate(loop->body().exprs());
+    if (loop->isTrivial()) {
+      return body;
+    }
+    if (!loop->isUnrolled()) {
+      return body + kLoopOverhead;
+    }
+    const int64_t trip_count = tripCount(loop);
+    const int64_t factor = unrollFactor(loop);
+    if (factor >= trip_count) {
+      return trip_count * body;
+    }
+    // nvcc fully unrolls the remainder of a partially unrolled loop
+    return (factor + trip_count % factor) * body + kLoopOverhead;
+  }
+
+  int64_t exprCost(const Expr* expr) {
+    auto it = expr_costs_.find(expr);
+    if (it != expr_costs_.end()) {
+      return it->second;
+    }
+    if (expr->isA<kir::Allocate>()) {
+      expr_costs_.emplace(expr, 0);
+      return 0;
+    }
+    int64_t cost = 1;
+    if (callsRuntimeFunction(expr)) {
+      cost = kRuntimeFunctionCost * (int64_t)expr->outputs().size();
+    } else if (isSpecialFunction(expr)) {
+      cost = kSpecialFunctionCost;
+    }
+    // Offsets that are not hoisted are computed next to each access
+    std::unordered_set<const Expr*> visited;
+    for (Val* val : expr->inputs()) {
+      if (auto ti = dynamic_cast<kir::TensorIndex*>(val)) {
+        cost += indexCost(ti->index(), visited);
+      }
+    }
+    for (Val* val : expr->outputs()) {
+      if (auto ti = dynamic_cast<kir::TensorIndex*>(val)) {
+        cost += indexCost(ti->index(), visited);
+      }
+    }
+    expr_costs_.emplace(expr, cost);
+    return cost;
+  }
+
+  static int64_t indexCost(
+      const Val* index,
+      std::unordered_set<const Expr*>& visited) {
+    const Expr* def = index->definition();
+    if (def == nullptr || !visited.insert(def).second) {
+      return 0;
+    }
+    int64_t cost = isSpecialFunction(def) ? kSpecialFunctionCost : 1;
+    for (Val* input : def->inputs()) {
+      cost += indexCost(input, visited);
+    }
+    return cost;
+  }
+
+  std::unordered_map<const Expr*, int64_t> expr_costs_;
+};
+
+// Returns whether a register array in exprs is indexed by the index of loop.
+// Partially unrolling loop would make the index dynamic and move the array to
+// local memory.
+bool indexesRegisterArray(
+    const ForLoop* loop,
+    const std::vector<Expr*>& exprs) {
+  for (Expr* expr : exprs) {
+    if (auto inner_loop = dynamic_cast<ForLoop*>(expr)) {
+      if (indexesRegisterArray(loop, inner_loop->body().exprs())) {
+        return true;
+      }
+      continue;
+    }
+    if (auto ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+      if (indexesRegisterArray(loop, ite->thenBody().exprs()) ||
+          indexesRegisterArray(loop, ite->elseBody().exprs())) {
+        return true;
+      }
+      continue;
+    }
+    auto operands = expr->inputs();
+    operands.insert(
+        operands.end(), expr->outputs().begin(), expr->outputs().end());
+    for (Val* val : operands) {
+      auto ti = dynamic_cast<kir::TensorIndex*>(val);
+      if (ti != nullptr &&
+          ti->view()->getMemoryType() == MemoryType::Local &&
+          DependencyCheck::isDependencyOf(loop->index(), ti->index())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void collectCandidates(
+    const std::vector<Expr*>& exprs,
+    std::vector<ForLoop*>& candidates) {
+  for (Expr* expr : exprs) {
+    if (auto loop = dynamic_cast<ForLoop*>(expr)) {
+      if (!loop->isTrivial() && loop->isUnrolled() &&
+          !loop->isUnrollRequired() &&
+          loop->circularBufferLoopStage() ==
+              CircularBufferLoopStage::NotApplicable &&
+          tripCount(loop) > 1 &&
+          !indexesRegisterArray(loop, loop->body().exprs())) {
+        candidates.push_back(loop);
+      }
+      collectCandidates(loop->body().exprs(), candidates);
+    } else if (auto ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+      collectCandidates(ite->thenBody().exprs(), candidates);
+      collectCandidates(ite->elseBody().exprs(), candidates);
+    }
+  }
+}
+
+} // namespace
+
+std::vector<Expr*> capUnrollFactors(const std::vector<Expr*>& exprs) {
+  InstructionCountEstimator estimator;
+  int64_t count = estimator.estimate(exprs);
+
+  if (isOptionEnabled(EnableOption::UnrollBudget)) {
+    const int64_t budget = unrollBudget();
+    std::vector<ForLoop*> candidates;
+    collectCandidates(exprs, candidates);
+
+    // Greedily halve the unroll factor that saves the most instructions
+    std::vector<ForLoop*> capped_loops;
+    while (count > budget) {
+      ForLoop* best_loop = nullptr;
+      int64_t best_count = count;
+      for (ForLoop* loop : candidates) {
+        const int64_t factor = unrollFactor(loop);
+        if (factor <= 1) {
+          continue;
+        }
+        const int64_t max_factor = loop->maxUnrollFactor();
+        loop->setMaxUnrollFactor(factor / 2);
+        const int64_t new_count = estimator.estimate(exprs);
+        loop->setMaxUnrollFactor(max_factor);
+        if (new_count < best_count) {
+          best_loop = loop;
+          best_count = new_count;
+        }
+      }
+      if (best_loop == nullptr) {
+        break;
+      }
+      if (best_loop->maxUnrollFactor() == 0) {
+        capped_loops.push_back(best_loop);
+      }
+      best_loop->setMaxUnrollFactor(unrollFactor(best_loop) / 2);
+      count = best_count;
+    }
+
+    if (remarks::isActive()) {
+      for (ForLoop* loop : capped_loops) {
+        remarks::report(
+            "unroll_budget",
+            "capped unroll factor of loop",
+            {{"iter_domain", loop->iter_domain()->toString()},
+             {"trip_count", std::to_string(tripCount(loop))},
+             {"unroll_factor", std::to_string(loop->maxUnrollFactor())}});
+      }
+    }
+  }
+
+  GpuLower::current()->estimatedInstructionCount() = count;
+  if (remarks::isActive()) {
+    remarks::report(
+        "unroll_budget",
+        "estimated kernel size",
+        {{"instructions", std::to_string(count)},
+         {"sass_bytes", std::to_string(count * kSassInstructionBytes)}});
+  }
+  return exprs;
+}
+
+} // namespace nvfuser
@@ -0,0 +1,29 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <ir/all_nodes.h>
+
+#include <vector>
+
+namespace nvfuser {
+
+//! Estimate the number of SASS instructions of the kernel from the indexed
+//! expressions, counting each unrolled loop as many copies of its body as it
+//! has iterations. The estimate is kept in
+//! KernelSummary::estimated_instruction_count and reported as a remark.
+//!
+//! With EnableOption::UnrollBudget, the unroll factors of the loops
+//! contributing the most instructions are halved until the estimate fits the
+//! budget, which codegen emits as "#pragma unroll N". Loops that index
+//! register arrays, loops that must be unrolled and circular buffered loops are
+//! left alone since partially unrolling them would move their buffers to local
+//! memory or break the pipelining. Must be called after IndexLowering.
+std::vector<Expr*> capUnrollFactors(const std::vector<Expr*>& exprs);
+
+} // namespace nvfuser
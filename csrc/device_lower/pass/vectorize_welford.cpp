@@ -111,10 +111,14 @@ class WelfordVectorizer : public kir::ExprMutator {
 
     // This optimization should be safe for the initial sequential
     // welford, where the var and N arguments are zero and one,
-    // respectively. It should also be mostly safe otherwise, but not
-    // guaranteed.
-    if (out_domain->hasBlockReduction() || out_domain->hasGridReduction() ||
-        !wop->inVar()->isZeroInt() || !wop->inN()->isOneInt()) {
+    // respectively, and for merging partial results whose counts are
+    // known to be uniform. It should also be mostly safe otherwise,
+    // but not guaranteed.
+    if (out_domain->hasBlockReduction() || out_domain->hasGridReduction()) {
+      return false;
+    }
+
+    if (!isSingleValueUpdate(wop) && !hasUniformInputCount(wop)) {
       return false;
     }
 
@@ -153,6 +157,53 @@ class WelfordVectorizer : public kir::ExprMutator {
     return true;
   }
 
+  // Check if a WelfordOp updates its output with one value at a time,
+  // i.e., the initial sequential welford
+  static bool isSingleValueUpdate(WelfordOp* wop) {
+    return wop->inVar()->isZeroInt() && wop->inN()->isOneInt();
+  }
+
+  // Check if a WelfordOp merges partial results whose count is the
+  // same in all iterations of the innermost loop, so that it can be
+  // hoisted just like the count of the output. This is the case when
+  // the partial results are the output of another WelfordOp, e.g.,
+  // the rfactor of an outer reduction, as its count only depends on
+  // the reduction and the innermost loop is mapped with a vectorized
+  // IterDomain.
+  bool hasUniformInputCount(WelfordOp* wop) const {
+    auto in_N = dynamic_cast<kir::TensorIndex*>(wop->inN());
+    if (in_N == nullptr) {
+      return false;
+    }
+
+    // The hoisted count is read without the predicate of the
+    // WelfordOp, which is only safe for register buffers
+    TensorView* in_N_tv = in_N->view();
+    if (in_N_tv->getMemoryType() != MemoryType::Local) {
+      return false;
+    }
+
+    auto producer = dynamic_cast<WelfordOp*>(in_N_tv->definition());
+    if (producer == nullptr || producer->outN() != in_N_tv) {
+      return false;
+    }
+
+    // The partial results must be complete before the innermost loop
+    NVF_ERROR(!for_loops_.empty());
+    for (Expr* expr :
+         lower_utils::flattenScopedExprs(for_loops_.back()->body().exprs())) {
+      if (std::any_of(
+              expr->outputs().begin(), expr->outputs().end(), [&](Val* out) {
+                auto ti = dynamic_cast<kir::TensorIndex*>(out);
+                return ti != nullptr && ti->view() == in_N_tv;
+              })) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   // Transform a serial WelfordOp.
   void vectorize(WelfordOp* wop) {
     NVF_ERROR(!scope_exprs_.empty());
@@ -326,19 +377,38 @@ class WelfordVectorizer : public kir::ExprMutator {
 
     auto hoisted_count = hoistCount(wop->outN()->as<kir::TensorIndex>());
 
+    // When merging partial results, the count of the partial results
+    // is added instead of one
+    const bool is_merge = !isSingleValueUpdate(wop);
+    Val* input_count = is_merge
+        ? hoistCount(wop->inN()->as<kir::TensorIndex>())
+        : GpuLower::current()->kernel()->oneVal();
+
     Val* count_increment = nullptr;
     if (!is_predicated) {
-      count_increment = GpuLower::current()->kernel()->oneVal();
+      count_increment = input_count;
     } else {
       // count_increment = (int)pred;
       count_increment = defineScalar(index_type);
       registerInsertBeforeInnerMostLoop(
           IrBuilder::create<UnaryOp>(UnaryOpType::Cast, count_increment, pred));
+      if (is_merge) {
+        // count_increment = (int)pred * input_count;
+        auto pred_count = count_increment;
+        count_increment = defineScalar(index_type);
+        registerInsertBeforeInnerMostLoop(IrBuilder::create<BinaryOp>(
+            BinaryOpType::Mul, count_increment, pred_count, input_count));
+      }
     }
 
     registerInsertBeforeInnerMostLoop(IrBuilder::create<BinaryOp>(
         BinaryOpType::Add, new_count, hoisted_count, count_increment));
 
+    if (is_merge) {
+      return applyMergeTransformation(
+          wop, pred, hoisted_count, count_increment, new_count);
+    }
+
     // float new_count_float;
     auto new_count_float = defineScalar(data_type);
 
@@ -386,6 +456,69 @@ class WelfordVectorizer : public kir::ExprMutator {
     return vectorized_wop;
   }
 
+  // Merge of partial results with uniform counts
+  //
+  // Before:
+  // for () {
+  //   welfordCombine(outAvg, outVar, outN, inAvg, inVar, inN);
+  // }
+  //
+  // After:
+  // nvfuser_index_t new_count = outN[0] + inN[0];
+  // float ratio = (float)inN[0] / (float)max(new_count, 1);
+  // float scale = (float)outN[0] * ratio;
+  // for () {
+  //   welfordVectorizedCombine(..., ratio, scale, new_count);
+  // }
+  //
+  // When predicated, count_increment is inN[0] if the predicate holds
+  // and zero otherwise.
+  kir::VectorizedWelfordOp* applyMergeTransformation(
+      WelfordOp* wop,
+      Val* pred,
+      Val* hoisted_count,
+      Val* count_increment,
+      Val* new_count) {
+    DataType data_type = wop->outAvg()->getDataType().value();
+    DataType index_type = wop->outN()->getDataType().value();
+
+    auto toFloat = [&](Val* count) {
+      auto count_float = defineScalar(data_type);
+      registerInsertBeforeInnerMostLoop(
+          IrBuilder::create<UnaryOp>(UnaryOpType::Cast, count_float, count));
+      return count_float;
+    };
+
+    // Avoid dividing by zero when no partial result has been merged
+    // yet
+    auto safe_count = defineScalar(index_type);
+    registerInsertBeforeInnerMostLoop(IrBuilder::create<BinaryOp>(
+        BinaryOpType::Max,
+        safe_count,
+        new_count,
+        GpuLower::current()->kernel()->oneVal()));
+
+    auto ratio = defineScalar(data_type);
+    registerInsertBeforeInnerMostLoop(IrBuilder::create<BinaryOp>(
+        BinaryOpType::Div,
+        ratio,
+        toFloat(count_increment),
+        toFloat(safe_count)));
+
+    auto scale = defineScalar(data_type);
+    registerInsertBeforeInnerMostLoop(IrBuilder::create<BinaryOp>(
+        BinaryOpType::Mul, scale, toFloat(hoisted_count), ratio));
+
+    return IrBuilder::create<kir::VectorizedWelfordOp>(
+        wop->outputTriplet(),
+        wop->inputTriplet(),
+        wop->initTriplet(),
+        new_count,
+        ratio,
+        pred,
+        scale);
+  }
+
   // Declare a scalar variable of type dt and insert its allocation
   Val* defineScalar(DataType dt) {
     Val* val = IrBuilder::create<Val>(dt);
@@ -260,8 +260,8 @@ class FuseBroadcastWithWarpReduce : private kir::IrVisitor {
     }
     if (auto tv = dynamic_cast<TensorView*>(allocate->buffer())) {
       if (tv->definition()) {
-        if (tv->definition()->isA<ReductionOp>() ||
-            tv->definition()->isA<BroadcastOp>()) {
+        if (tv->definition()
+                ->isOneOf<ReductionOp, GroupedReductionOp, BroadcastOp>()) {
           running_visible_allocation_stack_.back()->push_back(allocate);
         }
       }
@@ -341,6 +341,22 @@ class FuseBroadcastWithWarpReduce : private kir::IrVisitor {
         reduction_allocate;
   }
 
+  //! Same as above for each of the grouped reductions, which are reduced by
+  //!  a single grouped warp reduction
+  void handle(GroupedReductionOp* grouped_rop) final {
+    if (!isOpOutputRegisterTV(grouped_rop)) {
+      return;
+    }
+    for (auto out : grouped_rop->outputs()) {
+      auto reduction_ti_out = dynamic_cast<kir::TensorIndex*>(out);
+      NVF_ERROR(
+          reduction_ti_out,
+          "lower_warp_reduce: Pass needs to be run after indexing");
+      running_tv_to_allocate_map_.back()->operator[](reduction_ti_out->view()) =
+          getActiveAllocateFor(reduction_ti_out->view());
+    }
+  }
+
   void handle(BroadcastOp* broadcast) final {
     if (!isOpInputRegisterTV(broadcast) || !isOpOutputRegisterTV(broadcast)) {
       return;
@@ -353,7 +369,9 @@ class FuseBroadcastWithWarpReduce : private kir::IrVisitor {
   //!  conditions check.
   void tryAddOutputToReplaceMap(BroadcastOp* broadcast) {
     if (auto in_ti = dynamic_cast<kir::TensorIndex*>(broadcast->in())) {
-      if (!in_ti->view()->definition()->isA<ReductionOp>()) {
+      if (!in_ti->view()
+               ->definition()
+               ->isOneOf<ReductionOp, GroupedReductionOp>()) {
         return;
       }
       auto out_ti = broadcast->out()->as<kir::TensorIndex>();
@@ -782,6 +782,12 @@ bool hasBlockSync(const Expr* expr, const ThreadPredicateMap& pred_map) {
     return false;
   }
 
+  if (auto gr = dynamic_cast<const kir::GridReduction*>(expr);
+      gr && gr->isAtomic()) {
+    // Atomic GridReductions only add to global memory
+    return false;
+  }
+
   // GroupedReductionOp can have multiple output TVs, but they must be
   // parallelized in the same way, so just checking one of them is enough.
   auto tv = ir_utils::getTvOutput(expr);
@@ -788,7 +788,8 @@ void validateAndCollectVectorizeInfo(Fusion* fusion) {
                def->as<TernaryOp>()->getTernaryOpType() ==
                    TernaryOpType::Where) ||
               (def->isA<ReductionOp>() &&
-               def->as<ReductionOp>()->serialGridReductionRequested()),
+               (def->as<ReductionOp>()->serialGridReductionRequested() ||
+                def->as<ReductionOp>()->atomicGridReductionRequested())),
           "Vectorized accesses cannot be inline with computation: ",
           (def == nullptr ? tv->toString() : def->toString()));
     }
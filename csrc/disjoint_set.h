@@ -97,6 +97,20 @@ class VectorOfUniqueEntries {
     return any_added;
   }
 
+  // Inserts the entries of other that are not in this container before the
+  // existing ones, keeping their order. Returns true if any node was added.
+  template <class Container>
+  bool pushFront(const Container& other) {
+    std::vector<T> added;
+    for (const auto& entry : other) {
+      if (set_.emplace(entry).second) {
+        added.push_back(entry);
+      }
+    }
+    vector_.insert(vector_.begin(), added.begin(), added.end());
+    return !added.empty();
+  }
+
   // Returns a new VectorOfUniqueEntries with entries that are in both this and
   // other, order is preserved as this.
   VectorOfUniqueEntries<T, Hash> computeIntersect(
@@ -366,52 +380,84 @@ class DisjointSets {
         std::make_pair(entry, disjoint_sets_.back()));
   }
 
-  // Adds all of the disjoint set belonging to entry1 to the disjoint set
-  // belonging to entry0, maps all entries of disjoint set belonging to entry1
-  // to entry0, removes original disjoint set belonging to entry1.
+  // Merges the disjoint sets of entry0 and entry1 into a set holding the
+  // entries of the set of entry0 followed by those of the set of entry1, which
+  // is moved to the end of disjointSets(). A set only referenced by this
+  // container is reused for the merged set, like in union by size, so that
+  // only the entries of the other set are rehashed and remapped. Sets also
+  // held elsewhere, e.g., by a caller, are left untouched and a new set is
+  // made, so that the caller doesn't see them change.
   void mapEntries(T entry0, T entry1) {
-    auto set_it_0 = disjoint_set_maps_.find(entry0);
-    auto set_it_1 = disjoint_set_maps_.find(entry1);
+    if (entry0 == entry1) {
+      initializeSet(entry0);
+      return;
+    }
 
-    auto set_0_found = set_it_0 != disjoint_set_maps_.end();
-    auto set_1_found = set_it_1 != disjoint_set_maps_.end();
+    auto find_set = [this](const T& entry) -> DisjointSet {
+      auto it = disjoint_set_maps_.find(entry);
+      return it == disjoint_set_maps_.end() ? nullptr : it->second;
+    };
+    DisjointSet set0 = find_set(entry0);
+    DisjointSet set1 = find_set(entry1);
 
     // Sets already joined
-    if (set_0_found && set_1_found && set_it_0->second == set_it_1->second) {
+    if (set0 != nullptr && set0 == set1) {
       return;
     }
 
-    // Make and map new set
-    disjoint_sets_.push_back(
-        std::make_shared<VectorOfUniqueEntries<T, Hash>>());
-    auto new_set = disjoint_sets_.back();
-
-    // Add an entry to new_set along with the other entries previously
-    // grouped together with the entry. The existing set is erased.
-    auto mergeSets = [this](const T& entry, auto& new_set) {
-      if (auto it = disjoint_set_maps_.find(entry);
-          it != disjoint_set_maps_.end()) {
-        auto existing_set = it->second;
-        for (const auto& existing_entry : *existing_set) {
-          new_set->pushBack(existing_entry);
-          disjoint_set_maps_[existing_entry] = new_set;
+    // A set is referenced by each of its entries in disjoint_set_maps_, by
+    // disjoint_sets_ and by the local copy above
+    auto is_reusable = [](const DisjointSet& set) {
+      return set != nullptr && set.use_count() == set->size() + 2;
+    };
+    auto size_of = [](const DisjointSet& set) {
+      return set == nullptr ? (int64_t)1 : set->size();
+    };
+
+    // Adds entry along with the other entries previously grouped together
+    // with it to merged_set. The existing set is erased.
+    auto absorb = [this](
+                      const T& entry,
+                      const DisjointSet& existing_set,
+                      const DisjointSet& merged_set,
+                      bool at_front) {
+      if (existing_set == nullptr) {
+        if (at_front) {
+          merged_set->pushFront(std::vector<T>{entry});
+        } else {
+          merged_set->pushBack(entry);
         }
-        disjoint_sets_.erase(std::find(
-            disjoint_sets_.begin(), disjoint_sets_.end(), existing_set));
+        disjoint_set_maps_[entry] = merged_set;
+        return;
+      }
+      if (at_front) {
+        merged_set->pushFront(*existing_set);
       } else {
-        new_set->pushBack(entry);
-        disjoint_set_maps_[entry] = new_set;
+        merged_set->pushBack(*existing_set);
+      }
+      for (const auto& existing_entry : *existing_set) {
+        disjoint_set_maps_[existing_entry] = merged_set;
       }
+      eraseSet(existing_set);
     };
 
-    mergeSets(entry0, new_set);
-
-    // This should be after we enter a new set in case it doesn't exist.
-    if (entry0 == entry1) {
-      return;
+    const bool reuse0 = is_reusable(set0);
+    const bool reuse1 = is_reusable(set1);
+    if (reuse0 && (!reuse1 || size_of(set0) >= size_of(set1))) {
+      eraseSet(set0);
+      disjoint_sets_.push_back(set0);
+      absorb(entry1, set1, set0, /*at_front=*/false);
+    } else if (reuse1) {
+      eraseSet(set1);
+      disjoint_sets_.push_back(set1);
+      absorb(entry0, set0, set1, /*at_front=*/true);
+    } else {
+      disjoint_sets_.push_back(
+          std::make_shared<VectorOfUniqueEntries<T, Hash>>());
+      DisjointSet new_set = disjoint_sets_.back();
+      absorb(entry0, set0, new_set, /*at_front=*/false);
+      absorb(entry1, set1, new_set, /*at_front=*/false);
     }
-
-    mergeSets(entry1, new_set);
   }
 
   // Will assert if provided entry0 is not in any disjoint set, otherwise
@@ -467,8 +513,7 @@ class DisjointSets {
           set->front() == entry,
           "Disjoint set container found to be in inconsistent state.");
       disjoint_set_maps_.erase(entry);
-      disjoint_sets_.erase(
-          std::find(disjoint_sets_.begin(), disjoint_sets_.end(), set));
+      eraseSet(set);
     } else {
       disjoint_set_maps_.erase(entry);
       set->erase(entry);
@@ -514,6 +559,12 @@ class DisjointSets {
   }
 
  private:
+  // Removes set from the list of disjoint sets
+  void eraseSet(const DisjointSet& set) {
+    disjoint_sets_.erase(
+        std::find(disjoint_sets_.begin(), disjoint_sets_.end(), set));
+  }
+
   // Disjoint sets
   DisjointSetMap disjoint_set_maps_;
 
@@ -150,6 +150,7 @@ class Val;
   f(AllocateFusedReduction);          \
   f(InitMagicZero);                   \
   f(UpdateMagicZero);                 \
+  f(IncrementScalar);                 \
   f(GetRNGSeedAndOffsetFromHost);     \
   f(EncodeTensorMapTiled);            \
   f(RNGOp);
@@ -53,11 +53,13 @@ namespace nvfuser {
 // integrated into the vanilla APIs and are therefore removed. Refer to
 // https://docs.nvidia.com/cuda/archive/11.7.1/cuda-driver-api/group__CUDA__MEMOP.html
 #if (CUDA_VERSION >= 12000)
-#define ALL_DRIVER_API_WRAPPER(fn) \
-  ALL_DRIVER_API_WRAPPER_CUDA(fn); \
-  fn(cuStreamWaitValue32, 12000);  \
-  fn(cuStreamWriteValue32, 12000); \
-  fn(cuTensorMapEncodeTiled, 12000)
+#define ALL_DRIVER_API_WRAPPER(fn)   \
+  ALL_DRIVER_API_WRAPPER_CUDA(fn);   \
+  fn(cuLaunchKernelEx, 12000);       \
+  fn(cuStreamWaitValue32, 12000);    \
+  fn(cuStreamWriteValue32, 12000);   \
+  fn(cuTensorMapEncodeTiled, 12000); \
+  fn(cuTensorMapReplaceAddress, 12000)
 #elif (CUDA_VERSION >= 11000)
 #define ALL_DRIVER_API_WRAPPER(fn) \
   ALL_DRIVER_API_WRAPPER_CUDA(fn); \
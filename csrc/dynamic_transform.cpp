@@ -62,6 +62,10 @@ DynamicTransformInitialInfo DynamicTransformInitialInfo::clone(
   for (const auto v : root_dynamic_vals_) {
     cloned_info.root_dynamic_vals_.insert(ir_cloner.clone(v));
   }
+  cloned_info.root_vals_affecting_concretization_ =
+      ir_cloner.clone(root_vals_affecting_concretization_);
+  cloned_info.root_extents_checked_for_zero_ =
+      ir_cloner.clone(root_extents_checked_for_zero_);
   return cloned_info;
 }
 
@@ -230,7 +234,7 @@ class DynamicTransformInitialInfoBuilder : public IterVisitor {
       if (!id->getMaybeExpandedExtent()->isConstScalar() ||
           id->getMaybeExpandedExtent()->evaluate().as<int64_t>() == 0) {
         info_.maybe_zero_extents_set_.insert(id->getMaybeExpandedExtent());
-        loop_dynamic_vals_.push_back(id->getMaybeExpandedExtent());
+        maybe_zero_loop_vals_.push_back(id->getMaybeExpandedExtent());
       }
       if (!id->definition() || id->getIterType() != IterType::Symbolic) {
         continue;
@@ -246,8 +250,26 @@ class DynamicTransformInitialInfoBuilder : public IterVisitor {
   //! Process vector of loop dynamic values by finding inputs and recording the
   //! result into info_
   void finalizeDynamicVals() {
+    // An extent of a possibly empty tensor that is a root Val only matters
+    // by being zero or not, unless it is used by a dynamic op as well. Other
+    // extents are computed from their root Vals, whose values matter.
+    std::vector<Val*> zero_checked_extents;
+    for (Val* extent : maybe_zero_loop_vals_) {
+      if (extent->definition() == nullptr ||
+          extent->definition()->inputs().empty()) {
+        zero_checked_extents.push_back(extent);
+      } else {
+        loop_dynamic_vals_.push_back(extent);
+      }
+    }
     const auto inputs = InputsOf::outputs(loop_dynamic_vals_);
     info_.root_dynamic_vals_.insert(inputs.begin(), inputs.end());
+    info_.root_vals_affecting_concretization_ = inputs;
+    for (Val* extent : zero_checked_extents) {
+      if (info_.root_dynamic_vals_.insert(extent).second) {
+        info_.root_extents_checked_for_zero_.push_back(extent);
+      }
+    }
 
     // initial_info_ provides a set of Vals that are used for concretization.
     // Here we check which scalar inputs, if any, correspond to any of those
@@ -282,6 +304,9 @@ class DynamicTransformInitialInfoBuilder : public IterVisitor {
   //! scalars that influence concretization. That list of scalars is then used
   //! to compute a minimal cache key in InputsIdLookup::lookupId().
   std::vector<Val*> loop_dynamic_vals_;
+
+  //! Extents of possibly empty tensors, which are only checked for being zero
+  std::vector<Val*> maybe_zero_loop_vals_;
 };
 
 DynamicTransformConcretizationInfo::DynamicTransformConcretizationInfo(
@@ -58,6 +58,19 @@ class DynamicTransformInitialInfo {
     return root_dynamic_vals_;
   }
 
+  //! Return the Vals of getRootDynamicVals() whose values affect
+  //! concretization, in a deterministic order
+  const std::vector<Val*>& getRootValsAffectingConcretization() const {
+    return root_vals_affecting_concretization_;
+  }
+
+  //! Return the other Vals of getRootDynamicVals(), which are extents of
+  //! possibly empty tensors and only affect concretization by being zero or
+  //! not, in a deterministic order
+  const std::vector<Val*>& getRootExtentsCheckedForZero() const {
+    return root_extents_checked_for_zero_;
+  }
+
   //! Return a set of scalars that appear as extents in TensorViews in the
   //! Fusion. If any of these evaluate to zero, there is at least one empty
   //! TensorView present.
@@ -140,6 +153,10 @@ class DynamicTransformInitialInfo {
 
   // Root Vals that determine concretization
   std::unordered_set<Val*> root_dynamic_vals_;
+  // root_dynamic_vals_ split by whether their values or only whether they are
+  // zero matter
+  std::vector<Val*> root_vals_affecting_concretization_;
+  std::vector<Val*> root_extents_checked_for_zero_;
 
   friend class DynamicTransformInitialInfoBuilder;
 };
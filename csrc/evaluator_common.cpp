@@ -16,6 +16,9 @@
 #include <runtime/executor_kernel_arg.h>
 #include <tensor_metadata.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
 #include <optional>
 
 namespace nvfuser {
@@ -398,6 +401,12 @@ void PrecomputedValues::bindTensorMetaData(
 NaiveValueMachine::NaiveValueMachine(PrecomputedValues& precomputed_values)
     : precomputed_values_(precomputed_values), num_of_instructions_{0} {
   for (auto val : precomputed_values_.symbols_) {
+    // Constants are folded into the workspace by initializeValueList and
+    //  their instructions would always be skipped by run(), so don't emit
+    //  them at all.
+    if (precomputed_values_.is_constant_[val->evaluatorIndex()]) {
+      continue;
+    }
     auto def = val->definition();
     if (def) {
       if (auto uop = dynamic_cast<UnaryOp*>(def)) {
@@ -433,14 +442,27 @@ void NaiveValueMachine::copyFrom(const NaiveValueMachine& other) {
   bop_type_.insert(
       bop_type_.end(), other.bop_type_.begin(), other.bop_type_.end());
 
+  top_type_.clear();
+  top_type_.insert(
+      top_type_.end(), other.top_type_.begin(), other.top_type_.end());
+
   src0_.clear();
   src0_.insert(src0_.end(), other.src0_.begin(), other.src0_.end());
 
   src1_.clear();
   src1_.insert(src1_.end(), other.src1_.begin(), other.src1_.end());
 
+  src2_.clear();
+  src2_.insert(src2_.end(), other.src2_.begin(), other.src2_.end());
+
   dest_.clear();
   dest_.insert(dest_.end(), other.dest_.begin(), other.dest_.end());
+
+  int64_op_type_.clear();
+  int64_op_type_.insert(
+      int64_op_type_.end(),
+      other.int64_op_type_.begin(),
+      other.int64_op_type_.end());
 }
 
 void NaiveValueMachine::run() {
@@ -451,6 +473,9 @@ void NaiveValueMachine::run() {
         precomputed_values_.is_constant_[dest_[i]]) {
       continue;
     }
+    if (int64_op_type_[i] != Int64OpType::NONE && runInt64Op(i)) {
+      continue;
+    }
     runInstruction(i);
   }
 }
@@ -469,6 +494,7 @@ void NaiveValueMachine::makeUnaryOp(UnaryOp* uop) {
   }
   src0_[index] = in;
   dest_[index] = out;
+  int64_op_type_[index] = getInt64OpType(uop);
 }
 
 void NaiveValueMachine::makeBinaryOp(BinaryOp* bop) {
@@ -486,6 +512,7 @@ void NaiveValueMachine::makeBinaryOp(BinaryOp* bop) {
   src0_[index] = in0;
   src1_[index] = in1;
   dest_[index] = out;
+  int64_op_type_[index] = getInt64OpType(bop);
 }
 
 void NaiveValueMachine::makeTernaryOp(TernaryOp* top) {
@@ -506,6 +533,7 @@ void NaiveValueMachine::makeTernaryOp(TernaryOp* top) {
   src1_[index] = in1;
   src2_[index] = in2;
   dest_[index] = out;
+  int64_op_type_[index] = getInt64OpType(top);
 }
 
 int NaiveValueMachine::makeInstructionEntry() {
@@ -519,6 +547,7 @@ int NaiveValueMachine::makeInstructionEntry() {
   src1_.emplace_back(-1);
   src2_.emplace_back(-1);
   dest_.emplace_back(-1);
+  int64_op_type_.emplace_back(Int64OpType::NONE);
   return index;
 }
 
@@ -734,4 +763,148 @@ void NaiveValueMachine::runTernaryOp(int index) {
   precomputed_values_.defined_[dest_index] = true;
 }
 
+NaiveValueMachine::Int64OpType NaiveValueMachine::getInt64OpType(
+    Expr* expr) {
+  auto is_integral = [](Val* val) {
+    return val->getDataType().has_value() && isIntegralType(val->dtype());
+  };
+  if (!std::all_of(expr->inputs().begin(), expr->inputs().end(), is_integral) ||
+      !std::all_of(
+          expr->outputs().begin(), expr->outputs().end(), is_integral)) {
+    return Int64OpType::NONE;
+  }
+
+  if (auto uop = dynamic_cast<UnaryOp*>(expr)) {
+    switch (uop->getUnaryOpType()) {
+      case UnaryOpType::Neg:
+        return Int64OpType::NEG;
+      case UnaryOpType::Abs:
+        return Int64OpType::ABS;
+      case UnaryOpType::Cast:
+        return Int64OpType::CAST;
+      default:
+        return Int64OpType::NONE;
+    }
+  }
+  if (auto bop = dynamic_cast<BinaryOp*>(expr)) {
+    switch (bop->getBinaryOpType()) {
+      case BinaryOpType::Add:
+        return Int64OpType::ADD;
+      case BinaryOpType::Sub:
+        return Int64OpType::SUB;
+      case BinaryOpType::Mul:
+        return Int64OpType::MUL;
+      case BinaryOpType::Div:
+        return Int64OpType::DIV;
+      case BinaryOpType::Mod:
+        return Int64OpType::MOD;
+      case BinaryOpType::CeilDiv:
+        return Int64OpType::CEIL_DIV;
+      case BinaryOpType::Max:
+        return Int64OpType::MAX;
+      case BinaryOpType::Min:
+        return Int64OpType::MIN;
+      case BinaryOpType::Gcd:
+        return Int64OpType::GCD;
+      case BinaryOpType::BitwiseAnd:
+        return Int64OpType::BITWISE_AND;
+      case BinaryOpType::BitwiseOr:
+        return Int64OpType::BITWISE_OR;
+      case BinaryOpType::BitwiseXor:
+        return Int64OpType::BITWISE_XOR;
+      default:
+        return Int64OpType::NONE;
+    }
+  }
+  if (auto top = dynamic_cast<TernaryOp*>(expr)) {
+    if (top->getTernaryOpType() == TernaryOpType::Clamp) {
+      return Int64OpType::CLAMP;
+    }
+  }
+  return Int64OpType::NONE;
+}
+
+bool NaiveValueMachine::runInt64Op(int index) {
+  auto& values = precomputed_values_.values_;
+  auto available = [&](int src_index) {
+    return src_index < 0 ||
+        ((precomputed_values_.defined_[src_index] ||
+          precomputed_values_.is_constant_[src_index]) &&
+         values[src_index].is<int64_t>());
+  };
+  if (!available(src0_[index]) || !available(src1_[index]) ||
+      !available(src2_[index])) {
+    // Either an operand is not computed yet, which runInstruction handles by
+    //  skipping, or it is bound to a non-int64 value.
+    return false;
+  }
+
+  const int64_t a = values[src0_[index]].as<int64_t>();
+  auto b = [&]() { return values[src1_[index]].as<int64_t>(); };
+  auto c = [&]() { return values[src2_[index]].as<int64_t>(); };
+
+  int64_t result = 0;
+  switch (int64_op_type_[index]) {
+    case Int64OpType::NEG:
+      result = -a;
+      break;
+    case Int64OpType::ABS:
+      result = std::abs(a);
+      break;
+    case Int64OpType::CAST:
+      result = a;
+      break;
+    case Int64OpType::ADD:
+      result = a + b();
+      break;
+    case Int64OpType::SUB:
+      result = a - b();
+      break;
+    case Int64OpType::MUL:
+      result = a * b();
+      break;
+    case Int64OpType::DIV:
+      NVF_CHECK(b() != 0);
+      result = a / b();
+      break;
+    case Int64OpType::MOD:
+      NVF_CHECK(b() != 0);
+      result = a % b();
+      break;
+    case Int64OpType::CEIL_DIV: {
+      const int64_t rhs = b();
+      NVF_CHECK(rhs != 0);
+      result = rhs > 0 ? (a + rhs - 1) / rhs : (a + rhs + 1) / rhs;
+      break;
+    }
+    case Int64OpType::MAX:
+      result = std::max(a, b());
+      break;
+    case Int64OpType::MIN:
+      result = std::min(a, b());
+      break;
+    case Int64OpType::GCD:
+      result = std::gcd(a, b());
+      break;
+    case Int64OpType::BITWISE_AND:
+      result = a & b();
+      break;
+    case Int64OpType::BITWISE_OR:
+      result = a | b();
+      break;
+    case Int64OpType::BITWISE_XOR:
+      result = a ^ b();
+      break;
+    case Int64OpType::CLAMP:
+      result = std::min(std::max(a, b()), c());
+      break;
+    case Int64OpType::NONE:
+      return false;
+  }
+
+  values[dest_[index]] = result;
+  precomputed_values_.defined_[dest_[index]] = true;
+  return true;
+}
+
 } // namespace nvfuser
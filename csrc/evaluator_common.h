@@ -33,6 +33,31 @@ class NaiveValueMachine {
   //! The generic types of instructions supported for this machine.
   enum class InstructionType { UNARY_OP, BINARY_OP, TERNARY_OP, SET_OP };
 
+  //! Operators that have a dedicated implementation on int64 operands. Most
+  //!  instructions evaluated at launch time compute extents, strides and
+  //!  indices, so running them directly on int64_t avoids dispatching through
+  //!  the PolymorphicValue operators. NONE means the instruction is always
+  //!  run by the generic handlers.
+  enum class Int64OpType {
+    NONE,
+    NEG,
+    ABS,
+    CAST,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    CEIL_DIV,
+    MAX,
+    MIN,
+    GCD,
+    BITWISE_AND,
+    BITWISE_OR,
+    BITWISE_XOR,
+    CLAMP
+  };
+
  public:
   //! Constructor lowers all the expr IR nodes stored in precomputed_values
   //!  and stores them in the private state.
@@ -76,6 +101,15 @@ class NaiveValueMachine {
   //! Runs a ternary operation at given index of instruction buffer
   void runTernaryOp(int index);
 
+  //! Returns the int64 operator an IR expr can be lowered to, or
+  //!  Int64OpType::NONE if any of its inputs or outputs is not integral.
+  static Int64OpType getInt64OpType(Expr* expr);
+
+  //! Runs the instruction at the given index on int64 values. Returns false
+  //!  without touching the workspace if any operand does not hold an int64,
+  //!  in which case the instruction must be run by runInstruction.
+  bool runInt64Op(int index);
+
  private:
   friend PrecomputedValues;
 
@@ -128,6 +162,9 @@ class NaiveValueMachine {
 
   //! Destination of each instruction.
   std::vector<int> dest_;
+
+  //! Int64 fast path of each instruction, see Int64OpType.
+  std::vector<Int64OpType> int64_op_type_;
 };
 
 //! PrecomputedValues:
@@ -6,8 +6,10 @@
  */
 // clang-format on
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <optional>
 
 #include <debug.h>
 #include <evaluator_common.h>
@@ -209,6 +211,7 @@ void ExpressionEvaluator::bind_(
     const auto& t = concrete_value.as<at::Tensor>();
     bindTensorDomain(tv, t, evaluate_validate);
   }
+  known_int64s_.erase(value);
   if (value->isA<NamedScalar>()) {
     known_named_scalars_[value->as<NamedScalar>()->name()] =
         std::move(concrete_value);
@@ -278,6 +281,105 @@ const PolymorphicValue& ExpressionEvaluator::evaluate(
   return maybe_concrete_value;
 }
 
+std::optional<int64_t> ExpressionEvaluator::evaluateInt64(const Val* value) {
+  return evaluateInt64(value, known_values_, known_int64s_);
+}
+
+std::optional<int64_t> ExpressionEvaluator::evaluateInt64(
+    const Val* value) const {
+  std::unordered_map<const Val*, PolymorphicValue> known_values;
+  std::unordered_map<const Val*, int64_t> known_int64s;
+  return evaluateInt64(value, known_values, known_int64s);
+}
+
+namespace {
+
+// Mirrors BinaryOp::evaluate for int64_t operands. Returns std::nullopt for
+// other ops and for divisions by zero, which are left to BinaryOp::evaluate
+// to report.
+std::optional<int64_t> evaluateInt64BinaryOp(
+    BinaryOpType op_type,
+    int64_t lhs,
+    int64_t rhs) {
+  switch (op_type) {
+    case BinaryOpType::Add:
+      return lhs + rhs;
+    case BinaryOpType::Sub:
+      return lhs - rhs;
+    case BinaryOpType::Mul:
+      return lhs * rhs;
+    case BinaryOpType::Div:
+      return rhs == 0 ? std::nullopt : std::optional<int64_t>(lhs / rhs);
+    case BinaryOpType::Mod:
+      return rhs == 0 ? std::nullopt : std::optional<int64_t>(lhs % rhs);
+    case BinaryOpType::CeilDiv:
+      if (rhs == 0) {
+        return std::nullopt;
+      }
+      return rhs > 0 ? (lhs + rhs - 1) / rhs : (lhs + rhs + 1) / rhs;
+    case BinaryOpType::Max:
+      return std::max(lhs, rhs);
+    case BinaryOpType::Min:
+      return std::min(lhs, rhs);
+    default:
+      return std::nullopt;
+  }
+}
+
+} // namespace
+
+std::optional<int64_t> ExpressionEvaluator::evaluateInt64(
+    const Val* value,
+    std::unordered_map<const Val*, PolymorphicValue>& known_values,
+    std::unordered_map<const Val*, int64_t>& known_int64s) const {
+  auto as_int64 = [](const PolymorphicValue& pv) -> std::optional<int64_t> {
+    if (pv.is<int64_t>()) {
+      return pv.as<int64_t>();
+    }
+    return std::nullopt;
+  };
+
+  if (precomputed_values_ && precomputed_values_->hasValidValues()) {
+    const PolymorphicValue& pv = precomputed_values_->getMaybeValueFor(value);
+    if (pv.hasValue()) {
+      return as_int64(pv);
+    }
+  }
+
+  if (auto it = known_int64s.find(value); it != known_int64s.end()) {
+    return it->second;
+  }
+
+  const PolymorphicValue& known = getValue(value, known_values);
+  if (known.hasValue()) {
+    return as_int64(known);
+  }
+
+  if (value->isIntegralScalar()) {
+    if (auto* bop = dynamic_cast<BinaryOp*>(value->definition());
+        bop != nullptr && bop->lhs()->isIntegralScalar() &&
+        bop->rhs()->isIntegralScalar()) {
+      std::optional<int64_t> lhs =
+          evaluateInt64(bop->lhs(), known_values, known_int64s);
+      std::optional<int64_t> rhs = lhs.has_value()
+          ? evaluateInt64(bop->rhs(), known_values, known_int64s)
+          : std::nullopt;
+      if (lhs.has_value() && rhs.has_value()) {
+        std::optional<int64_t> result =
+            evaluateInt64BinaryOp(bop->getBinaryOpType(), *lhs, *rhs);
+        if (result.has_value()) {
+          known_int64s[value] = *result;
+          return result;
+        }
+      }
+    }
+  }
+
+  // Anything else, e.g., the metadata of a tensor, goes through
+  // PolymorphicValue
+  return as_int64(evaluate(value, known_values));
+}
+
 const PolymorphicValue& ExpressionEvaluator::getValue(
     const Val* value,
     const std::unordered_map<const Val*, PolymorphicValue>&
@@ -509,6 +611,9 @@ ExpressionEvaluator ExpressionEvaluator::clone(IrCloner& ir_cloner) const {
   for (const auto& kv : known_values_) {
     expr_eval.known_values_[ir_cloner.clone(kv.first)] = kv.second;
   }
+  for (const auto& [val, i] : known_int64s_) {
+    expr_eval.known_int64s_[ir_cloner.clone(val)] = i;
+  }
   expr_eval.known_named_scalars_.insert(
       known_named_scalars_.begin(), known_named_scalars_.end());
   return expr_eval;
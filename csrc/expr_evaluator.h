@@ -16,6 +16,7 @@
 #include <polymorphic_value.h>
 #include <visibility.h>
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -61,12 +62,24 @@ class ExpressionEvaluator {
       const Val* value,
       std::unordered_map<const Val*, PolymorphicValue>& known_values) const;
 
+  //! Evaluates an integer scalar, e.g., an extent, without going through
+  //! PolymorphicValue for the integer arithmetic that it is defined by.
+  //! Intermediate results are cached as plain int64_t. Returns std::nullopt
+  //! if the value can't be evaluated or isn't an int64_t. Anything other
+  //! than integer arithmetic is evaluated by evaluate.
+  NVF_API std::optional<int64_t> evaluateInt64(const Val* value);
+
+  //! Same as above through a const evaluator reference, with intermediate
+  //! results cached in lieu of known_values_ and known_int64s_.
+  NVF_API std::optional<int64_t> evaluateInt64(const Val* value) const;
+
   bool isKnown(const Val* value) const {
     return known_values_.count(value) > 0;
   }
 
   void invalidate(const Val* value) {
     known_values_.erase(value);
+    known_int64s_.erase(value);
   }
 
   //! Debugging helper, prints all the currently known values
@@ -109,6 +122,11 @@ class ExpressionEvaluator {
       const std::unordered_map<const Val*, PolymorphicValue>&
           additional_known_values) const;
 
+  std::optional<int64_t> evaluateInt64(
+      const Val* value,
+      std::unordered_map<const Val*, PolymorphicValue>& known_values,
+      std::unordered_map<const Val*, int64_t>& known_int64s) const;
+
  private:
   // TODO: Consider make this const. It can't be const as bind() of
   // this class calls
@@ -118,6 +136,8 @@ class ExpressionEvaluator {
   // known_named_scalars_.
   PrecomputedValues* precomputed_values_ = nullptr;
   std::unordered_map<const Val*, PolymorphicValue> known_values_;
+  // Integer results of evaluateInt64
+  std::unordered_map<const Val*, int64_t> known_int64s_;
   std::unordered_map<std::string, PolymorphicValue> known_named_scalars_;
   PolymorphicValue null_ = std::monostate{};
 };
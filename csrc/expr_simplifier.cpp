@@ -17,11 +17,13 @@
 #include <options.h>
 #include <utils.h>
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <list>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <regex>
 #include <sstream>
 #include <string>
@@ -2776,6 +2778,109 @@ Val* cancelTermsInPredicate(Val* value, const Context& context) {
 
 } // namespace rules
 
+namespace {
+thread_local ExprSimplifierCache* active_cache = nullptr; // NOLINT
+} // namespace
+
+ExprSimplifierCache::ExprSimplifierCache() : prev_cache_(active_cache) {
+  active_cache = this;
+}
+
+ExprSimplifierCache::~ExprSimplifierCache() {
+  active_cache = prev_cache_;
+  if (isDebugDumpEnabled(DebugDumpOption::ExprSimplification) &&
+      hits_ + misses_ > 0) {
+    debug() << "Expression simplifier cache: " << hits_ << " hits, "
+            << misses_ << " misses ("
+            << 100 * hits_ / (hits_ + misses_) << "% hit rate)" << std::endl;
+  }
+}
+
+/*static*/ ExprSimplifierCache* ExprSimplifierCache::current() {
+  return active_cache;
+}
+
+size_t ExprSimplifierCache::hash(Val* value) {
+  if (auto it = hashes_.find(value); it != hashes_.end()) {
+    return it->second;
+  }
+  size_t h = 0;
+  if (auto ns = dynamic_cast<NamedScalar*>(value)) {
+    // Named scalars are the same if they have the same name
+    h = std::hash<std::string>()(ns->name());
+  } else if (Expr* def = value->definition()) {
+    h = std::hash<std::string>()(def->getOpString());
+    for (Val* input : def->inputs()) {
+      hashCombine(h, hash(input));
+    }
+  } else if (value->value().hasValue()) {
+    h = std::hash<std::string>()(value->toInlineString());
+  } else {
+    // Other leaves are only the same as themselves
+    h = std::hash<Val*>()(value);
+  }
+  hashes_.emplace(value, h);
+  return h;
+}
+
+size_t ExprSimplifierCache::hash(
+    Val* value,
+    const std::list<VarInfo>& variables,
+    const std::vector<Val*>& assumptions,
+    bool preserve_error) {
+  size_t h = hash(value);
+  for (const VarInfo& info : variables) {
+    hashCombine(h, std::hash<Val*>()(info.variable));
+    hashCombine(h, info.is_unrolled_loop_index);
+  }
+  for (Val* assumption : assumptions) {
+    hashCombine(h, hash(assumption));
+  }
+  hashCombine(h, preserve_error);
+  // The axioms of the fusion are assumed as well. They are only ever added
+  // to, so their number tells whether they changed.
+  hashCombine(h, std::hash<Fusion*>()(value->fusion()));
+  hashCombine(h, value->fusion()->axioms().size());
+  return h;
+}
+
+Val* ExprSimplifierCache::lookup(
+    size_t key,
+    Val* value,
+    const std::list<VarInfo>& variables,
+    const std::vector<Val*>& assumptions,
+    bool preserve_error) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  auto same_variable = [](const VarInfo& a, const VarInfo& b) {
+    return a.variable == b.variable &&
+        a.is_unrolled_loop_index == b.is_unrolled_loop_index;
+  };
+  auto same_val = [](Val* a, Val* b) { return a->sameAs(b); };
+  for (const Entry& entry : it->second) {
+    if (entry.preserve_error == preserve_error &&
+        entry.value->fusion() == value->fusion() &&
+        std::equal(
+            entry.variables.begin(),
+            entry.variables.end(),
+            variables.begin(),
+            variables.end(),
+            same_variable) &&
+        std::equal(
+            entry.assumptions.begin(),
+            entry.assumptions.end(),
+            assumptions.begin(),
+            assumptions.end(),
+            same_val) &&
+        entry.value->sameAs(value)) {
+      return entry.simplified;
+    }
+  }
+  return nullptr;
+}
+
 #define RUN_PASS(pass_name)                                     \
   if (disabled_passes == nullptr ||                             \
       (!disabled_passes->empty() &&                             \
@@ -2798,8 +2903,6 @@ Val* simplifyExpr(
     std::vector<Val*> assumptions,
     bool preserve_error) {
   FusionGuard fg(value->fusion());
-  const Context context(variables, std::move(assumptions), preserve_error);
-  auto logger = debug_print::createLogger(value);
 
   // nullptr -> disable nothing
   // empty set -> disable everything
@@ -2814,6 +2917,28 @@ Val* simplifyExpr(
         std::make_unique<std::unordered_set<std::string>>(v.begin(), v.end());
   }
 
+  ExprSimplifierCache* cache = ExprSimplifierCache::current();
+  size_t key = 0;
+  std::optional<ExprSimplifierCache::Entry> entry;
+  if (cache != nullptr) {
+    key = cache->hash(value, variables, assumptions, preserve_error);
+    if (Val* cached =
+            cache->lookup(key, value, variables, assumptions, preserve_error)) {
+      cache->hits_++;
+      return cached;
+    }
+    cache->misses_++;
+    entry = ExprSimplifierCache::Entry{
+        value,
+        {variables.begin(), variables.end()},
+        assumptions,
+        preserve_error,
+        nullptr};
+  }
+
+  const Context context(variables, std::move(assumptions), preserve_error);
+  auto logger = debug_print::createLogger(value);
+
   Val* simplified = value;
   Val* old_simplified = nullptr;
   while (old_simplified != simplified) {
@@ -2851,6 +2976,10 @@ Val* simplifyExpr(
 
   auto unflattened = assoc_comm::unflatten(simplified, context);
   logger->record(debug_print::kUnflattenName, unflattened);
+  if (cache != nullptr) {
+    entry->simplified = unflattened;
+    cache->entries_[key].push_back(std::move(*entry));
+  }
   return unflattened;
 }
 
@@ -11,6 +11,8 @@
 #include <ir/all_nodes.h>
 #include <visibility.h>
 
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 // Note: [The Mathematics of Integer Arithmetic]
@@ -154,6 +156,74 @@ NVF_API Val* simplifyExpr(
     std::vector<Val*> assumptions = {},
     bool preserve_error = false);
 
+// Memoizes simplifyExpr while it is alive, e.g., while lowering a kernel, whose
+// index expressions are often structurally identical. A query is the same as
+// an earlier one if its value and assumptions are the same according to
+// Val::sameAs and if it has the same variables and `preserve_error`, in which
+// case the earlier result is returned without simplifying again. Queries are
+// bucketed by a structural hash, so only candidates of the same shape are
+// compared.
+//
+// Caches nest like FusionGuard: simplifyExpr uses the innermost one of the
+// calling thread, if any. The queried values must outlive the cache. With
+// NVFUSER_DUMP=expr_simplify, the hit rate is printed when it is destroyed.
+class ExprSimplifierCache {
+ public:
+  NVF_API ExprSimplifierCache();
+  NVF_API ~ExprSimplifierCache();
+
+  ExprSimplifierCache(const ExprSimplifierCache&) = delete;
+  ExprSimplifierCache& operator=(const ExprSimplifierCache&) = delete;
+
+  static ExprSimplifierCache* current();
+
+  int64_t hits() const {
+    return hits_;
+  }
+
+  int64_t misses() const {
+    return misses_;
+  }
+
+ private:
+  friend Val* simplifyExpr(
+      Val* value,
+      const std::list<VarInfo>& variables,
+      std::vector<Val*> assumptions,
+      bool preserve_error);
+
+  struct Entry {
+    Val* value;
+    std::vector<VarInfo> variables;
+    std::vector<Val*> assumptions;
+    bool preserve_error;
+    Val* simplified;
+  };
+
+  // Hashes the structure of `value`, consistently with Val::sameAs
+  size_t hash(Val* value);
+
+  size_t hash(
+      Val* value,
+      const std::list<VarInfo>& variables,
+      const std::vector<Val*>& assumptions,
+      bool preserve_error);
+
+  // Returns the result of a query that is the same as this one, or nullptr
+  Val* lookup(
+      size_t key,
+      Val* value,
+      const std::list<VarInfo>& variables,
+      const std::vector<Val*>& assumptions,
+      bool preserve_error);
+
+  std::unordered_map<size_t, std::vector<Entry>> entries_;
+  std::unordered_map<Val*, size_t> hashes_;
+  int64_t hits_ = 0;
+  int64_t misses_ = 0;
+  ExprSimplifierCache* prev_cache_;
+};
+
 class Context;
 namespace assoc_comm {
 // The expression type that represents the flattened ops. For example, if I have
@@ -26,6 +26,7 @@
 #include <transform_replay.h>
 
 #include <iterator>
+#include <utility>
 
 namespace nvfuser {
 
@@ -109,6 +110,104 @@ IrCloner Fusion::copy(const Fusion* from, Fusion* to) {
   return ir_cloner;
 }
 
+namespace {
+
+// An IrCloner that records the Vals it clones, including those cloned
+// recursively, so that their definitions can be cloned in turn.
+class RecordingIrCloner : public IrCloner {
+ public:
+  using IrCloner::IrCloner;
+
+  std::vector<const Val*> takeClonedVals() {
+    return std::exchange(cloned_vals_, {});
+  }
+
+ protected:
+  Statement* handle(const Statement* s) override {
+    Statement* clone = IrCloner::handle(s);
+    if (s->isVal()) {
+      cloned_vals_.push_back(s->asVal());
+    }
+    return clone;
+  }
+
+ private:
+  std::vector<const Val*> cloned_vals_;
+};
+
+} // namespace
+
+IrCloner Fusion::copy(
+    const Fusion* from,
+    Fusion* to,
+    const std::vector<Expr*>& exprs) {
+  FUSER_PERF_SCOPE("Fusion::copy exprs");
+  to->clear();
+  RecordingIrCloner ir_cloner(to);
+
+  // Clone the given exprs in the order of `from`, which also clones their
+  // inputs and outputs with their domains. Registering the cloned exprs sets
+  // the definitions of their outputs and the uses of their scalar inputs.
+  const std::unordered_set<Expr*> expr_set(exprs.begin(), exprs.end());
+  for (Expr* expr : from->deterministic_exprs()) {
+    if (expr_set.count(expr)) {
+      ir_cloner.clone(expr);
+    }
+  }
+
+  for (const auto& [output, alias_info] : from->io_alias_) {
+    if (expr_set.count(output->definition())) {
+      to->io_alias_[ir_cloner.clone(output)] = {
+          .type = alias_info.type,
+          .aliased_io = ir_cloner.clone(alias_info.aliased_io),
+          .hide_output = alias_info.hide_output};
+    }
+  }
+
+  if (from->axioms_ != nullptr) {
+    to->axioms_ = std::make_unique<std::vector<Val*>>();
+    for (auto pred : *from->axioms_) {
+      to->axioms_->emplace_back(ir_cloner.clone(pred));
+    }
+  }
+
+  for (const auto& i : from->managed_data_) {
+    if (i.first.has_value()) {
+      to->managed_data_.emplace_back(i.second(ir_cloner, i.first), i.second);
+    } else {
+      to->managed_data_.emplace_back(i.first, i.second);
+    }
+  }
+  for (auto [k, v] : from->managed_named_data_) {
+    if (v.first.has_value()) {
+      to->managed_named_data_.insert(std::make_pair(
+          k, std::make_pair(v.second(ir_cloner, v.first), v.second)));
+    }
+  }
+
+  // Clone the definitions of the cloned vals, e.g., of the extents and of the
+  // IterDomains between the root and the loop domains, until no new val is
+  // cloned. Tensors produced by other exprs are left without a definition,
+  // which is what bounds the copy.
+  for (std::vector<const Val*> vals = ir_cloner.takeClonedVals(); !vals.empty();
+       vals = ir_cloner.takeClonedVals()) {
+    for (const Val* val : vals) {
+      Expr* definition = val->definition();
+      if (definition == nullptr ||
+          (val->isA<TensorView>() && !expr_set.count(definition))) {
+        continue;
+      }
+      ir_cloner.clone(definition);
+    }
+  }
+
+  to->val_type_name_map_ = from->val_type_name_map_;
+  to->expr_name_counter_ = from->expr_name_counter_;
+  to->expected_dynamic_smem_bytes_ = from->expected_dynamic_smem_bytes_;
+
+  return ir_cloner;
+}
+
 // Clang tidy complains when using default constructor for IrContainer instead
 // of copy constructor. Fusion::copy has a call to IrContainer::copy, so it's
 // redundant to use the IrContainer copy constructor, but it is harmless since
@@ -429,6 +429,16 @@ class NVF_API Fusion : public IrContainer {
 
   static IrCloner copy(const Fusion* from, Fusion* to);
 
+  //! Copy only `exprs` of `from` into `to` with what they depend on: their
+  //! inputs and outputs, the domains of these and the exprs defining scalars
+  //! and IterDomains. Tensors produced by other exprs are copied as leaves.
+  //! The inputs and outputs of `to` are left empty. This is much cheaper than
+  //! copying the whole fusion to schedule a segment of it.
+  static IrCloner copy(
+      const Fusion* from,
+      Fusion* to,
+      const std::vector<Expr*>& exprs);
+
   //! During scheduling, this can be set to a non-negative value. If done, then
   //! during execution by KernelExecutor, we will check that this value matches
   //! the corresponding value in LaunchParams.
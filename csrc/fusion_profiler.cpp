@@ -6,12 +6,18 @@
  */
 // clang-format on
 
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
+#include <unordered_map>
 
 #include <cupti.h>
 
 #include <exceptions.h>
 #include <fusion_profiler.h>
+#include <options.h>
 
 namespace nvfuser {
 
@@ -215,8 +221,12 @@ void CudaEventTimer::start() {
 }
 
 void CudaEventTimer::stop() {
+  stop(stream_);
+}
+
+void CudaEventTimer::stop(cudaStream_t stream) {
   NVF_CHECK_EQ(state_, ProfilerState::Running);
-  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(stop_event_, stream_));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(stop_event_, stream));
   state_ = ProfilerState::Finished;
 }
 
@@ -312,6 +322,41 @@ void DeviceDescriptor::generate(DeviceDescriptor& desc, int device) {
   desc.peak_bandwidth_gbs = static_comp *
       static_cast<double>(desc.memory_clock) *
       static_cast<double>(desc.bus_width);
+
+  NVFUSER_CUDA_SAFE_CALL(cuDeviceGetAttribute(
+      &desc.sm_count, CU_DEVICE_ATTRIBUTE_MULTIPROCESSOR_COUNT, device));
+  NVFUSER_CUDA_SAFE_CALL(cuDeviceGetAttribute(
+      &desc.max_threads_per_sm,
+      CU_DEVICE_ATTRIBUTE_MAX_THREADS_PER_MULTIPROCESSOR,
+      device));
+  NVFUSER_CUDA_SAFE_CALL(cuDeviceGetAttribute(
+      &desc.max_registers_per_sm,
+      CU_DEVICE_ATTRIBUTE_MAX_REGISTERS_PER_MULTIPROCESSOR,
+      device));
+  NVFUSER_CUDA_SAFE_CALL(cuDeviceGetAttribute(
+      &desc.max_shared_memory_per_sm,
+      CU_DEVICE_ATTRIBUTE_MAX_SHARED_MEMORY_PER_MULTIPROCESSOR,
+      device));
+  NVFUSER_CUDA_SAFE_CALL(cuDeviceGetAttribute(
+      &desc.clock_rate, CU_DEVICE_ATTRIBUTE_CLOCK_RATE, device));
+  NVFUSER_CUDA_SAFE_CALL(cuDeviceGetAttribute(
+      &desc.compute_capability_major,
+      CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR,
+      device));
+  NVFUSER_CUDA_SAFE_CALL(cuDeviceGetAttribute(
+      &desc.compute_capability_minor,
+      CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR,
+      device));
+  const int major = desc.compute_capability_major;
+  const int minor = desc.compute_capability_minor;
+
+  // Peak FP32 throughput: FP32 lanes per SM * 2 FLOPs per FMA * clock. Volta,
+  // Turing and GA100 have 64 FP32 lanes per SM, later architectures 128.
+  const int fp32_lanes_per_sm =
+      (major < 8 || (major == 8 && minor == 0)) ? 64 : 128;
+  desc.peak_fp32_gflops = 2.0 * fp32_lanes_per_sm *
+      static_cast<double>(desc.sm_count) *
+      static_cast<double>(desc.clock_rate) * 1.0e-6; /*kHz->GHz*/
 }
 
 SegmentProfiler::SegmentProfiler(uint32_t id, bool cupti_disabled)
@@ -370,6 +415,20 @@ const std::string& SegmentProfiler::scheduler() const {
   return scheduler_;
 }
 
+void SegmentProfiler::heuristicParams(const std::string& params) {
+  heuristic_params_ = params;
+}
+const std::string& SegmentProfiler::heuristicParams() const {
+  return heuristic_params_;
+}
+
+void SegmentProfiler::arithmeticOps(int64_t flops) {
+  flops_ = flops;
+}
+int64_t SegmentProfiler::arithmeticOps() const {
+  return flops_;
+}
+
 uint32_t SegmentProfiler::segmentId() const {
   return segment_id_;
 }
@@ -398,11 +457,15 @@ auto FusionProfile::toTuple(const FusionProfile& prof, size_t seg_id) {
       prof.percentage_peak_bandwidth,
       prof.input_bytes,
       prof.output_bytes,
+      prof.peak_memory_bytes,
       kp.segment_id,
       kp.time_ms,
       kp.compile_time_ms,
       kp.effective_bandwidth_gbs,
       kp.percentage_peak_bandwidth,
+      kp.achieved_gflops,
+      kp.percentage_peak_flops,
+      kp.percentage_roofline,
       kp.input_bytes,
       kp.output_bytes,
       kp.shared_mem_str,
@@ -445,8 +508,11 @@ void FusionProfile::reset() {
 
   input_bytes = 0;
   output_bytes = 0;
+  peak_memory_bytes = 0;
 
   kernel_profiles.clear();
+  lowering_pass_profiles.clear();
+  communication_profiles.clear();
 }
 
 const std::vector<ProfileAttrDescriptor> FusionProfile::profile_attr_descs{
@@ -462,11 +528,15 @@ const std::vector<ProfileAttrDescriptor> FusionProfile::profile_attr_descs{
     {"%PkBw", false, false, false, 7, true, 2, std::nullopt},
     {"In(MB)", true, false, false, 8, true, 3, 1.0e-6},
     {"Out(MB)", true, false, false, 9, true, 3, 1.0e-6},
+    {"PkMem(MB)", true, false, false, 9, true, 3, 1.0e-6},
     {"S-Seg#", false, true, false, 6, true, 0, std::nullopt},
     {"S-KerTm(ms)", false, true, false, 11, true, 3, std::nullopt},
     {"S-CmpTm(ms)", true, true, false, 11, true, 3},
     {"S-EffBw(GB/s)", false, true, false, 13, true, 3, std::nullopt},
     {"S-%PkBw", false, true, false, 7, true, 2, std::nullopt},
+    {"S-GFLOP/s", true, true, false, 10, true, 3, std::nullopt},
+    {"S-%PkFlop", true, true, false, 9, true, 2, std::nullopt},
+    {"S-%Roof", false, true, false, 7, true, 2, std::nullopt},
     {"S-In(MB)", false, true, false, 8, true, 3, 1.0e-6},
     {"S-Out(MB)", false, true, false, 9, true, 3, 1.0e-6},
     {"S-Smem[Dyn,Stat]", false, true, true, 16, false, 0, std::nullopt},
@@ -546,6 +616,61 @@ constexpr std::ostream& printTuple(
     return printTuple<NOCUPTI, I + 1>(os, tup, seg_id, verbose);
   }
 }
+void printCommunicationProfiles(
+    std::ostream& os,
+    const std::vector<CommunicationProfile>& profiles) {
+  os << std::setfill(' ') << std::left << std::setw(6) << "C-Seg#" << " "
+     << std::setw(14) << "C-Name" << " " << std::setw(6) << "C-Team" << " "
+     << std::setw(10) << "C-Size(MB)" << " " << std::setw(9) << "C-Tm(ms)"
+     << " " << std::setw(14) << "C-AlgBw(GB/s)" << " " << std::setw(14)
+     << "C-BusBw(GB/s)" << " " << std::setw(5) << "C-Dev" << std::endl;
+  for (const CommunicationProfile& prof : profiles) {
+    os << std::right << std::fixed << std::setw(6) << prof.segment_id << " "
+       << std::left << std::setw(14) << prof.name << " " << std::right
+       << std::setw(6) << prof.team_size << " " << std::setprecision(3)
+       << std::setw(10) << static_cast<double>(prof.bytes) * 1.0e-6 << " "
+       << std::setw(9) << prof.time_ms << " " << std::setw(14)
+       << prof.algorithm_bandwidth_gbs << " " << std::setw(14)
+       << prof.bus_bandwidth_gbs << " " << std::setw(5) << prof.device
+       << std::endl;
+  }
+}
+void printStageProfiles(
+    std::ostream& os,
+    const std::vector<KernelProfile>& profiles) {
+  os << std::setfill(' ') << std::left << std::setw(6) << "W-Seg#" << " "
+     << std::setw(10) << "W-Stage" << " " << std::setw(4) << "W-WG" << " "
+     << std::setw(14) << "W-Cycles" << " " << std::setw(10) << "W-Count"
+     << " " << std::setw(9) << "W-%Kernel" << std::endl;
+  for (const KernelProfile& kp : profiles) {
+    for (const KernelStageProfile& prof : kp.stages) {
+      os << std::right << std::fixed << std::setw(6) << kp.segment_id << " "
+         << std::left << std::setw(10) << prof.stage << " " << std::right
+         << std::setw(4) << prof.warp_group << " " << std::setw(14)
+         << prof.cycles << " " << std::setw(10) << prof.count << " "
+         << std::setprecision(2) << std::setw(9) << prof.percentage_kernel
+         << std::endl;
+    }
+  }
+}
+
+// The stages of a warp group are relative to the cycles of the warp group in
+// the whole kernel, i.e., the Kernel stage
+void setStagePercentages(std::vector<KernelStageProfile>& stages) {
+  std::unordered_map<int64_t, int64_t> kernel_cycles;
+  for (const KernelStageProfile& prof : stages) {
+    if (prof.stage == "Kernel") {
+      kernel_cycles[prof.warp_group] = prof.cycles;
+    }
+  }
+  for (KernelStageProfile& prof : stages) {
+    auto it = kernel_cycles.find(prof.warp_group);
+    if (it != kernel_cycles.end() && it->second > 0) {
+      prof.percentage_kernel = static_cast<double>(prof.cycles) /
+          static_cast<double>(it->second) * 100.0;
+    }
+  }
+}
 } // namespace
 
 std::ostream& operator<<(std::ostream& os, const FusionProfile& fp) {
@@ -592,6 +717,136 @@ std::ostream& operator<<(std::ostream& os, const FusionProfile& fp) {
     }
   }
 
+  if (std::any_of(
+          fp.kernel_profiles.begin(),
+          fp.kernel_profiles.end(),
+          [](const KernelProfile& kp) { return !kp.stages.empty(); })) {
+    printStageProfiles(os, fp.kernel_profiles);
+  }
+
+  if (!fp.communication_profiles.empty()) {
+    printCommunicationProfiles(os, fp.communication_profiles);
+  }
+
+  return os;
+}
+
+namespace {
+
+// The heuristic parameters are printed on several lines, which exported rows
+// keep on one
+std::string collapseWhitespace(const std::string& str) {
+  std::string out;
+  bool space = false;
+  for (char c : str) {
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      space = !out.empty();
+      continue;
+    }
+    if (space) {
+      out += ' ';
+      space = false;
+    }
+    out += c;
+  }
+  return out;
+}
+
+std::string csvQuote(const std::string& str) {
+  std::string out{"\""};
+  for (char c : str) {
+    if (c == '"') {
+      out += '"';
+    }
+    out += c;
+  }
+  out += '"';
+  return out;
+}
+
+std::string jsonQuote(const std::string& str) {
+  std::string out{"\""};
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  out += '"';
+  return out;
+}
+
+} // namespace
+
+void writeKernelProfilesCsv(
+    std::ostream& os,
+    const FusionProfile& prof,
+    bool header) {
+  if (header) {
+    os << "fusion_id,segment_id,kernel_name,scheduler,heuristic_params,"
+       << "time_ms,input_bytes,output_bytes,flops,effective_bandwidth_gbs,"
+       << "percentage_peak_bandwidth,achieved_gflops,percentage_peak_flops,"
+       << "percentage_roofline,below_roofline_threshold,device_name"
+       << std::endl;
+  }
+  for (const KernelProfile& kp : prof.kernel_profiles) {
+    os << prof.fusion_id << "," << kp.segment_id << "," << csvQuote(kp.name)
+       << "," << csvQuote(kp.scheduler) << ","
+       << csvQuote(collapseWhitespace(kp.heuristic_params)) << ","
+       << kp.time_ms << "," << kp.input_bytes << "," << kp.output_bytes << ","
+       << kp.flops << "," << kp.effective_bandwidth_gbs << ","
+       << kp.percentage_peak_bandwidth << "," << kp.achieved_gflops << ","
+       << kp.percentage_peak_flops << "," << kp.percentage_roofline << ","
+       << (kp.below_roofline_threshold ? "true" : "false") << ","
+       << csvQuote(kp.device_name) << std::endl;
+  }
+}
+
+void writeKernelProfilesJson(std::ostream& os, const FusionProfile& prof) {
+  for (const KernelProfile& kp : prof.kernel_profiles) {
+    os << "{\"fusion_id\": " << prof.fusion_id
+       << ", \"segment_id\": " << kp.segment_id
+       << ", \"kernel_name\": " << jsonQuote(kp.name)
+       << ", \"scheduler\": " << jsonQuote(kp.scheduler)
+       << ", \"heuristic_params\": "
+       << jsonQuote(collapseWhitespace(kp.heuristic_params))
+       << ", \"time_ms\": " << kp.time_ms
+       << ", \"input_bytes\": " << kp.input_bytes
+       << ", \"output_bytes\": " << kp.output_bytes
+       << ", \"flops\": " << kp.flops
+       << ", \"effective_bandwidth_gbs\": " << kp.effective_bandwidth_gbs
+       << ", \"percentage_peak_bandwidth\": " << kp.percentage_peak_bandwidth
+       << ", \"achieved_gflops\": " << kp.achieved_gflops
+       << ", \"percentage_peak_flops\": " << kp.percentage_peak_flops
+       << ", \"percentage_roofline\": " << kp.percentage_roofline
+       << ", \"below_roofline_threshold\": "
+       << (kp.below_roofline_threshold ? "true" : "false")
+       << ", \"device_name\": " << jsonQuote(kp.device_name)
+       << ", \"stages\": [";
+    for (size_t i = 0; i < kp.stages.size(); ++i) {
+      const KernelStageProfile& stage = kp.stages.at(i);
+      os << (i > 0 ? ", " : "") << "{\"stage\": " << jsonQuote(stage.stage)
+         << ", \"warp_group\": " << stage.warp_group
+         << ", \"cycles\": " << stage.cycles << ", \"count\": " << stage.count
+         << ", \"percentage_kernel\": " << stage.percentage_kernel << "}";
+    }
+    os << "]}" << std::endl;
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const PipelineStageProfile& prof) {
+  os << std::endl
+     << std::setfill(' ') << std::left << "Pipeline stage " << prof.stage
+     << "/" << prof.num_stages << " on device " << prof.device << ", "
+     << prof.micro_batches << " micro-batches:" << std::endl
+     << std::fixed << std::setprecision(3) << "  total    " << std::setw(10)
+     << prof.total_time_ms << " ms" << std::endl
+     << "  forward  " << std::setw(10) << prof.forward_time_ms << " ms"
+     << std::endl
+     << "  backward " << std::setw(10) << prof.backward_time_ms << " ms"
+     << std::endl
+     << "  idle     " << std::setw(10) << prof.idle_time_ms << " ms"
+     << std::endl;
   return os;
 }
 
@@ -637,6 +892,7 @@ void FusionProfiler::reset() {
   fp->segments_.clear();
   fp->kernel_profiles_.clear();
   fp->corrid_2_segid_.clear();
+  fp->communications_.clear();
 }
 
 ProfilerState FusionProfiler::state() {
@@ -699,6 +955,46 @@ const DeviceDescriptor& FusionProfiler::deviceDescriptor(const int device_id) {
   return desc;
 }
 
+namespace {
+
+// The percentage of the roofline below which exported kernels are flagged
+double rooflineThreshold() {
+  const std::vector<std::string>& args =
+      getProfilerOptionArguments(ProfilerOption::Export);
+  if (args.size() < 2) {
+    return 50.0;
+  }
+  try {
+    return std::stod(args.at(1));
+  } catch (const std::exception&) {
+    NVF_THROW(
+        "Invalid roofline threshold of NVFUSER_PROF=export: ", args.at(1));
+  }
+}
+
+// Appends the kernel profiles to the file given to NVFUSER_PROF=export
+void exportProfile(const FusionProfile& fprof) {
+  const std::vector<std::string>& args =
+      getProfilerOptionArguments(ProfilerOption::Export);
+  NVF_CHECK(
+      !args.empty(),
+      "NVFUSER_PROF=export requires a file name, e.g., export(profile.csv)");
+  const std::filesystem::path path(args.at(0));
+  std::error_code ec;
+  const bool header = !std::filesystem::exists(path, ec) ||
+      std::filesystem::file_size(path, ec) == 0;
+  std::ofstream ofs(path, std::ios::app);
+  NVF_CHECK(ofs.good(), "Failed to open ", path, " to export the profile");
+  ofs << std::setprecision(6);
+  if (path.extension() == ".json") {
+    writeKernelProfilesJson(ofs, fprof);
+  } else {
+    writeKernelProfilesCsv(ofs, fprof, header);
+  }
+}
+
+} // namespace
+
 /*static*/ void FusionProfiler::stop() {
   FusionProfiler* fp = get();
   NVF_CHECK_EQ(state(), ProfilerState::Running);
@@ -713,6 +1009,7 @@ const DeviceDescriptor& FusionProfiler::deviceDescriptor(const int device_id) {
 
   double kernel_time_ms = 0.0;
   constexpr double mb_divider = 1.0 / 1.0e6;
+  const double roofline_threshold = rooflineThreshold();
   if (!fp->cupti_disabled_) {
     NVFUSER_CUPTI_SAFE_CALL(
         cuptiActivityDisable(CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL));
@@ -734,6 +1031,7 @@ const DeviceDescriptor& FusionProfiler::deviceDescriptor(const int device_id) {
       const DeviceDescriptor& device_desc = fp->deviceDescriptor(kprof.device);
       kprof.device_name = device_desc.name;
       kprof.peak_bandwidth_gbs = device_desc.peak_bandwidth_gbs;
+      kprof.peak_fp32_gflops = device_desc.peak_fp32_gflops;
       NVF_CHECK(
           fp->corrid_2_segid_.count(corr_id) > 0,
           "Correlation Id is not found in corrid -> segid hashmap! ",
@@ -757,6 +1055,20 @@ const DeviceDescriptor& FusionProfiler::deviceDescriptor(const int device_id) {
           mb_divider;
       kprof.percentage_peak_bandwidth =
           kprof.effective_bandwidth_gbs / kprof.peak_bandwidth_gbs * 100.0;
+      // A kernel is bound by the bandwidth or by the arithmetic throughput,
+      // whichever takes longer, so the fraction of the roofline it reaches
+      // is the larger of the two fractions
+      kprof.flops = segment(kp_idx).arithmeticOps();
+      kprof.achieved_gflops =
+          static_cast<double>(kprof.flops) / kprof.time_ms * mb_divider;
+      if (kprof.peak_fp32_gflops > 0.0) {
+        kprof.percentage_peak_flops =
+            kprof.achieved_gflops / kprof.peak_fp32_gflops * 100.0;
+      }
+      kprof.percentage_roofline = std::max(
+          kprof.percentage_peak_bandwidth, kprof.percentage_peak_flops);
+      kprof.below_roofline_threshold =
+          kprof.percentage_roofline < roofline_threshold;
       kprof.compile_time_ms = segment(kp_idx).compileTime();
 
       kprof.grid_str = toString(kprof.grid);
@@ -765,6 +1077,9 @@ const DeviceDescriptor& FusionProfiler::deviceDescriptor(const int device_id) {
       kprof.shared_mem_str = toString(kprof.shared_mem);
 
       kprof.scheduler = segment(kp_idx).scheduler();
+      kprof.heuristic_params = segment(kp_idx).heuristicParams();
+      kprof.stages = segment(kp_idx).stageProfiles();
+      setStagePercentages(kprof.stages);
 
       kernel_time_ms += kprof.time_ms;
       fprof.kernel_profiles[kp_idx] = std::move(kprof);
@@ -800,7 +1115,39 @@ const DeviceDescriptor& FusionProfiler::deviceDescriptor(const int device_id) {
           fp->deviceDescriptor(common_device).peak_bandwidth_gbs * 100.0;
     }
   }
+  // Communications that haven't been waited for, e.g., because the profiled
+  // Fusion errored out, aren't reported.
+  fprof.communication_profiles.clear();
+  for (auto& [comm_prof, timer] : fp->communications_) {
+    if (timer->state() != ProfilerState::Finished) {
+      continue;
+    }
+    comm_prof.time_ms = timer->time();
+    if (comm_prof.time_ms > 0.0) {
+      comm_prof.algorithm_bandwidth_gbs =
+          static_cast<double>(comm_prof.bytes) / comm_prof.time_ms *
+          mb_divider;
+      comm_prof.bus_bandwidth_gbs =
+          comm_prof.algorithm_bandwidth_gbs * comm_prof.bus_factor;
+    }
+    fprof.communication_profiles.push_back(comm_prof);
+  }
+
   fprof.compile_time_ms = fp->compile_timer_.time();
+  fprof.lowering_pass_profiles.clear();
+  for (const SegmentProfiler& seg : fp->segments_) {
+    std::vector<LoweringPassProfile>& passes =
+        fprof.lowering_pass_profiles.emplace_back();
+    if (seg.segmentCopy().has_value() && !seg.loweringPasses().empty()) {
+      passes.push_back(*seg.segmentCopy());
+    }
+    passes.insert(
+        passes.end(), seg.loweringPasses().begin(), seg.loweringPasses().end());
+  }
+
+  if (isProfilerExportEnabled() && !fprof.kernel_profiles.empty()) {
+    exportProfile(fprof);
+  }
 
   fp->state_ = ProfilerState::Processed;
 }
@@ -825,6 +1172,11 @@ void FusionProfiler::outputBytesAccessed(int64_t bytes) {
   get()->profile_.output_bytes = bytes;
 }
 
+void FusionProfiler::peakMemoryBytes(int64_t bytes) {
+  NVF_CHECK_EQ(state(), ProfilerState::Running);
+  get()->profile_.peak_memory_bytes = bytes;
+}
+
 const FusionProfile& FusionProfiler::profile() {
   NVF_CHECK_EQ(
       state(),
@@ -841,6 +1193,40 @@ double FusionProfiler::lastKernelTime() {
   return fprof.kernel_profiles.back().time_ms;
 }
 
+size_t FusionProfiler::startCommunication(CommunicationProfile prof) {
+  NVF_CHECK_EQ(state(), ProfilerState::Running);
+  FusionProfiler* fp = get();
+  auto timer = std::make_unique<CudaEventTimer>(
+      at::cuda::getCurrentCUDAStream().stream());
+  timer->start();
+  fp->communications_.emplace_back(std::move(prof), std::move(timer));
+  return fp->communications_.size() - 1;
+}
+
+void FusionProfiler::stopCommunication(size_t id) {
+  NVF_CHECK_EQ(state(), ProfilerState::Running);
+  FusionProfiler* fp = get();
+  NVF_CHECK(
+      id < fp->communications_.size(),
+      "FusionProfiler: You are attempting to stop a non-existent "
+      "communication! Communications: ",
+      fp->communications_.size(),
+      " Id: ",
+      id);
+  fp->communications_.at(id).second->stop(
+      at::cuda::getCurrentCUDAStream().stream());
+}
+
+void FusionProfiler::recordPipelineStage(PipelineStageProfile prof) {
+  get()->pipeline_stage_profile_ = std::move(prof);
+}
+
+const PipelineStageProfile& FusionProfiler::pipelineStageProfile() {
+  const auto& prof = get()->pipeline_stage_profile_;
+  NVF_CHECK(prof.has_value(), "No pipeline stage has been profiled!");
+  return *prof;
+}
+
 void FusionProfiler::recordAsyncCorrIdActivity(
     uint32_t seg_id,
     uint32_t corr_id) {
@@ -7,6 +7,8 @@
 // clang-format on
 #pragma once
 #include <chrono>
+#include <memory>
+#include <optional>
 #include <unordered_map>
 
 #include <c10/cuda/CUDAStream.h>
@@ -41,6 +43,9 @@ class CudaEventTimer {
   void reset();
   void start();
   void stop();
+  //! Records the stop event on `stream` instead, e.g., a stream that waits for
+  //! an asynchronous operation started on the timer's stream.
+  void stop(cudaStream_t stream);
   double time();
   ProfilerState state() const;
 
@@ -75,10 +80,11 @@ class HostTimer {
 
 //! \struct DeviceDescriptor
 //! \brief This struct captures the GPU information necessary to calculate the
-//! the Peak Bandwidth of the specific GPU queried.
+//! the Peak Bandwidth of the specific GPU queried, and the per-SM resources
+//! used by the cost model to estimate occupancy.
 struct DeviceDescriptor {
   //! Queries the GPU to populate the struct's data members and calculates the
-  //! peak bandwidth
+  //! peak bandwidth and FP32 throughput
   static void generate(DeviceDescriptor& desc, int device);
 
   //! Queried data members
@@ -86,9 +92,59 @@ struct DeviceDescriptor {
   std::string name{"NVIDIA Unknown GPU"};
   int bus_width{0};
   int memory_clock{0};
-
-  //! Calculated data member
+  int sm_count{0};
+  int max_threads_per_sm{0};
+  int max_registers_per_sm{0};
+  int max_shared_memory_per_sm{0};
+  int clock_rate{0};
+  int compute_capability_major{0};
+  int compute_capability_minor{0};
+
+  //! Calculated data members
   double peak_bandwidth_gbs{0.0};
+  double peak_fp32_gflops{0.0};
+};
+
+//! \struct LoweringPassProfile
+//! \brief This struct captures the host time of a step of GpuLower and the
+//! number of expressions of the IR after it, including nested ones.
+struct LoweringPassProfile {
+  std::string name{};
+  double time_ms{0.0};
+  int64_t num_exprs{0};
+};
+
+//! \struct PipelineStageProfile
+//! \brief This struct captures the GPU time that a device spent in the forward
+//! and backward passes of its pipeline stage during a run of a
+//! PipelineExecutor. The idle time is the rest of the run, i.e., the pipeline
+//! bubble and the communications that weren't overlapped.
+struct PipelineStageProfile {
+  int64_t stage{-1};
+  int64_t num_stages{0};
+  int64_t micro_batches{0};
+  int device{-1};
+
+  double total_time_ms{0.0};
+  double forward_time_ms{0.0};
+  double backward_time_ms{0.0};
+  double idle_time_ms{0.0};
+};
+
+std::ostream& operator<<(std::ostream&, const PipelineStageProfile&);
+
+//! \struct KernelStageProfile
+//! \brief This struct captures the cycles a warp group of a kernel spent in a
+//! stage, e.g., waiting for TMA loads, summed over the CTAs. Stages are
+//! profiled in kernels with TMA loads or MMAs with EnableOption::KernelProfile.
+struct KernelStageProfile {
+  std::string stage{};
+  int64_t warp_group{0};
+  int64_t cycles{0};
+  int64_t count{0};
+  //! Percentage of the cycles of the warp group in the kernel, so the
+  //! remainder of the stages shows the bubbles of the pipeline
+  double percentage_kernel{0.0};
 };
 
 //! \struct KernelProfile
@@ -106,6 +162,18 @@ struct KernelProfile {
   double effective_bandwidth_gbs{0.0};
   double percentage_peak_bandwidth{0.0};
 
+  //! Arithmetic operations of the segment, counted like the cost model does,
+  //! i.e., one per element of each expression
+  int64_t flops{0};
+  double achieved_gflops{0.0};
+  double percentage_peak_flops{0.0};
+  //! The fraction of the roofline reached, i.e., the larger of the
+  //! percentages of peak bandwidth and of peak FP32 throughput
+  double percentage_roofline{0.0};
+  //! True if percentage_roofline is below the threshold of
+  //! ProfilerOption::Export
+  bool below_roofline_threshold{false};
+
   std::array<int32_t, 3> grid{0, 0, 0};
   std::array<int32_t, 3> block{0, 0, 0};
   std::array<uint32_t, 3> cluster{0, 0, 0};
@@ -118,6 +186,7 @@ struct KernelProfile {
 
   std::string device_name{};
   double peak_bandwidth_gbs{0.0};
+  double peak_fp32_gflops{0.0};
 
   // These strings are here to capture the conversion
   // in struct that can be reference when making a tuple
@@ -127,6 +196,28 @@ struct KernelProfile {
   std::string shared_mem_str{};
 
   std::string scheduler{};
+  std::string heuristic_params{};
+
+  std::vector<KernelStageProfile> stages{};
+};
+
+//! \struct CommunicationProfile
+//! \brief This struct captures the time of a communication, measured with
+//! CUDA events from its post to its wait, and the resulting bandwidths. As in
+//! nccl-tests, the size is that of the largest buffer of the communication,
+//! and the bus bandwidth scales the algorithm bandwidth by the fraction of
+//! the data crossing the links, e.g., 2(n-1)/n for an Allreduce of n devices.
+struct CommunicationProfile {
+  std::string name{};
+  int64_t segment_id{-1};
+  int device{-1};
+  int64_t team_size{0};
+  int64_t bytes{0};
+  double bus_factor{1.0};
+
+  double time_ms{0.0};
+  double algorithm_bandwidth_gbs{0.0};
+  double bus_bandwidth_gbs{0.0};
 };
 
 struct ProfileAttrDescriptor {
@@ -173,13 +264,35 @@ struct FusionProfile {
 
   int64_t input_bytes{0};
   int64_t output_bytes{0};
+  //! High-water mark of the device memory allocated by the execution for its
+  //! outputs, intermediates and zeroed buffers
+  int64_t peak_memory_bytes{0};
 
   //! Vector of of the KernelProfiles for each segment of a Fusion
   std::vector<KernelProfile> kernel_profiles{};
+  //! The steps of GpuLower for each segment compiled while profiling,
+  //! preceded by the copy of the segment out of the complete fusion. Empty
+  //! for segments that were already compiled.
+  std::vector<std::vector<LoweringPassProfile>> lowering_pass_profiles{};
+  //! The communications waited for while profiling, in the order they were
+  //! posted
+  std::vector<CommunicationProfile> communication_profiles{};
 };
 
 std::ostream& operator<<(std::ostream&, const FusionProfile&);
 
+//! Writes a row per kernel of the FusionProfile in CSV, preceded by the
+//! header if `header` is true
+NVF_API void writeKernelProfilesCsv(
+    std::ostream& os,
+    const FusionProfile& prof,
+    bool header);
+
+//! Writes a JSON object per kernel of the FusionProfile, one per line
+NVF_API void writeKernelProfilesJson(
+    std::ostream& os,
+    const FusionProfile& prof);
+
 //! \struct SegmentProfiler
 //! \brief A class used to profile each segment of a Fusion
 class SegmentProfiler {
@@ -200,6 +313,30 @@ class SegmentProfiler {
 
   void scheduler(const std::string& name);
   const std::string& scheduler() const;
+  void heuristicParams(const std::string& params);
+  const std::string& heuristicParams() const;
+  void arithmeticOps(int64_t flops);
+  int64_t arithmeticOps() const;
+  void loweringPasses(std::vector<LoweringPassProfile> passes) {
+    lowering_passes_ = std::move(passes);
+  }
+  const std::vector<LoweringPassProfile>& loweringPasses() const {
+    return lowering_passes_;
+  }
+  //! The copy of the segment out of the complete fusion, reported as the first
+  //! lowering pass of the segment
+  void segmentCopy(LoweringPassProfile copy) {
+    segment_copy_ = std::move(copy);
+  }
+  const std::optional<LoweringPassProfile>& segmentCopy() const {
+    return segment_copy_;
+  }
+  void stageProfiles(std::vector<KernelStageProfile> stages) {
+    stages_ = std::move(stages);
+  }
+  const std::vector<KernelStageProfile>& stageProfiles() const {
+    return stages_;
+  }
 
   uint32_t segmentId() const;
   int device() const {
@@ -229,6 +366,11 @@ class SegmentProfiler {
   int64_t input_bytes_ = -1;
   int64_t output_bytes_ = -1;
   std::string scheduler_ = "None";
+  std::string heuristic_params_;
+  int64_t flops_ = 0;
+  std::vector<LoweringPassProfile> lowering_passes_;
+  std::optional<LoweringPassProfile> segment_copy_;
+  std::vector<KernelStageProfile> stages_;
   ProfilerState kernel_profile_state_;
 };
 
@@ -253,6 +395,7 @@ class FusionProfiler {
   static void stopCompile();
   static void inputBytesAccessed(int64_t bytes);
   static void outputBytesAccessed(int64_t bytes);
+  static void peakMemoryBytes(int64_t bytes);
   NVF_API static const FusionProfile& profile();
   // An API to query the last kernel time measured that is convenient
   // for profile a single kernel from the Fusion Executor.  Note, there
@@ -261,6 +404,18 @@ class FusionProfiler {
   NVF_API static double lastKernelTime();
   static SegmentProfiler& segment(size_t idx);
 
+  //! Starts timing a communication on the current stream. Returns the id to
+  //! stop the timer with once the communication has been waited for on the
+  //! current stream.
+  static size_t startCommunication(CommunicationProfile prof);
+  static void stopCommunication(size_t id);
+
+  //! Records the profile of the last run of a pipeline stage on this device.
+  //! Unlike the FusionProfile, it isn't reset when a Fusion starts profiling,
+  //! as the stages run their Fusions in between.
+  static void recordPipelineStage(PipelineStageProfile prof);
+  NVF_API static const PipelineStageProfile& pipelineStageProfile();
+
   //! Methods to capture Asynchronous CUPTI activity that get called from
   //! functions registered with CUPTI.
   //! Correlation ID -> Segment ID
@@ -306,6 +461,13 @@ class FusionProfiler {
   //! generated by CUPTI, to the segments responsible for the activity
   std::vector<KernelProfile> kernel_profiles_;
   std::unordered_map<uint32_t, uint32_t> corrid_2_segid_;
+
+  //! The communications started while profiling and their timers
+  std::vector<
+      std::pair<CommunicationProfile, std::unique_ptr<CudaEventTimer>>>
+      communications_;
+
+  std::optional<PipelineStageProfile> pipeline_stage_profile_;
 };
 
 } // namespace nvfuser
@@ -6,8 +6,10 @@
  */
 // clang-format on
 #include <algorithm>
+#include <ranges>
 #include <sstream>
 
+#include <alias_analysis.h>
 #include <debug.h>
 #include <device_lower/utils.h>
 #include <disjoint_set.h>
@@ -23,6 +25,7 @@
 #include <ops/alias.h>
 #include <ops/arith.h>
 #include <options.h>
+#include <scheduler/cost_model.h>
 #include <scheduler/debug_utils.h>
 #include <scheduler/normalization_utils.h>
 #include <transform_iter.h>
@@ -1613,59 +1616,48 @@ void GroupDependencyAnalysis::mergeGroups(
   }
 }
 
-//! Collect initial producer info using
-//!  a work list algorithm through forward traversal
-//!  a backward DFS would do the same
+//! Collect initial producer info by visiting the groups in topological
+//!  order. Each group is visited once all of its producer edges have been,
+//!  so the traversal is linear in the number of edges, apart from the
+//!  producer set unions.
 void GroupDependencyAnalysis::computeAllProducers() {
-  GroupSet visited;
-  GroupSet to_visit;
-
-  // Collect source nodes, with no producers we are guaranteed
-  //  a source node on a DAG
+  std::unordered_map<SegmentedGroup*, int64_t> num_unvisited_producer_edges;
+  std::deque<SegmentedGroup*> to_visit;
   for (auto group : segmented_fusion_->cgroups()) {
+    num_unvisited_producer_edges[group] = std::ssize(group->producer_edges);
+    // Source nodes, with no producers we are guaranteed a source node on a
+    // DAG
     if (group->producer_edges.empty()) {
-      visited.pushBack(group);
+      to_visit.push_back(group);
     }
   }
 
-  // visited now only contain source nodes
-  //  they can go backward to nowhere
-  for (auto group : visited) {
-    addConsumersToWorkList(group, to_visit);
-  }
-
+  int64_t num_visited = 0;
   while (!to_visit.empty()) {
-    SegmentedGroup* to_update = nullptr;
-    for (auto visiting_group : to_visit) {
-      if (std::all_of(
-              visiting_group->producer_edges.begin(),
-              visiting_group->producer_edges.end(),
-              [&visited](SegmentedEdge* e) { return visited.has(e->from); })) {
-        // filter multi-edges
-        GroupSet producers_of_visiting_group;
-        for (auto edge : visiting_group->producer_edges) {
-          producers_of_visiting_group.pushBack(edge->from);
-        }
+    SegmentedGroup* visiting_group = to_visit.front();
+    to_visit.pop_front();
+    num_visited++;
 
-        // populate all possible paths
-        // from producer backward, including
-        // the producer
-        for (auto producer : producers_of_visiting_group) {
-          getAllKnownProducersSet(visiting_group)->pushBack(producer);
-          mergeAllKnownProducersIntoFrom(visiting_group, producer);
-        }
-        to_update = visiting_group;
-        break;
+    // populate all possible paths from producer backward, including the
+    // producer. Multi-edges are filtered by the set.
+    auto& producers_of_visiting_group =
+        getAllKnownProducersSet(visiting_group);
+    for (auto edge : visiting_group->producer_edges) {
+      if (producers_of_visiting_group->pushBack(edge->from)) {
+        mergeAllKnownProducersIntoFrom(visiting_group, edge->from);
       }
     }
-    if (to_update) {
-      addConsumersToWorkList(to_update, to_visit);
-      to_visit.erase(to_update);
-      visited.pushBack(to_update);
-    } else {
-      NVF_THROW("unreachable, original graph not a DAG");
+
+    for (auto edge : visiting_group->consumer_edges) {
+      if (--num_unvisited_producer_edges.at(edge->to) == 0) {
+        to_visit.push_back(edge->to);
+      }
     }
   }
+  NVF_ERROR_EQ(
+      num_visited,
+      std::ssize(segmented_fusion_->cgroups()),
+      "unreachable, original graph not a DAG");
 }
 
 std::ostream& operator<<(
@@ -1877,24 +1869,13 @@ void eraseInputDistinctRootDomains(Fusion* fusion) {
 
 std::pair<IrCloner, std::unique_ptr<Fusion>> SegmentedFusion::makeFusion(
     SegmentedGroup* sg) const {
-  // TODO Optimize cloning step by only copying values and expressions between
-  // the fusion segment's inputs and outputs.
+  FUSER_PERF_SCOPE("SegmentedFusion::makeFusion");
   auto fusion_segment = std::make_unique<Fusion>();
 
+  // Only the exprs of the segment and what they depend on are copied, not the
+  // rest of the complete fusion.
   IrCloner complete_to_segment_map =
-      Fusion::copy(completeFusion(), fusion_segment.get());
-
-  std::vector<Val*> input_list(
-      fusion_segment->inputs().begin(), fusion_segment->inputs().end());
-  for (auto inp : input_list) {
-    fusion_segment->removeInput(inp);
-  }
-
-  std::vector<Val*> output_list(
-      fusion_segment->outputs().begin(), fusion_segment->outputs().end());
-  for (auto out : output_list) {
-    fusion_segment->removeOutput(out);
-  }
+      Fusion::copy(completeFusion(), fusion_segment.get(), sg->exprs());
 
   std::vector<TensorView*> view_tvs;
   for (auto inp : getAllInputs(sg)) {
@@ -2492,6 +2473,68 @@ SchedulerType tryMerge(
       segmented_fusion->completeFusion(), runtime_info);
 }
 
+// Returns the predicted runtime of the kernel scheduling groups with
+// scheduler_type. See cost_model::predictRuntime.
+std::optional<double> predictRuntime(
+    SegmentedFusion* segmented_fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const std::vector<SegmentedGroup*>& groups,
+    SchedulerType scheduler_type) {
+  FusionSegmentGuard fsg(segmented_fusion, groups);
+  return cost_model::predictRuntime(
+      scheduler_type, segmented_fusion->completeFusion(), runtime_info);
+}
+
+// With EnableOption::CostModel, two groups that can be scheduled together
+// are only merged if the merged kernel is predicted to be at least as fast
+// as the kernels of the separate groups. The separate kernels pay for
+// writing and reading back the tensors between the groups, and the merged
+// kernel for losing the resources of either kernel, e.g., a persistent
+// kernel that spills or a kernel whose vectorization is limited by a tensor
+// of the other group may be slower than the two kernels. This applies to the
+// Herrmann and the final merges, which go through codeGenSupportedMerge.
+// Merges are accepted whenever a cost can't be predicted.
+bool isMergeProfitable(
+    SegmentedFusion* segmented_fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    SegmentedGroup* group1,
+    SegmentedGroup* group2,
+    SchedulerType merged_scheduler_type) {
+  FUSER_PERF_SCOPE("isMergeProfitable");
+  if (!cost_model::isComparable(merged_scheduler_type)) {
+    return true;
+  }
+  std::optional<double> merged_time_us = predictRuntime(
+      segmented_fusion,
+      runtime_info,
+      {group1, group2},
+      merged_scheduler_type);
+  if (!merged_time_us.has_value()) {
+    return true;
+  }
+  double separate_time_us = 0.0;
+  for (SegmentedGroup* group : {group1, group2}) {
+    const SchedulerType scheduler_type =
+        tryMerge(segmented_fusion, runtime_info, group);
+    if (!cost_model::isComparable(scheduler_type)) {
+      return true;
+    }
+    std::optional<double> time_us = predictRuntime(
+        segmented_fusion, runtime_info, {group}, scheduler_type);
+    if (!time_us.has_value()) {
+      return true;
+    }
+    separate_time_us += *time_us;
+  }
+  scheduler_debug_utils::canScheduleMessage(
+      "**Segmenter** Predicted ",
+      *merged_time_us,
+      " us for the merged group and ",
+      separate_time_us,
+      " us for the separate groups");
+  return *merged_time_us <= separate_time_us;
+}
+
 // This function is for cleanup and
 //  easier debugging. It shouldn't affect functionality
 //  since segmented fusions are compiled with fusion
@@ -4040,12 +4083,39 @@ bool SegmentCandidateFinder::codeGenSupportedMerge(
   if (options_.custom_should_merge_groups != nullptr) {
     return (options_.custom_should_merge_groups)(group1, group2);
   }
-  return tryMerge(segmented_fusion_.get(), runtimeInfo(), group1, group2) !=
-      SchedulerType::None;
+  const SchedulerType merged_scheduler_type = tryMergeMemoized(group1, group2);
+  if (merged_scheduler_type == SchedulerType::None) {
+    return false;
+  }
+  if (!cost_model::isEnabled()) {
+    return true;
+  }
+  return isMergeProfitable(
+      segmented_fusion_.get(),
+      runtimeInfo(),
+      group1,
+      group2,
+      merged_scheduler_type);
+}
+
+SchedulerType SegmentCandidateFinder::tryMergeMemoized(
+    SegmentedGroup* a,
+    SegmentedGroup* b) {
+  std::vector<Expr*> exprs = a->exprs();
+  if (b != nullptr) {
+    exprs.insert(exprs.end(), b->exprs().begin(), b->exprs().end());
+  }
+  std::sort(exprs.begin(), exprs.end());
+  exprs.erase(std::unique(exprs.begin(), exprs.end()), exprs.end());
+  if (auto it = merge_results_.find(exprs); it != merge_results_.end()) {
+    return it->second;
+  }
+  const SchedulerType scheduler_type =
+      tryMerge(segmented_fusion_.get(), runtimeInfo(), a, b);
+  merge_results_.emplace(std::move(exprs), scheduler_type);
+  return scheduler_type;
 }
 
-// TODO: consider caching the heuristics value so tryMerge doesn't have to be
-//       called twice
 SchedulerType SegmentCandidateFinder::deriveSchedulerType(
     SegmentedGroup* group) {
   FUSER_PERF_SCOPE("SegmentCandidateFinder::deriveSchedulerType");
@@ -4054,7 +4124,7 @@ SchedulerType SegmentCandidateFinder::deriveSchedulerType(
     // this moment
     return SchedulerType::None;
   }
-  auto scheduler_type = tryMerge(segmented_fusion_.get(), runtimeInfo(), group);
+  auto scheduler_type = tryMergeMemoized(group);
   NVF_ERROR(
       scheduler_type != SchedulerType::None,
       "Can not find a scheduler to schedule fusion segment");
@@ -4082,6 +4152,7 @@ SegmentCandidateFinder::SegmentCandidateFinder(
   }
 
   privatizeUpcast();
+  recomputeCheapProducers();
   findSegments();
 }
 
@@ -4200,6 +4271,8 @@ void SegmentCandidateFinder::trySetUpMerge(
 
 void SegmentCandidateFinder::resolveForwardedInputs() {
   FUSER_PERF_SCOPE("SegmentCandidateFinder::resolveForwardedInputs");
+  // Expressions are added to the groups
+  merge_results_.clear();
   for (Val* forwarded_input : forwarded_fusion_inputs_) {
     if (forwarded_input->isFusionInput()) {
       // Nothing to resolve.
@@ -4324,6 +4397,20 @@ void SegmentCandidateFinder::findSegments() {
 
   validateIfDebug();
 
+  if (isOptionEnabled(EnableOption::HorizontalFusion) &&
+      options_.custom_should_merge_groups == nullptr) {
+    horizontalMerge();
+  }
+
+  validateIfDebug();
+
+  if (options_.run_final_merge &&
+      options_.custom_should_merge_groups == nullptr) {
+    splitViewTails();
+  }
+
+  validateIfDebug();
+
   // Resolve all the input expressions needed in each group
   resolveForwardedInputs();
 
@@ -4402,7 +4489,10 @@ void SegmentCandidateFinder::privatizeUpcast() {
   }
 }
 
-void SegmentCandidateFinder::revertPrivatizedUpcast(SegmentedGroup* group) {
+void SegmentCandidateFinder::replacePrivatizedVal(
+    SegmentedGroup* group,
+    Val* val_to_replace,
+    Val* val_to_keep) {
   // If a given consumer edge is a duplicate of another edge of the
   // same producer group, remove the given edge from both the producer
   // and consumer groups.
@@ -4455,6 +4545,51 @@ void SegmentCandidateFinder::revertPrivatizedUpcast(SegmentedGroup* group) {
     }
   };
 
+  NVF_ERROR(
+      val_to_replace->uses().size() == 1,
+      "Multiple use of replicated tensor found: ",
+      toDelimitedString(val_to_replace->uses()));
+
+  auto use_of_val_to_replace = val_to_replace->uses().at(0);
+
+  auto updated_expr = ir_utils::replaceValInExprInputs(
+      use_of_val_to_replace, val_to_replace, val_to_keep);
+
+  // Replace use_of_val_to_replace with updated_expr.
+  // use_of_val_to_replace must be in the same group of its consumer
+  // groups
+  if (!maybe_replace(group, use_of_val_to_replace, updated_expr)) {
+    for (auto consumer_edge : group->consumer_edges) {
+      if (maybe_replace(
+              consumer_edge->to, use_of_val_to_replace, updated_expr)) {
+        break;
+      }
+    }
+  }
+
+  // Update a consumer edge if its val is val_to_replace. Again, there
+  // must be at most one such edge.
+  SegmentedEdge* consumer_edge_to_update = nullptr;
+  for (auto consumer_edge : group->consumer_edges) {
+    if (consumer_edge->val == val_to_replace) {
+      NVF_ERROR(
+          consumer_edge_to_update == nullptr,
+          "Multiple consumer edges using ",
+          val_to_replace->toString(),
+          " found");
+      consumer_edge->val = val_to_keep;
+      consumer_edge_to_update = consumer_edge;
+    }
+  }
+
+  // Now that the consumer edge is updated, it may be a duplicate
+  // of an exising edge. Remove if so.
+  if (consumer_edge_to_update != nullptr) {
+    maybe_deduplicate_edge(consumer_edge_to_update);
+  }
+}
+
+void SegmentCandidateFinder::revertPrivatizedUpcast(SegmentedGroup* group) {
   for (const auto& [original_upcast, clones] : privatized_upcast_ops_) {
     std::vector<UnaryOp*> upcast_in_group;
     Val* upcast_val_to_keep = nullptr;
@@ -4486,59 +4621,190 @@ void SegmentCandidateFinder::revertPrivatizedUpcast(SegmentedGroup* group) {
         continue;
       }
 
-      NVF_ERROR(
-          upcast_val_to_replace->uses().size() == 1,
-          "Multiple use of replicated upcast tensor found: ",
-          toDelimitedString(upcast_val_to_replace->uses()));
-
-      auto use_of_upcast_val_to_replace = upcast_val_to_replace->uses().at(0);
-
-      auto updated_expr = ir_utils::replaceValInExprInputs(
-          use_of_upcast_val_to_replace,
-          upcast_val_to_replace,
-          upcast_val_to_keep);
-
-      // Replace use_of_upcast_val_to_replace with
-      // updated_expr. use_of_upcast_val_to_replace must be in the
-      // same group of its consumer groups
-      if (!maybe_replace(group, use_of_upcast_val_to_replace, updated_expr)) {
-        for (auto consumer_edge : group->consumer_edges) {
-          if (maybe_replace(
-                  consumer_edge->to,
-                  use_of_upcast_val_to_replace,
-                  updated_expr)) {
-            break;
-          }
-        }
+      replacePrivatizedVal(group, upcast_val_to_replace, upcast_val_to_keep);
+
+      std::erase(group->exprs_, uop);
+
+      // Note that it should not be necessary to do anything with
+      // group->output_vals since the inserted upcast ops should never produce
+      // fusion outputs.
+    }
+  }
+}
+
+namespace {
+
+// Pointwise expressions that are cheap enough to be recomputed by each
+// segment consuming their output. RNG ops are only included with an explicit
+// seed and offset: Philox is counter-based, so a clone regenerates the same
+// numbers from them and the logical index, e.g., a dropout mask, instead of
+// reading them from memory. Other RNG ops get their own offsets and would
+// draw different numbers. segment_sets are excluded as LoadStoreOps.
+bool isCheapProducer(Expr* expr) {
+  if (auto* rop = dynamic_cast<RNGOp*>(expr)) {
+    return rop->isDeterministic();
+  }
+  return expr != nullptr && ir_utils::isTvOp(expr) &&
+      expr->outputs().size() == 1 &&
+      expr->isOneOf<
+          UnaryOp,
+          BinaryOp,
+          TernaryOp,
+          BroadcastOp,
+          SqueezeOp,
+          ExpandOp>();
+}
+
+// Number of logical dimensions of tv that aren't reductions or broadcasts
+int64_t numConcreteDims(TensorView* tv) {
+  return std::ranges::count_if(tv->getLogicalDomain(), [](IterDomain* id) {
+    return !id->isReduction() && !id->isBroadcast();
+  });
+}
+
+// Returns the tensors tv is recomputed from when recomputing it from its
+// cheap producers, or std::nullopt if this takes more than max_exprs
+// expressions or reads more bytes per element than tv has. The tensors are
+// fusion inputs and outputs and tensors defined by expressions that aren't
+// cheap. Tensors with fewer concrete dimensions than tv, e.g., broadcast
+// operands, are assumed to be negligible in size.
+std::optional<std::vector<Val*>> cheapProducerFrontier(
+    TensorView* tv,
+    int64_t max_exprs) {
+  VectorOfUniqueEntries<Val*> frontier;
+  std::unordered_set<Expr*> visited;
+  std::vector<TensorView*> to_visit = {tv};
+  while (!to_visit.empty()) {
+    TensorView* producer = to_visit.back();
+    to_visit.pop_back();
+    Expr* def = producer->definition();
+    if (!visited.insert(def).second) {
+      continue;
+    }
+    if (std::ssize(visited) > max_exprs) {
+      return std::nullopt;
+    }
+    for (auto* input : ir_utils::filterByType<TensorView>(def->inputs())) {
+      if (input->isFusionInput() || input->isFusionOutput() ||
+          !isCheapProducer(input->definition())) {
+        frontier.pushBack(input);
+      } else {
+        to_visit.push_back(input);
       }
+    }
+  }
 
-      // Update a consumer edge if its val is
-      // upcast_val_to_replace. Again, there must be at most one such
-      // edge.
-      SegmentedEdge* consumer_edge_to_update = nullptr;
-      for (auto consumer_edge : group->consumer_edges) {
-        if (consumer_edge->val == upcast_val_to_replace) {
-          NVF_ERROR(
-              consumer_edge_to_update == nullptr,
-              "Multiple consumer edges using ",
-              upcast_val_to_replace->toString(),
-              " found");
-          consumer_edge->val = upcast_val_to_keep;
-          consumer_edge_to_update = consumer_edge;
-        }
+  const int64_t num_dims = numConcreteDims(tv);
+  int64_t frontier_bytes = 0;
+  for (auto* input : ir_utils::filterByType<TensorView>(frontier.vector())) {
+    if (numConcreteDims(input) >= num_dims) {
+      frontier_bytes += dataTypeSizeByte(input->dtype());
+    }
+  }
+  if (frontier_bytes > dataTypeSizeByte(tv->dtype())) {
+    return std::nullopt;
+  }
+  return frontier.vector();
+}
+
+std::vector<Expr*> tvExprsBetween(
+    const std::vector<Val*>& from,
+    TensorView* to) {
+  std::vector<Expr*> exprs = StmtSort::getExprsBetween(from, {to});
+  std::erase_if(exprs, [](Expr* expr) { return !ir_utils::isTvOp(expr); });
+  return exprs;
+}
+
+int64_t maxRecomputedExprs() {
+  constexpr int64_t default_max_exprs = 4;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::RecomputeProducers);
+  return option_args.empty() ? default_max_exprs : std::stoll(option_args[0]);
+}
+
+} // namespace
+
+void SegmentCandidateFinder::recomputeCheapProducers() {
+  if (!isOptionEnabled(EnableOption::RecomputeProducers)) {
+    return;
+  }
+  FUSER_PERF_SCOPE("SegmentCandidateFinder::recomputeCheapProducers");
+  FusionGuard fg(segmented_fusion_->complete_fusion_.get());
+  const int64_t max_exprs = maxRecomputedExprs();
+
+  // Privatized upcasts are reverted by matching their uses, so leave them
+  // alone
+  std::unordered_set<Expr*> privatized_upcasts;
+  for (const auto& [original_upcast, clones] : privatized_upcast_ops_) {
+    privatized_upcasts.insert(original_upcast);
+    privatized_upcasts.insert(clones.begin(), clones.end());
+  }
+
+  const auto exprs = segmented_fusion_->complete_fusion_->exprs();
+  for (auto expr : exprs) {
+    if (!ir_utils::isTvOp(expr) || privatized_upcasts.count(expr)) {
+      continue;
+    }
+
+    for (const auto i : arange(expr->inputs().size())) {
+      auto tv = dynamic_cast<TensorView*>(expr->input(i));
+      if (tv == nullptr || tv->isFusionOutput() ||
+          !isCheapProducer(tv->definition())) {
+        continue;
       }
 
-      // Now that the consumer edge is updated, it may be a duplicate
-      // of an exising edge. Remove if so.
-      if (consumer_edge_to_update != nullptr) {
-        maybe_deduplicate_edge(consumer_edge_to_update);
+      // Like privatized upcasts, the first use keeps the original tensor
+      const std::vector<Expr*>& uses = tv->uses();
+      if (uses.size() < 2 || expr == uses.front()) {
+        continue;
       }
 
-      std::erase(group->exprs_, uop);
+      std::optional<std::vector<Val*>> frontier =
+          cheapProducerFrontier(tv, max_exprs);
+      if (!frontier.has_value()) {
+        continue;
+      }
 
-      // Note that it should not be necessary to do anything with
-      // group->output_vals since the inserted upcast ops should never produce
-      // fusion outputs.
+      TensorView* recomputed_tv = RecomputeTv::recompute(tv, *frontier);
+      expr = ir_utils::replaceValInExprInputs(expr, tv, recomputed_tv);
+
+      auto it = std::ranges::find(
+          recomputed_producers_, tv, &RecomputedProducer::original_tv);
+      if (it == recomputed_producers_.end()) {
+        recomputed_producers_.push_back(
+            RecomputedProducer{tv, tvExprsBetween(*frontier, tv), {}});
+        it = std::prev(recomputed_producers_.end());
+      }
+      it->recomputations.emplace_back(
+          recomputed_tv, tvExprsBetween(*frontier, recomputed_tv));
+    }
+  }
+}
+
+void SegmentCandidateFinder::revertRecomputedProducers(SegmentedGroup* group) {
+  auto in_group = [group](const std::vector<Expr*>& exprs) {
+    return std::ranges::all_of(exprs, [group](Expr* expr) {
+      return std::ranges::find(group->exprs_, expr) != group->exprs_.end();
+    });
+  };
+
+  // Tensors are recorded in the order of their consumers. Reverting the
+  // downstream recomputations first keeps the original expressions of the
+  // upstream ones intact.
+  for (const RecomputedProducer& recomputed :
+       recomputed_producers_ | std::views::reverse) {
+    if (!in_group(recomputed.original_exprs)) {
+      continue;
+    }
+    for (const auto& [recomputed_tv, recomputed_exprs] :
+         recomputed.recomputations) {
+      if (!in_group(recomputed_exprs)) {
+        continue;
+      }
+      replacePrivatizedVal(group, recomputed_tv, recomputed.original_tv);
+      for (Expr* recomputed_expr : recomputed_exprs) {
+        std::erase(group->exprs_, recomputed_expr);
+      }
     }
   }
 }
@@ -4754,6 +5020,223 @@ void SegmentCandidateFinder::finalMerge() {
   }
 }
 
+void SegmentCandidateFinder::horizontalMerge() {
+  FUSER_PERF_SCOPE("SegmentCandidateFinder::horizontalMerge");
+  auto dependency = getGroupDependency();
+
+  auto can_merge_horizontally = [](SegmentedGroup* group) {
+    return !group->exprs_.empty() &&
+        (group->schedulerType() == SchedulerType::PointWise ||
+         group->schedulerType() == SchedulerType::Reduction);
+  };
+
+  bool merged_nodes = true;
+  while (merged_nodes) {
+    merged_nodes = false;
+    // Merge one pair at a time since merging invalidates groups()
+    for (auto i : arange(groups().size())) {
+      SegmentedGroup* first_group = groups().at(i);
+      if (!can_merge_horizontally(first_group)) {
+        continue;
+      }
+      const SchedulerType scheduler_type = first_group->schedulerType();
+      for (auto j : arange(i + 1, groups().size())) {
+        SegmentedGroup* second_group = groups().at(j);
+        if (!can_merge_horizontally(second_group) ||
+            second_group->schedulerType() != scheduler_type ||
+            dependency->isProducerOf(first_group, second_group) ||
+            dependency->isProducerOf(second_group, first_group)) {
+          continue;
+        }
+        if (tryMergeMemoized(first_group, second_group) != scheduler_type) {
+          continue;
+        }
+        if (cost_model::isEnabled() &&
+            !isMergeProfitable(
+                segmented_fusion_.get(),
+                runtimeInfo(),
+                first_group,
+                second_group,
+                scheduler_type)) {
+          continue;
+        }
+        to_merge_.emplace_back(first_group);
+        to_merge_.emplace_back(second_group);
+        mergeNodes();
+        merged_nodes = true;
+        break;
+      }
+      if (merged_nodes) {
+        break;
+      }
+    }
+  }
+}
+
+void SegmentCandidateFinder::splitViewTails() {
+  FUSER_PERF_SCOPE("SegmentCandidateFinder::splitViewTails");
+  const AliasAnalysisResult analysis =
+      findAliases(completeFusion(), EmptyAllocationAs::kLogical);
+  auto is_view = [&analysis](Expr* expr) {
+    return ir_utils::isTvOp(expr) && !ir_utils::isSegmentSet(expr) &&
+        std::ranges::all_of(expr->outputs(), [&analysis](Val* out) {
+             auto* tv = dynamic_cast<TensorView*>(out);
+             return tv != nullptr && analysis.getRoot(tv) != nullptr;
+           });
+  };
+
+  std::unordered_set<SegmentedGroup*> input_groups;
+  for (const auto& [input, group] : input2group_) {
+    input_groups.insert(group);
+  }
+
+  // The dependency analysis doesn't know about the new groups
+  group_dependency_.reset();
+
+  // groups() grows with the view groups
+  const std::vector<SegmentedGroup*> candidates = groups();
+  for (SegmentedGroup* group : candidates) {
+    if (input_groups.count(group) || group->exprs_.empty() ||
+        group->schedulerType() == SchedulerType::ExprEval ||
+        group->schedulerType() == SchedulerType::NoOp) {
+      continue;
+    }
+
+    const std::unordered_set<Expr*> group_exprs(
+        group->exprs_.begin(), group->exprs_.end());
+    std::unordered_set<Val*> needed_outside(
+        group->output_vals_.begin(), group->output_vals_.end());
+    for (SegmentedEdge* edge : group->consumer_edges) {
+      needed_outside.insert(edge->val);
+    }
+    // Inputs produced by other groups than the input groups, which a view
+    // group can read too. Forwarded inputs are recomputed by their consumers,
+    // which would make the view group more than views.
+    std::unordered_map<Val*, SegmentedGroup*> producer_groups;
+    for (SegmentedEdge* edge : group->producer_edges) {
+      if (!input_groups.count(edge->from)) {
+        producer_groups.emplace(edge->val, edge->from);
+      }
+    }
+
+    // Shrinks the views of the group to those whose outputs are only used by
+    // other tail views in the group and whose inputs are materialized anyway
+    std::unordered_set<Expr*> tail;
+    std::ranges::copy_if(
+        group->exprs_, std::inserter(tail, tail.end()), is_view);
+    auto is_tail = [&](Expr* expr) {
+      const bool used_by_tail_only =
+          std::ranges::all_of(expr->outputs(), [&](Val* out) {
+            return std::ranges::all_of(out->uses(), [&](Expr* use) {
+              return !group_exprs.count(use) || tail.count(use);
+            });
+          });
+      return used_by_tail_only &&
+          std::ranges::all_of(expr->inputs(), [&](Val* in) {
+               if (!in->isA<TensorView>()) {
+                 return true;
+               }
+               Expr* def = in->definition();
+               if (def != nullptr && group_exprs.count(def)) {
+                 return tail.count(def) > 0 || needed_outside.count(in) > 0;
+               }
+               return in->isFusionInput() || producer_groups.count(in) > 0;
+             });
+    };
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto it = tail.begin(); it != tail.end();) {
+        if (is_tail(*it)) {
+          ++it;
+        } else {
+          it = tail.erase(it);
+          changed = true;
+        }
+      }
+    }
+    if (tail.empty() || tail.size() == group_exprs.size()) {
+      continue;
+    }
+
+    SegmentedGroup* view_group = segmented_fusion_->newGroup();
+    std::vector<Expr*> kept_exprs;
+    for (Expr* expr : group->exprs_) {
+      (tail.count(expr) ? view_group->exprs_ : kept_exprs).push_back(expr);
+    }
+    group->exprs_ = std::move(kept_exprs);
+
+    auto defined_by_tail = [&tail](Val* val) {
+      return val->definition() != nullptr && tail.count(val->definition());
+    };
+    for (Val* out : std::vector<Val*>(group->output_vals_.vector())) {
+      if (defined_by_tail(out)) {
+        group->output_vals_.erase(out);
+        view_group->output_vals_.pushBack(out);
+      }
+    }
+    for (SegmentedEdge* edge :
+         std::vector<SegmentedEdge*>(group->consumer_edges)) {
+      if (defined_by_tail(edge->val)) {
+        segmented_fusion_->connectGroups(view_group, edge->to, edge->val);
+        segmented_fusion_->removeEdge(edge);
+      }
+    }
+
+    VectorOfUniqueEntries<Val*> sources;
+    for (Expr* expr : view_group->exprs_) {
+      for (Val* in : expr->inputs()) {
+        if (in->isA<TensorView>() && !defined_by_tail(in)) {
+          sources.pushBack(in);
+        }
+      }
+    }
+    for (Val* source : sources) {
+      if (source->definition() != nullptr &&
+          group_exprs.count(source->definition())) {
+        segmented_fusion_->connectGroups(group, view_group, source);
+      } else if (source->isFusionInput()) {
+        view_group->input_vals_.pushBack(source);
+        segmented_fusion_->connectGroups(
+            input2group_.at(source), view_group, source);
+      } else {
+        segmented_fusion_->connectGroups(
+            producer_groups.at(source), view_group, source);
+      }
+    }
+
+    // Drops the inputs the group no longer reads
+    std::unordered_set<Val*> used_inputs;
+    for (Expr* expr : group->exprs_) {
+      used_inputs.insert(expr->inputs().begin(), expr->inputs().end());
+    }
+    for (SegmentedEdge* edge :
+         std::vector<SegmentedEdge*>(group->producer_edges)) {
+      if (!used_inputs.count(edge->val)) {
+        segmented_fusion_->removeEdge(edge);
+      }
+    }
+    for (Val* in : std::vector<Val*>(group->input_vals_.vector())) {
+      if (!used_inputs.count(in)) {
+        group->input_vals_.erase(in);
+      }
+    }
+
+    const SchedulerType group_type = tryMergeMemoized(group);
+    const SchedulerType view_type = tryMergeMemoized(view_group);
+    if (group_type == SchedulerType::None ||
+        view_type != SchedulerType::ExprEval) {
+      // Puts the views back
+      to_merge_.emplace_back(group);
+      to_merge_.emplace_back(view_group);
+      mergeNodes();
+      continue;
+    }
+    group->setSchedulerType(group_type);
+    view_group->setSchedulerType(view_type);
+  }
+}
+
 void SegmentCandidateFinder::resolveScalarsInGroup(SegmentedGroup* group) {
   std::vector<Val*> to_visit;
   std::unordered_set<Val*> visited;
@@ -4979,6 +5462,9 @@ void SegmentCandidateFinder::removeScalarEdges() {
 
 void SegmentCandidateFinder::finalize() {
   FUSER_PERF_SCOPE("SegmentCandidateFinder::finalize");
+  // Scalar expressions are added to the groups and privatized upcasts are
+  // reverted
+  merge_results_.clear();
   // Remove unconnected groups
   groups().erase(
       std::remove_if(
@@ -5009,6 +5495,7 @@ void SegmentCandidateFinder::finalize() {
   }
 
   for (auto group : segmented_fusion_->groups()) {
+    revertRecomputedProducers(group);
     revertPrivatizedUpcast(group);
   }
 
@@ -5027,6 +5514,38 @@ GroupDependencyAnalysis* SegmentCandidateFinder::getGroupDependency() {
   return group_dependency_->as<GroupDependencyAnalysis>();
 }
 
+namespace {
+
+// Hashes what the compile-time heuristic data of a group depends on: its
+// scheduler, the index type and the IR of its fusion. Segment fusions made
+// from copies of the same concretized fusion register their vals in the same
+// order, so the hash also covers the position of each val.
+size_t heuristicDataHash(
+    SchedulerType scheduler_type,
+    Fusion* fusion,
+    PrimDataType index_type) {
+  std::stringstream ss;
+  ss << scheduler_type << " " << DataType(index_type) << std::endl;
+  for (Val* val : fusion->deterministic_vals()) {
+    ss << val->vtype() << " " << val->dtype() << " " << val->toString();
+    if (auto tv = dynamic_cast<TensorView*>(val)) {
+      ss << " " << tv->domain()->toString(0, /*loop_only=*/false);
+      for (const std::optional<bool>& contiguity : tv->getContiguity()) {
+        ss << (contiguity.has_value() ? (*contiguity ? "t" : "f") : "n");
+      }
+    }
+    ss << std::endl;
+  }
+  for (Expr* expr : fusion->deterministic_exprs()) {
+    ss << expr->toString();
+  }
+  ss << toDelimitedString(fusion->inputs()) << std::endl
+     << toDelimitedString(fusion->outputs());
+  return std::hash<std::string>()(ss.str());
+}
+
+} // namespace
+
 std::unique_ptr<HeuristicParams> SegmentedFusion::makeInitialHeuristicParams(
     SegmentedGroup* sg,
     SchedulerRuntimeInfo& runtime_info) {
@@ -5035,9 +5554,51 @@ std::unique_ptr<HeuristicParams> SegmentedFusion::makeInitialHeuristicParams(
   auto heuristic_data_cache_ptr = std::make_unique<HeuristicDataCache>();
   auto heuristic_data_cache = heuristic_data_cache_ptr.get();
   setCachedHeuristicDataFor(sg, std::move(heuristic_data_cache_ptr));
+
+  Fusion* fusion = runtime_info.fusion();
+  const std::deque<Val*>& vals = fusion->deterministic_vals();
+  const HeuristicDataKey key{
+      heuristicDataHash(
+          sg->schedulerType(), fusion, runtime_info.getIndexType()),
+      std::ssize(vals)};
+  heuristic_data_keys_[sg] = key;
+
+  // The compile-time entries of a structurally identical group of another
+  // segmentation only differ in the vals they refer to
+  if (heuristic_data_source_ != nullptr) {
+    auto source_it = std::find_if(
+        heuristic_data_source_->heuristic_data_keys_.begin(),
+        heuristic_data_source_->heuristic_data_keys_.end(),
+        [&key](const auto& group_and_key) {
+          return group_and_key.second.hash == key.hash &&
+              group_and_key.second.num_vals == key.num_vals;
+        });
+    if (source_it != heuristic_data_source_->heuristic_data_keys_.end()) {
+      SegmentedGroup* source_group = source_it->first;
+      const std::unordered_map<Val*, int64_t> source_positions =
+          source_group->getFusion()->deterministic_vals_map();
+      auto val_map = [&](Val* source_val) -> Val* {
+        auto position_it = source_positions.find(source_val);
+        if (position_it == source_positions.end() ||
+            position_it->second >= key.num_vals) {
+          return nullptr;
+        }
+        Val* val = vals.at(position_it->second);
+        if (val->vtype() != source_val->vtype() ||
+            val->dtype() != source_val->dtype() ||
+            val->name() != source_val->name()) {
+          return nullptr;
+        }
+        return val;
+      };
+      num_shared_heuristic_data_entries_ += heuristic_data_cache->copyFrom(
+          *heuristic_data_source_->getCachedHeuristicDataFor(source_group),
+          val_map);
+    }
+  }
+
   return SchedulerEntry::makeSchedulerInstance(sg->schedulerType())
-      ->computeHeuristics(
-          runtime_info.fusion(), runtime_info, heuristic_data_cache);
+      ->computeHeuristics(fusion, runtime_info, heuristic_data_cache);
 }
 
 HeuristicDataCache* SegmentedFusion::getCachedHeuristicDataFor(
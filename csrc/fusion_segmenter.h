@@ -21,6 +21,7 @@
 #include <deque>
 #include <functional>
 #include <list>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -308,6 +309,20 @@ class SegmentedFusion {
       SegmentedGroup* sg,
       SchedulerRuntimeInfo& runtime_info);
 
+  //! Lets makeInitialHeuristicParams start the HeuristicDataCache of a group
+  //!  from the entries of a structurally identical group of source, which
+  //!  is a segmentation of the same concretized fusion. source must outlive
+  //!  the calls to makeInitialHeuristicParams and can be reset with nullptr.
+  void setHeuristicDataSource(SegmentedFusion* source) {
+    heuristic_data_source_ = source;
+  }
+
+  //! Number of HeuristicDataCache entries copied from the source set by
+  //!  setHeuristicDataSource instead of being computed
+  int64_t numSharedHeuristicDataEntries() const {
+    return num_shared_heuristic_data_entries_;
+  }
+
   //! Debug drawing for graphviz
   void draw();
 
@@ -431,6 +446,19 @@ class SegmentedFusion {
   std::unordered_map<SegmentedGroup*, std::unique_ptr<HeuristicDataCache>>
       heuristic_data_cache_;
 
+  //! Structural hash of a group with a HeuristicDataCache and the number of
+  //!  vals of its fusion before the cache was filled. Vals created while
+  //!  computing the heuristics come after them and are not shared.
+  struct HeuristicDataKey {
+    size_t hash = 0;
+    int64_t num_vals = 0;
+  };
+  std::unordered_map<SegmentedGroup*, HeuristicDataKey> heuristic_data_keys_;
+
+  //! See setHeuristicDataSource
+  SegmentedFusion* heuristic_data_source_ = nullptr;
+  int64_t num_shared_heuristic_data_entries_ = 0;
+
   //! The number of values in fusion after constructing segmented fusion.
   //! Used for checking state during deserialization.
   size_t initial_vals_size_;
@@ -563,6 +591,11 @@ class SegmentCandidateFinder {
 
   bool codeGenSupportedMerge(SegmentedGroup* group1, SegmentedGroup* group2);
 
+  //! tryMerge of a and b, memoized in merge_results_
+  SchedulerType tryMergeMemoized(
+      SegmentedGroup* a,
+      SegmentedGroup* b = nullptr);
+
   void buildInitialSegments();
 
   // Replicate upcast ops when consumed by multiple expressions. This
@@ -577,6 +610,26 @@ class SegmentCandidateFinder {
   // Revert privatized upcast ops when not necessary
   void revertPrivatizedUpcast(SegmentedGroup* group);
 
+  // With EnableOption::RecomputeProducers, replicate the subgraphs of cheap
+  // pointwise producers, e.g., casts and broadcasts, whose output is consumed
+  // by multiple expressions, so that each segment can recompute the output
+  // from the inputs of the subgraph instead of reading it from global memory.
+  // Like privatizeUpcast, the subgraphs are only replicated if reading their
+  // inputs takes no more bytes than reading the output, and replicas that
+  // end up in the same segment as the original are reverted.
+  void recomputeCheapProducers();
+
+  // Revert recomputed producer subgraphs that are in the same segment as
+  // their original subgraph
+  void revertRecomputedProducers(SegmentedGroup* group);
+
+  // Redirect the single use of val_to_replace, a replica produced in group,
+  // to val_to_keep, and update the consumer edges of group accordingly
+  void replacePrivatizedVal(
+      SegmentedGroup* group,
+      Val* val_to_replace,
+      Val* val_to_keep);
+
   //! Find a group found in candidates that can be merged with the
   //! given group and set them to be merged if found. When no
   //! candidate is given, SegmentedGroup::getMergeCandidates is used
@@ -627,6 +680,23 @@ class SegmentCandidateFinder {
   //!   produces the consumer.
   void finalMerge();
 
+  //! With EnableOption::HorizontalFusion, merge pairs of independent groups,
+  //!  i.e., neither of which produces the other, that have the same
+  //!  pointwise or reduction scheduler and that this scheduler can still
+  //!  schedule together, e.g., the updates of several parameters of the same
+  //!  shape. This launches one kernel instead of one kernel per group.
+  //!  Merging independent groups can't create a cycle. With
+  //!  EnableOption::CostModel, merges predicted to be slower are skipped.
+  void horizontalMerge();
+
+  //! Moves the view ops at the end of a kernel group, e.g. a reshape or a
+  //!  permute, into a group of their own if the tensor they view is written
+  //!  by the kernel or read from global memory anyway. The merges may have
+  //!  left the kernel writing both the tensor and its view, where the view
+  //!  group evaluates the view from the tensor as metadata only, with
+  //!  ExprEvalExecutor.
+  void splitViewTails();
+
   //! Duplicate and add all exprs producing the used
   //!  scalar values in group
   void resolveScalarsInGroup(SegmentedGroup* group);
@@ -717,6 +787,26 @@ class SegmentCandidateFinder {
 
   std::unique_ptr<SegmenterAnalysis> group_dependency_;
 
+  //! Hash of the sorted expressions of a candidate segment
+  struct ExprsHash {
+    size_t operator()(const std::vector<Expr*>& exprs) const {
+      size_t hash = 0;
+      for (Expr* expr : exprs) {
+        hashCombine(hash, std::hash<Expr*>()(expr));
+      }
+      return hash;
+    }
+  };
+
+  //! Scheduler types proposed for candidate segments, keyed by their sorted
+  //! expressions. The segment narrowed by FusionSegmentGuard only depends on
+  //! its expressions, so a pair of groups that is tested again, e.g., by each
+  //! iteration of finalMerge, or a merged group whose scheduler type is
+  //! derived after testing the merge, doesn't run the schedulers' checks
+  //! again. Cleared whenever the complete fusion is modified.
+  std::unordered_map<std::vector<Expr*>, SchedulerType, ExprsHash>
+      merge_results_;
+
   //! List of vals to treat as complete fusion inputs for segmentation
   std::vector<Val*> forwarded_fusion_inputs_;
 
@@ -734,6 +824,18 @@ class SegmentCandidateFinder {
   std::unordered_map<UnaryOp*, std::unordered_set<UnaryOp*>>
       privatized_upcast_ops_;
 
+  //! A tensor replicated by recomputeCheapProducers, the expressions of its
+  //! original subgraph and, for each replica, the replicated tensor and its
+  //! expressions
+  struct RecomputedProducer {
+    TensorView* original_tv = nullptr;
+    std::vector<Expr*> original_exprs;
+    std::vector<std::pair<TensorView*, std::vector<Expr*>>> recomputations;
+  };
+
+  //! Ordered by the first consumer that recomputes each tensor
+  std::vector<RecomputedProducer> recomputed_producers_;
+
   //! Note:
   //!  Segmenter should eventually rely only on runtime_info_ for
   //!  safe caching. runtime_inputs_ is only used in translateWelford
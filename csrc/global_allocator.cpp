@@ -10,18 +10,36 @@
 #include <global_allocator.h>
 #include <options.h>
 #include <type.h>
+#include <utils.h>
 
 #include <ATen/ATen.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <unordered_map>
+#include <utility>
 
 namespace nvfuser {
 
 namespace {
 
-// For each device, we maintain an arena tensor which we will slice to provide
-// individual tensors. These tensors will grow in size and remain at the
-// high-water mark for their particular device until the thread terminates.
+// Arenas larger than this are not grown. Requests that don't fit are served by
+// a fresh at::zeros allocation instead.
+constexpr int64_t max_arena_bytes = 64LL * 1024 * 1024;
+
+// For each device and stream, we maintain an arena tensor which we will slice
+// to provide individual tensors. These tensors will grow in size and remain at
+// the high-water mark until released or the thread terminates.
+//
+// The arena stays allocated between kernel launches. Kernels that use its
+// memory restore zeros on exit, so consecutive launches on the same stream
+// can use it without another memset. Memory handed out for buffers that are
+// not restored to zero is cleared by an asynchronous memset on the arena's
+// stream when the arena is reset.
 class Arena {
  public:
+  explicit Arena(c10::cuda::CUDAStream stream) : stream_(stream) {}
+
   // Mark allocated_bytes_ as 0, allowing all available zeroed memory to be
   // reused on subsequent calls to getTensor().
   void reset() {
@@ -29,14 +47,22 @@ class Arena {
       debug() << "[global zeroed memory] Resetting allocated bytes to 0"
               << std::endl;
     }
+    if (dirty_bytes_ > 0) {
+      c10::cuda::CUDAStreamGuard stream_guard(stream_);
+      tensor_.narrow(0, 0, dirty_bytes_).zero_();
+      dirty_bytes_ = 0;
+    }
     allocated_bytes_ = 0;
-    tensor_.reset();
   }
 
+  // Returns a zeroed tensor, or an undefined tensor if the arena would exceed
+  // max_arena_bytes. If resets_to_zero is false, the memory is cleared on the
+  // next reset().
   at::Tensor getTensor(
       const std::vector<int64_t>& sizes,
       const c10::ScalarType& aten_dtype,
-      const c10::Device& device) {
+      const c10::Device& device,
+      bool resets_to_zero) {
     // determine number of bytes needed for this tensor
     int64_t new_bytes = dataTypeSizeByte(aten_to_data_type(aten_dtype));
     for (auto sz : sizes) {
@@ -48,20 +74,28 @@ class Arena {
 
     // after this function returns this will be the allocated size
     int64_t new_allocated_bytes = aligned_allocated_bytes + new_bytes;
+    if (new_allocated_bytes > max_arena_bytes) {
+      return at::Tensor();
+    }
 
     // resize tensor_ if needed. Minimum size is 128B.
     int64_t new_used_bytes = std::max((int64_t)128LL, tensor_.numel());
     while (new_used_bytes < new_allocated_bytes) {
       new_used_bytes *= 2;
     }
+    new_used_bytes = std::min(new_used_bytes, max_arena_bytes);
     if (new_used_bytes > tensor_.numel()) {
       if (isDebugDumpEnabled(DebugDumpOption::GlobalZeroedMemory)) {
         debug() << "[global zeroed memory] Resizing arena to " << new_used_bytes
                 << " bytes" << std::endl;
       }
+      // Tensors sliced from the previous arena keep it alive until they are
+      // released, so only the new arena needs to be zeroed.
+      c10::cuda::CUDAStreamGuard stream_guard(stream_);
       tensor_ = at::zeros(
           {new_used_bytes},
           at::TensorOptions().dtype(at::kByte).device(device));
+      dirty_bytes_ = 0;
     }
 
     if (isDebugDumpEnabled(DebugDumpOption::GlobalZeroedMemory)) {
@@ -77,6 +111,9 @@ class Arena {
 #endif
 
     allocated_bytes_ = new_allocated_bytes;
+    if (!resets_to_zero) {
+      dirty_bytes_ = std::max(dirty_bytes_, new_allocated_bytes);
+    }
 
     // slice and view tensor
     return tensor_
@@ -88,6 +125,7 @@ class Arena {
 
  private:
   void checkZeroed() const {
+    c10::cuda::CUDAStreamGuard stream_guard(stream_);
     c10::Scalar nnz = at::count_nonzero(tensor_).item();
     NVF_ERROR(
         nnz.equal(0),
@@ -97,39 +135,66 @@ class Arena {
   }
 
  private:
+  c10::cuda::CUDAStream stream_;
   at::Tensor tensor_;
   int64_t allocated_bytes_ = 0;
+  // Prefix of tensor_ that may be non-zero after the kernels using it finish
+  int64_t dirty_bytes_ = 0;
+};
+
+struct ArenaKeyHash {
+  size_t operator()(const std::pair<int8_t, c10::StreamId>& key) const {
+    size_t hash = std::hash<int8_t>()(key.first);
+    hashCombine(hash, std::hash<c10::StreamId>()(key.second));
+    return hash;
+  }
 };
 
-// We hold one Arena for each device
-thread_local std::vector<Arena> arenas;
+// We hold one Arena for each device and stream. Arenas are thread local, so
+// threads launching on the same stream never hand out the same memory to two
+// kernels in flight.
+thread_local std::
+    unordered_map<std::pair<int8_t, c10::StreamId>, Arena, ArenaKeyHash>
+        arenas;
+
+Arena& getArena(const c10::Device& device) {
+  c10::cuda::CUDAStream stream =
+      c10::cuda::getCurrentCUDAStream(device.index());
+  return arenas
+      .try_emplace(std::make_pair((int8_t)device.index(), stream.id()), stream)
+      .first->second;
+}
 
 } // namespace
 
 at::Tensor contigZeroedTensor(
     const std::vector<int64_t>& sizes,
     const c10::ScalarType& aten_dtype,
-    const c10::Device& device) {
+    const c10::Device& device,
+    bool resets_to_zero) {
   NVF_ERROR(device.is_cuda(), "contigZeroTensor requires CUDA device");
-  // Intermediate cast from int8_t to uint8_t for clarity:
-  // https://clang.llvm.org/extra/clang-tidy/checks/bugprone/signed-char-misuse.html
-  size_t device_num = (uint8_t)device.index();
 
-  // get arena from device number, resizing arenas if needed
-  if (device_num >= arenas.size()) {
-    arenas.resize(device_num + 1);
+  // request tensor from arena of the current stream
+  at::Tensor tensor =
+      getArena(device).getTensor(sizes, aten_dtype, device, resets_to_zero);
+  if (!tensor.defined()) {
+    tensor = at::zeros(
+        sizes, at::TensorOptions().dtype(aten_dtype).device(device));
   }
+  return tensor;
+}
 
-  // request tensor from arena
-  return arenas[device_num].getTensor(sizes, aten_dtype, device);
+void resetZeroedMemory(const c10::Device& device) {
+  auto it = arenas.find(std::make_pair(
+      (int8_t)device.index(),
+      c10::cuda::getCurrentCUDAStream(device.index()).id()));
+  if (it != arenas.end()) {
+    it->second.reset();
+  }
 }
 
-// Note that this does not free allocated zeroed memory, but rather it marks all
-// zeroed memory as available for re-use.
 void releaseZeroedMemory() {
-  for (Arena& a : arenas) {
-    a.reset();
-  }
+  arenas.clear();
 }
 
 } // namespace nvfuser
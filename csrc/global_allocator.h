@@ -12,16 +12,25 @@
 namespace nvfuser {
 
 //! This returns a slice of a thread local at::Tensor that contains all zeroes.
-//! Uses of this memory should always "clean up" by resetting the memory to zero
-//! at the end of the kernel.
+//! The memory is taken from an arena of the current stream on device, which
+//! stays allocated across kernel launches. Uses of this memory should always
+//! "clean up" by resetting the memory to zero at the end of the kernel. If
+//! resets_to_zero is false, the memory is instead cleared asynchronously by
+//! the next resetZeroedMemory() call on the same stream. Requests exceeding
+//! the arena size limit fall back to a new zeroed allocation.
 at::Tensor contigZeroedTensor(
     const std::vector<int64_t>& sizes,
     const c10::ScalarType& aten_dtype,
-    const c10::Device& device);
+    const c10::Device& device,
+    bool resets_to_zero = true);
 
 //! This should be called after each kernel launch to allow subsequent launches
-//! to re-use allocated memory. Note that it does not free allocated zeroed
-//! memory, but rather it marks all zeroed memory as available for re-use.
+//! on the current stream to re-use allocated memory. Note that it does not
+//! free allocated zeroed memory, but rather it marks all zeroed memory of the
+//! current stream on device as available for re-use.
+void resetZeroedMemory(const c10::Device& device);
+
+//! Frees all zeroed memory held by the calling thread.
 void releaseZeroedMemory();
 
 } // namespace nvfuser
@@ -8,16 +8,21 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#include <numeric>
+#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <ATen/EmptyTensor.h>
 #include <ATen/cuda/CUDAContext.h>
 
 #include <dynamic_transform.h>
 #include <fusion_profiler.h>
 #include <host_ir/executor.h>
 #include <host_ir/lower_to_communication.h>
+#include <host_ir/memory_plan.h>
 #include <host_ir/pass/convert_op_to_communication.h>
 #include <instrumentation.h>
 #include <ir/iostream.h>
@@ -26,10 +31,13 @@
 #include <multidevice/cuda_p2p.h>
 #include <multidevice/utils.h>
 #include <options.h>
+#include <remarks.h>
 #include <runtime/allocations.h>
 #include <runtime/executor_dispatch.h>
 #include <runtime/executor_kernel_arg.h>
 #include <runtime/fusion_kernel_runtime.h>
+#include <scheduler/autotune.h>
+#include <scheduler/matmul_utils.h>
 #include <tensor_metadata.h>
 
 namespace nvfuser {
@@ -82,6 +90,10 @@ void HostIrExecutor::compile(Fusion* fusion) {
     }
   }
 
+  output_alias_to_input_ =
+      executor_utils::getOutputAliasToInputMap(host_ir_container_.get());
+  output_infos_.clear();
+
   if (isProfilerEnabled()) {
     FusionProfiler::segment(group_id_).stopCompile();
   }
@@ -105,6 +117,75 @@ void validateTensors(
     }
   }
 }
+
+// Whether to time the communications. Host programs run outside of a
+// FusionExecutorCache, e.g., by a MultiDeviceExecutor, aren't profiled.
+bool isProfilingCommunications() {
+  return isProfilerEnabled() &&
+      FusionProfiler::state() == ProfilerState::Running;
+}
+
+int64_t bytesOf(const at::Tensor& tensor) {
+  return tensor.defined() ? tensor.numel() * tensor.element_size() : 0;
+}
+
+// Describes a communication for FusionProfiler::startCommunication. As in
+// nccl-tests, the size of a communication is that of its largest buffer.
+CommunicationProfile profileCommunication(
+    Communication* communication,
+    const at::Tensor& input,
+    const at::Tensor& output,
+    int64_t segment_id,
+    int64_t device) {
+  const int64_t team_size = communication->team_size();
+  const double ring_factor =
+      static_cast<double>(team_size - 1) / static_cast<double>(team_size);
+
+  CommunicationProfile prof;
+  std::stringstream ss;
+  ss << communication->type();
+  prof.name = ss.str();
+  prof.segment_id = segment_id;
+  prof.device = static_cast<int>(device);
+  prof.team_size = team_size;
+  switch (communication->type()) {
+    case CommunicationType::Allgather:
+    case CommunicationType::Gather:
+      prof.bytes = bytesOf(input) * team_size;
+      prof.bus_factor = ring_factor;
+      break;
+    case CommunicationType::ReduceScatter:
+    case CommunicationType::Scatter:
+      prof.bytes = bytesOf(output) * team_size;
+      prof.bus_factor = ring_factor;
+      break;
+    case CommunicationType::Allreduce:
+      prof.bytes = bytesOf(input);
+      prof.bus_factor = 2 * ring_factor;
+      break;
+    case CommunicationType::AllToAll:
+      prof.bytes = bytesOf(input);
+      prof.bus_factor = ring_factor;
+      break;
+    default:
+      prof.bytes = std::max(bytesOf(input), bytesOf(output));
+      prof.bus_factor = 1.0;
+  }
+  return prof;
+}
+
+CommunicationProfile profileCommunication(
+    P2PCommunication* communication,
+    const at::Tensor& buffer,
+    int64_t device) {
+  CommunicationProfile prof;
+  prof.name = communication->type() == P2PCommunicationType::SEND ? "Send"
+                                                                   : "Recv";
+  prof.device = static_cast<int>(device);
+  prof.team_size = 2;
+  prof.bytes = bytesOf(buffer);
+  return prof;
+}
 } // namespace
 
 KernelArgumentHolder HostIrExecutor::run(
@@ -126,14 +207,29 @@ KernelArgumentHolder HostIrExecutor::run(
   auto expr_eval = executor_utils::bindInputs(args, host_ir_container_.get());
 
   if (output_args.empty()) {
-    std::vector<GlobalBufferInfo> output_infos = getBufferInfos(
-        expr_eval, PrimDataType::Int, host_ir_container_->outputs());
-    auto output_alias_to_input =
-        executor_utils::getOutputAliasToInputMap(host_ir_container_.get());
+    // Inputs with the same cache id share the output shapes
+    std::shared_ptr<const std::vector<GlobalBufferInfo>> output_infos;
+    if (args.getCacheId().has_value()) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto& cached_output_infos = output_infos_[*args.getCacheId()];
+      if (cached_output_infos == nullptr) {
+        cached_output_infos =
+            std::make_shared<const std::vector<GlobalBufferInfo>>(
+                getBufferInfos(
+                    expr_eval,
+                    PrimDataType::Int,
+                    host_ir_container_->outputs()));
+      }
+      output_infos = cached_output_infos;
+    } else {
+      output_infos = std::make_shared<const std::vector<GlobalBufferInfo>>(
+          getBufferInfos(
+              expr_eval, PrimDataType::Int, host_ir_container_->outputs()));
+    }
     output_args = allocateOutputs(
         host_ir_container_.get(),
-        output_infos,
-        output_alias_to_input,
+        *output_infos,
+        output_alias_to_input_,
         c10::Device(c10::DeviceType::CUDA, args.getDeviceIndex()),
         args,
         true);
@@ -160,14 +256,24 @@ KernelArgumentHolder HostIrExecutor::run(
 
     // Inputs are already validated in bindInputs.
     validateTensors({out_tensor}, {communication->out()}, expr_eval);
+    std::optional<size_t> profile_id;
+    if (isProfilingCommunications()) {
+      profile_id = FusionProfiler::startCommunication(profileCommunication(
+          communication,
+          in_tensor,
+          out_tensor,
+          group_id_,
+          args.getDeviceIndex()));
+    }
     c10::intrusive_ptr<c10d::Work> work = postSingleCommunication(
         communication,
         communicator_->deviceId(),
         backend,
         in_tensor,
         out_tensor);
-    if (work != nullptr) {
-      work->wait();
+    waitOnCurrentStream(work);
+    if (profile_id.has_value()) {
+      FusionProfiler::stopCommunication(*profile_id);
     }
   }
 
@@ -209,17 +315,75 @@ HostIrEvaluator::HostIrEvaluator(
   if (isDebugDumpEnabled(DebugDumpOption::HostIr) && device_index == 0) {
     container_->print(debug());
   }
-  streams_.insert(
-      {container_->getDefaultStream(),
-       c10::cuda::getDefaultCUDAStream(
-           static_cast<c10::DeviceIndex>(device_index))});
+
+  // The buffers that kCuda communications export over IPC
+  std::unordered_set<Val*> exported_buffers;
+  for (Expr* expr : container_->unordered_exprs()) {
+    if (auto* communication = dynamic_cast<Communication*>(expr)) {
+      if (communication->backend() == CommunicatorBackend::kCuda) {
+        exported_buffers.insert(communication->in());
+      }
+    } else if (auto* p2p = dynamic_cast<P2PCommunication*>(expr)) {
+      if (p2p->backend() == CommunicatorBackend::kCuda) {
+        exported_buffers.insert(p2p->buffer());
+      }
+    }
+  }
+
+  if (isOptionEnabled(EnableOption::SymmetricMemory)) {
+    // Buffers allocated in a loop body may be in use on another stream when
+    // they are allocated again, so only top-level allocations are kept.
+    for (Expr* expr : container_->topLevelExprs()) {
+      auto* allocate = dynamic_cast<kir::Allocate*>(expr);
+      if (allocate != nullptr && exported_buffers.count(allocate->buffer())) {
+        symmetric_tvs_.insert(allocate->buffer()->as<TensorView>());
+      }
+    }
+  }
+
+  if (isOptionEnabled(EnableOption::HostIrMemoryPlan)) {
+    // IPC handles are per allocation, so exported buffers can't be carved
+    // out of the workspace
+    buffer_lifetimes_ =
+        computeBufferLifetimes(container_.get(), exported_buffers);
+    for (auto&& [i, lifetime] : enumerate(buffer_lifetimes_)) {
+      planned_buffers_.emplace(lifetime.tv, i);
+    }
+    observed_bytes_.assign(buffer_lifetimes_.size(), 0);
+  }
+
+  if (autotune::isEnabled() &&
+      std::any_of(
+          container_->vals().begin(),
+          container_->vals().end(),
+          [](Val* val) {
+            auto* named_scalar = dynamic_cast<NamedScalar*>(val);
+            return named_scalar != nullptr &&
+                named_scalar->name() == "numberOfStreams";
+          })) {
+    const auto* prop = at::cuda::getCurrentDeviceProperties();
+    std::stringstream ss;
+    ss << "host program\nsm_" << prop->major << prop->minor << "\n"
+       << (communicator_ != nullptr && communicator_->is_available()
+               ? communicator_->size()
+               : 1)
+       << " devices\n";
+    container_->print(ss);
+    stream_tuning_prefix_ = ss.str();
+  }
+}
+
+HostIrEvaluator::~HostIrEvaluator() {
+  for (cudaEvent_t event : tape_events_) {
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(event));
+  }
 }
 
 KernelArgumentHolder HostIrEvaluator::runWithInputs(
     const KernelArgumentHolder& args) {
   FUSER_PERF_SCOPE("HostIrEvaluator::runWithInputs");
+  bindDefaultStream();
   expr_evaluator_ = ExpressionEvaluator();
-  expr_evaluator_.bind("numberOfStreams", params_.number_of_streams);
   NVF_ERROR(args.getCacheId().has_value());
   expr_evaluator_.bind("cacheId", static_cast<int64_t>(*args.getCacheId()));
 
@@ -227,12 +391,31 @@ KernelArgumentHolder HostIrEvaluator::runWithInputs(
   for (auto&& [in_val, arg] : zip(container_->inputs(), args)) {
     expr_evaluator_.bind(in_val, arg);
   }
+  StreamTuning* stream_tuning = bindNumberOfStreams();
+  std::optional<CudaEventTimer> run_timer;
+  if (stream_tuning != nullptr) {
+    run_timer.emplace(c10::cuda::getCurrentCUDAStream());
+    run_timer->start();
+  }
+
+  if (isOptionEnabled(EnableOption::HostIrTape)) {
+    runTape();
+  } else {
+    for (Expr* e : container_->topLevelExprs()) {
+      const std::string event_name =
+          std::string("HostIrEvaluator::dispatch ") + e->getOpString();
+      FUSER_PERF_SCOPE(event_name.c_str());
+      dispatch(e);
+    }
+  }
 
-  for (Expr* e : container_->topLevelExprs()) {
-    const std::string event_name =
-        std::string("HostIrEvaluator::dispatch ") + e->getOpString();
-    FUSER_PERF_SCOPE(event_name.c_str());
-    dispatch(e);
+  if (!buffer_lifetimes_.empty()) {
+    updateMemoryPlan();
+  }
+
+  if (stream_tuning != nullptr) {
+    run_timer->stop();
+    recordStreamTuningRun(*stream_tuning, run_timer->time());
   }
 
   KernelArgumentHolder outs;
@@ -245,18 +428,37 @@ KernelArgumentHolder HostIrEvaluator::runWithInputs(
 
 KernelArgumentHolder HostIrEvaluator::runWithInput(
     const std::unordered_map<Val*, PolymorphicValue>& val_to_PValue) {
+  bindDefaultStream();
   expr_evaluator_ = ExpressionEvaluator();
-  expr_evaluator_.bind("numberOfStreams", params_.number_of_streams);
   expr_evaluator_.bind("rank", communicator_->deviceId());
   // process input values, converting IValue to PolymorphicValue
   for (const auto& [val, pvalue] : val_to_PValue) {
     expr_evaluator_.bind(val, pvalue);
   }
+  StreamTuning* stream_tuning = bindNumberOfStreams();
+  std::optional<CudaEventTimer> run_timer;
+  if (stream_tuning != nullptr) {
+    run_timer.emplace(c10::cuda::getCurrentCUDAStream());
+    run_timer->start();
+  }
 
-  // Interpret each instruction in an "eager" way by iterate over the Host Ir
-  // Container's top level expression list
-  for (auto expr : container_->topLevelExprs()) {
-    dispatch(expr);
+  if (isOptionEnabled(EnableOption::HostIrTape)) {
+    runTape();
+  } else {
+    // Interpret each instruction in an "eager" way by iterate over the Host Ir
+    // Container's top level expression list
+    for (auto expr : container_->topLevelExprs()) {
+      dispatch(expr);
+    }
+  }
+
+  if (!buffer_lifetimes_.empty()) {
+    updateMemoryPlan();
+  }
+
+  if (stream_tuning != nullptr) {
+    run_timer->stop();
+    recordStreamTuningRun(*stream_tuning, run_timer->time());
   }
 
   // Collect global outputs
@@ -321,42 +523,192 @@ c10::cuda::CUDAStream HostIrEvaluator::getCUDAStream(Stream* stream) {
   return streams_.at(stream_key);
 }
 
+void HostIrEvaluator::bindDefaultStream() {
+  // Like the stream captured by GetCurrentStream, it may differ from one run
+  // to the next
+  streams_.insert_or_assign(
+      container_->getDefaultStream(),
+      c10::cuda::getCurrentCUDAStream(
+          static_cast<c10::DeviceIndex>(my_local_device_index_)));
+}
+
+bool HostIrEvaluator::isStaticStream(Stream* stream) const {
+  if (stream->index() != nullptr ||
+      stream == container_->getDefaultStream()) {
+    return false;
+  }
+  // The stream captured by GetCurrentStream is only known when the
+  // expression runs
+  return std::none_of(
+      container_->unordered_exprs().begin(),
+      container_->unordered_exprs().end(),
+      [stream](Expr* expr) {
+        auto* get_current_stream = dynamic_cast<GetCurrentStream*>(expr);
+        return get_current_stream != nullptr &&
+            get_current_stream->stream() == stream;
+      });
+}
+
+void HostIrEvaluator::compileTape() {
+  FUSER_PERF_SCOPE("HostIrEvaluator::compileTape");
+  std::vector<Instruction> tape;
+  tape.reserve(container_->topLevelExprs().size());
+  for (Expr* expr : container_->topLevelExprs()) {
+    Instruction instruction{
+        expr,
+        std::string("HostIrEvaluator::dispatch ") + expr->getOpString(),
+        nullptr};
+
+    if (auto* launch_kernel = dynamic_cast<LaunchKernel*>(expr)) {
+      KernelExecutor* ke =
+          container_->getKernelExecutor(launch_kernel->groupId());
+      std::vector<PolymorphicValue> constant_inputs;
+      if (std::any_of(
+              launch_kernel->inputs().begin(),
+              launch_kernel->inputs().end(),
+              [](Val* input) { return input->isConstScalar(); })) {
+        for (Val* input : launch_kernel->inputs()) {
+          constant_inputs.push_back(
+              input->isConstScalar() ? input->evaluate() : PolymorphicValue());
+        }
+      }
+      instruction.run = [this, launch_kernel, ke, constant_inputs]() {
+        launchKernel(launch_kernel, ke, constant_inputs);
+      };
+    } else if (auto* set_current_stream =
+                   dynamic_cast<SetCurrentStream*>(expr)) {
+      if (isStaticStream(set_current_stream->stream())) {
+        c10::cuda::CUDAStream stream =
+            getCUDAStream(set_current_stream->stream());
+        instruction.run = [stream]() { setCurrentCUDAStream(stream); };
+      }
+    } else if (auto* synchronize = dynamic_cast<Synchronize*>(expr)) {
+      cudaEvent_t event = {};
+      NVFUSER_CUDA_RT_SAFE_CALL(
+          cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+      tape_events_.push_back(event);
+      if (isStaticStream(synchronize->stream())) {
+        cudaStream_t stream = getCUDAStream(synchronize->stream()).stream();
+        instruction.run = [this, stream, event]() {
+          synchronizeStream(stream, event);
+        };
+      } else {
+        instruction.run = [this, synchronize, event]() {
+          synchronizeStream(
+              getCUDAStream(synchronize->stream()).stream(), event);
+        };
+      }
+    }
+    tape.push_back(std::move(instruction));
+  }
+  tape_ = std::move(tape);
+}
+
+void HostIrEvaluator::runTape() {
+  if (!tape_.has_value()) {
+    compileTape();
+  }
+  for (const Instruction& instruction : *tape_) {
+    FUSER_PERF_SCOPE(instruction.event_name.c_str());
+    if (instruction.run) {
+      instruction.run();
+    } else {
+      dispatch(instruction.expr);
+    }
+  }
+}
+
+void HostIrEvaluator::warmUpBackends() {
+  NVF_ERROR(
+      communicator_ != nullptr && communicator_->is_available(),
+      "A valid communicator must be provided");
+  warmUpBackends(container_->topLevelExprs());
+}
+
+void HostIrEvaluator::warmUpBackends(const std::vector<Expr*>& exprs) {
+  // P2P communications and coalescing groups run on the world backend
+  auto warm_up_world = [this](std::optional<CommunicatorBackend> backend) {
+    std::vector<DeviceIdxType> all_devices(communicator_->size());
+    std::iota(all_devices.begin(), all_devices.end(), 0);
+    communicator_->warmUpBackendForTeam(all_devices, backend);
+  };
+  for (Expr* expr : exprs) {
+    if (auto* for_loop = dynamic_cast<ForLoop*>(expr)) {
+      warmUpBackends(for_loop->body().exprs());
+    } else if (auto* ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+      warmUpBackends(ite->thenBody().exprs());
+      warmUpBackends(ite->elseBody().exprs());
+    } else if (auto* communication = dynamic_cast<Communication*>(expr)) {
+      if (communication->backend() != CommunicatorBackend::kCuda) {
+        communicator_->warmUpBackendForTeam(
+            communication->team(), communication->backend());
+      }
+    } else if (auto* communication = dynamic_cast<P2PCommunication*>(expr)) {
+      if (communication->backend() != CommunicatorBackend::kCuda) {
+        warm_up_world(communication->backend());
+      }
+    } else if (expr->isA<StartCoalescing>()) {
+      warm_up_world(std::nullopt);
+    }
+  }
+}
+
 void HostIrEvaluator::handle(SetCurrentStream* set_current_stream) {
   setCurrentCUDAStream(getCUDAStream(set_current_stream->stream()));
 }
 
 void HostIrEvaluator::handle(GetCurrentStream* get_current_stream) {
-  streams_.insert(
-      {get_current_stream->stream(),
-       c10::cuda::getCurrentCUDAStream(
-           static_cast<c10::DeviceIndex>(my_local_device_index_))});
+  // The current stream may differ from one run to the next
+  streams_.insert_or_assign(
+      get_current_stream->stream(),
+      c10::cuda::getCurrentCUDAStream(
+          static_cast<c10::DeviceIndex>(my_local_device_index_)));
 }
 
-void HostIrEvaluator::handle(Synchronize* synchronize) {
+void HostIrEvaluator::synchronizeStream(
+    cudaStream_t stream_to_sync,
+    cudaEvent_t event) {
   cudaStream_t current_stream =
       c10::cuda::getCurrentCUDAStream(
           static_cast<c10::DeviceIndex>(my_local_device_index_))
           .stream();
-  cudaStream_t stream_to_sync = getCUDAStream(synchronize->stream()).stream();
 
-  cudaEvent_t event = {};
-  NVFUSER_CUDA_RT_SAFE_CALL(
-      cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  const bool owns_event = event == nullptr;
+  if (owns_event) {
+    NVFUSER_CUDA_RT_SAFE_CALL(
+        cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  }
   NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(event, stream_to_sync));
   NVFUSER_CUDA_RT_SAFE_CALL(
       cudaStreamWaitEvent(current_stream, event, cudaEventWaitDefault));
-  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(event));
+  if (owns_event) {
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(event));
+  }
+}
+
+void HostIrEvaluator::handle(Synchronize* synchronize) {
+  synchronizeStream(getCUDAStream(synchronize->stream()).stream());
 }
 
 void HostIrEvaluator::handle(LaunchKernel* launch_kernel) {
+  launchKernel(
+      launch_kernel,
+      container_->getKernelExecutor(launch_kernel->groupId()),
+      /*constant_inputs=*/{});
+}
+
+void HostIrEvaluator::launchKernel(
+    LaunchKernel* launch_kernel,
+    KernelExecutor* ke,
+    const std::vector<PolymorphicValue>& constant_inputs) {
   KernelArgumentHolder args;
-  PolymorphicValue cache_id =
-      expr_evaluator_.evaluate(launch_kernel->cacheId());
-  if (!cache_id.is<std::monostate>()) {
-    args.setCacheId(static_cast<size_t>(cache_id.as<int64_t>()));
-  }
-  for (auto& input : launch_kernel->inputs()) {
-    args.push(getKnownConcreteValue(input));
+  args.reserve(launch_kernel->inputs().size());
+  for (auto i : arange(launch_kernel->inputs().size())) {
+    if (!constant_inputs.empty() && constant_inputs[i].hasValue()) {
+      args.push(constant_inputs[i]);
+    } else {
+      args.push(getKnownConcreteValue(launch_kernel->input(i)));
+    }
   }
 
   // All output buffers are known already, pass them to the executor
@@ -373,14 +725,96 @@ void HostIrEvaluator::handle(LaunchKernel* launch_kernel) {
       "Not all outputs to the kernel were preallocated");
 
   args.setDeviceIndex();
+  setInputsId(ke, args);
 
   // run the compiled kernel
-  container_->getKernelExecutor(launch_kernel->groupId())
-      ->run(
-          args,
-          outputs,
-          launch_kernel->launchParams(),
-          launch_kernel->compileParams());
+  ke->run(
+      args,
+      outputs,
+      launch_kernel->launchParams(),
+      launch_kernel->compileParams());
+}
+
+HostIrEvaluator::StreamTuning* HostIrEvaluator::bindNumberOfStreams() {
+  if (stream_tuning_prefix_.empty()) {
+    expr_evaluator_.bind("numberOfStreams", params_.number_of_streams);
+    return nullptr;
+  }
+
+  std::stringstream key;
+  key << stream_tuning_prefix_;
+  for (Val* input : container_->inputs()) {
+    if (!input->isA<TensorView>() || !expr_evaluator_.isKnown(input)) {
+      continue;
+    }
+    key << "\n";
+    for (int64_t size : getKnownConcreteValue(input).as<at::Tensor>().sizes()) {
+      key << " " << autotune::shapeBucket(size);
+    }
+  }
+  auto [it, inserted] = stream_tunings_.try_emplace(key.str());
+  StreamTuning& tuning = it->second;
+  if (inserted) {
+    tuning.key = it->first;
+    tuning.number_of_streams = autotune::queryTunedNumberOfStreams(tuning.key);
+    // The default goes first, so that it is used for the untimed first run
+    constexpr int64_t max_number_of_streams = 16;
+    tuning.candidates.push_back(params_.number_of_streams);
+    for (int64_t n = 1; n <= max_number_of_streams &&
+         std::ssize(tuning.candidates) < autotune::maxCandidates();
+         n *= 2) {
+      if (n != params_.number_of_streams) {
+        tuning.candidates.push_back(n);
+      }
+    }
+    tuning.times_ms.assign(
+        tuning.candidates.size(), std::numeric_limits<double>::infinity());
+  }
+
+  if (tuning.number_of_streams.has_value()) {
+    expr_evaluator_.bind("numberOfStreams", *tuning.number_of_streams);
+    return nullptr;
+  }
+  // The first run compiles the kernels, so it isn't timed. The candidates are
+  // then timed in turn, so that a slow run is not always that of the same one.
+  const bool timed = tuning.num_runs > 0;
+  tuning.candidate =
+      timed ? (tuning.num_runs - 1) % std::ssize(tuning.candidates) : 0;
+  tuning.num_runs++;
+  expr_evaluator_.bind(
+      "numberOfStreams", tuning.candidates.at(tuning.candidate));
+  return timed ? &tuning : nullptr;
+}
+
+void HostIrEvaluator::recordStreamTuningRun(
+    StreamTuning& tuning,
+    double time_ms) {
+  constexpr int64_t num_rounds = 3;
+  double& best_time_ms = tuning.times_ms.at(tuning.candidate);
+  best_time_ms = std::min(best_time_ms, time_ms);
+  if (tuning.num_runs < 1 + num_rounds * std::ssize(tuning.candidates)) {
+    return;
+  }
+  // Each rank tunes its own number of streams. It doesn't change the order in
+  // which the communications are posted, so the ranks need not agree.
+  const auto fastest =
+      std::min_element(tuning.times_ms.begin(), tuning.times_ms.end()) -
+      tuning.times_ms.begin();
+  tuning.number_of_streams = tuning.candidates.at(fastest);
+  autotune::recordTunedNumberOfStreams(tuning.key, *tuning.number_of_streams);
+}
+
+void HostIrEvaluator::setInputsId(
+    ExecutorAbstract* executor,
+    KernelArgumentHolder& args) {
+  InputsIdLookup::IdLookupReturn id_lookup_ret =
+      inputs_id_lookups_[executor].lookupId(args);
+  if (id_lookup_ret.eviction) {
+    if (auto* ke = dynamic_cast<KernelExecutor*>(executor)) {
+      ke->evictCache(id_lookup_ret.evict_id);
+    }
+  }
+  args.setCacheId(id_lookup_ret.id);
 }
 
 void HostIrEvaluator::handle(PostOnStream* post_ir) {
@@ -420,9 +854,14 @@ void HostIrEvaluator::handle(PostOnStream* post_ir) {
   // Check if the executor has been cached. If not, create and cache it
   if (params_.use_fusion_executor_cache) {
     if (!fec_.count(hu)) {
+      auto fusion = std::make_unique<Fusion>(*hu->fusion_to_execute());
+      if (params_.num_communication_sms > 0) {
+        fusion->manage(
+            matmul_utils::kReservedSMsKey, params_.num_communication_sms);
+      }
       fec_.try_emplace(
           hu,
-          std::make_unique<Fusion>(*hu->fusion_to_execute()),
+          std::move(fusion),
           /*fusion_id=*/0,
           !params_.skip_auto_scheduling);
     }
@@ -462,6 +901,7 @@ void HostIrEvaluator::handle(PostOnStream* post_ir) {
       }
     }
     ExecutorAbstract* ea = executors_[hu].get();
+    setInputsId(ea, input_args);
     if (use_preallocated_outputs) {
       ExecutorDispatch::run(ea, input_args, outputs);
     } else {
@@ -492,14 +932,62 @@ void HostIrEvaluator::handle(Communication* communication) {
       getKnownTensorOrUndefined(communication->output(0));
 
   CommunicatorBackend backend_type = communication->backend();
-  c10d::Backend* backend =
-      communicator_->getBackendForTeam(communication->team(), backend_type);
-
   validateTensors(
       {input_tensor, output_tensor},
       {communication->in(), communication->out()},
       expr_evaluator_);
+  if (isProfilingCommunications()) {
+    startCommunicationProfile(
+        communication,
+        profileCommunication(
+            communication,
+            input_tensor,
+            output_tensor,
+            /*segment_id=*/-1,
+            my_local_device_index_));
+  }
+
+  if (backend_type == CommunicatorBackend::kCuda) {
+    CollectiveIpcHandle& handle =
+        ipc_handle_cache_.getOrExchange(communication, input_tensor);
+    switch (communication->type()) {
+      case CommunicationType::Allgather:
+        ipc_collective::allgather(handle, input_tensor, output_tensor);
+        break;
+      case CommunicationType::ReduceScatter:
+        ipc_collective::reduceScatter(
+            handle, input_tensor, output_tensor, communication->reduceOp());
+        break;
+      case CommunicationType::Allreduce:
+        ipc_collective::allreduce(
+            handle, input_tensor, output_tensor, communication->reduceOp());
+        break;
+      default:
+        NVF_THROW(
+            "Communication type ",
+            communication->type(),
+            " is not supported by the kCuda backend");
+    }
+    // The collective is ordered on the current stream, so Wait has nothing to
+    // wait for
+    works_[communication] = nullptr;
+    return;
+  }
+
+  if (!coalescing_ &&
+      isOptionEnabled(EnableOption::HierarchicalCollectives) &&
+      canPostHierarchically(communication, communicator_)) {
+    works_[communication] = postHierarchicalCommunication(
+        communication,
+        communicator_->deviceId(),
+        communicator_,
+        input_tensor,
+        output_tensor);
+    return;
+  }
 
+  c10d::Backend* backend =
+      communicator_->getBackendForTeam(communication->team(), backend_type);
   works_[communication] = postSingleCommunication(
       communication,
       communicator_->deviceId(),
@@ -514,6 +1002,11 @@ void HostIrEvaluator::handle(P2PCommunication* communication) {
       "A valid communicator must be provided");
 
   at::Tensor buffer = getKnownTensorOrUndefined(communication->buffer());
+  if (isProfilingCommunications()) {
+    startCommunicationProfile(
+        communication,
+        profileCommunication(communication, buffer, my_local_device_index_));
+  }
 
   CommunicatorBackend backend_type = communication->backend();
   if (backend_type == CommunicatorBackend::kCuda) {
@@ -553,13 +1046,32 @@ void HostIrEvaluator::handle(Wait* wait) {
     auto i = works_.find(communication);
     NVF_ERROR(i != works_.end(), "no wait req");
 
-    auto work = i->second;
-    if (work != nullptr) {
-      work->wait();
-    }
+    // Stream-ordered, so the host can post the next communications and
+    // kernels while this one is in flight
+    waitOnCurrentStream(i->second);
 
     works_.erase(communication);
   }
+
+  if (auto i = communication_profile_ids_.find(communication);
+      i != communication_profile_ids_.end()) {
+    for (size_t id : i->second) {
+      FusionProfiler::stopCommunication(id);
+    }
+    communication_profile_ids_.erase(i);
+  }
+}
+
+void HostIrEvaluator::startCommunicationProfile(
+    Expr* communication,
+    CommunicationProfile prof) {
+  const size_t id = FusionProfiler::startCommunication(std::move(prof));
+  // A coalesced communication is waited for through its EndCoalescing
+  if (coalescing_) {
+    coalesced_profile_ids_.push_back(id);
+  } else {
+    communication_profile_ids_[communication] = {id};
+  }
 }
 
 namespace {
@@ -614,6 +1126,7 @@ void HostIrEvaluator::handle(StartCoalescing* start_coalescing) {
       backend->getBackendName() == "nccl",
       "ProcessGroupUCC does not implement coalescence");
   backend->startCoalescing();
+  coalescing_ = true;
 }
 
 void HostIrEvaluator::handle(EndCoalescing* end_coalescing) {
@@ -622,6 +1135,12 @@ void HostIrEvaluator::handle(EndCoalescing* end_coalescing) {
       backend->getBackendName() == "nccl",
       "ProcessGroupUCC does not implement coalescence");
   works_[end_coalescing] = backend->endCoalescing();
+  coalescing_ = false;
+  if (!coalesced_profile_ids_.empty()) {
+    communication_profile_ids_[end_coalescing] =
+        std::move(coalesced_profile_ids_);
+    coalesced_profile_ids_.clear();
+  }
 }
 
 void HostIrEvaluator::handle(kir::IfThenElse* if_then_else) {
@@ -733,6 +1252,43 @@ void HostIrEvaluator::handle(kir::Allocate* allocate) {
   }
   GlobalBufferInfo info =
       getBufferInfos(expr_evaluator_, PrimDataType::Int, {tv}).at(0);
+  if (auto it = planned_buffers_.find(tv); it != planned_buffers_.end()) {
+    const int64_t i = it->second;
+    const int64_t bytes = (int64_t)at::detail::computeStorageNbytes(
+        info.shape_info.logical_sizes,
+        info.shape_info.logical_strides,
+        c10::elementSize(info.type));
+    observed_bytes_.at(i) = bytes;
+    // The plan is computed after a run from the sizes seen in that run, and
+    // only used for the buffers whose size didn't change
+    if (memory_plan_.bytes.size() == observed_bytes_.size() &&
+        memory_plan_.bytes.at(i) == bytes) {
+      const int64_t offset = memory_plan_.offsets.at(i);
+      expr_evaluator_.bind(
+          tv,
+          workspace_.slice(0, offset, offset + bytes)
+              .view(info.type)
+              .as_strided(
+                  info.shape_info.logical_sizes,
+                  info.shape_info.logical_strides));
+      return;
+    }
+  }
+  if (symmetric_tvs_.count(tv) != 0) {
+    auto it = symmetric_buffers_.find(tv);
+    if (it != symmetric_buffers_.end() &&
+        it->second.sizes() == info.shape_info.logical_sizes &&
+        it->second.strides() == info.shape_info.logical_strides &&
+        it->second.scalar_type() == info.type) {
+      expr_evaluator_.bind(tv, it->second);
+      return;
+    }
+    // Every rank sees the same shapes, so they all reallocate together
+    if (it != symmetric_buffers_.end()) {
+      ipc_handle_cache_.invalidate(it->second);
+      symmetric_buffers_.erase(it);
+    }
+  }
   c10::Device device =
       communicator_ ? communicator_->device() : at::Device("cuda:0");
   auto tensor = at::native::empty_strided_cuda(
@@ -742,9 +1298,37 @@ void HostIrEvaluator::handle(kir::Allocate* allocate) {
       c10::nullopt,
       device,
       c10::nullopt);
+  if (symmetric_tvs_.count(tv) != 0) {
+    symmetric_buffers_.emplace(tv, tensor);
+  }
   expr_evaluator_.bind(tv, tensor);
 }
 
+void HostIrEvaluator::updateMemoryPlan() {
+  if (observed_bytes_ == memory_plan_.bytes) {
+    return;
+  }
+  memory_plan_ = planMemory(buffer_lifetimes_, observed_bytes_);
+  if (!workspace_.defined() ||
+      workspace_.numel() < memory_plan_.workspace_bytes) {
+    c10::Device device =
+        communicator_ ? communicator_->device() : at::Device("cuda:0");
+    workspace_ = at::empty(
+        {memory_plan_.workspace_bytes},
+        at::TensorOptions().dtype(at::kByte).device(device));
+  }
+  if (remarks::isActive()) {
+    const int64_t allocated_bytes = std::accumulate(
+        observed_bytes_.begin(), observed_bytes_.end(), (int64_t)0);
+    remarks::report(
+        "host_ir_memory_plan",
+        "planned intermediates of the host program in one workspace",
+        {{"buffers", std::to_string(buffer_lifetimes_.size())},
+         {"workspace_bytes", std::to_string(memory_plan_.workspace_bytes)},
+         {"allocated_bytes", std::to_string(allocated_bytes)}});
+  }
+}
+
 void HostIrEvaluator::handle(HirAliasSelect* hir_alias_select) {
   auto indexed_id =
       hir_alias_select->in()->getLogicalDomain().at(hir_alias_select->axis());
@@ -843,6 +1427,10 @@ void HostIrEvaluator::handle(Deallocate* deallocate) {
       expr_evaluator_.isKnown(tv),
       "Tried to free buffer associated with unknown TensorView",
       tv);
+  // Symmetric buffers and their IPC handles are kept for the next run
+  if (symmetric_tvs_.count(tv) == 0 && planned_buffers_.count(tv) == 0) {
+    ipc_handle_cache_.invalidate(getKnownConcreteValue(tv).as<at::Tensor>());
+  }
   expr_evaluator_.invalidate(tv);
 }
 
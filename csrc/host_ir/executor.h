@@ -9,17 +9,29 @@
 
 #include <dispatch.h>
 #include <expr_evaluator.h>
+#include <fusion_profiler.h>
 #include <host_ir/container.h>
 #include <host_ir/host_ir.h>
+#include <host_ir/memory_plan.h>
 #include <multidevice/communicator.h>
 #include <multidevice/ipc_handle.h>
 #include <runtime/executor.h>
 #include <runtime/executor_abstract.h>
 #include <runtime/executor_params.h>
+#include <runtime/fusion_cache_utils.h>
 #include <runtime/fusion_executor_cache.h>
 
 #include <c10/cuda/CUDAStream.h>
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace nvfuser {
 
 class HostIrExecutor : public ExecutorAbstract {
@@ -43,9 +55,26 @@ class HostIrExecutor : public ExecutorAbstract {
     return host_ir_container_;
   }
 
+  //! Drops the output buffer infos cached for cache_id
+  void evictCache(size_t cache_id) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    output_infos_.erase(cache_id);
+  }
+
  private:
   std::unique_ptr<hir::HostIrContainer> host_ir_container_;
   Communicator* communicator_;
+  //! Output aliases of host_ir_container_, computed at compile time
+  std::vector<int> output_alias_to_input_;
+  //! Shapes of the outputs keyed by input cache id. Inputs with the same cache
+  //! id have the same sizes and strides, so the outputs can be allocated
+  //! without evaluating their extents again.
+  std::unordered_map<
+      size_t,
+      std::shared_ptr<const std::vector<GlobalBufferInfo>>>
+      output_infos_;
+  //! Guards output_infos_
+  std::mutex mutex_;
 };
 
 namespace hir {
@@ -59,20 +88,24 @@ struct HostIrEvaluatorParams {
   // use_fusion_executor_cache=true. WAR: temporary hack mainly use for
   // development
   bool skip_auto_scheduling = false;
-  // Experimental: whether to cache fusion executor. WAR: avoid recompilation
-  // but implicitely assumes that the input shape don't change over iterations
-  bool cache_fusion_executor = false;
   // number of additional cuda streams to use at runtime for comm+compute
-  // pipelining
+  // pipelining. With EnableOption::Autotune, it is the first candidate of the
+  // tuning of the host programs with stream-parallel loops.
   int64_t number_of_streams = 4;
+  // Number of SMs that the matmuls compiled by FusionExecutorCache leave to
+  // the communication kernels running concurrently, e.g., the number of NCCL
+  // channels. 0 lets the matmuls use all the SMs. See MatmulParams::sm_budget.
+  int64_t num_communication_sms = 0;
 };
 
 // A HostIrEvaluator evaluates a host programs represented through a
 // HostIrContainer It is instantiated with the desired HostIrContainer, and runs
 // the Host program with concrete inputs by calling the method runWithInput.
 //
-// For now HostIrEvaluator is an interpreter; later we could rather compile host
-// code.
+// By default HostIrEvaluator is an interpreter. With EnableOption::HostIrTape,
+// the top-level expressions are compiled on the first run into a tape of
+// instructions whose kernel executors, static streams and events are resolved
+// ahead of time, see compileTape.
 //
 // Note: most of the implementation is copy pasted for MultiDeviceExecutor. This
 // duplication will be resolved in the future.
@@ -83,6 +116,8 @@ class HostIrEvaluator final : public OptOutDispatch {
       Communicator* communicator = &Communicator::getInstance(),
       HostIrEvaluatorParams = HostIrEvaluatorParams());
 
+  ~HostIrEvaluator() override;
+
   // Used by FusionExecutor, the main stack.
   KernelArgumentHolder runWithInputs(const KernelArgumentHolder& args);
 
@@ -122,8 +157,20 @@ class HostIrEvaluator final : public OptOutDispatch {
   // An empty message means that the runtime is valid
   std::string canRun() const;
 
+  // Creates the backends of all the communications of the host program, so
+  // that no rendezvous is left for the first run. Must be called by all ranks.
+  // See Communicator::warmUpBackendForTeam.
+  void warmUpBackends();
+
+  // Size of the workspace holding the planned intermediates, see
+  // EnableOption::HostIrMemoryPlan
+  int64_t workspaceBytes() const {
+    return memory_plan_.workspace_bytes;
+  }
+
  private:
   using OptOutDispatch::handle;
+  void warmUpBackends(const std::vector<Expr*>& exprs);
   void handle(SetCurrentStream* set_current_stream) override;
   void handle(GetCurrentStream* get_current_stream) override;
   void handle(Synchronize* synchronize) override;
@@ -149,6 +196,79 @@ class HostIrEvaluator final : public OptOutDispatch {
 
   c10::cuda::CUDAStream getCUDAStream(Stream* stream);
 
+  // Binds the default stream of container_ to the current stream of the
+  // caller, so that switching back to the default stream orders the rest of
+  // a run on the caller's stream rather than on the null stream.
+  void bindDefaultStream();
+
+  // Returns whether the CUDA stream of stream is the same at every run, i.e.,
+  // it is neither indexed by a runtime value, captured by GetCurrentStream,
+  // nor the default stream.
+  bool isStaticStream(Stream* stream) const;
+
+  // Runs the instructions of tape_, compiling it on the first call
+  void runTape();
+
+  // Builds tape_ from the top-level expressions of container_. LaunchKernel
+  // gets its KernelExecutor and constant scalar inputs, SetCurrentStream its
+  // static stream and Synchronize an event created once. Other expressions
+  // are dispatched as by the interpreter.
+  void compileTape();
+
+  // constant_inputs is either empty or holds the value of each constant
+  // scalar input of launch_kernel and std::monostate for the other inputs
+  void launchKernel(
+      LaunchKernel* launch_kernel,
+      KernelExecutor* ke,
+      const std::vector<PolymorphicValue>& constant_inputs);
+
+  // Sets the cache id of args to the id of their sizes, strides and
+  // alignments among the runs of executor, so that a KernelExecutor reuses its
+  // launch parameters per shape. The iterations of a stream-parallel loop, or
+  // the steps of a variable batch, share the cache id of the inputs of the
+  // container but not necessarily the shapes of their kernels' arguments.
+  void setInputsId(ExecutorAbstract* executor, KernelArgumentHolder& args);
+
+  // Replans the workspace if the sizes of the planned buffers changed in the
+  // last run, growing the workspace if needed
+  void updateMemoryPlan();
+
+  // Tuning of the number of streams for one bucket of input shapes
+  struct StreamTuning {
+    // Key of the tuning database
+    std::string key;
+    std::vector<int64_t> candidates;
+    // Fastest run of each candidate so far
+    std::vector<double> times_ms;
+    int64_t num_runs = 0;
+    // The candidate of the current run
+    int64_t candidate = 0;
+    // Set once tuned, or found in the tuning database
+    std::optional<int64_t> number_of_streams;
+  };
+
+  // Binds numberOfStreams for this run once the inputs are bound. With
+  // EnableOption::Autotune, the first runs of a host program with
+  // stream-parallel loops try candidate numbers of streams for each bucket of
+  // input shapes, i.e., of message sizes, and the following runs use the
+  // fastest. Returns the tuning this run must be timed for, if any.
+  StreamTuning* bindNumberOfStreams();
+
+  // Records the time of a run timed for tuning, and stores the fastest
+  // candidate in the tuning database once all of them have been timed
+  void recordStreamTuningRun(StreamTuning& tuning, double time_ms);
+
+  // Starts timing a communication with FusionProfiler until the Wait for it,
+  // or for its EndCoalescing
+  void startCommunicationProfile(
+      Expr* communication,
+      CommunicationProfile prof);
+
+  // Makes the current stream wait for stream_to_sync, with event if given
+  void synchronizeStream(
+      cudaStream_t stream_to_sync,
+      cudaEvent_t event = nullptr);
+
   PolymorphicValue getKnownConcreteValue(Val* val) const {
     NVF_ERROR(
         expr_evaluator_.isKnown(val),
@@ -172,11 +292,50 @@ class HostIrEvaluator final : public OptOutDispatch {
   // Cache Fusions, KernelExecutors
   std::unordered_map<HostUnit*, std::unique_ptr<ExecutorAbstract>> executors_;
   std::unordered_map<HostUnit*, FusionExecutorCache> fec_;
+  // Ids of the shapes each executor has been run with, see setInputsId
+  std::unordered_map<ExecutorAbstract*, InputsIdLookup> inputs_id_lookups_;
   using StreamKey = std::variant<int64_t, Stream*>;
   std::unordered_map<StreamKey, c10::cuda::CUDAStream> streams_;
   std::unordered_map<Expr*, c10::intrusive_ptr<c10d::Work>> works_;
+  // Whether a StartCoalescing is pending. Hierarchical collectives wait on
+  // their intermediate steps, so they are not posted inside a group.
+  bool coalescing_ = false;
+  // The ids of the FusionProfiler timers of the communications that a Wait
+  // stops, by the communication or EndCoalescing it waits for
+  std::unordered_map<Expr*, std::vector<size_t>> communication_profile_ids_;
+  std::vector<size_t> coalesced_profile_ids_;
   const int64_t my_local_device_index_;
   IpcHandleCache ipc_handle_cache_;
+  // With EnableOption::SymmetricMemory, the top-level allocations of the
+  // buffers exported by kCuda communications are kept across runs. Every rank
+  // runs the same host program, so the buffers are allocated at the same
+  // point everywhere and their IPC handles stay valid.
+  std::unordered_set<TensorView*> symmetric_tvs_;
+  std::unordered_map<TensorView*, at::Tensor> symmetric_buffers_;
+  // With EnableOption::HostIrMemoryPlan, the top-level intermediates are
+  // carved out of workspace_ at the offsets of memory_plan_, which is computed
+  // from the sizes observed in the previous run, see updateMemoryPlan.
+  std::vector<BufferLifetime> buffer_lifetimes_;
+  std::unordered_map<TensorView*, int64_t> planned_buffers_;
+  std::vector<int64_t> observed_bytes_;
+  MemoryPlan memory_plan_;
+  at::Tensor workspace_;
+
+  // A pre-resolved top-level expression. run is empty when expr is
+  // dispatched, and event_name is the name of its profiler scope.
+  struct Instruction {
+    Expr* expr = nullptr;
+    std::string event_name;
+    std::function<void()> run;
+  };
+  std::optional<std::vector<Instruction>> tape_;
+  // Events of the Synchronize instructions of tape_
+  std::vector<cudaEvent_t> tape_events_;
+  // The host program and world size, which prefix the keys of the tuning
+  // database, if the number of streams is tuned. Empty otherwise.
+  std::string stream_tuning_prefix_;
+  // Keyed by the tuning key of the input shapes
+  std::unordered_map<std::string, StreamTuning> stream_tunings_;
 };
 
 } // namespace hir
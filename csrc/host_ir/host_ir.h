@@ -148,10 +148,11 @@ class LaunchKernel : public Expr {
     return attribute<CompileParams>(2);
   }
 
-  // A NamedScalar that holds the input cache ID. This NamedScalar is expected
-  // to be bound by HostIrEvaluate::runWithInputs. If it's not bound,
-  // KernelExecutor::runFusion will create a KernelArgumentHolder without cache
-  // ID and initializeExecutorEntry every time, slow yet functional.
+  // A NamedScalar that holds the input cache ID of the container, bound by
+  // HostIrEvaluator::runWithInputs. HostIrEvaluator doesn't pass it to the
+  // KernelExecutor: a launch in a loop may see different shapes under the
+  // same input cache ID, so the arguments are rather keyed by their own
+  // shapes, see HostIrEvaluator::setInputsId.
   Val* cacheId() const {
     return attributeVal(3);
   }
@@ -8,7 +8,10 @@
 #include <device_lower/utils.h>
 #include <host_ir/lower.h>
 #include <host_ir/lower_to_communication.h>
+#include <host_ir/pass/coalesce_communications.h>
 #include <host_ir/pass/convert_op_to_communication.h>
+#include <host_ir/pass/prefetch_allgathers.h>
+#include <host_ir/pass/ring_attention.h>
 #include <host_ir/pass/stream_parallel_type.h>
 #include <ir/all_nodes.h>
 #include <ir/builder.h>
@@ -18,8 +21,10 @@
 #include <multidevice/utils.h>
 #include <ops/all_ops.h>
 #include <ops/utils.h>
+#include <options.h>
 #include <preseg_passes/finalize_multidevice_domains.h>
 #include <preseg_passes/insert_reshardings.h>
+#include <preseg_passes/overlap_collective_matmul.h>
 #include <preseg_passes/propagate_shardings.h>
 #include <preseg_passes/reorder_sharded_axis.h>
 #include <runtime/fusion_kernel_runtime.h>
@@ -40,6 +45,12 @@ bool HostIrLower::isLowerableAsStandaloneHostOp(Expr* expr) {
     return true;
   }
 
+  // Ring attention replaces the allgathers of the key and the value of a
+  // standalone attention
+  if (expr->isA<SdpaFwdOp>() && isOptionEnabled(EnableOption::RingAttention)) {
+    return true;
+  }
+
   // Lower as standalone op "set" ops, i.e., LoadStoreOp of "Set" type with no
   // permute
   if (expr->isA<LoadStoreOp>()) {
@@ -79,6 +90,10 @@ std::unique_ptr<hir::HostIrContainer> HostIrLower::lower(
       preseg_passes::PropagateShardingsPass>::runPass(fusion.get());
   preseg_passes::OptimizationPass<
       preseg_passes::InsertReshardingsPass>::runPass(fusion.get());
+  if (isOptionEnabled(EnableOption::CollectiveMatmul)) {
+    preseg_passes::OptimizationPass<
+        preseg_passes::OverlapCollectiveMatmulPass>::runPass(fusion.get());
+  }
   preseg_passes::OptimizationPass<
       preseg_passes::FinalizeMultideviceDomainsPass>::runPass(fusion.get());
 
@@ -157,6 +172,11 @@ std::unique_ptr<hir::HostIrContainer> HostIrLower::lower(
 
   hir_pass::ConvertOpToCommunication(params_).runPass(hic.get());
 
+  hir_pass::RingAttention().runPass(hic.get());
+
+  hir_pass::PrefetchAllgathers().runPass(hic.get());
+  hir_pass::CoalesceCommunications().runPass(hic.get());
+
   return hic;
 }
 
@@ -17,14 +17,13 @@
 #include <multidevice/communication.h>
 #include <multidevice/utils.h>
 #include <ops/all_ops.h>
+#include <options.h>
 
 namespace nvfuser {
 
-namespace {
-
 // TODO: handle `c10d::RedOpType::reduceOp::AVG` and
 // `c10d::RedOpType::reduceOp::PREMUL_SUM`
-inline c10d::ReduceOp::RedOpType getC10dReduceOpType(BinaryOpType op) {
+c10d::ReduceOp::RedOpType getC10dReduceOpType(BinaryOpType op) {
   switch (op) {
     case BinaryOpType::Add:
       return c10d::ReduceOp::RedOpType::SUM;
@@ -46,6 +45,8 @@ inline c10d::ReduceOp::RedOpType getC10dReduceOpType(BinaryOpType op) {
   }
 }
 
+namespace {
+
 // Adds one or zero Scatter communication to the vector 'comms'
 void lowerToScatter(
     TensorView* input_tv,
@@ -285,6 +286,26 @@ void lowerToReduceScatter(
       backend));
 }
 
+// Adds one AllToAll communication to the vector 'comms'. The input and the
+// output are sharded on different axes of the same mesh.
+void lowerToAllToAll(
+    TensorView* input_tv,
+    TensorView* output_tv,
+    const CommunicatorBackend backend,
+    std::vector<Expr*>& comms,
+    DeviceIdxType my_device_idx) {
+  const DeviceMesh& mesh = input_tv->getDeviceMesh();
+  Team team = mesh.getSlice(my_device_idx, ParallelType::DIDx);
+  comms.push_back(IrBuilder::create<Communication>(
+      CommunicationType::AllToAll,
+      output_tv,
+      input_tv,
+      team,
+      /*root=*/-1,
+      c10d::ReduceOp::RedOpType::UNUSED,
+      backend));
+}
+
 IterDomain* getLogicalFromLoopId(TensorView* tv, IterDomain* loop_id) {
   std::vector<IterDomain*> logical_ids =
       getInputsInTargetDomain(loop_id, tv->getLogicalDomain());
@@ -370,9 +391,16 @@ CommunicationInfo getCommunicationInfo(Expr* e) {
       if (p_sharded && c_sharded) {
         IterDomain* p_logical_id = getLogicalFromLoopId(producer, p_loop_did);
         IterDomain* c_logical_id = getLogicalFromLoopId(consumer, c_loop_did);
+        // Moving the sharding to another axis within the mesh, e.g., from
+        // tokens to experts, exchanges a chunk between every pair of devices.
+        auto c_it = p2c_map.find(p_logical_id);
+        const bool is_same_axis =
+            c_it != p2c_map.end() && c_it->second == c_logical_id;
         // TODO(#4604): This is problematic for 2D sharding.
-        fill_communication_info(
-            CommunicationType::SendRecv, p_logical_id, c_logical_id);
+        CommunicationType type = same_mesh && !is_same_axis
+            ? CommunicationType::AllToAll
+            : CommunicationType::SendRecv;
+        fill_communication_info(type, p_logical_id, c_logical_id);
       }
     } else {
       NVF_ERROR(e->isA<ReductionOp>());
@@ -429,6 +457,15 @@ Layout getCommunicationLayout(
     TensorView* tv,
     const CommunicationType type,
     IterDomain* sharded_id) {
+  // With strided communication, a SendRecv is posted as send/recvs of the
+  // dense segments of `tv`, which can therefore be non-contiguous, and so is
+  // an Allgather into the slices of its output, in which the gathered axis
+  // can therefore be anywhere. See postSendRecv and postAllgather.
+  const bool is_strided = isOptionEnabled(EnableOption::StridedCommunication);
+  if (is_strided && type == CommunicationType::SendRecv) {
+    return *canonicalizeLayout(tv);
+  }
+
   const Layout layout = canonicalizeLayout(tv)->contiguous();
   // For the following communication types, the sharded_id does not have to be
   // outermost in allocation domain. Nonetheless, `tv` still needs to be
@@ -436,7 +473,9 @@ Layout getCommunicationLayout(
   if (type == CommunicationType::Reduce ||
       type == CommunicationType::Allreduce ||
       type == CommunicationType::Broadcast ||
-      type == CommunicationType::SendRecv) {
+      type == CommunicationType::SendRecv ||
+      type == CommunicationType::AllToAll ||
+      (is_strided && type == CommunicationType::Allgather)) {
     return layout;
   }
 
@@ -559,6 +598,10 @@ std::vector<Expr*> convertSingleOpToCommunication(
       } else {
         lowerToGather(input_tv, output_tv, backend, comms);
       }
+    } else if (
+        is_input_sharded && is_output_sharded &&
+        getCommunicationInfo(e).type == CommunicationType::AllToAll) {
+      lowerToAllToAll(input_tv, output_tv, backend, comms, my_device_idx);
     } else {
       // TODO(#4604): This is problematic for 2D sharding.
       lowerToBroadcastOrSendRecv(input_tv, output_tv, backend, comms);
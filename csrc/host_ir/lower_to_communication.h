@@ -22,6 +22,8 @@ struct CommunicationInfo {
   CommunicationType type;
   // Sharded logical IDs in producer/consumer.
   // For ReduceScatter, this is the scattered axis. Reduced axis is not stored.
+  // For AllToAll, these are different axes, so p_sharded_id is gathered in the
+  // consumer and c_sharded_id is scattered from the producer.
   IterDomain* p_sharded_id;
   IterDomain* c_sharded_id;
 };
@@ -46,11 +48,19 @@ CommunicationInfo getCommunicationInfo(Expr* expr);
 // this may change in the future. The returned layout is guaranteed to be
 // canonicalized, i.e., the allocation domain is a permutation of the logical
 // domain.
+//
+// The exchanged axes of an AllToAll don't have to be outermost because
+// postAllToAll stages the chunks that aren't. With
+// EnableOption::StridedCommunication, the gathered axis of an Allgather
+// doesn't have to be outermost and a SendRecv doesn't have to be contiguous.
 Layout getCommunicationLayout(
     TensorView* tv,
     const CommunicationType type,
     IterDomain* sharded_id);
 
+// Returns the process group reduction corresponding to a binary operation
+c10d::ReduceOp::RedOpType getC10dReduceOpType(BinaryOpType op);
+
 std::vector<Expr*> convertSingleOpToCommunication(
     Expr* c,
     DeviceIdxType my_device_idx,
@@ -0,0 +1,270 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <host_ir/memory_plan.h>
+
+#include <host_ir/host_ir.h>
+#include <ir/utils.h>
+#include <kernel_ir.h>
+#include <multidevice/communication.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace nvfuser::hir {
+
+namespace {
+
+// Offsets are aligned like the blocks of the caching allocator, which
+// kernels assume for vectorized and TMA accesses
+constexpr int64_t kBufferAlignment = 512;
+
+// Returns the TensorViews accessed by expr itself
+std::vector<TensorView*> accessedTvs(Expr* expr) {
+  std::vector<TensorView*> tvs;
+  for (auto* tv : ir_utils::filterByType<TensorView>(expr->inputs())) {
+    tvs.push_back(tv);
+  }
+  for (auto* tv : ir_utils::filterByType<TensorView>(expr->outputs())) {
+    tvs.push_back(tv);
+  }
+  if (auto* allocate = dynamic_cast<kir::Allocate*>(expr)) {
+    if (auto* tv = dynamic_cast<TensorView*>(allocate->buffer())) {
+      tvs.push_back(tv);
+    }
+  } else if (auto* deallocate = dynamic_cast<Deallocate*>(expr)) {
+    tvs.push_back(deallocate->buffer());
+  }
+  return tvs;
+}
+
+// Returns expr and the expressions nested in its scopes
+std::vector<Expr*> flatten(Expr* expr) {
+  std::vector<Expr*> exprs = {expr};
+  auto append = [&exprs](const Scope& scope) {
+    for (Expr* nested : scope.exprs()) {
+      std::vector<Expr*> nested_exprs = flatten(nested);
+      exprs.insert(exprs.end(), nested_exprs.begin(), nested_exprs.end());
+    }
+  };
+  if (auto* for_loop = dynamic_cast<ForLoop*>(expr)) {
+    append(for_loop->body());
+  } else if (auto* ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+    append(ite->thenBody());
+    append(ite->elseBody());
+  }
+  return exprs;
+}
+
+class LifetimeAnalysis {
+ public:
+  LifetimeAnalysis(
+      HostIrContainer* container,
+      const std::unordered_set<Val*>& excluded) {
+    const std::vector<Expr*>& exprs = container->topLevelExprs();
+    end_ = std::ssize(exprs);
+
+    std::unordered_map<TensorView*, int64_t> num_allocations;
+    for (auto i : arange(end_)) {
+      auto* allocate = dynamic_cast<kir::Allocate*>(exprs.at(i));
+      if (allocate == nullptr || !allocate->buffer()->isA<TensorView>()) {
+        continue;
+      }
+      auto* tv = allocate->buffer()->as<TensorView>();
+      if (num_allocations[tv]++ == 0) {
+        first_.emplace(tv, i);
+      }
+    }
+    for (auto&& [tv, count] : num_allocations) {
+      if (count > 1 || excluded.count(tv) != 0 ||
+          tv->isFusionInput() || tv->isFusionOutput()) {
+        first_.erase(tv);
+      }
+    }
+
+    std::unordered_set<Stream*> main_streams = {container->getDefaultStream()};
+    bool on_main_stream = true;
+    for (auto i : arange(end_)) {
+      Expr* top_level_expr = exprs.at(i);
+      if (auto* set_stream = dynamic_cast<SetCurrentStream*>(top_level_expr)) {
+        on_main_stream = main_streams.count(set_stream->stream()) != 0;
+      } else if (
+          auto* get_stream = dynamic_cast<GetCurrentStream*>(top_level_expr)) {
+        if (on_main_stream) {
+          main_streams.insert(get_stream->stream());
+        }
+      }
+      std::vector<Expr*> nested_exprs = flatten(top_level_expr);
+      const bool changes_stream = std::any_of(
+          nested_exprs.begin() + 1, nested_exprs.end(), [](Expr* expr) {
+            return expr->isA<SetCurrentStream>();
+          });
+      for (Expr* expr : nested_exprs) {
+        visit(expr, i, /*pinned=*/!on_main_stream || changes_stream);
+      }
+    }
+
+    // Communications that are never waited on may run until the end
+    for (auto&& [expr, roots] : in_flight_) {
+      pinned_.insert(roots.begin(), roots.end());
+    }
+    for (Val* out : container->outputs()) {
+      if (auto* tv = dynamic_cast<TensorView*>(out)) {
+        for (TensorView* root : rootsOf(tv)) {
+          first_.erase(root);
+        }
+      }
+    }
+  }
+
+  std::vector<BufferLifetime> lifetimes() const {
+    std::vector<BufferLifetime> lifetimes;
+    lifetimes.reserve(first_.size());
+    for (auto&& [tv, first] : first_) {
+      if (pinned_.count(tv) != 0) {
+        lifetimes.push_back({tv, 0, end_});
+        continue;
+      }
+      auto it = last_.find(tv);
+      lifetimes.push_back(
+          {tv, first, it == last_.end() ? first : std::max(first, it->second)});
+    }
+    // Deterministic order for the planner
+    std::sort(
+        lifetimes.begin(),
+        lifetimes.end(),
+        [](const BufferLifetime& a, const BufferLifetime& b) {
+          return a.first != b.first ? a.first < b.first
+                                    : a.tv->name() < b.tv->name();
+        });
+    return lifetimes;
+  }
+
+ private:
+  // Returns the planned buffers that tv may alias
+  std::vector<TensorView*> rootsOf(TensorView* tv) const {
+    if (first_.count(tv) != 0) {
+      return {tv};
+    }
+    auto it = roots_.find(tv);
+    return it == roots_.end() ? std::vector<TensorView*>{} : it->second;
+  }
+
+  void visit(Expr* expr, int64_t position, bool pinned) {
+    std::vector<TensorView*> roots;
+    for (TensorView* tv : accessedTvs(expr)) {
+      for (TensorView* root : rootsOf(tv)) {
+        if (std::find(roots.begin(), roots.end(), root) == roots.end()) {
+          roots.push_back(root);
+        }
+      }
+    }
+    // Outputs that aren't allocated may be views of the inputs, e.g. the
+    // outputs of LoadStoreOp and HirAliasSelect
+    for (auto* out : ir_utils::filterByType<TensorView>(expr->outputs())) {
+      if (first_.count(out) == 0) {
+        std::vector<TensorView*>& out_roots = roots_[out];
+        for (TensorView* root : roots) {
+          if (std::find(out_roots.begin(), out_roots.end(), root) ==
+              out_roots.end()) {
+            out_roots.push_back(root);
+          }
+        }
+      }
+    }
+
+    for (TensorView* root : roots) {
+      last_[root] = position;
+      if (pinned) {
+        pinned_.insert(root);
+      }
+    }
+
+    if (expr->isA<StartCoalescing>()) {
+      coalescing_ = true;
+    } else if (expr->isA<EndCoalescing>()) {
+      coalescing_ = false;
+      in_flight_[expr] = std::move(coalesced_);
+      coalesced_.clear();
+    } else if (expr->isOneOf<Communication, P2PCommunication>()) {
+      std::vector<TensorView*>& in_flight =
+          coalescing_ ? coalesced_ : in_flight_[expr];
+      in_flight.insert(in_flight.end(), roots.begin(), roots.end());
+    } else if (auto* wait = dynamic_cast<Wait*>(expr)) {
+      auto it = in_flight_.find(wait->communication());
+      if (it != in_flight_.end()) {
+        for (TensorView* root : it->second) {
+          last_[root] = position;
+        }
+        in_flight_.erase(it);
+      }
+    }
+  }
+
+  int64_t end_ = 0;
+  std::unordered_map<TensorView*, int64_t> first_;
+  std::unordered_map<TensorView*, int64_t> last_;
+  std::unordered_set<TensorView*> pinned_;
+  std::unordered_map<TensorView*, std::vector<TensorView*>> roots_;
+  // The buffers accessed by the communications that haven't been waited on
+  std::unordered_map<Expr*, std::vector<TensorView*>> in_flight_;
+  std::vector<TensorView*> coalesced_;
+  bool coalescing_ = false;
+};
+
+} // namespace
+
+std::vector<BufferLifetime> computeBufferLifetimes(
+    HostIrContainer* container,
+    const std::unordered_set<Val*>& excluded) {
+  return LifetimeAnalysis(container, excluded).lifetimes();
+}
+
+MemoryPlan planMemory(
+    const std::vector<BufferLifetime>& lifetimes,
+    const std::vector<int64_t>& bytes) {
+  NVF_ERROR_EQ(lifetimes.size(), bytes.size());
+  MemoryPlan plan;
+  plan.bytes = bytes;
+  plan.offsets.assign(lifetimes.size(), -1);
+
+  std::vector<int64_t> order(lifetimes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&bytes](int64_t a, int64_t b) {
+    return bytes.at(a) > bytes.at(b);
+  });
+
+  std::vector<int64_t> placed;
+  for (int64_t i : order) {
+    const BufferLifetime& lifetime = lifetimes.at(i);
+    // Ranges of the placed buffers live at the same time, sorted by offset
+    std::vector<std::pair<int64_t, int64_t>> taken;
+    for (int64_t j : placed) {
+      const BufferLifetime& other = lifetimes.at(j);
+      if (lifetime.first <= other.last && other.first <= lifetime.last) {
+        taken.emplace_back(
+            plan.offsets.at(j), plan.offsets.at(j) + bytes.at(j));
+      }
+    }
+    std::sort(taken.begin(), taken.end());
+    int64_t offset = 0;
+    for (auto [begin, end] : taken) {
+      if (offset + bytes.at(i) <= begin) {
+        break;
+      }
+      offset = std::max(offset, roundUpToMultiple(end, kBufferAlignment));
+    }
+    plan.offsets.at(i) = offset;
+    plan.workspace_bytes = std::max(plan.workspace_bytes, offset + bytes.at(i));
+    placed.push_back(i);
+  }
+  return plan;
+}
+
+} // namespace nvfuser::hir
@@ -0,0 +1,53 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <host_ir/container.h>
+#include <ir/interface_nodes.h>
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace nvfuser::hir {
+
+//! Positions in the top-level expressions of a host program between which a
+//! buffer may be accessed by the device
+struct BufferLifetime {
+  TensorView* tv = nullptr;
+  int64_t first = -1;
+  int64_t last = -1;
+};
+
+//! Returns the lifetimes of the intermediates allocated once at the top level
+//! of container, except for those in excluded. A lifetime starts at the
+//! allocation and ends at the last use of the buffer or of a tensor that may
+//! alias it, or at the wait of the last communication using it. Buffers used
+//! on another stream than the main one, or in a loop that changes streams,
+//! live during the whole program since their last access isn't ordered with
+//! the main stream. Buffers that a fusion output may alias are not included.
+std::vector<BufferLifetime> computeBufferLifetimes(
+    HostIrContainer* container,
+    const std::unordered_set<Val*>& excluded);
+
+//! Offsets of buffers in a workspace
+struct MemoryPlan {
+  //! Sizes in bytes of the buffers the plan was computed for
+  std::vector<int64_t> bytes;
+  std::vector<int64_t> offsets;
+  int64_t workspace_bytes = 0;
+};
+
+//! Packs the buffers of lifetimes, of the given sizes in bytes, into one
+//! workspace. Buffers whose lifetimes overlap get disjoint ranges. Large
+//! buffers are placed first, each at the lowest aligned offset that fits.
+MemoryPlan planMemory(
+    const std::vector<BufferLifetime>& lifetimes,
+    const std::vector<int64_t>& bytes);
+
+} // namespace nvfuser::hir
@@ -0,0 +1,156 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+
+#include <host_ir/pass/coalesce_communications.h>
+
+#include <host_ir/host_ir.h>
+#include <ir/builder.h>
+#include <kernel_ir.h>
+#include <multidevice/communication.h>
+#include <multidevice/communicator.h>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nvfuser::hir_pass {
+
+namespace {
+
+// ProcessGroup coalescing is only used on the NCCL backend of the world, see
+// HostIrEvaluator::handle(StartCoalescing*). Strided communications coalesce
+// their own send/recvs.
+bool isCoalescable(Expr* expr, const Team& world) {
+  auto* communication = dynamic_cast<Communication*>(expr);
+  return communication != nullptr &&
+      communication->backend() == CommunicatorBackend::kNccl &&
+      communication->team() == world &&
+      !isStridedCommunication(communication);
+}
+
+// Expressions that a communication can't be hoisted across
+bool endsBlock(Expr* expr) {
+  return expr->isOneOf<
+      ForLoop,
+      kir::IfThenElse,
+      hir::SetCurrentStream,
+      hir::GetCurrentStream,
+      hir::Synchronize,
+      hir::StartCoalescing,
+      hir::EndCoalescing,
+      hir::ShareMemHandles,
+      P2PCommunication>();
+}
+
+bool readsAny(Expr* expr, const std::unordered_set<Val*>& vals) {
+  return std::any_of(
+      expr->inputs().begin(), expr->inputs().end(), [&vals](Val* input) {
+        return vals.count(input) != 0;
+      });
+}
+
+} // namespace
+
+void CoalesceCommunications::passImplementation(Fusion* fusion) {
+  if (!isOptionEnabled(EnableOption::CoalesceCommunications)) {
+    return;
+  }
+  FusionGuard fg(fusion);
+  hir::HostIrContainer* hic = dynamic_cast<hir::HostIrContainer*>(fusion);
+  NVF_CHECK(hic, "Expected HostIrContainer");
+
+  Team world(Communicator::getInstance().size());
+  std::iota(world.begin(), world.end(), 0);
+
+  const std::vector<Expr*>& exprs = hic->topLevelExprs();
+  // The allocation of the output of each communication, when it directly
+  // precedes the communication, and the wait of each communication
+  std::unordered_map<Expr*, Expr*> allocations;
+  std::unordered_map<Expr*, Expr*> waits;
+  for (auto i : arange(std::ssize(exprs))) {
+    Expr* expr = exprs.at(i);
+    if (!isCoalescable(expr, world)) {
+      if (auto* wait = dynamic_cast<hir::Wait*>(expr)) {
+        waits.emplace(wait->communication(), wait);
+      }
+      continue;
+    }
+    if (i > 0) {
+      auto* allocate = dynamic_cast<kir::Allocate*>(exprs.at(i - 1));
+      if (allocate != nullptr &&
+          allocate->buffer() == expr->as<Communication>()->out()) {
+        allocations.emplace(expr, allocate);
+      }
+    }
+  }
+
+  std::unordered_set<Expr*> moved;
+  std::vector<Expr*> new_top_level_exprs;
+  for (auto i : arange(std::ssize(exprs))) {
+    Expr* expr = exprs.at(i);
+    if (moved.count(expr) != 0) {
+      continue;
+    }
+    if (!isCoalescable(expr, world) || waits.count(expr) == 0) {
+      new_top_level_exprs.push_back(expr);
+      continue;
+    }
+
+    std::vector<Expr*> block = {expr};
+    std::unordered_set<Val*> produced(
+        expr->outputs().begin(), expr->outputs().end());
+    for (auto j : arange(i + 1, std::ssize(exprs))) {
+      Expr* other = exprs.at(j);
+      if (endsBlock(other)) {
+        break;
+      }
+      if (moved.count(other) != 0 || other == waits.at(expr)) {
+        continue;
+      }
+      auto* allocate = dynamic_cast<kir::Allocate*>(other);
+      if (allocate == nullptr && isCoalescable(other, world) &&
+          waits.count(other) != 0 && !readsAny(other, produced) &&
+          (allocations.count(other) == 0 ||
+           !readsAny(allocations.at(other), produced))) {
+        block.push_back(other);
+        moved.insert(other);
+        moved.insert(waits.at(other));
+        if (allocations.count(other) != 0) {
+          moved.insert(allocations.at(other));
+        }
+      }
+      if (allocate != nullptr) {
+        produced.insert(allocate->buffer());
+      }
+      produced.insert(other->outputs().begin(), other->outputs().end());
+    }
+
+    if (block.size() == 1) {
+      new_top_level_exprs.push_back(expr);
+      continue;
+    }
+    moved.insert(waits.at(expr));
+    // The allocation of the first communication was already pushed
+    for (Expr* communication : block) {
+      if (communication != expr && allocations.count(communication) != 0) {
+        new_top_level_exprs.push_back(allocations.at(communication));
+      }
+    }
+    new_top_level_exprs.push_back(IrBuilder::create<hir::StartCoalescing>());
+    new_top_level_exprs.insert(
+        new_top_level_exprs.end(), block.begin(), block.end());
+    auto* end_coalescing = IrBuilder::create<hir::EndCoalescing>();
+    new_top_level_exprs.push_back(end_coalescing);
+    new_top_level_exprs.push_back(IrBuilder::create<hir::Wait>(end_coalescing));
+  }
+  hic->resetTopLevelExprs(new_top_level_exprs);
+}
+
+} // namespace nvfuser::hir_pass
@@ -0,0 +1,32 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <host_ir/container.h>
+#include <host_ir/pass/optimization_pass.h>
+
+namespace nvfuser::hir_pass {
+
+/* With EnableOption::CoalesceCommunications, groups top-level NCCL
+ * communications of the whole world that don't depend on each other into a
+ * StartCoalescing/EndCoalescing block waited on once, so that NCCL launches
+ * them together. A communication is hoisted into the block of an earlier one
+ * along with the allocation of its output, as long as none of the
+ * expressions in between produces its input. Stream changes and control flow
+ * end a block. Must run before InsertDeallocations. */
+class CoalesceCommunications : public OptimizationPass<CoalesceCommunications> {
+  friend class OptimizationPass<CoalesceCommunications>;
+
+ protected:
+  void passImplementation(Fusion* fusion);
+  static constexpr std::string_view name() {
+    return "CoalesceCommunications";
+  }
+};
+
+} // namespace nvfuser::hir_pass
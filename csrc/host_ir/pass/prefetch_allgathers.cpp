@@ -0,0 +1,156 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+
+#include <host_ir/pass/prefetch_allgathers.h>
+
+#include <host_ir/host_ir.h>
+#include <ir/builder.h>
+#include <kernel_ir.h>
+#include <multidevice/communication.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nvfuser::hir_pass {
+
+namespace {
+
+int64_t maxPrefetchesPerExpr() {
+  constexpr int64_t default_max_prefetches = 2;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::PrefetchAllgathers);
+  return option_args.empty() ? default_max_prefetches
+                             : std::stoll(option_args[0]);
+}
+
+// Expressions that neither compute nor change the order of the streams, which
+// an allgather is hoisted across
+bool isBookkeeping(Expr* expr) {
+  return expr->isOneOf<
+      kir::Allocate,
+      hir::Deallocate,
+      hir::Wait,
+      Communication>();
+}
+
+// Expressions that an allgather can't be hoisted across
+bool endsWindow(Expr* expr) {
+  return expr->isOneOf<
+      ForLoop,
+      kir::IfThenElse,
+      hir::SetCurrentStream,
+      hir::GetCurrentStream,
+      hir::Synchronize,
+      hir::StartCoalescing,
+      hir::EndCoalescing,
+      hir::ShareMemHandles,
+      P2PCommunication>();
+}
+
+} // namespace
+
+void PrefetchAllgathers::passImplementation(Fusion* fusion) {
+  if (!isOptionEnabled(EnableOption::PrefetchAllgathers)) {
+    return;
+  }
+  FusionGuard fg(fusion);
+  hir::HostIrContainer* hic = dynamic_cast<hir::HostIrContainer*>(fusion);
+  NVF_CHECK(hic, "Expected HostIrContainer");
+
+  const int64_t max_prefetches = maxPrefetchesPerExpr();
+  const std::unordered_set<Val*> fusion_inputs(
+      hic->inputs().begin(), hic->inputs().end());
+  const std::vector<Expr*>& exprs = hic->topLevelExprs();
+
+  std::unordered_map<Expr*, int64_t> wait_indices;
+  for (auto i : arange(std::ssize(exprs))) {
+    if (auto* wait = dynamic_cast<hir::Wait*>(exprs.at(i))) {
+      wait_indices.emplace(wait->communication(), i);
+    }
+  }
+
+  // Maps the index of each compute expression to the indices of the
+  // allgathers hoisted before it
+  std::unordered_map<int64_t, std::vector<int64_t>> prefetches;
+  std::unordered_set<int64_t> moved;
+  std::unordered_set<int64_t> prefetch_waits;
+  for (auto i : arange(1, std::ssize(exprs))) {
+    auto* communication = dynamic_cast<Communication*>(exprs.at(i));
+    if (communication == nullptr ||
+        communication->type() != CommunicationType::Allgather ||
+        fusion_inputs.count(communication->in()) == 0 ||
+        wait_indices.count(communication) == 0) {
+      continue;
+    }
+    auto* allocate = dynamic_cast<kir::Allocate*>(exprs.at(i - 1));
+    if (allocate == nullptr || allocate->buffer() != communication->out()) {
+      continue;
+    }
+
+    int64_t target = -1;
+    for (int64_t j = i - 2; j >= 0; --j) {
+      Expr* expr = exprs.at(j);
+      if (endsWindow(expr)) {
+        break;
+      }
+      if (!isBookkeeping(expr)) {
+        target = j;
+        break;
+      }
+    }
+    if (target < 0 || std::ssize(prefetches[target]) >= max_prefetches) {
+      continue;
+    }
+    prefetches[target].push_back(i);
+    moved.insert(i - 1);
+    moved.insert(i);
+    prefetch_waits.insert(wait_indices.at(communication));
+  }
+  if (prefetch_waits.empty()) {
+    return;
+  }
+
+  auto* get_current_stream = IrBuilder::create<hir::GetCurrentStream>();
+  hir::Stream* main_stream = get_current_stream->stream();
+  auto* prefetch_stream = IrBuilder::create<hir::Stream>();
+
+  std::vector<Expr*> new_top_level_exprs = {get_current_stream};
+  for (auto i : arange(std::ssize(exprs))) {
+    if (moved.count(i) != 0) {
+      continue;
+    }
+    if (prefetch_waits.count(i) != 0) {
+      // The main stream waits for the prefetch right before the first use
+      new_top_level_exprs.push_back(
+          IrBuilder::create<hir::Synchronize>(prefetch_stream));
+      continue;
+    }
+    if (auto it = prefetches.find(i); it != prefetches.end()) {
+      // Allocate on the main stream, which frees the buffers
+      for (int64_t prefetch : it->second) {
+        new_top_level_exprs.push_back(exprs.at(prefetch - 1));
+      }
+      new_top_level_exprs.push_back(
+          IrBuilder::create<hir::SetCurrentStream>(prefetch_stream));
+      for (int64_t prefetch : it->second) {
+        Expr* communication = exprs.at(prefetch);
+        new_top_level_exprs.push_back(communication);
+        new_top_level_exprs.push_back(
+            exprs.at(wait_indices.at(communication)));
+      }
+      new_top_level_exprs.push_back(
+          IrBuilder::create<hir::SetCurrentStream>(main_stream));
+    }
+    new_top_level_exprs.push_back(exprs.at(i));
+  }
+  hic->resetTopLevelExprs(new_top_level_exprs);
+}
+
+} // namespace nvfuser::hir_pass
@@ -0,0 +1,43 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <host_ir/container.h>
+#include <host_ir/pass/optimization_pass.h>
+
+namespace nvfuser::hir_pass {
+
+/* With EnableOption::PrefetchAllgathers, hoists the top-level allgathers of
+ * sharded fusion inputs, e.g. the weights of the next layer, before the
+ * nearest preceding compute expression and issues them on a side stream:
+ *
+ *   LaunchKernel(layer N)                Allocate(w_full)
+ *   Allocate(w_full)                     SetCurrentStream(prefetch)
+ *   Communication(w_full <- w)       =>  Communication(w_full <- w)
+ *   Wait(w_full)                         Wait(w_full)
+ *   LaunchKernel(layer N+1)              SetCurrentStream(main)
+ *                                        LaunchKernel(layer N)
+ *                                        Synchronize(prefetch)
+ *                                        LaunchKernel(layer N+1)
+ *
+ * The gathered buffer is allocated on the main stream, so the Deallocate
+ * inserted after its last use by InsertDeallocations releases it in stream
+ * order. The option argument bounds the number of gathered inputs hoisted
+ * across the same expression, which bounds the memory held ahead of time.
+ * Must run before InsertDeallocations. */
+class PrefetchAllgathers : public OptimizationPass<PrefetchAllgathers> {
+  friend class OptimizationPass<PrefetchAllgathers>;
+
+ protected:
+  void passImplementation(Fusion* fusion);
+  static constexpr std::string_view name() {
+    return "PrefetchAllgathers";
+  }
+};
+
+} // namespace nvfuser::hir_pass
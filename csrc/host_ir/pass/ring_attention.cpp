@@ -0,0 +1,295 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+
+#include <host_ir/pass/ring_attention.h>
+
+#include <host_ir/host_ir.h>
+#include <ir/builder.h>
+#include <ir/utils.h>
+#include <kernel_ir.h>
+#include <multidevice/communication.h>
+#include <multidevice/communicator.h>
+#include <ops/all_ops.h>
+#include <ops/utils.h>
+#include <options.h>
+#include <remarks.h>
+#include <transform_replay.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nvfuser::hir_pass {
+
+namespace {
+
+// Returns whether val is a constant equal to value
+template <typename T>
+bool isConstEqual(Val* val, T value) {
+  return val != nullptr && val->isConstScalar() &&
+      val->evaluate().as<T>() == value;
+}
+
+// Returns a new tensor with the logical domain, the sharding and the memory
+// type of tv, which stands for another buffer of the same local shape
+TensorView* cloneBuffer(TensorView* tv) {
+  auto* clone = ops::newValLike(tv, tv->dtype())->as<TensorView>();
+  TransformReplay::selfReplay(
+      tv->domain(), clone->domain(), /*ignore_reductions=*/true);
+  clone->setDeviceMesh(tv->getDeviceMesh());
+  clone->setMemoryType(MemoryType::Global);
+  clone->setCpuScalar(tv->isCpuScalar());
+  return clone;
+}
+
+// Returns a host unit merging two partial attention outputs over disjoint
+// key chunks, given their log-sum-exps:
+//   lse = log(exp(lse_a) + exp(lse_b))
+//   out = out_a * exp(lse_a - lse) + out_b * exp(lse_b - lse)
+hir::HostUnit* makeMergeUnit(TensorView* attn_out) {
+  const auto rank =
+      std::ssize(TensorDomain::noReductions(attn_out->getLogicalDomain()));
+  auto fusion = std::make_unique<Fusion>();
+  {
+    FusionGuard fg(fusion.get());
+    auto make_input = [&fusion](int64_t ndims, DataType dtype) {
+      TensorView* tv = TensorViewBuilder()
+                           .ndims(ndims)
+                           .dtype(dtype)
+                           .contiguity(true)
+                           .build();
+      fusion->addInput(tv);
+      return tv;
+    };
+    TensorView* out_a = make_input(rank, attn_out->dtype());
+    TensorView* lse_a = make_input(rank - 1, DataType::Float);
+    TensorView* out_b = make_input(rank, attn_out->dtype());
+    TensorView* lse_b = make_input(rank - 1, DataType::Float);
+
+    // Stable form of the log-sum-exp of two values
+    TensorView* lse = add(
+        maximum(lse_a, lse_b), log1p(exp(neg(abs(sub(lse_a, lse_b))))));
+    std::vector<bool> is_broadcast_dim(rank, false);
+    is_broadcast_dim.back() = true;
+    TensorView* weight_a = broadcast(exp(sub(lse_a, lse)), is_broadcast_dim);
+    TensorView* weight_b = broadcast(exp(sub(lse_b, lse)), is_broadcast_dim);
+    TensorView* out =
+        add(mul(castOp(DataType::Float, out_a), weight_a),
+            mul(castOp(DataType::Float, out_b), weight_b));
+    fusion->addOutput(castOp(attn_out->dtype(), out));
+    fusion->addOutput(lse);
+  }
+  return IrBuilder::create<hir::HostUnit>(std::move(fusion));
+}
+
+// A sequence-parallel attention found in the top-level expressions
+struct RingAttentionPattern {
+  SdpaFwdOp* sdpa = nullptr;
+  Communication* key_gather = nullptr;
+  Communication* value_gather = nullptr;
+};
+
+std::vector<Expr*> makeRing(
+    const RingAttentionPattern& pattern,
+    DeviceIdxType my_device_index) {
+  SdpaFwdOp* sdpa = pattern.sdpa;
+  const Team& team = pattern.key_gather->team();
+  const auto num_devices = std::ssize(team);
+  const auto my_index = std::distance(
+      team.begin(), std::find(team.begin(), team.end(), my_device_index));
+  Val* next_peer = IrBuilder::create<Val>(
+      team.at((my_index + 1) % num_devices), DataType::Int);
+  Val* prev_peer = IrBuilder::create<Val>(
+      team.at((my_index + num_devices - 1) % num_devices), DataType::Int);
+
+  hir::HostUnit* merge_unit = makeMergeUnit(sdpa->attn_out());
+  std::vector<Expr*> ring;
+  TensorView* key = pattern.key_gather->in();
+  TensorView* value = pattern.value_gather->in();
+  TensorView* attn_out = nullptr;
+  TensorView* logsumexp = nullptr;
+  for (auto step : arange(num_devices)) {
+    const bool is_last_step = step + 1 == num_devices;
+
+    TensorView* next_key = nullptr;
+    TensorView* next_value = nullptr;
+    hir::EndCoalescing* end_coalescing = nullptr;
+    if (!is_last_step) {
+      next_key = cloneBuffer(key);
+      next_value = cloneBuffer(value);
+      ring.push_back(
+          IrBuilder::create<kir::Allocate>(next_key, MemoryType::Global));
+      ring.push_back(
+          IrBuilder::create<kir::Allocate>(next_value, MemoryType::Global));
+      // Coalescing the sends and receives avoids a deadlock on their global
+      // order and uses both directions of the links
+      ring.push_back(IrBuilder::create<hir::StartCoalescing>());
+      for (auto [send_buffer, recv_buffer] :
+           {std::make_pair(key, next_key), std::make_pair(value, next_value)}) {
+        ring.push_back(IrBuilder::create<P2PCommunication>(
+            P2PCommunicationType::SEND,
+            send_buffer,
+            next_peer,
+            pattern.key_gather->backend()));
+        ring.push_back(IrBuilder::create<P2PCommunication>(
+            P2PCommunicationType::RECV,
+            recv_buffer,
+            prev_peer,
+            pattern.key_gather->backend()));
+      }
+      end_coalescing = IrBuilder::create<hir::EndCoalescing>();
+      ring.push_back(end_coalescing);
+    }
+
+    // The last step writes the philox outputs, which are unused without
+    // dropout. The last merge writes the attention output and log-sum-exp.
+    TensorView* step_out = cloneBuffer(sdpa->attn_out());
+    TensorView* step_lse = cloneBuffer(sdpa->logsumexp());
+    TensorView* philox_seed =
+        is_last_step ? sdpa->philox_seed() : cloneBuffer(sdpa->philox_seed());
+    TensorView* philox_offset = is_last_step
+        ? sdpa->philox_offset()
+        : cloneBuffer(sdpa->philox_offset());
+    ring.push_back(IrBuilder::create<SdpaFwdOp>(
+        step_out,
+        step_lse,
+        philox_seed,
+        philox_offset,
+        sdpa->query(),
+        key,
+        value,
+        sdpa->dropout_p(),
+        sdpa->is_causal(),
+        sdpa->scale()));
+
+    if (step == 0) {
+      attn_out = step_out;
+      logsumexp = step_lse;
+    } else {
+      TensorView* merged_out =
+          is_last_step ? sdpa->attn_out() : cloneBuffer(sdpa->attn_out());
+      TensorView* merged_lse =
+          is_last_step ? sdpa->logsumexp() : cloneBuffer(sdpa->logsumexp());
+      ring.push_back(IrBuilder::create<hir::PostOnStream>(
+          merge_unit,
+          std::vector<Val*>{attn_out, logsumexp, step_out, step_lse},
+          std::vector<Val*>{merged_out, merged_lse}));
+      attn_out = merged_out;
+      logsumexp = merged_lse;
+    }
+
+    if (!is_last_step) {
+      ring.push_back(IrBuilder::create<hir::Wait>(end_coalescing));
+      // Release the chunk received at the previous step, which has been
+      // forwarded and attended to
+      if (step > 0) {
+        ring.push_back(IrBuilder::create<hir::Deallocate>(key));
+        ring.push_back(IrBuilder::create<hir::Deallocate>(value));
+      }
+      key = next_key;
+      value = next_value;
+    }
+  }
+  return ring;
+}
+
+} // namespace
+
+void RingAttention::passImplementation(Fusion* fusion) {
+  if (!isOptionEnabled(EnableOption::RingAttention)) {
+    return;
+  }
+  FusionGuard fg(fusion);
+  hir::HostIrContainer* hic = dynamic_cast<hir::HostIrContainer*>(fusion);
+  NVF_CHECK(hic, "Expected HostIrContainer");
+  const DeviceIdxType my_device_index = Communicator::getInstance().deviceId();
+
+  // The allgathers of the container, by gathered tensor
+  std::unordered_map<Val*, Communication*> gathers;
+  for (Expr* expr : hic->topLevelExprs()) {
+    auto* communication = dynamic_cast<Communication*>(expr);
+    if (communication != nullptr &&
+        communication->type() == CommunicationType::Allgather &&
+        communication->backend() != CommunicatorBackend::kCuda) {
+      gathers.emplace(communication->out(), communication);
+    }
+  }
+
+  auto find_gather = [&gathers](TensorView* tv) -> Communication* {
+    auto it = gathers.find(tv);
+    if (it == gathers.end() || tv->uses().size() != 1) {
+      return nullptr;
+    }
+    return it->second;
+  };
+
+  std::unordered_map<Expr*, RingAttentionPattern> patterns;
+  std::unordered_set<Expr*> removed;
+  for (Expr* expr : hic->topLevelExprs()) {
+    auto* sdpa = dynamic_cast<SdpaFwdOp*>(expr);
+    if (sdpa == nullptr || !isConstEqual(sdpa->dropout_p(), 0.0) ||
+        !isConstEqual(sdpa->is_causal(), false)) {
+      continue;
+    }
+    Communication* key_gather = find_gather(sdpa->key());
+    Communication* value_gather = find_gather(sdpa->value());
+    if (key_gather == nullptr || value_gather == nullptr ||
+        key_gather->team() != value_gather->team() ||
+        key_gather->team().size() < 2) {
+      continue;
+    }
+    const Team& team = key_gather->team();
+    if (std::find(team.begin(), team.end(), my_device_index) == team.end()) {
+      continue;
+    }
+    patterns[sdpa] = {sdpa, key_gather, value_gather};
+    removed.insert(key_gather);
+    removed.insert(value_gather);
+
+    if (remarks::isActive()) {
+      remarks::report(
+          "ring_attention",
+          "replaced allgathers of key and value by a ring",
+          {{"attention", sdpa->attn_out()->toString()},
+           {"devices", std::to_string(team.size())}});
+    }
+  }
+  if (patterns.empty()) {
+    return;
+  }
+
+  std::vector<Expr*> new_top_level_exprs;
+  for (Expr* expr : hic->topLevelExprs()) {
+    if (removed.count(expr) != 0) {
+      continue;
+    }
+    if (auto* wait = dynamic_cast<hir::Wait*>(expr);
+        wait != nullptr && removed.count(wait->communication()) != 0) {
+      continue;
+    }
+    if (auto* allocate = dynamic_cast<kir::Allocate*>(expr)) {
+      auto* buffer = dynamic_cast<TensorView*>(allocate->buffer());
+      if (buffer != nullptr && buffer->definition() != nullptr &&
+          removed.count(buffer->definition()) != 0) {
+        continue;
+      }
+    }
+    if (auto it = patterns.find(expr); it != patterns.end()) {
+      std::vector<Expr*> ring = makeRing(it->second, my_device_index);
+      new_top_level_exprs.insert(
+          new_top_level_exprs.end(), ring.begin(), ring.end());
+      continue;
+    }
+    new_top_level_exprs.push_back(expr);
+  }
+  hic->resetTopLevelExprs(new_top_level_exprs);
+}
+
+} // namespace nvfuser::hir_pass
@@ -0,0 +1,51 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <host_ir/container.h>
+#include <host_ir/pass/optimization_pass.h>
+
+namespace nvfuser::hir_pass {
+
+/* With EnableOption::RingAttention, replaces the allgathers of the key and the
+ * value of a sequence-parallel SdpaFwdOp by a ring. At step s, each device
+ * attends its query shard to the key/value chunk it received at step s - 1
+ * while it forwards that chunk to the next device of the team:
+ *
+ *   Allocate(k_full)                    FOR s in [0, D) (unrolled):
+ *   Communication(k_full <- k)            Allocate(k_{s+1}), Allocate(v_{s+1})
+ *   Wait(k_full)                          StartCoalescing
+ *   Allocate(v_full)                =>    Send(k_s, next), Recv(k_{s+1}, prev)
+ *   Communication(v_full <- v)            Send(v_s, next), Recv(v_{s+1}, prev)
+ *   Wait(v_full)                          EndCoalescing
+ *   SdpaFwdOp(q, k_full, v_full)          SdpaFwdOp(o_s, lse_s <- q, k_s, v_s)
+ *                                         PostOnStream(merge o_s into o)
+ *                                         Wait(EndCoalescing)
+ *                                         Deallocate(k_s), Deallocate(v_s)
+ *
+ * with k_0 = k, v_0 = v and D the size of the team. The send/recv of the next
+ * chunk runs on the NCCL stream concurrently with the attention kernel on the
+ * current stream, and only two chunks are live at any time. The partial
+ * outputs are merged with their log-sum-exps, which makes the result exact.
+ * The ring is unrolled since D is known at lowering, which keeps every
+ * intermediate in SSA form.
+ *
+ * Only applies to non-causal attention without dropout, whose result doesn't
+ * depend on the order in which the key chunks are visited. Must run after
+ * ConvertOpToCommunication and before CoalesceCommunications. */
+class RingAttention : public OptimizationPass<RingAttention> {
+  friend class OptimizationPass<RingAttention>;
+
+ protected:
+  void passImplementation(Fusion* fusion);
+  static constexpr std::string_view name() {
+    return "RingAttention";
+  }
+};
+
+} // namespace nvfuser::hir_pass
@@ -8,6 +8,7 @@
 
 #include <host_ir/container.h>
 #include <host_ir/lower.h>
+#include <host_ir/lower_to_communication.h>
 #include <host_ir/pass/stream_parallel_type.h>
 #include <id_model/id_model.h>
 #include <ir/all_nodes.h>
@@ -15,6 +16,7 @@
 #include <ir/internal_base_nodes.h>
 #include <ir/utils.h>
 #include <kernel_ir.h>
+#include <multidevice/communication.h>
 #include <ops/all_ops.h>
 #include <ops/utils.h>
 
@@ -83,6 +85,33 @@ bool canMergeWithPreviousForLoop(
           new_top_level_exprs.back()->as<ForLoop>()->iterDomain());
 }
 
+// Returns the stream axis of the input of a reduction that scatters this axis
+// across devices, i.e., tv1 = sum(tv0) with tv0 [Stream(i0), ...] and tv1
+// [DIDx(i0), ...], and nullptr otherwise. Each chunk of tv0 is then reduced to
+// the device that owns it.
+IterDomain* getScatteredStreamAxis(Expr* expr, const IdModel& id_model) {
+  auto* reduction = dynamic_cast<ReductionOp*>(expr);
+  if (reduction == nullptr || !reduction->in()->isA<TensorView>()) {
+    return nullptr;
+  }
+  auto* input = reduction->in()->as<TensorView>();
+  auto* output = reduction->out()->as<TensorView>();
+  IterDomain* stream_axis = getStreamAxis(input->getLoopDomain());
+  if (stream_axis == nullptr) {
+    return nullptr;
+  }
+  if (std::none_of(
+          output->getLoopDomain().begin(),
+          output->getLoopDomain().end(),
+          [&](IterDomain* id) {
+            return id->isDeviceDim() &&
+                areIdsMapped(id_model, stream_axis, id);
+          })) {
+    return nullptr;
+  }
+  return stream_axis;
+}
+
 // Finds where a stream axis appears in a tensor's logical domain
 int64_t findStreamAxisIndex(
     const TensorView* tv,
@@ -189,8 +218,23 @@ std::vector<Expr*> groupStreamParallelRegions(
   std::vector<Expr*> new_top_level_exprs;
 
   for (auto* expr : top_level_exprs) {
-    // Skip expressions with no outputs
-    if (expr->outputs().size() == 0) {
+    // Skip expressions with no stream-parallelized outputs, e.g. standalone
+    // attentions, which have several outputs
+    auto output_tvs = ir_utils::filterByType<TensorView>(expr->outputs());
+    if (std::none_of(
+            output_tvs.begin(), output_tvs.end(), [](TensorView* tv) {
+              return getStreamAxis(tv->getLoopDomain()) != nullptr;
+            })) {
+      // A reduction scattering the stream axis of its input joins the
+      // for-loop producing its input, so that each chunk is sent as soon as it
+      // is computed
+      if (IterDomain* stream_axis = getScatteredStreamAxis(expr, id_model);
+          stream_axis != nullptr &&
+          canMergeWithPreviousForLoop(
+              new_top_level_exprs, stream_axis, id_model)) {
+        new_top_level_exprs.back()->as<ForLoop>()->body().push_back(expr);
+        continue;
+      }
       new_top_level_exprs.push_back(expr);
       continue;
     }
@@ -307,6 +351,64 @@ std::vector<Expr*> processForLoopBodies(
     };
 
     for (auto* body_expr : for_loop->body().exprs()) {
+      // Symmetrically to the "Linear Allgather" case below, an axis passing
+      // from Stream to DIDx in a reduction is lowered to one Reduce per chunk,
+      // rooted at the device owning the chunk. This is the "Linear
+      // ReduceScatter" case, where tv0 [Stream(i0), DIDx(i1), ...] and
+      // tv1=sum(tv0, {1}) [DIDx(i0), r(i1), ...]:
+      //
+      // FOR StreamIdx in range(i0):
+      //   [...]
+      //   IF StreamIdx == 0:
+      //     Reduce (in=Tv0[StreamIdx, ...], out=Tv1, root=mesh[0])
+      //   [...]
+      //   IF StreamIdx == i0 - 1:
+      //     Reduce (in=Tv0[StreamIdx, ...], out=Tv1, root=mesh[i0 - 1])
+      //
+      // The chunks are thus visited in the order of their destinations and each
+      // one is reduced while the next one is computed on another stream.
+      if (getScatteredStreamAxis(body_expr, id_model) != nullptr) {
+        auto* reduction = body_expr->as<ReductionOp>();
+        auto* input_tv = reduction->in()->as<TensorView>();
+        auto* output_tv = reduction->out()->as<TensorView>();
+        const DeviceMesh& mesh = output_tv->getDeviceMesh();
+        NVF_ERROR(
+            mesh.rank() == 1,
+            "Reduce only supports a 1D mesh. Given ",
+            mesh);
+
+        auto [slicing_input, is_new] = tensor_slicing_cache.get(
+            input_tv,
+            findStreamAxisIndex(input_tv, for_loop->iterDomain(), id_model),
+            for_loop->index());
+        if (is_new) {
+          new_loop_body.push_back(slicing_input);
+        }
+
+        const Team team = mesh.vector();
+        for (auto&& [chunk_index, root] : enumerate(team)) {
+          auto* is_chunk_of_root = IrBuilder::create<kir::Predicate>(eq(
+              for_loop->index(),
+              IrBuilder::create<Val>(
+                  static_cast<int64_t>(chunk_index), DataType::Int)));
+          auto* if_then_else =
+              IrBuilder::create<kir::IfThenElse>(is_chunk_of_root);
+          auto* reduce = IrBuilder::create<Communication>(
+              CommunicationType::Reduce,
+              output_tv,
+              slicing_input->out(),
+              team,
+              root,
+              getC10dReduceOpType(reduction->getReductionOpType()),
+              CommunicatorBackend::kNccl);
+          if_then_else->thenBody().push_back(reduce);
+          if_then_else->thenBody().push_back(
+              IrBuilder::create<hir::Wait>(reduce));
+          new_loop_body.push_back(if_then_else);
+        }
+        continue;
+      }
+
       // We have a special handling for when an axis pass from DIDx to Stream
       // parallel type in one expression. This case should be lowered to a P2P
       // Communication. For now, we only allow the "Linear Allgather" case,
@@ -54,6 +54,59 @@ void mapThroughLoopSwizzles(ValGraph& graph) {
   }
 }
 
+// Returns the tensor expressions of fusion and all tensors they use,
+// including dangling fusion inputs and outputs
+std::pair<std::vector<Expr*>, std::vector<TensorView*>> getTvExprsAndTvs(
+    Fusion* fusion) {
+  std::vector<Expr*> tv_exprs;
+  auto all_exprs = fusion->exprs();
+  std::copy_if(
+      all_exprs.begin(),
+      all_exprs.end(),
+      std::back_inserter(tv_exprs),
+      [](Expr* expr) {
+        NVF_ERROR(expr != nullptr);
+        return ir_utils::isTvOp(expr);
+      });
+
+  auto all_tvs = ir_utils::allTvsOfExprs(tv_exprs);
+
+  {
+    auto inp_tvs = ir_utils::filterByType<TensorView>(fusion->inputs());
+    all_tvs.pushBack(inp_tvs.begin(), inp_tvs.end());
+  }
+  {
+    auto out_tvs = ir_utils::filterByType<TensorView>(fusion->outputs());
+    all_tvs.pushBack(out_tvs.begin(), out_tvs.end());
+  }
+
+  return {tv_exprs, all_tvs.vector()};
+}
+
+// Map the IterDomains of graph that are registered to be exactly mapped in
+// fusion. Only those that are the same (per sameAs) are registered.
+void mapRegisteredExactMappings(Fusion* fusion, ValGraph& graph) {
+  if (!fusion->hasRegisteredExactMappings()) {
+    return;
+  }
+  DisjointSets<IterDomain*> additional_mappings =
+      fusion->registeredExactMappings();
+  for (const auto& disjoint_set : additional_mappings.disjointSets()) {
+    IterDomain* registerd_id = nullptr;
+    for (auto id : *disjoint_set) {
+      if (!graph.hasGroup(id)) {
+        continue;
+      }
+
+      if (registerd_id == nullptr) {
+        registerd_id = id;
+      } else {
+        graph.mapVals(registerd_id, id);
+      }
+    }
+  }
+}
+
 } // namespace
 
 void IdModel::assertNoSelfMapping(const ValGraph& graph) const {
@@ -122,28 +175,7 @@ IdModel::IdModel(
       validate_(validate),
       loop_promotion_map_builder_callback_(
           loop_promotion_map_builder_callback) {
-  auto all_exprs = fusion->exprs();
-  std::copy_if(
-      all_exprs.begin(),
-      all_exprs.end(),
-      std::back_inserter(tv_exprs_),
-      [](Expr* expr) {
-        NVF_ERROR(expr != nullptr);
-        return ir_utils::isTvOp(expr);
-      });
-
-  auto all_tvs = ir_utils::allTvsOfExprs(tv_exprs_);
-
-  {
-    auto inp_tvs = ir_utils::filterByType<TensorView>(fusion->inputs());
-    all_tvs.pushBack(inp_tvs.begin(), inp_tvs.end());
-  }
-  {
-    auto out_tvs = ir_utils::filterByType<TensorView>(fusion->outputs());
-    all_tvs.pushBack(out_tvs.begin(), out_tvs.end());
-  }
-
-  tvs_ = all_tvs.vector();
+  std::tie(tv_exprs_, tvs_) = getTvExprsAndTvs(fusion);
 
   // Add uses and definitions to all iter domains.
   buildIterDomainDefinitionsAndUses();
@@ -397,27 +429,9 @@ ValGraph& IdModel::buildExactGraph() {
   }
 
   // Map additional exact mappings if registered. Only map those that
-  // appear in this IdModel and when they are the same (per sameAs).
+  // appear in this IdModel.
   if (!tv_exprs_.empty()) {
-    Fusion* fusion = tv_exprs_.front()->fusion();
-    if (fusion->hasRegisteredExactMappings()) {
-      DisjointSets<IterDomain*> additional_mappings =
-          fusion->registeredExactMappings();
-      for (const auto& disjoint_set : additional_mappings.disjointSets()) {
-        IterDomain* registerd_id = nullptr;
-        for (auto id : *disjoint_set) {
-          if (!graph.hasGroup(id)) {
-            continue;
-          }
-
-          if (registerd_id == nullptr) {
-            registerd_id = id;
-          } else {
-            graph.mapVals(registerd_id, id);
-          }
-        }
-      }
-    }
+    mapRegisteredExactMappings(tv_exprs_.front()->fusion(), graph);
   }
 
   graph.validateConsistency();
@@ -1200,6 +1214,161 @@ Expr* IdModel::addReplayAs(std::vector<IterDomain*> new_inputs, Expr* expr) {
   return replay;
 }
 
+bool IdModel::updateWithNewTransforms() {
+  NVF_ERROR(fusion_ != nullptr, "IdModel is not built for a fusion");
+
+  // Tensors and their producer-consumer relationships must be the ones
+  // the graphs were built with
+  auto [tv_exprs, tvs] = getTvExprsAndTvs(fusion_);
+  if (tv_exprs != tv_exprs_ || tvs != tvs_) {
+    return false;
+  }
+
+  // Find the IterDomains that are not yet in the model. Like
+  // buildIterDomainDefinitionsAndUses, a definition is only part of the
+  // model if all of its inputs are domains of the same tensor.
+  std::unordered_set<IterDomain*> live_ids;
+  VectorOfUniqueEntries<IterDomain*> new_ids;
+  VectorOfUniqueEntries<Expr*> new_exprs;
+  for (TensorView* tv : tvs_) {
+    auto is_new = [&](IterDomain* id) { return !id_definitions_.count(id); };
+    if (std::ranges::any_of(tv->getMaybeRootDomain(), is_new) ||
+        std::ranges::any_of(tv->getLogicalDomain(), is_new)) {
+      return false;
+    }
+
+    const std::vector<IterDomain*> all_ids = tv->domain()->allIDs();
+    const std::unordered_set<IterDomain*> all_id_set(
+        all_ids.begin(), all_ids.end());
+    for (IterDomain* id : all_ids) {
+      live_ids.insert(id);
+      Expr* def = id->definition();
+      const bool def_in_model =
+          def != nullptr && std::ranges::all_of(def->inputs(), [&](Val* inp) {
+            return all_id_set.count(inp->as<IterDomain>()) > 0;
+          });
+      auto def_it = id_definitions_.find(id);
+      if (def_it != id_definitions_.end()) {
+        if (def_in_model && !def_it->second.has(def)) {
+          return false;
+        }
+        continue;
+      }
+      if (!def_in_model) {
+        return false;
+      }
+      new_ids.pushBack(id);
+      new_exprs.pushBack(def);
+    }
+  }
+
+  // IterDomains that are no longer used, e.g., replaced loop domains or
+  // replays of loop promotion, would remain mapped in the graphs
+  for (const auto& [id, defs] : id_definitions_) {
+    if (!live_ids.count(id)) {
+      return false;
+    }
+  }
+
+  // Sort the new expressions so that their inputs are registered before
+  // them. All of their outputs must be new domains of the tensors.
+  std::vector<Expr*> sorted_exprs;
+  sorted_exprs.reserve(new_exprs.size());
+  {
+    std::unordered_set<IterDomain*> known_ids = live_ids;
+    for (IterDomain* id : new_ids) {
+      known_ids.erase(id);
+    }
+    std::unordered_set<Expr*> sorted_set;
+    while (std::ssize(sorted_exprs) < new_exprs.size()) {
+      bool progress = false;
+      for (Expr* expr : new_exprs) {
+        if (sorted_set.count(expr)) {
+          continue;
+        }
+        if (std::ranges::any_of(expr->inputs(), [&](Val* inp) {
+              return !known_ids.count(inp->as<IterDomain>());
+            })) {
+          continue;
+        }
+        for (auto out : ir_utils::filterByType<IterDomain>(expr->outputs())) {
+          if (!new_ids.has(out)) {
+            return false;
+          }
+          known_ids.insert(out);
+        }
+        sorted_exprs.push_back(expr);
+        sorted_set.insert(expr);
+        progress = true;
+      }
+      if (!progress) {
+        return false;
+      }
+    }
+  }
+
+  for (Expr* expr : sorted_exprs) {
+    for (auto out_id : ir_utils::filterByType<IterDomain>(expr->outputs())) {
+      id_definitions_.emplace(out_id, VectorOfUniqueEntries<Expr*>{expr});
+      id_uses_.emplace(out_id, VectorOfUniqueEntries<Expr*>{});
+    }
+    for (auto inp_id : ir_utils::filterByType<IterDomain>(expr->inputs())) {
+      id_uses_.at(inp_id).pushBack(expr);
+    }
+  }
+
+  // Same as addReplayAs, but the new expressions are mapped with the
+  // existing uses of their input groups, including each other
+  for (auto mode : {IdMappingMode::EXACT, IdMappingMode::BROADCAST}) {
+    if (!hasIdGraph(mode)) {
+      continue;
+    }
+    ValGraph& graph = idGraph(mode);
+    for (Expr* expr : sorted_exprs) {
+      for (auto out_id : ir_utils::filterByType<IterDomain>(expr->outputs())) {
+        graph.initializeVal(out_id, {}, {});
+      }
+
+      graph.registerExpr(expr);
+
+      VectorOfUniqueEntries<Expr*> representative_uses;
+      for (auto inp : ir_utils::filterByType<IterDomain>(expr->inputs())) {
+        for (const ExprGroup& use_group : graph.getUses(graph.toGroup(inp))) {
+          NVF_ERROR(!use_group->empty());
+          if (!use_group->has(expr)) {
+            representative_uses.pushBack(use_group->front());
+          }
+        }
+      }
+
+      for (auto rep_use : representative_uses) {
+        graph.maybeMapThroughExprs(rep_use, expr, true);
+      }
+    }
+
+    // BROADCAST is built from EXACT, so it inherits these mappings
+    mapThroughLoopSwizzles(graph);
+    mapRegisteredExactMappings(fusion_, graph);
+
+    graph.validateConsistency();
+  }
+
+  if (!allow_self_mapping_ && hasIdGraph(IdMappingMode::EXACT)) {
+    assertNoSelfMapping(idGraph(IdMappingMode::EXACT));
+  }
+
+  for (auto mode : kIdMappingModes) {
+    if (mode != IdMappingMode::EXACT && mode != IdMappingMode::BROADCAST) {
+      removeGraph(mode);
+    }
+  }
+  loop_promotion_map_.clear();
+  loop_index_variable_map_.clear();
+  circular_buffered_loop_index_variable_map_.clear();
+
+  return true;
+}
+
 void IdModel::validateLoopGraphHasNoSelfMappedLeafDomains() const {
   for (auto tv : tvs_) {
     auto self_mappped_loop_pair =
@@ -237,6 +237,18 @@ class IdModel : public PolymorphicBase {
   // replayed expression and adding potential mappings through the expression.
   Expr* addReplayAs(std::vector<IterDomain*> new_inputs, Expr* expr);
 
+  // Adds the IterDomains and expressions appended to the tensors of
+  // the fusion since the graphs were built, e.g., by splits and merges
+  // of a scheduler, to the EXACT and BROADCAST graphs without building
+  // them again. The other graphs depend on the loop domains and
+  // inlining, so they are removed and need to be built again with
+  // maybeBuildGraph.
+  //
+  // Returns false without modifying the model if the fusion changed in
+  // any other way, e.g., a tensor was added or a root or logical domain
+  // was replaced. A new IdModel needs to be built in that case.
+  bool updateWithNewTransforms();
+
   //! Run through disjoint sets in the LOOP graph, make sure there's only one
   //! non-serial parallel type in each disjoint set, set the parallel type of
   //! all IterDomains in the disjoint set to that PType.
@@ -28,6 +28,7 @@
 #include <transform_iter.h>
 #include <transform_replay.h>
 
+#include <limits>
 #include <memory>
 
 namespace nvfuser {
@@ -2212,6 +2213,32 @@ bool shouldUseTensorIndexer(
   return false;
 }
 
+// Rebuilds the additions and multiplications at the top of a global offset
+// with Int32 arithmetic and casts the other subexpressions, e.g., the loop
+// indices and the strides, to Int32. The terms and factors of a non-negative
+// offset are not larger than the offset, so this is safe when the offset fits
+// in Int32. The casts are checked at launch time by validateIndexCasts.
+Val* narrowIndexToInt32(Val* index) {
+  if (index->isConstInt()) {
+    const int64_t value = index->evaluate().as<int64_t>();
+    if (value >= std::numeric_limits<int32_t>::min() &&
+        value <= std::numeric_limits<int32_t>::max()) {
+      return IrBuilder::create<Val>(value, DataType::Int32);
+    }
+  }
+  if (auto bop = dynamic_cast<BinaryOp*>(index->definition())) {
+    if (bop->getBinaryOpType() == BinaryOpType::Add) {
+      return IrBuilder::addExpr(
+          narrowIndexToInt32(bop->lhs()), narrowIndexToInt32(bop->rhs()));
+    }
+    if (bop->getBinaryOpType() == BinaryOpType::Mul) {
+      return IrBuilder::mulExpr(
+          narrowIndexToInt32(bop->lhs()), narrowIndexToInt32(bop->rhs()));
+    }
+  }
+  return IrBuilder::maybeCastExpr(DataType::Int32, index);
+}
+
 } // namespace
 
 // Producer is the inputs of an expression
@@ -2252,6 +2279,11 @@ kir::TensorIndex* Index::getProducerIndex(
         generate_pointer);
   }
 
+  if (!generate_pointer && producer->getMemoryType() == MemoryType::Global &&
+      GpuLower::current()->isInt32Indexed(producer)) {
+    index = narrowIndexToInt32(index);
+  }
+
   index = GpuLower::current()->commonScalarMap().hoistScalar(index, loops);
   if (ir_utils::isLdMatrixOp(consumer->definition()) &&
       at::cuda::getCurrentDeviceProperties()->major < 8) {
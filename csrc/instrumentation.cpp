@@ -6,6 +6,8 @@
  */
 // clang-format on
 #include <instrumentation.h>
+
+#include <cuda_utils.h>
 #include <options.h>
 #include <utils.h>
 
@@ -19,21 +21,52 @@
 namespace nvfuser {
 namespace inst {
 
+namespace {
+
+// Events a thread records before writing them to the file
+constexpr size_t kThreadBufferCapacity = 4096;
+
+// Tracks of the streams are numbered after those of the threads
+constexpr uint32_t kFirstStreamTrack = 1000;
+
+unsigned int processId() {
+#ifdef _WIN32
+  return GetCurrentProcessId();
+#else
+  return getpid();
+#endif // _WIN32
+}
+
+} // namespace
+
+//! A kernel whose events haven't been written to the trace yet
+struct Trace::Kernel {
+  std::string name;
+  int device = 0;
+  //! Track of the stream the kernel was launched on
+  uint32_t track = 0;
+  //! Id of the flow from the launch to the kernel
+  uint64_t id = 0;
+  cudaEvent_t start = nullptr;
+  cudaEvent_t stop = nullptr;
+  bool stopped = false;
+};
+
 Trace::Trace() {
   const char* trace_filename = getNvFuserEnv("TRACE");
   if (trace_filename != nullptr) {
     log_file_ = fopen(trace_filename, "w");
     NVF_CHECK(log_file_ != nullptr, "Can't open trace file");
 
-    // Disable the file stream buffering, since it may result
-    // in torn writes in multi-threaded tracing
-    setbuf(log_file_, nullptr);
-
     // Print the trace prologue
     // (including a dummy TRACE_START event)
     fprintf(log_file_, "{\n\"traceEvents\": [\n");
     start_timestamp_ = Clock::now();
-    logEvent('I', "TRACE_START");
+    fprintf(
+        log_file_,
+        "{ \"name\": \"TRACE_START\", \"ph\": \"I\", \"pid\": %u, "
+        "\"tid\": 0, \"ts\": 0 },\n",
+        processId());
   }
 
   // Note isOptionDisabled could throw an exception, so this
@@ -45,35 +78,224 @@ Trace::Trace() {
 
 Trace::~Trace() {
   if (log_file_ != nullptr) {
+    flushKernels(/*wait=*/true);
+    std::lock_guard<std::mutex> guard(file_mutex_);
+    for (const auto& buffer : thread_buffers_) {
+      flush(*buffer);
+    }
     // Print trace epilogue
-    logEvent('I', "TRACE_END", ' ');
+    fprintf(
+        log_file_,
+        "{ \"name\": \"TRACE_END\", \"ph\": \"I\", \"pid\": %u, "
+        "\"tid\": 0, \"ts\": %.3f }\n",
+        processId(),
+        microseconds(Clock::now()));
     fprintf(log_file_, "],\n\"displayTimeUnit\": \"ms\"\n}\n");
     fclose(log_file_);
   }
 }
 
-void Trace::logEvent(char ph, const char* name, char sep) {
-  const std::chrono::duration<double> d = Clock::now() - start_timestamp_;
-  const double elapsed = d.count() * 1e6;
+double Trace::microseconds(Clock::time_point timestamp) const {
+  return std::chrono::duration<double, std::micro>(
+             timestamp - start_timestamp_)
+      .count();
+}
 
-#ifdef _WIN32
-  const unsigned int pid = GetCurrentProcessId();
-  const unsigned int tid = GetCurrentThreadId();
-#else
-  const unsigned int pid = getpid();
-  const unsigned int tid = std::hash<pthread_t>{}(pthread_self());
-#endif // _WIN32
+Trace::ThreadBuffer& Trace::threadBuffer() {
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> guard(file_mutex_);
+    auto& new_buffer =
+        thread_buffers_.emplace_back(std::make_unique<ThreadBuffer>());
+    new_buffer->tid = static_cast<uint32_t>(thread_buffers_.size());
+    new_buffer->events.reserve(kThreadBufferCapacity);
+    fprintf(
+        log_file_,
+        "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %u, "
+        "\"tid\": %u, \"args\": { \"name\": \"Thread %u\" } },\n",
+        processId(),
+        new_buffer->tid,
+        new_buffer->tid);
+    buffer = new_buffer.get();
+  }
+  return *buffer;
+}
+
+void Trace::logEvent(char ph, const char* name, uint64_t id) {
+  ThreadBuffer& buffer = threadBuffer();
+  buffer.events.push_back({name, ph, Clock::now(), id});
+  if (buffer.events.size() >= kThreadBufferCapacity) {
+    std::lock_guard<std::mutex> guard(file_mutex_);
+    flush(buffer);
+  }
+}
+
+void Trace::flush(ThreadBuffer& buffer) {
+  const unsigned int pid = processId();
+  for (const Event& event : buffer.events) {
+    if (event.ph == 's') {
+      fprintf(
+          log_file_,
+          "{ \"name\": \"%s\", \"cat\": \"launch\", \"ph\": \"s\", "
+          "\"id\": %llu, \"pid\": %u, \"tid\": %u, \"ts\": %.3f },\n",
+          event.name,
+          static_cast<unsigned long long>(event.id),
+          pid,
+          buffer.tid,
+          microseconds(event.timestamp));
+      continue;
+    }
+    fprintf(
+        log_file_,
+        "{ \"name\": \"%s\", \"ph\": \"%c\", \"pid\": %u, \"tid\": %u, "
+        "\"ts\": %.3f },\n",
+        event.name != nullptr ? event.name : "",
+        event.ph,
+        pid,
+        buffer.tid,
+        microseconds(event.timestamp));
+  }
+  buffer.events.clear();
+}
+
+uint32_t Trace::streamTrack(int device, cudaStream_t stream) {
+  auto [it, inserted] = stream_tracks_.try_emplace(
+      stream, kFirstStreamTrack + static_cast<uint32_t>(stream_tracks_.size()));
+  if (inserted) {
+    std::lock_guard<std::mutex> guard(file_mutex_);
+    fprintf(
+        log_file_,
+        "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %u, "
+        "\"tid\": %u, \"args\": { \"name\": \"GPU %d stream %p\" } },\n",
+        processId(),
+        it->second,
+        device,
+        static_cast<void*>(stream));
+  }
+  return it->second;
+}
+
+Trace::Kernel* Trace::beginKernel(std::string name, cudaStream_t stream) {
+  if (log_file_ == nullptr) {
+    return nullptr;
+  }
+  auto kernel = std::make_unique<Kernel>();
+  kernel->name = std::move(name);
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaGetDevice(&kernel->device));
+
+  std::lock_guard<std::mutex> guard(kernel_mutex_);
+  auto [it, inserted] = device_clocks_.try_emplace(kernel->device);
+  DeviceClock& clock = it->second;
+  if (inserted) {
+    // Synchronizes once per device, so that the clock event completes right
+    // after the host timestamp
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaStreamSynchronize(stream));
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&clock.event));
+    clock.timestamp = Clock::now();
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(clock.event, stream));
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventSynchronize(clock.event));
+  }
+
+  kernel->track = streamTrack(kernel->device, stream);
+  kernel->id = next_kernel_id_++;
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&kernel->start));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&kernel->stop));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(kernel->start, stream));
+  logEvent('s', "launch", kernel->id);
+  return pending_kernels_.emplace_back(std::move(kernel)).get();
+}
+
+void Trace::endKernel(Kernel* kernel, cudaStream_t stream) {
+  if (kernel == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(kernel_mutex_);
+    // If the stop event can't be recorded, e.g., because the launch failed,
+    // its elapsed time can't be computed and the kernel is dropped
+    if (cudaEventRecord(kernel->stop, stream) != cudaSuccess) {
+      (void)cudaGetLastError();
+    }
+    kernel->stopped = true;
+  }
+  flushKernels(/*wait=*/false);
+}
+
+void Trace::flushKernels(bool wait) {
+  std::lock_guard<std::mutex> guard(kernel_mutex_);
+  const unsigned int pid = processId();
+  std::erase_if(pending_kernels_, [&](const std::unique_ptr<Kernel>& kernel) {
+    if (!kernel->stopped) {
+      return false;
+    }
+    // At exit, the CUDA runtime may already be unloaded, in which case the
+    // pending kernels are dropped
+    cudaError_t status = wait ? cudaEventSynchronize(kernel->stop)
+                              : cudaEventQuery(kernel->stop);
+    if (status == cudaErrorNotReady) {
+      return false;
+    }
+    const DeviceClock& clock = device_clocks_.at(kernel->device);
+    float start_ms = 0.0f;
+    float stop_ms = 0.0f;
+    if (status == cudaSuccess &&
+        cudaEventElapsedTime(&start_ms, clock.event, kernel->start) ==
+            cudaSuccess &&
+        cudaEventElapsedTime(&stop_ms, clock.event, kernel->stop) ==
+            cudaSuccess) {
+      const double start_us =
+          microseconds(clock.timestamp) + static_cast<double>(start_ms) * 1e3;
+      const double duration_us = static_cast<double>(stop_ms - start_ms) * 1e3;
+      std::lock_guard<std::mutex> file_guard(file_mutex_);
+      fprintf(
+          log_file_,
+          "{ \"name\": \"%s\", \"ph\": \"X\", \"pid\": %u, \"tid\": %u, "
+          "\"ts\": %.3f, \"dur\": %.3f },\n",
+          kernel->name.c_str(),
+          pid,
+          kernel->track,
+          start_us,
+          duration_us);
+      fprintf(
+          log_file_,
+          "{ \"name\": \"launch\", \"cat\": \"launch\", \"ph\": \"f\", "
+          "\"bp\": \"e\", \"id\": %llu, \"pid\": %u, \"tid\": %u, "
+          "\"ts\": %.3f },\n",
+          static_cast<unsigned long long>(kernel->id),
+          pid,
+          kernel->track,
+          start_us);
+    }
+    (void)cudaGetLastError();
+    cudaEventDestroy(kernel->start);
+    cudaEventDestroy(kernel->stop);
+    return true;
+  });
+}
+
+TraceAggregator::TraceAggregator() {
+  TraceAggregator* expected = nullptr;
+  NVF_CHECK(
+      Trace::instance()->aggregator_.compare_exchange_strong(expected, this),
+      "Another TraceAggregator is alive");
+}
+
+TraceAggregator::~TraceAggregator() {
+  Trace::instance()->aggregator_.store(nullptr);
+}
+
+double TraceAggregator::seconds(const std::string& name) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = durations_.find(name);
+  if (it == durations_.end()) {
+    return 0.0;
+  }
+  return std::chrono::duration<double>(it->second).count();
+}
 
-  fprintf(
-      log_file_,
-      "{ \"name\": \"%s\", \"ph\": \"%c\", \"pid\": %u, \"tid\": %u, \"ts\": "
-      "%.0f }%c\n",
-      name,
-      ph,
-      pid,
-      tid,
-      elapsed,
-      sep);
+void TraceAggregator::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  durations_.clear();
 }
 
 } // namespace inst
@@ -10,16 +10,25 @@
 #include <exceptions.h>
 #include <utils.h>
 
+#include <cuda_runtime.h>
 #include <nvtx3/nvToolsExt.h>
 
 // NOLINTNEXTLINE(modernize-deprecated-headers)
 #include <stdio.h>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace nvfuser {
 namespace inst {
 
+class TraceAggregator;
+
 //! An optional record of selected timestamped operations, events and counters
 //!
 //! This class is not intended to be used directly. Instead, the operations
@@ -34,18 +43,34 @@ namespace inst {
 //! https://chromium.googlesource.com/catapult/+/HEAD/tracing/README.md
 //!
 //! An easy way to view traces is to type `about://tracing` in Chrome or
-//! Chromium.
+//! Chromium, or to open them in https://ui.perfetto.dev.
+//!
+//! Each thread records its events into its own buffer, written to the file
+//! when it fills up and when the process exits, so that threads compiling in
+//! parallel neither contend on the file nor interleave partial events. Each
+//! thread has its own track, numbered in the order the threads first record
+//! an event.
+//!
+//! Kernels launched while tracing are timed with CUDA events and shown on a
+//! track per stream, on the same timeline as the host events and linked to
+//! the host scope that launched them with a flow arrow.
 //!
 class Trace : public NonCopyable {
  public:
   using Clock = std::chrono::steady_clock;
 
+  struct Kernel;
+
  public:
   NVF_API static Trace* instance() {
     static Trace trace;
     return &trace;
   }
 
+  bool isEnabled() const {
+    return log_file_ != nullptr;
+  }
+
   void beginEvent(const char* name) {
     if (log_file_ != nullptr) {
       logEvent('B', name);
@@ -64,16 +89,105 @@ class Trace : public NonCopyable {
     }
   }
 
+  //! Records the start of a kernel launched on stream, or returns nullptr if
+  //! not tracing
+  NVF_API Kernel* beginKernel(std::string name, cudaStream_t stream);
+
+  //! Records the end of the kernel, which is written to the trace once its
+  //! events complete, without synchronizing
+  NVF_API void endKernel(Kernel* kernel, cudaStream_t stream);
+
+  //! The aggregator that events are added to, if any
+  TraceAggregator* aggregator() const {
+    return aggregator_.load(std::memory_order_relaxed);
+  }
+
  private:
+  friend class TraceAggregator;
+
   NVF_API Trace();
   NVF_API ~Trace();
 
-  NVF_API void logEvent(char ph, const char* name, char sep = ',');
+  struct Event {
+    //! Written after the event is recorded, so names must be string
+    //! literals, like those of FUSER_PERF_SCOPE
+    const char* name;
+    char ph;
+    Clock::time_point timestamp;
+    //! Id of flow events
+    uint64_t id = 0;
+  };
+
+  //! Events recorded by a thread, owned by the Trace so that they are
+  //! written even if the thread exits before the process does
+  struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::vector<Event> events;
+  };
+
+  //! Timestamp of an event recorded on a device at a known host time, to
+  //! place the kernels of the device on the host timeline
+  struct DeviceClock {
+    cudaEvent_t event = nullptr;
+    Clock::time_point timestamp;
+  };
+
+  NVF_API void logEvent(char ph, const char* name, uint64_t id = 0);
+
+  ThreadBuffer& threadBuffer();
+
+  //! Writes the events of buffer to the file and clears them
+  void flush(ThreadBuffer& buffer);
+
+  //! Writes the kernels whose events have completed. If `wait`, waits for
+  //! all of them to complete.
+  void flushKernels(bool wait);
+
+  double microseconds(Clock::time_point timestamp) const;
+
+  //! Returns the track of stream on device, naming it on first use
+  uint32_t streamTrack(int device, cudaStream_t stream);
 
  private:
   FILE* log_file_ = nullptr;
   Clock::time_point start_timestamp_;
   bool record_nvtx_range_ = true;
+  std::atomic<TraceAggregator*> aggregator_{nullptr};
+
+  //! Guards log_file_ and the thread buffers
+  std::mutex file_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+
+  //! Guards the kernels and the tracks of the streams
+  std::mutex kernel_mutex_;
+  std::vector<std::unique_ptr<Kernel>> pending_kernels_;
+  std::unordered_map<int, DeviceClock> device_clocks_;
+  std::unordered_map<cudaStream_t, uint32_t> stream_tracks_;
+  uint64_t next_kernel_id_ = 1;
+};
+
+//! Sums up the time spent in each perf marker while it is alive, e.g., to
+//! break the host latency of a call down into stages in a benchmark. The
+//! time of a marker includes the time of the markers nested in it. Only one
+//! aggregator can be alive at a time.
+class TraceAggregator : public NonCopyable {
+ public:
+  NVF_API TraceAggregator();
+  NVF_API ~TraceAggregator();
+
+  void add(const char* name, Trace::Clock::duration duration) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    durations_[name] += duration;
+  }
+
+  //! Returns the total time in seconds spent in the markers named `name`
+  NVF_API double seconds(const std::string& name) const;
+
+  NVF_API void clear();
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Trace::Clock::duration> durations_;
 };
 
 //! \internal Automatic scope for a perf marker
@@ -81,15 +195,43 @@ class Trace : public NonCopyable {
 class TraceScope : public NonCopyable {
  public:
   explicit TraceScope(const char* event_name) : event_name_(event_name) {
-    Trace::instance()->beginEvent(event_name_);
+    Trace* trace = Trace::instance();
+    trace->beginEvent(event_name_);
+    if (trace->aggregator() != nullptr) {
+      start_ = Trace::Clock::now();
+    }
   }
 
   ~TraceScope() {
-    Trace::instance()->endEvent(event_name_);
+    Trace* trace = Trace::instance();
+    TraceAggregator* aggregator = trace->aggregator();
+    if (aggregator != nullptr && start_ != Trace::Clock::time_point()) {
+      aggregator->add(event_name_, Trace::Clock::now() - start_);
+    }
+    trace->endEvent(event_name_);
   }
 
  private:
   const char* event_name_ = nullptr;
+  Trace::Clock::time_point start_;
+};
+
+//! Shows a kernel launched on stream while it is alive on the track of the
+//! stream, if tracing. Constructed around the launch only.
+class KernelTraceScope : public NonCopyable {
+ public:
+  KernelTraceScope(std::string kernel_name, cudaStream_t stream)
+      : stream_(stream) {
+    kernel_ = Trace::instance()->beginKernel(std::move(kernel_name), stream);
+  }
+
+  ~KernelTraceScope() {
+    Trace::instance()->endKernel(kernel_, stream_);
+  }
+
+ private:
+  cudaStream_t stream_;
+  Trace::Kernel* kernel_;
 };
 
 #define FUSER_MACRO_CONCAT2(a, b) a##b
@@ -10,6 +10,7 @@
 
 #include <exceptions.h>
 #include <interval_analysis.h>
+#include <ir/utils.h>
 #include <kernel_ir_dispatch.h>
 
 #include <algorithm>
@@ -469,6 +470,14 @@ void ScalarBoundsCalculator::dispatch(Val* val) {
 }
 
 void ScalarBoundsCalculator::dispatch(Expr* expr) {
+  // The narrowed offsets of 32-bit indexed inputs are not hoisted if they are
+  // only used once, so look for their casts in the TensorIndex
+  for (Val* inp : expr->inputs()) {
+    if (auto ti = dynamic_cast<kir::TensorIndex*>(inp);
+        ti != nullptr && ti->index()->dtype() == DataType::Int32) {
+      dispatch(ti->index());
+    }
+  }
   if (auto* uop = dynamic_cast<UnaryOp*>(expr)) {
     if (uop->getUnaryOpType() == UnaryOpType::ToUnsignedSmemAddr) {
       // This is a workaround for a limitation in being able to evaluate
@@ -550,6 +559,19 @@ void ScalarBoundsCalculator::handle(ForLoop* loop) {
   BoundedInt start = bounds_.at(loop->start());
   BoundedInt stop = bounds_.at(loop->stop());
   setBounds(loop->index(), start.min, stop.max - 1L);
+  // Scalars incremented at the end of the loop body by strengthReduceIndices
+  // are initialized before the loop and take init + index * step inside it
+  for (auto inc :
+       ir_utils::filterByType<kir::IncrementScalar>(loop->body().exprs())) {
+    std::optional<BoundedInt> init = maybeGetBounds(inc->value());
+    std::optional<BoundedInt> step = maybeGetBounds(inc->step());
+    if (init.has_value() && step.has_value()) {
+      setBounds(
+          inc->value(), *init + bounds_.at(loop->index()) * *step);
+    } else {
+      setAsUnbounded(inc->value());
+    }
+  }
   kir::IrVisitor::handle(loop);
 }
 
@@ -19,16 +19,27 @@ void swap(IrContainer& a, IrContainer& b) noexcept {
 
   using std::swap;
 
-  // Swap the content
-  swap(a.vals_up_, b.vals_up_);
+  // Swap the content. The statements, including the shortcuts, live in the
+  // arena, so they go with it.
+  swap(a.arena_, b.arena_);
+  swap(a.arena_bytes_, b.arena_bytes_);
+
+  swap(a.deterministic_vals_, b.deterministic_vals_);
   swap(a.vals_, b.vals_);
 
-  swap(a.exprs_up_, b.exprs_up_);
+  swap(a.deterministic_exprs_, b.deterministic_exprs_);
   swap(a.exprs_, b.exprs_);
 
   swap(a.val_type_name_map_, b.val_type_name_map_);
   swap(a.expr_name_counter_, b.expr_name_counter_);
 
+  swap(a.true_val_, b.true_val_);
+  swap(a.false_val_, b.false_val_);
+  swap(a.one_val_, b.one_val_);
+  swap(a.zero_val_, b.zero_val_);
+  swap(a.magic_zero_val_, b.magic_zero_val_);
+  swap(a.axioms_, b.axioms_);
+
   swap(a.metadata_, b.metadata_);
 
   // Fixup the Statement::fusion_ links for a
@@ -133,47 +144,49 @@ void IrContainer::registerExpr(IrBuilderPasskey, Expr* expr) {
   registerExpr(expr);
 }
 
+void IrContainer::destroyStmt(Statement* stmt) noexcept {
+  stmt->~Statement();
+}
+
 void IrContainer::removeExpr(Expr* expr) {
   NVF_ERROR(
       exprs_.find(expr) != exprs_.end(),
       "Wanted to remove an expression but it doesn't exist in this container.");
-  auto expr_in_deque = std::find_if(
-      exprs_up_.begin(),
-      exprs_up_.end(),
-      [expr](std::unique_ptr<Expr>& expr_up) { return expr_up.get() == expr; });
+  auto expr_in_deque = std::find(
+      deterministic_exprs_.begin(), deterministic_exprs_.end(), expr);
 
   NVF_ERROR(
-      expr_in_deque != exprs_up_.end(),
-      "Wanted to remove an expression but its unique ptr is missing.");
+      expr_in_deque != deterministic_exprs_.end(),
+      "Wanted to remove an expression but it's missing from the ordered "
+      "exprs.");
 
   exprs_.erase(expr);
-  exprs_up_.erase(expr_in_deque);
+  deterministic_exprs_.erase(expr_in_deque);
+  destroyStmt(expr);
 }
 
 //! Completely remove val from the fusion, break all dependencies associated
 //! with it
 void IrContainer::removeVal(Val* val) {
   // Don't remove shortcuts
-  if (val == true_val_.get() || val == false_val_.get() ||
-      val == one_val_.get() || val == zero_val_.get() ||
-      val == magic_zero_val_.get()) {
+  if (val == true_val_ || val == false_val_ || val == one_val_ ||
+      val == zero_val_ || val == magic_zero_val_) {
     return;
   }
 
   NVF_ERROR(
       vals_.find(val) != vals_.end(),
       "Wanted to remove a value but it doesn't exist in this container.");
-  auto val_in_deque = std::find_if(
-      vals_up_.begin(), vals_up_.end(), [val](std::unique_ptr<Val>& val_up) {
-        return val_up.get() == val;
-      });
+  auto val_in_deque =
+      std::find(deterministic_vals_.begin(), deterministic_vals_.end(), val);
 
   NVF_ERROR(
-      val_in_deque != vals_up_.end(),
-      "Wanted to remove a value but its unique ptr is missing.");
+      val_in_deque != deterministic_vals_.end(),
+      "Wanted to remove a value but it's missing from the ordered vals.");
 
   vals_.erase(val);
-  vals_up_.erase(val_in_deque);
+  deterministic_vals_.erase(val_in_deque);
+  destroyStmt(val);
 }
 
 //! Register the Val with this container
@@ -182,7 +195,7 @@ void IrContainer::registerVal(Val* val) {
     return;
   }
 
-  vals_up_.emplace_back(val);
+  deterministic_vals_.push_back(val);
   vals_.insert(val);
   val->setName(IrContainerPasskey(), getValName(val->vtype()));
 }
@@ -192,17 +205,36 @@ void IrContainer::registerExpr(Expr* expr) {
   if (inContainer(expr)) {
     return;
   }
-  exprs_up_.emplace_back(expr);
+  deterministic_exprs_.push_back(expr);
   exprs_.insert(expr);
   expr->setName(IrContainerPasskey(), getExprName());
 }
 
 void IrContainer::clear() noexcept {
   FUSER_PERF_SCOPE("IrContainer clear");
+  for (Expr* expr : deterministic_exprs_) {
+    destroyStmt(expr);
+  }
+  for (Val* val : deterministic_vals_) {
+    destroyStmt(val);
+  }
+  auto destroy_shortcut = [](auto*& shortcut) {
+    if (shortcut != nullptr) {
+      destroyStmt(shortcut);
+      shortcut = nullptr;
+    }
+  };
+  destroy_shortcut(true_val_);
+  destroy_shortcut(false_val_);
+  destroy_shortcut(one_val_);
+  destroy_shortcut(zero_val_);
+  destroy_shortcut(magic_zero_val_);
   vals_.clear();
-  vals_up_.clear();
+  deterministic_vals_.clear();
   exprs_.clear();
-  exprs_up_.clear();
+  deterministic_exprs_.clear();
+  arena_->release();
+  arena_bytes_ = 0;
   axioms_.reset();
   val_type_name_map_.clear();
   metadata_.clear();
@@ -246,11 +278,11 @@ Val* IrContainer::zeroVal() {
   if (!zero_val_) {
     auto zero_val =
         IrBuilder::createInContainer<Val>(this, 0L, DataType::Index);
-    NVF_ERROR(vals_up_.back().get() == zero_val);
-    zero_val_ = std::unique_ptr<Val>(vals_up_.back().release());
-    vals_up_.pop_back();
+    NVF_ERROR(deterministic_vals_.back() == zero_val);
+    zero_val_ = zero_val;
+    deterministic_vals_.pop_back();
   }
-  return zero_val_.get();
+  return zero_val_;
 }
 
 Val* IrContainer::zeroVal(DataType dtype) {
@@ -267,11 +299,11 @@ Val* IrContainer::zeroVal(DataType dtype) {
 Val* IrContainer::oneVal() {
   if (!one_val_) {
     auto one_val = IrBuilder::createInContainer<Val>(this, 1L, DataType::Index);
-    NVF_ERROR(vals_up_.back().get() == one_val);
-    one_val_ = std::unique_ptr<Val>(vals_up_.back().release());
-    vals_up_.pop_back();
+    NVF_ERROR(deterministic_vals_.back() == one_val);
+    one_val_ = one_val;
+    deterministic_vals_.pop_back();
   }
-  return one_val_.get();
+  return one_val_;
 }
 
 Val* IrContainer::oneVal(DataType dtype) {
@@ -289,34 +321,33 @@ Val* IrContainer::falseVal() {
   if (!false_val_) {
     auto false_val =
         IrBuilder::createInContainer<Val>(this, false, DataType::Bool);
-    NVF_ERROR(vals_up_.back().get() == false_val);
-    false_val_ = std::unique_ptr<Val>(vals_up_.back().release());
-    vals_up_.pop_back();
+    NVF_ERROR(deterministic_vals_.back() == false_val);
+    false_val_ = false_val;
+    deterministic_vals_.pop_back();
   }
-  return false_val_.get();
+  return false_val_;
 }
 
 Val* IrContainer::trueVal() {
   if (!true_val_) {
     auto true_val =
         IrBuilder::createInContainer<Val>(this, true, DataType::Bool);
-    NVF_ERROR(vals_up_.back().get() == true_val);
-    true_val_ = std::unique_ptr<Val>(vals_up_.back().release());
-    vals_up_.pop_back();
+    NVF_ERROR(deterministic_vals_.back() == true_val);
+    true_val_ = true_val;
+    deterministic_vals_.pop_back();
   }
-  return true_val_.get();
+  return true_val_;
 }
 
 NamedScalar* IrContainer::magicZeroVal() {
   if (!magic_zero_val_) {
     auto magic_zero =
         IrBuilder::create<NamedScalar>(kMagicZeroName, DataType::Index);
-    NVF_ERROR(vals_up_.back().get() == magic_zero);
-    magic_zero_val_ = std::unique_ptr<NamedScalar>(
-        vals_up_.back().release()->as<NamedScalar>());
-    vals_up_.pop_back();
+    NVF_ERROR(deterministic_vals_.back() == magic_zero);
+    magic_zero_val_ = magic_zero;
+    deterministic_vals_.pop_back();
   }
-  return magic_zero_val_.get();
+  return magic_zero_val_;
 }
 
 Val* IrContainer::metadataOf(Val* v) {
@@ -361,33 +392,36 @@ void IrContainer::removeStatementsCreatedAfter(
     int64_t prev_num_exprs,
     int64_t prev_num_vals) {
   NVF_ERROR(
-      exprs_up_.size() == exprs_.size(),
-      "exprs_up_ (size ",
-      exprs_up_.size(),
+      deterministic_exprs_.size() == exprs_.size(),
+      "deterministic_exprs_ (size ",
+      deterministic_exprs_.size(),
       ") and exprs_ (size ",
       exprs_.size(),
       ") are out of sync.");
   NVF_ERROR(
-      std::ssize(exprs_up_) >= prev_num_exprs,
-      "exprs_up_ size (",
-      std::ssize(exprs_up_),
+      std::ssize(deterministic_exprs_) >= prev_num_exprs,
+      "deterministic_exprs_ size (",
+      std::ssize(deterministic_exprs_),
       ") is less than prev_num_exprs (",
       prev_num_exprs,
       ").");
 
   // Remove expressions before values because we need to change Val::uses_.
-  while (std::ssize(exprs_up_) > prev_num_exprs) {
-    Expr* e = exprs_up_.back().get();
+  while (std::ssize(deterministic_exprs_) > prev_num_exprs) {
+    Expr* e = deterministic_exprs_.back();
     for (Val* in : e->inputs()) {
       in->removeUse(e);
     }
     exprs_.erase(e);
-    exprs_up_.pop_back();
+    deterministic_exprs_.pop_back();
+    destroyStmt(e);
   }
 
-  while (std::ssize(vals_up_) > prev_num_vals) {
-    vals_.erase(vals_up_.back().get());
-    vals_up_.pop_back();
+  while (std::ssize(deterministic_vals_) > prev_num_vals) {
+    Val* v = deterministic_vals_.back();
+    vals_.erase(v);
+    deterministic_vals_.pop_back();
+    destroyStmt(v);
   }
 }
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <deque>
+#include <memory_resource>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -52,25 +53,13 @@ class IrContainer : public PolymorphicBase {
   }
 
   //! Return values in insertion order
-  const std::deque<Val*> deterministic_vals() const noexcept {
-    std::deque<Val*> vals_deque;
-    std::transform(
-        vals_up_.begin(),
-        vals_up_.end(),
-        std::back_inserter(vals_deque),
-        [](const std::unique_ptr<Val>& val_up) { return val_up.get(); });
-    return vals_deque;
+  const std::deque<Val*>& deterministic_vals() const noexcept {
+    return deterministic_vals_;
   }
 
   //! Return expression in insertion order
-  const std::deque<Expr*> deterministic_exprs() const noexcept {
-    std::deque<Expr*> exprs_deque;
-    std::transform(
-        exprs_up_.begin(),
-        exprs_up_.end(),
-        std::back_inserter(exprs_deque),
-        [](const std::unique_ptr<Expr>& expr_up) { return expr_up.get(); });
-    return exprs_deque;
+  const std::deque<Expr*>& deterministic_exprs() const noexcept {
+    return deterministic_exprs_;
   }
 
   //! Return mapping from value to integer id
@@ -79,12 +68,10 @@ class IrContainer : public PolymorphicBase {
     std::unordered_map<Val*, int64_t> vals_map;
     int64_t count = 0;
     std::transform(
-        vals_up_.begin(),
-        vals_up_.end(),
+        deterministic_vals_.begin(),
+        deterministic_vals_.end(),
         std::inserter(vals_map, vals_map.end()),
-        [&count](const std::unique_ptr<Val>& val_up) {
-          return std::make_pair(val_up.get(), count++);
-        });
+        [&count](Val* val) { return std::make_pair(val, count++); });
     return vals_map;
   }
 
@@ -94,15 +81,30 @@ class IrContainer : public PolymorphicBase {
     std::unordered_map<Expr*, int64_t> exprs_map;
     int64_t count = 0;
     std::transform(
-        exprs_up_.begin(),
-        exprs_up_.end(),
+        deterministic_exprs_.begin(),
+        deterministic_exprs_.end(),
         std::inserter(exprs_map, exprs_map.end()),
-        [&count](const std::unique_ptr<Expr>& expr_up) {
-          return std::make_pair(expr_up.get(), count++);
-        });
+        [&count](Expr* expr) { return std::make_pair(expr, count++); });
     return exprs_map;
   }
 
+  //! Allocate the storage of a statement of type T from the arena of this
+  //! container. The statement must then be registered with this container,
+  //! which destroys it when it's removed or when the container is cleared.
+  template <class T>
+  void* allocateStmt(IrBuilderPasskey) {
+    arena_bytes_ += (int64_t)sizeof(T);
+    return arena_->allocate(sizeof(T), alignof(T));
+  }
+
+  //! Bytes of the statements allocated from the arena of this container,
+  //! including removed ones, whose storage is only reclaimed when the
+  //! container is cleared. It doesn't count what the statements allocate
+  //! themselves, e.g., the vectors of their inputs.
+  int64_t arenaBytes() const noexcept {
+    return arena_bytes_;
+  }
+
   //! Register the Statement with this container
   NVF_API virtual void registerStmt(IrBuilderPasskey, Statement* stmt);
 
@@ -130,7 +132,8 @@ class IrContainer : public PolymorphicBase {
 
   // When include_shortcuts is true, it will count the shortcuts like true_val_.
   int64_t numVals(bool include_shortcuts) const noexcept {
-    return include_shortcuts ? std::ssize(vals_) : std::ssize(vals_up_);
+    return include_shortcuts ? std::ssize(vals_)
+                             : std::ssize(deterministic_vals_);
   }
 
   // Shortcuts for frequently used vals
@@ -187,6 +190,10 @@ class IrContainer : public PolymorphicBase {
 
   void lazyInitAxioms();
 
+  // Run the destructor of a statement allocated from arena_. Its storage is
+  // only reclaimed when the arena is released.
+  static void destroyStmt(Statement* stmt) noexcept;
+
   friend class StatementGuard;
 
   // A simple garbage collection mechanism to remove all Exprs and Vals that
@@ -199,15 +206,24 @@ class IrContainer : public PolymorphicBase {
       int64_t prev_num_exprs,
       int64_t prev_num_vals);
 
-  // Deque of unique pointer is the memory owning data structure
-  std::deque<std::unique_ptr<Val>> vals_up_;
+  // Bump allocator of all the Vals and Exprs of this container, including the
+  // shortcuts below. Scheduling and lowering create and clone a large number
+  // of small statements, which this keeps out of the global allocator and
+  // close to each other in memory.
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_ =
+      std::make_unique<std::pmr::monotonic_buffer_resource>();
+  // See arenaBytes()
+  int64_t arena_bytes_ = 0;
+
+  // Vals owned by this container in insertion order, excluding the shortcuts
+  std::deque<Val*> deterministic_vals_;
 
   // A convenient set to return when we just need an unordered set to do
   // something like check if a Val is in this container
   std::unordered_set<Val*> vals_;
 
-  // Deque of unique pointer is the memory owning data structure
-  std::deque<std::unique_ptr<Expr>> exprs_up_;
+  // Exprs owned by this container in insertion order
+  std::deque<Expr*> deterministic_exprs_;
 
   // A convenient set to return when we just need an unordered set to do
   // something like check if an Expr is in this container
@@ -227,11 +243,11 @@ class IrContainer : public PolymorphicBase {
   // to know when we're using a different container as in FusionCopy_test
   // demonstrates deleting then creating containers can result in the same
   // pointer for the container.
-  std::unique_ptr<Val> true_val_;
-  std::unique_ptr<Val> false_val_;
-  std::unique_ptr<Val> one_val_;
-  std::unique_ptr<Val> zero_val_;
-  std::unique_ptr<NamedScalar> magic_zero_val_;
+  Val* true_val_ = nullptr;
+  Val* false_val_ = nullptr;
+  Val* one_val_ = nullptr;
+  Val* zero_val_ = nullptr;
+  NamedScalar* magic_zero_val_ = nullptr;
   std::unique_ptr<std::vector<Val*>> axioms_;
   std::unordered_map<Val*, std::pair<Val*, Expr*>> metadata_;
 };
@@ -22,6 +22,8 @@
 
 #include <complex>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <sstream>
 
 //! Nodes in here are intended to be "user facing" users in this sense being
@@ -380,6 +382,8 @@ inline std::ostream& operator<<(
 //! getComputeAtAxis not being const because it can return a TV that some expect
 //! to be non-const is the biggest headache.
 //!
+class AllocationDomainProgram;
+
 class NVF_API TensorView : public Val {
  public:
   TensorView(
@@ -885,6 +889,13 @@ class NVF_API TensorView : public Val {
   }
   void setTMemDimSepPos(int64_t pos);
 
+  //! The replay of the allocation domain from the logical domain last
+  //! compiled by inferAndValidateAllocationSizesAndStrides, if any
+  std::shared_ptr<const AllocationDomainProgram> allocationDomainProgram()
+      const;
+  void setAllocationDomainProgram(
+      std::shared_ptr<const AllocationDomainProgram> program) const;
+
  protected:
   void setDomain(TensorDomain* td) {
     domain_ = td;
@@ -958,6 +969,12 @@ class NVF_API TensorView : public Val {
   // that separates the row and column of tensor memory.
   // See doc/dev/tmem.md for more details.
   int64_t tmem_dim_sep_pos_ = 0;
+
+  //! Not cloned, as it refers to the IterDomains of this tensor. Guarded by
+  //! allocation_program_mutex_ since tensors are evaluated by concurrent
+  //! runs of a kernel.
+  mutable std::shared_ptr<const AllocationDomainProgram> allocation_program_;
+  mutable std::mutex allocation_program_mutex_;
 };
 
 //! A simple TensorView builder
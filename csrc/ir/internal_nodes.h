@@ -989,6 +989,35 @@ class ReductionOp : public Expr {
   bool serialGridReductionRequested() const {
     return attribute<bool>(3);
   }
+
+  //! Split the blocks of each segment of a serial grid reduction into
+  //! num_chains chains of consecutive blocks. Blocks are only serialized
+  //! within a chain, each chain accumulates into its own work buffer, and the
+  //! last block of the segment combines the chains in order, so the result is
+  //! still deterministic.
+  void setSerialGridReductionChains(int64_t num_chains) {
+    NVF_CHECK(num_chains > 0, "Invalid number of chains: ", num_chains);
+    attribute<int64_t>(4) = num_chains;
+  }
+
+  int64_t serialGridReductionChains() const {
+    return attribute<int64_t>(4);
+  }
+
+  //! Scheduling method to request that the blocks of this grid reduction
+  //! combine their partial results in its output with atomics instead of
+  //! reducing them through a work buffer and a grid sync. Only sums and
+  //! maxima into fusion outputs whose reduction axes are all parallelized
+  //! with blockIdx are supported. The output is not initialized by the
+  //! kernel, so it must be set to the init value before the kernel is
+  //! launched. Sums are not deterministic.
+  void requestAtomicGridReduction(bool value = true) {
+    attribute<bool>(5) = value;
+  }
+
+  bool atomicGridReductionRequested() const {
+    return attribute<bool>(5);
+  }
 };
 
 //! Grouped reduction operation for horizontal fusions. It works like
@@ -2588,6 +2617,17 @@ class ForLoop final : public Expr {
     attribute<bool>(5) = true;
   }
 
+  //! Maximum number of iterations unrolled when isUnrolled() is true, which
+  //! emits "#pragma unroll N". Zero means the loop is fully unrolled. Set by
+  //! capUnrollFactors.
+  int64_t maxUnrollFactor() const {
+    return attribute<int64_t>(9);
+  }
+
+  void setMaxUnrollFactor(int64_t factor) {
+    attribute<int64_t>(9) = factor;
+  }
+
   //! True if no actual for-loop is materialized
   bool isTrivial() const;
 
@@ -2926,6 +2966,14 @@ class ArgsortOp : public Expr {
 //!         out[ 0:m, f(i) ] = (mat1[ i, 0:m, 0:k ] * scale1[ i, 0:m, 0:k' ])
 //!                           @(mat2[ 0:k, f(i) ] * scale2[ 0:k', f(i) ])
 //!
+//! Execution: GroupedMmaOp is scheduled by ExprEvalScheduler and evaluated
+//! with at::_grouped_mm or at::_scaled_grouped_mm. These launch one persistent
+//! kernel over all groups whose tile scheduler reads the offsets from device
+//! memory, so group sizes never need to be copied to the host. Epilogues
+//! consuming the output are segmented into a separate kernel. Generating the
+//! grouped kernel ourselves would need loop bounds and operand pointers that
+//! depend on the values of offsets, which the loop nest can't express yet.
+//!
 class GroupedMmaOp : public Expr {
  public:
   using Expr::Expr;
@@ -1564,6 +1564,8 @@ ReductionOp::ReductionOp(
   addDataAttribute(reduction_op_type);
   addDataAttribute(is_allreduce);
   addDataAttribute(false); // serial reduction
+  addDataAttribute(int64_t(1)); // serial reduction chains
+  addDataAttribute(false); // atomic reduction
 }
 
 std::string ReductionOp::toString(int indent_size) const {
@@ -5094,6 +5096,8 @@ ForLoop::ForLoop(
   // Storing IR nodes as Attribute is not safe with IrCloner, but
   // fortunately kernel IR does not need this feature.
   addDataAttribute(Scope(this));
+  // Maximum unroll factor, not capped by default
+  addDataAttribute((int64_t)0);
 }
 
 ForLoop::ForLoop(
@@ -5136,7 +5140,9 @@ ForLoop::ForLoop(IrBuilderPasskey passkey, const ForLoop* other)
           other->vectorize_shift(),
           other->isUnrollRequired(),
           other->circularBufferLoopStage(),
-          other->circularBufferLoopStageDepth()) {}
+          other->circularBufferLoopStageDepth()) {
+  setMaxUnrollFactor(other->maxUnrollFactor());
+}
 
 std::string ForLoop::toString(int indent_size) const {
   std::stringstream ss;
@@ -12,6 +12,7 @@
 #include <ir/utils.h>
 #include <kernel.h>
 #include <kernel_ir_dispatch.h>
+#include <options.h>
 #include <type.h>
 
 #include <ATen/cuda/CUDAContext.h>
@@ -56,6 +57,55 @@ class KernelIrScanner : private IrVisitor {
     return num_grouped_iterations;
   }
 
+  // Marks the tensors whose metadata is used by stmt or the index math it
+  // depends on. Whole metadata structs are copied with their strides, so any
+  // use other than reading another field counts, as do the metadata structs
+  // copied to local variables by hoisted GetMetaData expressions.
+  void findAllocStrideReads(Expr* stmt) {
+    if (auto metadata = dynamic_cast<GetMetaData*>(stmt);
+        metadata != nullptr && metadata->in()->isA<TensorView>()) {
+      summary_.tensors_reading_alloc_stride.insert(
+          metadata->in()->as<TensorView>());
+    }
+    std::vector<Statement*> to_visit{stmt};
+    while (!to_visit.empty()) {
+      Statement* current = to_visit.back();
+      to_visit.pop_back();
+      if (current == nullptr || !visited_.insert(current).second) {
+        continue;
+      }
+      if (auto ti = dynamic_cast<TensorIndex*>(current)) {
+        to_visit.push_back(ti->index());
+      } else if (auto pred = dynamic_cast<Predicate*>(current)) {
+        if (pred->hasValue()) {
+          to_visit.push_back(pred->value());
+        }
+      } else if (auto val = dynamic_cast<Val*>(current)) {
+        to_visit.push_back(val->definition());
+      } else {
+        auto expr = current->as<Expr>();
+        auto gop = dynamic_cast<GetAttr*>(expr);
+        for (Val* in : expr->inputs()) {
+          auto metadata = dynamic_cast<GetMetaData*>(in->definition());
+          if (metadata != nullptr && metadata->in()->isA<TensorView>() &&
+              (gop == nullptr || gop->attr() == "alloc_stride")) {
+            summary_.tensors_reading_alloc_stride.insert(
+                metadata->in()->as<TensorView>());
+          }
+          to_visit.push_back(in);
+        }
+        for (Val* out : expr->outputs()) {
+          to_visit.push_back(out);
+        }
+        for (Statement* attr : expr->attributes()) {
+          if (attr != nullptr && attr->isVal()) {
+            to_visit.push_back(attr);
+          }
+        }
+      }
+    }
+  }
+
   void checkWarpReduction(const Val* out, const Val* in) {
     summary_.all_block_reductions_are_warp_reduction =
         summary_.all_block_reductions_are_warp_reduction &&
@@ -66,6 +116,7 @@ class KernelIrScanner : private IrVisitor {
   using IrVisitor::handle;
   void dispatch(Expr* expr) final {
     IrVisitor::dispatch(expr);
+    findAllocStrideReads(expr);
     for (auto inp : expr->inputs()) {
       dispatch(inp);
     }
@@ -132,6 +183,10 @@ class KernelIrScanner : private IrVisitor {
   void handle(TensorIndex* tensor_index) final {
     const auto tv = tensor_index->view();
     const auto domain = tv->domain();
+    // Offsets of 32-bit indexed inputs cast their terms from Index to Int32
+    if (tensor_index->index()->dtype() == DataType::Int32) {
+      summary_.has_narrowing_index_casts = true;
+    }
     // Do we have any reductions?
     summary_.has_block_reductions =
         summary_.has_block_reductions || domain->hasBlockReduction();
@@ -164,8 +219,11 @@ class KernelIrScanner : private IrVisitor {
     // check if we have a warp reduction
     checkWarpReduction(grouped_rop->output(0), grouped_rop->input(0));
 
-    // skip expr grouped reduction
+    // expr grouped block reductions keep a smem slot per grouped expr
     if (grouped_rop->numHorizontallyGroupedExprs() > 1) {
+      summary_.num_grouped_block_reduction_exprs = std::max(
+          summary_.num_grouped_block_reduction_exprs,
+          (int64_t)grouped_rop->numHorizontallyGroupedExprs());
       return;
     }
     // process iteration grouped reduction
@@ -191,12 +249,19 @@ class KernelIrScanner : private IrVisitor {
 
   void handle(GridReduction* grid_reduction) final {
     // summary.has_grid_reductions is used to determine whether we need a
-    // reduction workspace. Serial grid reductions do not require this
-    // workspace.
+    // reduction workspace. Serial and atomic grid reductions do not require
+    // this workspace.
     summary_.has_grid_reductions =
-        grid_reduction->serialReductionTensor() == nullptr;
+        grid_reduction->serialReductionTensor() == nullptr &&
+        !grid_reduction->isAtomic();
+    if (grid_reduction->isAtomic()) {
+      summary_.atomic_reduction_outputs.emplace(
+          ir_utils::getTvOutput(grid_reduction), grid_reduction->init());
+    }
     summary_.all_block_reductions_are_warp_reduction = false;
-    if (grid_reduction->isAllreduce()) {
+    // Cluster allreduces only synchronize the blocks of a cluster
+    if (grid_reduction->isAllreduce() &&
+        !grid_reduction->isClusterReduction()) {
       summary_.has_cooperative_grid_reduction = true;
     }
   }
@@ -270,6 +335,12 @@ class KernelIrScanner : private IrVisitor {
     summary_.has_topk = true;
   }
 
+  void handle(LoadStoreOp* ldst) final {
+    if (ldst->cacheOp() == CacheOp::NoAllocate) {
+      summary_.has_non_coherent_loads = true;
+    }
+  }
+
   void handle(IfThenElse* ite) final {
     // Search for ElectSync UnaryOp in IfThenElse predicate
     if (ite->predicate()->predicate_type() == PredicateType::ElectSync &&
@@ -283,6 +354,7 @@ class KernelIrScanner : private IrVisitor {
 
  private:
   size_t max_smem_type_size_ = 0;
+  std::unordered_set<Statement*> visited_;
   KernelSummary summary_;
   DataType index_type_;
 };
@@ -388,6 +460,43 @@ class ValidateAllocation : private OptOutConstDispatch {
   std::vector<std::vector<const Allocate*>> live_allocations_;
 };
 
+// The size limit of kernel parameters, which CUDA 12.1 only raises on Volta
+// and newer
+constexpr int64_t kMaxKernelParamBytes = 4096;
+
+// Returns whether the parameters of a kernel are passed through a table in
+// device memory. Each parameter is rounded up to the alignment of pointers,
+// so this overestimates the size of smaller scalars.
+bool usesKernelArgTable(
+    const std::vector<Val*>& params,
+    const KernelSummary& summary,
+    PrimDataType index_type) {
+  int64_t param_bytes = 0;
+  for (Val* param : params) {
+    // TMA descriptors are opaque and must be __grid_constant__ parameters
+    if (std::holds_alternative<OpaqueType>(param->dtype().type)) {
+      return false;
+    }
+    int64_t bytes = 0;
+    auto tv = dynamic_cast<TensorView*>(param);
+    if (tv == nullptr || tv->isCpuScalar()) {
+      bytes = dataTypeSizeByte(param->dtype(), index_type);
+    } else {
+      int64_t dims =
+          std::ssize(TensorDomain::noReductions(tv->getLogicalDomain()));
+      if (summary.tensors_reading_alloc_stride.count(tv)) {
+        dims += std::ssize(
+            TensorDomain::noReductions(tv->getMaybeAllocationDomain()));
+      }
+      bytes = (int64_t)sizeof(void*) +
+          dims * (int64_t)dataTypeSizeByte(index_type);
+    }
+    param_bytes += roundUpToMultiple(bytes, (int64_t)sizeof(void*));
+  }
+  return isOptionEnabled(EnableOption::KernelArgTable) ||
+      param_bytes > kMaxKernelParamBytes;
+}
+
 } // namespace
 
 Kernel::Kernel(Fusion* fusion, PrimDataType index_type)
@@ -410,6 +519,7 @@ void Kernel::finalize(std::vector<Expr*> top_level_exprs) {
   // Make sure this is after analyze as it sets summary_
   summary_.validations = GpuLower::current()->validations();
   summary_.vectorized_accesses = GpuLower::current()->vectorizedAccesses();
+  summary_.tma_multicast_dims = GpuLower::current()->tmaMulticastDims();
   summary_.vectorized_set_info = GpuLower::current()->vectorizedSetInfo();
   summary_.sync_map = GpuLower::current()->syncMap();
   summary_.parallel_dimension_map = GpuLower::current()->parallelDimensionMap();
@@ -418,11 +528,20 @@ void Kernel::finalize(std::vector<Expr*> top_level_exprs) {
   summary_.min_device_version_reason =
       GpuLower::current()->minDeviceVersionReason();
   summary_.dec_inc_register_usage = GpuLower::current()->decIncRegisterUsage();
+  summary_.estimated_instruction_count =
+      GpuLower::current()->estimatedInstructionCount();
   parameters_ = GpuLower::current()->allKnownVals();
   parameters_.insert(parameters_.end(), outputs().begin(), outputs().end());
   for (auto alloc : summary_.global_allocations) {
     parameters_.push_back(alloc->buffer());
   }
+  summary_.uses_kernel_arg_table =
+      usesKernelArgTable(parameters_, summary_, index_type_);
+  // Threads of warp-specialized kernels may return before reaching the wait
+  summary_.uses_programmatic_dependent_launch =
+      isOptionEnabled(EnableOption::ProgrammaticDependentLaunch) &&
+      !summary_.has_cooperative_grid_reduction &&
+      !summary_.circular_buffer_info.hasWarpSpecialized();
 }
 
 void Kernel::analyze() {
@@ -505,6 +624,80 @@ void KernelPerformanceProfile::registerExpr(const Expr* expr) {
   expr_entry_map_.emplace(expr, slot);
 }
 
+const char* KernelPerformanceProfile::stageName(Stage stage) {
+  switch (stage) {
+    case Stage::Kernel:
+      return "Kernel";
+    case Stage::TmaWait:
+      return "TmaWait";
+    case Stage::Mma:
+      return "Mma";
+    case Stage::Epilogue:
+      return "Epilogue";
+  }
+  NVF_THROW("Unknown stage");
+}
+
+void KernelPerformanceProfile::registerStageExpr(
+    const Expr* expr,
+    Stage stage) {
+  NVF_ERROR(stage != Stage::Kernel, "Expressions can't be the whole kernel");
+  if (stage_entry_map_.find(stage) == stage_entry_map_.end()) {
+    stage_entry_map_.emplace(stage, num_profile_entries_);
+    num_profile_entries_ += max_warp_groups;
+  }
+  expr_stage_map_.emplace(expr, stage);
+}
+
+void KernelPerformanceProfile::registerKernelStage() {
+  if (stage_entry_map_.find(Stage::Kernel) == stage_entry_map_.end()) {
+    stage_entry_map_.emplace(Stage::Kernel, num_profile_entries_);
+    num_profile_entries_ += max_warp_groups;
+  }
+}
+
+std::optional<KernelPerformanceProfile::Stage> KernelPerformanceProfile::
+    getStage(const Expr* expr) const {
+  auto it = expr_stage_map_.find(expr);
+  if (it == expr_stage_map_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::optional<int64_t> KernelPerformanceProfile::getStageEntry(
+    Stage stage) const {
+  auto it = stage_entry_map_.find(stage);
+  if (it == stage_entry_map_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::vector<KernelPerformanceProfile::StageCycles> KernelPerformanceProfile::
+    getStageCycles(const at::Tensor& buffer) const {
+  std::vector<StageCycles> stage_cycles;
+  if (!buffer.defined() || stage_entry_map_.empty()) {
+    return stage_cycles;
+  }
+  const at::Tensor cpu_buffer = buffer.cpu();
+  for (const auto& [stage, entry] : stage_entry_map_) {
+    for (auto warp_group : arange(max_warp_groups)) {
+      const auto count = cpu_buffer[entry + warp_group][1].item<int64_t>();
+      // Warp groups not launched have no count
+      if (count == 0) {
+        continue;
+      }
+      stage_cycles.push_back(
+          {stage,
+           warp_group,
+           cpu_buffer[entry + warp_group][0].item<int64_t>(),
+           count});
+    }
+  }
+  return stage_cycles;
+}
+
 int64_t KernelPerformanceProfile::getNewIndex() {
   return num_profile_entries_++;
 }
@@ -559,6 +752,14 @@ std::string KernelPerformanceProfile::toString(const at::Tensor& buffer) const {
        << " us, " << count << "\n";
   }
 
+  for (const StageCycles& stage_cycles : getStageCycles(buffer)) {
+    const auto us = static_cast<double>(stage_cycles.cycles) /
+        (double)gpu_clock_khz * 1000.0;
+    ss << "Stage " << stageName(stage_cycles.stage) << ", warp group "
+       << stage_cycles.warp_group << ", " << us << " us, "
+       << stage_cycles.count << "\n";
+  }
+
   return ss.str();
 }
 
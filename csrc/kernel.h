@@ -21,8 +21,10 @@
 #include <vectorization_info.h>
 #include <visibility.h>
 
+#include <map>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -57,6 +59,11 @@ struct KernelSummary {
   //! grid reductions
   bool has_cooperative_grid_reduction = false;
 
+  //! Outputs of atomic grid reductions and the init values of the
+  //! reductions, which the outputs must be filled with before the kernel is
+  //! launched
+  std::unordered_map<const TensorView*, Val*> atomic_reduction_outputs;
+
   //! Do we have any block broadcasts?
   bool has_block_broadcasts = false;
 
@@ -78,6 +85,9 @@ struct KernelSummary {
   //! number of grouped iters for grouped outer block reduction
   int64_t num_grouped_iterations = 1;
 
+  //! number of grouped exprs for horizontally grouped block reduction
+  int64_t num_grouped_block_reduction_exprs = 1;
+
   //! Do we have any outer grouped grid welford op?
   bool has_outer_grouped_grid_welford = false;
 
@@ -103,6 +113,10 @@ struct KernelSummary {
   //! and their maximum vectorized access size
   std::unordered_map<TensorView*, int64_t> vectorized_accesses;
 
+  //! Cluster dimensions across which the TMA loads into each tensor are
+  //! multicast, see getTmaMulticastDimsMap
+  std::unordered_map<const TensorView*, int64_t> tma_multicast_dims;
+
   // Sync map is needed to figure out if global memory buffers need to be marked
   // as volatile because they're used for communication.
   std::shared_ptr<const SyncMap> sync_map;
@@ -140,13 +154,73 @@ struct KernelSummary {
 
   //! Do we have any topk op?
   bool has_topk = false;
+
+  //! Do we load global memory through the non-coherent path, i.e., with
+  //! CacheOp::NoAllocate? The loaded memory must not be written during the
+  //! launch.
+  bool has_non_coherent_loads = false;
+
+  //! Number of SASS instructions estimated by capUnrollFactors
+  int64_t estimated_instruction_count = 0;
+
+  //! Tensors whose alloc_stride may be read by the kernel. Other tensor
+  //! parameters, e.g., contiguous tensors indexed with their extents, are
+  //! passed without strides as Tensor<T, Dims, 0>, see runtime/tensor.cu.
+  std::unordered_set<const TensorView*> tensors_reading_alloc_stride;
+
+  //! Whether the arguments are passed as a KernelArgs struct in device memory
+  //! with a pointer to it as the only parameter. This is done when the
+  //! parameters would exceed the 4 KB limit, e.g., for fusions with hundreds
+  //! of inputs, unless the kernel takes TMA descriptors, which must be
+  //! parameters.
+  bool uses_kernel_arg_table = false;
+
+  //! Whether the kernel waits for the preceding grid of the stream before
+  //! accessing global memory, so that it can be launched with programmatic
+  //! dependent launch, see EnableOption::ProgrammaticDependentLaunch.
+  //! Cooperative and warp-specialized kernels are launched without it.
+  bool uses_programmatic_dependent_launch = false;
 };
 
 class KernelPerformanceProfile {
  public:
+  //! Stages of warp-specialized kernels, profiled per warp group to show
+  //! pipeline bubbles. Stage::Kernel is the whole kernel, which the cycles of
+  //! the other stages are relative to.
+  enum class Stage { Kernel, TmaWait, Mma, Epilogue };
+
+  //! Warp groups, i.e., groups of 128 threads, profiled per stage. Warp
+  //! groups beyond the last are recorded as the last.
+  static constexpr int64_t max_warp_groups = 8;
+
+  //! Cycles and count of a stage in a warp group, summed over the CTAs
+  struct StageCycles {
+    Stage stage = Stage::Kernel;
+    int64_t warp_group = 0;
+    int64_t cycles = 0;
+    int64_t count = 0;
+  };
+
+  static const char* stageName(Stage stage);
+
   //! Register an expression to profile
   void registerExpr(const Expr* expr);
 
+  //! Register an expression to profile as part of a stage
+  void registerStageExpr(const Expr* expr, Stage stage);
+
+  //! Profile the whole kernel as Stage::Kernel
+  void registerKernelStage();
+
+  //! Get the stage of an expression, if it is profiled as part of one
+  std::optional<Stage> getStage(const Expr* expr) const;
+
+  //! Get the first of the max_warp_groups profile entries of a stage
+  std::optional<int64_t> getStageEntry(Stage stage) const;
+
+  //! Read the cycles of the profiled stages from the backing buffer
+  std::vector<StageCycles> getStageCycles(const at::Tensor& buffer) const;
+
   //! Query if an expression is profiled
   bool isProfiled(const Expr* expr) const;
 
@@ -188,6 +262,12 @@ class KernelPerformanceProfile {
   //! Map profiled expressions to profile entry offsets
   std::unordered_map<const Expr*, int64_t> expr_entry_map_;
 
+  //! Map expressions profiled as part of a stage to the stage
+  std::unordered_map<const Expr*, Stage> expr_stage_map_;
+
+  //! Map profiled stages to their first profile entry
+  std::map<Stage, int64_t> stage_entry_map_;
+
   // TODO: Allow profiling of ForLoops
   //! Map profiled ForLoop to profile entry offsets
   // std::unordered_map<const ForLoop*, int64_t> loop_entry_map_;
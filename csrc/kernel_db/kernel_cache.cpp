@@ -0,0 +1,255 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <kernel_db/kernel_cache.h>
+
+#include <instrumentation.h>
+#include <options.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+
+namespace nvfuser {
+
+namespace {
+
+// Identifies the format of an entry file
+constexpr char entry_magic[] = "NVFKCACHE1";
+constexpr const char* entry_extension = ".kernel";
+
+// FNV-1a is used instead of std::hash so that file names are stable across
+// builds and processes.
+uint64_t fnv1a(const std::string& data, uint64_t basis) {
+  constexpr uint64_t prime = 0x100000001b3ULL;
+  uint64_t hash = basis;
+  for (char c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= prime;
+  }
+  return hash;
+}
+
+// Hash of the key used as the file name
+uint64_t keyHash(const std::string& key) {
+  return fnv1a(key, 0xcbf29ce484222325ULL);
+}
+
+// A second hash of the key stored in the entry to detect collisions of
+// keyHash
+uint64_t keyCheck(const std::string& key) {
+  return fnv1a(key, 0x84222325cbf29ce4ULL) ^ key.size();
+}
+
+void writeU64(std::ostream& out, uint64_t value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+bool readU64(std::istream& in, uint64_t& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return static_cast<bool>(in);
+}
+
+} // namespace
+
+KernelCache::KernelCache(fs::path path, int64_t max_bytes)
+    : path_(std::move(path)), max_bytes_(max_bytes) {
+  NVF_CHECK(max_bytes_ > 0, "Invalid kernel cache size: ", max_bytes_);
+  std::error_code error;
+  fs::create_directories(path_, error);
+  if (error) {
+    TORCH_WARN(
+        "Unable to create nvFuser kernel cache directory ",
+        path_.string(),
+        ": ",
+        error.message());
+  }
+}
+
+KernelCache* KernelCache::get() {
+  if (!isOptionEnabled(EnableOption::KernelCache)) {
+    return nullptr;
+  }
+  static KernelCache cache = []() {
+    constexpr int64_t default_max_mib = 4096;
+    const auto& option_args =
+        getEnableOptionArguments(EnableOption::KernelCache);
+    const int64_t max_mib =
+        option_args.empty() ? default_max_mib : std::stoll(option_args[0]);
+    const char* dir = getNvFuserEnv("KERNEL_CACHE_DIR");
+    fs::path path = dir != nullptr
+        ? fs::path(dir)
+        : fs::temp_directory_path() / "nvfuser_kernel_cache";
+    return KernelCache(std::move(path), max_mib * 1024 * 1024);
+  }();
+  return &cache;
+}
+
+fs::path KernelCache::entryPath(const std::string& key) const {
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << keyHash(key)
+     << entry_extension;
+  return path_ / ss.str();
+}
+
+bool KernelCache::query(
+    const std::string& key,
+    std::string& kernel_name,
+    std::vector<char>& binary) const {
+  FUSER_PERF_SCOPE("KernelCache::query");
+  const fs::path entry_path = entryPath(key);
+  std::ifstream in(entry_path, std::ios::in | std::ios::binary);
+  if (!in) {
+    return false;
+  }
+
+  char magic[sizeof(entry_magic)] = {};
+  in.read(magic, sizeof(entry_magic));
+  if (!in || std::memcmp(magic, entry_magic, sizeof(entry_magic)) != 0) {
+    return false;
+  }
+
+  uint64_t check = 0;
+  uint64_t name_size = 0;
+  uint64_t binary_size = 0;
+  if (!readU64(in, check) || check != keyCheck(key) ||
+      !readU64(in, name_size)) {
+    return false;
+  }
+  std::string name(name_size, '\0');
+  in.read(name.data(), static_cast<std::streamsize>(name_size));
+  if (!in || !readU64(in, binary_size)) {
+    return false;
+  }
+  std::vector<char> data(binary_size);
+  in.read(data.data(), static_cast<std::streamsize>(binary_size));
+  if (!in) {
+    return false;
+  }
+
+  kernel_name = std::move(name);
+  binary = std::move(data);
+
+  // Mark the entry as recently used. Failing to do so only affects eviction.
+  std::error_code error;
+  fs::last_write_time(entry_path, fs::file_time_type::clock::now(), error);
+  return true;
+}
+
+bool KernelCache::write(
+    const std::string& key,
+    const std::string& kernel_name,
+    const std::vector<char>& binary) {
+  FUSER_PERF_SCOPE("KernelCache::write");
+  const fs::path entry_path = entryPath(key);
+
+  // Write to a file private to this writer and rename it into place. Renames
+  // within a directory are atomic, so other processes either see the old
+  // entry, if any, or the complete new one.
+  std::random_device random;
+  std::stringstream suffix;
+  suffix << ".tmp" << std::hex << random() << random();
+  fs::path tmp_path = entry_path;
+  tmp_path += suffix.str();
+  {
+    std::ofstream out(tmp_path, std::ios::out | std::ios::binary);
+    if (!out) {
+      return false;
+    }
+    out.write(entry_magic, sizeof(entry_magic));
+    writeU64(out, keyCheck(key));
+    writeU64(out, kernel_name.size());
+    out.write(kernel_name.data(), (std::streamsize)kernel_name.size());
+    writeU64(out, binary.size());
+    out.write(binary.data(), (std::streamsize)binary.size());
+    out.close();
+    if (!out) {
+      std::error_code error;
+      fs::remove(tmp_path, error);
+      return false;
+    }
+  }
+
+  // A replaced entry no longer counts
+  std::error_code error;
+  const auto replaced_bytes = fs::file_size(entry_path, error);
+  const int64_t entry_bytes = static_cast<int64_t>(
+      sizeof(entry_magic) + 3 * sizeof(uint64_t) + kernel_name.size() +
+      binary.size());
+  fs::rename(tmp_path, entry_path, error);
+  if (error) {
+    fs::remove(tmp_path, error);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (num_bytes_.has_value()) {
+    *num_bytes_ += entry_bytes;
+    if (replaced_bytes != static_cast<std::uintmax_t>(-1)) {
+      *num_bytes_ -= static_cast<int64_t>(replaced_bytes);
+    }
+  }
+  if (!num_bytes_.has_value() || *num_bytes_ > max_bytes_) {
+    evict();
+  }
+  return true;
+}
+
+void KernelCache::evict() {
+  FUSER_PERF_SCOPE("KernelCache::evict");
+  struct Entry {
+    fs::path path;
+    fs::file_time_type time;
+    int64_t num_bytes;
+  };
+  std::vector<Entry> entries;
+  int64_t total_bytes = 0;
+
+  // Other processes may add or remove entries concurrently, so errors on
+  // individual entries are ignored.
+  std::error_code error;
+  for (fs::directory_iterator it(path_, error), end; !error && it != end;
+       it.increment(error)) {
+    const fs::path& path = it->path();
+    if (path.extension() != entry_extension) {
+      continue;
+    }
+    std::error_code entry_error;
+    const auto num_bytes = fs::file_size(path, entry_error);
+    const auto time = fs::last_write_time(path, entry_error);
+    if (entry_error) {
+      continue;
+    }
+    entries.push_back({path, time, static_cast<int64_t>(num_bytes)});
+    total_bytes += static_cast<int64_t>(num_bytes);
+  }
+  num_bytes_ = total_bytes;
+  if (total_bytes <= max_bytes_) {
+    return;
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a.time < b.time;
+  });
+  const int64_t target_bytes = max_bytes_ / 10 * 9;
+  for (const Entry& entry : entries) {
+    if (total_bytes <= target_bytes) {
+      break;
+    }
+    std::error_code remove_error;
+    fs::remove(entry.path, remove_error);
+    total_bytes -= entry.num_bytes;
+  }
+  num_bytes_ = total_bytes;
+}
+
+} // namespace nvfuser
@@ -0,0 +1,91 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <kernel_db/kernel_db.h>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <visibility.h>
+
+namespace nvfuser {
+
+//! KernelCache is a persistent, content-addressed cache of compiled kernels
+//! enabled by EnableOption::KernelCache. Unlike KernelDb, it has no index
+//! file. Each entry is a single file named after a hash of its key, which
+//! callers build from everything that affects the compiled binary, e.g., the
+//! full source code, the NVRTC options and the NVRTC version.
+//!
+//! The cache directory may be shared by many processes. Entries are written
+//! to a temporary file and renamed into place, so readers never observe a
+//! partially written entry, and concurrent writers of the same key just
+//! replace each other's identical entry. A hit refreshes the modification
+//! time of the entry, and a write evicts the least recently used entries
+//! once the directory exceeds its size limit. The size of the directory is
+//! tracked as entries are written, so that it's only scanned by evictions.
+//! Entries written by other processes are counted by the next scan.
+class KernelCache {
+ public:
+  NVF_API KernelCache(fs::path path, int64_t max_bytes);
+
+  //! Returns the cache configured by EnableOption::KernelCache or nullptr if
+  //! the option is not enabled. The directory is NVFUSER_KERNEL_CACHE_DIR if
+  //! set and nvfuser_kernel_cache in the temporary directory otherwise. The
+  //! optional argument of the option is the size limit in MiB (default
+  //! 4096).
+  static KernelCache* get();
+
+  //! Looks up the compiled binary and the name of the kernel function for
+  //! key. Returns false on a miss or if the entry can't be read.
+  NVF_API bool query(
+      const std::string& key,
+      std::string& kernel_name,
+      std::vector<char>& binary) const;
+
+  //! Stores a compiled binary for key. Returns false if the entry can't be
+  //! written.
+  NVF_API bool write(
+      const std::string& key,
+      const std::string& kernel_name,
+      const std::vector<char>& binary);
+
+  //! Path to the file holding the entry for key
+  NVF_API fs::path entryPath(const std::string& key) const;
+
+  const fs::path& path() const {
+    return path_;
+  }
+
+  int64_t maxBytes() const {
+    return max_bytes_;
+  }
+
+ private:
+  //! Removes the least recently used entries until the directory is at most
+  //! 90% of max_bytes_, so that eviction doesn't run on every write. Sets
+  //! num_bytes_ to the size of the remaining entries. Requires mutex_.
+  void evict();
+
+ private:
+  //! Directory holding the entries
+  fs::path path_;
+  //! Size limit of all entries in bytes
+  int64_t max_bytes_ = 0;
+  //! Guards num_bytes_ and evictions, as kernels may be written by multiple
+  //! compilation threads
+  std::mutex mutex_;
+  //! Bytes of all entries, counted by the scan of the first write and of
+  //! each eviction and updated by the writes since
+  std::optional<int64_t> num_bytes_;
+};
+
+} // namespace nvfuser
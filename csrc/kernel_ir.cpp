@@ -125,6 +125,7 @@ TensorIndex::TensorIndex(
   auto uint16x2 = ArrayType{std::make_shared<DataType>(DataType::UInt16), 2};
   NVF_ERROR(
       isPointerType(index->dtype()) || index->dtype() == DataType::Index ||
+          index->dtype() == DataType::Int32 /*For 32-bit indexed inputs*/ ||
           isStructType(index->dtype()) ||
           index->dtype() ==
               DataType::UInt64 /*For matrix descriptor for hopper MMA*/
@@ -730,18 +731,24 @@ NVFUSER_DEFINE_CLONE_AND_CREATE(Return)
 MBarrierInit::MBarrierInit(
     IrBuilderPasskey passkey,
     Val* mbarrier,
-    Val* thread_count)
+    Val* thread_count,
+    std::vector<int64_t> multicast_dims)
     : Expr(passkey) {
   NVF_ERROR(passkey.ir_container_ != nullptr);
   NVF_CHECK(thread_count->dtype() == DataType::UInt32);
   addInput(mbarrier);
   addInput(thread_count);
+  addDataAttribute(std::move(multicast_dims));
 }
 
 std::string MBarrierInit::toString(int indent_size) const {
   std::stringstream ss;
   indent(ss, indent_size) << "MBarrierInit(" << mbarrier()->toString() << ", "
-                          << threadCount()->toString() << ")\n";
+                          << threadCount()->toString();
+  if (!multicastDims().empty()) {
+    ss << ", multicast_dims={" << toDelimitedString(multicastDims()) << "}";
+  }
+  ss << ")\n";
   return ss.str();
 }
 
@@ -773,7 +780,8 @@ NVFUSER_DEFINE_CLONE_AND_CREATE(MBarrierInvalidate)
 MBarrierArrive::MBarrierArrive(
     IrBuilderPasskey passkey,
     Val* state,
-    Val* mbarrier)
+    Val* mbarrier,
+    std::vector<int64_t> multicast_dims)
     : Expr(passkey) {
   NVF_ERROR(passkey.ir_container_ != nullptr);
   addInput(mbarrier);
@@ -781,12 +789,16 @@ MBarrierArrive::MBarrierArrive(
     NVF_CHECK(state->dtype() == DataType::UInt64);
     addOutput(state);
   }
+  addDataAttribute(std::move(multicast_dims));
 }
 
 std::string MBarrierArrive::toString(int indent_size) const {
   std::stringstream ss;
-  indent(ss, indent_size) << "MBarrierArrive(" << mbarrier()->toString()
-                          << ")\n";
+  indent(ss, indent_size) << "MBarrierArrive(" << mbarrier()->toString();
+  if (!multicastDims().empty()) {
+    ss << ", multicast_dims={" << toDelimitedString(multicastDims()) << "}";
+  }
+  ss << ")\n";
   return ss.str();
 }
 
@@ -873,11 +885,14 @@ NVFUSER_DEFINE_CLONE_AND_CREATE(MBarrierWaitParity)
 BlockSerializeWait::BlockSerializeWait(
     IrBuilderPasskey passkey,
     ParallelTypeBitmap sync_dims,
-    Val* sync_buffer)
+    Val* sync_buffer,
+    int64_t num_chains)
     : Expr(passkey) {
   NVF_ERROR(passkey.ir_container_ != nullptr);
+  NVF_ERROR(num_chains > 0, "Invalid number of chains: ", num_chains);
   addDataAttribute(sync_dims);
   addAttribute(sync_buffer);
+  addDataAttribute(num_chains);
 }
 
 std::string BlockSerializeWait::toString(int indent_size) const {
@@ -896,11 +911,14 @@ NVFUSER_DEFINE_CLONE_AND_CREATE(BlockSerializeWait)
 BlockSerializeRelease::BlockSerializeRelease(
     IrBuilderPasskey passkey,
     ParallelTypeBitmap sync_dims,
-    Val* sync_buffer)
+    Val* sync_buffer,
+    int64_t num_chains)
     : Expr(passkey) {
   NVF_ERROR(passkey.ir_container_ != nullptr);
+  NVF_ERROR(num_chains > 0, "Invalid number of chains: ", num_chains);
   addDataAttribute(sync_dims);
   addAttribute(sync_buffer);
+  addDataAttribute(num_chains);
 }
 
 std::string BlockSerializeRelease::toString(int indent_size) const {
@@ -1054,6 +1072,38 @@ std::string UpdateMagicZero::toInlineString(int indent_size) const {
 
 NVFUSER_DEFINE_CLONE_AND_CREATE(UpdateMagicZero)
 
+IncrementScalar::IncrementScalar(
+    IrBuilderPasskey passkey,
+    Val* value,
+    Val* step)
+    : Expr(passkey) {
+  NVF_ERROR(passkey.ir_container_ != nullptr);
+  NVF_ERROR(
+      passkey.ir_container_->isA<kir::Kernel>(),
+      "IR type only valid for Kernel container.");
+  NVF_ERROR(
+      value->isIntegralScalar() && step->isIntegralScalar(),
+      "Only integral scalars can be incremented: ",
+      value->toString(),
+      " += ",
+      step->toString());
+  addAttribute(value);
+  addAttribute(step);
+}
+
+std::string IncrementScalar::toString(int indent_size) const {
+  std::stringstream ss;
+  indent(ss, indent_size) << value()->toString() << " += "
+                          << step()->toInlineString() << ";\n";
+  return ss.str();
+}
+
+std::string IncrementScalar::toInlineString(int indent_size) const {
+  NVF_CHECK(false, "IncrementScalar can not be printed inline");
+}
+
+NVFUSER_DEFINE_CLONE_AND_CREATE(IncrementScalar)
+
 IfThenElse::IfThenElse(IrBuilderPasskey passkey, Predicate* cond)
     : Expr(passkey) {
   setPredicate(cond);
@@ -1092,7 +1142,9 @@ GridReduction::GridReduction(
     Val* entrance_index,
     Val* entrances,
     bool is_allreduce,
-    TensorIndex* serial_reduction_tensor)
+    TensorIndex* serial_reduction_tensor,
+    bool is_cluster_reduction,
+    Val* serial_reduction_chain_stride)
     : ReductionOp(passkey, reduction_op_type, init, out, in, is_allreduce) {
   NVF_ERROR(passkey.ir_container_ != nullptr);
   NVF_ERROR(
@@ -1110,6 +1162,8 @@ GridReduction::GridReduction(
   addAttribute(entrances);
   addDataAttribute(ParallelTypeBitmap{});
   addAttribute(serial_reduction_tensor);
+  addDataAttribute(is_cluster_reduction);
+  addAttribute(serial_reduction_chain_stride);
 }
 
 std::string GridReduction::toString(int indent_size) const {
@@ -1120,10 +1174,15 @@ std::string GridReduction::toString(int indent_size) const {
                           << ", initial value = " << init()->toString()
                           << ",\n";
   ++indent_size;
-  indent(ss, indent_size) << "reduction buffer = "
-                          << reduction_buffer()->buffer()->toString() << ",\n";
-  indent(ss, indent_size) << "sync buffer = "
-                          << sync_buffer()->buffer()->toString() << ",\n";
+  if (reduction_buffer() != nullptr) {
+    indent(ss, indent_size) << "reduction buffer = "
+                            << reduction_buffer()->buffer()->toString()
+                            << ",\n";
+  }
+  if (sync_buffer() != nullptr) {
+    indent(ss, indent_size)
+        << "sync buffer = " << sync_buffer()->buffer()->toString() << ",\n";
+  }
   indent(ss, indent_size) << "read predicate = ";
   if (predicate() != nullptr) {
     ss << predicate()->toString();
@@ -1148,7 +1207,18 @@ std::string GridReduction::toString(int indent_size) const {
     indent(ss, indent_size)
         << "serial reduction tensor = " << serialReductionTensor()->toString()
         << " )\n";
+    if (serialGridReductionChains() > 1) {
+      indent(ss, indent_size)
+          << "serial reduction chains = " << serialGridReductionChains()
+          << ", chain stride = "
+          << serialReductionChainStride()->toInlineString() << " )\n";
+    }
   }
+  indent(ss, indent_size) << "cluster reduction = "
+                          << (isClusterReduction() ? "true" : "false")
+                          << " )\n";
+  indent(ss, indent_size) << "atomic reduction = "
+                          << (isAtomic() ? "true" : "false") << " )\n";
   return ss.str();
 }
 
@@ -1514,7 +1584,8 @@ VectorizedWelfordOp::VectorizedWelfordOp(
     const WelfordTriplet& init,
     Val* count,
     Val* reciprocal_of_count,
-    Val* hoisted_predicate)
+    Val* hoisted_predicate,
+    Val* delta_m2_scale)
     : WelfordOp(passkey, output, input, init, false) {
   NVF_ERROR(passkey.ir_container_ != nullptr);
   NVF_ERROR(
@@ -1523,6 +1594,7 @@ VectorizedWelfordOp::VectorizedWelfordOp(
   addAttribute(count);
   addAttribute(reciprocal_of_count);
   addAttribute(hoisted_predicate);
+  addAttribute(delta_m2_scale);
 }
 
 NVFUSER_DEFINE_CLONE_AND_CREATE(VectorizedWelfordOp)
@@ -56,6 +56,7 @@ class AsyncWait;
 class AsyncCommit;
 class InitMagicZero;
 class UpdateMagicZero;
+class IncrementScalar;
 class IfThenElse;
 class GridReduction;
 class GroupedGridReduction;
@@ -369,7 +370,7 @@ class Allocate final : public Expr {
   //! Instead, if the last thread resets the counter to zero, then the buffer
   //! can be re-used, and at::zeroes need only be run at the first kernel
   //! launch. If resetsToZero() is true, then KernelExecutor will use
-  //! contigZeroedTensor() and releaseZeroedMemory() from global_allocator.h to
+  //! contigZeroedTensor() and resetZeroedMemory() from global_allocator.h to
   //! reuse zeroed memory avoiding the additional kernel launch.
   //!
   //! Whenever possible, we should try to guarantee that resetsToZero() is true
@@ -674,7 +675,8 @@ class MBarrierInit final : public Expr {
   explicit MBarrierInit(
       IrBuilderPasskey passkey,
       Val* mbarrier,
-      Val* thread_count);
+      Val* thread_count,
+      std::vector<int64_t> multicast_dims = {});
 
   NVFUSER_DECLARE_CLONE_AND_CREATE
 
@@ -692,6 +694,14 @@ class MBarrierInit final : public Expr {
   Val* threadCount() const {
     return input(1);
   }
+
+  //! Cluster dimensions, as bitmasks of x, y and z, across which the tiles
+  //! released through this mbarrier are multicast. The mbarrier then also
+  //! expects the arrivals of the blocks multicast to, see
+  //! runtime/mbarrier.cu.
+  const std::vector<int64_t>& multicastDims() const {
+    return attribute<std::vector<int64_t>>(0);
+  }
 };
 
 class MBarrierInvalidate final : public Expr {
@@ -716,7 +726,11 @@ class MBarrierInvalidate final : public Expr {
 class MBarrierArrive final : public Expr {
  public:
   using Expr::Expr;
-  explicit MBarrierArrive(IrBuilderPasskey passkey, Val* state, Val* mbarrier);
+  explicit MBarrierArrive(
+      IrBuilderPasskey passkey,
+      Val* state,
+      Val* mbarrier,
+      std::vector<int64_t> multicast_dims = {});
 
   NVFUSER_DECLARE_CLONE_AND_CREATE
 
@@ -737,6 +751,12 @@ class MBarrierArrive final : public Expr {
   Val* mbarrier() const {
     return input(0);
   }
+
+  //! Cluster dimensions across which the tiles released by this arrive are
+  //! multicast. The blocks multicasting them are then arrived at too.
+  const std::vector<int64_t>& multicastDims() const {
+    return attribute<std::vector<int64_t>>(0);
+  }
 };
 
 // IR node for: mbarrier.arrive.expect_tx
@@ -830,7 +850,9 @@ class MBarrierWaitParity final : public Expr {
 // sync flag to indicate it is our turn to proceed (sync flag is incremented by
 // BlockSerializeRelease). Then block sync. This has the effect of
 // serializing blocks in each reduction segment. This is a block syncing
-// operation.
+// operation. With more than one chain, blocks only wait for the previous
+// block of their chain, and the last block of the segment also waits for all
+// the other chains to finish.
 class BlockSerializeWait final : public Expr {
  public:
   using Expr::Expr;
@@ -838,7 +860,8 @@ class BlockSerializeWait final : public Expr {
   explicit BlockSerializeWait(
       IrBuilderPasskey passkey,
       ParallelTypeBitmap sync_dims,
-      Val* sync_buffer);
+      Val* sync_buffer,
+      int64_t num_chains = 1);
 
   NVFUSER_DECLARE_CLONE_AND_CREATE
 
@@ -856,12 +879,20 @@ class BlockSerializeWait final : public Expr {
   Val* syncBuffer() const {
     return attributeVal(1);
   }
+
+  // Number of chains each reduction segment is split into. See
+  // ReductionOp::setSerialGridReductionChains.
+  int64_t numChains() const {
+    return attribute<int64_t>(2);
+  }
 };
 
 // This first performs a block sync. For all but last block in the reduction
 // segment, first thread then writes the next segment ID to the sync flag. When
 // used with BlockSerializeWait, this has the effect of serializing blocks in
-// order each reduction segment.
+// order each reduction segment. With more than one chain, the sync flag of
+// the chain of the block is incremented instead, and the last block of the
+// segment resets the flags of all chains.
 class BlockSerializeRelease final : public Expr {
  public:
   using Expr::Expr;
@@ -869,7 +900,8 @@ class BlockSerializeRelease final : public Expr {
   explicit BlockSerializeRelease(
       IrBuilderPasskey passkey,
       ParallelTypeBitmap sync_dims,
-      Val* sync_buffer);
+      Val* sync_buffer,
+      int64_t num_chains = 1);
 
   NVFUSER_DECLARE_CLONE_AND_CREATE
 
@@ -887,6 +919,12 @@ class BlockSerializeRelease final : public Expr {
   Val* syncBuffer() const {
     return attributeVal(1);
   }
+
+  // Number of chains each reduction segment is split into. See
+  // ReductionOp::setSerialGridReductionChains.
+  int64_t numChains() const {
+    return attribute<int64_t>(2);
+  }
 };
 
 // AsyncWait represents wait intrinsics for cp.async, cp.async.bulk and
@@ -988,6 +1026,34 @@ class UpdateMagicZero final : public Expr {
   std::string toInlineString(int indent_size = 0) const override;
 };
 
+//! Adds step to an allocated scalar in place, i.e. "value += step;". Used by
+//! strengthReduceIndices to update a hoisted index at the end of each
+//! iteration of a loop. value and step are attributes rather than an output
+//! and an input so that the definition of value is not made cyclic.
+class IncrementScalar final : public Expr {
+ public:
+  using Expr::Expr;
+
+  explicit IncrementScalar(IrBuilderPasskey passkey, Val* value, Val* step);
+
+  NVFUSER_DECLARE_CLONE_AND_CREATE
+
+  const char* getOpString() const override {
+    return "IncrementScalar";
+  }
+
+  std::string toString(int indent_size = 0) const override;
+  std::string toInlineString(int indent_size = 0) const override;
+
+  Val* value() const {
+    return attributeVal(0);
+  }
+
+  Val* step() const {
+    return attributeVal(1);
+  }
+};
+
 //! IfThenElse provides scoping for an boolean operator. Exprs placed in its
 //! body are considered inside the scope of the if statement. In the future the
 //! implementation should look quite different so that we can do proper
@@ -1040,9 +1106,10 @@ class IfThenElse final : public Expr {
 //! reduction and the buffer allocation needed to do it.
 //!
 //! This node provides KernelExecutor the information it needs to allocate the
-//! reduction and sync buffers.
+//! reduction and sync buffers. Serial and cluster reductions don't have these
+//! buffers.
 class GridReduction final : public ReductionOp {
-  static constexpr int num_reduction_op_attr = 4;
+  static constexpr int num_reduction_op_attr = 6;
 
  public:
   using ReductionOp::ReductionOp;
@@ -1058,7 +1125,9 @@ class GridReduction final : public ReductionOp {
       Val* entrance_index,
       Val* entrances,
       bool is_allreduce = false,
-      TensorIndex* serial_reduction_tensor = nullptr);
+      TensorIndex* serial_reduction_tensor = nullptr,
+      bool is_cluster_reduction = false,
+      Val* serial_reduction_chain_stride = nullptr);
 
   NVFUSER_DECLARE_CLONE_AND_CREATE
 
@@ -1069,12 +1138,14 @@ class GridReduction final : public ReductionOp {
   std::string toString(int indent_size = 0) const override;
   std::string toInlineString(int indent_size = 0) const override;
 
+  // nullptr for serial, cluster and atomic reductions
   Allocate* reduction_buffer() const {
-    return attribute(num_reduction_op_attr)->as<Allocate>();
+    return dynamic_cast<Allocate*>(attribute(num_reduction_op_attr));
   }
 
+  // nullptr for serial, cluster and atomic reductions
   Allocate* sync_buffer() const {
-    return attribute(num_reduction_op_attr + 1)->as<Allocate>();
+    return dynamic_cast<Allocate*>(attribute(num_reduction_op_attr + 1));
   }
 
   // Which instance of entering this grid reduction is this iteration?
@@ -1106,6 +1177,24 @@ class GridReduction final : public ReductionOp {
     return serialReductionTensor() != nullptr;
   }
 
+  // The blocks combine their partial results in the output with atomics, see
+  // ReductionOp::requestAtomicGridReduction
+  bool isAtomic() const {
+    return atomicGridReductionRequested();
+  }
+
+  // The blocks of each reduction segment form a thread block cluster and
+  // reduce through distributed shared memory
+  bool isClusterReduction() const {
+    return attribute<bool>(num_reduction_op_attr + 6);
+  }
+
+  // Number of elements of the work buffer of each chain of a chained serial
+  // reduction. nullptr unless serialGridReductionChains() > 1.
+  Val* serialReductionChainStride() const {
+    return attributeVal(num_reduction_op_attr + 7);
+  }
+
   GridReduction* withThreadPredicate(
       const ParallelTypeBitmap& thread_predicate) {
     auto result = shallowCopy()->as<GridReduction>();
@@ -1421,7 +1510,8 @@ class VectorizedWelfordOp final : public WelfordOp {
       const WelfordTriplet& init,
       Val* count,
       Val* reciprocal_of_count,
-      Val* hoisted_predicate);
+      Val* hoisted_predicate,
+      Val* delta_m2_scale = nullptr);
 
   NVFUSER_DECLARE_CLONE_AND_CREATE
 
@@ -1443,6 +1533,14 @@ class VectorizedWelfordOp final : public WelfordOp {
   Val* hoistedPredicate() const {
     return attributeVal(WelfordOp::kNumAttrs + 2);
   }
+
+  //! When merging partial results with a uniform count, the factor
+  //! outN * inN / count of the squared difference of the averages
+  //! added to outVar. reciprocalOfCount() is then inN / count. nullptr
+  //! when each input is a single value.
+  Val* deltaM2Scale() const {
+    return attributeVal(WelfordOp::kNumAttrs + 3);
+  }
 };
 
 // Allocate an instance of the fused reduction class.
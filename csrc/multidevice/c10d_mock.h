@@ -79,6 +79,8 @@ struct ReduceOptions {
   int64_t rootRank = 0;
 };
 
+struct AllToAllOptions {};
+
 struct BarrierOptions {
   std::vector<int64_t> device_ids;
 };
@@ -174,6 +176,15 @@ class Backend : public torch::CustomClassHolder {
     return c10::make_intrusive<Work>();
   }
 
+  c10::intrusive_ptr<Work> alltoall_base(
+      at::Tensor& outputBuffer,
+      at::Tensor& inputBuffer,
+      std::vector<int64_t>& outputSplitSizes,
+      std::vector<int64_t>& inputSplitSizes,
+      const AllToAllOptions& opts = AllToAllOptions()) {
+    return c10::make_intrusive<Work>();
+  }
+
   int getSize() const {
     return 0;
   }
@@ -5,16 +5,21 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 // clang-format on
+#include <ir/allocation_utils.h>
 #include <ir/cloner.h>
 #include <ir/iostream.h>
 #include <ir/printer.h>
 #include <multidevice/communication.h>
 #include <multidevice/utils.h>
+#include <options.h>
 #if defined(NVFUSER_DISTRIBUTED) && defined(USE_C10D_NCCL)
 #include <torch/csrc/distributed/c10d/ProcessGroupNCCL.hpp>
 #endif
 #include <utils.h>
 
+#include <numeric>
+#include <unordered_set>
+
 namespace nvfuser {
 
 std::ostream& operator<<(std::ostream& os, const CommunicationType& type) {
@@ -43,6 +48,9 @@ std::ostream& operator<<(std::ostream& os, const CommunicationType& type) {
     case CommunicationType::SendRecv:
       os << "SendRecv";
       break;
+    case CommunicationType::AllToAll:
+      os << "AllToAll";
+      break;
     default:
       NVF_THROW("unrecognized CommunicationType: ", type);
   }
@@ -84,6 +92,103 @@ void doLocalCopy(const at::Tensor& dst, const at::Tensor& src) {
   dst.view_as(src).copy_(src, /*non_blocking=*/true);
 }
 
+int64_t maxSegmentsPerPeer() {
+  constexpr int64_t default_max_segments = 256;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::StridedCommunication);
+  return option_args.empty() ? default_max_segments
+                             : std::stoll(option_args[0]);
+}
+
+// Returns the first of the innermost dimensions of t that are dense in memory.
+// t is made of dense blocks spanning these dimensions, in row-major order.
+int64_t firstDenseDim(const at::Tensor& t) {
+  int64_t dense_numel = 1;
+  int64_t dim = t.dim();
+  while (dim > 0 &&
+         (t.size(dim - 1) == 1 || t.stride(dim - 1) == dense_numel)) {
+    dense_numel *= t.size(dim - 1);
+    dim--;
+  }
+  return dim;
+}
+
+// Returns the number of elements of the dense blocks of t
+int64_t denseBlockNumel(const at::Tensor& t) {
+  int64_t numel = 1;
+  for (auto dim : arange(firstDenseDim(t), t.dim())) {
+    numel *= t.size(dim);
+  }
+  return numel;
+}
+
+// Same as denseBlockNumel for a tensor of the given sizes allocated as tv.
+// Unlike the strides of the tensor, this is known to the peers of a SendRecv.
+int64_t denseBlockNumel(const TensorView* tv, at::IntArrayRef sizes) {
+  const std::optional<Layout> layout = canonicalizeLayout(tv);
+  if (!layout.has_value() ||
+      TensorDomain::noReductions(layout->allocation_domain()) !=
+          TensorDomain::noReductions(tv->getLogicalDomain())) {
+    // The blocks of a permuted allocation are not in row-major order
+    return 1;
+  }
+  int64_t numel = 1;
+  auto dim = std::ssize(sizes);
+  for (auto i = layout->size() - 1; i >= 0; i--) {
+    if (layout->allocation_domain(i)->isReduction()) {
+      continue;
+    }
+    dim--;
+    if (!layout->contiguity(i).value_or(true)) {
+      break;
+    }
+    numel *= sizes[dim];
+  }
+  return numel;
+}
+
+// Splits t into 1D views of segment_numel elements each, in row-major order.
+// segment_numel must divide the number of elements of the dense blocks of t.
+std::vector<at::Tensor> splitIntoSegments(
+    const at::Tensor& t,
+    int64_t segment_numel) {
+  const int64_t dense_dim = firstDenseDim(t);
+  const int64_t block_numel = denseBlockNumel(t);
+  NVF_ERROR(
+      block_numel % segment_numel == 0,
+      "Segments of ",
+      segment_numel,
+      " elements don't tile dense blocks of ",
+      block_numel,
+      " elements");
+
+  std::vector<at::Tensor> segments;
+  if (t.numel() == 0) {
+    return segments;
+  }
+  segments.reserve(t.numel() / segment_numel);
+  // Index of the current block in the outer dimensions
+  std::vector<int64_t> index(dense_dim, 0);
+  while (true) {
+    int64_t offset = t.storage_offset();
+    for (auto dim : arange(dense_dim)) {
+      offset += index[dim] * t.stride(dim);
+    }
+    for (int64_t i = 0; i < block_numel; i += segment_numel) {
+      segments.push_back(t.as_strided({segment_numel}, {1}, offset + i));
+    }
+
+    int64_t dim = dense_dim - 1;
+    while (dim >= 0 && ++index[dim] == t.size(dim)) {
+      index[dim] = 0;
+      dim--;
+    }
+    if (dim < 0) {
+      return segments;
+    }
+  }
+}
+
 template <typename T>
 T getInitialValue(c10d::ReduceOp::RedOpType op) {
   // TODO: add other ops
@@ -113,6 +218,7 @@ bool hasRoot(CommunicationType type) {
     case CommunicationType::Allgather:
     case CommunicationType::Allreduce:
     case CommunicationType::ReduceScatter:
+    case CommunicationType::AllToAll:
       return false;
     default:
       NVF_THROW("unrecognized CommunicationType: ", type);
@@ -130,6 +236,7 @@ bool isReduction(CommunicationType type) {
     case CommunicationType::Scatter:
     case CommunicationType::Broadcast:
     case CommunicationType::SendRecv:
+    case CommunicationType::AllToAll:
       return false;
     default:
       NVF_THROW("unrecognized CommunicationType: ", type);
@@ -325,6 +432,59 @@ c10::intrusive_ptr<c10d::Work> postGather(
       output_tensors, input_tensors, {.rootRank = root_relative_index});
 }
 
+// Posts an Allgather into strided slices of the output as grouped send/recvs
+// of their dense segments. When the segments are too small, gathers into a
+// contiguous buffer instead and copies it to the slices.
+c10::intrusive_ptr<c10d::Work> postSegmentedAllgather(
+    Communication* communication,
+    DeviceIdxType my_device_index,
+    c10d::Backend* backend,
+    const at::Tensor& input_tensor,
+    const std::vector<at::Tensor>& recv_buffers) {
+  const Team& team = communication->team();
+  assertBuffersHaveSameSize({input_tensor}, recv_buffers);
+  if (input_tensor.numel() == 0) {
+    return nullptr;
+  }
+  const int64_t segment_numel = std::gcd(
+      denseBlockNumel(input_tensor), denseBlockNumel(recv_buffers.at(0)));
+  if (input_tensor.numel() > maxSegmentsPerPeer() * segment_numel) {
+    at::Tensor staging = at::empty(
+        {communication->team_size(), input_tensor.numel()},
+        input_tensor.options());
+    at::Tensor contiguous_input = input_tensor.contiguous();
+    waitOnCurrentStream(backend->_allgather_base(
+        staging.view({-1}), contiguous_input.view({-1}), {}));
+    for (auto&& [peer_index, recv_buffer] : enumerate(recv_buffers)) {
+      doLocalCopy(
+          recv_buffer,
+          staging[static_cast<int64_t>(peer_index)].view(input_tensor.sizes()));
+    }
+    // The copies are ordered on the current stream
+    return nullptr;
+  }
+
+  const std::vector<at::Tensor> send_segments =
+      splitIntoSegments(input_tensor, segment_numel);
+  backend->startCoalescing();
+  for (auto&& [peer_index, recv_buffer] : enumerate(recv_buffers)) {
+    if (team.at(peer_index) == my_device_index) {
+      doLocalCopy(recv_buffer, input_tensor);
+      continue;
+    }
+    const std::vector<at::Tensor> recv_segments =
+        splitIntoSegments(recv_buffer, segment_numel);
+    for (auto&& [send_segment, recv_segment] :
+         zip(send_segments, recv_segments)) {
+      std::vector<at::Tensor> send_tensors = {send_segment};
+      backend->send(send_tensors, static_cast<int>(peer_index), /*tag=*/0);
+      std::vector<at::Tensor> recv_tensors = {recv_segment};
+      backend->recv(recv_tensors, static_cast<int>(peer_index), /*tag=*/0);
+    }
+  }
+  return backend->endCoalescing();
+}
+
 c10::intrusive_ptr<c10d::Work> postAllgather(
     Communication* communication,
     DeviceIdxType my_device_index,
@@ -342,6 +502,26 @@ c10::intrusive_ptr<c10d::Work> postAllgather(
   NVF_ERROR(
       isTvContiguous(communication->out()), "Output tensor is not contiguous");
 
+  // With EnableOption::StridedCommunication, the gathered axis may not be
+  // outermost, in which case the slices of the peers are strided
+  const int64_t gathered_axis =
+      getShardedLogicalAxis(communication->in(), ParallelType::DIDx);
+  if (gathered_axis >= 0) {
+    std::vector<at::Tensor> recv_buffers = at::tensor_split(
+        output_tensor, communication->team_size(), gathered_axis);
+    bool is_outermost = true;
+    for (auto&& [peer_index, recv_buffer] : enumerate(recv_buffers)) {
+      is_outermost = is_outermost && recv_buffer.is_contiguous() &&
+          recv_buffer.storage_offset() ==
+              output_tensor.storage_offset() +
+                  static_cast<int64_t>(peer_index) * recv_buffer.numel();
+    }
+    if (!is_outermost) {
+      return postSegmentedAllgather(
+          communication, my_device_index, backend, input_tensor, recv_buffers);
+    }
+  }
+
   auto flattened_output_tensor =
       output_tensor.as_strided({output_tensor.numel()}, {1});
   auto flattened_input_tensor =
@@ -522,24 +702,169 @@ c10::intrusive_ptr<c10d::Work> postSendRecv(
     return nullptr;
   }
 
-  std::vector<at::Tensor> tensors;
-  if (my_device_index == sender) {
-    tensors = {input_tensor};
-    return backend->send(
-        tensors,
-        static_cast<int>(getRelativeIndex(communication->team(), receiver)),
-        /*tag=*/0);
-  } else {
-    NVF_ERROR(my_device_index == receiver);
-    tensors = {output_tensor};
-    return backend->recv(
-        tensors,
-        static_cast<int>(getRelativeIndex(communication->team(), sender)),
-        /*tag=*/0);
+  const bool is_sender = my_device_index == sender;
+  NVF_ERROR(is_sender || my_device_index == receiver);
+  at::Tensor buffer = is_sender ? input_tensor : output_tensor;
+  const int peer = static_cast<int>(
+      getRelativeIndex(communication->team(), is_sender ? receiver : sender));
+
+  std::vector<at::Tensor> tensors = {buffer};
+  if (isTvContiguous(communication->in()) &&
+      isTvContiguous(communication->out())) {
+    if (is_sender) {
+      return backend->send(tensors, peer, /*tag=*/0);
+    }
+    return backend->recv(tensors, peer, /*tag=*/0);
   }
+
+  // With EnableOption::StridedCommunication, the input or the output may be
+  // non-contiguous. Both peers derive the same segments from the layouts of
+  // the two tensors.
+  if (buffer.numel() == 0) {
+    return nullptr;
+  }
+  const int64_t segment_numel = std::gcd(
+      denseBlockNumel(communication->in(), buffer.sizes()),
+      denseBlockNumel(communication->out(), buffer.sizes()));
+  if (buffer.numel() > maxSegmentsPerPeer() * segment_numel) {
+    // Too many segments: stage the data in a contiguous buffer
+    if (is_sender) {
+      tensors = {buffer.contiguous()};
+      return backend->send(tensors, peer, /*tag=*/0);
+    }
+    tensors = {at::empty_like(buffer, at::MemoryFormat::Contiguous)};
+    waitOnCurrentStream(backend->recv(tensors, peer, /*tag=*/0));
+    buffer.copy_(tensors.front(), /*non_blocking=*/true);
+    // The copy is ordered on the current stream
+    return nullptr;
+  }
+
+  backend->startCoalescing();
+  for (const at::Tensor& segment : splitIntoSegments(buffer, segment_numel)) {
+    tensors = {segment};
+    if (is_sender) {
+      backend->send(tensors, peer, /*tag=*/0);
+    } else {
+      backend->recv(tensors, peer, /*tag=*/0);
+    }
+  }
+  return backend->endCoalescing();
+}
+
+c10::intrusive_ptr<c10d::Work> postAllToAll(
+    Communication* communication,
+    DeviceIdxType my_device_index,
+    c10d::Backend* backend,
+    at::Tensor input_tensor,
+    at::Tensor output_tensor) {
+  NVF_ERROR(
+      isTvContiguous(communication->in()),
+      "Input tensor is not contiguous: ",
+      communication->in(),
+      " contiguity: ",
+      communication->in()->domain()->getContiguityString());
+  NVF_ERROR(
+      isTvContiguous(communication->out()),
+      "Output tensor is not contiguous: ",
+      communication->out(),
+      " contiguity: ",
+      communication->out()->domain()->getContiguityString());
+
+  // The input is scattered along the axis sharded in the output and the
+  // output is gathered along the axis sharded in the input
+  const int64_t scattered_axis =
+      getShardedLogicalAxis(communication->out(), ParallelType::DIDx);
+  const int64_t gathered_axis =
+      getShardedLogicalAxis(communication->in(), ParallelType::DIDx);
+  NVF_ERROR(
+      scattered_axis >= 0 && gathered_axis >= 0,
+      "AllToAll expects both its input and output to be sharded on DIDx: ",
+      communication);
+  const int64_t team_size = communication->team_size();
+  NVF_ERROR(
+      input_tensor.size(scattered_axis) % team_size == 0 &&
+          output_tensor.size(gathered_axis) % team_size == 0,
+      "AllToAll expects the exchanged axes to be divisible by the team size ",
+      team_size,
+      ", but got input ",
+      input_tensor.sizes(),
+      " and output ",
+      output_tensor.sizes());
+
+  // The chunks sent to and received from each peer, stacked in the order of
+  // the team. Moving the chunk index outermost is free when the exchanged
+  // axis is already outermost, and otherwise stages the chunks.
+  at::Tensor send_chunks =
+      input_tensor.unflatten(scattered_axis, {team_size, -1})
+          .movedim(scattered_axis, 0)
+          .contiguous();
+  at::Tensor recv_chunks =
+      output_tensor.unflatten(gathered_axis, {team_size, -1})
+          .movedim(gathered_axis, 0);
+  assertBuffersHaveSameSize({send_chunks}, {recv_chunks});
+
+  std::vector<int64_t> equal_splits;
+  if (recv_chunks.is_contiguous()) {
+    return backend->alltoall_base(
+        recv_chunks, send_chunks, equal_splits, equal_splits);
+  }
+  at::Tensor staging =
+      at::empty_like(recv_chunks, at::MemoryFormat::Contiguous);
+  waitOnCurrentStream(
+      backend->alltoall_base(staging, send_chunks, equal_splits, equal_splits));
+  recv_chunks.copy_(staging, /*non_blocking=*/true);
+  // The copy is ordered on the current stream
+  return nullptr;
 }
 } // namespace
 
+void waitOnCurrentStream(const c10::intrusive_ptr<c10d::Work>& work) {
+  if (work == nullptr) {
+    return;
+  }
+#if defined(NVFUSER_DISTRIBUTED) && defined(USE_C10D_NCCL)
+  // WorkNCCL::synchronize makes the current stream wait for the NCCL stream.
+  // Unlike WorkNCCL::wait, it never blocks the host.
+  if (auto* nccl_work =
+          dynamic_cast<c10d::ProcessGroupNCCL::WorkNCCL*>(work.get())) {
+    nccl_work->synchronize();
+    return;
+  }
+#endif
+  work->wait();
+}
+
+bool isStridedCommunication(const Communication* communication) {
+  switch (communication->type()) {
+    case CommunicationType::SendRecv:
+      return !isTvContiguous(communication->in()) ||
+          !isTvContiguous(communication->out());
+    case CommunicationType::Allgather: {
+      const int64_t gathered_axis =
+          getShardedLogicalAxis(communication->in(), ParallelType::DIDx);
+      if (gathered_axis < 0) {
+        return false;
+      }
+      TensorView* out = communication->out();
+      IterDomain* gathered_id =
+          TensorDomain::noReductions(out->getLogicalDomain()).at(gathered_axis);
+      // Whether an axis of non-trivial size is allocated outside the gathered
+      // axis
+      for (IterDomain* id : out->getMaybeAllocationDomain()) {
+        if (id == gathered_id) {
+          return false;
+        }
+        if (!id->isReduction() && !id->isBroadcast() && !id->isDeviceDim()) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return false;
+  }
+}
+
 c10::intrusive_ptr<c10d::Work> postSingleCommunication(
     Communication* communication,
     DeviceIdxType my_device_index,
@@ -583,6 +908,9 @@ c10::intrusive_ptr<c10d::Work> postSingleCommunication(
     case CommunicationType::SendRecv:
       return postSendRecv(
           communication, my_device_index, backend, input_tensor, output_tensor);
+    case CommunicationType::AllToAll:
+      return postAllToAll(
+          communication, my_device_index, backend, input_tensor, output_tensor);
     default:
       NVF_THROW("Wrong communication type: ", communication->type());
       return nullptr;
@@ -591,6 +919,199 @@ c10::intrusive_ptr<c10d::Work> postSingleCommunication(
 
 namespace {
 
+// Returns the number of devices of the team per NVLink domain if the team
+// consists of runs of the same length of devices from distinct domains, or 0
+int64_t devicesPerDomain(const Team& team, Communicator* communicator) {
+  std::unordered_set<int64_t> domains;
+  int64_t run_length = 0;
+  int64_t devices_per_domain = 0;
+  for (auto i : arange(std::ssize(team))) {
+    const int64_t domain = communicator->nvlinkDomainOf(team[i]);
+    if (i > 0 && domain == communicator->nvlinkDomainOf(team[i - 1])) {
+      run_length++;
+      continue;
+    }
+    if (!domains.insert(domain).second) {
+      return 0;
+    }
+    if (i > 0) {
+      if (devices_per_domain != 0 && run_length != devices_per_domain) {
+        return 0;
+      }
+      devices_per_domain = run_length;
+    }
+    run_length = 1;
+  }
+  if (devices_per_domain != 0 && run_length != devices_per_domain) {
+    return 0;
+  }
+  return devices_per_domain;
+}
+
+// Returns the devices of the team whose relative indices are
+// first, first + stride, ... and less than first + count * stride
+Team stridedSubteam(
+    const Team& team,
+    int64_t first,
+    int64_t count,
+    int64_t stride) {
+  Team subteam;
+  subteam.reserve(count);
+  for (auto i : arange(count)) {
+    subteam.push_back(team.at(first + i * stride));
+  }
+  return subteam;
+}
+
+} // namespace
+
+bool canPostHierarchically(
+    Communication* communication,
+    Communicator* communicator) {
+  if (communication->type() != CommunicationType::Allreduce &&
+      communication->type() != CommunicationType::ReduceScatter) {
+    return false;
+  }
+  if (communication->backend() != CommunicatorBackend::kNccl) {
+    return false;
+  }
+  // Single-domain teams are already served by one NVLink ring
+  return devicesPerDomain(communication->team(), communicator) > 1;
+}
+
+c10::intrusive_ptr<c10d::Work> postHierarchicalCommunication(
+    Communication* communication,
+    DeviceIdxType my_device_index,
+    Communicator* communicator,
+    at::Tensor input_tensor,
+    at::Tensor output_tensor) {
+  const Team& team = communication->team();
+  if (std::find(team.begin(), team.end(), my_device_index) == team.end()) {
+    return nullptr;
+  }
+  const int64_t devices_per_domain = devicesPerDomain(team, communicator);
+  NVF_ERROR(
+      devices_per_domain > 1,
+      "Communication can't be posted hierarchically: ",
+      communication);
+  const int64_t num_domains = communication->team_size() / devices_per_domain;
+  const int64_t relative_index = getRelativeIndex(team, my_device_index);
+  const int64_t my_domain = relative_index / devices_per_domain;
+  const int64_t my_local_index = relative_index % devices_per_domain;
+
+  c10d::Backend* intra_backend = communicator->getBackendForTeam(
+      stridedSubteam(
+          team, my_domain * devices_per_domain, devices_per_domain, 1),
+      communication->backend());
+  c10d::Backend* inter_backend = communicator->getBackendForTeam(
+      stridedSubteam(team, my_local_index, num_domains, devices_per_domain),
+      communication->backend());
+
+  if (isDebugDumpEnabled(DebugDumpOption::Communication)) {
+    debug() << "Posting " << communication->toInlineString()
+            << " hierarchically over " << num_domains << " domains of "
+            << devices_per_domain << " devices with input_tensor "
+            << input_tensor.sizes() << " and output_tensor "
+            << output_tensor.sizes() << std::endl;
+  }
+
+  NVF_ERROR(
+      isTvContiguous(communication->in()),
+      "Input tensor is not contiguous: ",
+      communication->in(),
+      " contiguity: ",
+      communication->in()->domain()->getContiguityString());
+  NVF_ERROR(
+      isTvContiguous(communication->out()),
+      "Output tensor is not contiguous: ",
+      communication->out(),
+      " contiguity: ",
+      communication->out()->domain()->getContiguityString());
+
+  const c10d::ReduceScatterOptions reduce_scatter_options = {
+      .reduceOp = communication->reduceOp()};
+  auto flattened_output_tensor =
+      output_tensor.as_strided({output_tensor.numel()}, {1});
+
+  if (communication->type() == CommunicationType::Allreduce) {
+    doLocalCopy(output_tensor, input_tensor);
+    if (flattened_output_tensor.numel() % devices_per_domain != 0) {
+      std::vector<at::Tensor> output_tensors({output_tensor});
+      return communicator->getBackendForTeam(team, communication->backend())
+          ->allreduce(output_tensors, {.reduceOp = communication->reduceOp()});
+    }
+    at::Tensor shard = at::empty(
+        {flattened_output_tensor.numel() / devices_per_domain},
+        flattened_output_tensor.options());
+    waitOnCurrentStream(intra_backend->_reduce_scatter_base(
+        shard, flattened_output_tensor, reduce_scatter_options));
+    std::vector<at::Tensor> shards({shard});
+    waitOnCurrentStream(inter_backend->allreduce(
+        shards, {.reduceOp = communication->reduceOp()}));
+    return intra_backend->_allgather_base(flattened_output_tensor, shard);
+  }
+
+  // Shard r of the input goes to the device with relative index r, i.e.
+  // local index r % devices_per_domain of domain r / devices_per_domain.
+  // Reordering the shards local-index-major makes the intra-domain
+  // ReduceScatter hand each device the shards of its peers in all domains.
+  auto flattened_input_tensor =
+      input_tensor.as_strided({input_tensor.numel()}, {1});
+  at::Tensor permuted_input_tensor =
+      flattened_input_tensor
+          .view({num_domains, devices_per_domain, output_tensor.numel()})
+          .transpose(0, 1)
+          .contiguous()
+          .view({-1});
+  at::Tensor shards = at::empty(
+      {num_domains * output_tensor.numel()}, output_tensor.options());
+  waitOnCurrentStream(intra_backend->_reduce_scatter_base(
+      shards, permuted_input_tensor, reduce_scatter_options));
+  return inter_backend->_reduce_scatter_base(
+      flattened_output_tensor, shards, reduce_scatter_options);
+}
+
+AllToAllVResult postAllToAllV(
+    c10d::Backend* backend,
+    at::Tensor input,
+    at::Tensor send_counts) {
+  NVF_ERROR(backend != nullptr);
+  const int64_t size = backend->getSize();
+  NVF_ERROR_EQ(
+      send_counts.numel(),
+      size,
+      "Expected one send count per rank of the backend");
+  at::Tensor device_send_counts =
+      send_counts.to(at::kLong).contiguous().view({-1});
+  at::Tensor device_recv_counts = at::empty_like(device_send_counts);
+  std::vector<int64_t> equal_splits;
+  waitOnCurrentStream(backend->alltoall_base(
+      device_recv_counts, device_send_counts, equal_splits, equal_splits));
+
+  at::Tensor counts =
+      at::stack({device_send_counts, device_recv_counts}).cpu();
+  const int64_t* count_data = counts.data_ptr<int64_t>();
+  std::vector<int64_t> send_splits(count_data, count_data + size);
+  std::vector<int64_t> recv_splits(count_data + size, count_data + 2 * size);
+  NVF_ERROR_EQ(
+      std::accumulate(send_splits.begin(), send_splits.end(), int64_t(0)),
+      input.size(0),
+      "The send counts must sum up to the number of rows of the input");
+
+  std::vector<int64_t> output_sizes = input.sizes().vec();
+  output_sizes.at(0) =
+      std::accumulate(recv_splits.begin(), recv_splits.end(), int64_t(0));
+  AllToAllVResult result;
+  result.output = at::empty(output_sizes, input.options());
+  at::Tensor contiguous_input = input.contiguous();
+  result.work = backend->alltoall_base(
+      result.output, contiguous_input, recv_splits, send_splits);
+  result.recv_counts = std::move(recv_splits);
+  return result;
+}
+
+namespace {
+
 c10::intrusive_ptr<c10d::Work> postSend(
     P2PCommunication* communication,
     DeviceIdxType my_device_index,
@@ -31,7 +31,8 @@ enum class CommunicationType {
   Allreduce,
   ReduceScatter,
   Broadcast,
-  SendRecv
+  SendRecv,
+  AllToAll
 };
 
 std::ostream& operator<<(std::ostream& os, const CommunicationType& type);
@@ -41,8 +42,8 @@ using RedOpType = c10d::ReduceOp::RedOpType;
 // The class "Communication" represents a MPI-style communication
 // communication operation to be executed on the network. The base class
 // Communication should not be used directly but through its derived classes:
-// Broadcast, Gather, Scatter, Allgather, and SendRecv. Other collectives will
-// be added later.
+// Broadcast, Gather, Scatter, Allgather, SendRecv, and AllToAll. Other
+// collectives will be added later.
 class Communication : public Expr {
  public:
   using Expr::Expr;
@@ -219,6 +220,14 @@ class P2PCommunication : public Expr {
 // (*) SendRecv
 // Copies the sender's src buffers to the receiver's dst buffer
 // It is equivalent to a Broadcast with a team of size == 2
+// (*) AllToAll
+// Splits each device's src buffer into <team_size> chunks along the axis
+// sharded in the dst buffer and sends the i-th chunk to the i-th device, which
+// concatenates the chunks it receives along the axis sharded in the src
+// buffer, e.g., to move from sharding tokens to sharding experts.
+// Requirements:
+//   - all devices have one src buffer and one dst buffer
+//   - all buffers have the same number of elements
 c10::intrusive_ptr<c10d::Work> postSingleCommunication(
     Communication* communication,
     DeviceIdxType my_device_index,
@@ -226,6 +235,62 @@ c10::intrusive_ptr<c10d::Work> postSingleCommunication(
     at::Tensor input_tensor,
     at::Tensor output_tensor);
 
+// Makes the current stream wait for `work`. The works of NCCL complete on the
+// streams of the backend, so this only enqueues a cudaStreamWaitEvent and lets
+// the host run ahead, even with TORCH_NCCL_BLOCKING_WAIT. The works of other
+// backends, e.g., UCC, complete on the host, which this blocks until then.
+void waitOnCurrentStream(const c10::intrusive_ptr<c10d::Work>& work);
+
+// Returns whether the communication is an Allgather whose gathered axis isn't
+// outermost in its output or a SendRecv of non-contiguous tensors. With
+// EnableOption::StridedCommunication, postSingleCommunication posts it as
+// send/recvs of dense segments, which it coalesces itself.
+bool isStridedCommunication(const Communication* communication);
+
+// Returns whether the communication is an Allreduce or a ReduceScatter whose
+// team spans several NVLink domains of communicator and consists of the same
+// number (> 1) of consecutive devices from each domain.
+bool canPostHierarchically(
+    Communication* communication,
+    Communicator* communicator);
+
+// Posts a communication accepted by canPostHierarchically as
+// (*) Allreduce: a ReduceScatter within the domain of my_device_index, an
+// Allreduce of the resulting shard with the devices holding the same shard
+// in the other domains, and an Allgather within the domain.
+// (*) ReduceScatter: a ReduceScatter within the domain, whose input is
+// permuted so that each device receives the shards of its peers in the other
+// domains, followed by a ReduceScatter with these peers.
+// Only the last step crosses domains, with a fraction of the data that a flat
+// ring would send over the slower links. The intermediate steps are waited on
+// the current stream; the returned work is that of the last step.
+c10::intrusive_ptr<c10d::Work> postHierarchicalCommunication(
+    Communication* communication,
+    DeviceIdxType my_device_index,
+    Communicator* communicator,
+    at::Tensor input_tensor,
+    at::Tensor output_tensor);
+
+// The result of postAllToAllV. `output` is only complete once `work` is.
+struct AllToAllVResult {
+  at::Tensor output;
+  std::vector<int64_t> recv_counts;
+  c10::intrusive_ptr<c10d::Work> work;
+};
+
+// Posts an all-to-all of variable sizes among all the ranks of `backend`, as
+// needed to dispatch tokens to experts. The rows of `input` are grouped by
+// destination and `send_counts`, an integer tensor on the device of `input`,
+// holds the number of rows sent to each rank, so that it can be computed on
+// the device, e.g., by a histogram of the routing decisions. The counts are
+// exchanged with an all-to-all first and copied to the host to allocate the
+// output, which is the only synchronization with the host. The rows of the
+// output are grouped by source rank.
+AllToAllVResult postAllToAllV(
+    c10d::Backend* backend,
+    at::Tensor input,
+    at::Tensor send_counts);
+
 c10::intrusive_ptr<c10d::Work> postSingleCommunication(
     P2PCommunication* communication,
     DeviceIdxType my_device_index,
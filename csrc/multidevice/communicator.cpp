@@ -8,6 +8,7 @@
 #include <cuda_utils.h>
 #include <multidevice/communicator.h>
 #include <options.h>
+#include <remarks.h>
 #include <utils.h>
 
 #include <netdb.h>
@@ -362,6 +363,7 @@ c10d::Backend* Communicator::getBackendForTeam(
   // check if backend associated with the team is present in the cache
   if (backends_.find(team_key) ==
       backends_.end()) { // create the backend and cache it
+    const auto start = std::chrono::steady_clock::now();
 #ifdef NVFUSER_DISTRIBUTED
     backends_[team_key] = [&]() -> c10::intrusive_ptr<c10d::Backend> {
       // check that the caller's rank belongs to the requested team
@@ -380,10 +382,66 @@ c10d::Backend* Communicator::getBackendForTeam(
 #else
     backends_[team_key] = nullptr;
 #endif
+    recordBackendCreation(team_key, start);
   }
   return backends_.at(team_key).get();
 }
 
+c10d::Backend* Communicator::warmUpBackendForTeam(
+    const Team& team,
+    std::optional<CommunicatorBackend> backend,
+    const std::string& prefix) {
+  CommunicatorBackend b = getBackend(backend);
+  std::string team_key = prefix + getTeamKey(team, b);
+  const auto start = std::chrono::steady_clock::now();
+  const int64_t num_creations = numBackendCreations();
+  c10d::Backend* team_backend = getBackendForTeam(team, b, prefix);
+  if (team_backend == nullptr ||
+      !warmed_up_backends_.insert(team_key).second) {
+    return team_backend;
+  }
+#if defined(NVFUSER_DISTRIBUTED) && defined(USE_C10D_NCCL)
+  if (b == CommunicatorBackend::kNccl) {
+    static_cast<c10d::ProcessGroupNCCL*>(team_backend)
+        ->eagerConnectSingleDevice(device());
+    // Account the connection to the creation it completes
+    if (numBackendCreations() > num_creations) {
+      backend_creations_.back().latency =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start);
+    }
+  }
+#endif
+  return team_backend;
+}
+
+void Communicator::recordBackendCreation(
+    const std::string& team_key,
+    std::chrono::steady_clock::time_point start) {
+  const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  backend_creations_.push_back({team_key, latency});
+  if (isDebugDumpEnabled(DebugDumpOption::Communication)) {
+    debug() << "Created backend " << team_key << " in " << latency.count()
+            << " us" << std::endl;
+  }
+  if (remarks::isActive()) {
+    remarks::report(
+        "communicator",
+        "created backend",
+        {{"team", team_key}, {"latency_us", std::to_string(latency.count())}});
+  }
+}
+
+int64_t Communicator::nvlinkDomainSize() const {
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::HierarchicalCollectives);
+  const int64_t domain_size =
+      option_args.empty() ? local_size_ : std::stoll(option_args[0]);
+  NVF_CHECK(domain_size > 0, "Invalid NVLink domain size: ", domain_size);
+  return domain_size;
+}
+
 c10d::Backend* Communicator::getWorld(
     std::optional<CommunicatorBackend> backend) {
   std::vector<RankType> all_ranks(size_);
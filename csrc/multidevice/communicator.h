@@ -22,6 +22,11 @@
 #endif
 #include <visibility.h>
 
+#include <chrono>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 namespace nvfuser {
 
 // This file implements the class Communicator which sets up the inter-process
@@ -38,6 +43,15 @@ using RankType = DeviceIdxType;
 
 std::ostream& operator<<(std::ostream& out, const CommunicatorBackend& cb);
 
+// Records the creation of a backend by Communicator::getBackendForTeam. A
+// creation goes through a rendezvous on the TCPStore, so creations after the
+// first iteration of a program stall its steady state.
+struct BackendCreation {
+  std::string team_key;
+  // time spent creating the backend and, if it was warmed up, connecting it
+  std::chrono::microseconds latency;
+};
+
 #ifdef USE_C10D_NCCL
 constexpr CommunicatorBackend comm_backend_default = CommunicatorBackend::kNccl;
 #else
@@ -71,6 +85,18 @@ class Communicator {
     return local_size_;
   }
 
+  // returns the number of consecutive ranks that share an NVLink domain. This
+  // is the number of processes per node unless the argument of
+  // EnableOption::HierarchicalCollectives overrides it, e.g. for multi-node
+  // NVLink systems. Ranks are assumed to be numbered domain-major, as torchrun
+  // and mpirun do with one process per GPU.
+  int64_t nvlinkDomainSize() const;
+
+  // returns the index of the NVLink domain of a device
+  int64_t nvlinkDomainOf(DeviceIdxType device) const {
+    return device / nvlinkDomainSize();
+  }
+
   // sets the communicator's default backend
   void setDefaultBackend(CommunicatorBackend backend) {
     default_backend_ = backend;
@@ -88,6 +114,25 @@ class Communicator {
       std::optional<CommunicatorBackend> backend,
       const std::string& prefix = "");
 
+  // creates the backend of a team ahead of its first use. For NCCL, this also
+  // connects the NCCL communicator, which ProcessGroupNCCL otherwise does at
+  // the first collective. Like the first collective, it must be called by all
+  // the members of the team in the same order.
+  c10d::Backend* warmUpBackendForTeam(
+      const Team& team,
+      std::optional<CommunicatorBackend> backend,
+      const std::string& prefix = "");
+
+  // returns the backends created so far in order of creation
+  const std::vector<BackendCreation>& backendCreations() const {
+    return backend_creations_;
+  }
+
+  // returns the number of backends created so far
+  int64_t numBackendCreations() const {
+    return std::ssize(backend_creations_);
+  }
+
   // returns the device associated with the current process
   auto device() const {
     return at::Device("cuda:" + std::to_string(local_rank_));
@@ -143,6 +188,11 @@ class Communicator {
     return backend.value_or(default_backend_);
   }
 
+  // appends the creation of a backend started at start to backend_creations_
+  void recordBackendCreation(
+      const std::string& team_key,
+      std::chrono::steady_clock::time_point start);
+
   bool is_available_;
   CommunicatorBackend default_backend_;
   RankType rank_;
@@ -157,6 +207,10 @@ class Communicator {
   c10::intrusive_ptr<c10d::TCPStore> store_;
   // cache for the created backends. The keys are strings generated from Teams
   std::unordered_map<std::string, c10::intrusive_ptr<c10d::Backend>> backends_;
+  // trace of the creations of the backends, see BackendCreation
+  std::vector<BackendCreation> backend_creations_;
+  // keys of the backends connected by warmUpBackendForTeam
+  std::unordered_set<std::string> warmed_up_backends_;
 };
 
 } // namespace nvfuser
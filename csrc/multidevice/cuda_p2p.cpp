@@ -7,6 +7,10 @@
 // clang-format on
 #include <cuda_utils.h>
 #include <multidevice/cuda_p2p.h>
+#include <utils.h>
+
+#include <ATen/ATen.h>
+#include <c10/cuda/CUDAStream.h>
 
 namespace nvfuser {
 
@@ -67,4 +71,198 @@ void sendWait(const P2pIpcHandle& ipc_handles, CUstream stream) {
 
 } // namespace get_zcopy
 
+namespace ipc_collective {
+
+namespace {
+
+// Semaphore i of the buffer of a rank is set to the epoch of a collective by
+// the rank at index i of the team once its input is ready, and semaphore
+// team_size + i once it is done reading the buffer.
+enum class Phase : int64_t { kReady = 0, kDone = 1 };
+
+CUdeviceptr semaphoreAddress(
+    const CollectiveIpcHandle& handle,
+    int64_t owner,
+    Phase phase,
+    int64_t writer) {
+  return reinterpret_cast<CUdeviceptr>(handle.at(owner).semaphore(
+      static_cast<int64_t>(phase) * handle.size() + writer));
+}
+
+void signalPeers(
+    const CollectiveIpcHandle& handle,
+    Phase phase,
+    cuuint32_t epoch,
+    CUstream stream) {
+  for (auto peer : arange(handle.size())) {
+    if (peer == handle.myIndex()) {
+      continue;
+    }
+    NVFUSER_CUDA_SAFE_CALL(cuStreamWriteValue32(
+        stream,
+        semaphoreAddress(handle, peer, phase, handle.myIndex()),
+        epoch,
+        CU_STREAM_WRITE_VALUE_DEFAULT));
+  }
+}
+
+void waitForPeer(
+    const CollectiveIpcHandle& handle,
+    Phase phase,
+    int64_t peer,
+    cuuint32_t epoch,
+    CUstream stream) {
+  NVFUSER_CUDA_SAFE_CALL(cuStreamWaitValue32(
+      stream,
+      semaphoreAddress(handle, handle.myIndex(), phase, peer),
+      epoch,
+      CU_STREAM_WAIT_VALUE_GEQ));
+}
+
+void waitForPeers(
+    const CollectiveIpcHandle& handle,
+    Phase phase,
+    cuuint32_t epoch,
+    CUstream stream) {
+  for (auto peer : arange(handle.size())) {
+    if (peer != handle.myIndex()) {
+      waitForPeer(handle, phase, peer, epoch, stream);
+    }
+  }
+}
+
+CUstream currentStream() {
+  return static_cast<CUstream>(c10::cuda::getCurrentCUDAStream().stream());
+}
+
+at::Tensor flatten(const at::Tensor& tensor) {
+  NVF_ERROR(
+      tensor.is_contiguous(), "kCuda collectives need contiguous tensors");
+  return tensor.as_strided({tensor.numel()}, {1});
+}
+
+// The input of the rank at index in the team, flattened
+at::Tensor teamInput(
+    const CollectiveIpcHandle& handle,
+    int64_t index,
+    const at::Tensor& flat_input) {
+  if (index == handle.myIndex()) {
+    return flat_input;
+  }
+  return at::from_blob(
+      handle.at(index).ptr(), {flat_input.numel()}, flat_input.options());
+}
+
+void accumulate(at::Tensor& out, const at::Tensor& in, RedOpType op) {
+  switch (op) {
+    case RedOpType::SUM:
+    case RedOpType::AVG:
+      out.add_(in);
+      break;
+    case RedOpType::PRODUCT:
+      out.mul_(in);
+      break;
+    case RedOpType::MAX:
+      at::maximum_out(out, out, in);
+      break;
+    case RedOpType::MIN:
+      at::minimum_out(out, out, in);
+      break;
+    default:
+      NVF_THROW("Reduction ", op, " is not supported by the kCuda backend");
+  }
+}
+
+// Reduces the slices [offset, offset + output.numel()) of the inputs of the
+// team into output
+void reduce(
+    CollectiveIpcHandle& handle,
+    const at::Tensor& input,
+    at::Tensor output,
+    int64_t offset,
+    RedOpType op) {
+  at::Tensor flat_input = flatten(input);
+  at::Tensor flat_output = flatten(output);
+  const int64_t count = flat_output.numel();
+  NVF_ERROR(
+      offset + count <= flat_input.numel(),
+      "The output of the reduction is larger than its input");
+
+  const CUstream stream = currentStream();
+  const cuuint32_t epoch = handle.nextEpoch();
+  signalPeers(handle, Phase::kReady, epoch, stream);
+  for (auto index : arange(handle.size())) {
+    if (index != handle.myIndex()) {
+      waitForPeer(handle, Phase::kReady, index, epoch, stream);
+    }
+    at::Tensor slice =
+        teamInput(handle, index, flat_input).narrow(0, offset, count);
+    if (index == 0) {
+      flat_output.copy_(slice);
+    } else {
+      accumulate(flat_output, slice, op);
+    }
+  }
+  if (op == RedOpType::AVG) {
+    flat_output.div_(handle.size());
+  }
+  signalPeers(handle, Phase::kDone, epoch, stream);
+  waitForPeers(handle, Phase::kDone, epoch, stream);
+}
+
+} // namespace
+
+void allgather(
+    CollectiveIpcHandle& handle,
+    at::Tensor input,
+    at::Tensor output) {
+  at::Tensor flat_input = flatten(input);
+  at::Tensor flat_output = flatten(output);
+  NVF_ERROR_EQ(flat_output.numel(), flat_input.numel() * handle.size());
+  const int64_t bytes = flat_input.numel() * flat_input.element_size();
+
+  const CUstream stream = currentStream();
+  const cuuint32_t epoch = handle.nextEpoch();
+  signalPeers(handle, Phase::kReady, epoch, stream);
+  // Starting from the next rank spreads the reads over the peers
+  for (auto i : arange(handle.size())) {
+    const int64_t index = (handle.myIndex() + i) % handle.size();
+    if (index != handle.myIndex()) {
+      waitForPeer(handle, Phase::kReady, index, epoch, stream);
+    }
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaMemcpyAsync(
+        static_cast<uint8_t*>(flat_output.data_ptr()) + index * bytes,
+        teamInput(handle, index, flat_input).data_ptr(),
+        bytes,
+        cudaMemcpyDeviceToDevice,
+        stream));
+  }
+  signalPeers(handle, Phase::kDone, epoch, stream);
+  waitForPeers(handle, Phase::kDone, epoch, stream);
+}
+
+void reduceScatter(
+    CollectiveIpcHandle& handle,
+    at::Tensor input,
+    at::Tensor output,
+    RedOpType op) {
+  NVF_ERROR_EQ(input.numel(), output.numel() * handle.size());
+  reduce(handle, input, output, handle.myIndex() * output.numel(), op);
+}
+
+void allreduce(
+    CollectiveIpcHandle& handle,
+    at::Tensor input,
+    at::Tensor output,
+    RedOpType op) {
+  NVF_ERROR_EQ(input.numel(), output.numel());
+  NVF_ERROR(
+      !input.is_alias_of(output),
+      "The kCuda allreduce reads the inputs of the peers, so its output must "
+      "not alias its input");
+  reduce(handle, input, output, /*offset=*/0, op);
+}
+
+} // namespace ipc_collective
+
 } // namespace nvfuser
@@ -19,4 +19,34 @@ void sendWait(const P2pIpcHandle& ipc_handles, CUstream stream);
 
 } // namespace get_zcopy
 
+// Collectives of CommunicatorBackend::kCuda over the buffers of a team
+// exchanged by IpcHandleCache::getOrExchange. They are posted on the current
+// stream:
+//   - allgather pulls the input of each peer into output with the copy engines,
+//     so it uses no SM and overlaps fully with compute kernels.
+//   - reduceScatter and allreduce let reduction kernels read the inputs of the
+//     peers over NVLink and reduce them in team order, so that every rank gets
+//     the same result.
+// Each rank tells its peers that its input is ready before they read it, and
+// makes the stream wait until the peers are done reading before returning, so
+// the input can be overwritten by the next kernels.
+namespace ipc_collective {
+
+void allgather(
+    CollectiveIpcHandle& handle,
+    at::Tensor input,
+    at::Tensor output);
+void reduceScatter(
+    CollectiveIpcHandle& handle,
+    at::Tensor input,
+    at::Tensor output,
+    RedOpType op);
+void allreduce(
+    CollectiveIpcHandle& handle,
+    at::Tensor input,
+    at::Tensor output,
+    RedOpType op);
+
+} // namespace ipc_collective
+
 } // namespace nvfuser
@@ -31,6 +31,9 @@ MultiDeviceExecutor::MultiDeviceExecutor(
   // Create the HostIrEvaluator representing the host program
   host_ir_executor_ = std::make_unique<hir::HostIrEvaluator>(
       std::move(hic), &comm, params.executor);
+  if (params.warm_up_backends) {
+    host_ir_executor_->warmUpBackends();
+  }
 }
 
 KernelArgumentHolder MultiDeviceExecutor::runWithInput(
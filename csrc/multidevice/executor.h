@@ -23,6 +23,10 @@ namespace nvfuser {
 struct MultiDeviceExecutorParams {
   hir::HostIrEvaluatorParams executor;
   HostIrLowerParams lower;
+  // Whether to create the backends of all the communications at
+  // instantiation rather than at their first run, see
+  // HostIrEvaluator::warmUpBackends
+  bool warm_up_backends = false;
 };
 
 /*
@@ -9,6 +9,9 @@
 #include <multidevice/communicator.h>
 #include <multidevice/ipc_handle.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace nvfuser {
 
 namespace {
@@ -27,10 +30,12 @@ const T& fromBytes(const std::vector<uint8_t>& bytes) {
 
 } // namespace
 
-IpcHandle::IpcHandle(at::Tensor tensor)
+IpcHandle::IpcHandle(at::Tensor tensor, int64_t num_semaphores)
     : ptr_(tensor.data_ptr()),
+      num_semaphores_(num_semaphores),
       rank_(Communicator::getInstance().deviceId()),
       tensor_(tensor) {
+  NVF_ERROR(num_semaphores_ > 0, "An IpcHandle needs at least one semaphore");
   size_t psize = 0;
   NVFUSER_CUDA_SAFE_CALL(cuMemGetAddressRange(
       (CUdeviceptr*)&base_address_, &psize, (CUdeviceptr)ptr_));
@@ -38,13 +43,15 @@ IpcHandle::IpcHandle(at::Tensor tensor)
       static_cast<uint8_t*>(ptr_) - static_cast<uint8_t*>(base_address_));
   NVFUSER_CUDA_RT_SAFE_CALL(
       cudaIpcGetMemHandle(&ipc_handle_, tensor.data_ptr()));
-  NVFUSER_CUDA_RT_SAFE_CALL(
-      cudaMalloc((void**)&semaphore_, sizeof(IpcSemaphore)));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaMalloc(
+      (void**)&semaphore_, num_semaphores_ * sizeof(IpcSemaphore)));
   static_assert(
       sizeof(IpcSemaphore) == sizeof(int),
       "IpcSemaphore must be same size as int");
   NVFUSER_CUDA_RT_SAFE_CALL(cudaMemset(
-      (void*)semaphore_, (int)IpcSemaphore::kReady, sizeof(IpcSemaphore)));
+      (void*)semaphore_,
+      (int)IpcSemaphore::kReady,
+      num_semaphores_ * sizeof(IpcSemaphore)));
   NVFUSER_CUDA_RT_SAFE_CALL(
       cudaIpcGetMemHandle(&semaphore_ipc_handle_, semaphore_));
 }
@@ -55,6 +62,7 @@ IpcHandle::IpcHandle(std::vector<uint8_t> data) {
   offset_from_base_address_ = imported_buffer.offset_from_base_address_;
   ipc_handle_ = imported_buffer.ipc_handle_;
   semaphore_ipc_handle_ = imported_buffer.semaphore_ipc_handle_;
+  num_semaphores_ = imported_buffer.num_semaphores_;
   rank_ = imported_buffer.rank_;
 
   NVFUSER_CUDA_RT_SAFE_CALL(cudaIpcOpenMemHandle(
@@ -150,4 +158,76 @@ void IpcHandleCache::exchangeHandles(
   communicator->barrier();
 }
 
+CollectiveIpcHandle& IpcHandleCache::getOrExchange(
+    Communication* communication,
+    at::Tensor buffer) {
+  const KeyType key = getKey(communication, /*peer=*/-1, buffer);
+  if (auto it = collective_handles_.find(key);
+      it != collective_handles_.end()) {
+    return *it->second;
+  }
+
+  NVF_ERROR(
+      buffer.is_contiguous(), "IpcHandle only supports contiguous tensors");
+  Communicator* communicator = &Communicator::getInstance();
+  const Team& team = communication->team();
+  const auto my_it =
+      std::find(team.begin(), team.end(), communicator->deviceId());
+  NVF_ERROR(
+      my_it != team.end(),
+      "Rank ",
+      communicator->deviceId(),
+      " is not in the team of ",
+      communication);
+  const int64_t my_index = std::distance(team.begin(), my_it);
+
+  std::string team_key = "team=";
+  for (DeviceIdxType rank : team) {
+    team_key += std::to_string(rank) + ",";
+  }
+  // Keys are unique per exchange, so they don't need to be deleted before
+  // the next exchange
+  const std::string exchange_key = "nvfuser_ipc_handle_info_Comm_" + team_key +
+      "_exchange=" + std::to_string(collective_exchange_counts_[team_key]++);
+  auto store = communicator->getTcpStore();
+
+  std::vector<std::unique_ptr<IpcHandle>> handles(team.size());
+  handles.at(my_index) = std::make_unique<IpcHandle>(
+      buffer, /*num_semaphores=*/2 * std::ssize(team));
+  // Peers may write the semaphores as soon as they import them, so they must
+  // be reset before they are exported
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaStreamSynchronize(nullptr));
+  store->set(
+      exchange_key + "_rank=" + std::to_string(team.at(my_index)),
+      toBytes(*handles.at(my_index)));
+  for (auto index : arange(std::ssize(team))) {
+    if (index == my_index) {
+      continue;
+    }
+    // TCP store get is blocking until a timeout
+    handles.at(index) = std::make_unique<IpcHandle>(store->get(
+        exchange_key + "_rank=" + std::to_string(team.at(index))));
+  }
+
+  auto [it, inserted] = collective_handles_.emplace(
+      key,
+      std::make_unique<CollectiveIpcHandle>(std::move(handles), my_index));
+  return *it->second;
+}
+
+void IpcHandleCache::invalidate(const at::Tensor& tensor) {
+  if (!tensor.defined() || !tensor.has_storage()) {
+    return;
+  }
+  const auto begin =
+      reinterpret_cast<std::uintptr_t>(tensor.storage().data_ptr().get());
+  const auto end = begin + tensor.storage().nbytes();
+  auto in_storage = [begin, end](const auto& item) {
+    const std::uintptr_t data_ptr = item.first.data_ptr;
+    return data_ptr >= begin && data_ptr < end;
+  };
+  std::erase_if(handles_, in_storage);
+  std::erase_if(collective_handles_, in_storage);
+}
+
 } // namespace nvfuser
@@ -10,17 +10,22 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 #include <expr_evaluator.h>
+#include <multidevice/communication.h>
+#include <utils.h>
+
+#include <cstdint>
+#include <string>
 
 namespace nvfuser {
 
 enum class IpcSemaphore : cuuint32_t { kReady, kInUse };
 
 // The class IpcHandle represents a cuda buffer that can be exported/imported to
-// remote devices. It comes with a semaphore that is allocated on the buffer's
-// device.
+// remote devices. It comes with one or more semaphores that are allocated on
+// the buffer's device.
 class IpcHandle {
  public:
-  IpcHandle(at::Tensor tensor);
+  IpcHandle(at::Tensor tensor, int64_t num_semaphores = 1);
   ~IpcHandle();
 
   // This constructor is used when importing a remote Ipc Handle
@@ -30,8 +35,9 @@ class IpcHandle {
     return ptr_;
   }
 
-  auto semaphore() const {
-    return semaphore_;
+  auto semaphore(int64_t i = 0) const {
+    NVF_ERROR(i >= 0 && i < num_semaphores_, "Invalid semaphore index ", i);
+    return semaphore_ + i;
   }
 
  private:
@@ -43,6 +49,7 @@ class IpcHandle {
   cudaIpcMemHandle_t ipc_handle_ = {};
   cudaIpcMemHandle_t semaphore_ipc_handle_ = {};
   IpcSemaphore* semaphore_ = nullptr;
+  int64_t num_semaphores_ = 1;
   int64_t rank_;
   // we keep a reference of the tensor to prevent the cuda buffer to be freed
   // before the IpcHandle gets destroyed
@@ -70,9 +77,47 @@ class P2pIpcHandle {
   std::unique_ptr<IpcHandle> peer_;
 };
 
+// This class wraps the IpcHandles of the buffers of a collective Communication
+// on every rank of its team, indexed by position in the team. Each buffer comes
+// with 2 * team_size semaphores, see ipc_collective in cuda_p2p.h.
+class CollectiveIpcHandle {
+ public:
+  CollectiveIpcHandle(
+      std::vector<std::unique_ptr<IpcHandle>> handles,
+      int64_t my_index)
+      : handles_(std::move(handles)), my_index_(my_index) {}
+
+  int64_t size() const {
+    return std::ssize(handles_);
+  }
+
+  int64_t myIndex() const {
+    return my_index_;
+  }
+
+  const IpcHandle& local() const {
+    return *handles_.at(my_index_);
+  }
+
+  const IpcHandle& at(int64_t index) const {
+    return *handles_.at(index);
+  }
+
+  // Returns the value the semaphores are set to by the next collective.
+  // Every rank of the team calls it once per collective.
+  cuuint32_t nextEpoch() {
+    return ++epoch_;
+  }
+
+ private:
+  std::vector<std::unique_ptr<IpcHandle>> handles_;
+  int64_t my_index_;
+  cuuint32_t epoch_ = 0;
+};
+
 // IpcHandleCache manages and cache the IpcHandles.
-// Caching is done on the runtime values of (peer, tensor) and the
-// P2PCommunication* pointer.
+// Caching is done on the runtime values of the peer and of the buffer's
+// address, offset and size, and on the P2PCommunication* pointer.
 class IpcHandleCache {
  public:
   IpcHandleCache(const ExpressionEvaluator& expr_evaluator)
@@ -96,38 +141,42 @@ class IpcHandleCache {
     return *it;
   }
 
+  // Returns the handles of the buffers of communication on its team, where the
+  // local buffer is buffer. On a miss, the handles are exported and imported
+  // through the TCP store, which blocks until every rank of the team has
+  // called this method for the same communication.
+  CollectiveIpcHandle& getOrExchange(
+      Communication* communication,
+      at::Tensor buffer);
+
+  // Drops the handles of the buffers living in the storage of tensor. Must be
+  // called before tensor is freed, otherwise a later allocation at the same
+  // address would hit a stale handle.
+  void invalidate(const at::Tensor& tensor);
+
  private:
+  // Identifies a buffer by its address and extent so that a lookup is pure
+  // host work. A freed buffer must be invalidated since its address may be
+  // reused by another allocation.
   struct KeyType {
     int64_t peer;
-    at::Tensor buffer;
-    P2PCommunication* comm;
+    std::uintptr_t data_ptr;
+    int64_t storage_offset;
+    int64_t numel;
+    int64_t element_size;
+    Expr* comm;
 
-    bool operator==(const KeyType& other) const {
-      return peer == other.peer && TensorEqual{}(buffer, other.buffer) &&
-          comm == other.comm;
-    }
+    bool operator==(const KeyType& other) const = default;
 
     struct Hash {
       std::size_t operator()(const KeyType& key) const {
-        return (std::hash<int64_t>()(key.peer)) ^ (TensorHash{}(key.buffer)) ^
-            (std::hash<P2PCommunication*>()(key.comm));
-      }
-    };
-
-    struct TensorHash {
-      std::size_t operator()(const at::Tensor& tensor) const {
-        auto ptr = reinterpret_cast<std::uintptr_t>(tensor.data_ptr());
-        auto offset = tensor.storage_offset();
-        auto element_size = tensor.element_size();
-        auto numel = tensor.numel();
-        return std::hash<std::uintptr_t>()(ptr) ^ std::hash<int64_t>()(offset) ^
-            std::hash<int64_t>()(element_size) ^ std::hash<int64_t>()(numel);
-      }
-    };
-
-    struct TensorEqual {
-      bool operator()(const at::Tensor& lhs, const at::Tensor& rhs) const {
-        return lhs.equal(rhs);
+        size_t hash = std::hash<int64_t>()(key.peer);
+        hashCombine(hash, std::hash<std::uintptr_t>()(key.data_ptr));
+        hashCombine(hash, std::hash<int64_t>()(key.storage_offset));
+        hashCombine(hash, std::hash<int64_t>()(key.numel));
+        hashCombine(hash, std::hash<int64_t>()(key.element_size));
+        hashCombine(hash, std::hash<Expr*>()(key.comm));
+        return hash;
       }
     };
   };
@@ -147,7 +196,17 @@ class IpcHandleCache {
   KeyType getKey(P2PCommunication* comm) const {
     auto peer = expr_evaluator_.evaluate(comm->peer()).as<int64_t>();
     auto buffer = expr_evaluator_.evaluate(comm->buffer()).as<at::Tensor>();
-    return KeyType{peer, buffer, comm};
+    return getKey(comm, peer, buffer);
+  }
+
+  static KeyType getKey(Expr* comm, int64_t peer, const at::Tensor& buffer) {
+    return KeyType{
+        peer,
+        reinterpret_cast<std::uintptr_t>(buffer.data_ptr()),
+        buffer.storage_offset(),
+        buffer.numel(),
+        (int64_t)buffer.element_size(),
+        comm};
   }
 
   std::string getTcpStoreKey(P2PCommunication* communication, int64_t rank)
@@ -156,6 +215,16 @@ class IpcHandleCache {
   const ExpressionEvaluator& expr_evaluator_;
   std::unordered_map<KeyType, std::unique_ptr<P2pIpcHandle>, KeyType::Hash>
       handles_;
+  // Keyed with a peer of -1
+  std::unordered_map<
+      KeyType,
+      std::unique_ptr<CollectiveIpcHandle>,
+      KeyType::Hash>
+      collective_handles_;
+  // Number of exchanges of collective handles per team. The ranks of a team
+  // exchange the handles of their collectives in the same order, so the count
+  // identifies an exchange in the TCP store.
+  std::unordered_map<std::string, int64_t> collective_exchange_counts_;
 };
 
 } // namespace nvfuser
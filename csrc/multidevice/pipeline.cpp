@@ -0,0 +1,483 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <multidevice/pipeline.h>
+
+#include <c10/cuda/CUDAGuard.h>
+
+#include <debug.h>
+#include <fusion_profiler.h>
+#include <instrumentation.h>
+#include <ir/interface_nodes.h>
+#include <multidevice/communication.h>
+#include <options.h>
+#include <utils.h>
+
+#include <algorithm>
+
+namespace nvfuser {
+
+namespace {
+
+struct P2POp {
+  bool is_send;
+  at::Tensor tensor;
+  DeviceIdxType peer;
+};
+
+// Posts `ops` on `p2p_stream` after the work already posted on the current
+// stream, and makes the current stream wait for them if they receive
+// anything. The ops are grouped so that the sends and recvs that two stages
+// post to each other don't deadlock. Returns the works of sends that
+// nothing waits for yet.
+std::vector<c10::intrusive_ptr<c10d::Work>> postP2POps(
+    const std::vector<P2POp>& ops,
+    c10d::Backend* backend,
+    c10::cuda::CUDAStream p2p_stream) {
+  if (ops.empty()) {
+    return {};
+  }
+
+  c10::cuda::CUDAStream compute_stream =
+      c10::cuda::getCurrentCUDAStream(p2p_stream.device_index());
+  cudaEvent_t event;
+  NVFUSER_CUDA_RT_SAFE_CALL(
+      cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(event, compute_stream.stream()));
+  NVFUSER_CUDA_RT_SAFE_CALL(
+      cudaStreamWaitEvent(p2p_stream.stream(), event, cudaEventWaitDefault));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(event));
+
+  std::vector<c10::intrusive_ptr<c10d::Work>> works;
+  {
+    c10::cuda::CUDAStreamGuard stream_guard(p2p_stream);
+    // ProcessGroupUCC does not implement coalescence, see
+    // HostIrEvaluator::handle(StartCoalescing*)
+    const bool coalesce =
+        ops.size() > 1 && backend->getBackendName() == "nccl";
+    if (coalesce) {
+      backend->startCoalescing();
+    }
+    for (const P2POp& op : ops) {
+      // Needed to match ProcessGroup API
+      std::vector<at::Tensor> packed_buffer = {op.tensor};
+      works.push_back(
+          op.is_send
+              ? backend->send(packed_buffer, static_cast<int>(op.peer), 0)
+              : backend->recv(packed_buffer, static_cast<int>(op.peer), 0));
+    }
+    if (coalesce) {
+      works = {backend->endCoalescing()};
+    }
+  }
+
+  const bool receives =
+      std::any_of(ops.begin(), ops.end(), [](const P2POp& op) {
+        return !op.is_send;
+      });
+  if (!receives) {
+    return works;
+  }
+  for (const auto& work : works) {
+    waitOnCurrentStream(work);
+  }
+  return {};
+}
+
+// The forward of a micro-batch that is kept until its backward
+struct MicroBatch {
+  KernelArgumentHolder forward_inputs;
+  // The outputs of the forward, on the last stage only
+  KernelArgumentHolder outputs;
+  // Meta tensors like the outputs of the forward, to receive their gradients
+  std::vector<at::Tensor> output_likes;
+  std::unique_ptr<CudaEventTimer> forward_timer;
+  std::unique_ptr<CudaEventTimer> backward_timer;
+};
+
+// Allocates a contiguous tensor on `device` like the meta tensor `like`
+at::Tensor emptyLike(const at::Tensor& like, const at::Device& device) {
+  return at::empty(like.sizes(), like.options().device(device));
+}
+
+} // namespace
+
+PipelineExecutor::PipelineExecutor(
+    std::vector<PipelineStage> stages,
+    const DeviceMesh& mesh,
+    Communicator& comm,
+    PipelineExecutorParams params)
+    : comm_(comm),
+      params_(params),
+      p2p_stream_(c10::cuda::getStreamFromPool(
+          /*isHighPriority=*/true,
+          comm.device().index())) {
+  NVF_CHECK(!stages.empty(), "A pipeline needs at least one stage.");
+  NVF_CHECK(
+      params_.num_micro_batches > 0,
+      "Invalid number of micro-batches: ",
+      params_.num_micro_batches);
+  const DeviceIdxType my_device = comm_.deviceId();
+  NVF_CHECK(
+      mesh.has(my_device),
+      "Device ",
+      my_device,
+      " is not in the mesh of the pipeline ",
+      mesh);
+  peers_ = mesh.getSlice(my_device, params_.stage_parallel_type);
+  NVF_CHECK_EQ(
+      std::ssize(peers_),
+      std::ssize(stages),
+      "Expected one stage per device along ",
+      params_.stage_parallel_type,
+      " of ",
+      mesh);
+  stage_ = std::distance(
+      peers_.begin(), std::find(peers_.begin(), peers_.end(), my_device));
+
+  const bool has_backward = stages.front().backward != nullptr;
+  for (const PipelineStage& stage : stages) {
+    NVF_CHECK(stage.forward != nullptr, "Every stage needs a forward Fusion.");
+    NVF_CHECK_EQ(
+        stage.backward != nullptr,
+        has_backward,
+        "Either all stages or none have a backward Fusion.");
+  }
+  if (stage_ > 0) {
+    num_received_activations_ =
+        std::ssize(stages.at(stage_ - 1).forward->outputs());
+    NVF_CHECK_LE(
+        num_received_activations_,
+        std::ssize(stages.at(stage_).forward->inputs()),
+        "Stage ",
+        stage_,
+        " has fewer inputs than the outputs of the previous stage.");
+  }
+
+  PipelineStage& my_stage = stages.at(stage_);
+  forward_ = std::make_unique<FusionExecutorCache>(std::move(my_stage.forward));
+  if (has_backward) {
+    backward_ =
+        std::make_unique<FusionExecutorCache>(std::move(my_stage.backward));
+  }
+}
+
+KernelArgumentHolder PipelineExecutor::runWithInput(
+    const KernelArgumentHolder& inputs,
+    const KernelArgumentHolder& parameters) {
+  FUSER_PERF_SCOPE("PipelineExecutor::runWithInput");
+  const int64_t num_stages = numStages();
+  const int64_t num_micro_batches = params_.num_micro_batches;
+  const bool is_first = stage_ == 0;
+  const bool is_last = stage_ == num_stages - 1;
+  const bool profile = isProfilerEnabled();
+  c10d::Backend* backend = comm_.getWorld();
+  c10::cuda::CUDAStream compute_stream =
+      c10::cuda::getCurrentCUDAStream(p2p_stream_.device_index());
+
+  std::unique_ptr<CudaEventTimer> total_timer;
+  if (profile) {
+    total_timer = std::make_unique<CudaEventTimer>(compute_stream.stream());
+    total_timer->start();
+  }
+
+  // Split the inputs of the pipeline into micro-batches
+  std::vector<MicroBatch> micro_batches(num_micro_batches);
+  if (is_first) {
+    for (const PolymorphicValue& input : inputs) {
+      const auto& tensor = input.as<at::Tensor>();
+      NVF_CHECK(
+          tensor.dim() > 0 && tensor.size(0) % num_micro_batches == 0,
+          "The outermost axis of the inputs of the pipeline must be divisible "
+          "by the number of micro-batches, ",
+          num_micro_batches,
+          ", but got an input of sizes ",
+          tensor.sizes());
+      std::vector<at::Tensor> chunks =
+          at::chunk(tensor, num_micro_batches, /*dim=*/0);
+      for (auto&& [chunk, micro_batch] : zip(chunks, micro_batches)) {
+        micro_batch.forward_inputs.push(chunk);
+      }
+    }
+  }
+
+  // The received activations are allocated like those of the first
+  // micro-batch, whose sizes the previous stage sends first. These are meta
+  // tensors.
+  std::vector<at::Tensor> activation_likes;
+  auto recv_activation_sizes = [&]() {
+    const std::vector<Val*>& fusion_inputs = forward_->fusion()->inputs();
+    int64_t num_dims = 0;
+    for (auto i : arange(num_received_activations_)) {
+      num_dims += std::ssize(TensorDomain::noReductions(
+          fusion_inputs.at(i)->as<TensorView>()->getLogicalDomain()));
+    }
+    at::Tensor sizes = at::empty(
+        {num_dims},
+        at::TensorOptions().dtype(at::kLong).device(comm_.device()));
+    postP2POps({{false, sizes, peers_.at(stage_ - 1)}}, backend, p2p_stream_);
+    // Blocks the host once per run
+    at::Tensor cpu_sizes = sizes.cpu();
+    std::vector<int64_t> host_sizes(
+        cpu_sizes.data_ptr<int64_t>(),
+        cpu_sizes.data_ptr<int64_t>() + num_dims);
+    int64_t offset = 0;
+    for (auto i : arange(num_received_activations_)) {
+      auto* tv = fusion_inputs.at(i)->as<TensorView>();
+      const auto num_tv_dims = std::ssize(
+          TensorDomain::noReductions(tv->getLogicalDomain()));
+      std::vector<int64_t> tv_sizes(
+          host_sizes.begin() + offset,
+          host_sizes.begin() + offset + num_tv_dims);
+      offset += num_tv_dims;
+      activation_likes.push_back(at::empty(
+          tv_sizes,
+          at::TensorOptions()
+              .dtype(data_type_to_aten(tv->dtype()))
+              .device(at::kMeta)));
+    }
+  };
+  auto send_activation_sizes = [&](const KernelArgumentHolder& outputs) {
+    std::vector<int64_t> host_sizes;
+    for (const PolymorphicValue& output : outputs) {
+      const auto& sizes = output.as<at::Tensor>().sizes();
+      host_sizes.insert(host_sizes.end(), sizes.begin(), sizes.end());
+    }
+    at::Tensor sizes = at::tensor(host_sizes, at::kLong).to(comm_.device());
+    return postP2POps(
+        {{true, sizes, peers_.at(stage_ + 1)}}, backend, p2p_stream_);
+  };
+
+  std::vector<c10::intrusive_ptr<c10d::Work>> pending_sends;
+  auto post = [&](const std::vector<P2POp>& ops) {
+    auto works = postP2POps(ops, backend, p2p_stream_);
+    pending_sends.insert(pending_sends.end(), works.begin(), works.end());
+  };
+
+  // The P2P ops of the steps of the schedule. They are empty where the
+  // stage has no neighbor.
+  std::vector<at::Tensor> sent_activations;
+  auto recv_forward = [&](int64_t mb) -> std::vector<P2POp> {
+    if (is_first) {
+      return {};
+    }
+    if (activation_likes.empty()) {
+      recv_activation_sizes();
+    }
+    std::vector<P2POp> ops;
+    for (const at::Tensor& like : activation_likes) {
+      at::Tensor activation = emptyLike(like, comm_.device());
+      micro_batches.at(mb).forward_inputs.push(activation);
+      ops.push_back({false, activation, peers_.at(stage_ - 1)});
+    }
+    return ops;
+  };
+  auto send_forward = [&]() -> std::vector<P2POp> {
+    if (is_last) {
+      return {};
+    }
+    std::vector<P2POp> ops;
+    for (const at::Tensor& activation : sent_activations) {
+      ops.push_back({true, activation, peers_.at(stage_ + 1)});
+    }
+    sent_activations.clear();
+    return ops;
+  };
+  std::vector<at::Tensor> output_grads;
+  auto recv_backward = [&](int64_t mb) -> std::vector<P2POp> {
+    std::vector<P2POp> ops;
+    for (const at::Tensor& like : micro_batches.at(mb).output_likes) {
+      if (is_last) {
+        output_grads.push_back(
+            at::ones(like.sizes(), like.options().device(comm_.device())));
+        continue;
+      }
+      at::Tensor grad = emptyLike(like, comm_.device());
+      output_grads.push_back(grad);
+      ops.push_back({false, grad, peers_.at(stage_ + 1)});
+    }
+    return ops;
+  };
+  std::vector<at::Tensor> sent_grads;
+  auto send_backward = [&]() -> std::vector<P2POp> {
+    std::vector<P2POp> ops;
+    if (!is_first) {
+      for (const at::Tensor& grad : sent_grads) {
+        ops.push_back({true, grad, peers_.at(stage_ - 1)});
+      }
+    }
+    sent_grads.clear();
+    return ops;
+  };
+  auto concat = [](std::vector<P2POp> a, const std::vector<P2POp>& b) {
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+  };
+
+  // The computations of the steps of the schedule
+  KernelArgumentHolder accumulated_grads;
+  auto forward = [&](int64_t mb) {
+    MicroBatch& micro_batch = micro_batches.at(mb);
+    for (const PolymorphicValue& parameter : parameters) {
+      micro_batch.forward_inputs.push(parameter);
+    }
+    if (profile) {
+      micro_batch.forward_timer =
+          std::make_unique<CudaEventTimer>(compute_stream.stream());
+      micro_batch.forward_timer->start();
+    }
+    KernelArgumentHolder outputs =
+        forward_->runFusionWithInputs(micro_batch.forward_inputs);
+    if (profile) {
+      micro_batch.forward_timer->stop();
+    }
+
+    if (!is_last) {
+      if (mb == 0) {
+        auto works = send_activation_sizes(outputs);
+        pending_sends.insert(pending_sends.end(), works.begin(), works.end());
+      }
+      for (const PolymorphicValue& output : outputs) {
+        sent_activations.push_back(output.as<at::Tensor>().contiguous());
+      }
+    } else {
+      micro_batch.outputs = outputs;
+    }
+    if (hasBackward()) {
+      for (const PolymorphicValue& output : outputs) {
+        const auto& tensor = output.as<at::Tensor>();
+        micro_batch.output_likes.push_back(
+            at::empty(tensor.sizes(), tensor.options().device(at::kMeta)));
+      }
+    } else {
+      micro_batch.forward_inputs = KernelArgumentHolder();
+    }
+  };
+  auto backward = [&](int64_t mb) {
+    MicroBatch& micro_batch = micro_batches.at(mb);
+    KernelArgumentHolder args = micro_batch.forward_inputs;
+    for (const at::Tensor& grad : output_grads) {
+      args.push(grad);
+    }
+    output_grads.clear();
+    if (profile) {
+      micro_batch.backward_timer =
+          std::make_unique<CudaEventTimer>(compute_stream.stream());
+      micro_batch.backward_timer->start();
+    }
+    KernelArgumentHolder grads = backward_->runFusionWithInputs(args);
+    if (profile) {
+      micro_batch.backward_timer->stop();
+    }
+
+    const int64_t num_activations = is_first
+        ? inputs.size()
+        : num_received_activations_;
+    for (auto i : arange(grads.size())) {
+      const auto& grad = grads[i].as<at::Tensor>();
+      if (i < num_activations) {
+        sent_grads.push_back(grad.contiguous());
+        continue;
+      }
+      const int64_t j = i - num_activations;
+      if (j < accumulated_grads.size()) {
+        accumulated_grads[j].as<at::Tensor>().add_(grad);
+      } else {
+        accumulated_grads.push(grad.clone());
+      }
+    }
+    // The inputs of the micro-batch are no longer needed
+    micro_batch.forward_inputs = KernelArgumentHolder();
+    micro_batch.output_likes.clear();
+  };
+
+  if (!hasBackward()) {
+    for (auto mb : arange(num_micro_batches)) {
+      post(recv_forward(mb));
+      forward(mb);
+      post(send_forward());
+    }
+  } else {
+    // The 1F1B schedule. The last stage has no warmup and alternates forward
+    // and backward from the start.
+    const int64_t num_warmup =
+        std::min(num_stages - stage_ - 1, num_micro_batches);
+    const int64_t num_steady = num_micro_batches - num_warmup;
+    for (auto mb : arange(num_warmup)) {
+      post(recv_forward(mb));
+      forward(mb);
+      post(send_forward());
+    }
+    if (num_steady > 0) {
+      post(recv_forward(num_warmup));
+    }
+    for (auto i : arange(num_steady)) {
+      const int64_t forward_mb = num_warmup + i;
+      const int64_t backward_mb = i;
+      forward(forward_mb);
+      post(concat(send_forward(), recv_backward(backward_mb)));
+      backward(backward_mb);
+      if (i == num_steady - 1) {
+        post(send_backward());
+      } else {
+        post(concat(send_backward(), recv_forward(forward_mb + 1)));
+      }
+    }
+    for (auto backward_mb : arange(num_steady, num_micro_batches)) {
+      post(recv_backward(backward_mb));
+      backward(backward_mb);
+      post(send_backward());
+    }
+  }
+
+  // The sent tensors are kept alive by the works, which the compute stream
+  // waits for so that the next run doesn't overtake them.
+  for (const auto& work : pending_sends) {
+    waitOnCurrentStream(work);
+  }
+
+  KernelArgumentHolder outputs;
+  if (is_last) {
+    for (MicroBatch& micro_batch : micro_batches) {
+      for (const PolymorphicValue& output : micro_batch.outputs) {
+        outputs.push(output);
+      }
+    }
+  }
+  for (const PolymorphicValue& grad : accumulated_grads) {
+    outputs.push(grad);
+  }
+
+  if (profile) {
+    total_timer->stop();
+    PipelineStageProfile prof;
+    prof.stage = stage_;
+    prof.num_stages = num_stages;
+    prof.micro_batches = num_micro_batches;
+    prof.device = static_cast<int>(comm_.device().index());
+    prof.total_time_ms = total_timer->time();
+    for (MicroBatch& micro_batch : micro_batches) {
+      if (micro_batch.forward_timer != nullptr) {
+        prof.forward_time_ms += micro_batch.forward_timer->time();
+      }
+      if (micro_batch.backward_timer != nullptr) {
+        prof.backward_time_ms += micro_batch.backward_timer->time();
+      }
+    }
+    prof.idle_time_ms = std::max(
+        0.0,
+        prof.total_time_ms - prof.forward_time_ms - prof.backward_time_ms);
+    FusionProfiler::recordPipelineStage(prof);
+    if (isProfilerPrintingEnabled()) {
+      debug() << FusionProfiler::pipelineStageProfile();
+    }
+  }
+
+  return outputs;
+}
+
+} // namespace nvfuser
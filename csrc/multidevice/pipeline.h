@@ -0,0 +1,132 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <c10/cuda/CUDAStream.h>
+#include <exceptions.h>
+#include <fusion.h>
+#include <multidevice/communicator.h>
+#include <multidevice/device_mesh.h>
+#include <multidevice/multidevice.h>
+#include <runtime/fusion_executor_cache.h>
+#include <type.h>
+#include <visibility.h>
+
+#include <memory>
+#include <vector>
+
+namespace nvfuser {
+
+// The Fusions of a pipeline stage. The leading inputs of `forward` are the
+// activations, i.e., the outputs of the previous stage's `forward` or the
+// micro-batched inputs of the pipeline for the first stage. The trailing
+// inputs are the parameters of the stage, which are the same for all
+// micro-batches.
+//
+// `backward` is optional and must be given for all the stages or none. Its
+// inputs are the inputs of `forward` followed by the gradients of the outputs
+// of `forward`. Its leading outputs are the gradients of the activations, sent
+// to the previous stage, and its trailing outputs, e.g., the gradients of the
+// parameters, are accumulated over the micro-batches. The gradients of the
+// outputs of the last stage, typically a loss, are ones.
+struct PipelineStage {
+  std::unique_ptr<Fusion> forward;
+  std::unique_ptr<Fusion> backward;
+};
+
+struct PipelineExecutorParams {
+  // The number of micro-batches the inputs of the pipeline are split into
+  // along their outermost axis
+  int64_t num_micro_batches = 1;
+  // The axis of the DeviceMesh along which the stages are assigned. The other
+  // axes can be used by the stages' Fusions, e.g., for tensor parallelism.
+  ParallelType stage_parallel_type = ParallelType::DIDx;
+};
+
+/*
+  The PipelineExecutor runs a sequence of Fusions as the stages of a pipeline.
+  Stage i runs on the devices at index i along `stage_parallel_type` of the
+  DeviceMesh. Each device only compiles and runs its own stage with a
+  FusionExecutorCache, and exchanges the activations, and their gradients,
+  with the devices at the same position in the neighboring stages.
+
+  Without backward Fusions, the micro-batches flow through the stages one
+  after the other. With backward Fusions, the stages follow the
+  one-forward-one-backward (1F1B) schedule: stage i runs the forward pass of
+  (num_stages - i - 1) micro-batches, then alternates one forward and one
+  backward pass, and finally runs the remaining backward passes. This bounds
+  the number of micro-batches whose inputs are kept for the backward pass to
+  the number of stages.
+
+  The send/recvs are posted on a dedicated stream, and the sends and recvs
+  that two stages post to each other at the same step of the schedule are
+  grouped to avoid deadlocks. The compute stream only waits for the received
+  tensors before using them. The sizes of the activations are exchanged once
+  per run, with the first micro-batch, so the micro-batches must have the same
+  sizes.
+
+  When the profiler is enabled, the forward, backward and idle GPU times of
+  the stage are recorded in FusionProfiler::pipelineStageProfile.
+*/
+class PipelineExecutor {
+ public:
+  PipelineExecutor(
+      std::vector<PipelineStage> stages,
+      const DeviceMesh& mesh,
+      Communicator& comm = Communicator::getInstance(),
+      PipelineExecutorParams params = PipelineExecutorParams());
+
+  // Runs the pipeline. `inputs` are the inputs of the first stage's forward
+  // that are split into micro-batches, and are ignored by the other stages.
+  // `parameters` are the trailing inputs of the forward of this device's
+  // stage.
+  //
+  // Returns, on the last stage, the outputs of its forward for each
+  // micro-batch in order, followed, with backward Fusions, by the accumulated
+  // trailing outputs of this device's backward.
+  KernelArgumentHolder runWithInput(
+      const KernelArgumentHolder& inputs,
+      const KernelArgumentHolder& parameters = {});
+
+  // Returns the stage of this device
+  int64_t stage() const {
+    return stage_;
+  }
+
+  int64_t numStages() const {
+    return std::ssize(peers_);
+  }
+
+  bool hasBackward() const {
+    return backward_ != nullptr;
+  }
+
+  // Returns the devices running the stages at the same position as this
+  // device, indexed by stage
+  const std::vector<DeviceIdxType>& peers() const {
+    return peers_;
+  }
+
+  Communicator* comm() const {
+    return &comm_;
+  }
+
+ private:
+  Communicator& comm_;
+  PipelineExecutorParams params_;
+  std::vector<DeviceIdxType> peers_;
+  int64_t stage_ = -1;
+  // The number of outputs of the previous stage's forward, i.e., of
+  // activations received by this stage. -1 on the first stage.
+  int64_t num_received_activations_ = -1;
+  std::unique_ptr<FusionExecutorCache> forward_;
+  std::unique_ptr<FusionExecutorCache> backward_;
+  c10::cuda::CUDAStream p2p_stream_;
+};
+
+} // namespace nvfuser
@@ -128,6 +128,7 @@ std::unordered_map<DebugDumpOption, std::vector<std::string>> Options<
       {"kernel_ir", DebugDumpOption::KernelIr},
       {"launch_param", DebugDumpOption::LaunchParam},
       {"loop_rotation", DebugDumpOption::LoopRotation},
+      {"lower_pass_times", DebugDumpOption::LowerPassTimes},
       {"lower_verbose", DebugDumpOption::LowerVerbose},
       {"occupancy", DebugDumpOption::Occupancy},
       {"parallel_dimensions", DebugDumpOption::ParallelDimensions},
@@ -156,21 +157,78 @@ std::unordered_map<DebugDumpOption, std::vector<std::string>> Options<
 const std::unordered_map<std::string, EnableOption>& getEnableOptions() {
   static const std::unordered_map<std::string, EnableOption> available_options =
       {
+          {"async_compile", EnableOption::AsyncCompile},
+          {"atomic_max_reduction", EnableOption::AtomicMaxReduction},
+          {"atomic_reduction", EnableOption::AtomicReduction},
+          {"autotune", EnableOption::Autotune},
+          {"bank_conflict_repair", EnableOption::BankConflictRepair},
+          {"blackwell_matmul_heuristic",
+           EnableOption::BlackwellMatmulHeuristic},
+          {"cluster_reduction", EnableOption::ClusterReduction},
+          {"coalesce_communications", EnableOption::CoalesceCommunications},
+          {"collective_matmul", EnableOption::CollectiveMatmul},
+          {"compile_for_archs", EnableOption::CompileForArchs},
+          {"cost_model", EnableOption::CostModel},
+          {"cuda_graph", EnableOption::CudaGraph},
+          {"deterministic", EnableOption::Deterministic},
+          {"fast_codegen", EnableOption::FastCodegen},
+          {"fast_math", EnableOption::FastMath},
           {"fuse_matmul", EnableOption::FuseMatmul},
+          {"fuse_matmul_prologue", EnableOption::FuseMatmulPrologue},
           {"fuse_multiple_matmuls", EnableOption::FuseMultipleMatmuls},
+          {"hierarchical_collectives", EnableOption::HierarchicalCollectives},
+          {"horizontal_fusion", EnableOption::HorizontalFusion},
+          {"host_ir_memory_plan", EnableOption::HostIrMemoryPlan},
+          {"host_ir_tape", EnableOption::HostIrTape},
           {"id_model", EnableOption::IdModel},
           {"id_model_extra_validation", EnableOption::IdModelExtraValidation},
+          {"inline_ptx_patterns", EnableOption::InlinePtxPatterns},
+          {"inplace_segment_outputs", EnableOption::InplaceSegmentOutputs},
+          {"intermediate_buffer_pool", EnableOption::IntermediateBufferPool},
           {"io_to_lower_precision", EnableOption::IoToLowerPrecision},
+          {"kernel_arg_table", EnableOption::KernelArgTable},
+          {"kernel_cache", EnableOption::KernelCache},
           {"kernel_db", EnableOption::KernelDb},
           {"kernel_debug", EnableOption::KernelDebug},
           {"kernel_lineinfo", EnableOption::KernelLineInfo},
           {"kernel_profile", EnableOption::KernelProfile},
+          {"kernel_remarks", EnableOption::KernelRemarks},
+          {"l2_persistence", EnableOption::L2Persistence},
+          {"lazy_module_load", EnableOption::LazyModuleLoad},
+          {"matmul_plan_cache", EnableOption::MatmulPlanCache},
+          {"megakernel", EnableOption::Megakernel},
           {"memory_promotion", EnableOption::MemoryPromotion},
+          {"mixed_index_type", EnableOption::MixedIndexType},
+          {"mixed_vectorization", EnableOption::MixedVectorization},
+          {"multi_stream", EnableOption::MultiStream},
+          {"nvrtc_pch", EnableOption::NvrtcPch},
+          {"pack_shared_memory", EnableOption::PackSharedMemory},
+          {"parallel_lowering_analyses",
+           EnableOption::ParallelLoweringAnalyses},
+          {"peel_serial_loops", EnableOption::PeelSerialLoops},
+          {"persistent_grid", EnableOption::PersistentGrid},
+          {"prefetch_allgathers", EnableOption::PrefetchAllgathers},
+          {"programmatic_dependent_launch",
+           EnableOption::ProgrammaticDependentLaunch},
+          {"recompute_producers", EnableOption::RecomputeProducers},
+          {"register_spill_feedback", EnableOption::RegisterSpillFeedback},
           {"reuse_zeroed_memory", EnableOption::ReuseZeroedMemory},
+          {"ring_attention", EnableOption::RingAttention},
+          {"selective_magic_zero", EnableOption::SelectiveMagicZero},
+          {"shape_buckets", EnableOption::ShapeBuckets},
           {"static_fusion_count", EnableOption::StaticFusionCount},
+          {"strength_reduce_indices", EnableOption::StrengthReduceIndices},
+          {"strided_communication", EnableOption::StridedCommunication},
+          {"symmetric_memory", EnableOption::SymmetricMemory},
+          {"tiered_compile", EnableOption::TieredCompile},
+          {"tma_pointwise", EnableOption::TmaPointwise},
+          {"tma_transpose", EnableOption::TmaTranspose},
+          {"translate_sdpa", EnableOption::TranslateSdpa},
+          {"unroll_budget", EnableOption::UnrollBudget},
           {"wait_debugger", EnableOption::WaitDebugger},
           {"warn_register_spill", EnableOption::WarnRegisterSpill},
           {"ws_normalization", EnableOption::WarpSpecializedNormalization},
+          {"zero_copy_cat", EnableOption::ZeroCopyCat},
           {"host_ir_lowering", EnableOption::HostIrLowering},
       };
   return available_options;
@@ -212,9 +270,13 @@ const std::unordered_map<std::string, DisableOption>& getDisableOptions() {
           {"parallel_serde", DisableOption::ParallelSerde},
           {"predicate_elimination", DisableOption::PredicateElimination},
           {"python_inline_definitions", DisableOption::PythonInlineDefinitions},
+          {"kernel_binary_cache", DisableOption::KernelBinaryCache},
           {"kernel_reuse", DisableOption::KernelReuse},
           {"var_name_remapping", DisableOption::VarNameRemapping},
           {"welford_vectorization", DisableOption::WelfordVectorization},
+          {"redundant_sync_removal", DisableOption::RedundantSyncRemoval},
+          {"redux_sync", DisableOption::ReduxSync},
+          {"resize_rotary_pairs", DisableOption::ResizeRotaryPairs},
           {"resize_scheduler", DisableOption::ResizeScheduler},
           {"reuse_mismatched_type_registers",
            DisableOption::ReuseMismatchedTypeRegisters},
@@ -257,6 +319,8 @@ std::unordered_map<ProfilerOption, std::vector<std::string>> Options<
       {"print", ProfilerOption::Print},
       {"print.nocupti", ProfilerOption::PrintNocupti},
       {"print.verbose", ProfilerOption::PrintVerbose},
+      {"export", ProfilerOption::Export},
+      {"sample", ProfilerOption::Sample},
   };
 
   auto options = parseEnvOptions("PROF", available_options);
@@ -331,10 +395,23 @@ bool hasDisableOptionArguments(DisableOption option, const std::string& arg) {
 }
 
 bool isProfilerEnabled() {
-  return ProfilerOptionsGuard::getCurOptions().hasAny();
+  const auto& options = ProfilerOptionsGuard::getCurOptions();
+  if (!options.hasAny()) {
+    return false;
+  }
+  if (!options.has(ProfilerOption::Sample)) {
+    return true;
+  }
+  // Sampling alone doesn't enable the profiler
+  return options.has(ProfilerOption::Enable) ||
+      options.has(ProfilerOption::EnableNocupti) ||
+      options.has(ProfilerOption::Print) ||
+      options.has(ProfilerOption::PrintNocupti) ||
+      options.has(ProfilerOption::PrintVerbose) ||
+      options.has(ProfilerOption::Export);
 }
 bool isProfilerEnabledWithCupti() {
-  return ProfilerOptionsGuard::getCurOptions().hasAny() &&
+  return isProfilerEnabled() &&
       !(ProfilerOptionsGuard::getCurOptions().has(
             ProfilerOption::EnableNocupti) ||
         ProfilerOptionsGuard::getCurOptions().has(
@@ -349,5 +426,8 @@ bool isProfilerPrintingVerbose() {
   return ProfilerOptionsGuard::getCurOptions().has(
       ProfilerOption::PrintVerbose);
 }
+bool isProfilerExportEnabled() {
+  return ProfilerOptionsGuard::getCurOptions().has(ProfilerOption::Export);
+}
 
 } // namespace nvfuser
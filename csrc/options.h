@@ -79,6 +79,8 @@ enum class DebugDumpOption {
   BankConflictInfo, //! Dump bank confliction info
   SyncMap, //! RAW dependency info
   LowerVerbose, //! Print all passes' transform in GpuLower::lower
+  LowerPassTimes, //! Print the host time and the number of expressions after
+                  //! each step of GpuLower
   ExprSimplification, //! Print all passes' transform in simplifyExpr
   ExprSort, //! Print merging decisions on expression sorting
   ExprSortVerbose, //! Print verbose debug info on expression sorting
@@ -96,24 +98,214 @@ enum class DebugDumpOption {
 //! These can be set through the `NVFUSER_ENABLE` environment variable
 //!
 enum class EnableOption {
+  AsyncCompile, //! Compile new FusionKernelRuntimes in the background and
+                //! evaluate the fusion with ExpressionEvaluator until the
+                //! kernels are ready
+  AtomicMaxReduction, //! Let the blocks of grid reductions whose only
+                      //! reduction is a maximum written to a fusion output,
+                      //! e.g., the amax of FP8 quantization, combine their
+                      //! partial maxima in the output with atomics instead
+                      //! of a work buffer and a grid sync. The output is
+                      //! filled with the init value before each launch.
+  AtomicReduction, //! Let the blocks of grid outer reductions add their
+                   //! partial sums to the zeroed output with atomics instead
+                   //! of a work buffer and a grid sync. The result is not
+                   //! deterministic, so EnableOption::Deterministic disables
+                   //! it.
+  Autotune, //! Time a bounded set of scheduler parameters when compiling new
+            //! pointwise, reduction, inner persistent and transpose segments,
+            //! and numbers of streams in the first runs of host programs with
+            //! stream-parallel loops, and persist the fastest in a tuning
+            //! database. The optional argument is the number of candidates
+            //! (default 16).
+  BankConflictRepair, //! Swizzle shared memory buffers found to have bank
+                      //! conflicts when their layout is not constrained by
+                      //! MMA or TMA, see repairBankConflicts
+  BlackwellMatmulHeuristic, //! Schedule matmuls on Blackwell with the
+                            //! default heuristic, which pairs CTAs along M
+                            //! but still issues single-CTA MMAs
+  ClusterReduction, //! Reduce across the blocks of small grid reductions within
+                    //! a thread block cluster through distributed shared
+                    //! memory on Hopper and newer, and split persistent
+                    //! buffers too large for a block across a cluster
+  CoalesceCommunications, //! Group independent NCCL communications of the host
+                          //! program into coalesced blocks, see
+                          //! hir_pass::CoalesceCommunications
+  CollectiveMatmul, //! Pipeline the allgathers feeding and the reductions
+                    //! consuming tensor-parallel matmuls over CUDA streams,
+                    //! see OverlapCollectiveMatmulPass. The optional argument
+                    //! is the minimum chunk size in KiB (default 1024).
+  CompileForArchs, //! Also compile each kernel to SASS for the compute
+                   //! capabilities given as arguments, e.g.
+                   //! compile_for_archs(80,90), so that a serialized
+                   //! FusionCache can be loaded on those architectures
+  CostModel, //! Choose between schedulers and decide whether to merge
+             //! segments by the runtime SchedulerEntry::predictCost predicts,
+             //! and choose the allocation order of outputs by the strided
+             //! accesses it implies
+  CudaGraph, //! Capture the segments of a FusionKernelRuntime into a CUDA graph
+             //! and replay it for repeated inputs
+  Deterministic, //! Make fusions reproduce their results bit for bit from run
+                 //! to run. Always launch the compiled kernels instead of the
+                 //! ExpressionEvaluator fallback of AsyncCompile and
+                 //! TieredCompile, and don't choose parameters by timing them
+                 //! with Autotune
+  FastCodegen, //! Reuse string streams and memoize the inline strings of
+               //! scalar expressions when generating the CUDA kernel
+  FastMath, //! Compute exp, exp2, log, log2, log10, sin, cos, tanh, sigmoid,
+            //! silu and reciprocal of floats with approximate instructions,
+            //! e.g., ex2.approx and tanh.approx. See ValidationConstants for
+            //! their error bounds.
   FuseMatmul, //! Enable automatic fusion of matmul and linear ops
+  FuseMatmulPrologue, //! Fuse pointwise ops computing the operands of a matmul
+                      //! into the Hopper matmul kernel, between the TMA load
+                      //! and the MMA
   FuseMultipleMatmuls, //! Allow fusing more than one matmul in a single kernel
+  HierarchicalCollectives, //! Post allreduces and reduce-scatters spanning
+                           //! several NVLink domains as an intra-domain
+                           //! reduce-scatter, an inter-domain collective and,
+                           //! for allreduces, an intra-domain allgather. The
+                           //! optional argument is the number of ranks per
+                           //! domain (default: ranks per node).
+  HorizontalFusion, //! Merge independent segments that the pointwise or
+                    //! the reduction scheduler can schedule together into
+                    //! one kernel, see SegmentCandidateFinder::horizontalMerge
+  HostIrMemoryPlan, //! Carve the top-level intermediates of host programs out
+                    //! of one workspace at offsets packed by their lifetimes
+  HostIrTape, //! Compile the top-level expressions of HostIrEvaluator into a
+              //! tape with pre-resolved kernel executors, streams and events
+              //! instead of interpreting them at every run
   IdModel, //! Enable IdModel
   IdModelExtraValidation, //! Enable extra error checking when building IdModel
+  InlinePtxPatterns, //! Let lowerToInlinePtx pack pairs of float to half or
+                     //! bf16 casts into one cvt and load fusion inputs with
+                     //! ld.global.nc.L1::no_allocate
+  InplaceSegmentOutputs, //! Write the outputs of pointwise segments into the
+                         //! storage of intermediates that die with the
+                         //! segment and have the same sizes and strides
+  IntermediateBufferPool, //! Retain intermediate global buffers of a kernel
+                          //! between launches with the same inputs. The
+                          //! optional argument caps the total retained memory
+                          //! in MiB (default 256).
   IoToLowerPrecision, //! Enable castInputOutputToLowerPrecision. #1889 explains
                       //! why we disabled it by default.
+  KernelArgTable, //! Pass the arguments of every kernel through a table in
+                  //! device memory, which is otherwise only done when they
+                  //! exceed the 4 KB limit of kernel parameters
+  KernelCache, //! Persist compiled kernels in a content-addressed cache
+               //! directory shared across processes. The optional argument
+               //! is the size limit in MiB (default 4096).
   KernelDb, //! Enable Kernel Database
   KernelDebug, //! Enable debug mode in nvrtc
   KernelLineInfo, //! Embed line info to compiled kernel, and dump the full CUDA
                   //! C++ code
   KernelProfile, //! Enable intra-kernel performance profiling
+  KernelRemarks, //! Collect optimization remarks of schedulers and lowering
+                 //! passes for each segment, see remarks.h
+  L2Persistence, //! Keep intermediates passed from one segment to the next
+                 //! resident in the persisting L2 carve-out, and load
+                 //! expanded operands with an L2 evict_last hint
+  LazyModuleLoad, //! Defer loading the modules of deserialized kernels to
+                  //! their first launch
+  MatmulPlanCache, //! Run the 2D matmuls of ExprEvalExecutor with cuBLASLt
+                   //! plans cached by problem, see MatmulPlanCache. With the
+                   //! "tune" argument, the algorithm of a problem is the
+                   //! fastest of the heuristic candidates on its first use.
+  Megakernel, //! Experimental. Run the kernels of consecutive segments with
+              //! the same small grid as one persistent kernel with grid
+              //! syncs between them, see LaunchChain. The optional argument
+              //! is the maximum number of blocks (default: number of SMs).
   MemoryPromotion, //! Enable promotion of memory types for non-pointwise ops
+  MixedIndexType, //! Index the input tensors that fit in 32 bits with 32-bit
+                  //! offset arithmetic in kernels that use 64-bit indexing
+  MixedVectorization, //! Vectorize the inputs and outputs of pointwise
+                      //! kernels by the factors each of them supports,
+                      //! instead of the smallest one
+  MultiStream, //! Run segments that don't depend on each other concurrently
+               //! on side streams, see assignGroupStreams. The optional
+               //! argument is the number of streams including the current
+               //! one (default: 4, at most 8).
+  NvrtcPch, //! Pass the runtime library to NVRTC as a header and let it
+            //! precompile the header once per process (CUDA 12.8+)
+  PackSharedMemory, //! Assign shared memory addresses of statically sized
+                    //! buffers by packing their live intervals when it needs
+                    //! less memory than the stack-based allocation
+  ParallelLoweringAnalyses, //! Build SyncMap and CircularBufferInfo on the
+                            //! thread pool while NonDivisibleSplitInfo is
+                            //! built during lowering
+  PeelSerialLoops, //! Peel the last iteration of serial loops around unswitched
+                   //! loops and run the others without predicates when a
+                   //! single check before the loop passes
+  PersistentGrid, //! Launch no more blocks than can be resident on the device
+                  //! for 1D pointwise and reduction kernels, and let each
+                  //! block loop over the remaining tiles with a grid stride
+  PrefetchAllgathers, //! Issue the allgathers of sharded fusion inputs on a
+                      //! side stream before the preceding compute, see
+                      //! hir_pass::PrefetchAllgathers. The optional argument
+                      //! is the number of gathered inputs prefetched across
+                      //! one expression (default 2).
+  ProgrammaticDependentLaunch, //! Let the kernels of segments start before
+                               //! the preceding kernel completes (sm_90+),
+                               //! waiting for it before accessing global
+                               //! memory
+  RecomputeProducers, //! Let segments recompute the cheap pointwise
+                      //! producers of tensors consumed by several segments,
+                      //! e.g., casts and broadcasts, instead of reading them
+                      //! from global memory, see recomputeCheapProducers. The
+                      //! optional argument is the maximum number of
+                      //! recomputed expressions per tensor (default 4).
+  RegisterSpillFeedback, //! Recompile kernels of tunable segments that spill
+                         //! registers with a higher register limit or less
+                         //! unrolling and record the fix in the tuning
+                         //! database. The optional argument is the number of
+                         //! retries (default 2).
   ReuseZeroedMemory, //! Re-use zeroed memory used for grid synchronization
+  RingAttention, //! Replace the allgathers of the key and the value of
+                 //! sequence-parallel attentions in host programs by a ring
+                 //! of send/recv overlapped with partial attentions, see
+                 //! hir_pass::RingAttention
+  SelectiveMagicZero, //! Protect only the indices of unrolled loop nests whose
+                      //! hoisted addresses are estimated to need more
+                      //! registers than the optional argument (default 32)
+                      //! with magic zero, see selectMagicZeroLoops
+  ShapeBuckets, //! Compute heuristics of pointwise and transpose fusions from
+                //! extents rounded into buckets, so that inputs of the same
+                //! bucket reuse one FusionKernelRuntime. The optional argument
+                //! is "pow2" (default) or the bucket width, e.g. 64
   StaticFusionCount, //! Enable using single static count in kernel name
+  StrengthReduceIndices, //! Increment hoisted indices that are linear in the
+                         //! index of a serial loop at the end of each
+                         //! iteration instead of recomputing them
+  StridedCommunication, //! Communicate allgathers whose gathered axis isn't
+                        //! outermost and non-contiguous send/recvs as grouped
+                        //! send/recvs of dense segments instead of copying
+                        //! them to a contiguous layout. The optional argument
+                        //! is the maximum number of segments per peer
+                        //! (default 256), beyond which the data is staged.
+  SymmetricMemory, //! Allocate the buffers exported by kCuda communications
+                   //! once per HostIrEvaluator, at the same point of the
+                   //! host program on every rank, so that their IPC handles
+                   //! are exchanged only on the first run
+  TieredCompile, //! Evaluate fusions with ExpressionEvaluator for the first
+                 //! runs with the same inputs and compile their kernels in
+                 //! the background on the run given by the optional
+                 //! argument (default 2)
+  TmaPointwise, //! Stage inputs and outputs of the pointwise scheduler through
+                //! shared memory with circular buffered TMA loads and TMA
+                //! stores on Hopper and newer
+  TmaTranspose, //! Load and store the tiles of the transpose scheduler with TMA
+                //! and swizzled shared memory on Hopper and newer
+  TranslateSdpa, //! Translate attentions decomposed into matmul, softmax and
+                 //! matmul to SdpaFwdOp, see TranslateDecomposedSdpa
+  UnrollBudget, //! Cap the unroll factors of loops when the instruction count
+                //! estimated by capUnrollFactors exceeds the budget given by
+                //! the optional argument (default 8192 instructions)
   WaitDebugger, // Used for debugging multi-GPU. The rank given in the argument
                 // will wait for `gdb attach` at the start.
   WarnRegisterSpill, //! Enable warnings of register spill
   WarpSpecializedNormalization, //! Enable warp specialized persistent kernel
+  ZeroCopyCat, //! Let segments write the inputs of a CatOp that is segmented
+               //! on its own directly into the slices of its output
   HostIrLowering, //! Enable FusionKernelRuntime lowering to host IR
   EndOfOption //! Placeholder for counting the number of elements
 };
@@ -138,9 +330,12 @@ enum class DisableOption {
                   //! matmul
   Nvtx, //! Disable NVTX instrumentation
   ParallelCompile, //! Disable compiling Fusion segments in parallel
-  ParallelSerde, //! Disable deserializing FusionExecutorCache in parallel
+  ParallelSerde, //! Disable deserializing FusionExecutorCache and the segments
+                 //! of FusionKernelRuntime in parallel
   PredicateElimination, //! Disable predicate elimination
   PythonInlineDefinitions, //! Disable printing of inline definitions
+  KernelBinaryCache, //! Disable re-using binaries and loaded modules of
+                     //! identical kernels compiled earlier in this process
   KernelReuse, //! Disable re-using cached FusionKernelRuntimes with different
                //! input shapes
   VarNameRemapping, //! Disable variable name remapping
@@ -153,13 +348,18 @@ enum class DisableOption {
                //! need this in particular to investigate possible conflicts
                //! between nvFuser communicator and the framework also setting
                //! up `c10d::ProcessGroup`
+  RedundantSyncRemoval, //! Disable removing block syncs that are covered by
+                        //! another block sync
+  ReduxSync, //! Disable redux.sync in warp reductions of 32-bit integers
+  ResizeRotaryPairs, //! Disable computing both halves of the rotations of
+                     //! RoPE in the same thread in the resize scheduler
   ResizeScheduler, //! Disable the resize scheduler
   EndOfOption //! Placeholder for counting the number of elements
 };
 
 //! Options to set for Fusion Profiling.  Whenever the profiler
 //! is enabled, its output can be queried from the FusionProfile object.
-//! All options enable the profiler.
+//! All options but Sample enable the profiler.
 //!
 //! These can be set through the `NVFUSER_PROF` environment variable
 //!
@@ -175,6 +375,15 @@ enum class ProfilerOption {
   PrintVerbose, //! Enables the profiler and prints a complete set of columns
                 //! to the console.  WARNING: The output is will wrap on small
                 //! screens!
+  Export, //! Enables the profiler and appends a row per kernel to the file
+          //! given as first argument, in CSV or, if the file name ends with
+          //! .json, in JSON Lines. Kernels reaching less than the percentage
+          //! of the roofline given as optional second argument (default 50)
+          //! are flagged.
+  Sample, //! Samples the latency of 1 in N executions of each fusion and of
+          //! its segments with CUDA events, where N is the argument (default
+          //! 100), without enabling the profiler. The histograms are queried
+          //! with FusionExecutorCache::sampledLatencies.
   EndOfOption //! Placeholder for counting the number of elements
 };
 
@@ -329,6 +538,7 @@ bool isProfilerEnabled();
 bool isProfilerEnabledWithCupti();
 bool isProfilerPrintingEnabled();
 bool isProfilerPrintingVerbose();
+bool isProfilerExportEnabled();
 
 const std::vector<std::string>& getProfilerOptionArguments(
     ProfilerOption option);
@@ -11,6 +11,9 @@
 #include <iter_visitor.h>
 #include <logical_domain_map.h>
 #include <preseg_passes/allocation_order_inference.h>
+#include <scheduler/cost_model.h>
+
+#include <ranges>
 
 namespace nvfuser::preseg_passes {
 
@@ -78,10 +81,10 @@ int64_t countNonTrivialIterDomains(const TensorView* tv) {
 // 3. append reversed mapped_ids at the end of unmapped_id_vec.
 //   target_alloc_domain
 //   {iS3[i3], iS4[i4], iS6[i5], ir8[1], iS5[i1], iS7[i2]}
-void mapAllocationDomain(
+std::vector<IterDomain*> mappedAllocationDomain(
     const IdModel& id_model,
     const TensorView* ref,
-    TensorView* target) {
+    const TensorView* target) {
   const ValGraph& exact_graph = id_model.idGraph(IdMappingMode::EXACT);
 
   std::vector<IterDomain*> ref_alloc_domain = ref->getMaybeAllocationDomain();
@@ -215,12 +218,120 @@ void mapAllocationDomain(
   std::copy(mapped_ids.rbegin(), mapped_ids.rend(), unmapped_ids_vec_end);
 #endif
 
+  return target_alloc_domain;
+}
+
+void mapAllocationDomain(
+    const IdModel& id_model,
+    const TensorView* ref,
+    TensorView* target) {
+  std::vector<IterDomain*> target_alloc_domain =
+      mappedAllocationDomain(id_model, ref, target);
   // skip trivial allocation domain
-  if (target_alloc_domain != target_logical_domain) {
+  if (target_alloc_domain != target->getLogicalDomain()) {
     target->setAllocationDomain(target_alloc_domain, true);
   }
 }
 
+// Note [ Cost-Driven Allocation Order ]
+//
+// With EnableOption::CostModel, instead of propagating the allocation order of
+// a single reference, which is given up on when references disagree, we
+// evaluate candidate allocation orders of a target against all the tensors it
+// is computed with and pick the cheapest:
+//   candidates: the logical order of the target, the order propagated from
+//   the reference of Note [ Allocation Order Propagation ], and the order
+//   mapped from each of the tensors below.
+//   tensors: the sources that the target depends on, and the outputs whose
+//   allocation domain was set by the user, which the target shares an input
+//   with, since they are likely written by the same kernel.
+//   cost: a tensor whose innermost non-trivial allocation ID maps to a logical
+//   ID of the target, but not to the innermost one of the candidate, is
+//   accessed with a stride in a kernel that coalesces the target, or forces a
+//   transpose. It adds its weight, i.e., its number of non-trivial IDs times
+//   its element size, as a proxy for its size.
+// Ties go to the candidate listed first, so the legacy propagation is kept
+// unless another order is strictly cheaper.
+
+// Returns the ValGroup of the innermost non-trivial ID of `alloc_domain`, if
+// any
+std::optional<ValGroup> innermostGroup(
+    const ValGraph& exact_graph,
+    const std::vector<IterDomain*>& alloc_domain) {
+  for (IterDomain* id : alloc_domain | std::views::reverse) {
+    if (id->isBroadcast() || id->isReduction()) {
+      continue;
+    }
+    if (!exact_graph.hasGroup(id)) {
+      return std::nullopt;
+    }
+    return exact_graph.toGroup(id);
+  }
+  return std::nullopt;
+}
+
+int64_t layoutCost(
+    const ValGraph& exact_graph,
+    const std::vector<TensorView*>& tvs,
+    const TensorView* target,
+    const std::vector<IterDomain*>& candidate) {
+  std::optional<ValGroup> candidate_inner =
+      innermostGroup(exact_graph, candidate);
+  int64_t cost = 0;
+  for (TensorView* tv : tvs) {
+    std::optional<ValGroup> inner =
+        innermostGroup(exact_graph, tv->getMaybeAllocationDomain());
+    if (!inner.has_value() || inner == candidate_inner) {
+      continue;
+    }
+    // The layout of the target doesn't matter to a tensor whose innermost ID
+    // isn't in the target, e.g., when it's reduced.
+    if (std::none_of(
+            target->getLogicalDomain().begin(),
+            target->getLogicalDomain().end(),
+            [&](IterDomain* id) {
+              return exact_graph.hasGroup(id) &&
+                  exact_graph.toGroup(id) == *inner;
+            })) {
+      continue;
+    }
+    cost += countNonTrivialIterDomains(tv) *
+        (int64_t)dataTypeSizeByte(tv->getDataType().value());
+  }
+  return cost;
+}
+
+// See Note [ Cost-Driven Allocation Order ]
+void selectAllocationDomainByCost(
+    const IdModel& id_model,
+    const std::vector<TensorView*>& tvs,
+    const TensorView* ref,
+    TensorView* target) {
+  const ValGraph& exact_graph = id_model.idGraph(IdMappingMode::EXACT);
+
+  std::vector<std::vector<IterDomain*>> candidates;
+  if (ref != nullptr) {
+    candidates.push_back(mappedAllocationDomain(id_model, ref, target));
+  }
+  candidates.push_back(target->getLogicalDomain());
+  for (TensorView* tv : tvs) {
+    candidates.push_back(mappedAllocationDomain(id_model, tv, target));
+  }
+
+  const std::vector<IterDomain*>* best = nullptr;
+  int64_t best_cost = 0;
+  for (const std::vector<IterDomain*>& candidate : candidates) {
+    int64_t cost = layoutCost(exact_graph, tvs, target, candidate);
+    if (best == nullptr || cost < best_cost) {
+      best = &candidate;
+      best_cost = cost;
+    }
+  }
+  if (*best != target->getLogicalDomain()) {
+    target->setAllocationDomain(*best, true);
+  }
+}
+
 // Note [ Allocation Order Propagation ]
 //
 // The propagation tries to populate allocation domain from srcs to dsts.
@@ -257,7 +368,8 @@ void mapAllocationDomain(
 void inferAllocationOrder(
     Fusion* fusion,
     const std::vector<TensorView*>& srcs,
-    const std::vector<TensorView*>& dsts) {
+    const std::vector<TensorView*>& dsts,
+    const std::vector<TensorView*>& constrained_outputs) {
   // build IdModel, setting allow_self_mapping to avoid assert
   // even though we do NOT populate allocation order where self_mapping is
   // present
@@ -291,6 +403,8 @@ void inferAllocationOrder(
 
     // find a ref among srcs to be propagated to given dst
     TensorView* ref = nullptr;
+    // srcs that dst depends on, weighed by the cost-driven selection
+    std::vector<TensorView*> deps;
 
     // high water mark for candidate of ref.
     int64_t non_bc_high_water_mark = 0;
@@ -303,6 +417,7 @@ void inferAllocationOrder(
       if (!DependencyCheck::isDependencyOf(tv, dst)) {
         continue;
       }
+      deps.push_back(tv);
       // discard srcs with lower iterdomain count than ref.
       if (non_trivial_iter_count[tv] < non_bc_high_water_mark) {
         continue;
@@ -341,6 +456,19 @@ void inferAllocationOrder(
       }
     }
 
+    if (cost_model::isEnabled()) {
+      std::vector<TensorView*> tvs = deps;
+      for (TensorView* output : constrained_outputs) {
+        if (std::any_of(deps.begin(), deps.end(), [&](TensorView* tv) {
+              return DependencyCheck::isDependencyOf(tv, output);
+            })) {
+          tvs.push_back(output);
+        }
+      }
+      selectAllocationDomainByCost(id_model, tvs, ref, dst);
+      continue;
+    }
+
     // propagate allocation domain if we still have a candidate.
     if (ref) {
       mapAllocationDomain(id_model, ref, dst);
@@ -405,6 +533,9 @@ void AllocationDomainPass::runPass(Fusion* fusion) {
   auto output_tvs = ir_utils::filterByType<TensorView>(fusion->outputs());
   std::vector<TensorView*> dsts;
   dsts.reserve(output_tvs.size());
+  // outputs whose allocation domain is given, see Note [ Cost-Driven
+  // Allocation Order ]
+  std::vector<TensorView*> constrained_outputs;
   // TODO: instead of exclusion to propagation, this pass should mark it clear
   // that the propagated allocation order is strictly an optimization hint,
   // rather than a semantic requirement coming from computation definition.
@@ -412,6 +543,9 @@ void AllocationDomainPass::runPass(Fusion* fusion) {
   // hint, but they should respect semantic requirement.
   // see issue: https://github.com/NVIDIA/Fuser/pull/2425
   for (TensorView* output : output_tvs) {
+    if (output->hasAllocation()) {
+      constrained_outputs.push_back(output);
+    }
     if (Expr* def = output->definition()) {
       if (def->isOneOf<LinearOp, SdpaFwdOp, SdpaBwdOp, MatmulOp, MmaOp>()) {
         continue;
@@ -420,7 +554,7 @@ void AllocationDomainPass::runPass(Fusion* fusion) {
     dsts.push_back(output);
   }
   // propagate allocation domain from sources to destinations
-  inferAllocationOrder(fusion, srcs, dsts);
+  inferAllocationOrder(fusion, srcs, dsts, constrained_outputs);
 
   SdpaPropagator sdpa_propagator;
   for (Expr* e : fusion->exprs()) {
@@ -16,7 +16,10 @@ namespace nvfuser::preseg_passes {
 
 // Realize allocation order propagation on fusion inputs to optimize allocation
 // domain of output tensor. This optimization pass currently only applies to
-// fusion outputs, but not intermediate tensors.
+// fusion outputs, but not intermediate tensors. With EnableOption::CostModel,
+// the allocation order of each output is instead chosen among candidate orders
+// by the strided accesses they imply, see
+// Note [ Cost-Driven Allocation Order ].
 class AllocationDomainPass : public OptimizationPass<AllocationDomainPass> {
   friend class OptimizationPass<AllocationDomainPass>;
 
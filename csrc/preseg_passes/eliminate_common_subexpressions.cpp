@@ -0,0 +1,175 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <preseg_passes/eliminate_common_subexpressions.h>
+
+#include <debug.h>
+#include <ir/utils.h>
+#include <ops/arith.h>
+#include <options.h>
+
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace nvfuser::preseg_passes {
+
+namespace {
+
+bool isCast(Expr* expr) {
+  auto* uop = dynamic_cast<UnaryOp*>(expr);
+  return uop != nullptr && uop->getUnaryOpType() == UnaryOpType::Cast;
+}
+
+// Returns whether `expr` computes the same values whenever it has the same
+// inputs
+bool isPure(Expr* expr) {
+  if (expr->isOneOf<RNGOp, SdpaFwdOp>() || expr->outputs().empty()) {
+    return false;
+  }
+  return std::all_of(
+      expr->outputs().begin(), expr->outputs().end(), [](Val* out) {
+        auto* tv = dynamic_cast<TensorView*>(out);
+        return tv != nullptr && !tv->hasAllocation();
+      });
+}
+
+bool producesFusionOutput(Expr* expr) {
+  return std::any_of(
+      expr->outputs().begin(), expr->outputs().end(), [](Val* out) {
+        return out->isFusionOutput();
+      });
+}
+
+// An expression with its inputs after the replacements
+struct VisitedExpr {
+  Expr* expr;
+  std::vector<Val*> inputs;
+};
+
+bool computesSameValues(const VisitedExpr& a, const VisitedExpr& b) {
+  if (!a.expr->sameOp(b.expr)) {
+    return false;
+  }
+  for (auto&& [in, other_in] : zip(a.inputs, b.inputs)) {
+    if (in != other_in && (in->isA<TensorView>() || !in->sameAs(other_in))) {
+      return false;
+    }
+  }
+  for (auto&& [out, other_out] : zip(a.expr->outputs(), b.expr->outputs())) {
+    if (out->dtype() != other_out->dtype() ||
+        !TensorDomain::sameAs(
+            out->as<TensorView>()->getLogicalDomain(),
+            other_out->as<TensorView>()->getLogicalDomain())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// For `expr` = castOp(dtype, broadcast(castOp(_, in))) with `in` of dtype and
+// a first cast that doesn't lose precision, returns broadcast(in)
+TensorView* removeCastRoundTrip(
+    Expr* expr,
+    const std::unordered_map<Val*, Val*>& replacements) {
+  if (!isCast(expr) || !isPure(expr) || producesFusionOutput(expr)) {
+    return nullptr;
+  }
+  auto* bop = dynamic_cast<BroadcastOp*>(expr->input(0)->definition());
+  if (bop == nullptr || !isCast(bop->in()->definition())) {
+    return nullptr;
+  }
+  Val* in = bop->in()->definition()->input(0);
+  if (auto it = replacements.find(in); it != replacements.end()) {
+    in = it->second;
+  }
+  DataType dtype = expr->output(0)->getDataType().value();
+  if (!in->isA<TensorView>() || in->getDataType().value() != dtype ||
+      !isInclusiveType(dtype, bop->in()->getDataType().value())) {
+    return nullptr;
+  }
+  return broadcast(in->as<TensorView>(), bop->getBroadcastDimFlags());
+}
+
+} // namespace
+
+void EliminateCommonSubexpressionsPass::runPass(Fusion* fusion) {
+  FusionGuard fg(fusion);
+
+  // The replaced values are left dead and the replacements are applied at the
+  // end. Since expressions are visited in topological order, the inputs of an
+  // expression only need to be looked up once.
+  std::unordered_map<Val*, Val*> replacements;
+  // Visited pure expressions by type and first input
+  std::unordered_map<
+      std::type_index,
+      std::unordered_map<Val*, std::vector<VisitedExpr>>>
+      visited;
+  int64_t num_eliminated = 0;
+
+  // Returns the visited expression that computes the same values as `e`, or
+  // records `e` if there's none
+  auto find_or_insert = [&visited](VisitedExpr e) -> Expr* {
+    std::vector<VisitedExpr>& same_kind =
+        visited[std::type_index(typeid(*e.expr))][e.inputs.front()];
+    auto it = std::find_if(
+        same_kind.begin(), same_kind.end(), [&e](const VisitedExpr& other) {
+          return computesSameValues(e, other);
+        });
+    if (it != same_kind.end()) {
+      return it->expr;
+    }
+    same_kind.push_back(std::move(e));
+    return nullptr;
+  };
+
+  for (Expr* expr : fusion->exprs()) {
+    if (TensorView* replacement = removeCastRoundTrip(expr, replacements)) {
+      Expr* bop = replacement->definition();
+      if (Expr* same = find_or_insert({bop, bop->inputs()})) {
+        replacement = same->output(0)->as<TensorView>();
+      }
+      replacements[expr->output(0)] = replacement;
+      num_eliminated++;
+      continue;
+    }
+
+    if (!isPure(expr) || expr->inputs().empty()) {
+      continue;
+    }
+    VisitedExpr e{expr, {}};
+    e.inputs.reserve(expr->inputs().size());
+    for (Val* in : expr->inputs()) {
+      auto it = replacements.find(in);
+      e.inputs.push_back(it == replacements.end() ? in : it->second);
+    }
+    // A fusion output can replace, but not be replaced
+    if (producesFusionOutput(expr)) {
+      find_or_insert(std::move(e));
+      continue;
+    }
+    if (Expr* same = find_or_insert(std::move(e))) {
+      for (auto&& [out, same_out] : zip(expr->outputs(), same->outputs())) {
+        replacements[out] = same_out;
+      }
+      num_eliminated++;
+    }
+  }
+
+  if (replacements.empty()) {
+    return;
+  }
+  ir_utils::replaceValue(fusion, replacements);
+
+  if (isDebugDumpEnabled(DebugDumpOption::PreSegmenterLogging)) {
+    debug() << name() << " eliminated " << num_eliminated << " expressions"
+            << std::endl;
+  }
+}
+
+} // namespace nvfuser::preseg_passes
@@ -0,0 +1,38 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <preseg_passes/optimization_pass.h>
+
+namespace nvfuser::preseg_passes {
+
+//! Frontends decompose normalizations into chains of primitive ops that
+//! repeat the same computations, e.g., the mean of LayerNorm reduced once for
+//! the variance and again for the output, or `x - mean` computed in both. This
+//! pass merges tensor expressions that compute the same values: same op and
+//! attributes, same inputs and same output domains, so that identical
+//! reductions over the same input and axes are computed once.
+//!
+//! It also removes cast round trips across broadcasts, i.e., it replaces
+//!   T1 = castOp(fp32, T0[bf16]); T2 = broadcast(T1); T3 = castOp(bf16, T2)
+//! with T3 = broadcast(T0), which ConsecutiveCastPass doesn't do since it
+//! doesn't move casts across broadcasts.
+//!
+//! Expressions producing fusion outputs or random numbers are kept.
+class EliminateCommonSubexpressionsPass
+    : public OptimizationPass<EliminateCommonSubexpressionsPass> {
+  friend class OptimizationPass<EliminateCommonSubexpressionsPass>;
+
+ protected:
+  static void runPass(Fusion* fusion);
+  static constexpr std::string_view name() {
+    return "EliminateCommonSubexpressionsPass";
+  }
+};
+
+} // namespace nvfuser::preseg_passes
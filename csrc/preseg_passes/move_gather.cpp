@@ -29,8 +29,65 @@ bool isUnaryPointwiseOp(const Expr* expr) {
   return expr->isA<UnaryOp>() && ir_utils::isPointwiseTvOp(expr);
 }
 
-// For now we allow unary pointwise ops like cast/neg or a squeeze.
-// We only consider squeeze which has a single dim squeezed.
+// Returns the operand of a binary pointwise op with the value of `operand`
+// along `dim`, i.e., `operand` without expanding its broadcast dim, or nullptr
+// if `operand` varies along `dim`.
+TensorView* getInvariantOperand(Val* operand, int64_t dim) {
+  auto tv = dynamic_cast<TensorView*>(operand);
+  if (tv == nullptr) {
+    return nullptr;
+  }
+  if (tv->definition() != nullptr && tv->definition()->isA<ExpandOp>()) {
+    tv = tv->definition()->as<ExpandOp>()->in();
+  }
+  auto logical = TensorDomain::noReductions(tv->getLogicalDomain());
+  if (!logical.at(dim)->isBroadcast() || logical.at(dim)->hasExpandedExtent()) {
+    return nullptr;
+  }
+  return tv;
+}
+
+// Returns the position of the operand that a binary pointwise op `expr`
+// defining the lookup tensor of `gather_op` can be gathered from, i.e., the
+// other operand is constant along the gather dim, like the max and the sum of
+// exponentials that log_softmax subtracts from each row. The gathered operand
+// must broadcast the same dims as the lookup tensor so that the index still
+// has its sizes.
+std::optional<int64_t> getGatheredOperand(
+    const GatherOp* gather_op,
+    const Expr* expr) {
+  if (!expr->isA<BinaryOp>() || !ir_utils::isPointwiseTvOp(expr)) {
+    return std::nullopt;
+  }
+  auto lookup_logical =
+      TensorDomain::noReductions(gather_op->lookupTv()->getLogicalDomain());
+  for (auto i : arange(2)) {
+    auto gathered = dynamic_cast<TensorView*>(expr->input(i));
+    if (gathered == nullptr ||
+        getInvariantOperand(expr->input(1 - i), gather_op->dim()) == nullptr) {
+      continue;
+    }
+    auto gathered_logical =
+        TensorDomain::noReductions(gathered->getLogicalDomain());
+    if (gathered_logical.size() != lookup_logical.size()) {
+      continue;
+    }
+    if (std::equal(
+            gathered_logical.begin(),
+            gathered_logical.end(),
+            lookup_logical.begin(),
+            [](IterDomain* a, IterDomain* b) {
+              return a->isBroadcast() == b->isBroadcast();
+            })) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+// For now we allow unary pointwise ops like cast/neg, binary pointwise ops
+// accepted by getGatheredOperand or a squeeze. We only consider squeeze which
+// has a single dim squeezed.
 std::optional<Expr*> getAllowedLookupTvDef(const GatherOp* gather_op) {
   if (gather_op->lookupTv()->isFusionInput()) {
     return std::nullopt;
@@ -40,7 +97,8 @@ std::optional<Expr*> getAllowedLookupTvDef(const GatherOp* gather_op) {
   NVF_ERROR(
       producing_expr != nullptr, "Def for Lookup tensor view is nullptr.");
 
-  if (isUnaryPointwiseOp(producing_expr)) {
+  if (isUnaryPointwiseOp(producing_expr) ||
+      getGatheredOperand(gather_op, producing_expr).has_value()) {
     return producing_expr;
   }
 
@@ -125,6 +183,34 @@ TensorView* addPostGatherUnary(
   return cloned_def->output(0)->as<TensorView>();
 }
 
+// def is the binary Expr the defines the lookupTv for take_along_axis, and
+// gathered is the position of its operand that new_gather gathers from.
+TensorView* addPostGatherBinary(
+    GatherOp* old_gather,
+    GatherOp* new_gather,
+    Expr* def,
+    int64_t gathered) {
+  // The other operand is constant along the gather dim, so it's used without
+  // its expand, if any.
+  std::vector<Val*> operands(2);
+  operands.at(gathered) = new_gather->output(0);
+  operands.at(1 - gathered) =
+      getInvariantOperand(def->input(1 - gathered), old_gather->dim());
+
+  auto output_tv = ops::newValLike(
+      new_gather->output(0)->as<TensorView>(), def->output(0)->dtype());
+  IrBuilder::create<BinaryOp>(
+      def->as<BinaryOp>()->getBinaryOpType(),
+      output_tv,
+      operands.at(0),
+      operands.at(1));
+
+  TransformReplay::selfReplay(
+      old_gather->output(0)->as<TensorView>()->domain(), output_tv->domain());
+
+  return output_tv;
+}
+
 // old_gather is the original take_along_axis Expr
 // new_gather is the new Expr that will replace the old_gather
 // def is the Expr the defines the lookupTv for take_along_axis.
@@ -132,11 +218,19 @@ auto addOrCloneNewNodeAfterGather(
     Fusion* fusion,
     GatherOp* old_gather,
     GatherOp* new_gather,
-    Expr* def) {
-  // Create a new squeeze op or clone the unary pointwise op.
-  auto output_of_post_gather_op = def->isA<SqueezeOp>()
-      ? addPostGatherSqueeze(old_gather, new_gather, def)
-      : addPostGatherUnary(fusion, old_gather, new_gather, def);
+    Expr* def,
+    int64_t gathered) {
+  // Create a new squeeze op, a new binary op or clone the unary pointwise op.
+  TensorView* output_of_post_gather_op = nullptr;
+  if (def->isA<SqueezeOp>()) {
+    output_of_post_gather_op = addPostGatherSqueeze(old_gather, new_gather, def);
+  } else if (def->isA<BinaryOp>()) {
+    output_of_post_gather_op =
+        addPostGatherBinary(old_gather, new_gather, def, gathered);
+  } else {
+    output_of_post_gather_op =
+        addPostGatherUnary(fusion, old_gather, new_gather, def);
+  }
 
   // Update the uses of the old gather.
   for (auto expr : old_gather->output(0)->uses()) {
@@ -166,16 +260,25 @@ GatherOp* moveGatherOp(Fusion* fusion, GatherOp* gather_op, Expr* def) {
   auto dim_for_gather_op =
       def->isA<SqueezeOp>() ? gather_op->dim() + 1 : gather_op->dim();
 
+  // If we are moving ahead of a binary op, we gather from its operand that
+  // varies along the gather dim.
+  auto gathered = def->isA<BinaryOp>()
+      ? getGatheredOperand(gather_op, def).value()
+      : 0;
+
   // Create a new take_along_axis.
   auto new_gather_op_output = takeAlongAxis(
-      static_cast<TensorView*>(def->input(0)), index_tv, dim_for_gather_op);
+      static_cast<TensorView*>(def->input(gathered)),
+      index_tv,
+      dim_for_gather_op);
 
   // Add the def to after take_along_axis.
   addOrCloneNewNodeAfterGather(
       fusion,
       gather_op,
       new_gather_op_output->definition()->as<GatherOp>(),
-      def);
+      def,
+      gathered);
 
   fusion->removeExpr(gather_op);
 
@@ -187,8 +290,11 @@ GatherOp* moveGatherOp(Fusion* fusion, GatherOp* gather_op, Expr* def) {
 // We look at the def of lookupTv, say D.
 // If lookupTv is a fusion input, we stop.
 // If D is a squeeze operation or if D is unary pointwise op such as cast of neg
-// then we can move the take_along_axis before D. If D is any other type of Op
-// we stop.
+// then we can move the take_along_axis before D. So can we if D is a binary
+// pointwise op whose other operand is constant along the gather dim, e.g., the
+// subtraction of the row max and the log of the sum of exponentials in
+// log_softmax, in which case we gather from the operand that varies. If D is
+// any other type of Op we stop.
 // If D is a suitable candidate which can moved after take_along_axis, we do the
 // following steps:
 // [Say the def of the input to D is the op E]
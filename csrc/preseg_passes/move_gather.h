@@ -12,6 +12,8 @@ namespace nvfuser::preseg_passes {
 // A pre-segmenter pass that moves gather operations ahead of producer
 // unary pointwise ops such as cast. We move take_along_axis ahead of another op
 // if that op is a unary pointwise op such as cast or neg, or it's a squeeze op.
+// We also move it ahead of a binary pointwise op if the other operand is
+// constant along the gather dim.
 // Following 2 examples demonstrated what this pass does:
 
 // ┌───────┐                            ┌───────┐
@@ -53,6 +55,11 @@ namespace nvfuser::preseg_passes {
 // work on. ( doesn't quite apply when there is an Expr 3 in the above example)
 // 2. If Expr 3 and Gather are in different segments duplicating the op
 // removes any temporary Tv that is communicated between these two segments.
+// 3. A cross-entropy loss gathers the log-probability of each label from
+// log_softmax(logits), i.e., logits - max - log(sum(exp(logits - max))).
+// Gathering from the logits instead leaves the [tokens, vocab] log-probs
+// with no use, so they are never materialized, and only the max and the sum
+// of exponentials are reduced over the vocab.
 
 // Current restrictions:
 // We only handle gather operations of the type take_along_axis.
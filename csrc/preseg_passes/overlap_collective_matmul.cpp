@@ -0,0 +1,214 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <preseg_passes/overlap_collective_matmul.h>
+
+#include <ir/interface_nodes.h>
+#include <ir/internal_nodes.h>
+#include <ir/utils.h>
+#include <logical_domain_map.h>
+#include <multidevice/utils.h>
+#include <options.h>
+#include <remarks.h>
+
+#include <algorithm>
+#include <string>
+
+namespace nvfuser::preseg_passes {
+namespace {
+
+int64_t minChunkBytes() {
+  constexpr int64_t default_min_chunk_kib = 1024;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::CollectiveMatmul);
+  const int64_t min_chunk_kib = option_args.empty()
+      ? default_min_chunk_kib
+      : std::stoll(option_args[0]);
+  return min_chunk_kib * 1024;
+}
+
+// Returns the outermost axis of tv if it can be parallelized with
+// ParallelType::Stream, i.e., it is a serial iteration axis of both the logical
+// and the loop domain, and nullptr otherwise.
+IterDomain* getChunkAxis(TensorView* tv) {
+  if (tv->nDims() == 0) {
+    return nullptr;
+  }
+  IterDomain* id = tv->axis(0);
+  if (id->getIterType() != IterType::Iteration || id->isParallelized()) {
+    return nullptr;
+  }
+  if (std::find(
+          tv->getLogicalDomain().begin(), tv->getLogicalDomain().end(), id) ==
+      tv->getLogicalDomain().end()) {
+    return nullptr;
+  }
+  return id;
+}
+
+// Returns the axis of consumer mapped to the axis id of producer if it is
+// consumer's chunk axis, and nullptr otherwise
+IterDomain* mapChunkAxis(
+    TensorView* producer,
+    TensorView* consumer,
+    IterDomain* id) {
+  const auto p2c =
+      PairwiseLogicalDomainMap(producer, consumer).mapProducerToConsumer();
+  auto it = p2c.find(id);
+  if (it == p2c.end() || it->second != getChunkAxis(consumer)) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+// Returns whether splitting tv into chunks along chunk_axis is worth the
+// additional communications. Chunks of symbolic size are assumed large enough.
+bool hasLargeChunks(TensorView* tv, IterDomain* chunk_axis) {
+  if (chunk_axis->extent()->isConstInt() &&
+      chunk_axis->extent()->evaluate().as<int64_t>() <= 1) {
+    return false;
+  }
+  int64_t chunk_bytes = dataTypeSizeByte(tv->dtype());
+  for (IterDomain* id : TensorDomain::noReductions(tv->getLogicalDomain())) {
+    if (id == chunk_axis || id->isDeviceDim() || id->isBroadcast()) {
+      continue;
+    }
+    if (!id->extent()->isConstInt()) {
+      return true;
+    }
+    chunk_bytes *= id->extent()->evaluate().as<int64_t>();
+  }
+  return chunk_bytes >= minChunkBytes();
+}
+
+void report(const std::string& message, TensorView* tv, IterDomain* axis) {
+  if (!remarks::isActive()) {
+    return;
+  }
+  remarks::report(
+      "collective_matmul",
+      message,
+      {{"tensor", tv->toString()},
+       {"chunks", axis->extent()->toInlineString()}});
+}
+
+// Allgather -> matmul: parallelizes the chunk axes of the gathered operand
+// and of the matmul's output
+bool overlapAllgather(Expr* matmul) {
+  auto* gathered = matmul->input(0)->as<TensorView>();
+  auto* out = matmul->output(0)->as<TensorView>();
+  auto* set = dynamic_cast<LoadStoreOp*>(gathered->definition());
+  if (set == nullptr || set->opType() != LoadStoreOpType::Set ||
+      !isResharding(set) || gathered->uses().size() != 1) {
+    return false;
+  }
+
+  // The chunk axis of the gathered operand must come from the outermost axis
+  // of the sharded operand, either the gathered axis itself or an axis that
+  // is chunked on every device.
+  auto* sharded = set->in()->as<TensorView>();
+  if (sharded->nDims() == 0) {
+    return false;
+  }
+  IterDomain* sharded_axis = sharded->axis(0);
+  if (!sharded_axis->isDeviceDim() &&
+      getChunkAxis(sharded) != sharded_axis) {
+    return false;
+  }
+  IterDomain* gathered_axis = mapChunkAxis(sharded, gathered, sharded_axis);
+  if (gathered_axis == nullptr) {
+    return false;
+  }
+  IterDomain* out_axis = mapChunkAxis(gathered, out, gathered_axis);
+  if (out_axis == nullptr || !hasLargeChunks(gathered, gathered_axis)) {
+    return false;
+  }
+
+  gathered_axis->parallelize(ParallelType::Stream);
+  out_axis->parallelize(ParallelType::Stream);
+  report("pipelined allgather and matmul", out, out_axis);
+  return true;
+}
+
+// Returns the logical axis of out that reduced scatters across devices if it
+// can be parallelized with ParallelType::Stream, and nullptr otherwise
+IterDomain* getScatteredAxis(TensorView* out, TensorView* reduced) {
+  const auto p2c =
+      PairwiseLogicalDomainMap(out, reduced).mapProducerToConsumer();
+  for (IterDomain* id : out->getLogicalDomain()) {
+    auto it = p2c.find(id);
+    if (it != p2c.end() && it->second->isDeviceDim() &&
+        id->getIterType() == IterType::Iteration && !id->isParallelized()) {
+      return id;
+    }
+  }
+  return nullptr;
+}
+
+// matmul -> ReduceScatter: parallelizes the chunk axes of the matmul's output
+// and of the reduction over devices. When the output has no such axis, e.g.,
+// for row-parallel layers whose partial sums are sharded on their outermost
+// axis, parallelizes the scattered axis of the output instead.
+// StreamParallelType then reduces each chunk to the device owning it as soon
+// as it is computed.
+bool overlapReduceScatter(Expr* matmul) {
+  auto* out = matmul->output(0)->as<TensorView>();
+  if (out->uses().size() != 1) {
+    return false;
+  }
+  auto* reduction = dynamic_cast<ReductionOp*>(out->uses().front());
+  if (reduction == nullptr || !isResharding(reduction)) {
+    return false;
+  }
+  auto* reduced = reduction->out()->as<TensorView>();
+
+  if (IterDomain* out_axis = getChunkAxis(out); out_axis != nullptr) {
+    IterDomain* reduced_axis = mapChunkAxis(out, reduced, out_axis);
+    if (reduced_axis == nullptr || !hasLargeChunks(out, out_axis)) {
+      return false;
+    }
+    out_axis->parallelize(ParallelType::Stream);
+    reduced_axis->parallelize(ParallelType::Stream);
+    report("pipelined matmul and reduction", reduced, reduced_axis);
+    return true;
+  }
+
+  IterDomain* scattered_axis = getScatteredAxis(out, reduced);
+  if (scattered_axis == nullptr || !hasLargeChunks(out, scattered_axis)) {
+    return false;
+  }
+  scattered_axis->parallelize(ParallelType::Stream);
+  report("pipelined matmul and reduction by destination", out, scattered_axis);
+  return true;
+}
+
+} // namespace
+
+void OverlapCollectiveMatmulPass::runPass(Fusion* fusion) {
+  const std::vector<TensorView*> tvs = fusion->allTvs();
+  if (std::any_of(tvs.begin(), tvs.end(), [](TensorView* tv) {
+        return std::any_of(
+            tv->getLoopDomain().begin(),
+            tv->getLoopDomain().end(),
+            [](IterDomain* id) {
+              return id->getParallelType() == ParallelType::Stream;
+            });
+      })) {
+    return;
+  }
+
+  for (Expr* e : fusion->exprs()) {
+    if (!e->isOneOf<MatmulOp, LinearOp>()) {
+      continue;
+    }
+    if (!overlapAllgather(e)) {
+      overlapReduceScatter(e);
+    }
+  }
+}
+
+} // namespace nvfuser::preseg_passes
@@ -0,0 +1,54 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <preseg_passes/optimization_pass.h>
+
+#include <string>
+
+#include <fusion.h>
+
+namespace nvfuser::preseg_passes {
+
+// This can only run after InsertReshardingPass and is enabled by
+// EnableOption::CollectiveMatmul. It pipelines the communications surrounding
+// tensor-parallel matmuls with the matmuls themselves by parallelizing an
+// outer axis with ParallelType::Stream, as users otherwise do by hand:
+//
+//   1. Allgather -> matmul: a resharding set that gathers the A operand of a
+//      MatmulOp or LinearOp. When the gathered axis is the outermost one, each
+//      chunk comes from one peer and StreamParallelType lowers the set to P2P
+//      communications. Otherwise, each chunk of the outermost axis is gathered
+//      separately. This includes a set that moves the sharding between inner
+//      axes, e.g., an AllToAll dispatching tokens to experts, whose chunks are
+//      then exchanged while the previous ones are multiplied.
+//   2. matmul -> ReduceScatter: a MatmulOp or LinearOp whose output is
+//      reduced over a device dimension. Each chunk of the outermost axis is
+//      reduced separately. When the outermost axis is the reduced device
+//      dimension, as for row-parallel layers, the scattered axis is chunked
+//      instead and each chunk is reduced to the device that owns it.
+//
+// The number of chunks is the extent of the outermost axis, and
+// HostIrEvaluatorParams::number_of_streams bounds how many of them are in
+// flight. A pattern is left alone when its outermost axis has a single chunk
+// or when its chunks are known to be smaller than the optional argument of
+// the option (default 1024 KiB), in which case the communication latency
+// would outweigh the overlap. Fusions in which the user already parallelized
+// an axis with ParallelType::Stream are not modified.
+class OverlapCollectiveMatmulPass
+    : public OptimizationPass<OverlapCollectiveMatmulPass> {
+  friend class OptimizationPass<OverlapCollectiveMatmulPass>;
+
+ protected:
+  static void runPass(Fusion* fusion);
+  static constexpr std::string_view name() {
+    return "OverlapCollectiveMatmulPass";
+  }
+};
+
+} // namespace nvfuser::preseg_passes
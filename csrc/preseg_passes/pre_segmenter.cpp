@@ -14,6 +14,7 @@
 #include <preseg_passes/add_axioms.h>
 #include <preseg_passes/allocation_order_inference.h>
 #include <preseg_passes/consecutive_cast.h>
+#include <preseg_passes/eliminate_common_subexpressions.h>
 #include <preseg_passes/exact_mapped_extent_substitution.h>
 #include <preseg_passes/finalize_multidevice_domains.h>
 #include <preseg_passes/insert_reshardings.h>
@@ -27,6 +28,7 @@
 #include <preseg_passes/remove_empty.h>
 #include <preseg_passes/reorder_sharded_axis.h>
 #include <preseg_passes/segment_inplace_update.h>
+#include <preseg_passes/translate_decomposed_sdpa.h>
 #include <preseg_passes/translate_no_reduction_matmul_to_mul_squeeze.h>
 #include <preseg_passes/translate_repeat_to_expand.h>
 
@@ -48,6 +50,11 @@ namespace nvfuser::preseg_passes {
   OptimizationPass<TranslateRepeatToExpand>::runPass(fusion);
   // removes consecutive cast operations
   OptimizationPass<ConsecutiveCastPass>::runPass(fusion);
+  // merges repeated computations and cast round trips left by the
+  // decomposition of normalizations
+  OptimizationPass<EliminateCommonSubexpressionsPass>::runPass(fusion);
+  // matches the decomposed softmax after the cast round trips are merged
+  OptimizationPass<TranslateDecomposedSdpa>::runPass(fusion);
   OptimizationPass<AddAxiomsPass>::runPass(fusion);
   OptimizationPass<MoveSplitCatPass>::runPass(fusion);
   // MovePadPass needs to happen:
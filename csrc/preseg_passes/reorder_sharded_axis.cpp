@@ -12,6 +12,7 @@
 #include <ir/allocation_utils.h>
 #include <ir/base_nodes.h>
 #include <ir/interface_nodes.h>
+#include <ir/internal_nodes.h>
 #include <ir/utils.h>
 #include <multidevice/utils.h>
 #include <ops/alias.h>
@@ -32,7 +33,15 @@ void makeCommunicationLayoutCompliant(Expr* expr) {
 
   Layout p_layout =
       getCommunicationLayout(input, communication_info.type, p_sharded_id);
-  if (!isCompliantWith(*canonicalizeLayout(input), p_layout)) {
+  // MatmulOp::evaluate writes its output in the requested allocation, e.g. a
+  // row-parallel layer can produce its partial sums directly in the layout of
+  // the following reduce-scatter. So we override the layout of an
+  // intermediate matmul output instead of copying it.
+  const bool is_overridable = !input->isFusionInput() &&
+      !input->isFusionOutput() && !input->hasAllocation() &&
+      input->definition() != nullptr && input->definition()->isA<MatmulOp>();
+  if (!is_overridable &&
+      !isCompliantWith(*canonicalizeLayout(input), p_layout)) {
     TensorView* input_copy = set(input);
     TransformReplay::selfReplay(
         input->domain(), input_copy->domain(), /*ignore_reductions=*/true);
@@ -0,0 +1,267 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <ir/utils.h>
+#include <iter_visitor.h>
+#include <ops/all_ops.h>
+#include <options.h>
+#include <preseg_passes/translate_decomposed_sdpa.h>
+
+#include <ATen/cuda/CUDAContext.h>
+
+#include <unordered_set>
+#include <vector>
+
+namespace nvfuser::preseg_passes {
+
+namespace {
+
+// Returns tv before the casts between floating point types that produce it
+TensorView* skipCasts(TensorView* tv) {
+  while (auto* uop = dynamic_cast<UnaryOp*>(tv->definition())) {
+    if (uop->getUnaryOpType() != UnaryOpType::Cast ||
+        !isFloatingPointType(uop->in()->dtype())) {
+      break;
+    }
+    tv = uop->in()->as<TensorView>();
+  }
+  return tv;
+}
+
+// Returns the input of the reduction of type op_type along the innermost dim
+// broadcast back to tv, or nullptr
+TensorView* matchInnermostBroadcastReduction(
+    Val* tv,
+    BinaryOpType op_type) {
+  auto* bcast = dynamic_cast<BroadcastOp*>(tv->definition());
+  if (bcast == nullptr) {
+    return nullptr;
+  }
+  auto* rop = dynamic_cast<ReductionOp*>(bcast->in()->definition());
+  if (rop == nullptr || rop->getReductionOpType() != op_type) {
+    return nullptr;
+  }
+  const std::vector<IterDomain*>& logical =
+      rop->out()->as<TensorView>()->getLogicalDomain();
+  if (!logical.back()->isReduction() ||
+      std::any_of(logical.begin(), logical.end() - 1, [](IterDomain* id) {
+        return id->isReduction();
+      })) {
+    return nullptr;
+  }
+  return dynamic_cast<TensorView*>(rop->in());
+}
+
+// Returns the input of the softmax along the innermost dim that produces y,
+// i.e., exp(x - max(x)) / sum(exp(x - max(x))), or nullptr
+TensorView* matchSoftmax(TensorView* y) {
+  auto* normalize = dynamic_cast<BinaryOp*>(y->definition());
+  if (normalize == nullptr) {
+    return nullptr;
+  }
+  Val* sum = nullptr;
+  if (normalize->getBinaryOpType() == BinaryOpType::Div) {
+    sum = normalize->rhs();
+  } else if (normalize->getBinaryOpType() == BinaryOpType::Mul) {
+    auto* reciprocal = dynamic_cast<UnaryOp*>(normalize->rhs()->definition());
+    if (reciprocal == nullptr ||
+        reciprocal->getUnaryOpType() != UnaryOpType::Reciprocal) {
+      return nullptr;
+    }
+    sum = reciprocal->in();
+  } else {
+    return nullptr;
+  }
+
+  auto* exp = dynamic_cast<UnaryOp*>(normalize->lhs()->definition());
+  if (exp == nullptr || exp->getUnaryOpType() != UnaryOpType::Exp ||
+      matchInnermostBroadcastReduction(sum, BinaryOpType::Add) !=
+          normalize->lhs()) {
+    return nullptr;
+  }
+  auto* sub = dynamic_cast<BinaryOp*>(exp->in()->definition());
+  if (sub == nullptr || sub->getBinaryOpType() != BinaryOpType::Sub) {
+    return nullptr;
+  }
+  auto* x = dynamic_cast<TensorView*>(sub->lhs());
+  if (x == nullptr ||
+      matchInnermostBroadcastReduction(sub->rhs(), BinaryOpType::Max) != x) {
+    return nullptr;
+  }
+  return x;
+}
+
+// Translation algorithm overview:
+//
+// Step 1: Inspection. Traverses the given fusion and looks for MatmulOps whose
+// first operand is the softmax of the scaled scores of a query and a
+// transposed key.
+//
+// Step 2: Apply the translation.
+class DecomposedSdpaTranslator {
+ public:
+  DecomposedSdpaTranslator(Fusion* fusion) : fusion_(fusion) {}
+
+  void run() {
+    inspect();
+    translate();
+  }
+
+ private:
+  struct Attention {
+    MatmulOp* matmul = nullptr;
+    TensorView* query = nullptr;
+    TensorView* key = nullptr;
+    TensorView* value = nullptr;
+    // nullptr if the scores are not scaled
+    Val* scale = nullptr;
+    // True if the scores are divided by scale
+    bool reciprocal_scale = false;
+  };
+
+  void inspect() {
+    const auto exprs = fusion_->exprs();
+
+    for (auto matmul : ir_utils::filterByType<MatmulOp>(exprs)) {
+      Attention attention;
+      attention.matmul = matmul;
+      attention.value = matmul->inB();
+
+      TensorView* scores = matchSoftmax(skipCasts(matmul->inA()));
+      if (scores == nullptr) {
+        continue;
+      }
+
+      // Scores scaled by a floating point scalar
+      if (auto* bop = dynamic_cast<BinaryOp*>(scores->definition())) {
+        Val* scale = nullptr;
+        if (bop->getBinaryOpType() == BinaryOpType::Mul) {
+          scale = bop->lhs()->isA<TensorView>() ? bop->rhs() : bop->lhs();
+          scores = dynamic_cast<TensorView*>(
+              bop->lhs()->isA<TensorView>() ? bop->lhs() : bop->rhs());
+        } else if (bop->getBinaryOpType() == BinaryOpType::Div) {
+          scale = bop->rhs();
+          scores = dynamic_cast<TensorView*>(bop->lhs());
+          attention.reciprocal_scale = true;
+        }
+        if (scale == nullptr || scale->isA<TensorView>() ||
+            !scale->isFloatingPointScalar() || scores == nullptr) {
+          continue;
+        }
+        attention.scale = scale;
+      }
+
+      auto* qk = dynamic_cast<MatmulOp*>(skipCasts(scores)->definition());
+      if (qk == nullptr) {
+        continue;
+      }
+      attention.query = qk->inA();
+      TensorView* key_t = qk->inB();
+      auto* transpose = dynamic_cast<LoadStoreOp*>(key_t->definition());
+      if (transpose == nullptr ||
+          ir_utils::computePermutation(
+              key_t->getMaybeRootDomain(), key_t->getLogicalDomain()) !=
+              std::vector<int64_t>{0, 1, 3, 2}) {
+        continue;
+      }
+      attention.key = transpose->in()->as<TensorView>();
+
+      if (isSupported(attention)) {
+        attentions_.push_back(attention);
+      }
+    }
+  }
+
+  // Checks the inputs against the requirements of flash attention and that
+  // the intermediates of the attention are not used elsewhere
+  bool isSupported(const Attention& attention) const {
+    TensorView* out = attention.matmul->out();
+    const DataType dtype = attention.query->dtype();
+    if (dtype != DataType::Half && dtype != DataType::BFloat16) {
+      return false;
+    }
+    for (TensorView* tv :
+         {attention.query, attention.key, attention.value, out}) {
+      if (tv->dtype() != dtype) {
+        return false;
+      }
+      const std::vector<IterDomain*> logical =
+          TensorDomain::noReductions(tv->getLogicalDomain());
+      if (logical.size() != 4 ||
+          std::any_of(logical.begin(), logical.end(), [](IterDomain* id) {
+            return id->isBroadcast() || id->isDeviceDim();
+          })) {
+        return false;
+      }
+    }
+
+    const std::vector<Val*> vals = DependencyCheck::getAllValsBetween(
+        {attention.query, attention.key, attention.value}, {out});
+    std::unordered_set<Val*> intermediates(vals.begin(), vals.end());
+    intermediates.erase(attention.query);
+    intermediates.erase(attention.key);
+    intermediates.erase(attention.value);
+    return std::all_of(
+        intermediates.begin(), intermediates.end(), [&](Val* val) {
+          if (val == out) {
+            return true;
+          }
+          if (val->isFusionOutput()) {
+            return false;
+          }
+          return std::all_of(
+              val->uses().begin(), val->uses().end(), [&](Expr* use) {
+                return std::all_of(
+                    use->outputs().begin(),
+                    use->outputs().end(),
+                    [&](Val* use_out) {
+                      return intermediates.count(use_out) > 0;
+                    });
+              });
+        });
+  }
+
+  void translate() {
+    for (const Attention& attention : attentions_) {
+      Val* scale = attention.scale;
+      if (scale == nullptr) {
+        scale = IrBuilder::create<Val>(1.0);
+      } else if (attention.reciprocal_scale) {
+        scale = div(IrBuilder::create<Val>(1.0), scale);
+      }
+      SdpfaFwdResult sdpa = sdpfa_fwd(
+          attention.query,
+          attention.key,
+          attention.value,
+          /*dropout_p=*/IrBuilder::create<Val>(0.0),
+          /*is_causal=*/IrBuilder::create<Val>(false, DataType::Bool),
+          scale);
+      ir_utils::replaceValInAllExprInputsAndFusionOutputs(
+          attention.matmul->out(), sdpa.output);
+    }
+  }
+
+ private:
+  Fusion* fusion_ = nullptr;
+  std::vector<Attention> attentions_;
+};
+
+} // namespace
+
+void TranslateDecomposedSdpa::runPass(Fusion* fusion) {
+  // SdpaFwdOp is evaluated with flash attention, which requires Ampere or
+  // newer
+  if (!isOptionEnabled(EnableOption::TranslateSdpa) ||
+      at::cuda::getCurrentDeviceProperties()->major < 8) {
+    return;
+  }
+  FusionGuard fg(fusion);
+  DecomposedSdpaTranslator translator(fusion);
+  translator.run();
+}
+
+} // namespace nvfuser::preseg_passes
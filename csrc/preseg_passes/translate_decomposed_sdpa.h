@@ -0,0 +1,46 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <exceptions.h>
+#include <preseg_passes/optimization_pass.h>
+
+namespace nvfuser::preseg_passes {
+
+// Translate attentions decomposed into matmul, softmax and matmul to
+// SdpaFwdOp, set with EnableOption::TranslateSdpa. Otherwise, the fusion is
+// segmented at each matmul and the scores of [B, H, S, S] are written to
+// global memory, while SdpaFwdOp computes the softmax online across the tiles
+// of the key and the value.
+//
+// For example, given the following fusion:
+//
+// q = [B, H, S, E]; k = [B, H, S, E]; v = [B, H, S, E]
+// t0 = transpose(k, -2, -1)
+// t1 = matmul(q, t0)
+// t2 = mul(t1, scale)
+// t3 = softmax(t2, -1)
+// t4 = matmul(t3, v)
+//
+// t4 is translated to the output of sdpfa_fwd(q, k, v, 0.0, false, scale).
+//
+// Casts of the scores and of the probabilities between floating point types
+// are allowed, but the intermediates must not be used outside of the
+// attention. Masks, biases and dropout are not translated.
+class TranslateDecomposedSdpa
+    : public OptimizationPass<TranslateDecomposedSdpa> {
+  friend class OptimizationPass<TranslateDecomposedSdpa>;
+
+ protected:
+  static void runPass(Fusion* fusion);
+  static constexpr std::string_view name() {
+    return "TranslateDecomposedSdpa";
+  }
+};
+
+} // namespace nvfuser::preseg_passes
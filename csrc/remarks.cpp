@@ -0,0 +1,102 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <remarks.h>
+
+#include <utils.h>
+
+#include <iomanip>
+#include <sstream>
+
+namespace nvfuser {
+namespace remarks {
+
+namespace {
+
+thread_local RemarkCollector* active_collector = nullptr;
+
+void writeJsonString(std::ostream& os, const std::string& str) {
+  os << '"';
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+             << static_cast<int>(c) << std::dec;
+        } else {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+
+} // namespace
+
+void RemarkCollector::add(Remark remark) {
+  remarks_.push_back(std::move(remark));
+}
+
+std::string toJson(const std::vector<Remark>& remarks) {
+  std::stringstream ss;
+  ss << "[";
+  for (auto&& [i, remark] : enumerate(remarks)) {
+    ss << (i == 0 ? "" : ", ") << "{\"pass\": ";
+    writeJsonString(ss, remark.pass);
+    ss << ", \"message\": ";
+    writeJsonString(ss, remark.message);
+    ss << ", \"args\": {";
+    for (auto&& [j, arg] : enumerate(remark.args)) {
+      ss << (j == 0 ? "" : ", ");
+      writeJsonString(ss, arg.first);
+      ss << ": ";
+      writeJsonString(ss, arg.second);
+    }
+    ss << "}}";
+  }
+  ss << "]";
+  return ss.str();
+}
+
+RemarkGuard::RemarkGuard(RemarkCollector* collector)
+    : prev_collector_(active_collector) {
+  active_collector = collector;
+}
+
+RemarkGuard::~RemarkGuard() {
+  active_collector = prev_collector_;
+}
+
+bool isActive() {
+  return active_collector != nullptr;
+}
+
+void report(
+    std::string pass,
+    std::string message,
+    std::vector<std::pair<std::string, std::string>> args) {
+  if (active_collector == nullptr) {
+    return;
+  }
+  active_collector->add(
+      {std::move(pass), std::move(message), std::move(args)});
+}
+
+} // namespace remarks
+} // namespace nvfuser
@@ -0,0 +1,83 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <visibility.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nvfuser {
+
+//! Optimization remarks, enabled by EnableOption::KernelRemarks.
+//!
+//! Schedulers and lowering passes report the decisions that explain the
+//! performance of a kernel, e.g. the vectorization factor and the tensor
+//! limiting it, predicates that could not be eliminated, bank conflicts,
+//! circular buffering and register spills. FusionKernelRuntime collects the
+//! remarks of each segment while computing its heuristics and compiling it,
+//! and FusionExecutorCache::getMostRecentRemarks returns them as JSON.
+namespace remarks {
+
+struct Remark {
+  //! Scheduler or pass reporting the remark, e.g. "vectorization"
+  std::string pass;
+  //! Human readable description
+  std::string message;
+  //! Structured details as key-value pairs
+  std::vector<std::pair<std::string, std::string>> args;
+};
+
+//! Remarks of a single segment
+class RemarkCollector {
+ public:
+  void add(Remark remark);
+
+  const std::vector<Remark>& remarks() const {
+    return remarks_;
+  }
+
+  void clear() {
+    remarks_.clear();
+  }
+
+ private:
+  std::vector<Remark> remarks_;
+};
+
+//! Returns remarks as a JSON array of objects with the keys "pass", "message"
+//! and "args"
+NVF_API std::string toJson(const std::vector<Remark>& remarks);
+
+//! Directs the remarks reported by the current thread to collector while the
+//! guard is alive. A null collector drops the remarks.
+class NVF_API RemarkGuard {
+ public:
+  explicit RemarkGuard(RemarkCollector* collector);
+  ~RemarkGuard();
+
+  RemarkGuard(const RemarkGuard&) = delete;
+  RemarkGuard& operator=(const RemarkGuard&) = delete;
+
+ private:
+  RemarkCollector* prev_collector_;
+};
+
+//! Returns whether remarks reported by the current thread are collected, so
+//! that passes can skip the analysis behind a remark otherwise
+NVF_API bool isActive();
+
+//! Reports a remark if the current thread collects them
+NVF_API void report(
+    std::string pass,
+    std::string message,
+    std::vector<std::pair<std::string, std::string>> args = {});
+
+} // namespace remarks
+} // namespace nvfuser
@@ -15,6 +15,7 @@
 #include <runtime/executor.h>
 #include <runtime/executor_kernel_arg.h>
 #include <runtime/executor_utils.h>
+#include <runtime/peak_memory.h>
 #include <tensor_metadata.h>
 
 namespace nvfuser {
@@ -162,9 +163,10 @@ std::pair<std::vector<int64_t>, std::vector<int64_t>> inferShape(
 
   for (const auto i : arange(symbolic_sizes.size())) {
     auto symbolic_size = symbolic_sizes.at(i);
-    const auto inferred_val = expr_eval.evaluate(symbolic_size);
+    const std::optional<int64_t> inferred_val =
+        expr_eval.evaluateInt64(symbolic_size);
     NVF_ERROR(
-        inferred_val.hasValue(),
+        inferred_val.has_value(),
         "Could not launch kernel as program could not infer ",
         symbolic_size->toInlineString(),
         " (",
@@ -172,8 +174,7 @@ std::pair<std::vector<int64_t>, std::vector<int64_t>> inferShape(
         ") for the buffer ",
         tv->toString());
 
-    auto concrete_size = inferred_val.as<int64_t>();
-    concrete_sizes.at(i) = concrete_size;
+    concrete_sizes.at(i) = *inferred_val;
   }
 
   auto strides = getContiguousStrides(concrete_sizes, expand_flags);
@@ -245,14 +246,96 @@ KernelArgumentHolder allocateOutputs(
     const std::vector<int>& output_alias_to_input_map,
     const c10::Device& device,
     const KernelArgumentHolder& args,
-    bool dynamic_evaluate) {
+    bool dynamic_evaluate,
+    const std::vector<std::pair<int64_t, int64_t>>& inplace_outputs,
+    const std::vector<std::pair<int64_t, at::Tensor>>& output_slices,
+    const std::vector<std::pair<int64_t, at::Tensor>>& user_outputs) {
   FUSER_PERF_SCOPE("fusion_executor::allocations::allocateOutputs");
 
+  // Returns whether the kernel can write the output into tensor. Strides of
+  // dimensions of size one are never used to index the output.
+  auto has_output_layout = [&](const at::Tensor& tensor,
+                               const GlobalBufferInfo& out_info) {
+    const std::vector<int64_t>& sizes = out_info.shape_info.logical_sizes;
+    const std::vector<int64_t>& strides = out_info.shape_info.logical_strides;
+    if (tensor.device() != device || tensor.scalar_type() != out_info.type ||
+        tensor.sizes() != sizes) {
+      return false;
+    }
+    for (auto i : arange(std::ssize(sizes))) {
+      if (sizes.at(i) != 1 && tensor.stride(i) != strides.at(i)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Returns the buffer the output should be written into instead of a new
+  // allocation, if any: a tensor given by the user, a slice given by the
+  // caller, or a dead input whose storage isn't viewed by another tensor. A
+  // buffer filled with NaNs is meant to catch reads of unwritten elements,
+  // which a reused input would hide.
+  auto find_output_buffer =
+      [&](int64_t out_idx,
+          const GlobalBufferInfo& out_info) -> const at::Tensor* {
+    for (const auto& [user_out_idx, user_out] : user_outputs) {
+      if (user_out_idx != out_idx) {
+        continue;
+      }
+      NVF_CHECK(
+          has_output_layout(user_out, out_info),
+          "The tensor given for output ",
+          out_info.tv->toString(),
+          " has sizes ",
+          user_out.sizes(),
+          ", strides ",
+          user_out.strides(),
+          ", dtype ",
+          user_out.scalar_type(),
+          " and device ",
+          user_out.device(),
+          ", but the output has sizes ",
+          c10::IntArrayRef(out_info.shape_info.logical_sizes),
+          ", strides ",
+          c10::IntArrayRef(out_info.shape_info.logical_strides),
+          ", dtype ",
+          out_info.type,
+          " and device ",
+          device);
+      return &user_out;
+    }
+    for (const auto& [slice_out_idx, slice] : output_slices) {
+      if (slice_out_idx == out_idx && has_output_layout(slice, out_info)) {
+        return &slice;
+      }
+    }
+    if (shouldFillAllocationWithNan()) {
+      return nullptr;
+    }
+    for (const auto& [inplace_out_idx, in_idx] : inplace_outputs) {
+      if (inplace_out_idx != out_idx || !args[in_idx].is<at::Tensor>()) {
+        continue;
+      }
+      const auto& in_tensor = args[in_idx].as<at::Tensor>();
+      if (has_output_layout(in_tensor, out_info) &&
+          in_tensor.storage_offset() == 0 &&
+          in_tensor.storage().use_count() == 1) {
+        return &in_tensor;
+      }
+    }
+    return nullptr;
+  };
+
   KernelArgumentHolder out_tensors;
   out_tensors.resize(output_infos.size());
   for (auto out_idx : arange(output_infos.size())) {
-    auto out_info = output_infos.at(out_idx);
+    const GlobalBufferInfo& out_info = output_infos.at(out_idx);
     if (output_alias_to_input_map.at(out_idx) == -1) {
+      if (const at::Tensor* buffer =
+              find_output_buffer((int64_t)out_idx, out_info)) {
+        out_tensors[out_idx] = *buffer;
+        continue;
+      }
       auto alloc_tensor = at::native::empty_strided_cuda(
           out_info.shape_info.logical_sizes,
           out_info.shape_info.logical_strides,
@@ -263,6 +346,9 @@ KernelArgumentHolder allocateOutputs(
       if (shouldFillAllocationWithNan()) {
         fillTensorWithNan(alloc_tensor);
       }
+      if (PeakMemoryTracker* tracker = PeakMemoryTracker::current()) {
+        tracker->allocated(alloc_tensor);
+      }
       out_tensors[out_idx] = alloc_tensor;
     } else if (
         fusion->getOutputAlias(out_info.tv).type ==
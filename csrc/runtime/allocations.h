@@ -78,13 +78,32 @@ TensorShapeInfo inferTensorShapes(
 //
 // If dynamic_evaluate is true, then any argument with AllocationType::Evaluate
 // will not be populated, it will be filled with std::monostate.
+//
+// inplace_outputs lists pairs of an output and an input that the caller knows
+// to be dead after this fusion and read only at the positions written by the
+// output, see findInplaceOutputs. Such an output is written into the storage
+// of its input instead of a new buffer if the input has the same sizes,
+// strides and dtype and no other tensor views its storage.
+//
+// output_slices lists pairs of an output and a view of a larger buffer, e.g.,
+// the slice of the output of a CatOp that the output is concatenated into,
+// see findCatOutputSlices. Such an output is written into its view if the
+// view has the sizes, strides and dtype of the output.
+//
+// user_outputs lists pairs of an output and a tensor given by the user, e.g.,
+// with the `out` argument of FusionDefinition.execute. Such an output is
+// always written into its tensor, which is an error if the tensor doesn't
+// have the sizes, strides and dtype of the output.
 KernelArgumentHolder allocateOutputs(
     const Fusion* fusion,
     const std::vector<GlobalBufferInfo>& output_infos,
     const std::vector<int>& output_alias_to_input_map,
     const c10::Device& device,
     const KernelArgumentHolder& args,
-    bool dynamic_evaluate = false);
+    bool dynamic_evaluate = false,
+    const std::vector<std::pair<int64_t, int64_t>>& inplace_outputs = {},
+    const std::vector<std::pair<int64_t, at::Tensor>>& output_slices = {},
+    const std::vector<std::pair<int64_t, at::Tensor>>& user_outputs = {});
 
 //! Return information necessary for allocating output tensors. Input
 //! and output tensors are allowed to alias each other, which is
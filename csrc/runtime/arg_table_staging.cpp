@@ -0,0 +1,94 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/arg_table_staging.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include <ATen/ops/empty.h>
+#include <cuda_runtime.h>
+
+#include <exceptions.h>
+#include <utils.h>
+
+namespace nvfuser {
+
+namespace {
+
+// Large enough for the tables of many launches, which exceed 4 KB each
+constexpr int64_t default_chunk_size = 1L << 20;
+
+// Tables are 16-byte aligned like the fields of KernelArgs
+constexpr int64_t table_alignment = 16;
+
+} // namespace
+
+ArgTableStaging::ArgTableStaging(c10::cuda::CUDAStream stream)
+    : stream_(stream) {}
+
+ArgTableStaging& ArgTableStaging::current(c10::DeviceIndex device) {
+  thread_local std::map<
+      std::pair<c10::DeviceIndex, c10::StreamId>,
+      std::unique_ptr<ArgTableStaging>>
+      stagings;
+  c10::cuda::CUDAStream stream = c10::cuda::getCurrentCUDAStream(device);
+  auto& staging = stagings[{device, stream.id()}];
+  if (staging == nullptr) {
+    staging = std::make_unique<ArgTableStaging>(stream);
+  }
+  return *staging;
+}
+
+void ArgTableStaging::nextChunk(int64_t size) {
+  if (current_.has_value()) {
+    current_->retired.record(stream_);
+    retired_.push_back(std::move(*current_));
+    current_.reset();
+  }
+  if (!retired_.empty() && retired_.front().retired.query() &&
+      retired_.front().device.numel() >= size) {
+    current_.emplace(std::move(retired_.front()));
+    retired_.pop_front();
+    current_->used = 0;
+    return;
+  }
+  const int64_t capacity = std::max(
+      default_chunk_size, roundUpToMultiple(size, default_chunk_size));
+  current_.emplace();
+  current_->host = at::empty(
+      {capacity}, at::TensorOptions().dtype(at::kByte).pinned_memory(true));
+  current_->device = at::empty(
+      {capacity},
+      at::TensorOptions().dtype(at::kByte).device(stream_.device()));
+  num_chunks_++;
+}
+
+at::Tensor ArgTableStaging::stage(
+    int64_t size,
+    const std::function<void(std::byte*)>& write) {
+  if (!current_.has_value() ||
+      current_->used + size > current_->device.numel()) {
+    nextChunk(size);
+  }
+  const int64_t offset = current_->used;
+  auto* host = static_cast<std::byte*>(current_->host.data_ptr()) + offset;
+  write(host);
+  at::Tensor table = current_->device.narrow(0, offset, size);
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaMemcpyAsync(
+      table.data_ptr(),
+      host,
+      size,
+      cudaMemcpyHostToDevice,
+      stream_.stream()));
+  current_->used = roundUpToMultiple(offset + size, table_alignment);
+  return table;
+}
+
+} // namespace nvfuser
@@ -0,0 +1,78 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+
+#include <ATen/core/Tensor.h>
+#include <ATen/cuda/CUDAEvent.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <visibility.h>
+
+namespace nvfuser {
+
+//! \class ArgTableStaging
+//! \brief Pinned and device memory of a stream through which the argument
+//! tables of its kernel launches are copied, see
+//! KernelExecutor::copyArgsToTable.
+//!
+//! Consecutive tables, e.g., those of the segments of a FusionKernelRuntime
+//! run, are placed one after another in a chunk of pinned memory paired with
+//! a chunk of device memory of the same size, so a launch allocates neither.
+//! Allocating pinned memory is slow and implicitly synchronizes the device,
+//! and the caching host allocator does so whenever the host runs ahead of the
+//! copies of the blocks it could reuse. A full chunk is retired with an event
+//! recorded after the kernels reading it, and is reused once the event has
+//! completed, so staging never waits for the device.
+//!
+//! Each thread has its own staging per stream, so a chunk is only retired by
+//! the thread that enqueued all the kernels reading it. Tables copied during
+//! stream capture must outlive the captured graph and are not staged here.
+class NVF_API ArgTableStaging {
+ public:
+  explicit ArgTableStaging(c10::cuda::CUDAStream stream);
+
+  //! The staging of the calling thread for the current stream of device
+  static ArgTableStaging& current(c10::DeviceIndex device);
+
+  //! Writes size bytes to pinned memory with write and copies them
+  //! asynchronously to the returned device memory, ordered before the work
+  //! enqueued on the stream afterwards. The memory is reused once the kernels
+  //! enqueued before its chunk is retired have completed, so the table must
+  //! be read by a kernel launched before the next call.
+  at::Tensor stage(int64_t size, const std::function<void(std::byte*)>& write);
+
+  //! Number of chunks allocated so far
+  int64_t numChunks() const {
+    return num_chunks_;
+  }
+
+ private:
+  struct Chunk {
+    at::Tensor host;
+    at::Tensor device;
+    int64_t used = 0;
+    at::cuda::CUDAEvent retired;
+  };
+
+  //! Makes current_ a chunk with at least size bytes free
+  void nextChunk(int64_t size);
+
+  c10::cuda::CUDAStream stream_;
+  std::optional<Chunk> current_;
+  //! Retired chunks, in the order their events were recorded
+  std::deque<Chunk> retired_;
+  int64_t num_chunks_ = 0;
+};
+
+} // namespace nvfuser
@@ -0,0 +1,212 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/compile_thread_pool.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#include <exceptions.h>
+#include <multidevice/communicator.h>
+#include <utils.h>
+
+namespace nvfuser {
+
+namespace {
+
+// The CPUs the process may run on
+std::vector<int64_t> processCpus() {
+  std::vector<int64_t> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int64_t cpu : arange((int64_t)CPU_SETSIZE)) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  if (cpus.empty()) {
+    cpus.resize(std::max(std::thread::hardware_concurrency(), 1u));
+    std::iota(cpus.begin(), cpus.end(), 0);
+  }
+  return cpus;
+}
+
+// The number of processes of the node, if they form a Communicator
+int64_t localSize() {
+  const Communicator& communicator = Communicator::getInstance();
+  return communicator.is_available() ? communicator.local_size() : 1;
+}
+
+// Parses a list of CPUs and ranges of CPUs, e.g., "0-7,16"
+std::vector<int64_t> parseCpus(const std::string& list) {
+  std::vector<int64_t> cpus;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    int64_t first = -1;
+    int64_t last = -1;
+    try {
+      const size_t dash = item.find('-');
+      first = std::stoll(item.substr(0, dash));
+      last = dash == std::string::npos ? first
+                                       : std::stoll(item.substr(dash + 1));
+    } catch (const std::exception&) {
+    }
+    NVF_CHECK(
+        first >= 0 && first <= last && last < CPU_SETSIZE,
+        "NVFUSER_COMPILE_CPUS expects a list of CPUs such as 0-7,16, got ",
+        list);
+    for (int64_t cpu : arange(first, last + 1)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// The slice of the CPUs of the process that belongs to the local rank
+std::vector<int64_t> localRankCpus() {
+  std::vector<int64_t> cpus = processCpus();
+  const Communicator& communicator = Communicator::getInstance();
+  if (!communicator.is_available() || communicator.local_size() <= 1) {
+    return cpus;
+  }
+  const int64_t local_size = communicator.local_size();
+  const int64_t local_rank = communicator.local_rank();
+  const int64_t slice = std::max(std::ssize(cpus) / local_size, (int64_t)1);
+  const int64_t begin = (local_rank * slice) % std::ssize(cpus);
+  const int64_t end = std::min(begin + slice, (int64_t)std::ssize(cpus));
+  return std::vector<int64_t>(cpus.begin() + begin, cpus.begin() + end);
+}
+
+int64_t numThreads(const CompileThreadPoolOptions& options) {
+  const int64_t num_cpus = options.cpus.empty() ? std::ssize(processCpus())
+                                                : std::ssize(options.cpus);
+  if (options.num_threads > 0) {
+    return std::min(options.num_threads, num_cpus);
+  }
+  constexpr int64_t default_num_threads = 8;
+  return std::clamp(num_cpus / localSize(), (int64_t)1, default_num_threads);
+}
+
+// Pins the calling thread to cpus and sets its nice value
+void initThread(const CompileThreadPoolOptions& options) {
+  if (!options.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int64_t cpu : options.cpus) {
+      CPU_SET(cpu, &set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+      TORCH_WARN("Failed to set the CPU affinity of a compilation thread");
+    }
+  }
+  if (options.nice.has_value()) {
+    // On Linux, the nice value is per thread
+    const auto tid = (id_t)syscall(SYS_gettid);
+    if (setpriority(PRIO_PROCESS, tid, (int)options.nice.value()) != 0) {
+      TORCH_WARN(
+          "Failed to set the nice value of a compilation thread to ",
+          options.nice.value());
+    }
+  }
+}
+
+std::mutex options_mutex;
+std::optional<CompileThreadPoolOptions> pool_options;
+bool pool_created = false;
+
+CompileThreadPoolOptions takePoolOptions() {
+  std::lock_guard<std::mutex> guard(options_mutex);
+  pool_created = true;
+  if (pool_options.has_value()) {
+    return *pool_options;
+  }
+  return compileThreadPoolOptionsFromEnv();
+}
+
+} // namespace
+
+CompileThreadPoolOptions compileThreadPoolOptionsFromEnv() {
+  CompileThreadPoolOptions options;
+  if (const char* num_threads = getNvFuserEnv("NUM_THREADS")) {
+    options.num_threads = std::max(std::atoi(num_threads), 1);
+  }
+  if (const char* cpus = getNvFuserEnv("COMPILE_CPUS")) {
+    options.cpus = std::string(cpus) == "local" ? localRankCpus()
+                                                : parseCpus(cpus);
+  }
+  if (const char* nice = getNvFuserEnv("COMPILE_NICE")) {
+    options.nice = std::clamp(std::atoi(nice), -20, 19);
+  }
+  return options;
+}
+
+CompileThreadPool::CompileThreadPool(const CompileThreadPoolOptions& options)
+    : c10::ThreadPool(
+          (int)numThreads(options),
+          /*numa_node_id=*/-1,
+          [options]() { initThread(options); }) {}
+
+void CompileThreadPool::run(std::function<void()> func) {
+  const int64_t queued = queued_.fetch_add(1, std::memory_order_relaxed) + 1;
+  int64_t max_queued = max_queued_.load(std::memory_order_relaxed);
+  while (queued > max_queued &&
+         !max_queued_.compare_exchange_weak(
+             max_queued, queued, std::memory_order_relaxed)) {
+  }
+  c10::ThreadPool::run([this, func = std::move(func)]() {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    running_.fetch_add(1, std::memory_order_relaxed);
+    auto finish = [this]() {
+      running_.fetch_sub(1, std::memory_order_relaxed);
+      completed_.fetch_add(1, std::memory_order_relaxed);
+    };
+    try {
+      func();
+    } catch (...) {
+      finish();
+      throw;
+    }
+    finish();
+  });
+}
+
+CompileThreadPoolStats CompileThreadPool::stats() const {
+  return {
+      .num_threads = (int64_t)size(),
+      .queued = queued_.load(std::memory_order_relaxed),
+      .running = running_.load(std::memory_order_relaxed),
+      .completed = completed_.load(std::memory_order_relaxed),
+      .max_queued = max_queued_.load(std::memory_order_relaxed)};
+}
+
+void setCompileThreadPoolOptions(CompileThreadPoolOptions options) {
+  std::lock_guard<std::mutex> guard(options_mutex);
+  NVF_CHECK(
+      !pool_created,
+      "The compilation thread pool can only be configured before its first "
+      "use");
+  pool_options = std::move(options);
+}
+
+CompileThreadPool* getThreadPool() {
+  static CompileThreadPool pool(takePoolOptions());
+  return &pool;
+}
+
+} // namespace nvfuser
@@ -0,0 +1,84 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <c10/core/thread_pool.h>
+
+#include <visibility.h>
+
+namespace nvfuser {
+
+//! Settings of the thread pool returned by getThreadPool
+struct CompileThreadPoolOptions {
+  //! Number of threads, or 0 for the default: 8, but no more than the CPUs
+  //! the threads may run on divided by the processes of the node, so that
+  //! the ranks of a node don't oversubscribe it
+  int64_t num_threads = 0;
+  //! CPUs the threads are pinned to. Empty leaves them on the CPUs of the
+  //! process.
+  std::vector<int64_t> cpus;
+  //! Nice value of the threads, from -20 to 19. Lowering it below that of
+  //! the process usually requires privileges.
+  std::optional<int64_t> nice;
+};
+
+//! Reads the options from the environment:
+//!   NVFUSER_NUM_THREADS: the number of threads
+//!   NVFUSER_COMPILE_CPUS: the CPUs to pin the threads to, e.g., "0-7,16",
+//!     or "local" for the slice of the CPUs of the process that belongs to
+//!     the local rank of the Communicator
+//!   NVFUSER_COMPILE_NICE: the nice value of the threads
+NVF_API CompileThreadPoolOptions compileThreadPoolOptionsFromEnv();
+
+//! A snapshot of the work of a CompileThreadPool
+struct CompileThreadPoolStats {
+  int64_t num_threads = 0;
+  //! Tasks waiting for a thread
+  int64_t queued = 0;
+  //! Tasks being run
+  int64_t running = 0;
+  int64_t completed = 0;
+  //! The largest number of tasks that waited for a thread at once
+  int64_t max_queued = 0;
+};
+
+//! \class CompileThreadPool
+//! \brief The threads compiling the segments of fusions, lowering kernels
+//! and deserializing fusion caches, configured by CompileThreadPoolOptions.
+//! It counts its tasks to report how deep its queue gets.
+class CompileThreadPool : public c10::ThreadPool {
+ public:
+  explicit CompileThreadPool(const CompileThreadPoolOptions& options);
+
+  void run(std::function<void()> func) override;
+
+  CompileThreadPoolStats stats() const;
+
+ private:
+  std::atomic<int64_t> queued_ = 0;
+  std::atomic<int64_t> running_ = 0;
+  std::atomic<int64_t> completed_ = 0;
+  std::atomic<int64_t> max_queued_ = 0;
+};
+
+//! Sets the options of the pool returned by getThreadPool, overriding the
+//! environment. It must be called before the pool is first used.
+NVF_API void setCompileThreadPoolOptions(CompileThreadPoolOptions options);
+
+//! The pool, created on first use with the options set by
+//! setCompileThreadPoolOptions or else from the environment
+NVF_API CompileThreadPool* getThreadPool();
+
+} // namespace nvfuser
@@ -21,6 +21,7 @@
 #include <ir/all_nodes.h>
 #include <ir/utils.h>
 #include <iter_visitor.h>
+#include <kernel_db/kernel_cache.h>
 #include <kernel_db/kernel_db.h>
 #include <kernel_ir.h>
 #include <multidevice/communication.h>
@@ -28,6 +29,7 @@
 #include <multidevice/utils.h>
 #include <options.h>
 #include <polymorphic_value.h>
+#include <remarks.h>
 #include <runtime/allocations.h>
 #include <runtime/executor_kernel_arg.h>
 #include <runtime/executor_utils.h>
@@ -78,6 +80,7 @@
 #include <nvfuser_resources/mbarrier.h>
 #include <nvfuser_resources/memory.h>
 #include <nvfuser_resources/random_numbers.h>
+#include <nvfuser_resources/sort_utils.h>
 #include <nvfuser_resources/tensor.h>
 #include <nvfuser_resources/tensor_memory.h>
 #include <nvfuser_resources/topk.h>
@@ -118,6 +121,8 @@ std::string kernelPreamble() {
     ss << nvfuser_resources::block_sync_default_cu;
   }
   ss << nvfuser_resources::grid_sync_cu;
+  // mbarrier.cu uses the multicast helpers of cluster.cu
+  ss << nvfuser_resources::cluster_cu;
   ss << nvfuser_resources::mbarrier_cu;
 
   // Communication classes
@@ -552,6 +557,14 @@ void fillCompileOptions(
   if (isOptionEnabled(EnableOption::KernelProfile)) {
     nvrtc_compile_driver.setOption("-DNVFUSER_PROFILE_KERNEL");
   }
+
+#if CUDA_VERSION >= 12080
+  // Let NVRTC precompile the runtime header, see createNvrtcProgram
+  if (isOptionEnabled(EnableOption::NvrtcPch)) {
+    nvrtc_compile_driver.setOption("-pch");
+    nvrtc_compile_driver.setOption("--pch-messages=false");
+  }
+#endif
   if (isDebugDumpEnabled(DebugDumpOption::PrintPtxasLog) ||
       isDebugDumpEnabled(DebugDumpOption::PerfDebugVerbose) ||
       isOptionEnabled(EnableOption::WarnRegisterSpill) ||
@@ -649,6 +662,9 @@ int warnRegisterSpill(const std::string& compile_log) {
   return store_count + load_count;
 }
 
+// Defined below with the rest of the source code generation
+const std::string& runtimeHeader(PrimDataType index_type);
+
 void createNvrtcProgram(
     nvrtcProgram& program,
     const std::string& kernel_name,
@@ -657,6 +673,28 @@ void createNvrtcProgram(
   ss << "__tmp_" << kernel_name << ".cu";
   std::string name = ss.str();
   FUSER_PERF_SCOPE("executor_utils::NvrtcCreateProgram");
+
+  // The runtime library is identical for all kernels with the same index
+  // type. Automatic PCH only applies to included headers, so pass it as a
+  // header, which NVRTC then parses once per process instead of per kernel.
+  if (isOptionEnabled(EnableOption::NvrtcPch)) {
+    for (PrimDataType index_type : {PrimDataType::Int, PrimDataType::Int32}) {
+      const std::string& header = runtimeHeader(index_type);
+      if (full_src_code.compare(0, header.size(), header) != 0) {
+        continue;
+      }
+      const char* header_name = index_type == PrimDataType::Int
+          ? "nvfuser_runtime_int64.h"
+          : "nvfuser_runtime_int32.h";
+      const char* header_src = header.c_str();
+      const std::string src = std::string("#include \"") + header_name +
+          "\"\n" + full_src_code.substr(header.size());
+      NVFUSER_NVRTC_SAFE_CALL(nvrtcCreateProgram(
+          &program, src.c_str(), name.c_str(), 1, &header_src, &header_name));
+      return;
+    }
+  }
+
   NVFUSER_NVRTC_SAFE_CALL(nvrtcCreateProgram(
       &program, full_src_code.c_str(), name.c_str(), 0, nullptr, nullptr));
 }
@@ -752,7 +790,75 @@ std::unique_ptr<executor_utils::CudaExecutable> compileSource(
   return compiled_kernel;
 }
 
-// Compile the source if no existing compiled binary is found in KernelDB
+// Compiles full_src_code to a cubin for each architecture of
+// EnableOption::CompileForArchs other than major.minor. Kernels using features
+// an architecture doesn't have fail to compile for it and get no image, so
+// loading them there fails.
+void compileForArchs(
+    executor_utils::CudaExecutable* compiled_kernel,
+    const std::string& full_src_code,
+    const std::string& func_name,
+    int64_t major,
+    int64_t minor,
+    const CompileParams& compile_params,
+    std::optional<int64_t> opt_block_size) {
+  FUSER_PERF_SCOPE("executor_utils::compileForArchs");
+  compiled_kernel->images.clear();
+  for (int64_t arch : executor_utils::getCompileForArchs()) {
+    if (arch == major * 10 + minor) {
+      continue;
+    }
+    NvrtcCompileDriver nvrtc_compile_driver;
+    CuModuleLoadDataDriver module_load_driver;
+    fillCompileOptions(
+        nvrtc_compile_driver,
+        module_load_driver,
+        /*compile_to_sass=*/true,
+        arch / 10,
+        arch % 10,
+        compile_params,
+        opt_block_size);
+    std::unique_ptr<executor_utils::CudaExecutable> image;
+    try {
+      image = compileSource(
+          full_src_code,
+          func_name,
+          /*compile_to_sass=*/true,
+          nvrtc_compile_driver);
+    } catch (const std::exception& e) {
+      TORCH_WARN(
+          "Unable to compile ", func_name, " for sm_", arch, ": ", e.what());
+      continue;
+    }
+    compiled_kernel->images.push_back(
+        {arch,
+         toDelimitedString(nvrtc_compile_driver.options(), " "),
+         std::move(image->cubin)});
+  }
+}
+
+// Returns the key of a kernel in KernelCache. It must cover everything the
+// compiled binary depends on. The target architecture is part of the compile
+// arguments but is added explicitly as a safeguard.
+std::string getKernelCacheKey(
+    const std::string& full_src_code,
+    const std::string& compile_args,
+    bool compile_to_sass,
+    int64_t major,
+    int64_t minor) {
+  int nvrtc_major = 0;
+  int nvrtc_minor = 0;
+  NVFUSER_NVRTC_SAFE_CALL(nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+  std::stringstream ss;
+  ss << "cuda=" << CUDA_VERSION << ";nvrtc=" << nvrtc_major << "."
+     << nvrtc_minor << ";arch=" << major << minor
+     << ";binary=" << (compile_to_sass ? "cubin" : "ptx")
+     << ";args=" << compile_args << ";src=" << full_src_code;
+  return ss.str();
+}
+
+// Compile the source if no existing compiled binary is found in KernelDB or
+// KernelCache
 std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
     std::optional<std::reference_wrapper<const std::string>> kernel_code,
     const std::string& full_src_code,
@@ -822,14 +928,60 @@ std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
   auto& kernel_db = KernelDb::get();
   const auto use_kernel_db = kernel_db.enabled() && kernel_code.has_value();
 
+  // Cached binaries don't come with the compile log and the dumped files, so
+  // the kernel caches are bypassed when those are requested.
+  const bool use_kernel_caches =
+      !(isOptionEnabled(EnableOption::WarnRegisterSpill) ||
+        compile_params.enable_ptxas_verbose ||
+        isDebugDumpEnabled(DebugDumpOption::Ptx) ||
+        isDebugDumpEnabled(DebugDumpOption::Cubin) ||
+        isDebugDumpEnabled(DebugDumpOption::SassToFile));
+
+  KernelCache* kernel_cache = use_kernel_caches ? KernelCache::get() : nullptr;
+  std::string kernel_cache_key;
+  if (kernel_cache != nullptr) {
+    kernel_cache_key = getKernelCacheKey(
+        full_src_code, compile_args, compile_to_sass, major, minor);
+  }
+
+  const bool use_binary_cache = use_kernel_caches &&
+      kernel_code.has_value() &&
+      !isOptionDisabled(DisableOption::KernelBinaryCache);
+  std::string binary_cache_key;
+  if (use_binary_cache) {
+    binary_cache_key = KernelBinaryCache::makeKey(
+        kernel_code->get(), func_name, compile_args, compile_to_sass);
+  }
+
+  auto binary = [&]() -> std::vector<char>& {
+    return compile_to_sass ? compiled_kernel->cubin : compiled_kernel->ptx;
+  };
+
+  auto query_binary_cache = [&]() {
+    if (!use_binary_cache) {
+      return false;
+    }
+    auto entry = KernelBinaryCache::get().query(binary_cache_key);
+    if (entry == nullptr) {
+      return false;
+    }
+    compiled_kernel->kernel_name = entry->kernel_name;
+    binary() = entry->binary;
+    return true;
+  };
+
   // If the Kernel Query fails, the Kernel is recompiled
-  if (!(use_kernel_db &&
+  const bool binary_cache_hit = query_binary_cache();
+  if (!binary_cache_hit &&
+      !(use_kernel_db &&
         kernel_db.query(
             kernel_code.value(),
             compile_args,
             compiled_kernel->kernel_name,
-            (compile_to_sass ? compiled_kernel->cubin
-                             : compiled_kernel->ptx)))) {
+            binary())) &&
+      !(kernel_cache != nullptr &&
+        kernel_cache->query(
+            kernel_cache_key, compiled_kernel->kernel_name, binary()))) {
     compiled_kernel = compileSource(
         full_src_code, func_name, compile_to_sass, nvrtc_compile_driver);
     log << compiled_kernel->compile_log << std::endl;
@@ -838,20 +990,56 @@ std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
           kernel_code.value(),
           compile_args,
           compiled_kernel->kernel_name,
-          (compile_to_sass ? compiled_kernel->cubin : compiled_kernel->ptx));
+          binary());
       if (!result) {
         TORCH_WARN(
             "kernel_db was unable to write kernel: ",
             compiled_kernel->kernel_name);
       }
     }
+    if (kernel_cache != nullptr &&
+        !kernel_cache->write(
+            kernel_cache_key, compiled_kernel->kernel_name, binary())) {
+      TORCH_WARN(
+          "Unable to write kernel to the kernel cache: ",
+          compiled_kernel->kernel_name);
+    }
+  }
+  if (use_binary_cache && !binary_cache_hit) {
+    KernelBinaryCache::get().write(
+        binary_cache_key, {compiled_kernel->kernel_name, binary()});
+  }
+  if (compile_to_sass && isOptionEnabled(EnableOption::CompileForArchs)) {
+    compileForArchs(
+        compiled_kernel.get(),
+        full_src_code,
+        func_name,
+        major,
+        minor,
+        compile_params,
+        opt_block_size);
+  }
+
+  // PTX is JIT compiled on load with options that depend on the kernel, so
+  // only modules loaded from cubins are shared
+  if (compile_to_sass && use_binary_cache) {
+    auto load_module = [&]() {
+      CUmodule module = nullptr;
+      log << module_load_driver.invoke(module, compiled_kernel->cubin.data())
+          << std::endl;
+      return module;
+    };
+    compiled_kernel->shared_module =
+        executor_utils::ModuleRegistry::get().getOrLoad(
+            compiled_kernel->cubin, device, load_module);
+    compiled_kernel->module = compiled_kernel->shared_module->module;
+  } else {
+    log << module_load_driver.invoke(
+               compiled_kernel->module,
+               (compile_to_sass ? compiled_kernel->cubin.data()
+                                : compiled_kernel->ptx.data()))
+        << std::endl;
   }
-
-  log << module_load_driver.invoke(
-             compiled_kernel->module,
-             (compile_to_sass ? compiled_kernel->cubin.data()
-                              : compiled_kernel->ptx.data()))
-      << std::endl;
   compiled_kernel->compile_log = log.str();
   compiled_kernel->compile_args = compile_args;
 
@@ -874,11 +1062,10 @@ std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
   return compiled_kernel;
 }
 
+// Restores the binaries of a CudaExecutable without loading its module, see
+// loadCudaExecutable
 std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
-    const serde::CudaKernel* buffer,
-    const CompileParams& compile_params) {
-  FUSER_PERF_SCOPE("executor_utils::serde_NVRTC");
-
+    const serde::CudaKernel* buffer) {
   NVF_ERROR(buffer != nullptr, "serde::CudaKernel is nullptr.");
 
   // Deserialize flatbuffer into CudaExecutable
@@ -905,6 +1092,27 @@ std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
     compiled_kernel->ptx_filename = buffer->ptx_filename()->str();
   }
 
+  if (buffer->images() != nullptr) {
+    for (auto fb_image : *buffer->images()) {
+      executor_utils::CudaKernelImage& image =
+          compiled_kernel->images.emplace_back();
+      image.arch = fb_image->arch();
+      image.compile_args = fb_image->compile_args()->str();
+      image.cubin.assign(fb_image->cubin()->begin(), fb_image->cubin()->end());
+    }
+  }
+
+  return compiled_kernel;
+}
+
+// Loads the module of a CudaExecutable restored by getCudaExecutable after
+// checking that its compile arguments are still the ones generated for
+// compile_params
+void loadCudaExecutable(
+    executor_utils::CudaExecutable* compiled_kernel,
+    const CompileParams& compile_params) {
+  FUSER_PERF_SCOPE("executor_utils::serde_NVRTC");
+
   at::cuda::jit::initializeCudaContext();
 
   // The above initialization works in some cases. However, it seems to
@@ -945,8 +1153,26 @@ std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
 
   const auto latest_compile_args =
       toDelimitedString(nvrtc_compile_driver.options(), " ");
+
+  // A kernel compiled on another architecture is loaded from its image for
+  // this one, see EnableOption::CompileForArchs
+  const executor_utils::CudaKernelImage* image = nullptr;
+  if (latest_compile_args != compiled_kernel->compile_args && compile_to_sass) {
+    auto image_it = std::find_if(
+        compiled_kernel->images.begin(),
+        compiled_kernel->images.end(),
+        [&](const executor_utils::CudaKernelImage& candidate) {
+          return candidate.arch == major * 10 + minor;
+        });
+    if (image_it != compiled_kernel->images.end()) {
+      image = &*image_it;
+    }
+  }
+
   NVF_ERROR(
-      latest_compile_args == compiled_kernel->compile_args,
+      latest_compile_args ==
+          (image != nullptr ? image->compile_args
+                            : compiled_kernel->compile_args),
       "The compile arguments for the serialized cuda kernel does not ",
       "match the latest generated compile args.\t",
       latest_compile_args,
@@ -954,18 +1180,22 @@ std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
       compiled_kernel->compile_args);
 
   NVF_ERROR(
-      !compile_to_sass || !compiled_kernel->cubin.empty(),
+      !compile_to_sass || image != nullptr || !compiled_kernel->cubin.empty(),
       "Expected compiled cubin after deserializing CudaExecutable.");
 
   NVF_ERROR(
       compile_to_sass || !compiled_kernel->ptx.empty(),
       "Expected compiled ptx after deserializing CudaExecutable.");
 
+  const char* binary = nullptr;
+  if (image != nullptr) {
+    binary = image->cubin.data();
+  } else {
+    binary = compile_to_sass ? compiled_kernel->cubin.data()
+                             : compiled_kernel->ptx.data();
+  }
   std::stringstream log;
-  log << module_load_driver.invoke(
-             compiled_kernel->module,
-             (compile_to_sass ? compiled_kernel->cubin.data()
-                              : compiled_kernel->ptx.data()))
+  log << module_load_driver.invoke(compiled_kernel->module, binary)
       << std::endl;
   compiled_kernel->compile_log = log.str();
 
@@ -973,8 +1203,6 @@ std::unique_ptr<executor_utils::CudaExecutable> getCudaExecutable(
       &(compiled_kernel->function),
       compiled_kernel->module,
       compiled_kernel->kernel_name.c_str()));
-
-  return compiled_kernel;
 }
 
 static const char* defineIndexType(PrimDataType index_type) {
@@ -1015,6 +1243,24 @@ static const std::string& defineStdComplex() {
   return result;
 }
 
+// The part of the source code shared by all kernels with the same index type
+const std::string& runtimeHeader(PrimDataType index_type) {
+  auto make_header = [](PrimDataType index_type) {
+    return defineStdComplex() + "namespace " +
+        CompiledKernel::kernelNamespace() + "{\n" + defineTypes() +
+        defineIndexType(index_type) + kernelPreamble() + "} // namespace " +
+        CompiledKernel::kernelNamespace() + "\n";
+  };
+  static const std::string int32_header = make_header(PrimDataType::Int32);
+  static const std::string int64_header = make_header(PrimDataType::Int);
+  if (index_type == PrimDataType::Int32) {
+    return int32_header;
+  }
+  NVF_ERROR(
+      index_type == PrimDataType::Int, "invalid indexing type: ", index_type);
+  return int64_header;
+}
+
 // When executing nvFuser with: NVFUSER_EXTERNAL_SRC=file1.cu,file2.cu
 // This function retrieves structured code from the specified files.
 // The files should be comma-separated, and their order corresponds to the
@@ -1135,11 +1381,11 @@ std::string _getStructuredCode(
     bool has_argsort = false,
     bool has_topk = false) {
   // generating cuda code;
-  std::string code = "";
-  code += defineStdComplex();
-  code += std::string("namespace ") + CompiledKernel::kernelNamespace() +
-      "{\n" + defineTypes() + defineIndexType(index_type) + kernelPreamble() +
-      "} // namespace " + CompiledKernel::kernelNamespace() + "\n";
+  std::string code = runtimeHeader(index_type);
+
+  if (has_argsort || has_topk) {
+    code += nvfuser_resources::sort_utils_cu;
+  }
 
   if (has_argsort) {
     code += nvfuser_resources::argsort_cu;
@@ -1176,6 +1422,115 @@ std::string _getStructuredCode(
 
 } // namespace
 
+KernelBinaryCache& KernelBinaryCache::get() {
+  static KernelBinaryCache cache;
+  return cache;
+}
+
+std::string KernelBinaryCache::makeKey(
+    const std::string& kernel_code,
+    const std::string& func_name,
+    const std::string& compile_args,
+    bool compile_to_sass) {
+  std::stringstream ss;
+  ss << (compile_to_sass ? "cubin" : "ptx") << ";" << compile_args << ";";
+  // Replace the kernel name, which is the only part of the code that depends
+  // on the IDs of the fusion and the segment
+  size_t pos = 0;
+  while (true) {
+    const size_t next = kernel_code.find(func_name, pos);
+    ss << std::string_view(kernel_code).substr(pos, next - pos);
+    if (next == std::string::npos) {
+      break;
+    }
+    ss << "$kernel";
+    pos = next + func_name.size();
+  }
+  return ss.str();
+}
+
+std::shared_ptr<const KernelBinaryCache::Entry> KernelBinaryCache::query(
+    const std::string& key) {
+  FUSER_PERF_SCOPE("KernelBinaryCache::query");
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++hits_;
+  it->second.last_use = ++access_count_;
+  return it->second.entry;
+}
+
+void KernelBinaryCache::write(const std::string& key, Entry entry) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  const int64_t num_bytes = std::ssize(key) + std::ssize(entry.kernel_name) +
+      std::ssize(entry.binary);
+  auto [it, inserted] = entries_.try_emplace(
+      key,
+      Slot{
+          std::make_shared<const Entry>(std::move(entry)),
+          num_bytes,
+          ++access_count_});
+  if (inserted) {
+    num_bytes_ += num_bytes;
+    evict(key);
+  }
+}
+
+void KernelBinaryCache::evict(const std::string& keep) {
+  while (num_bytes_ > max_bytes_) {
+    auto lru = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->first == keep) {
+        continue;
+      }
+      if (lru == entries_.end() ||
+          it->second.last_use < lru->second.last_use) {
+        lru = it;
+      }
+    }
+    if (lru == entries_.end()) {
+      return;
+    }
+    num_bytes_ -= lru->second.num_bytes;
+    entries_.erase(lru);
+  }
+}
+
+int64_t KernelBinaryCache::size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return std::ssize(entries_);
+}
+
+int64_t KernelBinaryCache::numBytes() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return num_bytes_;
+}
+
+int64_t KernelBinaryCache::hits() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return hits_;
+}
+
+int64_t KernelBinaryCache::maxBytes() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return max_bytes_;
+}
+
+void KernelBinaryCache::setMaxBytes(int64_t max_bytes) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  max_bytes_ = max_bytes;
+  evict(/*keep=*/"");
+}
+
+void KernelBinaryCache::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  entries_.clear();
+  num_bytes_ = 0;
+  hits_ = 0;
+}
+
 NVF_API CompiledKernel::CompiledKernel(
     Fusion* fusion,
     CompileParams compile_params,
@@ -1276,24 +1631,51 @@ void CompiledKernel::compile(const LaunchParams& lparams) {
     kernel->print();
   }
 
-  if (isDebugDumpEnabled(DebugDumpOption::BankConflictInfo)) {
+  const bool dump_bank_conflict =
+      isDebugDumpEnabled(DebugDumpOption::BankConflictInfo);
+  if (dump_bank_conflict || remarks::isActive()) {
     auto bank_conflict_info = getBankConflictInfo(kernel);
-    if (bank_conflict_info.empty()) {
-      debug() << "===== No bank confliction =====" << std::endl;
-    } else {
-      debug() << "======= Bank confliction =======" << std::endl;
-      for (auto info : bank_conflict_info) {
-        debug() << "Expr: " << info.first->toString() << std::endl;
-        auto conflict = info.second;
-        if (conflict.first > 1) {
-          debug() << "input conflict: " << conflict.first << " way, ";
-        }
-        if (conflict.second > 1) {
-          debug() << "output conflict: " << conflict.second << " way";
+    for (const auto& [expr, conflict] : bank_conflict_info) {
+      remarks::report(
+          "bank_conflict",
+          "shared memory bank conflict",
+          {{"expr", expr->toString()},
+           {"input_ways", std::to_string(conflict.first)},
+           {"output_ways", std::to_string(conflict.second)}});
+    }
+    if (dump_bank_conflict) {
+      if (bank_conflict_info.empty()) {
+        debug() << "===== No bank confliction =====" << std::endl;
+      } else {
+        debug() << "======= Bank confliction =======" << std::endl;
+        for (auto info : bank_conflict_info) {
+          debug() << "Expr: " << info.first->toString() << std::endl;
+          auto conflict = info.second;
+          if (conflict.first > 1) {
+            debug() << "input conflict: " << conflict.first << " way, ";
+          }
+          if (conflict.second > 1) {
+            debug() << "output conflict: " << conflict.second << " way";
+          }
+          debug() << std::endl;
         }
-        debug() << std::endl;
+        debug() << "================================" << std::endl;
       }
-      debug() << "================================" << std::endl;
+    }
+  }
+
+  if (remarks::isActive()) {
+    for (auto tv : ir_utils::allTvs(kernel)) {
+      if (!tv->isCircularBuffered()) {
+        continue;
+      }
+      const auto& options = tv->circularBufferOptions();
+      remarks::report(
+          "circular_buffering",
+          "circular buffered tensor",
+          {{"tensor", tv->toString()},
+           {"stages", std::to_string(options.stage)},
+           {"prefetch", std::to_string(options.prefetch)}});
     }
   }
 
@@ -1365,6 +1747,17 @@ void CompiledKernel::compile(const LaunchParams& lparams) {
 
   NVF_ERROR(validKernelId(), "Invalid kernel id for CompiledKernel.");
 
+  if (remarks::isActive()) {
+    std::vector<std::pair<std::string, std::string>> args = {
+        {"local_memory_bytes", std::to_string(localMemorySize())}};
+    // Spills are only parsed from the ptxas log when it is verbose
+    if (compiled_kernel_->register_spills >= 0) {
+      args.emplace_back(
+          "spills", std::to_string(compiled_kernel_->register_spills));
+    }
+    remarks::report("registers", "register usage", std::move(args));
+  }
+
   if (isDebugDumpEnabled(DebugDumpOption::Sass)) {
     debug() << disassembledKernelSASS() << std::endl;
   }
@@ -1443,6 +1836,26 @@ void RtcKernel::compile(
   compiled_kernel_ = getCudaExecutable(std::nullopt, scode, name, "0", cp);
 }
 
+std::unique_ptr<executor_utils::CudaExecutable> compileKernelCode(
+    const std::string& code,
+    const std::string& func_name,
+    const CompileParams& compile_params,
+    int64_t block_size) {
+  FUSER_PERF_SCOPE("compileKernelCode");
+  NVF_ERROR(
+      compile_params.index_type.has_value(),
+      "The index type of ",
+      func_name,
+      " is not given");
+  return getCudaExecutable(
+      std::nullopt,
+      _getStructuredCode(code, compile_params.index_type.value(), func_name),
+      func_name,
+      func_name,
+      compile_params,
+      block_size);
+}
+
 float RtcKernel::run(
     const LaunchParams& launch_params,
     const KernelArgumentHolder& args,
@@ -1523,8 +1936,85 @@ void CompiledKernel::deserialize(const serde::KernelExecutor* buffer) {
   createKernelId();
   setUsedTVs();
 
-  compiled_kernel_ =
-      getCudaExecutable(buffer->compiled_kernel(), compile_params_);
+  compiled_kernel_ = getCudaExecutable(buffer->compiled_kernel());
+  if (!isOptionEnabled(EnableOption::LazyModuleLoad)) {
+    loadModule();
+  }
+}
+
+void CompiledKernel::loadModule() {
+  if (module_loaded_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(module_load_mutex_);
+  NVF_ERROR(compiled_kernel_ != nullptr, "Kernel is not compiled");
+  if (compiled_kernel_->function == nullptr) {
+    c10::DeviceGuard dg(device_);
+    loadCudaExecutable(compiled_kernel_.get(), compile_params_);
+  }
+  module_loaded_.store(true, std::memory_order_release);
+}
+
+CUfunction CompiledKernel::functionWithCachedAttributes() {
+  NVF_ERROR(isCompiled(), "Kernel is not compiled");
+  CUfunction function = compiled_kernel_->function;
+  if (function != cached_attributes_function_) {
+    cached_attributes_function_ = function;
+    static_smem_size_.reset();
+    available_dynamic_smem_size_.reset();
+  }
+  return function;
+}
+
+int64_t CompiledKernel::staticSmemSize() {
+  CUfunction function = functionWithCachedAttributes();
+  if (!static_smem_size_.has_value()) {
+    int size = 0;
+    NVFUSER_CUDA_SAFE_CALL(cuFuncGetAttribute(
+        &size, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES, function));
+    static_smem_size_ = size;
+  }
+  return static_smem_size_.value();
+}
+
+int64_t CompiledKernel::availableDynamicSmemSize() {
+  CUfunction function = functionWithCachedAttributes();
+  if (!available_dynamic_smem_size_.has_value()) {
+    int size = 0;
+    NVFUSER_CUDA_SAFE_CALL(cuFuncGetAttribute(
+        &size, CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES, function));
+    available_dynamic_smem_size_ = size;
+  }
+  return available_dynamic_smem_size_.value();
+}
+
+int64_t CompiledKernel::ensureAvailableDynamicSmemSize(
+    int64_t dynamic_smem_size) {
+  if (dynamic_smem_size <= availableDynamicSmemSize()) {
+    return available_dynamic_smem_size_.value();
+  }
+  // Other kernels may have raised the attribute of a shared module's
+  // function since it was cached here, and must not have it lowered
+  if (const auto& shared_module = compiled_kernel_->shared_module) {
+    available_dynamic_smem_size_ = shared_module->ensureMaxDynamicSmemSize(
+        compiled_kernel_->function, dynamic_smem_size);
+  } else {
+    NVFUSER_CUDA_SAFE_CALL(cuFuncSetAttribute(
+        compiled_kernel_->function,
+        CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES,
+        dynamic_smem_size));
+    available_dynamic_smem_size_ = dynamic_smem_size;
+  }
+  return available_dynamic_smem_size_.value();
+}
+
+int64_t CompiledKernel::localMemorySize() const {
+  NVF_ERROR(isCompiled(), "Kernel is not compiled");
+  NVF_ERROR(compiled_kernel_->function != nullptr, "Module is not loaded");
+  int size = 0;
+  NVFUSER_CUDA_SAFE_CALL(cuFuncGetAttribute(
+      &size, CU_FUNC_ATTRIBUTE_LOCAL_SIZE_BYTES, compiled_kernel_->function));
+  return size;
 }
 
 void CompiledKernel::setUsedTVs() {
@@ -9,6 +9,10 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 #include <c10/core/DeviceType.h>
 
@@ -54,6 +58,90 @@ class RtcKernel : public NonCopyable {
   int64_t device_index_;
 };
 
+//! Compiles the code of a kernel that isn't generated by a CompiledKernel,
+//! e.g., a Megakernel, with the runtime library of the index type of
+//! compile_params, and loads its function func_name on the current device
+std::unique_ptr<executor_utils::CudaExecutable> compileKernelCode(
+    const std::string& code,
+    const std::string& func_name,
+    const CompileParams& compile_params,
+    int64_t block_size);
+
+//! Process-wide cache of compiled kernel binaries. Segments of different
+//! FusionExecutorCaches often generate the same kernel, which only differs in
+//! the kernel name as it encodes the fusion, runtime and group IDs. Entries
+//! are keyed by the kernel code with its name replaced by a placeholder, the
+//! NVRTC options and the binary kind, so a kernel compiled once in this
+//! process is not compiled again by NVRTC. Lowering and code generation still
+//! run, as the code is the key. The binaries keep the name of the kernel that
+//! was compiled first. The keys and binaries are bounded by maxBytes(), and
+//! the least recently used entries are evicted beyond it. Disabled by
+//! DisableOption::KernelBinaryCache.
+class KernelBinaryCache {
+ public:
+  struct Entry {
+    //! Lowered name of the kernel function in binary
+    std::string kernel_name;
+    //! Cubin or PTX
+    std::vector<char> binary;
+  };
+
+  NVF_API static KernelBinaryCache& get();
+
+  //! Returns the key of the kernel named func_name with the given code
+  static std::string makeKey(
+      const std::string& kernel_code,
+      const std::string& func_name,
+      const std::string& compile_args,
+      bool compile_to_sass);
+
+  //! Returns the cached binary for key, or nullptr on a miss. The entry stays
+  //! valid after being evicted.
+  std::shared_ptr<const Entry> query(const std::string& key);
+
+  //! Adds a compiled binary for key unless another thread already did, and
+  //! evicts the least recently used entries beyond maxBytes()
+  void write(const std::string& key, Entry entry);
+
+  //! Number of cached binaries
+  NVF_API int64_t size() const;
+
+  //! Number of bytes of the cached keys and binaries
+  NVF_API int64_t numBytes() const;
+
+  //! Number of compilations skipped by hits
+  NVF_API int64_t hits() const;
+
+  NVF_API int64_t maxBytes() const;
+
+  //! Sets the bound of numBytes() and evicts entries beyond it
+  NVF_API void setMaxBytes(int64_t max_bytes);
+
+  //! Removes all entries and resets the hit count
+  NVF_API void clear();
+
+ private:
+  KernelBinaryCache() = default;
+
+  struct Slot {
+    std::shared_ptr<const Entry> entry;
+    int64_t num_bytes = 0;
+    //! Value of access_count_ when the entry was last written or queried
+    int64_t last_use = 0;
+  };
+
+  //! Evicts the least recently used entries until num_bytes_ is within
+  //! max_bytes_, except for the one of keep. Called with mutex_ held.
+  void evict(const std::string& keep);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Slot> entries_;
+  int64_t num_bytes_ = 0;
+  int64_t max_bytes_ = 64LL * 1024 * 1024;
+  int64_t access_count_ = 0;
+  int64_t hits_ = 0;
+};
+
 //! Class for compilation logic through nvRTC. It shouldn't hold any logic
 //! associated with how to run a kernel, but how to compile it. It should also
 //! contain any information about the kernel itself.
@@ -106,7 +194,11 @@ class CompiledKernel : public NonCopyable {
     if (compiled_kernel_ == nullptr) {
       return false;
     }
-    NVF_ERROR(compiled_kernel_->function != nullptr);
+    // The module of a deserialized kernel may not be loaded yet, see
+    // loadModule
+    NVF_ERROR(
+        compiled_kernel_->function != nullptr ||
+        !compiled_kernel_->cubin.empty() || !compiled_kernel_->ptx.empty());
     NVF_ERROR(validKernelId(), "Problem detected with compiled kernel ID.");
     return true;
   };
@@ -124,18 +216,38 @@ class CompiledKernel : public NonCopyable {
 
   NVF_API std::string getStructuredCode() const;
 
-  //! Returns a const reference to the latest compiled kernel.
-  const std::unique_ptr<executor_utils::CudaExecutable>& cudaExecutable()
+  //! Returns a const reference to the latest compiled kernel. A launch
+  //! copies it so that the executable it launches stays loaded while
+  //! recompileKernel replaces it.
+  const std::shared_ptr<executor_utils::CudaExecutable>& cudaExecutable()
       const {
     return compiled_kernel_;
   }
-  std::unique_ptr<executor_utils::CudaExecutable>& cudaExecutable() {
+  std::shared_ptr<executor_utils::CudaExecutable>& cudaExecutable() {
     return compiled_kernel_;
   }
 
   //! Returns the disassembled latest compiled binary
   NVF_API std::string disassembledKernelSASS() const;
 
+  //! Static shared memory size of the compiled function. The driver is only
+  //! queried once per function.
+  int64_t staticSmemSize();
+
+  //! Shared memory size currently available for dynamic allocation by the
+  //! compiled function. The driver is only queried once per function.
+  int64_t availableDynamicSmemSize();
+
+  //! Makes sure at least dynamic_smem_size bytes of dynamic shared memory
+  //! are available to the compiled function and returns the available size.
+  //! The driver is only called when the size needs to grow.
+  int64_t ensureAvailableDynamicSmemSize(int64_t dynamic_smem_size);
+
+  //! Local memory per thread of the compiled function, which holds the stack
+  //! frame and the registers spilled by ptxas. Unlike the spill counts of the
+  //! ptxas log, it is also known for binaries loaded from a cache.
+  int64_t localMemorySize() const;
+
   static void setGlobalFusionCount(int64_t new_fusion_count) {
     global_fusion_count_.store(new_fusion_count);
   }
@@ -223,9 +335,15 @@ class CompiledKernel : public NonCopyable {
     return kernel_code_;
   }
 
-  //! Deserialize Fusion Executor using flatbuffers
+  //! Deserialize Fusion Executor using flatbuffers. With
+  //! EnableOption::LazyModuleLoad, the module is loaded by the first
+  //! loadModule instead.
   void deserialize(const serde::KernelExecutor* buffer);
 
+  //! Loads the module of a deserialized kernel if it isn't loaded yet. Only
+  //! the first call synchronizes.
+  void loadModule();
+
   //  private:
   void setUsedTVs();
 
@@ -243,6 +361,10 @@ class CompiledKernel : public NonCopyable {
   }
 
  private:
+  //! Returns the compiled function after dropping the cached attributes of
+  //! a previously compiled one
+  CUfunction functionWithCachedAttributes();
+
   CompileParams compile_params_;
   // Assuming sm70 or above:
   //  limit of statically allocated smem is 48 KB:
@@ -252,7 +374,20 @@ class CompiledKernel : public NonCopyable {
   const int64_t max_static_smem_ = 48 << 10;
 
   int64_t warp_size_ = 0;
-  std::unique_ptr<executor_utils::CudaExecutable> compiled_kernel_;
+  std::shared_ptr<executor_utils::CudaExecutable> compiled_kernel_;
+
+  // Attributes of the compiled function cached by staticSmemSize,
+  // availableDynamicSmemSize and ensureAvailableDynamicSmemSize. They are
+  // dropped when compiled_kernel_ holds a different function, e.g., after
+  // recompileKernel.
+  CUfunction cached_attributes_function_ = nullptr;
+  std::optional<int64_t> static_smem_size_ = std::nullopt;
+  std::optional<int64_t> available_dynamic_smem_size_ = std::nullopt;
+
+  // Set once the module of compiled_kernel_ is known to be loaded, so that
+  // loadModule only takes module_load_mutex_ on its first calls
+  std::atomic<bool> module_loaded_ = false;
+  std::mutex module_load_mutex_;
 
   // TensorViews actually used in the kernel.
   std::vector<TensorView*> used_tvs_;
@@ -26,8 +26,13 @@
 #include <options.h>
 #include <polymorphic_value.h>
 #include <runtime/allocations.h>
+#include <runtime/arg_table_staging.h>
 #include <runtime/executor_kernel_arg.h>
 #include <runtime/executor_utils.h>
+#include <runtime/l2_persistence.h>
+#include <runtime/megakernel.h>
+#include <runtime/peak_memory.h>
+#include <scheduler/expr_eval_sched.h>
 #include <serde/utils.h>
 #include <tensor_metadata.h>
 #include <utils.h>
@@ -38,8 +43,10 @@
 #include <ATen/native/cuda/jit_utils.h>
 #include <c10/core/DeviceGuard.h>
 #include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAGraphsC10Utils.h>
 #include <c10/cuda/CUDAStream.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <fstream>
@@ -72,6 +79,24 @@ void ExprEvalExecutor::compile(Fusion* fusion) {
       supported(fusion),
       "ExprEvalExecutor does not support the Fusion provided.");
   fusion_ = std::make_unique<Fusion>(*fusion);
+  if (std::optional<LinearActivation> match =
+          matchLinearActivation(fusion_.get())) {
+    fused_linear_ = match->linear;
+    fused_gelu_ = match->gelu;
+  }
+  if (isOptionEnabled(EnableOption::MatmulPlanCache)) {
+    const std::vector<Expr*> exprs = fusion_->exprs();
+    auto* matmul = exprs.size() == 1 ? dynamic_cast<MatmulOp*>(exprs.front())
+                                     : nullptr;
+    // Sharded matmuls and outputs with an allocation domain are left to
+    // MatmulOp::evaluate
+    if (matmul != nullptr && matmul->inA()->nDims() == 2 &&
+        matmul->inB()->nDims() == 2 && !isSharded(matmul->out()) &&
+        !matmul->out()->hasAllocation()) {
+      cached_matmul_ = matmul;
+      matmul_plans_ = std::make_unique<MatmulPlanCache>();
+    }
+  }
   if (isProfilerEnabled()) {
     FusionProfiler::segment(group_id_).stopCompile();
   }
@@ -105,7 +130,11 @@ KernelArgumentHolder ExprEvalExecutor::run(
         outputs.empty(),
         "Fusion executor is using expression evaluator,",
         " and expects that the outputs are not populated, which they were.");
-    if (outputs.empty()) {
+    if (fused_linear_ != nullptr) {
+      outputs.push(runLinearActivation(expr_eval));
+    } else if (cached_matmul_ != nullptr) {
+      outputs.push(runCachedMatmul(expr_eval));
+    } else {
       for (const auto& out_val : fusion_->outputs()) {
         auto out_tensor =
             expr_eval.evaluate(out_val->as<TensorView>()).as<at::Tensor>();
@@ -121,6 +150,44 @@ KernelArgumentHolder ExprEvalExecutor::run(
   return outputs;
 }
 
+at::Tensor ExprEvalExecutor::runCachedMatmul(ExpressionEvaluator& expr_eval) {
+  const auto a = expr_eval.evaluate(cached_matmul_->inA()).as<at::Tensor>();
+  const auto b = expr_eval.evaluate(cached_matmul_->inB()).as<at::Tensor>();
+  if (!MatmulPlanCache::supports(a, b)) {
+    return expr_eval.evaluate(cached_matmul_->out()).as<at::Tensor>();
+  }
+  at::Tensor out = matmul_plans_->matmul(a, b);
+  expr_eval.bind(cached_matmul_->out(), out);
+  return out;
+}
+
+at::Tensor ExprEvalExecutor::runLinearActivation(
+    ExpressionEvaluator& expr_eval) {
+  const auto in = expr_eval.evaluate(fused_linear_->inA()).as<at::Tensor>();
+  const auto weight =
+      expr_eval.evaluate(fused_linear_->inB()).as<at::Tensor>();
+  const auto bias = expr_eval.evaluate(fused_linear_->bias()).as<at::Tensor>();
+
+  // at::_addmm_activation dispatches to cuBLASLt with the bias and the
+  // activation in the epilogue, computed in float before rounding to the
+  // output type. The leading dimensions of in are flattened into rows.
+  at::Tensor out = at::_addmm_activation(
+      bias,
+      in.reshape({-1, in.size(-1)}),
+      weight.t(),
+      /*beta=*/1,
+      /*alpha=*/1,
+      /*use_gelu=*/fused_gelu_);
+  std::vector<int64_t> out_sizes = in.sizes().vec();
+  out_sizes.back() = weight.size(0);
+  out = out.view(out_sizes);
+
+  Val* out_val = fusion_->outputs().front();
+  out = out.to(data_type_to_aten(out_val->dtype()));
+  expr_eval.bind(out_val, out);
+  return out;
+}
+
 namespace {
 bool hasCpuScalarOutputs(Fusion* _fusion) {
   if (_fusion->exprs().empty()) {
@@ -174,6 +241,18 @@ void KernelExecutor::compile(
     CompileParams compile_params,
     SchedulerType scheduler_type) {
   FUSER_PERF_SCOPE("KernelExecutor::compile");
+  lower(fusion, args, launch_constraints, compile_params, scheduler_type);
+  compileLowered();
+}
+
+void KernelExecutor::lower(
+    Fusion* fusion,
+    const KernelArgumentHolder& args,
+    const LaunchParams& launch_constraints,
+    CompileParams compile_params,
+    SchedulerType scheduler_type) {
+  FUSER_PERF_SCOPE("KernelExecutor::lower");
+  DEBUG_PRINT_SCOPE_NAME("KernelExecutor::lower", "group_id=", group_id_);
 
   NVF_ERROR(
       supported(fusion),
@@ -227,6 +306,25 @@ void KernelExecutor::compile(
     compile_params.index_type = arg_index_type;
   }
 
+  if (!compile_params.int32_indexed_inputs.empty()) {
+    NVF_ERROR(
+        compile_params.index_type == PrimDataType::Int,
+        "32-bit indexed inputs are only used in kernels with 64-bit indexing");
+    const std::vector<int64_t> int32_indexable_args =
+        args.getInt32IndexableTensorPositions();
+    NVF_ERROR(
+        std::includes(
+            int32_indexable_args.begin(),
+            int32_indexable_args.end(),
+            compile_params.int32_indexed_inputs.begin(),
+            compile_params.int32_indexed_inputs.end()),
+        "Compilation with 32-bit indexed inputs {",
+        toDelimitedString(compile_params.int32_indexed_inputs),
+        "} is requested but only {",
+        toDelimitedString(int32_indexable_args),
+        "} fit in 32-bit indexing");
+  }
+
   c10::DeviceGuard dg(device);
 
   NVF_ERROR(device.is_cuda(), "Provided device to CUDA fuser is the CPU.");
@@ -236,6 +334,10 @@ void KernelExecutor::compile(
   device_smem_limit_ = static_cast<int64_t>(properties->sharedMemPerBlockOptin);
   warp_size_ = properties->warpSize;
 
+  if (isOptionEnabled(EnableOption::BankConflictRepair)) {
+    repairBankConflicts(fusion, compile_params);
+  }
+
   // Lowered is needed to compute launch parameters as it uses the CA map. We
   // could modify that, but simply generating that part first.
   compiled_kernel_ = std::make_unique<CompiledKernel>(
@@ -268,24 +370,8 @@ void KernelExecutor::compile(
     dynamic_smem = launch_params.smem();
     NVF_ERROR(block_size > 0, "launch param inferred block size < 0");
   }
-
-  // Launch parameters are required to compile the kernel to:
-  // (1) validate register sharing
-  // (2) runtime function may use static CTA shape, e.g.
-  //     iterGroupedStaticWarpAllReduce
-  compiled_kernel_->compile(launch_params);
-
-  // These should be nullopt at this point, but reset just in case
-  resetCompiledKernelProperties();
-
-  // If the dynamic shmem size is known, make sure the compiled kernel
-  // has at least that size of dynamic shmem
-  if (dynamic_smem.has_value()) {
-    ensureAvailableDynamicSmemSize(dynamic_smem.value());
-  }
-  if (isProfilerEnabled()) {
-    FusionProfiler::segment(group_id_).stopCompile();
-  }
+  lowered_launch_params_ = launch_params;
+  lowered_dynamic_smem_ = dynamic_smem;
 
   for (auto expr : exprs) {
     if (ir_utils::isCpAsyncBulk(expr)) {
@@ -328,16 +414,37 @@ void KernelExecutor::compile(
   }
 }
 
-LaunchParams KernelExecutor::computeLaunchParams(
-    const LaunchParams& launch_constraints,
-    ExpressionEvaluator& expr_eval,
-    const int64_t warp_size,
-    DataType index_type) {
-  FUSER_PERF_SCOPE("KernelExecutor::computeLaunchParams");
-  NVF_ERROR(warp_size > 0, "WARP_SIZE should be larger than 0");
+void KernelExecutor::compileLowered() {
+  FUSER_PERF_SCOPE("KernelExecutor::compileLowered");
+  DEBUG_PRINT_SCOPE_NAME(
+      "KernelExecutor::compileLowered", "group_id=", group_id_);
+  NVF_ERROR(
+      compiled_kernel_ != nullptr && compiled_kernel_->lowered() != nullptr,
+      "KernelExecutor::lower must be called before compileLowered");
 
-  LaunchParams launch_params;
+  // This may run on a different thread than lower
+  c10::DeviceGuard dg(compiled_kernel_->device());
+  FusionGuard fg(compiled_kernel_->kernel());
+
+  // Launch parameters are required to compile the kernel to:
+  // (1) validate register sharing
+  // (2) runtime function may use static CTA shape, e.g.
+  //     iterGroupedStaticWarpAllReduce
+  compiled_kernel_->compile(lowered_launch_params_);
+
+  // If the dynamic shmem size is known, make sure the compiled kernel
+  // has at least that size of dynamic shmem
+  if (lowered_dynamic_smem_.has_value()) {
+    ensureAvailableDynamicSmemSize(lowered_dynamic_smem_.value());
+  }
+  if (isProfilerEnabled()) {
+    FusionProfiler::segment(group_id_).loweringPasses(
+        compiled_kernel_->lowered()->passProfiles());
+    FusionProfiler::segment(group_id_).stopCompile();
+  }
+}
 
+const executor_utils::ParallelExtentMap& KernelExecutor::parallelIterExtents() {
   auto data_cache = compileTimeDataCache();
 
   auto lower = compiled_kernel_->lowered().get();
@@ -362,7 +469,21 @@ LaunchParams KernelExecutor::computeLaunchParams(
           data_cache, [&parallel_binding_ids]() {
             return executor_utils::getParallelIterExtents(parallel_binding_ids);
           });
-  auto& parallel_iter_extents = parallel_iter_extent_entry.get();
+  return parallel_iter_extent_entry.get();
+}
+
+LaunchParams KernelExecutor::computeLaunchParams(
+    const LaunchParams& launch_constraints,
+    ExpressionEvaluator& expr_eval,
+    const int64_t warp_size,
+    DataType index_type) {
+  FUSER_PERF_SCOPE("KernelExecutor::computeLaunchParams");
+  NVF_ERROR(warp_size > 0, "WARP_SIZE should be larger than 0");
+
+  LaunchParams launch_params;
+
+  auto lower = compiled_kernel_->lowered().get();
+  const auto& parallel_iter_extents = parallelIterExtents();
 
   const auto& simplified_parallel_iter_extents =
       lower->parallelDimensionMap().getMap();
@@ -382,11 +503,10 @@ LaunchParams KernelExecutor::computeLaunchParams(
     if (launch_constraints.hasDim(p_type)) {
       auto parallel_extents = entry.second;
       for (auto extent : parallel_extents) {
-        auto inferred_val = expr_eval.evaluate(extent);
-        if (inferred_val.hasValue()) {
+        std::optional<int64_t> inferred_val = expr_eval.evaluateInt64(extent);
+        if (inferred_val.has_value()) {
           // This value could have been inferred, make sure it was set right.
-          bool valid =
-              inferred_val.as<int64_t>() == launch_constraints.getDim(p_type) ||
+          bool valid = *inferred_val == launch_constraints.getDim(p_type) ||
               launch_constraints.getRawVal(p_type) == -1;
           if (!useFallback() && !valid) {
             TORCH_WARN_ONCE(
@@ -413,18 +533,18 @@ LaunchParams KernelExecutor::computeLaunchParams(
   // Run through the rest of the parallel IterDomains and infer their size
   for (auto [p_type, extent] : simplified_parallel_iter_extents) {
     FUSER_PERF_SCOPE("KernelExecutor::ParallelBindingResolution");
-    auto val = expr_eval.evaluate(extent);
+    std::optional<int64_t> val = expr_eval.evaluateInt64(extent);
     NVF_ERROR(
-        val.hasValue(),
+        val.has_value(),
         "Tried to evaluate the extent, ",
         extent->toInlineString(),
         " for the ptype: ",
         p_type,
         " to set launch bounds but could not.");
 
-    if (val > 0) {
-      expr_eval.bind(p_type, val);
-      launch_params.bind(val.as<int64_t>(), p_type);
+    if (*val > 0) {
+      expr_eval.bind(p_type, *val);
+      launch_params.bind(*val, p_type);
     }
   }
 
@@ -434,6 +554,44 @@ LaunchParams KernelExecutor::computeLaunchParams(
     expr_eval.precomputedValues()->evaluate();
   }
 
+  launch_params.setSmem(
+      computeDynamicSmemSize(launch_params, expr_eval, index_type));
+  return launch_params;
+}
+
+std::optional<LaunchParams> KernelExecutor::computeLaunchParamsWithFormula(
+    const KernelArgumentHolder& args,
+    const LaunchParams& launch_constraints,
+    ExpressionEvaluator& expr_eval,
+    DataType index_type) {
+  FUSER_PERF_SCOPE("KernelExecutor::computeLaunchParamsWithFormula");
+  auto formula_entry = executor_utils::caching::ExecutorCompileTimeEntry<
+      executor_utils::caching::ParallelExtentFormula>(
+      compileTimeDataCache(), [this]() {
+        return std::make_unique<executor_utils::caching::LaunchParamsFormula>(
+            compiled_kernel_->kernel(), parallelIterExtents());
+      });
+  const auto& formula = formula_entry.get();
+
+  LaunchParams launch_params;
+  if (!formula.available() ||
+      !formula.evaluate(args, launch_constraints, launch_params)) {
+    return std::nullopt;
+  }
+  for (ParallelType p_type : kParallelTypeThreads) {
+    if (launch_params.hasDim(p_type)) {
+      expr_eval.bind(p_type, launch_params.getDim(p_type));
+    }
+  }
+  launch_params.setSmem(
+      computeDynamicSmemSize(launch_params, expr_eval, index_type));
+  return launch_params;
+}
+
+int64_t KernelExecutor::computeDynamicSmemSize(
+    const LaunchParams& launch_params,
+    ExpressionEvaluator& expr_eval,
+    DataType index_type) {
   const auto kernel = compiled_kernel_->lowered()->kernel();
   const auto& kernel_summary = kernel->summary();
 
@@ -454,7 +612,10 @@ LaunchParams KernelExecutor::computeLaunchParams(
         kernel_summary.has_block_welford || kernel_summary.has_grid_welford ? 3
                                                                             : 1;
     // in outer reduction, may group iteration domain, e.g. when vectorized.
-    const int64_t grouped_iter_factor = kernel_summary.num_grouped_iterations;
+    // Grouped block reductions reduce all of their exprs in one call.
+    const int64_t grouped_iter_factor = std::max(
+        kernel_summary.num_grouped_iterations,
+        kernel_summary.num_grouped_block_reduction_exprs);
 
     NVF_CHECK(
         !(kernel_summary.has_iter_grouped_reductions && welford_factor == 3),
@@ -510,9 +671,42 @@ LaunchParams KernelExecutor::computeLaunchParams(
     validateDynamicSmemSize(dynamic_smem_size);
   }
 
-  launch_params.setSmem(dynamic_smem_size);
+  return dynamic_smem_size;
+}
 
-  return launch_params;
+namespace {
+
+// Total bytes retained by all IntermediateBufferPools
+std::atomic<int64_t> pooled_intermediate_bytes{0};
+
+int64_t intermediateBufferPoolCapacity() {
+  constexpr int64_t default_capacity_mib = 256;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::IntermediateBufferPool);
+  const int64_t capacity_mib =
+      option_args.empty() ? default_capacity_mib : std::stoll(option_args[0]);
+  return capacity_mib * 1024 * 1024;
+}
+
+// Stores buffer in slot if it fits in the budget of retained memory
+void retainIntermediateBuffer(
+    IntermediateBufferPool& pool,
+    at::Tensor& slot,
+    const at::Tensor& buffer) {
+  const auto num_bytes = static_cast<int64_t>(buffer.nbytes());
+  if (pooled_intermediate_bytes.fetch_add(num_bytes) + num_bytes >
+      intermediateBufferPoolCapacity()) {
+    pooled_intermediate_bytes.fetch_sub(num_bytes);
+    return;
+  }
+  slot = buffer;
+  pool.num_bytes += num_bytes;
+}
+
+} // namespace
+
+IntermediateBufferPool::~IntermediateBufferPool() {
+  pooled_intermediate_bytes.fetch_sub(num_bytes);
 }
 
 std::vector<GlobalBufferInfo> KernelExecutor::getIntermediateBufferInfo(
@@ -683,8 +877,17 @@ void KernelExecutor::initializeExecutorEntry(
   ExpressionEvaluator expr_eval =
       executor_utils::bindInputs(args, compiled_kernel_->kernel());
 
-  auto launch_params = computeLaunchParams(
-      launch_constraints, expr_eval, warp_size_, index_type);
+  // The formula skips the expression evaluation of the parallel extents for
+  // the new input signatures of a kernel
+  LaunchParams launch_params;
+  if (std::optional<LaunchParams> formula_launch_params =
+          computeLaunchParamsWithFormula(
+              args, launch_constraints, expr_eval, index_type)) {
+    launch_params = formula_launch_params.value();
+  } else {
+    launch_params = computeLaunchParams(
+        launch_constraints, expr_eval, warp_size_, index_type);
+  }
 
   for (const auto& entry : compiled_kernel_->kernel()->summary().validations) {
     NVF_CHECK(expr_eval.evaluate(entry.first).as<bool>(), entry.second);
@@ -797,8 +1000,8 @@ void KernelExecutor::initializeExecutorEntry(
 }
 
 namespace {
-GlobalBufferInfo& linear_buffer_info_getter(
-    KernelExecutorEntry& entry,
+const GlobalBufferInfo& linear_buffer_info_getter(
+    const KernelExecutorEntry& entry,
     size_t idx) {
   if (idx < entry.inputs.size()) {
     return entry.inputs[idx];
@@ -824,79 +1027,264 @@ GlobalBufferInfo& linear_buffer_info_getter(
 };
 } // namespace
 
-void KernelExecutor::computeArgs(
+std::vector<int64_t> KernelExecutor::kernelAllocStrides(
+    const Val* param,
+    const GlobalBufferInfo& buffer_info) const {
+  // Tensors whose strides the kernel doesn't read are passed without them
+  const auto& tensors_reading_alloc_stride =
+      compiled_kernel_->kernel()->summary().tensors_reading_alloc_stride;
+  auto tv = dynamic_cast<const TensorView*>(param);
+  if (tv != nullptr && tensors_reading_alloc_stride.count(tv) == 0) {
+    return {};
+  }
+  return buffer_info.shape_info.allocation_strides.empty()
+      ? buffer_info.shape_info.logical_strides
+      : buffer_info.shape_info.allocation_strides;
+}
+
+void KernelExecutor::initializePackedArgs(
     KernelExecutorEntry& entry,
-    const KernelArgumentHolder& args) const {
-  FUSER_PERF_SCOPE("KernelExecutor::computeArgs");
-  if (std::ssize(entry.args) != args.size()) {
-    entry.args.resize(args.size());
-    entry.arg_ptrs.resize(args.size());
+    const KernelArgumentHolder& inputs) const {
+  FUSER_PERF_SCOPE("KernelExecutor::initializePackedArgs");
+  const PrimDataType idx_type = compiled_kernel_->kernel()->indexType();
+  const auto& params = compiled_kernel_->kernel()->parameters();
+  const int64_t num_packed = inputs.size() + std::ssize(entry.outputs) +
+      std::ssize(entry.intermediates);
+  NVF_ERROR_LE(num_packed, std::ssize(params));
+
+  entry.packed_args.clear();
+  entry.packed_arg_offsets.clear();
+  entry.packed_arg_is_tensor.clear();
+  entry.packed_arg_offsets.reserve(num_packed);
+  entry.packed_arg_is_tensor.reserve(num_packed);
+
+  int64_t buffer_info_idx = 0;
+  for (auto arg_idx : arange(num_packed)) {
+    // Outputs and intermediates are always CUDA tensors
+    const bool is_input = arg_idx < inputs.size();
+    const bool is_tensor = !is_input ||
+        (inputs[arg_idx].is<at::Tensor>() &&
+         inputs[arg_idx].as<at::Tensor>().is_cuda());
+    std::vector<std::byte> bytes;
+    if (is_tensor) {
+      const auto& buffer_info =
+          linear_buffer_info_getter(entry, buffer_info_idx++);
+      bytes = tensorMetadataToBytes(
+          buffer_info.shape_info.logical_sizes,
+          kernelAllocStrides(params[arg_idx], buffer_info),
+          idx_type,
+          buffer_info.shape_info.unsharded_logical_sizes);
+    } else {
+      if (inputs[arg_idx].is<at::Tensor>()) {
+        buffer_info_idx++;
+      }
+      bytes = polymorphicValueToBytes(
+          inputs[arg_idx], params[arg_idx]->dtype(), idx_type);
+    }
+    // Keep each argument 16-byte aligned as if it were allocated separately
+    const int64_t offset =
+        roundUpToMultiple(std::ssize(entry.packed_args), 16);
+    entry.packed_args.resize(offset + bytes.size());
+    std::memcpy(entry.packed_args.data() + offset, bytes.data(), bytes.size());
+    entry.packed_arg_offsets.push_back(offset);
+    entry.packed_arg_is_tensor.push_back(is_tensor);
   }
+}
 
+void KernelExecutor::computeArgs(
+    const KernelExecutorEntry& entry,
+    const KernelArgumentHolder& args,
+    KernelLaunchArgs& launch_args) const {
+  FUSER_PERF_SCOPE("KernelExecutor::computeArgs");
   NVF_ERROR_EQ(
       args.size(), std::ssize(compiled_kernel_->kernel()->parameters()));
 
-  for (auto inp : compiled_kernel_->kernel()->inputs()) {
-    if (!inp->isA<TensorView>()) {
-      continue;
-    }
-  }
+  const int64_t num_packed = std::ssize(entry.packed_arg_offsets);
+  NVF_ERROR_LE(num_packed, args.size());
+  launch_args.packed_args = entry.packed_args;
+  launch_args.args.resize(args.size() - num_packed);
+  launch_args.arg_ptrs.resize(args.size());
 
   const PrimDataType idx_type = compiled_kernel_->kernel()->indexType();
+  const auto& params = compiled_kernel_->kernel()->parameters();
   int64_t buffer_info_idx = 0;
-  for (auto&& [arg_idx, arg] : enumerate(args)) {
+  // Only data pointers and scalars need updating in the packed arguments
+  for (auto arg_idx : arange(num_packed)) {
+    const auto& arg = args[arg_idx];
+    std::byte* slot =
+        launch_args.packed_args.data() + entry.packed_arg_offsets[arg_idx];
+    if (arg.is<at::Tensor>()) {
+      buffer_info_idx++;
+    }
+    if (entry.packed_arg_is_tensor[arg_idx]) {
+      NVF_ERROR(
+          arg.is<at::Tensor>() && arg.as<at::Tensor>().is_cuda(),
+          "Expected a CUDA tensor for kernel argument ",
+          arg_idx);
+      void* data = arg.as<at::Tensor>().data_ptr();
+      std::memcpy(slot, &data, sizeof(void*));
+    } else {
+      // The size of a scalar is determined by the parameter dtype, so it fits
+      // in the slot reserved by initializePackedArgs
+      auto bytes =
+          polymorphicValueToBytes(arg, params[arg_idx]->dtype(), idx_type);
+      std::memcpy(slot, bytes.data(), bytes.size());
+    }
+    launch_args.arg_ptrs[arg_idx] = slot;
+  }
+
+  for (auto arg_idx : arange(num_packed, args.size())) {
+    const auto& arg = args[arg_idx];
+    auto& bytes = launch_args.args[arg_idx - num_packed];
     if (arg.is<at::Tensor>() && arg.as<at::Tensor>().is_cuda()) {
       const auto& buffer_info =
           linear_buffer_info_getter(entry, buffer_info_idx++);
-      entry.args[arg_idx] = tensorToBytes(
+      bytes = tensorToBytes(
           arg,
           buffer_info.shape_info.logical_sizes,
-          buffer_info.shape_info.allocation_strides.empty()
-              ? buffer_info.shape_info.logical_strides
-              : buffer_info.shape_info.allocation_strides,
+          kernelAllocStrides(params[arg_idx], buffer_info),
           idx_type,
           buffer_info.shape_info.unsharded_logical_sizes);
-      entry.arg_ptrs[arg_idx] = entry.args[arg_idx].data();
     } else {
       if (arg.is<at::Tensor>()) {
         buffer_info_idx++;
       }
-      auto bytes = polymorphicValueToBytes(
-          arg,
-          compiled_kernel_->kernel()->parameters()[arg_idx]->dtype(),
-          idx_type);
-      entry.args[arg_idx] = bytes;
-      entry.arg_ptrs[arg_idx] = entry.args[arg_idx].data();
+      bytes = polymorphicValueToBytes(arg, params[arg_idx]->dtype(), idx_type);
     }
+    launch_args.arg_ptrs[arg_idx] = bytes.data();
   }
 }
 
-int64_t KernelExecutor::getAvailableDynamicSmemSize() {
-  if (!available_dynamic_smem_size_.has_value()) {
-    int size = 0;
-    NVFUSER_CUDA_SAFE_CALL(cuFuncGetAttribute(
-        &size,
-        CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES,
-        compiled_kernel_->cudaExecutable()->function));
-    available_dynamic_smem_size_ = size;
-  }
-  return available_dynamic_smem_size_.value();
+void KernelExecutor::copyArgsToTable(KernelLaunchArgs& launch_args) const {
+  FUSER_PERF_SCOPE("KernelExecutor::copyArgsToTable");
+  // The fields of KernelArgs are 16-byte aligned like the packed arguments,
+  // which are followed by the remaining ones
+  std::vector<int64_t> offsets;
+  offsets.reserve(launch_args.args.size());
+  int64_t size = std::ssize(launch_args.packed_args);
+  for (const auto& bytes : launch_args.args) {
+    offsets.push_back(roundUpToMultiple(size, 16));
+    size = offsets.back() + std::ssize(bytes);
+  }
+
+  auto write_table = [&](std::byte* table) {
+    std::memcpy(
+        table, launch_args.packed_args.data(), launch_args.packed_args.size());
+    for (auto i : arange(launch_args.args.size())) {
+      std::memcpy(
+          table + offsets[i],
+          launch_args.args[i].data(),
+          launch_args.args[i].size());
+    }
+  };
+
+  if (c10::cuda::currentStreamCaptureStatusMayInitCtx() ==
+      c10::cuda::CaptureStatus::None) {
+    launch_args.arg_table =
+        ArgTableStaging::current(compiled_kernel_->device().index())
+            .stage(size, write_table);
+  } else {
+    // Every replay of the graph copies from the pinned memory, so it's kept
+    // alive instead of being staged for reuse
+    at::Tensor staging = at::empty(
+        {size}, at::TensorOptions().dtype(at::kByte).pinned_memory(true));
+    write_table(static_cast<std::byte*>(staging.data_ptr()));
+    launch_args.arg_table = at::empty(
+        {size},
+        at::TensorOptions().dtype(at::kByte).device(
+            compiled_kernel_->device()));
+    launch_args.arg_table.copy_(staging, /*non_blocking=*/true);
+    std::lock_guard<std::mutex> guard(mutex_);
+    captured_arg_staging_.push_back(staging);
+  }
+  launch_args.arg_table_ptr = launch_args.arg_table.data_ptr();
+  launch_args.arg_ptrs.assign(1, &launch_args.arg_table_ptr);
 }
 
-int64_t KernelExecutor::getStaticSmemSize() {
-  if (!static_smem_size_.has_value()) {
-    int size = 0;
-    // Is this really a costly operation worth caching?
-    NVFUSER_CUDA_SAFE_CALL(cuFuncGetAttribute(
-        &size,
-        CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES,
-        compiled_kernel_->cudaExecutable()->function));
-    static_smem_size_ = size;
-  }
-  return static_smem_size_.value();
+bool KernelExecutor::canRunInMegakernel() const {
+  const kir::Kernel* kernel = compiled_kernel_->kernel();
+  const auto& summary = kernel->summary();
+  // Warp-specialized kernels synchronize with the block dimensions of their
+  // compute warps, and kernel profiles are read after each launch. Inputs
+  // may be written by an earlier stage of the megakernel, so they can't be
+  // loaded through the non-coherent path.
+  return !has_tma_ && !has_rng_ && !summary.uses_kernel_arg_table &&
+      !summary.has_argsort && !summary.has_topk &&
+      !summary.has_non_coherent_loads &&
+      !summary.circular_buffer_info.hasWarpSpecialized() &&
+      !kernel->hasManaged("cluster_dims") &&
+      !kernel->hasManaged("enable_register_sharing") &&
+      summary.atomic_reduction_outputs.empty() &&
+      !isOptionEnabled(EnableOption::KernelProfile);
+}
+
+void KernelExecutor::launchKernel(
+    const executor_utils::CudaExecutable& executable,
+    const LaunchParams& launch_params,
+    KernelLaunchArgs& launch_args,
+    CUstream stream) const {
+  std::optional<inst::KernelTraceScope> kernel_trace_scope;
+  if (inst::Trace::instance()->isEnabled()) {
+    kernel_trace_scope.emplace(compiled_kernel_->kernelName(), stream);
+  }
+  const kir::KernelSummary& summary = compiled_kernel_->kernel()->summary();
+#if (CUDA_VERSION >= 12000)
+  if (summary.uses_programmatic_dependent_launch &&
+      at::cuda::getDeviceProperties(compiled_kernel_->device().index())
+              ->major >= 9) {
+    FUSER_PERF_SCOPE("ExecutorRunFusion::cuLaunchKernelEx");
+    CUlaunchAttribute attribute;
+    attribute.id = CU_LAUNCH_ATTRIBUTE_PROGRAMMATIC_STREAM_SERIALIZATION;
+    attribute.value.programmaticStreamSerializationAllowed = 1;
+    CUlaunchConfig config;
+    config.gridDimX = launch_params.gdimx();
+    config.gridDimY = launch_params.gdimy();
+    config.gridDimZ = launch_params.gdimz();
+    config.blockDimX = launch_params.bdimx();
+    config.blockDimY = launch_params.bdimy();
+    config.blockDimZ = launch_params.bdimz();
+    config.sharedMemBytes = launch_params.smem();
+    config.hStream = stream;
+    config.attrs = &attribute;
+    config.numAttrs = 1;
+    NVFUSER_CUDA_SAFE_CALL(cuLaunchKernelEx(
+        &config,
+        executable.function,
+        launch_args.arg_ptrs.data(),
+        nullptr));
+    return;
+  }
+#endif
+  if (!summary.has_cooperative_grid_reduction) {
+    FUSER_PERF_SCOPE("ExecutorRunFusion::cuLaunchKernel");
+    NVFUSER_CUDA_SAFE_CALL(cuLaunchKernel(
+        executable.function,
+        launch_params.gdimx(),
+        launch_params.gdimy(),
+        launch_params.gdimz(),
+        launch_params.bdimx(),
+        launch_params.bdimy(),
+        launch_params.bdimz(),
+        launch_params.smem(),
+        stream,
+        launch_args.arg_ptrs.data(),
+        nullptr));
+  } else {
+    FUSER_PERF_SCOPE("ExecutorRunFusion::cuLaunchCooperativeKernel");
+    NVFUSER_CUDA_SAFE_CALL(cuLaunchCooperativeKernel(
+        executable.function,
+        launch_params.gdimx(),
+        launch_params.gdimy(),
+        launch_params.gdimz(),
+        launch_params.bdimx(),
+        launch_params.bdimy(),
+        launch_params.bdimz(),
+        launch_params.smem(),
+        stream,
+        launch_args.arg_ptrs.data()));
+  }
 }
 
-// TODO: Move to CompiledKernel
 void KernelExecutor::validateDynamicSmemSize(int64_t dynamic_smem_size) {
   // If specified, check that dynamic smem size matches what the scheduler
   // expects
@@ -910,40 +1298,29 @@ void KernelExecutor::validateDynamicSmemSize(int64_t dynamic_smem_size) {
         " does not match expected size ",
         expected_dynamic_smem_size);
   }
+  const int64_t static_smem_size = compiled_kernel_->staticSmemSize();
   NVF_ERROR(
-      getStaticSmemSize() + dynamic_smem_size < device_smem_limit_,
+      static_smem_size + dynamic_smem_size < device_smem_limit_,
       "The total shared memory allocation is larger than available memory.",
       " Dynamic size: ",
       dynamic_smem_size,
       ". Static size: ",
-      getStaticSmemSize(),
+      static_smem_size,
       ". Required total size: ",
-      getStaticSmemSize() + dynamic_smem_size,
+      static_smem_size + dynamic_smem_size,
       ". Device limit size: ",
       device_smem_limit_);
 }
 
-// TODO: Move to CompiledKernel
 int64_t KernelExecutor::ensureAvailableDynamicSmemSize(
     int64_t dynamic_smem_size) {
   NVF_ERROR(
       compiled_kernel_->isCompiled(),
       "Cannot set dynamic smem size unless kernel is compiled");
-  if (dynamic_smem_size > getAvailableDynamicSmemSize()) {
+  if (dynamic_smem_size > compiled_kernel_->availableDynamicSmemSize()) {
     validateDynamicSmemSize(dynamic_smem_size);
-    NVFUSER_CUDA_SAFE_CALL(cuFuncSetAttribute(
-        compiled_kernel_->cudaExecutable()->function,
-        CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES,
-        dynamic_smem_size));
-    available_dynamic_smem_size_ = dynamic_smem_size;
   }
-  return getAvailableDynamicSmemSize();
-}
-
-// TODO: Move to CompiledKernel
-void KernelExecutor::resetCompiledKernelProperties() {
-  available_dynamic_smem_size_.reset();
-  static_smem_size_.reset();
+  return compiled_kernel_->ensureAvailableDynamicSmemSize(dynamic_smem_size);
 }
 
 namespace {
@@ -969,7 +1346,7 @@ KernelArgumentHolder resolveRNGSeed(
 // TODO: Reduce bindings to only those necessary to resolve missing params.
 // TODO: Check if this could be reused to also resolve dynamic aliases.
 KernelArgumentHolder KernelExecutor::resolveTMA(
-    KernelExecutorEntry& entry,
+    const KernelExecutorEntry& entry,
     const KernelArgumentHolder& args) const {
   ExpressionEvaluator expr_eval;
   int64_t arg_idx = 0;
@@ -997,6 +1374,13 @@ KernelArgumentHolder KernelExecutor::resolveTMA(
 
   KernelArgumentHolder resolved_args;
   for (auto param : compiled_kernel_->kernel()->parameters()) {
+    // Tensor maps repeat across launches, so they are looked up in
+    // tensor_maps_ instead of being encoded for every launch
+    if (auto encode = dynamic_cast<kir::EncodeTensorMapTiled*>(
+            param->definition())) {
+      resolved_args.push(tensor_maps_.get(encode, expr_eval));
+      continue;
+    }
     resolved_args.push(expr_eval.evaluate(param));
   }
   return resolved_args;
@@ -1006,7 +1390,8 @@ KernelArgumentHolder KernelExecutor::run(
     KernelArgumentHolder args,
     KernelArgumentHolder output_args,
     const LaunchParams& launch_constraints,
-    CompileParams compile_params) {
+    CompileParams compile_params,
+    const OutputPlacement& output_placement) {
   FUSER_PERF_SCOPE("KernelExecutor::run");
 
   if (isProfilerEnabled()) {
@@ -1042,49 +1427,88 @@ KernelArgumentHolder KernelExecutor::run(
   auto stream = at::cuda::getCurrentCUDAStream();
   at::cuda::jit::initializeCudaContext();
   NVF_ERROR(compiled_kernel_->lowered());
+  compiled_kernel_->loadModule();
 
   // Placeholder for the case where parameter cache is not used
   KernelExecutorEntry temporary_executor_entry;
+  KernelExecutorEntry* executor_entry = &temporary_executor_entry;
+  // Keeps the cached entry alive for the duration of this launch even if it
+  // gets evicted by another thread
+  std::shared_ptr<KernelExecutorEntry> cached_executor_entry;
+  // The compiled kernel this launch was prepared for, which stays loaded even
+  // if another thread recompiles the kernel for a larger block
+  std::shared_ptr<executor_utils::CudaExecutable> executable;
+
+  // Only the lookup and lazy initialization of shared state is serialized.
+  // Once initialized, an entry is only read, so concurrent launches of this
+  // kernel, e.g., from different threads on different streams, proceed
+  // without holding the lock.
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (args.getCacheId().has_value() &&
+        !compiled_kernel_->launchParamCacheDisabled()) {
+      auto& entry = executor_entry_lookup_[*args.getCacheId()];
+      if (entry == nullptr) {
+        entry = std::make_shared<KernelExecutorEntry>();
+        entry->intermediate_pool = std::make_unique<IntermediateBufferPool>();
+      }
+      cached_executor_entry = entry;
+      executor_entry = cached_executor_entry.get();
+    }
 
-  KernelExecutorEntry* executor_entry = args.getCacheId().has_value() &&
-          !compiled_kernel_->launchParamCacheDisabled()
-      ? &executor_entry_lookup_[*args.getCacheId()]
-      : &temporary_executor_entry;
+    // Initialize the executor entry if not initlized
+    if (!executor_entry->init) {
+      initializeExecutorEntry(
+          *executor_entry,
+          args,
+          launch_constraints,
+          compile_params,
+          output_args,
+          compiled_kernel_->kernel()->indexType());
+    }
 
-  // Initialize the executor entry if not initlized
-  if (!executor_entry->init) {
-    initializeExecutorEntry(
-        *executor_entry,
-        args,
-        launch_constraints,
-        compile_params,
-        output_args,
-        compiled_kernel_->kernel()->indexType());
-  }
+    if (!(executor_entry->launch_params.nThreads() <=
+              compiled_kernel_->blockSizeHighWaterMark() &&
+          compile_params.maxrregcount ==
+              compiled_kernel_->maxrregcountHighWaterMark())) {
+      compiled_kernel_->recompileKernel(
+          executor_entry->launch_params, compile_params);
+    }
+    executable = compiled_kernel_->cudaExecutable();
 
-  if (!(executor_entry->launch_params.nThreads() <=
-            compiled_kernel_->blockSizeHighWaterMark() &&
-        compile_params.maxrregcount ==
-            compiled_kernel_->maxrregcountHighWaterMark())) {
-    compiled_kernel_->recompileKernel(
-        executor_entry->launch_params, compile_params);
-  }
+    if (execute_kernel_ &&
+        !compiled_kernel_->kernel()->topLevelExprs().empty()) {
+      ensureAvailableDynamicSmemSize(executor_entry->launch_params.smem());
+    }
 
-  // TODO: Why does this need to be stored in the class?
-  launch_params_ = executor_entry->launch_params;
+    // TMA descriptors and RNG seeds are interleaved with the other
+    // parameters and are re-evaluated for each launch, so such kernels don't
+    // use packed arguments.
+    if (!has_tma_ && !has_rng_ && executor_entry->packed_arg_offsets.empty()) {
+      initializePackedArgs(*executor_entry, args);
+    }
+
+    // TODO: Why does this need to be stored in the class?
+    launch_params_ = executor_entry->launch_params;
+  }
+  const LaunchParams& launch_params = executor_entry->launch_params;
 
   // context manager to disable auto grad for `empty_cuda` calls later
   at::AutoDispatchBelowADInplaceOrView non_variable_type_mode;
 
   // only allocate outputs when not given
   if (output_args.empty()) {
+    static const std::vector<std::pair<int64_t, int64_t>> no_inplace_outputs;
     output_args = allocateOutputs(
         compiled_kernel_->kernel(),
         executor_entry->outputs,
         executor_entry->output_aliased_to_input,
         compiled_kernel_->device(),
         args,
-        has_dynamic_alias_);
+        has_dynamic_alias_,
+        output_placement.write_inplace ? inplace_outputs_ : no_inplace_outputs,
+        output_placement.output_slices,
+        output_placement.user_outputs);
     if (has_dynamic_alias_) {
       ExpressionEvaluator expr_eval;
       if (has_dynamic_alias_ || has_tma_) {
@@ -1115,12 +1539,53 @@ KernelArgumentHolder KernelExecutor::run(
         "Output is not populated or not a Tensor");
   }
 
+  // The blocks of atomic grid reductions combine their partial results in
+  // their outputs, which the kernel doesn't initialize
+  const auto& atomic_reduction_outputs =
+      compiled_kernel_->kernel()->summary().atomic_reduction_outputs;
+  if (!atomic_reduction_outputs.empty() && execute_kernel_) {
+    for (const auto i : arange(compiled_kernel_->kernel()->outputs().size())) {
+      auto* output = dynamic_cast<TensorView*>(
+          compiled_kernel_->kernel()->outputs()[i]);
+      auto init_it = atomic_reduction_outputs.find(output);
+      if (init_it != atomic_reduction_outputs.end()) {
+        output_args[i].as<at::Tensor>().fill_(
+            PolymorphicValue_functions::toScalar(init_it->second->value()));
+      }
+    }
+  }
+
   args.push(output_args);
 
   KernelArgumentHolder intermediate_args;
   at::Tensor profile_buffer;
+  // Pooled and zeroed buffers outlive the launch, so they are only counted
+  // by the memory tracker until the launch is done
+  PeakMemoryTracker* memory_tracker = PeakMemoryTracker::current();
+  int64_t retained_intermediate_bytes = 0;
   {
     FUSER_PERF_SCOPE("KernelExecutor::runFusion::intermediates");
+    // Buffers retained from previous launches on the current stream. Stream
+    // capture is excluded as the captured graph would keep using the buffers
+    // after they are handed to other launches.
+    IntermediateBufferPool* pool = nullptr;
+    std::vector<at::Tensor>* pooled_buffers = nullptr;
+    std::unique_lock<std::mutex> pool_lock;
+    if (executor_entry->intermediate_pool != nullptr &&
+        !executor_entry->intermediates.empty() &&
+        isOptionEnabled(EnableOption::IntermediateBufferPool) &&
+        !shouldFillAllocationWithNan() &&
+        c10::cuda::currentStreamCaptureStatusMayInitCtx() ==
+            c10::cuda::CaptureStatus::None) {
+      pool = executor_entry->intermediate_pool.get();
+      pool_lock = std::unique_lock<std::mutex>(pool->mutex);
+      pooled_buffers =
+          &pool->buffers[at::cuda::getCurrentCUDAStream(
+                             compiled_kernel_->device().index())
+                             .id()];
+      pooled_buffers->resize(executor_entry->intermediates.size());
+    }
+
     // Intermediates just use logical sizes and strides even though they're
     // really allocation sizes and strides.
     //
@@ -1143,15 +1608,48 @@ KernelArgumentHolder KernelExecutor::run(
           unexpanded_sizes.push_back(buf_info.shape_info.logical_sizes[j]);
         }
       }
+      const bool is_poolable = pooled_buffers != nullptr &&
+          !buf_info.is_profile_buffer &&
+          (!buf_info.zero_init || buf_info.resets_to_zero);
       at::Tensor intermediate_buffer;
-      if (buf_info.zero_init) {
-        if (isOptionEnabled(EnableOption::ReuseZeroedMemory) ||
-            buf_info.resets_to_zero) {
+      bool is_retained = is_poolable;
+      if (is_poolable && pooled_buffers->at(intermediate_i).defined()) {
+        intermediate_buffer = pooled_buffers->at(intermediate_i);
+      } else if (is_poolable) {
+        intermediate_buffer = buf_info.zero_init
+            ? at::zeros(
+                  unexpanded_sizes,
+                  at::TensorOptions()
+                      .dtype(buf_info.type)
+                      .device(compiled_kernel_->device()))
+            : at::native::empty_cuda(
+                  unexpanded_sizes,
+                  buf_info.type,
+                  c10::nullopt,
+                  compiled_kernel_->device(),
+                  c10::nullopt);
+        retainIntermediateBuffer(
+            *pool, pooled_buffers->at(intermediate_i), intermediate_buffer);
+      } else if (buf_info.zero_init) {
+        // Like the pool, the zeroed memory arena of the stream is excluded
+        // from stream capture. The arena can be reallocated or handed to
+        // other launches on the stream while the graph still points into it,
+        // so captured buffers are zeroed in the graph's own memory pool on
+        // every replay instead.
+        if ((isOptionEnabled(EnableOption::ReuseZeroedMemory) ||
+             buf_info.resets_to_zero) &&
+            c10::cuda::currentStreamCaptureStatusMayInitCtx() ==
+                c10::cuda::CaptureStatus::None) {
           // Allow access to reusable zeroed memory if buffer is guaranteed
           // to reset to zero upon completion of the kernel, or if we have
-          // enabled the option (unsafe)
+          // enabled the option. In the latter case, the arena clears the
+          // buffer with a memset after the kernel.
           intermediate_buffer = contigZeroedTensor(
-              unexpanded_sizes, buf_info.type, compiled_kernel_->device());
+              unexpanded_sizes,
+              buf_info.type,
+              compiled_kernel_->device(),
+              buf_info.resets_to_zero);
+          is_retained = true;
         } else {
           intermediate_buffer = at::zeros(
               unexpanded_sizes,
@@ -1170,6 +1668,14 @@ KernelArgumentHolder KernelExecutor::run(
           fillTensorWithNan(intermediate_buffer);
         }
       }
+      if (memory_tracker != nullptr) {
+        if (is_retained) {
+          retained_intermediate_bytes +=
+              intermediate_buffer.numel() * intermediate_buffer.element_size();
+        } else {
+          memory_tracker->allocated(intermediate_buffer);
+        }
+      }
       if (has_expansion) {
         intermediate_buffer = at::native::expand(
             intermediate_buffer, buf_info.shape_info.logical_sizes);
@@ -1181,6 +1687,9 @@ KernelArgumentHolder KernelExecutor::run(
       }
     }
   }
+  if (memory_tracker != nullptr) {
+    memory_tracker->reserve(retained_intermediate_bytes);
+  }
 
   if (args.size() != std::ssize(compiled_kernel_->kernel()->parameters())) {
     NVF_ERROR(
@@ -1204,10 +1713,14 @@ KernelArgumentHolder KernelExecutor::run(
     }
   }
 
-  computeArgs(*executor_entry, args);
+  KernelLaunchArgs launch_args;
+  computeArgs(*executor_entry, args, launch_args);
+  if (compiled_kernel_->kernel()->summary().uses_kernel_arg_table) {
+    copyArgsToTable(launch_args);
+  }
 
   if (isDebugDumpEnabled(DebugDumpOption::LaunchParam)) {
-    launch_params_.print();
+    launch_params.print();
   }
 
   if (isDebugDumpEnabled(DebugDumpOption::KernelArgs)) {
@@ -1226,25 +1739,27 @@ KernelArgumentHolder KernelExecutor::run(
             << std::endl;
   }
 
+  // A LaunchChain may defer the launch to enqueue it together with the
+  // launches of the following segments
+  bool is_deferred = false;
   if (execute_kernel_ && !compiled_kernel_->kernel()->topLevelExprs().empty()) {
     FUSER_PERF_SCOPE("KernelExecutor::runFusion::execute_kernel");
-    ensureAvailableDynamicSmemSize(executor_entry->launch_params.smem());
 
     if (isDebugDumpEnabled(DebugDumpOption::Occupancy) ||
         isDebugDumpEnabled(DebugDumpOption::PerfDebugVerbose)) {
       int blocks_per_sm = -1;
       NVFUSER_CUDA_SAFE_CALL(cuOccupancyMaxActiveBlocksPerMultiprocessor(
           &blocks_per_sm,
-          compiled_kernel_->cudaExecutable()->function,
-          launch_params_.nThreads(),
-          launch_params_.smem()));
+          executable->function,
+          launch_params.nThreads(),
+          launch_params.smem()));
 
       const int64_t device_id =
           static_cast<unsigned char>(compiled_kernel_->device().index());
       const auto prop =
           at::cuda::getDeviceProperties((c10::DeviceIndex)device_id);
       const int64_t warps_per_sm =
-          ceilDiv(blocks_per_sm * launch_params_.nThreads(), prop->warpSize);
+          ceilDiv(blocks_per_sm * launch_params.nThreads(), prop->warpSize);
 
       const int hw_max_warps =
           prop->maxThreadsPerMultiProcessor / prop->warpSize;
@@ -1259,37 +1774,36 @@ KernelArgumentHolder KernelExecutor::run(
               << ", occupancy=" << oss.str() << std::endl;
     }
 
-    if (!compiled_kernel_->kernel()->summary().has_cooperative_grid_reduction) {
-      FUSER_PERF_SCOPE("ExecutorRunFusion::cuLaunchKernel");
-      NVFUSER_CUDA_SAFE_CALL(cuLaunchKernel(
-          compiled_kernel_->cudaExecutable()->function,
-          launch_params_.gdimx(),
-          launch_params_.gdimy(),
-          launch_params_.gdimz(),
-          launch_params_.bdimx(),
-          launch_params_.bdimy(),
-          launch_params_.bdimz(),
-          launch_params_.smem(),
-          stream,
-          executor_entry->arg_ptrs.data(),
-          nullptr));
-    } else {
-      FUSER_PERF_SCOPE("ExecutorRunFusion::cuLaunchCooperativeKernel");
-      NVFUSER_CUDA_SAFE_CALL(cuLaunchCooperativeKernel(
-          compiled_kernel_->cudaExecutable()->function,
-          launch_params_.gdimx(),
-          launch_params_.gdimy(),
-          launch_params_.gdimz(),
-          launch_params_.bdimx(),
-          launch_params_.bdimy(),
-          launch_params_.bdimz(),
-          launch_params_.smem(),
-          stream,
-          executor_entry->arg_ptrs.data()));
+    // Launch chains aren't used with L2 persistence, as the window would be
+    // cleared before the deferred launches run
+    if (output_placement.persist_in_l2 && !l2_persisting_outputs_.empty()) {
+      NVF_ERROR(LaunchChain::current() == nullptr);
+      std::vector<at::Tensor> persisting_outputs;
+      persisting_outputs.reserve(l2_persisting_outputs_.size());
+      for (int64_t i : l2_persisting_outputs_) {
+        if (output_args[i].is<at::Tensor>()) {
+          persisting_outputs.push_back(output_args[i].as<at::Tensor>());
+        }
+      }
+      l2_persistence::setAccessPolicyWindow(stream, persisting_outputs);
+    }
+
+    if (LaunchChain* launch_chain = LaunchChain::current()) {
+      is_deferred = launch_chain->defer(
+          this, executable, launch_params, launch_args, args);
+    }
+    if (!is_deferred) {
+      launchKernel(*executable, launch_params, launch_args, stream);
     }
   }
 
-  releaseZeroedMemory();
+  // The zeroed memory of a deferred launch is reset once it's enqueued
+  if (!is_deferred) {
+    resetZeroedMemory(compiled_kernel_->device());
+  }
+  if (memory_tracker != nullptr) {
+    memory_tracker->release(retained_intermediate_bytes);
+  }
 
   if (isOptionEnabled(EnableOption::KernelProfile)) {
     debug() << compiled_kernel_->kernel()->profile().toString(profile_buffer);
@@ -1299,11 +1813,57 @@ KernelArgumentHolder KernelExecutor::run(
     auto& sprof = FusionProfiler::segment(group_id_);
     sprof.stopKernel();
     sprof.outputBytesAccessed(computeBytes(output_args));
+    if (isOptionEnabled(EnableOption::KernelProfile)) {
+      std::vector<KernelStageProfile> stages;
+      for (const auto& stage_cycles :
+           compiled_kernel_->kernel()->profile().getStageCycles(
+               profile_buffer)) {
+        stages.push_back(
+            {kir::KernelPerformanceProfile::stageName(stage_cycles.stage),
+             stage_cycles.warp_group,
+             stage_cycles.cycles,
+             stage_cycles.count});
+      }
+      sprof.stageProfiles(std::move(stages));
+    }
   }
 
   return output_args;
 }
 
+int64_t KernelExecutor::moduleBytes() const {
+  if (!isCompiled()) {
+    return 0;
+  }
+  const auto& executable = compiledKernel()->cudaExecutable();
+  if (executable == nullptr) {
+    return 0;
+  }
+  return std::ssize(
+      executable->cubin.empty() ? executable->ptx : executable->cubin);
+}
+
+int64_t KernelExecutor::retainedBufferBytes() const {
+  // A launch holds the lock of its pool while it may take mutex_, so the
+  // pools aren't locked while holding mutex_.
+  std::vector<std::shared_ptr<KernelExecutorEntry>> entries;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    entries.reserve(executor_entry_lookup_.size());
+    for (const auto& [cache_id, entry] : executor_entry_lookup_) {
+      entries.push_back(entry);
+    }
+  }
+  int64_t num_bytes = 0;
+  for (const auto& entry : entries) {
+    if (entry->intermediate_pool != nullptr) {
+      std::lock_guard<std::mutex> guard(entry->intermediate_pool->mutex);
+      num_bytes += entry->intermediate_pool->num_bytes;
+    }
+  }
+  return num_bytes;
+}
+
 flatbuffers::Offset<serde::KernelExecutor> KernelExecutor::serialize(
     flatbuffers::FlatBufferBuilder& builder) const {
   // See table definition for KernelExecutor in serde/fusion_cache.fbs
@@ -1311,11 +1871,12 @@ flatbuffers::Offset<serde::KernelExecutor> KernelExecutor::serialize(
 
   // Separate unordered_map for executor_entry_lookup into key and value
   // vectors. The key value is the cache_id value in the KernelArgumentHolder.
+  std::lock_guard<std::mutex> guard(mutex_);
   std::vector<size_t> executor_entry_lookup_keys_fb;
   std::vector<fb_executor_entry> executor_entry_lookup_values_fb;
   for (const auto& [key, value] : executor_entry_lookup_) {
     executor_entry_lookup_keys_fb.push_back(key);
-    executor_entry_lookup_values_fb.push_back(serialize(builder, value));
+    executor_entry_lookup_values_fb.push_back(serialize(builder, *value));
   }
 
   // When compilation is skipped, avoid serializing cubin because it doesn't
@@ -1380,6 +1941,20 @@ flatbuffers::Offset<serde::CudaKernel> KernelExecutor::serialize(
     fb_ptx_filename = builder.CreateString(compiled_kernel->ptx_filename);
   }
 
+  std::vector<flatbuffers::Offset<serde::CudaKernelImage>> fb_images;
+  fb_images.reserve(compiled_kernel->images.size());
+  for (const executor_utils::CudaKernelImage& image :
+       compiled_kernel->images) {
+    fb_images.push_back(serde::CreateCudaKernelImage(
+        builder,
+        image.arch,
+        builder.CreateString(image.compile_args),
+        builder.CreateVector(
+            reinterpret_cast<const uint8_t*>(image.cubin.data()),
+            image.cubin.size())));
+  }
+  auto fb_images_vector = builder.CreateVector(fb_images);
+
   serde::CudaKernelBuilder ckb(builder);
   ckb.add_cubin(fb_cubin);
   ckb.add_cubin_filename(fb_cubin_filename);
@@ -1388,6 +1963,7 @@ flatbuffers::Offset<serde::CudaKernel> KernelExecutor::serialize(
   ckb.add_kernel_name(fb_kernel_name);
   ckb.add_compile_args(fb_compile_args);
   ckb.add_block_size(compiled_kernel->block_size);
+  ckb.add_images(fb_images_vector);
   return ckb.Finish();
 }
 
@@ -1561,9 +2137,11 @@ void KernelExecutor::deserialize(
 
   // GlobalBufferInfo requires lowered kernel before deserialization
   for (auto idx : arange(buffer->executor_entry_lookup_keys()->size())) {
-    executor_entry_lookup_.emplace(
-        buffer->executor_entry_lookup_keys()->Get(idx),
+    auto entry = std::make_shared<KernelExecutorEntry>(
         deserialize(buffer->executor_entry_lookup_values()->Get(idx)));
+    entry->intermediate_pool = std::make_unique<IntermediateBufferPool>();
+    executor_entry_lookup_.emplace(
+        buffer->executor_entry_lookup_keys()->Get(idx), std::move(entry));
   }
 
   has_rng_ = buffer->has_rng();
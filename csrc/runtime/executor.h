@@ -17,12 +17,17 @@
 #include <runtime/executor_abstract.h>
 #include <runtime/executor_params.h>
 #include <runtime/executor_utils.h>
+#include <runtime/matmul_plan_cache.h>
+#include <runtime/tensor_map_cache.h>
 #include <scheduler/scheduler_types.h>
 #include <serde/fusion_cache_generated.h>
 #include <utils.h>
 #include <atomic>
+#include <memory>
+#include <mutex>
 
 #include <c10/core/DeviceType.h>
+#include <c10/core/Stream.h>
 
 #include <functional>
 
@@ -51,9 +56,53 @@ class ExprEvalExecutor : public ExecutorAbstract {
     return fusion_;
   }
 
+  //! Set if the fusion is a single MatmulOp and EnableOption::MatmulPlanCache
+  //! is set
+  const MatmulPlanCache* matmulPlanCache() const {
+    return matmul_plans_.get();
+  }
+
  private:
+  // Runs the MatmulOp of the fusion with a cached cuBLASLt plan if its
+  // operands are supported, or with ATen otherwise
+  at::Tensor runCachedMatmul(ExpressionEvaluator& expr_eval);
+
+  // Runs the LinearActivation of the fusion with a single cuBLASLt matmul
+  // that applies the bias and the activation in its epilogue
+  at::Tensor runLinearActivation(ExpressionEvaluator& expr_eval);
+
   // TODO: Set properly
   std::unique_ptr<Fusion> fusion_;
+  // Set if the fusion is a LinearActivation
+  LinearOp* fused_linear_ = nullptr;
+  bool fused_gelu_ = false;
+  // Set with matmul_plans_
+  MatmulOp* cached_matmul_ = nullptr;
+  std::unique_ptr<MatmulPlanCache> matmul_plans_;
+};
+
+// Intermediate global buffers retained between launches of a
+// KernelExecutorEntry when EnableOption::IntermediateBufferPool is set.
+//
+// Buffers are indexed by the stream they were used on. Launches on the same
+// stream are ordered, so the next launch on that stream can reuse a buffer
+// without waiting for the previous kernel. Only buffers whose contents don't
+// need to be initialized on each launch are retained, i.e., buffers that are
+// not zero-initialized and zero-initialized buffers that the kernel resets to
+// zero on exit.
+struct IntermediateBufferPool {
+  IntermediateBufferPool() = default;
+  IntermediateBufferPool(const IntermediateBufferPool&) = delete;
+  IntermediateBufferPool& operator=(const IntermediateBufferPool&) = delete;
+  // Returns the retained bytes to the global budget
+  ~IntermediateBufferPool();
+
+  std::mutex mutex;
+  // Buffers in the order of KernelExecutorEntry::intermediates. Undefined
+  // tensors are not retained.
+  std::unordered_map<c10::StreamId, std::vector<at::Tensor>> buffers;
+  // Total bytes held in buffers
+  int64_t num_bytes = 0;
 };
 
 // struct used to hold necessary information to launch compiled kernel on a
@@ -72,17 +121,67 @@ struct KernelExecutorEntry {
   // Temporary work buffers and intemediate global-memory tensors
   std::vector<GlobalBufferInfo> intermediates;
   std::vector<GlobalBufferInfo> inputs;
-  // The arguments to the kernel. These are configured in computeArgs and
-  // recomputeArgs.
+  // Retained intermediate buffers. Only created for cached entries.
+  std::unique_ptr<IntermediateBufferPool> intermediate_pool;
+  // Kernel arguments of the inputs, outputs and intermediates packed back to
+  // back. The tensor metadata only depends on this entry, so each launch
+  // copies this buffer and only patches data pointers and scalar values.
+  // Built by initializePackedArgs on the first launch.
+  std::vector<std::byte> packed_args;
+  // Offset of each packed argument in packed_args
+  std::vector<int64_t> packed_arg_offsets;
+  // Whether each packed argument is a CUDA tensor, whose data pointer is the
+  // only part that changes between launches
+  std::vector<bool> packed_arg_is_tensor;
+};
+
+// The encoded arguments of a single kernel launch. Unlike KernelExecutorEntry,
+// which is shared by all launches with the same cache id and is immutable once
+// initialized, this is owned by the launching thread so that multiple threads
+// can launch the same kernel concurrently.
+struct KernelLaunchArgs {
+  // The arguments to the kernel. These are configured in computeArgs.
   // For the common case of a tensor argument, these correspond to the
   // `struct Tensor` data in runtime/tensor.cu. That means each tensor
-  // element in `args` would be a sizeof(void*) + len(shape)*sizeof(int) +
+  // argument would be a sizeof(void*) + len(shape)*sizeof(int) +
   // len(shape)*sizeof(int) byte array (here "int" is used in place of the
   // index type, which varies in practice).
+  //
+  // Copy of KernelExecutorEntry::packed_args holding the inputs, outputs and
+  // intermediates of this launch.
+  std::vector<std::byte> packed_args;
+  // Arguments following the packed ones. This holds all arguments of kernels
+  // with TMA descriptors or RNG seeds, which are not packed.
   std::vector<std::vector<std::byte>> args;
-  // This is just the data() pointers to the above `args`; cuLaunchKernel
-  // requires an array of this form.
+  // Pointers to each argument in the above buffers; cuLaunchKernel requires
+  // an array of this form.
   std::vector<void*> arg_ptrs;
+  // The arguments copied to device memory for kernels that read them from a
+  // KernelArgs struct, see KernelSummary::uses_kernel_arg_table. arg_ptrs then
+  // only points to arg_table_ptr.
+  at::Tensor arg_table;
+  void* arg_table_ptr = nullptr;
+};
+
+// Where a single call of KernelExecutor::run places the outputs of a segment
+// of a FusionKernelRuntime. Unlike the state of the executor, it belongs to
+// one call, so concurrent runs of the same executor, e.g., from different
+// threads, don't see each other's tensors.
+struct OutputPlacement {
+  // Keep the outputs of KernelExecutor::setL2PersistingOutputs in the
+  // persisting L2 carve-out while the kernel runs
+  bool persist_in_l2 = false;
+  // Write the outputs of KernelExecutor::setInplaceOutputs into the storage
+  // of their inputs
+  bool write_inplace = false;
+  // Views that outputs are written into when their layouts match, e.g., the
+  // slices of a concatenated tensor, see findCatOutputSlices.
+  std::vector<std::pair<int64_t, at::Tensor>> output_slices;
+  // Tensors given by the user that outputs must be written into, e.g., the
+  // final outputs of a fusion run with preallocated outputs. Unlike the views
+  // of output_slices, a tensor whose layout doesn't match the output is an
+  // error.
+  std::vector<std::pair<int64_t, at::Tensor>> user_outputs;
 };
 
 class GpuLower;
@@ -110,11 +209,26 @@ class KernelExecutor : public ExecutorAbstract {
       CompileParams compile_params = CompileParams(),
       SchedulerType sceduler_type = SchedulerType::None);
 
+  //! First half of compile: lowers the fusion and computes the launch
+  //! parameters used to generate the kernel. Lowering doesn't use NVRTC, so
+  //! FusionKernelRuntime lowers all segments before compiling any of them.
+  void lower(
+      Fusion* fusion,
+      const KernelArgumentHolder& args = {},
+      const LaunchParams& launch_constraints = LaunchParams(),
+      CompileParams compile_params = CompileParams(),
+      SchedulerType sceduler_type = SchedulerType::None);
+
+  //! Second half of compile: generates the CUDA code of the lowered kernel,
+  //! compiles it with NVRTC and loads the module.
+  void compileLowered();
+
   NVF_API KernelArgumentHolder
   run(KernelArgumentHolder args,
       KernelArgumentHolder outputs = {},
       const LaunchParams& launch_constraints = LaunchParams(),
-      CompileParams compile_params = CompileParams());
+      CompileParams compile_params = CompileParams(),
+      const OutputPlacement& output_placement = {});
 
   // Register a lowering hooks that are called to modify the GpuLower object
   // before running lowering passes. The main use case is for unit tests to
@@ -138,6 +252,7 @@ class KernelExecutor : public ExecutorAbstract {
   };
 
   void evictCache(size_t cache_id) {
+    std::lock_guard<std::mutex> guard(mutex_);
     executor_entry_lookup_.erase(cache_id);
   }
 
@@ -167,6 +282,11 @@ class KernelExecutor : public ExecutorAbstract {
     return launch_params_;
   }
 
+  //! Tensor maps of the TMA operands, reused across launches
+  const TensorMapCache& tensorMapCache() const {
+    return tensor_maps_;
+  }
+
   static void setGlobalFusionCount(int64_t new_fusion_count) {
     CompiledKernel::setGlobalFusionCount(new_fusion_count);
   }
@@ -183,6 +303,35 @@ class KernelExecutor : public ExecutorAbstract {
     group_id_ = gid;
   }
 
+  //! Positions of the outputs read by the next segment. The largest of them
+  //! is kept in the persisting L2 carve-out by the runs that ask for it with
+  //! OutputPlacement::persist_in_l2, see l2_persistence::setAccessPolicyWindow.
+  //! They are fixed by the segmentation, so they are set once before the
+  //! kernel is compiled and only read by concurrent runs.
+  void setL2PersistingOutputs(std::vector<int64_t> outputs) {
+    NVF_ERROR(
+        !isCompiled(), "L2 persisting outputs must be set before compiling");
+    l2_persisting_outputs_ = std::move(outputs);
+  }
+
+  //! Pairs of an output and an input that is dead after this segment. The
+  //! output is written into the storage of the input by the runs that ask
+  //! for it with OutputPlacement::write_inplace when their layouts match, see
+  //! findInplaceOutputs. Like setL2PersistingOutputs, they are set once
+  //! before the kernel is compiled.
+  void setInplaceOutputs(std::vector<std::pair<int64_t, int64_t>> outputs) {
+    NVF_ERROR(!isCompiled(), "Inplace outputs must be set before compiling");
+    inplace_outputs_ = std::move(outputs);
+  }
+
+  //! Bytes of the binary of the compiled kernel, which estimates the device
+  //! memory of its loaded module. Zero if it isn't compiled.
+  int64_t moduleBytes() const;
+
+  //! Bytes of the intermediate buffers retained between launches, see
+  //! IntermediateBufferPool
+  int64_t retainedBufferBytes() const;
+
   //! Serialize Fusion Executor using flatbuffers
   flatbuffers::Offset<serde::KernelExecutor> serialize(
       flatbuffers::FlatBufferBuilder& builder) const;
@@ -203,13 +352,47 @@ class KernelExecutor : public ExecutorAbstract {
     return compiled_kernel_;
   }
 
+  //! Whether the compiled kernel can run as a stage of a Megakernel, i.e.,
+  //! its code only depends on the grid and the block it's launched with and
+  //! its parameters are plain values
+  bool canRunInMegakernel() const;
+
+  //! Enqueues executable, the compiled kernel when the launch was prepared
+  //! by run, on stream with the arguments of that launch
+  void launchKernel(
+      const executor_utils::CudaExecutable& executable,
+      const LaunchParams& launch_params,
+      KernelLaunchArgs& launch_args,
+      CUstream stream) const;
+
  private:
+  //! Extents of the parallelized IterDomains of each parallel type, cached in
+  //! the compile-time data cache
+  const executor_utils::ParallelExtentMap& parallelIterExtents();
+
   LaunchParams computeLaunchParams(
       const LaunchParams& launch_constraints,
       ExpressionEvaluator& expr_eval,
       const int64_t warp_size,
       DataType index_dtype);
 
+  //! Computes the launch parameters with the LaunchParamsFormula of the
+  //! kernel, binding the parallel dimensions to expr_eval. Returns nullopt if
+  //! the formula is unavailable for the kernel or args, in which case
+  //! computeLaunchParams is used.
+  std::optional<LaunchParams> computeLaunchParamsWithFormula(
+      const KernelArgumentHolder& args,
+      const LaunchParams& launch_constraints,
+      ExpressionEvaluator& expr_eval,
+      DataType index_type);
+
+  //! Dynamic shared memory of a launch with the parallel dimensions of
+  //! launch_params bound to expr_eval
+  int64_t computeDynamicSmemSize(
+      const LaunchParams& launch_params,
+      ExpressionEvaluator& expr_eval,
+      DataType index_type);
+
   //! Return information necessay for allocating intermediate tensors,
   //! including temporary work buffers as well as intermediate
   //! global-memory tensors
@@ -233,13 +416,34 @@ class KernelExecutor : public ExecutorAbstract {
 
   std::unique_ptr<PrecomputedValues>& evaluatorPrecomputedValues();
 
+  // Returns the allocation strides of the kernel argument of param, or none if
+  // the kernel doesn't read them, see
+  // KernelSummary::tensors_reading_alloc_stride.
+  std::vector<int64_t> kernelAllocStrides(
+      const Val* param,
+      const GlobalBufferInfo& buffer_info) const;
+
+  // Packs the arguments of the inputs, outputs and intermediates of entry for
+  // reuse across launches. Only the inputs are needed as the metadata of the
+  // remaining tensors is recorded in entry.
+  void initializePackedArgs(
+      KernelExecutorEntry& entry,
+      const KernelArgumentHolder& inputs) const;
+
   // Creates the initial set of arguments to a kernel, based on the arguments
   // to we have now.
-  void computeArgs(KernelExecutorEntry& entry, const KernelArgumentHolder& args)
-      const;
+  void computeArgs(
+      const KernelExecutorEntry& entry,
+      const KernelArgumentHolder& args,
+      KernelLaunchArgs& launch_args) const;
+
+  // Copies the arguments computed by computeArgs to a table in device memory,
+  // staged through the ArgTableStaging of the current stream and copied
+  // asynchronously, and passes the kernel a pointer to it
+  void copyArgsToTable(KernelLaunchArgs& launch_args) const;
 
   KernelArgumentHolder resolveTMA(
-      KernelExecutorEntry& entry,
+      const KernelExecutorEntry& entry,
       const KernelArgumentHolder& args) const;
 
   //! Serialize CompiledKernel using flatbuffers
@@ -270,12 +474,6 @@ class KernelExecutor : public ExecutorAbstract {
   //! Deserialize GlobalBufferInfo using flatbuffers
   GlobalBufferInfo deserialize(const serde::GlobalBufferInfo* buffer);
 
-  //! Get the current dynamic shared memory size
-  int64_t getAvailableDynamicSmemSize();
-
-  //! Get the static shared memory size of the current compiled kernel
-  int64_t getStaticSmemSize();
-
   //! Check if the shared memory size can be expandable to accommodate
   //! the given dynamic size. The total shared memory size consumed
   //! would be the sum of the static and dynamic sizes.
@@ -285,22 +483,12 @@ class KernelExecutor : public ExecutorAbstract {
   //! the given size
   int64_t ensureAvailableDynamicSmemSize(int64_t dynamic_smem_size);
 
-  //! Clear the cached properties of the compiled kernel
-  void resetCompiledKernelProperties();
-
  private:
   std::unique_ptr<CompiledKernel> compiled_kernel_;
 
   //! Absolute limit of all available shared mem space from cudaDeviceProp
   int64_t device_smem_limit_ = 0;
 
-  //! Static shared memory size of the current compiled kernel
-  std::optional<int64_t> static_smem_size_ = std::nullopt;
-
-  //! Available shared memory space for dynamic allocation for the current
-  //!  compiled kernel at the current shared memory/L1 configuration
-  std::optional<int64_t> available_dynamic_smem_size_ = std::nullopt;
-
   int64_t warp_size_ = 0;
 
   // Has an RNG kernel and therefore needs to infer RNG state through expression
@@ -316,8 +504,19 @@ class KernelExecutor : public ExecutorAbstract {
   bool has_dynamic_alias_ = false;
 
   // lookup table to take short cut to retrieve recorded information in order to
-  // launch kernels without re-inference parameters.
-  std::unordered_map<size_t, KernelExecutorEntry> executor_entry_lookup_;
+  // launch kernels without re-inference parameters. Entries are shared so that
+  // a launch in flight keeps its entry alive even if another thread evicts it.
+  std::unordered_map<size_t, std::shared_ptr<KernelExecutorEntry>>
+      executor_entry_lookup_;
+
+  // Guards executor_entry_lookup_, the initialization of its entries and the
+  // lazily computed kernel properties so that run can be called from multiple
+  // threads. It is not held while allocating buffers or launching the kernel.
+  mutable std::mutex mutex_;
+
+  // Pinned staging buffers of argument tables copied during stream capture,
+  // which the captured graphs copy from on every replay. Guarded by mutex_.
+  mutable std::vector<at::Tensor> captured_arg_staging_;
 
   // Compile time information caching. This is used for shape inference
   //  support. The cache stores graph information that are available
@@ -328,10 +527,19 @@ class KernelExecutor : public ExecutorAbstract {
   // Cached expr eval
   std::unique_ptr<PrecomputedValues> evaluator_precomputed_values_ = nullptr;
 
+  // Tensor maps encoded by resolveTMA, which is const like run
+  mutable TensorMapCache tensor_maps_;
+
   // Profiling support: knob to control wheter we actually execute the
   // kernel on the GPU or not
   bool execute_kernel_ = true;
 
+  // Outputs covered by an L2 access policy window when the kernel is launched
+  std::vector<int64_t> l2_persisting_outputs_;
+
+  // Outputs written into the storage of dead inputs, with these inputs
+  std::vector<std::pair<int64_t, int64_t>> inplace_outputs_;
+
   // Heuristic tuning support: the last kernel occupancy, if
   // DebugDumpOption::Occupancy is true
   float kernel_occupancy_ = -1.0f;
@@ -339,6 +547,11 @@ class KernelExecutor : public ExecutorAbstract {
   // Profiling support: the last launch param used
   LaunchParams launch_params_;
 
+  // Launch parameters and dynamic shared memory size computed by lower to be
+  // used by compileLowered
+  LaunchParams lowered_launch_params_;
+  std::optional<int64_t> lowered_dynamic_smem_ = std::nullopt;
+
   // Lowering hooks that are called after the GpuLower instance is created
   // before running lowering passes.
   // The main use case is for unit tests to modify the lowering process.
@@ -117,7 +117,8 @@ KernelArgumentHolder ExecutorDispatch::run(
     const KernelArgumentHolder& args,
     KernelArgumentHolder outputs,
     const LaunchParams& launch_constraints,
-    const CompileParams& compile_params) {
+    const CompileParams& compile_params,
+    const OutputPlacement& output_placement) {
   FUSER_PERF_SCOPE("ExecutorDispatch::run");
   if (auto hire = dynamic_cast<HostIrExecutor*>(executor)) {
     return hire->run(args, outputs);
@@ -126,7 +127,8 @@ KernelArgumentHolder ExecutorDispatch::run(
     return eee->run(args, outputs);
   }
   if (auto ke = dynamic_cast<KernelExecutor*>(executor)) {
-    return ke->run(args, outputs, launch_constraints, compile_params);
+    return ke->run(
+        args, outputs, launch_constraints, compile_params, output_placement);
   }
   NVF_THROW("Unsupported Executor detected.");
 }
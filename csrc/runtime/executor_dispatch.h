@@ -48,7 +48,8 @@ class ExecutorDispatch {
       const KernelArgumentHolder& args,
       KernelArgumentHolder outputs = {},
       const LaunchParams& launch_constraints = LaunchParams(),
-      const CompileParams& compile_params = CompileParams());
+      const CompileParams& compile_params = CompileParams(),
+      const OutputPlacement& output_placement = {});
 };
 
 } // namespace nvfuser
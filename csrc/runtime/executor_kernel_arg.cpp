@@ -15,6 +15,8 @@
 #include <serde/polymorphic_value.h>
 #include <tensor_metadata.h>
 
+#include <cstring>
+
 namespace nvfuser {
 
 namespace {
@@ -104,6 +106,19 @@ PrimDataType KernelArgumentHolder::getSmallestIndexTypeOfArguments() const {
   return PrimDataType::Int32;
 }
 
+std::vector<int64_t> KernelArgumentHolder::getInt32IndexableTensorPositions()
+    const {
+  std::vector<int64_t> positions;
+  for (auto i : arange(std::ssize(arguments_))) {
+    const PolymorphicValue& arg = arguments_.at(i);
+    if (arg.is<at::Tensor>() &&
+        getSmallestIndexType(arg.as<at::Tensor>()) == PrimDataType::Int32) {
+      positions.push_back(i);
+    }
+  }
+  return positions;
+}
+
 void KernelArgumentHolder::pushTensorProxy(
     const std::vector<int64_t>& sizes,
     const std::vector<int64_t>& strides,
@@ -309,18 +324,13 @@ std::vector<std::byte> polymorphicValueToBytes(
   }
 }
 
-std::vector<std::byte> tensorToBytes(
-    const PolymorphicValue& argument,
+std::vector<std::byte> tensorMetadataToBytes(
     const std::vector<int64_t>& logical_sizes,
     const std::vector<int64_t>& alloc_strides,
     PrimDataType idx_type,
     const std::vector<int64_t>& unsharded_logical_sizes) {
   std::vector<std::byte> bytes;
-  NVF_ERROR(
-      argument.is<at::Tensor>() && argument.as<at::Tensor>().is_cuda(),
-      "Argument is not a CUDA tensor.");
-  const auto& tensor = argument.as<at::Tensor>();
-  auto data = tensor.data_ptr();
+  void* data = nullptr;
 
   const auto& size_to_use =
       logical_sizes.size() == unsharded_logical_sizes.size()
@@ -360,6 +370,25 @@ std::vector<std::byte> tensorToBytes(
         (std::byte*)alloc_stride32.data() +
             sizeof(int32_t) * alloc_stride32.size());
   }
+  // Pad to the alignment of the data pointer, which is the size of the
+  // Tensor struct when an odd number of 32-bit sizes and strides is passed.
+  bytes.resize(roundUpToMultiple(std::ssize(bytes), (int64_t)sizeof(void*)));
+  return bytes;
+}
+
+std::vector<std::byte> tensorToBytes(
+    const PolymorphicValue& argument,
+    const std::vector<int64_t>& logical_sizes,
+    const std::vector<int64_t>& alloc_strides,
+    PrimDataType idx_type,
+    const std::vector<int64_t>& unsharded_logical_sizes) {
+  NVF_ERROR(
+      argument.is<at::Tensor>() && argument.as<at::Tensor>().is_cuda(),
+      "Argument is not a CUDA tensor.");
+  std::vector<std::byte> bytes = tensorMetadataToBytes(
+      logical_sizes, alloc_strides, idx_type, unsharded_logical_sizes);
+  void* data = argument.as<at::Tensor>().data_ptr();
+  std::memcpy(bytes.data(), &data, sizeof(void*));
   return bytes;
 }
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <ATen/core/ivalue.h>
+#include <c10/util/SmallVector.h>
 #include <exceptions.h>
 #include <expr_evaluator.h>
 #include <ir/all_nodes.h>
@@ -28,8 +29,13 @@ struct GlobalBufferInfo;
 //! tensor sizes/shapes/dtype/memory_ptr and copies scalar inputs. It is used
 //! for both compilation as well as kernel execution. It takes ownership of
 //! at::Tensors so care should be taken when using it relative to tensor.
+//!
+//! Up to inline_capacity arguments are stored inline, so building the
+//! arguments of a typical segment does not allocate.
 class NVF_API KernelArgumentHolder {
  public:
+  static constexpr size_t inline_capacity = 16;
+
   KernelArgumentHolder() = default;
 
   KernelArgumentHolder(const KernelArgumentHolder& self) = default;
@@ -57,6 +63,10 @@ class NVF_API KernelArgumentHolder {
   //! arguments. It does not consider any other tensors used in a kernel.
   NVF_API PrimDataType getSmallestIndexTypeOfArguments() const;
 
+  //! Returns the positions of the tensor arguments that can be indexed with
+  //! 32-bit arithmetic.
+  NVF_API std::vector<int64_t> getInt32IndexableTensorPositions() const;
+
   // Push a tensor proxy to the arguments
   void pushTensorProxy(
       const std::vector<int64_t>& sizes,
@@ -123,22 +133,22 @@ class NVF_API KernelArgumentHolder {
     return arguments_.at(ind);
   }
 
-  // Returns iterator pointing to the beginning of vector container
+  // Returns iterator pointing to the beginning of the arguments
   auto begin() const {
     return arguments_.begin();
   }
 
-  // Returns iterator pointing to the end of vector container
+  // Returns iterator pointing to the end of the arguments
   auto end() const {
     return arguments_.end();
   }
 
-  // Returns iterator pointing to the beginning of vector container
+  // Returns iterator pointing to the beginning of the arguments
   auto begin() {
     return arguments_.begin();
   }
 
-  // Returns iterator pointing to the end of vector container
+  // Returns iterator pointing to the end of the arguments
   auto end() {
     return arguments_.end();
   }
@@ -214,7 +224,7 @@ class NVF_API KernelArgumentHolder {
   void setCommonDevice();
 
  private:
-  std::vector<PolymorphicValue> arguments_;
+  c10::SmallVector<PolymorphicValue, inline_capacity> arguments_;
 
   int8_t device_index_ = 0;
   std::optional<size_t> cache_id_ = std::nullopt;
@@ -227,6 +237,15 @@ std::vector<std::byte> polymorphicValueToBytes(
     const DataType& dtype,
     PrimDataType index_type);
 
+// Used to convert the metadata of a CUDA tensor to a byte vector. The layout
+// is the same as tensorToBytes, but the data pointer is left null so it can be
+// patched for each launch.
+std::vector<std::byte> tensorMetadataToBytes(
+    const std::vector<int64_t>& logical_sizes,
+    const std::vector<int64_t>& allocation_strides,
+    PrimDataType idx_type,
+    const std::vector<int64_t>& unsharded_logical_sizes = {});
+
 // Used to convert a CUDA tensor to a byte vector.
 std::vector<std::byte> tensorToBytes(
     const PolymorphicValue& argument,
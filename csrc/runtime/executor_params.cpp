@@ -24,7 +24,12 @@ std::string CompileParams::toString() const {
   ss << "maxrregcount = " << maxrregcount << ", "
      << "enable_magic_zero = " << enable_magic_zero << ", "
      << "enable_ptxas_verbose = " << enable_ptxas_verbose
-     << ", include_paths = " << toDelimitedString(include_paths, ":") << "\n";
+     << ", include_paths = " << toDelimitedString(include_paths, ":");
+  if (!int32_indexed_inputs.empty()) {
+    ss << ", int32_indexed_inputs = {"
+       << toDelimitedString(int32_indexed_inputs) << "}";
+  }
+  ss << "\n";
   return ss.str();
 }
 
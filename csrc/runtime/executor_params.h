@@ -28,6 +28,9 @@ struct CompileParams {
   std::optional<c10::Device> device = std::nullopt;
   // Additional include paths to be added to the nvrtc compilation
   std::vector<std::string> include_paths;
+  // Positions of the fusion inputs that are indexed with 32-bit arithmetic
+  // although index_type is Int. Set with EnableOption::MixedIndexType.
+  std::vector<int64_t> int32_indexed_inputs;
 
   bool operator==(const CompileParams& other) const {
     // Disallow comparison if the index type is nullopt
@@ -40,7 +43,8 @@ struct CompileParams {
     return index_type == other.index_type &&
         maxrregcount == other.maxrregcount &&
         enable_magic_zero == other.enable_magic_zero &&
-        device == other.device && include_paths == other.include_paths;
+        device == other.device && include_paths == other.include_paths &&
+        int32_indexed_inputs == other.int32_indexed_inputs;
   }
 
   bool operator!=(const CompileParams& other) const {
@@ -19,6 +19,7 @@
 #include <ir/all_nodes.h>
 #include <ir/iostream.h>
 #include <ir/utils.h>
+#include <multidevice/utils.h>
 #include <options.h>
 #include <runtime/executor_utils.h>
 #include <tensor_metadata.h>
@@ -28,6 +29,7 @@
 
 #include <cstdlib>
 #include <fstream>
+#include <string_view>
 #include <variant>
 
 namespace nvfuser {
@@ -540,15 +542,378 @@ std::vector<int> getOutputAliasToInputMap(const Fusion* fusion) {
   return output_to_input_map;
 }
 
-CudaExecutable::~CudaExecutable() {
+std::vector<int64_t> getCompileForArchs() {
+  std::vector<int64_t> archs;
+  if (!isOptionEnabled(EnableOption::CompileForArchs)) {
+    return archs;
+  }
+  for (const std::string& arg :
+       getEnableOptionArguments(EnableOption::CompileForArchs)) {
+    int64_t arch = 0;
+    try {
+      arch = std::stoll(arg);
+    } catch (const std::exception&) {
+    }
+    NVF_CHECK(
+        arch >= 10,
+        "NVFUSER_ENABLE=compile_for_archs expects compute capabilities such "
+        "as 80 or 90, got ",
+        arg);
+    archs.push_back(arch);
+  }
+  return archs;
+}
+
+SharedModule::~SharedModule() {
   if (module != nullptr) {
     NVFUSER_CUDA_SAFE_CALL(cuModuleUnload(module));
+  }
+}
+
+int64_t SharedModule::ensureMaxDynamicSmemSize(
+    CUfunction function,
+    int64_t size) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto [it, inserted] = max_dynamic_smem_sizes_.try_emplace(function, 0);
+  if (inserted) {
+    int current = 0;
+    NVFUSER_CUDA_SAFE_CALL(cuFuncGetAttribute(
+        &current, CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES, function));
+    it->second = current;
+  }
+  if (size > it->second) {
+    NVFUSER_CUDA_SAFE_CALL(cuFuncSetAttribute(
+        function, CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES, (int)size));
+    it->second = size;
+  }
+  return it->second;
+}
+
+ModuleRegistry& ModuleRegistry::get() {
+  static ModuleRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<SharedModule> ModuleRegistry::getOrLoad(
+    const std::vector<char>& cubin,
+    int device_index,
+    const std::function<CUmodule()>& load) {
+  FUSER_PERF_SCOPE("ModuleRegistry::getOrLoad");
+  size_t hash = std::hash<std::string_view>()(
+      std::string_view(cubin.data(), cubin.size()));
+  hashCombine(hash, static_cast<size_t>(device_index));
+
+  // Must be called with mutex_ held
+  auto find = [&]() -> std::shared_ptr<SharedModule> {
+    auto& modules = modules_[hash];
+    std::erase_if(modules, [](const auto& module) { return module.expired(); });
+    for (const auto& weak_module : modules) {
+      std::shared_ptr<SharedModule> module = weak_module.lock();
+      if (module != nullptr && module->device_index == device_index &&
+          module->cubin == cubin) {
+        return module;
+      }
+    }
+    return nullptr;
+  };
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (auto module = find()) {
+      ++num_reuses_;
+      return module;
+    }
+  }
+
+  // Load without holding the lock so that segments compiled in parallel
+  // don't wait for each other. If another thread loaded the same cubin in the
+  // meantime, its module is used and this one is unloaded.
+  auto loaded = std::make_shared<SharedModule>(load(), device_index, cubin);
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (auto module = find()) {
+    ++num_reuses_;
+    return module;
+  }
+  modules_[hash].push_back(loaded);
+  return loaded;
+}
+
+int64_t ModuleRegistry::numModules() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  int64_t num_modules = 0;
+  for (const auto& [hash, modules] : modules_) {
+    num_modules += std::count_if(
+        modules.begin(), modules.end(), [](const auto& module) {
+          return !module.expired();
+        });
+  }
+  return num_modules;
+}
+
+int64_t ModuleRegistry::numReuses() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return num_reuses_;
+}
+
+CudaExecutable::~CudaExecutable() {
+  if (module != nullptr && shared_module == nullptr) {
+    NVFUSER_CUDA_SAFE_CALL(cuModuleUnload(module));
     module = (CUmodule)0x2a2a2a2a2a2a2a2a;
   }
 }
 
 namespace caching {
 
+LaunchParamsFormula::LaunchParamsFormula(
+    const kir::Kernel* kernel,
+    const std::unordered_map<ParallelType, std::vector<const Val*>>&
+        parallel_iter_extents) {
+  FUSER_PERF_SCOPE("LaunchParamsFormula::LaunchParamsFormula");
+  const auto& inputs = kernel->inputs();
+  for (auto i : arange(std::ssize(inputs))) {
+    if (auto tv = dynamic_cast<const TensorView*>(inputs[i])) {
+      // Sizes of sharded inputs are unsharded when bound, see
+      // ExpressionEvaluator::bindTensorDomain
+      if (isSharded(tv)) {
+        continue;
+      }
+      const auto logical_domain =
+          TensorDomain::noReductions(tv->getLogicalDomain());
+      for (auto dim : arange(std::ssize(logical_domain))) {
+        IterDomain* id = logical_domain[dim];
+        if (id->isBroadcast()) {
+          if (id->hasExpandedExtent()) {
+            input_of_.emplace(id->expandedExtent(), std::make_pair(i, dim));
+          }
+        } else {
+          input_of_.emplace(id->extent(), std::make_pair(i, dim));
+        }
+      }
+    } else if (
+        inputs[i]->getDataType().has_value() &&
+        isIntegralType(inputs[i]->dtype())) {
+      input_of_.emplace(inputs[i], std::make_pair(i, -1));
+    }
+  }
+
+  for (const auto& [p_type, extent] :
+       kernel->summary().parallel_dimension_map.getMap()) {
+    const int64_t reg = compile(extent);
+    if (reg < 0) {
+      return;
+    }
+    extents_.emplace_back(p_type, reg);
+  }
+  // These are only checked, not evaluated
+  const auto num_registers = registers_.size();
+  const auto num_loads = loads_.size();
+  const auto num_constraint_loads = constraint_loads_.size();
+  const auto num_instructions = instructions_.size();
+  for (const auto& [p_type, extents] : parallel_iter_extents) {
+    for (const Val* extent : extents) {
+      if (compile(extent) < 0) {
+        return;
+      }
+    }
+  }
+  registers_.resize(num_registers);
+  loads_.resize(num_loads);
+  constraint_loads_.resize(num_constraint_loads);
+  instructions_.resize(num_instructions);
+  available_ = true;
+  // Only needed while compiling
+  register_of_.clear();
+  input_of_.clear();
+}
+
+int64_t LaunchParamsFormula::compile(const Val* val) {
+  if (auto it = register_of_.find(val); it != register_of_.end()) {
+    return it->second;
+  }
+  auto new_register = [&](int64_t initial_value) {
+    registers_.push_back(initial_value);
+    const auto reg = std::ssize(registers_) - 1;
+    register_of_[val] = reg;
+    return reg;
+  };
+
+  if (auto it = input_of_.find(val); it != input_of_.end()) {
+    const auto reg = new_register(0);
+    loads_.push_back({it->second.first, it->second.second, reg});
+    return reg;
+  }
+  if (val->isConst()) {
+    return val->value().is<int64_t>() ? new_register(val->value().as<int64_t>())
+                                      : -1;
+  }
+  if (auto ns = dynamic_cast<const NamedScalar*>(val)) {
+    std::optional<ParallelType> p_type = ns->getParallelDim();
+    if (!p_type.has_value()) {
+      return -1;
+    }
+    const auto reg = new_register(0);
+    constraint_loads_.emplace_back(p_type.value(), reg);
+    return reg;
+  }
+
+  Expr* def = val->definition();
+  if (def == nullptr || !val->getDataType().has_value() ||
+      !isIntegralType(val->dtype())) {
+    return -1;
+  }
+  // Casts between integer types are no-ops, as in NaiveValueMachine
+  if ((def->isA<UnaryOp>() &&
+       def->as<UnaryOp>()->getUnaryOpType() == UnaryOpType::Cast) ||
+      (def->isA<LoadStoreOp>() &&
+       def->as<LoadStoreOp>()->opType() == LoadStoreOpType::Set)) {
+    const Val* in = def->input(0);
+    if (!in->getDataType().has_value() || !isIntegralType(in->dtype())) {
+      return -1;
+    }
+    const int64_t reg = compile(in);
+    if (reg >= 0) {
+      register_of_[val] = reg;
+    }
+    return reg;
+  }
+
+  OpType type = OpType::Neg;
+  if (auto uop = dynamic_cast<const UnaryOp*>(def)) {
+    if (uop->getUnaryOpType() != UnaryOpType::Neg) {
+      return -1;
+    }
+  } else if (auto bop = dynamic_cast<const BinaryOp*>(def)) {
+    switch (bop->getBinaryOpType()) {
+      case BinaryOpType::Add:
+        type = OpType::Add;
+        break;
+      case BinaryOpType::Sub:
+        type = OpType::Sub;
+        break;
+      case BinaryOpType::Mul:
+        type = OpType::Mul;
+        break;
+      case BinaryOpType::Div:
+        type = OpType::Div;
+        break;
+      case BinaryOpType::Mod:
+        type = OpType::Mod;
+        break;
+      case BinaryOpType::CeilDiv:
+        type = OpType::CeilDiv;
+        break;
+      case BinaryOpType::Max:
+        type = OpType::Max;
+        break;
+      case BinaryOpType::Min:
+        type = OpType::Min;
+        break;
+      default:
+        return -1;
+    }
+  } else {
+    return -1;
+  }
+
+  Instruction instruction{type, -1, compile(def->input(0)), -1};
+  if (instruction.lhs < 0) {
+    return -1;
+  }
+  if (def->inputs().size() > 1) {
+    instruction.rhs = compile(def->input(1));
+    if (instruction.rhs < 0) {
+      return -1;
+    }
+  }
+  instruction.dst = new_register(0);
+  instructions_.push_back(instruction);
+  return instruction.dst;
+}
+
+bool LaunchParamsFormula::evaluate(
+    const KernelArgumentHolder& args,
+    const LaunchParams& launch_constraints,
+    LaunchParams& launch_params) const {
+  FUSER_PERF_SCOPE("LaunchParamsFormula::evaluate");
+  NVF_ERROR(available_);
+  std::vector<int64_t> registers = registers_;
+  for (const Load& load : loads_) {
+    const PolymorphicValue& arg = args[load.input];
+    if (load.dim < 0) {
+      if (!arg.is<int64_t>()) {
+        return false;
+      }
+      registers[load.dst] = arg.as<int64_t>();
+    } else {
+      if (!arg.is<at::Tensor>() || arg.as<at::Tensor>().dim() <= load.dim) {
+        return false;
+      }
+      registers[load.dst] = arg.as<at::Tensor>().size(load.dim);
+    }
+  }
+  for (const auto& [p_type, dst] : constraint_loads_) {
+    if (!launch_constraints.hasDim(p_type)) {
+      return false;
+    }
+    registers[dst] = launch_constraints.getDim(p_type);
+  }
+
+  for (const Instruction& instruction : instructions_) {
+    const int64_t a = registers[instruction.lhs];
+    const int64_t b = instruction.rhs < 0 ? 0 : registers[instruction.rhs];
+    int64_t& result = registers[instruction.dst];
+    switch (instruction.type) {
+      case OpType::Neg:
+        result = -a;
+        break;
+      case OpType::Add:
+        result = a + b;
+        break;
+      case OpType::Sub:
+        result = a - b;
+        break;
+      case OpType::Mul:
+        result = a * b;
+        break;
+      case OpType::Div:
+        if (b == 0) {
+          return false;
+        }
+        result = a / b;
+        break;
+      case OpType::Mod:
+        if (b == 0) {
+          return false;
+        }
+        result = a % b;
+        break;
+      case OpType::CeilDiv:
+        if (b == 0) {
+          return false;
+        }
+        result = b > 0 ? (a + b - 1) / b : (a + b + 1) / b;
+        break;
+      case OpType::Max:
+        result = std::max(a, b);
+        break;
+      case OpType::Min:
+        result = std::min(a, b);
+        break;
+    }
+  }
+
+  // Same order of binding as KernelExecutor::computeLaunchParams
+  for (const auto& [p_type, reg] : extents_) {
+    if (launch_constraints.hasDim(p_type) && !launch_params.hasDim(p_type)) {
+      launch_params.bind(launch_constraints.getDim(p_type), p_type);
+    }
+    if (registers[reg] > 0) {
+      launch_params.bind(registers[reg], p_type);
+    }
+  }
+  return true;
+}
+
 //! CompileTimeInfo is the actual subclass of CompileTimeInfoBase that will
 //!  be stored in the data cache. It owns a data_ state internally of the
 //!  dataType defined within the entry class, which are listed in header file.
@@ -597,6 +962,7 @@ ExecutorCompileTimeEntry<EntryClass>::ExecutorCompileTimeEntry(
 template class ExecutorCompileTimeEntry<ParallelBindingIterDomains>;
 template class ExecutorCompileTimeEntry<ParallelIterExtentMap>;
 template class ExecutorCompileTimeEntry<VectorizedTensorValidation>;
+template class ExecutorCompileTimeEntry<ParallelExtentFormula>;
 
 } // namespace caching
 
@@ -665,8 +1031,9 @@ void validateIndexCasts(
   NVF_ERROR(
       calc.castsFromIndexAreSafe(),
       "Found unsafe casts from DataType::Index. ",
-      "This is likely because one coordinate of a TMA instruction overflowed "
-      "Int32");
+      "This is likely because one coordinate of a TMA instruction or the "
+      "offset of an input indexed with EnableOption::MixedIndexType "
+      "overflowed Int32");
 }
 
 } // namespace executor_utils
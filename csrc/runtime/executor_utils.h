@@ -21,8 +21,13 @@
 #include <ir/all_nodes.h>
 #include <kernel.h>
 #include <runtime/executor_kernel_arg.h>
+#include <runtime/executor_params.h>
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace nvfuser {
@@ -31,12 +36,83 @@ class GpuLower;
 
 namespace executor_utils {
 
+//! A CUmodule shared by all CudaExecutables loaded from the same cubin on the
+//! same device. The module is unloaded with the last of them. See
+//! ModuleRegistry.
+struct SharedModule : public NonCopyable {
+  SharedModule(CUmodule module, int device_index, std::vector<char> cubin)
+      : module(module), device_index(device_index), cubin(std::move(cubin)) {}
+  NVF_API ~SharedModule();
+
+  //! Raises CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES of function, a
+  //! function of module, to at least size and returns the attribute. The
+  //! attribute belongs to the function, which all the kernels sharing the
+  //! module use, so it is only ever raised, under the lock, or a kernel
+  //! needing less would take shared memory away from another one.
+  NVF_API int64_t ensureMaxDynamicSmemSize(CUfunction function, int64_t size);
+
+  CUmodule module = nullptr;
+  int device_index = -1;
+  //! Compared on lookup to rule out hash collisions
+  std::vector<char> cubin;
+
+ private:
+  std::mutex mutex_;
+  //! CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES of the functions of
+  //! module, once queried
+  std::unordered_map<CUfunction, int64_t> max_dynamic_smem_sizes_;
+};
+
+//! Process-wide registry of the modules loaded from cubins. Kernels of
+//! different fusions are often compiled to identical cubins, e.g. with
+//! KernelBinaryCache, and sharing one module for them saves the load time
+//! and the device memory of the module code.
+class ModuleRegistry {
+ public:
+  NVF_API static ModuleRegistry& get();
+
+  //! Returns a live module loaded from cubin on device_index, or calls load
+  //! to load a new one if there is none.
+  std::shared_ptr<SharedModule> getOrLoad(
+      const std::vector<char>& cubin,
+      int device_index,
+      const std::function<CUmodule()>& load);
+
+  //! Number of modules currently loaded through this registry
+  NVF_API int64_t numModules() const;
+
+  //! Number of loads avoided by sharing a module
+  NVF_API int64_t numReuses() const;
+
+ private:
+  ModuleRegistry() = default;
+
+  mutable std::mutex mutex_;
+  //! Modules by hash of device index and cubin. Expired modules are removed
+  //! on the next lookup with the same hash.
+  std::unordered_map<size_t, std::vector<std::weak_ptr<SharedModule>>>
+      modules_;
+  int64_t num_reuses_ = 0;
+};
+
 // I'm not happy with CudaExecutable being a struct exposing all the fields.
 // This could be refactored.
+//! Cubin of a kernel compiled for another architecture than the current
+//! device, see EnableOption::CompileForArchs
+struct CudaKernelImage {
+  //! Compute capability as major * 10 + minor
+  int64_t arch = 0;
+  std::string compile_args;
+  std::vector<char> cubin;
+};
+
 struct CudaExecutable : public NonCopyable {
   NVF_API ~CudaExecutable();
 
   CUmodule module = nullptr;
+  //! Owner of module if it is shared via ModuleRegistry, in which case this
+  //! executable doesn't unload the module itself
+  std::shared_ptr<SharedModule> shared_module;
   CUfunction function = nullptr;
   std::string compile_log;
   std::vector<char> ptx;
@@ -49,12 +125,19 @@ struct CudaExecutable : public NonCopyable {
   std::string sass_filename;
   long block_size = -1;
   int register_spills = -1;
+  //! Cubins for the other architectures of EnableOption::CompileForArchs.
+  //! A deserialized executable on a device of one of these loads its image.
+  std::vector<CudaKernelImage> images;
 };
 
 //! Bind input values to runtime values
 NVF_API ExpressionEvaluator
 bindInputs(const KernelArgumentHolder& args, Fusion* fusion);
 
+//! Compute capabilities, as major * 10 + minor, given to
+//! EnableOption::CompileForArchs. Empty if the option isn't set.
+NVF_API std::vector<int64_t> getCompileForArchs();
+
 // Returns a vector where vector[out_idx] == the input index in fusion->inputs()
 // that output[out_idx] is aliased to. If output[out_idx] is not aliased to any
 // input, then vector[out_idx] is -1.
@@ -73,6 +156,7 @@ enum class CompileTimeEntryType {
   SIMPLIFIED_PARALLEL_ITER_EXTENT_MAP,
   WARP_PADDED_PARALLEL_EXTENTS,
   VECTORIZED_TENSOR_VALIDATION,
+  PARALLEL_EXTENT_FORMULA,
   INPUT_ALIAS_INDICES,
   OUTPUT_ALIAS_INDICES
 };
@@ -125,6 +209,83 @@ class VectorizedTensorValidation {
       CompileTimeEntryType::VECTORIZED_TENSOR_VALIDATION;
 };
 
+//!  LaunchParamsFormula:
+//!    Auxiliary data type for entry class ParallelExtentFormula. The extents
+//!    of the ParallelDimensionMap of a kernel compiled into int64
+//!    instructions on the sizes of its input tensors, its integer scalar
+//!    inputs and the launch constraints, so that the launch parameters of a
+//!    new shape are computed without an ExpressionEvaluator.
+class LaunchParamsFormula {
+ public:
+  //! The formula is unavailable if an extent of the ParallelDimensionMap or
+  //! of the parallelized IterDomains depends on other values, e.g., the
+  //! sizes of sharded inputs, or on ops without an int64 instruction. The
+  //! latter are checked so that the ExpressionEvaluator can evaluate them
+  //! without binding them to the launch constraints.
+  LaunchParamsFormula(
+      const kir::Kernel* kernel,
+      const std::unordered_map<ParallelType, std::vector<const Val*>>&
+          parallel_iter_extents);
+
+  bool available() const {
+    return available_;
+  }
+
+  //! Binds the evaluated extents to launch_params, or the launch constraints
+  //! of the parallel types whose extents aren't positive. Returns false if
+  //! an input isn't of the expected type, a launch constraint used by an
+  //! extent is missing, or an extent divides by zero.
+  bool evaluate(
+      const KernelArgumentHolder& args,
+      const LaunchParams& launch_constraints,
+      LaunchParams& launch_params) const;
+
+ private:
+  enum class OpType { Neg, Add, Sub, Mul, Div, Mod, CeilDiv, Max, Min };
+
+  struct Instruction {
+    OpType type;
+    int64_t dst;
+    int64_t lhs;
+    int64_t rhs;
+  };
+
+  //! Loads the size dim of the tensor input, or the scalar input if dim is
+  //! -1, into register dst
+  struct Load {
+    int64_t input;
+    int64_t dim;
+    int64_t dst;
+  };
+
+  //! Returns the register of val, emitting the instructions computing it, or
+  //! -1 if it can't be computed
+  int64_t compile(const Val* val);
+
+  bool available_ = false;
+  //! Initial values of the registers, i.e., the constants
+  std::vector<int64_t> registers_;
+  //! Registers of the compiled values and the inputs and dimensions of the
+  //! extents of input tensors, used while compiling
+  std::unordered_map<const Val*, int64_t> register_of_;
+  std::unordered_map<const Val*, std::pair<int64_t, int64_t>> input_of_;
+  std::vector<Load> loads_;
+  std::vector<std::pair<ParallelType, int64_t>> constraint_loads_;
+  std::vector<Instruction> instructions_;
+  std::vector<std::pair<ParallelType, int64_t>> extents_;
+};
+
+//! Compile-time info to be cached in each KernelExecutor:
+//!  ParallelExtentFormula
+//!    Stores the launch parameter formula of the kernel, used when the
+//!    KernelExecutorEntry of a new input signature is initialized.
+class ParallelExtentFormula {
+ public:
+  using DataType = LaunchParamsFormula;
+  static const CompileTimeEntryType EntryType =
+      CompileTimeEntryType::PARALLEL_EXTENT_FORMULA;
+};
+
 //! Base abstract class for unified storage in `ExecutorCompileTimeInfoCache`,
 //!  each entry in `ExecutorCompileTimeInfoCache` will be a subclass.
 class CompileTimeInfoBase : public PolymorphicBase {
@@ -8,10 +8,19 @@
 #include <runtime/fusion_cache_utils.h>
 
 #include <fusion_segmenter.h>
+#include <instrumentation.h>
 #include <ir/all_nodes.h>
+#include <iter_visitor.h>
+#include <options.h>
 #include <polymorphic_value.h>
+#include <runtime/allocations.h>
 #include <runtime/executor_kernel_arg.h>
 
+#include <ATen/ExpandUtils.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace nvfuser {
@@ -28,8 +37,144 @@ void encodeBuffer(T value, std::string& buffer) {
     buffer.push_back(*(v++));
   }
 }
+
+// Largest power-of-two number of bytes, up to 16, that evenly divides nbytes
+size_t vectorizableBytes(int64_t nbytes) {
+  constexpr int64_t max_vectorize_bytes = 16;
+  int64_t vec_bytes = 1;
+  while (vec_bytes < max_vectorize_bytes && nbytes % (vec_bytes * 2) == 0) {
+    vec_bytes *= 2;
+  }
+  return (size_t)vec_bytes;
+}
 } // namespace
 
+size_t computeHeuristicSignature(
+    const KernelArgumentHolder& args,
+    std::optional<PrimDataType> forced_index_type) {
+  FUSER_PERF_SCOPE("computeHeuristicSignature");
+  size_t signature = (size_t)(forced_index_type.has_value()
+                                  ? forced_index_type.value()
+                                  : args.getSmallestIndexTypeOfArguments());
+  for (const auto& arg : args) {
+    if (!arg.is<at::Tensor>()) {
+      hashCombine(signature, 0);
+      continue;
+    }
+    const auto& tensor = arg.as<at::Tensor>();
+    const int64_t item_size = (int64_t)tensor.element_size();
+    hashCombine(signature, (size_t)tensor.scalar_type());
+    hashCombine(signature, (size_t)tensor.dim());
+    hashCombine(
+        signature,
+        SchedulerRuntimeInfo::computeAlignmentSize((size_t)tensor.data_ptr()));
+    if (tensor.dim() == 0) {
+      continue;
+    }
+    // Contiguity and vectorization of the innermost dimension, which is what
+    // vectorization analysis is most sensitive to.
+    const bool inner_contiguous = tensor.stride(-1) == 1;
+    hashCombine(signature, (size_t)inner_contiguous);
+    hashCombine(
+        signature,
+        inner_contiguous ? vectorizableBytes(tensor.size(-1) * item_size) : 0);
+    // Alignment of the outer strides bounds the vectorization factor too
+    size_t stride_alignment = 16;
+    for (int64_t dim = 0; dim + 1 < tensor.dim(); ++dim) {
+      if (tensor.size(dim) == 1) {
+        continue;
+      }
+      stride_alignment = std::min(
+          stride_alignment, vectorizableBytes(tensor.stride(dim) * item_size));
+    }
+    hashCombine(signature, stride_alignment);
+  }
+  return signature;
+}
+
+size_t computeShapeClass(
+    const KernelArgumentHolder& args,
+    std::optional<PrimDataType> forced_index_type) {
+  FUSER_PERF_SCOPE("computeShapeClass");
+  size_t shape_class = (size_t)(forced_index_type.has_value()
+                                    ? forced_index_type.value()
+                                    : args.getSmallestIndexTypeOfArguments());
+  for (const auto& arg : args) {
+    if (!arg.is<at::Tensor>()) {
+      hashCombine(shape_class, 0);
+      continue;
+    }
+    const auto& tensor = arg.as<at::Tensor>();
+    hashCombine(shape_class, (size_t)tensor.scalar_type());
+    hashCombine(shape_class, (size_t)tensor.dim());
+    for (int64_t size : tensor.sizes()) {
+      // Broadcast-like extents change what the schedulers accept, so they
+      // get a class of their own
+      size_t log2_ceil = 0;
+      while (size > ((int64_t)1 << log2_ceil)) {
+        ++log2_ceil;
+      }
+      hashCombine(shape_class, size == 1 ? 0 : log2_ceil + 1);
+    }
+  }
+  return shape_class;
+}
+
+int64_t bucketExtent(int64_t extent, int64_t bucket_width) {
+  constexpr int64_t max_power_of_two_divisor = 64;
+  NVF_CHECK(bucket_width >= 0, "Invalid shape bucket width: ", bucket_width);
+  if (extent <= max_power_of_two_divisor) {
+    return extent;
+  }
+  int64_t bound = 1;
+  if (bucket_width > 0) {
+    bound = roundUpToMultiple(extent, bucket_width);
+  } else {
+    while (bound < extent) {
+      bound *= 2;
+    }
+  }
+  bound = roundUpToMultiple(bound, max_power_of_two_divisor);
+  const int64_t divisor = extent & -extent;
+  return divisor >= max_power_of_two_divisor ? bound : bound + divisor;
+}
+
+std::optional<KernelArgumentHolder> bucketArgs(
+    const KernelArgumentHolder& args) {
+  if (!isOptionEnabled(EnableOption::ShapeBuckets)) {
+    return std::nullopt;
+  }
+  FUSER_PERF_SCOPE("bucketArgs");
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::ShapeBuckets);
+  const int64_t bucket_width =
+      option_args.empty() || option_args[0] == "pow2"
+      ? 0
+      : std::stoll(option_args[0]);
+
+  KernelArgumentHolder bucketed_args = args;
+  for (PolymorphicValue& arg : bucketed_args) {
+    if (!arg.is<at::Tensor>()) {
+      continue;
+    }
+    const at::Tensor tensor = arg.as<at::Tensor>();
+    if (!tensor.is_cuda() || tensor.dim() == 0) {
+      continue;
+    }
+    if (!tensor.is_non_overlapping_and_dense()) {
+      return std::nullopt;
+    }
+    std::vector<int64_t> sizes = tensor.sizes().vec();
+    for (int64_t& size : sizes) {
+      size = bucketExtent(size, bucket_width);
+    }
+    const std::vector<int64_t> strides =
+        at::infer_dense_strides(sizes, tensor.strides());
+    arg = at::from_blob(tensor.data_ptr(), sizes, strides, tensor.options());
+  }
+  return bucketed_args;
+}
+
 ArgumentManager::ArgumentManager(
     const KernelArgumentHolder& args,
     const RuntimeWorkSpace& runtime_workspace,
@@ -46,9 +191,9 @@ const PolymorphicValue& ArgumentManager::checkTensorMap(Val* v) const {
 
 KernelArgumentHolder ArgumentManager::translateValsToArgs(
     const std::vector<Val*>& vals) const {
-  std::vector<PolymorphicValue> arg_values;
-  arg_values.reserve(vals.size());
-
+  FUSER_PERF_SCOPE("ArgumentManager::translateValsToArgs");
+  KernelArgumentHolder holder;
+  holder.reserve(vals.size());
   for (auto val : vals) {
     auto it = tensor_map_.find(val);
     NVF_ERROR(
@@ -56,20 +201,16 @@ KernelArgumentHolder ArgumentManager::translateValsToArgs(
         "Could not find value ",
         val->toString(),
         " in tensor map");
-    arg_values.push_back(it->second);
-  }
-
-  KernelArgumentHolder holder;
-  for (auto arg : arg_values) {
-    holder.push(std::move(arg));
+    holder.push(it->second);
   }
   return holder;
 }
 
 void ArgumentManager::updateWithSegmentOutputs(
     const std::vector<Val*>& group_outputs,
-    const KernelArgumentHolder& group_runtime_outputs,
+    KernelArgumentHolder group_runtime_outputs,
     const int64_t group_id) {
+  FUSER_PERF_SCOPE("ArgumentManager::updateWithSegmentOutputs");
   // Insert graph segment output to tensor map
   NVF_ERROR_EQ(
       std::ssize(group_outputs),
@@ -77,7 +218,8 @@ void ArgumentManager::updateWithSegmentOutputs(
       "Output size does not match.");
   for (const size_t group_out_i : arange(group_outputs.size())) {
     tensor_map_.emplace(
-        group_outputs[group_out_i], group_runtime_outputs[group_out_i]);
+        group_outputs[group_out_i],
+        std::move(group_runtime_outputs[group_out_i]));
   }
 
   // Delete args corresponding to vals lastly used in this segment
@@ -208,6 +350,288 @@ void prepareRuntimeOrder(
         "Couldn't run all groups, something must have gone wrong in "
         "segmentation.");
   }
+
+  const auto& group_run_order = runtime_workspace.group_run_order;
+  std::unordered_map<SegmentedGroup*, int64_t> run_order_ids;
+  for (const auto run_order_id : arange(std::ssize(group_run_order))) {
+    run_order_ids[group_run_order[run_order_id]] = run_order_id;
+  }
+  runtime_workspace.group_producers.resize(group_run_order.size());
+  for (const auto run_order_id : arange(std::ssize(group_run_order))) {
+    auto& producers = runtime_workspace.group_producers[run_order_id];
+    for (SegmentedEdge* edge : group_run_order[run_order_id]->producer_edges) {
+      const int64_t producer = run_order_ids.at(edge->from);
+      if (std::find(producers.begin(), producers.end(), producer) ==
+          producers.end()) {
+        producers.push_back(producer);
+      }
+    }
+  }
+}
+
+std::vector<int64_t> assignGroupStreams(
+    const std::vector<std::vector<int64_t>>& group_producers,
+    int64_t num_streams) {
+  NVF_ERROR(num_streams > 0, "Expected at least one stream");
+  std::vector<int64_t> streams(group_producers.size(), 0);
+  // The last group assigned to each stream
+  std::vector<int64_t> last_groups(num_streams, -1);
+  int64_t next_stream = 0;
+  for (const auto group : arange(std::ssize(group_producers))) {
+    int64_t stream = -1;
+    for (const int64_t producer : group_producers[group]) {
+      if (last_groups[streams[producer]] == producer) {
+        stream = streams[producer];
+        break;
+      }
+    }
+    if (stream == -1) {
+      stream = next_stream;
+      next_stream = (next_stream + 1) % num_streams;
+    }
+    streams[group] = stream;
+    last_groups[stream] = group;
+  }
+  return streams;
+}
+
+namespace {
+
+// Returns whether expr writes each element of its output from the elements of
+// its inputs at the same position.
+bool isElementwise(Expr* expr) {
+  if (!expr->isOneOf<UnaryOp, BinaryOp, TernaryOp, LoadStoreOp>()) {
+    return false;
+  }
+  if (auto* ldst = dynamic_cast<LoadStoreOp*>(expr);
+      ldst != nullptr && ldst->opType() != LoadStoreOpType::Set &&
+      ldst->opType() != LoadStoreOpType::SegmenterSet) {
+    return false;
+  }
+  return std::all_of(
+      expr->outputs().begin(), expr->outputs().end(), [](Val* out) {
+        auto* tv = dynamic_cast<TensorView*>(out);
+        return tv != nullptr && !tv->hasRoot();
+      });
+}
+
+} // namespace
+
+std::vector<std::vector<std::pair<int64_t, int64_t>>> findInplaceOutputs(
+    const SegmentedFusion* segmented_fusion,
+    const std::vector<SegmentedGroup*>& group_run_order) {
+  const std::unordered_set<Val*> fusion_ios = [&]() {
+    std::unordered_set<Val*> ios(
+        segmented_fusion->inputs().begin(), segmented_fusion->inputs().end());
+    ios.insert(
+        segmented_fusion->outputs().begin(),
+        segmented_fusion->outputs().end());
+    return ios;
+  }();
+
+  // The position in the run order of the last group reading each
+  // intermediate
+  std::unordered_map<Val*, size_t> last_use;
+  for (auto run_order_id : arange(group_run_order.size())) {
+    for (Val* in : group_run_order.at(run_order_id)->inputs()) {
+      last_use[in] = run_order_id;
+    }
+  }
+
+  std::vector<std::vector<std::pair<int64_t, int64_t>>> inplace_outputs(
+      group_run_order.size());
+  for (auto run_order_id : arange(group_run_order.size())) {
+    SegmentedGroup* group = group_run_order.at(run_order_id);
+    // Other schedulers may read an element of an input after a different
+    // element of an output is written, e.g., to reduce or transpose it.
+    if (group->schedulerType() != SchedulerType::PointWise) {
+      continue;
+    }
+    const std::vector<Val*>& inputs = group->inputs();
+    const std::vector<Val*>& outputs = group->outputs();
+    std::vector<bool> output_taken(outputs.size(), false);
+    for (auto in_idx : arange(std::ssize(inputs))) {
+      auto* in = dynamic_cast<TensorView*>(inputs.at(in_idx));
+      if (in == nullptr || fusion_ios.count(in) != 0 ||
+          last_use.at(in) != run_order_id) {
+        continue;
+      }
+      const size_t rank =
+          TensorDomain::noReductions(in->getLogicalDomain()).size();
+
+      // Every use of in in the group, up to the outputs, must read and write
+      // the same position so that no element of in is overwritten before it
+      // is read.
+      const std::vector<Val*> between = DependencyCheck::getAllValsBetween(
+          {in}, {outputs.begin(), outputs.end()});
+      const bool is_elementwise =
+          std::all_of(between.begin(), between.end(), [&](Val* val) {
+            return val == in ||
+                (isElementwise(val->definition()) &&
+                 TensorDomain::noReductions(
+                     val->as<TensorView>()->getLogicalDomain())
+                         .size() == rank);
+          });
+      if (!is_elementwise) {
+        continue;
+      }
+
+      for (auto out_idx : arange(std::ssize(outputs))) {
+        auto* out = dynamic_cast<TensorView*>(outputs.at(out_idx));
+        if (out == nullptr || output_taken.at(out_idx) ||
+            out->dtype() != in->dtype() ||
+            std::find(between.begin(), between.end(), out) == between.end() ||
+            segmented_fusion->completeFusion()->getOutputAlias(out).type !=
+                AllocationType::New) {
+          continue;
+        }
+        output_taken.at(out_idx) = true;
+        inplace_outputs.at(run_order_id).emplace_back(out_idx, in_idx);
+        break;
+      }
+    }
+  }
+  return inplace_outputs;
+}
+
+namespace {
+
+// Returns the CatOp of group if group only pads and concatenates its inputs
+// into its only output.
+CatOp* findConcatenation(SegmentedGroup* group) {
+  if (group->outputs().size() != 1 ||
+      !group->outputs().front()->isA<TensorView>()) {
+    return nullptr;
+  }
+  CatOp* cat = nullptr;
+  for (Expr* expr : group->exprs()) {
+    if (auto* cat_op = dynamic_cast<CatOp*>(expr)) {
+      if (cat != nullptr) {
+        return nullptr;
+      }
+      cat = cat_op;
+    } else if (!expr->isA<PadOp>()) {
+      return nullptr;
+    }
+  }
+  if (cat == nullptr || cat->output(0) != group->outputs().front()) {
+    return nullptr;
+  }
+  for (Val* in : cat->inputs()) {
+    Expr* def = in->definition();
+    if (def == nullptr || !def->isA<PadOp>() ||
+        std::find(group->exprs().begin(), group->exprs().end(), def) ==
+            group->exprs().end()) {
+      return nullptr;
+    }
+  }
+  return cat;
+}
+
+} // namespace
+
+std::vector<CatOutputSlices> findCatOutputSlices(
+    const SegmentedFusion* segmented_fusion,
+    const std::vector<SegmentedGroup*>& group_run_order) {
+  Fusion* complete_fusion = segmented_fusion->completeFusion();
+
+  // The group producing each intermediate, with its position in the outputs
+  // of the group
+  std::unordered_map<Val*, std::pair<int64_t, int64_t>> producers;
+
+  std::vector<CatOutputSlices> cat_output_slices;
+  for (auto run_order_id : arange(std::ssize(group_run_order))) {
+    SegmentedGroup* group = group_run_order.at(run_order_id);
+    CatOp* cat = findConcatenation(group);
+    if (cat != nullptr &&
+        complete_fusion->getOutputAlias(cat->output(0)).type ==
+            AllocationType::New) {
+      CatOutputSlices plan;
+      plan.cat_run_order_id = run_order_id;
+      bool has_producer = false;
+      for (Val* padded : cat->inputs()) {
+        Val* in = padded->definition()->as<PadOp>()->in();
+        auto producer_it = producers.find(in);
+        // An intermediate read by another expression must stay a tensor of
+        // its own.
+        if (producer_it != producers.end() && in->uses().size() == 1 &&
+            !in->isFusionOutput()) {
+          plan.producers.push_back(producer_it->second);
+          has_producer = true;
+        } else {
+          plan.producers.emplace_back(-1, -1);
+        }
+      }
+      if (has_producer) {
+        cat_output_slices.push_back(std::move(plan));
+      }
+    }
+
+    for (auto out_idx : arange(std::ssize(group->outputs()))) {
+      Val* out = group->outputs().at(out_idx);
+      if (out->isA<TensorView>()) {
+        producers[out] = {run_order_id, out_idx};
+      }
+    }
+  }
+  return cat_output_slices;
+}
+
+std::pair<at::Tensor, std::vector<at::Tensor>> allocateCatOutputSlices(
+    const CatOutputSlices& plan,
+    const std::vector<SegmentedGroup*>& group_run_order,
+    ExpressionEvaluator& expr_eval,
+    const c10::Device& device) {
+  CatOp* cat = findConcatenation(group_run_order.at(plan.cat_run_order_id));
+  NVF_ERROR(cat != nullptr, "Expected a concatenation");
+  auto* out = cat->output(0)->as<TensorView>();
+  const TensorShapeInfo shape_info = inferTensorShapes(out, expr_eval);
+  at::Tensor buffer = at::native::empty_strided_cuda(
+      shape_info.logical_sizes,
+      shape_info.logical_strides,
+      data_type_to_aten(out->dtype()),
+      c10::nullopt,
+      device,
+      c10::nullopt);
+
+  const int64_t dim = cat->concatenatedDim();
+  std::vector<at::Tensor> slices;
+  slices.reserve(cat->inputs().size());
+  int64_t offset = 0;
+  for (Val* padded : cat->inputs()) {
+    auto* in = padded->definition()->as<PadOp>()->in()->as<TensorView>();
+    const int64_t extent =
+        expr_eval
+            .evaluate(TensorDomain::noReductions(in->getLogicalDomain())
+                          .at(dim)
+                          ->getMaybeExpandedExtent())
+            .as<int64_t>();
+    slices.push_back(buffer.narrow(dim, offset, extent));
+    offset += extent;
+  }
+  return {std::move(buffer), std::move(slices)};
+}
+
+void fillCatOutputSlices(
+    const CatOutputSlices& plan,
+    const std::vector<SegmentedGroup*>& group_run_order,
+    const KernelArgumentHolder& group_inputs,
+    const std::vector<at::Tensor>& slices) {
+  SegmentedGroup* group = group_run_order.at(plan.cat_run_order_id);
+  CatOp* cat = findConcatenation(group);
+  NVF_ERROR(cat != nullptr, "Expected a concatenation");
+  for (auto i : arange(std::ssize(cat->inputs()))) {
+    Val* in = cat->input(i)->definition()->as<PadOp>()->in();
+    auto in_it = std::find(group->inputs().begin(), group->inputs().end(), in);
+    NVF_ERROR(in_it != group->inputs().end(), "Not an input: ", in);
+    const auto& tensor =
+        group_inputs[std::distance(group->inputs().begin(), in_it)]
+            .as<at::Tensor>();
+    const at::Tensor& slice = slices.at(i);
+    if (slice.numel() > 0 && tensor.data_ptr() != slice.data_ptr()) {
+      slice.copy_(tensor);
+    }
+  }
 }
 
 flatbuffers::Offset<serde::InputsIdLookup> InputsIdLookup::serialize(
@@ -217,15 +641,26 @@ flatbuffers::Offset<serde::InputsIdLookup> InputsIdLookup::serialize(
 
   using fb_string = flatbuffers::Offset<flatbuffers::String>;
 
+  std::shared_lock<std::shared_mutex> guard(mutex_);
+
   // For serialization, we require a consistent ordering for the
-  // encoding_lookup_ map.
-  std::unordered_map<std::string, size_t> str_key_ordering;
+  // encoding_lookup_ map. The LRU list is ordered from the most to the least
+  // recently used entry.
+  std::vector<std::pair<uint64_t, const std::string*>> lru_order;
+  lru_order.reserve(encoding_lookup_.size());
+  for (const auto& [key, value] : encoding_lookup_) {
+    lru_order.emplace_back(value.last_access.load(), &key);
+  }
+  std::sort(lru_order.begin(), lru_order.end(), [](auto& lhs, auto& rhs) {
+    return lhs.first > rhs.first;
+  });
 
-  // 1. Serialize used_entry_ list
+  // 1. Serialize LRU order
+  std::unordered_map<std::string, size_t> str_key_ordering;
   std::vector<fb_string> lru_cache_fb;
-  for (const auto& str : used_entry_) {
-    lru_cache_fb.push_back(builder.CreateString(str));
-    str_key_ordering.emplace(str, str_key_ordering.size());
+  for (auto&& [last_access, str] : lru_order) {
+    lru_cache_fb.push_back(builder.CreateString(*str));
+    str_key_ordering.emplace(*str, str_key_ordering.size());
   }
 
   // 2. Serialize encoding_lookup_ map
@@ -249,24 +684,23 @@ void InputsIdLookup::deserialize(const serde::InputsIdLookup* buffer) {
   // See definitions in serde/fusion_cache.fbs for tables
   // InputsIdLookup and EncodingEntry
   NVF_ERROR(buffer != nullptr, "serde::InputsIdLookup is nullptr.");
-  using list_iter = std::list<std::string>::iterator;
-  std::vector<list_iter> used_entry_iterators;
 
+  std::unique_lock<std::shared_mutex> guard(mutex_);
   max_cache_size_ = buffer->max_cache_size();
   current_id_ = buffer->current_id();
-  for (auto fb_str : *buffer->lru_cache()) {
-    used_entry_.emplace_back(fb_str->str());
-    used_entry_iterators.emplace_back(std::prev(used_entry_.end()));
-  }
+
+  // lru_cache is ordered from the most to the least recently used entry, so
+  // the first entry gets the largest access count.
+  const uint64_t num_entries = buffer->lru_cache()->size();
+  access_counter_.store(num_entries);
 
   for (auto idx : arange(buffer->encoding_lookup_keys()->size())) {
     auto fb_encoding_lookup_str = buffer->encoding_lookup_keys()->Get(idx);
     auto fb_encoding_entry = buffer->encoding_lookup_values()->Get(idx);
 
-    EncodingEntry entry{
-        fb_encoding_entry->id(),
-        used_entry_iterators.at(fb_encoding_entry->lru_iter())};
-    encoding_lookup_.emplace(fb_encoding_lookup_str->str(), entry);
+    auto& entry = encoding_lookup_[fb_encoding_lookup_str->str()];
+    entry.id = fb_encoding_entry->id();
+    entry.last_access.store(num_entries - fb_encoding_entry->lru_iter());
   }
 }
 
@@ -275,10 +709,11 @@ InputsIdLookup::IdLookupReturn InputsIdLookup::lookupId(
     const std::unordered_set<size_t>& scalar_inputs_to_record) {
   IdLookupReturn ret;
 
-  // lock mutex_ because we are touching encoding_
-  std::lock_guard<std::mutex> guard(mutex_);
-  encoding_.clear();
-  encodeBuffer(args.getDeviceIndex(), encoding_);
+  // Each thread encodes into its own buffer, which is reused across calls so
+  // that encoding does not allocate in the steady state.
+  thread_local std::string encoding;
+  encoding.clear();
+  encodeBuffer(args.getDeviceIndex(), encoding);
 
   for (const auto i : arange(args.size())) {
     const auto& arg = args[i];
@@ -286,23 +721,23 @@ InputsIdLookup::IdLookupReturn InputsIdLookup::lookupId(
       const auto& input_tensor = arg.as<at::Tensor>();
 
       for (auto size : input_tensor.sizes()) {
-        encodeBuffer(size, encoding_);
-        encoding_.push_back(' ');
+        encodeBuffer(size, encoding);
+        encoding.push_back(' ');
       }
-      encoding_.push_back('X');
-      encoding_.push_back(' ');
+      encoding.push_back('X');
+      encoding.push_back(' ');
       for (auto stride : input_tensor.strides()) {
-        encodeBuffer(stride, encoding_);
-        encoding_.push_back(' ');
+        encodeBuffer(stride, encoding);
+        encoding.push_back(' ');
       }
-      encoding_.push_back('a');
+      encoding.push_back('a');
       encodeBuffer(
           SchedulerRuntimeInfo::computeAlignmentSize(
               (size_t)input_tensor.data_ptr()),
-          encoding_);
+          encoding);
     } else {
       // encode s for scalar;
-      encoding_.push_back('s');
+      encoding.push_back('s');
       if (scalar_inputs_to_record.find(i) != scalar_inputs_to_record.end()) {
         // Add value of scalars here only if it is one of the scalars
         // provided, as these are used in determining concretization.
@@ -310,13 +745,13 @@ InputsIdLookup::IdLookupReturn InputsIdLookup::lookupId(
         // any DataType might appear via `cast` and `where`, so we handle all
         // cases here.
         if (arg.is<int64_t>()) {
-          encodeBuffer(arg.as<int64_t>(), encoding_);
+          encodeBuffer(arg.as<int64_t>(), encoding);
         } else if (arg.is<bool>()) {
-          encodeBuffer(arg.as<bool>(), encoding_);
+          encodeBuffer(arg.as<bool>(), encoding);
         } else if (arg.is<double>()) {
-          encodeBuffer(arg.as<double>(), encoding_);
+          encodeBuffer(arg.as<double>(), encoding);
         } else if (arg.is<std::complex<double>>()) {
-          encodeBuffer(arg.as<std::complex<double>>(), encoding_);
+          encodeBuffer(arg.as<std::complex<double>>(), encoding);
         } else {
           NVF_THROW(
               "Unhandled input type when creating input ID. Cannot record ",
@@ -324,34 +759,58 @@ InputsIdLookup::IdLookupReturn InputsIdLookup::lookupId(
         }
       }
     }
-    encoding_.push_back(';');
+    encoding.push_back(';');
   }
 
-  auto& entry = encoding_lookup_[encoding_];
-
-  if (entry.id == 0) {
-    // no entry existed for given input set, set id for given entry
-    entry.id = current_id_++;
-    if (used_entry_.size() == max_cache_size_) {
-      // pop least recently used cache;
-      const auto& remove_iter = encoding_lookup_.find(used_entry_.back());
-      used_entry_.pop_back();
-      ret.evict_id = remove_iter->second.id;
-      ret.eviction = true;
-      encoding_lookup_.erase(remove_iter);
-    }
-  } else {
-    // short-cut to leave LRU entry as is
-    if (entry.lru_iter == used_entry_.begin()) {
-      ret.id = entry.id;
+  const uint64_t access =
+      access_counter_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  // Fast path: the entry already exists. Only a shared lock is needed since
+  // recency is recorded atomically in the entry itself.
+  {
+    std::shared_lock<std::shared_mutex> guard(mutex_);
+    auto it = encoding_lookup_.find(std::string_view(encoding));
+    if (it != encoding_lookup_.end()) {
+      it->second.last_access.store(access, std::memory_order_relaxed);
+      ret.id = it->second.id;
       return ret;
     }
+  }
 
-    used_entry_.erase(entry.lru_iter);
+  std::unique_lock<std::shared_mutex> guard(mutex_);
+  auto [entry_it, inserted] = encoding_lookup_.try_emplace(encoding);
+  auto& entry = entry_it->second;
+  entry.last_access.store(access, std::memory_order_relaxed);
+  if (!inserted) {
+    // Another thread inserted the same encoding after our shared lookup
+    ret.id = entry.id;
+    return ret;
+  }
+
+  // no entry existed for given input set, set id for given entry
+  entry.id = current_id_++;
+  if (encoding_lookup_.size() > max_cache_size_) {
+    // evict least recently used cache entry. This linear scan only happens
+    // when inserting, which is followed by a much more expensive cache miss
+    // in FusionExecutorCache anyway.
+    auto remove_it = encoding_lookup_.end();
+    uint64_t oldest_access = std::numeric_limits<uint64_t>::max();
+    for (auto it = encoding_lookup_.begin(); it != encoding_lookup_.end();
+         ++it) {
+      const uint64_t last_access =
+          it->second.last_access.load(std::memory_order_relaxed);
+      if (it != entry_it && last_access < oldest_access) {
+        oldest_access = last_access;
+        remove_it = it;
+      }
+    }
+    NVF_ERROR(remove_it != encoding_lookup_.end());
+    ret.evict_id = remove_it->second.id;
+    ret.eviction = true;
+    encoding_lookup_.erase(remove_it);
   }
 
   ret.id = entry.id;
-  entry.lru_iter = used_entry_.insert(used_entry_.begin(), encoding_);
   return ret;
 }
 
@@ -14,9 +14,12 @@
 
 #include <c10/util/ArrayRef.h>
 
-#include <list>
+#include <atomic>
 #include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -29,6 +32,23 @@ class SegmentedFusion;
 struct ExecutorLog {
   std::unique_ptr<HeuristicParams> params = nullptr;
   ExecutorAbstract* fusion_executor = nullptr;
+  //! High-water mark of the device memory allocated by the most recent
+  //! execution of the whole fusion, not only of the segment above
+  int64_t peak_memory_bytes = 0;
+};
+
+//! A group made only of a CatOp and the PadOps of its inputs, whose inputs are
+//! written by their producing groups directly into the slices of the output
+//! of the CatOp instead of being read again by the group.
+struct CatOutputSlices {
+  //! Position of the group of the CatOp in the run order
+  int64_t cat_run_order_id = -1;
+
+  //! For each input of the CatOp, the position in the run order of the group
+  //! producing it and its position in SegmentedGroup::outputs of that group,
+  //! or -1s if the input is copied into its slice when the CatOp would run,
+  //! e.g., because it's a fusion input.
+  std::vector<std::pair<int64_t, int64_t>> producers;
 };
 
 struct RuntimeWorkSpace {
@@ -37,12 +57,124 @@ struct RuntimeWorkSpace {
 
   //! Pre-determined order to bind tensor input meta data
   std::vector<Val*> group_extent_binding_order;
+
+  //! For each group in group_run_order, the positions of its outputs read by
+  //! the next group. See l2_persistence::findHandoffOutputs.
+  std::vector<std::vector<int64_t>> l2_handoff_outputs;
+
+  //! For each group in group_run_order, pairs of positions in
+  //! SegmentedGroup::outputs and SegmentedGroup::inputs of the outputs that
+  //! can be written into the storage of the inputs. Empty unless
+  //! EnableOption::InplaceSegmentOutputs is set. See findInplaceOutputs.
+  std::vector<std::vector<std::pair<int64_t, int64_t>>> inplace_outputs;
+
+  //! CatOps whose inputs are written into their output by the producing
+  //! groups. Empty unless EnableOption::ZeroCopyCat is set. See
+  //! findCatOutputSlices.
+  std::vector<CatOutputSlices> cat_output_slices;
+
+  //! For each group in group_run_order, the positions in group_run_order of
+  //! the groups producing its inputs
+  std::vector<std::vector<int64_t>> group_producers;
 };
 
 // Perform a topological sort of different groups composiong the Segmented
 // Fusion
 void prepareRuntimeOrder(SegmentedFusion*, RuntimeWorkSpace&);
 
+//! Assigns each group of a run order to one of num_streams streams, 0 being
+//! the stream the fusion runs on, so that groups that don't depend on each
+//! other can run concurrently. group_producers is
+//! RuntimeWorkSpace::group_producers. A group stays on the stream of a
+//! producer that is the last group assigned to it, so that chains of groups
+//! need no synchronization; other groups take the streams in turn.
+NVF_API std::vector<int64_t> assignGroupStreams(
+    const std::vector<std::vector<int64_t>>& group_producers,
+    int64_t num_streams);
+
+//! Returns, for each group of group_run_order, the pairs of an output and an
+//! input of the group such that the output can overwrite the input, which
+//! saves an allocation in long chains of segments. The input must be an
+//! intermediate that no later group reads, and the group must be scheduled
+//! by the pointwise scheduler with only elementwise ops between the input and
+//! the output, so that each element of the input is read before the same
+//! element of the output is written. The output must have the dtype of the
+//! input. Each input and output is in at most one pair. Whether the tensors
+//! have the same sizes and strides is only known at run time, see
+//! allocateOutputs.
+NVF_API std::vector<std::vector<std::pair<int64_t, int64_t>>>
+findInplaceOutputs(
+    const SegmentedFusion* segmented_fusion,
+    const std::vector<SegmentedGroup*>& group_run_order);
+
+//! Returns the groups of group_run_order that only concatenate tensors, i.e.,
+//! that consist of a CatOp and the PadOps of its inputs, and have the output
+//! of the CatOp as their only output. The inputs of the CatOp that are
+//! intermediates only read by the CatOp are planned to be written by their
+//! producing groups into the slices of a buffer allocated for the output of
+//! the CatOp, so that the concatenation reads and writes nothing for them.
+//! Groups with no such input are not returned.
+NVF_API std::vector<CatOutputSlices> findCatOutputSlices(
+    const SegmentedFusion* segmented_fusion,
+    const std::vector<SegmentedGroup*>& group_run_order);
+
+//! Allocates the output of the CatOp of plan, whose sizes are evaluated by
+//! expr_eval bound to the inputs of the complete fusion, and returns it with
+//! its slices for each input of the CatOp.
+std::pair<at::Tensor, std::vector<at::Tensor>> allocateCatOutputSlices(
+    const CatOutputSlices& plan,
+    const std::vector<SegmentedGroup*>& group_run_order,
+    ExpressionEvaluator& expr_eval,
+    const c10::Device& device);
+
+//! Copies the inputs of the CatOp of plan that weren't written into their
+//! slices by their producing groups, given the inputs of the group of the
+//! CatOp, so that the buffer of the slices holds the output of the CatOp.
+void fillCatOutputSlices(
+    const CatOutputSlices& plan,
+    const std::vector<SegmentedGroup*>& group_run_order,
+    const KernelArgumentHolder& group_inputs,
+    const std::vector<at::Tensor>& slices);
+
+//! Computes a cheap signature of the properties of args that most commonly
+//! decide heuristic parameters: the index type and, for each tensor, its
+//! dtype, rank, pointer and stride alignment, and the vectorizable width of
+//! its innermost dimension. Arguments with equal signatures are likely, but
+//! not guaranteed, to produce the same heuristics, so the signature is only
+//! used to order candidates before the full heuristic comparison. See
+//! FusionExecutorCache::getKernelRuntimeFor.
+size_t computeHeuristicSignature(
+    const KernelArgumentHolder& args,
+    std::optional<PrimDataType> forced_index_type = std::nullopt);
+
+//! Computes a coarse class of the shapes of args: the index type and, for
+//! each tensor, its dtype, rank and, for each dimension, whether the extent
+//! is one and the power of two it rounds up to. Segmentation is mostly
+//! decided by the fusion and these properties, so FusionExecutorCache reuses
+//! the segmentation of a concretization across inputs of the same class.
+size_t computeShapeClass(
+    const KernelArgumentHolder& args,
+    std::optional<PrimDataType> forced_index_type = std::nullopt);
+
+//! Returns the extent that represents the bucket of extent for
+//! EnableOption::ShapeBuckets. bucket_width is the width of the buckets, or 0
+//! for buckets bounded by powers of two. Extents up to 64 are kept since
+//! heuristics are most sensitive to them. Larger extents are rounded up to the
+//! bound of their bucket, which is a multiple of 64, plus their largest
+//! power-of-two divisor below 64. This keeps the vectorization factors an
+//! extent allows, so that all extents of a bucket share at most seven
+//! representatives.
+NVF_API int64_t bucketExtent(int64_t extent, int64_t bucket_width);
+
+//! With EnableOption::ShapeBuckets, returns a copy of args whose CUDA tensors
+//! have the extents given by bucketExtent and dense strides in the same order
+//! as the original ones. The copies alias the data of the original tensors
+//! and may only be used for metadata such as computing heuristics. Returns
+//! std::nullopt if the option is not set or a tensor is not dense, e.g.,
+//! expanded or sliced, as its strides can't be rounded consistently.
+std::optional<KernelArgumentHolder> bucketArgs(
+    const KernelArgumentHolder& args);
+
 //! Simple hasher for pair<T, const U*>. There is no default hasher for pairs,
 //! since there are a lot of options how to combine hashes. In a case where one
 //! element of the pair is unlikely to change much, the following hash is fast
@@ -98,21 +230,26 @@ class ArgumentManager {
   ArgumentManager(ArgumentManager&&) = default;
   ArgumentManager& operator=(ArgumentManager&&) = default;
 
-  // This map is only taken on destruction. It might be good to steal the tensor
-  // map instead of make a copy.
   std::unordered_map<Val*, PolymorphicValue> getTensorMap() const {
     return tensor_map_;
   }
 
+  // Moves the tensor map out, leaving this ArgumentManager empty. Used when
+  // the map is only needed after the last segment.
+  std::unordered_map<Val*, PolymorphicValue> takeTensorMap() {
+    return std::move(tensor_map_);
+  }
+
   const PolymorphicValue& checkTensorMap(Val* v) const;
 
   // Translate a vector of Vals to their corresponding entries in tensor_map_
   KernelArgumentHolder translateValsToArgs(const std::vector<Val*>& vals) const;
 
-  // Update argument manager with outputs from a segment
+  // Update argument manager with outputs from a segment. The outputs are
+  // moved into the tensor map.
   void updateWithSegmentOutputs(
       const std::vector<Val*>& group_outputs,
-      const KernelArgumentHolder& group_runtime_outputs,
+      KernelArgumentHolder group_runtime_outputs,
       const int64_t group_id);
 
   std::string toString() const {
@@ -148,6 +285,14 @@ class ArgumentManager {
 //! grow gigantic when we have input shapes that does not stabalize to a finite
 //! set.
 //!
+//! lookupId is safe to call from multiple threads. Inputs are encoded into a
+//! thread-local buffer, and the lookup of an existing entry only takes a
+//! shared lock, so concurrent cache hits do not serialize. Recency is tracked
+//! with a monotonic access counter stored in each entry rather than by
+//! reordering a list, which means hits never need exclusive access. The
+//! exclusive lock is only taken to insert a new entry and evict the least
+//! recently used one.
+//!
 //! \note the uniqueness of the ide generated for a given input set is only
 //!   local to the instance of `InputsIdLookup`.
 //!
@@ -196,6 +341,7 @@ class InputsIdLookup : public NonCopyable {
 
   //! debugging API that returns the size of lookup table
   size_t size() const {
+    std::shared_lock<std::shared_mutex> guard(mutex_);
     return encoding_lookup_.size();
   }
 
@@ -207,18 +353,25 @@ class InputsIdLookup : public NonCopyable {
   void deserialize(const serde::InputsIdLookup* buffer);
 
  private:
-  // string to store encoded input meta information. Reuse the buffer instead of
-  // stringtream gives few us perf gain.
-  std::string encoding_; // Note: shared state, guarded by mutex_
-
-  // mutex_ used to guard reused encoding_
-  std::mutex mutex_;
+  //! mutex_ guards the structure of encoding_lookup_ and current_id_. Hits
+  //! only need a shared lock; insertion and eviction need an exclusive one.
+  mutable std::shared_mutex mutex_;
 
   //! entry stored in `encoding_lookup_` to implement LRU
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
   struct EncodingEntry {
     size_t id = 0;
-    std::list<std::string>::iterator lru_iter;
+    //! Value of access_counter_ at the most recent lookup of this entry.
+    //! Updated atomically on hits while only holding a shared lock.
+    std::atomic<uint64_t> last_access{0};
+  };
+
+  //! Hash and equality that allow looking up a std::string key with a
+  //! std::string_view, so that hits do not copy the encoding.
+  struct EncodingHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view encoding) const {
+      return std::hash<std::string_view>{}(encoding);
+    }
   };
 
   //! maximum cache size for LRU
@@ -228,15 +381,14 @@ class InputsIdLookup : public NonCopyable {
   //! conflicts
   size_t current_id_ = 1;
 
-  //! entry in the cache, This is used to implement LRU cache, where entries in
-  //! the list is ordered by their recent usage (freshly used entry is placed at
-  //! the beginning)
-  std::list<std::string> used_entry_;
+  //! Monotonic counter used to order entries by their recent usage. The entry
+  //! with the smallest last_access is the least recently used one.
+  std::atomic<uint64_t> access_counter_{0};
 
-  //! map from `std::string` to a unique id `size_t` (packaged in
-  //! `EncodingEntry`
-  //! ). We store an iterator to `used_entry_` to implement LRU
-  std::unordered_map<std::string, EncodingEntry> encoding_lookup_;
+  //! map from the encoded inputs to a unique id `size_t` (packaged in
+  //! `EncodingEntry`) along with its most recent access
+  std::unordered_map<std::string, EncodingEntry, EncodingHash, std::equal_to<>>
+      encoding_lookup_;
 };
 
 } // namespace nvfuser
@@ -31,8 +31,70 @@
 #include <scheduler/registry.h>
 #include <utils.h>
 
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <string_view>
+
 namespace nvfuser {
 
+namespace {
+
+// Whether the runtime can run all inputs of a shape bucket with the heuristics
+// computed for its representative. The pointwise and transpose schedulers only
+// constrain the block size of their kernels, which depends on the heuristic
+// parameters compared by HeuristicParams::sameAs, and leave the grid to be
+// inferred from the actual extents.
+bool allowsShapeBuckets(FusionKernelRuntime* kernel_runtime) {
+  const auto& heuristics =
+      kernel_runtime->schedulerHeuristics()->heuristicsList();
+  return std::all_of(
+      heuristics.begin(), heuristics.end(), [](const auto& params) {
+        switch (params->scheduler_type) {
+          case SchedulerType::NoOp:
+          case SchedulerType::ExprEval:
+          case SchedulerType::PointWise:
+          case SchedulerType::Transpose:
+            return true;
+          default:
+            return false;
+        }
+      });
+}
+
+// Returns the lowest index of the devices whose properties, as far as the
+// schedulers look at them, are those of device. Devices of the same kind
+// segment a fusion the same way, so they share their segmentations.
+int8_t segmentationDevice(int8_t device) {
+  static const std::vector<int8_t> representatives = []() {
+    const auto num_devices = at::cuda::getNumGPUs();
+    std::vector<int8_t> representatives(num_devices);
+    for (auto i : arange(num_devices)) {
+      const cudaDeviceProp* prop = at::cuda::getDeviceProperties(i);
+      representatives.at(i) = (int8_t)i;
+      for (auto j : arange(i)) {
+        const cudaDeviceProp* other = at::cuda::getDeviceProperties(j);
+        if (std::string_view(prop->name) == other->name &&
+            prop->major == other->major && prop->minor == other->minor &&
+            prop->multiProcessorCount == other->multiProcessorCount &&
+            prop->sharedMemPerBlockOptin == other->sharedMemPerBlockOptin &&
+            prop->regsPerBlock == other->regsPerBlock &&
+            prop->l2CacheSize == other->l2CacheSize) {
+          representatives.at(i) = (int8_t)j;
+          break;
+        }
+      }
+    }
+    return representatives;
+  }();
+  if (device < 0 || device >= std::ssize(representatives)) {
+    return device;
+  }
+  return representatives.at(device);
+}
+
+} // namespace
+
 FusionExecutorCache::FusionExecutorCache(
     std::unique_ptr<Fusion> fusion,
     int64_t fusion_id,
@@ -45,7 +107,8 @@ FusionExecutorCache::FusionExecutorCache(
 KernelArgumentHolder FusionExecutorCache::runFusionWithInputs(
     KernelArgumentHolder args,
     std::optional<PrimDataType> forced_index_type,
-    std::optional<int8_t> selected_device) {
+    std::optional<int8_t> selected_device,
+    const KernelArgumentHolder& outputs) {
   FUSER_PERF_SCOPE("FusionExecutorCache::runFusionWithInputs");
 
   if (isProfilerEnabled()) {
@@ -53,18 +116,55 @@ KernelArgumentHolder FusionExecutorCache::runFusionWithInputs(
   }
 
   args.setDeviceIndex(selected_device);
-  setCacheId(args);
-  auto kernel_runtime = getKernelRuntimeFor(args, forced_index_type);
+  FusionKernelRuntime* kernel_runtime = nullptr;
+  FusionSampler* sampler = nullptr;
+  {
+    // Finding and compiling a runtime mutates the cache, but running a
+    // compiled runtime does not, so only this part is serialized when
+    // multiple threads run this fusion.
+    std::lock_guard<std::mutex> guard(mutex_);
+    setCacheId(args);
+    kernel_runtime = getKernelRuntimeFor(args, forced_index_type);
+
+    if (isProfilerEnabled()) {
+      FusionProfiler::createSegments(kernel_runtime->executors().size());
+    }
 
-  if (isProfilerEnabled()) {
-    FusionProfiler::createSegments(kernel_runtime->executors().size());
-  }
+    if (!kernel_runtime->isCompiling() && !kernel_runtime->isCompiled()) {
+      // ExpressionEvaluator reduces with ATen, whose results don't match
+      // the kernels bit for bit
+      const bool can_run_with_fallback =
+          !isOptionEnabled(EnableOption::HostIrLowering) &&
+          !isOptionEnabled(EnableOption::Deterministic) &&
+          !isProfilerEnabled() && kernel_runtime->canRunWithFallback();
+      if (can_run_with_fallback && shouldDeferCompilation(args)) {
+        // With tiered compilation, inputs that have been run only a few
+        // times are evaluated with ExpressionEvaluator without compiling.
+        kernel_runtime->deferCompilation();
+      } else if (
+          can_run_with_fallback &&
+          (isOptionEnabled(EnableOption::AsyncCompile) ||
+           isOptionEnabled(EnableOption::TieredCompile))) {
+        // With async compilation, this and subsequent calls evaluate the
+        // fusion with ExpressionEvaluator until the kernels are ready
+        // instead of blocking all callers on the compilation.
+        kernel_runtime->compileFusionAsync(args);
+      } else {
+        kernel_runtime->compileFusionParallel(args);
+      }
+    }
 
-  if (!kernel_runtime->isCompiled()) {
-    kernel_runtime->compileFusionParallel(args);
-  }
+    most_recent_runtime_ = kernel_runtime;
 
-  most_recent_runtime_ = kernel_runtime;
+    if (FusionSampler::isEnabled()) {
+      if (sampler_ == nullptr) {
+        sampler_ = std::make_unique<FusionSampler>(fusion_id_);
+      }
+      sampler = sampler_.get();
+    }
+  }
+  SampledExecutionGuard sampled_execution_guard(
+      sampler, c10::cuda::getCurrentCUDAStream(args.getDeviceIndex()));
 
   auto fusion = kernel_runtime->fusionSegments()->completeFusion();
 
@@ -77,7 +177,38 @@ KernelArgumentHolder FusionExecutorCache::runFusionWithInputs(
         " failed");
   }
 
-  auto outputs = kernel_runtime->runWithInputs(args);
+  // The given tensors are for the returned outputs, so hidden outputs get
+  // none.
+  KernelArgumentHolder user_outputs;
+  if (!outputs.empty()) {
+    const auto num_returned = std::count_if(
+        fusion->outputs().begin(), fusion->outputs().end(), [&](Val* out) {
+          return !fusion->getOutputAlias(out).hide_output;
+        });
+    NVF_CHECK_EQ(
+        outputs.size(),
+        num_returned,
+        "A tensor must be given for each output of the fusion.");
+    int64_t next_output = 0;
+    for (Val* out : fusion->outputs()) {
+      if (fusion->getOutputAlias(out).hide_output) {
+        user_outputs.push(std::monostate());
+        continue;
+      }
+      const PolymorphicValue& user_out = outputs[next_output++];
+      NVF_CHECK(
+          user_out.is<at::Tensor>() &&
+              user_out.as<at::Tensor>().scalar_type() ==
+                  data_type_to_aten(out->dtype()),
+          "Output ",
+          out->toString(),
+          " must be given a tensor of dtype ",
+          out->dtype());
+      user_outputs.push(user_out);
+    }
+  }
+
+  auto all_outputs = kernel_runtime->runWithInputs(args, user_outputs);
 
   // Kernel time measurement is off by default
   kernel_runtime->disableKernelTimeMeasurement();
@@ -85,13 +216,33 @@ KernelArgumentHolder FusionExecutorCache::runFusionWithInputs(
   // Removing aliased outputs, since those are updated by the Fusion. It is not
   // semantically correct to actually return them as outputs from
   // fusion.
-  NVF_ERROR_EQ(std::ssize(fusion->outputs()), outputs.size());
+  NVF_ERROR_EQ(std::ssize(fusion->outputs()), all_outputs.size());
   KernelArgumentHolder unaliased_outputs;
-  for (auto out_index : arange(outputs.size())) {
+  for (auto out_index : arange(all_outputs.size())) {
     Val* out = fusion->outputs()[out_index];
     if (!fusion->getOutputAlias(out).hide_output) {
-      unaliased_outputs.push(outputs[out_index]);
+      unaliased_outputs.push(all_outputs[out_index]);
+    }
+  }
+
+  // Outputs that no kernel wrote into the given tensors, e.g., those
+  // evaluated as views of inputs, are copied into them.
+  for (auto i : arange(outputs.size())) {
+    const auto& user_out = outputs[i].as<at::Tensor>();
+    const auto& out = unaliased_outputs[i].as<at::Tensor>();
+    if (out.is_same(user_out)) {
+      continue;
     }
+    NVF_CHECK(
+        out.sizes() == user_out.sizes(),
+        "The tensor given for output ",
+        i,
+        " has sizes ",
+        user_out.sizes(),
+        ", but the output has sizes ",
+        out.sizes());
+    user_out.copy_(out);
+    unaliased_outputs[i] = user_out;
   }
 
   // NOTE: This should be the last code in the method to capture all host time
@@ -131,6 +282,7 @@ bool FusionExecutorCache::isCompiled(
 
   // Access kernels associated with the common device id
   KernelArgumentHolder args(inputs);
+  std::lock_guard<std::mutex> guard(mutex_);
   setCacheId(args);
   return getKernelRuntimeFor(args)->isCompiled();
 }
@@ -241,6 +393,11 @@ std::string FusionExecutorCache::getMostRecentScheduledIr(
   return getScheduledIr(most_recent_runtime_, tensor_transforms);
 }
 
+std::string FusionExecutorCache::getMostRecentRemarks() const {
+  NVF_CHECK(most_recent_runtime_ != nullptr, "Fusion has not been executed!");
+  return most_recent_runtime_->getRemarks();
+}
+
 std::string FusionExecutorCache::getScheduledIrFor(
     KernelArgumentHolder args,
     bool tensor_transforms) {
@@ -267,6 +424,42 @@ FusionExecutorCache::getKernelRuntimes() const {
   return kernel_runtimes_;
 }
 
+ExecutorCacheMemoryUsage FusionExecutorCache::memoryUsage() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  ExecutorCacheMemoryUsage usage;
+  usage.ir_bytes += fusion_->arenaBytes();
+  for (const auto& [conc_info, runtimes] : kernel_runtimes_) {
+    for (const auto& runtime : runtimes) {
+      usage.ir_bytes +=
+          runtime->fusionSegments()->completeFusion()->arenaBytes();
+      for (const auto& executor : runtime->executors()) {
+        auto* ke = dynamic_cast<KernelExecutor*>(executor.get());
+        if (ke == nullptr || !ke->isCompiled()) {
+          continue;
+        }
+        usage.module_bytes += ke->moduleBytes();
+        usage.buffer_bytes += ke->retainedBufferBytes();
+        usage.ir_bytes += ke->compiledKernel()->kernel()->arenaBytes();
+      }
+    }
+  }
+  return usage;
+}
+
+FusionSamples FusionExecutorCache::sampledLatencies() {
+  FusionSampler* sampler = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    sampler = sampler_.get();
+  }
+  if (sampler == nullptr) {
+    FusionSamples samples;
+    samples.fusion_id = fusion_id_;
+    return samples;
+  }
+  return sampler->samples();
+}
+
 //! Count concretizations. Note that each might have multiple
 //! FusionKernelRuntimes. If device is given, count only concretizations on
 //! the given device; otherwise count concretizations on all devices.
@@ -371,6 +564,28 @@ flatbuffers::Offset<serde::FusionExecutorCache> FusionExecutorCache::serialize(
           kernel_runtime_ptr, kernel_cache_ordering.size());
     }
 
+    // Record the heuristic signatures each runtime was used with by its index
+    // in device_runtimes, so that restored runtimes are tried first for them.
+    std::vector<size_t> signature_keys;
+    std::vector<size_t> signature_values;
+    auto signature_it = runtime_signature_index_.find(device_concrete_key);
+    if (signature_it != runtime_signature_index_.end()) {
+      for (auto&& [signature, signature_runtimes] : signature_it->second) {
+        for (FusionKernelRuntime* runtime : signature_runtimes.runtimes) {
+          auto runtime_it = std::find_if(
+              device_runtimes.begin(),
+              device_runtimes.end(),
+              [runtime](const auto& device_runtime) {
+                return device_runtime.get() == runtime;
+              });
+          NVF_ERROR(runtime_it != device_runtimes.end());
+          signature_keys.push_back(signature);
+          signature_values.push_back(
+              std::distance(device_runtimes.begin(), runtime_it));
+        }
+      }
+    }
+
     // We recompute the DynamicTransformConcretizationInfo during
     // deserialization using a metadata copy of kernel inputs.
     auto&& [device_id, conc_info] = device_concrete_key;
@@ -379,7 +594,9 @@ flatbuffers::Offset<serde::FusionExecutorCache> FusionExecutorCache::serialize(
         device_id,
         conc_info_id_map_.at(device_concrete_key),
         (conc_info != nullptr),
-        &fb_device_runtimes));
+        &fb_device_runtimes,
+        &signature_keys,
+        &signature_values));
   }
 
   // 2. Serialize input id to kernel cache
@@ -500,6 +717,17 @@ void FusionExecutorCache::deserialize(
 
       all_runtimes.emplace_back(device_runtimes.back().get());
     }
+
+    // Restore the heuristic signatures the runtimes were used with
+    if (fb_device_runtimes->signature_keys() != nullptr) {
+      auto& signature_index = runtime_signature_index_[config];
+      for (auto idx : arange(fb_device_runtimes->signature_keys()->size())) {
+        size_t signature = fb_device_runtimes->signature_keys()->Get(idx);
+        size_t runtime_id = fb_device_runtimes->signature_values()->Get(idx);
+        signature_index[signature].record(
+            device_runtimes.at(runtime_id).get());
+      }
+    }
   }
 
   // 2. Rebuild input id to kernel cache
@@ -510,7 +738,24 @@ void FusionExecutorCache::deserialize(
   }
 }
 
+bool FusionExecutorCache::shouldDeferCompilation(
+    const KernelArgumentHolder& args) {
+  if (!isOptionEnabled(EnableOption::TieredCompile)) {
+    return false;
+  }
+  NVF_ERROR(args.getCacheId().has_value());
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::TieredCompile);
+  constexpr int64_t default_threshold = 2;
+  const int64_t threshold =
+      option_args.empty() ? default_threshold : std::stoll(option_args[0]);
+  // This run is the num_runs-th one with these inputs
+  const int64_t num_runs = ++num_runs_before_compile_[*args.getCacheId()];
+  return num_runs < threshold;
+}
+
 void FusionExecutorCache::evictCache(size_t cache_id) {
+  num_runs_before_compile_.erase(cache_id);
   auto it = id_to_kernel_runtime_.find(cache_id);
   NVF_ERROR(it != id_to_kernel_runtime_.end());
   it->second->evictCache(cache_id);
@@ -530,7 +775,9 @@ void FusionExecutorCache::evictCache(size_t cache_id) {
 //   segmenting and compiling new kernels. Otherwise, we check whether we can
 //   re-use any of the previously-segmented runtimes.
 //      i. We look at all FusionKernelRuntimes that have been used with
-//      this concretized fusion.
+//      this concretized fusion, starting with those previously used with
+//      inputs of the same heuristic signature (see
+//      computeHeuristicSignature).
 //      ii. For each of those runtimes, we compare the heuristic parameters
 //      for each segment to those that we compute using the current inputs.
 //   If we do not find any runtimes whose heuristic parameters match, then we
@@ -565,9 +812,11 @@ FusionKernelRuntime* FusionExecutorCache::getKernelRuntimeFor(
     // if its index type does not match with the forced type
     if (!forced_index_type.has_value() ||
         forced_index_type.value() == id_it->second->getIndexType()) {
+      ++runtime_cache_stats_.hits;
       return id_it->second;
     }
   }
+  ++runtime_cache_stats_.misses;
 
   // Compute or get cached initial concretization info
   const auto& initial_info = initialInfo();
@@ -575,13 +824,7 @@ FusionKernelRuntime* FusionExecutorCache::getKernelRuntimeFor(
   // Compute concretization info to use as cache key
   DynamicTransformConcretizationInfo* conc_info = nullptr;
   if (initial_info.isDynamic()) {
-    // This class needs to own conc_info so it can be compared in subsequent
-    // invocations.
-    auto expr_eval = executor_utils::bindInputs(args, fusion_.get());
-    cached_conc_info_.emplace_back(
-        std::make_unique<DynamicTransformConcretizationInfo>(
-            &initial_info, &expr_eval, &exact_map_));
-    conc_info = cached_conc_info_.back().get();
+    conc_info = getConcretizationInfo(args);
   }
 
   // Initialize or fetch vector of FusionKernelRuntime objects associated with
@@ -595,6 +838,16 @@ FusionKernelRuntime* FusionExecutorCache::getKernelRuntimeFor(
     deterministic_conc_info_.emplace_back(device_concrete_key);
   }
 
+  // With shape buckets, heuristics are computed from and compared with the
+  // representatives of the input extents, while the runtime still runs args.
+  std::optional<KernelArgumentHolder> bucketed_args;
+  if (supportsShapeBuckets() &&
+      exact_shape_concretizations_.count(device_concrete_key) == 0) {
+    bucketed_args = bucketArgs(args);
+  }
+  const KernelArgumentHolder& heuristic_args =
+      bucketed_args.has_value() ? bucketed_args.value() : args;
+
   // Check for re-use hit case
   //  a kernel runtime is re-usable if all the compiled
   //  kernels have the same heuristic parameters
@@ -611,33 +864,61 @@ FusionKernelRuntime* FusionExecutorCache::getKernelRuntimeFor(
   // of input shapes we segment and compile a new FusionKernelRuntime.
   // Effectively, this option disables Paths 2 and 3 above so that we only
   // have Path 1 (hottest re-use path) and Path 4 (full recompile).
+  const size_t heuristic_signature =
+      computeHeuristicSignature(heuristic_args, forced_index_type);
+  auto& signature_runtimes =
+      runtime_signature_index_[device_concrete_key][heuristic_signature];
   if (!isOptionDisabled(DisableOption::KernelReuse)) {
     FUSER_PERF_SCOPE("FusionExecutorCache::getKernelRuntimeFor::reuseKRT");
-    auto runtime_it = std::find_if(
-        kernel_runtimes.begin(),
-        kernel_runtimes.end(),
-        [&args, &new_heuristics, &forced_index_type](auto& kernel_runtime) {
-          auto maybe_heuristics =
-              kernel_runtime->getMaybeHeuristicsFor(args, forced_index_type);
-          if (!maybe_heuristics.has_value()) {
-            return false;
-          }
-          new_heuristics = std::move(maybe_heuristics.value());
-          return true;
-        });
-    if (runtime_it != kernel_runtimes.end()) {
-      kernel_runtime = runtime_it->get();
+    auto can_reuse = [&heuristic_args,
+                      &new_heuristics,
+                      &forced_index_type,
+                      bucketed = bucketed_args.has_value()](
+                         FusionKernelRuntime* kernel_runtime) {
+      if (bucketed && !allowsShapeBuckets(kernel_runtime)) {
+        return false;
+      }
+      auto maybe_heuristics = kernel_runtime->getMaybeHeuristicsFor(
+          heuristic_args, forced_index_type);
+      if (!maybe_heuristics.has_value()) {
+        return false;
+      }
+      new_heuristics = std::move(maybe_heuristics.value());
+      return true;
+    };
+
+    // Runtimes already used with inputs of the same heuristic signature are
+    // the most likely to match, so try them first. The most recently
+    // recorded runtime is tried first.
+    std::vector<FusionKernelRuntime*>& runtimes = signature_runtimes.runtimes;
+    auto sig_it = std::find_if(runtimes.rbegin(), runtimes.rend(), can_reuse);
+    if (sig_it != runtimes.rend()) {
+      kernel_runtime = *sig_it;
+    } else if (runtimes.size() < kernel_runtimes.size()) {
+      // Signature collisions aside, a runtime used with different signatures
+      // may still be compatible. The signature ignores extents, so runtimes
+      // that rejected earlier inputs of this signature are checked again.
+      auto runtime_it = std::find_if(
+          kernel_runtimes.begin(),
+          kernel_runtimes.end(),
+          [&signature_runtimes, &can_reuse](auto& kernel_runtime) {
+            FusionKernelRuntime* runtime = kernel_runtime.get();
+            return signature_runtimes.recorded.count(runtime) == 0 &&
+                can_reuse(runtime);
+          });
+      if (runtime_it != kernel_runtimes.end()) {
+        kernel_runtime = runtime_it->get();
+        signature_runtimes.record(kernel_runtime);
+      }
+    }
+    if (kernel_runtime != nullptr) {
       kernel_runtime->updateHeuristicsLaunchParams(new_heuristics.get());
       id_to_kernel_runtime_[unique_id] = kernel_runtime;
       return kernel_runtime;
     }
   }
 
-  {
-    FUSER_PERF_SCOPE("FusionExecutorCache::getKernelRuntimeFor::compileNewKRT");
-    // Paths 3 or 4
-    // cache miss, need to re-build an optimized graph for this case
-
+  auto concretize = [&]() {
     // Clone fusion_ so that we can safely concretize it
     auto conc_fusion = std::make_unique<Fusion>(*fusion_);
     if (initial_info.isDynamic()) {
@@ -664,17 +945,88 @@ FusionKernelRuntime* FusionExecutorCache::getKernelRuntimeFor(
         conc_fusion->print();
       }
     }
-    FusionGuard fg(conc_fusion.get());
-    kernel_runtimes.emplace_back(std::make_unique<FusionKernelRuntime>(
-        std::move(conc_fusion),
-        args,
-        /*serde_buffer=*/nullptr,
-        forced_index_type,
-        fusion_id_,
-        conc_info_id_map_.at(device_concrete_key),
-        kernel_runtimes.size(),
-        auto_schedule_));
-    kernel_runtime = kernel_runtimes.back().get();
+    return conc_fusion;
+  };
+
+  auto make_runtime = [&](const KernelArgumentHolder& runtime_args) {
+    // Runtimes of a concretization share the compile-time heuristic data of
+    // the segments they have in common. The latest runtime is the most likely
+    // to be segmented like the new one.
+    FusionKernelRuntime* heuristic_data_source =
+        kernel_runtimes.empty() ? nullptr : kernel_runtimes.back().get();
+    auto new_runtime = [&](const serde::SegmentedFusion* cached_segmentation) {
+      std::unique_ptr<Fusion> conc_fusion = concretize();
+      FusionGuard fg(conc_fusion.get());
+      return std::make_unique<FusionKernelRuntime>(
+          std::move(conc_fusion),
+          runtime_args,
+          /*serde_buffer=*/nullptr,
+          forced_index_type,
+          fusion_id_,
+          conc_info_id_map_.at(device_concrete_key),
+          kernel_runtimes.size(),
+          auto_schedule_,
+          heuristic_data_source,
+          cached_segmentation);
+    };
+
+    // NVFUSER_DISABLE=kernel_reuse segments every new runtime for its inputs
+    if (isOptionDisabled(DisableOption::KernelReuse)) {
+      kernel_runtimes.emplace_back(new_runtime(nullptr));
+      return;
+    }
+
+    const size_t shape_class =
+        computeShapeClass(runtime_args, forced_index_type);
+    auto& segmentations = segmentation_cache_[std::make_pair(
+        segmentationDevice(args.getDeviceIndex()), conc_info)];
+    auto segmentation_it = segmentations.find(shape_class);
+    if (segmentation_it != segmentations.end()) {
+      std::unique_ptr<FusionKernelRuntime> runtime =
+          new_runtime(flatbuffers::GetRoot<serde::SegmentedFusion>(
+              segmentation_it->second.data()));
+      if (runtime->isValid()) {
+        ++runtime_cache_stats_.segmentation_reuses;
+        kernel_runtimes.push_back(std::move(runtime));
+        return;
+      }
+    }
+
+    // Segment for runtime_args and cache the result, replacing a cached
+    // segmentation that failed the runtime checks
+    kernel_runtimes.emplace_back(new_runtime(nullptr));
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(
+        kernel_runtimes.back()->fusionSegments()->serialize(builder));
+    if (flatbuffers::GetRoot<serde::SegmentedFusion>(builder.GetBufferPointer())
+            ->valid()) {
+      segmentations.insert_or_assign(shape_class, builder.Release());
+    }
+  };
+
+  {
+    FUSER_PERF_SCOPE("FusionExecutorCache::getKernelRuntimeFor::compileNewKRT");
+    // Paths 3 or 4
+    // cache miss, need to re-build an optimized graph for this case
+    ++runtime_cache_stats_.recompiles;
+    make_runtime(heuristic_args);
+    if (bucketed_args.has_value() &&
+        !allowsShapeBuckets(kernel_runtimes.back().get())) {
+      // The segments can't share heuristics across a bucket. Segment again
+      // with the exact extents, which all later inputs of this
+      // concretization use too.
+      kernel_runtimes.pop_back();
+      exact_shape_concretizations_.insert(device_concrete_key);
+      make_runtime(args);
+      kernel_runtime = kernel_runtimes.back().get();
+      const size_t exact_signature =
+          computeHeuristicSignature(args, forced_index_type);
+      runtime_signature_index_[device_concrete_key][exact_signature].record(
+          kernel_runtime);
+    } else {
+      kernel_runtime = kernel_runtimes.back().get();
+      signature_runtimes.record(kernel_runtime);
+    }
 
     if (profiling_) {
       kernel_runtime->profile(true);
@@ -684,6 +1036,92 @@ FusionKernelRuntime* FusionExecutorCache::getKernelRuntimeFor(
   }
 }
 
+bool FusionExecutorCache::supportsShapeBuckets() {
+  if (!supports_shape_buckets_.has_value()) {
+    const std::vector<Val*>& inputs = fusion_->inputs();
+    const std::vector<Expr*> exprs = fusion_->exprs();
+    const std::vector<TensorView*> tvs = fusion_->allTvs();
+    // Extents fixed at definition can't be rounded with the input extents
+    // they are mapped to
+    auto has_large_constant_extent = [](TensorView* tv) {
+      return std::any_of(
+          tv->getLogicalDomain().begin(),
+          tv->getLogicalDomain().end(),
+          [](IterDomain* id) {
+            return id->extent()->isConstInt() &&
+                id->extent()->evaluate().as<int64_t>() > 64;
+          });
+    };
+    supports_shape_buckets_ = !initialInfo().isDynamic() &&
+        std::all_of(inputs.begin(),
+                    inputs.end(),
+                    [](Val* in) { return in->isA<TensorView>(); }) &&
+        std::none_of(exprs.begin(),
+                     exprs.end(),
+                     [](Expr* expr) {
+                       return expr->isOneOf<ViewOp, SliceOp, PadOp, CatOp>();
+                     }) &&
+        std::none_of(tvs.begin(), tvs.end(), has_large_constant_extent);
+  }
+  return supports_shape_buckets_.value();
+}
+
+DynamicTransformConcretizationInfo* FusionExecutorCache::getConcretizationInfo(
+    const KernelArgumentHolder& args) {
+  FUSER_PERF_SCOPE("FusionExecutorCache::getConcretizationInfo");
+  const auto& initial_info = initialInfo();
+  auto expr_eval = executor_utils::bindInputs(args, fusion_.get());
+
+  // Values that can't be evaluated before propagating them through the exact
+  // map, or that aren't integers, leave the inputs without a key
+  std::optional<std::vector<int64_t>> key = std::vector<int64_t>();
+  auto push_key = [&](Val* val, bool zero_only) {
+    if (!key.has_value()) {
+      return;
+    }
+    PolymorphicValue value = expr_eval.evaluate(val);
+    if (!value.is<int64_t>()) {
+      key.reset();
+      return;
+    }
+    key->push_back(zero_only ? value.as<int64_t>() == 0 : value.as<int64_t>());
+  };
+  for (Val* val : initial_info.getRootValsAffectingConcretization()) {
+    push_key(val, /*zero_only=*/false);
+  }
+  for (Val* extent : initial_info.getRootExtentsCheckedForZero()) {
+    push_key(extent, /*zero_only=*/true);
+  }
+  if (key.has_value()) {
+    auto it = conc_info_by_key_.find(*key);
+    if (it != conc_info_by_key_.end()) {
+      ++runtime_cache_stats_.conc_info_reuses;
+      return it->second;
+    }
+  }
+
+  // This class needs to own conc_info so it can be compared in subsequent
+  // invocations. Inputs with different keys may still concretize the same
+  // way, e.g., reshapes of different extents splitting the same axes.
+  auto new_conc_info = std::make_unique<DynamicTransformConcretizationInfo>(
+      &initial_info, &expr_eval, &exact_map_);
+  DynamicTransformConcretizationInfo* conc_info = nullptr;
+  for (const auto& cached : cached_conc_info_) {
+    if (*cached == *new_conc_info) {
+      conc_info = cached.get();
+      break;
+    }
+  }
+  if (conc_info == nullptr) {
+    cached_conc_info_.push_back(std::move(new_conc_info));
+    conc_info = cached_conc_info_.back().get();
+  }
+  if (key.has_value()) {
+    conc_info_by_key_.emplace(std::move(*key), conc_info);
+  }
+  return conc_info;
+}
+
 DynamicTransformInitialInfo& FusionExecutorCache::initialInfo() {
   if (!initial_info_.has_value()) {
     initial_info_ = DynamicTransform::getInitialInfo(fusion());
@@ -13,14 +13,17 @@
 #include <fusion.h>
 #include <fusion_segmenter.h>
 #include <runtime/fusion_cache_utils.h>
+#include <runtime/sampling_profiler.h>
 #include <scheduler/heuristic.h>
 #include <serde/fusion_cache_generated.h>
 
 #include <c10/util/ArrayRef.h>
 
 #include <mutex>
+#include <optional>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace nvfuser {
 class DynamicTransformConcretizationInfo;
@@ -109,11 +112,47 @@ enum class PrimDataType;
 //!     d) rank;
 //!     e) scalar type;
 //!
+//! With EnableOption::ShapeBuckets, heuristics of fusions scheduled by the
+//! pointwise and transpose schedulers are computed from the extents given by
+//! bucketExtent instead of the actual ones. Kernels keep their extents
+//! symbolic and their launch constraints of these schedulers don't depend on
+//! the extents, so inputs whose extents fall in the same bucket reuse the same
+//! FusionKernelRuntime without rescheduling or recompiling. Concretizations
+//! segmented into other schedulers fall back to the exact extents.
+//!
 //! [ Note -- Segmented Fusion Tentative Design ]
 //! Segmentation adds an extra dimension in caching. Initial implementation,
 //! assumed graph partition strategy is independent of input pattern, which we
 //! can revisit once we have more advanced graph segmentation logic Each
 //! FusionExecutorCache corresponds to one graph and one graph segmentation.
+//! Counts of the lookups of FusionExecutorCache::getKernelRuntimeFor
+struct RuntimeCacheStats {
+  //! Inputs whose ID already mapped to a runtime
+  int64_t hits = 0;
+  //! Inputs with a new ID, i.e., reuses of an existing runtime plus recompiles
+  int64_t misses = 0;
+  //! Misses that segmented and compiled a new FusionKernelRuntime
+  int64_t recompiles = 0;
+  //! Recompiles that reused a cached segmentation instead of segmenting
+  int64_t segmentation_reuses = 0;
+  //! Misses of a dynamic fusion that reused the concretization info of
+  //! earlier inputs agreeing on the values affecting concretization
+  int64_t conc_info_reuses = 0;
+};
+
+//! Estimates of the memory held by a FusionExecutorCache, see
+//! FusionExecutorCache::memoryUsage
+struct ExecutorCacheMemoryUsage {
+  //! Device memory of the loaded kernel modules, estimated by the sizes of
+  //! their binaries
+  int64_t module_bytes = 0;
+  //! Device memory of the intermediate buffers retained between launches
+  int64_t buffer_bytes = 0;
+  //! Host memory of the statements of the fusion, of its segmentations and of
+  //! the lowered kernels, see IrContainer::arenaBytes
+  int64_t ir_bytes = 0;
+};
+
 class FusionExecutorCache {
  public:
   //! create new fusion executor cache at a given device to handle kernel
@@ -135,10 +174,18 @@ class FusionExecutorCache {
   //! WARING: Correctness is not guaranteed.
   //! TODO: Check usage of forced_index_type. It's a lot of plumbing, what's the
   //! value.
+  //!
+  //! If `outputs` is not empty, it has a tensor for each returned output,
+  //! i.e., each output not hidden by an alias, and the outputs are written
+  //! into these tensors and returned. Kernels write into them directly, which
+  //! requires them to have the sizes, strides and dtype of the outputs.
+  //! Outputs that aren't produced by a kernel, e.g., views of inputs, are
+  //! copied into them.
   NVF_API KernelArgumentHolder runFusionWithInputs(
       KernelArgumentHolder args,
       std::optional<PrimDataType> forced_index_type = std::nullopt,
-      std::optional<int8_t> selected_device = std::nullopt);
+      std::optional<int8_t> selected_device = std::nullopt,
+      const KernelArgumentHolder& outputs = {});
 
   //! query if there's a kernel ready to go for given inputs
   NVF_API bool isCompiled(
@@ -172,6 +219,11 @@ class FusionExecutorCache {
   //! Get the most recently executed Scheduled IR
   std::string getMostRecentScheduledIr(bool tensor_transforms = false) const;
 
+  //! Get the optimization remarks of the segments of the most recently
+  //! executed runtime as JSON, see FusionKernelRuntime::getRemarks. Requires
+  //! EnableOption::KernelRemarks when the runtime is compiled.
+  std::string getMostRecentRemarks() const;
+
   //! Get the Scheduled IR for the given inputs
   std::string getScheduledIrFor(
       KernelArgumentHolder args,
@@ -203,6 +255,19 @@ class FusionExecutorCache {
   //! runtimes on all devices.
   size_t countRuntimes(int8_t device = -1) const;
 
+  //! Hit, miss and recompile counts of the runtime lookups of this fusion
+  const RuntimeCacheStats& runtimeCacheStats() const {
+    return runtime_cache_stats_;
+  }
+
+  //! Memory held by the compiled runtimes of this fusion. It can be called
+  //! while the fusion runs on other threads.
+  NVF_API ExecutorCacheMemoryUsage memoryUsage();
+
+  //! Latency histograms of the executions sampled with NVFUSER_PROF=sample.
+  //! It can be called while the fusion runs on other threads.
+  NVF_API FusionSamples sampledLatencies();
+
   void profile(bool to_profile);
 
   //! Internal knob for profiling shape inference
@@ -240,12 +305,28 @@ class FusionExecutorCache {
   //! entry in `KernelExecutor`
   void evictCache(size_t cache_id);
 
+  //! With EnableOption::TieredCompile, returns true if the runtime for args
+  //! shouldn't be compiled yet because fewer runs than the threshold have
+  //! used these inputs
+  bool shouldDeferCompilation(const KernelArgumentHolder& args);
+
   //! The index type of forced_index_type is used to get a kernel
   //! runtime no matter what sizes inputs have
   FusionKernelRuntime* getKernelRuntimeFor(
       const KernelArgumentHolder& inputs,
       std::optional<PrimDataType> forced_index_type = std::nullopt);
 
+  //! Returns the concretization info of a dynamic fusion for args. The info
+  //! is looked up by the values of the root Vals affecting concretization and
+  //! only computed for new values. Equal infos are shared.
+  DynamicTransformConcretizationInfo* getConcretizationInfo(
+      const KernelArgumentHolder& args);
+
+  //! Returns whether EnableOption::ShapeBuckets may apply to fusion_. Fusions
+  //! whose extents are related by reshapes, resizes or scalar inputs keep
+  //! their exact extents.
+  bool supportsShapeBuckets();
+
   //! Get initial concretization info (without inputs). This computes the info
   //! if it has not yet been computed, then caches it for later use. This means
   //! this method should not be called until the definition of the Fusion is
@@ -274,6 +355,47 @@ class FusionExecutorCache {
       PairPointerEquals>
       kernel_runtimes_;
 
+  //! Runtimes of a concretization recorded under a heuristic signature
+  struct SignatureRuntimes {
+    std::vector<FusionKernelRuntime*> runtimes;
+    //! Same runtimes as runtimes, so that a miss skips them in constant time
+    //! when checking the other runtimes of the concretization
+    std::unordered_set<FusionKernelRuntime*> recorded;
+
+    void record(FusionKernelRuntime* runtime) {
+      runtimes.push_back(runtime);
+      recorded.insert(runtime);
+    }
+  };
+
+  //! Secondary index over kernel_runtimes_ keyed by the heuristic signature
+  //! of the inputs each runtime has been used with (see
+  //! computeHeuristicSignature). On an input ID miss, runtimes recorded under
+  //! the signature of the new inputs are checked first, so that the expensive
+  //! heuristic comparison usually runs only once. A runtime may be recorded
+  //! under multiple signatures.
+  std::unordered_map<
+      ConcreteInfo,
+      std::unordered_map<size_t, SignatureRuntimes>,
+      PairPointerHash,
+      PairPointerEquals>
+      runtime_signature_index_;
+
+  //! Serialized segmentations of the runtimes of each concretization, keyed
+  //! by the computeShapeClass of the inputs they were segmented for. A new
+  //! runtime whose inputs are of a cached class starts from the cached
+  //! segmentation, which it checks against the runtime checks of the
+  //! schedulers, instead of running SegmentCandidateFinder. Devices of the
+  //! same kind share the key of the lowest of their indices, so that a fusion
+  //! run on all local GPUs is only segmented once. Their kernels are
+  //! compiled once too, as KernelBinaryCache is keyed by architecture.
+  std::unordered_map<
+      ConcreteInfo,
+      std::unordered_map<size_t, flatbuffers::DetachedBuffer>,
+      PairPointerHash,
+      PairPointerEquals>
+      segmentation_cache_;
+
   //! This seems to just own the unique pointer of
   //! DynamicTransformConcretizationInfo which is implicitly being used for
   //! lifetime of entries in kernel_runtimes_. We should push the lifetime to
@@ -281,6 +403,25 @@ class FusionExecutorCache {
   std::vector<std::unique_ptr<DynamicTransformConcretizationInfo>>
       cached_conc_info_;
 
+  struct ConcretizationKeyHash {
+    size_t operator()(const std::vector<int64_t>& key) const {
+      size_t hash = 0;
+      for (int64_t value : key) {
+        hashCombine(hash, std::hash<int64_t>()(value));
+      }
+      return hash;
+    }
+  };
+
+  //! Concretization infos keyed by the values of
+  //! DynamicTransformInitialInfo::getRootValsAffectingConcretization followed
+  //! by whether each of getRootExtentsCheckedForZero is zero
+  std::unordered_map<
+      std::vector<int64_t>,
+      DynamicTransformConcretizationInfo*,
+      ConcretizationKeyHash>
+      conc_info_by_key_;
+
   //! Map each pair of device_id and concretization info to an integer id
   std::unordered_map<ConcreteInfo, int64_t, PairPointerHash, PairPointerEquals>
       conc_info_id_map_;
@@ -292,9 +433,29 @@ class FusionExecutorCache {
   //! Short-cut for exact size cache hit
   std::unordered_map<size_t, FusionKernelRuntime*> id_to_kernel_runtime_;
 
+  //! Counts of getKernelRuntimeFor lookups
+  RuntimeCacheStats runtime_cache_stats_;
+
+  //! Computed by supportsShapeBuckets on first use
+  std::optional<bool> supports_shape_buckets_;
+
+  //! Concretizations that were segmented into schedulers whose launch
+  //! constraints depend on the extents, see EnableOption::ShapeBuckets
+  std::unordered_set<ConcreteInfo, PairPointerHash, PairPointerEquals>
+      exact_shape_concretizations_;
+
+  //! Number of runs by input ID whose runtime wasn't compiled yet, used by
+  //! EnableOption::TieredCompile
+  std::unordered_map<size_t, int64_t> num_runs_before_compile_;
+
   //! This is cached to speed up finding concretization info
   ExactLogicalDomainMap exact_map_;
 
+  //! Guards the caches above when runFusionWithInputs is called from
+  //! multiple threads. Only held to look up and compile a runtime, not
+  //! while running it.
+  std::mutex mutex_;
+
   //! Logging state for most recent compilation
   bool profiling_ = false;
 
@@ -318,6 +479,9 @@ class FusionExecutorCache {
 
   // Whether to auto schedule the Fusion. If set to false, scheduling is skipped
   const bool auto_schedule_;
+
+  //! Created on the first run with ProfilerOption::Sample
+  std::unique_ptr<FusionSampler> sampler_;
 };
 
 } // namespace nvfuser
@@ -11,23 +11,42 @@
 #include <fusion_profiler.h>
 #include <fusion_segmenter.h>
 #include <host_ir/lower_to_communication.h>
+#include <host_ir/pass/coalesce_communications.h>
 #include <host_ir/pass/convert_op_to_communication.h>
 #include <host_ir/pass/insert_deallocations.h>
+#include <host_ir/pass/prefetch_allgathers.h>
 #include <instrumentation.h>
 #include <ir/base_nodes.h>
+#include <ir/utils.h>
 #include <multidevice/communication.h>
 #include <multidevice/utils.h>
+#include <options.h>
 #include <preseg_passes/pre_segmenter.h>
 #include <python_frontend/fusion_definition.h>
 #include <python_frontend/translation.h>
+#include <runtime/compile_thread_pool.h>
 #include <runtime/executor.h>
 #include <runtime/executor_dispatch.h>
+#include <runtime/executor_utils.h>
 #include <runtime/fusion_cache_utils.h>
+#include <runtime/l2_persistence.h>
+#include <runtime/peak_memory.h>
+#include <runtime/sampling_profiler.h>
+#include <scheduler/autotune.h>
+#include <scheduler/cost_model.h>
 #include <scheduler/heuristic.h>
+#include <scheduler/registry.h>
 #include <serde/fusion_cache_generated.h>
+#include <serde/heuristic_params.h>
 #include <type.h>
 
+#include <ATen/cuda/CUDAEvent.h>
 #include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <chrono>
+#include <unordered_set>
+#include <utility>
 
 namespace nvfuser {
 
@@ -57,6 +76,42 @@ KernelArgumentHolder copyMetadataArg(const KernelArgumentHolder& src) {
   dst.setDeviceIndex(src.getDeviceIndex());
   return dst;
 }
+
+// With EnableOption::MixedIndexType, records the inputs of a 64-bit indexed
+// segment that fit in 32-bit indexing. This is part of the compile params, so
+// a runtime is only reused for inputs that fit the same way.
+void setInt32IndexedInputs(
+    HeuristicParams* heuristic_params,
+    const KernelArgumentHolder& group_runtime_inputs) {
+  CompileParams& cparams = heuristic_params->cparams;
+  if (!isOptionEnabled(EnableOption::MixedIndexType) ||
+      cparams.index_type != PrimDataType::Int) {
+    return;
+  }
+  cparams.int32_indexed_inputs =
+      group_runtime_inputs.getInt32IndexableTensorPositions();
+}
+
+// The number of streams segments run on with EnableOption::MultiStream,
+// including the current one
+int64_t numSegmentStreams() {
+  constexpr int64_t kMaxStreams = 8;
+  const std::vector<std::string>& args =
+      getEnableOptionArguments(EnableOption::MultiStream);
+  if (args.empty()) {
+    return 4;
+  }
+  int64_t num_streams = 0;
+  try {
+    num_streams = std::stoll(args.at(0));
+  } catch (const std::exception&) {
+  }
+  NVF_CHECK(
+      num_streams > 0,
+      "NVFUSER_ENABLE=multi_stream expects a positive number of streams, got ",
+      args.at(0));
+  return std::min(num_streams, kMaxStreams);
+}
 } // namespace
 
 FusionKernelRuntime::FusionKernelRuntime(
@@ -67,7 +122,9 @@ FusionKernelRuntime::FusionKernelRuntime(
     int64_t fusion_id,
     int64_t concrete_id,
     int64_t runtime_id,
-    bool auto_schedule)
+    bool auto_schedule,
+    FusionKernelRuntime* heuristic_data_source,
+    const serde::SegmentedFusion* cached_segmentation)
     : args_metadata_{copyMetadataArg(args)},
       fusion_id_{fusion_id},
       concrete_id_{concrete_id},
@@ -99,7 +156,10 @@ FusionKernelRuntime::FusionKernelRuntime(
   SchedulerRuntimeInfo runtime_info(
       fusion.get(), args, nullptr, all_tvs, forced_index_type);
 
-  if (serde_buffer == nullptr || !serde_buffer->segmented_fusion()->valid()) {
+  const serde::SegmentedFusion* serde_segmented_fusion =
+      serde_buffer != nullptr ? serde_buffer->segmented_fusion()
+                              : cached_segmentation;
+  if (serde_segmented_fusion == nullptr || !serde_segmented_fusion->valid()) {
     // Default compilation path applies segmentation before scheduling and
     // compiling the fusion.
     segmented_fusion_ =
@@ -108,8 +168,9 @@ FusionKernelRuntime::FusionKernelRuntime(
     // Serialization path that generates segmented fusion from flatbuffers.
     // Convert Welford to two-pass if option is enabled and the original
     // heuristic is persistent
+    check_segmentation_ = serde_buffer == nullptr;
     const flatbuffers::Vector<flatbuffers::Offset<serde::SegmentedGroup>>*
-        segmented_groups = serde_buffer->segmented_fusion()->groups();
+        segmented_groups = serde_segmented_fusion->groups();
     bool has_persistent_heuristic = std::any_of(
         segmented_groups->begin(),
         segmented_groups->end(),
@@ -125,14 +186,28 @@ FusionKernelRuntime::FusionKernelRuntime(
       SegmentCandidateFinder::translateWelfordInFusion(fusion.get(), args);
     }
     segmented_fusion_ = std::make_unique<SegmentedFusion>(std::move(fusion));
-    segmented_fusion_->deserialize(serde_buffer->segmented_fusion());
+    segmented_fusion_->deserialize(serde_segmented_fusion);
   }
 
   // Pre-compute the executor order so that the run time path
   //  would go directly to kernel launch.
   prepareRuntimeOrder(segmented_fusion_.get(), runtime_workspace_);
+  runtime_workspace_.l2_handoff_outputs = l2_persistence::findHandoffOutputs(
+      segmented_fusion_.get(), runtime_workspace_.group_run_order);
+  if (isOptionEnabled(EnableOption::InplaceSegmentOutputs)) {
+    runtime_workspace_.inplace_outputs = findInplaceOutputs(
+        segmented_fusion_.get(), runtime_workspace_.group_run_order);
+  }
+  if (isOptionEnabled(EnableOption::ZeroCopyCat)) {
+    runtime_workspace_.cat_output_slices = findCatOutputSlices(
+        segmented_fusion_.get(), runtime_workspace_.group_run_order);
+  }
 
   executors_.resize(segmented_fusion_->groups().size());
+  if (isOptionEnabled(EnableOption::KernelRemarks)) {
+    heuristic_remarks_.resize(segmented_fusion_->groups().size());
+    compile_remarks_.resize(segmented_fusion_->groups().size());
+  }
 
   if (isDebugDumpEnabled(DebugDumpOption::FusionSegments)) {
     segmented_fusion_->print();
@@ -143,18 +218,75 @@ FusionKernelRuntime::FusionKernelRuntime(
   //  counts as un-segmented.
   is_segmented_ = segmented_fusion_->groups().size() > 1;
 
+  Fusion* complete_fusion = segmented_fusion_->completeFusion();
+  supports_cuda_graph_ = !ir_utils::hasOpsOfType<RNGOp>(complete_fusion) &&
+      std::none_of(segmented_fusion_->groups().begin(),
+                   segmented_fusion_->groups().end(),
+                   [](SegmentedGroup* group) {
+                     return group->schedulerType() ==
+                         SchedulerType::Communication;
+                   }) &&
+      std::all_of(complete_fusion->outputs().begin(),
+                  complete_fusion->outputs().end(),
+                  [complete_fusion](Val* out) {
+                    return complete_fusion->getOutputAlias(out).aliased_io ==
+                        nullptr;
+                  });
+  supports_fallback_ = supports_cuda_graph_ &&
+      std::all_of(complete_fusion->outputs().begin(),
+                  complete_fusion->outputs().end(),
+                  [](Val* out) { return out->isA<TensorView>(); });
+
+  // A restored runtime takes the heuristics it was serialized with, instead
+  // of recomputing them for its initial arguments
+  if (serde_buffer != nullptr && serde_buffer->heuristics() != nullptr &&
+      serde_buffer->heuristics()->size() ==
+          segmented_fusion_->groups().size()) {
+    heuristics_ = std::make_unique<HeuristicParamsList>(
+        segmented_fusion_->groups().size());
+    for (SegmentedGroup* group : segmented_fusion_->groups()) {
+      heuristics_->at(group->groupId()) = serde::deserializeHeuristicParams(
+          serde_buffer->heuristics()->Get(group->groupId()),
+          group->getFusion());
+      NVF_ERROR(
+          heuristics_->at(group->groupId())->scheduler_type ==
+              group->schedulerType(),
+          "Heuristics do not match.");
+    }
+    return;
+  }
+
   // Create Initial Heuristics for Segmented Fusion
+  if (heuristic_data_source != nullptr) {
+    segmented_fusion_->setHeuristicDataSource(
+        heuristic_data_source->fusionSegments());
+  }
   auto maybe_heuristics = getMaybeHeuristicsFor(args, forced_index_type);
+  segmented_fusion_->setHeuristicDataSource(nullptr);
+  if (check_segmentation_ && !maybe_heuristics.has_value()) {
+    // Leave heuristics_ unset, see isValid
+    return;
+  }
   NVF_CHECK(maybe_heuristics.has_value());
   heuristics_ = std::move(maybe_heuristics.value());
 }
 
+FusionKernelRuntime::~FusionKernelRuntime() {
+  // The background compilation accesses the members of this runtime
+  waitForCompilation();
+}
+
 void FusionKernelRuntime::evictCache(size_t input_id) {
+  waitForCompilation();
   for (auto& ea : executors_) {
     if (auto ke = dynamic_cast<KernelExecutor*>(ea.get())) {
       ke->evictCache(input_id);
+    } else if (auto hie = dynamic_cast<HostIrExecutor*>(ea.get())) {
+      hie->evictCache(input_id);
     }
   }
+  std::lock_guard<std::mutex> guard(mutex_);
+  cuda_graphs_.erase(input_id);
 }
 
 bool FusionKernelRuntime::isCompiled() const {
@@ -191,6 +323,14 @@ flatbuffers::Offset<serde::FusionKernelRuntime> FusionKernelRuntime::serialize(
     segmented_fusion_fb = segmented_fusion_->serialize(builder);
   }
 
+  // 2. Serialize the heuristics of the segments
+  std::vector<flatbuffers::Offset<serde::HeuristicParams>> heuristics_fb;
+  heuristics_fb.reserve(schedulers().size());
+  for (const auto& heuristic_params : schedulers()) {
+    heuristics_fb.push_back(
+        serde::serializeHeuristicParams(builder, heuristic_params.get()));
+  }
+
   return serde::CreateFusionKernelRuntimeDirect(
       builder,
       fusion_id_,
@@ -198,7 +338,8 @@ flatbuffers::Offset<serde::FusionKernelRuntime> FusionKernelRuntime::serialize(
       runtime_id_,
       args_metadata_.serialize(builder),
       &executors_fb,
-      segmented_fusion_fb);
+      segmented_fusion_fb,
+      &heuristics_fb);
 }
 
 void FusionKernelRuntime::deserialize(
@@ -230,7 +371,7 @@ void FusionKernelRuntime::deserialize(
   };
 
   // 1. Deserialize KernelExecutor objects
-  for (auto idx : arange(executors_.size())) {
+  auto deserialize_group = [&](int64_t idx) {
     auto sg = runtime_workspace_.group_run_order.at(idx);
 
     // Create and schedule Fusion for this SegmentedGroup
@@ -253,6 +394,8 @@ void FusionKernelRuntime::deserialize(
         group_id,
         sg->schedulerType());
 
+    initSegmentOutputs(sg);
+
     // Deserialize KernelExecutor; Otherwise use ExecutorDispatch
     if (auto ke =
             dynamic_cast<KernelExecutor*>(executors_.at(group_id).get())) {
@@ -275,7 +418,47 @@ void FusionKernelRuntime::deserialize(
           heuristic_params->cparams,
           heuristic_params->scheduler_type);
     }
+  };
+
+  // Runtimes are themselves deserialized on the thread pool by
+  // FusionCache::deserializeAllExecutorCaches, in which case waiting for the
+  // pool would deadlock, so their executors are deserialized serially.
+  const int64_t num_groups = std::ssize(executors_);
+  if (num_groups <= 1 || isOptionDisabled(DisableOption::ParallelSerde) ||
+      getThreadPool()->inThreadPool()) {
+    for (auto idx : arange(num_groups)) {
+      deserialize_group(idx);
+    }
+    return;
+  }
+
+  std::atomic<bool> detect_exception_in_thread_pool{false};
+  std::string thread_pool_error_message;
+  std::mutex thread_pool_error_message_mutex;
+  for (auto idx : arange(num_groups)) {
+    getThreadPool()->run([&, idx]() {
+      FUSER_PERF_SCOPE("FusionKernelRuntime::deserializeParallel");
+      try {
+        c10::cuda::CUDAGuard device_guard(device_index);
+        deserialize_group(idx);
+      } catch (const std::exception& e) {
+        detect_exception_in_thread_pool.store(true);
+        const std::lock_guard<std::mutex> lock(thread_pool_error_message_mutex);
+        std::stringstream ss;
+        ss << thread_pool_error_message << "\nError from segmentation group "
+           << runtime_workspace_.group_run_order.at(idx)->groupId() << ": "
+           << e.what() << "\n";
+        thread_pool_error_message = ss.str();
+      }
+    });
   }
+  getThreadPool()->waitWorkComplete();
+  NVF_ERROR(
+      !detect_exception_in_thread_pool.load(),
+      "Detected exception while deserializing fusion segments in parallel. ",
+      "Error messages from all threads are printed below.\n",
+      thread_pool_error_message,
+      "\nUse NVFUSER_DISABLE=parallel_serde to simplify error message.");
 }
 
 PrimDataType FusionKernelRuntime::getIndexType() const {
@@ -290,7 +473,8 @@ PrimDataType FusionKernelRuntime::getIndexType() const {
 }
 
 KernelArgumentHolder FusionKernelRuntime::runWithInputs(
-    const KernelArgumentHolder& args) {
+    const KernelArgumentHolder& args,
+    const KernelArgumentHolder& outputs) {
   FUSER_PERF_SCOPE("FusionKernelRuntime::runWithInputs");
 
   if (isOptionEnabled(EnableOption::HostIrLowering)) {
@@ -312,8 +496,27 @@ KernelArgumentHolder FusionKernelRuntime::runWithInputs(
             << std::endl;
   }
 
+  if (isCompiling() || compilation_deferred_) {
+    if (std::optional<KernelArgumentHolder> outputs = runWithFallback(args)) {
+      return std::move(*outputs);
+    }
+    waitForCompilation();
+    if (!isCompiled()) {
+      // Either compilation was deferred or the background compilation
+      // failed, in which case compiling again reports the error to the
+      // caller.
+      compileFusionParallel(args);
+    }
+  }
+
+  // A captured graph writes into its own static outputs
+  if (isOptionEnabled(EnableOption::CudaGraph) && outputs.empty() &&
+      canUseCudaGraph(args)) {
+    return runWithCudaGraph(args);
+  }
+
   c10::Device device(c10::DeviceType::CUDA, (int8_t)args.getDeviceIndex());
-  const auto& tensor_map = runSegmentsWithInputs(args);
+  const auto& tensor_map = runSegmentsWithInputs(args, outputs);
 
   if (isDebugDumpEnabled(DebugDumpOption::PerfDebugVerbose)) {
     debug() << "============= FINISHED RUNNING FUSION SEGMENTS ============"
@@ -333,6 +536,91 @@ KernelArgumentHolder FusionKernelRuntime::runWithInputs(
   return fusion_outputs;
 }
 
+bool FusionKernelRuntime::canUseCudaGraph(
+    const KernelArgumentHolder& args) const {
+  // Kernel timing and the profiler need to observe each launch, and scalars
+  // would be baked into the captured kernel parameters.
+  return supports_cuda_graph_ && args.getCacheId().has_value() &&
+      !measure_kernel_time_ && !isProfilerEnabled() &&
+      std::all_of(args.begin(), args.end(), [](const PolymorphicValue& arg) {
+        return arg.is<at::Tensor>() && arg.as<at::Tensor>().is_cuda();
+      });
+}
+
+KernelArgumentHolder FusionKernelRuntime::runWithCudaGraph(
+    const KernelArgumentHolder& args) {
+  FUSER_PERF_SCOPE("FusionKernelRuntime::runWithCudaGraph");
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  const size_t cache_id = args.getCacheId().value();
+  auto [it, is_new] = cuda_graphs_.try_emplace(cache_id);
+  CudaGraphEntry& entry = it->second;
+
+  auto get_outputs = [this](const auto& tensor_map) {
+    KernelArgumentHolder outputs;
+    for (Val* output : segmented_fusion_->outputs()) {
+      outputs.push(tensor_map.at(output));
+    }
+    return outputs;
+  };
+
+  if (is_new) {
+    // Warm up: executor entries get initialized and kernels get recompiled if
+    // necessary outside of stream capture.
+    return get_outputs(runSegmentsWithInputs(args));
+  }
+
+  if (entry.graph == nullptr) {
+    FUSER_PERF_SCOPE("FusionKernelRuntime::runWithCudaGraph::capture");
+    // Allocate static input buffers with the exact sizes and strides of the
+    // arguments, which are guaranteed to be equal for the same cache id.
+    for (const auto& arg : args) {
+      const auto& tensor = arg.as<at::Tensor>();
+      entry.inputs.push(at::empty_strided(
+          tensor.sizes(), tensor.strides(), tensor.options()));
+    }
+    entry.inputs.setDeviceIndex(args.getDeviceIndex());
+    entry.inputs.setCacheId(cache_id);
+
+    // Capture on a side stream as capturing the default stream is illegal
+    c10::cuda::CUDAStream capture_stream =
+        c10::cuda::getStreamFromPool(false, args.getDeviceIndex());
+    entry.graph = std::make_unique<at::cuda::CUDAGraph>();
+    {
+      c10::cuda::CUDAStreamGuard stream_guard(capture_stream);
+      entry.graph->capture_begin(
+          /*pool=*/{0, 0}, cudaStreamCaptureModeThreadLocal);
+      entry.outputs = get_outputs(runSegmentsWithInputs(entry.inputs));
+      entry.graph->capture_end();
+    }
+  }
+
+  c10::cuda::CUDAStream stream =
+      c10::cuda::getCurrentCUDAStream(args.getDeviceIndex());
+  // The previous replay may have run on another stream, so its reads of the
+  // static buffers have to finish before they are overwritten
+  entry.replayed.block(stream);
+  for (auto i : arange(args.size())) {
+    entry.inputs[i].as<at::Tensor>().copy_(
+        args[i].as<at::Tensor>(), /*non_blocking=*/true);
+  }
+  // Replays on the current stream
+  entry.graph->replay();
+
+  // The next replay overwrites the static outputs, so the caller gets copies
+  // ordered after this replay on the current stream.
+  KernelArgumentHolder outputs;
+  for (const PolymorphicValue& output : entry.outputs) {
+    if (output.is<at::Tensor>()) {
+      outputs.push(output.as<at::Tensor>().clone());
+    } else {
+      outputs.push(output);
+    }
+  }
+  entry.replayed.record(stream);
+  return outputs;
+}
+
 std::vector<KernelArgumentHolder> FusionKernelRuntime::prepareInputs(
     const KernelArgumentHolder& args) const {
   std::vector<KernelArgumentHolder> all_runtime_inputs;
@@ -366,17 +654,107 @@ std::vector<KernelArgumentHolder> FusionKernelRuntime::prepareInputs(
 
     // map output args to tensor map
     args_manager.updateWithSegmentOutputs(
-        group_to_run->outputs(), group_runtime_outputs, run_order_id);
+        group_to_run->outputs(),
+        std::move(group_runtime_outputs),
+        run_order_id);
   }
 
   return all_runtime_inputs;
 }
 
+void FusionKernelRuntime::compileFusionAsync(KernelArgumentHolder args) {
+  FUSER_PERF_SCOPE("FusionKernelRuntime::compileFusionAsync");
+  std::lock_guard<std::mutex> guard(async_compile_mutex_);
+  if (async_compilation_.valid()) {
+    if (async_compilation_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return;
+    }
+    // A finished compilation only leaves the runtime uncompiled if it
+    // failed. Its error is reported to the caller instead of compiling again
+    // in the background while the fallback hides the failure.
+    async_compilation_.get();
+  }
+
+  prepareFallback();
+
+  // compileFusionParallel itself waits for all work of getThreadPool() to
+  // complete, so it can't run as a task of that pool.
+  async_compilation_ =
+      std::async(std::launch::async, [this, args = std::move(args)]() {
+        compileFusionParallel(args);
+      }).share();
+}
+
+void FusionKernelRuntime::deferCompilation() {
+  if (prepareFallback()) {
+    compilation_deferred_ = true;
+  }
+}
+
+bool FusionKernelRuntime::prepareFallback() {
+  if (!supports_fallback_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> guard(fallback_mutex_);
+  if (fallback_fusion_ == nullptr) {
+    fallback_fusion_ =
+        std::make_unique<Fusion>(*segmented_fusion_->completeFusion());
+  }
+  return true;
+}
+
+bool FusionKernelRuntime::isCompiling() const {
+  std::lock_guard<std::mutex> guard(async_compile_mutex_);
+  return async_compilation_.valid() &&
+      async_compilation_.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready;
+}
+
+void FusionKernelRuntime::waitForCompilation() const {
+  std::shared_future<void> compilation;
+  {
+    std::lock_guard<std::mutex> guard(async_compile_mutex_);
+    compilation = async_compilation_;
+  }
+  if (compilation.valid()) {
+    compilation.wait();
+  }
+}
+
+std::optional<KernelArgumentHolder> FusionKernelRuntime::runWithFallback(
+    const KernelArgumentHolder& args) {
+  FUSER_PERF_SCOPE("FusionKernelRuntime::runWithFallback");
+  std::lock_guard<std::mutex> guard(fallback_mutex_);
+  if (fallback_fusion_ == nullptr) {
+    return std::nullopt;
+  }
+
+  try {
+    auto expr_eval = executor_utils::bindInputs(args, fallback_fusion_.get());
+    KernelArgumentHolder outputs;
+    for (Val* out : fallback_fusion_->outputs()) {
+      outputs.push(expr_eval.evaluate(out));
+    }
+    return outputs;
+  } catch (const std::exception& e) {
+    // Not all ops can be evaluated by ATen. Evaluation has no side effects,
+    // so the caller can still wait for the kernels and run them instead.
+    if (isDebugDumpEnabled(DebugDumpOption::PerfDebugVerbose)) {
+      debug() << "Disabling fallback evaluation: " << e.what() << std::endl;
+    }
+    fallback_fusion_.reset();
+    supports_fallback_ = false;
+    return std::nullopt;
+  }
+}
+
 // passing args by value because we will be modify this
 void FusionKernelRuntime::compileFusionParallel(KernelArgumentHolder args) {
   FUSER_PERF_SCOPE("FusionKernelRuntime::compileFusionParallel");
 
   std::lock_guard<std::mutex> guard(mutex_);
+  compilation_deferred_ = false;
 
   NVF_ERROR_EQ(
       args.size(),
@@ -409,6 +787,20 @@ void FusionKernelRuntime::compileFusionParallel(KernelArgumentHolder args) {
   const std::vector<KernelArgumentHolder> all_runtime_inputs =
       prepareInputs(args);
 
+  // Tuning replaces heuristics_, so it has to finish before any segment is
+  // lowered. Timing is skipped while profiling so that the profile only
+  // reports the kernels of the fusion, and in background compilations, whose
+  // heuristics_ FusionExecutorCache may read concurrently and whose timings
+  // would compete with the fallback.
+  if (autotune::isEnabled() && hic == nullptr && !isProfilerEnabled() &&
+      !isCompiling()) {
+    for (int64_t run_order_id = 0; run_order_id < num_groups; ++run_order_id) {
+      autotuneKernel(
+          all_runtime_inputs.at(run_order_id),
+          runtime_workspace_.group_run_order.at(run_order_id));
+    }
+  }
+
   std::atomic<bool> detect_exception_in_thread_pool{false};
   std::string thread_pool_error_message;
   std::mutex thread_pool_error_message_mutex;
@@ -426,29 +818,51 @@ void FusionKernelRuntime::compileFusionParallel(KernelArgumentHolder args) {
         compileKernel(group_runtime_inputs, group_to_run, hic.get());
       } else {
         hir::HostIrContainer* hic_ptr = hic.get();
-        // launch compileKernel thread here
+        // Compilation is pipelined in two stages. The first stage schedules
+        // and lowers a segment and then enqueues the second stage, which
+        // generates the code, runs NVRTC and loads the module. Since the
+        // thread pool runs tasks in FIFO order, all segments are lowered
+        // before NVRTC starts and modules are loaded as soon as each NVRTC
+        // compilation finishes.
+        auto record_error = [&detect_exception_in_thread_pool,
+                             &thread_pool_error_message,
+                             &thread_pool_error_message_mutex](
+                                SegmentedGroup* group, const char* what) {
+          // Set flag inside lambda so we can throw an exception after thread
+          // pool completes its work.
+          detect_exception_in_thread_pool.store(true);
+          const std::lock_guard<std::mutex> lock(
+              thread_pool_error_message_mutex);
+          std::stringstream ss;
+          ss << thread_pool_error_message << "\nError from segmentation group "
+             << group->groupId() << ": " << what << "\n";
+          thread_pool_error_message = ss.str();
+        };
         getThreadPool()->run([this,
                               &group_runtime_inputs,
                               group_to_run,
                               hic_ptr,
-                              &detect_exception_in_thread_pool,
-                              &thread_pool_error_message,
-                              &thread_pool_error_message_mutex]() {
+                              record_error]() {
           FUSER_PERF_SCOPE("FusionKernelRuntime::compileFusionParallel");
+          KernelExecutor* ke = nullptr;
           try {
-            compileKernel(group_runtime_inputs, group_to_run, hic_ptr);
+            ke = lowerKernel(group_runtime_inputs, group_to_run, hic_ptr);
           } catch (const std::exception& e) {
-            // Set flag inside lambda so we can throw an exception after thread
-            // pool completes its work.
-            detect_exception_in_thread_pool.store(true);
-            const std::lock_guard<std::mutex> lock(
-                thread_pool_error_message_mutex);
-            std::stringstream ss;
-            ss << thread_pool_error_message
-               << "\nError from segmentation group " << group_to_run->groupId()
-               << ": " << e.what() << "\n";
-            thread_pool_error_message = ss.str();
+            record_error(group_to_run, e.what());
           }
+          if (ke == nullptr) {
+            return;
+          }
+          remarks::RemarkCollector* collector = compileRemarksOf(group_to_run);
+          getThreadPool()->run([ke, group_to_run, collector, record_error]() {
+            FUSER_PERF_SCOPE("FusionKernelRuntime::compileLoweredKernel");
+            remarks::RemarkGuard remark_guard(collector);
+            try {
+              ke->compileLowered();
+            } catch (const std::exception& e) {
+              record_error(group_to_run, e.what());
+            }
+          });
         });
       }
     }
@@ -471,6 +885,17 @@ void FusionKernelRuntime::compileFusionParallel(KernelArgumentHolder args) {
         "\nUse NVFUSER_DISABLE=parallel_compile to simplify error message.");
   }
 
+  // Recompiling replaces heuristics_, which is skipped in background
+  // compilations for the same reason as tuning.
+  if (autotune::isSpillFeedbackEnabled() && hic == nullptr &&
+      !isProfilerEnabled() && !isCompiling()) {
+    for (int64_t run_order_id = 0; run_order_id < num_groups; ++run_order_id) {
+      reduceRegisterSpills(
+          all_runtime_inputs.at(run_order_id),
+          runtime_workspace_.group_run_order.at(run_order_id));
+    }
+  }
+
   // add all expressions and compiled kernels to the host ir container
   if (hic != nullptr) {
     IrCloner ir_cloner(hic.get());
@@ -559,6 +984,8 @@ void FusionKernelRuntime::compileFusionParallel(KernelArgumentHolder args) {
       hic->addOutput(ir_cloner.clone(out));
     }
 
+    hir_pass::PrefetchAllgathers().runPass(hic.get());
+    hir_pass::CoalesceCommunications().runPass(hic.get());
     hir_pass::InsertDeallocations().runPass(hic.get());
 
     hie_ = std::make_unique<hir::HostIrEvaluator>(
@@ -594,11 +1021,41 @@ const ExecutorLog& FusionKernelRuntime::getMostRecentExecutorLog() const {
   return most_recent_executor_log_;
 }
 
+std::string FusionKernelRuntime::getRemarks() const {
+  waitForCompilation();
+  std::stringstream ss;
+  ss << "[";
+  if (!compile_remarks_.empty()) {
+    for (auto&& [run_order_id, group] :
+         enumerate(runtime_workspace_.group_run_order)) {
+      const int64_t group_id = group->groupId();
+      std::vector<remarks::Remark> all_remarks =
+          heuristic_remarks_.at(group_id).remarks();
+      const auto& compile_remarks = compile_remarks_.at(group_id).remarks();
+      all_remarks.insert(
+          all_remarks.end(), compile_remarks.begin(), compile_remarks.end());
+      ss << (run_order_id == 0 ? "" : ", ") << "{\"group_id\": " << group_id
+         << ", \"scheduler\": \"" << group->schedulerType()
+         << "\", \"remarks\": " << remarks::toJson(all_remarks) << "}";
+    }
+  }
+  ss << "]";
+  return ss.str();
+}
+
+remarks::RemarkCollector* FusionKernelRuntime::compileRemarksOf(
+    SegmentedGroup* sg) {
+  return compile_remarks_.empty() ? nullptr
+                                  : &compile_remarks_.at(sg->groupId());
+}
+
 std::optional<std::unique_ptr<HeuristicParamsList>> FusionKernelRuntime::
     getMaybeHeuristicsFor(
         const KernelArgumentHolder& args,
         std::optional<PrimDataType> forced_index_type) {
   FUSER_PERF_SCOPE("FusionKernelRuntime::getMaybeHeuristicsFor");
+  // Computing heuristics uses the segments being compiled in the background
+  waitForCompilation();
 
   // The runtime group run order is different from the segmented_fusion group
   // order. Instead of using HeuristicParamsList::emplaceBack, we initialize
@@ -611,6 +1068,8 @@ std::optional<std::unique_ptr<HeuristicParamsList>> FusionKernelRuntime::
   // ArgumentManager
   ArgumentManager args_manager(
       args, runtime_workspace_, segmented_fusion_->inputs());
+  // The runtime facts of a tensor are shared by all the segments that take it
+  TensorArgInfoCache arg_info_cache;
   // Follow group run order
   for (int64_t run_order_id : arange(num_groups)) {
     auto group_to_run = runtime_workspace_.group_run_order.at(run_order_id);
@@ -649,13 +1108,32 @@ std::optional<std::unique_ptr<HeuristicParamsList>> FusionKernelRuntime::
         group_runtime_inputs,
         evaluator_precomputed_values.get(),
         all_tvs_for_fusion_to_run,
-        forced_index_type);
+        forced_index_type,
+        &arg_info_cache,
+        group_to_run->inputs());
 
     if (heuristics_ == nullptr) {
+      // The runtime checks that segmentation ran for the cached segmentation
+      // on other inputs. Compile-time checks only depend on the fusion.
+      if (check_segmentation_ &&
+          !Schedule::canSchedule(
+              group_to_run->schedulerType(),
+              fusion_to_run,
+              fusion_to_run_info,
+              /*data_cache=*/nullptr,
+              /*skip_compile_time_checks=*/true)) {
+        return std::nullopt;
+      }
+      remarks::RemarkGuard remark_guard(
+          heuristic_remarks_.empty()
+              ? nullptr
+              : &heuristic_remarks_.at(group_to_run->groupId()));
       // Add new scheduler entry for this segmented group
       heuristics->at(group_to_run->groupId()) =
           segmented_fusion_->makeInitialHeuristicParams(
               group_to_run, fusion_to_run_info);
+      setInt32IndexedInputs(
+          heuristics->at(group_to_run->groupId()).get(), group_runtime_inputs);
     } else {
       // Try to get scheduler entry
       // NOTE: we are able to skip compile time checks here since the fusion
@@ -675,6 +1153,7 @@ std::optional<std::unique_ptr<HeuristicParamsList>> FusionKernelRuntime::
       // Check if this scheduler entry matches the previous entry for this
       // segmented group. If no match, then return std::nullptr
       auto heuristic_params = std::move(maybe_heuristic_params.value());
+      setInt32IndexedInputs(heuristic_params.get(), group_runtime_inputs);
       if (!heuristic_params->sameAs(
               heuristics_->at(group_to_run->groupId()).get())) {
         return std::nullopt;
@@ -690,13 +1169,16 @@ std::optional<std::unique_ptr<HeuristicParamsList>> FusionKernelRuntime::
         evaluator_precomputed_values.get());
 
     args_manager.updateWithSegmentOutputs(
-        group_to_run->outputs(), group_runtime_outputs, run_order_id);
+        group_to_run->outputs(),
+        std::move(group_runtime_outputs),
+        run_order_id);
   }
   return heuristics;
 }
 
 void FusionKernelRuntime::updateHeuristicsLaunchParams(
     HeuristicParamsList* update_heuristics) {
+  waitForCompilation();
   auto scheduler_list_length = heuristics_->heuristicsList().size();
   NVF_ERROR(
       update_heuristics->heuristicsList().size() == scheduler_list_length);
@@ -712,7 +1194,9 @@ const std::vector<std::unique_ptr<ExecutorAbstract>>& FusionKernelRuntime::
 }
 
 std::unordered_map<Val*, PolymorphicValue> FusionKernelRuntime::
-    runSegmentsWithInputs(const KernelArgumentHolder& args) {
+    runSegmentsWithInputs(
+        const KernelArgumentHolder& args,
+        const KernelArgumentHolder& outputs) {
   FUSER_PERF_SCOPE("FusionKernelRuntime::runSegmentsWithInputs");
   NVF_ERROR_EQ(
       args.size(),
@@ -725,6 +1209,108 @@ std::unordered_map<Val*, PolymorphicValue> FusionKernelRuntime::
   // group should share cache id.
   auto group_cache_id = args.getCacheId();
   const int64_t num_groups = (int64_t)runtime_workspace_.group_run_order.size();
+  const bool use_l2_persistence = l2_persistence::isEnabled();
+
+  // The outputs of the CatOps in cat_output_slices and their slices, which
+  // are allocated before the first segment writing into them runs.
+  const std::vector<CatOutputSlices>& cat_output_slices =
+      runtime_workspace_.cat_output_slices;
+  std::vector<std::pair<at::Tensor, std::vector<at::Tensor>>> cat_buffers(
+      cat_output_slices.size());
+  std::optional<ExpressionEvaluator> cat_expr_eval;
+
+  // The tensors given for the outputs of the fusion. If an output appears
+  // more than once, it's written into the first tensor given for it.
+  std::unordered_map<Val*, at::Tensor> user_outputs;
+  if (!outputs.empty()) {
+    NVF_ERROR_EQ(outputs.size(), std::ssize(segmented_fusion_->outputs()));
+    for (auto out_idx : arange(outputs.size())) {
+      if (outputs[out_idx].is<at::Tensor>()) {
+        user_outputs.emplace(
+            segmented_fusion_->outputs().at(out_idx),
+            outputs[out_idx].as<at::Tensor>());
+      }
+    }
+  }
+
+  // Tracks the device memory allocated by this execution when profiling.
+  // Kernel outputs and intermediates are tracked as they are allocated, while
+  // the outputs of other segments, e.g., those evaluated by ATen, are tracked
+  // once the segment returns unless they view the inputs or the outputs given
+  // by the user.
+  std::optional<PeakMemoryTracker> memory_tracker;
+  std::optional<PeakMemoryTrackerGuard> memory_tracker_guard;
+  std::unordered_set<const c10::StorageImpl*> external_storages;
+  if (profiling_ || isProfilerEnabled()) {
+    memory_tracker.emplace();
+    memory_tracker_guard.emplace(&*memory_tracker);
+    for (const KernelArgumentHolder* holder : {&args, &outputs}) {
+      for (const PolymorphicValue& arg : *holder) {
+        if (arg.is<at::Tensor>() && arg.as<at::Tensor>().has_storage()) {
+          external_storages.insert(
+              arg.as<at::Tensor>().storage().unsafeGetStorageImpl());
+        }
+      }
+    }
+  }
+
+  // With EnableOption::Megakernel, the launches of consecutive kernels are
+  // deferred to be enqueued as one persistent kernel. Like CUDA graphs, this
+  // hides each launch from the profilers.
+  std::optional<LaunchChain> launch_chain;
+  std::optional<LaunchChainGuard> launch_chain_guard;
+  if (isOptionEnabled(EnableOption::Megakernel) && supports_cuda_graph_ &&
+      num_groups > 1 && !use_l2_persistence && !profiling_ &&
+      !measure_kernel_time_ && !isProfilerEnabled() &&
+      FusionSampler::current() == nullptr) {
+    launch_chain.emplace(
+        megakernels_,
+        c10::Device(c10::DeviceType::CUDA, args.getDeviceIndex()));
+    launch_chain_guard.emplace(&*launch_chain);
+  }
+
+  // With EnableOption::MultiStream, segments that don't depend on each other
+  // run concurrently on side streams. A segment waits for the events of its
+  // producers on other streams, and the side streams are joined into the
+  // current stream at the end. Like megakernels, this requires that the
+  // segments are only ordered by their edges, e.g., that no input is updated
+  // in place.
+  std::vector<int64_t> group_streams;
+  std::vector<c10::cuda::CUDAStream> streams;
+  std::vector<bool> group_signals;
+  std::vector<at::cuda::CUDAEvent> group_events;
+  if (isOptionEnabled(EnableOption::MultiStream) && supports_cuda_graph_ &&
+      num_groups > 1 && !launch_chain.has_value() && !use_l2_persistence &&
+      !profiling_ && !measure_kernel_time_ && !isProfilerEnabled() &&
+      FusionSampler::current() == nullptr && cat_output_slices.empty()) {
+    group_streams = assignGroupStreams(
+        runtime_workspace_.group_producers, numSegmentStreams());
+    const int64_t num_streams =
+        *std::max_element(group_streams.begin(), group_streams.end()) + 1;
+    if (num_streams > 1) {
+      const c10::DeviceIndex device_index = args.getDeviceIndex();
+      streams.push_back(c10::cuda::getCurrentCUDAStream(device_index));
+      at::cuda::CUDAEvent fork;
+      fork.record(streams.front());
+      for ([[maybe_unused]] auto i : arange(1, num_streams)) {
+        streams.push_back(c10::cuda::getStreamFromPool(
+            /*isHighPriority=*/false, device_index));
+        fork.block(streams.back());
+      }
+      group_signals.resize(num_groups, false);
+      for (auto run_order_id : arange(num_groups)) {
+        for (const int64_t producer :
+             runtime_workspace_.group_producers.at(run_order_id)) {
+          if (group_streams.at(producer) != group_streams.at(run_order_id)) {
+            group_signals.at(producer) = true;
+          }
+        }
+      }
+      group_events.resize(num_groups);
+    }
+  }
+  const bool use_multi_stream = !streams.empty();
+
   kernel_time_ms_ = 0;
   for (auto run_order_id : arange(num_groups)) {
     // TODO: index mode should be updated per segmented kernel
@@ -737,15 +1323,154 @@ std::unordered_map<Val*, PolymorphicValue> FusionKernelRuntime::
       group_runtime_inputs.setCacheId(group_cache_id.value());
     }
 
+    OutputPlacement output_placement;
+    std::optional<at::Tensor> cat_output;
+    for (auto plan_id : arange(std::ssize(cat_output_slices))) {
+      const CatOutputSlices& plan = cat_output_slices.at(plan_id);
+      auto& [buffer, slices] = cat_buffers.at(plan_id);
+      if (plan.cat_run_order_id == run_order_id && buffer.defined()) {
+        fillCatOutputSlices(
+            plan,
+            runtime_workspace_.group_run_order,
+            group_runtime_inputs,
+            slices);
+        cat_output = std::move(buffer);
+        cat_buffers.at(plan_id) = {};
+        continue;
+      }
+      for (auto i : arange(std::ssize(plan.producers))) {
+        const auto [producer_run_order_id, out_idx] = plan.producers.at(i);
+        if (producer_run_order_id != run_order_id) {
+          continue;
+        }
+        if (!buffer.defined()) {
+          if (!cat_expr_eval.has_value()) {
+            cat_expr_eval = executor_utils::bindInputs(
+                args, segmented_fusion_->completeFusion());
+          }
+          std::tie(buffer, slices) = allocateCatOutputSlices(
+              plan,
+              runtime_workspace_.group_run_order,
+              *cat_expr_eval,
+              c10::Device(c10::DeviceType::CUDA, args.getDeviceIndex()));
+          if (memory_tracker.has_value()) {
+            memory_tracker->allocated(buffer);
+          }
+        }
+        output_placement.output_slices.emplace_back(out_idx, slices.at(i));
+      }
+    }
+    if (cat_output.has_value()) {
+      // The inputs of the CatOp are already in place
+      args_manager.updateWithSegmentOutputs(
+          group_to_run->outputs(),
+          KernelArgumentHolder(std::move(*cat_output)),
+          run_order_id);
+      continue;
+    }
+
+    std::optional<c10::cuda::CUDAStreamGuard> stream_guard;
+    if (use_multi_stream) {
+      const int64_t stream_id = group_streams.at(run_order_id);
+      c10::cuda::CUDAStream stream = streams.at(stream_id);
+      bool crosses_streams = stream_id != 0;
+      for (const int64_t producer :
+           runtime_workspace_.group_producers.at(run_order_id)) {
+        if (group_streams.at(producer) != stream_id) {
+          group_events.at(producer).block(stream);
+          crosses_streams = true;
+        }
+      }
+      // The host may free the inputs before this segment has read them, so
+      // their memory must not be handed to work on the stream they were
+      // allocated on until then.
+      if (crosses_streams) {
+        for (const PolymorphicValue& input : group_runtime_inputs) {
+          if (input.is<at::Tensor>() && input.as<at::Tensor>().has_storage()) {
+            input.as<at::Tensor>().record_stream(stream);
+          }
+        }
+      }
+      stream_guard.emplace(stream);
+    }
+
     // TODO: currently we are still outputing PyTorch tensors, instead of
     // something abstract. This is quite unsatisfying.
 
+    // The executor covers the outputs read by the next segment with an L2
+    // access policy window, which is cleared once that segment is launched.
+    // It also writes outputs into the tensors given by the user, into the
+    // storage of inputs that die with this segment, or into the slices of
+    // concatenated tensors.
+    //
+    // In a megakernel, writing into the storage of inputs could leave stale
+    // copies of them in the L1 caches of the stages that read them, so
+    // outputs aren't written in place. The same holds on multiple streams,
+    // where a segment on another stream may still read them. Other segments
+    // may enqueue work, which must follow the pending launches.
+    if (dynamic_cast<KernelExecutor*>(
+            executors_.at(group_to_run->groupId()).get()) != nullptr) {
+      output_placement.persist_in_l2 = use_l2_persistence;
+      output_placement.write_inplace =
+          !launch_chain.has_value() && !use_multi_stream;
+      for (auto i : arange(std::ssize(group_to_run->outputs()))) {
+        auto it = user_outputs.find(group_to_run->outputs().at(i));
+        if (it != user_outputs.end()) {
+          output_placement.user_outputs.emplace_back(i, it->second);
+        }
+      }
+    } else if (launch_chain.has_value()) {
+      launch_chain->flush();
+    }
+
     // Run graph segment
-    KernelArgumentHolder group_runtime_outputs =
-        runKernelWithInput(group_runtime_inputs, group_to_run);
+    KernelArgumentHolder group_runtime_outputs = runKernelWithInput(
+        group_runtime_inputs, group_to_run, output_placement);
+    if (memory_tracker.has_value()) {
+      for (const PolymorphicValue& output : group_runtime_outputs) {
+        if (output.is<at::Tensor>() && output.as<at::Tensor>().has_storage() &&
+            !external_storages.contains(
+                output.as<at::Tensor>().storage().unsafeGetStorageImpl())) {
+          memory_tracker->allocated(output.as<at::Tensor>());
+        }
+      }
+    }
+
+    if (use_l2_persistence && run_order_id > 0 &&
+        !runtime_workspace_.l2_handoff_outputs.at(run_order_id - 1).empty()) {
+      l2_persistence::resetAccessPolicyWindow(
+          c10::cuda::getCurrentCUDAStream());
+    }
+
+    if (use_multi_stream) {
+      const int64_t stream_id = group_streams.at(run_order_id);
+      // Outputs returned to the user are used on the current stream
+      if (stream_id != 0) {
+        for (const PolymorphicValue& output : group_runtime_outputs) {
+          if (output.is<at::Tensor>() &&
+              output.as<at::Tensor>().has_storage()) {
+            output.as<at::Tensor>().record_stream(streams.front());
+          }
+        }
+      }
+      if (group_signals.at(run_order_id)) {
+        group_events.at(run_order_id).record(streams.at(stream_id));
+      }
+      stream_guard.reset();
+    }
 
     args_manager.updateWithSegmentOutputs(
-        group_to_run->outputs(), group_runtime_outputs, run_order_id);
+        group_to_run->outputs(),
+        std::move(group_runtime_outputs),
+        run_order_id);
+  }
+  if (launch_chain.has_value()) {
+    launch_chain->flush();
+  }
+  for (auto stream_id : arange(1, std::ssize(streams))) {
+    at::cuda::CUDAEvent join;
+    join.record(streams.at(stream_id));
+    join.block(streams.front());
   }
 
   if (isProfilerEnabled()) {
@@ -768,14 +1493,24 @@ std::unordered_map<Val*, PolymorphicValue> FusionKernelRuntime::
     FusionProfiler::outputBytesAccessed(output_bytes);
   }
 
-  return args_manager.getTensorMap();
+  if (memory_tracker.has_value()) {
+    if (profiling_) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      most_recent_executor_log_.peak_memory_bytes = memory_tracker->peakBytes();
+    }
+    if (isProfilerEnabled()) {
+      FusionProfiler::peakMemoryBytes(memory_tracker->peakBytes());
+    }
+  }
+
+  return args_manager.takeTensorMap();
 }
 
 KernelArgumentHolder FusionKernelRuntime::runKernelWithInput(
     const KernelArgumentHolder& args,
-    SegmentedGroup* sg) {
+    SegmentedGroup* sg,
+    const OutputPlacement& output_placement) {
   FUSER_PERF_SCOPE("FusionKernelRuntime::runKernelWithInput");
-  std::lock_guard<std::mutex> guard(mutex_);
   // This function will be called once on un-segmented fusion,
   // for segmented fusion, this function will be called on each segment
   // In the case of segmented fusion, segmented group needs to be given so
@@ -789,6 +1524,7 @@ KernelArgumentHolder FusionKernelRuntime::runKernelWithInput(
   ExecutorAbstract* ea = executors_.at(group_id).get();
 
   if (profiling_) {
+    std::lock_guard<std::mutex> guard(mutex_);
     most_recent_executor_log_.fusion_executor = ea;
     most_recent_executor_log_.params = heuristic_params->clone();
   }
@@ -799,9 +1535,28 @@ KernelArgumentHolder FusionKernelRuntime::runKernelWithInput(
   // is ad hoc.
   if (auto ke = dynamic_cast<KernelExecutor*>(ea)) {
     ke->setGroupId(group_id);
+    if (isProfilerEnabled()) {
+      // Needed to place the kernel on the roofline
+      ExpressionEvaluator ee;
+      for (const auto i : arange(sg->inputs().size())) {
+        ee.bind(sg->inputs()[i], args[i]);
+      }
+      SegmentProfiler& sprof = FusionProfiler::segment(group_id);
+      sprof.arithmeticOps(cost_model::arithmeticOps(sg->exprs(), ee));
+      sprof.heuristicParams(heuristic_params->toString());
+    }
+  }
+  FusionSampler::Execution* sampled_execution = FusionSampler::current();
+  if (sampled_execution != nullptr) {
+    sampled_execution->startSegment(
+        group_id, c10::cuda::getCurrentCUDAStream(args.getDeviceIndex()));
+  }
+  auto outputs = ExecutorDispatch::run(
+      ea, args, {}, launch_params, compile_params, output_placement);
+  if (sampled_execution != nullptr) {
+    sampled_execution->stopSegment(
+        group_id, c10::cuda::getCurrentCUDAStream(args.getDeviceIndex()));
   }
-  auto outputs =
-      ExecutorDispatch::run(ea, args, {}, launch_params, compile_params);
 
   return outputs;
 }
@@ -811,6 +1566,265 @@ void FusionKernelRuntime::compileKernel(
     SegmentedGroup* sg,
     hir::HostIrContainer* hic) {
   FUSER_PERF_SCOPE("FusionKernelRuntime::compileKernel");
+  if (KernelExecutor* ke = lowerKernel(args, sg, hic)) {
+    remarks::RemarkGuard remark_guard(compileRemarksOf(sg));
+    ke->compileLowered();
+  }
+}
+
+void FusionKernelRuntime::initSegmentOutputs(SegmentedGroup* sg) {
+  auto* ke = dynamic_cast<KernelExecutor*>(executors_.at(sg->groupId()).get());
+  if (ke == nullptr) {
+    return;
+  }
+  const auto& run_order = runtime_workspace_.group_run_order;
+  const auto run_order_id = std::distance(
+      run_order.begin(), std::find(run_order.begin(), run_order.end(), sg));
+  ke->setL2PersistingOutputs(
+      runtime_workspace_.l2_handoff_outputs.at(run_order_id));
+  if (!runtime_workspace_.inplace_outputs.empty()) {
+    ke->setInplaceOutputs(runtime_workspace_.inplace_outputs.at(run_order_id));
+  }
+}
+
+void FusionKernelRuntime::autotuneKernel(
+    const KernelArgumentHolder& args,
+    SegmentedGroup* sg) {
+  FUSER_PERF_SCOPE("FusionKernelRuntime::autotuneKernel");
+  std::unique_ptr<HeuristicParams>& heuristic_params =
+      heuristics_->at(sg->groupId());
+  if (!autotune::isTunable(heuristic_params->scheduler_type)) {
+    return;
+  }
+  c10::cuda::CUDAGuard dg(args.getDeviceIndex());
+  c10::Device device(c10::DeviceType::CUDA, args.getDeviceIndex());
+
+  std::string key;
+  {
+    FusionGuard fg(sg->getFusion());
+    SchedulerRuntimeInfo runtime_info(sg->getFusion(), args);
+    key = autotune::tuningKey(
+        heuristic_params.get(), sg->getFusion(), runtime_info);
+  }
+  if (std::optional<autotune::TuningKnobs> knobs =
+          autotune::queryTunedKnobs(key)) {
+    // Another runtime tuned this segment after the heuristics were computed.
+    // Knobs are idempotent, so it's fine if they were already applied.
+    autotune::applyKnobs(heuristic_params.get(), *knobs);
+    return;
+  }
+
+  std::vector<autotune::TuningCandidate> candidates =
+      autotune::candidateParams(
+          heuristic_params.get(), autotune::maxCandidates());
+  if (candidates.size() == 1) {
+    autotune::recordTunedKnobs(key, candidates.front().knobs);
+    return;
+  }
+
+  // Candidates run on zero-filled buffers instead of the user's tensors, which
+  // may be aliased by outputs, and instead of the meta tensors prepareInputs
+  // infers for intermediate segments.
+  KernelArgumentHolder tuning_args;
+  for (const PolymorphicValue& arg : args) {
+    if (arg.is<at::Tensor>() && !arg.as<at::Tensor>().is_cpu()) {
+      const at::Tensor& tensor = arg.as<at::Tensor>();
+      tuning_args.push(
+          at::empty_strided(
+              tensor.sizes(), tensor.strides(), tensor.options().device(device))
+              .zero_());
+    } else {
+      tuning_args.push(arg);
+    }
+  }
+  tuning_args.setDeviceIndex(args.getDeviceIndex());
+
+  std::vector<std::unique_ptr<KernelExecutor>> executors(candidates.size());
+  auto compile_candidate = [this, sg, &candidates, &executors, &tuning_args](
+                               size_t candidate_id) {
+    FUSER_PERF_SCOPE("FusionKernelRuntime::autotuneKernel::compile");
+    c10::cuda::CUDAGuard dg(tuning_args.getDeviceIndex());
+    const HeuristicParams* params = candidates.at(candidate_id).params.get();
+    try {
+      auto fusion_to_run = segmented_fusion_->makeFusion(sg).second;
+      FusionGuard fg(fusion_to_run.get());
+      SchedulerEntry::makeSchedulerInstance(params->scheduler_type)
+          ->schedule(fusion_to_run.get(), params);
+      auto ke = std::make_unique<KernelExecutor>();
+      ke->compile(
+          fusion_to_run.get(),
+          tuning_args,
+          params->lparams,
+          params->cparams,
+          params->scheduler_type);
+      executors.at(candidate_id) = std::move(ke);
+    } catch (const std::exception& e) {
+      // Candidates other than the heuristic's choice may be invalid for this
+      // segment, e.g., exceed the register or shared memory limits.
+      if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
+        debug() << "Autotuning candidate "
+                << candidates.at(candidate_id).knobs.toString()
+                << " failed to compile: " << e.what() << std::endl;
+      }
+    }
+  };
+  if (isOptionDisabled(DisableOption::ParallelCompile)) {
+    for (size_t candidate_id : arange(candidates.size())) {
+      compile_candidate(candidate_id);
+    }
+  } else {
+    for (size_t candidate_id : arange(candidates.size())) {
+      getThreadPool()->run([&compile_candidate, candidate_id]() {
+        compile_candidate(candidate_id);
+      });
+    }
+    getThreadPool()->waitWorkComplete();
+  }
+
+  constexpr int64_t num_warmup_runs = 2;
+  constexpr int64_t num_timed_runs = 10;
+  std::optional<size_t> best_candidate_id;
+  double best_time_ms = 0.0;
+  for (size_t candidate_id : arange(candidates.size())) {
+    KernelExecutor* ke = executors.at(candidate_id).get();
+    if (ke == nullptr) {
+      continue;
+    }
+    const autotune::TuningCandidate& candidate = candidates.at(candidate_id);
+    const HeuristicParams* params = candidate.params.get();
+    double time_ms = 0.0;
+    try {
+      for ([[maybe_unused]] auto i : arange(num_warmup_runs)) {
+        ke->run(tuning_args, {}, params->lparams, params->cparams);
+      }
+      CudaEventTimer timer(c10::cuda::getCurrentCUDAStream());
+      timer.start();
+      for ([[maybe_unused]] auto i : arange(num_timed_runs)) {
+        ke->run(tuning_args, {}, params->lparams, params->cparams);
+      }
+      timer.stop();
+      time_ms = timer.time() / static_cast<double>(num_timed_runs);
+    } catch (const std::exception& e) {
+      if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
+        debug() << "Autotuning candidate " << candidate.knobs.toString()
+                << " failed to run: " << e.what() << std::endl;
+      }
+      continue;
+    }
+    if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
+      debug() << "Autotuning candidate " << candidate.knobs.toString()
+              << " of segment " << sg->groupId() << ": " << time_ms << " ms"
+              << std::endl;
+    }
+    if (!best_candidate_id.has_value() || time_ms < best_time_ms) {
+      best_candidate_id = candidate_id;
+      best_time_ms = time_ms;
+    }
+  }
+  // If no candidate ran, the segment is compiled with the heuristic's choice,
+  // which reports the error, and tuning is retried by the next runtime.
+  if (!best_candidate_id.has_value()) {
+    return;
+  }
+
+  autotune::TuningCandidate& best = candidates.at(*best_candidate_id);
+  autotune::recordTunedKnobs(key, best.knobs);
+  heuristic_params = std::move(best.params);
+}
+
+void FusionKernelRuntime::reduceRegisterSpills(
+    const KernelArgumentHolder& args,
+    SegmentedGroup* sg) {
+  FUSER_PERF_SCOPE("FusionKernelRuntime::reduceRegisterSpills");
+  const int64_t group_id = sg->groupId();
+  std::unique_ptr<HeuristicParams>& heuristic_params =
+      heuristics_->at(group_id);
+  auto* ke = dynamic_cast<KernelExecutor*>(executors_.at(group_id).get());
+  if (ke == nullptr || !autotune::isTunable(heuristic_params->scheduler_type)) {
+    return;
+  }
+  int64_t local_memory_size = ke->compiledKernel()->localMemorySize();
+  if (local_memory_size == 0) {
+    return;
+  }
+  c10::cuda::CUDAGuard dg(args.getDeviceIndex());
+
+  std::string key;
+  {
+    FusionGuard fg(sg->getFusion());
+    SchedulerRuntimeInfo runtime_info(sg->getFusion(), args);
+    key = autotune::tuningKey(
+        heuristic_params.get(), sg->getFusion(), runtime_info);
+  }
+  // The knobs applied by the heuristic, if any, are kept
+  autotune::TuningKnobs knobs =
+      autotune::queryTunedKnobs(key).value_or(autotune::TuningKnobs{});
+  std::optional<autotune::TuningKnobs> best_knobs;
+
+  // Candidates build on each other, even when one doesn't help, since lifting
+  // the register limit and less unrolling can both be needed.
+  std::unique_ptr<HeuristicParams> params = heuristic_params->clone();
+  for ([[maybe_unused]] auto retry :
+       arange(autotune::maxSpillFeedbackRetries())) {
+    std::optional<autotune::TuningCandidate> candidate =
+        autotune::spillFeedbackCandidate(params.get(), knobs);
+    if (!candidate.has_value()) {
+      break;
+    }
+    knobs = candidate->knobs;
+    params = std::move(candidate->params);
+
+    // lowerKernel compiles the params in heuristics_, so they are swapped
+    // back along with the executor if the candidate isn't better.
+    std::unique_ptr<HeuristicParams> previous_params =
+        std::exchange(heuristic_params, params->clone());
+    std::unique_ptr<ExecutorAbstract> previous_executor =
+        std::move(executors_.at(group_id));
+    int64_t candidate_local_memory_size = -1;
+    try {
+      if (KernelExecutor* candidate_ke = lowerKernel(args, sg, nullptr)) {
+        candidate_ke->compileLowered();
+        candidate_local_memory_size =
+            candidate_ke->compiledKernel()->localMemorySize();
+      }
+    } catch (const std::exception& e) {
+      if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
+        debug() << "Register spill feedback candidate " << knobs.toString()
+                << " failed to compile: " << e.what() << std::endl;
+      }
+    }
+    if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
+      debug() << "Register spill feedback candidate " << knobs.toString()
+              << " of segment " << group_id << ": "
+              << candidate_local_memory_size
+              << " bytes of local memory, was " << local_memory_size
+              << std::endl;
+    }
+    if (candidate_local_memory_size < 0 ||
+        candidate_local_memory_size >= local_memory_size) {
+      heuristic_params = std::move(previous_params);
+      executors_.at(group_id) = std::move(previous_executor);
+      continue;
+    }
+    local_memory_size = candidate_local_memory_size;
+    best_knobs = knobs;
+    if (local_memory_size == 0) {
+      break;
+    }
+  }
+
+  if (best_knobs.has_value()) {
+    autotune::recordTunedKnobs(key, *best_knobs);
+  }
+}
+
+KernelExecutor* FusionKernelRuntime::lowerKernel(
+    const KernelArgumentHolder& args,
+    SegmentedGroup* sg,
+    hir::HostIrContainer* hic) {
+  FUSER_PERF_SCOPE("FusionKernelRuntime::lowerKernel");
+  DEBUG_PRINT_SCOPE_NAME(
+      "FusionKernelRuntime::lowerKernel", "group_id=", sg->groupId());
   c10::cuda::CUDAGuard dg(args.getDeviceIndex());
   c10::Device device(c10::DeviceType::CUDA, args.getDeviceIndex());
 
@@ -820,23 +1834,38 @@ void FusionKernelRuntime::compileKernel(
   // Check that the heuristics are matched, in the case of segmented fusion
   NVF_ERROR(heuristic_params->scheduler_type == sg->schedulerType());
 
+  // Remarks of a previous compilation of this segment are replaced
+  remarks::RemarkCollector* collector = compileRemarksOf(sg);
+  if (collector != nullptr) {
+    collector->clear();
+  }
+  remarks::RemarkGuard remark_guard(collector);
+
   if (hic != nullptr &&
       (sg->schedulerType() == SchedulerType::ExprEval ||
        sg->schedulerType() == SchedulerType::Communication)) {
     // When lowering to host IR, ExprEval and Communication segments are
     // lowered to top-level expressions in the host IR container, not
     // executors. Only kernels need to be compiled.
-    return;
+    return nullptr;
   }
 
   // Running a segment group as a single kernel,
   // make a fusion to run from segmented fusion
+  const auto copy_start = std::chrono::steady_clock::now();
   auto fusion_to_run = segmented_fusion_->makeFusion(sg).second;
+  if (isProfilerEnabled()) {
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - copy_start;
+    FusionProfiler::segment(group_id).segmentCopy(
+        {"makeFusion", elapsed.count(), std::ssize(fusion_to_run->exprs())});
+  }
   if (isDebugDumpEnabled(DebugDumpOption::FusionIrPresched)) {
     fusion_to_run->printMath();
   }
   FusionGuard fg(fusion_to_run.get());
   if (auto_schedule_) {
+    FUSER_PERF_SCOPE("FusionKernelRuntime::lowerKernel::schedule");
     SchedulerEntry::makeSchedulerInstance(heuristic_params->scheduler_type)
         ->schedule(fusion_to_run.get(), heuristic_params);
   }
@@ -854,24 +1883,40 @@ void FusionKernelRuntime::compileKernel(
         heuristic_params->cparams,
         heuristic_params->scheduler_type);
     hic->addKernelExecutor(std::move(ke));
-  } else {
-    // Initialize associated executors
-    executors_[group_id] = ExecutorDispatch::makeExecutor(
-        fusion_to_run.get(),
-        fusion_id_,
-        concrete_id_,
-        runtime_id_,
-        group_id,
-        heuristic_params->scheduler_type);
+    return nullptr;
+  }
+
+  // Initialize associated executors
+  executors_[group_id] = ExecutorDispatch::makeExecutor(
+      fusion_to_run.get(),
+      fusion_id_,
+      concrete_id_,
+      runtime_id_,
+      group_id,
+      heuristic_params->scheduler_type);
 
-    ExecutorDispatch::compile(
-        executors_.at(group_id).get(),
+  initSegmentOutputs(sg);
+
+  // The lowered kernel doesn't refer to fusion_to_run, so the kernel can be
+  // compiled after it's destroyed.
+  if (auto ke = dynamic_cast<KernelExecutor*>(executors_.at(group_id).get())) {
+    ke->lower(
         fusion_to_run.get(),
         args,
         heuristic_params->lparams,
         heuristic_params->cparams,
         heuristic_params->scheduler_type);
+    return ke;
   }
+
+  ExecutorDispatch::compile(
+      executors_.at(group_id).get(),
+      fusion_to_run.get(),
+      args,
+      heuristic_params->lparams,
+      heuristic_params->cparams,
+      heuristic_params->scheduler_type);
+  return nullptr;
 }
 
 std::pair<LaunchParams, CompileParams> FusionKernelRuntime::getKernelConfig(
@@ -7,15 +7,21 @@
 // clang-format on
 #pragma once
 
+#include <ATen/cuda/CUDAEvent.h>
+#include <ATen/cuda/CUDAGraph.h>
 #include <c10/util/ArrayRef.h>
 
 #include <fusion_segmenter.h>
 #include <host_ir/executor.h>
 #include <polymorphic_value.h>
+#include <remarks.h>
 #include <runtime/executor.h>
 #include <runtime/executor_kernel_arg.h>
 #include <runtime/fusion_cache_utils.h>
+#include <runtime/megakernel.h>
 
+#include <atomic>
+#include <future>
 #include <mutex>
 #include <vector>
 
@@ -27,6 +33,7 @@ class Fusion;
 class Val;
 namespace serde {
 struct FusionKernelRuntime;
+struct SegmentedFusion;
 }
 
 //! FusionKernelRuntime is the unified interface from fusion graphs into
@@ -43,6 +50,16 @@ struct FusionKernelRuntime;
 //! SegmentCandidateFinder::segment pass in the constructor and compile the
 //! fusions. When serde_buffer exists, we deserialize the segmented_fusion_ and
 //! executors_ objects from the flatbuffer binary.
+//!
+//! heuristic_data_source is an existing runtime of the same concretized
+//! fusion. Segments structurally identical to one of its segments start
+//! their HeuristicDataCache from the compile-time entries of that segment.
+//!
+//! cached_segmentation is the serialized segmentation of an earlier runtime of
+//! the same concretized fusion, used in place of SegmentCandidateFinder when
+//! serde_buffer is a nullptr. Since it was decided for other inputs, each
+//! group is checked with the runtime checks of its scheduler first. If one
+//! fails, isValid() returns false and the runtime must be discarded.
 class FusionKernelRuntime {
  public:
   explicit FusionKernelRuntime(
@@ -53,7 +70,12 @@ class FusionKernelRuntime {
       int64_t fusion_id = 0,
       int64_t concrete_id = 0,
       int64_t runtime_id = 0,
-      bool auto_schedule = true);
+      bool auto_schedule = true,
+      FusionKernelRuntime* heuristic_data_source = nullptr,
+      const serde::SegmentedFusion* cached_segmentation = nullptr);
+
+  //! Waits for a compilation started by compileFusionAsync to finish
+  ~FusionKernelRuntime();
 
   //! Type notations within FusionKernelRuntime Context
 
@@ -64,6 +86,12 @@ class FusionKernelRuntime {
   //! query if we have already attempted compilation
   bool isCompiled() const;
 
+  //! False if the cached segmentation given to the constructor can't be
+  //! scheduled with its inputs
+  bool isValid() const {
+    return heuristics_ != nullptr;
+  }
+
   //! Serialize Fusion Kernel Runtime using flatbuffers
   flatbuffers::Offset<serde::FusionKernelRuntime> serialize(
       flatbuffers::FlatBufferBuilder& builder) const;
@@ -76,13 +104,43 @@ class FusionKernelRuntime {
   //! Note that all heuristics use the same index type.
   PrimDataType getIndexType() const;
 
-  //! Unified interface to run the managed kernels with given input
-  NVF_API KernelArgumentHolder runWithInputs(const KernelArgumentHolder& args);
+  //! Unified interface to run the managed kernels with given input.
+  //! `outputs`, if not empty, has a tensor or nothing for each output of the
+  //! fusion. The kernels producing these outputs write them into the given
+  //! tensors, see OutputPlacement::user_outputs. Outputs that aren't
+  //! produced by a kernel, e.g., those evaluated by ExpressionEvaluator, are
+  //! returned as usual and left to the caller.
+  NVF_API KernelArgumentHolder runWithInputs(
+      const KernelArgumentHolder& args,
+      const KernelArgumentHolder& outputs = {});
 
   //! Compile a kernel executor for given inputs. Note: The compilation is
   //! multithreaded. The segments in the fusion are compiled independently.
   NVF_API void compileFusionParallel(KernelArgumentHolder args);
 
+  //! Starts compileFusionParallel in the background and returns immediately.
+  //! Until it finishes, runWithInputs evaluates the complete fusion with
+  //! ExpressionEvaluator if possible and waits for the compilation otherwise.
+  //! Rethrows the error of a previous background compilation that failed.
+  //! Used with EnableOption::AsyncCompile.
+  void compileFusionAsync(KernelArgumentHolder args);
+
+  //! Returns true while a compilation started by compileFusionAsync runs
+  NVF_API bool isCompiling() const;
+
+  //! Returns true if the complete fusion may be run with ExpressionEvaluator
+  //! while its kernels are compiled in the background or not compiled yet.
+  //! Becomes false once the evaluation failed.
+  bool canRunWithFallback() const {
+    return supports_fallback_;
+  }
+
+  //! Makes runWithInputs evaluate the complete fusion with
+  //! ExpressionEvaluator without compiling any kernels, which is the first
+  //! tier of EnableOption::TieredCompile. If the evaluation fails,
+  //! runWithInputs compiles the kernels instead.
+  void deferCompilation();
+
   //! Turn On/Off profiling
   void profile(bool to_profile = true) {
     profiling_ = to_profile;
@@ -123,6 +181,11 @@ class FusionKernelRuntime {
   //! space for recent logs
   const ExecutorLog& getMostRecentExecutorLog() const;
 
+  //! Returns the optimization remarks of the segments in run order as a JSON
+  //! array of objects with the keys "group_id", "scheduler" and "remarks".
+  //! The remarks are only collected with EnableOption::KernelRemarks.
+  std::string getRemarks() const;
+
   // Try to compute heuristics based on the SegmentedFusion managed
   //  in this kernel runtime, and will return a nullopt if either
   //  any segment cannot be scheduled or the parameters don't match
@@ -143,20 +206,28 @@ class FusionKernelRuntime {
     return *hie_.get();
   };
 
+  //! Megakernels of the segments run with EnableOption::Megakernel
+  const MegakernelCache& megakernels() const {
+    return megakernels_;
+  }
+
  private:
   //! Runs each fusion segment given arguments. The outputs for a fusion are
   //! added back to the arguments, so they can be used as inputs to successive
   //! segments. Returns a map that links each NvFuser Val to its corresponding
-  //! tensor.
+  //! tensor. `outputs` is the same as that of runWithInputs.
   std::unordered_map<Val*, PolymorphicValue> runSegmentsWithInputs(
-      const KernelArgumentHolder& args);
+      const KernelArgumentHolder& args,
+      const KernelArgumentHolder& outputs = {});
 
   //! Interface to run a single kernel, either one kernel for single-kernel
   //! fusions, or a kernel for a segmentedGrouup in a segmented fusion. Returns
-  //! the kernel outputs.
+  //! the kernel outputs, which are placed by a KernelExecutor as given by
+  //! output_placement.
   KernelArgumentHolder runKernelWithInput(
       const KernelArgumentHolder& args,
-      SegmentedGroup* sg);
+      SegmentedGroup* sg,
+      const OutputPlacement& output_placement = {});
 
   //! Interface to compile a single kernel. It is either a single kernel for a
   //! fusion or a kernel for a segmentedGrouup in a segmented fusion. Returns
@@ -166,6 +237,36 @@ class FusionKernelRuntime {
       SegmentedGroup* sg,
       hir::HostIrContainer* hic);
 
+  //! First stage of compileKernel: schedules the segment, creates its
+  //! executor and, for kernels, lowers the fusion. Returns the KernelExecutor
+  //! that still needs KernelExecutor::compileLowered, i.e., code generation
+  //! and NVRTC, or nullptr if the segment is fully compiled.
+  KernelExecutor* lowerKernel(
+      const KernelArgumentHolder& args,
+      SegmentedGroup* sg,
+      hir::HostIrContainer* hic);
+
+  //! Passes the outputs of segment sg that are fixed by the segmentation to
+  //! its newly created executor, see KernelExecutor::setL2PersistingOutputs
+  //! and KernelExecutor::setInplaceOutputs.
+  void initSegmentOutputs(SegmentedGroup* sg);
+
+  //! With EnableOption::Autotune, compiles and times the candidates of
+  //! autotune::candidateParams for a segment that has no entry in the tuning
+  //! database yet. The fastest candidate replaces the heuristic params of the
+  //! segment and is recorded in the database, so that later heuristics and
+  //! processes pick it without tuning again.
+  void autotuneKernel(const KernelArgumentHolder& args, SegmentedGroup* sg);
+
+  //! With EnableOption::RegisterSpillFeedback, recompiles the kernel of a
+  //! tunable segment that uses local memory with the candidates of
+  //! autotune::spillFeedbackCandidate, up to autotune::maxSpillFeedbackRetries
+  //! times. The kernel with the least local memory is kept, and its knobs are
+  //! recorded in the tuning database so that later heuristics start with them.
+  void reduceRegisterSpills(
+      const KernelArgumentHolder& args,
+      SegmentedGroup* sg);
+
   std::pair<LaunchParams, CompileParams> getKernelConfig(
       const KernelArgumentHolder& args,
       SegmentedGroup* sg);
@@ -179,6 +280,40 @@ class FusionKernelRuntime {
   std::vector<KernelArgumentHolder> prepareInputs(
       const KernelArgumentHolder& args) const;
 
+  //! Returns true if this runtime can be captured into a CUDA graph and
+  //! replayed for the given arguments. See runWithCudaGraph.
+  bool canUseCudaGraph(const KernelArgumentHolder& args) const;
+
+  //! Runs the segments through a CUDA graph captured for the cache id of
+  //! args. The first run with a cache id is executed eagerly to warm up
+  //! executor caches and lazy initialization. The second run captures all
+  //! segments into a graph that reads its inputs from static buffers.
+  //! Subsequent runs copy the inputs into the static buffers and replay the
+  //! graph. The graph's outputs live in its memory pool and are overwritten
+  //! by the next replay with the same cache id, so replays return copies of
+  //! them that the caller owns.
+  KernelArgumentHolder runWithCudaGraph(const KernelArgumentHolder& args);
+
+  //! Creates fallback_fusion_ if the fusion supports it. Returns
+  //! supports_fallback_.
+  bool prepareFallback();
+
+  //! Blocks until a compilation started by compileFusionAsync finishes.
+  //! Errors are not rethrown here. runWithInputs reports them by compiling
+  //! again synchronously, and later calls by compileFusionAsync.
+  void waitForCompilation() const;
+
+  //! Evaluates the complete fusion with ExpressionEvaluator while the
+  //! kernels are compiled in the background. Returns std::nullopt if the
+  //! fusion turns out not to be evaluable, in which case the fallback is not
+  //! attempted again.
+  std::optional<KernelArgumentHolder> runWithFallback(
+      const KernelArgumentHolder& args);
+
+  //! Collector of the remarks reported while scheduling and compiling sg, or
+  //! nullptr if they are not collected
+  remarks::RemarkCollector* compileRemarksOf(SegmentedGroup* sg);
+
   int64_t numGroups() const {
     int64_t n_groups = std::ssize(runtime_workspace_.group_run_order);
     NVF_ERROR_EQ(n_groups, std::ssize(segmented_fusion_->groups()));
@@ -201,6 +336,12 @@ class FusionKernelRuntime {
   //! Heuristics object holding scheduler entries for all segments
   std::unique_ptr<HeuristicParamsList> heuristics_;
 
+  //! Optimization remarks reported while computing the initial heuristics
+  //! and while scheduling and compiling each segment, indexed by group ID.
+  //! Empty unless EnableOption::KernelRemarks is set.
+  std::vector<remarks::RemarkCollector> heuristic_remarks_;
+  std::vector<remarks::RemarkCollector> compile_remarks_;
+
   // Checks if this runtime instance is for a single-kernel fusion (false) or a
   //  segmented fusion (true).
   bool is_segmented_ = true;
@@ -208,9 +349,63 @@ class FusionKernelRuntime {
   //! Multi-Kernel fusion segment when applies
   std::unique_ptr<SegmentedFusion> segmented_fusion_ = nullptr;
 
+  //! Whether segmented_fusion_ comes from a cached segmentation whose groups
+  //! must pass the runtime checks of their schedulers before the initial
+  //! heuristics are computed
+  bool check_segmentation_ = false;
+
   //! Pre-allocated runtime workspace to speed up kernel launch preparation.
   RuntimeWorkSpace runtime_workspace_;
 
+  //! State of a CUDA graph captured for one input cache id
+  struct CudaGraphEntry {
+    //! Null until the graph is captured, i.e., after the warm-up run
+    std::unique_ptr<at::cuda::CUDAGraph> graph;
+    //! Static buffers the captured kernels read the fusion inputs from
+    KernelArgumentHolder inputs;
+    //! Fusion outputs written by the captured kernels
+    KernelArgumentHolder outputs;
+    //! Recorded once the last replay's outputs have been copied. Callers may
+    //! replay on different streams, so the next one waits on it before
+    //! overwriting the static buffers.
+    at::cuda::CUDAEvent replayed;
+  };
+
+  //! CUDA graphs keyed by input cache id, used with EnableOption::CudaGraph.
+  //! Guarded by mutex_ since replaying overwrites the static buffers, which
+  //! CudaGraphEntry::replayed orders on the device.
+  std::unordered_map<size_t, CudaGraphEntry> cuda_graphs_;
+
+  //! Whether the fusion itself allows CUDA graph replay. Inputs updated in
+  //! place, outputs aliasing inputs, RNG, and communication can't be
+  //! captured with static buffers.
+  bool supports_cuda_graph_ = false;
+
+  //! Megakernels of chains of segments, used with EnableOption::Megakernel.
+  //! They have the same requirements as supports_cuda_graph_, since a kernel
+  //! can't read what an earlier stage wrote into memory it read before.
+  MegakernelCache megakernels_;
+
+  //! Compilation started by compileFusionAsync. Guarded by
+  //! async_compile_mutex_.
+  std::shared_future<void> async_compilation_;
+  mutable std::mutex async_compile_mutex_;
+
+  //! Copy of the complete fusion evaluated by runWithFallback. It's separate
+  //! from the fusion being compiled as binding inputs may add metadata Vals
+  //! to it. Guarded by fallback_mutex_.
+  std::unique_ptr<Fusion> fallback_fusion_;
+  std::mutex fallback_mutex_;
+
+  //! Whether the fusion can be evaluated by runWithFallback. It has the same
+  //! requirements as supports_cuda_graph_ so that evaluating it instead of
+  //! the kernels has no visible side effects, and all outputs must be
+  //! tensors. Cleared by runWithFallback if the evaluation fails.
+  std::atomic<bool> supports_fallback_ = false;
+
+  //! Set by deferCompilation until compileFusionParallel runs
+  std::atomic<bool> compilation_deferred_ = false;
+
   // States for profiling support
   bool profiling_ = false;
 
@@ -222,8 +417,13 @@ class FusionKernelRuntime {
   //! The sum of the last kernel execution times
   float kernel_time_ms_ = 0;
 
-  //! something to do with parallel compilation, not sure what it's actually
-  //! being used to protect.
+  //! Guards compilation of executors_ and most_recent_executor_log_. It is
+  //! not held while running segments: executors are immutable once compiled
+  //! and synchronize their own launch caches, while per-launch state such as
+  //! the ArgumentManager is local to each runWithInputs call. This allows
+  //! multiple threads to run the same compiled runtime concurrently. It is
+  //! held for whole runs in runWithCudaGraph though, as cuda_graphs_ and the
+  //! static buffers of a graph are shared.
   mutable std::mutex mutex_;
 
   // ID of fusion in python frontend fusion cache, which maps to a single
@@ -0,0 +1,151 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/l2_persistence.h>
+
+#include <cuda_utils.h>
+#include <fusion_segmenter.h>
+#include <options.h>
+#include <utils.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDAGraphsC10Utils.h>
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+
+namespace nvfuser {
+namespace l2_persistence {
+
+namespace {
+
+// Returns the device properties of the current device if it has a persisting
+// L2 carve-out and the current stream is not being captured, or nullptr.
+const cudaDeviceProp* persistingL2Device() {
+  if (c10::cuda::currentStreamCaptureStatusMayInitCtx() !=
+      c10::cuda::CaptureStatus::None) {
+    return nullptr;
+  }
+  const cudaDeviceProp* prop = at::cuda::getCurrentDeviceProperties();
+  if (prop->persistingL2CacheMaxSize <= 0 ||
+      prop->accessPolicyMaxWindowSize <= 0) {
+    return nullptr;
+  }
+  return prop;
+}
+
+// Sets the persisting L2 limit of the current device to its maximum. The
+// limit is per device and kept for the lifetime of the process.
+void reserveCarveOut(const cudaDeviceProp* prop) {
+  static std::mutex reserved_devices_mutex;
+  static std::unordered_set<int> reserved_devices;
+  const int device = at::cuda::current_device();
+  std::lock_guard<std::mutex> guard(reserved_devices_mutex);
+  if (reserved_devices.insert(device).second) {
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaDeviceSetLimit(
+        cudaLimitPersistingL2CacheSize,
+        (size_t)prop->persistingL2CacheMaxSize));
+  }
+}
+
+} // namespace
+
+bool isEnabled() {
+  return isOptionEnabled(EnableOption::L2Persistence);
+}
+
+std::vector<std::vector<int64_t>> findHandoffOutputs(
+    const SegmentedFusion* segmented_fusion,
+    const std::vector<SegmentedGroup*>& group_run_order) {
+  const std::unordered_set<Val*> fusion_outputs(
+      segmented_fusion->outputs().begin(), segmented_fusion->outputs().end());
+
+  std::vector<std::vector<int64_t>> handoff_outputs(group_run_order.size());
+  for (size_t run_order_id = 0; run_order_id + 1 < group_run_order.size();
+       ++run_order_id) {
+    const std::vector<Val*>& next_inputs =
+        group_run_order.at(run_order_id + 1)->inputs();
+    const std::vector<Val*>& outputs =
+        group_run_order.at(run_order_id)->outputs();
+    for (auto i : arange(std::ssize(outputs))) {
+      Val* out = outputs.at(i);
+      if (!out->isA<TensorView>() || fusion_outputs.count(out) != 0) {
+        continue;
+      }
+      if (std::find(next_inputs.begin(), next_inputs.end(), out) !=
+          next_inputs.end()) {
+        handoff_outputs.at(run_order_id).push_back(i);
+      }
+    }
+  }
+  return handoff_outputs;
+}
+
+void setAccessPolicyWindow(
+    cudaStream_t stream,
+    const std::vector<at::Tensor>& tensors) {
+  const cudaDeviceProp* prop = persistingL2Device();
+  if (prop == nullptr) {
+    return;
+  }
+
+  // Prefer the largest intermediate that fits the window. A window smaller
+  // than its tensor only keeps a slice of it, so otherwise take the smallest.
+  const size_t max_window_bytes = (size_t)prop->accessPolicyMaxWindowSize;
+  auto better = [max_window_bytes](size_t bytes, size_t chosen_bytes) {
+    const bool fits = bytes <= max_window_bytes;
+    const bool chosen_fits = chosen_bytes <= max_window_bytes;
+    if (fits != chosen_fits) {
+      return fits;
+    }
+    return fits ? bytes > chosen_bytes : bytes < chosen_bytes;
+  };
+  const at::Tensor* chosen = nullptr;
+  for (const at::Tensor& tensor : tensors) {
+    if (!tensor.defined() || tensor.nbytes() == 0) {
+      continue;
+    }
+    if (chosen == nullptr || better(tensor.nbytes(), chosen->nbytes())) {
+      chosen = &tensor;
+    }
+  }
+  if (chosen == nullptr) {
+    return;
+  }
+
+  reserveCarveOut(prop);
+
+  const size_t window_bytes = std::min(chosen->nbytes(), max_window_bytes);
+  cudaStreamAttrValue attr = {};
+  attr.accessPolicyWindow.base_ptr = chosen->data_ptr();
+  attr.accessPolicyWindow.num_bytes = window_bytes;
+  // Only a fraction of the window persists if it is larger than the
+  // carve-out. The rest is streamed so that it doesn't thrash the carve-out.
+  attr.accessPolicyWindow.hitRatio = std::min(
+      1.0f,
+      static_cast<float>(prop->persistingL2CacheMaxSize) /
+          static_cast<float>(window_bytes));
+  attr.accessPolicyWindow.hitProp = cudaAccessPropertyPersisting;
+  attr.accessPolicyWindow.missProp = cudaAccessPropertyStreaming;
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaStreamSetAttribute(
+      stream, cudaStreamAttributeAccessPolicyWindow, &attr));
+}
+
+void resetAccessPolicyWindow(cudaStream_t stream) {
+  if (persistingL2Device() == nullptr) {
+    return;
+  }
+  cudaStreamAttrValue attr = {};
+  attr.accessPolicyWindow.num_bytes = 0;
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaStreamSetAttribute(
+      stream, cudaStreamAttributeAccessPolicyWindow, &attr));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaCtxResetPersistingL2Cache());
+}
+
+} // namespace l2_persistence
+} // namespace nvfuser
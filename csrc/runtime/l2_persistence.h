@@ -0,0 +1,60 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <ATen/core/Tensor.h>
+#include <cuda_runtime.h>
+
+#include <visibility.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace nvfuser {
+
+class SegmentedFusion;
+class SegmentedGroup;
+
+//! Cross-segment L2 residency, enabled by EnableOption::L2Persistence.
+//!
+//! When a segment writes an intermediate that the next segment reads right
+//! away, FusionKernelRuntime asks the executor of the producer to cover it
+//! with an access policy window of the persisting L2 carve-out. The window is
+//! set on the stream before the producer is launched, so its stores already
+//! occupy persisting lines, and is reset after the consumer is launched. Only
+//! one window can be active per stream, so the largest intermediate that fits
+//! the window is chosen.
+//!
+//! Loads of expanded operands, which are read by many blocks, are marked with
+//! CacheOp::EvictLast by refineCachePolicy under the same option.
+namespace l2_persistence {
+
+//! Returns whether EnableOption::L2Persistence is set.
+NVF_API bool isEnabled();
+
+//! Returns, for each group of group_run_order, the positions in
+//! SegmentedGroup::outputs of the intermediates read by the next group in the
+//! run order. Outputs of the complete fusion are not included since they
+//! outlive the fusion and would only take the carve-out from other data.
+NVF_API std::vector<std::vector<int64_t>> findHandoffOutputs(
+    const SegmentedFusion* segmented_fusion,
+    const std::vector<SegmentedGroup*>& group_run_order);
+
+//! Covers the largest of tensors with a persisting access policy window of
+//! stream and reserves the L2 carve-out of the device on first use. Does
+//! nothing if the device has no persisting L2 or the stream is being
+//! captured into a CUDA graph.
+void setAccessPolicyWindow(
+    cudaStream_t stream,
+    const std::vector<at::Tensor>& tensors);
+
+//! Clears the window of stream and demotes persisting lines to normal ones.
+void resetAccessPolicyWindow(cudaStream_t stream);
+
+} // namespace l2_persistence
+} // namespace nvfuser
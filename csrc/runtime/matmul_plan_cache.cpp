@@ -0,0 +1,329 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/matmul_plan_cache.h>
+
+#include <cuda_utils.h>
+#include <exceptions.h>
+#include <instrumentation.h>
+#include <options.h>
+
+#include <ATen/Context.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/ops/empty.h>
+#include <ATen/ops/matmul.h>
+#include <c10/cuda/CUDAStream.h>
+#include <cublasLt.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+#define NVFUSER_CUBLAS_SAFE_CALL(x)       \
+  do {                                    \
+    cublasStatus_t _status = x;           \
+    NVF_ERROR(                            \
+        _status == CUBLAS_STATUS_SUCCESS, \
+        "cuBLAS error: ",                 \
+        cublasGetStatusString(_status),   \
+        " in ",                           \
+        #x);                              \
+  } while (0)
+
+namespace nvfuser {
+
+namespace {
+
+// Workspace retained per stream for the algorithms that need one
+constexpr int64_t kWorkspaceBytes = 4 * 1024 * 1024;
+// Heuristic candidates timed with the "tune" argument
+constexpr int kTuneCandidates = 8;
+constexpr int kTuneIterations = 5;
+
+cudaDataType_t toCudaDataType(at::ScalarType dtype) {
+  switch (dtype) {
+    case at::kHalf:
+      return CUDA_R_16F;
+    case at::kBFloat16:
+      return CUDA_R_16BF;
+    case at::kFloat:
+      return CUDA_R_32F;
+    default:
+      NVF_THROW("Unsupported data type of a cuBLASLt matmul: ", dtype);
+  }
+}
+
+// Largest power of two up to 256 bytes that divides the address
+int64_t alignmentOf(const at::Tensor& t) {
+  const auto address = reinterpret_cast<uintptr_t>(t.data_ptr());
+  int64_t alignment = 256;
+  while (address % alignment != 0) {
+    alignment /= 2;
+  }
+  return alignment;
+}
+
+// A matmul operand as a column-major cuBLASLt matrix. A row-major [rows, cols]
+// tensor is the column-major [cols, rows] matrix, so it is used untransposed
+// as the transpose of itself.
+struct Operand {
+  cublasOperation_t op;
+  int64_t rows;
+  int64_t cols;
+  int64_t ld;
+};
+
+std::optional<Operand> columnMajorOperand(const at::Tensor& t) {
+  if (t.stride(1) == 1 && t.stride(0) >= std::max<int64_t>(t.size(1), 1)) {
+    return Operand{CUBLAS_OP_N, t.size(1), t.size(0), t.stride(0)};
+  }
+  if (t.stride(0) == 1 && t.stride(1) >= std::max<int64_t>(t.size(0), 1)) {
+    return Operand{CUBLAS_OP_T, t.size(0), t.size(1), t.stride(1)};
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+// Descriptors and algorithm of a matmul problem. The row-major a @ b is
+// computed as the column-major b^T @ a^T, so b is the first operand of
+// cuBLASLt.
+class MatmulPlanCache::Plan {
+ public:
+  Plan(const at::Tensor& a, const at::Tensor& b) {
+    const Operand op_a = columnMajorOperand(a).value();
+    const Operand op_b = columnMajorOperand(b).value();
+    const cudaDataType_t dtype = toCudaDataType(a.scalar_type());
+    const cublasComputeType_t compute_type =
+        a.scalar_type() == at::kFloat && at::globalContext().allowTF32CuBLAS()
+        ? CUBLAS_COMPUTE_32F_FAST_TF32
+        : CUBLAS_COMPUTE_32F;
+
+    NVFUSER_CUBLAS_SAFE_CALL(
+        cublasLtMatmulDescCreate(&desc_, compute_type, CUDA_R_32F));
+    NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatmulDescSetAttribute(
+        desc_, CUBLASLT_MATMUL_DESC_TRANSA, &op_b.op, sizeof(op_b.op)));
+    NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatmulDescSetAttribute(
+        desc_, CUBLASLT_MATMUL_DESC_TRANSB, &op_a.op, sizeof(op_a.op)));
+    NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatrixLayoutCreate(
+        &b_layout_, dtype, op_b.rows, op_b.cols, op_b.ld));
+    NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatrixLayoutCreate(
+        &a_layout_, dtype, op_a.rows, op_a.cols, op_a.ld));
+    NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatrixLayoutCreate(
+        &out_layout_, dtype, b.size(1), a.size(0), b.size(1)));
+  }
+
+  ~Plan() {
+    cublasLtMatrixLayoutDestroy(out_layout_);
+    cublasLtMatrixLayoutDestroy(a_layout_);
+    cublasLtMatrixLayoutDestroy(b_layout_);
+    cublasLtMatmulDescDestroy(desc_);
+  }
+
+  Plan(const Plan&) = delete;
+  Plan& operator=(const Plan&) = delete;
+
+  // Returns the algorithms suggested by the cuBLASLt heuristic, best first
+  std::vector<cublasLtMatmulHeuristicResult_t> heuristics(
+      int64_t alignment,
+      int num_candidates) const {
+    cublasLtMatmulPreference_t preference = nullptr;
+    NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatmulPreferenceCreate(&preference));
+    const uint64_t workspace_bytes = kWorkspaceBytes;
+    NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatmulPreferenceSetAttribute(
+        preference,
+        CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+        &workspace_bytes,
+        sizeof(workspace_bytes)));
+    const auto alignment_bytes = static_cast<uint32_t>(alignment);
+    for (auto attr :
+         {CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES,
+          CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES,
+          CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES,
+          CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES}) {
+      NVFUSER_CUBLAS_SAFE_CALL(cublasLtMatmulPreferenceSetAttribute(
+          preference, attr, &alignment_bytes, sizeof(alignment_bytes)));
+    }
+
+    std::vector<cublasLtMatmulHeuristicResult_t> results(num_candidates);
+    int num_results = 0;
+    const cublasStatus_t status = cublasLtMatmulAlgoGetHeuristic(
+        at::cuda::getCurrentCUDABlasLtHandle(),
+        desc_,
+        b_layout_,
+        a_layout_,
+        out_layout_,
+        out_layout_,
+        preference,
+        num_candidates,
+        results.data(),
+        &num_results);
+    cublasLtMatmulPreferenceDestroy(preference);
+    if (status != CUBLAS_STATUS_SUCCESS) {
+      num_results = 0;
+    }
+    results.resize(num_results);
+    return results;
+  }
+
+  cublasStatus_t run(
+      const cublasLtMatmulAlgo_t& algo,
+      const at::Tensor& a,
+      const at::Tensor& b,
+      at::Tensor& out,
+      void* workspace,
+      cudaStream_t stream) const {
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+    return cublasLtMatmul(
+        at::cuda::getCurrentCUDABlasLtHandle(),
+        desc_,
+        &alpha,
+        b.data_ptr(),
+        b_layout_,
+        a.data_ptr(),
+        a_layout_,
+        &beta,
+        out.data_ptr(),
+        out_layout_,
+        out.data_ptr(),
+        out_layout_,
+        &algo,
+        workspace,
+        kWorkspaceBytes,
+        stream);
+  }
+
+  // Set once the algorithm is selected. Problems without one fall back to
+  // at::matmul.
+  bool has_algo = false;
+  cublasLtMatmulAlgo_t algo{};
+
+ private:
+  cublasLtMatmulDesc_t desc_ = nullptr;
+  cublasLtMatrixLayout_t a_layout_ = nullptr;
+  cublasLtMatrixLayout_t b_layout_ = nullptr;
+  cublasLtMatrixLayout_t out_layout_ = nullptr;
+};
+
+MatmulPlanCache::MatmulPlanCache()
+    : tune_(hasEnableOptionArgument(EnableOption::MatmulPlanCache, "tune")) {}
+
+MatmulPlanCache::~MatmulPlanCache() = default;
+
+bool MatmulPlanCache::supports(const at::Tensor& a, const at::Tensor& b) {
+  if (a.dim() != 2 || b.dim() != 2 || !a.is_cuda() || !b.is_cuda() ||
+      a.device() != b.device() || a.scalar_type() != b.scalar_type()) {
+    return false;
+  }
+  if (a.scalar_type() != at::kHalf && a.scalar_type() != at::kBFloat16 &&
+      a.scalar_type() != at::kFloat) {
+    return false;
+  }
+  // Empty problems are left to ATen, as are sizes that cuBLASLt can't index
+  for (const at::Tensor& t : {a, b}) {
+    for (auto i : arange(2)) {
+      if (t.size(i) == 0 ||
+          t.size(i) > std::numeric_limits<int32_t>::max() ||
+          t.stride(i) > std::numeric_limits<int32_t>::max()) {
+        return false;
+      }
+    }
+  }
+  return columnMajorOperand(a).has_value() && columnMajorOperand(b).has_value();
+}
+
+void* MatmulPlanCache::workspace(cudaStream_t stream, const at::Tensor& like) {
+  at::Tensor& workspace = workspaces_[stream];
+  if (!workspace.defined()) {
+    workspace = at::empty({kWorkspaceBytes}, like.options().dtype(at::kByte));
+  }
+  return workspace.data_ptr();
+}
+
+at::Tensor MatmulPlanCache::matmul(const at::Tensor& a, const at::Tensor& b) {
+  FUSER_PERF_SCOPE("MatmulPlanCache::matmul");
+  const Operand op_a = columnMajorOperand(a).value();
+  const Operand op_b = columnMajorOperand(b).value();
+  // The output is allocated by the caching allocator, which aligns it to at
+  // least 256 bytes
+  const int64_t alignment = std::min(alignmentOf(a), alignmentOf(b));
+  const std::vector<int64_t> key{
+      a.size(0),
+      a.size(1),
+      b.size(1),
+      op_a.op,
+      op_a.ld,
+      op_b.op,
+      op_b.ld,
+      static_cast<int64_t>(a.scalar_type()),
+      a.get_device(),
+      alignment,
+      at::globalContext().allowTF32CuBLAS()};
+
+  at::Tensor out = at::empty({a.size(0), b.size(1)}, a.options());
+  const cudaStream_t stream = c10::cuda::getCurrentCUDAStream(a.get_device());
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  void* workspace_ptr = workspace(stream, a);
+  auto it = plans_.find(key);
+  if (it == plans_.end()) {
+    FUSER_PERF_SCOPE("MatmulPlanCache::createPlan");
+    auto plan = std::make_unique<Plan>(a, b);
+    std::vector<cublasLtMatmulHeuristicResult_t> candidates =
+        plan->heuristics(alignment, tune_ ? kTuneCandidates : 1);
+    if (candidates.size() == 1) {
+      plan->algo = candidates.front().algo;
+      plan->has_algo = true;
+    } else if (candidates.size() > 1) {
+      // Times each candidate on the operands, writing to out, which the
+      // matmul below overwrites
+      cudaEvent_t start = nullptr;
+      cudaEvent_t stop = nullptr;
+      NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&start));
+      NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&stop));
+      float best_ms = std::numeric_limits<float>::max();
+      for (const cublasLtMatmulHeuristicResult_t& candidate : candidates) {
+        // Warms up the algorithm and skips it if it fails
+        if (plan->run(candidate.algo, a, b, out, workspace_ptr, stream) !=
+            CUBLAS_STATUS_SUCCESS) {
+          continue;
+        }
+        NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(start, stream));
+        for ([[maybe_unused]] auto _ : arange(kTuneIterations)) {
+          NVFUSER_CUBLAS_SAFE_CALL(
+              plan->run(candidate.algo, a, b, out, workspace_ptr, stream));
+        }
+        NVFUSER_CUDA_RT_SAFE_CALL(cudaEventRecord(stop, stream));
+        NVFUSER_CUDA_RT_SAFE_CALL(cudaEventSynchronize(stop));
+        float time_ms = 0.0f;
+        NVFUSER_CUDA_RT_SAFE_CALL(cudaEventElapsedTime(&time_ms, start, stop));
+        if (time_ms < best_ms) {
+          best_ms = time_ms;
+          plan->algo = candidate.algo;
+          plan->has_algo = true;
+        }
+      }
+      NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(start));
+      NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(stop));
+    }
+    it = plans_.emplace(key, std::move(plan)).first;
+  }
+  // Plans are immutable once created and never erased, and the workspace of
+  // the stream is only used by matmuls ordered on that stream
+  const Plan& plan = *it->second;
+  lock.unlock();
+
+  if (!plan.has_algo) {
+    return at::matmul(a, b);
+  }
+  NVFUSER_CUBLAS_SAFE_CALL(
+      plan.run(plan.algo, a, b, out, workspace_ptr, stream));
+  return out;
+}
+
+} // namespace nvfuser
@@ -0,0 +1,79 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ATen/Tensor.h>
+#include <cuda_runtime.h>
+
+#include <utils.h>
+
+namespace nvfuser {
+
+//! \class MatmulPlanCache
+//! \brief Caches the cuBLASLt plans of the 2D matmuls run by an
+//! ExprEvalExecutor, set with EnableOption::MatmulPlanCache, so that repeated
+//! matmuls of a problem skip the shape dispatch of at::matmul and the
+//! algorithm heuristic of cuBLASLt.
+//!
+//! A plan holds the matmul and layout descriptors and the algorithm of a
+//! problem, keyed by its sizes, leading dimensions, transposes, data type and
+//! alignment. The algorithm is the first one returned by the cuBLASLt
+//! heuristic, or with the "tune" argument of the option, the fastest of its
+//! candidates timed on the first matmul of the problem. Workspaces are
+//! retained per stream, since matmuls on the same stream are ordered.
+class MatmulPlanCache {
+ public:
+  MatmulPlanCache();
+  ~MatmulPlanCache();
+
+  MatmulPlanCache(const MatmulPlanCache&) = delete;
+  MatmulPlanCache& operator=(const MatmulPlanCache&) = delete;
+
+  //! Returns true if a and b are 2D CUDA tensors of the same floating point
+  //! type, each with a unit stride, i.e., row or column major
+  static bool supports(const at::Tensor& a, const at::Tensor& b);
+
+  //! Returns a @ b as a contiguous tensor. Falls back to at::matmul if
+  //! cuBLASLt has no algorithm for the problem.
+  at::Tensor matmul(const at::Tensor& a, const at::Tensor& b);
+
+  int64_t numPlans() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::ssize(plans_);
+  }
+
+ private:
+  class Plan;
+
+  struct KeyHash {
+    size_t operator()(const std::vector<int64_t>& key) const {
+      size_t hash = 0;
+      for (int64_t value : key) {
+        hashCombine(hash, std::hash<int64_t>()(value));
+      }
+      return hash;
+    }
+  };
+
+  //! Workspace retained for matmuls on stream
+  void* workspace(cudaStream_t stream, const at::Tensor& like);
+
+  const bool tune_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::vector<int64_t>, std::unique_ptr<Plan>, KeyHash>
+      plans_;
+  std::unordered_map<cudaStream_t, at::Tensor> workspaces_;
+};
+
+} // namespace nvfuser
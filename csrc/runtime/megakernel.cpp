@@ -0,0 +1,363 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/megakernel.h>
+
+#include <driver_api.h>
+#include <exceptions.h>
+#include <global_allocator.h>
+#include <instrumentation.h>
+#include <options.h>
+#include <runtime/compiled_kernel.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/core/DeviceGuard.h>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace nvfuser {
+
+namespace {
+
+// Chain set by LaunchChainGuard
+thread_local LaunchChain* current_chain = nullptr;
+
+// The size limit of kernel parameters, see usesKernelArgTable
+constexpr int64_t kMaxKernelParamBytes = 4096;
+
+int64_t maxChainBlocks(c10::Device device) {
+  const std::vector<std::string>& args =
+      getEnableOptionArguments(EnableOption::Megakernel);
+  if (args.empty()) {
+    return at::cuda::getDeviceProperties(device.index())->multiProcessorCount;
+  }
+  int64_t max_blocks = 0;
+  try {
+    max_blocks = std::stoll(args.at(0));
+  } catch (const std::exception&) {
+  }
+  NVF_CHECK(
+      max_blocks > 0,
+      "NVFUSER_ENABLE=megakernel expects a positive number of blocks, got ",
+      args.at(0));
+  return max_blocks;
+}
+
+bool sameGrid(const LaunchParams& a, const LaunchParams& b) {
+  return a.gdimx() == b.gdimx() && a.gdimy() == b.gdimy() &&
+      a.gdimz() == b.gdimz() && a.bdimx() == b.bdimx() &&
+      a.bdimy() == b.bdimy() && a.bdimz() == b.bdimz();
+}
+
+// Type and name of each parameter of the kernel whose parameter list starts
+// at pos, i.e., right after its opening parenthesis. Parameters are split at
+// the commas that aren't nested in template arguments. Returns std::nullopt
+// if a parameter isn't a type followed by a name.
+std::optional<std::vector<std::pair<std::string, std::string>>> parameters(
+    const std::string& code,
+    size_t pos) {
+  std::vector<std::pair<std::string, std::string>> params;
+  auto add = [&](size_t begin, size_t end) {
+    const size_t first = code.find_first_not_of(" \n", begin);
+    const size_t last = code.find_last_not_of(" \n", end - 1);
+    if (first == std::string::npos || first >= end) {
+      return true;
+    }
+    const std::string decl = code.substr(first, last - first + 1);
+    const size_t name_pos = decl.find_last_not_of(
+                                "abcdefghijklmnopqrstuvwxyz"
+                                "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_") +
+        1;
+    if (name_pos == 0 || name_pos == decl.size()) {
+      return false;
+    }
+    params.emplace_back(decl.substr(0, name_pos), decl.substr(name_pos));
+    return true;
+  };
+
+  int64_t depth = 0;
+  size_t begin = pos;
+  for (size_t i = pos; i < code.size(); ++i) {
+    const char c = code[i];
+    if (c == '<' || c == '(') {
+      ++depth;
+    } else if (c == '>') {
+      --depth;
+    } else if (c == ')' && depth > 0) {
+      --depth;
+    } else if (c == ')' || (c == ',' && depth == 0)) {
+      if (!add(begin, i)) {
+        return std::nullopt;
+      }
+      if (c == ')') {
+        return params;
+      }
+      begin = i + 1;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+std::unique_ptr<Megakernel> Megakernel::compile(
+    const std::vector<DeferredLaunch>& launches) {
+  FUSER_PERF_SCOPE("Megakernel::compile");
+  NVF_ERROR(!launches.empty());
+  const CompiledKernel& first = *launches.front().executor->compiledKernel();
+  c10::DeviceGuard dg(first.device());
+
+  std::stringstream stages;
+  std::stringstream params;
+  std::stringstream body;
+  for (auto i : arange(launches.size())) {
+    const CompiledKernel& kernel = *launches.at(i).executor->compiledKernel();
+    std::string code = kernel.kernelCode();
+    const std::string declaration =
+        "__global__ void " + kernel.kernelName() + "(";
+    const size_t pos = code.find(declaration);
+    if (pos == std::string::npos) {
+      return nullptr;
+    }
+    auto stage_params = parameters(code, pos + declaration.size());
+    if (!stage_params.has_value()) {
+      return nullptr;
+    }
+    // The stage is called by the megakernel with its parameters instead
+    code.replace(pos, std::strlen("__global__"), "__device__");
+
+    const std::string ns = "stage" + std::to_string(i);
+    stages << "namespace " << ns << " {\n"
+           << code << "\n} // namespace " << ns << "\n\n";
+    body << "  " << ns << "::" << kernel.kernelName() << "(";
+    for (auto j : arange(stage_params->size())) {
+      const auto& [type, name] = stage_params->at(j);
+      params << type << ns << "_" << name << ", ";
+      body << (j > 0 ? ", " : "") << ns << "_" << name;
+    }
+    body << ");\n";
+    if (i + 1 < launches.size()) {
+      body << "  grid_sync::sync<true, true, true, true, false>(*semaphore, "
+              "num_blocks, DefaultBlockDim());\n";
+    }
+  }
+
+  const std::string name = "nvfuser_megakernel_" + first.kernelId() + "_n" +
+      std::to_string(launches.size());
+  std::stringstream code;
+  code << stages.str() << "__global__ void " << name << "(" << params.str()
+       << "int64_t* semaphore) {\n"
+       << "  const uint64_t num_blocks =\n"
+       << "      (uint64_t)gridDim.x * gridDim.y * gridDim.z;\n"
+       << body.str()
+       << "  // Only the last block waits for the others, which don't touch\n"
+       << "  // the semaphore anymore, so it can reset it for the next launch\n"
+       << "  grid_sync::sync<true, true, true, false, false>(*semaphore, "
+          "num_blocks, DefaultBlockDim());\n"
+       << "  if (index_utils::maskedIsLast<true, true, true>(blockIdx, "
+          "gridDim) &&\n"
+       << "      threadIdx.x == 0 && threadIdx.y == 0 && threadIdx.z == 0) {\n"
+       << "    *semaphore = 0;\n"
+       << "  }\n"
+       << "}\n";
+
+  CompileParams compile_params;
+  compile_params.index_type = first.kernel()->indexType();
+  compile_params.device = first.device();
+  auto megakernel = std::make_unique<Megakernel>();
+  megakernel->executable_ = compileKernelCode(
+      code.str(),
+      name,
+      compile_params,
+      launches.front().launch_params.nThreads());
+  return megakernel;
+}
+
+bool Megakernel::launch(
+    std::vector<DeferredLaunch>& launches,
+    CUstream stream) {
+  FUSER_PERF_SCOPE("Megakernel::launch");
+  const LaunchParams& launch_params = launches.front().launch_params;
+  const c10::Device device =
+      launches.front().executor->compiledKernel()->device();
+
+  int64_t smem = 0;
+  int64_t param_bytes = (int64_t)sizeof(void*);
+  for (const DeferredLaunch& launch : launches) {
+    smem = std::max(smem, launch.launch_params.smem());
+    param_bytes += std::ssize(launch.launch_args.packed_args);
+    for (const auto& bytes : launch.launch_args.args) {
+      param_bytes +=
+          roundUpToMultiple(std::ssize(bytes), (int64_t)sizeof(void*));
+    }
+  }
+  if (param_bytes > kMaxKernelParamBytes) {
+    return false;
+  }
+
+  const CUfunction function = executable_->function;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (smem > available_dynamic_smem_size_) {
+      if (cuFuncSetAttribute(
+              function,
+              CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES,
+              (int)smem) != CUDA_SUCCESS) {
+        return false;
+      }
+      available_dynamic_smem_size_ = smem;
+    }
+    if (smem != occupancy_smem_size_) {
+      int blocks_per_sm = 0;
+      NVFUSER_CUDA_SAFE_CALL(cuOccupancyMaxActiveBlocksPerMultiprocessor(
+          &blocks_per_sm,
+          function,
+          (int)launch_params.nThreads(),
+          (size_t)smem));
+      resident_blocks_ = (int64_t)blocks_per_sm *
+          at::cuda::getDeviceProperties(device.index())->multiProcessorCount;
+      occupancy_smem_size_ = smem;
+    }
+    // Blocks spinning in a grid sync would wait for blocks that never start
+    if (launch_params.nBlocks() > resident_blocks_) {
+      return false;
+    }
+  }
+
+  // The megakernel resets the semaphore to zero before it exits
+  at::Tensor semaphore = contigZeroedTensor({1}, at::kLong, device);
+  void* semaphore_ptr = semaphore.data_ptr();
+  std::vector<void*> arg_ptrs;
+  for (DeferredLaunch& launch : launches) {
+    arg_ptrs.insert(
+        arg_ptrs.end(),
+        launch.launch_args.arg_ptrs.begin(),
+        launch.launch_args.arg_ptrs.end());
+  }
+  arg_ptrs.push_back(&semaphore_ptr);
+
+  std::optional<inst::KernelTraceScope> kernel_trace_scope;
+  if (inst::Trace::instance()->isEnabled()) {
+    kernel_trace_scope.emplace(executable_->kernel_name, stream);
+  }
+  NVFUSER_CUDA_SAFE_CALL(cuLaunchCooperativeKernel(
+      function,
+      launch_params.gdimx(),
+      launch_params.gdimy(),
+      launch_params.gdimz(),
+      launch_params.bdimx(),
+      launch_params.bdimy(),
+      launch_params.bdimz(),
+      smem,
+      stream,
+      arg_ptrs.data()));
+  return true;
+}
+
+Megakernel* MegakernelCache::get(const std::vector<DeferredLaunch>& launches) {
+  std::vector<CUfunction> key;
+  key.reserve(launches.size());
+  for (const DeferredLaunch& launch : launches) {
+    key.push_back(launch.executable->function);
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto [it, is_new] = megakernels_.try_emplace(std::move(key));
+  if (is_new) {
+    // A failure is cached as nullptr, and the kernels are launched
+    // separately from then on
+    try {
+      it->second = Megakernel::compile(launches);
+    } catch (const std::exception& e) {
+      TORCH_WARN(
+          "Failed to compile the megakernel of ",
+          launches.size(),
+          " kernels, which are launched separately: ",
+          e.what());
+    }
+  }
+  return it->second.get();
+}
+
+LaunchChain::LaunchChain(MegakernelCache& megakernels, c10::Device device)
+    : megakernels_(megakernels),
+      device_(device),
+      max_blocks_(maxChainBlocks(device)) {}
+
+LaunchChain* LaunchChain::current() {
+  return current_chain;
+}
+
+bool LaunchChain::defer(
+    KernelExecutor* executor,
+    std::shared_ptr<executor_utils::CudaExecutable> executable,
+    const LaunchParams& launch_params,
+    KernelLaunchArgs& launch_args,
+    const KernelArgumentHolder& args) {
+  const bool can_defer = launch_params.nBlocks() <= max_blocks_ &&
+      executor->canRunInMegakernel();
+  if (!launches_.empty()) {
+    const DeferredLaunch& first = launches_.front();
+    if (!can_defer || !sameGrid(first.launch_params, launch_params) ||
+        first.executor->compiledKernel()->kernel()->indexType() !=
+            executor->compiledKernel()->kernel()->indexType()) {
+      flush();
+    }
+  }
+  if (!can_defer) {
+    return false;
+  }
+  launches_.push_back(
+      {executor,
+       std::move(executable),
+       launch_params,
+       std::move(launch_args),
+       args});
+  return true;
+}
+
+void LaunchChain::flush() {
+  if (launches_.empty()) {
+    return;
+  }
+  FUSER_PERF_SCOPE("LaunchChain::flush");
+  c10::DeviceGuard dg(device_);
+  CUstream stream = at::cuda::getCurrentCUDAStream(device_.index());
+
+  bool is_launched = false;
+  if (launches_.size() > 1) {
+    if (Megakernel* megakernel = megakernels_.get(launches_)) {
+      is_launched = megakernel->launch(launches_, stream);
+    }
+  }
+  if (is_launched) {
+    megakernels_.recordLaunch();
+  } else {
+    for (DeferredLaunch& launch : launches_) {
+      launch.executor->launchKernel(
+          *launch.executable, launch.launch_params, launch.launch_args, stream);
+    }
+  }
+  launches_.clear();
+  resetZeroedMemory(device_);
+}
+
+LaunchChainGuard::LaunchChainGuard(LaunchChain* chain)
+    : prev_chain_(current_chain) {
+  current_chain = chain;
+}
+
+LaunchChainGuard::~LaunchChainGuard() {
+  current_chain = prev_chain_;
+}
+
+} // namespace nvfuser
@@ -0,0 +1,181 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <c10/core/Device.h>
+#include <cuda.h>
+
+#include <runtime/executor.h>
+#include <runtime/executor_kernel_arg.h>
+#include <runtime/executor_params.h>
+#include <runtime/executor_utils.h>
+#include <utils.h>
+
+namespace nvfuser {
+
+//! A kernel launch prepared by KernelExecutor::run and deferred by a
+//! LaunchChain
+struct DeferredLaunch {
+  KernelExecutor* executor = nullptr;
+  //! The compiled kernel of executor when the launch was prepared
+  std::shared_ptr<executor_utils::CudaExecutable> executable;
+  LaunchParams launch_params;
+  KernelLaunchArgs launch_args;
+  //! Keeps the inputs, outputs and intermediates of the launch alive until
+  //! it's enqueued, so that their memory isn't handed to work enqueued
+  //! before it
+  KernelArgumentHolder args;
+};
+
+//! \class Megakernel
+//! \brief A persistent cooperative kernel running the kernels of consecutive
+//! segments as stages, separated by grid syncs of runtime/grid_sync.cu.
+//!
+//! The code of each stage is the generated kernel turned into a device
+//! function, which the megakernel calls with its own parameters. Stages are
+//! launched with the same grid and block, so they see the same blockIdx and
+//! blockDim as on their own, and get the largest dynamic shared memory of
+//! them. All blocks must be resident on the device at once.
+class Megakernel {
+ public:
+  //! Generates and compiles the megakernel of the kernels of launches.
+  //! Returns nullptr if the code of a kernel can't be made a stage.
+  static std::unique_ptr<Megakernel> compile(
+      const std::vector<DeferredLaunch>& launches);
+
+  //! Enqueues launches on stream as one launch of this megakernel. Returns
+  //! false without enqueuing anything if its grid can't be resident on the
+  //! device at once or its parameters exceed the limit of kernel
+  //! parameters.
+  bool launch(std::vector<DeferredLaunch>& launches, CUstream stream);
+
+ private:
+  std::unique_ptr<executor_utils::CudaExecutable> executable_;
+  //! Dynamic shared memory size the function was configured for
+  int64_t available_dynamic_smem_size_ = 0;
+  //! Blocks that can be resident on the device at once with the dynamic
+  //! shared memory size they were computed for
+  int64_t occupancy_smem_size_ = -1;
+  int64_t resident_blocks_ = 0;
+  std::mutex mutex_;
+};
+
+//! \class MegakernelCache
+//! \brief Megakernels of a FusionKernelRuntime, keyed by the functions of
+//! their stages, which change when a stage is recompiled.
+class MegakernelCache {
+ public:
+  //! Returns the megakernel of the kernels of launches, which is compiled on
+  //! first use, or nullptr if it can't be compiled
+  Megakernel* get(const std::vector<DeferredLaunch>& launches);
+
+  //! Number of launches enqueued through megakernels of this cache
+  int64_t numLaunches() const {
+    return num_launches_.load(std::memory_order_relaxed);
+  }
+
+  void recordLaunch() {
+    num_launches_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+ private:
+  struct KeyHash {
+    size_t operator()(const std::vector<CUfunction>& key) const {
+      size_t hash = 0;
+      for (CUfunction function : key) {
+        hashCombine(hash, std::hash<CUfunction>()(function));
+      }
+      return hash;
+    }
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<
+      std::vector<CUfunction>,
+      std::unique_ptr<Megakernel>,
+      KeyHash>
+      megakernels_;
+  std::atomic<int64_t> num_launches_ = 0;
+};
+
+//! \class LaunchChain
+//! \brief Defers the kernel launches of consecutive segments of a
+//! FusionKernelRuntime run with EnableOption::Megakernel, and enqueues them
+//! as one Megakernel when they are flushed.
+//!
+//! A launch joins the chain if its kernel can run in a megakernel and its
+//! grid has no more blocks than the argument of the option, by default the
+//! number of SMs. Such grids are resident on the device at once, and their
+//! kernels are short enough for the launch gaps between them to matter,
+//! e.g., the kernels of a decode step with batch size 1. A launch with a
+//! different grid, block or index type flushes the chain and starts a new
+//! one.
+//!
+//! Since the launches are enqueued after the host has moved on to the
+//! following segments, any other work enqueued on the stream in between
+//! must flush the chain first. The tensors of the deferred launches are held
+//! until they are enqueued, so that their memory isn't reused by such work
+//! or by the following launches, and the zeroed memory handed to them is
+//! only reset after they are enqueued.
+class LaunchChain {
+ public:
+  LaunchChain(MegakernelCache& megakernels, c10::Device device);
+
+  //! Drops the pending launches, e.g., when a segment throws
+  ~LaunchChain() = default;
+
+  LaunchChain(const LaunchChain&) = delete;
+  LaunchChain& operator=(const LaunchChain&) = delete;
+
+  //! Chain of the runtime running on the calling thread, if any
+  static LaunchChain* current();
+
+  //! Defers the launch of executable, the compiled kernel of executor, with
+  //! launch_args, which are taken, and the tensors of args. If it can't be
+  //! deferred, the pending launches are enqueued first and false is
+  //! returned, in which case the caller enqueues it.
+  bool defer(
+      KernelExecutor* executor,
+      std::shared_ptr<executor_utils::CudaExecutable> executable,
+      const LaunchParams& launch_params,
+      KernelLaunchArgs& launch_args,
+      const KernelArgumentHolder& args);
+
+  //! Enqueues the pending launches on the current stream, as a megakernel if
+  //! there are several of them
+  void flush();
+
+ private:
+  MegakernelCache& megakernels_;
+  const c10::Device device_;
+  const int64_t max_blocks_;
+  std::vector<DeferredLaunch> launches_;
+};
+
+//! \class LaunchChainGuard
+//! \brief Makes a chain the current one of the thread while alive
+class LaunchChainGuard {
+ public:
+  explicit LaunchChainGuard(LaunchChain* chain);
+  ~LaunchChainGuard();
+
+  LaunchChainGuard(const LaunchChainGuard&) = delete;
+  LaunchChainGuard& operator=(const LaunchChainGuard&) = delete;
+
+ private:
+  LaunchChain* prev_chain_;
+};
+
+} // namespace nvfuser
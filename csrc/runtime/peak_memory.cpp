@@ -0,0 +1,73 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/peak_memory.h>
+
+#include <algorithm>
+
+namespace nvfuser {
+
+namespace {
+
+// Tracker set by PeakMemoryTrackerGuard
+thread_local PeakMemoryTracker* current_tracker = nullptr;
+
+} // namespace
+
+PeakMemoryTracker* PeakMemoryTracker::current() {
+  return current_tracker;
+}
+
+void PeakMemoryTracker::allocated(const at::Tensor& tensor) {
+  if (!tensor.defined() || !tensor.has_storage()) {
+    return;
+  }
+  const c10::StorageImpl* storage = tensor.storage().unsafeGetStorageImpl();
+  for (const auto& [weak_storage, bytes] : storages_) {
+    if (!weak_storage.expired() &&
+        weak_storage._unsafe_get_target() == storage) {
+      return;
+    }
+  }
+  storages_.emplace_back(
+      tensor.storage().getWeakStorageImpl(),
+      static_cast<int64_t>(tensor.storage().nbytes()));
+  update();
+}
+
+void PeakMemoryTracker::reserve(int64_t bytes) {
+  reserved_bytes_ += bytes;
+  update();
+}
+
+void PeakMemoryTracker::release(int64_t bytes) {
+  reserved_bytes_ -= bytes;
+}
+
+// Memory is freed between allocations, so the peak is reached right after
+// one of them
+void PeakMemoryTracker::update() {
+  std::erase_if(storages_, [](const auto& storage) {
+    return storage.first.expired();
+  });
+  int64_t live_bytes = reserved_bytes_;
+  for (const auto& [weak_storage, bytes] : storages_) {
+    live_bytes += bytes;
+  }
+  peak_bytes_ = std::max(peak_bytes_, live_bytes);
+}
+
+PeakMemoryTrackerGuard::PeakMemoryTrackerGuard(PeakMemoryTracker* tracker)
+    : prev_tracker_(current_tracker) {
+  current_tracker = tracker;
+}
+
+PeakMemoryTrackerGuard::~PeakMemoryTrackerGuard() {
+  current_tracker = prev_tracker_;
+}
+
+} // namespace nvfuser
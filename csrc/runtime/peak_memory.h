@@ -0,0 +1,69 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <ATen/Tensor.h>
+#include <c10/util/intrusive_ptr.h>
+
+namespace nvfuser {
+
+//! \class PeakMemoryTracker
+//! \brief Tracks the device memory used by an execution of a segmented fusion,
+//! i.e., its outputs, intermediates and zeroed buffers, and its high-water
+//! mark.
+//!
+//! Allocations are held by weak references to their storage, so they are
+//! freed once the last tensor viewing them is destroyed, e.g., when
+//! ArgumentManager drops a segment output after its last use. Memory kept
+//! across executions, i.e., pooled intermediates and the zeroed memory arena,
+//! is counted while a kernel uses it.
+class PeakMemoryTracker {
+ public:
+  //! Tracker of the execution on the calling thread, if any
+  static PeakMemoryTracker* current();
+
+  //! Counts a new allocation until its storage is freed. Tensors viewing a
+  //! storage already counted are ignored.
+  void allocated(const at::Tensor& tensor);
+
+  //! Counts memory kept across executions until it is released
+  void reserve(int64_t bytes);
+  void release(int64_t bytes);
+
+  int64_t peakBytes() const {
+    return peak_bytes_;
+  }
+
+ private:
+  void update();
+
+  std::vector<std::pair<c10::weak_intrusive_ptr<c10::StorageImpl>, int64_t>>
+      storages_;
+  int64_t reserved_bytes_ = 0;
+  int64_t peak_bytes_ = 0;
+};
+
+//! \class PeakMemoryTrackerGuard
+//! \brief Makes a tracker the current one of the thread while alive
+class PeakMemoryTrackerGuard {
+ public:
+  explicit PeakMemoryTrackerGuard(PeakMemoryTracker* tracker);
+  ~PeakMemoryTrackerGuard();
+
+  PeakMemoryTrackerGuard(const PeakMemoryTrackerGuard&) = delete;
+  PeakMemoryTrackerGuard& operator=(const PeakMemoryTrackerGuard&) = delete;
+
+ private:
+  PeakMemoryTracker* prev_tracker_;
+};
+
+} // namespace nvfuser
@@ -0,0 +1,326 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/sampling_profiler.h>
+
+#include <cuda_utils.h>
+#include <exceptions.h>
+#include <options.h>
+#include <utils.h>
+
+#include <c10/cuda/CUDAGuard.h>
+
+#include <cmath>
+#include <iomanip>
+
+namespace nvfuser {
+
+namespace {
+
+// Execution sampled on this thread, set by SampledExecutionGuard
+thread_local FusionSampler::Execution* current_execution = nullptr;
+
+int64_t samplingPeriod() {
+  const std::vector<std::string>& args =
+      getProfilerOptionArguments(ProfilerOption::Sample);
+  if (args.empty()) {
+    return 100;
+  }
+  int64_t period = 0;
+  try {
+    period = std::stoll(args.at(0));
+  } catch (const std::exception&) {
+  }
+  NVF_CHECK(
+      period > 0,
+      "NVFUSER_PROF=sample expects a positive sampling period, got ",
+      args.at(0));
+  return period;
+}
+
+int64_t bucketOf(double time_us) {
+  if (time_us < 1.0) {
+    return 0;
+  }
+  return std::min(
+      static_cast<int64_t>(std::floor(std::log2(time_us))) + 1,
+      LatencyHistogram::num_buckets - 1);
+}
+
+} // namespace
+
+double LatencyHistogram::bucketUpperBoundUs(int64_t bucket) {
+  return std::ldexp(1.0, static_cast<int>(bucket));
+}
+
+double LatencyHistogram::meanUs() const {
+  return count == 0 ? 0.0 : total_us / static_cast<double>(count);
+}
+
+double LatencyHistogram::percentileUs(double percentile) const {
+  NVF_CHECK(
+      percentile > 0.0 && percentile <= 100.0,
+      "Invalid percentile: ",
+      percentile);
+  const auto rank = static_cast<int64_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(count)));
+  int64_t seen = 0;
+  for (auto bucket : arange(num_buckets)) {
+    seen += counts.at(bucket);
+    if (seen >= rank && seen > 0) {
+      return std::min(bucketUpperBoundUs(bucket), max_us);
+    }
+  }
+  return 0.0;
+}
+
+std::ostream& operator<<(std::ostream& os, const FusionSamples& samples) {
+  auto print = [&os](const std::string& name, const LatencyHistogram& h) {
+    os << std::left << std::setw(10) << name << std::right << std::setw(10)
+       << h.count << std::setprecision(3) << std::fixed << std::setw(12)
+       << h.meanUs() << std::setw(12)
+       << (h.count > 0 ? h.percentileUs(50.0) : 0.0) << std::setw(12)
+       << (h.count > 0 ? h.percentileUs(99.0) : 0.0) << std::setw(12)
+       << h.max_us << std::endl;
+  };
+  os << "Fusion " << samples.fusion_id << ": " << samples.executions
+     << " executions, " << samples.fusion.count << " sampled, "
+     << samples.dropped << " dropped" << std::endl;
+  os << std::left << std::setw(10) << "" << std::right << std::setw(10)
+     << "Samples" << std::setw(12) << "Mean(us)" << std::setw(12)
+     << "P50(us)" << std::setw(12) << "P99(us)" << std::setw(12)
+     << "Max(us)" << std::endl;
+  print("fusion", samples.fusion);
+  for (auto i : arange(samples.segments.size())) {
+    print("segment " + std::to_string(i), samples.segments.at(i));
+  }
+  return os;
+}
+
+void FusionSampler::AtomicHistogram::add(float time_ms) {
+  const double time_us = static_cast<double>(time_ms) * 1.0e3;
+  const auto time_ns = static_cast<int64_t>(time_us * 1.0e3);
+  counts.at(bucketOf(time_us)).fetch_add(1, std::memory_order_relaxed);
+  total_ns.fetch_add(time_ns, std::memory_order_relaxed);
+  int64_t max = max_ns.load(std::memory_order_relaxed);
+  while (time_ns > max &&
+         !max_ns.compare_exchange_weak(
+             max, time_ns, std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogram FusionSampler::AtomicHistogram::snapshot() const {
+  LatencyHistogram h;
+  for (auto bucket : arange(LatencyHistogram::num_buckets)) {
+    h.counts.at(bucket) = counts.at(bucket).load(std::memory_order_relaxed);
+    h.count += h.counts.at(bucket);
+  }
+  h.total_us =
+      static_cast<double>(total_ns.load(std::memory_order_relaxed)) * 1.0e-3;
+  h.max_us =
+      static_cast<double>(max_ns.load(std::memory_order_relaxed)) * 1.0e-3;
+  return h;
+}
+
+FusionSampler::Execution::~Execution() {
+  destroyEvents();
+}
+
+void FusionSampler::Execution::createEvents(c10::DeviceIndex device) {
+  destroyEvents();
+  c10::cuda::CUDAGuard device_guard(device);
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&start_event_));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&stop_event_));
+  device_ = device;
+}
+
+void FusionSampler::Execution::destroyEvents() {
+  if (device_ == -1) {
+    return;
+  }
+  // Events are destroyed on the device they were created on
+  c10::cuda::CUDAGuard device_guard(device_);
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(start_event_));
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(stop_event_));
+  for (const auto& [start, stop] : segment_events_) {
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(start));
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventDestroy(stop));
+  }
+  segment_events_.clear();
+  segment_recorded_.clear();
+  device_ = -1;
+}
+
+void FusionSampler::Execution::startSegment(
+    int64_t segment_id,
+    c10::cuda::CUDAStream stream) {
+  if (segment_id >= FusionSampler::max_segments ||
+      stream.device_index() != device_) {
+    return;
+  }
+  c10::cuda::CUDAGuard device_guard(device_);
+  while (std::ssize(segment_events_) <= segment_id) {
+    std::array<cudaEvent_t, 2>& events = segment_events_.emplace_back();
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&events[0]));
+    NVFUSER_CUDA_RT_SAFE_CALL(cudaEventCreate(&events[1]));
+    segment_recorded_.push_back(false);
+  }
+  NVFUSER_CUDA_RT_SAFE_CALL(
+      cudaEventRecord(segment_events_.at(segment_id)[0], stream.stream()));
+}
+
+void FusionSampler::Execution::stopSegment(
+    int64_t segment_id,
+    c10::cuda::CUDAStream stream) {
+  if (segment_id >= std::ssize(segment_events_) ||
+      stream.device_index() != device_) {
+    return;
+  }
+  c10::cuda::CUDAGuard device_guard(device_);
+  NVFUSER_CUDA_RT_SAFE_CALL(
+      cudaEventRecord(segment_events_.at(segment_id)[1], stream.stream()));
+  segment_recorded_.at(segment_id) = true;
+}
+
+FusionSampler::FusionSampler(int64_t fusion_id)
+    : fusion_id_(fusion_id),
+      period_(samplingPeriod()),
+      slots_(std::make_unique<std::array<Execution, num_slots>>()) {}
+
+FusionSampler::~FusionSampler() = default;
+
+bool FusionSampler::isEnabled() {
+  return ProfilerOptionsGuard::getCurOptions().has(ProfilerOption::Sample);
+}
+
+FusionSampler::Execution* FusionSampler::start(c10::cuda::CUDAStream stream) {
+  if (executions_.fetch_add(1, std::memory_order_relaxed) % period_ != 0) {
+    return nullptr;
+  }
+  drain();
+
+  // Claims the next free slot of the ring
+  const int64_t first = next_slot_.fetch_add(1, std::memory_order_relaxed);
+  for (auto i : arange(num_slots)) {
+    Execution& slot = slots_->at((first + i) % num_slots);
+    auto expected = Execution::State::Free;
+    if (!slot.state_.compare_exchange_strong(
+            expected,
+            Execution::State::Recording,
+            std::memory_order_acquire)) {
+      continue;
+    }
+    try {
+      if (slot.device_ != stream.device_index()) {
+        slot.createEvents(stream.device_index());
+      }
+      std::fill(
+          slot.segment_recorded_.begin(), slot.segment_recorded_.end(), false);
+      c10::cuda::CUDAGuard device_guard(slot.device_);
+      NVFUSER_CUDA_RT_SAFE_CALL(
+          cudaEventRecord(slot.start_event_, stream.stream()));
+    } catch (...) {
+      slot.state_.store(Execution::State::Free, std::memory_order_release);
+      throw;
+    }
+    return &slot;
+  }
+  dropped_.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+void FusionSampler::stop(
+    Execution* execution,
+    c10::cuda::CUDAStream stream) {
+  // Called while unwinding when the execution throws, so this doesn't throw
+  // but discards the sample instead
+  c10::cuda::CUDAGuard device_guard(execution->device_);
+  if (cudaEventRecord(execution->stop_event_, stream.stream()) !=
+      cudaSuccess) {
+    (void)cudaGetLastError();
+    execution->state_.store(Execution::State::Free, std::memory_order_release);
+    return;
+  }
+  execution->state_.store(
+      Execution::State::Pending, std::memory_order_release);
+}
+
+FusionSampler::Execution* FusionSampler::current() {
+  return current_execution;
+}
+
+void FusionSampler::drain() {
+  for (Execution& slot : *slots_) {
+    auto expected = Execution::State::Pending;
+    if (!slot.state_.compare_exchange_strong(
+            expected, Execution::State::Draining, std::memory_order_acquire)) {
+      continue;
+    }
+    // The segments were recorded before the stop event, so they are complete
+    // too. Querying the event doesn't synchronize.
+    c10::cuda::CUDAGuard device_guard(slot.device_);
+    const cudaError_t status = cudaEventQuery(slot.stop_event_);
+    if (status == cudaErrorNotReady) {
+      slot.state_.store(Execution::State::Pending, std::memory_order_release);
+      continue;
+    }
+    if (status != cudaSuccess) {
+      slot.state_.store(Execution::State::Free, std::memory_order_release);
+      NVFUSER_CUDA_RT_SAFE_CALL(status);
+    }
+
+    float time_ms = 0.0f;
+    NVFUSER_CUDA_RT_SAFE_CALL(
+        cudaEventElapsedTime(&time_ms, slot.start_event_, slot.stop_event_));
+    fusion_histogram_.add(time_ms);
+    for (auto segment_id : arange(slot.segment_events_.size())) {
+      if (!slot.segment_recorded_.at(segment_id)) {
+        continue;
+      }
+      const auto& [start, stop] = slot.segment_events_.at(segment_id);
+      NVFUSER_CUDA_RT_SAFE_CALL(cudaEventElapsedTime(&time_ms, start, stop));
+      segment_histograms_.at(segment_id).add(time_ms);
+    }
+    slot.state_.store(Execution::State::Free, std::memory_order_release);
+  }
+}
+
+FusionSamples FusionSampler::samples() {
+  drain();
+  FusionSamples samples;
+  samples.fusion_id = fusion_id_;
+  samples.executions = executions_.load(std::memory_order_relaxed);
+  samples.dropped = dropped_.load(std::memory_order_relaxed);
+  samples.fusion = fusion_histogram_.snapshot();
+  for (const AtomicHistogram& histogram : segment_histograms_) {
+    samples.segments.push_back(histogram.snapshot());
+  }
+  // Segments beyond the last one sampled aren't reported
+  while (!samples.segments.empty() && samples.segments.back().count == 0) {
+    samples.segments.pop_back();
+  }
+  return samples;
+}
+
+SampledExecutionGuard::SampledExecutionGuard(
+    FusionSampler* sampler,
+    c10::cuda::CUDAStream stream)
+    : sampler_(sampler), stream_(stream), prev_execution_(current_execution) {
+  if (sampler_ != nullptr) {
+    execution_ = sampler_->start(stream_);
+  }
+  current_execution = execution_;
+}
+
+SampledExecutionGuard::~SampledExecutionGuard() {
+  current_execution = prev_execution_;
+  if (execution_ != nullptr) {
+    sampler_->stop(execution_, stream_);
+  }
+}
+
+} // namespace nvfuser
@@ -0,0 +1,173 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <c10/cuda/CUDAStream.h>
+#include <cuda_runtime.h>
+
+#include <visibility.h>
+
+namespace nvfuser {
+
+//! \struct LatencyHistogram
+//! \brief Snapshot of the latencies sampled for a fusion or a segment, in
+//! power-of-two buckets of microseconds.
+struct LatencyHistogram {
+  static constexpr int64_t num_buckets = 32;
+
+  //! Bucket 0 counts latencies below 1 us and bucket i > 0 those in
+  //! [2^(i-1), 2^i) us. The last bucket also counts longer latencies.
+  std::array<int64_t, num_buckets> counts{};
+  int64_t count = 0;
+  double total_us = 0.0;
+  double max_us = 0.0;
+
+  //! Exclusive upper bound of the latencies counted in bucket
+  static double bucketUpperBoundUs(int64_t bucket);
+
+  double meanUs() const;
+  //! Upper bound of the bucket holding the given percentile, in (0, 100]
+  double percentileUs(double percentile) const;
+};
+
+//! \struct FusionSamples
+//! \brief Latency histograms of a fusion and of its segments, as returned by
+//! FusionSampler::samples.
+struct FusionSamples {
+  int64_t fusion_id = -1;
+  //! Executions of the fusion while sampling was enabled
+  int64_t executions = 0;
+  //! Sampled executions not recorded because all slots were still waiting
+  //! for their events
+  int64_t dropped = 0;
+  LatencyHistogram fusion;
+  //! Indexed by segment id. A fusion whose segmentation depends on the
+  //! inputs accumulates the segments of each segmentation by id.
+  std::vector<LatencyHistogram> segments;
+};
+
+NVF_API std::ostream& operator<<(
+    std::ostream& os,
+    const FusionSamples& samples);
+
+//! \class FusionSampler
+//! \brief Samples the latency of 1 in N executions of a fusion, set with
+//! ProfilerOption::Sample, and of its segments with CUDA events only, so that
+//! it can be left enabled in production, unlike FusionProfiler.
+//!
+//! The events of sampled executions are kept in a fixed ring of slots until
+//! they complete, without synchronizing. Slots are claimed and drained into
+//! the histograms with atomic operations only, so concurrent executions of
+//! the fusion neither lock nor wait for each other. A FusionSampler is owned
+//! by the FusionExecutorCache of the fusion.
+class FusionSampler {
+ public:
+  class Execution;
+
+  NVF_API explicit FusionSampler(int64_t fusion_id);
+  NVF_API ~FusionSampler();
+
+  FusionSampler(const FusionSampler&) = delete;
+  FusionSampler& operator=(const FusionSampler&) = delete;
+
+  //! Returns true if ProfilerOption::Sample is set
+  static bool isEnabled();
+
+  //! Counts an execution and returns a slot recording it on stream if it is
+  //! one of the 1 in N sampled, or nullptr otherwise
+  Execution* start(c10::cuda::CUDAStream stream);
+  void stop(Execution* execution, c10::cuda::CUDAStream stream);
+
+  //! Execution sampled on the calling thread, if any
+  static Execution* current();
+
+  //! Drains the completed executions and returns the histograms
+  NVF_API FusionSamples samples();
+
+ private:
+  static constexpr int64_t num_slots = 64;
+  static constexpr int64_t max_segments = 64;
+
+  struct AtomicHistogram {
+    std::array<std::atomic<int64_t>, LatencyHistogram::num_buckets> counts{};
+    std::atomic<int64_t> total_ns{0};
+    std::atomic<int64_t> max_ns{0};
+
+    void add(float time_ms);
+    LatencyHistogram snapshot() const;
+  };
+
+  //! Adds the completed executions to the histograms and frees their slots
+  void drain();
+
+  const int64_t fusion_id_;
+  const int64_t period_;
+  std::atomic<int64_t> executions_{0};
+  std::atomic<int64_t> dropped_{0};
+  std::atomic<int64_t> next_slot_{0};
+  std::unique_ptr<std::array<Execution, num_slots>> slots_;
+  AtomicHistogram fusion_histogram_;
+  std::array<AtomicHistogram, max_segments> segment_histograms_;
+};
+
+//! \class FusionSampler::Execution
+//! \brief A slot of the ring of a FusionSampler, recording the events of a
+//! sampled execution
+class FusionSampler::Execution {
+ public:
+  Execution() = default;
+  ~Execution();
+
+  //! Segments with ids beyond the histograms of the FusionSampler are only
+  //! counted in the latency of the fusion
+  void startSegment(int64_t segment_id, c10::cuda::CUDAStream stream);
+  void stopSegment(int64_t segment_id, c10::cuda::CUDAStream stream);
+
+ private:
+  friend class FusionSampler;
+
+  enum class State : int { Free, Recording, Pending, Draining };
+
+  void createEvents(c10::DeviceIndex device);
+  void destroyEvents();
+
+  std::atomic<State> state_{State::Free};
+  c10::DeviceIndex device_ = -1;
+  cudaEvent_t start_event_ = nullptr;
+  cudaEvent_t stop_event_ = nullptr;
+  std::vector<std::array<cudaEvent_t, 2>> segment_events_;
+  std::vector<bool> segment_recorded_;
+};
+
+//! \class SampledExecutionGuard
+//! \brief Samples an execution with the FusionSampler, if it is one of the 1
+//! in N, and makes it the current one of the thread while alive so that the
+//! segments run by the thread are recorded too.
+class SampledExecutionGuard {
+ public:
+  SampledExecutionGuard(FusionSampler* sampler, c10::cuda::CUDAStream stream);
+  ~SampledExecutionGuard();
+
+  SampledExecutionGuard(const SampledExecutionGuard&) = delete;
+  SampledExecutionGuard& operator=(const SampledExecutionGuard&) = delete;
+
+ private:
+  FusionSampler* sampler_;
+  c10::cuda::CUDAStream stream_;
+  FusionSampler::Execution* execution_ = nullptr;
+  FusionSampler::Execution* prev_execution_;
+};
+
+} // namespace nvfuser
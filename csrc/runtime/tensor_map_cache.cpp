@@ -0,0 +1,72 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <runtime/tensor_map_cache.h>
+
+#include <cuda_utils.h>
+#include <driver_api.h>
+#include <exceptions.h>
+#include <instrumentation.h>
+
+namespace nvfuser {
+
+PolymorphicValue TensorMapCache::get(
+    const kir::EncodeTensorMapTiled* encode,
+    ExpressionEvaluator& ee) {
+  FUSER_PERF_SCOPE("TensorMapCache::get");
+  std::vector<PolymorphicValue> inputs;
+  inputs.reserve(encode->inputs().size());
+  for (Val* input : encode->inputs()) {
+    inputs.push_back(ee.evaluate(input));
+  }
+  NVF_ERROR(
+      inputs.size() == 5,
+      "Incorrect number of inputs to EncodeTensorMapTiled!");
+  NVF_ERROR(inputs.at(0).is<Pointer>());
+  void* global_address = (void*)inputs.at(0);
+
+  // The global dims, global strides, box dims and element strides. Their
+  // lengths are fixed by the tensor rank of the expr.
+  std::vector<int64_t> key;
+  for (auto i : arange(1, std::ssize(inputs))) {
+    NVF_ERROR(inputs.at(i).is<std::vector>());
+    auto values = (std::vector<int64_t>)inputs.at(i);
+    key.insert(key.end(), values.begin(), values.end());
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entries = tensor_maps_[encode];
+  auto entry_it = entries.find(key);
+  if (entry_it != entries.end()) {
+    Entry& entry = entry_it->second;
+    if (entry.global_address == global_address) {
+      return entry.tensor_map;
+    }
+#if (CUDA_VERSION >= 12000)
+    // The alignment cuTensorMapEncodeTiled requires of the global address
+    const size_t alignment =
+        encode->interleave() == tma::TensorMapInterleave::B32 ? 32 : 16;
+    if (reinterpret_cast<size_t>(global_address) % alignment == 0) {
+      NVFUSER_CUDA_SAFE_CALL(cuTensorMapReplaceAddress(
+          &entry.tensor_map.as<Opaque>().as<CUtensorMap>(), global_address));
+      entry.global_address = global_address;
+      return entry.tensor_map;
+    }
+#endif
+  }
+
+  // Misaligned addresses are encoded too, which reports them
+  PolymorphicValue tensor_map = encode->evaluate(ee, inputs).at(0);
+  ++num_encodes_;
+  if (entries.size() >= max_entries_per_expr) {
+    entries.clear();
+  }
+  entries.insert_or_assign(std::move(key), Entry{global_address, tensor_map});
+  return tensor_map;
+}
+
+} // namespace nvfuser
@@ -0,0 +1,73 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <expr_evaluator.h>
+#include <kernel_ir.h>
+#include <polymorphic_value.h>
+#include <utils.h>
+
+namespace nvfuser {
+
+//! \class TensorMapCache
+//! \brief Caches the tensor maps of the kir::EncodeTensorMapTiled exprs of a
+//! kernel across its launches, so that launches with repeated tensors don't
+//! call cuTensorMapEncodeTiled for every TMA operand.
+//!
+//! Tensor maps are keyed by the expr, whose attributes fix the data type,
+//! swizzle, interleave, L2 promotion and OOB fill, and by the evaluated global
+//! dims, global strides, box dims and element strides. A cached tensor map of
+//! another global address is updated in place with cuTensorMapReplaceAddress,
+//! which is much cheaper than encoding it again.
+class TensorMapCache {
+ public:
+  //! Returns the tensor map of encode, whose inputs are evaluated with ee
+  PolymorphicValue get(
+      const kir::EncodeTensorMapTiled* encode,
+      ExpressionEvaluator& ee);
+
+  //! Number of tensor maps encoded with cuTensorMapEncodeTiled
+  int64_t numEncodes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_encodes_;
+  }
+
+ private:
+  struct Entry {
+    void* global_address = nullptr;
+    PolymorphicValue tensor_map;
+  };
+
+  struct KeyHash {
+    size_t operator()(const std::vector<int64_t>& key) const {
+      size_t hash = 0;
+      for (int64_t value : key) {
+        hashCombine(hash, std::hash<int64_t>()(value));
+      }
+      return hash;
+    }
+  };
+
+  //! Tensor maps kept per expr. Beyond it, e.g., with dynamic shapes, the
+  //! tensor maps of the expr are dropped.
+  static constexpr size_t max_entries_per_expr = 64;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<
+      const kir::EncodeTensorMapTiled*,
+      std::unordered_map<std::vector<int64_t>, Entry, KeyHash>>
+      tensor_maps_;
+  int64_t num_encodes_ = 0;
+};
+
+} // namespace nvfuser
@@ -0,0 +1,472 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <scheduler/autotune.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <instrumentation.h>
+#include <kernel_db/kernel_cache.h>
+#include <options.h>
+#include <scheduler/pointwise_heuristic.h>
+#include <scheduler/reduction_heuristic.h>
+#include <scheduler/transpose_heuristic.h>
+#include <scheduler/utils.h>
+
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace nvfuser {
+
+namespace autotune {
+
+namespace {
+
+// Tuning results are tiny, so the size limit of the database only guards
+// against unbounded growth of the directory.
+constexpr int64_t database_max_bytes = 64 * 1024 * 1024;
+
+// Returns the tuning database shared by all processes
+KernelCache& database() {
+  static KernelCache cache = []() {
+    const char* dir = getNvFuserEnv("AUTOTUNE_DIR");
+    fs::path path = dir != nullptr
+        ? fs::path(dir)
+        : fs::temp_directory_path() / "nvfuser_autotune";
+    return KernelCache(std::move(path), database_max_bytes);
+  }();
+  return cache;
+}
+
+// Results of this process, which also cache database lookups
+std::mutex tuned_knobs_mutex;
+std::unordered_map<std::string, TuningKnobs> tuned_knobs;
+
+void applyPointwiseKnobs(PointwiseParams* pparams, const TuningKnobs& knobs) {
+  // Unrolling changes the grid size, so it is only tuned where the grid
+  // dimension can't exceed the limit of BIDy, which split_grid_y_dim was
+  // computed for.
+  if (knobs.unroll_factor > 0 &&
+      (pparams->break_point == 0 ||
+       (!pparams->flip_grid_binding && pparams->unroll_factor_outer == 1))) {
+    pparams->unroll_factor_inner = knobs.unroll_factor;
+  }
+  if (knobs.vectorization_factor > 0) {
+    pparams->vectorization_factor =
+        std::min(pparams->vectorization_factor, knobs.vectorization_factor);
+  }
+  if (knobs.threads_per_block > 0 && pparams->break_point == 0) {
+    pparams->threads_per_block_1d = knobs.threads_per_block;
+    pparams->lparams.bindUnsafe(knobs.threads_per_block, ParallelType::TIDx);
+  }
+}
+
+void applyReductionKnobs(ReductionParams* rparams, const TuningKnobs& knobs) {
+  // Only the serial parts of 2D inner reductions are tuned, so that the grid
+  // and the block are the ones chosen by the heuristic.
+  if (!rparams->fastest_dim || rparams->schedule_3D ||
+      !rparams->vectorize_inner_reduction ||
+      rparams->cross_grid_inner_reduction) {
+    return;
+  }
+  const int64_t vectorization_factor = rparams->unroll_factor_inner_reduction;
+  if (knobs.vectorization_factor > 1 &&
+      knobs.vectorization_factor < vectorization_factor) {
+    rparams->unroll_factor_inner_reduction = knobs.vectorization_factor;
+    if (rparams->scheduler_type == SchedulerType::InnerPersistent) {
+      // Keep the number of threads required to hold the persistent buffers
+      // by moving the vectorized elements to the persistent batch.
+      rparams->batches_per_block_inner_reduction *=
+          vectorization_factor / knobs.vectorization_factor;
+    }
+  }
+  if (knobs.unroll_factor > 0 &&
+      rparams->scheduler_type == SchedulerType::Reduction) {
+    rparams->unroll_factor_top_of_vectorization = knobs.unroll_factor;
+  }
+}
+
+void applyTransposeKnobs(TransposeParams* tparams, const TuningKnobs& knobs) {
+  bool changed = false;
+  // See note [Supporting small transpose dimensions]. The virtual innermost
+  // dimensions are built for the default tile sizes.
+  if (knobs.tile_size > 0 && tparams->split_before_tiling.empty() &&
+      tparams->dims_merged_with_1.empty() &&
+      tparams->dims_merged_with_2.empty()) {
+    tparams->tile_size1 = knobs.tile_size;
+    tparams->tile_size2 = knobs.tile_size;
+    changed = true;
+  }
+  if (knobs.vectorization_factor > 0) {
+    tparams->vectorize_factor1 =
+        std::min(tparams->vectorize_factor1, knobs.vectorization_factor);
+    tparams->vectorize_factor2 =
+        std::min(tparams->vectorize_factor2, knobs.vectorization_factor);
+    for (int64_t& vectorize_factor : tparams->extra_vectorize_factors) {
+      vectorize_factor = std::min(vectorize_factor, knobs.vectorization_factor);
+    }
+    changed = true;
+  }
+  if (changed) {
+    tparams->lparams.bindUnsafe(
+        tparams->getThreadsPerBlock(), ParallelType::TIDx);
+  }
+}
+
+// Unroll factor the unroll_factor knob adjusts, see the apply functions above
+int64_t unrollFactor(const HeuristicParams* params) {
+  if (auto* pparams = dynamic_cast<const PointwiseParams*>(params)) {
+    return pparams->unroll_factor_inner;
+  }
+  auto* rparams = dynamic_cast<const ReductionParams*>(params);
+  if (rparams != nullptr &&
+      rparams->scheduler_type == SchedulerType::Reduction) {
+    return rparams->unroll_factor_top_of_vectorization;
+  }
+  return 1;
+}
+
+// Vectorization caps to try below the factor chosen by the heuristic
+std::vector<int64_t> vectorizationCandidates(
+    int64_t vectorization_factor,
+    int64_t min_factor) {
+  std::vector<int64_t> factors = {0};
+  for (int64_t factor = vectorization_factor / 2; factor >= min_factor;
+       factor /= 2) {
+    factors.push_back(factor);
+  }
+  return factors;
+}
+
+} // namespace
+
+std::string TuningKnobs::toString() const {
+  std::stringstream ss;
+  ss << "unroll_factor=" << unroll_factor
+     << " vectorization_factor=" << vectorization_factor
+     << " threads_per_block=" << threads_per_block
+     << " tile_size=" << tile_size << " max_registers=" << max_registers;
+  return ss.str();
+}
+
+std::optional<TuningKnobs> TuningKnobs::fromString(const std::string& str) {
+  TuningKnobs knobs;
+  std::stringstream ss(str);
+  std::string token;
+  int64_t num_knobs = 0;
+  while (ss >> token) {
+    const auto pos = token.find('=');
+    if (pos == std::string::npos) {
+      return std::nullopt;
+    }
+    const std::string name = token.substr(0, pos);
+    int64_t value = 0;
+    try {
+      value = std::stoll(token.substr(pos + 1));
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+    if (name == "unroll_factor") {
+      knobs.unroll_factor = value;
+    } else if (name == "vectorization_factor") {
+      knobs.vectorization_factor = value;
+    } else if (name == "threads_per_block") {
+      knobs.threads_per_block = value;
+    } else if (name == "tile_size") {
+      knobs.tile_size = value;
+    } else if (name == "max_registers") {
+      knobs.max_registers = value;
+    } else {
+      return std::nullopt;
+    }
+    num_knobs++;
+  }
+  if (num_knobs != 5) {
+    return std::nullopt;
+  }
+  return knobs;
+}
+
+int64_t shapeBucket(int64_t n) {
+  if (n <= 1) {
+    return n;
+  }
+  const int64_t last_pow2 = scheduler_utils::lastPow2(n);
+  return last_pow2 == n ? n : last_pow2 * 2;
+}
+
+bool isEnabled() {
+  // The fastest candidate may differ from one process to the next, and so
+  // would the order of the reductions of the segment
+  return isOptionEnabled(EnableOption::Autotune) &&
+      !isOptionEnabled(EnableOption::Deterministic);
+}
+
+bool isTunable(SchedulerType scheduler_type) {
+  switch (scheduler_type) {
+    case SchedulerType::PointWise:
+    case SchedulerType::Reduction:
+    case SchedulerType::InnerPersistent:
+    case SchedulerType::Transpose:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t maxCandidates() {
+  constexpr int64_t default_max_candidates = 16;
+  const auto& option_args = getEnableOptionArguments(EnableOption::Autotune);
+  const int64_t max_candidates = option_args.empty()
+      ? default_max_candidates
+      : std::stoll(option_args[0]);
+  NVF_CHECK(
+      max_candidates > 0,
+      "Invalid number of autotuning candidates: ",
+      max_candidates);
+  return max_candidates;
+}
+
+std::string tuningKey(
+    const HeuristicParams* params,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info) {
+  FUSER_PERF_SCOPE("autotune::tuningKey");
+  const auto* prop = at::cuda::getCurrentDeviceProperties();
+  std::stringstream ss;
+  ss << "sm_" << prop->major << prop->minor << "\n"
+     << params->scheduler_type << "\n"
+     << params->cparams.index_type.value_or(runtime_info.getIndexType())
+     << "\n";
+  for (Val* input : fusion->inputs()) {
+    auto* tv = dynamic_cast<TensorView*>(input);
+    if (tv == nullptr) {
+      ss << input->dtype() << "\n";
+      continue;
+    }
+    ss << tv->dtype() << " [" << tv->domain()->getContiguityString() << "]";
+    for (IterDomain* id : TensorDomain::noReductions(tv->getLogicalDomain())) {
+      PolymorphicValue extent =
+          runtime_info.expressionEvaluator().evaluate(id->extent());
+      ss << " " << (extent.hasValue() ? shapeBucket(extent.as<int64_t>()) : -1);
+    }
+    ss << "\n";
+  }
+  for (Expr* expr : fusion->exprs()) {
+    ss << expr->toString();
+  }
+  return ss.str();
+}
+
+std::optional<TuningKnobs> queryTunedKnobs(const std::string& key) {
+  FUSER_PERF_SCOPE("autotune::queryTunedKnobs");
+  std::lock_guard<std::mutex> guard(tuned_knobs_mutex);
+  if (auto it = tuned_knobs.find(key); it != tuned_knobs.end()) {
+    return it->second;
+  }
+  std::string knobs_str;
+  std::vector<char> unused_binary;
+  if (!database().query(key, knobs_str, unused_binary)) {
+    return std::nullopt;
+  }
+  std::optional<TuningKnobs> knobs = TuningKnobs::fromString(knobs_str);
+  if (knobs.has_value()) {
+    tuned_knobs.emplace(key, *knobs);
+  }
+  return knobs;
+}
+
+void recordTunedKnobs(const std::string& key, const TuningKnobs& knobs) {
+  FUSER_PERF_SCOPE("autotune::recordTunedKnobs");
+  std::lock_guard<std::mutex> guard(tuned_knobs_mutex);
+  tuned_knobs[key] = knobs;
+  if (!database().write(key, knobs.toString(), /*binary=*/{})) {
+    TORCH_WARN_ONCE(
+        "Unable to write to the nvFuser autotuning database ",
+        database().path().string());
+  }
+}
+
+std::optional<int64_t> queryTunedNumberOfStreams(const std::string& key) {
+  FUSER_PERF_SCOPE("autotune::queryTunedNumberOfStreams");
+  std::string value_str;
+  std::vector<char> unused_binary;
+  if (!database().query(key, value_str, unused_binary)) {
+    return std::nullopt;
+  }
+  constexpr std::string_view prefix = "number_of_streams=";
+  if (!value_str.starts_with(prefix)) {
+    return std::nullopt;
+  }
+  try {
+    const int64_t number_of_streams =
+        std::stoll(value_str.substr(prefix.size()));
+    if (number_of_streams > 0) {
+      return number_of_streams;
+    }
+  } catch (const std::exception&) {
+  }
+  return std::nullopt;
+}
+
+void recordTunedNumberOfStreams(
+    const std::string& key,
+    int64_t number_of_streams) {
+  FUSER_PERF_SCOPE("autotune::recordTunedNumberOfStreams");
+  if (!database().write(
+          key,
+          "number_of_streams=" + std::to_string(number_of_streams),
+          /*binary=*/{})) {
+    TORCH_WARN_ONCE(
+        "Unable to write to the nvFuser autotuning database ",
+        database().path().string());
+  }
+}
+
+bool applyKnobs(HeuristicParams* params, const TuningKnobs& knobs) {
+  if (knobs.max_registers > 0 && isTunable(params->scheduler_type)) {
+    params->cparams.maxrregcount = knobs.max_registers;
+  }
+  if (auto* pparams = dynamic_cast<PointwiseParams*>(params)) {
+    applyPointwiseKnobs(pparams, knobs);
+    return true;
+  }
+  if (auto* tparams = dynamic_cast<TransposeParams*>(params)) {
+    applyTransposeKnobs(tparams, knobs);
+    return true;
+  }
+  auto* rparams = dynamic_cast<ReductionParams*>(params);
+  if (rparams != nullptr && isTunable(rparams->scheduler_type)) {
+    applyReductionKnobs(rparams, knobs);
+    return true;
+  }
+  return false;
+}
+
+void applyTunedParams(
+    HeuristicParams* params,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info) {
+  if (!(isEnabled() || isSpillFeedbackEnabled()) ||
+      !isTunable(params->scheduler_type)) {
+    return;
+  }
+  std::optional<TuningKnobs> knobs =
+      queryTunedKnobs(tuningKey(params, fusion, runtime_info));
+  if (knobs.has_value()) {
+    applyKnobs(params, *knobs);
+  }
+}
+
+std::vector<TuningCandidate> candidateParams(
+    const HeuristicParams* params,
+    int64_t max_candidates) {
+  std::vector<TuningCandidate> candidates;
+  auto add_candidate = [&](const TuningKnobs& knobs) {
+    if (std::ssize(candidates) >= max_candidates) {
+      return;
+    }
+    std::unique_ptr<HeuristicParams> candidate = params->clone();
+    if (!applyKnobs(candidate.get(), knobs)) {
+      return;
+    }
+    for (const TuningCandidate& other : candidates) {
+      if (other.params->sameAs(candidate.get())) {
+        return;
+      }
+    }
+    candidates.push_back({knobs, std::move(candidate)});
+  };
+
+  add_candidate(TuningKnobs{});
+  if (auto* pparams = dynamic_cast<const PointwiseParams*>(params)) {
+    for (int64_t vectorization_factor :
+         vectorizationCandidates(pparams->vectorization_factor, 1)) {
+      for (int64_t unroll_factor : {0, 1, 2, 4}) {
+        for (int64_t threads_per_block : {0, 256, 512, 64}) {
+          add_candidate(
+              {.unroll_factor = unroll_factor,
+               .vectorization_factor = vectorization_factor,
+               .threads_per_block = threads_per_block});
+        }
+      }
+    }
+  } else if (auto* tparams = dynamic_cast<const TransposeParams*>(params)) {
+    for (int64_t vectorization_factor : vectorizationCandidates(
+             std::max(tparams->vectorize_factor1, tparams->vectorize_factor2),
+             1)) {
+      for (int64_t tile_size : {0, 64, 16}) {
+        add_candidate(
+            {.vectorization_factor = vectorization_factor,
+             .tile_size = tile_size});
+      }
+    }
+  } else if (auto* rparams = dynamic_cast<const ReductionParams*>(params)) {
+    for (int64_t vectorization_factor : vectorizationCandidates(
+             rparams->unroll_factor_inner_reduction, 2)) {
+      for (int64_t unroll_factor : {0, 1, 2, 4}) {
+        add_candidate(
+            {.unroll_factor = unroll_factor,
+             .vectorization_factor = vectorization_factor});
+      }
+    }
+  }
+  return candidates;
+}
+
+bool isSpillFeedbackEnabled() {
+  return isOptionEnabled(EnableOption::RegisterSpillFeedback);
+}
+
+int64_t maxSpillFeedbackRetries() {
+  constexpr int64_t default_max_retries = 2;
+  const auto& option_args =
+      getEnableOptionArguments(EnableOption::RegisterSpillFeedback);
+  const int64_t max_retries =
+      option_args.empty() ? default_max_retries : std::stoll(option_args[0]);
+  NVF_CHECK(
+      max_retries >= 0,
+      "Invalid number of register spill feedback retries: ",
+      max_retries);
+  return max_retries;
+}
+
+std::optional<TuningCandidate> spillFeedbackCandidate(
+    const HeuristicParams* params,
+    const TuningKnobs& knobs) {
+  auto make_candidate =
+      [params](const TuningKnobs& next) -> std::optional<TuningCandidate> {
+    std::unique_ptr<HeuristicParams> candidate = params->clone();
+    if (!applyKnobs(candidate.get(), next) || candidate->sameAs(params)) {
+      return std::nullopt;
+    }
+    return TuningCandidate{next, std::move(candidate)};
+  };
+
+  // The maximum allowed by ptxas. CompiledKernel still caps it so that a
+  // block fits on an SM.
+  constexpr int64_t max_register_limit = 255;
+  if (params->cparams.maxrregcount < max_register_limit) {
+    TuningKnobs next = knobs;
+    next.max_registers = max_register_limit;
+    if (std::optional<TuningCandidate> candidate = make_candidate(next)) {
+      return candidate;
+    }
+  }
+  if (const int64_t unroll_factor = unrollFactor(params); unroll_factor > 1) {
+    TuningKnobs next = knobs;
+    next.unroll_factor = unroll_factor / 2;
+    if (std::optional<TuningCandidate> candidate = make_candidate(next)) {
+      return candidate;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace autotune
+
+} // namespace nvfuser
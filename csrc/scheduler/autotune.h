@@ -0,0 +1,142 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <fusion.h>
+#include <scheduler/heuristic.h>
+#include <scheduler/runtime_info.h>
+#include <scheduler/scheduler_types.h>
+#include <visibility.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nvfuser {
+
+namespace autotune {
+
+//! Adjustments applied on top of the parameters chosen by the heuristic of
+//! the pointwise, reduction, inner persistent and transpose schedulers when
+//! EnableOption::Autotune is set. A value of 0 keeps the value chosen by the
+//! heuristic. Knobs only ever select configurations that are valid for any
+//! input the heuristic accepts, e.g., vectorization_factor is a cap on the
+//! factor of the heuristic, and applying the same knobs twice is a no-op.
+struct TuningKnobs {
+  //! Unroll factor of the pointwise scheduler, or unroll on top of the
+  //! vectorization of an inner reduction
+  int64_t unroll_factor = 0;
+  //! Upper bound of the vectorization factors
+  int64_t vectorization_factor = 0;
+  //! Threads per block of the 1D pointwise scheduler
+  int64_t threads_per_block = 0;
+  //! Tile size of both groups of the transpose scheduler
+  int64_t tile_size = 0;
+  //! Register limit of CompileParams::maxrregcount. It is only set by
+  //! EnableOption::RegisterSpillFeedback to lift the limit of a heuristic.
+  int64_t max_registers = 0;
+
+  bool operator==(const TuningKnobs& other) const = default;
+
+  std::string toString() const;
+
+  //! Inverse of toString. Returns std::nullopt if str isn't valid.
+  static std::optional<TuningKnobs> fromString(const std::string& str);
+};
+
+struct TuningCandidate {
+  TuningKnobs knobs;
+  std::unique_ptr<HeuristicParams> params;
+};
+
+//! Returns true if EnableOption::Autotune is set and
+//! EnableOption::Deterministic is not
+bool isEnabled();
+
+//! Returns true if the parameters of scheduler_type can be tuned
+bool isTunable(SchedulerType scheduler_type);
+
+//! Key of the tuning database for a segment. It is built from the scheduler
+//! and index type of params, the SM architecture, the expressions of fusion
+//! and the dtype, contiguity and extents of its inputs, where extents are
+//! rounded up to the next power of two so that similar shapes share their
+//! tuning result.
+NVF_API std::string tuningKey(
+    const HeuristicParams* params,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info);
+
+//! Looks up the knobs stored for key in memory first and then in the tuning
+//! database. The database directory is NVFUSER_AUTOTUNE_DIR if set and
+//! nvfuser_autotune in the temporary directory otherwise, so that tuning
+//! results are shared across processes.
+NVF_API std::optional<TuningKnobs> queryTunedKnobs(const std::string& key);
+
+//! Stores the winning knobs for key in memory and in the tuning database
+NVF_API void recordTunedKnobs(const std::string& key, const TuningKnobs& knobs);
+
+//! Applies knobs to params in place. Returns false if params is not a
+//! tunable type.
+bool applyKnobs(HeuristicParams* params, const TuningKnobs& knobs);
+
+//! Called at the end of the heuristics of the tunable schedulers. If
+//! autotuning is enabled and the database holds knobs for this segment,
+//! params are adjusted in place so that segments tuned before, possibly by
+//! another process, are compiled with their tuned configuration right away.
+void applyTunedParams(
+    HeuristicParams* params,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info);
+
+//! Enumerates up to max_candidates distinct configurations derived from
+//! params. The first candidate always holds the unmodified params, so that
+//! tuning never picks a configuration slower than the heuristic's choice.
+std::vector<TuningCandidate> candidateParams(
+    const HeuristicParams* params,
+    int64_t max_candidates);
+
+//! Maximum number of candidates timed per segment, given by the optional
+//! argument of EnableOption::Autotune (default 16)
+int64_t maxCandidates();
+
+//! Rounds n up to the next power of two, so that similar shapes share their
+//! tuning result
+int64_t shapeBucket(int64_t n);
+
+//! Looks up the number of streams stored for key in the tuning database. It
+//! is tuned by HostIrEvaluator for the stream-parallel loops of a host
+//! program, see HostIrEvaluatorParams::number_of_streams.
+NVF_API std::optional<int64_t> queryTunedNumberOfStreams(
+    const std::string& key);
+
+//! Stores the winning number of streams for key in the tuning database
+NVF_API void recordTunedNumberOfStreams(
+    const std::string& key,
+    int64_t number_of_streams);
+
+//! Returns true if EnableOption::RegisterSpillFeedback is set
+bool isSpillFeedbackEnabled();
+
+//! Maximum number of recompilations of a segment that spills registers, given
+//! by the optional argument of EnableOption::RegisterSpillFeedback (default 2)
+int64_t maxSpillFeedbackRetries();
+
+//! Returns the next configuration to try for a kernel compiled with params,
+//! the result of applying knobs, that spills registers, or std::nullopt if
+//! there is none. A register limit set by the heuristic is lifted first, as
+//! that keeps the schedule. Then the unroll factor is halved. The knobs of the
+//! candidate include knobs, so they can be recorded as they are.
+NVF_API std::optional<TuningCandidate> spillFeedbackCandidate(
+    const HeuristicParams* params,
+    const TuningKnobs& knobs);
+
+} // namespace autotune
+
+} // namespace nvfuser
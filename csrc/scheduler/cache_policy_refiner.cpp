@@ -11,6 +11,7 @@
 #include <ir/internal_nodes.h>
 #include <ir/utils.h>
 #include <logical_domain_map.h>
+#include <options.h>
 #include <scheduler/cache_policy_refiner.h>
 #include <scheduler/debug_utils.h>
 
@@ -137,7 +138,11 @@ bool refineCachePolicy(LoadStoreOp* ldst) {
     return false;
   }
 
-  auto target_cache_op = CacheOp::AllLevels;
+  // An expanded operand is read by every block along the expanded dimension,
+  // so with L2 persistence we also ask L2 to keep it over streaming data.
+  auto target_cache_op = isOptionEnabled(EnableOption::L2Persistence)
+      ? CacheOp::EvictLast
+      : CacheOp::AllLevels;
   vlog(
       "Changed the cache op of ",
       ldst->toString(),
@@ -13,7 +13,8 @@
 namespace nvfuser {
 
 // Visits all global-to-local vector loads in `fusion` and refines their cache
-// policies.
+// policies. Loads of expanded operands use CacheOp::EvictLast with
+// EnableOption::L2Persistence, and CacheOp::AllLevels otherwise.
 NVF_API void refineCachePolicy(Fusion* fusion);
 
 } // namespace nvfuser
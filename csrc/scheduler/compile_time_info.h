@@ -39,6 +39,7 @@ enum class CompileTimeEntryType {
   INPUTS_AND_OUTPUTS_INNER_DIM_GROUPS,
   TV_TO_CONTIG_INNER_SIZE_MAPS,
   RESIZE_VECTORIZATION_FACTORS,
+  RESIZE_VECTORIZATION_FACTORS_OF_TENSORS,
   UNROLLABLE_INPUTS_AND_OUTPUTS,
   REDUCTION_TVS,
   PERSISTENT_BUFFER_INFO,
@@ -116,6 +117,15 @@ class ResizeVectorizationFactors {
       CompileTimeEntryType::RESIZE_VECTORIZATION_FACTORS;
 };
 
+//! Stores the scalar vals that the vectorization factor of each tensor
+//! must be able to divide evenly
+class ResizeVectorizationFactorsOfTensors {
+ public:
+  using DataType = std::unordered_map<TensorView*, std::unordered_set<Val*>>;
+  static const CompileTimeEntryType EntryType =
+      CompileTimeEntryType::RESIZE_VECTORIZATION_FACTORS_OF_TENSORS;
+};
+
 //! Entry type definition class for `INPUTS_AND_OUTPUTS_INNER_DIM_GROUPS`,
 //!  stores the fusion's inputs and outputs grouped by inner most dimension.
 class InputsOutputsInnerDimGroups {
@@ -263,6 +273,16 @@ class HeuristicDataCache {
     return entry_type_map_.at(entry_type);
   }
 
+  //! Copies the entries of other that are missing in this cache, with each
+  //!  IR node they refer to replaced by val_map(node). other holds the entries
+  //!  of a structurally identical fusion, so val_map maps between the vals of
+  //!  the two fusions. An entry is skipped if val_map returns nullptr for one
+  //!  of its nodes, and so are the domain maps, which hold analyses of the
+  //!  whole fusion. Returns the number of copied entries.
+  int64_t copyFrom(
+      HeuristicDataCache& other,
+      const std::function<Val*(Val*)>& val_map);
+
  private:
   std::vector<EntryOwningPtr> entries_;
   std::unordered_map<EntryType, EntryPtr> entry_type_map_;
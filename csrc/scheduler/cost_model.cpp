@@ -0,0 +1,336 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <scheduler/cost_model.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <fusion_profiler.h>
+#include <instrumentation.h>
+#include <ir/all_nodes.h>
+#include <options.h>
+#include <scheduler/debug_utils.h>
+#include <scheduler/heuristic.h>
+#include <scheduler/pointwise_heuristic.h>
+#include <scheduler/reduction_heuristic.h>
+#include <scheduler/registry.h>
+#include <scheduler/runtime_info.h>
+#include <scheduler/transpose_heuristic.h>
+#include <scheduler/utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace nvfuser {
+
+namespace cost_model {
+
+namespace {
+
+// Host and device overhead of launching a kernel, which makes two small
+// kernels more expensive than one that does the same work
+constexpr double launch_overhead_us = 3.0;
+
+// Registers assumed for indexing, predicates and temporaries of any kernel
+constexpr int64_t base_registers_per_thread = 32;
+constexpr int64_t max_registers_per_thread = 255;
+
+// Widest global memory access of a thread, i.e., a 128-bit vector
+constexpr int64_t max_access_bytes = 16;
+
+// Threads per block assumed when the heuristic doesn't bind the block size
+constexpr int64_t default_threads_per_block = 128;
+
+// Fraction of the resident threads per SM beyond which memory bandwidth and
+// FP32 throughput are assumed to be saturated. Below it, both scale linearly
+// with occupancy.
+constexpr double saturating_occupancy = 0.5;
+
+// Number of elements of tv, not counting reduction and broadcast dimensions.
+// Extents that can't be evaluated are counted as 1.
+int64_t numel(TensorView* tv, ExpressionEvaluator& ee) {
+  int64_t n = 1;
+  for (IterDomain* id : tv->getLogicalDomain()) {
+    if (id->isReduction() || id->isBroadcast()) {
+      continue;
+    }
+    PolymorphicValue extent = ee.evaluate(id->extent());
+    if (extent.hasValue()) {
+      n *= extent.as<int64_t>();
+    }
+  }
+  return n;
+}
+
+int64_t globalMemoryBytes(Fusion* fusion, ExpressionEvaluator& ee) {
+  int64_t bytes = 0;
+  for (auto* tv : ir_utils::filterByType<TensorView>(fusion->inputs())) {
+    bytes += numel(tv, ee) * dataTypeSizeByte(tv->dtype());
+  }
+  for (auto* tv : ir_utils::filterByType<TensorView>(fusion->outputs())) {
+    // Outputs evaluated as views of inputs aren't written by the kernel
+    if (fusion->getOutputAlias(tv).type == AllocationType::Evaluate) {
+      continue;
+    }
+    bytes += numel(tv, ee) * dataTypeSizeByte(tv->dtype());
+  }
+  return bytes;
+}
+
+// Number of elements a thread loads or stores per access
+int64_t vectorizationFactor(const HeuristicParams* params) {
+  if (auto* pparams = dynamic_cast<const PointwiseParams*>(params)) {
+    return pparams->vectorization_factor;
+  }
+  if (auto* rparams = dynamic_cast<const ReductionParams*>(params)) {
+    if (rparams->vectorize_inner_reduction) {
+      return rparams->unroll_factor_inner_reduction;
+    }
+    if (rparams->vectorize_iter_dom) {
+      return rparams->unroll_factor_iter_dom;
+    }
+    return 1;
+  }
+  if (auto* tparams = dynamic_cast<const TransposeParams*>(params)) {
+    return std::min(tparams->vectorize_factor1, tparams->vectorize_factor2);
+  }
+  // Other schedulers are assumed to vectorize fully
+  return max_access_bytes;
+}
+
+int64_t accessBytes(Fusion* fusion, const HeuristicParams* params) {
+  int64_t item_bytes = max_access_bytes;
+  for (auto* tv : ir_utils::filterByType<TensorView>(fusion->inputs())) {
+    item_bytes = std::min(item_bytes, dataTypeSizeByte(tv->dtype()));
+  }
+  return std::clamp(
+      vectorizationFactor(params) * item_bytes, (int64_t)1, max_access_bytes);
+}
+
+// Fraction of the peak bandwidth reached with accesses of access_bytes, from
+// 40% for single bytes to 100% for 16 bytes
+double accessEfficiency(int64_t access_bytes) {
+  return std::min(
+      1.0, 0.4 + 0.15 * std::log2(static_cast<double>(access_bytes)));
+}
+
+int64_t launchDim(const LaunchParams& lparams, ParallelType pt) {
+  return lparams.hasDim(pt) ? lparams.getRawVal(pt) : 1;
+}
+
+int64_t threadsPerBlock(const HeuristicParams* params) {
+  const LaunchParams& lparams = params->lparams;
+  if (!lparams.hasDim(ParallelType::TIDx) &&
+      !lparams.hasDim(ParallelType::TIDy) &&
+      !lparams.hasDim(ParallelType::TIDz)) {
+    return default_threads_per_block;
+  }
+  return launchDim(lparams, ParallelType::TIDx) *
+      launchDim(lparams, ParallelType::TIDy) *
+      launchDim(lparams, ParallelType::TIDz);
+}
+
+} // namespace
+
+int64_t arithmeticOps(
+    const std::vector<Expr*>& exprs,
+    ExpressionEvaluator& ee) {
+  int64_t flops = 0;
+  for (Expr* expr : exprs) {
+    if (expr->isOneOf<ReductionOp, WelfordOp, GroupedReductionOp>()) {
+      // Reductions do work proportional to their inputs
+      auto* in = dynamic_cast<TensorView*>(expr->input(0));
+      if (in != nullptr) {
+        flops += numel(in, ee) * (expr->isA<WelfordOp>() ? 4 : 1);
+      }
+    } else if (expr->isOneOf<UnaryOp, BinaryOp, TernaryOp>()) {
+      auto* out = dynamic_cast<TensorView*>(expr->output(0));
+      if (out != nullptr) {
+        flops += numel(out, ee);
+      }
+    }
+  }
+  return flops;
+}
+
+int64_t arithmeticOps(Fusion* fusion, ExpressionEvaluator& ee) {
+  return arithmeticOps(fusion->exprs(), ee);
+}
+
+std::string KernelCost::toString() const {
+  std::stringstream ss;
+  ss << "KernelCost{bytes=" << bytes << ", flops=" << flops
+     << ", access_bytes=" << access_bytes << ", occupancy=" << occupancy
+     << ", spills=" << spills << ", time_us=" << time_us << "}";
+  return ss.str();
+}
+
+bool isEnabled() {
+  return isOptionEnabled(EnableOption::CostModel);
+}
+
+const DeviceDescriptor& deviceDescriptor() {
+  static std::mutex device_descriptors_mutex;
+  static std::unordered_map<int, DeviceDescriptor> device_descriptors;
+  const int device = at::cuda::current_device();
+  std::lock_guard<std::mutex> guard(device_descriptors_mutex);
+  auto [it, inserted] = device_descriptors.try_emplace(device);
+  if (inserted) {
+    DeviceDescriptor::generate(it->second, device);
+  }
+  return it->second;
+}
+
+bool isComparable(SchedulerType scheduler_type) {
+  switch (scheduler_type) {
+    case SchedulerType::PointWise:
+    case SchedulerType::Reduction:
+    case SchedulerType::InnerPersistent:
+    case SchedulerType::OuterPersistent:
+    case SchedulerType::InnerOuterPersistent:
+    case SchedulerType::Transpose:
+    case SchedulerType::Resize:
+      return true;
+    default:
+      return false;
+  }
+}
+
+KernelCost estimateKernelCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const HeuristicParams* params,
+    const KernelResources& resources) {
+  FUSER_PERF_SCOPE("cost_model::estimateKernelCost");
+  const DeviceDescriptor& desc = deviceDescriptor();
+  ExpressionEvaluator& ee = runtime_info.expressionEvaluator();
+
+  KernelCost cost;
+  cost.bytes = globalMemoryBytes(fusion, ee);
+  cost.flops = arithmeticOps(fusion, ee);
+  cost.access_bytes = accessBytes(fusion, params);
+
+  int64_t registers_per_thread = base_registers_per_thread +
+      ceilDiv(resources.register_buffer_bytes_per_thread, 4);
+  if (registers_per_thread > max_registers_per_thread) {
+    // Spilled buffers are stored to and loaded back from local memory. The
+    // persistent buffers are about as large as the data the kernel reads.
+    cost.spills = true;
+    const double spilled_fraction =
+        static_cast<double>(registers_per_thread - max_registers_per_thread) /
+        static_cast<double>(registers_per_thread - base_registers_per_thread);
+    cost.bytes += static_cast<int64_t>(
+        2.0 * spilled_fraction * static_cast<double>(cost.bytes));
+    registers_per_thread = max_registers_per_thread;
+  }
+
+  const int64_t threads = threadsPerBlock(params);
+  int64_t blocks_per_sm = std::min(
+      desc.max_threads_per_sm / threads,
+      desc.max_registers_per_sm / (registers_per_thread * threads));
+  if (resources.shared_memory_bytes_per_block > 0) {
+    blocks_per_sm = std::min(
+        blocks_per_sm,
+        desc.max_shared_memory_per_sm /
+            resources.shared_memory_bytes_per_block);
+  }
+  if (blocks_per_sm == 0) {
+    // The kernel can't be launched with these resources
+    cost.occupancy = 0.0;
+    cost.time_us = std::numeric_limits<double>::infinity();
+    return cost;
+  }
+
+  cost.occupancy = std::min(
+      1.0,
+      static_cast<double>(blocks_per_sm * threads) /
+          static_cast<double>(desc.max_threads_per_sm));
+  const double efficiency =
+      std::min(1.0, cost.occupancy / saturating_occupancy);
+  // 1 GB/s is 1e3 bytes per microsecond
+  const double memory_us = static_cast<double>(cost.bytes) /
+      (desc.peak_bandwidth_gbs * 1.0e3 * efficiency *
+       accessEfficiency(cost.access_bytes));
+  const double compute_us = desc.peak_fp32_gflops > 0.0
+      ? static_cast<double>(cost.flops) /
+          (desc.peak_fp32_gflops * 1.0e3 * efficiency)
+      : 0.0;
+  cost.time_us = launch_overhead_us + std::max(memory_us, compute_us);
+  return cost;
+}
+
+KernelCost estimatePersistentKernelCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const ReductionParams* rparams,
+    HeuristicDataCache* data_cache) {
+  FUSER_PERF_SCOPE("cost_model::estimatePersistentKernelCost");
+  const scheduler_utils::PersistentBufferInfo persistent_buffer_info =
+      scheduler_utils::persistentBuffers(fusion);
+  const scheduler_utils::PersistentBufferSizeReturn buffer_sizes =
+      scheduler_utils::persistentBufferSize(
+          fusion, runtime_info, persistent_buffer_info, data_cache);
+
+  // Bytes of all persistent buffers for a single iteration element
+  int64_t buffer_bytes = rparams->project_persistent_buffers
+      ? buffer_sizes.projected_persistent_buffer_size
+      : buffer_sizes.persistent_buffer_size;
+  // Each block of a cluster holds its part of the row
+  if (rparams->cluster_inner_reduction) {
+    buffer_bytes = ceilDiv(buffer_bytes, rparams->lparams.gdimx());
+  }
+  int64_t smem_buffer_bytes = 0;
+  for (TensorView* tv : rparams->smem_persistent_buffers) {
+    smem_buffer_bytes += scheduler_utils::getPersistentBufferSizeOfTensor(
+        tv, runtime_info, persistent_buffer_info);
+  }
+  smem_buffer_bytes = std::min(smem_buffer_bytes, buffer_bytes);
+
+  // Iteration elements processed by a block. Inner persistent kernels place
+  // them on TIDy and outer persistent kernels on TIDx.
+  const int64_t iterations_per_block = rparams->fastest_dim
+      ? launchDim(rparams->lparams, ParallelType::TIDy)
+      : launchDim(rparams->lparams, ParallelType::TIDx) *
+          std::max<int64_t>(rparams->unroll_factor_iter_dom, 1);
+
+  KernelResources resources;
+  resources.register_buffer_bytes_per_thread = ceilDiv(
+      (buffer_bytes - smem_buffer_bytes) * iterations_per_block,
+      threadsPerBlock(rparams));
+  resources.shared_memory_bytes_per_block =
+      smem_buffer_bytes * iterations_per_block;
+  return estimateKernelCost(fusion, runtime_info, rparams, resources);
+}
+
+std::optional<double> predictRuntime(
+    SchedulerType scheduler_type,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info) {
+  FUSER_PERF_SCOPE("cost_model::predictRuntime");
+  try {
+    std::unique_ptr<SchedulerEntry> scheduler =
+        SchedulerEntry::makeSchedulerInstance(scheduler_type);
+    std::unique_ptr<HeuristicParams> params =
+        scheduler->computeHeuristics(fusion, runtime_info);
+    const KernelCost cost =
+        scheduler->predictCost(fusion, runtime_info, params.get());
+    scheduler_debug_utils::canScheduleMessage(
+        "Predicted cost of ", scheduler_type, ": ", cost.toString());
+    return cost.time_us;
+  } catch (const std::exception& e) {
+    scheduler_debug_utils::canScheduleMessage(
+        "Unable to predict the cost of ", scheduler_type, ": ", e.what());
+    return std::nullopt;
+  }
+}
+
+} // namespace cost_model
+
+} // namespace nvfuser
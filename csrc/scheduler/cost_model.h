@@ -0,0 +1,111 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <fusion.h>
+#include <scheduler/scheduler_types.h>
+#include <visibility.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nvfuser {
+
+struct DeviceDescriptor;
+class ExpressionEvaluator;
+class HeuristicDataCache;
+class HeuristicParams;
+class ReductionParams;
+class SchedulerRuntimeInfo;
+
+namespace cost_model {
+
+//! Roofline estimate of the runtime of a kernel, reported by
+//! SchedulerEntry::predictCost. It is only meant to rank the options of the
+//! segmenter and of Schedule::proposeHeuristics against each other, not to
+//! predict absolute runtimes.
+struct KernelCost {
+  //! Bytes read and written in global memory, including register spills
+  int64_t bytes = 0;
+  //! Arithmetic operations, counting one per element of each expression
+  int64_t flops = 0;
+  //! Bytes of the widest global memory access of a thread, given by the
+  //! vectorization factor of the kernel and the narrowest input dtype
+  int64_t access_bytes = 16;
+  //! Fraction of the maximum resident threads per SM
+  double occupancy = 1.0;
+  //! True if the persistent buffers held in registers don't fit in the 255
+  //! registers available per thread
+  bool spills = false;
+  //! Predicted runtime in microseconds, including the launch overhead
+  double time_us = 0.0;
+
+  std::string toString() const;
+};
+
+//! Resources a kernel needs on top of what the cost model assumes for any
+//! kernel
+struct KernelResources {
+  //! Bytes of persistent buffers each thread holds in registers
+  int64_t register_buffer_bytes_per_thread = 0;
+  //! Bytes of shared memory per block
+  int64_t shared_memory_bytes_per_block = 0;
+};
+
+//! Returns true if EnableOption::CostModel is set
+bool isEnabled();
+
+//! Descriptor of the current device, generated on first use and cached per
+//! device. Heuristics use it to choose between schedules that only pay off on
+//! some architectures or problem sizes.
+const DeviceDescriptor& deviceDescriptor();
+
+//! Returns true if scheduler_type is one of the kernel schedulers that
+//! Schedule::proposeHeuristics compares by predicted runtime. The others,
+//! e.g., ExprEval and Matmul, accept segments no other scheduler can take.
+bool isComparable(SchedulerType scheduler_type);
+
+//! Arithmetic operations of exprs, counting one per element of each
+//! expression and four per element reduced by a Welford. Extents ee can't
+//! evaluate count as one.
+NVF_API int64_t
+arithmeticOps(const std::vector<Expr*>& exprs, ExpressionEvaluator& ee);
+NVF_API int64_t arithmeticOps(Fusion* fusion, ExpressionEvaluator& ee);
+
+//! Roofline estimate of the kernel generated for fusion with params: the
+//! time to move the inputs and outputs of fusion or to execute its
+//! arithmetic, whichever is longer, at the bandwidth and throughput reachable
+//! with the occupancy given by the launch parameters and resources. Narrow
+//! accesses of kernels that aren't vectorized reach a lower bandwidth.
+NVF_API KernelCost estimateKernelCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const HeuristicParams* params,
+    const KernelResources& resources = {});
+
+//! estimateKernelCost for the persistent schedulers, accounting for the
+//! registers and shared memory needed by the persistent buffers
+KernelCost estimatePersistentKernelCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const ReductionParams* rparams,
+    HeuristicDataCache* data_cache = nullptr);
+
+//! Computes the heuristics of scheduler_type for fusion and returns their
+//! predicted runtime in microseconds, or std::nullopt if the heuristics can't
+//! be computed, e.g., for segments the runtime info only partially describes.
+NVF_API std::optional<double> predictRuntime(
+    SchedulerType scheduler_type,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info);
+
+} // namespace cost_model
+
+} // namespace nvfuser
@@ -13,6 +13,8 @@
 #include <scheduler/registry_utils.h>
 #include <scheduler/runtime_info.h>
 
+#include <cmath>
+
 namespace nvfuser {
 
 namespace {
@@ -40,9 +42,117 @@ bool allOutputsArePointerArithmetics(Fusion* fusion) {
   auto out_tvs = ir_utils::filterByType<TensorView>(fusion->outputs());
   return std::all_of(out_tvs.begin(), out_tvs.end(), is_pointer_arithmetic);
 }
+
+// Returns the definition of v if it is a BinaryOp of op_type
+BinaryOp* binaryOpOf(Val* v, BinaryOpType op_type) {
+  auto* bop = v == nullptr ? nullptr : dynamic_cast<BinaryOp*>(v->definition());
+  if (bop == nullptr || bop->getBinaryOpType() != op_type) {
+    return nullptr;
+  }
+  return bop;
+}
+
+// Returns the input of the definition of v if it is a UnaryOp of op_type
+Val* unaryOperand(Val* v, UnaryOpType op_type) {
+  auto* uop = v == nullptr ? nullptr : dynamic_cast<UnaryOp*>(v->definition());
+  if (uop == nullptr || uop->getUnaryOpType() != op_type) {
+    return nullptr;
+  }
+  return uop->in();
+}
+
+// Returns the other operand of the definition of v if it is a BinaryOp of
+// op_type with the constant scalar as one operand
+Val* scalarOperand(Val* v, BinaryOpType op_type, double scalar) {
+  BinaryOp* bop = binaryOpOf(v, op_type);
+  if (bop == nullptr) {
+    return nullptr;
+  }
+  auto is_scalar = [scalar](Val* operand) {
+    return operand->isConst() && operand->value().is<double>() &&
+        std::abs(operand->value().as<double>() - scalar) < 1e-9;
+  };
+  if (is_scalar(bop->lhs())) {
+    return bop->rhs();
+  }
+  if (is_scalar(bop->rhs())) {
+    return bop->lhs();
+  }
+  return nullptr;
+}
+
+// Returns x if y is tanh_gelu(x) as defined in ops/composite.cpp
+Val* tanhGeluInput(Val* y) {
+  constexpr double kBeta = M_SQRT2 * M_2_SQRTPI * 0.5;
+  constexpr double kKappa = 0.044715;
+
+  BinaryOp* out = binaryOpOf(
+      scalarOperand(y, BinaryOpType::Mul, 0.5), BinaryOpType::Mul);
+  if (out == nullptr) {
+    return nullptr;
+  }
+  Val* x = out->lhs();
+  Val* tanh_inner = unaryOperand(
+      scalarOperand(out->rhs(), BinaryOpType::Add, 1.0), UnaryOpType::Tanh);
+  BinaryOp* inner_2 = binaryOpOf(
+      scalarOperand(tanh_inner, BinaryOpType::Mul, kBeta), BinaryOpType::Add);
+  if (inner_2 == nullptr || inner_2->lhs() != x) {
+    return nullptr;
+  }
+  BinaryOp* x_cube = binaryOpOf(
+      scalarOperand(inner_2->rhs(), BinaryOpType::Mul, kKappa),
+      BinaryOpType::Mul);
+  if (x_cube == nullptr || x_cube->lhs() != x) {
+    return nullptr;
+  }
+  BinaryOp* x_sq = binaryOpOf(x_cube->rhs(), BinaryOpType::Mul);
+  if (x_sq == nullptr || x_sq->lhs() != x || x_sq->rhs() != x) {
+    return nullptr;
+  }
+  return x;
+}
 } // namespace
 
-// Check if the fusion has a single MatmulOp/LinearOp node
+std::optional<LinearActivation> matchLinearActivation(Fusion* fusion) {
+  if (fusion->outputs().size() != 1) {
+    return std::nullopt;
+  }
+  Val* out = fusion->outputs().front();
+  // Expressions of the pattern, which must be all those of the fusion
+  int64_t num_exprs = 1;
+  if (Val* in = unaryOperand(out, UnaryOpType::Cast)) {
+    out = in;
+    num_exprs++;
+  }
+
+  LinearActivation match;
+  Val* x = nullptr;
+  if ((x = unaryOperand(out, UnaryOpType::Relu)) != nullptr) {
+    num_exprs++;
+  } else if ((x = tanhGeluInput(out)) != nullptr) {
+    match.gelu = true;
+    // See tanh_gelu
+    num_exprs += 9;
+  } else {
+    return std::nullopt;
+  }
+  if (Val* in = unaryOperand(x, UnaryOpType::Cast)) {
+    x = in;
+    num_exprs++;
+  }
+
+  match.linear = dynamic_cast<LinearOp*>(x->definition());
+  if (match.linear == nullptr || !match.linear->hasBias() ||
+      match.linear->inB()->nDims() != 2 ||
+      match.linear->bias()->nDims() != 1 ||
+      std::ssize(fusion->exprs()) != num_exprs) {
+    return std::nullopt;
+  }
+  return match;
+}
+
+// Check if the fusion has a single MatmulOp/LinearOp node or a
+// LinearActivation
 bool ExprEvalScheduler::canScheduleCompileTime(Fusion* fusion) {
   if (scheduler_utils::isResharding(fusion)) {
     scheduler_debug_utils::canScheduleRejectReason(
@@ -54,6 +164,12 @@ bool ExprEvalScheduler::canScheduleCompileTime(Fusion* fusion) {
     return true;
   }
 
+  // NVFUSER_DISABLE=matmul_expr_eval disables the fused epilogue too
+  if (matchLinearActivation(fusion).has_value() &&
+      !isOptionDisabled(DisableOption::MatmulExprEval)) {
+    return true;
+  }
+
   auto exprs = fusion->exprs();
   if (exprs.size() != 1) {
     scheduler_debug_utils::canScheduleRejectReason(
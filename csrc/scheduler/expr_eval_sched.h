@@ -10,17 +10,34 @@
 #include <scheduler/heuristic.h>
 #include <scheduler/registry.h>
 
+#include <optional>
+
 namespace nvfuser {
 
 class Fusion;
 class SchedulerRuntimeInfo;
 class HeuristicDataCache;
+class LinearOp;
+
+// A LinearOp with a bias followed by a ReLU or a tanh-approximated GELU,
+// optionally in float between casts. cuBLASLt applies the bias and the
+// activation in the epilogue of the matmul, so ExprEvalExecutor runs the
+// pattern as a single library call instead of a matmul and a pointwise kernel.
+struct LinearActivation {
+  LinearOp* linear = nullptr;
+  // tanh-approximated GELU if true, ReLU otherwise
+  bool gelu = false;
+};
+
+// Returns the LinearActivation if it is the whole fusion
+std::optional<LinearActivation> matchLinearActivation(Fusion* fusion);
 
 // ExprEval scheduler represents the case where we allocate outputs directly
 // using EE. No code is generated.
 class ExprEvalScheduler : public SchedulerEntry {
  public:
-  // This scheduler only accepts MatmulOp.
+  // This scheduler only accepts a single expression evaluated by ATen, such
+  // as MatmulOp, or a LinearActivation.
   bool canScheduleCompileTime(Fusion* fusion) override;
 
   bool canScheduleRunTime(
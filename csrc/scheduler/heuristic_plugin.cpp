@@ -0,0 +1,581 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+
+#include <ir/interface_nodes.h>
+#include <ir/utils.h>
+#include <scheduler/heuristic_plugin.h>
+#include <scheduler/utils.h>
+#include <sys_utils.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nvfuser {
+
+namespace heuristic_plugin {
+
+namespace {
+
+std::mutex plugin_mutex;
+typedef std::unique_ptr<KernelConfig> (*KernelConfigFactoryPointer)();
+static class PluginInterface : LibraryLoader {
+ public:
+  PluginInterface() {
+    const char* envvar = getNvFuserEnv("HEURISTIC_PLUGIN");
+    if (envvar != nullptr) {
+      setFilename(envvar);
+    }
+  }
+
+  ~PluginInterface() = default;
+
+  bool available() const {
+    return !filename().empty();
+  }
+
+  std::unique_ptr<KernelConfig> getConfig() {
+    NVF_ERROR(available());
+    if (factory_func_ptr_ == nullptr) {
+      std::lock_guard<std::mutex> lock(plugin_mutex);
+      factory_func_ptr_ =
+          (KernelConfigFactoryPointer)getSymbol("makeHeuristicConfig");
+    }
+    return (*factory_func_ptr_)();
+  }
+
+ private:
+  KernelConfigFactoryPointer factory_func_ptr_ = nullptr;
+} plugin;
+
+std::unique_ptr<KernelConfig> defaultConfigFactory() {
+  return plugin.getConfig();
+}
+
+// See matmul_heuristic_plugin.cpp for why a flag is used instead of comparing
+// config_factory with defaultConfigFactory.
+thread_local KernelConfigFactory config_factory = defaultConfigFactory;
+thread_local bool config_factory_modified = false;
+
+using ProblemDescription = KernelConfig::ProblemDescription;
+using ParallelDim = KernelConfig::ParallelDim;
+
+//! Holds the storage referenced by the pointers of a ProblemDescription
+struct ProblemStorage {
+  std::vector<int64_t> extents;
+  std::string input_dtypes;
+  std::string output_dtypes;
+};
+
+char dtypeToChar(const DataType& dtype) {
+  if (dtype == DataType::Bool) {
+    return 'O';
+  } else if (dtype == DataType::Char) {
+    return 'B';
+  } else if (dtype == DataType::Int32) {
+    return 'I';
+  } else if (dtype == DataType::Int) {
+    return 'L';
+  } else if (dtype == DataType::Float8_e4m3fn) {
+    return 'Q';
+  } else if (dtype == DataType::Float8_e5m2) {
+    return 'R';
+  } else if (dtype == DataType::BFloat16) {
+    return 'T';
+  } else if (dtype == DataType::Half) {
+    return 'H';
+  } else if (dtype == DataType::Float) {
+    return 'S';
+  } else if (dtype == DataType::Double) {
+    return 'D';
+  } else if (dtype == DataType::ComplexFloat) {
+    return 'C';
+  } else if (dtype == DataType::ComplexDouble) {
+    return 'Z';
+  }
+  return '?';
+}
+
+std::string dtypesToString(const std::vector<Val*>& vals) {
+  std::string dtypes;
+  for (auto tv : ir_utils::filterByType<TensorView>(vals)) {
+    dtypes.push_back(dtypeToChar(tv->getDataType().value()));
+  }
+  return dtypes;
+}
+
+uint8_t toVecSize(int64_t vectorization_factor) {
+  return (uint8_t)std::clamp(vectorization_factor, (int64_t)1, (int64_t)255);
+}
+
+ProblemDescription::SchedulerType toPluginSchedulerType(
+    SchedulerType scheduler_type) {
+  switch (scheduler_type) {
+    case SchedulerType::PointWise:
+      return ProblemDescription::SchedulerType::PointWise;
+    case SchedulerType::Reduction:
+      return ProblemDescription::SchedulerType::Reduction;
+    case SchedulerType::InnerPersistent:
+      return ProblemDescription::SchedulerType::InnerPersistent;
+    case SchedulerType::OuterPersistent:
+      return ProblemDescription::SchedulerType::OuterPersistent;
+    case SchedulerType::InnerOuterPersistent:
+      return ProblemDescription::SchedulerType::InnerOuterPersistent;
+    case SchedulerType::Transpose:
+      return ProblemDescription::SchedulerType::Transpose;
+    default:
+      NVF_THROW("Unsupported scheduler for heuristic plugin: ", scheduler_type);
+  }
+}
+
+ParallelDim toParallelDim(ParallelType parallel_type) {
+  switch (parallel_type) {
+    case ParallelType::Serial:
+      return ParallelDim::Serial;
+    case ParallelType::BIDx:
+      return ParallelDim::BIDx;
+    case ParallelType::BIDy:
+      return ParallelDim::BIDy;
+    case ParallelType::BIDz:
+      return ParallelDim::BIDz;
+    case ParallelType::TIDx:
+      return ParallelDim::TIDx;
+    case ParallelType::TIDy:
+      return ParallelDim::TIDy;
+    case ParallelType::TIDz:
+      return ParallelDim::TIDz;
+    default:
+      NVF_THROW(
+          "Unsupported parallel type for heuristic plugin: ", parallel_type);
+  }
+}
+
+ParallelType toParallelType(ParallelDim parallel_dim) {
+  switch (parallel_dim) {
+    case ParallelDim::Serial:
+      return ParallelType::Serial;
+    case ParallelDim::BIDx:
+      return ParallelType::BIDx;
+    case ParallelDim::BIDy:
+      return ParallelType::BIDy;
+    case ParallelDim::BIDz:
+      return ParallelType::BIDz;
+    case ParallelDim::TIDx:
+      return ParallelType::TIDx;
+    case ParallelDim::TIDy:
+      return ParallelType::TIDy;
+    case ParallelDim::TIDz:
+      return ParallelType::TIDz;
+  }
+  NVF_THROW(
+      "Unrecognized parallel dimension returned by plugin: ",
+      (int)parallel_dim);
+}
+
+constexpr std::array<ParallelType, 6> launch_dim_types = {
+    ParallelType::BIDx,
+    ParallelType::BIDy,
+    ParallelType::BIDz,
+    ParallelType::TIDx,
+    ParallelType::TIDy,
+    ParallelType::TIDz};
+
+void copyLaunchParamsToConfig(
+    KernelConfig* config,
+    const HeuristicParams* params) {
+  for (auto i : arange(launch_dim_types.size())) {
+    config->launch_dims[i] = params->lparams.getRawVal(launch_dim_types[i]);
+  }
+}
+
+void copyConfigToLaunchParams(
+    HeuristicParams* params,
+    const KernelConfig* config) {
+  const KernelConfig::LaunchDims& dims = config->launch_dims;
+  LaunchParams lparams(dims[0], dims[1], dims[2], dims[3], dims[4], dims[5]);
+  lparams.setSmem(params->lparams.smem());
+  params->lparams = lparams;
+}
+
+//! Fills the parts of the problem description shared by all schedulers.
+//! storage must outlive the call to configure.
+void fillProblemDescription(
+    ProblemDescription& problem,
+    ProblemStorage& storage,
+    SchedulerType scheduler_type,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference) {
+  problem.scheduler_type = toPluginSchedulerType(scheduler_type);
+
+  for (IterDomain* id : TensorDomain::noDevices(
+           TensorDomain::noReductions(reference->getLogicalDomain()))) {
+    auto extent = runtime_info.expressionEvaluator().evaluate(id->extent());
+    NVF_ERROR(
+        extent.hasValue(),
+        "Error inferring extent for heuristic plugin: ",
+        id->extent()->toInlineString());
+    storage.extents.push_back(extent.as<int64_t>());
+  }
+  storage.input_dtypes = dtypesToString(fusion->inputs());
+  storage.output_dtypes = dtypesToString(fusion->outputs());
+
+  problem.extents = storage.extents.data();
+  problem.num_dims = (uint32_t)storage.extents.size();
+  problem.input_dtypes = storage.input_dtypes.c_str();
+  problem.output_dtypes = storage.output_dtypes.c_str();
+}
+
+void copyParamsToConfig(KernelConfig* config, const PointwiseParams* pparams) {
+  KernelConfig::Pointwise& pointwise = config->pointwise;
+  pointwise.break_point = pparams->break_point;
+  pointwise.split_block = pparams->split_block;
+  pointwise.split_grid_y_dim = pparams->split_grid_y_dim;
+  pointwise.flip_grid_binding = pparams->flip_grid_binding;
+  pointwise.vectorization_factor = pparams->vectorization_factor;
+  pointwise.unroll_factor_outer = pparams->unroll_factor_outer;
+  pointwise.unroll_factor_inner = pparams->unroll_factor_inner;
+  copyLaunchParamsToConfig(config, pparams);
+}
+
+void copyConfigToParams(PointwiseParams* pparams, const KernelConfig* config) {
+  const KernelConfig::Pointwise& pointwise = config->pointwise;
+  pparams->break_point = pointwise.break_point;
+  pparams->split_block = pointwise.split_block;
+  pparams->split_grid_y_dim = pointwise.split_grid_y_dim;
+  pparams->flip_grid_binding = pointwise.flip_grid_binding;
+  pparams->vectorization_factor = pointwise.vectorization_factor;
+  pparams->unroll_factor_outer = pointwise.unroll_factor_outer;
+  pparams->unroll_factor_inner = pointwise.unroll_factor_inner;
+  copyConfigToLaunchParams(pparams, config);
+}
+
+void copyParamsToConfig(KernelConfig* config, const ReductionParams* rparams) {
+  KernelConfig::Reduction& reduction = config->reduction;
+  reduction.fastest_dim = rparams->fastest_dim;
+  reduction.persistent_kernel = rparams->persistent_kernel;
+  reduction.project_persistent_buffers = rparams->project_persistent_buffers;
+  reduction.schedule_3D = rparams->schedule_3D;
+  reduction.flip_grid = rparams->flip_grid;
+
+  reduction.cross_block_inner_reduction = rparams->cross_block_inner_reduction;
+  reduction.cross_grid_inner_reduction = rparams->cross_grid_inner_reduction;
+  reduction.unroll_factor_inner_reduction =
+      rparams->unroll_factor_inner_reduction;
+  reduction.unroll_factor_top_of_vectorization =
+      rparams->unroll_factor_top_of_vectorization;
+  reduction.vectorize_inner_reduction = rparams->vectorize_inner_reduction;
+  reduction.split_grid_dim_inner_reduction =
+      rparams->split_grid_dim_inner_reduction;
+  reduction.pad_inner_reduction_to_warp = rparams->pad_inner_reduction_to_warp;
+  reduction.batches_per_block_inner_reduction =
+      rparams->batches_per_block_inner_reduction;
+  reduction.block_dim_inner_reduction =
+      toParallelDim(rparams->block_dim_inner_reduction);
+  reduction.grid_dim_inner_reduction =
+      toParallelDim(rparams->grid_dim_inner_reduction);
+  reduction.block_dim_inner_reduction_extra =
+      toParallelDim(rparams->block_dim_inner_reduction_extra);
+
+  reduction.multiple_reds_per_blk = rparams->multiple_reds_per_blk;
+  reduction.unroll_factor_iter_dom = rparams->unroll_factor_iter_dom;
+  reduction.vectorize_iter_dom = rparams->vectorize_iter_dom;
+  reduction.split_grid_dim_iter_dom_inner =
+      rparams->split_grid_dim_iter_dom_inner;
+  reduction.split_grid_dim_iter_dom_outer =
+      rparams->split_grid_dim_iter_dom_outer;
+  reduction.block_dim_iter_dom = toParallelDim(rparams->block_dim_iter_dom);
+  reduction.grid_dim_iter_dom = toParallelDim(rparams->grid_dim_iter_dom);
+
+  reduction.cross_block_outer_reduction = rparams->cross_block_outer_reduction;
+  reduction.cross_grid_outer_reduction = rparams->cross_grid_outer_reduction;
+  reduction.split_grid_dim_outer_reduction =
+      rparams->split_grid_dim_outer_reduction;
+  reduction.batches_per_block_outer_reduction =
+      rparams->batches_per_block_outer_reduction;
+  reduction.unroll_factor_outer_reduction =
+      rparams->unroll_factor_outer_reduction;
+  reduction.block_dim_outer_reduction =
+      toParallelDim(rparams->block_dim_outer_reduction);
+  reduction.grid_dim_outer_reduction =
+      toParallelDim(rparams->grid_dim_outer_reduction);
+
+  reduction.compute_persistent_buffer_with_first_consumer =
+      rparams->compute_persistent_buffer_with_first_consumer;
+  reduction.static_bdimx = rparams->static_bdimx;
+  reduction.static_bdimy = rparams->static_bdimy;
+
+  reduction.combined_inner_outer = rparams->combined_inner_outer;
+  reduction.tidx_for_outer_reduction = rparams->tidx_for_outer_reduction;
+  reduction.pad_outer_reduction_to_warp = rparams->pad_outer_reduction_to_warp;
+  reduction.combined_split_grid_inner_dim =
+      rparams->combined_split_grid_inner_dim;
+  reduction.vectorization_factor_outer = rparams->vectorization_factor_outer;
+  reduction.vectorization_factor_tmp_gmem_write =
+      rparams->vectorization_factor_tmp_gmem_write;
+  copyLaunchParamsToConfig(config, rparams);
+}
+
+void copyConfigToParams(ReductionParams* rparams, const KernelConfig* config) {
+  const KernelConfig::Reduction& reduction = config->reduction;
+  rparams->fastest_dim = reduction.fastest_dim;
+  rparams->persistent_kernel = reduction.persistent_kernel;
+  rparams->project_persistent_buffers = reduction.project_persistent_buffers;
+  rparams->schedule_3D = reduction.schedule_3D;
+  rparams->flip_grid = reduction.flip_grid;
+
+  rparams->cross_block_inner_reduction = reduction.cross_block_inner_reduction;
+  rparams->cross_grid_inner_reduction = reduction.cross_grid_inner_reduction;
+  rparams->unroll_factor_inner_reduction =
+      reduction.unroll_factor_inner_reduction;
+  rparams->unroll_factor_top_of_vectorization =
+      reduction.unroll_factor_top_of_vectorization;
+  rparams->vectorize_inner_reduction = reduction.vectorize_inner_reduction;
+  rparams->split_grid_dim_inner_reduction =
+      reduction.split_grid_dim_inner_reduction;
+  rparams->pad_inner_reduction_to_warp = reduction.pad_inner_reduction_to_warp;
+  rparams->batches_per_block_inner_reduction =
+      reduction.batches_per_block_inner_reduction;
+  rparams->block_dim_inner_reduction =
+      toParallelType(reduction.block_dim_inner_reduction);
+  rparams->grid_dim_inner_reduction =
+      toParallelType(reduction.grid_dim_inner_reduction);
+  rparams->block_dim_inner_reduction_extra =
+      toParallelType(reduction.block_dim_inner_reduction_extra);
+
+  rparams->multiple_reds_per_blk = reduction.multiple_reds_per_blk;
+  rparams->unroll_factor_iter_dom = reduction.unroll_factor_iter_dom;
+  rparams->vectorize_iter_dom = reduction.vectorize_iter_dom;
+  rparams->split_grid_dim_iter_dom_inner =
+      reduction.split_grid_dim_iter_dom_inner;
+  rparams->split_grid_dim_iter_dom_outer =
+      reduction.split_grid_dim_iter_dom_outer;
+  rparams->block_dim_iter_dom = toParallelType(reduction.block_dim_iter_dom);
+  rparams->grid_dim_iter_dom = toParallelType(reduction.grid_dim_iter_dom);
+
+  rparams->cross_block_outer_reduction = reduction.cross_block_outer_reduction;
+  rparams->cross_grid_outer_reduction = reduction.cross_grid_outer_reduction;
+  rparams->split_grid_dim_outer_reduction =
+      reduction.split_grid_dim_outer_reduction;
+  rparams->batches_per_block_outer_reduction =
+      reduction.batches_per_block_outer_reduction;
+  rparams->unroll_factor_outer_reduction =
+      reduction.unroll_factor_outer_reduction;
+  rparams->block_dim_outer_reduction =
+      toParallelType(reduction.block_dim_outer_reduction);
+  rparams->grid_dim_outer_reduction =
+      toParallelType(reduction.grid_dim_outer_reduction);
+
+  rparams->compute_persistent_buffer_with_first_consumer =
+      reduction.compute_persistent_buffer_with_first_consumer;
+  rparams->static_bdimx = reduction.static_bdimx;
+  rparams->static_bdimy = reduction.static_bdimy;
+
+  rparams->combined_inner_outer = reduction.combined_inner_outer;
+  rparams->tidx_for_outer_reduction = reduction.tidx_for_outer_reduction;
+  rparams->pad_outer_reduction_to_warp = reduction.pad_outer_reduction_to_warp;
+  rparams->combined_split_grid_inner_dim =
+      reduction.combined_split_grid_inner_dim;
+  rparams->vectorization_factor_outer = reduction.vectorization_factor_outer;
+  rparams->vectorization_factor_tmp_gmem_write =
+      reduction.vectorization_factor_tmp_gmem_write;
+  copyConfigToLaunchParams(rparams, config);
+}
+
+void copyParamsToConfig(KernelConfig* config, const TransposeParams* tparams) {
+  KernelConfig::Transpose& transpose = config->transpose;
+  transpose.tile_size1 = tparams->tile_size1;
+  transpose.tile_size2 = tparams->tile_size2;
+  transpose.vectorize_factor1 = tparams->vectorize_factor1;
+  transpose.vectorize_factor2 = tparams->vectorize_factor2;
+  copyLaunchParamsToConfig(config, tparams);
+}
+
+void copyConfigToParams(TransposeParams* tparams, const KernelConfig* config) {
+  const KernelConfig::Transpose& transpose = config->transpose;
+  tparams->tile_size1 = transpose.tile_size1;
+  tparams->tile_size2 = transpose.tile_size2;
+  tparams->vectorize_factor1 = transpose.vectorize_factor1;
+  tparams->vectorize_factor2 = transpose.vectorize_factor2;
+  copyConfigToLaunchParams(tparams, config);
+}
+
+void checkVectorizationFactor(
+    int64_t vectorization_factor,
+    int64_t max_vectorization_factor,
+    const char* name) {
+  NVF_CHECK(
+      vectorization_factor >= 1 &&
+          vectorization_factor <= max_vectorization_factor,
+      "Invalid ",
+      name,
+      " returned by heuristic plugin: ",
+      vectorization_factor,
+      ". Expected a value between 1 and ",
+      max_vectorization_factor);
+}
+
+} // namespace
+
+bool updatePointwiseParams(
+    PointwiseParams* pparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference,
+    int64_t max_vectorization_factor) {
+  if (!hasPlugin()) {
+    return false;
+  }
+
+  // Use factory function to create an empty config
+  std::unique_ptr<KernelConfig> config = config_factory();
+
+  // Set previous heuristic values so they are available to the plugin
+  copyParamsToConfig(config.get(), pparams);
+
+  ProblemStorage storage;
+  fillProblemDescription(
+      config->problem,
+      storage,
+      SchedulerType::PointWise,
+      fusion,
+      runtime_info,
+      reference);
+  config->problem.supported_vec_size.group1 =
+      toVecSize(max_vectorization_factor);
+
+  // Execute the user-provided heuristic
+  config->configure();
+
+  // Load values from config back into pparams. The vectorization factor is
+  // checked by the caller as it depends on the break point.
+  copyConfigToParams(pparams, config.get());
+
+  return true;
+}
+
+bool updateReductionParams(
+    ReductionParams* rparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reduction_tv,
+    int64_t max_vectorization_factor,
+    int64_t max_persistent_buffer_size) {
+  if (!hasPlugin()) {
+    return false;
+  }
+
+  std::unique_ptr<KernelConfig> config = config_factory();
+
+  copyParamsToConfig(config.get(), rparams);
+
+  ProblemStorage storage;
+  ProblemDescription& problem = config->problem;
+  fillProblemDescription(
+      problem,
+      storage,
+      rparams->scheduler_type,
+      fusion,
+      runtime_info,
+      ir_utils::getSoleProducerTv(reduction_tv));
+  const auto properties = scheduler_utils::getReductionProperties(
+      fusion, runtime_info, reduction_tv);
+  problem.total_reduction_numel = properties.total_reduction_numel;
+  problem.total_iteration_numel = properties.total_iteration_numel;
+  problem.inner_most_dimension_numel = properties.inner_most_dimension_numel;
+  problem.fastest_dim_reduction = properties.fastest_dim_reduction;
+  problem.max_persistent_buffer_size = max_persistent_buffer_size;
+  problem.supported_vec_size.group1 = toVecSize(max_vectorization_factor);
+
+  config->configure();
+
+  copyConfigToParams(rparams, config.get());
+
+  if (rparams->vectorize_inner_reduction) {
+    checkVectorizationFactor(
+        rparams->unroll_factor_inner_reduction,
+        max_vectorization_factor,
+        "inner reduction vectorization factor");
+  }
+  if (rparams->vectorize_iter_dom) {
+    checkVectorizationFactor(
+        rparams->unroll_factor_iter_dom,
+        max_vectorization_factor,
+        "iteration domain vectorization factor");
+  }
+
+  return true;
+}
+
+bool updateTransposeParams(
+    TransposeParams* tparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference1,
+    int64_t max_vectorization_factor1,
+    int64_t max_vectorization_factor2) {
+  if (!hasPlugin()) {
+    return false;
+  }
+
+  std::unique_ptr<KernelConfig> config = config_factory();
+
+  copyParamsToConfig(config.get(), tparams);
+
+  ProblemStorage storage;
+  fillProblemDescription(
+      config->problem,
+      storage,
+      SchedulerType::Transpose,
+      fusion,
+      runtime_info,
+      reference1);
+  config->problem.supported_vec_size.group1 =
+      toVecSize(max_vectorization_factor1);
+  config->problem.supported_vec_size.group2 =
+      toVecSize(max_vectorization_factor2);
+
+  config->configure();
+
+  copyConfigToParams(tparams, config.get());
+
+  checkVectorizationFactor(
+      tparams->vectorize_factor1,
+      max_vectorization_factor1,
+      "vectorization factor of the first group");
+  checkVectorizationFactor(
+      tparams->vectorize_factor2,
+      max_vectorization_factor2,
+      "vectorization factor of the second group");
+
+  return true;
+}
+
+bool hasPlugin() {
+  return config_factory_modified || plugin.available();
+}
+
+KernelConfigFactoryGuard::KernelConfigFactoryGuard(KernelConfigFactory func)
+    : prev_factory_(config_factory),
+      prev_factory_modified_(config_factory_modified) {
+  config_factory = func;
+  config_factory_modified = true;
+}
+
+KernelConfigFactoryGuard::~KernelConfigFactoryGuard() {
+  config_factory = prev_factory_;
+  config_factory_modified = prev_factory_modified_;
+}
+
+} // namespace heuristic_plugin
+
+} // namespace nvfuser
@@ -0,0 +1,80 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <fusion.h>
+#include <scheduler/heuristic_plugin_api.h>
+#include <scheduler/pointwise_heuristic.h>
+#include <scheduler/reduction_heuristic.h>
+#include <scheduler/runtime_info.h>
+#include <scheduler/transpose_heuristic.h>
+
+#include <functional>
+#include <memory>
+
+namespace nvfuser {
+
+namespace heuristic_plugin {
+
+//! Returns true if KernelConfigFactoryGuard is active indicating an imitated
+//! plugin, or if a shared library plugin has been provided using the
+//! environment variable NVFUSER_HEURISTIC_PLUGIN.
+bool hasPlugin();
+
+//! If there is no user-defined plugin (see hasPlugin()) we return false.
+//! Otherwise, we use the plugin to modify the pointwise parameters in place.
+//! reference is the reference tensor of the pointwise scheduler and
+//! max_vectorization_factor the vectorization factor supported at the break
+//! point chosen by the default heuristic.
+bool updatePointwiseParams(
+    PointwiseParams* pparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference,
+    int64_t max_vectorization_factor);
+
+//! Same as updatePointwiseParams for the reduction and persistent schedulers,
+//! which are told apart by rparams->scheduler_type. reduction_tv is the
+//! reference reduction tensor.
+bool updateReductionParams(
+    ReductionParams* rparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reduction_tv,
+    int64_t max_vectorization_factor,
+    int64_t max_persistent_buffer_size = 0);
+
+//! Same as updatePointwiseParams for the transpose scheduler. reference1 is
+//! the reference tensor of the first group.
+bool updateTransposeParams(
+    TransposeParams* tparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference1,
+    int64_t max_vectorization_factor1,
+    int64_t max_vectorization_factor2);
+
+//! Defines the type of the "makeHeuristicConfig" symbol
+using KernelConfigFactory = std::function<std::unique_ptr<KernelConfig>()>;
+
+//! This function can be used to imitate a plugin, in the same way as
+//! matmul_heuristic_plugin::KernelConfigFactoryGuard. When the guard passes
+//! out of scope, the config factory will be reset to its prior value.
+class KernelConfigFactoryGuard {
+ public:
+  explicit KernelConfigFactoryGuard(KernelConfigFactory func);
+  ~KernelConfigFactoryGuard();
+
+ private:
+  KernelConfigFactory prev_factory_;
+  bool prev_factory_modified_;
+};
+
+} // namespace heuristic_plugin
+
+} // namespace nvfuser
@@ -0,0 +1,186 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace nvfuser {
+
+namespace heuristic_plugin {
+
+//! This is the counterpart of matmul_heuristic_plugin::KernelConfig for the
+//! pointwise, reduction, inner/outer/inner-outer persistent and transpose
+//! schedulers. In order to plug in your own custom heuristic, create a dynamic
+//! library defining a subclass of KernelConfig, overriding the `configure`
+//! method, and export a std::unique_ptr<KernelConfig> makeHeuristicConfig()
+//! function that returns a unique_ptr to an object of that type. The symbol
+//! name differs from the matmul plugin's makeConfig so that a single library
+//! can provide both.
+//!
+//! If that library is located at /path/to/libfoo.so you can set
+//! NVFUSER_HEURISTIC_PLUGIN=/path/to/libfoo.so to use the plugin to determine
+//! the parameters of those schedulers.
+//!
+//! Before `configure` is called, `problem` describes the fusion segment and
+//! the remaining fields hold the parameters chosen by the default heuristic.
+//! Only `launch_dims` and the parameter struct matching
+//! `problem.scheduler_type` are read back afterwards, so the plugin is
+//! responsible for keeping `launch_dims` consistent with the parameters it
+//! changes, e.g. with the tile sizes of the transpose scheduler. Parameters
+//! that are not exposed here, e.g. which persistent buffers are stored in
+//! shared memory, are kept from the default heuristic.
+struct KernelConfig {
+  //! This is the information available to the plugin to determine the kernel
+  //! configuration.
+  struct ProblemDescription {
+    //! Explicit integer mapping for the scheduler being configured
+    enum class SchedulerType {
+      PointWise = 0,
+      Reduction = 1,
+      InnerPersistent = 2,
+      OuterPersistent = 3,
+      InnerOuterPersistent = 4,
+      Transpose = 5,
+    };
+    SchedulerType scheduler_type = SchedulerType::PointWise;
+
+    //! Extents of the reference tensor of the scheduler, ignoring reduction
+    //! and device dimensions. The reference is the largest output for the
+    //! pointwise scheduler, the producer of the reference reduction for the
+    //! reduction and persistent schedulers, and the reference of the first
+    //! group for the transpose scheduler.
+    const int64_t* extents = nullptr;
+    uint32_t num_dims = 0;
+
+    //! Data types of the fusion input and output tensors, one letter per
+    //! tensor using the mapping documented in matmul_heuristic_plugin_api.h,
+    //! extended with L = Int64 and O = Bool. Other types are mapped to '?'.
+    const char* input_dtypes = "";
+    const char* output_dtypes = "";
+
+    //! Only set for the reduction and persistent schedulers
+    int64_t total_reduction_numel = 0;
+    int64_t total_iteration_numel = 0;
+    int64_t inner_most_dimension_numel = 0;
+    bool fastest_dim_reduction = false;
+
+    //! Size in bytes of the persistent buffers of the inner and outer
+    //! persistent schedulers, 0 otherwise
+    int64_t max_persistent_buffer_size = 0;
+
+    //! Largest vectorization factors in elements allowed by the inputs and
+    //! outputs. The first group applies to all schedulers; the second one is
+    //! only used by the transpose scheduler. For the pointwise scheduler, this
+    //! is for the break point chosen by the default heuristic.
+    struct SupportedVectorization {
+      uint8_t group1 = 1;
+      uint8_t group2 = 1;
+    } supported_vec_size;
+  } problem;
+
+  //! gdimx, gdimy, gdimz, bdimx, bdimy and bdimz of the kernel, or -1 for
+  //! dimensions the kernel is not parallelized on
+  using LaunchDims = std::array<int64_t, 6>;
+  LaunchDims launch_dims = {-1, -1, -1, -1, -1, -1};
+
+  //! Explicit integer mapping for the parallel dimensions used by reductions
+  enum class ParallelDim {
+    Serial = 0,
+    BIDx = 1,
+    BIDy = 2,
+    BIDz = 3,
+    TIDx = 4,
+    TIDy = 5,
+    TIDz = 6,
+  };
+
+  //! Mirrors PointwiseParams
+  struct Pointwise {
+    int64_t break_point = 0;
+    bool split_block = false;
+    bool split_grid_y_dim = false;
+    bool flip_grid_binding = false;
+    int64_t vectorization_factor = 1;
+    int64_t unroll_factor_outer = 1;
+    int64_t unroll_factor_inner = 1;
+  } pointwise;
+
+  //! Mirrors ReductionParams. Used by the reduction and persistent schedulers.
+  struct Reduction {
+    bool fastest_dim = false;
+    bool persistent_kernel = false;
+    bool project_persistent_buffers = false;
+    bool schedule_3D = false;
+    bool flip_grid = false;
+
+    // Inner reduction domain
+    bool cross_block_inner_reduction = false;
+    bool cross_grid_inner_reduction = false;
+    int64_t unroll_factor_inner_reduction = 1;
+    int64_t unroll_factor_top_of_vectorization = 1;
+    bool vectorize_inner_reduction = false;
+    bool split_grid_dim_inner_reduction = false;
+    bool pad_inner_reduction_to_warp = false;
+    int64_t batches_per_block_inner_reduction = 1;
+    ParallelDim block_dim_inner_reduction = ParallelDim::Serial;
+    ParallelDim grid_dim_inner_reduction = ParallelDim::Serial;
+    ParallelDim block_dim_inner_reduction_extra = ParallelDim::Serial;
+
+    // Iteration domain
+    bool multiple_reds_per_blk = false;
+    int64_t unroll_factor_iter_dom = 1;
+    bool vectorize_iter_dom = false;
+    bool split_grid_dim_iter_dom_inner = false;
+    bool split_grid_dim_iter_dom_outer = false;
+    ParallelDim block_dim_iter_dom = ParallelDim::Serial;
+    ParallelDim grid_dim_iter_dom = ParallelDim::Serial;
+
+    // Outer reduction domain of 3D schedules
+    bool cross_block_outer_reduction = false;
+    bool cross_grid_outer_reduction = false;
+    bool split_grid_dim_outer_reduction = false;
+    int64_t batches_per_block_outer_reduction = 1;
+    int64_t unroll_factor_outer_reduction = 1;
+    ParallelDim block_dim_outer_reduction = ParallelDim::Serial;
+    ParallelDim grid_dim_outer_reduction = ParallelDim::Serial;
+
+    bool compute_persistent_buffer_with_first_consumer = false;
+    bool static_bdimx = false;
+    bool static_bdimy = false;
+
+    // Combined inner and outer reductions
+    bool combined_inner_outer = false;
+    bool tidx_for_outer_reduction = false;
+    bool pad_outer_reduction_to_warp = false;
+    bool combined_split_grid_inner_dim = false;
+    int64_t vectorization_factor_outer = 1;
+    int64_t vectorization_factor_tmp_gmem_write = 1;
+  } reduction;
+
+  //! Mirrors the tile and vectorization parameters of TransposeParams
+  struct Transpose {
+    int64_t tile_size1 = 32;
+    int64_t tile_size2 = 32;
+    int64_t vectorize_factor1 = 1;
+    int64_t vectorize_factor2 = 1;
+  } transpose;
+
+ public:
+  // This should be overridden to implement the actual heuristic logic
+  virtual void configure() = 0;
+
+  // This allows us to use a std::unique_ptr<KernelConfig> and call derived
+  // classes' destructors on deletion.
+  virtual ~KernelConfig() = default;
+};
+
+} // namespace heuristic_plugin
+
+} // namespace nvfuser
@@ -205,15 +205,41 @@ void Common::cacheInputsAndOutputs(bool skip_intermediates) {
   // fusion segmentation
   scheduler_utils::clearMemorySpace(fusion_);
 
+  // On Hopper+, only the operands are loaded to shared memory with TMA. Any
+  // other inputs of the operand prologues, like the per-row statistics of a
+  // normalization, are loaded to registers and computed with.
+  const bool load_prologue_inputs_to_registers =
+      !isAmpere(params_->mma_macro) && !isTuring(params_->mma_macro);
+  std::unordered_set<Val*> prologue_vals;
+  VectorOfUniqueEntries<TensorView*> prologue_inputs;
+
   // Cache operands
   for (auto role : {MatmulTensorRole::OPERAND_A, MatmulTensorRole::OPERAND_B}) {
     VectorOfUniqueEntries<TensorView*> unique_operands;
+    const std::vector<TensorView*>& role_tvs = tensor_roles_.count(role)
+        ? tensor_roles_.at(role)
+        : std::vector<TensorView*>{};
     for (const mma_utils::MatmulPattern& pattern : patterns_) {
       TensorView* immediate_operand =
           role == MatmulTensorRole::OPERAND_A ? pattern.A : pattern.B;
       for (Val* v : InputsOf::output(immediate_operand)) {
-        if (auto* tv = dynamic_cast<TensorView*>(v)) {
-          unique_operands.pushBack(tv);
+        auto* tv = dynamic_cast<TensorView*>(v);
+        if (tv == nullptr) {
+          continue;
+        }
+        if (load_prologue_inputs_to_registers &&
+            std::find(role_tvs.begin(), role_tvs.end(), tv) ==
+                role_tvs.end()) {
+          prologue_inputs.pushBack(tv);
+          continue;
+        }
+        unique_operands.pushBack(tv);
+      }
+      if (load_prologue_inputs_to_registers) {
+        for (Val* v : DependencyCheck::getAllValsBetween(
+                 {fusion_->inputs().begin(), fusion_->inputs().end()},
+                 {immediate_operand})) {
+          prologue_vals.insert(v);
         }
       }
     }
@@ -245,11 +271,41 @@ void Common::cacheInputsAndOutputs(bool skip_intermediates) {
     }
   }
 
+  // Cache prologue inputs. Their uses outside of the prologues are cached
+  // separately as epilogue inputs below.
+  for (TensorView* tv : prologue_inputs.vector()) {
+    std::vector<Expr*> prologue_uses;
+    for (Expr* use : tv->uses()) {
+      if (prologue_vals.count(use->output(0))) {
+        prologue_uses.push_back(use);
+      }
+    }
+    TensorView* tv_cache = tv->cacheAfter(
+        LoadStoreOpType::Set,
+        CacheOp::Unspecified,
+        /*propagate_allocation_domain=*/true,
+        prologue_uses);
+    cached_prologue_inputs_.emplace_back(tv, tv_cache);
+  }
+
   // Cache epilogue inputs
   if (auto it = tensor_roles_.find(MatmulTensorRole::EPILOGUE_INPUT);
       it != tensor_roles_.end()) {
     for (TensorView* tv : it->second) {
-      TensorView* tv_cache = tv->cacheAfter();
+      std::vector<Expr*> epilogue_uses;
+      for (Expr* use : tv->uses()) {
+        if (!prologue_vals.count(use->output(0))) {
+          epilogue_uses.push_back(use);
+        }
+      }
+      if (epilogue_uses.empty()) {
+        continue;
+      }
+      TensorView* tv_cache = tv->cacheAfter(
+          LoadStoreOpType::Set,
+          CacheOp::Unspecified,
+          /*propagate_allocation_domain=*/true,
+          epilogue_uses);
       cached_epilogue_inputs_.emplace_back(tv, tv_cache);
     }
   }
@@ -78,6 +78,8 @@ class Common {
   //! Defines all cache tensors of inputs and outputs. Schedules intermediate
   //! global TensorViews for skipping metadata operations like permute and
   //! broadcast when loading operands. Defines as_, bs_, acw_smems_, bcw_smems_.
+  //! On Hopper+, inputs of the operand prologues without an operand role are
+  //! cached in registers and saved in cached_prologue_inputs_.
   //! Sets the mma macro.
   //!
   //! If skip_intermediates is true, we call
@@ -132,6 +134,7 @@ class Common {
   int64_t num_device_and_batch_dims_ = 0;
 
   std::vector<std::pair<TensorView*, TensorView*>> cached_epilogue_inputs_;
+  std::vector<std::pair<TensorView*, TensorView*>> cached_prologue_inputs_;
 
   std::vector<TensorView*> as_, bs_, acw_smems_, bcw_smems_, mma_results_,
       splitk_sums_, smem_epilogues_;
@@ -1204,6 +1204,8 @@ void AmpereMinus::scheduleSplitKSum() {
   for (TensorView* splitk_sum : splitk_sums_) {
     // Always use serial grid reduction for split-K sum
     splitk_sum->definition()->as<ReductionOp>()->requestSerialGridReduction();
+    splitk_sum->definition()->as<ReductionOp>()->setSerialGridReductionChains(
+        params_->splitk_serial_chains);
 
     if (params_->use_smem_epilogue) {
       // Now that transforms are propagated backward to smem_epilogue, which
@@ -249,6 +249,14 @@ class MatmulParams : public HeuristicParams {
   // When (CTA-K == K), then stream-k is equivalent to the persistent
   // data-parallel strategy. When K dimension is evenly divided among CTAs (K %
   // CTA-K == 0), then stream-k is equivalent to persistent split-k strategy.
+  //
+  // The Hopper+ scheduler implements the latter case. The K loop of each
+  // output tile is distributed evenly across splitk_factor CTAs, which the
+  // heuristic chooses so that the number of work units fills whole waves of
+  // SMs. The partial tiles are accumulated by a serial grid reduction through
+  // a global workspace. Distributing the stages of a CTA across output tiles
+  // would need loop bounds that vary per CTA, which our loop nests can't
+  // express yet.
 
   //! Specify whether to use a 1-1 mapping from output tile to CTA or to launch
   //! one CTA per SM then loop over a subset of output tiles within the kernel
@@ -259,8 +267,10 @@ class MatmulParams : public HeuristicParams {
                    // referred to as the (data-parallel) strategy.
     DistributeTilesAcrossSMs, // Use persistent kernels to compute entire output
                               // tiles
-    DistributeStagesAcrossSMs // Use persistent kernels to compute whole and
-                              // partial output tiles (stream-K)
+    DistributeStagesAcrossSMs // Distribute the K loop of each output tile
+                              // across splitk_factor CTAs, chosen to fill
+                              // whole waves of SMs (stream-K). See [Split-K
+                              // and Stream-K].
   } tiling_strategy = TilingStrategy::OneTilePerCTA;
 
   //! Configure circular buffering loops
@@ -313,6 +323,12 @@ class MatmulParams : public HeuristicParams {
   //! Promote reuse of prologue shared memory
   bool promote_prologue_smem_reuse = false;
 
+  //! If use_smem_epilogue==true and tiles are distributed across SMs, wait
+  //! for the TMA store of a tile only before the next tile writes its output
+  //! to shared memory instead of at the end of the tile, so that the store
+  //! overlaps with the mainloop of the next tile.
+  bool overlap_epilogue_store = false;
+
   //! If use_smem_epilogue==false, this has no effect. Otherwise, it enables
   //! storing the mma result to shared memory using stmatrix and loading
   //! epilogue inputs to registers using ldmatrix instructions. Note that
@@ -324,6 +340,22 @@ class MatmulParams : public HeuristicParams {
   //! axis and perform a grid reduction before the epilogue.
   int splitk_factor = 1;
 
+  //! Number of chains the split-K serial grid reduction is split into. The
+  //! splitk_factor CTAs of each output tile are serialized within chains of
+  //! consecutive CTAs only, and the last CTA combines the chains in order.
+  //! This shortens the serialized part of the reduction from splitk_factor
+  //! steps to about splitk_factor / splitk_serial_chains +
+  //! splitk_serial_chains steps while keeping the result deterministic.
+  int64_t splitk_serial_chains = 1;
+
+  //! Number of SMs that persistent kernels distribute their tiles across, or
+  //! 0 to use all the SMs of the device. A smaller budget leaves SMs to the
+  //! kernels running concurrently on other streams, e.g., the NCCL kernels of
+  //! a pipelined host program, instead of delaying them until the persistent
+  //! CTAs exit. Other tiling strategies launch one CTA per work unit and
+  //! can't honor a budget. See matmul_utils::kReservedSMsKey.
+  int64_t sm_budget = 0;
+
   //! This is the CGA size on Hopper+ devices. This parameter is ignored on
   //! Ampere and Turing.
   //! Note that this indicates the actual dimension of the cluster in XYZ grid
@@ -370,6 +402,13 @@ class MatmulParams : public HeuristicParams {
     }
   } cluster_dims;
 
+  //! Multicast the operand tiles shared by the CTAs of a cluster with TMA, so
+  //! that each of them is loaded from global memory once per cluster instead
+  //! of once per CTA. Only honored on Hopper+ with warp specialized circular
+  //! buffering and OneTilePerCTA, and has no effect unless cluster_dims spans
+  //! more than one CTA.
+  bool multicast_operands = false;
+
   std::string toString() const override {
     std::stringstream ss;
     ss << "\n===== Matmul Parameters ========\n"
@@ -428,15 +467,21 @@ class MatmulParams : public HeuristicParams {
        << "Use shared memory epilogue: " << use_smem_epilogue << "\n"
        << "Promote re-use of prologue shared memory: "
        << promote_prologue_smem_reuse << "\n"
+       << "Overlap epilogue store: " << overlap_epilogue_store << "\n"
+       << "Multicast operands: " << multicast_operands << "\n"
        << "Use ldmatrix/stmatrix in epilogue: " << use_ldst_matrix << "\n"
        << "Split-K factor: " << splitk_factor << "\n"
+       << "Split-K serial chains: " << splitk_serial_chains << "\n"
+       << "SM budget: " << sm_budget << "\n"
        << "====================================\n";
     return ss.str();
   }
 
   size_t hash() const override {
     // combine boolean flags for hashing
-    size_t attr_hash = (static_cast<size_t>(promote_prologue_smem_reuse) << 2) |
+    size_t attr_hash = (static_cast<size_t>(overlap_epilogue_store) << 4) |
+        (static_cast<size_t>(multicast_operands) << 3) |
+        (static_cast<size_t>(promote_prologue_smem_reuse) << 2) |
         (static_cast<size_t>(use_smem_epilogue) << 1) |
         (static_cast<size_t>(async_gmem_load_operands));
 
@@ -448,7 +493,9 @@ class MatmulParams : public HeuristicParams {
         (std::hash<size_t>{}(static_cast<size_t>(cta_order)) << 4) ^
         (std::hash<size_t>{}(grid_traversal_factor.first) << 5) ^
         (std::hash<size_t>{}(grid_traversal_factor.second) << 6) ^
-        (std::hash<size_t>{}(splitk_factor) << 7);
+        (std::hash<size_t>{}(splitk_factor) << 7) ^
+        (std::hash<size_t>{}(splitk_serial_chains) << 8) ^
+        (std::hash<size_t>{}(sm_budget) << 9);
     return attr_hash;
   }
 
@@ -471,8 +518,12 @@ class MatmulParams : public HeuristicParams {
         other->grid_traversal_factor == grid_traversal_factor &&
         other->use_smem_epilogue == use_smem_epilogue &&
         other->promote_prologue_smem_reuse == promote_prologue_smem_reuse &&
+        other->overlap_epilogue_store == overlap_epilogue_store &&
         other->cluster_dims == cluster_dims &&
-        other->splitk_factor == splitk_factor;
+        other->multicast_operands == multicast_operands &&
+        other->splitk_factor == splitk_factor &&
+        other->splitk_serial_chains == splitk_serial_chains &&
+        other->sm_budget == sm_budget;
   }
 
   std::unique_ptr<HeuristicParams> clone() const override {
@@ -136,7 +136,8 @@ void HopperPlus::validate() const {
   NVF_ERROR(
       cc >= 90, "This matmul scheduler is restricted to Hopper & Blackwell.");
 
-  if (params_->tiling_strategy != MatmulParams::TilingStrategy::OneTilePerCTA) {
+  if (params_->tiling_strategy ==
+      MatmulParams::TilingStrategy::DistributeTilesAcrossSMs) {
     NVF_CHECK(
         params_->splitk_factor == 1,
         "Hopper+ matmul scheduler does not support scheduling persistent "
@@ -148,12 +149,6 @@ void HopperPlus::validate() const {
       "Cluster dims must have 1 in Z dimension but found ",
       params_->cluster_dims.z);
 
-  NVF_CHECK(
-      params_->tiling_strategy !=
-          MatmulParams::TilingStrategy::DistributeStagesAcrossSMs,
-      "Hopper+ matmul scheduler does not support distributing stages across "
-      "SMs a la stream-K");
-
   NVF_CHECK(
       isCooperative(),
       "Hopper+ matmul scheduler only supports cooperatively buffering at the "
@@ -189,6 +184,9 @@ void HopperPlus::run() {
   // Defines acw_smem/bcw_smem and acr/bcr by possibly calling cacheAfter.
   cacheInputsAndOutputs(/*skip_intermediates=*/true);
 
+  // Defines the smem inputs of the mma for operands computed in a prologue
+  definePrologues();
+
   // We need to find roles again after caching, since we will need to rebuild
   // the IdModel.
   // TODO: update the val graph on the fly in cacheInputsAndOutputs using
@@ -196,8 +194,6 @@ void HopperPlus::run() {
   // a full rebuild here
   findRoles();
 
-  inspectPrologues();
-
   setCGADims();
 
   scheduleOperands();
@@ -205,6 +201,9 @@ void HopperPlus::run() {
   // schedule mma instruction output (mma_result)
   scheduleMmaResults();
 
+  // schedule the computation between the smem operands and the mma inputs
+  schedulePrologues();
+
   // schedule epilogue
   scheduleEpilogue();
 
@@ -395,7 +394,8 @@ std::vector<MatmulDimRole> HopperPlus::applyCgaAndCtaTilingWithSwizzling(
         mma_utils::makeTile(tv, params_->tile_sizes.cta_tile, merged_roles);
 
     switch (params_->tiling_strategy) {
-      case MatmulParams::TilingStrategy::OneTilePerCTA: {
+      case MatmulParams::TilingStrategy::OneTilePerCTA:
+      case MatmulParams::TilingStrategy::DistributeStagesAcrossSMs: {
         // NOTE: This merge is only used for non-persistent schedules
         // Now merge the 3 CGA/CTA split outer dims back with the outermost
         // dims. This is important since we need single dims to bind to. For
@@ -554,9 +554,12 @@ std::vector<std::vector<MatmulDimRole>> HopperPlus::blockTileTensors(
       }
     }
 
-    // Merge in batch dims to the BIDy dim for non-persistent
+    // Merge in batch dims to the BIDy dim for non-persistent. Stream-K
+    // kernels distribute the split K loop over BIDz, see scheduleSplitKSum.
     if (params_->tiling_strategy ==
-        MatmulParams::TilingStrategy::OneTilePerCTA) {
+            MatmulParams::TilingStrategy::OneTilePerCTA ||
+        params_->tiling_strategy ==
+            MatmulParams::TilingStrategy::DistributeStagesAcrossSMs) {
       if (num_local_batch_dims_ > 0) {
         NVF_ERROR(merged_roles.front() == MatmulDimRole::Batch);
         // Merge batch dim into the dimension that will be parallelized BIDy
@@ -603,27 +606,92 @@ std::vector<std::vector<MatmulDimRole>> HopperPlus::blockTileTensors(
 }
 
 int64_t HopperPlus::numCGAs() const {
-  const int64_t num_sms =
-      at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
-  return num_sms /
+  return matmul_utils::numSMs(params_) /
       (params_->cluster_dims.x * params_->cluster_dims.y *
        params_->cluster_dims.z);
 }
 
-void HopperPlus::inspectPrologues() const {
+void HopperPlus::definePrologues() {
   for (TensorView* mma_result : mma_results_) {
     for (Val* v : mma_result->definition()->inputs()) {
       TensorView* op_input = v->as<TensorView>();
+      if (std::find(acw_smems_.begin(), acw_smems_.end(), op_input) !=
+              acw_smems_.end() ||
+          std::find(bcw_smems_.begin(), bcw_smems_.end(), op_input) !=
+              bcw_smems_.end() ||
+          std::find(prologue_smems_.begin(), prologue_smems_.end(), op_input) !=
+              prologue_smems_.end()) {
+        continue;
+      }
+      // The operand is computed in registers from the TMA-loaded operand and
+      // possibly other inputs. The MMA reads its operands from shared memory,
+      // so we write the result of the prologue to a swizzled smem tensor.
+      NVF_CHECK(
+          isHopper(params_->mma_macro),
+          "Prologue fusion is only supported on Hopper but found macro ",
+          toString(params_->mma_macro));
+      TensorView* prologue_smem = cacheAfter(op_input);
+      prologue_smem->setMemoryType(MemoryType::Shared);
+      prologue_smems_.push_back(prologue_smem);
+    }
+  }
+}
 
-      // We currently require all operands to lie in smem, meaning we cannot yet
-      // handle any prologue computation. This includes `BroadcastOp` which
-      // might be introduced when translating a MatmulOp or LinearOp to MmaOp.
-      Expr* def = op_input->definition();
-      NVF_ERROR(def != nullptr && def->isA<LoadStoreOp>());
-      NVF_ERROR(
-          def->input(0)->as<TensorView>()->getMemoryType() ==
-          MemoryType::Global);
+void HopperPlus::schedulePrologues() {
+  if (prologue_smems_.empty()) {
+    return;
+  }
+  blockTileTensors(prologue_smems_);
+  parallelizeBlocks(prologue_smems_);
+
+  // The prologue computation is bounded by the TMA-loaded operands and the
+  // global inputs that are loaded to registers
+  std::vector<TensorView*> boundary_tvs = acw_smems_;
+  boundary_tvs.insert(boundary_tvs.end(), bcw_smems_.begin(), bcw_smems_.end());
+  for (const auto& [tv, tv_cache] : cached_prologue_inputs_) {
+    boundary_tvs.push_back(tv);
+  }
+
+  const int64_t num_math_warp_groups = getNumEpilogueWarpGroups();
+  for (TensorView* prologue_smem : prologue_smems_) {
+    mma_utils::orderTiledConcreteIdAsMaybeAllocationDomain(prologue_smem);
+    const std::vector<IterDomain*> tiled_loop =
+        prologue_smem->getLoopDomain();
+
+    // Swizzle the allocation domain the same way applyMmaSwizzleForTMALoad
+    // swizzles the TMA-loaded operands, so that the MMA can read the tile
+    // with the same descriptor. The inner dimension is split into boxes of
+    // the swizzle width before swizzling each box.
+    const MmaInputSmemSwizzle swizzle =
+        mma_utils::tmaSwizzleSharedMemory(prologue_smem);
+    const int64_t dtype_size = dataTypeSizeByte(prologue_smem->dtype());
+    if (swizzle != MmaInputSmemSwizzle::None) {
+      prologue_smem->split(-1, getBytesFromSwizzle(swizzle) / dtype_size);
+      prologue_smem->reorder({{-2, -3}});
+    }
+    prologue_smem->applyMmaSwizzle(swizzle);
+
+    // The threads write the tile in the order of the unswizzled loop domain,
+    // 16 bytes at a time:
+    //   [..., Mi, Ki] -> [..., MKi/vec/128/WG, WG, TIDx(128), vec]
+    prologue_smem->setLoopDomain(tiled_loop);
+    const int64_t vec_size = core_matrix_width_bytes / dtype_size;
+    prologue_smem->merge(-2);
+    prologue_smem->split(-1, vec_size);
+    prologue_smem->split(-2, 128);
+    prologue_smem->axis(-2)->parallelize(ParallelType::TIDx);
+    if (num_math_warp_groups > 1) {
+      prologue_smem->split(-3, num_math_warp_groups);
+      prologue_smem->axis(-3)->parallelize(ParallelType::TIDy);
     }
+
+    scheduler_utils::BoundedDirectionalTransformPropagator::backward(
+        prologue_smem,
+        -1,
+        boundary_tvs,
+        scheduler_utils::BoundedDirectionalTransformPropagator::Options()
+            .propagateParallelType());
+    prologue_smem->axis(-1)->parallelize(ParallelType::Vectorize);
   }
 }
 
@@ -653,7 +721,8 @@ void HopperPlus::parallelizeBlocks(const std::vector<TensorView*>& tvs) const {
   for (TensorView* tv : tvs) {
     switch (params_->tiling_strategy) {
       case MatmulParams::TilingStrategy::OneTilePerCTA:
-        // Data-parallel kernels are parallelized BIDx BIDy
+      case MatmulParams::TilingStrategy::DistributeStagesAcrossSMs:
+        // Data-parallel and stream-K kernels are parallelized BIDx BIDy
         switch (params_->cta_order) {
           // TODO: Should we instead check the roles of these dimensions to take
           // the outermost two M or N axes?
@@ -671,7 +740,6 @@ void HopperPlus::parallelizeBlocks(const std::vector<TensorView*>& tvs) const {
         }
         break;
       case MatmulParams::TilingStrategy::DistributeTilesAcrossSMs:
-      case MatmulParams::TilingStrategy::DistributeStagesAcrossSMs:
         // For persistent kernels, we parallelize BIDx, and if cluster_dims is
         // non-trivial then we also bind BIDy and BIDz
         if (params_->cluster_dims.x != 1 || params_->cluster_dims.y != 1) {
@@ -1211,6 +1279,12 @@ void Blackwell::scheduleEpilogueWithSmemEpilogue() {
 void HopperPlus::scheduleEpilogue() {
   if (params_->use_smem_epilogue) {
     scheduleEpilogueWithSmemEpilogue();
+    // Only a persistent kernel has a next tile to overlap the TMA stores with
+    if (params_->overlap_epilogue_store &&
+        params_->tiling_strategy ==
+            MatmulParams::TilingStrategy::DistributeTilesAcrossSMs) {
+      fusion_->manage("overlap_tma_store", true);
+    }
   } else {
     scheduleEpilogueWithoutSmemEpilogue();
   }
@@ -1223,6 +1297,8 @@ void Hopper::scheduleSplitKSum() {
   for (TensorView* splitk_sum : splitk_sums_) {
     // Always use serial grid reduction for split-K sum
     splitk_sum->definition()->as<ReductionOp>()->requestSerialGridReduction();
+    splitk_sum->definition()->as<ReductionOp>()->setSerialGridReductionChains(
+        params_->splitk_serial_chains);
     transformLikeMmaOutputWithoutK(splitk_sum);
     auto s = mma_utils::MmaSwizzler::scheduleMmaOutputAllocation(
         splitk_sum->getLoopDomain());
@@ -1248,6 +1324,8 @@ void Blackwell::scheduleSplitKSum() {
   for (TensorView* splitk_sum : splitk_sums_) {
     // Always use serial grid reduction for split-K sum
     splitk_sum->definition()->as<ReductionOp>()->requestSerialGridReduction();
+    splitk_sum->definition()->as<ReductionOp>()->setSerialGridReductionChains(
+        params_->splitk_serial_chains);
     transformLikeMmaOutputWithoutK(splitk_sum);
     splitk_sum->axis(2)->parallelize(ParallelType::BIDz);
     splitk_sum->split(-1, getLdTMemVectorizeFactor());
@@ -122,8 +122,8 @@ class HopperPlus : public Common {
   //
   //  result in global memory: d
 
-  // Currently the support is for a, b, c and d as fusion inputs/outputs
-  //  aka. no prolog fusion yet.
+  // a and b are fusion inputs loaded by TMA. On Hopper, the mma inputs might
+  // be computed from them in a prologue, see definePrologues().
   void cacheOperandsToSmem(
       const std::vector<TensorView*>& operands,
       std::vector<TensorView*>& smem_operands);
@@ -159,7 +159,8 @@ class HopperPlus : public Common {
       const std::vector<TensorView*>& tvs);
 
   //! Specifies the CGA dimensions by setting "cluster_dims" as fusion-managed
-  //! data
+  //! data, and requests the TMA multicast of the operand tiles shared by the
+  //! CTAs of a CGA by setting "tma_multicast"
   void setCGADims() const {
     if (params_->cluster_dims != MatmulParams::ClusterDims{1, 1, 1}) {
       fusion_->manage(
@@ -168,6 +169,13 @@ class HopperPlus : public Common {
               params_->cluster_dims.x,
               params_->cluster_dims.y,
               params_->cluster_dims.z});
+      if (params_->multicast_operands &&
+          params_->circular_buffering_strategy ==
+              MatmulParams::CircularBufferingStrategy::WarpSpecialized &&
+          params_->tiling_strategy ==
+              MatmulParams::TilingStrategy::OneTilePerCTA) {
+        fusion_->manage("tma_multicast", true);
+      }
     }
   }
 
@@ -181,9 +189,17 @@ class HopperPlus : public Common {
   //! defineOperandCaches().
   void scheduleOperands();
 
-  //! Check that there is no computation in the prologues, since we do not
-  //! support that (yet)
-  void inspectPrologues() const;
+  //! Defines a shared memory cache for each mma input that is computed in a
+  //! prologue instead of being loaded by TMA. These are saved in
+  //! prologue_smems_. Only Hopper supports prologue computation, since wgmma
+  //! reads the operands from shared memory written by the math warp groups.
+  void definePrologues();
+
+  //! Schedule the prologue smem tensors with the swizzle expected by the mma
+  //! and propagate their loop domain to the prologue computation, which is
+  //! bounded by the TMA-loaded operands and the prologue inputs cached in
+  //! registers.
+  void schedulePrologues();
 
   void parallelizeBlocks(const std::vector<TensorView*>& tvs) const;
 
@@ -227,6 +243,9 @@ class HopperPlus : public Common {
   // Get the circular buffer type: pipelined or warp-specialized?
   // If warp-specialized, on which parallel type? Do we want register sharing?
   CircularBufferType getCircularBufferType() const;
+
+  // Shared memory inputs of the mma written by the prologue computation
+  std::vector<TensorView*> prologue_smems_;
 };
 
 class Hopper : public HopperPlus {
@@ -20,6 +20,7 @@
 #include <ir/interface_nodes.h>
 #include <ir/internal_nodes.h>
 #include <ir/utils.h>
+#include <iter_visitor.h>
 #include <mma_type.h>
 #include <options.h>
 #include <runtime/executor_utils.h>
@@ -29,6 +30,7 @@
 #include <val_graph.h>
 
 #include <algorithm>
+#include <cmath>
 #include <deque>
 #include <iostream>
 #include <iterator>
@@ -36,6 +38,7 @@
 #include <memory>
 #include <sstream>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include "matmul_heuristic.h"
@@ -49,6 +52,38 @@ namespace {
 //! Access to the structure should be done with labels defined in MatmulDimRole.
 using ProblemShape = std::array<int64_t, 4>;
 
+//! Returns the N size, from min_n to 256 in steps of step_n, of the macro
+//! that covers n_extent best.
+uint16_t getBestMacroN(int64_t n_extent, uint16_t min_n, uint16_t step_n) {
+  const auto score_macro = [&n_extent](int64_t macro_n) {
+    // We prefer a macro_n that divides n_extent most evenly, since a small
+    // remainder means we will have a row of tiles with a lot of wasted
+    // work. The best case though is when there is no remainder as in that
+    // case no extra tile row is needed.
+    //
+    // However, it is not worth creating new rows of tiles in the output
+    // just to avoid a remainder, so the largest contribution to the score
+    // is 256 times the number of tile rows needed.
+    int64_t score = ceilDiv(n_extent, macro_n) * 256L;
+    int64_t remainder = n_extent % macro_n;
+    if (remainder != 0) {
+      score += macro_n - remainder;
+    }
+    return score;
+  };
+  // Scan through all possible macros to find the one with the lowest score
+  uint16_t best_macro_n = min_n;
+  int64_t best_macro_score = score_macro(min_n);
+  for (uint16_t macro_n = min_n + step_n; macro_n <= 256; macro_n += step_n) {
+    int64_t score = score_macro((int64_t)macro_n);
+    if (score < best_macro_score) {
+      best_macro_n = macro_n;
+      best_macro_score = score;
+    }
+  }
+  return best_macro_n;
+}
+
 //! A helper for deciding the type of MMA op for given fusion and problem shape.
 inline std::optional<MmaMacro> getMmaOp(
     const int dev_version,
@@ -72,40 +107,25 @@ inline std::optional<MmaMacro> getMmaOp(
         macro_encode.n = 16;
       }
       break;
-    case 90: {
+    case 90:
       macro_encode.arch = MmaMacroEncode::Arch::Hopper;
       macro_encode.m = 64;
       // TODO: guess here whether it is advantageous to double M or double N in
       // order to form the CTA tile. Currently we assume M is doubled (coopA)
-      const auto score_macro = [&n_extent](int64_t macro_n) {
-        // We prefer a macro_n that divides n_extent most evenly, since a small
-        // remainder means we will have a row of tiles with a lot of wasted
-        // work. The best case though is when there is no remainder as in that
-        // case no extra tile row is needed.
-        //
-        // However, it is not worth creating new rows of tiles in the output
-        // just to avoid a remainder, so the largest contribution to the score
-        // is 256 times the number of tile rows needed.
-        int64_t score = ceilDiv(n_extent, macro_n) * 256L;
-        int64_t remainder = n_extent % macro_n;
-        if (remainder != 0) {
-          score += macro_n - remainder;
-        }
-        return score;
-      };
-      // Scan through all possible macros to find the one with the lowest score
-      uint16_t best_macro_n = 8;
-      int64_t best_macro_score = score_macro(8);
-      for (uint16_t macro_n = 16; macro_n <= 256; macro_n += 8) {
-        int64_t score = score_macro((int64_t)macro_n);
-        if (score < best_macro_score) {
-          best_macro_n = macro_n;
-          best_macro_score = score;
-        }
+      macro_encode.n = getBestMacroN(n_extent, /*min_n=*/8, /*step_n=*/8);
+      break;
+    case 100:
+    case 103:
+      // The paired CTAs of the default heuristic don't issue the 2-CTA MMA
+      // yet, so it's opt-in until that MMA exists
+      if (!isOptionEnabled(EnableOption::BlackwellMatmulHeuristic)) {
+        return std::nullopt;
       }
-      macro_encode.n = best_macro_n;
+      // The accumulator of a 128-row macro spans all 128 lanes of TMem
+      macro_encode.arch = MmaMacroEncode::Arch::Blackwell1CTA;
+      macro_encode.m = 128;
+      macro_encode.n = getBestMacroN(n_extent, /*min_n=*/16, /*step_n=*/16);
       break;
-    }
     default:
       return std::nullopt;
   }
@@ -134,11 +154,9 @@ void limitCircularBufferingSmemOperands(
     const int64_t tiles_n = ceilDiv(
         problem_shape[(size_t)MatmulDimRole::N],
         mparams->tile_sizes.cta_tile.n);
-    const int64_t num_sms =
-        at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
     // NOTE: we don't account for swizzle here which might increase this number
     // in rare cases
-    num_tiles_per_cta = ceilDiv(tiles_m * tiles_n, num_sms);
+    num_tiles_per_cta = ceilDiv(tiles_m * tiles_n, numSMs(mparams));
   }
   int64_t stages = std::min(
       (int64_t)mparams->circular_buffer_options.smem_circular_buffer_stage,
@@ -155,6 +173,61 @@ void limitCircularBufferingSmemOperands(
 
 namespace {
 
+// Returns the number of chains that the serial reduction of splitk_factor
+// partial tiles is split into, about the square root of the factor, which
+// minimizes the serialized steps splitk_factor / chains + chains.
+int64_t getSplitKSerialChains(int64_t splitk_factor) {
+  if (splitk_factor < 4) {
+    return 1;
+  }
+  return std::lround(std::sqrt((double)splitk_factor));
+}
+
+// Returns the number of CTAs the K loop of each output tile is split across,
+// or 1 if the output tiles alone fill the SMs. Tall-skinny problems, e.g., the
+// GEMMs of decoding with M of at most 64 and a long K, have fewer tiles than
+// SMs, so most SMs would idle. The partial tiles are summed by the serial grid
+// reduction in fp32 through a global work buffer, which needs no
+// initialization and is retained across launches with
+// EnableOption::IntermediateBufferPool.
+int64_t getSplitKFactor(
+    const MatmulParams* mparams,
+    const ProblemShape& problem_shape,
+    const size_t num_problems) {
+  constexpr int64_t max_splitk_factor = 16;
+
+  // Split-K and batch dimensions are both parallelized on BIDz
+  if (num_problems != 1 || problem_shape[(size_t)MatmulDimRole::Batch] != 1) {
+    return 1;
+  }
+  // The fixup of the partial tiles only pays off for a long K loop
+  if (problem_shape[(size_t)MatmulDimRole::K] <
+      std::max(
+          problem_shape[(size_t)MatmulDimRole::M],
+          problem_shape[(size_t)MatmulDimRole::N])) {
+    return 1;
+  }
+  const GemmTile& cta_tile = mparams->tile_sizes.cta_tile;
+  const int64_t num_tiles =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::M], cta_tile.m) *
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::N], cta_tile.n);
+  const int64_t num_sms = numSMs(mparams);
+  if (num_tiles >= num_sms) {
+    return 1;
+  }
+  // Each CTA still iterates over enough stages to fill its circular buffer
+  const int64_t k_stages =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::K], cta_tile.k);
+  const int64_t min_stages_per_cta = std::max(
+      (int64_t)mparams->circular_buffer_options.smem_circular_buffer_stage,
+      (int64_t)1);
+  int64_t factor = std::min(num_sms / num_tiles, max_splitk_factor);
+  while (factor > 1 && ceilDiv(k_stages, factor) < min_stages_per_cta) {
+    factor--;
+  }
+  return factor;
+}
+
 bool fillDefaultAmpereHeuristic(
     MatmulParams* mparams,
     const ProblemShape& problem_shape,
@@ -245,9 +318,42 @@ bool fillDefaultAmpereHeuristic(
     mparams->circular_buffer_options.smem_circular_buffer_stage = std::min(
         2, mparams->circular_buffer_options.smem_circular_buffer_stage);
   }
+
+  mparams->splitk_factor =
+      (int)getSplitKFactor(mparams, problem_shape, num_problems);
+  mparams->splitk_serial_chains = getSplitKSerialChains(mparams->splitk_factor);
   return true;
 }
 
+// Computes how many total bytes need to be loaded for the cta tile, summed
+// over all tiles in the output
+int64_t estimateBytesTransferred(
+    const ProblemShape& problem_shape,
+    int64_t num_sms,
+    const GemmTile& cta) {
+  const int64_t tiles_m =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::M], cta.m);
+  const int64_t tiles_n =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::N], cta.n);
+  const int64_t tiles_k =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::K], cta.k);
+
+  // This is the number of bytes that get loaded per circular buffering stage
+  // in a single tile.
+  const int64_t bytes_per_output_tile = tiles_k * (cta.m + cta.n) * cta.k;
+
+  // Now we model wave quantization of the MN tile grid. For example if there
+  // are 132 SMs, then we round up the number of tiles to a multiple of 132
+  // and then multiply the bytes per output tile by that number. The last wave
+  // might run faster than we model it here because it is not really loading
+  // that full amount of data, but it is still wasted computation and so this
+  // is how we model it. Note that we also do not model L2 locality here at
+  // all, so this number is meant as a very rough estimate of compute time for
+  // memory-bound problems.
+  const int64_t num_waves = ceilDiv(tiles_m * tiles_n, num_sms);
+  return num_waves * num_sms * bytes_per_output_tile;
+}
+
 // This function sets cta_tile, warp_tile, and the mma instruction for Hopper
 // problems. Our strategy is as follows:
 // 1) We use warp_tile.k=cta_tile.k=64 usually, but we also check 16, 32,
@@ -264,40 +370,13 @@ bool fillDefaultAmpereHeuristic(
 void fillOptimalHopperTileSizes(
     MatmulParams* mparams,
     const ProblemShape& problem_shape) {
-  const int64_t m = problem_shape[(size_t)MatmulDimRole::M];
-  const int64_t n = problem_shape[(size_t)MatmulDimRole::N];
-  const int64_t k = problem_shape[(size_t)MatmulDimRole::K];
-
   struct TileConfig {
     GemmTile cta;
     GemmTile warp;
     GemmTile instr;
   };
 
-  // Compute how many total bytes need to be computed, summed over all tiles in
-  // the output
-  const auto bytes_transferred = [m, n, k](const GemmTile& cta) {
-    const int64_t tiles_m = ceilDiv(m, cta.m);
-    const int64_t tiles_n = ceilDiv(n, cta.n);
-    const int64_t tiles_k = ceilDiv(k, cta.k);
-
-    // This is the number of bytes that get loaded per circular buffering stage
-    // in a single tile.
-    const int64_t bytes_per_output_tile = tiles_k * (cta.m + cta.n) * cta.k;
-
-    // Now we model wave quantization of the MN tile grid. For example if there
-    // are 132 SMs, then we round up the number of tiles to a multiple of 132
-    // and then multiply the bytes per output tile by that number. The last wave
-    // might run faster than we model it here because it is not really loading
-    // that full amount of data, but it is still wasted computation and so this
-    // is how we model it. Note that we also do not model L2 locality here at
-    // all, so this number is meant as a very rough estimate of compute time for
-    // memory-bound problems.
-    const int64_t num_sms =
-        at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
-    const int64_t num_waves = ceilDiv(tiles_m * tiles_n, num_sms);
-    return num_waves * num_sms * bytes_per_output_tile;
-  };
+  const int64_t num_sms = numSMs(mparams);
 
   TileConfig best_config{
       /*cta=*/{64, 64, 64}, /*warp=*/{64, 64, 64}, /*instr=*/{64, 64, 16}};
@@ -336,7 +415,8 @@ void fillOptimalHopperTileSizes(
             .warp = {64L, instr_n, cta_k},
             .instr = {64L, instr_n, 16L},
         };
-        const int64_t bytes_tx = bytes_transferred(cfg.cta);
+        const int64_t bytes_tx =
+            estimateBytesTransferred(problem_shape, num_sms, cfg.cta);
         if (bytes_tx < best_bytes_tx) {
           best_bytes_tx = bytes_tx;
           best_config = cfg;
@@ -354,16 +434,96 @@ void fillOptimalHopperTileSizes(
       (uint16_t)16};
 }
 
+// This function sets cta_tile, warp_tile, and the mma instruction for
+// Blackwell problems, scoring the candidates like fillOptimalHopperTileSizes.
+// The MMA is issued by a single thread for the whole CTA, so the warp tile is
+// the CTA tile. The macro is 128 x instr_n and the CTA tile stacks one or two
+// of them along M. Their fp32 accumulators are allocated in TMem, whose 512
+// columns bound m_ratio * instr_n.
+void fillOptimalBlackwellTileSizes(
+    MatmulParams* mparams,
+    const ProblemShape& problem_shape) {
+  constexpr int64_t instr_m = 128;
+  constexpr int64_t tmem_columns = 512;
+  const int64_t num_sms = numSMs(mparams);
+
+  GemmTile best_cta{128, 128, 64};
+  int64_t best_bytes_tx = std::numeric_limits<int64_t>::max();
+
+  // If two sizes result in the same number of total byte, prefer the larger CTA
+  // K. To do this we iterate backwards here.
+  constexpr int64_t reserved_mbarrier_bytes = 1024L;
+  const int64_t smem_bytes =
+      at::cuda::getCurrentDeviceProperties()->sharedMemPerBlockOptin;
+  for (int64_t cta_k = 256; cta_k > 0; cta_k -= 64) {
+    for (int64_t m_ratio : {2L, 1L}) {
+      for (int64_t instr_n = 256; instr_n > 0; instr_n -= 64) {
+        const int64_t cta_m = m_ratio * instr_m;
+        if (m_ratio * instr_n > tmem_columns || cta_m > 256 || cta_k > 256) {
+          continue;
+        }
+        // Don't consider cases where we would need fewer than 3 load stages
+        // due to smem constraint
+        const int64_t bytes_per_stage = (cta_m + instr_n) * cta_k * 2;
+        if (bytes_per_stage * 3L > smem_bytes - reserved_mbarrier_bytes) {
+          continue;
+        }
+        const GemmTile cta{cta_m, instr_n, cta_k};
+        const int64_t bytes_tx =
+            estimateBytesTransferred(problem_shape, num_sms, cta);
+        if (bytes_tx < best_bytes_tx) {
+          best_bytes_tx = bytes_tx;
+          best_cta = cta;
+        }
+      }
+    }
+  }
+
+  mparams->tile_sizes.cta_tile = best_cta;
+  mparams->tile_sizes.warp_tile = best_cta;
+  mparams->mma_macro = MmaMacroEncode{
+      MmaMacroEncode::Arch::Blackwell1CTA,
+      (uint16_t)instr_m,
+      (uint16_t)best_cta.n,
+      (uint16_t)16};
+}
+
+// Returns true if computing operand from the fusion inputs needs ops other
+// than set, broadcast and squeeze, which can't be skipped when loading the
+// operand with TMA. See EnableOption::FuseMatmulPrologue.
+bool hasPrologueComputation(TensorView* operand) {
+  const std::vector<Expr*> exprs = StmtSort::getExprsTo({operand});
+  return std::any_of(exprs.begin(), exprs.end(), [](Expr* expr) {
+    return !expr->isOneOf<LoadStoreOp, BroadcastOp, SqueezeOp>();
+  });
+}
+
+int64_t maxOperandDtypeSize(
+    const mma_utils::TensorRolesMap& tensor_roles,
+    MatmulTensorRole role) {
+  int64_t size = 2;
+  if (auto it = tensor_roles.find(role); it != tensor_roles.end()) {
+    for (TensorView* tv : it->second) {
+      size = std::max(size, dataTypeSizeByte(tv->dtype()));
+    }
+  }
+  return size;
+}
+
 void maximizeHopperOperandStages(
     MatmulParams* mparams,
     const mma_utils::TensorRolesMap& tensor_roles,
-    const size_t num_problems) {
+    const std::vector<mma_utils::MatmulPattern>& patterns) {
   const GemmTile& cta_tile = mparams->tile_sizes.cta_tile;
 
   // TODO: We should take the main loop structure into account here to get a
   // more accurate estimate in case of horizontal fusion
-  int64_t operand_smem_per_stage =
-      (int64_t)num_problems * 2 * (cta_tile.m + cta_tile.n) * cta_tile.k;
+  int64_t operand_smem_per_stage = (int64_t)patterns.size() *
+      (maxOperandDtypeSize(tensor_roles, MatmulTensorRole::OPERAND_A) *
+           cta_tile.m +
+       maxOperandDtypeSize(tensor_roles, MatmulTensorRole::OPERAND_B) *
+           cta_tile.n) *
+      cta_tile.k;
   // warp specialized kernels require two mbarriers per stage
   if (mparams->circular_buffering_strategy ==
       MatmulParams::CircularBufferingStrategy::WarpSpecialized) {
@@ -375,10 +535,27 @@ void maximizeHopperOperandStages(
   // We leave a bit of space for semaphores.
   int64_t max_operand_smem =
       (int64_t)at::cuda::getCurrentDeviceProperties()->sharedMemPerBlockOptin;
+  // Operands with a prologue are computed in registers from the circular
+  // buffered TMA loads and stored to a single buffer the MMA reads
+  bool has_prologue = false;
+  for (const mma_utils::MatmulPattern& pattern : patterns) {
+    if (hasPrologueComputation(pattern.A)) {
+      max_operand_smem -= 2 * cta_tile.m * cta_tile.k;
+      has_prologue = true;
+    }
+    if (hasPrologueComputation(pattern.B)) {
+      max_operand_smem -= 2 * cta_tile.n * cta_tile.k;
+      has_prologue = true;
+    }
+  }
   // TODO: subtract additional space such as mbarriers used to synchronize the
   // epilogue in ping-pong
-  if (mparams->tiling_strategy != MatmulParams::TilingStrategy::OneTilePerCTA) {
-    // We cannot reuse memory for smem epilogue in persistent kernels.
+  if (mparams->tiling_strategy ==
+          MatmulParams::TilingStrategy::DistributeTilesAcrossSMs ||
+      has_prologue) {
+    // We cannot reuse memory for smem epilogue in persistent kernels. The
+    // prologue buffers are not circular buffered, so they can't be reused
+    // either.
     for (TensorView* out : tensor_roles.at(MatmulTensorRole::OUTPUT)) {
       max_operand_smem -=
           dataTypeSizeByte(out->dtype()) * cta_tile.m * cta_tile.n;
@@ -405,8 +582,9 @@ int64_t computeHopperBIDxTiles(
   // dimension. However, when we swizzle, we pull groups of a fixed size from
   // the _other_ dimension to create a new inner dimension. We find the swizzle
   // factor that is largest and has the least quantization when we divide that
-  // other dimension by the swizzle factor.
-  mparams->cta_order = Mtiles <= Ntiles
+  // other dimension by the swizzle factor. Blackwell pairs the CTAs of a
+  // cluster along M, see fillDefaultHopperHeuristic.
+  mparams->cta_order = Mtiles <= Ntiles || isBlackwell(mparams->mma_macro)
       ? MatmulParams::TileRasterizationOrder::ColumnMajor
       : MatmulParams::TileRasterizationOrder::RowMajor;
 
@@ -420,18 +598,87 @@ int64_t computeHopperBIDxTiles(
   return BIDx_tiles;
 }
 
+// Returns the number of CTAs the K loop of each output tile is distributed
+// across, or 1 if the persistent data-parallel kernel already fills the waves
+// of SMs well. Each additional split adds a partial tile to the fixup through
+// the global workspace, so a larger factor is only chosen if it improves the
+// wave efficiency noticeably. See TilingStrategy::DistributeStagesAcrossSMs.
+int64_t getStreamKFactor(
+    const MatmulParams* mparams,
+    const ProblemShape& problem_shape) {
+  // Wave efficiency above which the tiles are computed data-parallel
+  constexpr double min_wave_efficiency = 0.9;
+  // Wave efficiency a larger factor must gain over a smaller one
+  constexpr double min_wave_efficiency_gain = 0.05;
+  constexpr int64_t max_stream_k_factor = 8;
+
+  const GemmTile& cta_tile = mparams->tile_sizes.cta_tile;
+  const int64_t num_tiles =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::M], cta_tile.m) *
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::N], cta_tile.n) *
+      problem_shape[(size_t)MatmulDimRole::Batch];
+  const int64_t k_stages =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::K], cta_tile.k);
+  const int64_t num_sms = numSMs(mparams);
+  auto wave_efficiency = [num_sms](int64_t num_work_units) {
+    return (double)num_work_units /
+        (double)(ceilDiv(num_work_units, num_sms) * num_sms);
+  };
+
+  double best_efficiency = wave_efficiency(num_tiles);
+  int64_t best_factor = 1;
+  if (best_efficiency >= min_wave_efficiency) {
+    return best_factor;
+  }
+  // Each CTA still iterates over enough stages to fill its circular buffer
+  const int64_t min_stages_per_cta = std::max(
+      (int64_t)mparams->circular_buffer_options.smem_circular_buffer_stage,
+      (int64_t)1);
+  for (int64_t factor = 2; factor <= max_stream_k_factor &&
+       ceilDiv(k_stages, factor) >= min_stages_per_cta;
+       factor++) {
+    const double efficiency = wave_efficiency(num_tiles * factor);
+    if (efficiency >= best_efficiency + min_wave_efficiency_gain) {
+      best_efficiency = efficiency;
+      best_factor = factor;
+    }
+  }
+  return best_factor;
+}
+
+// Fills the default heuristic of Hopper and Blackwell, which are both
+// scheduled by the HopperPlus scheduler
 bool fillDefaultHopperHeuristic(
     MatmulParams* mparams,
     const ProblemShape& problem_shape,
     const mma_utils::TensorRolesMap& tensor_roles,
-    const size_t num_problems) {
+    const std::vector<mma_utils::MatmulPattern>& patterns) {
+  const bool is_blackwell = isBlackwell(mparams->mma_macro);
+
   // Use non-persistent kernel
   mparams->tiling_strategy =
       MatmulParams::TilingStrategy::DistributeTilesAcrossSMs;
 
-  fillOptimalHopperTileSizes(mparams, problem_shape);
+  if (is_blackwell) {
+    fillOptimalBlackwellTileSizes(mparams, problem_shape);
+  } else {
+    fillOptimalHopperTileSizes(mparams, problem_shape);
+  }
 
-  maximizeHopperOperandStages(mparams, tensor_roles, num_problems);
+  maximizeHopperOperandStages(mparams, tensor_roles, patterns);
+
+  // Distribute the K loops of the tiles across the SMs if the tile grid
+  // quantizes badly into waves, e.g., for skinny problems with a long K. This
+  // launches one CTA per work unit, so it's not used under an SM budget.
+  if (const int64_t stream_k_factor = mparams->sm_budget == 0
+          ? getStreamKFactor(mparams, problem_shape)
+          : 1;
+      stream_k_factor > 1) {
+    mparams->tiling_strategy =
+        MatmulParams::TilingStrategy::DistributeStagesAcrossSMs;
+    mparams->splitk_factor = (int)stream_k_factor;
+    mparams->splitk_serial_chains = getSplitKSerialChains(stream_k_factor);
+  }
 
   // Use warp specialization on hopper by default
   mparams->circular_buffering_strategy =
@@ -455,7 +702,12 @@ bool fillDefaultHopperHeuristic(
   // the _other_ dimension to create a new inner dimension. We find the swizzle
   // factor that is largest and has the least quantization when we divide that
   // other dimension by the swizzle factor.
-  mparams->cta_order = Mtiles <= Ntiles
+  //
+  // On Blackwell, the CTAs of a cluster are paired along M instead, like the
+  // pairs of CTAs of the 2-CTA MMA. The pair computes the two M halves of a
+  // 256 x N (or 512 x N) block, so it loads its B tile from L2 once for both
+  // CTAs. Cluster X applies to M with ColumnMajor.
+  mparams->cta_order = Mtiles <= Ntiles || is_blackwell
       ? MatmulParams::TileRasterizationOrder::ColumnMajor
       : MatmulParams::TileRasterizationOrder::RowMajor;
 
@@ -489,7 +741,8 @@ bool fillDefaultHopperHeuristic(
   // For non-persistent kernels, M=BIDx if cta_order is ColumnMajor, and N=BIDx
   // for RowMajor. These dims are then multiplied by the grid_traversal_factor
   // when swizzling.
-  if (mparams->tiling_strategy != MatmulParams::TilingStrategy::OneTilePerCTA ||
+  if (mparams->tiling_strategy ==
+          MatmulParams::TilingStrategy::DistributeTilesAcrossSMs ||
       computeHopperBIDxTiles(mparams, problem_shape) % 2 == 0) {
     mparams->cluster_dims = {2, 1, 1};
   }
@@ -497,21 +750,57 @@ bool fillDefaultHopperHeuristic(
   return true;
 }
 
+// A persistent kernel computes its tiles in waves of one tile per SM of the
+// budget. Shrinks the budget to the fewest SMs, in whole CGAs, that compute
+// the tiles in the same number of waves: the matmul takes as long and the
+// concurrent kernels get the remaining SMs. The budget is dropped for the
+// other tiling strategies, which can't honor it.
+void fitSMBudgetToWaves(
+    MatmulParams* mparams,
+    const ProblemShape& problem_shape) {
+  if (mparams->sm_budget == 0) {
+    return;
+  }
+  if (mparams->tiling_strategy !=
+      MatmulParams::TilingStrategy::DistributeTilesAcrossSMs) {
+    mparams->sm_budget = 0;
+    return;
+  }
+  const GemmTile& cta_tile = mparams->tile_sizes.cta_tile;
+  const int64_t num_tiles =
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::M], cta_tile.m) *
+      ceilDiv(problem_shape[(size_t)MatmulDimRole::N], cta_tile.n) *
+      problem_shape[(size_t)MatmulDimRole::Batch];
+  const int64_t cluster_size = mparams->cluster_dims.x *
+      mparams->cluster_dims.y * mparams->cluster_dims.z;
+  const int64_t num_waves = ceilDiv(num_tiles, mparams->sm_budget);
+  const int64_t sms_per_wave =
+      ceilDiv(ceilDiv(num_tiles, num_waves), cluster_size) * cluster_size;
+  mparams->sm_budget = std::min(mparams->sm_budget, sms_per_wave);
+}
+
 } // namespace
 
+int64_t numSMs(const MatmulParams* mparams) {
+  if (mparams->sm_budget > 0) {
+    return mparams->sm_budget;
+  }
+  return at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
+}
+
 //! A wrapper for core heuristics initialization.
 //! We should have already set mparams->mma_macro before calling this function.
 inline bool initCoreHeuristics(
     MatmulParams* mparams,
     const ProblemShape& problem_shape,
     const mma_utils::TensorRolesMap& tensor_roles,
-    const size_t num_problems) {
-  if (isHopper(mparams->mma_macro)) {
+    const std::vector<mma_utils::MatmulPattern>& patterns) {
+  if (isHopper(mparams->mma_macro) || isBlackwell(mparams->mma_macro)) {
     return fillDefaultHopperHeuristic(
-        mparams, problem_shape, tensor_roles, num_problems);
+        mparams, problem_shape, tensor_roles, patterns);
   } else if (isAmpere(mparams->mma_macro) || isTuring(mparams->mma_macro)) {
     return fillDefaultAmpereHeuristic(
-        mparams, problem_shape, tensor_roles, num_problems);
+        mparams, problem_shape, tensor_roles, patterns.size());
   }
   // Unsupported arch
   return false;
@@ -540,6 +829,36 @@ ProblemShape getProblemShape(
   return shape;
 }
 
+// Returns true if tv is only used to compute the operands of pattern, e.g.,
+// the per-group scales of quantized weights, whose group dim isn't mapped to
+// K. Such inputs get no tensor role and are cached in registers by the
+// prologue of the Hopper scheduler, see EnableOption::FuseMatmulPrologue.
+bool isPrologueOnlyInput(
+    TensorView* tv,
+    const mma_utils::MatmulPattern& pattern) {
+  if (at::cuda::getCurrentDeviceProperties()->major != 9 ||
+      !isOptionEnabled(EnableOption::FuseMatmulPrologue)) {
+    return false;
+  }
+  const std::vector<Val*> vals =
+      DependencyCheck::getAllValsBetween({tv}, {pattern.A, pattern.B});
+  if (vals.empty()) {
+    return false;
+  }
+  const std::unordered_set<Val*> val_set(vals.begin(), vals.end());
+  return std::all_of(vals.begin(), vals.end(), [&](Val* val) {
+    if (val == pattern.A || val == pattern.B) {
+      return true;
+    }
+    return std::all_of(val->uses().begin(), val->uses().end(), [&](Expr* use) {
+      return std::all_of(
+          use->outputs().begin(), use->outputs().end(), [&](Val* out) {
+            return val_set.count(out) > 0;
+          });
+    });
+  });
+}
+
 // Checks that this pattern:
 //   - is a GEMM or batch GEMM
 //   - has at least two inputs i.e. not A @ A.T
@@ -622,6 +941,12 @@ std::string isMatmulFusionDefinitionSupported(
       tvs_with_roles.insert(entry->second.begin(), entry->second.end());
     }
 
+    for (TensorView* tv : fusion_inputs_tvs) {
+      if (!tvs_with_roles.count(tv) && isPrologueOnlyInput(tv, pattern)) {
+        tvs_with_roles.insert(tv);
+      }
+    }
+
     const auto in_out_tvs_count =
         fusion_inputs_tvs.size() + fusion_outputs_tvs.size();
     if (in_out_tvs_count != tvs_with_roles.size()) {
@@ -1027,6 +1352,39 @@ MatmulParams::SupportedVectorization getSupportedVectorization(
   return calc.compute();
 }
 
+// Returns a reject reason if all matmul patterns of fusion are mul-sums with
+// an M or N of at most kMaxGemvRows. Such a matmul would waste most of each
+// tensor core tile, while the reduction scheduler computes it as a GEMV:
+// the K reduction is spread across the threads and warps of a block, the
+// contiguous K axis of the weights is loaded vectorized, and a dequantizing
+// cast of the weights is fused in registers. MatmulOp, LinearOp and MmaOp can
+// only be scheduled as matmuls, so their patterns are always kept.
+std::string getGemvRejectReason(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info) {
+  std::vector<mma_utils::MatmulPattern> patterns =
+      mma_utils::findMatmulPatterns(fusion);
+  if (patterns.empty() ||
+      !std::ranges::all_of(patterns, [](const mma_utils::MatmulPattern& p) {
+        return p.output->definition()->isA<ReductionOp>();
+      })) {
+    return "";
+  }
+  IdModel id_model(fusion, /*build_graphs=*/false);
+  id_model.maybeBuildGraph(IdMappingMode::BROADCAST);
+  for (const mma_utils::MatmulPattern& pattern : patterns) {
+    const ProblemShape problem_shape =
+        getProblemShape(pattern.getDimRoles(id_model), runtime_info);
+    if (std::min(
+            problem_shape[(size_t)MatmulDimRole::M],
+            problem_shape[(size_t)MatmulDimRole::N]) > kMaxGemvRows) {
+      return "";
+    }
+  }
+  return "Mul-sum matmuls with M or N of at most " +
+      std::to_string(kMaxGemvRows) + " are scheduled as reductions";
+}
+
 } // anonymous namespace
 
 std::unique_ptr<MatmulParams> getMatmulHeuristics(
@@ -1040,6 +1398,15 @@ std::unique_ptr<MatmulParams> getMatmulHeuristics(
   // Set kernel index mode
   mparams->cparams.index_type = runtime_info.getIndexType();
 
+  // Leave the reserved SMs to the kernels running concurrently
+  if (const std::optional<const int64_t> reserved_sms =
+          fusion->getManagedSafe<int64_t>(kReservedSMsKey);
+      reserved_sms.has_value() && *reserved_sms > 0) {
+    const int64_t num_sms =
+        at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
+    mparams->sm_budget = std::max(num_sms - *reserved_sms, (int64_t)1);
+  }
+
   // Check initial conditions
   std::vector<mma_utils::MatmulPattern> patterns =
       mma_utils::findMatmulPatterns(fusion);
@@ -1085,7 +1452,7 @@ std::unique_ptr<MatmulParams> getMatmulHeuristics(
       tensor_roles,
       // TODO: this assumes all patterns will lie in the same main loop, which
       // might be false
-      /*num_problems=*/patterns.size());
+      patterns);
   NVF_ERROR(status, "Initialization of core part of heuristics failed.");
 
   if (matmul_heuristic_plugin::hasPlugin()) {
@@ -1114,8 +1481,8 @@ std::unique_ptr<MatmulParams> getMatmulHeuristics(
       // and non-persistent after the plugin runs and this changes the launch
       // grid.
       // TODO: respect the cluster size given by plugin
-      if (mparams->tiling_strategy !=
-              MatmulParams::TilingStrategy::OneTilePerCTA ||
+      if (mparams->tiling_strategy ==
+              MatmulParams::TilingStrategy::DistributeTilesAcrossSMs ||
           computeHopperBIDxTiles(mparams.get(), problem_shape) % 2 == 0) {
         mparams->cluster_dims = {2, 1, 1};
       } else {
@@ -1132,10 +1499,9 @@ std::unique_ptr<MatmulParams> getMatmulHeuristics(
         "NVFUSER_MATMUL_HEURISTIC_PLUGIN=/path/to/libmatmulheuristic.so");
   }
 
-  if (isHopper(mparams->mma_macro)) {
-    // Always maximize stages on hopper, for both default heuristic and plugin
-    maximizeHopperOperandStages(
-        mparams.get(), tensor_roles, /*num_problems=*/(size_t)patterns.size());
+  if (isHopper(mparams->mma_macro) || isBlackwell(mparams->mma_macro)) {
+    // Always maximize stages on hopper+, for both default heuristic and plugin
+    maximizeHopperOperandStages(mparams.get(), tensor_roles, patterns);
   }
 
   // Ensure that entire pipeline is filled for shared memory operands given
@@ -1145,7 +1511,7 @@ std::unique_ptr<MatmulParams> getMatmulHeuristics(
   mparams->circular_buffer_options.circular_buffer_smem_write =
       mparams->circular_buffer_options.smem_circular_buffer_stage > 1;
   mparams->circular_buffer_options.circular_buffer_smem_read = false;
-  if (isHopper(mparams->mma_macro) &&
+  if ((isHopper(mparams->mma_macro) || isBlackwell(mparams->mma_macro)) &&
       mparams->circular_buffer_options.smem_circular_buffer_stage > 1) {
     mparams->circular_buffering_strategy =
         MatmulParams::CircularBufferingStrategy::WarpSpecialized;
@@ -1206,6 +1572,8 @@ std::unique_ptr<MatmulParams> getMatmulHeuristics(
     // mparams->cparams.index_type = PrimDataType::Int32;
   }
 
+  fitSMBudgetToWaves(mparams.get(), problem_shape);
+
   if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
     debug() << mparams->toString() << std::endl;
   }
@@ -1257,23 +1625,28 @@ std::string getMatmulCompileTimeRejectReason(Fusion* fusion) {
     for (const mma_utils::MatmulPattern& pattern : patterns) {
       Expr* op = pattern.output->definition();
       if (device_prop->major >= 9) {
+        // Pointwise prologues are computed between the TMA load and the MMA
+        // on Hopper. Otherwise, the prologue must be skipped by the TMA load.
+        const bool fuse_prologue = device_prop->major == 9 &&
+            isOptionEnabled(EnableOption::FuseMatmulPrologue);
         for (TensorView* operand : {pattern.A, pattern.B}) {
-          // Check that the prologue is trivial
-          TensorView* tv = operand;
-          while (!tv->isFusionInput()) {
-            Expr* def = tv->definition();
-            NVF_ERROR(
-                def != nullptr,
-                "Unexpected undefined tensor ",
-                tv->toString(),
-                " which is not a fusion input");
-            if (!def->isOneOf<LoadStoreOp, BroadcastOp, SqueezeOp>()) {
-              return "Operand " + operand->toString() +
-                  " must have only trivial prologue ops (set, broadcast, "
-                  "squeeze) but found " +
-                  def->toString();
+          for (Expr* def : StmtSort::getExprsTo({operand})) {
+            if (def->isOneOf<LoadStoreOp, BroadcastOp, SqueezeOp>() ||
+                (fuse_prologue &&
+                 def->isOneOf<
+                     UnaryOp,
+                     BinaryOp,
+                     TernaryOp,
+                     ExpandOp,
+                     ViewOp>())) {
+              continue;
             }
-            tv = ir_utils::getTvInput(def);
+            return "Operand " + operand->toString() +
+                (fuse_prologue
+                     ? " must have only pointwise prologue ops but found "
+                     : " must have only trivial prologue ops (set, broadcast, "
+                       "squeeze) but found ") +
+                def->toString();
           }
         }
         if (op->isA<ReductionOp>()) {
@@ -1357,17 +1730,18 @@ std::string getMatmulRunTimeRejectReason(
     Fusion* fusion,
     HeuristicDataCache* data_cache,
     SchedulerRuntimeInfo& runtime_info) {
-  // On Hopper, we use TMA to load operands. Since TMA requires each coordinate
-  // of the input to be represented with a 32-bit signed int, we will encounter
-  // overflow if any dimension of an operand is larger than that.
+  // On Hopper+, we use TMA to load operands. Since TMA requires each
+  // coordinate of the input to be represented with a 32-bit signed int, we will
+  // encounter overflow if any dimension of an operand is larger than that.
   const auto device_prop = at::cuda::getCurrentDeviceProperties();
-  if (device_prop->major == 9) {
+  if (device_prop->major >= 9) {
     for (Val* inp : fusion->inputs()) {
       if (auto* tv = dynamic_cast<TensorView*>(inp)) {
         for (int64_t extent : runtime_info.getInputAllocationSizes(tv)) {
           if (extent >= (1L << 31)) {
             std::stringstream ss;
-            ss << "Cannot schedule Hopper matmul with dims larger than 2^31-1, "
+            ss << "Cannot schedule Hopper+ matmul with dims larger than "
+                  "2^31-1, "
                   "but found "
                << extent;
             return ss.str();
@@ -1376,7 +1750,7 @@ std::string getMatmulRunTimeRejectReason(
       }
     }
   }
-  return "";
+  return getGemvRejectReason(fusion, runtime_info);
 }
 
 bool isCpAsyncOperandLoadSupported(
@@ -17,6 +17,21 @@ class HeuristicDataCache;
 class MatmulParams;
 
 namespace matmul_utils {
+//! Name of the Fusion-managed int64_t holding the number of SMs to leave to
+//! the kernels that run concurrently with the matmuls of the Fusion, e.g.,
+//! HostIrEvaluatorParams::num_communication_sms. getMatmulHeuristics turns it
+//! into MatmulParams::sm_budget.
+constexpr const char* kReservedSMsKey = "reserved_sms";
+
+//! Mul-sum matmuls whose M or N is at most this size, e.g., the
+//! matrix-vector products of small-batch inference, are rejected at runtime by
+//! the matmul scheduler and computed as GEMVs by the reduction scheduler.
+constexpr int64_t kMaxGemvRows = 8;
+
+//! Returns the number of SMs the kernel is scheduled for, i.e.,
+//! mparams->sm_budget if set and the SM count of the device otherwise.
+int64_t numSMs(const MatmulParams* mparams);
+
 //! An implementation of functionality that will prepare heuristics for fusion
 //!  that represents matmul. May return empty object if any of conditions are
 //!  not met.
@@ -6,8 +6,12 @@
  */
 // clang-format on
 #include <instrumentation.h>
+#include <options.h>
+#include <scheduler/autotune.h>
 #include <scheduler/debug_utils.h>
+#include <scheduler/heuristic_plugin.h>
 #include <scheduler/normalization_inner.h>
+#include <scheduler/normalization_inner_tma_ws.h>
 #include <scheduler/normalization_utils.h>
 #include <scheduler/reduction_utils.h>
 #include <scheduler/registry_utils.h>
@@ -69,6 +73,44 @@ std::pair<int64_t, int64_t> getPersistentBufferSize(
       persistent_buffer_size, available_persistent_buffer_size);
 }
 
+// Returns the number of blocks of a thread block cluster that each row of the
+// persistent buffers is split across: 1 if a single block can hold the row, or
+// 0 if not even the largest portable cluster can. The blocks of a cluster
+// exchange their partial reductions through distributed shared memory, see
+// EnableOption::ClusterReduction.
+int64_t getPersistentClusterSize(
+    Fusion* fusion,
+    const int64_t total_reduction_numel,
+    const int64_t inner_most_dimension_numel,
+    const int64_t persistent_buffer_size,
+    const int64_t available_persistent_buffer_size) {
+  if (persistent_buffer_size <= available_persistent_buffer_size) {
+    return 1;
+  }
+  if (!isOptionEnabled(EnableOption::ClusterReduction) ||
+      at::cuda::getCurrentDeviceProperties()->major < 9 ||
+      total_reduction_numel != inner_most_dimension_numel) {
+    return 0;
+  }
+  // Only ReductionOp is lowered to cluster reductions
+  if (ir_utils::hasOpsOfType<WelfordOp, GroupedReductionOp>(fusion)) {
+    return 0;
+  }
+  // Largest portable cluster size
+  constexpr int64_t max_cluster_size = 8;
+  for (int64_t cluster_size = 2; cluster_size <= max_cluster_size;
+       cluster_size *= 2) {
+    if (inner_most_dimension_numel % cluster_size != 0) {
+      return 0;
+    }
+    if (ceilDiv(persistent_buffer_size, cluster_size) <=
+        available_persistent_buffer_size) {
+      return cluster_size;
+    }
+  }
+  return 0;
+}
+
 // Return the maximum register count each thread can use and achieved occupancy.
 // We always guarantee the returned register count is at least as large as the
 // buffer+overhead estimate. We meet the desired occupancy but don't try to
@@ -1052,6 +1094,62 @@ void innerPersistentHeuristic3D(
       LaunchParams::UNINITIALIZED_VAL);
 }
 
+// Splits each row across the blocks of a thread block cluster, which hold
+// their part of the persistent buffers in registers or shared memory as
+// chosen by the heuristics of a single block for a row of
+// inner_most_dimension_numel / cluster_size elements. The iteration domain
+// moves to BIDy since BIDx is the cluster.
+void innerPersistentHeuristicCluster(
+    const PersistentKernelProperties& properties,
+    const int64_t cluster_size,
+    ReductionParams* rparams) {
+  PersistentKernelProperties block_properties = properties;
+  block_properties.inner_most_dimension_numel /= cluster_size;
+  block_properties.total_reduction_numel /= cluster_size;
+  block_properties.max_persistent_buffer_size =
+      ceilDiv(properties.max_persistent_buffer_size, cluster_size);
+  while (block_properties.inner_most_dimension_numel %
+             block_properties.vectorize_factor !=
+         0) {
+    block_properties.vectorize_factor /= 2;
+  }
+
+  if (block_properties.max_persistent_buffer_size >
+      scheduler_utils::register_file_size) {
+    rparams->smem_persistent_buffers = properties.persistent_buffers;
+    innerPersistentHeuristicSharedMemory(block_properties, rparams);
+  } else {
+    innerPersistentHeuristic2D(block_properties, rparams);
+  }
+
+  rparams->cross_grid_inner_reduction = true;
+  rparams->grid_dim_inner_reduction = ParallelType::BIDx;
+  rparams->cluster_inner_reduction = true;
+
+  const int64_t bdimy = rparams->lparams.getRawVal(ParallelType::TIDy);
+  const int64_t godim = ceilDiv(
+      properties.total_iteration_numel,
+      rparams->multiple_reds_per_blk ? bdimy : 1);
+  int64_t gdimy = LaunchParams::UNINITIALIZED_VAL;
+  rparams->grid_dim_iter_dom = ParallelType::Serial;
+  rparams->split_grid_dim_iter_dom_outer = false;
+  if (godim > 1) {
+    rparams->grid_dim_iter_dom = ParallelType::BIDy;
+    if (godim > scheduler_utils::y_grid_limit) {
+      rparams->split_grid_dim_iter_dom_outer = true;
+      gdimy = scheduler_utils::y_grid_limit;
+    }
+  }
+
+  rparams->lparams = LaunchParams(
+      cluster_size,
+      gdimy,
+      LaunchParams::UNINITIALIZED_VAL,
+      LaunchParams::UNINITIALIZED_VAL,
+      bdimy,
+      LaunchParams::UNINITIALIZED_VAL);
+}
+
 std::unique_ptr<ReductionParams> getInnerPersistentHeuristics(
     Fusion* fusion,
     SchedulerRuntimeInfo& runtime_info,
@@ -1075,8 +1173,37 @@ std::unique_ptr<ReductionParams> getInnerPersistentHeuristics(
   rparams->project_persistent_buffers = prop.project_persistent_buffers;
   rparams->cparams.index_type = prop.index_type;
 
+  // Rows whose persistent buffers don't fit in a block are split across a
+  // cluster
+  auto reduction_tv_entry =
+      HeuristicDataCacheEntry<HeuristicCompileTime::ReductionTVs>(
+          data_cache, [&fusion]() {
+            return std::make_unique<std::vector<TensorView*>>(
+                scheduler_utils::getReductionTvs(fusion));
+          });
+  auto& reduction_tvs = reduction_tv_entry.get();
+  const auto [persistent_buffer_size, available_persistent_buffer_size] =
+      getPersistentBufferSize(
+          fusion,
+          runtime_info,
+          data_cache,
+          reduction_tvs,
+          prop.total_reduction_numel == prop.inner_most_dimension_numel);
+  const int64_t cluster_size = getPersistentClusterSize(
+      fusion,
+      prop.total_reduction_numel,
+      prop.inner_most_dimension_numel,
+      persistent_buffer_size,
+      available_persistent_buffer_size);
+
   // specific heuristics for different cases
-  if (prop.max_persistent_buffer_size > scheduler_utils::register_file_size) {
+  if (inner_tma_warp_specialized::canUse(prop)) {
+    inner_tma_warp_specialized::getHeuristics(rparams.get(), prop);
+  } else if (cluster_size > 1) {
+    rparams->tag = "Cluster Inner Persistent Heuristic.\n";
+    innerPersistentHeuristicCluster(prop, cluster_size, rparams.get());
+  } else if (
+      prop.max_persistent_buffer_size > scheduler_utils::register_file_size) {
     rparams->tag = "Shared Memory Inner Persistent Heuristic.\n";
     // all persistent buffers are moved to shared memory
     // TODO: allow only part of the buffers to be moved to shared memory
@@ -1090,6 +1217,14 @@ std::unique_ptr<ReductionParams> getInnerPersistentHeuristics(
     innerPersistentHeuristic3D(prop, rparams.get());
   }
 
+  heuristic_plugin::updateReductionParams(
+      rparams.get(),
+      fusion,
+      runtime_info,
+      prop.reduction_tv,
+      prop.vectorize_factor,
+      prop.max_persistent_buffer_size);
+
   // debug print
   if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
     debug() << prop.toString() << std::endl;
@@ -1141,7 +1276,12 @@ bool InnerPersistentKernelScheduler::canScheduleRunTime(
   const int64_t device_multiprocessor_count =
       (int64_t)at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
 
-  if (persistent_buffer_size > available_persistent_buffer_size) {
+  if (getPersistentClusterSize(
+          fusion,
+          properties.total_reduction_numel,
+          properties.inner_most_dimension_numel,
+          persistent_buffer_size,
+          available_persistent_buffer_size) == 0) {
     scheduler_debug_utils::canScheduleRejectReason(
         schedulerType(),
         can_use_smem_persistent
@@ -1194,9 +1334,25 @@ std::unique_ptr<HeuristicParams> InnerPersistentKernelScheduler::
   FUSER_PERF_SCOPE("InnerPersistentKernelScheduler::computeHeuristics");
   auto rparams = getInnerPersistentHeuristics(fusion, runtime_info, data_cache);
   NVF_ERROR(rparams != nullptr);
+  autotune::applyTunedParams(rparams.get(), fusion, runtime_info);
   return rparams;
 }
 
+cost_model::KernelCost InnerPersistentKernelScheduler::predictCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const HeuristicParams* params,
+    HeuristicDataCache* data_cache) {
+  auto rparams = dynamic_cast<const ReductionParams*>(params);
+  NVF_ERROR(
+      rparams != nullptr,
+      "Incorrect parameters sent to "
+      "InnerPersistentKernelScheduler::predictCost",
+      params);
+  return cost_model::estimatePersistentKernelCost(
+      fusion, runtime_info, rparams, data_cache);
+}
+
 void InnerPersistentKernelScheduler::schedule(
     Fusion* fusion,
     const HeuristicParams* params) {
@@ -1209,7 +1365,18 @@ void InnerPersistentKernelScheduler::schedule(
   NVF_ERROR(
       rparams->scheduler_type ==
       InnerPersistentKernelScheduler::schedulerType());
-  normalization_scheduler_utils::schedulePersistentKernel(
-      fusion, rparams, rparams->scheduler_type);
+  if (rparams->cluster_inner_reduction) {
+    // The blocks sharing a row form a cluster, which lowering detects to
+    // reduce them through distributed shared memory
+    fusion->manage(
+        "cluster_dims",
+        std::tuple<int64_t, int64_t, int64_t>{rparams->lparams.gdimx(), 1, 1});
+  }
+  if (rparams->tma_warp_specialized) {
+    inner_tma_warp_specialized::scheduleFusion(fusion, rparams);
+  } else {
+    normalization_scheduler_utils::schedulePersistentKernel(
+        fusion, rparams, rparams->scheduler_type);
+  }
 }
 } // namespace nvfuser
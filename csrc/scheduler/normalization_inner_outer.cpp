@@ -8,6 +8,7 @@
 #include <instrumentation.h>
 #include <options.h>
 #include <scheduler/debug_utils.h>
+#include <scheduler/heuristic_plugin.h>
 #include <scheduler/normalization_inner_outer_multi_wave.h>
 #include <scheduler/normalization_inner_outer_tma_ws.h>
 #include <scheduler/normalization_inner_outer_utils.h>
@@ -150,6 +151,9 @@ std::unique_ptr<ReductionParams> getInnerOuterPersistentHeuristics(
         runtime_info.getIndexType());
   }
 
+  heuristic_plugin::updateReductionParams(
+      rparams.get(), fusion, runtime_info, ref_red_tv, hp.vectorize_factor);
+
   return rparams;
 }
 
@@ -434,6 +438,21 @@ std::unique_ptr<HeuristicParams> InnerOuterPersistentKernelScheduler::
   return rparams;
 }
 
+cost_model::KernelCost InnerOuterPersistentKernelScheduler::predictCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const HeuristicParams* params,
+    HeuristicDataCache* data_cache) {
+  auto rparams = dynamic_cast<const ReductionParams*>(params);
+  NVF_ERROR(
+      rparams != nullptr,
+      "Incorrect parameters sent to "
+      "InnerOuterPersistentKernelScheduler::predictCost",
+      params);
+  return cost_model::estimatePersistentKernelCost(
+      fusion, runtime_info, rparams, data_cache);
+}
+
 void InnerOuterPersistentKernelScheduler::schedule(
     Fusion* fusion,
     const HeuristicParams* params) {
@@ -46,6 +46,12 @@ class InnerOuterPersistentKernelScheduler : public SchedulerEntry {
       Fusion* fusion,
       SchedulerRuntimeInfo& runtime_info,
       HeuristicDataCache* data_cache) override;
+
+  cost_model::KernelCost predictCost(
+      Fusion* fusion,
+      SchedulerRuntimeInfo& runtime_info,
+      const HeuristicParams* params,
+      HeuristicDataCache* data_cache = nullptr) override;
 };
 
 } // namespace nvfuser
@@ -0,0 +1,362 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <scheduler/normalization_inner_tma_ws.h>
+
+#include <debug.h>
+#include <ir/utils.h>
+#include <options.h>
+#include <scheduler/reduction_utils.h>
+#include <scheduler/tools/inlining.h>
+#include <scheduler/tools/maxinfo_propagator.h>
+#include <scheduler/utils.h>
+#include <transform_replay.h>
+#include <utils.h>
+
+#include <ATen/cuda/CUDAContext.h>
+
+#include <algorithm>
+
+namespace nvfuser {
+namespace inner_tma_warp_specialized {
+
+using PersistentKernelProperties =
+    normalization_scheduler_utils::PersistentKernelProperties;
+
+namespace {
+
+// Circular buffering with a single stage can't overlap the TMA loads with the
+// computation, the register persistent schedule is used instead.
+constexpr int64_t min_stages = 2;
+
+// Number of threads of the computation warp groups
+constexpr int64_t min_computation_threads = 128;
+constexpr int64_t max_computation_threads = 512;
+
+// Shared memory used by a block. It is the sum of
+// (1) The circular buffered persistent buffers, proportional to [iter_unroll]
+//     and [n_stages]
+// (2) The mbarriers, each stage requires 16 bytes for WAR and RAW.
+// (3) The block reduction workspace, proportional to [iter_unroll] and
+//     [bdimx]. It is aligned to 128 bytes since the other shared memory
+//     tensors are stacked on top of it, see assignNextAddress in
+//     StackBasedSharedMemAllocator.
+int64_t sharedMemoryBytes(
+    const PersistentKernelProperties& prop,
+    int64_t iter_unroll,
+    int64_t n_stages,
+    int64_t bdimx) {
+  const int64_t buffer_size =
+      prop.max_persistent_buffer_size * iter_unroll * n_stages;
+  const int64_t mbarrier_size = 16 * n_stages;
+  // Welford reduces the average, the variance and the count together
+  const int64_t n_reduced_values =
+      prop.reduction_tv->definition()->isA<WelfordOp>() ? 3 : 1;
+  const int64_t reduction_workspace_size = roundUpToMultiple(
+      iter_unroll * bdimx * n_reduced_values *
+          dataTypeSizeByte(prop.reduction_tv->getDataType().value()),
+      128);
+  return buffer_size + mbarrier_size + reduction_workspace_size;
+}
+
+bool isEnoughSmem(
+    const PersistentKernelProperties& prop,
+    int64_t iter_unroll,
+    int64_t n_stages,
+    int64_t bdimx) {
+  return (int64_t)at::cuda::getCurrentDeviceProperties()
+             ->sharedMemPerBlockOptin >=
+      sharedMemoryBytes(prop, iter_unroll, n_stages, bdimx);
+}
+
+// The computation threads copy the rows of the circular buffered tensors from
+// shared memory to registers before releasing the shared memory to the next
+// TMA load. The copy may take more registers than the shared memory buffer
+// when the persistent batch doesn't divide the row.
+bool isEnoughRegs(
+    const PersistentKernelProperties& prop,
+    int64_t iter_unroll,
+    int64_t bdimx) {
+  const int64_t after_vect =
+      prop.inner_most_dimension_numel / prop.vectorize_factor;
+  const int64_t buffer_bytes_per_element =
+      prop.max_persistent_buffer_size / prop.inner_most_dimension_numel;
+  const int64_t elements_per_thread =
+      ceilDiv(after_vect, bdimx) * prop.vectorize_factor * iter_unroll;
+  const int64_t reg_count =
+      buffer_bytes_per_element * elements_per_thread /
+          scheduler_utils::bytes_per_register +
+      scheduler_utils::register_overhead;
+  return reg_count <= scheduler_utils::max_registers_per_thread;
+}
+
+} // namespace
+
+bool canUse(const PersistentKernelProperties& prop) {
+  if (!isOptionEnabled(EnableOption::WarpSpecializedNormalization) ||
+      at::cuda::getCurrentDeviceProperties()->major < 9) {
+    return false;
+  }
+  // The persistent buffers are loaded with 1D TMA, so they must be inputs
+  // whose rows are contiguous and 16-byte aligned, which the vectorization
+  // factor implies.
+  if (prop.total_reduction_numel != prop.inner_most_dimension_numel ||
+      prop.persistent_buffers.empty()) {
+    return false;
+  }
+  for (TensorView* tv : prop.persistent_buffers) {
+    const int64_t vect_bytes =
+        prop.vectorize_factor * dataTypeSizeByte(tv->getDataType().value());
+    if (!tv->isFusionInput() || vect_bytes % 16 != 0) {
+      return false;
+    }
+  }
+  return isEnoughSmem(prop, 1, min_stages, min_computation_threads) &&
+      isEnoughRegs(prop, 1, max_computation_threads);
+}
+
+void getHeuristics(
+    ReductionParams* rparams,
+    const PersistentKernelProperties& prop) {
+  const auto dev_prop = at::cuda::getCurrentDeviceProperties();
+  const int64_t sm_count = (int64_t)dev_prop->multiProcessorCount;
+  const int64_t vect_factor = prop.vectorize_factor;
+  const int64_t after_vect = prop.inner_most_dimension_numel / vect_factor;
+  const int64_t outer_dim_numel = prop.total_iteration_numel;
+
+  // bdimx: number of computation threads, only increased when each thread
+  // holds too many elements in registers.
+  int64_t bdimx = min_computation_threads;
+  while (!isEnoughRegs(prop, 1, bdimx) &&
+         bdimx * 2 <= max_computation_threads &&
+         isEnoughSmem(prop, 1, min_stages, bdimx * 2)) {
+    bdimx *= 2;
+  }
+  // iter_unroll: rows grouped together in a TMA load and the reduction.
+  int64_t iter_unroll = 1;
+  // n_stages: circular buffer stages, more stages than rows processed by each
+  // block don't add any overlap.
+  int64_t n_stages = min_stages;
+  NVF_ERROR(
+      isEnoughSmem(prop, iter_unroll, n_stages, bdimx),
+      "Not enough shared memory for TMA warp specialized.");
+  const int64_t rows_per_block = ceilDiv(outer_dim_numel, sm_count);
+  // Try to update paras in each loop and break if no update is made.
+  while (true) {
+    bool is_updated = false;
+    if (n_stages * 2 * iter_unroll <= rows_per_block &&
+        isEnoughSmem(prop, iter_unroll, n_stages * 2, bdimx)) {
+      is_updated = true;
+      n_stages *= 2;
+    }
+    // iter_unroll should be divisible by outer_dim_numel due to limitation of
+    // 1D TMA predicate.
+    if (n_stages * iter_unroll * 2 <= rows_per_block &&
+        outer_dim_numel % (iter_unroll * 2) == 0 &&
+        isEnoughSmem(prop, iter_unroll * 2, n_stages, bdimx) &&
+        isEnoughRegs(prop, iter_unroll * 2, bdimx)) {
+      is_updated = true;
+      iter_unroll *= 2;
+    }
+    if (!is_updated) {
+      break;
+    }
+  }
+  const int64_t inner_batch = ceilDiv(after_vect, bdimx);
+  const int64_t gdimy =
+      std::min(sm_count, ceilDiv(outer_dim_numel, iter_unroll));
+
+  // Non Warp Specialized dim can't have more than 128 threads, see
+  // normalization_inner_outer_tma_ws.cpp.
+  ParallelType ws_pt = bdimx > 128 ? ParallelType::TIDx : ParallelType::TIDy;
+  WarpSpecialized ws(ws_pt);
+  const int64_t total_threads = kWarpSpecializationPaddedThreads + bdimx;
+  if (total_threads > 256) {
+    // Keep [tma_branch_registers] registers for the padded threads and move
+    // the others to the computation threads, with a granularity of 8.
+    const int64_t reg_per_thread =
+        getRegPerThreadGivenThreadsPerSM(total_threads);
+    const int64_t tma_branch_registers = 32;
+    const int64_t compute_branch_registers = scheduler_utils::roundDownToN(
+        reg_per_thread +
+            (reg_per_thread - tma_branch_registers) *
+                kWarpSpecializationPaddedThreads / bdimx,
+        8);
+    ws.num_registers =
+        std::make_pair(tma_branch_registers, compute_branch_registers);
+  }
+  rparams->circular_buffer_options = CircularBufferOptions{
+      .type = ws, .stage = n_stages, .prefetch = n_stages - 1};
+
+  rparams->tma_warp_specialized = true;
+  rparams->persistent_kernel = true;
+  rparams->fastest_dim = true;
+  rparams->smem_persistent_buffers = prop.persistent_buffers;
+  rparams->unroll_factor_iter_dom = iter_unroll;
+  rparams->unroll_factor_inner_reduction = vect_factor;
+  rparams->vectorize_inner_reduction = vect_factor > 1;
+  rparams->batches_per_block_inner_reduction = inner_batch;
+  rparams->block_dim_inner_reduction = ParallelType::TIDx;
+  rparams->pad_inner_reduction_to_warp = true;
+  rparams->split_grid_dim_iter_dom_outer = true;
+  rparams->grid_dim_iter_dom = ParallelType::BIDy;
+  rparams->is_non_circular_buffer_gmem_to_regs = true;
+  rparams->is_circular_buffer_regs_cached = true;
+
+  rparams->lparams = LaunchParams(
+      LaunchParams::UNINITIALIZED_VAL,
+      gdimy,
+      LaunchParams::UNINITIALIZED_VAL,
+      ws_pt == ParallelType::TIDx ? bdimx + kWarpSpecializationPaddedThreads
+                                  : bdimx,
+      LaunchParams::UNINITIALIZED_VAL,
+      LaunchParams::UNINITIALIZED_VAL);
+
+  rparams->tag = "TMA Warp Specialized Inner Persistent Heuristic.\n";
+
+  if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
+    debug() << "\n===== TMA Warp Specialized Inner Persistent Stats ========\n"
+            << "outer_dim_numel: " << outer_dim_numel << "\n"
+            << "inner_dim_numel: " << prop.inner_most_dimension_numel << "\n"
+            << "smem_bytes: "
+            << sharedMemoryBytes(prop, iter_unroll, n_stages, bdimx) << "\n"
+            << "bdimx: " << bdimx << "\n"
+            << "gdimy: " << gdimy << "\n";
+  }
+}
+
+void scheduleFusion(Fusion* fusion, const ReductionParams* rparams) {
+  FusionGuard fg(fusion);
+
+  // Grab the reduction, input, and output tensor views. dummy_outputs are
+  // helper tensors for persistent buffer projection.
+  std::vector<TensorView*> dummy_outputs, cached_inputs, reduction_tvs,
+      smem_consumers;
+  std::vector<std::pair<TensorView*, TensorView*>> cached_outputs;
+  normalization_scheduler_utils::beforeSchedule(
+      fusion,
+      rparams,
+      dummy_outputs,
+      cached_inputs,
+      reduction_tvs,
+      smem_consumers,
+      cached_outputs);
+
+  TensorView* reference_tv =
+      normalization_scheduler_utils::scheduleReductionGeneral(
+          fusion, rparams, reduction_tvs, SchedulerType::InnerPersistent);
+  NVF_ERROR(
+      reference_tv != nullptr && reduction_tvs[0] != nullptr,
+      "Need these two tensor views to finish the scheduling.");
+
+  for (auto output : dummy_outputs) {
+    fusion->addOutput(output);
+  }
+
+  // Collect tvs loaded with TMA, they require special scheduling.
+  std::vector<TensorView*> tma_load_tvs;
+  for (auto tv : smem_consumers) {
+    auto smem_tv = ir_utils::getSoleProducerTv(tv);
+    if (std::find(tma_load_tvs.begin(), tma_load_tvs.end(), smem_tv) ==
+        tma_load_tvs.end()) {
+      tma_load_tvs.emplace_back(smem_tv);
+    }
+  }
+
+  const bool is_unroll_or_vectorization = rparams->isUnrolled();
+  const bool is_vectorize = rparams->vectorize_inner_reduction;
+  const bool group_inner_reduction = rparams->unroll_factor_iter_dom > 1;
+
+  // Propagate transformations in two steps since the TMA tvs only follow the
+  // iteration domain of the reference.
+  // Step-1, propagate iteration domain to all tvs.
+  int64_t first_redu_axis = -1;
+  for (int64_t i = 0; i < (int64_t)reference_tv->nDims(); i++) {
+    if (reference_tv->axis(i)->isReduction() ||
+        reference_tv->axis(i)->isRFactorProduct()) {
+      first_redu_axis = i;
+      break;
+    }
+  }
+  if (first_redu_axis > 0) {
+    TransformPropagator propagator(reference_tv, first_redu_axis - 1);
+    MaxLogicalDomainInfoSpanningTree(reference_tv).traverse(&propagator);
+  }
+  // Step-2, propagate reduction domain to all tvs except the TMA tvs.
+  {
+    TransformPropagator propagator(reference_tv);
+    std::vector<TensorView*> all_tvs_except_tma = ir_utils::allTvsExcept(
+        fusion, {tma_load_tvs.begin(), tma_load_tvs.end()});
+    SetSelector selector(
+        {all_tvs_except_tma.begin(), all_tvs_except_tma.end()});
+    MaxLogicalDomainInfoSpanningTree(reference_tv, &selector)
+        .traverse(&propagator);
+  }
+  if (reference_tv != reduction_tvs[0]) {
+    reduction_scheduler_utils::propagateRFactor(
+        reference_tv, reduction_tvs[0], reduction_tvs);
+  }
+
+  const auto& unroll_vectorizable_cached_tvs =
+      reduction_scheduler_utils::getCachedTvsToUnrollOrVectorize(
+          reference_tv, is_vectorize, cached_inputs, cached_outputs);
+  reduction_scheduler_utils::propagateParallelization(
+      reduction_tvs[0],
+      reference_tv,
+      is_unroll_or_vectorization,
+      group_inner_reduction,
+      reduction_tvs,
+      unroll_vectorizable_cached_tvs);
+
+  // The inner dimension of the TMA tvs is not split, 1D TMA loads the whole
+  // row: [I/Unroll/BIDy, BIDy, Unroll | Bulk]
+  for (auto tv : tma_load_tvs) {
+    tv->axis(-1)->parallelize(ParallelType::Bulk);
+  }
+
+  // Needs special handling of vectorized loading from shared memory due to
+  // potential different data types of inputs and shared memory tensor.
+  if (is_vectorize) {
+    reduction_scheduler_utils::sharedMemoryConsumerVectorization(
+        smem_consumers, rparams->unroll_factor_inner_reduction);
+  }
+
+  // Remove dummy outputs as they can inadvertently affect CA positions
+  for (auto output : dummy_outputs) {
+    fusion->removeOutput(output);
+  }
+
+  // Inline the TMA tvs and their register caches after BIDy, so all the
+  // unrolled rows share the same barrier and the shared memory is released
+  // as soon as it is copied to registers.
+  constexpr int64_t tma_inline_pos = 2;
+  std::unordered_set<TensorView*> exclude_tvs;
+  for (auto tv : tma_load_tvs) {
+    if (tv->nDims() >= tma_inline_pos + 1) {
+      exclude_tvs.insert(tv);
+      inlineSelectedAt({tv}, tv, tma_inline_pos);
+    }
+  }
+  for (auto tv : smem_consumers) {
+    if (ir_utils::getSoleProducerTv(tv)->nDims() >= tma_inline_pos + 1) {
+      exclude_tvs.insert(tv);
+      inlineSelectedAt({tv}, tv, tma_inline_pos);
+    }
+  }
+  inlineMost(ir_utils::allTvsExcept(fusion, exclude_tvs));
+
+  const CircularBufferOptions& options = rparams->circular_buffer_options;
+  for (auto tv : tma_load_tvs) {
+    // Circular buffer requires a loop to circulate on
+    if (tv->getComputeAtPosition() > 0) {
+      tv->circularBuffer(options.stage, options.prefetch, options.type);
+    }
+  }
+}
+
+} // namespace inner_tma_warp_specialized
+} // namespace nvfuser
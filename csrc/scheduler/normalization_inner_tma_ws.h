@@ -0,0 +1,39 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <fusion.h>
+#include <scheduler/normalization_utils.h>
+#include <scheduler/reduction_heuristic.h>
+
+namespace nvfuser {
+
+//! TMA warp specialized schedule of the inner persistent scheduler, enabled by
+//! EnableOption::WarpSpecializedNormalization on Hopper and newer.
+//!
+//! Each block loops over rows in a grid-stride fashion. The persistent buffers,
+//! which must be fusion inputs, are loaded to shared memory with 1D TMA by a
+//! dedicated producer warp group and circular buffered across rows. The
+//! computation warp groups copy each row to registers, release the shared
+//! memory to the next TMA load, and do the normalization. The reduction
+//! tensor is scheduled as:
+//!   [I/Unroll/BIDy, BIDy, Unroll | Persistent, TIDx, Vect]
+namespace inner_tma_warp_specialized {
+
+//! Returns true if the fusion described by prop can use this schedule
+bool canUse(
+    const normalization_scheduler_utils::PersistentKernelProperties& prop);
+
+void getHeuristics(
+    ReductionParams* rparams,
+    const normalization_scheduler_utils::PersistentKernelProperties& prop);
+
+void scheduleFusion(Fusion* fusion, const ReductionParams* rparams);
+
+} // namespace inner_tma_warp_specialized
+} // namespace nvfuser
@@ -8,6 +8,7 @@
 #include <instrumentation.h>
 #include <scheduler/cache_policy_refiner.h>
 #include <scheduler/debug_utils.h>
+#include <scheduler/heuristic_plugin.h>
 #include <scheduler/normalization_outer.h>
 #include <scheduler/normalization_utils.h>
 #include <scheduler/reduction_utils.h>
@@ -432,6 +433,13 @@ std::unique_ptr<ReductionParams> getOuterPersistentHeuristics(
       prop.vectorize_factor,
       prop.project_persistent_buffers,
       prop.index_type);
+  heuristic_plugin::updateReductionParams(
+      rparams.get(),
+      fusion,
+      runtime_info,
+      prop.reduction_tv,
+      prop.vectorize_factor,
+      prop.max_persistent_buffer_size);
   return rparams;
 }
 
@@ -665,6 +673,21 @@ std::unique_ptr<HeuristicParams> OuterPersistentKernelScheduler::
   return rparams;
 }
 
+cost_model::KernelCost OuterPersistentKernelScheduler::predictCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const HeuristicParams* params,
+    HeuristicDataCache* data_cache) {
+  auto rparams = dynamic_cast<const ReductionParams*>(params);
+  NVF_ERROR(
+      rparams != nullptr,
+      "Incorrect parameters sent to "
+      "OuterPersistentKernelScheduler::predictCost",
+      params);
+  return cost_model::estimatePersistentKernelCost(
+      fusion, runtime_info, rparams, data_cache);
+}
+
 void OuterPersistentKernelScheduler::schedule(
     Fusion* fusion,
     const HeuristicParams* params) {
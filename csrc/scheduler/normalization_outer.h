@@ -39,6 +39,12 @@ class OuterPersistentKernelScheduler : public SchedulerEntry {
       SchedulerRuntimeInfo& runtime_info,
       HeuristicDataCache* data_cache) override;
 
+  cost_model::KernelCost predictCost(
+      Fusion* fusion,
+      SchedulerRuntimeInfo& runtime_info,
+      const HeuristicParams* params,
+      HeuristicDataCache* data_cache = nullptr) override;
+
   void schedule(Fusion* fusion, const HeuristicParams* params) override;
 
   constexpr static SchedulerType schedulerType() {
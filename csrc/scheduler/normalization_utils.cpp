@@ -1097,7 +1097,8 @@ PersistentKernelProperties getPersistentKernelProperties(
       .has_exp_op = has_exp_op,
       .has_rng_op = has_rng_op,
       .disable_project_to_avoid_recompute = disable_project_to_avoid_recompute,
-      .persistent_buffers = buffers};
+      .persistent_buffers = buffers,
+      .reduction_tv = ref_red_tv};
 }
 
 bool checkOpsAndInputs(Fusion* fusion, SchedulerType scheduler_type) {
@@ -1533,6 +1534,19 @@ TensorView* scheduleReductionGeneral(
     groupReductions(reduction_tvs, false);
   }
 
+  // Independent block reductions of the same type are reduced by a single
+  // grouped block or warp reduction. Shared memory persistence is skipped
+  // since its budget only accounts for the workspace of a single reduction.
+  if (scheduler_type == SchedulerType::InnerPersistent &&
+      !rparams->cross_grid_inner_reduction && !rparams->tma_warp_specialized &&
+      rparams->smem_persistent_buffers.empty() && reduction_tvs.size() > 1 &&
+      std::all_of(
+          reduction_tvs.begin(), reduction_tvs.end(), [&](TensorView* tv) {
+            return tv->dtype() == reduction_tv->dtype();
+          })) {
+    groupReductions(reduction_tvs, false);
+  }
+
   auto dim_analysis = scheduler_utils::canonicalDimReduction(
       fusion, reduction_tv, rparams->fastest_dim && rparams->schedule_3D);
   bool has_iter_axis = dim_analysis.first;
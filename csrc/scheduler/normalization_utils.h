@@ -223,6 +223,8 @@ struct PersistentKernelProperties {
   bool has_rng_op;
   bool disable_project_to_avoid_recompute;
   std::vector<TensorView*> persistent_buffers;
+  // Reference reduction tensor the properties are computed from
+  TensorView* reduction_tv = nullptr;
   std::string toString() const {
     std::stringstream ss;
     ss << "===== Persistent Kernel Properties ========\n"
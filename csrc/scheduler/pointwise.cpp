@@ -11,10 +11,14 @@
 #include <instrumentation.h>
 #include <ir/printer.h>
 #include <multidevice/utils.h>
+#include <options.h>
+#include <scheduler/autotune.h>
 #include <scheduler/cache_policy_refiner.h>
 #include <scheduler/debug_utils.h>
+#include <scheduler/heuristic_plugin.h>
 #include <scheduler/mark_aliases.h>
 #include <scheduler/pointwise.h>
+#include <scheduler/pointwise_tma.h>
 #include <scheduler/reduction_utils.h>
 #include <scheduler/registry_utils.h>
 #include <scheduler/runtime_info.h>
@@ -172,6 +176,112 @@ int64_t getUnrollFactor(
   }
 }
 
+// Returns the break point right after the reference dimension along which an
+// index_select gathers whole rows of its lookup tensor, e.g., an embedding
+// lookup, or 0 if there is no such dimension. Breaking there maps the threads
+// of a block to the contiguous copy of the rows, which is vectorized, and
+// loads each index once per row instead of once per element.
+int64_t getRowGatherBreakPoint(
+    Fusion* fusion,
+    const ComputeAtMap& ca_map,
+    const std::vector<IterDomain*>& ref_loop) {
+  for (auto idx_sel : ir_utils::getOpsOfType<IndexSelectOp>(fusion)) {
+    const auto lookup_logical =
+        TensorDomain::noReductions(idx_sel->lookupTv()->getLogicalDomain());
+    if (idx_sel->dim() + 1 >= std::ssize(lookup_logical)) {
+      // Gathering along the innermost dimension doesn't read whole rows
+      continue;
+    }
+    for (const auto i : arange(std::ssize(ref_loop) - 1)) {
+      if (ca_map.areMapped(
+              ref_loop.at(i),
+              idx_sel->getConsumerOfIndexedID(),
+              IdMappingMode::EXACT)) {
+        return i + 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Widens the vectorization of the loop past the factor supported by every
+// vectorizable input and output, up to the factor supported by any of them,
+// with max_vect_bytes per access. The tensors supporting a smaller factor
+// keep theirs, see PointwiseParams::input_vectorization_factors, and the
+// unroll factors shrink so that each thread moves as many bytes as before.
+void setVectorizationFactorsOfTensors(
+    PointwiseParams* params,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* largest_out,
+    HeuristicDataCache* data_cache,
+    const std::unordered_map<int64_t, int64_t>& reorder_map,
+    int64_t max_vect_bytes) {
+  const auto factors = vectorize_helper::getVectorizationFactorsOfTensors(
+      runtime_info, largest_out, data_cache, params->break_point, reorder_map);
+  const PrimDataType index_type = runtime_info.getIndexType();
+  auto max_factor_of = [&](TensorView* tv) {
+    return std::min(
+        factors.at(tv),
+        scheduler_utils::lastPow2(std::max(
+            max_vect_bytes / dataTypeSizeByte(tv->dtype(), index_type),
+            (int64_t)1)));
+  };
+
+  int64_t loop_factor = params->vectorization_factor;
+  for (const auto& [tv, factor] : factors) {
+    loop_factor = std::max(loop_factor, max_factor_of(tv));
+  }
+  if (loop_factor == params->vectorization_factor) {
+    return;
+  }
+
+  // Tensors that aren't vectorized don't need a factor of their own
+  auto factor_of = [&](Val* val) {
+    auto tv = dynamic_cast<TensorView*>(val);
+    return tv != nullptr && factors.count(tv)
+        ? std::min(max_factor_of(tv), loop_factor)
+        : loop_factor;
+  };
+  params->input_vectorization_factors.clear();
+  for (Val* inp : fusion->inputs()) {
+    params->input_vectorization_factors.push_back(factor_of(inp));
+  }
+  params->output_vectorization_factors.clear();
+  for (Val* out : fusion->outputs()) {
+    params->output_vectorization_factors.push_back(factor_of(out));
+  }
+
+  const int64_t growth = loop_factor / params->vectorization_factor;
+  params->vectorization_factor = loop_factor;
+  params->unroll_factor_inner =
+      std::max(params->unroll_factor_inner / growth, (int64_t)1);
+  params->unroll_factor_outer =
+      std::max(params->unroll_factor_outer / growth, (int64_t)1);
+}
+
+// Splits the vectorized axis of tv into a serial loop over vectorized
+// accesses of factor elements, when factor is smaller than the vectorization
+// factor of the loop.
+void narrowVectorization(TensorView* tv, int64_t factor, int64_t loop_factor) {
+  if (factor >= loop_factor) {
+    return;
+  }
+  const auto& loop = tv->getLoopDomain();
+  auto it = std::find_if(loop.begin(), loop.end(), [](IterDomain* id) {
+    return id->getParallelType() == ParallelType::Vectorize;
+  });
+  if (it == loop.end()) {
+    return;
+  }
+  const int64_t pos = std::distance(loop.begin(), it);
+  tv->axis(pos)->parallelize(ParallelType::Serial);
+  if (factor > 1) {
+    tv->split(pos, factor);
+    tv->axis(pos + 1)->parallelize(ParallelType::Vectorize);
+  }
+}
+
 } // namespace
 
 std::unique_ptr<PointwiseParams> getPointwiseHeuristics(
@@ -235,13 +345,14 @@ std::unique_ptr<PointwiseParams> getPointwiseHeuristics(
   std::vector<int64_t> elem_counts(ref_loop.size(), 1);
   int64_t n_elems = 1;
   for (size_t ref_i = 0; ref_i < ref_loop.size(); ref_i++) {
-    auto inferred_val =
-        runtime_info.expressionEvaluator().evaluate(ref_loop[ref_i]->extent());
+    std::optional<int64_t> inferred_val =
+        runtime_info.expressionEvaluator().evaluateInt64(
+            ref_loop[ref_i]->extent());
     NVF_ERROR(
-        inferred_val.hasValue(),
+        inferred_val.has_value(),
         "Error inferring size for pointwise scheduler: ",
         ref_loop[ref_i]->extent()->toInlineString());
-    elem_counts[ref_i] = inferred_val.as<int64_t>();
+    elem_counts[ref_i] = *inferred_val;
     n_elems *= elem_counts[ref_i];
   }
 
@@ -359,6 +470,12 @@ std::unique_ptr<PointwiseParams> getPointwiseHeuristics(
 
   // Indicates whether the fusion is outer broadcast dominated or not.
   bool is_outer_broadcast_dominated = false;
+
+  // Gathered rows are always split from the indices selecting them, which
+  // wouldn't be found by the transfer size estimate below since the lookup
+  // tensor isn't mapped to the output along the indexed dimension.
+  const int64_t row_gather_break_point = getRowGatherBreakPoint(
+      fusion, domain_map.getComputeAtMap(), ref_loop);
   { // Figure out break point position. Empty scope, consider moving to a
     // separate function.
     //
@@ -383,6 +500,12 @@ std::unique_ptr<PointwiseParams> getPointwiseHeuristics(
           continue;
         }
 
+        const bool is_row_gather_break = row_gather_break_point > 0 &&
+            break_point_i == row_gather_break_point;
+        if (row_gather_break_point > 0 && !is_row_gather_break) {
+          continue;
+        }
+
         // Number of elements in the right side of reference tv with
         // break_point_i
         int64_t cur_right_elem_count = 1;
@@ -417,8 +540,9 @@ std::unique_ptr<PointwiseParams> getPointwiseHeuristics(
 
         //  Continue if this break point doesn't save at least 10% of 1D
         //  scheduling or isn't better than previous break_points found.
-        if (cur_transfer_size >= min_total_transfer ||
-            cur_transfer_size * 10 >= transfer_size_1d * 9) {
+        if (!is_row_gather_break &&
+            (cur_transfer_size >= min_total_transfer ||
+             cur_transfer_size * 10 >= transfer_size_1d * 9)) {
           continue;
         }
 
@@ -466,10 +590,11 @@ std::unique_ptr<PointwiseParams> getPointwiseHeuristics(
     }
   }
 
-  params->vectorization_factor = std::min(
-      max_vect_factor,
+  const int64_t supported_vect_factor =
       vectorize_helper::getVectorizationFactor(
-          runtime_info, largest_out, data_cache, break_point, reorder_map));
+          runtime_info, largest_out, data_cache, break_point, reorder_map);
+  params->vectorization_factor =
+      std::min(max_vect_factor, supported_vect_factor);
 
   // get unroll factor:
 
@@ -510,6 +635,83 @@ std::unique_ptr<PointwiseParams> getPointwiseHeuristics(
     params->split_grid_y_dim = true;
   }
 
+  // The TMA mode replaces the schedule chosen above, so the heuristic plugin
+  // is only consulted for the regular schedule.
+  const bool use_tma = pointwise_tma::getHeuristics(
+      params.get(), fusion, runtime_info, largest_out, elem_counts);
+  if (use_tma && !params->tma_bulk_copy &&
+      params->break_point != break_point) {
+    // The TMA mode only vectorizes the innermost dimension
+    params->vectorization_factor = std::min(
+        params->vectorization_factor,
+        vectorize_helper::getVectorizationFactor(
+            runtime_info,
+            largest_out,
+            data_cache,
+            params->break_point,
+            reorder_map));
+  }
+
+  const bool plugin_updated = !use_tma &&
+      heuristic_plugin::updatePointwiseParams(
+          params.get(),
+          fusion,
+          runtime_info,
+          largest_out,
+          supported_vect_factor);
+  if (plugin_updated) {
+    // The supported vectorization depends on the break point chosen by the
+    // plugin
+    const int64_t plugin_supported_vect_factor =
+        params->break_point == break_point
+        ? supported_vect_factor
+        : vectorize_helper::getVectorizationFactor(
+              runtime_info,
+              largest_out,
+              data_cache,
+              params->break_point,
+              reorder_map);
+    NVF_CHECK(
+        params->vectorization_factor >= 1 &&
+            params->vectorization_factor <= plugin_supported_vect_factor,
+        "Invalid vectorization factor returned by heuristic plugin: ",
+        params->vectorization_factor,
+        ". Expected a value between 1 and ",
+        plugin_supported_vect_factor);
+  }
+
+  // Let the inputs and outputs of narrower dtypes, or with more alignment,
+  // than the one limiting the vectorization be vectorized by more elements.
+  // The factors chosen by the heuristic plugin are kept as they are.
+  if (!use_tma && !plugin_updated &&
+      isOptionEnabled(EnableOption::MixedVectorization)) {
+    setVectorizationFactorsOfTensors(
+        params.get(),
+        fusion,
+        runtime_info,
+        largest_out,
+        data_cache,
+        reorder_map,
+        max_vect_factor * max_dtype_size_for_vectorization);
+  }
+
+  // Cap the grid of the 1D scheduler at the blocks that can be resident at
+  // once and loop over the remaining tiles in each block, which saves the
+  // launch and tail effects of many waves of short-lived blocks.
+  if (isOptionEnabled(EnableOption::PersistentGrid) &&
+      params->break_point == 0 && !params->use_tma_load) {
+    const int64_t num_tiles = ceilDiv(
+        n_elems,
+        params->vectorization_factor * params->threads_per_block_1d *
+            params->unroll_factor_inner);
+    const int64_t grid_size =
+        scheduler_utils::maxResidentBlocks(params->threads_per_block_1d);
+    if (num_tiles > grid_size) {
+      params->persistent_grid = true;
+      params->lparams.bind(grid_size, ParallelType::BIDx);
+    }
+  }
+
   if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
     debug() << "\n===== Pointwise Stats ========\n"
             << "num_elems: " << n_elems << "\n"
@@ -943,7 +1145,7 @@ void schedulePointwise(Fusion* fusion, const PointwiseParams* pparams) {
       // Unswitch
       reference_tv->split(0, 1);
       // Threads
-      reference_tv->split(0, kThreadX);
+      reference_tv->split(0, pparams->threads_per_block_1d);
 
       reference_tv->axis(0)->parallelize(ParallelType::BIDx);
       reference_tv->axis(1)->parallelize(ParallelType::TIDx);
@@ -961,7 +1163,7 @@ void schedulePointwise(Fusion* fusion, const PointwiseParams* pparams) {
         reference_tv->split(0, pparams->vectorization_factor);
       }
       // Threads
-      reference_tv->split(0, kThreadX);
+      reference_tv->split(0, pparams->threads_per_block_1d);
       // Unroll
       if (pparams->unroll_factor_inner > 1) {
         reference_tv->split(0, pparams->unroll_factor_inner);
@@ -984,6 +1186,15 @@ void schedulePointwise(Fusion* fusion, const PointwiseParams* pparams) {
       }
     }
     unswitch_pos = 2;
+
+    if (pparams->persistent_grid) {
+      // Grid-stride loop over the tiles:
+      // [Serial, BIDx{gridDim.x} | Unswitch, ...]
+      reference_tv->split(0, NamedScalar::getParallelDim(ParallelType::BIDx));
+      reference_tv->axis(0)->parallelize(ParallelType::Serial);
+      reference_tv->axis(1)->parallelize(ParallelType::BIDx);
+      unswitch_pos = 3;
+    }
   }
 
   TransformPropagator propagator(reference_tv);
@@ -1020,6 +1231,32 @@ void schedulePointwise(Fusion* fusion, const PointwiseParams* pparams) {
         vectorize_id->parallelize(ParallelType::Serial);
       }
     }
+
+    // The inputs and outputs with smaller vectorization factors than the
+    // loop are accessed by several vectorized accesses, each reading or
+    // writing part of the registers of the loop.
+    for (const auto i : arange(pparams->input_vectorization_factors.size())) {
+      auto inp = dynamic_cast<TensorView*>(fusion->inputs().at(i));
+      if (inp == nullptr) {
+        continue;
+      }
+      for (auto consumer : ir_utils::consumerTvsOf(inp)) {
+        narrowVectorization(
+            consumer,
+            pparams->input_vectorization_factors.at(i),
+            pparams->vectorization_factor);
+      }
+    }
+    for (const auto i : arange(pparams->output_vectorization_factors.size())) {
+      auto out = dynamic_cast<TensorView*>(fusion->outputs().at(i));
+      if (out == nullptr) {
+        continue;
+      }
+      narrowVectorization(
+          out,
+          pparams->output_vectorization_factors.at(i),
+          pparams->vectorization_factor);
+    }
   }
 
   // Begin by inlining at the unswitch position for the entire DAG. The cached
@@ -1068,6 +1305,7 @@ std::unique_ptr<HeuristicParams> PointWiseScheduler::computeHeuristics(
   FUSER_PERF_SCOPE("PointWiseScheduler::computeHeuristics");
   auto pparams = getPointwiseHeuristics(fusion, runtime_info, data_cache);
   NVF_ERROR(pparams != nullptr);
+  autotune::applyTunedParams(pparams.get(), fusion, runtime_info);
   return pparams;
 }
 
@@ -1080,7 +1318,11 @@ void PointWiseScheduler::schedule(
       pparams != nullptr,
       "Incorrect parameters sent to PointWiseScheduler::schedule",
       params);
-  schedulePointwise(fusion, pparams);
+  if (pparams->use_tma_load) {
+    pointwise_tma::scheduleFusion(fusion, pparams);
+  } else {
+    schedulePointwise(fusion, pparams);
+  }
 }
 
 } // namespace nvfuser
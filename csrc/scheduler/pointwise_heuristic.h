@@ -53,6 +53,48 @@ class PointwiseParams : public HeuristicParams {
   // Also used in 1D scheduler.
   int64_t unroll_factor_inner = 1;
 
+  // Number of threads per block of the 1D scheduler. The 2D scheduler derives
+  // its block dimensions from the problem size instead.
+  int64_t threads_per_block_1d = 128;
+
+  // Stage inputs through shared memory with circular buffered TMA loads
+  // instead of loading them to registers. The reference is tiled as [outer,
+  // inner] at break_point, see pointwise_tma.h.
+  bool use_tma_load = false;
+
+  // Store outputs from shared memory with TMA. Only used with use_tma_load.
+  bool use_tma_store = false;
+
+  // Outer and inner extent of the TMA box
+  int64_t tma_tile_outer = 1;
+  int64_t tma_tile_inner = 1;
+
+  // Number of consecutive tiles along the outer dimension processed by a
+  // block, which is the loop circular buffered by the TMA loads
+  int64_t tma_tiles_per_block = 1;
+
+  // Number of circular buffer stages of the TMA loads
+  int64_t circular_buffer_stages = 1;
+
+  // The fusion only copies inputs to outputs. The tiles loaded with TMA are
+  // stored with TMA straight from shared memory, without any thread
+  // touching the data. Only used with use_tma_load and use_tma_store.
+  bool tma_bulk_copy = false;
+
+  // Launch the grid size bound to lparams.gdimx() instead of one block per
+  // tile, and let each block loop over the tiles with a stride of gridDim.x.
+  // Only used by the 1D scheduler.
+  bool persistent_grid = false;
+
+  // Vectorization factors of the fusion inputs and outputs, indexed like
+  // fusion->inputs() and fusion->outputs(), when they differ. The loop is
+  // vectorized by vectorization_factor, and the accesses of a tensor with a
+  // smaller factor are split into vectorization_factor / factor vectorized
+  // accesses, so that tensors of narrower dtypes still move 16 bytes at a
+  // time. Empty means every tensor is vectorized by vectorization_factor.
+  std::vector<int64_t> input_vectorization_factors;
+  std::vector<int64_t> output_vectorization_factors;
+
   using HeuristicParams::HeuristicParams;
 
   // Warning: Does not check launch parameters!
@@ -68,7 +110,18 @@ class PointwiseParams : public HeuristicParams {
         other->split_grid_y_dim == split_grid_y_dim &&
         other->unroll_factor_outer == unroll_factor_outer &&
         other->unroll_factor_inner == unroll_factor_inner &&
-        other->flip_grid_binding == flip_grid_binding;
+        other->threads_per_block_1d == threads_per_block_1d &&
+        other->flip_grid_binding == flip_grid_binding &&
+        other->use_tma_load == use_tma_load &&
+        other->use_tma_store == use_tma_store &&
+        other->tma_tile_outer == tma_tile_outer &&
+        other->tma_tile_inner == tma_tile_inner &&
+        other->tma_tiles_per_block == tma_tiles_per_block &&
+        other->circular_buffer_stages == circular_buffer_stages &&
+        other->tma_bulk_copy == tma_bulk_copy &&
+        other->persistent_grid == persistent_grid &&
+        other->input_vectorization_factors == input_vectorization_factors &&
+        other->output_vectorization_factors == output_vectorization_factors;
     return attr_equal;
   }
 
@@ -87,13 +140,32 @@ class PointwiseParams : public HeuristicParams {
       if (split_grid_y_dim) {
         ss << "  Split y grid dim\n";
       }
+    } else {
+      ss << "threads_per_block_1d: " << threads_per_block_1d << "\n";
+      if (persistent_grid) {
+        ss << "Persistent grid\n";
+      }
     }
     ss << "vectorization_factor: " << vectorization_factor << "\n";
+    if (!input_vectorization_factors.empty()) {
+      ss << "  input_vectorization_factors: "
+         << toDelimitedString(input_vectorization_factors) << "\n"
+         << "  output_vectorization_factors: "
+         << toDelimitedString(output_vectorization_factors) << "\n";
+    }
     ss << "unroll_factor_outer: " << unroll_factor_outer << "\n";
     ss << "unroll_factor_inner: " << unroll_factor_inner << "\n";
     if (flip_grid_binding) {
       ss << "Flip BIDx/BIDy bindings\n";
     }
+    if (use_tma_load) {
+      ss << "TMA load" << (use_tma_store ? " and store" : "")
+         << (tma_bulk_copy ? " of a bulk copy" : "") << "\n"
+         << "  tma_tile: [" << tma_tile_outer << ", " << tma_tile_inner
+         << "]\n"
+         << "  tma_tiles_per_block: " << tma_tiles_per_block << "\n"
+         << "  circular_buffer_stages: " << circular_buffer_stages << "\n";
+    }
     ss << "====================================\n";
     return ss.str();
   }
@@ -106,7 +178,22 @@ class PointwiseParams : public HeuristicParams {
         static_cast<size_t>(split_grid_y_dim) << 6 ^
         static_cast<size_t>(unroll_factor_outer) << 7 ^
         static_cast<size_t>(unroll_factor_inner) << 9 ^
-        static_cast<size_t>(flip_grid_binding) << 10;
+        static_cast<size_t>(flip_grid_binding) << 10 ^
+        static_cast<size_t>(threads_per_block_1d) << 11 ^
+        static_cast<size_t>(use_tma_load) << 12 ^
+        static_cast<size_t>(use_tma_store) << 13 ^
+        static_cast<size_t>(tma_tile_outer) << 14 ^
+        static_cast<size_t>(tma_tile_inner) << 16 ^
+        static_cast<size_t>(tma_tiles_per_block) << 18 ^
+        static_cast<size_t>(circular_buffer_stages) << 20 ^
+        static_cast<size_t>(persistent_grid) << 23 ^
+        static_cast<size_t>(tma_bulk_copy) << 24;
+    for (int64_t factor : input_vectorization_factors) {
+      attr_hash = attr_hash * 31 ^ static_cast<size_t>(factor);
+    }
+    for (int64_t factor : output_vectorization_factors) {
+      attr_hash = attr_hash * 31 ^ static_cast<size_t>(factor);
+    }
     return attr_hash;
   }
 
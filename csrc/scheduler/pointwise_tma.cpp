@@ -0,0 +1,524 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <scheduler/pointwise_tma.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <instrumentation.h>
+#include <ir/utils.h>
+#include <options.h>
+#include <scheduler/cache_policy_refiner.h>
+#include <scheduler/debug_utils.h>
+#include <scheduler/pointwise_utils.h>
+#include <scheduler/runtime_info.h>
+#include <scheduler/tools/inlining.h>
+#include <scheduler/tools/maxinfo_propagator.h>
+#include <scheduler/utils.h>
+#include <transform_replay.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+namespace nvfuser {
+namespace pointwise_tma {
+
+namespace {
+
+// cuTensorMapEncodeTiled limits each dimension of a box to 256 elements and
+// requires the inner dimension of a box and the strides of the tensor to be
+// multiples of 16 bytes.
+constexpr int64_t max_box_extent = 256;
+constexpr int64_t tma_alignment_bytes = 16;
+
+// Elements of a tile. With 128 threads and 4 byte elements, each thread
+// processes 32 elements, e.g., 8 vectorized loads of 4 elements, per tile.
+constexpr int64_t target_tile_elements = 4096;
+constexpr int64_t threads_per_block = 128;
+
+constexpr int64_t max_circular_buffer_stages = 4;
+constexpr int64_t max_tiles_per_block = 16;
+
+// Shared memory left for the mbarriers of the circular buffers and the
+// reduction workspace of the runtime
+constexpr int64_t smem_overhead_bytes = 1024;
+
+// Inputs loaded with TMA
+std::vector<TensorView*> getTmaLoadTvs(Fusion* fusion, int64_t n_dims) {
+  std::vector<TensorView*> tvs;
+  for (auto tv : ir_utils::filterByType<TensorView>(fusion->inputs())) {
+    if (!tv->uses().empty() && isTmaCompatible(tv, n_dims)) {
+      tvs.push_back(tv);
+    }
+  }
+  return tvs;
+}
+
+// Outputs stored with TMA. Outputs aliasing inputs keep the regular path.
+std::vector<TensorView*> getTmaStoreTvs(Fusion* fusion, int64_t n_dims) {
+  std::vector<TensorView*> tvs;
+  for (auto tv : ir_utils::filterByType<TensorView>(fusion->outputs())) {
+    if (tv->definition() == nullptr || tv->isFusionInput() ||
+        fusion->getOutputAlias(tv).type != AllocationType::New) {
+      continue;
+    }
+    if (isTmaCompatible(tv, n_dims) &&
+        std::find(tvs.begin(), tvs.end(), tv) == tvs.end()) {
+      tvs.push_back(tv);
+    }
+  }
+  return tvs;
+}
+
+// Returns true if the fusion only copies TMA loads to TMA stores, i.e., each
+// output is a plain copy of a TMA load of the same dtype and there is no
+// other expression
+bool isBulkCopy(
+    Fusion* fusion,
+    const std::vector<TensorView*>& load_tvs,
+    const std::vector<TensorView*>& store_tvs) {
+  for (auto out : fusion->outputs()) {
+    if (std::find(store_tvs.begin(), store_tvs.end(), out) ==
+        store_tvs.end()) {
+      return false;
+    }
+  }
+  for (auto expr : fusion->exprs()) {
+    auto ldst = dynamic_cast<LoadStoreOp*>(expr);
+    if (ldst == nullptr || ldst->opType() != LoadStoreOpType::Set) {
+      return false;
+    }
+    auto in = dynamic_cast<TensorView*>(ldst->in());
+    auto out = dynamic_cast<TensorView*>(ldst->out());
+    if (in == nullptr || out == nullptr || in->dtype() != out->dtype() ||
+        std::find(load_tvs.begin(), load_tvs.end(), in) == load_tvs.end() ||
+        std::find(store_tvs.begin(), store_tvs.end(), out) ==
+            store_tvs.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t tileBytes(const std::vector<TensorView*>& tvs, int64_t tile_elements) {
+  int64_t bytes = 0;
+  for (auto tv : tvs) {
+    bytes += tile_elements * dataTypeSizeByte(tv->dtype());
+  }
+  return bytes;
+}
+
+} // namespace
+
+bool isTmaCompatible(TensorView* tv, int64_t n_dims) {
+  if (tv->hasAllocation() || tv->isCpuScalar()) {
+    return false;
+  }
+  const std::vector<IterDomain*> logical =
+      TensorDomain::noReductions(tv->getLogicalDomain());
+  if ((int64_t)logical.size() != n_dims ||
+      std::any_of(logical.begin(), logical.end(), [](IterDomain* id) {
+        return id->isBroadcast() || id->isDeviceDim();
+      })) {
+    return false;
+  }
+  const std::vector<std::optional<bool>>& contiguity = tv->getContiguity();
+  return std::all_of(
+      contiguity.begin(), contiguity.end(), [](std::optional<bool> contig) {
+        return !contig.has_value() || contig.value();
+      });
+}
+
+bool getHeuristics(
+    PointwiseParams* pparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference,
+    const std::vector<int64_t>& elem_counts) {
+  FUSER_PERF_SCOPE("pointwise_tma::getHeuristics");
+  if (!isOptionEnabled(EnableOption::TmaPointwise)) {
+    return false;
+  }
+  auto reject = [](const char* reason) {
+    scheduler_debug_utils::log("Pointwise TMA is not used: ", reason);
+    return false;
+  };
+
+  const auto dev_prop = at::cuda::getCurrentDeviceProperties();
+  if (dev_prop->major < 9) {
+    return reject("TMA requires Hopper or newer.");
+  }
+  const int64_t n_dims = (int64_t)elem_counts.size();
+  if (n_dims < 2) {
+    return reject("the reference has fewer than 2 dimensions.");
+  }
+  const std::vector<IterDomain*>& ref_loop = reference->getLoopDomain();
+  if (std::any_of(ref_loop.begin(), ref_loop.end(), [](IterDomain* id) {
+        return id->isBroadcast() || id->isDeviceDim();
+      })) {
+    return reject("the reference has broadcast or device dimensions.");
+  }
+  if (scheduler_utils::nLogicalDims(reference) != n_dims ||
+      !scheduler_utils::maybeReorderAsAllocationMap(reference).empty()) {
+    return reject("the reference isn't laid out as its logical domain.");
+  }
+  // View, permute, pad and slice transform logical domains, and gather-like
+  // ops need the memory type promotion of the regular schedule.
+  for (auto tv : fusion->allTvs()) {
+    if (tv->hasRoot()) {
+      return reject("the fusion transforms logical domains.");
+    }
+  }
+  for (auto expr : fusion->exprs()) {
+    if (expr->isOneOf<SelectOp, IndexSelectOp, GatherOp, ScatterOp>()) {
+      return reject("the fusion has gather or scatter ops.");
+    }
+  }
+
+  const int64_t inner = elem_counts.back();
+  int64_t outer = 1;
+  for (auto i : arange(n_dims - 1)) {
+    outer *= elem_counts.at(i);
+  }
+  constexpr int64_t max_tensor_map_dim = (int64_t)1 << 32;
+  if (inner > max_tensor_map_dim || outer > max_tensor_map_dim) {
+    return reject("the tensor is too large for a tensor map.");
+  }
+
+  const std::vector<TensorView*> load_tvs = getTmaLoadTvs(fusion, n_dims);
+  if (load_tvs.empty()) {
+    return reject("no input has the shape of the reference.");
+  }
+  const std::vector<TensorView*> store_tvs = getTmaStoreTvs(fusion, n_dims);
+  int64_t min_dtype_size = std::numeric_limits<int64_t>::max();
+  for (auto tv : load_tvs) {
+    if ((int64_t)runtime_info.getAlignmentSize(tv) < tma_alignment_bytes) {
+      return reject("an input isn't aligned to 16 bytes.");
+    }
+  }
+  for (const auto& tvs : {load_tvs, store_tvs}) {
+    for (auto tv : tvs) {
+      const int64_t dtype_size = dataTypeSizeByte(tv->dtype());
+      if ((inner * dtype_size) % tma_alignment_bytes != 0) {
+        return reject("the inner extent isn't a multiple of 16 bytes.");
+      }
+      min_dtype_size = std::min(min_dtype_size, dtype_size);
+    }
+  }
+
+  const int64_t tile_inner =
+      std::min(max_box_extent, scheduler_utils::lastPow2(inner));
+  if (tile_inner * min_dtype_size < tma_alignment_bytes) {
+    return reject("the inner extent is too small.");
+  }
+  int64_t tile_outer = std::min(
+      {max_box_extent,
+       scheduler_utils::lastPow2(outer),
+       std::max(target_tile_elements / tile_inner, (int64_t)1)});
+
+  // Each circular buffer stage holds a tile of each TMA load. The shared
+  // memory of the TMA stores isn't circular buffered, and a bulk copy stores
+  // the tiles of the loads. Aim for two blocks per SM, so that the TMA loads
+  // of one block overlap with the prologue and epilogue of the other.
+  const bool bulk_copy = isBulkCopy(fusion, load_tvs, store_tvs);
+  const int64_t smem_budget = std::min(
+      (int64_t)dev_prop->sharedMemPerBlockOptin,
+      (int64_t)dev_prop->sharedMemPerMultiprocessor / 2) -
+      smem_overhead_bytes;
+  auto smemBytes = [&](int64_t tile_elements, int64_t stages) {
+    return tileBytes(load_tvs, tile_elements) * stages +
+        (bulk_copy ? 0 : tileBytes(store_tvs, tile_elements));
+  };
+  int64_t stages = max_circular_buffer_stages;
+  while (smemBytes(tile_outer * tile_inner, stages) > smem_budget) {
+    if (stages > 2) {
+      stages--;
+    } else if (tile_outer > 1) {
+      tile_outer /= 2;
+    } else {
+      return reject("the tiles don't fit in shared memory.");
+    }
+  }
+
+  const int64_t tiles_outer = ceilDiv(outer, tile_outer);
+  const int64_t tiles_inner = ceilDiv(inner, tile_inner);
+  if (tiles_inner > 65535) {
+    return reject("the inner extent exceeds the limit of BIDy.");
+  }
+  const int64_t smem_per_block = smemBytes(tile_outer * tile_inner, stages);
+  const int64_t blocks_per_sm = std::max(
+      (int64_t)dev_prop->sharedMemPerMultiprocessor /
+          (smem_per_block + smem_overhead_bytes),
+      (int64_t)1);
+  const int64_t resident_blocks =
+      blocks_per_sm * (int64_t)dev_prop->multiProcessorCount;
+  // Process the tiles in a single wave when there are enough of them, so that
+  // each block amortizes the prologue of its circular buffer.
+  const int64_t tiles_per_block = std::min(
+      {max_tiles_per_block,
+       tiles_outer,
+       std::max(ceilDiv(tiles_outer * tiles_inner, resident_blocks), 1L)});
+
+  const int64_t tile_elements = tile_outer * tile_inner;
+  const int64_t vectorization_factor =
+      std::min(pparams->vectorization_factor, tile_inner);
+  const int64_t bdimx = std::min(
+      threads_per_block,
+      std::max(
+          scheduler_utils::roundUpToN(
+              tile_elements / vectorization_factor,
+              (int64_t)dev_prop->warpSize),
+          (int64_t)dev_prop->warpSize));
+
+  pparams->tag = "Pointwise TMA heuristics";
+  pparams->use_tma_load = true;
+  pparams->use_tma_store = !store_tvs.empty();
+  pparams->tma_tile_outer = tile_outer;
+  pparams->tma_tile_inner = tile_inner;
+  pparams->tma_tiles_per_block = tiles_per_block;
+  pparams->circular_buffer_stages = stages;
+  pparams->tma_bulk_copy = bulk_copy;
+  pparams->break_point = n_dims - 1;
+  pparams->vectorization_factor = vectorization_factor;
+  pparams->split_block = false;
+  pparams->split_grid_y_dim = false;
+  pparams->flip_grid_binding = false;
+  pparams->unroll_factor_inner = 1;
+  pparams->unroll_factor_outer = 1;
+  pparams->lparams = LaunchParams();
+  if (bulk_copy) {
+    // A single thread issues the TMA loads and stores of a block
+    pparams->vectorization_factor = 1;
+  } else {
+    pparams->lparams.bind(bdimx, ParallelType::TIDx);
+  }
+  return true;
+}
+
+namespace {
+
+// gmem -> (TMA load) -> smem -> (TMA store) -> gmem, tiled like the TMA
+// tensors of scheduleFusion
+void scheduleBulkCopy(Fusion* fusion, const PointwiseParams* pparams) {
+  const int64_t n_dims = pparams->break_point + 1;
+  const std::vector<TensorView*> store_tvs = getTmaStoreTvs(fusion, n_dims);
+
+  std::vector<TensorView*> smem_loads;
+  for (auto cached_input : scheduler_utils::cacheInputs(fusion, true)) {
+    auto ldst = cached_input->definition()->as<LoadStoreOp>();
+    ldst->setOpType(LoadStoreOpType::CpAsyncBulkTensorTile);
+    ldst->setCacheOp(CacheOp::Unspecified);
+    cached_input->setMemoryType(MemoryType::Shared);
+    smem_loads.push_back(cached_input);
+  }
+  for (auto tv : store_tvs) {
+    tv->definition()->as<LoadStoreOp>()->setOpType(
+        LoadStoreOpType::CpAsyncBulkTensorTile);
+  }
+
+  TensorView* reference_tv = store_tvs.front();
+  reference_tv->flatten(0, n_dims - 2);
+  reference_tv->split(1, pparams->tma_tile_inner);
+  reference_tv->split(0, pparams->tma_tile_outer);
+  reference_tv->split(0, pparams->tma_tiles_per_block);
+  reference_tv->reorder({{3, 1}});
+  // [outer/tile/tpb, inner/tile, tpb, tile_outer, tile_inner]
+  TransformPropagator propagator(reference_tv);
+  MaxLogicalDomainInfoSpanningTree(reference_tv).traverse(&propagator);
+
+  constexpr int64_t tile_pos = 3;
+  for (auto tv : smem_loads) {
+    tv->setAllocationDomain(tv->getLoopDomain(), true);
+  }
+  for (auto tv : fusion->allTvs()) {
+    if (tv->isFusionInput()) {
+      continue;
+    }
+    tv->axis(0)->parallelize(ParallelType::BIDx);
+    tv->axis(1)->parallelize(ParallelType::BIDy);
+    tv->axis(tile_pos)->parallelize(ParallelType::Bulk);
+    tv->axis(tile_pos + 1)->parallelize(ParallelType::Bulk);
+  }
+  inlineAllAt(reference_tv, tile_pos, true);
+
+  // The TMA store of a tile reads the stage that its TMA load wrote, so the
+  // loads of the next tiles overlap with the stores of the previous ones
+  for (auto tv : smem_loads) {
+    tv->circularBuffer(
+        pparams->circular_buffer_stages,
+        /*prefetch_distance=*/pparams->circular_buffer_stages - 1);
+  }
+}
+
+} // namespace
+
+void scheduleFusion(Fusion* fusion, const PointwiseParams* pparams) {
+  FusionGuard fg(fusion);
+  NVF_ERROR(pparams->use_tma_load, "Expected TMA pointwise parameters.");
+
+  scheduler_utils::clearMemorySpace(fusion);
+
+  if (pparams->tma_bulk_copy) {
+    scheduleBulkCopy(fusion, pparams);
+    return;
+  }
+
+  // The TMA tensors are found the same way as by getHeuristics, which checked
+  // the runtime requirements of all of them.
+  const int64_t n_dims = pparams->break_point + 1;
+  const std::vector<TensorView*> load_tvs = getTmaLoadTvs(fusion, n_dims);
+  const std::vector<TensorView*> store_tvs = pparams->use_tma_store
+      ? getTmaStoreTvs(fusion, n_dims)
+      : std::vector<TensorView*>{};
+  const std::unordered_set<TensorView*> load_tv_set(
+      load_tvs.begin(), load_tvs.end());
+  const std::unordered_set<TensorView*> store_tv_set(
+      store_tvs.begin(), store_tvs.end());
+
+  auto cached_inputs = scheduler_utils::cacheInputs(fusion, true);
+  auto cached_outputs = scheduler_utils::cacheAndForkOutputs(fusion, true);
+  refineCachePolicy(fusion);
+
+  // gmem -> (TMA load) -> smem -> (vectorized load) -> registers
+  std::vector<TensorView*> smem_loads;
+  std::vector<TensorView*> smem_load_caches;
+  for (auto cached_input : cached_inputs) {
+    if (load_tv_set.count(ir_utils::getSoleProducerTv(cached_input)) == 0) {
+      continue;
+    }
+    auto ldst = cached_input->definition()->as<LoadStoreOp>();
+    ldst->setOpType(LoadStoreOpType::CpAsyncBulkTensorTile);
+    ldst->setCacheOp(CacheOp::Unspecified);
+    cached_input->setMemoryType(MemoryType::Shared);
+    smem_loads.push_back(cached_input);
+    smem_load_caches.push_back(cached_input->cacheAfter());
+  }
+  NVF_ERROR(!smem_loads.empty(), "No input is loaded with TMA.");
+
+  // registers -> (vectorized store) -> smem -> (TMA store) -> gmem
+  std::vector<TensorView*> smem_stores;
+  for (auto [cached_output, output] : cached_outputs) {
+    if (store_tv_set.count(output) == 0) {
+      continue;
+    }
+    TensorView* smem_store = cached_output->cacheAfter();
+    smem_store->setMemoryType(MemoryType::Shared);
+    output->definition()->as<LoadStoreOp>()->setOpType(
+        LoadStoreOpType::CpAsyncBulkTensorTile);
+    smem_stores.push_back(smem_store);
+  }
+
+  TensorView* reference_tv = pointwise_utils::getReferenceTensor(fusion);
+  NVF_ERROR(
+      reference_tv != nullptr,
+      "Could not find a fully broadcasted output to reference schedule on.");
+
+  // [outer, inner]
+  reference_tv->flatten(0, n_dims - 2);
+  reference_tv->split(1, pparams->tma_tile_inner);
+  reference_tv->split(0, pparams->tma_tile_outer);
+  reference_tv->split(0, pparams->tma_tiles_per_block);
+  // [outer/tile/tpb, tpb, tile_outer, inner/tile, tile_inner]
+  reference_tv->reorder({{3, 1}});
+  // [outer/tile/tpb, inner/tile, tpb, tile_outer, tile_inner]
+  TransformPropagator propagator(reference_tv);
+  MaxLogicalDomainInfoSpanningTree(reference_tv).traverse(&propagator);
+
+  // The shared memory tensors are laid out as the box of their TMA
+  std::vector<TensorView*> tma_tvs;
+  for (auto tv : smem_loads) {
+    tv->setAllocationDomain(tv->getLoopDomain(), true);
+    tma_tvs.push_back(tv);
+  }
+  for (auto tv : smem_stores) {
+    tv->setAllocationDomain(tv->getLoopDomain(), true);
+  }
+  tma_tvs.insert(tma_tvs.end(), store_tvs.begin(), store_tvs.end());
+  constexpr int64_t tile_pos = 3;
+  for (auto tv : tma_tvs) {
+    tv->axis(0)->parallelize(ParallelType::BIDx);
+    tv->axis(1)->parallelize(ParallelType::BIDy);
+    tv->axis(tile_pos)->parallelize(ParallelType::Bulk);
+    tv->axis(tile_pos + 1)->parallelize(ParallelType::Bulk);
+  }
+
+  // Distribute the tile over the threads for everything but the TMA tensors.
+  // A TMA store output can't be the reference of this step, so its shared
+  // memory producer is used instead.
+  TensorView* thread_ref = store_tv_set.count(reference_tv)
+      ? ir_utils::getSoleProducerTv(reference_tv)
+      : reference_tv;
+  thread_ref->merge(tile_pos);
+  if (pparams->vectorization_factor > 1) {
+    thread_ref->split(tile_pos, pparams->vectorization_factor);
+  }
+  thread_ref->split(tile_pos, pparams->lparams.bdimx());
+  // [BIDx, BIDy, tpb, tile/vect/TIDx, TIDx, vect]
+  thread_ref->axis(0)->parallelize(ParallelType::BIDx);
+  thread_ref->axis(1)->parallelize(ParallelType::BIDy);
+  thread_ref->axis(tile_pos + 1)->parallelize(ParallelType::TIDx);
+
+  std::vector<TensorView*> thread_tvs = ir_utils::allTvsExcept(
+      fusion, std::unordered_set<TensorView*>(tma_tvs.begin(), tma_tvs.end()));
+  TransformPropagator thread_propagator(thread_ref);
+  SetSelector selector({thread_tvs.begin(), thread_tvs.end()});
+  MaxLogicalDomainInfoSpanningTree(thread_ref, &selector)
+      .traverse(&thread_propagator);
+  scheduler_utils::parallelizeAllLike(thread_ref, thread_tvs);
+
+  if (pparams->vectorization_factor > 1) {
+    // Shared memory is read and written with vectorized accesses. Inputs and
+    // outputs on the regular path are vectorized as by the regular schedule.
+    std::vector<TensorView*> vectorized_tvs = smem_load_caches;
+    vectorized_tvs.insert(
+        vectorized_tvs.end(), smem_stores.begin(), smem_stores.end());
+    for (auto tv : scheduler_utils::getInputsOutputsWithInnerDim(
+             reference_tv, true, true)) {
+      if (load_tv_set.count(tv) || store_tv_set.count(tv)) {
+        continue;
+      }
+      if (!tv->isFusionInput()) {
+        vectorized_tvs.push_back(tv);
+        continue;
+      }
+      auto consumer_tvs = ir_utils::consumerTvsOf(tv);
+      vectorized_tvs.insert(
+          vectorized_tvs.end(), consumer_tvs.begin(), consumer_tvs.end());
+    }
+    thread_ref->axis(-1)->parallelize(ParallelType::Vectorize);
+    scheduler_utils::parallelizeAllLike(
+        thread_ref, vectorized_tvs, {ParallelType::Vectorize});
+    if (std::find(vectorized_tvs.begin(), vectorized_tvs.end(), thread_ref) ==
+        vectorized_tvs.end()) {
+      thread_ref->axis(-1)->parallelize(ParallelType::Serial);
+    }
+  }
+
+  // Each iteration of the tpb loop processes one tile. The TMA tensors are
+  // allocated per tile and the rest of the fusion is inlined into the tile.
+  inlineAllAt(thread_ref, tile_pos, true);
+  std::vector<TensorView*> all_tvs = fusion->allTvs();
+  std::unordered_set<TensorView*> inner_most_tensors(
+      all_tvs.begin(), all_tvs.end());
+  for (auto tv : tma_tvs) {
+    inner_most_tensors.erase(tv);
+  }
+  for (auto tv : smem_stores) {
+    inner_most_tensors.erase(tv);
+  }
+  inlineMost(inner_most_tensors);
+
+  // Prefetch the tiles of the next iterations while computing the current one
+  for (auto tv : smem_loads) {
+    tv->circularBuffer(
+        pparams->circular_buffer_stages,
+        /*prefetch_distance=*/pparams->circular_buffer_stages - 1);
+  }
+}
+
+} // namespace pointwise_tma
+} // namespace nvfuser
@@ -0,0 +1,63 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <fusion.h>
+#include <scheduler/pointwise_heuristic.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace nvfuser {
+
+class SchedulerRuntimeInfo;
+
+//! TMA mode of the pointwise scheduler, enabled by EnableOption::TmaPointwise
+//! on Hopper and newer.
+//!
+//! The reference tensor is treated as [outer, inner], where outer merges all
+//! but the innermost logical dimension, and tiled as:
+//!   [outer/tile_outer/tiles_per_block, inner/tile_inner, tiles_per_block,
+//!    tile_outer, tile_inner]
+//! which is parallelized as [BIDx, BIDy, Serial, Bulk, Bulk] by the TMA loads
+//! and stores. Inputs matching the full shape of the reference are loaded
+//! tile by tile to shared memory with CpAsyncBulkTensorTile, circular buffered
+//! along the tiles_per_block loop, and copied to registers with vectorized
+//! shared memory loads. Outputs are written to shared memory by the threads
+//! and stored with CpAsyncBulkTensorTile. Other inputs and outputs, e.g.,
+//! broadcast inputs, use the regular register path. The computation
+//! distributes each tile as [tile/vect/TIDx, TIDx, vect] over the threads.
+//!
+//! A fusion that only copies inputs to outputs is a bulk copy: the outputs
+//! are stored with TMA straight from the circular buffers of the loads, so
+//! the tiles go global -> shared -> global without a register stage, and a
+//! single thread per block issues the copies.
+namespace pointwise_tma {
+
+//! Returns true if tv can be the global memory tensor of a TMA load or store
+//! tiled like a reference of n_dims dimensions. It must have n_dims
+//! dimensions without any broadcast, so that the boxes of all TMA tensors are
+//! the same tile, and be contiguous, so that the outer dimensions can be
+//! merged into one dimension of the tensor map.
+bool isTmaCompatible(TensorView* tv, int64_t n_dims);
+
+//! Fills the TMA parameters of pparams and returns true if the fusion can use
+//! the TMA mode. elem_counts are the extents of the loop domain of the
+//! reference that getPointwiseHeuristics analyzes. Otherwise, pparams is not
+//! modified.
+bool getHeuristics(
+    PointwiseParams* pparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference,
+    const std::vector<int64_t>& elem_counts);
+
+void scheduleFusion(Fusion* fusion, const PointwiseParams* pparams);
+
+} // namespace pointwise_tma
+} // namespace nvfuser
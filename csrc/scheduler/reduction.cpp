@@ -9,7 +9,10 @@
 #include <debug.h>
 #include <instrumentation.h>
 #include <multidevice/utils.h>
+#include <options.h>
+#include <scheduler/autotune.h>
 #include <scheduler/debug_utils.h>
+#include <scheduler/heuristic_plugin.h>
 #include <scheduler/mark_aliases.h>
 #include <scheduler/reduction.h>
 #include <scheduler/reduction_utils.h>
@@ -43,6 +46,79 @@ int64_t roundDownPow2OrMultipleOf(const int64_t x, const int64_t multiple) {
   return std::max(std::max(round_down_multiple, round_down_pow2), (int64_t)1);
 }
 
+// Largest grid size of the iteration domain on BIDx. With
+// EnableOption::PersistentGrid, it's capped at the blocks that can be resident
+// at once, and split_grid_dim_iter_dom_outer makes each block loop over the
+// remaining iterations. Kernels with grid reductions keep one iteration per
+// block, as looping would serialize a grid synchronization per iteration.
+int64_t iterDomGridLimit(
+    const int64_t threads_per_block,
+    const bool has_grid_reduction) {
+  if (has_grid_reduction || !isOptionEnabled(EnableOption::PersistentGrid)) {
+    return scheduler_utils::x_grid_limit;
+  }
+  return std::min(
+      scheduler_utils::maxResidentBlocks(threads_per_block),
+      scheduler_utils::x_grid_limit);
+}
+
+// Returns true if the grid reduction across grdim blocks can be done within a
+// thread block cluster, see ReductionParams::cluster_inner_reduction. Larger
+// grid reductions keep using global memory.
+bool useClusterReduction(const int64_t grdim) {
+  // Largest portable cluster size
+  constexpr int64_t max_cluster_size = 8;
+  if (!isOptionEnabled(EnableOption::ClusterReduction) || grdim < 2 ||
+      grdim > max_cluster_size) {
+    return false;
+  }
+  return at::cuda::getCurrentDeviceProperties()->major >= 9;
+}
+
+// Returns true if the blocks of the grid reduction of rparams can combine
+// their partial results in the output with atomics, see
+// ReductionParams::atomic_inner_reduction. Sums depend on the order of the
+// additions, so they are only reduced this way with
+// EnableOption::AtomicReduction, and only by outer reductions whose only
+// output is the sum, e.g., bias gradients. Maxima are exact in any order and
+// are reduced this way with EnableOption::AtomicMaxReduction, e.g., the amax
+// that delayed-scaling FP8 training computes next to the quantized output of
+// a pointwise fusion. The output is filled before each launch, which costs a
+// launch of its own, so neither is on by default.
+bool useAtomicReduction(
+    Fusion* fusion,
+    const std::vector<TensorView*>& reduction_tvs,
+    const ReductionParams* rparams) {
+  if (rparams->schedule_3D || rparams->persistent_kernel ||
+      !rparams->cross_grid_inner_reduction ||
+      rparams->cluster_inner_reduction) {
+    return false;
+  }
+  if (reduction_tvs.size() != 1 || !reduction_tvs.at(0)->isFusionOutput()) {
+    return false;
+  }
+  TensorView* reduction_tv = reduction_tvs.at(0);
+  auto rop = dynamic_cast<ReductionOp*>(reduction_tv->definition());
+  if (rop == nullptr || !reduction_tv->uses().empty() ||
+      fusion->getOutputAlias(reduction_tv).type != AllocationType::New) {
+    return false;
+  }
+  const DataType dtype = reduction_tv->getDataType().value();
+  if (dtype != DataType::Float && dtype != DataType::Double) {
+    return false;
+  }
+  switch (rop->getReductionOpType()) {
+    case BinaryOpType::Max:
+      return isOptionEnabled(EnableOption::AtomicMaxReduction);
+    case BinaryOpType::Add:
+      return isOptionEnabled(EnableOption::AtomicReduction) &&
+          !isOptionEnabled(EnableOption::Deterministic) &&
+          !rparams->fastest_dim && fusion->outputs().size() == 1;
+    default:
+      return false;
+  }
+}
+
 int64_t clamp(const int64_t val, const int64_t min_val, const int64_t max_val) {
   return std::min(std::max(val, min_val), max_val);
 }
@@ -343,6 +419,7 @@ std::unique_ptr<ReductionParams> inner2dReductionHeuristic(
     rparams->grid_dim_inner_reduction = ParallelType::BIDx;
     rparams->split_grid_dim_inner_reduction = true;
     gdimx = std::min(grdim, scheduler_utils::x_grid_limit);
+    rparams->cluster_inner_reduction = useClusterReduction(grdim);
 
     rparams->grid_dim_iter_dom = ParallelType::BIDy;
     if (godim > scheduler_utils::y_grid_limit) {
@@ -357,9 +434,10 @@ std::unique_ptr<ReductionParams> inner2dReductionHeuristic(
 
   } else {
     rparams->grid_dim_iter_dom = ParallelType::BIDx;
-    if (godim > scheduler_utils::x_grid_limit) {
+    const int64_t grid_limit = iterDomGridLimit(bdimx * bdimy, false);
+    if (godim > grid_limit) {
       rparams->split_grid_dim_iter_dom_outer = true;
-      gdimx = scheduler_utils::x_grid_limit;
+      gdimx = grid_limit;
     }
   }
 
@@ -742,9 +820,11 @@ std::unique_ptr<ReductionParams> inner3dReductionHeuristic(
 
   } else {
     rparams->grid_dim_iter_dom = ParallelType::BIDx;
-    if (godim > scheduler_utils::x_grid_limit) {
+    const int64_t grid_limit = iterDomGridLimit(
+        bdimx * bdimy * bdimz, rparams->cross_grid_outer_reduction);
+    if (godim > grid_limit) {
       rparams->split_grid_dim_iter_dom_outer = true;
-      gdimx = scheduler_utils::x_grid_limit;
+      gdimx = grid_limit;
     }
   }
 
@@ -945,13 +1025,14 @@ std::unique_ptr<ReductionParams> heuristicParaToSchedulerPara(
 
   rparams->grid_dim_iter_dom =
       flip_grid ? ParallelType::BIDy : ParallelType::BIDx;
-  if (params.gidim > (flip_grid ? scheduler_utils::y_grid_limit
-                                : scheduler_utils::x_grid_limit)) {
+  const int64_t grid_limit = iterDomGridLimit(
+      threads_per_block, rparams->cross_grid_inner_reduction);
+  if (params.gidim > (flip_grid ? scheduler_utils::y_grid_limit : grid_limit)) {
     rparams->split_grid_dim_iter_dom_outer = true;
     if (flip_grid) {
       gdimy = scheduler_utils::y_grid_limit;
     } else {
-      gdimx = scheduler_utils::x_grid_limit;
+      gdimx = grid_limit;
     }
   }
 
@@ -1519,19 +1600,78 @@ std::unique_ptr<ReductionParams> getReductionHeuristics(
       vectorize_factor,
       has_mufu_computation);
   heuristic->cparams.index_type = runtime_info.getIndexType();
+  heuristic_plugin::updateReductionParams(
+      heuristic.get(), fusion, runtime_info, reduction_tv, vectorize_factor);
+  heuristic->atomic_inner_reduction =
+      useAtomicReduction(fusion, reduction_tvs, heuristic.get());
   return heuristic;
 }
 
+// Double buffers the register caches of fusion inputs along the innermost
+// serial reduction loop of reference_tv. The circular buffer pass then
+// prefetches the loads of the next iteration of the loop before the math of
+// the current one, which hides the global memory latency of long serial
+// loops. Inputs cached in shared memory or not inlined into the reduction loop
+// are left alone.
+void prefetchSerialReductionLoads(
+    TensorView* reference_tv,
+    const std::vector<TensorView*>& cached_inputs) {
+  for (TensorView* tv : cached_inputs) {
+    if (tv->getMemoryType() != MemoryType::Local || tv->hasComputeWith() ||
+        tv->nDims() != reference_tv->nDims()) {
+      continue;
+    }
+    auto ldst = dynamic_cast<LoadStoreOp*>(tv->definition());
+    if (ldst == nullptr || !ldst->in()->isFusionInput()) {
+      continue;
+    }
+
+    // Same axis as the one the circular buffer pass picks: the innermost
+    // serial, non-broadcast axis outside both the computeAt position and the
+    // first unrolled axis.
+    int64_t stop = tv->getComputeAtPosition();
+    for (auto i : arange(stop)) {
+      if (tv->axis(i)->getParallelType() == ParallelType::Unroll) {
+        stop = i;
+        break;
+      }
+    }
+    int64_t pos = -1;
+    for (int64_t i = stop - 1; i >= 0; --i) {
+      if (!isParallelTypeThread(tv->axis(i)->getParallelType()) &&
+          !tv->axis(i)->isBroadcast()) {
+        pos = i;
+        break;
+      }
+    }
+    if (pos < 0 || !reference_tv->axis(pos)->isReduction() ||
+        reference_tv->axis(pos)->getParallelType() != ParallelType::Serial) {
+      continue;
+    }
+    tv->circularBuffer(/*number_of_stages=*/2);
+  }
+}
+
 // fusion is the input IR that will be modified by this function
 void scheduleReduction(Fusion* fusion, const ReductionParams* rparams) {
   FusionGuard fg(fusion);
 
   bool unroll = rparams->isUnrolled();
 
-  // Cache inputs if unrolled
-  auto cached_inputs = scheduler_utils::cacheInputs(fusion, unroll);
+  // Cache inputs if unrolled or prefetched
+  auto cached_inputs = scheduler_utils::cacheInputs(
+      fusion, unroll || rparams->prefetch_serial_reduction_loads);
 
-  // Cache and fork outputs
+  // Cache and fork outputs. The output of an atomic reduction is written by
+  // the reduction itself, so it's marked before. Rfactoring recreates the
+  // reduction, which is marked again below.
+  if (rparams->atomic_inner_reduction) {
+    scheduler_utils::getReductionTvs(fusion)
+        .at(0)
+        ->definition()
+        ->as<ReductionOp>()
+        ->requestAtomicGridReduction();
+  }
   auto cached_outputs = scheduler_utils::cacheAndForkOutputs(fusion, unroll);
 
   // Make sure we don't have global memory set on intermediate tensors from
@@ -1584,6 +1724,14 @@ void scheduleReduction(Fusion* fusion, const ReductionParams* rparams) {
   TensorView* reference_tv = reduction_scheduler_utils::scheduleReductionTV(
       rparams, reduction_tv, has_iter_axis);
 
+  if (rparams->cluster_inner_reduction) {
+    // The blocks of each grid reduction form a cluster, which lowering detects
+    // to reduce them through distributed shared memory
+    fusion->manage(
+        "cluster_dims",
+        std::tuple<int64_t, int64_t, int64_t>{rparams->lparams.gdimx(), 1, 1});
+  }
+
   // Reduction tensor views and rfactor tensor views are setup. Let's finish off
   // the scheduling, particularly inlining and unrolling.
   NVF_ERROR(
@@ -1600,6 +1748,7 @@ void scheduleReduction(Fusion* fusion, const ReductionParams* rparams) {
   // see validateAndConvertIterDomainGrouping
   const bool has_welford = ir_utils::hasOpsOfType<WelfordOp>(fusion);
   const bool use_iter_grouped_reduction = !rparams->fastest_dim &&
+      !rparams->atomic_inner_reduction &&
       (has_welford
            ? rparams->cross_grid_inner_reduction && rparams->persistent_kernel
            : rparams->cross_block_inner_reduction);
@@ -1614,10 +1763,31 @@ void scheduleReduction(Fusion* fusion, const ReductionParams* rparams) {
         reference_tv, reduction_tv, reduction_tvs);
   }
 
-  const auto& unroll_vectorizable_cached_tvs =
+  auto unroll_vectorizable_cached_tvs =
       reduction_scheduler_utils::getCachedTvsToUnrollOrVectorize(
           reference_tv, is_vectorize, cached_inputs, cached_outputs);
 
+  if (rparams->atomic_inner_reduction) {
+    // The blocks combine their partial results in the output, so the
+    // reduction within each block is done by a separate tensor first
+    std::vector<int64_t> block_axes;
+    for (const auto i : arange(reduction_tv->nDims())) {
+      IterDomain* id = reduction_tv->axis(i);
+      if (id->isReduction() && id->isThreadDim()) {
+        block_axes.push_back(i);
+      }
+    }
+    if (!block_axes.empty()) {
+      reduction_tv->rFactor(block_axes);
+    }
+    reduction_tv->definition()->as<ReductionOp>()->requestAtomicGridReduction();
+    // Vectorize the atomics of outer reductions like the stores of a cached
+    // output
+    if (is_vectorize && !rparams->fastest_dim) {
+      unroll_vectorizable_cached_tvs.insert(reduction_tv);
+    }
+  }
+
   reduction_scheduler_utils::propagateParallelization(
       reduction_tv,
       reference_tv,
@@ -1631,6 +1801,10 @@ void scheduleReduction(Fusion* fusion, const ReductionParams* rparams) {
 
   scheduler_utils::promoteProducerMemoryTypes(fusion, cached_inputs);
 
+  if (rparams->prefetch_serial_reduction_loads) {
+    prefetchSerialReductionLoads(reference_tv, cached_inputs);
+  }
+
   // TODO(#1401): We could let segmentation split a partially alias-producing
   // fusion into an alias-only segment and the rest. This way, the rest of the
   // fusion (which has fewer expressions) can potentially find a better
@@ -1809,6 +1983,7 @@ std::unique_ptr<HeuristicParams> ReductionScheduler::computeHeuristics(
   FUSER_PERF_SCOPE("ReductionScheduler::computeHeuristics");
   auto rparams = getReductionHeuristics(fusion, runtime_info, data_cache);
   NVF_ERROR(rparams != nullptr);
+  autotune::applyTunedParams(rparams.get(), fusion, runtime_info);
   return rparams;
 }
 
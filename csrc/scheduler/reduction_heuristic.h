@@ -58,6 +58,16 @@ class ReductionParams : public HeuristicParams {
   bool vectorize_inner_reduction = false;
   // Split grid dim for iteration axis in case it's too large for cuda
   bool split_grid_dim_inner_reduction = false;
+  // Reduce across the lparams.gdimx() blocks of cross_grid_inner_reduction
+  // within a thread block cluster through distributed shared memory instead of
+  // a global work buffer. Requires Hopper or newer.
+  bool cluster_inner_reduction = false;
+  // Combine the partial results of the blocks of cross_grid_inner_reduction
+  // in the output with atomics instead of reducing them through a global
+  // work buffer and a grid sync. Only used by non-persistent reductions
+  // written to fusion outputs: maxima, and sums of outer reductions, which
+  // aren't deterministic.
+  bool atomic_inner_reduction = false;
   // Pad inner dimension to nearest warp
   bool pad_inner_reduction_to_warp = false;
   // Register persistent buffer size in inner dimension
@@ -119,6 +129,11 @@ class ReductionParams : public HeuristicParams {
   // Use computeWith to persistent buffers
   bool compute_persistent_buffer_with_first_consumer = false;
 
+  // Double buffer the register caches of the inputs along the serial
+  // reduction loop, so the loads of the next iteration are issued before the
+  // math of the current one. Only used by non-persistent reductions.
+  bool prefetch_serial_reduction_loads = false;
+
   bool static_bdimx = false;
   bool static_bdimy = false;
 
@@ -190,6 +205,8 @@ class ReductionParams : public HeuristicParams {
         other->vectorize_inner_reduction == vectorize_inner_reduction &&
         other->split_grid_dim_inner_reduction ==
             split_grid_dim_inner_reduction &&
+        other->cluster_inner_reduction == cluster_inner_reduction &&
+        other->atomic_inner_reduction == atomic_inner_reduction &&
         other->pad_inner_reduction_to_warp == pad_inner_reduction_to_warp &&
         other->batches_per_block_inner_reduction ==
             batches_per_block_inner_reduction &&
@@ -207,6 +224,8 @@ class ReductionParams : public HeuristicParams {
             batches_per_block_outer_reduction &&
         other->compute_persistent_buffer_with_first_consumer ==
             compute_persistent_buffer_with_first_consumer &&
+        other->prefetch_serial_reduction_loads ==
+            prefetch_serial_reduction_loads &&
         other->combined_inner_outer == combined_inner_outer &&
         other->tidx_for_outer_reduction == tidx_for_outer_reduction &&
         other->pad_outer_reduction_to_warp == pad_outer_reduction_to_warp &&
@@ -227,6 +246,10 @@ class ReductionParams : public HeuristicParams {
     if (other->static_bdimx || static_bdimx) {
       attr_equal = attr_equal && other->lparams.bdimx() == lparams.bdimx();
     }
+    // The cluster size is compiled into the kernel
+    if (other->cluster_inner_reduction || cluster_inner_reduction) {
+      attr_equal = attr_equal && other->lparams.gdimx() == lparams.gdimx();
+    }
     return attr_equal;
   }
 
@@ -296,6 +319,8 @@ class ReductionParams : public HeuristicParams {
     if (cross_grid_inner_reduction) {
       ss << "cross grid - " << grid_dim_inner_reduction << " / ";
       ss << (split_grid_dim_inner_reduction ? "split grid dim / " : "");
+      ss << (cluster_inner_reduction ? "cluster / " : "");
+      ss << (atomic_inner_reduction ? "atomic / " : "");
     }
     if (batches_per_block_inner_reduction > 1 || persistent_kernel) {
       ss << "persistent batch - " << batches_per_block_inner_reduction << " / ";
@@ -315,6 +340,10 @@ class ReductionParams : public HeuristicParams {
       ss << "\ncomputeWith persistent buffers";
     }
 
+    if (prefetch_serial_reduction_loads) {
+      ss << "\nprefetch serial reduction loads";
+    }
+
     ss << "\n" << lparams.toString();
     ss << cparams.toString() << "\n";
     ss << "====================================\n";
@@ -352,7 +381,10 @@ class ReductionParams : public HeuristicParams {
         static_cast<size_t>(tma_warp_specialized) << (bits - 25) ^
         static_cast<size_t>(is_non_circular_buffer_gmem_to_regs)
             << (bits - 26) ^
-        static_cast<size_t>(is_circular_buffer_regs_cached) << (bits - 27);
+        static_cast<size_t>(is_circular_buffer_regs_cached) << (bits - 27) ^
+        static_cast<size_t>(cluster_inner_reduction) << (bits - 28) ^
+        static_cast<size_t>(prefetch_serial_reduction_loads) << (bits - 29) ^
+        static_cast<size_t>(atomic_inner_reduction) << (bits - 30);
     return attr_hash;
   }
 
@@ -109,6 +109,12 @@ TensorView* scheduleReductionTV(
     reduction_tv->axis(axis)->parallelize(ptype);
   };
 
+  auto outer_parallel_static =
+      [&reduction_tv](int64_t axis, ParallelType ptype, int64_t factor) {
+        reduction_tv->split(axis, factor, false);
+        reduction_tv->axis(axis)->parallelize(ptype);
+      };
+
   auto outer_unswitch = [&reduction_tv](int64_t axis) {
     reduction_tv->split(axis, 1, false);
     reduction_tv->axis(axis)->parallelize(ParallelType::Unswitch);
@@ -183,7 +189,15 @@ TensorView* scheduleReductionTV(
     }
     auto outer_i = inner_reduce_axis;
     if (rparams->cross_grid_inner_reduction) {
-      outer_parallel(outer_i++, rparams->grid_dim_inner_reduction);
+      if (rparams->cluster_inner_reduction) {
+        // The cluster size must be static
+        outer_parallel_static(
+            outer_i++,
+            rparams->grid_dim_inner_reduction,
+            rparams->lparams.gdimx());
+      } else {
+        outer_parallel(outer_i++, rparams->grid_dim_inner_reduction);
+      }
     }
 
     reduction_tv->split(
@@ -229,7 +243,13 @@ TensorView* scheduleReductionTV(
 
     inner_unswitch(inner_reduce_axis);
     if (rparams->cross_grid_inner_reduction) {
-      if (rparams->split_grid_dim_inner_reduction) {
+      if (rparams->cluster_inner_reduction) {
+        // The cluster size must be static
+        outer_parallel_static(
+            inner_reduce_axis,
+            rparams->grid_dim_inner_reduction,
+            rparams->lparams.gdimx());
+      } else if (rparams->split_grid_dim_inner_reduction) {
         outer_parallel(inner_reduce_axis, rparams->grid_dim_inner_reduction);
       } else {
         reduction_tv->axis(inner_reduce_axis)
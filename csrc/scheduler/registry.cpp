@@ -140,6 +140,14 @@ std::unique_ptr<HeuristicParams> SchedulerEntry::scheduleWith(
   return heuristic_params;
 }
 
+cost_model::KernelCost SchedulerEntry::predictCost(
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const HeuristicParams* params,
+    HeuristicDataCache* data_cache) {
+  return cost_model::estimateKernelCost(fusion, runtime_info, params);
+}
+
 namespace Schedule {
 // Simple dispatcher interface
 bool canSchedule(
@@ -165,17 +173,40 @@ bool canSchedule(
   return scheduler->canScheduleRunTime(fusion, runtime_info, data_cache);
 }
 
-// Simply loop through the list as baseline strategy
+// Simply loop through the list as baseline strategy. With
+// EnableOption::CostModel, the kernel schedulers that accept the fusion are
+// compared by predicted runtime instead. Priority breaks ties and wins if the
+// cost of the higher priority scheduler can't be predicted.
 SchedulerType proposeHeuristics(
     Fusion* fusion,
     SchedulerRuntimeInfo& runtime_info) {
+  SchedulerType best_scheduler = SchedulerType::None;
+  std::optional<double> best_time_us;
   for (const auto& sh : all_heuristics_in_priority_order) {
-    if (canSchedule(sh, fusion, runtime_info)) {
+    if (!canSchedule(sh, fusion, runtime_info)) {
+      continue;
+    }
+    if (!cost_model::isEnabled() || !cost_model::isComparable(sh)) {
+      if (best_scheduler != SchedulerType::None) {
+        continue;
+      }
       scheduler_debug_utils::canScheduleMessage("***Accepted*** as: ", sh);
       return sh;
     }
+    std::optional<double> time_us =
+        cost_model::predictRuntime(sh, fusion, runtime_info);
+    if (best_scheduler == SchedulerType::None ||
+        (time_us.has_value() && best_time_us.has_value() &&
+         *time_us < *best_time_us)) {
+      best_scheduler = sh;
+      best_time_us = time_us;
+    }
   }
-  return SchedulerType::None;
+  if (best_scheduler != SchedulerType::None) {
+    scheduler_debug_utils::canScheduleMessage(
+        "***Accepted*** as: ", best_scheduler);
+  }
+  return best_scheduler;
 }
 } // namespace Schedule
 
@@ -199,6 +230,115 @@ class CompileTimeInfo : public HeuristicCompileTime::CompileTimeInfoBase {
   std::unique_ptr<typename EntryClass::DataType> data_;
 };
 
+// Rebuilds cached data with the IR nodes of another fusion. Data that only
+// holds plain values is copied as is.
+class EntryTranslator {
+ public:
+  explicit EntryTranslator(const std::function<Val*(Val*)>& val_map)
+      : val_map_(val_map) {}
+
+  //! Whether a node couldn't be mapped, in which case the translated data
+  //!  must be discarded
+  bool failed() const {
+    return failed_;
+  }
+
+  template <typename T>
+  std::enable_if_t<std::is_base_of_v<Val, T>, T*> translate(T* node) {
+    // e.g., a group without a reference in ReferenceTensorsForGroups
+    if (node == nullptr) {
+      return nullptr;
+    }
+    Val* mapped = val_map_(node);
+    if (mapped == nullptr || !mapped->isA<T>()) {
+      failed_ = true;
+      return nullptr;
+    }
+    return mapped->as<T>();
+  }
+
+  template <typename T>
+  std::enable_if_t<std::is_arithmetic_v<T>, T> translate(T value) {
+    return value;
+  }
+
+  template <typename T>
+  std::vector<T> translate(const std::vector<T>& data) {
+    std::vector<T> translated;
+    translated.reserve(data.size());
+    for (const auto& element : data) {
+      translated.push_back(translate(element));
+    }
+    return translated;
+  }
+
+  template <typename T>
+  std::unordered_set<T> translate(const std::unordered_set<T>& data) {
+    std::unordered_set<T> translated;
+    for (const auto& element : data) {
+      translated.insert(translate(element));
+    }
+    return translated;
+  }
+
+  template <typename K, typename V>
+  std::unordered_map<K, V> translate(const std::unordered_map<K, V>& data) {
+    std::unordered_map<K, V> translated;
+    for (const auto& [key, value] : data) {
+      translated.emplace(translate(key), translate(value));
+    }
+    return translated;
+  }
+
+  scheduler_utils::PersistentBufferInfo translate(
+      const scheduler_utils::PersistentBufferInfo& info) {
+    scheduler_utils::PersistentBufferInfo translated = info;
+    translated.persistent_buffers = translate(info.persistent_buffers);
+    translated.unmappable_dims = translate(info.unmappable_dims);
+    translated.non_persistent_buffers = translate(info.non_persistent_buffers);
+    translated.persistent_buffer_resolution_points =
+        translate(info.persistent_buffer_resolution_points);
+    translated.projectable_persistent_buffers =
+        translate(info.projectable_persistent_buffers);
+    translated.projectable_buffer_inputs =
+        translate(info.projectable_buffer_inputs);
+    translated.unamppable_dims_projected_to_inputs =
+        translate(info.unamppable_dims_projected_to_inputs);
+    return translated;
+  }
+
+  scheduler_utils::BroadcastMultipleInformation translate(
+      const scheduler_utils::BroadcastMultipleInformation& info) {
+    return info;
+  }
+
+  scheduler_utils::SchedulerHyperParameters translate(
+      const scheduler_utils::SchedulerHyperParameters& hp) {
+    return hp;
+  }
+
+ private:
+  const std::function<Val*(Val*)>& val_map_;
+  bool failed_ = false;
+};
+
+template <typename EntryClass>
+bool copyEntry(
+    HeuristicDataCache& data_cache,
+    HeuristicCompileTime::CompileTimeInfoBase* entry,
+    const std::function<Val*(Val*)>& val_map) {
+  using DataType = typename EntryClass::DataType;
+  EntryTranslator translator(val_map);
+  auto data = std::make_unique<DataType>(translator.translate(
+      *entry->as<CompileTimeInfo<EntryClass>>()->get()));
+  if (translator.failed()) {
+    return false;
+  }
+  data_cache.insert(
+      std::make_unique<CompileTimeInfo<EntryClass>>(std::move(data)));
+  return true;
+}
+
 } // namespace
 
 void HeuristicDataCache::insert(HeuristicDataCache::EntryOwningPtr new_entry) {
@@ -207,6 +347,84 @@ void HeuristicDataCache::insert(HeuristicDataCache::EntryOwningPtr new_entry) {
   entries_.emplace_back(std::move(new_entry));
 }
 
+int64_t HeuristicDataCache::copyFrom(
+    HeuristicDataCache& other,
+    const std::function<Val*(Val*)>& val_map) {
+  using namespace HeuristicCompileTime;
+  int64_t num_copied = 0;
+  for (const auto& [entry_type, entry] : other.entry_type_map_) {
+    if (hasEntry(entry_type)) {
+      continue;
+    }
+    bool copied = false;
+    switch (entry_type) {
+      case CompileTimeEntryType::DOMAIN_MAP:
+      case CompileTimeEntryType::TRANSPOSE_DOMAIN_MAP:
+        break;
+      case CompileTimeEntryType::REFERENCE_TENSORS:
+        copied = copyEntry<ReferenceTensors>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::REFERENCE_TENSORS_FOR_GROUPS:
+        copied = copyEntry<ReferenceTensorsForGroups>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::VECTORIZABLE_INPUTS_AND_OUTPUTS:
+        copied =
+            copyEntry<VectorizableInputsAndOutputs>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::INPUTS_AND_OUTPUTS_INNER_DIM_GROUPS:
+        copied = copyEntry<InputsOutputsInnerDimGroups>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::TV_TO_CONTIG_INNER_SIZE_MAPS:
+        copied = copyEntry<TvToContigInnerSizeMaps>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::RESIZE_VECTORIZATION_FACTORS:
+        copied = copyEntry<ResizeVectorizationFactors>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::RESIZE_VECTORIZATION_FACTORS_OF_TENSORS:
+        copied = copyEntry<ResizeVectorizationFactorsOfTensors>(
+            *this, entry, val_map);
+        break;
+      case CompileTimeEntryType::UNROLLABLE_INPUTS_AND_OUTPUTS:
+        copied = copyEntry<UnrollableInputsAndOutputs>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::REDUCTION_TVS:
+        copied = copyEntry<ReductionTVs>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::PERSISTENT_BUFFER_INFO:
+        copied = copyEntry<PersistentBufferInfo>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::SCOPE_PERSISTENT_FACTOR_INFO:
+        copied = copyEntry<ScopePersistentFactorInfo>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::BROADCAST_BYTE_MULTIPLES:
+        copied = copyEntry<BroadcastMultiples>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::INNER_MOST_DIMS_INFO:
+        copied = copyEntry<InnerMostDimInfo>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::CAN_SCHEDULE_TRANSPOSE:
+        copied = copyEntry<CanScheduleTranspose>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::CAN_SCHEDULE_MUL_SUM_AS_MMA:
+        break;
+      case CompileTimeEntryType::LOGICAL_REORDER_MAP:
+        copied = copyEntry<LogicalReorderMap>(*this, entry, val_map);
+        break;
+      case CompileTimeEntryType::VECTORIZATION_BREAK_POINT_OF_RED_PROD:
+        copied = copyEntry<VectorizationBreakPointOfReductionProducer>(
+            *this, entry, val_map);
+        break;
+      case CompileTimeEntryType::SCHEDULE_HYPERPARAMETERS:
+        copied = copyEntry<SchedulerHyperParameters>(*this, entry, val_map);
+        break;
+    }
+    if (copied) {
+      ++num_copied;
+    }
+  }
+  return num_copied;
+}
+
 template <typename EntryClass>
 HeuristicDataCacheEntry<EntryClass>::HeuristicDataCacheEntry(
     HeuristicDataCache* data_cache,
@@ -240,6 +458,8 @@ template class HeuristicDataCacheEntry<
     HeuristicCompileTime::TvToContigInnerSizeMaps>;
 template class HeuristicDataCacheEntry<
     HeuristicCompileTime::ResizeVectorizationFactors>;
+template class HeuristicDataCacheEntry<
+    HeuristicCompileTime::ResizeVectorizationFactorsOfTensors>;
 template class HeuristicDataCacheEntry<
     HeuristicCompileTime::InputsOutputsInnerDimGroups>;
 template class HeuristicDataCacheEntry<
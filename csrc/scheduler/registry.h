@@ -10,6 +10,7 @@
 #include <expr_evaluator.h>
 #include <fusion.h>
 #include <scheduler/compile_time_info.h>
+#include <scheduler/cost_model.h>
 #include <scheduler/utils.h>
 
 namespace nvfuser {
@@ -48,6 +49,18 @@ class SchedulerEntry {
       SchedulerRuntimeInfo& runtime_info,
       HeuristicDataCache* data_cache = nullptr) = 0;
 
+  //! Predicted cost of the kernel generated with params, which
+  //! EnableOption::CostModel uses to choose between schedulers and
+  //! segmentations. The default is a roofline estimate from the bytes the
+  //! fusion moves and the operations it executes. Schedulers override it to
+  //! account for resources the default doesn't know about, e.g., persistent
+  //! buffers.
+  virtual cost_model::KernelCost predictCost(
+      Fusion* fusion,
+      SchedulerRuntimeInfo& runtime_info,
+      const HeuristicParams* params,
+      HeuristicDataCache* data_cache = nullptr);
+
   // Dispatch heuristic type to the right derived class of scheduler entry.
   // Scheduler entries are stateless so it's a lightweight class to dispatch to
   // the virtual functions in this abstract class.
@@ -20,6 +20,7 @@
 #include <scheduler/tools/inlining.h>
 #include <scheduler/tools/loop_domain_scheduler.h>
 #include <scheduler/tools/resize_utils.h>
+#include <scheduler/tools/rotary_embedding.h>
 #include <scheduler/tools/static_repeat.h>
 #include <val_graph_visitor.h>
 
@@ -235,12 +236,71 @@ std::unique_ptr<HeuristicParams> ResizeScheduler::computeHeuristics(
 
   // Only consider the innermost dimension to vectorize for now.
   // TODO: Consider vectorizing merged IDs, not just the innermost
-  params->vectorization_factor = vectorize_helper::getVectorizationFactor(
-      runtime_info,
-      ref_tv,
-      data_cache,
-      (int64_t)ref_tv->getLogicalDomain().size() - 1,
-      {});
+  //
+  // The loop is vectorized by the largest factor of any input or
+  // output. Tensors that can't use it, typically because a slice or
+  // pad offset isn't divisible by it, are still accessed element by
+  // element within the same loop.
+  const auto vectorization_factors =
+      vectorize_helper::getVectorizationFactorsOfTensors(
+          runtime_info,
+          ref_tv,
+          data_cache,
+          (int64_t)ref_tv->getLogicalDomain().size() - 1);
+  for (const auto& [tv, factor] : vectorization_factors) {
+    params->vectorization_factor =
+        std::max(params->vectorization_factor, factor);
+  }
+  // The reference itself must be able to hold a vectorized chunk
+  PolymorphicValue ref_inner_extent =
+      runtime_info.expressionEvaluator().evaluate(
+          ref_tv->getLogicalDomain().back()->extent());
+  params->vectorization_factor = ref_inner_extent.hasValue()
+      ? std::min(
+            params->vectorization_factor,
+            scheduler_utils::maxVectorizationWidth(
+                ref_inner_extent.as<int64_t>()))
+      : 1;
+
+  // Compute both halves of the rotations of RoPE in the same thread. The
+  // vectorized chunks then need to fit in a half.
+  if (!isOptionDisabled(DisableOption::ResizeRotaryPairs) &&
+      ref_inner_extent.hasValue()) {
+    if (auto rotary_info = scheduler_tools::getMaybeRotaryEmbeddingInfo(ref_tv);
+        rotary_info.has_value()) {
+      auto& ee = runtime_info.expressionEvaluator();
+      PolymorphicValue extent = ee.evaluate(rotary_info->extent);
+      PolymorphicValue negated_half_start =
+          ee.evaluate(rotary_info->negated_half_start);
+      PolymorphicValue half_stop = ee.evaluate(rotary_info->half_stop);
+      if (extent.hasValue() && negated_half_start.hasValue() &&
+          half_stop.hasValue() && extent == ref_inner_extent &&
+          negated_half_start == half_stop &&
+          2 * half_stop.as<int64_t>() == extent.as<int64_t>()) {
+        params->rotary_pairs = true;
+        params->vectorization_factor = std::min(
+            params->vectorization_factor,
+            scheduler_utils::maxVectorizationWidth(half_stop.as<int64_t>()));
+      }
+    }
+  }
+
+  if (params->vectorization_factor > 1) {
+    for (auto&& [i, inp] : enumerate(fusion->inputs())) {
+      auto it = vectorization_factors.find(dynamic_cast<TensorView*>(inp));
+      if (it != vectorization_factors.end() &&
+          it->second < params->vectorization_factor) {
+        params->unvectorized_inputs.push_back(i);
+      }
+    }
+    for (auto&& [i, out] : enumerate(fusion->outputs())) {
+      auto it = vectorization_factors.find(dynamic_cast<TensorView*>(out));
+      if (it != vectorization_factors.end() &&
+          it->second < params->vectorization_factor) {
+        params->unvectorized_outputs.push_back(i);
+      }
+    }
+  }
 
   return params;
 }
@@ -420,9 +480,13 @@ void ResizeScheduler::schedule(Fusion* fusion, const HeuristicParams* params) {
     scheduler_tools::propagateResizeToInputs(expr);
   }
 
-  // Update the IdModel
-  id_model = std::make_unique<IdModel>(fusion, /*build_graphs=*/false);
-  id_model->buildExactGraph();
+  // Update the IdModel. When the propagation only appended resize ops to
+  // the loop domains of the producers, they are added to the exact graph
+  // as is. Recomputed inputs or cancelled reshapes need a new model.
+  if (!id_model->updateWithNewTransforms()) {
+    id_model = std::make_unique<IdModel>(fusion, /*build_graphs=*/false);
+    id_model->buildExactGraph();
+  }
 
   // Detect an ending repeat
   auto repeat_info = scheduler_tools::getMaybeStaticRepeatInfo(ref_tv);
@@ -529,6 +593,18 @@ void ResizeScheduler::schedule(Fusion* fusion, const HeuristicParams* params) {
     //   +--- next_innermost_pos
   }
 
+  if (resize_params->rotary_pairs) {
+    // Move the halves of the rotated dimension inside each thread so that
+    // it computes the rotations of both
+    ref_tv->split(next_innermost_pos, 2, /*inner_split=*/false);
+    // [..., 2, H/2, vec_factor]
+    ref_tv->reorder({{next_innermost_pos - 1, next_innermost_pos}});
+    --next_innermost_pos;
+    // [..., H/2, 2, vec_factor]
+    //        ^
+    //        +--- next_innermost_pos
+  }
+
   ref_tv->flatten(outermost_pos, next_innermost_pos);
   // [..., I0, vec_factor]
   //       ^
@@ -593,9 +669,19 @@ void ResizeScheduler::schedule(Fusion* fusion, const HeuristicParams* params) {
   }
 
   if (vec_factor > 1) {
+    std::unordered_set<Val*> unvectorized_tvs;
+    for (int64_t i : resize_params->unvectorized_inputs) {
+      unvectorized_tvs.insert(fusion->inputs().at(i));
+    }
+    for (int64_t i : resize_params->unvectorized_outputs) {
+      unvectorized_tvs.insert(fusion->outputs().at(i));
+    }
     const auto tvs_to_vectorize =
         scheduler_utils::getInputsOutputsWithInnerDim(ref_tv, true, true);
     for (auto tv_to_vectorize : tvs_to_vectorize) {
+      if (unvectorized_tvs.count(tv_to_vectorize)) {
+        continue;
+      }
       if (tv_to_vectorize->isFusionInput()) {
         for (auto consumer_tv : ir_utils::consumerTvsOf(tv_to_vectorize)) {
           consumer_tv->axis(-1)->parallelize(ParallelType::Vectorize);
@@ -27,6 +27,17 @@ class ResizeParams : public HeuristicParams {
 
   int64_t vectorization_factor = 1;
 
+  // Indices of the fusion inputs and outputs that are accessed element by
+  // element in the vectorized loop, e.g., because a slice or pad offset
+  // misaligns them
+  std::vector<int64_t> unvectorized_inputs;
+  std::vector<int64_t> unvectorized_outputs;
+
+  // Split the innermost dimension of the reference into its halves and
+  // compute both in the same thread, for the rotations of RoPE, see
+  // scheduler_tools::getMaybeRotaryEmbeddingInfo
+  bool rotary_pairs = false;
+
   static constexpr int64_t max_gdimx = (1L << 31) - 1L;
 
   using HeuristicParams::HeuristicParams;
@@ -40,7 +51,10 @@ class ResizeParams : public HeuristicParams {
     bool attr_equal = other->cparams == cparams &&
         other->split_grid_x_dim == split_grid_x_dim &&
         other->largest_input == largest_input &&
-        other->vectorization_factor == vectorization_factor;
+        other->vectorization_factor == vectorization_factor &&
+        other->unvectorized_inputs == unvectorized_inputs &&
+        other->unvectorized_outputs == unvectorized_outputs &&
+        other->rotary_pairs == rotary_pairs;
     return attr_equal;
   }
 
@@ -51,12 +65,21 @@ class ResizeParams : public HeuristicParams {
        << " split grid x dim: " << split_grid_x_dim << "\n"
        << " index of largest input: " << largest_input << "\n"
        << " vectorization factor: " << vectorization_factor << "\n";
+    if (rotary_pairs) {
+      ss << " rotary pairs\n";
+    }
+    if (!unvectorized_inputs.empty() || !unvectorized_outputs.empty()) {
+      ss << " unvectorized inputs: " << toDelimitedString(unvectorized_inputs)
+         << "\n"
+         << " unvectorized outputs: "
+         << toDelimitedString(unvectorized_outputs) << "\n";
+    }
     ss << "====================================\n";
     return ss.str();
   }
 
   size_t hash() const override {
-    return c10::get_hash(split_grid_x_dim);
+    return c10::get_hash(split_grid_x_dim, rotary_pairs);
   }
 
   std::unique_ptr<HeuristicParams> clone() const override {
@@ -20,7 +20,9 @@ SchedulerRuntimeInfo::SchedulerRuntimeInfo(
     KernelArgumentHolder args,
     PrecomputedValues* precomputed_values,
     const std::vector<TensorView*>& all_tvs,
-    std::optional<PrimDataType> forced_index_type)
+    std::optional<PrimDataType> forced_index_type,
+    TensorArgInfoCache* arg_info_cache,
+    const std::vector<Val*>& arg_info_keys)
     : complete_fusion_(complete_fusion) {
   FUSER_PERF_SCOPE("SchedulerRuntimeInfo::SchedulerRuntimeInfo");
   NVF_ERROR_EQ(std::ssize(complete_fusion_->inputs()), args.size());
@@ -37,55 +39,91 @@ SchedulerRuntimeInfo::SchedulerRuntimeInfo(
         *expression_evaluator_);
   }
 
+  NVF_ERROR(
+      arg_info_cache == nullptr || arg_info_keys.size() == args.size(),
+      "Expected a key for each argument");
   for (auto inp_i : arange(static_cast<int64_t>(args.size()))) {
     auto fusion_inp = complete_fusion_->inputs().at(inp_i);
     auto input_tv = dynamic_cast<TensorView*>(fusion_inp);
     // Note: we are skipping CpuScalar tensor here
-    if (input_tv != nullptr && !input_tv->isCpuScalar()) {
-      const auto& metadata =
-          expression_evaluator_->evaluate(IrBuilder::metadataExpr(input_tv));
-      const auto& alloc_sizes = metadata->*&TensorMetaData::alloc_size;
-      const auto& alloc_strides = metadata->*&TensorMetaData::alloc_stride;
-      NVF_ERROR(alloc_sizes.size() == alloc_strides.size());
-
-      input_ptrs_[fusion_inp] = (size_t)(metadata->*&TensorMetaData::data);
-
-      std::optional<std::vector<int64_t>> alloc_perm_opt =
-          ir_utils::computePermutation(
-              TensorDomain::noReductions(input_tv->getLogicalDomain()),
-              TensorDomain::noReductions(input_tv->getMaybeAllocationDomain()));
-      if (alloc_perm_opt.has_value()) {
-        // Save the strides in order of allocation domain in case the
-        // allocation domain is a permutation of RFactor domain
-        // NOTE: alloc_sizes and alloc_strides are already in order of
-        // allocation domain
-        input_sizes_.emplace(fusion_inp, alloc_sizes.vec());
-        input_strides_elements_.emplace(fusion_inp, alloc_strides.vec());
-      }
+    if (input_tv == nullptr || input_tv->isCpuScalar()) {
+      continue;
+    }
 
-      // find and push discontiguous stride
-      int64_t dtype_size = dataTypeSizeByte(input_tv->dtype());
-      input_discontig_strides_[fusion_inp] = {};
-      auto dims = static_cast<int64_t>(alloc_strides.size());
-      int64_t expected_stride = 1;
-      for (int64_t dim = dims - 1; dim >= 0; dim--) {
-        auto size = alloc_sizes.at(dim);
-        auto stride = alloc_strides.at(dim);
-        // Skip broadcast dimensions because they don't affect contiguity.
-        // Consider to change this to check IterDomain::isBroadcast instead:
-        // https://github.com/NVIDIA/Fuser/pull/2854#discussion_r1733205035
-        if (size <= 1 || stride == 0) {
-          continue;
-        }
-
-        if (stride != expected_stride) {
-          input_discontig_strides_[fusion_inp].push_back(stride * dtype_size);
-          expected_stride = stride;
-        }
-        expected_stride *= size;
+    std::optional<TensorArgInfo> computed_info;
+    const TensorArgInfo* info = nullptr;
+    if (arg_info_cache != nullptr) {
+      const Val* key = arg_info_keys.at(inp_i);
+      auto it = arg_info_cache->find(key);
+      if (it == arg_info_cache->end()) {
+        it = arg_info_cache->emplace(key, computeTensorArgInfo(input_tv))
+                 .first;
       }
+      info = &it->second;
+    } else {
+      info = &computed_info.emplace(computeTensorArgInfo(input_tv));
+    }
+
+    input_ptrs_[fusion_inp] = info->ptr;
+    if (info->alloc_sizes.has_value()) {
+      input_sizes_.emplace(fusion_inp, *info->alloc_sizes);
+      input_strides_elements_.emplace(fusion_inp, *info->alloc_strides);
+    }
+    input_discontig_strides_[fusion_inp] = info->discontig_strides;
+    alignment_map_[input_tv] = info->alignment;
+  }
+}
+
+TensorArgInfo SchedulerRuntimeInfo::computeTensorArgInfo(
+    TensorView* input_tv) {
+  TensorArgInfo info;
+  const auto& metadata =
+      expression_evaluator_->evaluate(IrBuilder::metadataExpr(input_tv));
+  const auto& alloc_sizes = metadata->*&TensorMetaData::alloc_size;
+  const auto& alloc_strides = metadata->*&TensorMetaData::alloc_stride;
+  NVF_ERROR(alloc_sizes.size() == alloc_strides.size());
+
+  info.ptr = (size_t)(metadata->*&TensorMetaData::data);
+
+  std::optional<std::vector<int64_t>> alloc_perm_opt =
+      ir_utils::computePermutation(
+          TensorDomain::noReductions(input_tv->getLogicalDomain()),
+          TensorDomain::noReductions(input_tv->getMaybeAllocationDomain()));
+  if (alloc_perm_opt.has_value()) {
+    // Save the strides in order of allocation domain in case the
+    // allocation domain is a permutation of RFactor domain
+    // NOTE: alloc_sizes and alloc_strides are already in order of
+    // allocation domain
+    info.alloc_sizes = alloc_sizes.vec();
+    info.alloc_strides = alloc_strides.vec();
+  }
+
+  // find and push discontiguous stride
+  int64_t dtype_size = dataTypeSizeByte(input_tv->dtype());
+  auto dims = static_cast<int64_t>(alloc_strides.size());
+  int64_t expected_stride = 1;
+  for (int64_t dim = dims - 1; dim >= 0; dim--) {
+    auto size = alloc_sizes.at(dim);
+    auto stride = alloc_strides.at(dim);
+    // Skip broadcast dimensions because they don't affect contiguity.
+    // Consider to change this to check IterDomain::isBroadcast instead:
+    // https://github.com/NVIDIA/Fuser/pull/2854#discussion_r1733205035
+    if (size <= 1 || stride == 0) {
+      continue;
     }
+
+    if (stride != expected_stride) {
+      info.discontig_strides.push_back(stride * dtype_size);
+      expected_stride = stride;
+    }
+    expected_stride *= size;
+  }
+
+  info.alignment = computeAlignmentSize(info.ptr);
+  for (auto stride : info.discontig_strides) {
+    info.alignment = std::min(info.alignment, computeAlignmentSize(stride));
   }
+  return info;
 }
 
 // TODO: Output tensors could have an alignment that is not 16 Bytes passed in
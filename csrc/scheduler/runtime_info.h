@@ -19,6 +19,27 @@ namespace nvfuser {
 
 class ExpressionEvaluator;
 
+//! Runtime facts of a tensor argument of a fusion, which only depend on the
+//! tensor and the allocation domain of its TensorView
+struct TensorArgInfo {
+  // Data pointer address
+  size_t ptr = 0;
+  // Sizes and strides in elements ordered like the allocation domain. Only
+  // set if the allocation domain is a permutation of the logical domain.
+  std::optional<std::vector<int64_t>> alloc_sizes;
+  std::optional<std::vector<int64_t>> alloc_strides;
+  // Strides in bytes of the discontiguous dimensions
+  std::vector<size_t> discontig_strides;
+  // Alignment in bytes of the pointer and of the discontiguous strides
+  size_t alignment = 0;
+};
+
+//! The TensorArgInfo of one set of arguments, shared by the
+//! SchedulerRuntimeInfos of the segments of a fusion. Entries are keyed by the
+//! Vals of the complete fusion, so that a tensor consumed by several segments
+//! is only analyzed once.
+using TensorArgInfoCache = std::unordered_map<const Val*, TensorArgInfo>;
+
 //!  SchedulerRuntimeInfo is the abstraction introduced in
 //! this PR for passing runtime input dependent information
 //! to the schedulers and kernel caches.
@@ -45,12 +66,17 @@ class SchedulerRuntimeInfo : public NonCopyable {
   //! The index type of forced_index_type is used if given, no matter
   //! how large the actual arguments and fusion tensors
   //! are. CORRECTNESS IS NOT GUARANTEED.
+  //!
+  //! If arg_info_cache is given, the TensorArgInfo of the i-th input is looked
+  //! up in and added to it with arg_info_keys[i] as the key.
   SchedulerRuntimeInfo(
       Fusion* complete_fusion,
       KernelArgumentHolder args,
       PrecomputedValues* precomputed_values = nullptr,
       const std::vector<TensorView*>& all_tvs = {},
-      std::optional<PrimDataType> forced_index_type = std::nullopt);
+      std::optional<PrimDataType> forced_index_type = std::nullopt,
+      TensorArgInfoCache* arg_info_cache = nullptr,
+      const std::vector<Val*>& arg_info_keys = {});
 
   //! Lookup for the alignment sizes of the given tv. Currently only returns
   //!  actual alignment info for input tensors to the complete fusion,
@@ -115,6 +141,9 @@ class SchedulerRuntimeInfo : public NonCopyable {
       const KernelArgumentHolder& inputs,
       PrecomputedValues* precomputed_values);
 
+  // Computes the TensorArgInfo of a fusion input from its metadata
+  TensorArgInfo computeTensorArgInfo(TensorView* input_tv);
+
   bool isInputTv(TensorView* tv) const {
     return std::find(
                complete_fusion_->inputs().begin(),
@@ -0,0 +1,109 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+
+#include <id_model/id_model.h>
+#include <ir/all_nodes.h>
+#include <ir/utils.h>
+#include <scheduler/tools/rotary_embedding.h>
+
+namespace nvfuser {
+namespace scheduler_tools {
+
+namespace {
+
+// Returns the slice producing an input of a cat through the pad of the
+// cat and, if negated, a negation
+SliceOp* getSlicedHalf(Val* cat_input, bool negated) {
+  auto pad = dynamic_cast<PadOp*>(cat_input->definition());
+  if (pad == nullptr) {
+    return nullptr;
+  }
+  Val* in = pad->in();
+  if (negated) {
+    auto uop = dynamic_cast<UnaryOp*>(in->definition());
+    if (uop == nullptr || uop->getUnaryOpType() != UnaryOpType::Neg) {
+      return nullptr;
+    }
+    in = uop->in();
+  }
+  auto slice = dynamic_cast<SliceOp*>(in->definition());
+  if (slice == nullptr) {
+    return nullptr;
+  }
+
+  // Only the innermost dimension may be sliced, with a unit step
+  const auto logical =
+      TensorDomain::noReductions(slice->out()->getLogicalDomain());
+  if (logical.empty() ||
+      std::any_of(logical.begin(), logical.end() - 1, [](IterDomain* id) {
+        return id->definition() != nullptr;
+      })) {
+    return nullptr;
+  }
+  if (!slice->getRanges().back().step->isOneInt()) {
+    return nullptr;
+  }
+  return slice;
+}
+
+} // namespace
+
+std::optional<RotaryEmbeddingInfo> getMaybeRotaryEmbeddingInfo(
+    TensorView* ref_tv) {
+  Fusion* fusion = ref_tv->fusion();
+  const auto ref_logical =
+      TensorDomain::noReductions(ref_tv->getLogicalDomain());
+  if (ref_logical.empty()) {
+    return std::nullopt;
+  }
+
+  std::optional<IdModel> id_model;
+  for (auto cat : ir_utils::getOpsOfType<CatOp>(fusion)) {
+    auto cat_out = cat->output(0)->as<TensorView>();
+    const auto cat_logical =
+        TensorDomain::noReductions(cat_out->getLogicalDomain());
+    if (cat->inputs().size() != 2 ||
+        cat->concatenatedDim() != std::ssize(cat_logical) - 1) {
+      continue;
+    }
+
+    // cat({-x[..., h/2:], x[..., :h/2]}, -1)
+    SliceOp* negated_half = getSlicedHalf(cat->input(0), /*negated=*/true);
+    SliceOp* half = getSlicedHalf(cat->input(1), /*negated=*/false);
+    if (negated_half == nullptr || half == nullptr ||
+        negated_half->in() != half->in() ||
+        !half->getRanges().back().start->isZeroInt()) {
+      continue;
+    }
+
+    if (!id_model.has_value()) {
+      id_model.emplace(fusion, /*build_graphs=*/false);
+      id_model->buildExactGraph();
+    }
+    if (!id_model->idGraph(IdMappingMode::EXACT)
+             .disjointValSets()
+             .strictAreMapped(cat_logical.back(), ref_logical.back())) {
+      continue;
+    }
+
+    TensorView* rotated_input_tv = half->in();
+    return RotaryEmbeddingInfo{
+        .rotated_input_tv = rotated_input_tv,
+        .rotated_tv = cat_out,
+        .extent = TensorDomain::noReductions(
+                      rotated_input_tv->getLogicalDomain())
+                      .back()
+                      ->extent(),
+        .negated_half_start = negated_half->getRanges().back().start,
+        .half_stop = half->getRanges().back().stop};
+  }
+  return std::nullopt;
+}
+
+} // namespace scheduler_tools
+} // namespace nvfuser
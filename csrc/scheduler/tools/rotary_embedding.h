@@ -0,0 +1,61 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <optional>
+
+namespace nvfuser {
+
+class TensorView;
+class Val;
+
+namespace scheduler_tools {
+
+// Rotary position embeddings (RoPE) rotate the halves of the innermost
+// dimension of Q and K:
+//
+// t0: [i0, i1, h]
+// t1 = slice(t0, {0, 0, h/2}, {i0, i1, h}) // [i0, i1, h/2]
+// t2 = neg(t1)
+// t3 = slice(t0, {0, 0, 0}, {i0, i1, h/2}) // [i0, i1, h/2]
+// t4 = cat({t2, t3}, -1) // [i0, i1, h]
+// t5 = t0 * cos + t4 * sin
+//
+// Each element of t5 reads the element of t0 at the same position and
+// the one half a row away. The resize scheduler handles the slices and
+// the cat generically, with threads computing consecutive elements, so
+// the two reads of each element of t0 come from different threads.
+//
+// getMaybeRotaryEmbeddingInfo detects the cat of the rotated halves.
+// When its innermost dimension is mapped to the one of the reference
+// tensor, the resize scheduler splits the latter into the two halves
+// and computes both in the same thread: each thread then reads the
+// pairs of elements of t0 it needs with vectorized loads, the second
+// read of each hitting L1, and reads cos and sin where it writes.
+struct RotaryEmbeddingInfo {
+  // Tensor whose halves are rotated. In the above example, this
+  // corresponds to t0.
+  TensorView* rotated_input_tv = nullptr;
+  // Cat of the rotated halves. In the above example, this
+  // corresponds to t4.
+  TensorView* rotated_tv = nullptr;
+  // The extent of the innermost dimension of rotated_input_tv and the
+  // offsets of the halves, which must be half of it at run time
+  Val* extent = nullptr;
+  Val* negated_half_start = nullptr;
+  Val* half_stop = nullptr;
+};
+
+// Returns the first rotation of halves whose innermost dimension is
+// exact mapped to the innermost logical dimension of ref_tv
+std::optional<RotaryEmbeddingInfo> getMaybeRotaryEmbeddingInfo(
+    TensorView* ref_tv);
+
+} // namespace scheduler_tools
+
+} // namespace nvfuser
@@ -9,12 +9,15 @@
 #include <ATen/cuda/CUDAContext.h>
 #include <debug.h>
 #include <instrumentation.h>
+#include <scheduler/autotune.h>
 #include <scheduler/debug_utils.h>
+#include <scheduler/heuristic_plugin.h>
 #include <scheduler/reduction_utils.h>
 #include <scheduler/registry_utils.h>
 #include <scheduler/runtime_info.h>
 #include <scheduler/tools/inlining.h>
 #include <scheduler/transpose.h>
+#include <scheduler/transpose_tma.h>
 #include <scheduler/utils.h>
 #include <scheduler/vectorize_helper.h>
 
@@ -374,13 +377,18 @@ getReferenceTensors(
   auto reference_tensors_entry =
       HeuristicDataCacheEntry<HeuristicCompileTime::ReferenceTensorsForGroups>(
           data_cache, [&domain_map, &grouped_inputs_outputs]() {
-            std::vector<TensorView*> data{
-                domain_map.findReferenceFor(grouped_inputs_outputs[0]),
-                domain_map.findReferenceFor(grouped_inputs_outputs[1])};
+            // The references of the groups after the first two may be
+            // missing, in which case those groups aren't tiled. See note
+            // [Tiling more than two groups]
+            std::vector<TensorView*> data;
+            data.reserve(grouped_inputs_outputs.size());
+            for (const auto& group : grouped_inputs_outputs) {
+              data.push_back(domain_map.findReferenceFor(group));
+            }
             return std::make_unique<std::vector<TensorView*>>(std::move(data));
           });
   auto& reference_tensors = reference_tensors_entry.get();
-  NVF_ERROR(reference_tensors.size() == 2);
+  NVF_ERROR(reference_tensors.size() >= 2);
   TensorView* reference1 = reference_tensors[0];
   TensorView* reference2 = reference_tensors[1];
   NVF_ERROR(
@@ -427,6 +435,10 @@ getInnerMostDimInfoInReference(
             std::vector<int64_t> data;
             data.reserve(group_references.size());
             for (auto ref_tv : group_references) {
+              if (ref_tv == nullptr) {
+                data.push_back(-1);
+                continue;
+              }
               auto inner_most_id = scheduler_utils::innerMostAllocDim(ref_tv);
               auto inner_most_pos_in_global_ref =
                   domain_map.getInnerLeafDim(global_reference, inner_most_id);
@@ -576,6 +588,92 @@ std::string getTransposeRuntimeRejectReason(
   return "";
 }
 
+// Note [Tiling more than two groups]
+//
+// Tensors are grouped by their inner most dims. The tile covers the inner most
+// dims of the first two groups. It's read and written with the inner most dim
+// of the first group innermost, and staged in shared memory for the second
+// group, which is accessed with its own inner most dim innermost. A fusion
+// mixing several permutations, e.g., the layout conversions of vision models,
+// has more groups. The inner most dims of those groups are not in the tile, so
+// their tensors would be accessed one element per tile along their contiguous
+// dims.
+//
+// Instead, the inner most dims of the following groups are tiled too, with
+// extra_tile_sizes, and each of these groups is staged in its own shared memory
+// buffers and scheduled like the second group. Every tiled group multiplies
+// the elements of the tile, so these tiles are small, and groups are only
+// tiled while the tile stays within max_elements_per_tile, the grid fills a
+// wave and the staging buffers fit in shared memory. The remaining groups are
+// accessed like the first group. Virtual inner most dims and view ops are not
+// supported with extra tiled groups.
+void setExtraGroupTiles(
+    TransposeParams* tparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference1,
+    const std::vector<TensorView*>& reference_tensors,
+    const std::vector<int64_t>& innermost_info,
+    const std::vector<int64_t>& shape_in_ref1,
+    int64_t n_elems,
+    int64_t device_multiprocessor_count,
+    const std::vector<std::vector<TensorView*>>& grouped_inputs_outputs,
+    int64_t max_unroll_factor) {
+  if (tparams->use_tma || !tparams->split_before_tiling.empty() ||
+      !tparams->dims_merged_with_1.empty() ||
+      !tparams->dims_merged_with_2.empty() ||
+      !scheduler_utils::getViewTVs(fusion).empty()) {
+    return;
+  }
+  constexpr int64_t extra_tile_size = 8;
+  constexpr int64_t max_elements_per_tile =
+      TransposeParams::getDefaultTileSize() *
+      TransposeParams::getDefaultTileSize() * extra_tile_size;
+  const auto index_type = runtime_info.getIndexType();
+  // Bytes of the staging buffers of a group per element of the tile
+  auto smem_bytes_per_element = [index_type](
+                                    const std::vector<TensorView*>& group) {
+    int64_t bytes = 0;
+    for (auto tv : group) {
+      bytes += dataTypeSizeByte(tv->getDataType().value(), index_type);
+    }
+    return bytes;
+  };
+  const int64_t available_smem = (int64_t)deviceAvailableSharedMemoryBytes();
+  int64_t staged_bytes_per_element =
+      smem_bytes_per_element(grouped_inputs_outputs[1]);
+  std::unordered_set<int64_t> tiled_dims{innermost_info[0], innermost_info[1]};
+
+  for (int64_t group : arange(2, std::ssize(grouped_inputs_outputs))) {
+    const int64_t inner_most_pos = innermost_info.at(group);
+    if (reference_tensors.at(group) == nullptr || inner_most_pos < 0 ||
+        tiled_dims.count(inner_most_pos) > 0 ||
+        shape_in_ref1.at(inner_most_pos) < extra_tile_size) {
+      return;
+    }
+    const int64_t elements_per_tile =
+        tparams->getElementsPerTile() * extra_tile_size;
+    staged_bytes_per_element +=
+        smem_bytes_per_element(grouped_inputs_outputs[group]);
+    if (elements_per_tile > max_elements_per_tile ||
+        n_elems < device_multiprocessor_count * elements_per_tile ||
+        staged_bytes_per_element * elements_per_tile > available_smem) {
+      return;
+    }
+    tiled_dims.insert(inner_most_pos);
+    tparams->extra_tile_sizes.push_back(extra_tile_size);
+    tparams->extra_vectorize_factors.push_back(std::min(
+        extra_tile_size,
+        vectorize_helper::getVectorizationFactorTransposeGroup(
+            runtime_info,
+            reference1,
+            inner_most_pos,
+            /*dims_to_merge=*/{},
+            grouped_inputs_outputs[group],
+            max_unroll_factor)));
+  }
+}
+
 } // namespace
 
 bool hasAtLeastTwoValidGroups(Fusion* fusion) {
@@ -734,6 +832,8 @@ std::unique_ptr<TransposeParams> getTransposeHeuristics(
   // TODO 2: Small transpose dimensions transformation should also consider the
   // vectorization impact. i.e. when split_before_tiling, we should try to split
   // on a factor that allows vectorization.
+  int64_t supported_vectorize_factor1 = 1;
+  int64_t supported_vectorize_factor2 = 1;
   {
     // duplicating reference1's TensorDomain, since the transformations applied
     // is not persistent and only needed for us to compute vectorization width.
@@ -772,10 +872,60 @@ std::unique_ptr<TransposeParams> getTransposeHeuristics(
             tparams->dims_merged_with_2,
             grouped_inputs_outputs[1],
             max_unroll_factor);
+
+    // A heuristic plugin may vectorize beyond the unrolling limits above up
+    // to what the data types allow
+    if (heuristic_plugin::hasPlugin()) {
+      supported_vectorize_factor1 =
+          vectorize_helper::getVectorizationFactorTransposeGroup(
+              runtime_info,
+              reference1,
+              inner_most_pos1_in_ref1,
+              tparams->dims_merged_with_1,
+              grouped_inputs_outputs[0],
+              kSixteen / max_io_dtype_size);
+      supported_vectorize_factor2 =
+          vectorize_helper::getVectorizationFactorTransposeGroup(
+              runtime_info,
+              reference1,
+              inner_most_pos2_in_ref1,
+              tparams->dims_merged_with_2,
+              grouped_inputs_outputs[1],
+              kSixteen / max_io_dtype_size);
+    }
   }
 
+  // The TMA mode picks its own tiles and vectorization, which the heuristic
+  // plugin isn't aware of
+  const bool use_tma = transpose_tma::getHeuristics(
+      tparams.get(), fusion, runtime_info, grouped_inputs_outputs, n_elems);
+
+  setExtraGroupTiles(
+      tparams.get(),
+      fusion,
+      runtime_info,
+      reference1,
+      reference_tensors,
+      innermost_info,
+      shape_in_ref1,
+      n_elems,
+      device_multiprocessor_count,
+      grouped_inputs_outputs,
+      max_unroll_factor);
+
   tparams->lparams.bind(tparams->getThreadsPerBlock(), ParallelType::TIDx);
 
+  // The heuristic plugin only knows about two groups
+  if (!use_tma && tparams->extra_tile_sizes.empty()) {
+    heuristic_plugin::updateTransposeParams(
+        tparams.get(),
+        fusion,
+        runtime_info,
+        reference1,
+        supported_vectorize_factor1,
+        supported_vectorize_factor2);
+  }
+
   if (isDebugDumpEnabled(DebugDumpOption::SchedulerDebug)) {
     debug() << "\n===== Transpose Stats ========\n"
             << "inputs: " << ir_utils::toString(fusion->inputs()) << "\n"
@@ -794,6 +944,15 @@ std::unique_ptr<TransposeParams> getTransposeHeuristics(
             << "reference2: " << reference2->toString() << "\n"
             << "inner_most_id2 position: " << inner_most_pos2_in_ref1
             << " (in reference 1)" << std::endl;
+    for (auto i : arange(std::ssize(tparams->extra_tile_sizes))) {
+      debug() << "group " << i + 3 << ": "
+              << ir_utils::toString(grouped_inputs_outputs[i + 2]) << "\n"
+              << "reference" << i + 3 << ": "
+              << reference_tensors[i + 2]->toString() << "\n"
+              << "inner_most_id" << i + 3
+              << " position: " << innermost_info[i + 2] << " (in reference 1)"
+              << std::endl;
+    }
     if (hasSmallTransposeDimensions(tparams)) {
       debug() << "small transposed dim, needs virtual inner-most dim"
               << std::endl;
@@ -806,6 +965,11 @@ std::unique_ptr<TransposeParams> getTransposeHeuristics(
 }
 
 void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
+  if (tparams->use_tma) {
+    transpose_tma::scheduleFusion(fusion, tparams);
+    return;
+  }
+
   FusionGuard fg(fusion);
 
   // Make sure we don't have global memory set on intermediate tensors from
@@ -857,6 +1021,11 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
   auto grouped_inputs_outputs = domain_map.groupInputsOutputsByInnerDim();
   NVF_ERROR(grouped_inputs_outputs.size() >= 2);
 
+  // See note [Tiling more than two groups]
+  const int64_t n_extra_groups = std::ssize(tparams->extra_tile_sizes);
+  NVF_ERROR(std::ssize(grouped_inputs_outputs) >= 2 + n_extra_groups);
+  const int64_t n_tiles = 2 + n_extra_groups;
+
   /*
    * We need something similar to `cacheFork` for input tensors in group 2. We
    * need this because we will want to propagate to the entire DAG except group
@@ -870,28 +1039,54 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
    * if groups = {{t1, t2}, {t0}}, then removing {t0, cache} from the DAG will
    * make it disconnected.
    */
-  std::unordered_set<TensorView*> group2_and_cached_inputs(
-      grouped_inputs_outputs[1].begin(), grouped_inputs_outputs[1].end());
-  for (auto tv : grouped_inputs_outputs[1]) {
-    if (tv->isFusionInput()) {
-      auto existing_cache = ir_utils::consumerTvsOf(tv)[0];
-      if (ir_utils::consumerTvsOf(existing_cache).size() > 1) {
-        auto new_cache = tv->cacheAfter();
-        new_cache->setMemoryType(MemoryType::Shared);
-        group2_and_cached_inputs.emplace(new_cache);
-      } else {
-        existing_cache->setMemoryType(MemoryType::Shared);
-        group2_and_cached_inputs.emplace(existing_cache);
+  auto stage_group = [&cached_outputs](const std::vector<TensorView*>& group) {
+    std::unordered_set<TensorView*> group_and_cached_inputs(
+        group.begin(), group.end());
+    for (auto tv : group) {
+      if (tv->isFusionInput()) {
+        auto existing_cache = ir_utils::consumerTvsOf(tv)[0];
+        if (ir_utils::consumerTvsOf(existing_cache).size() > 1) {
+          auto new_cache = tv->cacheAfter();
+          new_cache->setMemoryType(MemoryType::Shared);
+          group_and_cached_inputs.emplace(new_cache);
+        } else {
+          existing_cache->setMemoryType(MemoryType::Shared);
+          group_and_cached_inputs.emplace(existing_cache);
+        }
       }
     }
-  }
-  // set cached outputs of group 2 to shared memory
-  for (auto pair : cached_outputs) {
-    auto cached_output = pair.first;
-    auto output = pair.second;
-    if (group2_and_cached_inputs.count(output) > 0) {
-      cached_output->setMemoryType(MemoryType::Shared);
+    // set cached outputs of the group to shared memory
+    for (auto pair : cached_outputs) {
+      auto cached_output = pair.first;
+      auto output = pair.second;
+      if (group_and_cached_inputs.count(output) > 0) {
+        cached_output->setMemoryType(MemoryType::Shared);
+      }
     }
+    return group_and_cached_inputs;
+  };
+  std::unordered_set<TensorView*> group2_and_cached_inputs =
+      stage_group(grouped_inputs_outputs[1]);
+  // The groups after the first two are staged the same way, each in its own
+  // shared memory buffers
+  std::vector<std::unordered_set<TensorView*>> extra_groups_and_cached_inputs;
+  std::vector<TensorView*> extra_references;
+  for (auto i : arange(n_extra_groups)) {
+    extra_groups_and_cached_inputs.push_back(
+        stage_group(grouped_inputs_outputs[i + 2]));
+    TensorView* reference =
+        domain_map.findReferenceFor(grouped_inputs_outputs[i + 2]);
+    NVF_ERROR(
+        reference != nullptr,
+        "Could not find a reference tensor for group ",
+        i + 3);
+    extra_references.push_back(reference);
+  }
+  // All tensors staged in shared memory
+  std::unordered_set<TensorView*> staged_tvs = group2_and_cached_inputs;
+  for (const auto& group_and_cached_inputs : extra_groups_and_cached_inputs) {
+    staged_tvs.insert(
+        group_and_cached_inputs.begin(), group_and_cached_inputs.end());
   }
 
   TensorView* reference1 =
@@ -968,14 +1163,26 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
   reference1->split(inner_most_pos2_in_ref1, tparams->tile_size2);
   reference1->reorder({{inner_most_pos2_in_ref1 + 1, -1}});
   // [..., I1/tile1, .., I2/tile2, ..., tile1, tile2]
+  // There are no virtual inner most dims with extra tiles, so their positions
+  // weren't changed by the merges above
+  for (auto i : arange(n_extra_groups)) {
+    const int64_t inner_most_pos_in_ref1 = domain_map.getInnerLeafDim(
+        reference1, scheduler_utils::innerMostAllocDim(extra_references[i]));
+    NVF_ERROR(
+        inner_most_pos_in_ref1 >= 0, "getInnerLeafDim cannot be resolved");
+    reference1->split(inner_most_pos_in_ref1, tparams->extra_tile_sizes[i]);
+    reference1->reorder({{inner_most_pos_in_ref1 + 1, -1}});
+  }
+  // [..., I1/tile1, .., I2/tile2, ..., tile1, tile2, extra tiles...]
 
   // Merge remaining dimensions ignoring reduction axes (See Issue #2317)
   // The reduction axes cannot be at any position.
   // For example: [i0, r1, i1, r2, i2] after tiling is [i0, r1, i1/tile1, r2,
   // i2/tile2, tile1, tile2] The following code merges all the outer iterdomains
   // as: [i0 * i1/tile1 * i2/tile2, r1, r2, tile1, tile2]
-  int64_t rhs_i = reference1->nDims() - 3;
-  for (int64_t lhs_i = reference1->nDims() - 4; lhs_i >= 0; lhs_i--) {
+  int64_t rhs_i = reference1->nDims() - n_tiles - 1;
+  for (int64_t lhs_i = reference1->nDims() - n_tiles - 2; lhs_i >= 0;
+       lhs_i--) {
     if (reference1->axis(lhs_i)->isReduction() ||
         reference1->axis(lhs_i)->isDeviceDim()) {
       continue;
@@ -990,12 +1197,12 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
   }
 
   reference1->split(rhs_i, 1);
-  // [r.., merged_dim, 1, tile1, tile2]
+  // [r.., merged_dim, 1, tile1, tile2, extra tiles...]
 
   // parallelize non-tile dimensions
   reference1->axis(rhs_i + 1)->parallelize(ParallelType::Unswitch);
   reference1->axis(rhs_i)->parallelize(ParallelType::BIDx);
-  // [BIDx, Unswitch, tile1, tile2]
+  // [BIDx, Unswitch, tile1, tile2, extra tiles...]
 
   // Propagate transformations so far to the entire DAG
   TransformPropagator propagator(reference1);
@@ -1038,84 +1245,133 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
   // transform tile for vectorization/unroll
   // See note [vectorization and unroll of input and output]
 
-  int64_t pos = reference2->nDims() - 2;
-  // [..., tile1, tile2]
-  moveReductionsOut(reference2, 2);
-  reference2->merge(pos);
-  reference2->split(pos, tparams->vectorize_factor2);
-  reference2->split(pos, tparams->getThreadsPerBlock());
-  // [..., Unroll, TIDx, Vectorize]
-
-  // Propagate transformations of reference2 to the entire DAG except
-  // group 1. We actually only want to propagate to the fusion outputs, but
-  // inputs and outputs themselves are disconnected, so we have to borrow the
-  // entire DAG and use its spanning tree.
-  {
-    auto all_tvs_except1 = ir_utils::allTvsExcept(
-        fusion,
-        {grouped_inputs_outputs[0].begin(), grouped_inputs_outputs[0].end()});
-    SetSelector selector({all_tvs_except1.begin(), all_tvs_except1.end()});
-    MaxLogicalDomainInfoSpanningTree entire_dag_except1(reference2, &selector);
-    TransformPropagator propagator(reference2);
-    entire_dag_except1.traverse(&propagator);
-  }
-
-  // parallelize group2 and its cached inputs
-  {
-    if (tparams->vectorize_factor2 > 1) {
-      reference2->axis(-1)->parallelize(ParallelType::Vectorize);
+  // Moves the tile of a group innermost and splits the tiles for
+  // vectorization and unroll
+  // [..., tiles...] -> [..., Unroll, TIDx, Vectorize]
+  auto schedule_tiles = [&](TensorView* reference,
+                            int64_t tile,
+                            int64_t vectorize_factor) {
+    const int64_t pos = reference->nDims() - n_tiles;
+    if (tile != n_tiles - 1) {
+      reference->reorder({{pos + tile, -1}});
+    }
+    moveReductionsOut(reference, n_tiles);
+    for (int64_t i = 0; i < n_tiles - 1; i++) {
+      reference->merge(pos);
     }
-    reference2->axis(-2)->parallelize(ParallelType::TIDx);
-    reference2->axis(-3)->parallelize(ParallelType::Unroll);
+    reference->split(pos, vectorize_factor);
+    reference->split(pos, tparams->getThreadsPerBlock());
+  };
 
-    ComputeAtMap ca_map(fusion);
+  // Schedules a group staged in shared memory from its reference. excluded
+  // are the tensors the schedule is not propagated to.
+  auto schedule_staged_group =
+      [&](TensorView* reference,
+          int64_t tile,
+          int64_t vectorize_factor,
+          const std::unordered_set<TensorView*>& group_and_cached_inputs,
+          const std::unordered_set<TensorView*>& excluded) {
+        schedule_tiles(reference, tile, vectorize_factor);
+
+        // Propagate transformations of the reference to the entire DAG except
+        // the excluded tensors. We actually only want to propagate to the
+        // fusion outputs, but inputs and outputs themselves are disconnected,
+        // so we have to borrow the entire DAG and use its spanning tree.
+        {
+          auto all_tvs_except = ir_utils::allTvsExcept(fusion, excluded);
+          SetSelector selector({all_tvs_except.begin(), all_tvs_except.end()});
+          MaxLogicalDomainInfoSpanningTree entire_dag_except(
+              reference, &selector);
+          TransformPropagator propagator(reference);
+          entire_dag_except.traverse(&propagator);
+        }
 
-    scheduler_utils::parallelizeAllLike(
-        reference2,
-        {group2_and_cached_inputs.begin(), group2_and_cached_inputs.end()},
-        {ParallelType::TIDx});
+        // parallelize the group and its cached inputs
+        if (vectorize_factor > 1) {
+          reference->axis(-1)->parallelize(ParallelType::Vectorize);
+        }
+        reference->axis(-2)->parallelize(ParallelType::TIDx);
+        reference->axis(-3)->parallelize(ParallelType::Unroll);
+
+        ComputeAtMap ca_map(fusion);
+
+        scheduler_utils::parallelizeAllLike(
+            reference,
+            {group_and_cached_inputs.begin(), group_and_cached_inputs.end()},
+            {ParallelType::TIDx});
+
+        // Only vectorize the axes that exactly maps to the vectorized axes
+        //  on reference as support for permissively mapped axes are not
+        //  yet clearly defined.
+        std::vector<TensorView*> vectorized_group_cached_inputs;
+        for (auto gin : group_and_cached_inputs) {
+          if (std::any_of(
+                  gin->getLoopDomain().begin(),
+                  gin->getLoopDomain().end(),
+                  [&ca_map, reference](IterDomain* id) {
+                    return ca_map.areMapped(
+                        id, reference->axis(-1), IdMappingMode::EXACT);
+                  })) {
+            vectorized_group_cached_inputs.push_back(gin);
+          }
+        }
+        if (!vectorized_group_cached_inputs.empty()) {
+          scheduler_utils::parallelizeAllLike(
+              reference,
+              vectorized_group_cached_inputs,
+              {ParallelType::Vectorize});
+        }
 
-    // Only vectorize the axes that exactly maps to the vectorized axes
-    //  on reference as support for permissively mapped axes are not
-    //  yet clearly defined.
-    std::vector<TensorView*> vectorized_group2_cached_inputs;
-    for (auto gin : group2_and_cached_inputs) {
-      if (std::any_of(
-              gin->getLoopDomain().begin(),
-              gin->getLoopDomain().end(),
-              [&ca_map, reference2](IterDomain* id) {
-                return ca_map.areMapped(
-                    id, reference2->axis(-1), IdMappingMode::EXACT);
-              })) {
-        vectorized_group2_cached_inputs.push_back(gin);
+        // Only unroll the axes that exactly maps to the unrolled axes
+        //  on reference as support for permissively mapped axes are not
+        //  yet clearly defined.
+        std::vector<TensorView*> unrolled_group_cached_inputs;
+        for (auto gin : group_and_cached_inputs) {
+          if (std::any_of(
+                  gin->getLoopDomain().begin(),
+                  gin->getLoopDomain().end(),
+                  [&ca_map, reference](IterDomain* id) {
+                    return ca_map.areMapped(
+                        id, reference->axis(-3), IdMappingMode::EXACT);
+                  })) {
+            unrolled_group_cached_inputs.push_back(gin);
+          }
+        }
+        if (!unrolled_group_cached_inputs.empty()) {
+          scheduler_utils::parallelizeAllLike(
+              reference, unrolled_group_cached_inputs, {ParallelType::Unroll});
+        }
+      };
+
+  // Each staged group is scheduled without touching group 1 and the other
+  // staged groups. Group 1 is scheduled last, so the tensors between the
+  // groups end up with its schedule.
+  const std::unordered_set<TensorView*> group1(
+      grouped_inputs_outputs[0].begin(), grouped_inputs_outputs[0].end());
+  auto excluded_for = [&](const std::unordered_set<TensorView*>& group) {
+    std::unordered_set<TensorView*> excluded = group1;
+    for (auto tv : staged_tvs) {
+      if (group.count(tv) == 0) {
+        excluded.insert(tv);
       }
     }
-    if (!vectorized_group2_cached_inputs.empty()) {
-      scheduler_utils::parallelizeAllLike(
-          reference2,
-          vectorized_group2_cached_inputs,
-          {ParallelType::Vectorize});
-    }
+    return excluded;
+  };
 
-    // Only unroll the axes that exactly maps to the unrolled axes
-    //  on reference as support for permissively mapped axes are not
-    //  yet clearly defined.
-    std::vector<TensorView*> unrolled_group2_cached_inputs;
-    for (auto gin : group2_and_cached_inputs) {
-      if (std::any_of(
-              gin->getLoopDomain().begin(),
-              gin->getLoopDomain().end(),
-              [&ca_map, reference2](IterDomain* id) {
-                return ca_map.areMapped(
-                    id, reference2->axis(-3), IdMappingMode::EXACT);
-              })) {
-        unrolled_group2_cached_inputs.push_back(gin);
-      }
-    }
-    if (!unrolled_group2_cached_inputs.empty()) {
-      scheduler_utils::parallelizeAllLike(
-          reference2, unrolled_group2_cached_inputs, {ParallelType::Unroll});
-    }
+  schedule_staged_group(
+      reference2,
+      /*tile=*/1,
+      tparams->vectorize_factor2,
+      group2_and_cached_inputs,
+      excluded_for(group2_and_cached_inputs));
+
+  for (auto i : arange(n_extra_groups)) {
+    schedule_staged_group(
+        extra_references[i],
+        /*tile=*/i + 2,
+        tparams->extra_vectorize_factors[i],
+        extra_groups_and_cached_inputs[i],
+        excluded_for(extra_groups_and_cached_inputs[i]));
   }
 
   //////////////////////////////
@@ -1123,13 +1379,7 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
   //////////////////////////////
 
   // schedule group 1
-  reference1->reorder({{-2, -1}});
-  // [..., tile2, tile1]
-  pos = reference1->nDims() - 2;
-  moveReductionsOut(reference1, 2);
-  reference1->merge(pos);
-  reference1->split(pos, tparams->vectorize_factor1);
-  reference1->split(pos, tparams->getThreadsPerBlock());
+  schedule_tiles(reference1, /*tile=*/0, tparams->vectorize_factor1);
   if (tparams->vectorize_factor1 > 1) {
     reference1->axis(-1)->parallelize(ParallelType::Vectorize);
   }
@@ -1138,17 +1388,17 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
   // [..., Unroll, TIDx, Vectorize]
 
   // Propagate transformations, parallelization of the reference1 to the entire
-  // DAG except group 2 and its corresponding cached outputs.
+  // DAG except the staged groups and their corresponding cached outputs.
   {
-    auto all_tvs_except2 =
-        ir_utils::allTvsExcept(fusion, group2_and_cached_inputs);
-    SetSelector selector({all_tvs_except2.begin(), all_tvs_except2.end()});
+    auto all_tvs_except_staged = ir_utils::allTvsExcept(fusion, staged_tvs);
+    SetSelector selector(
+        {all_tvs_except_staged.begin(), all_tvs_except_staged.end()});
     MaxLogicalDomainInfoSpanningTree entire_dag_except_outputs(
         reference1, &selector);
     TransformPropagator propagator(reference1);
     entire_dag_except_outputs.traverse(&propagator);
     scheduler_utils::parallelizeAllLike(
-        reference1, all_tvs_except2, {ParallelType::TIDx});
+        reference1, all_tvs_except_staged, {ParallelType::TIDx});
   }
 
   // vectorize and unroll group 1's output and cached input
@@ -1210,9 +1460,11 @@ void scheduleTranspose(Fusion* fusion, const TransposeParams* tparams) {
   // Step 5: Cleanup and inline //
   ////////////////////////////////
 
-  // cleanup parallelization from reference1 and reference2 if they are fusion
-  // inputs
-  for (auto tv : {reference1, reference2}) {
+  // cleanup parallelization from the references if they are fusion inputs
+  std::vector<TensorView*> references{reference1, reference2};
+  references.insert(
+      references.end(), extra_references.begin(), extra_references.end());
+  for (auto tv : references) {
     if (tv->isFusionInput()) {
       for (auto id : tv->getLoopDomain()) {
         // DIDs are given as inputs instead of artifacts of this scheduler. So
@@ -1252,6 +1504,7 @@ std::unique_ptr<HeuristicParams> TransposeScheduler::computeHeuristics(
   FUSER_PERF_SCOPE("TransposeScheduler::computeHeuristics");
   auto tparams = getTransposeHeuristics(fusion, runtime_info, data_cache);
   NVF_ERROR(tparams != nullptr);
+  autotune::applyTunedParams(tparams.get(), fusion, runtime_info);
   return tparams;
 }
 
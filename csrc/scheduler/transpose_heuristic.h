@@ -51,6 +51,20 @@ class TransposeParams : public HeuristicParams {
   // Tile size for the inner most dim of tensors in the second group
   int64_t tile_size2 = getDefaultTileSize();
 
+  // Tile sizes for the inner most dims of the groups after the first two,
+  // whose tensors are staged in shared memory like those of the second group.
+  // See note [Tiling more than two groups]
+  std::vector<int64_t> extra_tile_sizes = {};
+
+  // Vectorization factors for tensors in the groups after the first two
+  std::vector<int64_t> extra_vectorize_factors = {};
+
+  // Load the tiles of the transposed inputs to swizzled shared memory and
+  // store the tiles of the outputs with TMA, see transpose_tma.h. tile_size1
+  // and vectorize_factor1 then refer to the inputs loaded with TMA, and
+  // tile_size2 and vectorize_factor2 to the outputs.
+  bool use_tma = false;
+
   using HeuristicParams::HeuristicParams;
 
   // Warning: Does not check launch parameters!
@@ -65,7 +79,10 @@ class TransposeParams : public HeuristicParams {
         other->dims_merged_with_2 == dims_merged_with_2 &&
         other->vectorize_factor1 == vectorize_factor1 &&
         other->vectorize_factor2 == vectorize_factor2 &&
-        other->tile_size1 == tile_size1 && other->tile_size2 == tile_size2;
+        other->tile_size1 == tile_size1 && other->tile_size2 == tile_size2 &&
+        other->extra_tile_sizes == extra_tile_sizes &&
+        other->extra_vectorize_factors == extra_vectorize_factors &&
+        other->use_tma == use_tma;
     return attr_equal;
   }
 
@@ -74,9 +91,15 @@ class TransposeParams : public HeuristicParams {
     ss << "\n===== Transpose Parameters ========\n"
        << (tag.empty() ? "" : "Tag: ") << tag << " Transpose Characteristics:\n"
        << " BlckX: " << lparams.bdimx() << "\n";
+    if (use_tma) {
+      ss << " TMA load and store with swizzled shared memory\n";
+    }
     ss << " input tile size: " << tile_size1 << "\n";
     ss << " output tile size: " << tile_size2 << "\n";
-    int64_t elements_per_tile = tile_size1 * tile_size2;
+    for (auto&& [i, tile_size] : enumerate(extra_tile_sizes)) {
+      ss << " group " << i + 3 << " tile size: " << tile_size << "\n";
+    }
+    int64_t elements_per_tile = getElementsPerTile();
     ss << " elements per tile: " << elements_per_tile << "\n";
     int64_t elements_per_thread = elements_per_tile / lparams.bdimx();
     ss << " elements per thread: " << elements_per_thread << "\n";
@@ -94,6 +117,16 @@ class TransposeParams : public HeuristicParams {
     if (unroll_factor2 > 1) {
       ss << "Unroll group 2, Factor: " << unroll_factor2 << "\n";
     }
+    for (auto&& [i, vectorize_factor] : enumerate(extra_vectorize_factors)) {
+      if (vectorize_factor > 1) {
+        ss << "Vectorize group " << i + 3 << ", Factor: " << vectorize_factor
+           << "\n";
+      }
+      int64_t unroll_factor = elements_per_thread / vectorize_factor;
+      if (unroll_factor > 1) {
+        ss << "Unroll group " << i + 3 << ", Factor: " << unroll_factor << "\n";
+      }
+    }
     if (!split_before_tiling.empty() || !dims_merged_with_1.empty() ||
         !dims_merged_with_2.empty()) {
       ss << "Virtual inner-most dim:\n";
@@ -146,17 +179,33 @@ class TransposeParams : public HeuristicParams {
         vectorize_factor1,
         vectorize_factor2,
         tile_size1,
-        tile_size2);
+        tile_size2,
+        extra_tile_sizes,
+        extra_vectorize_factors,
+        use_tma);
   }
 
   std::unique_ptr<HeuristicParams> clone() const override {
     return std::make_unique<TransposeParams>(*this);
   }
 
+  int64_t getElementsPerTile() const {
+    int64_t elements_per_tile = tile_size1 * tile_size2;
+    for (int64_t tile_size : extra_tile_sizes) {
+      elements_per_tile *= tile_size;
+    }
+    return elements_per_tile;
+  }
+
   int64_t getThreadsPerBlock() const {
-    int64_t tile_vectors1 = ceilDiv(tile_size1 * tile_size2, vectorize_factor1);
-    int64_t tile_vectors2 = ceilDiv(tile_size1 * tile_size2, vectorize_factor2);
+    const int64_t elements_per_tile = getElementsPerTile();
+    int64_t tile_vectors1 = ceilDiv(elements_per_tile, vectorize_factor1);
+    int64_t tile_vectors2 = ceilDiv(elements_per_tile, vectorize_factor2);
     int64_t tile_vectors = std::min(tile_vectors1, tile_vectors2);
+    for (int64_t vectorize_factor : extra_vectorize_factors) {
+      tile_vectors =
+          std::min(tile_vectors, ceilDiv(elements_per_tile, vectorize_factor));
+    }
     return std::min(getMaxThreadsPerBlock(), tile_vectors);
   }
 };
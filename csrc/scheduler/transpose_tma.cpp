@@ -0,0 +1,379 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <scheduler/transpose_tma.h>
+
+#include <fusion_profiler.h>
+#include <instrumentation.h>
+#include <ir/utils.h>
+#include <mma_type.h>
+#include <options.h>
+#include <scheduler/cost_model.h>
+#include <scheduler/debug_utils.h>
+#include <scheduler/mma_utils.h>
+#include <scheduler/pointwise_tma.h>
+#include <scheduler/runtime_info.h>
+#include <scheduler/tools/domain_map.h>
+#include <scheduler/tools/inlining.h>
+#include <scheduler/tools/maxinfo_propagator.h>
+#include <scheduler/utils.h>
+#include <transform_replay.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace nvfuser {
+namespace transpose_tma {
+
+namespace {
+
+// cuTensorMapEncodeTiled requires the strides of the tensor to be multiples of
+// 16 bytes. The swizzle modes of a TMA box permute 16 byte chunks within rows
+// of at most 128 bytes, which is also the largest inner extent of a swizzled
+// box.
+constexpr int64_t tma_alignment_bytes = 16;
+constexpr int64_t max_swizzle_bytes = 128;
+constexpr int64_t min_swizzle_bytes = 32;
+
+// Shared memory left for the mbarriers of the TMA loads
+constexpr int64_t smem_overhead_bytes = 1024;
+
+// Blocks that must be resident on each SM, so that the TMA loads of a block
+// overlap with the shared memory transposes of the others
+constexpr int64_t min_blocks_per_sm = 2;
+
+// Returns the index of the group of grouped_inputs_outputs whose tensors are
+// all fusion inputs, or -1 if there isn't exactly one such group out of two.
+// The other group holds all outputs.
+int64_t getTmaLoadGroup(
+    const std::vector<std::vector<TensorView*>>& grouped_inputs_outputs) {
+  if (grouped_inputs_outputs.size() != 2) {
+    return -1;
+  }
+  int64_t load_group = -1;
+  for (auto i : arange(2)) {
+    const std::vector<TensorView*>& group = grouped_inputs_outputs.at(i);
+    if (std::all_of(group.begin(), group.end(), [](TensorView* tv) {
+          return tv->isFusionInput();
+        })) {
+      if (load_group >= 0) {
+        return -1;
+      }
+      load_group = i;
+    }
+  }
+  return load_group;
+}
+
+int64_t innerExtent(TensorView* tv, SchedulerRuntimeInfo& runtime_info) {
+  const std::vector<IterDomain*> logical =
+      TensorDomain::noReductions(tv->getLogicalDomain());
+  return runtime_info.expressionEvaluator()
+      .evaluate(logical.back()->extent())
+      .as<int64_t>();
+}
+
+} // namespace
+
+bool getHeuristics(
+    TransposeParams* tparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const std::vector<std::vector<TensorView*>>& grouped_inputs_outputs,
+    int64_t n_elems) {
+  FUSER_PERF_SCOPE("transpose_tma::getHeuristics");
+  if (!isOptionEnabled(EnableOption::TmaTranspose)) {
+    return false;
+  }
+  auto reject = [](const char* reason) {
+    scheduler_debug_utils::log("Transpose TMA is not used: ", reason);
+    return false;
+  };
+
+  const DeviceDescriptor& desc = cost_model::deviceDescriptor();
+  if (desc.compute_capability_major < 9) {
+    return reject("TMA requires Hopper or newer.");
+  }
+  if (!tparams->split_before_tiling.empty() ||
+      !tparams->dims_merged_with_1.empty() ||
+      !tparams->dims_merged_with_2.empty()) {
+    return reject("small transpose dimensions need virtual inner dimensions.");
+  }
+  if (!scheduler_utils::getViewTVs(fusion).empty()) {
+    return reject("the fusion has view ops.");
+  }
+  for (auto expr : fusion->exprs()) {
+    if (expr->isOneOf<
+            SelectOp,
+            IndexSelectOp,
+            GatherOp,
+            ScatterOp,
+            PadOp,
+            SliceOp>()) {
+      return reject("the fusion has gather, scatter or resize ops.");
+    }
+  }
+
+  const int64_t load_group = getTmaLoadGroup(grouped_inputs_outputs);
+  if (load_group < 0) {
+    return reject("no group of the transpose consists of inputs only.");
+  }
+  const std::vector<TensorView*>& load_tvs =
+      grouped_inputs_outputs.at(load_group);
+  const std::vector<TensorView*> store_tvs =
+      ir_utils::filterByType<TensorView>(fusion->outputs()).vector();
+  if (store_tvs.empty()) {
+    return reject("the fusion has no outputs.");
+  }
+  const int64_t n_dims = scheduler_utils::nLogicalDims(store_tvs.front());
+  for (auto tv : load_tvs) {
+    if (!pointwise_tma::isTmaCompatible(tv, n_dims) ||
+        tv->domain()->hasReduction()) {
+      return reject("a transposed input isn't a contiguous tensor.");
+    }
+    if ((int64_t)runtime_info.getAlignmentSize(tv) < tma_alignment_bytes) {
+      return reject("a transposed input isn't aligned to 16 bytes.");
+    }
+  }
+  for (auto tv : store_tvs) {
+    if (tv->definition() == nullptr || tv->isFusionInput() ||
+        fusion->getOutputAlias(tv).type != AllocationType::New ||
+        !pointwise_tma::isTmaCompatible(tv, n_dims)) {
+      return reject("an output can't be stored with TMA.");
+    }
+  }
+
+  // The rows of the widest transposed input fill the largest swizzle. The
+  // rows of narrower inputs use a smaller swizzle.
+  int64_t max_load_dtype_size = 1;
+  for (auto tv : load_tvs) {
+    max_load_dtype_size =
+        std::max(max_load_dtype_size, dataTypeSizeByte(tv->dtype()));
+  }
+  const int64_t tile_size1 = max_swizzle_bytes / max_load_dtype_size;
+  for (auto tv : load_tvs) {
+    if (tile_size1 * dataTypeSizeByte(tv->dtype()) < min_swizzle_bytes) {
+      return reject("the data types of the transposed inputs differ too much.");
+    }
+  }
+  // tile_size2 is the outer dimension of the input boxes, which swizzleTMABox
+  // splits by 8, and the inner dimension of the output boxes
+  const int64_t tile_size2 = tile_size1;
+
+  const int64_t inner1 = innerExtent(load_tvs.front(), runtime_info);
+  const int64_t inner2 = innerExtent(store_tvs.front(), runtime_info);
+  if (inner1 < tile_size1 || inner2 < tile_size2) {
+    return reject("the transposed dimensions are smaller than a tile.");
+  }
+  for (auto tv : load_tvs) {
+    if ((inner1 * dataTypeSizeByte(tv->dtype())) % tma_alignment_bytes != 0) {
+      return reject("the inner extent of an input isn't a multiple of 16B.");
+    }
+  }
+  for (auto tv : store_tvs) {
+    if ((inner2 * dataTypeSizeByte(tv->dtype())) % tma_alignment_bytes != 0) {
+      return reject("the inner extent of an output isn't a multiple of 16B.");
+    }
+  }
+  int64_t tile_bytes = 0;
+  for (const auto& tvs : {load_tvs, store_tvs}) {
+    for (auto tv : tvs) {
+      tile_bytes += tile_size1 * tile_size2 * dataTypeSizeByte(tv->dtype());
+    }
+  }
+
+  // Threads write the output tiles in their layout, so only the outputs are
+  // vectorized. The vectorization factor of their group accounts for the
+  // inputs of the group, which stay on the regular path.
+  const int64_t vectorize_factor2 = std::min(
+      load_group == 0 ? tparams->vectorize_factor2 : tparams->vectorize_factor1,
+      tile_size2);
+
+  TransposeParams tma_params = *tparams;
+  tma_params.use_tma = true;
+  tma_params.tile_size1 = tile_size1;
+  tma_params.tile_size2 = tile_size2;
+  tma_params.vectorize_factor1 = 1;
+  tma_params.vectorize_factor2 = vectorize_factor2;
+  const int64_t threads_per_block = tma_params.getThreadsPerBlock();
+
+  // TMA only pays off for transposes bound by memory bandwidth, i.e., that
+  // keep all SMs busy with enough resident blocks to hide the latency of the
+  // loads. Smaller transposes are bound by the launch and the regular
+  // schedule, which needs no tensor maps, is as fast.
+  const int64_t blocks_per_sm = std::min(
+      (int64_t)desc.max_shared_memory_per_sm /
+          (tile_bytes + smem_overhead_bytes),
+      (int64_t)desc.max_threads_per_sm / threads_per_block);
+  if (blocks_per_sm < min_blocks_per_sm) {
+    return reject("the tiles don't fit in shared memory.");
+  }
+  const int64_t n_tiles = ceilDiv(inner1, tile_size1) *
+      ceilDiv(inner2, tile_size2) * (n_elems / (inner1 * inner2));
+  if (n_tiles < blocks_per_sm * (int64_t)desc.sm_count) {
+    return reject("the transpose is too small to fill the device.");
+  }
+
+  tma_params.tag = "Transpose TMA heuristics";
+  *tparams = tma_params;
+  return true;
+}
+
+void scheduleFusion(Fusion* fusion, const TransposeParams* tparams) {
+  FusionGuard fg(fusion);
+  NVF_ERROR(tparams->use_tma, "Expected TMA transpose parameters.");
+
+  scheduler_utils::clearMemorySpace(fusion);
+
+  // The groups are found the same way as by getHeuristics, which checked the
+  // runtime requirements of all TMA tensors.
+  std::vector<std::vector<TensorView*>> grouped_inputs_outputs =
+      scheduler_tools::TransposeDomainMap(fusion)
+          .groupInputsOutputsByInnerDim();
+  const int64_t load_group = getTmaLoadGroup(grouped_inputs_outputs);
+  NVF_ERROR(load_group >= 0, "No group of the transpose is loaded with TMA.");
+  const std::unordered_set<TensorView*> load_tv_set(
+      grouped_inputs_outputs.at(load_group).begin(),
+      grouped_inputs_outputs.at(load_group).end());
+
+  auto cached_inputs = scheduler_utils::cacheInputs(fusion, true);
+  auto cached_outputs = scheduler_utils::cacheAndForkOutputs(fusion, true);
+
+  // gmem -> (TMA load) -> swizzled smem -> (transposed load) -> registers
+  std::vector<TensorView*> smem_loads;
+  for (auto cached_input : cached_inputs) {
+    if (load_tv_set.count(ir_utils::getSoleProducerTv(cached_input)) == 0) {
+      continue;
+    }
+    auto ldst = cached_input->definition()->as<LoadStoreOp>();
+    ldst->setOpType(LoadStoreOpType::CpAsyncBulkTensorTile);
+    ldst->setCacheOp(CacheOp::Unspecified);
+    cached_input->setMemoryType(MemoryType::Shared);
+    smem_loads.push_back(cached_input);
+    cached_input->cacheAfter();
+  }
+  NVF_ERROR(!smem_loads.empty(), "No input is loaded with TMA.");
+
+  // registers -> (vectorized store) -> smem -> (TMA store) -> gmem
+  std::vector<TensorView*> smem_stores;
+  std::vector<TensorView*> store_tvs;
+  for (auto [cached_output, output] : cached_outputs) {
+    TensorView* smem_store = cached_output->cacheAfter();
+    smem_store->setMemoryType(MemoryType::Shared);
+    output->definition()->as<LoadStoreOp>()->setOpType(
+        LoadStoreOpType::CpAsyncBulkTensorTile);
+    smem_stores.push_back(smem_store);
+    store_tvs.push_back(output);
+  }
+  NVF_ERROR(!store_tvs.empty(), "No output is stored with TMA.");
+
+  // The domain map is rebuilt for the cached tensors
+  scheduler_tools::TransposeDomainMap domain_map(fusion);
+  grouped_inputs_outputs = domain_map.groupInputsOutputsByInnerDim();
+  TensorView* reference =
+      domain_map.findReferenceFor(grouped_inputs_outputs.at(1 - load_group));
+  TensorView* load_reference =
+      domain_map.findReferenceFor(grouped_inputs_outputs.at(load_group));
+  NVF_ERROR(
+      reference != nullptr && load_reference != nullptr,
+      "Could not find the reference tensors of the TMA transpose.");
+  const int64_t inner_pos1 = domain_map.getInnerLeafDim(
+      reference, scheduler_utils::innerMostAllocDim(load_reference));
+  const int64_t inner_pos2 = domain_map.getInnerLeafDim(
+      reference, scheduler_utils::innerMostAllocDim(reference));
+  NVF_ERROR(
+      inner_pos1 >= 0 && inner_pos2 >= 0 && inner_pos1 != inner_pos2,
+      "getInnerLeafDim cannot be resolved");
+
+  // [..., I1, .., I2, ...]
+  reference->split(inner_pos1, tparams->tile_size1);
+  reference->reorder({{inner_pos1 + 1, -1}});
+  reference->split(inner_pos2, tparams->tile_size2);
+  reference->reorder({{inner_pos2 + 1, -1}});
+  // [..., I1/tile1, .., I2/tile2, ..., tile1, tile2]
+  reference->flatten(0, reference->nDims() - 3);
+  // [tiles, tile1, tile2]
+  TransformPropagator propagator(reference);
+  MaxLogicalDomainInfoSpanningTree(reference).traverse(&propagator);
+
+  // The input tiles are laid out as the inputs, [tiles, tile2, tile1], with
+  // the rows of tile1 swizzled by the TMA loads
+  for (auto tv : smem_loads) {
+    tv->reorder({{1, 2}});
+    tv->swizzleTMABox(getSwizzleFromBytes(
+        tparams->tile_size1 * dataTypeSizeByte(tv->dtype())));
+    tv->setAllocationDomain(tv->getLoopDomain(), true);
+    mma_utils::MmaSwizzler::parallelizeAsBulkSkippingFirstIDs(tv, 1);
+    tv->axis(0)->parallelize(ParallelType::BIDx);
+  }
+  // The output tiles are written row by row, so they need no swizzle
+  for (auto tv : smem_stores) {
+    tv->setAllocationDomain(tv->getLoopDomain(), true);
+  }
+  constexpr int64_t tile_pos = 1;
+  for (auto tv : store_tvs) {
+    tv->axis(0)->parallelize(ParallelType::BIDx);
+    tv->axis(tile_pos)->parallelize(ParallelType::Bulk);
+    tv->axis(tile_pos + 1)->parallelize(ParallelType::Bulk);
+  }
+
+  // Distribute the tile over the threads in the layout of the outputs for
+  // everything but the TMA tensors
+  std::vector<TensorView*> tma_tvs = smem_loads;
+  tma_tvs.insert(tma_tvs.end(), store_tvs.begin(), store_tvs.end());
+  TensorView* thread_ref = smem_stores.front();
+  thread_ref->merge(tile_pos);
+  if (tparams->vectorize_factor2 > 1) {
+    thread_ref->split(tile_pos, tparams->vectorize_factor2);
+  }
+  thread_ref->split(tile_pos, tparams->lparams.bdimx());
+  // [BIDx, tile/vect/TIDx, TIDx, vect]
+  thread_ref->axis(0)->parallelize(ParallelType::BIDx);
+  thread_ref->axis(tile_pos + 1)->parallelize(ParallelType::TIDx);
+
+  std::vector<TensorView*> thread_tvs = ir_utils::allTvsExcept(
+      fusion, std::unordered_set<TensorView*>(tma_tvs.begin(), tma_tvs.end()));
+  TransformPropagator thread_propagator(thread_ref);
+  SetSelector selector({thread_tvs.begin(), thread_tvs.end()});
+  MaxLogicalDomainInfoSpanningTree(thread_ref, &selector)
+      .traverse(&thread_propagator);
+  scheduler_utils::parallelizeAllLike(thread_ref, thread_tvs);
+
+  if (tparams->vectorize_factor2 > 1) {
+    // The output tiles are written with vectorized stores and the inputs of
+    // the output group are loaded with vectorized loads. The transposed reads
+    // of the input tiles are strided, so they aren't vectorized.
+    std::vector<TensorView*> vectorized_tvs = smem_stores;
+    for (auto tv : grouped_inputs_outputs.at(1 - load_group)) {
+      if (tv->isFusionInput()) {
+        auto consumer_tvs = ir_utils::consumerTvsOf(tv);
+        vectorized_tvs.insert(
+            vectorized_tvs.end(), consumer_tvs.begin(), consumer_tvs.end());
+      }
+    }
+    thread_ref->axis(-1)->parallelize(ParallelType::Vectorize);
+    scheduler_utils::parallelizeAllLike(
+        thread_ref, vectorized_tvs, {ParallelType::Vectorize});
+  }
+
+  // Each block transposes one tile. The TMA tensors are allocated per tile
+  // and the rest of the fusion is inlined into the tile.
+  inlineAllAt(thread_ref, tile_pos, true);
+  std::vector<TensorView*> all_tvs = fusion->allTvs();
+  std::unordered_set<TensorView*> inner_most_tensors(
+      all_tvs.begin(), all_tvs.end());
+  for (auto tv : tma_tvs) {
+    inner_most_tensors.erase(tv);
+  }
+  for (auto tv : smem_stores) {
+    inner_most_tensors.erase(tv);
+  }
+  inlineMost(inner_most_tensors);
+}
+
+} // namespace transpose_tma
+} // namespace nvfuser
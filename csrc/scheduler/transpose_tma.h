@@ -0,0 +1,50 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+
+#include <fusion.h>
+#include <scheduler/transpose_heuristic.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace nvfuser {
+
+class SchedulerRuntimeInfo;
+
+//! TMA mode of the transpose scheduler, enabled by EnableOption::TmaTranspose
+//! and selected by the DeviceDescriptor of the current device.
+//!
+//! One group of the transpose must consist of inputs only. These are the
+//! transposed inputs, whose tiles are loaded with CpAsyncBulkTensorTile to
+//! shared memory laid out with the hardware swizzle of the TMA box. The other
+//! group holds the outputs, which are written to shared memory by the threads
+//! and stored with CpAsyncBulkTensorTile. The reference tensor is tiled as:
+//!   [tiles, tile_size1, tile_size2]
+//! where tile_size1 is along the inner dimension of the transposed inputs and
+//! tile_size2 along the inner dimension of the outputs. The threads compute
+//! in the layout of the outputs, [tiles, tile/vect/TIDx, TIDx, vect], so the
+//! transpose happens when reading the swizzled input tiles, which spreads the
+//! strided accesses over the banks of shared memory.
+namespace transpose_tma {
+
+//! Updates tparams to the TMA mode and returns true if the fusion can use it
+//! and the device benefits from it. grouped_inputs_outputs are the groups of
+//! the transpose domain map, and n_elems the number of elements of the
+//! reference. Otherwise, tparams is not modified.
+bool getHeuristics(
+    TransposeParams* tparams,
+    Fusion* fusion,
+    SchedulerRuntimeInfo& runtime_info,
+    const std::vector<std::vector<TensorView*>>& grouped_inputs_outputs,
+    int64_t n_elems);
+
+void scheduleFusion(Fusion* fusion, const TransposeParams* tparams);
+
+} // namespace transpose_tma
+} // namespace nvfuser
@@ -1308,6 +1308,11 @@ std::vector<std::pair<TensorView*, TensorView*>> cacheAndForkOutputs(
         output->definition()->isA<ScatterOp>()) {
       continue;
     }
+    // So must the output of an atomic grid reduction
+    if (auto rop = dynamic_cast<ReductionOp*>(output->definition());
+        rop != nullptr && rop->atomicGridReductionRequested()) {
+      continue;
+    }
     if (!output->uses().empty()) {
       output = output->cacheFork();
     }
@@ -3001,6 +3006,17 @@ bool isHighBandwidthFlopsRatio() {
   return bandwidth_flops_ratio > reference_ratio;
 }
 
+int64_t maxResidentBlocks(int64_t threads_per_block) {
+  NVF_ERROR(threads_per_block > 0, "Invalid threads per block");
+  const auto dev_prop = at::cuda::getCurrentDeviceProperties();
+  const int64_t blocks_per_sm = std::min(
+      (int64_t)dev_prop->maxBlocksPerMultiProcessor,
+      std::max(
+          (int64_t)dev_prop->maxThreadsPerMultiProcessor / threads_per_block,
+          (int64_t)1));
+  return blocks_per_sm * (int64_t)dev_prop->multiProcessorCount;
+}
+
 bool hasExpensiveMUFUops(Fusion* fusion) {
   const std::unordered_set<UnaryOpType> expensive_unary_ops{
       UnaryOpType::Exp,
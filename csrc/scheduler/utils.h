@@ -803,6 +803,12 @@ int64_t getRequiredBytesInFlight();
 // Returns true if the device has a high bandwidth to compute raito.
 bool isHighBandwidthFlopsRatio();
 
+// Returns the number of blocks of threads_per_block threads that can be
+// resident on the device at once, assuming occupancy is only limited by the
+// number of threads and blocks per SM. Used as the grid size of persistent
+// grid-stride kernels.
+int64_t maxResidentBlocks(int64_t threads_per_block);
+
 // Return true if the fusion has computation requires Floating-Point
 // Multi-Function (MUFU) units, e.g. cos, sin, exponent, logarithm, sine,
 // cosine, square root, hyperbolic tangent. Currently, we only tested tanh, exp,
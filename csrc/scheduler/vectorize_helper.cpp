@@ -18,11 +18,13 @@
 #include <ir/iostream.h>
 #include <ir/printer.h>
 #include <iter_visitor.h>
+#include <remarks.h>
 #include <scheduler/registry.h>
 #include <scheduler/runtime_info.h>
 #include <scheduler/tools/resize_utils.h>
 #include <val_graph_visitor.h>
 
+#include <sstream>
 #include <unordered_set>
 
 namespace nvfuser {
@@ -902,7 +904,10 @@ class CanSkipResize : public ValGraphPermissiveBFS {
 // https://github.com/NVIDIA/Fuser/issues/3640). To workaround the
 // limitation, grab all factors that must be divisible by a
 // vectorization factors.
-std::unordered_set<Val*> getResizeVectorizationFactors(
+//
+// Returns the resize-based ops with the Resize exprs whose factors
+// must be divisible.
+std::vector<std::pair<Expr*, Resize*>> getResizesConstrainingVectorization(
     TensorView* reference_tv,
     int64_t break_point) {
   Fusion* fusion = reference_tv->fusion();
@@ -915,16 +920,7 @@ std::unordered_set<Val*> getResizeVectorizationFactors(
   IdModel id_model(fusion);
   const auto& graph = id_model.buildExactGraph();
 
-  std::unordered_set<Val*> resize_factors;
-
-  auto add_resize_factors = [&](Resize* resize) {
-    if (!resize->leftExpand()->isZeroInt()) {
-      resize_factors.insert(resize->leftExpand());
-    }
-    if (!resize->rightExpand()->isZeroInt()) {
-      resize_factors.insert(resize->rightExpand());
-    }
-  };
+  std::vector<std::pair<Expr*, Resize*>> constraining_resizes;
 
   const ValGroups ref_vec_groups = graph.toGroups(std::vector<Val*>{
       reference_tv->getLogicalDomain().begin() + break_point,
@@ -933,8 +929,8 @@ std::unordered_set<Val*> getResizeVectorizationFactors(
   // For each of Resize exprs, if it's reachable from the reference
   // vectorized IDs without visiting the Resize expr itself, its
   // constraint may not be reflectd in the inner sizes.
-  for (auto resize : resize_based_ops) {
-    auto resize_out_tv = resize->output(0)->as<TensorView>();
+  for (auto resize_based_op : resize_based_ops) {
+    auto resize_out_tv = resize_based_op->output(0)->as<TensorView>();
     for (const auto logical_id : resize_out_tv->getLogicalDomain()) {
       auto resize = dynamic_cast<Resize*>(logical_id->definition());
       if (resize == nullptr) {
@@ -942,14 +938,120 @@ std::unordered_set<Val*> getResizeVectorizationFactors(
       }
 
       if (CanSkipResize::run(graph, ref_vec_groups, resize)) {
-        add_resize_factors(resize);
+        constraining_resizes.emplace_back(resize_based_op, resize);
       }
     }
   }
 
+  return constraining_resizes;
+}
+
+void addResizeFactors(Resize* resize, std::unordered_set<Val*>& factors) {
+  if (!resize->leftExpand()->isZeroInt()) {
+    factors.insert(resize->leftExpand());
+  }
+  if (!resize->rightExpand()->isZeroInt()) {
+    factors.insert(resize->rightExpand());
+  }
+}
+
+std::unordered_set<Val*> getResizeVectorizationFactors(
+    TensorView* reference_tv,
+    int64_t break_point) {
+  std::unordered_set<Val*> resize_factors;
+  for (const auto& [resize_based_op, resize] :
+       getResizesConstrainingVectorization(reference_tv, break_point)) {
+    addResizeFactors(resize, resize_factors);
+  }
+  return resize_factors;
+}
+
+// A resize shifts the accesses of the tensors on one side of it
+// relative to the tensors on the other side. Its factors only
+// constrain the vectorization of a tensor that is on the other side
+// than the reference, i.e., the data of exactly one of them flows
+// into the resize.
+std::unordered_map<TensorView*, std::unordered_set<Val*>>
+getResizeVectorizationFactorsOfTensors(
+    TensorView* reference_tv,
+    int64_t break_point,
+    const std::vector<TensorView*>& tvs) {
+  std::unordered_map<TensorView*, std::unordered_set<Val*>> resize_factors;
+  auto is_upstream = [](TensorView* tv, Expr* resize_based_op) {
+    Val* resize_in = resize_based_op->input(0);
+    return tv == resize_in || DependencyCheck::isDependencyOf(tv, resize_in);
+  };
+  for (const auto& [resize_based_op, resize] :
+       getResizesConstrainingVectorization(reference_tv, break_point)) {
+    const bool ref_is_upstream = is_upstream(reference_tv, resize_based_op);
+    for (TensorView* tv : tvs) {
+      if (is_upstream(tv, resize_based_op) != ref_is_upstream) {
+        addResizeFactors(resize, resize_factors[tv]);
+      }
+    }
+  }
   return resize_factors;
 }
 
+// Maximum vectorization factor of tv as allowed by its data type,
+// alignment and contiguous inner size. Returns 1 if tv is not found
+// in tv_to_inner_size_map.
+int64_t getVectorizationFactorOfTensor(
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* tv,
+    const std::unordered_map<TensorView*, Val*>& tv_to_inner_size_map) {
+  // factor <= max_factor / dtype_size
+  const auto dtype_size =
+      dataTypeSizeByte(tv->dtype(), runtime_info.getIndexType());
+  int64_t max_vec_size =
+      SchedulerRuntimeInfo::max_alignment_size_in_byte / dtype_size;
+
+  // factor <= alignment / dtype_size
+  int64_t alignment_size = (int64_t)runtime_info.getAlignmentSize(tv);
+  NVF_ERROR(alignment_size % dtype_size == 0);
+  max_vec_size = std::min(max_vec_size, alignment_size / dtype_size);
+
+  // factor <= projected_extent
+  auto inner_size_it = tv_to_inner_size_map.find(tv);
+  if (inner_size_it == tv_to_inner_size_map.end()) {
+    // If we don't have info for a tensor that is supposed to be
+    // vectorized, that means the tensor has no projected
+    // vectorizable extent, i.e., not vectorizable.
+    return 1;
+  }
+  auto inner_size_opt =
+      runtime_info.expressionEvaluator().evaluate(inner_size_it->second);
+  NVF_ERROR(
+      inner_size_opt.hasValue(),
+      "Vectorization heuristic could not evaluate inner most size: ",
+      inner_size_it->second);
+
+  return std::min(
+      scheduler_utils::maxVectorizationWidth(inner_size_opt.as<int64_t>()),
+      max_vec_size);
+}
+
+// Limits max_vec_size so that it divides all of resize_factors.
+// Returns 1 if any of them can't be evaluated.
+int64_t applyResizeVectorizationFactors(
+    SchedulerRuntimeInfo& runtime_info,
+    const std::unordered_set<Val*>& resize_factors,
+    int64_t max_vec_size) {
+  for (const auto resize_factor : resize_factors) {
+    auto inferred_val =
+        runtime_info.expressionEvaluator().evaluate(resize_factor);
+    if (!inferred_val.hasValue()) {
+      return 1;
+    }
+    auto inferred_val_int = inferred_val.as<int64_t>();
+    if (inferred_val_int == 0) {
+      continue;
+    }
+    max_vec_size = std::gcd(max_vec_size, inferred_val_int);
+  }
+  return max_vec_size;
+}
+
 } // namespace
 
 int64_t getVectorizationFactor(
@@ -1000,60 +1102,102 @@ int64_t getVectorizationFactor(
   int64_t max_vec_size = SchedulerRuntimeInfo::max_alignment_size_in_byte;
   const auto& tv_to_inner_size_map = vectorize_maps_entry.get().at(break_point);
 
+  TensorView* limiting_tv = nullptr;
   for (auto inp_or_out : vectorizable_inputs_outputs) {
-    // factor <= max_factor / dtype_size
-    const auto dtype_size =
-        dataTypeSizeByte(inp_or_out->dtype(), runtime_info.getIndexType());
-    max_vec_size = std::min(
-        max_vec_size,
-        SchedulerRuntimeInfo::max_alignment_size_in_byte / dtype_size);
-
-    // factor <= alignment / dtype_size
-    int64_t alignment_size = (int64_t)runtime_info.getAlignmentSize(inp_or_out);
-    NVF_ERROR(alignment_size % dtype_size == 0);
-    max_vec_size = std::min(max_vec_size, alignment_size / dtype_size);
-
-    // factor <= projected_extent
-    auto inner_size_it = tv_to_inner_size_map.find(inp_or_out);
-    if (inner_size_it == tv_to_inner_size_map.end()) {
-      // If we don't have info for a tensor that is supposed to be
-      // vectorized, that means the tensor has no projected
-      // vectorizable extent, i.e., not vectorizable.
-      // TODO: Instead of competely disabling vectorization for all
-      // tensors, just disable the problematic tensor and keep the
-      // other tensors vectorized
-      return 1;
+    // TODO: Instead of competely disabling vectorization for all
+    // tensors when one of them is not vectorizable, just disable the
+    // problematic tensor and keep the other tensors vectorized. See
+    // getVectorizationFactorsOfTensors.
+    const int64_t tv_vec_size = getVectorizationFactorOfTensor(
+        runtime_info, inp_or_out, tv_to_inner_size_map);
+    if (tv_vec_size < max_vec_size) {
+      max_vec_size = tv_vec_size;
+      limiting_tv = inp_or_out;
     }
-    auto inner_size_opt =
-        runtime_info.expressionEvaluator().evaluate(inner_size_it->second);
-    NVF_ERROR(
-        inner_size_opt.hasValue(),
-        "Vectorization heuristic could not evaluate inner most size: ",
-        inner_size_it->second);
-
-    max_vec_size = std::min(
-        scheduler_utils::maxVectorizationWidth(inner_size_opt.as<int64_t>()),
-        max_vec_size);
   }
 
   // This is a WAR for vectorization through resize as the spanning
   // tree based traversal is not guaranteed to reflect all resize ops
   // that may affect vectorization. This is a safe but conservative
   // analysis since it should only be necessary for innermost IDs.
-  for (const auto resize_factor : resize_factors) {
-    auto inferred_val =
-        runtime_info.expressionEvaluator().evaluate(resize_factor);
-    if (!inferred_val.hasValue()) {
-      return 1;
+  const int64_t vec_size = applyResizeVectorizationFactors(
+      runtime_info, resize_factors, max_vec_size);
+
+  if (remarks::isActive()) {
+    std::vector<std::pair<std::string, std::string>> args = {
+        {"factor", std::to_string(vec_size)},
+        {"reference", reference_tv->toString()}};
+    std::stringstream message;
+    message << "Vectorization factor " << vec_size;
+    if (vec_size < max_vec_size) {
+      message << " limited by resize ops";
+      args.emplace_back("limited_by", "resize");
+    } else if (limiting_tv != nullptr) {
+      message << " limited by the alignment or contiguous inner extent of "
+              << limiting_tv->toString();
+      args.emplace_back("limited_by", limiting_tv->toString());
     }
-    auto inferred_val_int = inferred_val.as<int64_t>();
-    if (inferred_val_int == 0) {
-      continue;
+    remarks::report("vectorization", message.str(), std::move(args));
+  }
+  return vec_size;
+}
+
+std::unordered_map<TensorView*, int64_t> getVectorizationFactorsOfTensors(
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference_tv,
+    HeuristicDataCache* data_cache,
+    int64_t break_point,
+    const std::unordered_map<int64_t, int64_t>& logical_reorder_map) {
+  FUSER_PERF_SCOPE("vectorize_helper::getVectorizationFactorsOfTensors");
+
+  auto vectorizable_inputs_outputs_entry = HeuristicDataCacheEntry<
+      HeuristicCompileTime::VectorizableInputsAndOutputs>(
+      data_cache, [&reference_tv]() {
+        return std::make_unique<std::vector<TensorView*>>(
+            scheduler_utils::getInputsOutputsWithInnerDim(
+                reference_tv, true, true));
+      });
+  const auto& vectorizable_inputs_outputs =
+      vectorizable_inputs_outputs_entry.get();
+
+  auto vectorize_maps_entry =
+      HeuristicDataCacheEntry<HeuristicCompileTime::TvToContigInnerSizeMaps>(
+          data_cache, [&reference_tv, &logical_reorder_map]() {
+            return std::make_unique<
+                std::vector<std::unordered_map<TensorView*, Val*>>>(
+                getTvToContigInnerSizeMapsOf(
+                    reference_tv, logical_reorder_map));
+          });
+
+  std::unordered_map<TensorView*, int64_t> factors;
+  if (break_point >= static_cast<int64_t>(vectorize_maps_entry.get().size())) {
+    for (TensorView* tv : vectorizable_inputs_outputs) {
+      factors.emplace(tv, 1);
     }
-    max_vec_size = std::gcd(max_vec_size, inferred_val_int);
+    return factors;
   }
 
-  return max_vec_size;
+  auto resize_factors_entry = HeuristicDataCacheEntry<
+      HeuristicCompileTime::ResizeVectorizationFactorsOfTensors>(
+      data_cache, [&]() {
+        return std::make_unique<
+            std::unordered_map<TensorView*, std::unordered_set<Val*>>>(
+            getResizeVectorizationFactorsOfTensors(
+                reference_tv, break_point, vectorizable_inputs_outputs));
+      });
+  const auto& resize_factors = resize_factors_entry.get();
+
+  const auto& tv_to_inner_size_map = vectorize_maps_entry.get().at(break_point);
+  for (TensorView* tv : vectorizable_inputs_outputs) {
+    int64_t factor =
+        getVectorizationFactorOfTensor(runtime_info, tv, tv_to_inner_size_map);
+    if (auto it = resize_factors.find(tv); it != resize_factors.end()) {
+      factor =
+          applyResizeVectorizationFactors(runtime_info, it->second, factor);
+    }
+    factors.emplace(tv, factor);
+  }
+  return factors;
 }
 
 int64_t getVectorizationFactorTransposeGroup(
@@ -319,6 +319,19 @@ int64_t getVectorizationFactor(
     int64_t break_point,
     const std::unordered_map<int64_t, int64_t>& logical_reorder = {});
 
+// Like getVectorizationFactor, but returns the factor of each of the
+// vectorizable inputs and outputs of reference_tv instead of the
+// minimum over all of them. The factors of a resize only limit the
+// tensors whose accesses it shifts relative to reference_tv, so a
+// tensor that can't be vectorized because of a misaligned slice or pad
+// offset doesn't prevent vectorizing the others.
+std::unordered_map<TensorView*, int64_t> getVectorizationFactorsOfTensors(
+    SchedulerRuntimeInfo& runtime_info,
+    TensorView* reference_tv,
+    HeuristicDataCache* data_cache,
+    int64_t break_point,
+    const std::unordered_map<int64_t, int64_t>& logical_reorder = {});
+
 int64_t getVectorizationFactorTransposeGroup(
     SchedulerRuntimeInfo& runtime_info,
     TensorView* reference,
@@ -0,0 +1,580 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <ir/interface_nodes.h>
+#include <scheduler/matmul_heuristic.h>
+#include <scheduler/pointwise_heuristic.h>
+#include <scheduler/reduction_heuristic.h>
+#include <scheduler/resize_heuristic.h>
+#include <scheduler/transpose_heuristic.h>
+#include <serde/heuristic_params.h>
+#include <serde/utils.h>
+
+namespace nvfuser::serde {
+
+namespace {
+
+using CircularBufferOptionsType = nvfuser::MatmulParams::CircularBufferOptions;
+
+flatbuffers::Offset<CompileParams> serializeCompileParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::CompileParams& cparams) {
+  auto fb_include_paths = builder.CreateVectorOfStrings(cparams.include_paths);
+  auto fb_int32_indexed_inputs =
+      builder.CreateVector(cparams.int32_indexed_inputs);
+  CompileParamsBuilder builder_(builder);
+  builder_.add_has_index_type(cparams.index_type.has_value());
+  if (cparams.index_type.has_value()) {
+    builder_.add_index_type(toUnderlying(cparams.index_type.value()));
+  }
+  builder_.add_maxrregcount(cparams.maxrregcount);
+  builder_.add_enable_magic_zero(cparams.enable_magic_zero);
+  builder_.add_enable_ptxas_verbose(cparams.enable_ptxas_verbose);
+  builder_.add_include_paths(fb_include_paths);
+  builder_.add_int32_indexed_inputs(fb_int32_indexed_inputs);
+  return builder_.Finish();
+}
+
+nvfuser::CompileParams deserializeCompileParams(const CompileParams* buffer) {
+  NVF_ERROR(buffer != nullptr, "serde::CompileParams is nullptr.");
+  nvfuser::CompileParams cparams;
+  if (buffer->has_index_type()) {
+    cparams.index_type = mapToNvfuserDtype(buffer->index_type());
+  }
+  cparams.maxrregcount = buffer->maxrregcount();
+  cparams.enable_magic_zero = buffer->enable_magic_zero();
+  cparams.enable_ptxas_verbose = buffer->enable_ptxas_verbose();
+  for (auto path : *buffer->include_paths()) {
+    cparams.include_paths.push_back(path->str());
+  }
+  cparams.int32_indexed_inputs = parseVector(buffer->int32_indexed_inputs());
+  return cparams;
+}
+
+flatbuffers::Offset<CircularBufferOptions> serializeCircularBufferOptions(
+    flatbuffers::FlatBufferBuilder& builder,
+    const CircularBufferOptionsType& options) {
+  return CreateCircularBufferOptions(
+      builder,
+      options.circular_buffer_smem_write,
+      options.circular_buffer_smem_read,
+      options.smem_circular_buffer_stage,
+      options.smem_circular_buffer_prefetch_gap);
+}
+
+CircularBufferOptionsType deserializeCircularBufferOptions(
+    const CircularBufferOptions* buffer) {
+  NVF_ERROR(buffer != nullptr, "serde::CircularBufferOptions is nullptr.");
+  CircularBufferOptionsType options;
+  options.circular_buffer_smem_write = buffer->circular_buffer_smem_write();
+  options.circular_buffer_smem_read = buffer->circular_buffer_smem_read();
+  options.smem_circular_buffer_stage =
+      (int)buffer->smem_circular_buffer_stage();
+  options.smem_circular_buffer_prefetch_gap =
+      (int)buffer->smem_circular_buffer_prefetch_gap();
+  return options;
+}
+
+flatbuffers::Offset<PointwiseParams> serializePointwiseParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::PointwiseParams* pparams) {
+  auto fb_input_vectorization_factors =
+      builder.CreateVector(pparams->input_vectorization_factors);
+  auto fb_output_vectorization_factors =
+      builder.CreateVector(pparams->output_vectorization_factors);
+  PointwiseParamsBuilder builder_(builder);
+  builder_.add_break_point(pparams->break_point);
+  builder_.add_split_block(pparams->split_block);
+  builder_.add_split_grid_y_dim(pparams->split_grid_y_dim);
+  builder_.add_flip_grid_binding(pparams->flip_grid_binding);
+  builder_.add_vectorization_factor(pparams->vectorization_factor);
+  builder_.add_unroll_factor_outer(pparams->unroll_factor_outer);
+  builder_.add_unroll_factor_inner(pparams->unroll_factor_inner);
+  builder_.add_threads_per_block_1d(pparams->threads_per_block_1d);
+  builder_.add_use_tma_load(pparams->use_tma_load);
+  builder_.add_use_tma_store(pparams->use_tma_store);
+  builder_.add_tma_tile_outer(pparams->tma_tile_outer);
+  builder_.add_tma_tile_inner(pparams->tma_tile_inner);
+  builder_.add_tma_tiles_per_block(pparams->tma_tiles_per_block);
+  builder_.add_circular_buffer_stages(pparams->circular_buffer_stages);
+  builder_.add_tma_bulk_copy(pparams->tma_bulk_copy);
+  builder_.add_persistent_grid(pparams->persistent_grid);
+  builder_.add_input_vectorization_factors(fb_input_vectorization_factors);
+  builder_.add_output_vectorization_factors(fb_output_vectorization_factors);
+  return builder_.Finish();
+}
+
+void deserializePointwiseParams(
+    const PointwiseParams* buffer,
+    nvfuser::PointwiseParams* pparams) {
+  pparams->break_point = buffer->break_point();
+  pparams->split_block = buffer->split_block();
+  pparams->split_grid_y_dim = buffer->split_grid_y_dim();
+  pparams->flip_grid_binding = buffer->flip_grid_binding();
+  pparams->vectorization_factor = buffer->vectorization_factor();
+  pparams->unroll_factor_outer = buffer->unroll_factor_outer();
+  pparams->unroll_factor_inner = buffer->unroll_factor_inner();
+  pparams->threads_per_block_1d = buffer->threads_per_block_1d();
+  pparams->use_tma_load = buffer->use_tma_load();
+  pparams->use_tma_store = buffer->use_tma_store();
+  pparams->tma_tile_outer = buffer->tma_tile_outer();
+  pparams->tma_tile_inner = buffer->tma_tile_inner();
+  pparams->tma_tiles_per_block = buffer->tma_tiles_per_block();
+  pparams->circular_buffer_stages = buffer->circular_buffer_stages();
+  pparams->tma_bulk_copy = buffer->tma_bulk_copy();
+  pparams->persistent_grid = buffer->persistent_grid();
+  pparams->input_vectorization_factors =
+      parseVector(buffer->input_vectorization_factors());
+  pparams->output_vectorization_factors =
+      parseVector(buffer->output_vectorization_factors());
+}
+
+flatbuffers::Offset<ReductionParams> serializeReductionParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::ReductionParams* rparams) {
+  auto fb_circular_buffer_options =
+      serializeCircularBufferOptions(builder, rparams->circular_buffer_options);
+  std::vector<int64_t> smem_persistent_buffers;
+  smem_persistent_buffers.reserve(rparams->smem_persistent_buffers.size());
+  for (TensorView* tv : rparams->smem_persistent_buffers) {
+    smem_persistent_buffers.push_back((int64_t)tv->name());
+  }
+  auto fb_smem_persistent_buffers =
+      builder.CreateVector(smem_persistent_buffers);
+
+  ReductionParamsBuilder builder_(builder);
+  builder_.add_fastest_dim(rparams->fastest_dim);
+  builder_.add_persistent_kernel(rparams->persistent_kernel);
+  builder_.add_project_persistent_buffers(rparams->project_persistent_buffers);
+  builder_.add_schedule_3d(rparams->schedule_3D);
+  builder_.add_flip_grid(rparams->flip_grid);
+  builder_.add_cross_block_inner_reduction(
+      rparams->cross_block_inner_reduction);
+  builder_.add_cross_grid_inner_reduction(rparams->cross_grid_inner_reduction);
+  builder_.add_unroll_factor_inner_reduction(
+      rparams->unroll_factor_inner_reduction);
+  builder_.add_unroll_factor_top_of_vectorization(
+      rparams->unroll_factor_top_of_vectorization);
+  builder_.add_vectorize_inner_reduction(rparams->vectorize_inner_reduction);
+  builder_.add_split_grid_dim_inner_reduction(
+      rparams->split_grid_dim_inner_reduction);
+  builder_.add_cluster_inner_reduction(rparams->cluster_inner_reduction);
+  builder_.add_atomic_inner_reduction(rparams->atomic_inner_reduction);
+  builder_.add_pad_inner_reduction_to_warp(
+      rparams->pad_inner_reduction_to_warp);
+  builder_.add_batches_per_block_inner_reduction(
+      rparams->batches_per_block_inner_reduction);
+  builder_.add_block_dim_inner_reduction(
+      toUnderlying(rparams->block_dim_inner_reduction));
+  builder_.add_grid_dim_inner_reduction(
+      toUnderlying(rparams->grid_dim_inner_reduction));
+  builder_.add_multiple_reds_per_blk(rparams->multiple_reds_per_blk);
+  builder_.add_unroll_factor_iter_dom(rparams->unroll_factor_iter_dom);
+  builder_.add_vectorize_iter_dom(rparams->vectorize_iter_dom);
+  builder_.add_split_grid_dim_iter_dom_inner(
+      rparams->split_grid_dim_iter_dom_inner);
+  builder_.add_split_grid_dim_iter_dom_outer(
+      rparams->split_grid_dim_iter_dom_outer);
+  builder_.add_block_dim_iter_dom(toUnderlying(rparams->block_dim_iter_dom));
+  builder_.add_grid_dim_iter_dom(toUnderlying(rparams->grid_dim_iter_dom));
+  builder_.add_cross_block_outer_reduction(
+      rparams->cross_block_outer_reduction);
+  builder_.add_cross_grid_outer_reduction(rparams->cross_grid_outer_reduction);
+  builder_.add_split_grid_dim_outer_reduction(
+      rparams->split_grid_dim_outer_reduction);
+  builder_.add_batches_per_block_outer_reduction(
+      rparams->batches_per_block_outer_reduction);
+  builder_.add_unroll_factor_outer_reduction(
+      rparams->unroll_factor_outer_reduction);
+  builder_.add_block_dim_outer_reduction(
+      toUnderlying(rparams->block_dim_outer_reduction));
+  builder_.add_grid_dim_outer_reduction(
+      toUnderlying(rparams->grid_dim_outer_reduction));
+  builder_.add_compute_persistent_buffer_with_first_consumer(
+      rparams->compute_persistent_buffer_with_first_consumer);
+  builder_.add_prefetch_serial_reduction_loads(
+      rparams->prefetch_serial_reduction_loads);
+  builder_.add_static_bdimx(rparams->static_bdimx);
+  builder_.add_static_bdimy(rparams->static_bdimy);
+  builder_.add_combined_inner_outer(rparams->combined_inner_outer);
+  builder_.add_tidx_for_outer_reduction(rparams->tidx_for_outer_reduction);
+  builder_.add_pad_outer_reduction_to_warp(
+      rparams->pad_outer_reduction_to_warp);
+  builder_.add_combined_split_grid_inner_dim(
+      rparams->combined_split_grid_inner_dim);
+  builder_.add_tma_warp_specialized(rparams->tma_warp_specialized);
+  builder_.add_is_non_circular_buffer_gmem_to_regs(
+      rparams->is_non_circular_buffer_gmem_to_regs);
+  builder_.add_is_circular_buffer_regs_cached(
+      rparams->is_circular_buffer_regs_cached);
+  builder_.add_circular_buffer_options(fb_circular_buffer_options);
+  builder_.add_vectorization_factor_outer(rparams->vectorization_factor_outer);
+  builder_.add_vectorization_factor_tmp_gmem_write(
+      rparams->vectorization_factor_tmp_gmem_write);
+  builder_.add_block_dim_inner_reduction_extra(
+      toUnderlying(rparams->block_dim_inner_reduction_extra));
+  builder_.add_smem_persistent_buffers(fb_smem_persistent_buffers);
+  return builder_.Finish();
+}
+
+void deserializeReductionParams(
+    const ReductionParams* buffer,
+    Fusion* segment_fusion,
+    nvfuser::ReductionParams* rparams) {
+  rparams->fastest_dim = buffer->fastest_dim();
+  rparams->persistent_kernel = buffer->persistent_kernel();
+  rparams->project_persistent_buffers = buffer->project_persistent_buffers();
+  rparams->schedule_3D = buffer->schedule_3d();
+  rparams->flip_grid = buffer->flip_grid();
+  rparams->cross_block_inner_reduction = buffer->cross_block_inner_reduction();
+  rparams->cross_grid_inner_reduction = buffer->cross_grid_inner_reduction();
+  rparams->unroll_factor_inner_reduction =
+      buffer->unroll_factor_inner_reduction();
+  rparams->unroll_factor_top_of_vectorization =
+      buffer->unroll_factor_top_of_vectorization();
+  rparams->vectorize_inner_reduction = buffer->vectorize_inner_reduction();
+  rparams->split_grid_dim_inner_reduction =
+      buffer->split_grid_dim_inner_reduction();
+  rparams->cluster_inner_reduction = buffer->cluster_inner_reduction();
+  rparams->atomic_inner_reduction = buffer->atomic_inner_reduction();
+  rparams->pad_inner_reduction_to_warp = buffer->pad_inner_reduction_to_warp();
+  rparams->batches_per_block_inner_reduction =
+      buffer->batches_per_block_inner_reduction();
+  rparams->block_dim_inner_reduction =
+      static_cast<ParallelType>(buffer->block_dim_inner_reduction());
+  rparams->grid_dim_inner_reduction =
+      static_cast<ParallelType>(buffer->grid_dim_inner_reduction());
+  rparams->multiple_reds_per_blk = buffer->multiple_reds_per_blk();
+  rparams->unroll_factor_iter_dom = buffer->unroll_factor_iter_dom();
+  rparams->vectorize_iter_dom = buffer->vectorize_iter_dom();
+  rparams->split_grid_dim_iter_dom_inner =
+      buffer->split_grid_dim_iter_dom_inner();
+  rparams->split_grid_dim_iter_dom_outer =
+      buffer->split_grid_dim_iter_dom_outer();
+  rparams->block_dim_iter_dom =
+      static_cast<ParallelType>(buffer->block_dim_iter_dom());
+  rparams->grid_dim_iter_dom =
+      static_cast<ParallelType>(buffer->grid_dim_iter_dom());
+  rparams->cross_block_outer_reduction = buffer->cross_block_outer_reduction();
+  rparams->cross_grid_outer_reduction = buffer->cross_grid_outer_reduction();
+  rparams->split_grid_dim_outer_reduction =
+      buffer->split_grid_dim_outer_reduction();
+  rparams->batches_per_block_outer_reduction =
+      buffer->batches_per_block_outer_reduction();
+  rparams->unroll_factor_outer_reduction =
+      buffer->unroll_factor_outer_reduction();
+  rparams->block_dim_outer_reduction =
+      static_cast<ParallelType>(buffer->block_dim_outer_reduction());
+  rparams->grid_dim_outer_reduction =
+      static_cast<ParallelType>(buffer->grid_dim_outer_reduction());
+  rparams->compute_persistent_buffer_with_first_consumer =
+      buffer->compute_persistent_buffer_with_first_consumer();
+  rparams->prefetch_serial_reduction_loads =
+      buffer->prefetch_serial_reduction_loads();
+  rparams->static_bdimx = buffer->static_bdimx();
+  rparams->static_bdimy = buffer->static_bdimy();
+  rparams->combined_inner_outer = buffer->combined_inner_outer();
+  rparams->tidx_for_outer_reduction = buffer->tidx_for_outer_reduction();
+  rparams->pad_outer_reduction_to_warp = buffer->pad_outer_reduction_to_warp();
+  rparams->combined_split_grid_inner_dim =
+      buffer->combined_split_grid_inner_dim();
+  rparams->tma_warp_specialized = buffer->tma_warp_specialized();
+  rparams->is_non_circular_buffer_gmem_to_regs =
+      buffer->is_non_circular_buffer_gmem_to_regs();
+  rparams->is_circular_buffer_regs_cached =
+      buffer->is_circular_buffer_regs_cached();
+  rparams->circular_buffer_options =
+      deserializeCircularBufferOptions(buffer->circular_buffer_options());
+  rparams->vectorization_factor_outer = buffer->vectorization_factor_outer();
+  rparams->vectorization_factor_tmp_gmem_write =
+      buffer->vectorization_factor_tmp_gmem_write();
+  rparams->block_dim_inner_reduction_extra =
+      static_cast<ParallelType>(buffer->block_dim_inner_reduction_extra());
+
+  if (buffer->smem_persistent_buffers()->size() == 0) {
+    return;
+  }
+  NVF_ERROR(
+      segment_fusion != nullptr,
+      "The fusion of the segment is required to resolve "
+      "smem_persistent_buffers.");
+  std::vector<TensorView*> all_tvs = segment_fusion->allTvs();
+  for (auto name : *buffer->smem_persistent_buffers()) {
+    auto tv_it =
+        std::find_if(all_tvs.begin(), all_tvs.end(), [name](TensorView* tv) {
+          return (int64_t)tv->name() == name;
+        });
+    NVF_ERROR(
+        tv_it != all_tvs.end(),
+        "Could not find the shared memory persistent buffer T",
+        name,
+        " in the fusion of the segment.");
+    rparams->smem_persistent_buffers.push_back(*tv_it);
+  }
+}
+
+flatbuffers::Offset<TransposeParams> serializeTransposeParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::TransposeParams* tparams) {
+  std::vector<int64_t> split_dims;
+  std::vector<int64_t> split_factors;
+  split_dims.reserve(tparams->split_before_tiling.size());
+  split_factors.reserve(tparams->split_before_tiling.size());
+  for (auto&& [dim, factor] : tparams->split_before_tiling) {
+    split_dims.push_back(dim);
+    split_factors.push_back(factor);
+  }
+  return CreateTransposeParamsDirect(
+      builder,
+      &split_dims,
+      &split_factors,
+      &tparams->dims_merged_with_1,
+      &tparams->dims_merged_with_2,
+      tparams->vectorize_factor1,
+      tparams->vectorize_factor2,
+      tparams->tile_size1,
+      tparams->tile_size2,
+      tparams->use_tma,
+      &tparams->extra_tile_sizes,
+      &tparams->extra_vectorize_factors);
+}
+
+void deserializeTransposeParams(
+    const TransposeParams* buffer,
+    nvfuser::TransposeParams* tparams) {
+  NVF_ERROR(
+      buffer->split_before_tiling_dims()->size() ==
+      buffer->split_before_tiling_factors()->size());
+  for (auto idx : arange(buffer->split_before_tiling_dims()->size())) {
+    tparams->split_before_tiling.emplace_back(
+        buffer->split_before_tiling_dims()->Get(idx),
+        buffer->split_before_tiling_factors()->Get(idx));
+  }
+  tparams->dims_merged_with_1 = parseVector(buffer->dims_merged_with_1());
+  tparams->dims_merged_with_2 = parseVector(buffer->dims_merged_with_2());
+  tparams->vectorize_factor1 = buffer->vectorize_factor1();
+  tparams->vectorize_factor2 = buffer->vectorize_factor2();
+  tparams->tile_size1 = buffer->tile_size1();
+  tparams->tile_size2 = buffer->tile_size2();
+  tparams->use_tma = buffer->use_tma();
+  tparams->extra_tile_sizes = parseVector(buffer->extra_tile_sizes());
+  tparams->extra_vectorize_factors =
+      parseVector(buffer->extra_vectorize_factors());
+}
+
+GemmTile parseGemmTile(const flatbuffers::Vector<int64_t>* fb_tile) {
+  NVF_ERROR(fb_tile != nullptr && fb_tile->size() == 3);
+  return GemmTile(fb_tile->Get(0), fb_tile->Get(1), fb_tile->Get(2));
+}
+
+flatbuffers::Offset<MatmulParams> serializeMatmulParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::MatmulParams* mparams) {
+  std::vector<int64_t> supported_vec_size{
+      mparams->supported_vec_size.a,
+      mparams->supported_vec_size.b,
+      mparams->supported_vec_size.epilogue};
+  std::vector<int64_t> cta_tile = mparams->tile_sizes.cta_tile.toVector();
+  std::vector<int64_t> warp_tile = mparams->tile_sizes.warp_tile.toVector();
+  std::vector<int64_t> grid_traversal_factor{
+      mparams->grid_traversal_factor.first,
+      mparams->grid_traversal_factor.second};
+  std::vector<int64_t> cluster_dims{
+      mparams->cluster_dims.x,
+      mparams->cluster_dims.y,
+      mparams->cluster_dims.z};
+  return CreateMatmulParamsDirect(
+      builder,
+      &supported_vec_size,
+      mparams->async_gmem_load_operands,
+      &cta_tile,
+      &warp_tile,
+      toUnderlying(mparams->mma_macro),
+      toUnderlying(mparams->tiling_strategy),
+      toUnderlying(mparams->buffering_loop_level),
+      toUnderlying(mparams->circular_buffering_strategy),
+      toUnderlying(mparams->cta_order),
+      serializeCircularBufferOptions(builder, mparams->circular_buffer_options),
+      &grid_traversal_factor,
+      mparams->use_smem_epilogue,
+      mparams->promote_prologue_smem_reuse,
+      mparams->overlap_epilogue_store,
+      mparams->use_ldst_matrix,
+      mparams->splitk_factor,
+      mparams->splitk_serial_chains,
+      mparams->sm_budget,
+      &cluster_dims,
+      mparams->multicast_operands);
+}
+
+void deserializeMatmulParams(
+    const MatmulParams* buffer,
+    nvfuser::MatmulParams* mparams) {
+  using MatmulParamsType = nvfuser::MatmulParams;
+  NVF_ERROR(buffer->supported_vec_size()->size() == 3);
+  mparams->supported_vec_size.a = buffer->supported_vec_size()->Get(0);
+  mparams->supported_vec_size.b = buffer->supported_vec_size()->Get(1);
+  mparams->supported_vec_size.epilogue = buffer->supported_vec_size()->Get(2);
+  mparams->async_gmem_load_operands = buffer->async_gmem_load_operands();
+  mparams->tile_sizes = MatMulTileOptions(
+      parseGemmTile(buffer->cta_tile()), parseGemmTile(buffer->warp_tile()));
+  mparams->mma_macro = static_cast<MmaMacro>(buffer->mma_macro());
+  mparams->tiling_strategy =
+      static_cast<MatmulParamsType::TilingStrategy>(buffer->tiling_strategy());
+  mparams->buffering_loop_level =
+      static_cast<MatmulParamsType::BufferingLoopLevel>(
+          buffer->buffering_loop_level());
+  mparams->circular_buffering_strategy =
+      static_cast<MatmulParamsType::CircularBufferingStrategy>(
+          buffer->circular_buffering_strategy());
+  mparams->cta_order = static_cast<MatmulParamsType::TileRasterizationOrder>(
+      buffer->cta_order());
+  mparams->circular_buffer_options =
+      deserializeCircularBufferOptions(buffer->circular_buffer_options());
+  NVF_ERROR(buffer->grid_traversal_factor()->size() == 2);
+  mparams->grid_traversal_factor = {
+      (int)buffer->grid_traversal_factor()->Get(0),
+      (int)buffer->grid_traversal_factor()->Get(1)};
+  mparams->use_smem_epilogue = buffer->use_smem_epilogue();
+  mparams->promote_prologue_smem_reuse = buffer->promote_prologue_smem_reuse();
+  mparams->overlap_epilogue_store = buffer->overlap_epilogue_store();
+  mparams->use_ldst_matrix = buffer->use_ldst_matrix();
+  mparams->splitk_factor = (int)buffer->splitk_factor();
+  mparams->splitk_serial_chains = buffer->splitk_serial_chains();
+  mparams->sm_budget = buffer->sm_budget();
+  NVF_ERROR(buffer->cluster_dims()->size() == 3);
+  mparams->cluster_dims.x = buffer->cluster_dims()->Get(0);
+  mparams->cluster_dims.y = buffer->cluster_dims()->Get(1);
+  mparams->cluster_dims.z = buffer->cluster_dims()->Get(2);
+  mparams->multicast_operands = buffer->multicast_operands();
+}
+
+flatbuffers::Offset<ResizeParams> serializeResizeParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::ResizeParams* rparams) {
+  return CreateResizeParamsDirect(
+      builder,
+      rparams->split_grid_x_dim,
+      rparams->largest_input,
+      rparams->vectorization_factor,
+      &rparams->unvectorized_inputs,
+      &rparams->unvectorized_outputs,
+      rparams->rotary_pairs);
+}
+
+void deserializeResizeParams(
+    const ResizeParams* buffer,
+    nvfuser::ResizeParams* rparams) {
+  rparams->split_grid_x_dim = buffer->split_grid_x_dim();
+  rparams->largest_input = buffer->largest_input();
+  rparams->vectorization_factor = buffer->vectorization_factor();
+  rparams->unvectorized_inputs = parseVector(buffer->unvectorized_inputs());
+  rparams->unvectorized_outputs = parseVector(buffer->unvectorized_outputs());
+  rparams->rotary_pairs = buffer->rotary_pairs();
+}
+
+} // namespace
+
+flatbuffers::Offset<HeuristicParams> serializeHeuristicParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::HeuristicParams* params) {
+  // See table definition for HeuristicParams in serde/fusion_cache.fbs
+  NVF_ERROR(params != nullptr, "Cannot serialize null HeuristicParams.");
+
+  HeuristicParamsData data_type = HeuristicParamsData::NONE;
+  flatbuffers::Offset<void> data = 0;
+  if (auto pparams = dynamic_cast<const nvfuser::PointwiseParams*>(params)) {
+    data_type = HeuristicParamsData::PointwiseParams;
+    data = serializePointwiseParams(builder, pparams).Union();
+  } else if (
+      auto rparams = dynamic_cast<const nvfuser::ReductionParams*>(params)) {
+    data_type = HeuristicParamsData::ReductionParams;
+    data = serializeReductionParams(builder, rparams).Union();
+  } else if (
+      auto tparams = dynamic_cast<const nvfuser::TransposeParams*>(params)) {
+    data_type = HeuristicParamsData::TransposeParams;
+    data = serializeTransposeParams(builder, tparams).Union();
+  } else if (
+      auto mparams = dynamic_cast<const nvfuser::MatmulParams*>(params)) {
+    data_type = HeuristicParamsData::MatmulParams;
+    data = serializeMatmulParams(builder, mparams).Union();
+  } else if (
+      auto rsparams = dynamic_cast<const nvfuser::ResizeParams*>(params)) {
+    data_type = HeuristicParamsData::ResizeParams;
+    data = serializeResizeParams(builder, rsparams).Union();
+  } else {
+    NVF_ERROR(
+        params->isStrictlyA<nvfuser::HeuristicParams>(),
+        "Serialization is not implemented for the heuristic parameters of ",
+        params->scheduler_type);
+  }
+
+  return CreateHeuristicParams(
+      builder,
+      toUnderlying(params->scheduler_type),
+      builder.CreateString(params->tag),
+      params->lparams.serialize(builder),
+      serializeCompileParams(builder, params->cparams),
+      data_type,
+      data);
+}
+
+std::unique_ptr<nvfuser::HeuristicParams> deserializeHeuristicParams(
+    const HeuristicParams* buffer,
+    Fusion* segment_fusion) {
+  // See table definition for HeuristicParams in serde/fusion_cache.fbs
+  NVF_ERROR(buffer != nullptr, "serde::HeuristicParams is nullptr.");
+  auto scheduler_type = static_cast<SchedulerType>(buffer->scheduler_type());
+
+  std::unique_ptr<nvfuser::HeuristicParams> params;
+  switch (buffer->data_type()) {
+    case HeuristicParamsData::PointwiseParams: {
+      auto pparams = std::make_unique<nvfuser::PointwiseParams>(scheduler_type);
+      deserializePointwiseParams(
+          buffer->data_as_PointwiseParams(), pparams.get());
+      params = std::move(pparams);
+      break;
+    }
+    case HeuristicParamsData::ReductionParams: {
+      auto rparams = std::make_unique<nvfuser::ReductionParams>(scheduler_type);
+      deserializeReductionParams(
+          buffer->data_as_ReductionParams(), segment_fusion, rparams.get());
+      params = std::move(rparams);
+      break;
+    }
+    case HeuristicParamsData::TransposeParams: {
+      auto tparams = std::make_unique<nvfuser::TransposeParams>(scheduler_type);
+      deserializeTransposeParams(
+          buffer->data_as_TransposeParams(), tparams.get());
+      params = std::move(tparams);
+      break;
+    }
+    case HeuristicParamsData::MatmulParams: {
+      auto mparams = std::make_unique<nvfuser::MatmulParams>();
+      NVF_ERROR(mparams->scheduler_type == scheduler_type);
+      deserializeMatmulParams(buffer->data_as_MatmulParams(), mparams.get());
+      params = std::move(mparams);
+      break;
+    }
+    case HeuristicParamsData::ResizeParams: {
+      auto rparams = std::make_unique<nvfuser::ResizeParams>(scheduler_type);
+      deserializeResizeParams(buffer->data_as_ResizeParams(), rparams.get());
+      params = std::move(rparams);
+      break;
+    }
+    default:
+      params = std::make_unique<nvfuser::HeuristicParams>(scheduler_type);
+      break;
+  }
+
+  params->tag = buffer->tag()->str();
+  params->lparams.deserialize(buffer->lparams());
+  params->cparams = deserializeCompileParams(buffer->cparams());
+  return params;
+}
+
+} // namespace nvfuser::serde
@@ -0,0 +1,32 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#pragma once
+#include <fusion.h>
+#include <scheduler/heuristic.h>
+#include <serde/fusion_cache_generated.h>
+#include <visibility.h>
+
+#include <memory>
+
+namespace nvfuser::serde {
+
+//! Serializes the parameters of a segment, including those of the
+//! PointwiseParams, ReductionParams, TransposeParams, MatmulParams and
+//! ResizeParams subclasses.
+NVF_API flatbuffers::Offset<HeuristicParams> serializeHeuristicParams(
+    flatbuffers::FlatBufferBuilder& builder,
+    const nvfuser::HeuristicParams* params);
+
+//! Rebuilds the parameters of a segment. The TensorViews the parameters refer
+//! to, e.g., ReductionParams::smem_persistent_buffers, are looked up by name
+//! in segment_fusion.
+NVF_API std::unique_ptr<nvfuser::HeuristicParams> deserializeHeuristicParams(
+    const HeuristicParams* buffer,
+    Fusion* segment_fusion);
+
+} // namespace nvfuser::serde
@@ -20,200 +20,6 @@ namespace nvfuser {
 
 namespace {
 
-// Forward traverse from logical domain to allocation domain, compute frontier
-// sizes and strides, validate that splits are divisible and merges are
-// contiguous, and update active_ids_ correspondingly.
-class ForwardTraverseFromLogicalToAlloc {
-  ExpressionEvaluator& ee_;
-  std::unordered_map<IterDomain*, std::pair<int64_t, int64_t>>& active_ids_;
-
-  void handle(Split* split) {
-    auto in = split->in();
-    auto inner = split->inner();
-    auto outer = split->outer();
-    auto in_it = active_ids_.find(in);
-    // NVF_ERROR(in_it != active_ids_.end())
-    if (in_it == active_ids_.end()) {
-      // TODO: see [Allocation domain on both side of logical]
-      return;
-    }
-
-    auto [in_size, in_stride] = in_it->second;
-    auto factor = ee_.evaluate(split->factor()).as<int64_t>();
-    NVF_ERROR(
-        in_size % factor == 0,
-        "The logical domain and allocation domain of fusion input/output ",
-        "tensors must be a one-to-one map, therefore, ",
-        "non-divisible split is not allowed in allocation domain");
-
-    int64_t inner_size = 0;
-    int64_t outer_size = 0;
-    if (split->innerSplit()) {
-      outer_size = in_size / factor;
-      inner_size = factor;
-    } else {
-      outer_size = factor;
-      inner_size = in_size / factor;
-    }
-
-    NVF_ERROR(active_ids_.erase(in) == 1);
-    NVF_ERROR(active_ids_.emplace(inner, std::make_pair(inner_size, in_stride))
-                  .second);
-    NVF_ERROR(
-        active_ids_
-            .emplace(outer, std::make_pair(outer_size, in_stride * inner_size))
-            .second);
-  }
-
-  void handle(Merge* merge) {
-    auto inner = merge->inner();
-    auto outer = merge->outer();
-    auto out = merge->out();
-    auto inner_it = active_ids_.find(inner);
-    auto outer_it = active_ids_.find(outer);
-    // NVF_ERROR(inner_it != active_ids_.end())
-    // NVF_ERROR(outer_it != active_ids_.end())
-    if (inner_it == active_ids_.end() || outer_it == active_ids_.end()) {
-      // TODO: see [Allocation domain on both side of logical]
-      return;
-    }
-    auto [inner_size, inner_stride] = inner_it->second;
-    auto [outer_size, outer_stride] = outer_it->second;
-    NVF_ERROR(
-        inner_stride * inner_size == outer_stride,
-        "Merging of discontiguous dimensions is not allowed in allocation "
-        "domain. An allocation IterDomain can't have two different strides.");
-    NVF_ERROR(active_ids_.erase(inner) == 1);
-    NVF_ERROR(active_ids_.erase(outer) == 1);
-    NVF_ERROR(
-        active_ids_
-            .emplace(out, std::make_pair(inner_size * outer_size, inner_stride))
-            .second);
-  }
-
-  void handle(Expr* expr) {
-    if (auto split = dynamic_cast<Split*>(expr)) {
-      handle(split);
-    } else if (auto merge = dynamic_cast<Merge*>(expr)) {
-      handle(merge);
-    } else {
-      NVF_THROW("Unsupported transormation in allocation domain");
-    }
-  }
-
- public:
-  ForwardTraverseFromLogicalToAlloc(
-      ExpressionEvaluator& ee,
-      std::unordered_map<IterDomain*, std::pair<int64_t, int64_t>>& active_ids)
-      : ee_(ee), active_ids_(active_ids) {}
-
-  void run(
-      TensorView* tv,
-      const std::vector<IterDomain*>& logical,
-      const std::vector<IterDomain*>& alloc) {
-    auto forward_exprs = StmtSort::getExprsBetween(
-        {logical.begin(), logical.end()}, {alloc.begin(), alloc.end()});
-    for (auto expr : forward_exprs) {
-      handle(expr);
-    }
-  }
-};
-
-// Similar to ForwardTraverseFromLogicalToAlloc, but in the opposite direction.
-class BackwardTraverseFromLogicalToAlloc {
-  at::Tensor tensor_;
-  ExpressionEvaluator& ee_;
-  std::unordered_map<IterDomain*, std::pair<int64_t, int64_t>>& active_ids_;
-
-  void handle(Split* split) {
-    auto in = split->in();
-    auto inner = split->inner();
-    auto outer = split->outer();
-    auto inner_it = active_ids_.find(inner);
-    auto outer_it = active_ids_.find(outer);
-    // NVF_ERROR(inner_it != active_ids_.end())
-    // NVF_ERROR(outer_it != active_ids_.end())
-    if (inner_it == active_ids_.end() || outer_it == active_ids_.end()) {
-      // TODO: see [Allocation domain on both side of logical]
-      return;
-    }
-    auto [inner_size, inner_stride] = inner_it->second;
-    auto [outer_size, outer_stride] = outer_it->second;
-    NVF_ERROR(
-        inner_stride * inner_size == outer_stride,
-        "The logical domain and allocation domain of fusion input/output ",
-        "tensors must be a one-to-one map, therefore, ",
-        "splitting one dimension into discontiguous dimensions is not allowed "
-        "in allocation domain");
-    NVF_ERROR(active_ids_.erase(inner) == 1);
-    NVF_ERROR(active_ids_.erase(outer) == 1);
-    NVF_ERROR(active_ids_
-                  .emplace(
-                      in,
-                      std::pair<int64_t, int64_t>{
-                          inner_size * outer_size, inner_stride})
-                  .second);
-  }
-
-  void handle(Merge* merge) {
-    auto inner = merge->inner();
-    auto outer = merge->outer();
-    auto out = merge->out();
-    auto factor = ee_.evaluate(inner->extent()).as<int64_t>();
-    auto out_it = active_ids_.find(out);
-    // NVF_ERROR(out_it != active_ids_.end())
-    if (out_it == active_ids_.end()) {
-      // TODO: see [Allocation domain on both side of logical]
-      return;
-    }
-    auto [out_size, out_stride] = out_it->second;
-    NVF_ERROR(
-        out_size % factor == 0,
-        "The logical domain and allocation domain of fusion input/output ",
-        "tensors must be a one-to-one map, therefore, ",
-        "the size of the output must divisible by the size of inner dimension");
-    NVF_ERROR(active_ids_.erase(out) == 1);
-    NVF_ERROR(
-        active_ids_
-            .emplace(inner, std::pair<int64_t, int64_t>{factor, out_stride})
-            .second);
-    NVF_ERROR(active_ids_
-                  .emplace(
-                      outer,
-                      std::pair<int64_t, int64_t>{
-                          out_size / factor, out_stride * factor})
-                  .second);
-  }
-
-  void handle(Expr* expr) {
-    if (auto split = dynamic_cast<Split*>(expr)) {
-      handle(split);
-    } else if (auto merge = dynamic_cast<Merge*>(expr)) {
-      handle(merge);
-    } else {
-      NVF_THROW("Unsupported transormation in allocation domain");
-    }
-  }
-
- public:
-  BackwardTraverseFromLogicalToAlloc(
-      ExpressionEvaluator& ee,
-      std::unordered_map<IterDomain*, std::pair<int64_t, int64_t>>& active_ids)
-      : ee_(ee), active_ids_(active_ids) {}
-
-  void run(
-      TensorView* tv,
-      const std::vector<IterDomain*>& logical,
-      const std::vector<IterDomain*>& alloc) {
-    auto backward_exprs = StmtSort::getExprsBetween(
-        {alloc.begin(), alloc.end()}, {logical.begin(), logical.end()});
-    std::reverse(backward_exprs.begin(), backward_exprs.end());
-    for (auto expr : backward_exprs) {
-      handle(expr);
-    }
-  }
-};
-
 void validateAllocationSizesAndStrides(
     const std::vector<IterDomain*>& alloc_dom,
     const std::vector<std::optional<bool>>& contiguity,
@@ -284,46 +90,222 @@ void validateAllocationSizesAndStrides(
 
 } // namespace
 
-std::pair<std::vector<int64_t>, std::vector<int64_t>>
-inferAndValidateAllocationSizesAndStrides(
-    const at::Tensor& tensor,
-    TensorView* tv,
-    ExpressionEvaluator ee) {
-  const auto& logical = tv->getLogicalDomain();
-  const auto& alloc = tv->getMaybeAllocationDomain();
-
-  // active IDs and their shape and stride
-  std::vector<int64_t> logical_sizes = unshardedSizes(tv, tensor.sizes());
-  std::unordered_map<IterDomain*, std::pair<int64_t, int64_t>> active_ids;
-  int64_t dim_index = 0;
+std::shared_ptr<const AllocationDomainProgram> AllocationDomainProgram::
+    compile(TensorView* tv) {
+  auto program = std::make_shared<AllocationDomainProgram>();
+  program->domain_ = tv->domain();
+  program->logical_ = tv->getLogicalDomain();
+  program->alloc_ = tv->getMaybeAllocationDomain();
+  const std::vector<IterDomain*>& logical = program->logical_;
+  const std::vector<IterDomain*>& alloc = program->alloc_;
+
+  // The slots of the active IDs
+  std::unordered_map<IterDomain*, int64_t> slots;
+  auto add_slot = [&](IterDomain* id) {
+    const int64_t slot = program->num_slots_++;
+    NVF_ERROR(slots.emplace(id, slot).second);
+    return slot;
+  };
+  auto take_slot = [&](IterDomain* id) {
+    auto it = slots.find(id);
+    NVF_ERROR(it != slots.end());
+    const int64_t slot = it->second;
+    slots.erase(it);
+    return slot;
+  };
+  auto make_factor = [](Val* factor) {
+    return factor->isConstInt()
+        ? Factor{nullptr, factor->evaluate().as<int64_t>()}
+        : Factor{factor, 0};
+  };
   for (IterDomain* id : TensorDomain::noReductions(logical)) {
-    active_ids[id] = {logical_sizes.at(dim_index), tensor.stride(dim_index)};
-    dim_index++;
+    add_slot(id);
+  }
+  program->num_logical_dims_ = program->num_slots_;
+
+  // Forward traverse from logical domain to allocation domain, validating
+  // that splits are divisible and merges are contiguous.
+  for (Expr* expr : StmtSort::getExprsBetween(
+           {logical.begin(), logical.end()}, {alloc.begin(), alloc.end()})) {
+    if (auto* split = dynamic_cast<Split*>(expr)) {
+      if (!slots.contains(split->in())) {
+        // TODO: see [Allocation domain on both side of logical]
+        continue;
+      }
+      Op op{OpType::ForwardSplit};
+      op.factor = make_factor(split->factor());
+      op.inner_split = split->innerSplit();
+      op.in = take_slot(split->in());
+      op.inner = add_slot(split->inner());
+      op.outer = add_slot(split->outer());
+      program->ops_.push_back(op);
+    } else if (auto* merge = dynamic_cast<Merge*>(expr)) {
+      if (!slots.contains(merge->inner()) || !slots.contains(merge->outer())) {
+        // TODO: see [Allocation domain on both side of logical]
+        continue;
+      }
+      Op op{OpType::ForwardMerge};
+      op.inner = take_slot(merge->inner());
+      op.outer = take_slot(merge->outer());
+      op.in = add_slot(merge->out());
+      program->ops_.push_back(op);
+    } else {
+      NVF_THROW("Unsupported transormation in allocation domain");
+    }
   }
-  NVF_ERROR(dim_index == tensor.dim());
 
-  ForwardTraverseFromLogicalToAlloc(ee, active_ids).run(tv, logical, alloc);
-  BackwardTraverseFromLogicalToAlloc(ee, active_ids).run(tv, logical, alloc);
+  // Similarly, but in the opposite direction
+  std::vector<Expr*> backward_exprs = StmtSort::getExprsBetween(
+      {alloc.begin(), alloc.end()}, {logical.begin(), logical.end()});
+  std::reverse(backward_exprs.begin(), backward_exprs.end());
+  for (Expr* expr : backward_exprs) {
+    if (auto* split = dynamic_cast<Split*>(expr)) {
+      if (!slots.contains(split->inner()) || !slots.contains(split->outer())) {
+        // TODO: see [Allocation domain on both side of logical]
+        continue;
+      }
+      Op op{OpType::BackwardSplit};
+      op.inner = take_slot(split->inner());
+      op.outer = take_slot(split->outer());
+      op.in = add_slot(split->in());
+      program->ops_.push_back(op);
+    } else if (auto* merge = dynamic_cast<Merge*>(expr)) {
+      if (!slots.contains(merge->out())) {
+        // TODO: see [Allocation domain on both side of logical]
+        continue;
+      }
+      Op op{OpType::BackwardMerge};
+      op.factor = make_factor(merge->inner()->extent());
+      op.in = take_slot(merge->out());
+      op.inner = add_slot(merge->inner());
+      op.outer = add_slot(merge->outer());
+      program->ops_.push_back(op);
+    } else {
+      NVF_THROW("Unsupported transormation in allocation domain");
+    }
+  }
 
-  // Now active_ids should contain the final sizes and strides, unordered. We
-  // need to put them to the correct order.
-  std::vector<int64_t> allocation_sizes;
-  std::vector<int64_t> allocation_strides;
-  allocation_sizes.reserve(alloc.size());
-  allocation_strides.reserve(alloc.size());
   for (IterDomain* id : TensorDomain::noReductions(alloc)) {
-    if (id->isDeviceDim()) {
-      allocation_sizes.push_back(1);
-    } else {
-      allocation_sizes.push_back(active_ids.at(id).first);
+    NVF_ERROR(
+        slots.contains(id),
+        "Can't infer the size and stride of allocation IterDomain ",
+        id->toString());
+    program->outputs_.emplace_back(slots.at(id), id->isDeviceDim());
+  }
+  return program;
+}
+
+bool AllocationDomainProgram::matches(const TensorView* tv) const {
+  return tv->domain() == domain_ && tv->getLogicalDomain() == logical_ &&
+      tv->getMaybeAllocationDomain() == alloc_;
+}
+
+std::pair<std::vector<int64_t>, std::vector<int64_t>> AllocationDomainProgram::
+    run(const std::vector<int64_t>& logical_sizes,
+        c10::IntArrayRef logical_strides,
+        const ExpressionEvaluator& ee) const {
+  auto evaluate = [&ee](const Factor& factor) {
+    return factor.val == nullptr ? factor.value
+                                 : ee.evaluate(factor.val).as<int64_t>();
+  };
+
+  // The sizes and strides of the slots
+  std::vector<std::pair<int64_t, int64_t>> values(num_slots_);
+  for (auto i : arange(std::ssize(logical_sizes))) {
+    values[i] = {logical_sizes[i], logical_strides[i]};
+  }
+  for (const Op& op : ops_) {
+    switch (op.type) {
+      case OpType::ForwardSplit: {
+        const auto [in_size, in_stride] = values[op.in];
+        const int64_t factor = evaluate(op.factor);
+        NVF_ERROR(
+            in_size % factor == 0,
+            "The logical domain and allocation domain of fusion input/output ",
+            "tensors must be a one-to-one map, therefore, ",
+            "non-divisible split is not allowed in allocation domain");
+        const int64_t inner_size =
+            op.inner_split ? factor : in_size / factor;
+        const int64_t outer_size =
+            op.inner_split ? in_size / factor : factor;
+        values[op.inner] = {inner_size, in_stride};
+        values[op.outer] = {outer_size, in_stride * inner_size};
+        break;
+      }
+      case OpType::ForwardMerge: {
+        const auto [inner_size, inner_stride] = values[op.inner];
+        const auto [outer_size, outer_stride] = values[op.outer];
+        NVF_ERROR(
+            inner_stride * inner_size == outer_stride,
+            "Merging of discontiguous dimensions is not allowed in allocation "
+            "domain. An allocation IterDomain can't have two different "
+            "strides.");
+        values[op.in] = {inner_size * outer_size, inner_stride};
+        break;
+      }
+      case OpType::BackwardSplit: {
+        const auto [inner_size, inner_stride] = values[op.inner];
+        const auto [outer_size, outer_stride] = values[op.outer];
+        NVF_ERROR(
+            inner_stride * inner_size == outer_stride,
+            "The logical domain and allocation domain of fusion input/output ",
+            "tensors must be a one-to-one map, therefore, ",
+            "splitting one dimension into discontiguous dimensions is not "
+            "allowed in allocation domain");
+        values[op.in] = {inner_size * outer_size, inner_stride};
+        break;
+      }
+      case OpType::BackwardMerge: {
+        const auto [out_size, out_stride] = values[op.in];
+        const int64_t factor = evaluate(op.factor);
+        NVF_ERROR(
+            out_size % factor == 0,
+            "The logical domain and allocation domain of fusion input/output ",
+            "tensors must be a one-to-one map, therefore, ",
+            "the size of the output must divisible by the size of inner "
+            "dimension");
+        values[op.inner] = {factor, out_stride};
+        values[op.outer] = {out_size / factor, out_stride * factor};
+        break;
+      }
     }
-    allocation_strides.push_back(active_ids.at(id).second);
   }
 
+  std::vector<int64_t> allocation_sizes;
+  std::vector<int64_t> allocation_strides;
+  allocation_sizes.reserve(outputs_.size());
+  allocation_strides.reserve(outputs_.size());
+  for (const auto& [slot, is_device_dim] : outputs_) {
+    allocation_sizes.push_back(is_device_dim ? 1 : values[slot].first);
+    allocation_strides.push_back(values[slot].second);
+  }
+  return {std::move(allocation_sizes), std::move(allocation_strides)};
+}
+
+std::pair<std::vector<int64_t>, std::vector<int64_t>>
+inferAndValidateAllocationSizesAndStrides(
+    const at::Tensor& tensor,
+    TensorView* tv,
+    const ExpressionEvaluator& ee) {
+  std::shared_ptr<const AllocationDomainProgram> program =
+      tv->allocationDomainProgram();
+  if (program == nullptr || !program->matches(tv)) {
+    program = AllocationDomainProgram::compile(tv);
+    tv->setAllocationDomainProgram(program);
+  }
+
+  std::vector<int64_t> logical_sizes = unshardedSizes(tv, tensor.sizes());
+  NVF_ERROR_EQ(std::ssize(logical_sizes), program->numLogicalDims());
+  auto [allocation_sizes, allocation_strides] =
+      program->run(logical_sizes, tensor.strides(), ee);
+
   // Only validate final sizes and strides when we have a non-empty tensor.
   if (tensor.numel() != 0) {
     validateAllocationSizesAndStrides(
-        alloc, tv->getContiguity(), allocation_sizes, allocation_strides);
+        tv->getMaybeAllocationDomain(),
+        tv->getContiguity(),
+        allocation_sizes,
+        allocation_strides);
   }
   return {std::move(allocation_sizes), std::move(allocation_strides)};
 }
@@ -13,6 +13,10 @@
 #include <polymorphic_value.h>
 #include <type.h>
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace nvfuser {
 
 struct TensorMetaData : public Struct {
@@ -100,6 +104,67 @@ struct TensorMetaData : public Struct {
   }
 };
 
+//! \class AllocationDomainProgram
+//! \brief The splits and merges between the logical and allocation domains
+//! of a TensorView, compiled into operations on the sizes and strides of
+//! slots, one for each IterDomain they visit. It's compiled once per
+//! TensorView and rerun for each tensor of it, so that the domains aren't
+//! traversed on every launch.
+class AllocationDomainProgram {
+ public:
+  static std::shared_ptr<const AllocationDomainProgram> compile(
+      TensorView* tv);
+
+  //! Whether tv still has the domains the program was compiled for
+  bool matches(const TensorView* tv) const;
+
+  int64_t numLogicalDims() const {
+    return num_logical_dims_;
+  }
+
+  //! Returns the allocation sizes and strides of a tensor with the given
+  //! unsharded logical sizes and logical strides. The extents of split
+  //! factors that aren't constants are evaluated by ee.
+  std::pair<std::vector<int64_t>, std::vector<int64_t>> run(
+      const std::vector<int64_t>& logical_sizes,
+      c10::IntArrayRef logical_strides,
+      const ExpressionEvaluator& ee) const;
+
+ private:
+  enum class OpType {
+    ForwardSplit,
+    ForwardMerge,
+    BackwardSplit,
+    BackwardMerge
+  };
+
+  //! A factor known at compile time if val is nullptr
+  struct Factor {
+    Val* val = nullptr;
+    int64_t value = 0;
+  };
+
+  //! in is the slot of the input of a split or of the output of a merge
+  struct Op {
+    OpType type;
+    int64_t in = -1;
+    int64_t inner = -1;
+    int64_t outer = -1;
+    Factor factor;
+    bool inner_split = true;
+  };
+
+  TensorDomain* domain_ = nullptr;
+  std::vector<IterDomain*> logical_;
+  std::vector<IterDomain*> alloc_;
+  //! The slots of the logical IterDomains come first
+  int64_t num_logical_dims_ = 0;
+  int64_t num_slots_ = 0;
+  std::vector<Op> ops_;
+  //! The slot of each allocation IterDomain, and whether it's a device dim
+  std::vector<std::pair<int64_t, bool>> outputs_;
+};
+
 // Given an ATen tensor, whose sizes and strides are w.r.t to the logical domain
 // of its corresponding TensorView, compute the sizes and strides of the tensor
 // with respect to its allocation domain.
@@ -109,10 +174,11 @@ struct TensorMetaData : public Struct {
 // Another example, if the logical domain is [I1*I2] and the allocation domain
 // is [I1, I2], and the tensor's size is [15] and stride is [7], and the extent
 // of I2 is 5, then the resulting size will be [3, 5] and stride will be [35, 7]
+// The transforms are compiled into an AllocationDomainProgram cached by tv.
 std::pair<std::vector<int64_t>, std::vector<int64_t>>
 inferAndValidateAllocationSizesAndStrides(
     const at::Tensor& tensor,
     TensorView* tv,
-    ExpressionEvaluator ee);
+    const ExpressionEvaluator& ee);
 
 } // namespace nvfuser
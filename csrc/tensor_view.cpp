@@ -1459,6 +1459,18 @@ void TensorView::setTMemDimSepPos(int64_t pos) {
   tmem_dim_sep_pos_ = pos;
 }
 
+std::shared_ptr<const AllocationDomainProgram> TensorView::
+    allocationDomainProgram() const {
+  std::lock_guard<std::mutex> guard(allocation_program_mutex_);
+  return allocation_program_;
+}
+
+void TensorView::setAllocationDomainProgram(
+    std::shared_ptr<const AllocationDomainProgram> program) const {
+  std::lock_guard<std::mutex> guard(allocation_program_mutex_);
+  allocation_program_ = std::move(program);
+}
+
 TensorViewBuilder& TensorViewBuilder::ndims(int64_t ndims) {
   NVF_CHECK(ndims >= 0);
   NVF_CHECK(shape_.empty() || (int64_t)shape_.size() == ndims);
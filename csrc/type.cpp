@@ -1462,6 +1462,12 @@ std::ostream& operator<<(std::ostream& os, const CacheOp& cache_op) {
     case CacheOp::Global:
       os << "Global";
       break;
+    case CacheOp::EvictLast:
+      os << "EvictLast";
+      break;
+    case CacheOp::NoAllocate:
+      os << "NoAllocate";
+      break;
     default:
       NVF_THROW("undefined cache operator");
       break;
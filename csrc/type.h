@@ -803,6 +803,13 @@ enum class CacheOp {
   AllLevels,
   Streaming,
   Global,
+  // Cache at all levels and evict last from L2 (ld.global.L2::cache_hint with
+  // a createpolicy evict_last policy). Used for data read by many blocks.
+  EvictLast,
+  // Load through the non-coherent path without allocating in L1
+  // (ld.global.nc.L1::no_allocate). Only valid for data that is not written
+  // by the kernel. Set by lowerToInlinePtx for vectorized input loads.
+  NoAllocate,
 };
 
 //! Used to annotate the special memory intrinsics that a loadstore op will be
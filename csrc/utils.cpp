@@ -20,25 +20,6 @@
 
 namespace nvfuser {
 
-int getNumThreads() {
-  const char* option_env_name = "NUM_THREADS";
-  auto dump_options = getNvFuserEnv(option_env_name);
-  if (dump_options == nullptr) {
-    constexpr int default_num_threads = 8;
-    return default_num_threads;
-  }
-  auto num_threads_value = std::atoi(dump_options);
-  int max_num_threads = (int)std::thread::hardware_concurrency();
-  return std::max(std::min(num_threads_value, max_num_threads), 1);
-}
-
-// TODO: clean this up with some knobs
-c10::ThreadPool* getThreadPool() {
-  static auto num_threads = getNumThreads();
-  static c10::ThreadPool pool(num_threads);
-  return &pool;
-}
-
 std::string debug_str(const at::Tensor& tensor) {
   std::stringstream ss;
   ss << "Tensor:";
@@ -19,8 +19,6 @@
 #include <tma.h>
 #include <type.h>
 
-#include <c10/core/thread_pool.h>
-
 #include <concepts>
 #include <coroutine>
 #include <deque>
@@ -60,9 +58,6 @@ constexpr int64_t kWarpSpecializationPaddedThreads = 128;
 
 class KernelArgumentHolder;
 
-int getNumThreads();
-c10::ThreadPool* getThreadPool();
-
 std::string debug_str(const at::Tensor& tensor);
 
 bool is_cpu_scalar(const at::Tensor& tensor);
@@ -411,16 +411,30 @@ void ValGraph::mapVals(Val* val0, Val* val1) {
   // Definitions and uses are based on the groups of id0 and id1, don't merge
   // them into a single group until we grab all definitions and uses for later
   // processing.
-  const ValGroup orig_val_group0 = toGroup(val0);
-  const ValGroup orig_val_group1 = toGroup(val1);
-
+  //
   // Note that getDefinitions and getUses return references, which
   // will be invalidated once unique_definitions_ and unique_uses_ are
   // updated
-  const ExprGroups orig_defs0 = getDefinitions(orig_val_group0);
-  const ExprGroups orig_defs1 = getDefinitions(orig_val_group1);
-  const ExprGroups orig_uses0 = getUses(orig_val_group0);
-  const ExprGroups orig_uses1 = getUses(orig_val_group1);
+  ExprGroups orig_defs0;
+  ExprGroups orig_defs1;
+  ExprGroups orig_uses0;
+  ExprGroups orig_uses1;
+  {
+    const ValGroup orig_val_group0 = toGroup(val0);
+    const ValGroup orig_val_group1 = toGroup(val1);
+    orig_defs0 = getDefinitions(orig_val_group0);
+    orig_defs1 = getDefinitions(orig_val_group1);
+    orig_uses0 = getUses(orig_val_group0);
+    orig_uses1 = getUses(orig_val_group1);
+
+    // The original groups are dropped before merging them, which lets
+    // DisjointSets reuse the larger one for the merged group instead of
+    // copying both.
+    unique_definitions_.erase(orig_val_group0);
+    unique_definitions_.erase(orig_val_group1);
+    unique_uses_.erase(orig_val_group0);
+    unique_uses_.erase(orig_val_group1);
+  }
 
   // Map the iter domains together before we traverse across definitions and
   // uses. Traversing definitions and uses could use the new property of id0 and
@@ -466,11 +480,6 @@ void ValGraph::mapVals(Val* val0, Val* val1) {
       }
     }
   }
-
-  unique_definitions_.erase(orig_val_group0);
-  unique_definitions_.erase(orig_val_group1);
-  unique_uses_.erase(orig_val_group0);
-  unique_uses_.erase(orig_val_group1);
 }
 
 void ValGraph::maybeMapThroughExprs(Expr* expr0, Expr* expr1, bool forward) {
@@ -7,6 +7,7 @@
 // clang-format on
 #include <validator_utils.h>
 
+#include <algorithm>
 #include <unordered_map>
 
 #include <ATen/cuda/CUDAContext.h>
@@ -16,6 +17,7 @@
 #include <expr_evaluator.h>
 #include <fusion.h>
 #include <ir/iostream.h>
+#include <options.h>
 #include <runtime/executor_utils.h>
 
 namespace nvfuser {
@@ -24,6 +26,16 @@ std::pair<double, double> getTolerance(
     DataType dtype,
     int64_t reduction_size,
     const ValidationConstants& tolerances) {
+  // Approximate functions loosen the tolerances of floats. Double shares the
+  // tolerances of float and is never approximated.
+  if (dtype == DataType::Float && isOptionEnabled(EnableOption::FastMath)) {
+    const auto [abs_tol, rel_tol] =
+        getTolerance(DataType::Double, reduction_size, tolerances);
+    return {
+        std::max(abs_tol, tolerances.fast_math_float_abs_tol),
+        std::max(rel_tol, tolerances.fast_math_float_rel_tol)};
+  }
+
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
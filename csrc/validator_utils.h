@@ -49,6 +49,14 @@ struct ValidationConstants {
   double base_half_rel_tol = -1;
   double base_float_abs_tol = -1;
   double base_float_rel_tol = -1;
+
+  // Lower bounds of the tolerances of floats with EnableOption::FastMath.
+  // tanh.approx.f32, which also computes sigmoid and silu, has the largest
+  // relative error, 2^-10.987. ex2.approx.f32 and __expf are within
+  // 2 + floor(1.173 * |x|) ulps, and __logf, __sinf and __cosf within an
+  // absolute error of 2^-21.41 in their accurate ranges.
+  double fast_math_float_abs_tol = 1e-3;
+  double fast_math_float_rel_tol = 1e-3;
 };
 
 // Returns abs and relative values to use for validation.
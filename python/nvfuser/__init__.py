@@ -209,6 +209,7 @@ class FusionDefinition(_C._FusionDefinition):
         print_repro=False,
         profile=False,
         save_repro_inputs=False,
+        out: list[torch.Tensor] | None = None,
         _enable_options: list[str] = [],
         _disable_options: list[str] = [],
     ) -> list[torch.Tensor] | tuple[list[torch.Tensor], list[Sharding]]:
@@ -230,6 +231,13 @@ class FusionDefinition(_C._FusionDefinition):
         device, i.e. `torch.device("cuda:0")`. This method enables selecting an
         alternative preferred device.
 
+        Kernels, ATen ops evaluated in place of kernels and communications are
+        all enqueued on the current CUDA stream of the device, e.g., the one
+        set by `torch.cuda.stream`, and this method returns without waiting for
+        them. The outputs are ready in the order of that stream. The host only
+        waits for the device when it needs a value computed there, e.g., the
+        sizes of an output that depend on the values of an input.
+
         Args:
             inputs (List[Union[Tensor, Scalar]]): A list of inputs to fusion.
 
@@ -253,6 +261,13 @@ class FusionDefinition(_C._FusionDefinition):
             profile (bool): Captures a CUPTI based profile of a fusion.
             save_repro_inputs (bool): Saves the inputs for last_repro_script() to
                 provide a provide a reproduction script.
+            out (Optional[List[Tensor]]): A tensor for each output, e.g., a slot
+                of a KV cache, to write the output into instead of allocating
+                it. The tensors are returned as the outputs. Kernels write
+                into them directly, so they must have the sizes, strides and
+                dtypes of the outputs; outputs that no kernel produces, like
+                views of inputs, are copied into them. Not supported with user,
+                multidevice or segment schedules.
             _enable_options/_disable_options (list): NVFUSER_ENABLE/DISABLE options to use.
                 This is an alternative to environment variables.
                 Note: Currently, we do not cache/store these options in the FusionCache which makes it
@@ -317,6 +332,7 @@ class FusionDefinition(_C._FusionDefinition):
             self.fake_inputs = [fake_mode.from_tensor(inp) for inp in inputs]
 
         if hasattr(self, "segments") and len(self.segments) > 0:
+            assert out is None, "out is not supported with segments"
             return self._execute_segments(inputs, device=device, profile=profile)
 
         try:
@@ -335,6 +351,7 @@ class FusionDefinition(_C._FusionDefinition):
                 profile=profile,
                 _enable_options=_enable_options,
                 _disable_options=_disable_options,
+                out=out,
             )
 
             if defined_multidevice_schedule:
@@ -347,6 +364,47 @@ class FusionDefinition(_C._FusionDefinition):
             logger.exception(self._repro_error_str("executing", inputs))
             raise
 
+    def compile(self, *, device=None) -> Callable[..., list[torch.Tensor]]:
+        """
+        Returns a callable that executes this FusionDefinition with less host
+        overhead than :meth:`execute`, e.g., for the decode steps of a model
+        whose kernels are as short as the host work of launching them.
+
+        The callable takes the inputs as positional arguments and returns the
+        output tensors. Each call goes straight to the executor of the fusion:
+        tensors are passed without conversion and no schedule is looked up.
+        In exchange, it doesn't support the options of :meth:`execute`, user
+        or multidevice schedules, or segments. The number of inputs is fixed,
+        but their sizes can change from call to call like with
+        :meth:`execute`.
+
+        Kwargs:
+            device (Optional[Union[int, str, torch.device]]): The device to
+                run on, like the argument of :meth:`execute`.
+
+        Returns:
+            The callable.
+        """
+        if not isinstance(device, int) and device is not None:
+            device = torch.device(device)
+            assert (
+                device.type == "cuda"
+            ), "If device argument is passed it must be a CUDA device"
+            device = device.index
+
+        if self.id() is None:
+            assert not hasattr(self, "schedule") and not hasattr(
+                self, "multidevice_schedule"
+            ), "A FusionDefinition with a schedule can't be compiled."
+            self._setup_definition()
+            self.definition()
+            self._finalize_definition()
+        assert not (
+            hasattr(self, "segments") and len(self.segments) > 0
+        ), "A segmented FusionDefinition can't be compiled."
+
+        return self._compile(device=device)
+
     def debug_output(self):
         """
         Retrieve string of captured debug information from the previous execution.
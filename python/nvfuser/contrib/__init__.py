@@ -2,8 +2,15 @@
 # All rights reserved.
 # SPDX-License-Identifier: BSD-3-Clause
 from . import nn
+from .multi_tensor import multi_tensor_apply
+from .ragged import RaggedTensor, ragged_apply, ragged_layer_norm, ragged_softmax
 
 
 __all__ = [
+    "RaggedTensor",
+    "multi_tensor_apply",
     "nn",
+    "ragged_apply",
+    "ragged_layer_norm",
+    "ragged_softmax",
 ]
@@ -0,0 +1,223 @@
+# SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple, Union
+
+import torch
+
+import nvfuser
+from nvfuser import DataType, FusionDefinition
+
+
+__all__ = [
+    "multi_tensor_apply",
+]
+
+
+# Traced definitions, keyed by the function, the layouts of the tensors and the
+# types of the scalars. The sizes are static in the definitions because they
+# determine where each tensor lives in the packed tensors.
+_definitions: Dict[Any, Tuple[FusionDefinition, List[Optional[int]]]] = {}
+
+
+def _scalar_dtype(value: Union[bool, int, float]) -> DataType:
+    if isinstance(value, bool):
+        return DataType.Bool
+    if isinstance(value, int):
+        return DataType.Int
+    return DataType.Double
+
+
+def _pack(
+    fd: FusionDefinition,
+    tensors: List["nvfuser.Tensor"],
+    numels: List[int],
+    padded_numels: List[int],
+) -> "nvfuser.Tensor":
+    """Flattens `tensors` and concatenates them, each padded to its entry in
+    `padded_numels` so that every tensor starts at an aligned offset."""
+    flat = []
+    for tensor, numel, padded_numel in zip(tensors, numels, padded_numels):
+        tensor = fd.ops.reshape(tensor, [numel])
+        if padded_numel != numel:
+            tensor = fd.ops.pad(tensor, [0, padded_numel - numel])
+        flat.append(tensor)
+    if len(flat) == 1:
+        return flat[0]
+    return fd.ops.cat(flat, dim=0)
+
+
+def _define(
+    fd: FusionDefinition,
+    fn: Callable,
+    tensor_lists: Sequence[Sequence[torch.Tensor]],
+    scalars: Sequence[Union[bool, int, float]],
+    alias_outputs: Optional[Sequence[Optional[int]]],
+    alignment_bytes: int,
+) -> List[Optional[int]]:
+    """Defines the packed fusion in `fd` and returns the alias of each output
+    of `fn`."""
+    groups = list(zip(*tensor_lists))
+    inputs = [[fd.from_pytorch(t, static_sizes=True) for t in ts] for ts in groups]
+    scalar_inputs = [fd.define_scalar(dtype=_scalar_dtype(s)) for s in scalars]
+
+    # Every operand of a group has the same number of elements. Padding them
+    # to a multiple of the alignment of the narrowest dtype keeps the offsets
+    # of all the packed tensors aligned, so that the resize scheduler can
+    # vectorize each of them.
+    min_itemsize = min(t.element_size() for ts in tensor_lists for t in ts)
+    alignment = max(alignment_bytes // min_itemsize, 1)
+    numels = [ts[0].numel() for ts in groups]
+    padded_numels = [(n + alignment - 1) // alignment * alignment for n in numels]
+    offsets = [0]
+    for padded_numel in padded_numels[:-1]:
+        offsets.append(offsets[-1] + padded_numel)
+
+    packed = [
+        _pack(fd, [ins[j] for ins in inputs], numels, padded_numels)
+        for j in range(len(tensor_lists))
+    ]
+    outputs = fn(fd, packed, scalar_inputs)
+    if alias_outputs is None:
+        alias_outputs = [None] * len(outputs)
+    if len(alias_outputs) != len(outputs):
+        raise ValueError(
+            f"alias_outputs has {len(alias_outputs)} entries "
+            f"but fn returned {len(outputs)} outputs"
+        )
+
+    for output, alias in zip(outputs, alias_outputs):
+        for i, (offset, numel) in enumerate(zip(offsets, numels)):
+            shape = list(groups[i][0].size())
+            unpacked = fd.ops.reshape(
+                fd.ops.slice(output, [offset], [offset + numel]), shape
+            )
+            if alias is None:
+                fd.add_output(unpacked)
+            else:
+                fd.add_output(unpacked, alias_input=inputs[i][alias])
+    return list(alias_outputs)
+
+
+def multi_tensor_apply(
+    fn: Callable,
+    tensor_lists: Sequence[Sequence[torch.Tensor]],
+    scalars: Sequence[Union[bool, int, float]] = (),
+    *,
+    alias_outputs: Optional[Sequence[Optional[int]]] = None,
+    max_tensors_per_kernel: int = 32,
+    alignment_bytes: int = 16,
+) -> List[List[torch.Tensor]]:
+    """Apply the same pointwise computation to many groups of tensors, with as
+    few kernels as possible.
+
+    This is nvFuser's counterpart of Apex's `multi_tensor_apply`, e.g., for
+    the steps of Adam or LAMB over all the parameters of a model. The i-th
+    group consists of `tensor_lists[j][i]` for all j, which must have the same
+    number of elements, but different groups can have different sizes.
+
+    Instead of a fusion per group, the operands of up to
+    `max_tensors_per_kernel` groups are flattened and packed into one tensor
+    per list inside a single fusion, `fn` is applied once to the packed
+    tensors, and its outputs are sliced back into the groups. The resize
+    scheduler takes such a fusion as a whole, so the packing only exists in
+    the index math of the kernel: each element finds the tensor it belongs to
+    from its offset, like a chunk table, and no packed copy is materialized.
+    Each tensor starts at an offset aligned to `alignment_bytes`, so the
+    accesses stay vectorized.
+
+    Groups are chunked in order and the operands of a list must share a
+    dtype within a chunk; a chunk ends early at a change of dtype.
+
+    Args:
+        fn: Called as `fn(fd, packed, scalars)` with the FusionDefinition, the
+            packed tensors, one per list, and the scalars defined as inputs of
+            the fusion. Returns a list of pointwise outputs of the same size
+            as the packed tensors.
+        tensor_lists: The lists of tensors. Lists have the same length, i.e.,
+            the number of groups.
+        scalars: Scalars passed to `fn`, e.g., the learning rate. They are
+            inputs of the fusion, so changing them doesn't retrace it.
+        alias_outputs: For each output of `fn`, the index of the list that it
+            updates in place, or None to return it. Defaults to returning all
+            the outputs.
+        max_tensors_per_kernel: The maximum number of groups packed in one
+            fusion. Each element of the packed tensor tests the offsets of
+            the groups, so very long lists are split over several kernels.
+        alignment_bytes: The alignment of the offsets of the packed tensors.
+
+    Returns:
+        For each output of `fn`, the list of its slices for each group, or
+        the updated tensors of the aliased list.
+    """
+    if not tensor_lists or not tensor_lists[0]:
+        return []
+    num_groups = len(tensor_lists[0])
+    if any(len(ts) != num_groups for ts in tensor_lists):
+        raise ValueError("All the tensor lists must have the same length")
+    for i in range(num_groups):
+        if any(ts[i].numel() != tensor_lists[0][i].numel() for ts in tensor_lists):
+            raise ValueError(f"The tensors of group {i} have different sizes")
+
+    def dtypes(i: int) -> Tuple[torch.dtype, ...]:
+        return tuple(ts[i].dtype for ts in tensor_lists)
+
+    results: Optional[List[List[torch.Tensor]]] = None
+    begin = 0
+    while begin < num_groups:
+        end = begin + 1
+        while (
+            end < num_groups
+            and end - begin < max_tensors_per_kernel
+            and dtypes(end) == dtypes(begin)
+        ):
+            end += 1
+        chunk = [list(ts[begin:end]) for ts in tensor_lists]
+        outputs = _apply_chunk(fn, chunk, scalars, alias_outputs, alignment_bytes)
+        if results is None:
+            results = [[] for _ in outputs]
+        for result, output in zip(results, outputs):
+            result.extend(output)
+        begin = end
+    return results
+
+
+def _apply_chunk(
+    fn: Callable,
+    tensor_lists: List[List[torch.Tensor]],
+    scalars: Sequence[Union[bool, int, float]],
+    alias_outputs: Optional[Sequence[Optional[int]]],
+    alignment_bytes: int,
+) -> List[List[torch.Tensor]]:
+    key = (
+        fn,
+        tuple(
+            (tuple(t.size()), tuple(t.stride()), t.dtype, t.device)
+            for ts in tensor_lists
+            for t in ts
+        ),
+        tuple(_scalar_dtype(s) for s in scalars),
+        None if alias_outputs is None else tuple(alias_outputs),
+        alignment_bytes,
+    )
+    if key not in _definitions:
+        with FusionDefinition() as fd:
+            aliases = _define(
+                fd, fn, tensor_lists, scalars, alias_outputs, alignment_bytes
+            )
+        _definitions[key] = (fd, aliases)
+    fd, aliases = _definitions[key]
+
+    groups = list(zip(*tensor_lists))
+    outputs = fd.execute([t for ts in groups for t in ts] + list(scalars))
+
+    # Aliased outputs aren't returned by the fusion.
+    results = []
+    next_output = 0
+    for alias in aliases:
+        if alias is None:
+            results.append(list(outputs[next_output : next_output + len(groups)]))
+            next_output += len(groups)
+        else:
+            results.append(list(tensor_lists[alias]))
+    return results
@@ -0,0 +1,289 @@
+# SPDX-FileCopyrightText: Copyright (c) 2026-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+from typing import Any, Callable, Dict, List, Optional, Sequence, Union
+
+import torch
+
+import nvfuser
+from nvfuser import DataType, FusionDefinition
+from nvfuser.pytorch_utils import torch_dtype_to_nvfuser_dtype
+
+
+__all__ = [
+    "RaggedTensor",
+    "ragged_apply",
+    "ragged_layer_norm",
+    "ragged_softmax",
+]
+
+
+class RaggedTensor:
+    """Rows of different lengths packed one after the other, without padding,
+    e.g., the tokens of a batch of sequences of different lengths.
+
+    Row i is `values[offsets[i]:offsets[i + 1]]`. The trailing dimensions of
+    `values`, e.g., the hidden size, are the same for all rows.
+
+    Args:
+        values: The packed rows, of shape [total_length, ...].
+        offsets: A 1D integer tensor on the device of `values` with the
+            num_rows + 1 boundaries of the rows, starting with 0 and ending
+            with total_length.
+        max_length: The length of the longest row. Like the maximum sequence
+            length of variable-length attention, it's usually known on the
+            host; it's computed from `offsets` otherwise, which synchronizes
+            with the device.
+    """
+
+    def __init__(
+        self,
+        values: torch.Tensor,
+        offsets: torch.Tensor,
+        max_length: Optional[int] = None,
+    ):
+        if offsets.dim() != 1 or offsets.numel() == 0:
+            raise ValueError("offsets must be a non-empty 1D tensor")
+        if offsets.device != values.device:
+            raise ValueError("values and offsets must be on the same device")
+        self.values = values
+        self.offsets = offsets.to(torch.int64)
+        if max_length is None:
+            lengths = self.lengths()
+            max_length = int(lengths.max()) if lengths.numel() > 0 else 0
+        self.max_length = max_length
+        self._row_ids: Optional[torch.Tensor] = None
+
+    @classmethod
+    def from_tensors(cls, tensors: Sequence[torch.Tensor]) -> "RaggedTensor":
+        """Packs `tensors`, which only differ in the size of their outermost
+        dimension, as the rows of a RaggedTensor."""
+        lengths = [t.size(0) for t in tensors]
+        offsets = [0]
+        for length in lengths:
+            offsets.append(offsets[-1] + length)
+        values = torch.cat(list(tensors))
+        return cls(
+            values,
+            torch.tensor(offsets, dtype=torch.int64, device=values.device),
+            max(lengths, default=0),
+        )
+
+    @property
+    def num_rows(self) -> int:
+        return self.offsets.numel() - 1
+
+    def lengths(self) -> torch.Tensor:
+        return self.offsets[1:] - self.offsets[:-1]
+
+    def row_ids(self) -> torch.Tensor:
+        """Returns the row of each element of `values`. It's computed once and
+        shared by the RaggedTensors returned by the ops."""
+        if self._row_ids is None:
+            self._row_ids = torch.repeat_interleave(
+                torch.arange(self.num_rows, device=self.values.device),
+                self.lengths(),
+                output_size=self.values.size(0),
+            )
+        return self._row_ids
+
+    def with_values(self, values: torch.Tensor) -> "RaggedTensor":
+        """Returns a RaggedTensor with the rows of this one and `values`."""
+        if values.size(0) != self.values.size(0):
+            raise ValueError("values must have the total length of the rows")
+        result = RaggedTensor(values, self.offsets, self.max_length)
+        result._row_ids = self._row_ids
+        return result
+
+    def to_padded(self, padding_value: float = 0.0) -> torch.Tensor:
+        """Returns the rows padded to [num_rows, max_length, ...]."""
+        padded = self.values.new_full(
+            (self.num_rows, self.max_length) + tuple(self.values.shape[1:]),
+            padding_value,
+        )
+        positions = torch.arange(
+            self.values.size(0), device=self.values.device
+        ) - self.offsets.index_select(0, self.row_ids())
+        padded[self.row_ids(), positions] = self.values
+        return padded
+
+
+def _check_same_rows(tensors: Sequence[RaggedTensor]) -> None:
+    for t in tensors[1:]:
+        if t.offsets is not tensors[0].offsets:
+            raise ValueError("The RaggedTensors must share their offsets")
+
+
+def _scalar_dtype(value: Union[bool, int, float]) -> DataType:
+    if isinstance(value, bool):
+        return DataType.Bool
+    if isinstance(value, int):
+        return DataType.Int
+    return DataType.Double
+
+
+# Traced definitions of ragged_apply, keyed by the function, the dtypes and
+# ranks of the values and the types of the scalars
+_apply_definitions: Dict[Any, FusionDefinition] = {}
+
+
+def ragged_apply(
+    fn: Callable,
+    inputs: Sequence[RaggedTensor],
+    scalars: Sequence[Union[bool, int, float]] = (),
+) -> List[RaggedTensor]:
+    """Applies a pointwise computation to RaggedTensors with the same rows.
+
+    The computation only reads and writes the packed values, so it does no
+    work for the padding that a padded batch would have.
+
+    Args:
+        fn: Called as `fn(fd, values, scalars)` with the FusionDefinition, the
+            values of `inputs` and the scalars defined as inputs of the
+            fusion. Returns a list of pointwise outputs with the outermost
+            dimension of the values.
+        inputs: RaggedTensors sharing the same offsets.
+        scalars: Scalars passed to `fn`. They are inputs of the fusion, so
+            changing them doesn't retrace it.
+
+    Returns:
+        A RaggedTensor with the rows of `inputs` for each output of `fn`.
+    """
+    if not inputs:
+        raise ValueError("ragged_apply needs at least one input")
+    _check_same_rows(inputs)
+    key = (
+        fn,
+        tuple((t.values.dtype, t.values.dim()) for t in inputs),
+        tuple(_scalar_dtype(s) for s in scalars),
+    )
+    if key not in _apply_definitions:
+        with FusionDefinition() as fd:
+            values = [fd.from_pytorch(t.values) for t in inputs]
+            scalar_inputs = [fd.define_scalar(dtype=_scalar_dtype(s)) for s in scalars]
+            for output in fn(fd, values, scalar_inputs):
+                fd.add_output(output)
+        _apply_definitions[key] = fd
+    outputs = _apply_definitions[key].execute(
+        [t.values for t in inputs] + list(scalars)
+    )
+    return [inputs[0].with_values(output) for output in outputs]
+
+
+def _define_row_view(
+    fd: FusionDefinition,
+    values: "nvfuser.Tensor",
+    starts: "nvfuser.Tensor",
+    lengths: "nvfuser.Tensor",
+    max_length: "nvfuser.Scalar",
+):
+    """Gathers the rows into a [num_rows, max_length] view and returns it with
+    the mask of its elements that belong to a row. Positions past the end of
+    their row read the first element instead, so they stay in bounds."""
+    num_rows = fd.ops.size(starts, 0)
+    shape = [num_rows, max_length]
+    positions = fd.ops.broadcast_in_dim(
+        fd.ops.iota(max_length, None, None, DataType.Int), shape, [1]
+    )
+    valid = fd.ops.lt(positions, fd.ops.broadcast_in_dim(lengths, shape, [0]))
+    index = fd.ops.where(
+        valid,
+        fd.ops.add(fd.ops.broadcast_in_dim(starts, shape, [0]), positions),
+        fd.define_scalar(0, dtype=DataType.Int),
+    )
+    # The values are broadcast along the rows, so the gather reads them in
+    # place.
+    rows = fd.ops.take_along_axis(fd.ops.broadcast(values, [True, False]), index, 1)
+    return rows, valid
+
+
+def _define_row_normalization(
+    fd: FusionDefinition, x: RaggedTensor, layer_norm: bool
+) -> None:
+    values = fd.from_pytorch(x.values)
+    starts = fd.from_pytorch(x.offsets[:-1])
+    lengths = fd.from_pytorch(x.lengths())
+    row_ids = fd.from_pytorch(x.row_ids())
+    max_length = fd.define_scalar(dtype=DataType.Int)
+    eps = fd.define_scalar(dtype=DataType.Double) if layer_norm else None
+
+    is_reduced_precision = x.values.dtype in (torch.float16, torch.bfloat16)
+    if is_reduced_precision:
+        values = fd.ops.cast(values, DataType.Float)
+    rows, valid = _define_row_view(fd, values, starts, lengths, max_length)
+    shape = [fd.ops.size(rows, 0), fd.ops.size(rows, 1)]
+    zero = fd.define_scalar(0.0)
+
+    # The statistics of the rows are reduced over the padded view, whose
+    # padding is masked out. The values are then normalized in their packed
+    # layout, with the statistics of their rows.
+    if layer_norm:
+        count = fd.ops.cast(lengths, DataType.Float)
+        mean = fd.ops.div(fd.ops.sum(fd.ops.where(valid, rows, zero), [1]), count)
+        centered = fd.ops.where(
+            valid, fd.ops.sub(rows, fd.ops.broadcast_in_dim(mean, shape, [0])), zero
+        )
+        var = fd.ops.div(fd.ops.sum(fd.ops.mul(centered, centered), [1]), count)
+        rstd = fd.ops.rsqrt(fd.ops.add(var, eps))
+        out = fd.ops.mul(
+            fd.ops.sub(values, fd.ops.index_select(mean, row_ids, 0)),
+            fd.ops.index_select(rstd, row_ids, 0),
+        )
+    else:
+        rows = fd.ops.where(valid, rows, fd.define_scalar(float("-inf")))
+        row_max = fd.ops.max(rows, [1])
+        exp = fd.ops.where(
+            valid,
+            fd.ops.exp(
+                fd.ops.sub(rows, fd.ops.broadcast_in_dim(row_max, shape, [0]))
+            ),
+            zero,
+        )
+        row_sum = fd.ops.sum(exp, [1])
+        out = fd.ops.div(
+            fd.ops.exp(fd.ops.sub(values, fd.ops.index_select(row_max, row_ids, 0))),
+            fd.ops.index_select(row_sum, row_ids, 0),
+        )
+    if is_reduced_precision:
+        out = fd.ops.cast(out, torch_dtype_to_nvfuser_dtype(x.values.dtype))
+    fd.add_output(out)
+
+
+# Traced definitions of the row normalizations, keyed by the kind of
+# normalization and the dtype of the values
+_normalization_definitions: Dict[Any, FusionDefinition] = {}
+
+
+def _normalize_rows(
+    x: RaggedTensor, layer_norm: bool, eps: Optional[float] = None
+) -> RaggedTensor:
+    if x.values.dim() != 1:
+        raise ValueError("The rows must be 1D, i.e., values must be 1D")
+    key = (layer_norm, x.values.dtype)
+    if key not in _normalization_definitions:
+        with FusionDefinition() as fd:
+            _define_row_normalization(fd, x, layer_norm)
+        _normalization_definitions[key] = fd
+    args = [x.values, x.offsets[:-1], x.lengths(), x.row_ids(), x.max_length]
+    if layer_norm:
+        args.append(eps)
+    (out,) = _normalization_definitions[key].execute(args)
+    return x.with_values(out)
+
+
+def ragged_softmax(x: RaggedTensor) -> RaggedTensor:
+    """Returns the softmax of each row of `x`, whose values must be 1D, e.g.,
+    the attention scores of a query over keys of varying lengths.
+
+    The maximum and the sum of each row are reduced over a
+    [num_rows, max_length] view gathered from the packed values, in which
+    positions past the end of a row are masked out and read no new memory.
+    The softmax itself is computed on the packed values."""
+    return _normalize_rows(x, layer_norm=False)
+
+
+def ragged_layer_norm(x: RaggedTensor, eps: float = 1e-5) -> RaggedTensor:
+    """Returns each row of `x`, whose values must be 1D, normalized to a zero
+    mean and a unit variance. The statistics are computed like those of
+    `ragged_softmax`."""
+    return _normalize_rows(x, layer_norm=True, eps=eps)
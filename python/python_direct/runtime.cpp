@@ -308,6 +308,24 @@ str
 Notes
 -----
 - Returns None if execution has occurred yet.
+)")
+      .def(
+          "get_most_recent_remarks",
+          &FusionExecutorCache::getMostRecentRemarks,
+          R"(
+Get the optimization remarks of the most recent execution.
+
+Returns
+-------
+str
+    A JSON array with an object per segment in run order. Each object has
+    the keys "group_id", "scheduler" and "remarks", a list of the remarks
+    reported by the schedulers and lowering passes for the segment.
+
+Notes
+-----
+- Remarks are only collected when NVFUSER_ENABLE=kernel_remarks is set while
+  the fusion is compiled.
 )");
 }
 
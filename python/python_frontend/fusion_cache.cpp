@@ -12,17 +12,23 @@
 #include <instrumentation.h>
 #include <options.h>
 #include <python_frontend/fusion_cache.h>
+#include <runtime/compile_thread_pool.h>
+#include <runtime/compiled_kernel.h>
+#include <runtime/executor_utils.h>
 #include <runtime/fusion_kernel_runtime.h>
 #include <serde/fusion_record.h>
 #include <utils.h>
 
 #include <filesystem>
+#include <utility>
 namespace fs = std::filesystem;
 
 #ifdef _WIN32
 #include <c10/util/win32-headers.h>
 #else
+#include <fcntl.h>
 #include <pthread.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -79,40 +85,60 @@ fs::path getSerdeFilePath(const std::string& file_name) {
   return kernel_db_path / file_name;
 }
 
-BinaryBuffer openFusionCache(std::string filename) {
+// Memory-maps the FusionCache buffer, so that only the parts of it used by
+// lazily deserialized FusionExecutorCaches are ever read from disk. The
+// returned pointer owns the mapping.
+std::shared_ptr<const uint8_t> openFusionCache(
+    const std::string& filename,
+    size_t& file_size) {
   FUSER_PERF_SCOPE("Flatbuffers::openFusionCache");
-  auto file_handle = std::fopen(filename.c_str(), "rb");
-  NVF_CHECK(file_handle != nullptr, "Failed to open FusionCache buffer.");
-
   auto file_path = fs::path(filename.c_str());
-  auto file_size = fs::file_size(file_path);
+  NVF_CHECK(fs::exists(file_path), "Failed to open FusionCache buffer.");
+  file_size = fs::file_size(file_path);
   NVF_CHECK(file_size > 0, "FusionCache buffer is empty.");
 
-  BinaryBuffer buffer(file_size);
+#ifdef _WIN32
+  auto file_handle = std::fopen(filename.c_str(), "rb");
+  NVF_CHECK(file_handle != nullptr, "Failed to open FusionCache buffer.");
+  auto buffer = std::make_shared<BinaryBuffer>(file_size);
   size_t read_status =
-      std::fread(buffer.data(), sizeof(uint8_t), file_size, file_handle);
+      std::fread(buffer->data(), sizeof(uint8_t), file_size, file_handle);
   NVF_CHECK(
       read_status == file_size, "Failed to read entire FusionCache buffer.\n");
   std::fclose(file_handle);
-  return buffer;
+  return std::shared_ptr<const uint8_t>(buffer, buffer->data());
+#else
+  int fd = open(filename.c_str(), O_RDONLY);
+  NVF_CHECK(fd >= 0, "Failed to open FusionCache buffer.");
+  void* data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after closing the file descriptor.
+  close(fd);
+  NVF_CHECK(data != MAP_FAILED, "Failed to map FusionCache buffer.");
+  return std::shared_ptr<const uint8_t>(
+      static_cast<const uint8_t*>(data),
+      [file_size](const uint8_t* ptr) {
+        munmap(const_cast<uint8_t*>(ptr), file_size);
+      });
+#endif // _WIN32
 }
 
 // This check function only throws errors if strict flag is enabled.
 const serde::FusionCache* verifyFusionCache(
-    const BinaryBuffer& buffer,
+    const uint8_t* buffer,
+    size_t buffer_size,
     std::optional<int64_t> device_id) {
   FUSER_PERF_SCOPE("Flatbuffers::verifyFusionCache");
-  auto fusion_cache_buffer = serde::GetFusionCache(buffer.data());
+  auto fusion_cache_buffer = serde::GetFusionCache(buffer);
 
   // Check flatbuffer integrity
-  flatbuffers::Verifier v(buffer.data(), buffer.size());
+  flatbuffers::Verifier v(buffer, buffer_size);
   NVF_CHECK(
       fusion_cache_buffer->Verify(v),
       "Failed to verify the integrity of FusionCache buffer.");
 
   // Check schema version
   NVF_CHECK(
-      serde::FusionCacheBufferHasIdentifier(buffer.data()),
+      serde::FusionCacheBufferHasIdentifier(buffer),
       "Failed to verify the schema version of the FusionCache buffer");
 
   // Check device major and minor versions
@@ -120,10 +146,17 @@ const serde::FusionCache* verifyFusionCache(
       ? at::cuda::getDeviceProperties(
             static_cast<c10::DeviceIndex>(device_id.value()))
       : at::cuda::getCurrentDeviceProperties();
+  // The kernels may have been compiled for this device too, see
+  // EnableOption::CompileForArchs
+  const int64_t device_arch = device_prop->major * 10 + device_prop->minor;
+  const auto* device_archs = fusion_cache_buffer->device_archs();
   NVF_CHECK(
-      device_prop->major == fusion_cache_buffer->device_major() &&
-          device_prop->minor == fusion_cache_buffer->device_minor(),
-      false,
+      (device_prop->major == fusion_cache_buffer->device_major() &&
+       device_prop->minor == fusion_cache_buffer->device_minor()) ||
+          (device_archs != nullptr &&
+           std::find(
+               device_archs->begin(), device_archs->end(), device_arch) !=
+               device_archs->end()),
       "Expected cuda version ",
       device_prop->major,
       ".",
@@ -152,20 +185,15 @@ const serde::FusionCache* verifyFusionCache(
   return fusion_cache_buffer;
 }
 
-} // namespace
-
-void serialize() {
-  auto tmp_file_path = getSerdeFilePath(getSerdeTmpFile());
+// Save to a per-process temporary file to avoid multi-process contention.
+// Then, rename the temporary file to the actual file. If the actual file
+// already exists, then the rename may fail or replace the actual file.
+// Files replaced through this process should remain extant if they are being
+// read because of UNIX filesystem properties, but this behavior is
+// unverified.
+void serializeToFile(const fs::path& tmp_file_path, const fs::path& file_path) {
   FusionCache::get()->serialize(tmp_file_path);
 
-  // Save to a per-process temporary file to avoid multi-process contention.
-  // Then, rename the temporary file to the actual file. If the actual file
-  // already exists, then the rename may fail or replace the actual file.
-  // Files replaced through this process should remain extant if they are being
-  // read because of UNIX filesystem properties, but this behavior is
-  // unverified.
-  auto file_path =
-      getSerdeFilePath(getSerdeFile(FusionCache::get()->deviceId()));
   std::error_code rename_ec;
   fs::rename(tmp_file_path, file_path, rename_ec);
 
@@ -183,6 +211,45 @@ void serialize() {
   }
 }
 
+// Returns the file of the ahead-of-time compiled bundle for the current
+// device and CUDA version, if NVFUSER_FUSION_CACHE_BUNDLE names a directory
+// containing one.
+std::optional<fs::path> getBundleFilePath(std::optional<int64_t> device_id) {
+  const char* bundle_dir = getNvFuserEnv("FUSION_CACHE_BUNDLE");
+  if (bundle_dir == nullptr) {
+    return std::nullopt;
+  }
+  fs::path file_path = fs::path(bundle_dir) / getSerdeFile(device_id);
+  if (!fs::exists(file_path)) {
+    return std::nullopt;
+  }
+  return file_path;
+}
+
+} // namespace
+
+void serialize() {
+  serializeToFile(
+      getSerdeFilePath(getSerdeTmpFile()),
+      getSerdeFilePath(getSerdeFile(FusionCache::get()->deviceId())));
+}
+
+void serializeBundle(const std::string& directory) {
+  FUSER_PERF_SCOPE("serializeBundle");
+  fs::path bundle_path(directory);
+  std::error_code ec;
+  fs::create_directories(bundle_path, ec);
+  NVF_CHECK(
+      !ec,
+      "Unable to create FusionCache bundle directory ",
+      bundle_path.string(),
+      ": ",
+      ec.message());
+  serializeToFile(
+      bundle_path / getSerdeTmpFile(),
+      bundle_path / getSerdeFile(FusionCache::get()->deviceId()));
+}
+
 // FusionCache static data member definitions for singleton usage
 std::mutex FusionCache::singleton_lock_;
 FusionCache* FusionCache::singleton_ = nullptr;
@@ -289,6 +356,47 @@ void FusionSchedules::createExecutorIfNotExists() {
   }
 }
 
+void FusionSchedules::markDefined() {
+  {
+    std::lock_guard<std::mutex> guard(scheds_lock);
+    defined_ = true;
+  }
+  defined_cv_.notify_all();
+}
+
+void FusionSchedules::waitUntilDefined() {
+  std::unique_lock<std::mutex> lock(scheds_lock);
+  defined_cv_.wait(lock, [this]() { return defined_; });
+}
+
+ExecutorCacheMemoryUsage FusionSchedules::memoryUsage() {
+  std::lock_guard<std::mutex> guard(scheds_lock);
+  ExecutorCacheMemoryUsage usage;
+  if (auto_gen_schedules != nullptr) {
+    usage = auto_gen_schedules->memoryUsage();
+  }
+  if (presched_fusion_ != nullptr) {
+    usage.ir_bytes += presched_fusion_->arenaBytes();
+  }
+  for (const auto& [input_id, device_scheds] : user_def_schedules) {
+    for (const auto& [device, user_sched] : device_scheds) {
+      if (user_sched.scheduled_fusion != nullptr) {
+        usage.ir_bytes += user_sched.scheduled_fusion->arenaBytes();
+      }
+      if (user_sched.executor != nullptr) {
+        usage.module_bytes += user_sched.executor->moduleBytes();
+        usage.buffer_bytes += user_sched.executor->retainedBufferBytes();
+      }
+    }
+  }
+  return usage;
+}
+
+bool FusionSchedules::isEvictable() {
+  std::unique_lock<std::mutex> lock(scheds_lock, std::try_to_lock);
+  return lock.owns_lock() && defined_ && user_def_schedules.empty();
+}
+
 TrieNode::TrieNode(RecordFunctor* rec, TrieNode* _parent, size_t _fusion_id)
     : record(rec),
       children(),
@@ -302,12 +410,12 @@ bool TrieNode::isTerminal() const {
 }
 
 void TrieNode::setException(const char* e) {
-  std::lock_guard<std::mutex> guard(trie_node_lock);
+  std::unique_lock<std::shared_mutex> guard(trie_node_lock);
   exception = e;
 }
 
 std::optional<std::string> TrieNode::getException() {
-  std::lock_guard<std::mutex> guard(trie_node_lock);
+  std::shared_lock<std::shared_mutex> guard(trie_node_lock);
   return exception;
 }
 
@@ -328,7 +436,7 @@ flatbuffers::Offset<serde::TrieNode> TrieNode::serialize(
       record->serialize(builder),
       &children_trie_node_ids,
       fusion_id,
-      visits,
+      visits.load(),
       isTerminal());
 }
 
@@ -341,10 +449,29 @@ FusionCache* FusionCache::get(
   if (singleton_ == nullptr) {
     singleton_ = new FusionCache(max_fusions, selected_device);
 
+    // An ahead-of-time compiled bundle takes precedence over the common
+    // workspace. Unlike the workspace, the bundle is never deleted.
+    bool loaded_bundle = false;
+    std::optional<fs::path> bundle_path =
+        getBundleFilePath(singleton_->deviceId());
+    if (load_from_default_workspace && bundle_path.has_value()) {
+      try {
+        singleton_->deserialize(bundle_path->native());
+        loaded_bundle = true;
+      } catch (const std::exception& deserialize_exception) {
+        std::cout << "Warning: Failed to deserialize FusionCache bundle "
+                  << bundle_path->string() << ":\n"
+                  << deserialize_exception.what() << std::endl;
+        delete singleton_;
+        singleton_ = new FusionCache(max_fusions, selected_device);
+      }
+    }
+
     // Deserialize cache hierarchy from common workspace automatically
     auto file_path =
         getSerdeFilePath(getSerdeFile(singleton_->deviceId())).native();
-    if (load_from_default_workspace && fs::exists(file_path)) {
+    if (load_from_default_workspace && !loaded_bundle &&
+        fs::exists(file_path)) {
       try {
         singleton_->deserialize(file_path);
       } catch (const std::exception& deserialize_exception) {
@@ -355,16 +482,9 @@ FusionCache* FusionCache::get(
                   << "A new workspace will be saved upon program exit after "
                      "deleting incompatible workspace."
                   << std::endl;
-
-        // Hide exception message because it should be resolved by saving a new
-        // workspace.
-        if (!isOptionDisabled(DisableOption::ParallelSerde)) {
-          std::cout << "Use NVFUSER_DISABLE=parallel_serde to print exception "
-                       "message."
-                    << std::endl;
-        } else {
-          std::cout << deserialize_exception.what() << std::endl;
-        }
+        // The executor caches are deserialized lazily and handle their own
+        // errors, so the exception comes from the trie and is always printed.
+        std::cout << deserialize_exception.what() << std::endl;
 
         // Delete incompatible workspace
         std::error_code remove_ec;
@@ -381,14 +501,15 @@ FusionCache* FusionCache::get(
     }
   }
   NVF_CHECK(
-      max_fusions >= singleton_->fusions_.size(),
+      max_fusions >= singleton_->numFusions(),
       "The max fusions is set less than the number of fusions in the cache.");
   singleton_->max_fusions_ = max_fusions;
   return singleton_;
 }
 
 size_t FusionCache::numFusions() const {
-  return fusions_.size();
+  std::shared_lock<std::shared_mutex> guard(fusions_lock_);
+  return num_live_fusions_;
 }
 
 std::optional<int64_t> FusionCache::deviceId() const {
@@ -432,7 +553,8 @@ void FusionCache::print(std::ostream& os) const {
 }
 
 void FusionCache::stats(std::ostream& os) const {
-  os << "Total Fusions: " << fusions_.size() << "\n";
+  os << "Total Fusions: " << num_live_fusions_;
+  os << " Evicted Fusions: " << num_evictions_ << "\n";
 
   // Does not make sense to print stats if the cache is disabled.
   if (!fusions_.empty()) {
@@ -450,7 +572,33 @@ void FusionCache::stats(std::ostream& os) const {
     os << "Cache Lookups: " << root_->visits;
     os << " Cache Hits: " << total_cache_hits;
     os << " Hit Rate: " << hit_rate << "%\n";
+
+    os << "Memory by Fusion Id:\n";
+    ExecutorCacheMemoryUsage total;
+    for (const auto& fusion : fusions_) {
+      if (fusion == nullptr) {
+        continue;
+      }
+      ExecutorCacheMemoryUsage usage = fusion->memoryUsage();
+      os << "\t" << fusion->fusion_id_ << " -> " << usage.module_bytes
+         << " module bytes, " << usage.buffer_bytes << " buffer bytes, "
+         << usage.ir_bytes << " IR bytes\n";
+      total.module_bytes += usage.module_bytes;
+      total.buffer_bytes += usage.buffer_bytes;
+      total.ir_bytes += usage.ir_bytes;
+    }
+    os << "Kernel Modules: " << total.module_bytes << " bytes";
+    os << " Retained Buffers: " << total.buffer_bytes << " bytes";
+    os << " Fusion IR: " << total.ir_bytes << " bytes\n";
   }
+
+  // Kernels shared across fusions
+  const KernelBinaryCache& binary_cache = KernelBinaryCache::get();
+  os << "Cached Kernel Binaries: " << binary_cache.size();
+  os << " Compilations Skipped: " << binary_cache.hits() << "\n";
+  const auto& module_registry = executor_utils::ModuleRegistry::get();
+  os << "Loaded Kernel Modules: " << module_registry.numModules();
+  os << " Module Loads Skipped: " << module_registry.numReuses() << "\n";
 }
 
 void FusionCache::reset() {
@@ -476,42 +624,228 @@ FusionCache::FusionCache(
   root_ = std::make_unique<TrieNode>(start);
 }
 
-// In order to keep queries fast, this method does not lock.
-// In the worst case, the query should fail and if you try to create a child,
-// it should give you back an already created child if two threads are walking
-// the trie at the same time with the same definition.
+// In order to keep queries fast, this method only takes a shared lock of the
+// node, so concurrent queries don't block each other. If the query fails and
+// you try to create a child, it gives you back an already created child if two
+// threads are walking the trie at the same time with the same definition.
 std::optional<TrieNode*> FusionCache::queryChildren(
     TrieNode* node,
     RecordFunctor* rec) const {
   NVF_CHECK(
       !node->isTerminal(), "There should be no children from a Terminal Node!");
   NVF_CHECK(rec, "Record is null!");
-  auto trie_node = node->children.find(rec);
-  if (trie_node == std::end(node->children)) {
+  TrieNode* child = nullptr;
+  {
+    std::shared_lock<std::shared_mutex> guard(node->trie_node_lock);
+    auto trie_node = node->children.find(rec);
+    if (trie_node == std::end(node->children)) {
+      return std::nullopt;
+    }
+    child = trie_node->second.get();
+  }
+  ++(child->visits);
+  if (child->isTerminal()) {
+    deserializeExecutorCache(child->fusion_id);
+  }
+  return std::optional<TrieNode*>(child);
+}
+
+std::optional<TrieNode*> FusionCache::queryFingerprint(
+    size_t fingerprint,
+    const std::vector<std::unique_ptr<RecordFunctor>>& records) const {
+  TrieNode* terminal = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(fingerprint_lock_);
+    auto it = terminal_fingerprints_.find(fingerprint);
+    if (it == terminal_fingerprints_.end()) {
+      return std::nullopt;
+    }
+    terminal = it->second;
+  }
+
+  // Compare the records from the last one up to the root, which is a
+  // StartRecord that no definition records.
+  TrieNode* node = terminal->parent;
+  for (auto it = records.rbegin(); it != records.rend(); ++it) {
+    if (node == nullptr || node->parent == nullptr ||
+        !(*node->record == **it)) {
+      return std::nullopt;
+    }
+    node = node->parent;
+  }
+  if (node != root_.get()) {
     return std::nullopt;
-  } else {
-    ++(trie_node->second.get()->visits);
-    return std::optional<TrieNode*>(trie_node->second.get());
   }
+
+  ++(terminal->visits);
+  deserializeExecutorCache(terminal->fusion_id);
+  return std::optional<TrieNode*>(terminal);
+}
+
+void FusionCache::registerFingerprint(size_t fingerprint, TrieNode* node) {
+  NVF_CHECK(node->isTerminal(), "Only terminal nodes have a fingerprint!");
+  std::lock_guard<std::mutex> guard(fingerprint_lock_);
+  terminal_fingerprints_[fingerprint] = node;
+}
+
+void FusionCache::deserializeExecutorCache(size_t fusion_id) const {
+  {
+    std::lock_guard<std::mutex> guard(serde_lock_);
+    if (!serde_executor_caches_.contains(fusion_id)) {
+      return;
+    }
+  }
+
+  FUSER_PERF_SCOPE("FusionCache::deserializeExecutorCache");
+  FusionSchedules* fusion_schedule = queryFusionSchedules(fusion_id);
+  // Concurrent queries of the same fusion wait here until it's deserialized.
+  std::lock_guard<std::mutex> scheds_guard(fusion_schedule->scheds_lock);
+  const serde::FusionExecutorCache* fb_fec_node = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(serde_lock_);
+    auto it = serde_executor_caches_.find(fusion_id);
+    if (it == serde_executor_caches_.end()) {
+      return;
+    }
+    fb_fec_node = it->second;
+    serde_executor_caches_.erase(it);
+  }
+
+  // Create an executor so the following code can deserialize it.
+  fusion_schedule->createExecutorIfNotExists();
+  try {
+    fusion_schedule->auto_gen_schedules->deserialize(
+        fb_fec_node, (int64_t)fusion_id);
+  } catch (const std::exception& e) {
+    // The fusion is still valid, so start over with an empty executor cache
+    // that compiles kernels on demand.
+    TORCH_WARN(
+        "Failed to deserialize the executor cache of fusion ",
+        fusion_id,
+        ". Its kernels will be recompiled: ",
+        e.what());
+    Fusion* fusion = fusion_schedule->auto_gen_schedules->fusion();
+    fusion_schedule->auto_gen_schedules = std::make_unique<FusionExecutorCache>(
+        std::make_unique<Fusion>(*fusion), (int64_t)fusion_id);
+  }
+}
+
+void FusionCache::deserializeAllExecutorCaches() const {
+  std::vector<size_t> fusion_ids;
+  {
+    std::lock_guard<std::mutex> guard(serde_lock_);
+    for (const auto& [fusion_id, fb_fec_node] : serde_executor_caches_) {
+      fusion_ids.push_back(fusion_id);
+    }
+  }
+  if (fusion_ids.empty()) {
+    return;
+  }
+
+  FUSER_PERF_SCOPE("FusionCache::deserializeAllExecutorCaches");
+  if (isOptionDisabled(DisableOption::ParallelSerde)) {
+    for (size_t fusion_id : fusion_ids) {
+      deserializeExecutorCache(fusion_id);
+    }
+    return;
+  }
+  // Parallelize the deserialization of each FusionExecutorCache.
+  // deserializeExecutorCache handles its own errors.
+  for (size_t fusion_id : fusion_ids) {
+    getThreadPool()->run([this, fusion_id]() {
+      FUSER_PERF_SCOPE("FusionCache::deserializeFusionParallel");
+      deserializeExecutorCache(fusion_id);
+    });
+  }
+  getThreadPool()->waitWorkComplete();
 }
 
 FusionSchedules* FusionCache::queryFusionSchedules(size_t fusion_id) const {
+  return shareFusionSchedules(fusion_id).get();
+}
+
+std::shared_ptr<FusionSchedules> FusionCache::shareFusionSchedules(
+    size_t fusion_id) const {
+  std::shared_lock<std::shared_mutex> guard(fusions_lock_);
   NVF_CHECK(
       fusion_id < fusions_.size(),
       "Invalid scheduler query for id: ",
       fusion_id);
-  FusionSchedules* ptr = fusions_.at(fusion_id).get();
-  NVF_CHECK(ptr != nullptr, "Unexpected null FusionSchedules object.");
+  const std::shared_ptr<FusionSchedules>& ptr = fusions_.at(fusion_id);
+  NVF_CHECK(
+      ptr != nullptr,
+      "Fusion ",
+      fusion_id,
+      " was evicted from the FusionCache. Define it again to rebuild it.");
   return ptr;
 }
 
+bool FusionCache::reviveFusionSchedules(size_t fusion_id) {
+  // Declared before the lock, so an evicted fusion is freed after unlocking
+  std::shared_ptr<FusionSchedules> evicted;
+  std::unique_lock<std::shared_mutex> guard(fusions_lock_);
+  NVF_CHECK(
+      fusion_id < fusions_.size(),
+      "Invalid scheduler query for id: ",
+      fusion_id);
+  if (fusions_[fusion_id] != nullptr) {
+    return false;
+  }
+  evicted = makeRoomForFusion();
+  fusions_[fusion_id] = std::make_shared<FusionSchedules>(fusion_id);
+  ++num_live_fusions_;
+  return true;
+}
+
+void FusionCache::markUsed(FusionSchedules* scheds) {
+  scheds->last_used = ++use_tick_;
+}
+
+std::shared_ptr<FusionSchedules> FusionCache::makeRoomForFusion() {
+  if (num_live_fusions_ < max_fusions_) {
+    return nullptr;
+  }
+  // Eviction is rare compared to marking fusions as used, so the least
+  // recently used one is found by a scan rather than kept in order.
+  std::shared_ptr<FusionSchedules>* victim = nullptr;
+  for (auto& fusion : fusions_) {
+    if (fusion == nullptr || !fusion->isEvictable()) {
+      continue;
+    }
+    if (victim == nullptr || fusion->last_used < (*victim)->last_used) {
+      victim = &fusion;
+    }
+  }
+  NVF_CHECK(
+      victim != nullptr,
+      "The number of fusions in nvfuser has exceeded ",
+      max_fusions_,
+      "fusions and none of them can be evicted.  The max_fusions for the ",
+      "FusionCache might need to be increased if the max number is not being ",
+      "exceeded due to an error.");
+  if (isDebugDumpEnabled(DebugDumpOption::PythonFrontendDebug)) {
+    debug() << "\nFusionCache: Evict fusion " << (*victim)->fusion_id_
+            << ".\n";
+  }
+  {
+    // A revived fusion is compiled again rather than deserialized.
+    std::lock_guard<std::mutex> guard(serde_lock_);
+    serde_executor_caches_.erase((*victim)->fusion_id_);
+  }
+  --num_live_fusions_;
+  ++num_evictions_;
+  return std::exchange(*victim, nullptr);
+}
+
 std::optional<size_t> FusionCache::queryUserScheduleId(
     const FusionSchedules* scheds,
     const KernelArgumentHolder& args) {
   std::optional<size_t> result = std::nullopt;
 
+  std::lock_guard<std::mutex> guard(scheds->scheds_lock);
   auto& user_scheds = scheds->user_def_schedules;
   if (!user_scheds.empty()) {
+    std::lock_guard<std::mutex> encodings_guard(user_def_input_encodings_lock_);
     auto input_id = user_def_input_encodings_.lookupId(args);
     auto user_sched = user_scheds.find(input_id.id);
     if (user_sched != user_scheds.end()) {
@@ -539,14 +873,17 @@ bool FusionCache::existUserSchedule(
     const FusionSchedules* scheds,
     KernelArgumentHolder args,
     int device) {
+  std::lock_guard<std::mutex> guard(scheds->scheds_lock);
   // Short-Circuit: No user schedules
   if (scheds->user_def_schedules.empty()) {
     return false;
   }
   args.setDeviceIndex(device);
   // Short-Circuit: User schedule does not exist for fusion and args.
-  InputsIdLookup::IdLookupReturn input_id =
-      user_def_input_encodings_.lookupId(args);
+  InputsIdLookup::IdLookupReturn input_id = [&]() {
+    std::lock_guard<std::mutex> encodings_guard(user_def_input_encodings_lock_);
+    return user_def_input_encodings_.lookupId(args);
+  }();
   auto user_sched_iter = scheds->user_def_schedules.find(input_id.id);
   if (user_sched_iter == scheds->user_def_schedules.end()) {
     return false;
@@ -564,24 +901,30 @@ TrieNode* FusionCache::createChild(TrieNode* node, RecordFunctor* rec) {
       !node->isTerminal(), "Cannot create a trie node from a terminal node!");
   NVF_CHECK(rec, "Record is null!");
 
-  std::lock_guard<std::mutex> guard(node->trie_node_lock);
+  // Declared before the locks, so an evicted fusion is freed after unlocking
+  std::shared_ptr<FusionSchedules> evicted;
+  std::unique_lock<std::shared_mutex> guard(node->trie_node_lock);
 
   // As a thread-safety compromise for fast queries, the node is re-queried
   // prior to child creation incase another thread slipped in the node.
-  auto child_node = queryChildren(node, rec);
-  if (child_node.has_value()) {
-    child = child_node.value();
+  auto child_node = node->children.find(rec);
+  if (child_node != std::end(node->children)) {
+    child = child_node->second.get();
+    ++(child->visits);
+    if (child->isTerminal()) {
+      deserializeExecutorCache(child->fusion_id);
+    }
   } else {
     size_t fusion_id = 0;
+    // Terminal nodes of different parents may be created concurrently.
+    std::unique_lock<std::shared_mutex> fusions_guard(
+        fusions_lock_, std::defer_lock);
     if (rec->recordType() == serde::RecordType::End) {
-      NVF_CHECK(
-          (fusions_.size() + 1) <= max_fusions_,
-          "The number of fusions in nvfuser has exceeded ",
-          max_fusions_,
-          "fusions.  The max_fusions for the FusionCache might need to be ",
-          "increased if the max number is not being exceeded due to an error.");
+      fusions_guard.lock();
+      evicted = makeRoomForFusion();
       fusion_id = fusions_.size();
-      fusions_.emplace_back(std::make_unique<FusionSchedules>(fusion_id));
+      fusions_.emplace_back(std::make_shared<FusionSchedules>(fusion_id));
+      ++num_live_fusions_;
     }
 
     // Copying the record owned by the FusionDefinition that calls this function
@@ -616,7 +959,10 @@ UserSchedule* FusionCache::createUserSchedule(
   std::lock_guard<std::mutex> guard(scheds->scheds_lock);
   args.setDeviceIndex(device);
   auto& user_scheds = scheds->user_def_schedules;
-  auto input_id = user_def_input_encodings_.lookupId(args);
+  InputsIdLookup::IdLookupReturn input_id = [&]() {
+    std::lock_guard<std::mutex> encodings_guard(user_def_input_encodings_lock_);
+    return user_def_input_encodings_.lookupId(args);
+  }();
 
   // Create UserSchedule for device
   if (user_scheds[input_id.id].count(device) == 0) {
@@ -641,6 +987,10 @@ TrieNode* FusionCache::rootTriePtr() {
 
 void FusionCache::serialize(std::string filename) const {
   FUSER_PERF_SCOPE("FusionCache::serialize");
+  // Executor caches that were never queried are still only in the old
+  // buffer, and flatbuffers can't copy them into a new one as is.
+  deserializeAllExecutorCaches();
+
   flatbuffers::FlatBufferBuilder builder(1024);
   // TODO: Serialize Fusion IR containers
 
@@ -698,10 +1048,10 @@ void FusionCache::serialize(std::string filename) const {
       continue;
     }
 
-    FusionSchedules* schedule = queryFusionSchedules(node->fusion_id);
-    if (schedule->auto_gen_schedules == nullptr) {
-      // This fusion has been created but never executed. It doesn't save us
-      // anything to serialize that.
+    FusionSchedules* schedule = fusions_.at(node->fusion_id).get();
+    if (schedule == nullptr || schedule->auto_gen_schedules == nullptr) {
+      // This fusion has been evicted, or created but never executed. It
+      // doesn't save us anything to serialize that.
       continue;
     }
 
@@ -716,6 +1066,8 @@ void FusionCache::serialize(std::string filename) const {
   int cuda_major = 0;
   int cuda_minor = 0;
   NVFUSER_NVRTC_SAFE_CALL(nvrtcVersion(&cuda_major, &cuda_minor));
+  const std::vector<int64_t> device_archs =
+      executor_utils::getCompileForArchs();
 
   // 6. Build FusionCache flatbuffer object
   // See table definition for FusionCache in serde/fusion_cache.fbs
@@ -729,7 +1081,8 @@ void FusionCache::serialize(std::string filename) const {
       device_prop->major,
       device_prop->minor,
       cuda_major,
-      cuda_minor);
+      cuda_minor,
+      &device_archs);
   builder.Finish(fusion_cache, /*file_identifier=*/"NV01");
 
   // 6. Write flatbuffer binary to file
@@ -750,9 +1103,10 @@ void FusionCache::deserialize(std::string filename) {
   NVF_CHECK(
       fusions_.empty(),
       "Deserialization is prohibited if FusionCache is already populated.");
-  const BinaryBuffer& buffer = openFusionCache(filename);
+  size_t buffer_size = 0;
+  serde_buffer_ = openFusionCache(filename, buffer_size);
   const serde::FusionCache* fusion_cache_buffer =
-      verifyFusionCache(buffer, device_id_);
+      verifyFusionCache(serde_buffer_.get(), buffer_size, device_id_);
 
   // See table definition for FusionCache in serde/fusion_cache.fbs
   FUSER_PERF_SCOPE("FusionCache::deserialize");
@@ -766,6 +1120,8 @@ void FusionCache::deserialize(std::string filename) {
   max_fusions_ = fusion_cache_buffer->max_fusions();
 
   // 2. Deserialize fusions: (Fusion) and structure: (TrieNode) fields
+  // Terminal nodes whose fusions were evicted or never executed have no
+  // FusionExecutorCache but still get a FusionSchedules.
   int64_t num_fusions = 0;
   for (const auto i :
        arange(fusion_cache_buffer->auto_gen_schedules()->size())) {
@@ -773,9 +1129,16 @@ void FusionCache::deserialize(std::string filename) {
         num_fusions,
         fusion_cache_buffer->auto_gen_schedules()->Get(i)->fusion_id() + 1);
   }
-  std::generate_n(std::back_inserter(fusions_), num_fusions, [] {
-    return std::make_unique<FusionSchedules>();
-  });
+  for (const auto* fb_trie_node : *fusion_cache_buffer->structure()) {
+    if (fb_trie_node->is_terminal()) {
+      num_fusions =
+          std::max(num_fusions, (int64_t)fb_trie_node->fusion_id() + 1);
+    }
+  }
+  for (const auto fusion_id : arange(num_fusions)) {
+    fusions_.push_back(std::make_shared<FusionSchedules>(fusion_id));
+  }
+  num_live_fusions_ = fusions_.size();
 
   serde::RecordFunctorFactory record_functor_factory;
 
@@ -841,6 +1204,7 @@ void FusionCache::deserialize(std::string filename) {
       fs->outputs_fid_ = state->outputs();
       fs->extents_fid_ = state->extents();
       fs->map_value_to_fid_ = state->getValueMap();
+      fs->markDefined();
     }
 
     // Table TrieNode => Field: children: [ulong]
@@ -875,46 +1239,17 @@ void FusionCache::deserialize(std::string filename) {
     state_queue.pop_front();
   }
 
-  std::atomic<bool> detect_exception_in_thread_pool{false};
-  // Deserialize terminal_nodes field in the FusionCache table
+  // Deserialize terminal_nodes field in the FusionCache table. Each
+  // FusionExecutorCache is only deserialized when its terminal node is first
+  // queried; until then it's kept as a table in the mapped buffer.
+  std::lock_guard<std::mutex> guard(serde_lock_);
   for (auto idx : arange(fusion_cache_buffer->terminal_nodes()->size())) {
     auto node_idx = fusion_cache_buffer->terminal_nodes()->Get(idx);
     auto trie_node = bfs_order.at(node_idx);
     terminal_nodes_.push_back(trie_node);
-
-    auto fb_fec_node = fusion_cache_buffer->auto_gen_schedules()->Get(idx);
-    FusionSchedules* fusion_schedule =
-        queryFusionSchedules(trie_node->fusion_id);
-    // Create an executor so the following code can deserialize it.
-    fusion_schedule->createExecutorIfNotExists();
-
-    if (!isOptionDisabled(DisableOption::ParallelSerde)) {
-      // Parallelize the deserialization of each FusionExecutorCache.
-      getThreadPool()->run([=, &detect_exception_in_thread_pool]() {
-        FUSER_PERF_SCOPE("FusionCache::deserializeFusionParallel");
-        try {
-          fusion_schedule->auto_gen_schedules->deserialize(
-              fb_fec_node, (int64_t)trie_node->fusion_id);
-        } catch (const std::exception& e) {
-          // Set flag inside lambda so we can throw an exception after thread
-          // pool completes its work.
-          detect_exception_in_thread_pool.store(true);
-        }
-      });
-    } else {
-      FUSER_PERF_SCOPE("FusionCache::deserializeFusionSerial");
-      fusion_schedule->auto_gen_schedules->deserialize(
-          fb_fec_node, (int64_t)trie_node->fusion_id);
-    }
-  }
-
-  if (!isOptionDisabled(DisableOption::ParallelSerde)) {
-    // Wait until all fusion executor caches are deserialized
-    getThreadPool()->waitWorkComplete();
-    NVF_ERROR(
-        !detect_exception_in_thread_pool.load(),
-        "Detected exception while deserializing fusions in parallel.\n",
-        "Use NVFUSER_DISABLE=parallel_serde to print exception message.");
+    serde_executor_caches_.emplace(
+        trie_node->fusion_id,
+        fusion_cache_buffer->auto_gen_schedules()->Get(idx));
   }
 }
 
@@ -15,8 +15,11 @@
 #include <scheduler/compile_time_info.h>
 #include <scheduler/registry.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 namespace nvfuser::python_frontend {
 
@@ -98,9 +101,25 @@ class FusionSchedules {
   //! finalizeDefinition may be followed by finalizeMultideviceSchedule which
   //! can modify presched_fusion_. The if-not-exists check is necessary because
   //! multiple FusionDefinitions may map to the same FusionSchedules. In that
-  //! case, we want to reuse the same executor.
+  //! case, we want to reuse the same executor. The caller holds scheds_lock.
   void createExecutorIfNotExists();
 
+  //! Called once the fields below that link the Fusion to its
+  //! FusionDefinition are set, or building the Fusion failed.
+  void markDefined();
+  //! Blocks until markDefined is called, so a thread whose definition hits
+  //! the terminal node created by another thread doesn't see a partially
+  //! built FusionSchedules.
+  void waitUntilDefined();
+
+  //! Memory held by the executors, the user schedules and the unscheduled
+  //! Fusion IR of this fusion
+  ExecutorCacheMemoryUsage memoryUsage();
+  //! Whether the FusionCache may evict this fusion, i.e., it's defined and it
+  //! has no user schedules, which FusionDefinitions point to. Returns false
+  //! instead of waiting if another thread holds scheds_lock.
+  bool isEvictable();
+
   //! Schedules Automatically generated by nvFuser for dynamic inputs. (default)
   //! NOTE: The FusionExecutorCache also holds the Unscheduled Fusion IR
   std::unique_ptr<FusionExecutorCache> auto_gen_schedules;
@@ -115,8 +134,9 @@ class FusionSchedules {
   Fusion* last_user_def_scheduled_ir;
   //! Keeps a pointer to the last executed executor for printing its cuda kernel
   KernelExecutor* last_user_def_executor;
-  //! For thread-Safe locking of Fusion Schedules
-  std::mutex scheds_lock;
+  //! For thread-Safe locking of Fusion Schedules. It guards the creation of
+  //! the executors and the user schedules, but not running them.
+  mutable std::mutex scheds_lock;
   //! ID of fusion in python frontend fusion cache
   int64_t fusion_id_ = -1;
   //! Fusion IDs of input arguments for FusionState
@@ -129,11 +149,17 @@ class FusionSchedules {
   std::unordered_map<const Val*, int64_t> map_value_to_fid_;
   //! stores the executor if FusionDefinition::use_multidevice_executor_ is true
   std::unique_ptr<MultiDeviceExecutor> multi_device_executor;
+  //! Tick of the last definition or execution of this fusion, see
+  //! FusionCache::markUsed
+  std::atomic<int64_t> last_used{0};
 
  private:
   //! Holds the presched fusion that will be `std::move`d to a
   //! FusionExecutorCache or MultiDeviceExecutor at first execution.
   std::unique_ptr<Fusion> presched_fusion_;
+  //! Whether markDefined has been called. Guarded by scheds_lock.
+  bool defined_ = false;
+  std::condition_variable defined_cv_;
 };
 
 //! \struct TrieNode
@@ -174,11 +200,12 @@ struct TrieNode {
   //! unscheduled Fusion.  The id is only valid if the entry is terminal.
   size_t fusion_id;
   //! Count of times the Entry is traversed
-  size_t visits;
+  std::atomic<size_t> visits;
   //! Parent node for printing
   TrieNode* parent;
-  //! For thread-Safe locking of a node
-  std::mutex trie_node_lock;
+  //! For thread-Safe locking of a node. Queries of its children share it,
+  //! so only creating a child blocks them.
+  std::shared_mutex trie_node_lock;
   //! exception is used to track if we failed to create a valid fusion for
   //! FusionDefinition at this given TrieNode
   std::optional<std::string> exception = std::nullopt;
@@ -192,16 +219,21 @@ struct TrieNode {
 //! cache fusions.  A leaf of the tree with a terminal node contains a
 //! container for caching the kernels generated for specific fusions.
 //!
-//! \todo
-//! Add the ability to evict a fusion.  There is currently a max number
-//! of fusions that is checked to prevent a runaway case.
-//!
 //! \note
-//! Thread-Safety is assured by the Python GIL.  If a no-GIL python is used
-//! then further scrutiny needs to be applied to the mutexes used to limit
-//! acccess to the singleton pointer, node creation, and user schedule
-//! creation.  Otherwise, the Python GIL provides a natural thread based mutex
-//! that does not allow for multiple threads to interact.
+//! Definitions can be looked up, created and executed from multiple threads,
+//! e.g., with the Python GIL released while in C++. Each trie node has a
+//! reader-writer lock, so concurrent queries don't block each other and only
+//! wait for the creation of a child of the same node. The FusionSchedules of
+//! a new definition are published to other threads once they are built, see
+//! FusionSchedules::waitUntilDefined. reset(), serialize(), print() and stats()
+//! aren't meant to run concurrently with definitions.
+//!
+//! At most max_fusions fusions are alive. Creating one more evicts the least
+//! recently defined or executed FusionSchedules, which frees its Fusion IR,
+//! kernels and retained buffers. Its terminal node stays in the trie, so the
+//! next definition hitting it builds the fusion again under the same id. An
+//! evicted fusion that is still executing, e.g., by another thread or by a
+//! CompiledFusion, is freed once that's done.
 
 class FusionCache {
   //! The constructor is private given the FusionCache is only constructed
@@ -221,7 +253,7 @@ class FusionCache {
       size_t max_fusions = 16384,
       std::optional<int64_t> selected_device = std::nullopt,
       bool load_from_default_workspace = true);
-  //! Number of fusions cached
+  //! Number of fusions cached, excluding evicted ones
   NVF_API size_t numFusions() const;
   //! Get device associated with this FusionCache
   NVF_API std::optional<int64_t> deviceId() const;
@@ -234,18 +266,40 @@ class FusionCache {
 
   //! Serialize Fusion Cache using flatbuffers
   NVF_API void serialize(std::string filename) const;
-  //! Deserialize Fusion Cache using flatbuffers
+  //! Deserialize Fusion Cache using flatbuffers. The file is memory-mapped
+  //! and each FusionExecutorCache is only deserialized when its fusion is
+  //! first queried.
   NVF_API void deserialize(std::string filename);
 
   //! The rest of the public methods are only used in C++
 
-  //! Thread-Unsafe: Queries the current trie node to see if a record matches
+  //! Thread-Safe: Queries the current trie node to see if a record matches
   //! one of its children
   NVF_API std::optional<TrieNode*> queryChildren(
       TrieNode* node,
       RecordFunctor* rec) const;
+  //! Thread-Safe: Queries the terminal node of a definition by the
+  //! fingerprint of its records, see FusionState::fingerprint. The records
+  //! are compared with those on the path to the node, so a fingerprint
+  //! collision returns std::nullopt, after which the trie has to be walked.
+  NVF_API std::optional<TrieNode*> queryFingerprint(
+      size_t fingerprint,
+      const std::vector<std::unique_ptr<RecordFunctor>>& records) const;
+  //! Thread-Safe: Maps a fingerprint to the terminal node of its definition
+  //! for queryFingerprint. A colliding fingerprint is remapped.
+  NVF_API void registerFingerprint(size_t fingerprint, TrieNode* node);
   //! Query a Fusion's Schedules based on fusion id or cache id
   FusionSchedules* queryFusionSchedules(size_t fusion_id) const;
+  //! Like queryFusionSchedules, but the returned FusionSchedules stays alive
+  //! if it's evicted meanwhile, e.g., while it's executed.
+  std::shared_ptr<FusionSchedules> shareFusionSchedules(
+      size_t fusion_id) const;
+  //! Thread-Safe: Creates a FusionSchedules for the evicted fusion of a
+  //! terminal node. Returns whether it was created by this call, in which
+  //! case the caller builds its fusion, or whether it exists already.
+  bool reviveFusionSchedules(size_t fusion_id);
+  //! Marks the fusion as the most recently used one for LRU eviction
+  void markUsed(FusionSchedules* scheds);
   //! Determine if a user schedule exists for given inputs.
   bool existUserSchedule(
       const FusionSchedules* scheds,
@@ -275,6 +329,17 @@ class FusionCache {
   NVF_API TrieNode* rootTriePtr();
 
  private:
+  //! Thread-Safe: Deserializes the FusionExecutorCache of fusion_id from the
+  //! buffer given to deserialize unless that's done already
+  void deserializeExecutorCache(size_t fusion_id) const;
+  //! Deserializes the FusionExecutorCaches that haven't been queried yet
+  void deserializeAllExecutorCaches() const;
+  //! Evicts the least recently used fusion if max_fusions_ are alive, so one
+  //! more can be created. The evicted FusionSchedules is returned, so the
+  //! caller frees it after releasing its locks. The caller holds a unique
+  //! lock of fusions_lock_.
+  std::shared_ptr<FusionSchedules> makeRoomForFusion();
+
   //! The static pointer to the FusionCache
   static FusionCache* singleton_;
   //! Lock for accessing the singleton by multiple threads
@@ -288,10 +353,25 @@ class FusionCache {
   //! The root (start) of the prefix tree to start a cache look up of a given
   //! fusion definition.
   std::unique_ptr<TrieNode> root_;
-  //! A vector of nvFuser Fusion IR fusions.
-  std::vector<std::unique_ptr<FusionSchedules>> fusions_;
+  //! A vector of nvFuser Fusion IR fusions by id. Evicted fusions are null.
+  std::vector<std::shared_ptr<FusionSchedules>> fusions_;
+  //! Number of fusions in fusions_ that aren't evicted
+  size_t num_live_fusions_ = 0;
+  //! Number of fusions evicted so far
+  size_t num_evictions_ = 0;
+  //! The last tick given by markUsed
+  std::atomic<int64_t> use_tick_{0};
   //! A vector of Terminal trie nodes for Stats collection
   std::vector<TrieNode*> terminal_nodes_;
+  //! Guards fusions_, the counts above and terminal_nodes_, which change as
+  //! definitions are created by any thread
+  mutable std::shared_mutex fusions_lock_;
+  //! Terminal trie nodes by the fingerprint of their definitions. A node is
+  //! registered once its definition has walked the trie, which includes the
+  //! definitions of a deserialized cache.
+  std::unordered_map<size_t, TrieNode*> terminal_fingerprints_;
+  //! Guards terminal_fingerprints_
+  mutable std::mutex fingerprint_lock_;
 
   //! Items specifically to aid user defined schedules these data members
   //! are for the mechanics of user schedule usage and don't make sense as
@@ -301,6 +381,19 @@ class FusionCache {
   // NOTE: I would prefer this be per FusionSchedules object but the container
   // is not allowed to be copied or moved.
   InputsIdLookup user_def_input_encodings_;
+  //! Guards user_def_input_encodings_, which is shared by all fusions
+  std::mutex user_def_input_encodings_lock_;
+
+  //! The memory-mapped buffer given to deserialize. It must outlive
+  //! serde_executor_caches_, which points into it.
+  std::shared_ptr<const uint8_t> serde_buffer_;
+  //! FusionExecutorCaches by fusion id that are yet to be deserialized from
+  //! serde_buffer_. They are deserialized on the first query of their
+  //! terminal node.
+  mutable std::unordered_map<size_t, const serde::FusionExecutorCache*>
+      serde_executor_caches_;
+  //! Guards serde_executor_caches_
+  mutable std::mutex serde_lock_;
 };
 
 //! Serialize Fusion Cache to common workspace
@@ -313,4 +406,12 @@ class FusionCache {
 //! '''
 NVF_API void serialize();
 
+//! Serialize Fusion Cache to an ahead-of-time compiled bundle in directory.
+//! The file is named like the common workspace file, i.e., after the device
+//! architecture and the CUDA version, so a bundle directory can hold the
+//! caches built on several GPU architectures. FusionCache::get loads the file
+//! matching the current device from the directory given by
+//! NVFUSER_FUSION_CACHE_BUNDLE instead of the common workspace.
+NVF_API void serializeBundle(const std::string& directory);
+
 } // namespace nvfuser::python_frontend
@@ -57,14 +57,55 @@ FusionDefinition* FusionDefinition::setupDefinition() {
   return this;
 }
 
+void FusionDefinition::walkTrie() {
+  FUSER_PERF_SCOPE("FusionDefinition::walkTrie");
+  for (const auto& record : recording_) {
+    auto child_node = fusionCache()->queryChildren(trie_node_, record.get());
+    // If the Record is found in the cache, the FusionDefinition and the Cache
+    // will not share Record given the Record had to be created in order to
+    // match it but it also already existed in the cache.
+    if (child_node.has_value()) {
+      if (isDebugDumpEnabled(DebugDumpOption::PythonFrontendDebug)) {
+        debug() << "\nFusionDefinition: Record (hash: 0x" << std::hex
+                << record->hash() << ") hit in Fusion Cache.\n";
+      }
+      trie_node_ = child_node.value();
+    } else {
+      if (isDebugDumpEnabled(DebugDumpOption::PythonFrontendDebug)) {
+        debug() << "\nFusionDefinition: Record (hash: 0x" << std::hex
+                << record->hash() << ") missed in Fusion Cache.\n";
+      }
+      trie_node_ = fusionCache()->createChild(trie_node_, record.get());
+    }
+  }
+}
+
 void FusionDefinition::finalizeDefinition() {
   FUSER_PERF_SCOPE("FusionDefinition::finalizeDefinition");
-  auto child_node = fusionCache()->queryChildren(trie_node_, end_record_.get());
+  // A single lookup resolves the terminal node of a definition that has been
+  // seen before. Otherwise, e.g., on a fingerprint collision or for a new
+  // definition, the trie is walked record by record.
+  auto child_node = fusionCache()->queryFingerprint(fingerprint(), recording_);
   if (!child_node.has_value()) {
+    walkTrie();
+    child_node = fusionCache()->queryChildren(trie_node_, end_record_.get());
+    if (child_node.has_value()) {
+      fusionCache()->registerFingerprint(fingerprint(), child_node.value());
+    }
+  }
+  // The fusion of a terminal node is built again if it was evicted.
+  bool build_fusion = true;
+  if (child_node.has_value()) {
+    trie_node_ = child_node.value();
+    build_fusion = fusionCache()->reviveFusionSchedules(trie_node_->fusion_id);
+  } else {
     if (isDebugDumpEnabled(DebugDumpOption::PythonFrontendDebug)) {
       debug() << "\nFusionDefinition: Terminal Node not found.\n";
     }
     trie_node_ = fusionCache()->createChild(trie_node_, end_record_.get());
+    fusionCache()->registerFingerprint(fingerprint(), trie_node_);
+  }
+  if (build_fusion) {
     fusion_id_ = std::optional<size_t>(trie_node_->fusion_id);
     try {
       NVF_CHECK(id().has_value(), "Invalid fusion id!");
@@ -82,6 +123,7 @@ void FusionDefinition::finalizeDefinition() {
       // we'll be able to throw the same exception again when user tries to
       // create the same fusion entry.
       trie_node_->setException(e.what());
+      fusionCache()->queryFusionSchedules(trie_node_->fusion_id)->markDefined();
       fusion_id_ = std::nullopt;
       throw;
     }
@@ -96,6 +138,8 @@ void FusionDefinition::finalizeDefinition() {
     fs->outputs_fid_ = outputs();
     fs->extents_fid_ = extents();
     fs->map_value_to_fid_ = getValueMap();
+    fusionCache()->markUsed(fs);
+    fs->markDefined();
 
     if (isDebugDumpEnabled(DebugDumpOption::FusionIrOriginal)) {
       printIr();
@@ -104,7 +148,11 @@ void FusionDefinition::finalizeDefinition() {
     if (isDebugDumpEnabled(DebugDumpOption::PythonFrontendDebug)) {
       debug() << "\nFusionDefinition: Terminal Node found!\n";
     }
-    trie_node_ = child_node.value();
+    // Another thread may still be building the fusion of this definition.
+    std::shared_ptr<FusionSchedules> fs =
+        fusionCache()->shareFusionSchedules(trie_node_->fusion_id);
+    fs->waitUntilDefined();
+    fusionCache()->markUsed(fs.get());
     std::optional<std::string> opt_e = trie_node_->getException();
     // rethrow the exception message if the cached FusionDefinition fails to
     // build a proper fusion earlier.
@@ -115,8 +163,6 @@ void FusionDefinition::finalizeDefinition() {
     // In this case, a new CPP Fusion is not created, so the mapping from CPP
     // fusion to Python FusionDefinition is not initialized. This state is
     // stored within FusionSchedules and is retrieved for this FusionDefinition.
-    FusionSchedules* fs =
-        fusionCache()->queryFusionSchedules(fusion_id_.value());
     inputs_fid_ = fs->inputs_fid_;
     outputs_fid_ = fs->outputs_fid_;
     extents_fid_ = fs->extents_fid_;
@@ -367,14 +413,19 @@ std::pair<KernelArgumentHolder, std::vector<Sharding>> FusionDefinition::
         bool capture_debug_output,
         bool profile,
         std::vector<std::string> _enable_options,
-        std::vector<std::string> _disable_options) const {
+        std::vector<std::string> _disable_options,
+        KernelArgumentHolder user_outputs) const {
   debug_output_ = std::nullopt;
   std::stringstream debug_ss;
   DebugStreamGuard dsg(capture_debug_output ? debug_ss : std::cout);
   args.setDeviceIndex(selected_device);
   NVF_CHECK(id().has_value(), "Valid fusion schedule is not available!");
 
-  auto scheds = fusionCache()->queryFusionSchedules(id().value());
+  // Keeps the schedules alive if the fusion is evicted while it runs
+  std::shared_ptr<FusionSchedules> shared_scheds =
+      fusionCache()->shareFusionSchedules(id().value());
+  FusionSchedules* scheds = shared_scheds.get();
+  fusionCache()->markUsed(scheds);
 
   if (profile) {
     ProfilerOptionsGuard::getCurOptions().set(ProfilerOption::Enable);
@@ -413,10 +464,18 @@ std::pair<KernelArgumentHolder, std::vector<Sharding>> FusionDefinition::
     return &user_sched;
   };
   const auto* user_sched = find_user_schedule();
+  NVF_CHECK(
+      user_outputs.empty() ||
+          (user_sched == nullptr && !use_multidevice_executor_),
+      "Outputs can't be given with user schedules or the "
+      "MultiDeviceExecutor.");
 
   KernelArgumentHolder outputs;
   if (user_sched == nullptr) {
     if (use_multidevice_executor_) {
+      // Unlike the FusionExecutorCache, the MultiDeviceExecutor isn't run
+      // concurrently.
+      std::lock_guard<std::mutex> guard(scheds->scheds_lock);
       if (scheds->multi_device_executor == nullptr) {
         MultiDeviceExecutorParams params;
         params.lower.communicator_backend = backend_type_;
@@ -427,9 +486,12 @@ std::pair<KernelArgumentHolder, std::vector<Sharding>> FusionDefinition::
       }
       outputs = scheds->multi_device_executor->runWithInput(args);
     } else {
-      scheds->createExecutorIfNotExists();
+      {
+        std::lock_guard<std::mutex> guard(scheds->scheds_lock);
+        scheds->createExecutorIfNotExists();
+      }
       outputs = scheds->auto_gen_schedules->runFusionWithInputs(
-          args, std::nullopt, args.getDeviceIndex());
+          args, std::nullopt, args.getDeviceIndex(), user_outputs);
     }
   } else {
     NVF_ERROR(
@@ -506,6 +568,38 @@ std::pair<KernelArgumentHolder, std::vector<Sharding>> FusionDefinition::
   return std::make_pair(std::move(outputs), std::move(output_shardings));
 }
 
+CompiledFusion FusionDefinition::compile(std::optional<int8_t> device) const {
+  NVF_CHECK(id().has_value(), "Valid fusion schedule is not available!");
+  NVF_CHECK(
+      !use_multidevice_executor_,
+      "A FusionDefinition using the MultiDeviceExecutor can't be compiled.");
+  std::shared_ptr<FusionSchedules> scheds =
+      fusionCache()->shareFusionSchedules(id().value());
+  std::lock_guard<std::mutex> guard(scheds->scheds_lock);
+  NVF_CHECK(
+      scheds->user_def_schedules.empty(),
+      "A FusionDefinition with user schedules can't be compiled.");
+  scheds->createExecutorIfNotExists();
+  return CompiledFusion(
+      scheds,
+      scheds->auto_gen_schedules.get(),
+      std::ssize(scheds->preschedFusion()->inputs()),
+      device);
+}
+
+KernelArgumentHolder CompiledFusion::run(KernelArgumentHolder args) const {
+  NVF_CHECK(
+      args.size() == num_args_,
+      "Expected ",
+      num_args_,
+      " arguments but got ",
+      args.size());
+  args.setDeviceIndex(device_);
+  const int8_t device_index = args.getDeviceIndex();
+  return executor_cache_->runFusionWithInputs(
+      std::move(args), std::nullopt, device_index);
+}
+
 std::string FusionDefinition::fusionIr() {
   NVF_CHECK(id().has_value(), "Invalid fusion definition!");
   std::stringstream ss;
@@ -707,27 +801,9 @@ void FusionDefinition::defineRecord(RecordFunctor* record) {
       max_length_,
       "operations.  The max_length for FusionDefintion's might need to be ",
       "increased if the definition is created as expected.");
+  // The trie is only walked when finalizing the definition, and only if its
+  // fingerprint doesn't resolve the terminal node.
   addRecord(record);
-  auto child_node =
-      fusionCache()->queryChildren(trie_node_, recording_.back().get());
-  // If the Record is found in the cache, the FusionDefinition and the Cache
-  // will not share Record given the Record had to be created in order to
-  // match it but it also already existed in the cache.
-  if (child_node.has_value()) {
-    if (isDebugDumpEnabled(DebugDumpOption::PythonFrontendDebug)) {
-      debug() << "\nFusionDefinition: Record (hash: 0x" << std::hex
-              << record->hash() << ") hit in Fusion Cache.\n";
-    }
-    trie_node_ = child_node.value();
-    // The FusionDefinition and the Cache will share the Record
-  } else {
-    if (isDebugDumpEnabled(DebugDumpOption::PythonFrontendDebug)) {
-      debug() << "\nFusionDefinition: Record (hash: 0x" << std::hex
-              << record->hash() << ") missed in Fusion Cache.\n";
-    }
-    trie_node_ =
-        fusionCache()->createChild(trie_node_, recording_.back().get());
-  }
 }
 
 Fusion* FusionDefinition::preschedFusion() {
@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 
 #include <exceptions.h>
@@ -23,6 +24,7 @@ namespace nvfuser::python_frontend {
 class FusionCache;
 class FusionDefinition;
 class FusionInterface;
+class FusionSchedules;
 class FusionState;
 struct RecordFunctor;
 class SegmentationState;
@@ -143,6 +145,40 @@ struct Vector {
   FusionDefinition* fusion_definition;
 };
 
+//! A FusionDefinition bound to the FusionExecutorCache of its schedules, for
+//! calling it repeatedly with little host overhead, e.g., in the decode steps
+//! of a model. Unlike FusionDefinition::execute, a call doesn't look up the
+//! schedules or the user schedules of the definition, set options or capture
+//! debug output; it passes the arguments straight to the
+//! FusionExecutorCache. The number of arguments is fixed when compiling.
+//! The schedules stay alive while it exists, even if the FusionCache evicts
+//! them.
+class NVF_API CompiledFusion {
+ public:
+  CompiledFusion(
+      std::shared_ptr<FusionSchedules> scheds,
+      FusionExecutorCache* executor_cache,
+      int64_t num_args,
+      std::optional<int8_t> device)
+      : scheds_(std::move(scheds)),
+        executor_cache_(executor_cache),
+        num_args_(num_args),
+        device_(device) {}
+
+  //! Runs the fusion and returns its outputs
+  KernelArgumentHolder run(KernelArgumentHolder args) const;
+
+  int64_t numArgs() const {
+    return num_args_;
+  }
+
+ private:
+  std::shared_ptr<FusionSchedules> scheds_;
+  FusionExecutorCache* executor_cache_;
+  int64_t num_args_;
+  std::optional<int8_t> device_;
+};
+
 //! FusionDefinition defines the C++ side of a Python Context manager to
 //! encapsulate the definition of fusion operations.
 //!
@@ -205,6 +241,10 @@ class NVF_API FusionDefinition : public FusionState {
   //! of output shardings. If it was a single-GPU execution, output shardings
   //! will be empty.
   //!
+  //! If `user_outputs` is not empty, the outputs are written into its
+  //! tensors, see FusionExecutorCache::runFusionWithInputs. This isn't
+  //! supported with user schedules or the MultiDeviceExecutor.
+  //!
   //! Alternatives considered:
   //! 1. Return std::vector<std::variant<at::Tensor, DistributedTensor>>.
   //! Because DistributedTensor can also represent a non-distributed tensor, I
@@ -228,7 +268,13 @@ class NVF_API FusionDefinition : public FusionState {
       bool capture_debug_output,
       bool profile,
       std::vector<std::string> _enable_options,
-      std::vector<std::string> _disable_options) const;
+      std::vector<std::string> _disable_options,
+      KernelArgumentHolder user_outputs) const;
+
+  //! Binds a finalized definition to the FusionExecutorCache of its
+  //! schedules. The definition must not have user schedules and must not use
+  //! the MultiDeviceExecutor.
+  NVF_API CompiledFusion compile(std::optional<int8_t> device) const;
 
   //! Return debugging output captured through exeuction with
   //! capture_debug_output=true
@@ -310,6 +356,9 @@ class NVF_API FusionDefinition : public FusionState {
  private:
   //! Returns the FusionCache Ptr that holds the cache of Fusions
   FusionCache* fusionCache() const;
+  //! Walks the trie of the FusionCache from trie_node_ along the recorded
+  //! records, creating the nodes that are missing
+  void walkTrie();
   //! Composite operations can create hidden TensorViews in the CPP fusion
   //! These TensorViews are not visible from python definition. This function
   //! finds and adds them to FusionDefinition
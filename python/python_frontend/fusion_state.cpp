@@ -104,6 +104,7 @@ std::unique_ptr<FusionState> FusionState::clone() {
   for (auto&& rf : recording_) {
     state->recording_.emplace_back(rf->clone());
   }
+  state->fingerprint_ = fingerprint_;
   state->fusion_ = fusion_;
   state->fusion_state_.insert(
       state->fusion_state_.end(), fusion_state_.begin(), fusion_state_.end());
@@ -155,6 +156,7 @@ void FusionState::addRecord(RecordFunctor* record) {
   FUSER_PERF_SCOPE("FusionContainer::addRecord");
   recording_.emplace_back(record);
   num_recording_states_ += record->numOutputs();
+  hashCombine(fingerprint_, record->hash());
   RecordFunctor* state_record = recording_.back().get();
 
   // NOTE: when the outputs are added to the Record constructor,
@@ -99,6 +99,12 @@ class FusionState {
 
   //! Add a Record
   void addRecord(RecordFunctor* record);
+  //! Hash of the records added so far, combined in order. It's computed as
+  //! the records are added, so a definition can be looked up in the
+  //! FusionCache without hashing its records again.
+  size_t fingerprint() const {
+    return fingerprint_;
+  }
   //! Builds an nvFuser Fusion IR object
   void buildFusionIr(Fusion* fusion);
 
@@ -138,6 +144,8 @@ class FusionState {
   //! The number of states in Fusion Container
   //! A sum of all outputs for each RecordFunctor
   size_t num_recording_states_;
+  //! Hash of recording_, see fingerprint()
+  size_t fingerprint_ = 0;
 };
 
 } // namespace nvfuser::python_frontend
@@ -30,6 +30,7 @@
 #include <python_frontend/python_bindings.h>
 #include <python_frontend/translation.h>
 #include <python_utils.h>
+#include <runtime/compile_thread_pool.h>
 #include <runtime/fusion_kernel_runtime.h>
 #include <scheduler/compile_time_info.h>
 #include <scheduler/registry.h>
@@ -590,7 +591,17 @@ void defineHeuristicParamBindings(py::module& nvfuser) {
       .PARAM(PointwiseParams, flip_grid_binding)
       .PARAM(PointwiseParams, vectorization_factor)
       .PARAM(PointwiseParams, unroll_factor_inner)
-      .PARAM(PointwiseParams, unroll_factor_outer);
+      .PARAM(PointwiseParams, unroll_factor_outer)
+      .PARAM(PointwiseParams, threads_per_block_1d)
+      .PARAM(PointwiseParams, use_tma_load)
+      .PARAM(PointwiseParams, use_tma_store)
+      .PARAM(PointwiseParams, tma_tile_outer)
+      .PARAM(PointwiseParams, tma_tile_inner)
+      .PARAM(PointwiseParams, tma_tiles_per_block)
+      .PARAM(PointwiseParams, circular_buffer_stages)
+      .PARAM(PointwiseParams, persistent_grid)
+      .PARAM(PointwiseParams, input_vectorization_factors)
+      .PARAM(PointwiseParams, output_vectorization_factors);
 
   // Reduction scheduler parameters
   INITHEURISTICPARAMS(ReductionParams)
@@ -605,6 +616,8 @@ void defineHeuristicParamBindings(py::module& nvfuser) {
       .PARAM(ReductionParams, unroll_factor_top_of_vectorization)
       .PARAM(ReductionParams, vectorize_inner_reduction)
       .PARAM(ReductionParams, split_grid_dim_inner_reduction)
+      .PARAM(ReductionParams, cluster_inner_reduction)
+      .PARAM(ReductionParams, atomic_inner_reduction)
       .PARAM(ReductionParams, pad_inner_reduction_to_warp)
       .PARAM(ReductionParams, batches_per_block_inner_reduction)
       .PARAM(ReductionParams, block_dim_inner_reduction)
@@ -623,6 +636,7 @@ void defineHeuristicParamBindings(py::module& nvfuser) {
       .PARAM(ReductionParams, block_dim_outer_reduction)
       .PARAM(ReductionParams, grid_dim_outer_reduction)
       .PARAM(ReductionParams, compute_persistent_buffer_with_first_consumer)
+      .PARAM(ReductionParams, prefetch_serial_reduction_loads)
       .PARAM(ReductionParams, static_bdimx)
       .PARAM(ReductionParams, static_bdimy)
       .PARAM(ReductionParams, combined_inner_outer)
@@ -644,11 +658,14 @@ void defineHeuristicParamBindings(py::module& nvfuser) {
       .PARAM(MatmulParams, use_ldst_matrix)
       .PARAM(MatmulParams, promote_prologue_smem_reuse)
       .PARAM(MatmulParams, splitk_factor)
+      .PARAM(MatmulParams, splitk_serial_chains)
       .PARAM(MatmulParams, tiling_strategy)
       .PARAM(MatmulParams, buffering_loop_level)
       .PARAM(MatmulParams, circular_buffering_strategy)
       .PARAM(MatmulParams, cta_order)
       .PARAM(MatmulParams, cluster_dims)
+      .PARAM(MatmulParams, multicast_operands)
+      .PARAM(MatmulParams, overlap_epilogue_store)
       .PARAM(MatmulParams, mma_macro);
 
 #undef PARAM
@@ -707,7 +724,9 @@ void initNvFuserPythonBindings(PyObject* module) {
       .value("unspecified", CacheOp::Unspecified)
       .value("all_levels", CacheOp::AllLevels)
       .value("streaming", CacheOp::Streaming)
-      .value("global", CacheOp::Global);
+      .value("global", CacheOp::Global)
+      .value("evict_last", CacheOp::EvictLast)
+      .value("no_allocate", CacheOp::NoAllocate);
 
   //! MemoryType used for scheduling
   py::enum_<MemoryType>(nvfuser, "MemoryType")
@@ -736,6 +755,30 @@ void initNvFuserPythonBindings(PyObject* module) {
   nvfuser.def("compute_contiguity", computeContiguity);
   nvfuser.def("compute_tensor_descriptor", computeTensorDescriptor);
   nvfuser.def("serialize", serialize);
+  nvfuser.def("serialize_bundle", serializeBundle, py::arg("directory"));
+  nvfuser.def(
+      "configure_compile_thread_pool",
+      [](int64_t num_threads,
+         std::vector<int64_t> cpus,
+         std::optional<int64_t> nice) {
+        setCompileThreadPoolOptions(
+            {.num_threads = num_threads,
+             .cpus = std::move(cpus),
+             .nice = nice});
+      },
+      py::arg("num_threads") = 0,
+      py::arg("cpus") = std::vector<int64_t>{},
+      py::arg("nice") = py::none());
+  nvfuser.def("compile_thread_pool_stats", []() {
+    const CompileThreadPoolStats stats = getThreadPool()->stats();
+    py::dict dict;
+    dict["num_threads"] = stats.num_threads;
+    dict["queued"] = stats.queued;
+    dict["running"] = stats.running;
+    dict["completed"] = stats.completed;
+    dict["max_queued"] = stats.max_queued;
+    return dict;
+  });
 
   //! Binding the FusionCache that holds a cache of Fusions
   //! This is only bound to provide an interface to get the number of fusions
@@ -827,6 +870,21 @@ void initNvFuserPythonBindings(PyObject* module) {
          int64_t is_warp_specialized_) {
         self.is_warp_specialized = is_warp_specialized_;
       });
+  //! Stages of a kernel per warp group, profiled with
+  //! EnableOption::KernelProfile
+  py::class_<KernelStageProfile> stage_prof(nvfuser, "KernelStageProfile");
+  stage_prof.def_property_readonly(
+      "stage", [](KernelStageProfile& self) { return self.stage; });
+  stage_prof.def_property_readonly(
+      "warp_group", [](KernelStageProfile& self) { return self.warp_group; });
+  stage_prof.def_property_readonly(
+      "cycles", [](KernelStageProfile& self) { return self.cycles; });
+  stage_prof.def_property_readonly(
+      "count", [](KernelStageProfile& self) { return self.count; });
+  stage_prof.def_property_readonly(
+      "percentage_kernel",
+      [](KernelStageProfile& self) { return self.percentage_kernel; });
+
   //! KernelProfiles are encapsulated in FusionProfiles where each KP
   //! is associated with a segment.
   py::class_<KernelProfile> kernel_prof(nvfuser, "KernelProfile");
@@ -852,6 +910,20 @@ void initNvFuserPythonBindings(PyObject* module) {
   kernel_prof.def_property_readonly(
       "percentage_peak_bandwidth",
       [](KernelProfile& self) { return self.percentage_peak_bandwidth; });
+  kernel_prof.def_property_readonly(
+      "flops", [](KernelProfile& self) { return self.flops; });
+  kernel_prof.def_property_readonly(
+      "achieved_gflops",
+      [](KernelProfile& self) { return self.achieved_gflops; });
+  kernel_prof.def_property_readonly(
+      "percentage_peak_flops",
+      [](KernelProfile& self) { return self.percentage_peak_flops; });
+  kernel_prof.def_property_readonly(
+      "percentage_roofline",
+      [](KernelProfile& self) { return self.percentage_roofline; });
+  kernel_prof.def_property_readonly(
+      "below_roofline_threshold",
+      [](KernelProfile& self) { return self.below_roofline_threshold; });
   kernel_prof.def_property_readonly(
       "grid_str", [](KernelProfile& self) { return self.grid_str; });
   kernel_prof.def_property_readonly(
@@ -869,6 +941,11 @@ void initNvFuserPythonBindings(PyObject* module) {
       "output_bytes", [](KernelProfile& self) { return self.output_bytes; });
   kernel_prof.def_property_readonly(
       "scheduler", [](KernelProfile& self) { return self.scheduler; });
+  kernel_prof.def_property_readonly(
+      "heuristic_params",
+      [](KernelProfile& self) { return self.heuristic_params; });
+  kernel_prof.def_property_readonly(
+      "stages", [](KernelProfile& self) { return self.stages; });
 
   //! A fusion profile is generated for FusionDefinition.
   py::class_<FusionProfile> fusion_prof(nvfuser, "FusionProfile");
@@ -899,6 +976,9 @@ void initNvFuserPythonBindings(PyObject* module) {
       "input_bytes", [](FusionProfile& self) { return self.input_bytes; });
   fusion_prof.def_property_readonly(
       "output_bytes", [](FusionProfile& self) { return self.output_bytes; });
+  fusion_prof.def_property_readonly(
+      "peak_memory_bytes",
+      [](FusionProfile& self) { return self.peak_memory_bytes; });
   fusion_prof.def_property_readonly("kernel_profiles", [](FusionProfile& self) {
     return self.kernel_profiles;
   });
@@ -946,6 +1026,54 @@ void initNvFuserPythonBindings(PyObject* module) {
   vector_class.def(pybind11::self == pybind11::self);
   vector_class.def(pybind11::self != pybind11::self);
 
+  py::class_<CompiledFusion> compiled_fusion(nvfuser, "_CompiledFusion");
+  compiled_fusion.def_property_readonly(
+      "num_args", [](CompiledFusion& self) { return self.numArgs(); });
+  compiled_fusion.def(
+      "__call__",
+      [](const CompiledFusion& self,
+         const py::args& args) -> std::vector<at::Tensor> {
+        // Tensors and Python scalars are converted directly, without going
+        // through an IValue.
+        KernelArgumentHolder ins;
+        ins.reserve(self.numArgs());
+        auto push = [&ins](py::handle obj) {
+          if (THPVariable_Check(obj.ptr())) {
+            ins.push(THPVariable_Unpack(obj.ptr()));
+          } else if (py::isinstance<py::bool_>(obj)) {
+            ins.push(PolymorphicValue(obj.cast<bool>()));
+          } else if (py::isinstance<py::int_>(obj)) {
+            ins.push(PolymorphicValue(obj.cast<int64_t>()));
+          } else if (py::isinstance<py::float_>(obj)) {
+            ins.push(PolymorphicValue(obj.cast<double>()));
+          } else {
+            ins.push(torch::jit::toIValue(obj, c10::AnyType::get()));
+          }
+        };
+        for (py::handle obj : args) {
+          // Allows for a Vector of Sizes to be inputed as a list/tuple
+          if (py::isinstance<py::list>(obj) ||
+              py::isinstance<py::tuple>(obj)) {
+            for (py::handle item : obj) {
+              push(item);
+            }
+          } else {
+            push(obj);
+          }
+        }
+        KernelArgumentHolder outs;
+        {
+          py::gil_scoped_release release;
+          outs = self.run(std::move(ins));
+        }
+        std::vector<at::Tensor> out_tensors;
+        out_tensors.reserve(outs.size());
+        for (const auto& out : outs) {
+          out_tensors.push_back(out.as<at::Tensor>());
+        }
+        return out_tensors;
+      });
+
   //! The FusionDefinition is a context manager in Python where the user will
   //! define the set the operations and connections between operations for
   //! nvFuser to create.
@@ -969,7 +1097,11 @@ void initNvFuserPythonBindings(PyObject* module) {
       .def(
           "_finalize_definition",
           [](FusionDefinition& self) {
-            self.finalizeDefinition();
+            {
+              // Other threads can define and execute fusions meanwhile.
+              py::gil_scoped_release release;
+              self.finalizeDefinition();
+            }
             // Mark the end of a definition
             inst::Trace::instance()->endEvent("FusionDefinition Definition");
           })
@@ -1071,7 +1203,8 @@ void initNvFuserPythonBindings(PyObject* module) {
              bool capture_debug_output,
              bool profile,
              std::vector<std::string> _enable_options,
-             std::vector<std::string> _disable_options)
+             std::vector<std::string> _disable_options,
+             std::optional<std::vector<at::Tensor>> out)
               -> std::pair<std::vector<at::Tensor>, std::vector<Sharding>> {
             KernelArgumentHolder ins;
             for (py::handle obj : iter) {
@@ -1090,14 +1223,26 @@ void initNvFuserPythonBindings(PyObject* module) {
               NVF_CHECK(device.value() < 256, "Maximum device index is 255");
               int8_device = (int8_t)device.value();
             }
-            auto&& [outs, out_shardings] = self.execute(
-                ins,
-                int8_device,
-                override_user_schedule,
-                capture_debug_output,
-                profile,
-                _enable_options,
-                _disable_options);
+            KernelArgumentHolder user_outs;
+            if (out.has_value()) {
+              for (const at::Tensor& tensor : *out) {
+                user_outs.push(tensor);
+              }
+            }
+            KernelArgumentHolder outs;
+            std::vector<Sharding> out_shardings;
+            {
+              py::gil_scoped_release release;
+              std::tie(outs, out_shardings) = self.execute(
+                  ins,
+                  int8_device,
+                  override_user_schedule,
+                  capture_debug_output,
+                  profile,
+                  _enable_options,
+                  _disable_options,
+                  user_outs);
+            }
 
             std::vector<at::Tensor> out_tensors;
             out_tensors.reserve(outs.size());
@@ -1116,7 +1261,20 @@ void initNvFuserPythonBindings(PyObject* module) {
           py::arg("profile") = false,
           py::arg("_enable_options") = py::none(),
           py::arg("_disable_options") = py::none(),
+          py::arg("out") = py::none(),
           py::return_value_policy::reference)
+      .def(
+          "_compile",
+          [](FusionDefinition& self, std::optional<int64_t> device) {
+            std::optional<int8_t> int8_device = std::nullopt;
+            if (device.has_value()) {
+              NVF_CHECK(device.value() < 256, "Maximum device index is 255");
+              int8_device = (int8_t)device.value();
+            }
+            return self.compile(int8_device);
+          },
+          py::kw_only(),
+          py::arg("device") = py::none())
       .def_static(
           "_profile",
           &FusionProfiler::profile,
@@ -10,6 +10,8 @@
 
 #include <torch/torch.h>
 
+#include <thread>
+
 #include <python_frontend/fusion_cache.h>
 #include <tests/cpp/utils.h>
 #include <tests/cpp/validator.h>
@@ -183,4 +185,130 @@ TEST_F(NVFuserTest, PyFusionCache_CUDA) {
   }
 }
 
+// RUN CMD: bin/test_jit --gtest_filter="NVFuserTest*PyFusionCacheFingerprint*"
+TEST_F(NVFuserTest, PyFusionCacheFingerprint_CUDA) {
+  FusionCache::reset();
+  FusionCache* fc = FusionCache::get();
+
+  std::vector<std::unique_ptr<RecordFunctor>> records;
+  records.emplace_back(new TensorRecord(
+      {State(0, serde::StateType::Tensor)}, {3}, {true}, DataType::Float));
+  records.emplace_back(new ScalarRecord(
+      {State(1, serde::StateType::Scalar)}, std::monostate{}, DataType::Float));
+
+  TrieNode* node = fc->rootTriePtr();
+  for (const auto& record : records) {
+    node = fc->createChild(node, record.get());
+  }
+  std::unique_ptr<RecordFunctor> end_record(new EndRecord());
+  TrieNode* terminal = fc->createChild(node, end_record.get());
+
+  // Nothing is registered yet
+  EXPECT_FALSE(fc->queryFingerprint(42, records).has_value());
+
+  fc->registerFingerprint(42, terminal);
+  auto hit = fc->queryFingerprint(42, records);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit.value(), terminal);
+  EXPECT_FALSE(fc->queryFingerprint(7, records).has_value());
+
+  // A different definition with a colliding fingerprint isn't resolved by it
+  std::vector<std::unique_ptr<RecordFunctor>> prefix;
+  prefix.emplace_back(records.front()->clone());
+  EXPECT_FALSE(fc->queryFingerprint(42, prefix).has_value());
+  std::vector<std::unique_ptr<RecordFunctor>> other;
+  other.emplace_back(records.front()->clone());
+  other.emplace_back(new ScalarRecord(
+      {State(1, serde::StateType::Scalar)}, std::monostate{}, DataType::Int));
+  EXPECT_FALSE(fc->queryFingerprint(42, other).has_value());
+}
+
+// RUN CMD: bin/test_jit --gtest_filter="NVFuserTest*PyFusionCacheThreads*"
+TEST_F(NVFuserTest, PyFusionCacheThreads_CUDA) {
+  FusionCache::reset();
+  FusionCache* fc = FusionCache::get();
+
+  // Threads walk the trie with the same definition, or with one of a few
+  // different definitions, concurrently.
+  constexpr int64_t num_threads = 8;
+  constexpr int64_t num_definitions = 2;
+  std::vector<TrieNode*> terminals(num_threads, nullptr);
+  std::vector<std::thread> threads;
+  for (int64_t i : arange(num_threads)) {
+    threads.emplace_back([&, i]() {
+      std::vector<std::unique_ptr<RecordFunctor>> records;
+      records.emplace_back(new TensorRecord(
+          {State(0, serde::StateType::Tensor)}, {3}, {true}, DataType::Float));
+      records.emplace_back(new ScalarRecord(
+          {State(1, serde::StateType::Scalar)},
+          std::monostate{},
+          i % num_definitions == 0 ? DataType::Float : DataType::Int));
+      records.emplace_back(new EndRecord());
+      TrieNode* node = fc->rootTriePtr();
+      for (const auto& record : records) {
+        auto child = fc->queryChildren(node, record.get());
+        node = child.has_value() ? child.value()
+                                 : fc->createChild(node, record.get());
+      }
+      terminals.at(i) = node;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ((int64_t)fc->numFusions(), num_definitions);
+  for (int64_t i : arange(num_threads)) {
+    ASSERT_NE(terminals.at(i), nullptr);
+    EXPECT_TRUE(terminals.at(i)->isTerminal());
+    EXPECT_EQ(terminals.at(i), terminals.at(i % num_definitions));
+  }
+  EXPECT_NE(terminals.at(0), terminals.at(1));
+}
+
+// RUN CMD: bin/test_jit --gtest_filter="NVFuserTest*PyFusionCacheEviction*"
+TEST_F(NVFuserTest, PyFusionCacheEviction_CUDA) {
+  FusionCache::reset();
+  FusionCache* fc = FusionCache::get(2);
+
+  // Creates the terminal node of a definition with a scalar of `dtype`
+  auto define = [&](DataType dtype) -> TrieNode* {
+    std::unique_ptr<RecordFunctor> record(new ScalarRecord(
+        {State(0, serde::StateType::Scalar)}, std::monostate{}, dtype));
+    std::unique_ptr<RecordFunctor> end_record(new EndRecord());
+    TrieNode* node = fc->createChild(fc->rootTriePtr(), record.get());
+    TrieNode* terminal = fc->createChild(node, end_record.get());
+    FusionSchedules* scheds = fc->queryFusionSchedules(terminal->fusion_id);
+    fc->markUsed(scheds);
+    scheds->markDefined();
+    return terminal;
+  };
+
+  TrieNode* a = define(DataType::Float);
+  TrieNode* b = define(DataType::Int);
+  std::shared_ptr<FusionSchedules> a_scheds =
+      fc->shareFusionSchedules(a->fusion_id);
+  fc->markUsed(a_scheds.get());
+
+  // b is the least recently used fusion.
+  TrieNode* c = define(DataType::Bool);
+  EXPECT_EQ(fc->numFusions(), 2);
+  EXPECT_THAT(
+      [&]() { fc->queryFusionSchedules(b->fusion_id); },
+      ::testing::ThrowsMessage<nvfuser::nvfError>(
+          ::testing::HasSubstr("was evicted")));
+  EXPECT_EQ(fc->queryFusionSchedules(a->fusion_id), a_scheds.get());
+
+  // Reviving b under the same id evicts a, which stays alive while shared.
+  EXPECT_TRUE(fc->reviveFusionSchedules(b->fusion_id));
+  EXPECT_FALSE(fc->reviveFusionSchedules(b->fusion_id));
+  EXPECT_EQ(fc->numFusions(), 2);
+  EXPECT_EQ(a_scheds->fusion_id_, (int64_t)a->fusion_id);
+  EXPECT_THAT(
+      [&]() { fc->queryFusionSchedules(a->fusion_id); },
+      ::testing::ThrowsMessage<nvfuser::nvfError>(
+          ::testing::HasSubstr("was evicted")));
+  EXPECT_NE(fc->queryFusionSchedules(c->fusion_id), nullptr);
+}
+
 } // namespace nvfuser
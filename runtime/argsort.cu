@@ -11,54 +11,9 @@
 namespace nvf {
 namespace argsort {
 
-// Block state constants following nvFuser conventions from fused_reduction.cu
-// Sort Domain - TEMPLATE STATE 0
-//   - Participating in the sort, has values coming in, sorted values coming out
-// Iteration Domain - TEMPLATE STATE 1
-//   - Not participating in the sort, has values across the dimension after
-//   sorting
-constexpr __device__ bool isSort(int STATE) {
-  return STATE == 0;
-}
-
-constexpr __device__ bool isIter(int STATE) {
-  return STATE == 1;
-}
-
-// Type utils for interoperation between our own half types and the
-// CUDA standard types
-template <typename T>
-struct CudaType {
-  using type = T;
-
-  __device__ inline static T get(const T& t) {
-    return t;
-  }
-};
-
-#ifdef __NVFUSER_HAS_HALF__
-template <>
-struct CudaType<__half> {
-  using type = __nv_half;
-
-  __device__ inline static typename CudaType<__half>::type get(
-      const __half& t) {
-    return __ushort_as_half(__NVFUSER_HALF_TO_CUS(t));
-  }
-};
-#endif // __NVFUSER_HAS_HALF__
-
-#ifdef __NVFUSER_HAS_BFLOAT__
-template <>
-struct CudaType<__bfloat> {
-  using type = __nv_bfloat16;
-
-  __device__ inline static typename CudaType<__bfloat>::type get(
-      const __bfloat& t) {
-    return __ushort_as_bfloat16(__NVFUSER_BFLOAT_TO_CUS(t));
-  }
-};
-#endif // __NVFUSER_HAS_BFLOAT__
+using sort_utils::CudaType;
+using sort_utils::isIter;
+using sort_utils::isSort;
 
 // Block-parallel argsort using CUB BlockRadixSort
 // Following nvFuser dimensional template parameter pattern like
@@ -186,8 +186,78 @@ enum class CacheOp {
   AllLevels,
   Streaming,
   Global,
+  EvictLast,
+  NoAllocate,
 };
 
+// Loads with an L2 evict_last policy so that lines read by many blocks, e.g.
+// broadcast operands, stay in L2 while streaming data passes through it. The
+// policy requires sm_80; older architectures cache at all levels instead.
+template <typename T>
+__device__ inline T loadGlobalEvictLast(T* from);
+
+template <>
+__device__ inline uint2 loadGlobalEvictLast(uint2* from) {
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800))
+  uint2 data;
+  uint64_t policy;
+  asm("createpolicy.fractional.L2::evict_last.b64 %0, 1.0;" : "=l"(policy));
+  asm volatile("ld.global.L2::cache_hint.v2.s32 {%0,%1}, [%2], %3;"
+               : "=r"(data.x), "=r"(data.y)
+               : "l"(from), "l"(policy));
+  return data;
+#else
+  return __ldca(from);
+#endif
+}
+
+template <>
+__device__ inline uint4 loadGlobalEvictLast(uint4* from) {
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800))
+  uint4 data;
+  uint64_t policy;
+  asm("createpolicy.fractional.L2::evict_last.b64 %0, 1.0;" : "=l"(policy));
+  asm volatile("ld.global.L2::cache_hint.v4.s32 {%0,%1,%2,%3}, [%4], %5;"
+               : "=r"(data.x), "=r"(data.y), "=r"(data.z), "=r"(data.w)
+               : "l"(from), "l"(policy));
+  return data;
+#else
+  return __ldca(from);
+#endif
+}
+
+// Loads read-only data through the non-coherent path without allocating it in
+// L1, which keeps L1 for data that is reused. Requires sm_70; older
+// architectures stream the data instead.
+template <typename T>
+__device__ inline T loadGlobalNoAllocate(T* from);
+
+template <>
+__device__ inline uint2 loadGlobalNoAllocate(uint2* from) {
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 700))
+  uint2 data;
+  asm volatile("ld.global.nc.L1::no_allocate.v2.s32 {%0,%1}, [%2];"
+               : "=r"(data.x), "=r"(data.y)
+               : "l"(from));
+  return data;
+#else
+  return __ldcs(from);
+#endif
+}
+
+template <>
+__device__ inline uint4 loadGlobalNoAllocate(uint4* from) {
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 700))
+  uint4 data;
+  asm volatile("ld.global.nc.L1::no_allocate.v4.s32 {%0,%1,%2,%3}, [%4];"
+               : "=r"(data.x), "=r"(data.y), "=r"(data.z), "=r"(data.w)
+               : "l"(from));
+  return data;
+#else
+  return __ldcs(from);
+#endif
+}
+
 template <typename T, CacheOp cache_op>
 __device__ void loadGlobalToLocalCached(void* to, void* from) {
   T* typed_to = reinterpret_cast<T*>(to);
@@ -202,6 +272,12 @@ __device__ void loadGlobalToLocalCached(void* to, void* from) {
     case CacheOp::Global:
       *typed_to = __ldcg(typed_from);
       break;
+    case CacheOp::EvictLast:
+      *typed_to = loadGlobalEvictLast<T>(typed_from);
+      break;
+    case CacheOp::NoAllocate:
+      *typed_to = loadGlobalNoAllocate<T>(typed_from);
+      break;
   }
 }
 
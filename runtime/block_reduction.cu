@@ -196,6 +196,142 @@ __device__ void blockReduce(
       block_dim);
 }
 
+// Calls the i-th of reduction_ops as reduction_ops_i(a[i * a_stride],
+// b[i * b_stride]), so that grouped reductions can apply a different op to
+// each of their values.
+template <typename T, typename... Funcs>
+__device__ __forceinline__ void reduceEachValue(
+    T* a,
+    unsigned int a_stride,
+    const T* b,
+    unsigned int b_stride,
+    Funcs... reduction_ops) {
+  unsigned int i = 0;
+  ((reduction_ops(a[i * a_stride], b[i * b_stride]), ++i), ...);
+}
+
+// Same as reduceEachValue but accumulates into the values pointed to by out
+template <int N, typename T, typename... Funcs>
+__device__ __forceinline__ void reduceEachValueInto(
+    T* const (&out)[N],
+    const T* b,
+    unsigned int b_stride,
+    Funcs... reduction_ops) {
+  unsigned int i = 0;
+  ((reduction_ops(*out[i], b[i * b_stride]), ++i), ...);
+}
+
+// Reduces N independent values over the same thread dimensions with a
+// single tree. Value i is reduced with the i-th of reduction_ops and
+// occupies the i-th plane of shared_mem, which must hold N values per thread.
+// Compared to N calls of blockReduce, the values share the index math and all
+// of the block syncs of the tree.
+template <
+    bool X_REDUCE,
+    bool Y_REDUCE,
+    bool Z_REDUCE,
+    bool Aligned,
+    int N,
+    typename T,
+    typename BlockDimT,
+    typename... Funcs>
+__device__ void groupedBlockReduce(
+    T* const (&out)[N],
+    const T (&inp_val)[N],
+    T* shared_mem,
+    bool read_pred,
+    bool write_pred,
+    const T (&init_val)[N],
+    // block_dim is basically just blockDim (wrapped as DefaultBlockDim) if
+    // there is no warp specialization in the kernel. If there is warp
+    // specialization, block_dim is the the dimension of the compute warps.
+    BlockDimT block_dim,
+    Funcs... reduction_ops) {
+  static_assert(sizeof...(Funcs) == N, "Expected one reduction op per value");
+
+  bool should_write =
+      index_utils::maskedIsZero<X_REDUCE, Y_REDUCE, Z_REDUCE>(threadIdx);
+  unsigned int reduction_size =
+      index_utils::maskedSize<X_REDUCE, Y_REDUCE, Z_REDUCE>(block_dim);
+  unsigned int reduction_tid =
+      index_utils::maskedOffset<X_REDUCE, Y_REDUCE, Z_REDUCE>(
+          threadIdx, block_dim);
+
+  // Same layout of each plane as in blockReduce
+  unsigned int smem_offset = threadIdx.x + threadIdx.y * block_dim.x +
+      threadIdx.z * block_dim.x * block_dim.y;
+  unsigned int plane_size = block_dim.x * block_dim.y * block_dim.z;
+
+  constexpr int num_redu_dims = (int)X_REDUCE + (int)Y_REDUCE + (int)Z_REDUCE;
+  constexpr bool xz_reduce = (num_redu_dims == 2 && !Y_REDUCE);
+  unsigned int peer_stride = 1;
+  if (num_redu_dims == 1) {
+    peer_stride = X_REDUCE ? 1
+        : Y_REDUCE         ? block_dim.x
+                           : block_dim.x * block_dim.y;
+  } else if (num_redu_dims == 2 && Y_REDUCE) {
+    peer_stride = !Z_REDUCE ? 1 : block_dim.x;
+  }
+  auto peer_offset_at = [&](int factor) -> unsigned int {
+    if constexpr (xz_reduce) {
+      if (block_dim.y > 1) {
+        unsigned int redu_offset = reduction_tid + factor;
+        unsigned int idz = redu_offset / block_dim.x;
+        unsigned int idx = redu_offset % block_dim.x;
+        return idx + threadIdx.y * block_dim.x +
+            idz * block_dim.x * block_dim.y;
+      }
+    }
+    return smem_offset + factor * peer_stride;
+  };
+
+  // Initialize shared memory
+#pragma unroll
+  for (int i = 0; i < N; ++i) {
+    shared_mem[i * plane_size + smem_offset] =
+        read_pred ? inp_val[i] : init_val[i];
+  }
+  block_sync::sync<Aligned>(block_dim);
+
+  // Reduce down to nearest power of 2 for the tree reduction:
+  int np2 = 1 << (31 - __clz(reduction_size));
+  if (reduction_tid < np2 && reduction_tid + np2 < reduction_size) {
+    reduceEachValue(
+        shared_mem + smem_offset,
+        plane_size,
+        shared_mem + peer_offset_at(np2),
+        plane_size,
+        reduction_ops...);
+  }
+  block_sync::sync<Aligned>(block_dim);
+
+  // loop peel the final iteration to save one syncthread for the end
+  for (int factor = np2 / 2; factor > 1; factor >>= 1) {
+    if (reduction_tid < factor) {
+      reduceEachValue(
+          shared_mem + smem_offset,
+          plane_size,
+          shared_mem + peer_offset_at(factor),
+          plane_size,
+          reduction_ops...);
+    }
+    block_sync::sync<Aligned>(block_dim);
+  }
+
+  if (should_write && write_pred) {
+    reduceEachValueInto(
+        out, shared_mem + smem_offset, plane_size, reduction_ops...);
+    if (reduction_size > 1) {
+      reduceEachValueInto(
+          out,
+          shared_mem + smem_offset + peer_stride,
+          plane_size,
+          reduction_ops...);
+    }
+  }
+  block_sync::sync<Aligned>(block_dim);
+}
+
 // Each thread in the iteration dimension processes N elements
 // Typical usage is in outer reduction where the iteration dimension
 // is parallelized by vectorized loads, bidmx. The reduction dimension
@@ -34,6 +34,13 @@ void clusterSync() {
   clusterWait();
 }
 
+// Synchronize threads in cluster. Unlike clusterSync, the threads of a warp
+// don't have to execute the barrier convergently.
+void clusterSyncUnaligned() {
+  asm volatile("barrier.cluster.arrive;" : :);
+  asm volatile("barrier.cluster.wait;" : :);
+}
+
 // Returns the dim3 grid size in terms of number of clusters.
 dim3 clusterGridDims() {
   uint32_t x, y, z;
@@ -86,4 +93,82 @@ uint32_t mapSharedRank(uint32_t smemAddr, uint32_t rank) {
   return result;
 }
 
+// Returns the generic address of the same location as ptr, which points to
+// the shared memory of this block, in the shared memory of the block with the
+// given rank in the cluster
+template <typename T>
+T* mapSharedRank(T* ptr, uint32_t rank) {
+  uint64_t result;
+  asm volatile("mapa.u64  %0, %1, %2;"
+               : "=l"(result)
+               : "l"(reinterpret_cast<uint64_t>(ptr)), "r"(rank));
+  return reinterpret_cast<T*>(result);
+}
+
+// TMA multicast: the tiles loaded by the blocks of a cluster that are the same
+// across some dimensions of the cluster are loaded once, by the block whose
+// coordinates in these dimensions are 0, into the shared memory of all of
+// these blocks. The dimensions are given as a bitmask of x (1), y (2) and
+// z (4).
+
+// Returns the rank of the block that multicasts the tiles of this block that
+// are shared across shared_dims.
+uint32_t multicastLeaderRank(uint32_t shared_dims) {
+  dim3 id = blockIdInCluster();
+  dim3 shape = clusterShape();
+  uint32_t x = (shared_dims & 1) ? 0 : id.x;
+  uint32_t y = (shared_dims & 2) ? 0 : id.y;
+  uint32_t z = (shared_dims & 4) ? 0 : id.z;
+  return x + shape.x * (y + shape.y * z);
+}
+
+bool isMulticastLeader(uint32_t shared_dims) {
+  return multicastLeaderRank(shared_dims) == blockRankInCluster();
+}
+
+// Returns the mask of the ranks of the blocks that share the tiles of this
+// block across shared_dims, this block included.
+uint16_t multicastMask(uint32_t shared_dims) {
+  dim3 id = blockIdInCluster();
+  dim3 shape = clusterShape();
+  uint16_t mask = 0;
+  for (uint32_t z = 0; z < shape.z; ++z) {
+    for (uint32_t y = 0; y < shape.y; ++y) {
+      for (uint32_t x = 0; x < shape.x; ++x) {
+        if (((shared_dims & 1) || x == id.x) &&
+            ((shared_dims & 2) || y == id.y) &&
+            ((shared_dims & 4) || z == id.z)) {
+          mask |= (uint16_t)(1 << (x + shape.x * (y + shape.y * z)));
+        }
+      }
+    }
+  }
+  return mask;
+}
+
+// Returns the number of blocks that release the tiles multicast by this
+// block, that is, this block and the blocks whose leader across any of
+// shared_dims is this block.
+template <uint32_t... shared_dims>
+uint32_t multicastArrivingBlocks() {
+  constexpr uint32_t all_shared_dims[] = {shared_dims...};
+  dim3 id = blockIdInCluster();
+  dim3 shape = clusterShape();
+  uint32_t count = 0;
+  for (uint32_t z = 0; z < shape.z; ++z) {
+    for (uint32_t y = 0; y < shape.y; ++y) {
+      for (uint32_t x = 0; x < shape.x; ++x) {
+        bool arrives = x == id.x && y == id.y && z == id.z;
+        for (uint32_t dims : all_shared_dims) {
+          arrives = arrives ||
+              (((dims & 1) ? 0 : x) == id.x && ((dims & 2) ? 0 : y) == id.y &&
+               ((dims & 4) ? 0 : z) == id.z);
+        }
+        count += arrives ? 1 : 0;
+      }
+    }
+  }
+  return count;
+}
+
 #endif // Arch 90
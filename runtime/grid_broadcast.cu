@@ -29,12 +29,13 @@ template <
     bool Z_THREAD,
     bool Aligned,
     typename T,
-    typename BlockDimT>
+    typename BlockDimT,
+    int SyncFlagsAllocDims>
 __device__ void broadcast(
     T& out,
     const T& inp_val,
     volatile T* work_buf,
-    Tensor<int64_t, 1> sync_flags,
+    Tensor<int64_t, 1, SyncFlagsAllocDims> sync_flags,
     bool read_write_pred,
     // block_dim is basically just blockDim (wrapped as DefaultBlockDim) if
     // there is no warp specialization in the kernel. If there is warp
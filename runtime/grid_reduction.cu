@@ -716,6 +716,145 @@ __device__ void serialReductionStep(
   }
 }
 
+// Chained version of serialReductionStep, used with
+// grid_sync::blockSerializeWaitChained. The work buffer of each chain is
+// chain_stride elements after the one of the previous chain. Each block
+// reduces into the work buffer of its chain, and the last block of the
+// segment then combines the results of the other chains in chain order, so
+// the result does not depend on the timing of the chains.
+template <
+    bool X_BLOCK,
+    bool Y_BLOCK,
+    bool Z_BLOCK,
+    int64_t vec_size,
+    typename T,
+    typename Func>
+__device__ void chainedSerialReductionStep(
+    T* out,
+    T* in,
+    T init,
+    volatile T* work,
+    nvfuser_index_t chain_stride,
+    int64_t num_chains,
+    Func reduction_op,
+    bool read_pred,
+    bool write_pred) {
+  grid_sync::ChainPosition pos =
+      grid_sync::chainPosition<X_BLOCK, Y_BLOCK, Z_BLOCK>(num_chains);
+  serialReductionStep<vec_size>(
+      out,
+      in,
+      init,
+      work + pos.chain * chain_stride,
+      reduction_op,
+      pos.block_idx_in_chain == 0,
+      pos.last_block,
+      read_pred,
+      write_pred);
+  if (!pos.last_block || !write_pred) {
+    return;
+  }
+  for (int64_t chain = 0; chain < pos.chain; ++chain) {
+    T work_reg[vec_size];
+    loadGlobalToLocal<T, vec_size, true, CacheOp::Global>(
+        work_reg, work + chain * chain_stride);
+#pragma unroll
+    for (int i = 0; i < vec_size; ++i) {
+      reduction_op(out[i], work_reg[i]);
+    }
+  }
+}
+
+// Adds the partial result "in" of a block to "out" in global memory for an
+// atomic grid reduction. "out" is zeroed before the kernel is launched, and
+// the blocks add to it in no particular order, so the result is not
+// deterministic. Nothing is added if either predicate is false. On Hopper and
+// newer, vectors of floats are added with vectorized red instructions.
+template <int64_t vec_size, typename T>
+__device__ void atomicReductionStep(
+    T* out,
+    T* in,
+    bool read_pred,
+    bool write_pred) {
+  if (!read_pred || !write_pred) {
+    return;
+  }
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 900))
+  if constexpr (std::is_same_v<T, float> && vec_size % 4 == 0) {
+#pragma unroll
+    for (int64_t i = 0; i < vec_size; i += 4) {
+      asm volatile(
+          "red.global.add.v4.f32 [%0], {%1, %2, %3, %4};\n" ::"l"(out + i),
+          "f"(in[i]),
+          "f"(in[i + 1]),
+          "f"(in[i + 2]),
+          "f"(in[i + 3])
+          : "memory");
+    }
+    return;
+  } else if constexpr (std::is_same_v<T, float> && vec_size == 2) {
+    asm volatile(
+        "red.global.add.v2.f32 [%0], {%1, %2};\n" ::"l"(out),
+        "f"(in[0]),
+        "f"(in[1])
+        : "memory");
+    return;
+  }
+#endif
+#pragma unroll
+  for (int64_t i = 0; i < vec_size; ++i) {
+    atomicAdd(out + i, in[i]);
+  }
+}
+
+// Raises *out to value with integer atomics on the bits of the float. The
+// bits of non-negative floats order like signed integers and those of negative
+// floats order inversely to unsigned integers. NaNs are stored as a NaN whose
+// bits exceed those of any other non-negative float, so they propagate like
+// in fmax.
+__device__ void atomicMaxFloat(float* out, float value) {
+  if (value != value) {
+    atomicMax(reinterpret_cast<int*>(out), 0x7fffffff);
+  } else if (!signbit(value)) {
+    atomicMax(reinterpret_cast<int*>(out), __float_as_int(value));
+  } else {
+    atomicMin(
+        reinterpret_cast<unsigned int*>(out),
+        static_cast<unsigned int>(__float_as_int(value)));
+  }
+}
+
+__device__ void atomicMaxFloat(double* out, double value) {
+  if (value != value) {
+    atomicMax(reinterpret_cast<long long*>(out), 0x7fffffffffffffffLL);
+  } else if (!signbit(value)) {
+    atomicMax(reinterpret_cast<long long*>(out), __double_as_longlong(value));
+  } else {
+    atomicMin(
+        reinterpret_cast<unsigned long long*>(out),
+        static_cast<unsigned long long>(__double_as_longlong(value)));
+  }
+}
+
+// Raises "out" in global memory to the partial maxima "in" of a block for an
+// atomic grid reduction. "out" is set to the lowest value before the kernel is
+// launched. Unlike sums, the result doesn't depend on the order of the
+// blocks. Nothing is written if either predicate is false.
+template <int64_t vec_size, typename T>
+__device__ void atomicMaxReductionStep(
+    T* out,
+    T* in,
+    bool read_pred,
+    bool write_pred) {
+  if (!read_pred || !write_pred) {
+    return;
+  }
+#pragma unroll
+  for (int64_t i = 0; i < vec_size; ++i) {
+    atomicMaxFloat(out + i, in[i]);
+  }
+}
+
 // check required transactions based on data type and vectorization factor
 // ensure each thread in each transaction has no more than 16 bytes which
 // is the maximum allowed vectorization width.
@@ -1064,4 +1203,94 @@ __device__ void iterGroupedGridReduce(
         block_dim);
   }
 }
+
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 900))
+// Grid reduction within a thread block cluster. Each reduction segment, i.e.,
+// the blocks along the X/Y/Z_BLOCK dimensions, must be exactly one cluster.
+// The partial results of the blocks are exchanged through distributed shared
+// memory, so unlike gridReduce no global work buffer or sync flags are needed.
+// Like gridReduce, only the last block of each segment gets valid results
+// unless Allreduce is set, in which case all threads of all blocks in the
+// cluster do, which persistent kernels use to hold a row across the cluster.
+template <
+    bool X_BLOCK,
+    bool Y_BLOCK,
+    bool Z_BLOCK,
+    bool X_THREAD,
+    bool Y_THREAD,
+    bool Z_THREAD,
+    bool Aligned,
+    bool Allreduce,
+    typename T,
+    typename Func,
+    typename BlockDimT>
+__device__ void clusterReduce(
+    T& out,
+    const T& inp_val,
+    Func reduction_op,
+    T* shared_buf,
+    bool read_pred,
+    bool write_pred,
+    T init_val,
+    BlockDimT block_dim) {
+  T block_reduction_val = init_val;
+
+  // Do block reduction when required. blockReduce ends with a block sync, so
+  // shared_buf can be reused right after.
+  if (X_THREAD || Y_THREAD || Z_THREAD) {
+    blockReduce<X_THREAD, Y_THREAD, Z_THREAD, Aligned>(
+        block_reduction_val,
+        inp_val,
+        reduction_op,
+        shared_buf,
+        read_pred,
+        true,
+        init_val,
+        block_dim);
+  } else if (read_pred) {
+    block_reduction_val = inp_val;
+  }
+
+  const bool has_block_result = (!X_THREAD || threadIdx.x == 0) &&
+      (!Y_THREAD || threadIdx.y == 0) && (!Z_THREAD || threadIdx.z == 0);
+  const auto thread_offset =
+      index_utils::maskedOffset<!X_THREAD, !Y_THREAD, !Z_THREAD>(
+          threadIdx, block_dim);
+
+  if (has_block_result) {
+    shared_buf[thread_offset] = block_reduction_val;
+  }
+
+  // Make the block results visible to the cluster
+  if (Aligned) {
+    clusterSync();
+  } else {
+    clusterSyncUnaligned();
+  }
+
+  if (Allreduce ||
+      (has_block_result &&
+       index_utils::maskedIsLast<X_BLOCK, Y_BLOCK, Z_BLOCK>(
+           blockIdx, gridDim))) {
+    const dim3 cluster_shape = clusterShape();
+    const uint32_t cluster_size =
+        cluster_shape.x * cluster_shape.y * cluster_shape.z;
+    T result = init_val;
+    for (uint32_t rank = 0; rank < cluster_size; ++rank) {
+      reduction_op(result, *mapSharedRank(shared_buf + thread_offset, rank));
+    }
+    if (write_pred) {
+      out = result;
+    }
+  }
+
+  // Keep the shared memory of all blocks alive and unmodified until it has
+  // been read by the cluster
+  if (Aligned) {
+    clusterSync();
+  } else {
+    clusterSyncUnaligned();
+  }
+}
+#endif // Arch 90
 } // namespace reduction
@@ -7,6 +7,24 @@
 // clang-format on
 namespace grid_sync {
 
+// Programmatic dependent launch (sm_90+). A kernel launched with the
+// programmatic stream serialization attribute may start before the preceding
+// kernel of the stream completes. waitForPrerequisiteGrids blocks until that
+// kernel has completed and its memory operations are visible, and
+// launchDependentGrids lets the following kernel start once all blocks of this
+// one have called it or exited. Both are no-ops for other launches.
+__device__ void waitForPrerequisiteGrids() {
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 900))
+  asm volatile("griddepcontrol.wait;" : : : "memory");
+#endif
+}
+
+__device__ void launchDependentGrids() {
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 900))
+  asm volatile("griddepcontrol.launch_dependents;" : : : "memory");
+#endif
+}
+
 // Get the first bit in a 64 bit integer
 #define FIRST_UINT64_BIT ((uint64_t)1 << (sizeof(uint64_t) * 8 - 1))
 
@@ -268,4 +286,71 @@ __device__ void blockSerializeRelease(int64_t* semaphore) {
   semaphoreRelease(semaphore, last_block ? 0 : block_idx_in_segment + 1);
 }
 
+// Position of this block in a segment indicated by the [XYZ]_BLOCK template
+// arguments whose blocks are split into num_chains chains of consecutive
+// blocks. Only the last chain may be shorter than the others.
+struct ChainPosition {
+  int64_t chain;
+  int64_t block_idx_in_chain;
+  int64_t chain_size;
+  bool last_block;
+};
+
+template <bool X_BLOCK, bool Y_BLOCK, bool Z_BLOCK>
+__device__ ChainPosition chainPosition(int64_t num_chains) {
+  int64_t segment_size =
+      index_utils::maskedSize<X_BLOCK, Y_BLOCK, Z_BLOCK>(gridDim);
+  int64_t block_idx_in_segment =
+      index_utils::maskedOffset<X_BLOCK, Y_BLOCK, Z_BLOCK>(blockIdx, gridDim);
+  int64_t chain_size = ceilDiv(segment_size, num_chains);
+  return {
+      block_idx_in_segment / chain_size,
+      block_idx_in_segment % chain_size,
+      chain_size,
+      block_idx_in_segment == segment_size - 1};
+}
+
+// Chained version of blockSerializeWait. Blocks are only serialized within
+// their chain, and each chain has its own semaphore in semaphores. The last
+// block of the segment additionally waits for all the other chains to
+// complete. Since blocks only wait for blocks with lower indices, this can't
+// deadlock where blockSerializeWait doesn't.
+template <bool X_BLOCK, bool Y_BLOCK, bool Z_BLOCK>
+__device__ void blockSerializeWaitChained(
+    int64_t* semaphores,
+    int64_t num_chains) {
+  ChainPosition pos = chainPosition<X_BLOCK, Y_BLOCK, Z_BLOCK>(num_chains);
+
+  if (pos.block_idx_in_chain > 0) {
+    semaphoreWait(semaphores + pos.chain, pos.block_idx_in_chain);
+  }
+  if (pos.last_block) {
+    for (int64_t chain = 0; chain < pos.chain; ++chain) {
+      semaphoreWait(semaphores + chain, pos.chain_size);
+    }
+  }
+  __syncthreads();
+}
+
+// Chained version of blockSerializeRelease. The last block of the segment
+// cleans up the semaphores of all chains.
+template <bool X_BLOCK, bool Y_BLOCK, bool Z_BLOCK>
+__device__ void blockSerializeReleaseChained(
+    int64_t* semaphores,
+    int64_t num_chains) {
+  ChainPosition pos = chainPosition<X_BLOCK, Y_BLOCK, Z_BLOCK>(num_chains);
+
+  // See blockSerializeRelease for why the fence is needed
+  __threadfence();
+  __syncthreads();
+
+  if (pos.last_block) {
+    for (int64_t chain = 0; chain <= pos.chain; ++chain) {
+      semaphoreRelease(semaphores + chain, 0);
+    }
+  } else {
+    semaphoreRelease(semaphores + pos.chain, pos.block_idx_in_chain + 1);
+  }
+}
+
 } // namespace grid_sync
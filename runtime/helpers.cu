@@ -222,6 +222,67 @@ __device__ float silu(float x) {
   return x * sigmoid(x);
 }
 
+// Approximate float functions emitted in place of the exact ones with
+// EnableOption::FastMath. Their error bounds are those of the CUDA intrinsics
+// and PTX instructions they map to, see ValidationConstants.
+__device__ float fast_exp(float x) {
+  return __expf(x);
+}
+
+__device__ float fast_exp2(float x) {
+  float y;
+  asm("ex2.approx.ftz.f32 %0, %1;" : "=f"(y) : "f"(x));
+  return y;
+}
+
+__device__ float fast_log(float x) {
+  return __logf(x);
+}
+
+__device__ float fast_log2(float x) {
+  return __log2f(x);
+}
+
+__device__ float fast_log10(float x) {
+  return __log10f(x);
+}
+
+__device__ float fast_sin(float x) {
+  return __sinf(x);
+}
+
+__device__ float fast_cos(float x) {
+  return __cosf(x);
+}
+
+__device__ float fast_tanh(float x) {
+#if __CUDA_ARCH__ >= 750
+  float y;
+  asm("tanh.approx.f32 %0, %1;" : "=f"(y) : "f"(x));
+  return y;
+#else
+  return tanhf(x);
+#endif
+}
+
+__device__ float fast_reciprocal(float x) {
+  float y;
+  asm("rcp.approx.ftz.f32 %0, %1;" : "=f"(y) : "f"(x));
+  return y;
+}
+
+__device__ float fast_sigmoid(float x) {
+#if __CUDA_ARCH__ >= 750
+  return 0.5f * fast_tanh(0.5f * x) + 0.5f;
+#else
+  return fast_reciprocal(1.0f + __expf(-x));
+#endif
+}
+
+__device__ float fast_silu(float x) {
+  return x * fast_sigmoid(x);
+}
+
 __device__ double threshold(double x, double t, double v) {
   return x <= t ? v : x;
 }
@@ -496,6 +557,29 @@ __device__ inline int64_t readCycleCounter() {
   return clock64();
 }
 
+#ifdef NVFUSER_PROFILE_KERNEL
+// Add the cycles elapsed since start to the profile of a stage of a
+// warp-specialized kernel. Each warp group, i.e., 128 consecutive threads,
+// has a pair of cycles and count in buffer, starting at entry, which the first
+// thread of the warp group accumulates over all thread blocks.
+__device__ inline void profileStage(
+    int64_t* buffer,
+    int64_t entry,
+    int64_t max_warp_groups,
+    int64_t start) {
+  const int64_t cycles = readCycleCounter() - start;
+  const int64_t tid = threadIdx.x +
+      (int64_t)blockDim.x * (threadIdx.y + (int64_t)blockDim.y * threadIdx.z);
+  if (tid % 128 != 0) {
+    return;
+  }
+  const int64_t warp_group = min(tid / 128, max_warp_groups - 1);
+  int64_t* profile = buffer + (entry + warp_group) * 2;
+  atomicAdd((unsigned long long*)profile, (unsigned long long)cycles);
+  atomicAdd((unsigned long long*)(profile + 1), 1ULL);
+}
+#endif // NVFUSER_PROFILE_KERNEL
+
 __device__ float print_impl(const char* name, float value) {
   printf(
       "%s = %f @ threadIdx=(%d,%d,%d), blockIdx=(%d,%d,%d)\n",
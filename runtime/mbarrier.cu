@@ -55,6 +55,34 @@ __device__ inline void arrive(uint32_t smem_barrier_ptr, uint32_t cta_id) {
       :
       : "r"(smem_barrier_ptr), "r"(cta_id));
 }
+
+// The mbarriers releasing tiles multicast across shared_dims of the cluster,
+// see multicastLeaderRank in cluster.cu. Their leaders only reload a tile once
+// the consumers of all the blocks sharing it have released it, so each thread
+// arrives at the mbarrier of its block and at those of its leaders, and the
+// mbarriers expect the arrivals of all the blocks they are the leader of.
+template <uint32_t... shared_dims>
+__device__ inline void initMulticast(
+    uint32_t smem_barrier_ptr,
+    uint32_t thread_count) {
+  init(
+      smem_barrier_ptr,
+      thread_count * multicastArrivingBlocks<shared_dims...>());
+}
+
+template <uint32_t... shared_dims>
+__device__ inline void arriveMulticast(uint32_t smem_barrier_ptr) {
+  constexpr uint32_t all_shared_dims[] = {shared_dims...};
+  arrive(smem_barrier_ptr);
+  uint32_t arrived = 1u << blockRankInCluster();
+  for (uint32_t dims : all_shared_dims) {
+    uint32_t leader = multicastLeaderRank(dims);
+    if ((arrived & (1u << leader)) == 0) {
+      arrive(smem_barrier_ptr, leader);
+      arrived |= 1u << leader;
+    }
+  }
+}
 #endif
 
 __device__ inline void wait(uint32_t smem_barrier_ptr, uint64_t state) {
@@ -230,7 +230,7 @@ __device__ inline void cpAsyncBulkTensorTileG2SMulticast(
   uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(src.descriptor);
   asm volatile(
       "cp.async.bulk.tensor.3d.shared::cluster.global.mbarrier::complete_tx::"
-      "bytes.multicast_cluster"
+      "bytes.multicast::cluster"
       " [%0], [%1, {%3, %4, %5}], [%2], %6;"
       :
       : "r"(smem_addr),
@@ -269,7 +269,7 @@ __device__ inline void cpAsyncBulkTensorTileG2SMulticast(
   uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(src.descriptor);
   asm volatile(
       "cp.async.bulk.tensor.4d.shared::cluster.global.mbarrier::complete_tx::"
-      "bytes.multicast_cluster"
+      "bytes.multicast::cluster"
       " [%0], [%1, {%3, %4, %5, %6}], [%2], %7;"
       :
       : "r"(smem_addr),
@@ -310,7 +310,7 @@ __device__ inline void cpAsyncBulkTensorTileG2SMulticast(
   uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(src.descriptor);
   asm volatile(
       "cp.async.bulk.tensor.5d.shared::cluster.global.mbarrier::complete_tx::"
-      "bytes.multicast_cluster"
+      "bytes.multicast::cluster"
       " [%0], [%1, {%3, %4, %5, %6, %7}], [%2], %8;"
       :
       : "r"(smem_addr),
@@ -325,6 +325,21 @@ __device__ inline void cpAsyncBulkTensorTileG2SMulticast(
       : "memory");
 }
 
+// Multicasts the tile of src to the blocks of the cluster sharing it across
+// shared_dims, see multicastLeaderRank. Only the leader of these blocks issues
+// the load. smem_addr and the mbarrier of src are offsets in the shared memory
+// of each of these blocks, whose mbarriers each receive the complete-tx of the
+// whole tile.
+template <uint32_t shared_dims, int dim>
+__device__ inline void cpAsyncBulkTensorTileG2SMulticast(
+    const CpAsyncBulkTensorTileG2SIndex<dim>& src,
+    uint32_t smem_addr) {
+  if (isMulticastLeader(shared_dims)) {
+    cpAsyncBulkTensorTileG2SMulticast(
+        src, smem_addr, multicastMask(shared_dims));
+  }
+}
+
 // TMA Stores:
 
 template <int dim>
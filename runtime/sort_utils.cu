@@ -0,0 +1,87 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+
+// Utilities shared by argsort.cu and topk.cu, which must be included after
+// this file
+
+namespace nvf {
+namespace sort_utils {
+
+// Block state constants following nvFuser conventions from fused_reduction.cu
+// Sort Domain - TEMPLATE STATE 0
+//   - Participating in the sort or topk selection, has values coming in,
+//   sorted or selected values coming out
+// Iteration Domain - TEMPLATE STATE 1
+//   - Not participating in the sort or topk selection, has values across the
+//   dimension after sorting
+constexpr __device__ bool isSort(int STATE) {
+  return STATE == 0;
+}
+
+constexpr __device__ bool isIter(int STATE) {
+  return STATE == 1;
+}
+
+// Type utils for interoperability between our own half types and the
+// CUDA standard types
+template <typename T>
+struct CudaType {
+  using type = T;
+
+  __device__ inline static T get(const T& t) {
+    return t;
+  }
+};
+
+template <typename T>
+struct NvFuserType {
+  using type = T;
+
+  __device__ inline static T get(const T& t) {
+    return t;
+  }
+};
+
+#ifdef __NVFUSER_HAS_HALF__
+template <>
+struct CudaType<__half> {
+  using type = __nv_half;
+
+  __device__ inline static type get(const __half& t) {
+    return __ushort_as_half(__NVFUSER_HALF_TO_CUS(t));
+  }
+};
+template <>
+struct NvFuserType<__half> {
+  __device__ inline static __half get(
+      const typename CudaType<__half>::type& t) {
+    return *(reinterpret_cast<const __half*>(&t));
+  }
+};
+#endif // __NVFUSER_HAS_HALF__
+
+#ifdef __NVFUSER_HAS_BFLOAT__
+template <>
+struct CudaType<__bfloat> {
+  using type = __nv_bfloat16;
+
+  __device__ inline static type get(const __bfloat& t) {
+    return __ushort_as_bfloat16(__NVFUSER_BFLOAT_TO_CUS(t));
+  }
+};
+template <>
+struct NvFuserType<__bfloat> {
+  __device__ inline static __bfloat get(
+      const typename CudaType<__bfloat>::type& t) {
+    return *(reinterpret_cast<const __bfloat*>(&t));
+  }
+};
+#endif // __NVFUSER_HAS_BFLOAT__
+
+} // namespace sort_utils
+} // namespace nvf
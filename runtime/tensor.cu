@@ -16,6 +16,19 @@ struct Tensor {
   Array<nvfuser_index_t, AllocDims, 1> alloc_stride;
 };
 
+// Specialization for tensors whose strides the kernel doesn't read, e.g.,
+// contiguous tensors indexed with their extents. Leaving out the strides
+// shrinks the parameters of the kernel.
+template <typename T, int Dims>
+struct Tensor<T, Dims, 0> {
+  __device__ T& operator[](nvfuser_index_t ind) {
+    return data[ind];
+  };
+
+  T* data;
+  Array<nvfuser_index_t, Dims, 1> logical_size;
+};
+
 // Specialization for 0-dim case as it does not need size and stride arrays.
 // They will be an error as well since zero-length arrays are not allowed.
 template <typename T>
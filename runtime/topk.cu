@@ -11,77 +11,10 @@
 namespace nvf {
 namespace topk {
 
-// Block state constants following nvFuser conventions from fused_reduction.cu
-// Sort Domain - TEMPLATE STATE 0
-//   - Participating in the topk selection, has values coming in, selected
-//   values coming out
-// Iteration Domain - TEMPLATE STATE 1
-//   - Not participating in the topk selection, has values across the dimension
-//   after selection
-constexpr __device__ bool isSort(int STATE) {
-  return STATE == 0;
-}
-
-constexpr __device__ bool isIter(int STATE) {
-  return STATE == 1;
-}
-
-// TODO: We have exactly the same code in argsort.cu, we should refactor it.
-// Type utils for interoperability between our own half types and the
-// CUDA standard types (identical to argsort implementation)
-template <typename T>
-struct CudaType {
-  using type = T;
-
-  __device__ inline static T get(const T& t) {
-    return t;
-  }
-};
-
-template <typename T>
-struct NvFuserType {
-  using type = T;
-
-  __device__ inline static T get(const T& t) {
-    return t;
-  }
-};
-
-#ifdef __NVFUSER_HAS_HALF__
-template <>
-struct CudaType<__half> {
-  using type = __nv_half;
-
-  __device__ inline static type get(const __half& t) {
-    return __ushort_as_half(__NVFUSER_HALF_TO_CUS(t));
-  }
-};
-template <>
-struct NvFuserType<__half> {
-  __device__ inline static __half get(
-      const typename CudaType<__half>::type& t) {
-    return *(reinterpret_cast<const __half*>(&t));
-  }
-};
-#endif // __NVFUSER_HAS_HALF__
-
-#ifdef __NVFUSER_HAS_BFLOAT__
-template <>
-struct CudaType<__bfloat> {
-  using type = __nv_bfloat16;
-
-  __device__ inline static type get(const __bfloat& t) {
-    return __ushort_as_bfloat16(__NVFUSER_BFLOAT_TO_CUS(t));
-  }
-};
-template <>
-struct NvFuserType<__bfloat> {
-  __device__ inline static __bfloat get(
-      const typename CudaType<__bfloat>::type& t) {
-    return *(reinterpret_cast<const __bfloat*>(&t));
-  }
-};
-#endif // __NVFUSER_HAS_BFLOAT__
+using sort_utils::CudaType;
+using sort_utils::isIter;
+using sort_utils::isSort;
+using sort_utils::NvFuserType;
 
 // Block-parallel topk using CUB BlockRadixSort
 // Following nvFuser dimensional template parameter pattern like
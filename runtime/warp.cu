@@ -21,6 +21,79 @@ __device__ __forceinline__ std::complex<T> shfl_xor(
   return std::complex<T>(real, imag);
 }
 
+// Reduction ops of 32-bit integers that codegen passes to warp reductions
+// instead of lambdas, so that reduceWithinWarp can do them with a single
+// redux.sync on sm_80 and newer. They reduce like the lambdas otherwise,
+// e.g., across the warps of a block.
+struct ReduxAdd {
+  template <typename T>
+  __device__ __forceinline__ void operator()(T& a, T b) const {
+    a = a + b;
+  }
+};
+struct ReduxMax {
+  template <typename T>
+  __device__ __forceinline__ void operator()(T& a, T b) const {
+    a = max(a, b);
+  }
+};
+struct ReduxMin {
+  template <typename T>
+  __device__ __forceinline__ void operator()(T& a, T b) const {
+    a = min(a, b);
+  }
+};
+struct ReduxAnd {
+  template <typename T>
+  __device__ __forceinline__ void operator()(T& a, T b) const {
+    a = a & b;
+  }
+};
+struct ReduxOr {
+  template <typename T>
+  __device__ __forceinline__ void operator()(T& a, T b) const {
+    a = a | b;
+  }
+};
+struct ReduxXor {
+  template <typename T>
+  __device__ __forceinline__ void operator()(T& a, T b) const {
+    a = a ^ b;
+  }
+};
+
+// Reduces val across the lanes of a full warp, leaving the result in all
+// lanes
+template <typename T, typename Func>
+__device__ __forceinline__ void reduceWithinWarp(T& val, Func reduction_op) {
+  for (int i = 16; i >= 1; i /= 2) {
+    reduction_op(val, shfl_xor(val, i, 32));
+  }
+}
+
+#if (defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800))
+#define DEFINE_REDUX_WITHIN_WARP(FUNC, TYPE, PTX_OP)                \
+  __device__ __forceinline__ void reduceWithinWarp(TYPE& val, FUNC) { \
+    asm volatile("redux.sync." PTX_OP " %0, %0, 0xffffffff;"          \
+                 : "+r"(val));                                        \
+  }
+
+DEFINE_REDUX_WITHIN_WARP(ReduxAdd, int, "add.s32")
+DEFINE_REDUX_WITHIN_WARP(ReduxAdd, uint32_t, "add.u32")
+DEFINE_REDUX_WITHIN_WARP(ReduxMax, int, "max.s32")
+DEFINE_REDUX_WITHIN_WARP(ReduxMax, uint32_t, "max.u32")
+DEFINE_REDUX_WITHIN_WARP(ReduxMin, int, "min.s32")
+DEFINE_REDUX_WITHIN_WARP(ReduxMin, uint32_t, "min.u32")
+DEFINE_REDUX_WITHIN_WARP(ReduxAnd, int, "and.b32")
+DEFINE_REDUX_WITHIN_WARP(ReduxAnd, uint32_t, "and.b32")
+DEFINE_REDUX_WITHIN_WARP(ReduxOr, int, "or.b32")
+DEFINE_REDUX_WITHIN_WARP(ReduxOr, uint32_t, "or.b32")
+DEFINE_REDUX_WITHIN_WARP(ReduxXor, int, "xor.b32")
+DEFINE_REDUX_WITHIN_WARP(ReduxXor, uint32_t, "xor.b32")
+
+#undef DEFINE_REDUX_WITHIN_WARP
+#endif // Arch 80
+
 template <
     bool SINGLE_WARP,
     bool Aligned,
@@ -49,9 +122,7 @@ __device__ void warpReduceTIDX(
   }
 
   // Reduce within each warp
-  for (int i = 16; i >= 1; i /= 2) {
-    reduction_op(reduce_val, shfl_xor(reduce_val, i, WARP_SIZE));
-  }
+  reduceWithinWarp(reduce_val, reduction_op);
 
   // Reduce across warp if needed
   // Load value to shared mem
@@ -81,9 +152,7 @@ __device__ void warpReduceTIDX(
                                            : init_val;
 
       // Reduce within warp 0
-      for (int i = 16; i >= 1; i /= 2) {
-        reduction_op(reduce_val, shfl_xor(reduce_val, i, 32));
-      }
+      reduceWithinWarp(reduce_val, reduction_op);
     }
 
     if (is_warp_head) {
@@ -127,9 +196,7 @@ __device__ void warpReduceTIDXY(
   }
 
   // Reduce within each warp
-  for (int i = 16; i >= 1; i /= 2) {
-    reduction_op(reduce_val, shfl_xor(reduce_val, i, WARP_SIZE));
-  }
+  reduceWithinWarp(reduce_val, reduction_op);
 
   // Reduce across warp if needed
   // Load value to shared mem
@@ -146,9 +213,7 @@ __device__ void warpReduceTIDXY(
     if (warp_idx == 0) {
       reduce_val = lane_idx < num_of_warps ? shared_mem[lane_idx] : init_val;
       // Reduce within warp 0
-      for (int i = 16; i >= 1; i /= 2) {
-        reduction_op(reduce_val, shfl_xor(reduce_val, i, 32));
-      }
+      reduceWithinWarp(reduce_val, reduction_op);
     }
 
     if (lane_idx == 0) {
@@ -162,6 +227,101 @@ __device__ void warpReduceTIDXY(
   }
 }
 
+// Grouped version of warpReduceTIDX. Reduces N independent values with
+// one shuffle tree and one round trip through shared memory, which must
+// hold N values per warp. Value i is reduced with the i-th of
+// reduction_ops, see reduceEachValue in block_reduction.cu.
+template <
+    bool SINGLE_WARP,
+    bool Aligned,
+    int N,
+    typename T,
+    typename BlockDimT,
+    typename... Funcs>
+__device__ void groupedWarpReduceTIDX(
+    T* const (&out)[N],
+    const T (&inp_val)[N],
+    T* shared_mem,
+    bool read_write_pred,
+    const T (&init_val)[N],
+    // block_dim is basically just blockDim (wrapped as DefaultBlockDim) if
+    // there is no warp specialization in the kernel. If there is warp
+    // specialization, block_dim is the the dimension of the compute warps.
+    BlockDimT block_dim,
+    Funcs... reduction_ops) {
+  static_assert(sizeof...(Funcs) == N, "Expected one reduction op per value");
+  constexpr int WARP_SIZE = 32;
+
+  // Assume input padded to multiples of a warp
+  T reduce_val[N];
+#pragma unroll
+  for (int i = 0; i < N; ++i) {
+    reduce_val[i] = read_write_pred ? inp_val[i] : init_val[i];
+  }
+
+  // Reduce within each warp. The shuffles of all values are issued before
+  // they are combined so that they can be in flight together.
+  auto reduce_within_warp = [&]() {
+    for (int lane_mask = 16; lane_mask >= 1; lane_mask /= 2) {
+      T peer_val[N];
+#pragma unroll
+      for (int i = 0; i < N; ++i) {
+        peer_val[i] = shfl_xor(reduce_val[i], lane_mask, WARP_SIZE);
+      }
+      reduceEachValue(reduce_val, 1, peer_val, 1, reduction_ops...);
+    }
+  };
+  reduce_within_warp();
+
+  // Reduce across warp if needed
+  if (!SINGLE_WARP) {
+    unsigned int warp_idx = threadIdx.x / WARP_SIZE;
+    unsigned int lane_idx = threadIdx.x % WARP_SIZE;
+    unsigned int reduce_group_id = threadIdx.z * block_dim.y + threadIdx.y;
+    bool is_warp_head = lane_idx == 0;
+    unsigned int reduction_size = block_dim.x;
+    unsigned int num_of_warps = reduction_size / WARP_SIZE;
+    // [reduce_group, warp, N]
+    unsigned int smem_offset = reduce_group_id * num_of_warps * N;
+
+    block_sync::sync<Aligned>(block_dim);
+
+    if (is_warp_head) {
+#pragma unroll
+      for (int i = 0; i < N; ++i) {
+        shared_mem[smem_offset + warp_idx * N + i] = reduce_val[i];
+      }
+    }
+
+    block_sync::sync<Aligned>(block_dim);
+
+    if (warp_idx == 0) {
+      // This assumes num_of_warps will be < 32, meaning < 1024 threads.
+      //  Should be true for long enough.
+      assert(num_of_warps <= 32);
+
+#pragma unroll
+      for (int i = 0; i < N; ++i) {
+        reduce_val[i] = lane_idx < num_of_warps
+            ? shared_mem[smem_offset + lane_idx * N + i]
+            : init_val[i];
+      }
+
+      // Reduce within warp 0
+      reduce_within_warp();
+    }
+
+    if (is_warp_head) {
+      reduceEachValueInto(out, reduce_val, 1, reduction_ops...);
+    }
+    // needs sync, otherwise other warps may access shared memory before this
+    // reduction is done.
+    block_sync::sync<Aligned>(block_dim);
+  } else {
+    reduceEachValueInto(out, reduce_val, 1, reduction_ops...);
+  }
+}
+
 // sizeof(T) * K = sizeof(uint64_t)
 // Array structure ensures data is aligned for safe casting to uint64_t
 template <int K, typename T, typename Func>
@@ -106,6 +106,48 @@ __inline__ __device__ void welfordVectorized(
   a_N = ab_N;
 }
 
+// Vectorized version of welfordCombine, where the count of b is the
+// same for all elements. b_N_div_ab_N and a_N_b_N_div_ab_N are
+// b_N / ab_N and a_N * b_N / ab_N, computed once for all elements.
+template <typename T, bool OutputGmem>
+__inline__ __device__ void welfordVectorizedCombine(
+    T& a_avg,
+    T& a_M2,
+    nvfuser_index_t& a_N,
+    const T b_avg,
+    const T b_M2,
+    const T b_N_div_ab_N,
+    const T a_N_b_N_div_ab_N,
+    const nvfuser_index_t ab_N,
+    const bool pred) {
+  if (OutputGmem && !pred) {
+    return;
+  }
+  T predicated_b_avg = pred ? b_avg : a_avg;
+  T predicated_b_M2 = pred ? b_M2 : (T)0;
+  T delta = predicated_b_avg - a_avg;
+  a_avg += delta * b_N_div_ab_N;
+  a_M2 += predicated_b_M2 + delta * delta * a_N_b_N_div_ab_N;
+  a_N = ab_N;
+}
+
+// Non predicated version
+template <typename T>
+__inline__ __device__ void welfordVectorizedCombine(
+    T& a_avg,
+    T& a_M2,
+    nvfuser_index_t& a_N,
+    const T b_avg,
+    const T b_M2,
+    const T b_N_div_ab_N,
+    const T a_N_b_N_div_ab_N,
+    const nvfuser_index_t ab_N) {
+  T delta = b_avg - a_avg;
+  a_avg += delta * b_N_div_ab_N;
+  a_M2 += b_M2 + delta * delta * a_N_b_N_div_ab_N;
+  a_N = ab_N;
+}
+
 // [Z,Y,X]_THREADS is the number of participating threads in the z, y, x
 // dimension of the block.
 template <
@@ -369,7 +411,8 @@ template <
     bool Aligned,
     typename T,
     typename TN,
-    typename BlockDimT>
+    typename BlockDimT,
+    int SyncFlagsAllocDims>
 __device__ void gridWelford(
     T& out_avg,
     T& out_M2,
@@ -380,7 +423,7 @@ __device__ void gridWelford(
     volatile T* work_buf_avg,
     volatile T* work_buf_M2,
     volatile TN* work_buf_N,
-    Tensor<int64_t, 1> sync_flags,
+    Tensor<int64_t, 1, SyncFlagsAllocDims> sync_flags,
     T* shared_buf_avg,
     T* shared_buf_M2,
     TN* shared_buf_N,
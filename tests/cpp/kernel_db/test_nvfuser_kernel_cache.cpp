@@ -0,0 +1,92 @@
+// clang-format off
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+ * All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+// clang-format on
+#include <gtest/gtest.h>
+
+#include <kernel_db/kernel_cache.h>
+#include <tests/cpp/utils.h>
+
+#include <chrono>
+#include <iterator>
+
+// RUN CMD: bin/test_jit --gtest_filter="NVFuserTest*KernelCache*"
+namespace nvfuser {
+
+namespace {
+
+fs::path makeTestCacheDir(const std::string& name) {
+  fs::path path = fs::temp_directory_path() / name;
+  if (fs::is_directory(path)) {
+    fs::remove_all(path);
+  }
+  return path;
+}
+
+int64_t countEntries(const fs::path& path) {
+  return std::distance(fs::directory_iterator(path), fs::directory_iterator());
+}
+
+} // namespace
+
+TEST_F(NVFuserTest, KernelCache_WriteQuery) {
+  fs::path path = makeTestCacheDir("nvfuser_kernel_cache_write_query_test");
+  KernelCache cache(path, /*max_bytes=*/1 << 20);
+  ASSERT_TRUE(fs::is_directory(path));
+
+  const std::string key("args=--gpu-architecture=sm_80;src=kernel_0");
+  const std::vector<char> binary = {'c', 'u', 'b', 'i', 'n'};
+
+  std::string kernel_name;
+  std::vector<char> cached_binary;
+  EXPECT_FALSE(cache.query(key, kernel_name, cached_binary));
+
+  ASSERT_TRUE(cache.write(key, "kernel_0", binary));
+  ASSERT_TRUE(cache.query(key, kernel_name, cached_binary));
+  EXPECT_EQ(kernel_name, "kernel_0");
+  EXPECT_EQ(cached_binary, binary);
+
+  // Another cache using the same directory, e.g. in another process, sees
+  // the entry. A different key doesn't.
+  KernelCache other_cache(path, /*max_bytes=*/1 << 20);
+  EXPECT_TRUE(other_cache.query(key, kernel_name, cached_binary));
+  EXPECT_FALSE(other_cache.query(key + "0", kernel_name, cached_binary));
+
+  // Writing the same key again replaces the entry
+  ASSERT_TRUE(other_cache.write(key, "kernel_0", binary));
+  EXPECT_EQ(countEntries(path), 1);
+
+  fs::remove_all(path);
+}
+
+TEST_F(NVFuserTest, KernelCache_Evict) {
+  fs::path path = makeTestCacheDir("nvfuser_kernel_cache_evict_test");
+  const std::vector<char> binary(1000, 'x');
+  // Room for a few entries of about 1 KB each
+  KernelCache cache(path, /*max_bytes=*/3500);
+
+  std::string kernel_name;
+  std::vector<char> cached_binary;
+  for (auto i : arange(3)) {
+    const std::string key = "kernel_" + std::to_string(i);
+    ASSERT_TRUE(cache.write(key, key, binary));
+    // Make sure modification times are ordered
+    fs::last_write_time(
+        cache.entryPath(key),
+        fs::file_time_type::clock::now() - std::chrono::seconds(10 - i));
+  }
+  // Using kernel_0 makes kernel_1 the least recently used entry
+  ASSERT_TRUE(cache.query("kernel_0", kernel_name, cached_binary));
+
+  ASSERT_TRUE(cache.write("kernel_3", "kernel_3", binary));
+  EXPECT_TRUE(cache.query("kernel_0", kernel_name, cached_binary));
+  EXPECT_FALSE(cache.query("kernel_1", kernel_name, cached_binary));
+  EXPECT_TRUE(cache.query("kernel_3", kernel_name, cached_binary));
+
+  fs::remove_all(path);
+}
+
+} // namespace nvfuser
@@ -1608,6 +1608,44 @@ TEST_F(AliasTest, FusionEmpty) {
       UnorderedElementsAre(HeuristicIs(SchedulerType::ExprEval)));
 }
 
+// A reshape between two kernels is evaluated as a view of the tensor written
+// by the first kernel rather than written as a copy by it
+TEST_F(AliasTest, ViewBetweenSegmentsIsNotCopied) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* in = makeContigConcreteTensor({128, 1024});
+  TensorView* t1 = exp(in);
+  TensorView* t2 = reshape(t1, {128, 1024}, {128 * 1024});
+  TensorView* out = sum(t2, {0});
+  fusion->addInput(in);
+  fusion->addOutput(t1);
+  fusion->addOutput(out);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  at::Tensor in_tensor =
+      at::randn({128, 1024}, at::dtype(at::kFloat).device(at::kCUDA));
+  auto out_tensors = executor_cache.runFusionWithInputs({in_tensor});
+  testValidate(
+      executor_cache.fusion(), out_tensors, {in_tensor}, __LINE__, __FILE__);
+
+  // The runtime segments a copy of the fusion, whose vals keep their names
+  auto writes = [](SegmentedGroup* group, TensorView* tv) {
+    return std::ranges::any_of(group->outputs(), [tv](Val* out) {
+      return out->isA<TensorView>() && out->name() == tv->name();
+    });
+  };
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  for (SegmentedGroup* group : runtime->fusionSegments()->groups()) {
+    if (group->schedulerType() == SchedulerType::ExprEval) {
+      continue;
+    }
+    EXPECT_FALSE(writes(group, t1) && writes(group, t2))
+        << "A kernel writes both " << t1->toString() << " and its reshape "
+        << t2->toString();
+  }
+}
+
 TEST_F(AliasTest, IntermediateTensorWithAllocation) {
   auto fusion = std::make_unique<Fusion>();
   FusionGuard fg(fusion.get());
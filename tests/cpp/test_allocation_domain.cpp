@@ -14,6 +14,7 @@
 #include <runtime/executor.h>
 #include <scheduler/all_schedulers.h>
 #include <scheduler/registry.h>
+#include <tensor_metadata.h>
 
 #include <tests/cpp/utils.h>
 #include <tests/cpp/validator.h>
@@ -1527,4 +1528,42 @@ TEST_F(AllocationDomainTest, InputAllocationIsSplit_Symbolic) {
       executor_cache.fusion(), out_tensors, {in_tensor}, __LINE__, __FILE__);
 }
 
+TEST_F(AllocationDomainTest, CachedAllocationDomainProgram) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  // [i0, i1] allocated as [i1, i0/4, 4]
+  tv0->split(0, 4);
+  tv0->setAllocationDomain({tv0->axis(2), tv0->axis(0), tv0->axis(1)}, true);
+
+  ExpressionEvaluator ee;
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::empty_strided({8, 3}, {1, 8}, options);
+  auto [sizes, strides] =
+      inferAndValidateAllocationSizesAndStrides(t0, tv0, ee);
+  EXPECT_THAT(sizes, ElementsAre(3, 2, 4));
+  EXPECT_THAT(strides, ElementsAre(8, 4, 1));
+
+  // Another tensor reruns the same program
+  auto program = tv0->allocationDomainProgram();
+  ASSERT_NE(program, nullptr);
+  at::Tensor t1 = at::empty_strided({16, 5}, {1, 16}, options);
+  std::tie(sizes, strides) =
+      inferAndValidateAllocationSizesAndStrides(t1, tv0, ee);
+  EXPECT_THAT(sizes, ElementsAre(5, 4, 4));
+  EXPECT_THAT(strides, ElementsAre(16, 4, 1));
+  EXPECT_EQ(tv0->allocationDomainProgram(), program);
+
+  // Changing the allocation domain recompiles it
+  tv0->setAllocationDomain(tv0->getLogicalDomain(), true);
+  at::Tensor t2 = at::empty({4, 6}, options);
+  std::tie(sizes, strides) =
+      inferAndValidateAllocationSizesAndStrides(t2, tv0, ee);
+  EXPECT_THAT(sizes, ElementsAre(4, 6));
+  EXPECT_THAT(strides, ElementsAre(6, 1));
+  EXPECT_NE(tv0->allocationDomainProgram(), program);
+}
+
 } // namespace nvfuser
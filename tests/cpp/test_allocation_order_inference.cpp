@@ -256,6 +256,37 @@ TEST_F(AllocationOrderInferenceTest, TernaryOpPropagation) {
   EXPECT_THAT(getAllocationOrder(tv4), ElementsAre(0, 2, 3, 1));
 }
 
+TEST_F(AllocationOrderInferenceTest, CostDrivenSelection) {
+  auto fusion_ptr = std::make_unique<Fusion>();
+  Fusion& fusion = *fusion_ptr.get();
+  FusionGuard fg(&fusion);
+
+  // tv0 and tv1 are transposed in memory and tv2 isn't. The propagation gives
+  // up on the ambiguous references, while the cost-driven selection follows
+  // the majority, so that only tv2 is read with a stride.
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = makeContigTensor(2);
+  fusion.addInput(tv1);
+  auto tv2 = makeContigTensor(2);
+  fusion.addInput(tv2);
+  auto tv3 = add(add(tv0, tv1), tv2);
+  fusion.addOutput(tv3);
+
+  tv0->setAllocationDomain({tv0->axis(1), tv0->axis(0)}, true);
+  tv1->setAllocationDomain({tv1->axis(1), tv1->axis(0)}, true);
+
+  preseg_passes::OptimizationPass<preseg_passes::AllocationDomainPass>::runPass(
+      &fusion);
+  EXPECT_FALSE(tv3->hasAllocation());
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::CostModel);
+  preseg_passes::OptimizationPass<preseg_passes::AllocationDomainPass>::runPass(
+      &fusion);
+  EXPECT_THAT(getAllocationOrder(tv3), ElementsAre(1, 0));
+}
+
 TEST_F(AllocationOrderInferenceTest, ReductionOpPropagation) {
   auto fusion_ptr = std::make_unique<Fusion>();
   Fusion& fusion = *fusion_ptr.get();
@@ -16,6 +16,8 @@
 #include <fusion.h>
 #include <ops/all_ops.h>
 
+#include <utility>
+
 namespace nvfuser {
 
 class ExprEvalTest : public NVFuserTest {};
@@ -117,6 +119,39 @@ TEST_F(ExprEvalTest, Bindings) {
   checkIntValue(evaluator, d, -2);
 }
 
+TEST_F(ExprEvalTest, EvaluateInt64) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  ExpressionEvaluator evaluator;
+
+  auto* a = IrBuilder::create<Val>(DataType::Int);
+  auto* b = IrBuilder::create<Val>(DataType::Index);
+  auto* c = mul(add(a, b), IrBuilder::create<Val>(3L));
+  auto* d = neg(ceilDiv(c, b));
+  auto* e = div(a, sub(b, b));
+
+  EXPECT_FALSE(evaluator.evaluateInt64(c).has_value());
+
+  evaluator.bind(a, 7L);
+  evaluator.bind(b, 3L);
+
+  EXPECT_EQ(evaluator.evaluateInt64(a), 7);
+  EXPECT_EQ(std::as_const(evaluator).evaluateInt64(c), 30);
+  EXPECT_EQ(evaluator.evaluateInt64(c), 30);
+  EXPECT_EQ(evaluator.evaluateInt64(mod(a, b)), 1);
+  EXPECT_EQ(evaluator.evaluateInt64(maximum(a, b)), 7);
+  // neg falls back to evaluate
+  EXPECT_EQ(evaluator.evaluateInt64(d), -10);
+  // Errors are reported like evaluate does
+  EXPECT_THAT(
+      [&]() { evaluator.evaluateInt64(e); },
+      ThrowsMessage<nvfuser::nvfError>(HasSubstr("Integer division by zero")));
+  // Not an integer
+  EXPECT_FALSE(
+      evaluator.evaluateInt64(IrBuilder::create<Val>(1.5)).has_value());
+}
+
 // Evaluate known values with const expression evaluator reference
 TEST_F(ExprEvalTest, ConstReference) {
   Fusion fusion;
@@ -813,6 +848,45 @@ TEST_F(ExprEvalTest, TensorMetadataPrecomputedValues) {
   checkIntValue(evaluator, logical_size_1, 4);
 }
 
+// Test that integer extents computed by the int64 fast path of
+// NaiveValueMachine match the generic evaluation
+TEST_F(ExprEvalTest, PrecomputedValuesInt64Extents) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto* tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+
+  auto* tv1 = set(tv0);
+  fusion.addOutput(tv1);
+  // [ceilDiv(i0, 4), 3, ceilDiv(4 * i1, 3)]
+  tv1->split(0, 4);
+  tv1->merge(1, 2);
+  tv1->split(1, 3, /*inner_split=*/false);
+
+  PrecomputedValues pv(&fusion);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  for (int64_t size : {10, 13}) {
+    auto t0 = at::randn({size, 5}, options);
+    pv.bindInputs({t0});
+    pv.evaluate();
+
+    ExpressionEvaluator pv_evaluator;
+    pv_evaluator.bindPrecomputedValues(&pv);
+    ExpressionEvaluator evaluator;
+    evaluator.bind(tv0, t0);
+
+    for (IterDomain* id : tv1->getLoopDomain()) {
+      EXPECT_EQ(
+          pv_evaluator.evaluate(id->extent()), evaluator.evaluate(id->extent()))
+          << id->toString();
+    }
+    checkIntValue(pv_evaluator, tv1->axis(0)->extent(), (size + 3) / 4);
+    checkIntValue(pv_evaluator, tv1->axis(2)->extent(), (20 + 2) / 3);
+  }
+}
+
 TEST_F(ExprEvalTest, NamedScalar) {
   Fusion fusion;
   FusionGuard fg(&fusion);
@@ -1216,4 +1216,25 @@ TEST_F(ExprSimplifierTest, NonZeroLoopIndexStart) {
                   .as<bool>());
 }
 
+TEST_F(ExprSimplifierTest, Cache) {
+  using stupid_simple_compiler::parse;
+  constexpr const char* query = "( i0 * 4 + i1 ) / 4";
+  constexpr const char* assumption = "i0 >= 0 && 0 <= i1 && i1 < 4";
+
+  ExprSimplifierCache cache;
+  Val* simplified = simplifyExpr(parse(query), {}, {parse(assumption)});
+  EXPECT_EQ(cache.misses(), 1);
+
+  // The same query, built from other pointers
+  EXPECT_EQ(simplifyExpr(parse(query), {}, {parse(assumption)}), simplified);
+  EXPECT_EQ(cache.hits(), 1);
+
+  // Other assumptions make another query
+  simplifyExpr(parse(query), {}, {});
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 2);
+
+  EXPECT_TRUE(isEquivalent(simplified, "i0"_));
+}
+
 } // namespace nvfuser
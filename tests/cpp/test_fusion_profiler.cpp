@@ -15,6 +15,7 @@
 #include <runtime/executor.h>
 #include <runtime/executor_utils.h>
 #include <runtime/fusion_executor_cache.h>
+#include <runtime/sampling_profiler.h>
 #include <scheduler/tools/inlining.h>
 #include <sys_utils.h>
 #include <tests/cpp/utils.h>
@@ -148,6 +149,44 @@ TEST_F(FusionProfilerTest, ProfileNocupti1Segment) {
   EXPECT_TRUE(fprof.kernel_profiles.empty());
 }
 
+TEST_F(FusionProfilerTest, ProfileLoweringPasses) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  ProfilerOptionsGuard::getCurOptions().set(ProfilerOption::EnableNocupti);
+
+  auto tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  auto tv1 = sum(tv0, {1});
+  fusion->addOutput(tv1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({128, 256}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+
+  const FusionProfile& fprof = FusionProfiler::profile();
+  ASSERT_EQ(fprof.lowering_pass_profiles.size(), 1);
+  const std::vector<LoweringPassProfile>& passes =
+      fprof.lowering_pass_profiles.at(0);
+  std::vector<std::string> names;
+  double total_ms = 0.0;
+  for (const LoweringPassProfile& pass : passes) {
+    names.push_back(pass.name);
+    EXPECT_GE(pass.time_ms, 0.0);
+    total_ms += pass.time_ms;
+  }
+  EXPECT_THAT(
+      names,
+      testing::IsSupersetOf(
+          {"build ComputeAtMap",
+           "build predicateElimination",
+           "reorderExprsForComputeAt",
+           "IndexLowering"}));
+  EXPECT_GT(passes.back().num_exprs, 0);
+  EXPECT_LE(total_ms, fprof.compile_time_ms);
+}
+
 TEST_F(FusionProfilerTest, Profile3Segments) {
   try {
     auto fusion = std::make_unique<Fusion>();
@@ -196,10 +235,144 @@ TEST_F(FusionProfilerTest, Profile3Segments) {
   EXPECT_NE(fprof.kernel_time_ms, fprof.kernel_profiles.at(0).time_ms);
   EXPECT_EQ(fprof.input_bytes, int64_t((11 + 13 + 17) * 4));
   EXPECT_EQ(fprof.output_bytes, int64_t((11 + 13 + 17) * 4));
+  // The outputs are all alive at the end of the execution
+  EXPECT_GE(fprof.peak_memory_bytes, fprof.output_bytes);
   EXPECT_GT(fprof.effective_bandwidth_gbs, 0.0);
   EXPECT_GT(fprof.percentage_peak_bandwidth, 0.0);
 }
 
+TEST_F(FusionProfilerTest, ProfileRoofline) {
+  try {
+    auto fusion = std::make_unique<Fusion>();
+    FusionGuard fg(fusion.get());
+    ProfilerOptionsGuard::getCurOptions().unset(ProfilerOption::EnableNocupti);
+    ProfilerOptionsGuard::getCurOptions().set(ProfilerOption::Enable);
+
+    auto shape = std::vector<int64_t>({128, 1024});
+    auto tv0 = makeConcreteTensor(shape);
+    auto tv1 = makeConcreteTensor(shape);
+    fusion->addInput(tv0);
+    fusion->addInput(tv1);
+
+    auto tv2 = mul(add(tv0, tv1), tv1);
+    fusion->addOutput(tv2);
+
+    auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+    auto t0 = at::randn(shape, options);
+    auto t1 = at::randn(shape, options);
+
+    FusionExecutorCache executor_cache(std::move(fusion));
+    auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+    SUCCEED();
+  } catch (const std::exception& e) {
+    FAIL() << "Defining and profiling the fusion failed!" << e.what();
+  }
+
+  const FusionProfile& fprof = FusionProfiler::profile();
+  ASSERT_EQ(fprof.kernel_profiles.size(), 1);
+  const KernelProfile& kprof = fprof.kernel_profiles.at(0);
+  EXPECT_EQ(kprof.flops, 2 * 128 * 1024);
+  EXPECT_GT(kprof.achieved_gflops, 0.0);
+  EXPECT_GT(kprof.percentage_peak_flops, 0.0);
+  EXPECT_GE(kprof.percentage_roofline, kprof.percentage_peak_bandwidth);
+  EXPECT_GE(kprof.percentage_roofline, kprof.percentage_peak_flops);
+  EXPECT_EQ(kprof.below_roofline_threshold, kprof.percentage_roofline < 50.0);
+  EXPECT_EQ(kprof.scheduler, "pointwise");
+  EXPECT_FALSE(kprof.heuristic_params.empty());
+
+  std::stringstream csv;
+  writeKernelProfilesCsv(csv, fprof, /*header=*/true);
+  std::string line;
+  ASSERT_TRUE(std::getline(csv, line));
+  EXPECT_THAT(line, testing::StartsWith("fusion_id,segment_id,kernel_name,"));
+  ASSERT_TRUE(std::getline(csv, line));
+  EXPECT_THAT(line, testing::HasSubstr("\"pointwise\""));
+  EXPECT_FALSE(std::getline(csv, line));
+
+  std::stringstream json;
+  writeKernelProfilesJson(json, fprof);
+  ASSERT_TRUE(std::getline(json, line));
+  EXPECT_THAT(line, testing::HasSubstr("\"percentage_roofline\": "));
+  EXPECT_FALSE(std::getline(json, line));
+}
+
+// RUN CMD: bin/test_profiler --gtest_filter="*ProfileStages*"
+TEST_F(FusionProfilerTest, ProfileStages) {
+  NVFUSER_TEST_CUDA_ARCH_RANGE_GUARD(9, 0, 10, 0);
+  EnableOptionsGuard eog;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmul);
+  EnableOptionsGuard::getCurOptions().set(EnableOption::KernelProfile);
+  ProfilerOptionsGuard::getCurOptions().unset(ProfilerOption::EnableNocupti);
+  ProfilerOptionsGuard::getCurOptions().set(ProfilerOption::Enable);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  auto tv0 = makeContigTensor(2, DataType::Half);
+  auto tv1 = makeContigTensor(2, DataType::Half);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addOutput(matmul(tv0, tv1));
+
+  auto options = at::TensorOptions().dtype(at::kHalf).device(at::kCUDA, 0);
+  auto t0 = at::randn({1024, 512}, options);
+  auto t1 = at::randn({512, 2048}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  executor_cache.runFusionWithInputs({t0, t1});
+
+  const FusionProfile& fprof = FusionProfiler::profile();
+  ASSERT_EQ(fprof.kernel_profiles.size(), 1);
+  const KernelProfile& kprof = fprof.kernel_profiles.at(0);
+  EXPECT_EQ(kprof.scheduler, "matmul");
+  std::unordered_set<std::string> stages;
+  for (const KernelStageProfile& stage : kprof.stages) {
+    stages.insert(stage.stage);
+    EXPECT_GT(stage.count, 0);
+    EXPECT_GE(stage.percentage_kernel, 0.0);
+    EXPECT_LE(stage.percentage_kernel, 100.0);
+  }
+  EXPECT_THAT(
+      stages, testing::IsSupersetOf({"Kernel", "TmaWait", "Mma", "Epilogue"}));
+}
+
+TEST_F(FusionProfilerTest, SampleLatencies) {
+  ProfilerOptionsGuard::getCurOptions().unset(ProfilerOption::Enable);
+  ProfilerOptionsGuard::getCurOptions().unset(ProfilerOption::EnableNocupti);
+  ProfilerOptionsGuard::getCurOptions().set(ProfilerOption::Sample, {"2"});
+  EXPECT_FALSE(isProfilerEnabled());
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(1);
+  fusion->addInput(tv0);
+  TensorView* tv1 = segment_set(mul(tv0, IrBuilder::create<Val>(2.0)));
+  fusion->addOutput(add(tv1, tv1));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({1024}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion), /*fusion_id=*/7);
+  for ([[maybe_unused]] auto i : arange(5)) {
+    executor_cache.runFusionWithInputs({t0});
+  }
+  NVFUSER_CUDA_RT_SAFE_CALL(cudaDeviceSynchronize());
+
+  // The 1st, 3rd and 5th executions are sampled
+  FusionSamples samples = executor_cache.sampledLatencies();
+  EXPECT_EQ(samples.fusion_id, 7);
+  EXPECT_EQ(samples.executions, 5);
+  EXPECT_EQ(samples.dropped, 0);
+  EXPECT_EQ(samples.fusion.count, 3);
+  EXPECT_GT(samples.fusion.max_us, 0.0);
+  EXPECT_LE(samples.fusion.meanUs(), samples.fusion.max_us);
+  ASSERT_EQ(samples.segments.size(), 2);
+  for (const LatencyHistogram& segment : samples.segments) {
+    EXPECT_EQ(segment.count, 3);
+    EXPECT_LE(segment.max_us, samples.fusion.max_us);
+  }
+  EXPECT_EQ(FusionProfiler::state(), ProfilerState::Ready);
+}
+
 TEST_F(FusionProfilerTest, FusionProfilerErrorChecks) {
   FusionProfiler::reset();
 
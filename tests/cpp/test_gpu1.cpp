@@ -365,6 +365,37 @@ TEST_F(NVFuserTest, FusionMove_CUDA) {
   ASSERT_EQ(lowered_ir.str(), moved_lowered_ir.str());
 }
 
+TEST_F(NVFuserTest, FusionMoveShortcuts_CUDA) {
+  Fusion fusion;
+  Val* zero = nullptr;
+  Val* removed = nullptr;
+  Val* kept = nullptr;
+  {
+    FusionGuard fg(&fusion);
+    zero = fusion.zeroVal();
+    removed = IrBuilder::create<Val>(DataType::Int);
+    kept = add(IrBuilder::create<Val>(DataType::Int), zero);
+    fusion.removeVal(removed);
+  }
+
+  // The statements, including the shortcuts, live in the arena of the
+  // container, which moves with them.
+  Fusion another_fusion = std::move(fusion);
+  EXPECT_EQ(another_fusion.zeroVal(), zero);
+  EXPECT_EQ(zero->container(), &another_fusion);
+  EXPECT_EQ(kept->container(), &another_fusion);
+
+  const std::deque<Val*>& vals = another_fusion.deterministic_vals();
+  EXPECT_EQ(std::count(vals.begin(), vals.end(), removed), 0);
+  EXPECT_EQ(std::count(vals.begin(), vals.end(), kept), 1);
+  EXPECT_EQ(std::count(vals.begin(), vals.end(), zero), 0);
+
+  // Copies get shortcuts of their own.
+  Fusion copy = another_fusion;
+  EXPECT_NE(copy.zeroVal(), zero);
+  EXPECT_EQ(copy.zeroVal()->container(), &copy);
+}
+
 TEST_F(NVFuserTest, FusionSimpleArith_CUDA) {
   std::stringstream ss1, ss2;
 
@@ -1085,6 +1085,39 @@ TEST_F(NVFuserTest, FusionDisjointSet_CUDA) {
   }
 }
 
+// Merged sets keep the entries of the first set before those of the second
+// whichever set is reused, and sets held outside of DisjointSets don't change
+TEST_F(NVFuserTest, FusionDisjointSetMergeOrder_CUDA) {
+  DisjointSets<int> set;
+  for (auto i : {1, 2, 3}) {
+    set.mapEntries(0, i);
+  }
+  set.mapEntries(4, 5);
+  set.initializeSet(6);
+
+  // The larger set of 0 is reused
+  set.mapEntries(0, 4);
+  EXPECT_EQ(
+      set.disjointSetMap().at(0)->vector(),
+      std::vector<int>({0, 1, 2, 3, 4, 5}));
+  // The larger set of 0 is reused, but the entry of 6 goes first
+  set.mapEntries(6, 0);
+  EXPECT_EQ(
+      set.disjointSetMap().at(0)->vector(),
+      std::vector<int>({6, 0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(set.size(), 1);
+
+  set.mapEntries(7, 8);
+  const DisjointSets<int>::DisjointSet held = set.disjointSetMap().at(7);
+  set.mapEntries(0, 7);
+  EXPECT_EQ(held->vector(), std::vector<int>({7, 8}));
+  EXPECT_EQ(
+      set.disjointSetMap().at(8)->vector(),
+      std::vector<int>({6, 0, 1, 2, 3, 4, 5, 7, 8}));
+  EXPECT_EQ(set.size(), 1);
+  EXPECT_TRUE(set.strictAreMapped(8, 6));
+}
+
 TEST_F(NVFuserTest, FusionNonUniqueBroadcastSize_CUDA) {
   Fusion fusion;
   FusionGuard fg(&fusion);
@@ -5519,6 +5552,34 @@ TEST_F(NVFuserTest, FusionSimpleWarp_CUDA) {
   testValidate(fusion.get(), outputs, {t1}, {at_output}, __LINE__, __FILE__);
 }
 
+// Warp reductions of 32-bit integers pass a functor that reduces within a
+// warp with redux.sync on sm_80 and newer
+TEST_F(NVFuserTest, FusionWarpReduceRedux_CUDA) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeSymbolicTensor(2, DataType::Int32);
+  fusion->addInput(tv0);
+  auto tv1 = max(tv0, {1});
+  fusion->addOutput(tv1);
+
+  tv1->axis(0)->parallelize(ParallelType::BIDx);
+  tv1->axis(1)->parallelize(ParallelType::TIDx);
+  tv1->axis(1)->padToMultipleOfWarp();
+
+  auto options = at::TensorOptions().dtype(at::kInt).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randint(-1000, 1000, {16, 127}, options);
+
+  KernelExecutor ke;
+  ke.compile(fusion.get(), {t0});
+  EXPECT_THAT(
+      ke.compiledKernel()->kernelString(),
+      ::testing::HasSubstr("warp::ReduxMax{}"));
+  auto outputs = ke.run({t0});
+
+  testValidate(fusion.get(), outputs, {t0}, __LINE__, __FILE__);
+}
+
 TEST_F(NVFuserTest, FusionSimpleWarpPad_CUDA) {
   auto fusion = std::make_unique<Fusion>();
   FusionGuard fg(fusion.get());
@@ -30,6 +30,7 @@
 #include <kernel_ir_dispatch.h>
 #include <logical_domain_map.h>
 #include <ops/all_ops.h>
+#include <runtime/arg_table_staging.h>
 #include <runtime/executor.h>
 #include <runtime/executor_params.h>
 #include <runtime/fusion_executor_cache.h>
@@ -1726,6 +1727,73 @@ TEST_F(NVFuserTest, FusionRAWSyncInsertionPlace4_CUDA) {
   sync_insertion_checker.handle(gpulw.run()->topLevelExprs());
 }
 
+TEST_F(NVFuserTest, RemoveRedundantSyncs) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeConcreteTensor({32, 32});
+  fusion.addInput(tv0);
+  auto tv1 = set(tv0);
+  auto tv2 = set(tv1);
+  fusion.addOutput(tv2);
+
+  // tv2 reads tv1 transposed, so a RAW sync is placed between the two loop
+  // nests
+  tv1->setMemoryType(MemoryType::Shared);
+  tv1->axis(0)->parallelize(ParallelType::TIDy);
+  tv1->axis(1)->parallelize(ParallelType::TIDx);
+  tv2->axis(0)->parallelize(ParallelType::TIDx);
+  tv2->axis(1)->parallelize(ParallelType::TIDy);
+
+  auto count_syncs = [](const std::vector<Expr*>& exprs) {
+    return std::count_if(exprs.begin(), exprs.end(), [](Expr* expr) {
+      return expr->isA<kir::BlockSync>();
+    });
+  };
+
+  GpuLower gpulw(&fusion);
+  auto pass_it = std::find_if(
+      gpulw.passes().begin(), gpulw.passes().end(), [](const auto& pass) {
+        return pass.first == "removeRedundantThreadSynchronization";
+      });
+  ASSERT_NE(pass_it, gpulw.passes().end());
+
+  // Duplicate each top-level sync, then make sure the duplicates are removed
+  int64_t num_syncs = 0;
+  pass_it = gpulw.passes().insert(
+      pass_it,
+      {"duplicateSyncs",
+       [&](const std::vector<Expr*>& exprs) -> std::vector<Expr*> {
+         num_syncs = count_syncs(exprs);
+         std::vector<Expr*> new_exprs;
+         for (Expr* expr : exprs) {
+           new_exprs.push_back(expr);
+           if (expr->isA<kir::BlockSync>()) {
+             new_exprs.push_back(IrBuilder::create<kir::BlockSync>());
+           }
+         }
+         return new_exprs;
+       }});
+  gpulw.passes().insert(
+      pass_it + 2,
+      {"checkSyncs",
+       [&](const std::vector<Expr*>& exprs) -> std::vector<Expr*> {
+         EXPECT_EQ(count_syncs(exprs), num_syncs);
+         return exprs;
+       }});
+  gpulw.run();
+  EXPECT_EQ(num_syncs, 1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({32, 32}, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  auto cg_outputs = ke.run({t0});
+
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
 // Test serial write and parallel read of shared mem: mapped case
 TEST_F(NVFuserTest, FusionSerialSmemWriteParallelRead1_CUDA) {
   Fusion fusion;
@@ -5184,6 +5252,87 @@ TEST_F(NVFuserTest, FusionVectorizeWelford2_CUDA) {
       __FILE__);
 }
 
+// Merge of rfactored partial results, whose counts are uniform across
+// the vectorized loop
+TEST_F(NVFuserTest, FusionVectorizeWelford3_CUDA) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  std::vector<int64_t> shape({12, 32});
+
+  auto tv0 = makeContigConcreteTensor(shape);
+  fusion.addInput(tv0);
+
+  auto tv1 = set(tv0);
+  auto tvs = Welford(tv1, {0});
+  fusion.addOutput(tvs.avg);
+  fusion.addOutput(tvs.var_sum);
+  fusion.addOutput(tvs.n);
+
+  // [r12, i32] -> [i8, r3, r4, i4]
+  tvs.avg->split(1, 4);
+  tvs.avg->split(0, 4);
+  tvs.avg->reorder({{2, 0}});
+  auto rf_tvs = tvs.avg->rFactor({2}, {tvs.avg, tvs.var_sum, tvs.n});
+
+  MaxLogicalDomainInfoSpanningTree tree(rf_tvs.at(0));
+  TransformPropagator tp(rf_tvs.at(0));
+  tree.traverse(&tp);
+
+  tv1->axis(-1)->parallelize(ParallelType::Vectorize);
+
+  inlineMost();
+
+  GpuLower gpulw(&fusion);
+  auto all_exprs = KernelExprVisitor::getAllExprs(gpulw.run());
+  EXPECT_EQ(
+      std::count_if(
+          all_exprs.begin(),
+          all_exprs.end(),
+          [](Expr* expr) { return expr->isStrictlyA<WelfordOp>(); }),
+      0);
+  // Both the rfactor and the merge of its results are vectorized
+  EXPECT_EQ(
+      std::count_if(
+          all_exprs.begin(),
+          all_exprs.end(),
+          [](Expr* expr) {
+            auto vwop = dynamic_cast<kir::VectorizedWelfordOp*>(expr);
+            return vwop != nullptr && vwop->deltaM2Scale() == nullptr;
+          }),
+      1);
+  EXPECT_EQ(
+      std::count_if(
+          all_exprs.begin(),
+          all_exprs.end(),
+          [](Expr* expr) {
+            auto vwop = dynamic_cast<kir::VectorizedWelfordOp*>(expr);
+            return vwop != nullptr && vwop->deltaM2Scale() != nullptr;
+          }),
+      1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto options_int = at::TensorOptions().dtype(at::kLong).device(at::kCUDA, 0);
+
+  at::Tensor t0 = at::randn(shape, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  auto cg_outputs = ke.run({t0});
+
+  auto ref_avg = t0.mean({0});
+  auto ref_var = t0.var({0}, false) * shape[0];
+  auto ref_N = at::ones({shape[1]}, options_int) * shape[0];
+
+  testValidate(
+      ke.compiledKernel()->kernel(),
+      cg_outputs,
+      {t0},
+      {ref_avg, ref_var, ref_N},
+      __LINE__,
+      __FILE__);
+}
+
 TEST_F(NVFuserTest, FusionRepro2241_CUDA) {
   std::unique_ptr<Fusion> fusion_ptr = std::make_unique<Fusion>();
   auto fusion = fusion_ptr.get();
@@ -5815,6 +5964,60 @@ TEST_F(NVFuserTest, FusionExecutorCacheIndexType2_CUDA) {
   NVF_CHECK(kernel_runtime->getIndexType() == PrimDataType::Int32);
 }
 
+// Inputs listed in CompileParams::int32_indexed_inputs are indexed with
+// 32-bit arithmetic even though the kernel uses 64-bit indexing
+TEST_F(NVFuserTest, MixedIndexType) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = makeSymbolicTensor(2);
+  fusion.addInput(tv1);
+  auto tv2 = add(tv0, tv1);
+  fusion.addOutput(tv2);
+
+  tv2->merge(0);
+  tv2->split(0, 128);
+  TransformPropagatorWithCheck propagator(tv2);
+  MaxLogicalDomainInfoSpanningTree(tv2).traverse(&propagator);
+  tv2->axis(0)->parallelize(ParallelType::BIDx);
+  tv2->axis(1)->parallelize(ParallelType::TIDx);
+  scheduler_utils::parallelizeAllLike(tv2);
+  inlineMost();
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({99, 101}, options);
+  at::Tensor t1 = at::randn({99, 101}, options);
+
+  KernelExecutor ke;
+  CompileParams compile_opts = {
+      .index_type = PrimDataType::Int, .int32_indexed_inputs = {0}};
+  ke.compile(&fusion, {t0, t1}, LaunchParams(), compile_opts);
+
+  kir::Kernel* kernel = ke.compiledKernel()->kernel();
+  EXPECT_EQ(kernel->indexType(), PrimDataType::Int);
+  EXPECT_TRUE(kernel->summary().has_narrowing_index_casts);
+  int64_t num_input_indices = 0;
+  for (Expr* expr : ir_utils::flattenScopedExprs(kernel->topLevelExprs())) {
+    for (auto ti : ir_utils::filterByType<kir::TensorIndex>(expr->inputs())) {
+      if (!ti->view()->isFusionInput()) {
+        continue;
+      }
+      ++num_input_indices;
+      EXPECT_EQ(
+          ti->index()->dtype(),
+          ti->view() == kernel->inputs().at(0) ? DataType::Int32
+                                               : DataType::Index)
+          << ti->toString();
+    }
+  }
+  EXPECT_EQ(num_input_indices, 2);
+
+  auto cg_outputs = ke.run({t0, t1});
+  testValidate(&fusion, cg_outputs, {t0, t1}, __LINE__, __FILE__);
+}
+
 //! Test whether we can create and use float16 scalars
 TEST_F(NVFuserTest, FusionHalfScalars_CUDA) {
   auto fusion = std::make_unique<Fusion>();
@@ -9087,6 +9290,313 @@ TEST_F(NVFuserTest, DeviceSharedMemoryLimit) {
   int device_reserved = (int)properties->reservedSharedMemPerBlock;
   EXPECT_EQ(device_limit, device_total - device_reserved);
 }
+
+TEST_F(NVFuserTest, PeelSerialLoops) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeSymbolicTensor(1);
+  fusion.addInput(tv0);
+  auto tv1 = set(tv0);
+  auto tv2 = add(tv1, IrBuilder::create<Val>(1.0));
+  fusion.addOutput(tv2);
+
+  // [serial, unswitch, TIDx], where only the last iteration of the serial
+  // loop is out of bounds with a non-divisible size
+  tv2->split(0, 128);
+  tv2->split(0, 1);
+  TransformPropagatorWithCheck propagator(tv2);
+  MaxLogicalDomainInfoSpanningTree(tv2).traverse(&propagator);
+  tv2->axis(1)->parallelize(ParallelType::Unswitch);
+  tv2->axis(2)->parallelize(ParallelType::TIDx);
+  scheduler_utils::parallelizeAllLike(tv2);
+  inlineMost();
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::PeelSerialLoops);
+
+  GpuLower gpulw(&fusion);
+  kir::Kernel* kernel = gpulw.run();
+  auto peel_ite_it = std::find_if(
+      kernel->topLevelExprs().begin(),
+      kernel->topLevelExprs().end(),
+      [](Expr* expr) { return expr->isA<kir::IfThenElse>(); });
+  ASSERT_NE(peel_ite_it, kernel->topLevelExprs().end());
+  auto peel_ite = (*peel_ite_it)->as<kir::IfThenElse>();
+  auto count_loops = [](const Scope& scope) {
+    return std::count_if(
+        scope.exprs().begin(), scope.exprs().end(), [](Expr* expr) {
+          return expr->isA<ForLoop>();
+        });
+  };
+  // Main and peeled loops, and the fallback loop
+  EXPECT_EQ(count_loops(peel_ite->thenBody()), 2);
+  EXPECT_EQ(count_loops(peel_ite->elseBody()), 1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  for (int64_t size : {999, 1024, 100}) {
+    auto t0 = at::randn({size}, options);
+    KernelExecutor ke;
+    ke.compile(&fusion, {t0});
+    auto cg_outputs = ke.run({t0});
+    testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+  }
+}
+// Cap the unroll factor of a loop whose fully unrolled body exceeds the
+// instruction budget
+TEST_F(NVFuserTest, UnrollBudget) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(1);
+  fusion.addInput(tv0);
+  TensorView* tv1 = tv0;
+  for (int64_t i = 0; i < 8; ++i) {
+    tv1 = sin(tv1);
+  }
+  fusion.addOutput(tv1);
+
+  tv1->split(0, 16);
+  tv1->split(0, 128);
+  TransformPropagatorWithCheck propagator(tv1);
+  MaxLogicalDomainInfoSpanningTree(tv1).traverse(&propagator);
+  tv1->axis(0)->parallelize(ParallelType::BIDx);
+  tv1->axis(1)->parallelize(ParallelType::TIDx);
+  tv1->axis(2)->parallelize(ParallelType::Unroll);
+  scheduler_utils::parallelizeAllLike(tv1);
+  inlineMost();
+
+  std::function<ForLoop*(const std::vector<Expr*>&)> find_unrolled_loop =
+      [&](const std::vector<Expr*>& exprs) -> ForLoop* {
+    for (Expr* expr : exprs) {
+      ForLoop* found = nullptr;
+      if (auto loop = dynamic_cast<ForLoop*>(expr)) {
+        found = loop->isUnrolled() ? loop
+                                   : find_unrolled_loop(loop->body().exprs());
+      } else if (auto ite = dynamic_cast<kir::IfThenElse*>(expr)) {
+        found = find_unrolled_loop(ite->thenBody().exprs());
+      }
+      if (found != nullptr) {
+        return found;
+      }
+    }
+    return nullptr;
+  };
+
+  int64_t unrolled_count = 0;
+  {
+    GpuLower gpulw(&fusion);
+    kir::Kernel* kernel = gpulw.run();
+    ForLoop* loop = find_unrolled_loop(kernel->topLevelExprs());
+    ASSERT_NE(loop, nullptr);
+    EXPECT_EQ(loop->maxUnrollFactor(), 0);
+    unrolled_count = kernel->summary().estimated_instruction_count;
+    EXPECT_GT(unrolled_count, 0);
+  }
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::UnrollBudget, {std::to_string(unrolled_count / 2)});
+  {
+    GpuLower gpulw(&fusion);
+    kir::Kernel* kernel = gpulw.run();
+    ForLoop* loop = find_unrolled_loop(kernel->topLevelExprs());
+    ASSERT_NE(loop, nullptr);
+    EXPECT_GT(loop->maxUnrollFactor(), 0);
+    EXPECT_LT(loop->maxUnrollFactor(), 16);
+    EXPECT_LT(kernel->summary().estimated_instruction_count, unrolled_count);
+  }
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({128 * 16 * 5 + 7}, options);
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  EXPECT_THAT(
+      ke.compiledKernel()->kernelString(),
+      ::testing::ContainsRegex("#pragma unroll [0-9]+"));
+  auto cg_outputs = ke.run({t0});
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+// Building analyses concurrently must not change the generated kernel
+TEST_F(NVFuserTest, ParallelLoweringAnalyses) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  TensorView* tv2 = broadcast(tv1, {false, true});
+  TensorView* tv3 = sub(tv0, tv2);
+  fusion.addOutput(tv3);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 1024}, options);
+  auto heuristic_params = SchedulerEntry::scheduleWith(
+      &fusion, SchedulerType::InnerPersistent, {t0});
+
+  const std::string serial_code =
+      codegen::generateCudaKernel(GpuLower(&fusion).run());
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::ParallelLoweringAnalyses);
+  EXPECT_EQ(codegen::generateCudaKernel(GpuLower(&fusion).run()), serial_code);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0}, heuristic_params->lparams);
+  auto cg_outputs = ke.run({t0}, {}, heuristic_params->lparams);
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+// Reusing string streams and memoizing inline strings must not change the
+// generated kernel
+TEST_F(NVFuserTest, FastCodegen) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  TensorView* tv2 = broadcast(tv1, {false, true});
+  TensorView* tv3 = div(sin(tv0), tv2);
+  TensorView* tv4 = add(tv3, IrBuilder::create<Val>(0.1));
+  fusion.addOutput(tv4);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 1000}, options);
+  SchedulerEntry::scheduleWith(&fusion, SchedulerType::InnerPersistent, {t0});
+
+  GpuLower gpulw(&fusion);
+  kir::Kernel* kernel = gpulw.run();
+  const std::string code = codegen::generateCudaKernel(kernel);
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FastCodegen);
+  EXPECT_EQ(codegen::generateCudaKernel(kernel), code);
+}
+// Small unrolled loop nests are not protected with magic zero when the
+// protection is selective
+TEST_F(NVFuserTest, SelectiveMagicZero) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  TensorView* tv1 = set(tv0);
+  TensorView* tv2 = add(tv1, IrBuilder::create<Val>(1.0));
+  fusion.addOutput(tv2);
+
+  tv2->merge(0);
+  tv2->split(0, 4);
+  tv2->split(0, 128);
+  TransformPropagatorWithCheck propagator(tv2);
+  MaxLogicalDomainInfoSpanningTree(tv2).traverse(&propagator);
+  tv2->axis(0)->parallelize(ParallelType::BIDx);
+  tv2->axis(1)->parallelize(ParallelType::TIDx);
+  tv2->axis(2)->parallelize(ParallelType::Unroll);
+  scheduler_utils::parallelizeAllLike(tv2);
+  tv1->computeAt(tv2, 2);
+
+  auto generate = [&fusion]() {
+    return codegen::generateCudaKernel(GpuLower(&fusion).run());
+  };
+  EXPECT_THAT(generate(), ::testing::HasSubstr(kMagicZeroName));
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::SelectiveMagicZero);
+  EXPECT_THAT(
+      generate(), ::testing::Not(::testing::HasSubstr(kMagicZeroName)));
+
+  // The nest needs more registers than a zero budget
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::SelectiveMagicZero, {"0"});
+  EXPECT_THAT(generate(), ::testing::HasSubstr(kMagicZeroName));
+
+  EnableOptionsGuard::getCurOptions().set(EnableOption::SelectiveMagicZero);
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({99, 101}, options);
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  auto cg_outputs = ke.run({t0});
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
+// Tensors indexed without their strides are passed without them
+TEST_F(NVFuserTest, TensorArgsWithoutStrides) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+  TensorView* tv1 = add(tv0, IrBuilder::create<Val>(1.0));
+  fusion.addOutput(tv1);
+
+  tv1->merge(0);
+  tv1->split(0, 128);
+  tv1->axis(0)->parallelize(ParallelType::BIDx);
+  tv1->axis(1)->parallelize(ParallelType::TIDx);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({99, 128}, options).slice(1, 0, 101);
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  const std::string& kernel_code = ke.compiledKernel()->kernelString();
+  EXPECT_THAT(kernel_code, ::testing::HasSubstr("Tensor<float, 2, 2> T0"));
+  EXPECT_THAT(kernel_code, ::testing::HasSubstr("Tensor<float, 2, 0> T1"));
+  auto cg_outputs = ke.run({t0});
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
+// Kernels whose parameters exceed 4 KB read their arguments from a table in
+// device memory
+TEST_F(NVFuserTest, KernelArgTable) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  constexpr int64_t num_inputs = 300;
+  TensorView* out = nullptr;
+  for ([[maybe_unused]] auto i : arange(num_inputs)) {
+    TensorView* tv = makeContigTensor(1);
+    fusion.addInput(tv);
+    out = out == nullptr ? tv : add(out, tv);
+  }
+  fusion.addOutput(out);
+
+  out->split(0, 128);
+  TransformPropagatorWithCheck propagator(out);
+  MaxLogicalDomainInfoSpanningTree(out).traverse(&propagator);
+  out->axis(0)->parallelize(ParallelType::BIDx);
+  out->axis(1)->parallelize(ParallelType::TIDx);
+  scheduler_utils::parallelizeAllLike(out);
+  inlineMost();
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  KernelArgumentHolder args;
+  for ([[maybe_unused]] auto i : arange(num_inputs)) {
+    args.push(at::randn({1000}, options));
+  }
+  KernelExecutor ke;
+  ke.compile(&fusion, args);
+  EXPECT_THAT(
+      ke.compiledKernel()->kernelString(),
+      ::testing::HasSubstr("KernelArgs* __restrict__ args"));
+  auto cg_outputs = ke.run(args);
+  testValidate(&fusion, cg_outputs, args, __LINE__, __FILE__);
+
+  // Many more tables than fit in a chunk of the staging are copied, and the
+  // chunks are reused once the kernels reading them have completed
+  ArgTableStaging& staging = ArgTableStaging::current(0);
+  const int64_t num_chunks = staging.numChunks();
+  for (auto i : arange(400)) {
+    args[i % num_inputs] = at::randn({1000}, options);
+    at::Tensor output = ke.run(args)[0].as<at::Tensor>();
+    std::vector<at::Tensor> inputs;
+    for (const auto& arg : args) {
+      inputs.push_back(arg.as<at::Tensor>());
+    }
+    EXPECT_TRUE(at::allclose(output, at::stack(inputs).sum(0), 1e-3, 1e-3));
+  }
+  EXPECT_LE(staging.numChunks() - num_chunks, 2);
+}
 // Test file size should be up to 10K LoC. Create a new file for more tests.
 
 } // namespace nvfuser
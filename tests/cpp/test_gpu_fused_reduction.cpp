@@ -6,6 +6,7 @@
  */
 // clang-format on
 #include <csrc/exceptions.h>
+#include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
 #include <codegen.h>
@@ -859,6 +860,84 @@ TEST_F(NVFuserTest, FusionGroupedReduction7_CUDA) {
   ASSERT_ANY_THROW(groupReductions({tv1, tv4}));
 }
 
+// Grouped block reductions along TIDy with different ops are reduced by a
+// single groupedBlockReduce call
+TEST_F(NVFuserTest, FusionGroupedBlockReduction_CUDA) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+
+  auto tv1 = sum(tv0, {0});
+  auto tv2 = max(tv0, {0});
+  auto tv3 = add(tv1, tv2);
+  fusion.addOutput(tv3);
+
+  groupReductions({tv1, tv2});
+
+  tv1->axis(0)->parallelize(ParallelType::TIDy);
+  tv1->axis(1)->parallelize(ParallelType::BIDx);
+  scheduler_utils::parallelizeAllLike(tv1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({99, 33}, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  EXPECT_THAT(
+      ke.compiledKernel()->kernelString(),
+      ::testing::HasSubstr("groupedBlockReduce<"));
+  auto outputs = ke.run({t0});
+
+  auto ref = t0.sum({0}) + std::get<0>(t0.max(0));
+
+  testValidate(
+      ke.compiledKernel()->kernel(), outputs, {t0}, {ref}, __LINE__, __FILE__);
+}
+
+// Grouped warp reductions along TIDx share one shuffle tree
+TEST_F(NVFuserTest, FusionGroupedWarpReduction_CUDA) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+
+  auto tv1 = sum(tv0, {1});
+  auto tv2 = sum(mul(tv0, tv0), {1});
+  auto tv3 = add(tv1, tv2);
+  fusion.addOutput(tv3);
+
+  groupReductions({tv1, tv2});
+
+  tv1->split(1, 128);
+  TransformPropagator propagator(tv1);
+  MaxLogicalDomainInfoSpanningTree(tv1).traverse(&propagator);
+
+  auto rf_tvs = tv1->rFactor({1}, {tv1, tv2});
+
+  rf_tvs.at(0)->axis(0)->parallelize(ParallelType::BIDx);
+  rf_tvs.at(0)->axis(2)->parallelize(ParallelType::TIDx);
+  scheduler_utils::parallelizeAllLike(rf_tvs.at(0));
+  inlineMost();
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({17, 1024}, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  EXPECT_THAT(
+      ke.compiledKernel()->kernelString(),
+      ::testing::HasSubstr("warp::groupedWarpReduceTIDX<"));
+  auto outputs = ke.run({t0});
+
+  auto ref = t0.sum({1}) + (t0 * t0).sum({1});
+
+  testValidate(
+      ke.compiledKernel()->kernel(), outputs, {t0}, {ref}, __LINE__, __FILE__);
+}
+
 // Grouping rfactor'ed reductions
 TEST_F(NVFuserTest, FusionGroupedReductionRfactor1_CUDA) {
   Fusion fusion;
@@ -2621,4 +2700,44 @@ TEST_F(NVFuserTest, FusionTensorRankLimit) {
   testValidate(executor_cache.fusion(), cg_outputs, {t0}, __LINE__, __FILE__);
 }
 
+TEST_F(NVFuserTest, ClusterGridReduction) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(9, 0);
+
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = sum(tv0, {1});
+  fusion.addOutput(tv1);
+
+  // [I, R] -> [BIDy, rBIDx{4}, rS, rTIDx{128}]
+  constexpr int64_t cluster_size = 4;
+  tv1->split(1, 128);
+  tv1->split(1, cluster_size, false);
+  auto tv2 = tv1->rFactor({2});
+  tv1->axis(0)->parallelize(ParallelType::BIDy);
+  tv1->axis(1)->parallelize(ParallelType::BIDx);
+  tv1->axis(2)->parallelize(ParallelType::TIDx);
+  scheduler_utils::parallelizeAllLike(tv1, {tv2});
+  inlineMost();
+
+  // The blocks along BIDx form a cluster, so the grid reduction doesn't need
+  // any global buffer
+  fusion.manage(
+      "cluster_dims",
+      std::tuple<int64_t, int64_t, int64_t>{cluster_size, 1, 1});
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({96, 10000}, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  EXPECT_TRUE(
+      ke.compiledKernel()->kernel()->summary().global_allocations.empty());
+  auto cg_outputs = ke.run({t0});
+
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
 } // namespace nvfuser
@@ -2641,4 +2641,111 @@ TEST_F(OuterReductionTest, SimpleThreadLocalSerialReduction) {
   testValidate(&fusion_copy, outputs, {at_t0}, __LINE__, __FILE__);
 }
 
+TEST_F(OuterReductionTest, PersistentGrid) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::PersistentGrid);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  FusionGuard fg(fusion_ptr.get());
+  Fusion& fusion = *fusion_ptr;
+
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = sum(tv0, {0});
+  fusion.addOutput(tv1);
+
+  // The iteration domain needs many more blocks than can be resident
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({16, (1L << 22) + 3}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const auto* rparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<ReductionParams>();
+  ASSERT_FALSE(rparams->cross_grid_inner_reduction);
+  EXPECT_TRUE(rparams->split_grid_dim_iter_dom_outer);
+  EXPECT_LE(
+      rparams->lparams.gdimx(),
+      scheduler_utils::maxResidentBlocks(rparams->lparams.bdimx()));
+}
+
+TEST_F(OuterReductionTest, PrefetchSerialReductionLoads) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = sum(tv0, {0});
+  fusion.addOutput(tv1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({16384, 1024}, options);
+
+  SchedulerRuntimeInfo runtime_info(&fusion, {t0});
+  auto scheduler =
+      SchedulerEntry::makeSchedulerInstance(SchedulerType::Reduction);
+  auto heuristic_params = scheduler->computeHeuristics(&fusion, runtime_info);
+  auto rparams = heuristic_params->as<ReductionParams>();
+  rparams->prefetch_serial_reduction_loads = true;
+  scheduler->schedule(&fusion, rparams);
+
+  // The register cache of the input is double buffered along the serial
+  // reduction loop
+  auto cached_input = ir_utils::consumerTvsOf(tv0).at(0);
+  EXPECT_TRUE(cached_input->isCircularBuffered()) << cached_input->toString();
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0}, heuristic_params->lparams);
+  auto cg_outputs = ke.run({t0}, {}, heuristic_params->lparams);
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
+TEST_F(OuterReductionTest, AtomicGridReduction) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::AtomicReduction);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  FusionGuard fg(fusion_ptr.get());
+
+  auto tv0 = makeContigTensor(2);
+  fusion_ptr->addInput(tv0);
+  auto tv1 = sum(tv0, {0});
+  fusion_ptr->addOutput(tv1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({65536, 128}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  // The output is zeroed before each launch
+  for ([[maybe_unused]] auto i : arange(2)) {
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  }
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const auto* rparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<ReductionParams>();
+  ASSERT_TRUE(rparams->cross_grid_inner_reduction);
+  EXPECT_TRUE(rparams->atomic_inner_reduction);
+
+  // No work buffer or grid sync is needed
+  const auto& summary = runtime->executors()
+                            .at(0)
+                            ->as<KernelExecutor>()
+                            ->compiledKernel()
+                            ->kernel()
+                            ->summary();
+  EXPECT_FALSE(summary.has_grid_reductions);
+  EXPECT_EQ(summary.atomic_reduction_outputs.size(), 1);
+}
+
 } // namespace nvfuser
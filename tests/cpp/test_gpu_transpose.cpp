@@ -6,6 +6,7 @@
  */
 // clang-format on
 #include <csrc/exceptions.h>
+#include <device_lower/analysis/bank_conflict.h>
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
@@ -994,6 +995,41 @@ TEST_F(TransposeTest, FusionTransposeBankConflict9) {
   testValidate(&fusion, outputs, {input}, __LINE__, __FILE__);
 }
 
+TEST_F(TransposeTest, FusionTransposeBankConflictRepair) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeConcreteTensor({32, 32});
+  fusion.addInput(tv0);
+  auto tv1 = set(tv0);
+  auto tv2 = transpose(tv1, 0, 1);
+  auto tv3 = set(tv2);
+  fusion.addOutput(tv3);
+
+  tv1->setMemoryType(MemoryType::Shared);
+  for (auto tv : {tv1, tv2, tv3}) {
+    tv->axis(0)->parallelize(ParallelType::TIDy);
+    tv->axis(1)->parallelize(ParallelType::TIDx);
+  }
+
+  auto bank_conflict_info = fusion.bankConflictInfo();
+  ASSERT_EQ(bank_conflict_info.at(tv1).first, std::vector<int64_t>{32});
+
+  EXPECT_EQ(repairBankConflicts(&fusion), std::vector<TensorView*>{tv1});
+  EXPECT_TRUE(fusion.bankConflictInfo().empty());
+  // Nothing left to repair
+  EXPECT_TRUE(repairBankConflicts(&fusion).empty());
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor input = at::randn({32, 32}, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion);
+  auto outputs = ke.run({input});
+
+  testValidate(&fusion, outputs, {input}, __LINE__, __FILE__);
+}
+
 // small transpose dimension with merge and split. See issue #667
 TEST_F(TransposeTest, UnswitchPredicateIssueRepro667) {
   auto fusion = std::make_unique<Fusion>();
@@ -1342,4 +1378,62 @@ TEST_F(TransposeTest, ReductionIterDomainOnInputsIssue1659) {
   testValidate(fusion_ptr, cg_outputs, {t0, t1}, __LINE__, __FILE__);
 }
 
+// Converting channels-last activations loads the input tiles with TMA to
+// swizzled shared memory and stores the output tiles with TMA
+// The input and the two outputs have three different inner most dims. The
+// inner most dim of the third group is tiled and staged in shared memory too.
+// See note [Tiling more than two groups]
+TEST_F(TransposeTest, ThreeInnerDimGroups) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeContigTensor(3);
+  fusion->addInput(tv0);
+  auto tv1 = permute(tv0, {0, 2, 1});
+  auto tv2 = permute(sin(tv0), {1, 2, 0});
+  fusion->addOutput(tv1);
+  fusion->addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256, 128}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto cg_outputs = executor_cache.runFusionWithInputs({t0});
+
+  auto runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_FALSE(runtime->isSegmented());
+  auto heuristic_params =
+      runtime->schedulerHeuristics()->heuristicsList().at(0).get();
+  ASSERT_EQ(heuristic_params->scheduler_type, SchedulerType::Transpose);
+  EXPECT_EQ(
+      heuristic_params->as<TransposeParams>()->extra_tile_sizes.size(), 1);
+
+  testValidate(executor_cache.fusion(), cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
+TEST_F(TransposeTest, TmaChannelsLastToChannelsFirst) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(9, 0);
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::TmaTranspose);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  Fusion& fusion = *fusion_ptr;
+  FusionGuard fg(&fusion);
+
+  // [N, H, W, C] -> [N, C, H, W]
+  auto tv0 = makeContigTensor(4);
+  fusion.addInput(tv0);
+  auto tv1 = permute(tv0, {0, 3, 1, 2});
+  auto tv2 = relu(tv1);
+  fusion.addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({16, 64, 64, 256}, options);
+
+  auto cg_results = scheduleAndRun(&fusion, SchedulerType::Transpose, {t0});
+  auto tparams = cg_results.heuristic_params->as<TransposeParams>();
+  EXPECT_TRUE(tparams->use_tma);
+  testValidate(&fusion, cg_results.outputs, {t0}, __LINE__, __FILE__);
+}
+
 } // namespace nvfuser
@@ -541,31 +541,25 @@ TEST_F(StreamTest, HostIrSetStream) {
       c10::cuda::getDefaultCUDAStream(0), c10::cuda::getCurrentCUDAStream(0));
 }
 
-// The following test simply demonstrate how to change current CUDA stream in
-// the host program
+// The default stream of the host program is the current CUDA stream of the
+// caller, so that the host program runs in the caller's stream order
 TEST_F(StreamTest, HostIrDefaultStream) {
-  auto change_stream = [](bool use_default_stream) {
-    auto hic = std::make_unique<HostIrContainer>();
-    FusionGuard fg(hic.get());
-    Stream* stream;
-    if (use_default_stream) {
-      stream = hic->getDefaultStream();
-    } else {
-      stream = IrBuilder::create<Stream>();
-    }
-    auto set_stream = IrBuilder::create<SetCurrentStream>(stream);
-    hic->pushBackTopLevelExprs(set_stream);
-    HostIrEvaluator hie(std::move(hic));
-    hie.runWithInput({});
-  };
+  auto hic = std::make_unique<HostIrContainer>();
+  FusionGuard fg(hic.get());
+  Stream* default_stream = hic->getDefaultStream();
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<SetCurrentStream>(IrBuilder::create<Stream>()));
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<SetCurrentStream>(default_stream));
 
-  setCurrentCUDAStream(c10::cuda::getDefaultCUDAStream(0));
-  change_stream(/*use_default_stream=*/false);
-  EXPECT_NE(
-      c10::cuda::getDefaultCUDAStream(0), c10::cuda::getCurrentCUDAStream(0));
-  change_stream(/*use_default_stream=*/true);
-  EXPECT_EQ(
-      c10::cuda::getDefaultCUDAStream(0), c10::cuda::getCurrentCUDAStream(0));
+  HostIrEvaluator hie(std::move(hic));
+  for (auto cuda_stream :
+       {c10::cuda::getDefaultCUDAStream(0), c10::cuda::getStreamFromPool()}) {
+    setCurrentCUDAStream(cuda_stream);
+    hie.runWithInput({});
+    EXPECT_EQ(cuda_stream, c10::cuda::getCurrentCUDAStream(0));
+    EXPECT_EQ(cuda_stream, hie.getCudaStreams().at(default_stream));
+  }
 }
 
 TEST_F(StreamTest, HostIrGetCurrentStream) {
@@ -588,6 +582,35 @@ TEST_F(StreamTest, HostIrGetCurrentStream) {
   EXPECT_EQ(cuda_stream, c10::cuda::getCurrentCUDAStream(0));
 }
 
+// With EnableOption::HostIrTape, the tape compiled on the first run resolves
+// the static streams ahead of time but still captures the current stream at
+// every run.
+TEST_F(StreamTest, HostIrTape) {
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::HostIrTape);
+
+  auto hic = std::make_unique<HostIrContainer>();
+  FusionGuard fg(hic.get());
+  auto get_stream = IrBuilder::create<GetCurrentStream>();
+  auto current_stream = get_stream->stream();
+  auto other_stream = IrBuilder::create<Stream>();
+  hic->pushBackTopLevelExprs(get_stream);
+  hic->pushBackTopLevelExprs(IrBuilder::create<SetCurrentStream>(other_stream));
+  hic->pushBackTopLevelExprs(IrBuilder::create<Synchronize>(current_stream));
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<SetCurrentStream>(current_stream));
+
+  HostIrEvaluator hie(std::move(hic));
+  for (int64_t run = 0; run < 2; run++) {
+    auto cuda_stream = c10::cuda::getStreamFromPool();
+    setCurrentCUDAStream(cuda_stream);
+    hie.runWithInput({});
+    EXPECT_EQ(cuda_stream, c10::cuda::getCurrentCUDAStream(0));
+  }
+  // The default stream, the stream captured by the last run and other_stream
+  EXPECT_EQ(hie.getCudaStreams().size(), 3);
+}
+
 TEST_F(StreamTest, ByIndex) {
   constexpr int64_t kStreamIndex1 = 2;
   constexpr int64_t kStreamIndex2 = 3;
@@ -608,6 +631,7 @@ TEST_F(StreamTest, ByIndex) {
   hic->pushBackTopLevelExprs(IrBuilder::create<SetCurrentStream>(stream2));
 
   HostIrEvaluator hie(std::move(hic));
+  setCurrentCUDAStream(c10::cuda::getDefaultCUDAStream(0));
   hie.runWithInput({});
 
   const std::unordered_map<
@@ -1231,6 +1255,44 @@ TEST_F(AllocationTest, inHostForLoop) {
   EXPECT_EQ(sizes, outputs[0].as<at::Tensor>().sizes());
 }
 
+TEST_F(AllocationTest, MemoryPlan) {
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::HostIrMemoryPlan);
+  constexpr int64_t kSize = 1024;
+
+  auto hic = std::make_unique<HostIrContainer>();
+  FusionGuard fg(hic.get());
+
+  TensorView* x = makeContigConcreteTensor({kSize});
+  hic->addInput(x);
+  // t0 and t2 are not live at the same time, so they can share memory
+  std::vector<TensorView*> tvs;
+  TensorView* prev = x;
+  for (auto i : arange(4)) {
+    TensorView* tv = makeContigConcreteTensor({kSize});
+    tv->setMemoryType(MemoryType::Global);
+    hic->pushBackTopLevelExprs(
+        IrBuilder::create<kir::Allocate>(tv, MemoryType::Global));
+    hic->pushBackTopLevelExprs(IrBuilder::create<BinaryOp>(
+        i % 2 == 0 ? BinaryOpType::Add : BinaryOpType::Mul, tv, prev, x));
+    tvs.push_back(tv);
+    prev = tv;
+  }
+  hic->addOutput(tvs.back());
+
+  HostIrEvaluator hie(std::move(hic));
+
+  auto options = at::TensorOptions().device(at::kCUDA, 0);
+  at::Tensor x_aten = at::randn({kSize}, options);
+  at::Tensor expected = ((x_aten + x_aten) * x_aten + x_aten) * x_aten;
+  // The first run observes the sizes and the second one uses the plan
+  for ([[maybe_unused]] auto run : arange(2)) {
+    KernelArgumentHolder outputs = hie.runWithInput({{x, x_aten}});
+    EXPECT_TRUE(outputs[0].as<at::Tensor>().equal(expected));
+  }
+  EXPECT_EQ(hie.workspaceBytes(), 2 * kSize * sizeof(float));
+}
+
 using HirAliasSelectHostIrTest = NVFuserTest;
 
 TEST_F(HirAliasSelectHostIrTest, SelectingTensor) {
@@ -3129,4 +3129,53 @@ TEST_F(IdModelTest, BroadcastOnlyNoLoopPromotion) {
       << promotion_id->toString();
 }
 
+// Transforms appended after building the graphs are added to them
+// incrementally, and the result must match a fresh build
+TEST_F(IdModelTest, UpdateWithNewTransforms) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = set(tv0);
+  auto tv2 = broadcast(tv1, {false, true, false});
+  auto tv3 = makeSymbolicTensor(3);
+  fusion.addInput(tv3);
+  auto tv4 = add(tv2, tv3);
+  fusion.addOutput(tv4);
+
+  IdModel id_model(&fusion, /*build_graphs=*/false);
+  id_model.buildBroadcastGraph();
+  id_model.buildPermissiveGraph();
+
+  tv4->merge(1)->split(0, 4);
+  TransformPropagatorWithCheck propagator(tv4);
+  MaxLogicalDomainInfoSpanningTree(tv4).traverse(&propagator);
+
+  EXPECT_TRUE(id_model.updateWithNewTransforms());
+  EXPECT_FALSE(id_model.hasIdGraph(IdMappingMode::PERMISSIVE));
+
+  IdModel ref_model(&fusion, /*build_graphs=*/false);
+  ref_model.buildBroadcastGraph();
+
+  for (auto mode : {IdMappingMode::EXACT, IdMappingMode::BROADCAST}) {
+    const ValGraph& graph = id_model.idGraph(mode);
+    const ValGraph& ref_graph = ref_model.idGraph(mode);
+    EXPECT_EQ(
+        graph.disjointValSets().size(), ref_graph.disjointValSets().size());
+    EXPECT_EQ(
+        graph.disjointExprSets().size(), ref_graph.disjointExprSets().size());
+    for (const ValGroup& ref_group :
+         ref_graph.disjointValSets().disjointSets()) {
+      EXPECT_EQ(graph.toGroup(ref_group->front())->set(), ref_group->set())
+          << "Mismatched group of " << ref_group->front()->toString()
+          << " in " << mode;
+    }
+  }
+
+  // A new tensor requires building a new model
+  tv1->cacheAfter();
+  EXPECT_FALSE(id_model.updateWithNewTransforms());
+}
+
 } // namespace nvfuser
@@ -857,4 +857,43 @@ TEST_F(NVFuserTest, IndexSelectVectorization3DCase1) {
   testValidate(&fusion, outputs, {t0, t1}, __LINE__, __FILE__);
 }
 
+// Embedding lookup, where each index selects a whole row of the table
+TEST_F(NVFuserTest, IndexSelectEmbeddingRowGather) {
+  auto fusion_ptr = std::make_unique<Fusion>();
+  Fusion& fusion = *fusion_ptr.get();
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeContigTensor(2, DataType::BFloat16);
+  fusion.addInput(tv0);
+  auto tv1 = makeContigTensor(1, DataType::Int);
+  fusion.addInput(tv1);
+
+  auto tv2 = indexSelect(tv0, 0, tv1);
+  fusion.addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA, 0);
+  auto options_i = at::TensorOptions().dtype(at::kLong).device(at::kCUDA, 0);
+
+  std::vector<int64_t> shape1({32000, 4096});
+  std::vector<int64_t> shape2({8192});
+  auto t0 = at::randn(shape1, options);
+  auto t1 = at::randint(0, shape1[0], shape2, options_i);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+
+  // lookup tv [ 32000, 4096 ]
+  // index  tv [ 8192 ]
+  // output tv [ 8192, 4096 ]
+  // The rows are split from the indices, so each index is loaded once per row
+  // and the row copy is vectorized.
+  checkIndexSelectVectorization(executor_cache, 8, true, false);
+  const auto& heuristic_param = executor_cache.getMostRecentKernelRuntime()
+                                    ->schedulerHeuristics()
+                                    ->heuristicsList()
+                                    .front();
+  EXPECT_EQ(heuristic_param->as<PointwiseParams>()->break_point, 1);
+  testValidate(&fusion, outputs, {t0, t1}, __LINE__, __FILE__);
+}
+
 } // namespace nvfuser
@@ -34,7 +34,7 @@ TEST_F(LoopRotationTest, RotateInner) {
 
   const std::string expected_kernel = R"(
 // Codegen generated code
-__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 2> T4) {
+__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 0> T4) {
   NVFUSER_DEFINE_MAGIC_ZERO;
   #pragma unroll 1
   for(nvfuser_index_t i0 = 0LL; i0 < T0.logical_size[0LL]; ++i0) {
@@ -101,7 +101,7 @@ TEST_F(LoopRotationTest, RotateOuter) {
 
   const std::string expected_kernel = R"(
 // Codegen generated code
-__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 2> T4) {
+__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 0> T4) {
   NVFUSER_DEFINE_MAGIC_ZERO;
   Array<float, 3LL, 1> T1;
   Array<float, 3LL, 1> T2;
@@ -199,7 +199,7 @@ TEST_F(LoopRotationTest, NonDivisibleSplit) {
 
   const std::string expected_kernel = R"(
 // Codegen generated code
-__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 2> T4) {
+__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 0> T4) {
   NVFUSER_DEFINE_MAGIC_ZERO;
   nvfuser_index_t i0;
   i0 = T0.logical_size[0LL] * T0.logical_size[1LL];
@@ -306,7 +306,7 @@ TEST_F(LoopRotationTest, CircularBuffered) {
 
   const std::string expected_kernel = R"(
 // Codegen generated code
-__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 2> T4) {
+__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 0> T4) {
   NVFUSER_DEFINE_MAGIC_ZERO;
   nvfuser_index_t i0;
   i0 = 4LL * T0.alloc_stride[0LL];
@@ -418,7 +418,7 @@ TEST_F(LoopRotationTest, SelectCircularBufferLoad) {
 
   const std::string expected_kernel = R"(
 // Codegen generated code
-__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 2> T4) {
+__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 0> T4) {
   NVFUSER_DEFINE_MAGIC_ZERO;
   nvfuser_index_t i0;
   i0 = 4LL * T0.alloc_stride[0LL];
@@ -570,7 +570,7 @@ TEST_F(LoopRotationTest, MultipleCircularBuffer) {
   const std::string expected_kernel = R"(
 // Codegen generated code
 
-__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 2> T3) {
+__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 0> T3) {
   alignas(16) extern __shared__ char array[];
   const unsigned smem_offset = 0;
   NVFUSER_DEFINE_MAGIC_ZERO;
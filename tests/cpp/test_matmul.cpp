@@ -34,6 +34,7 @@
 #include <runtime/fusion_executor_cache.h>
 #include <scheduler/all_schedulers.h>
 #include <scheduler/matmul.h>
+#include <scheduler/matmul_utils.h>
 #include <scheduler/mma_utils.h>
 #include <scheduler/reduction_utils.h>
 #include <scheduler/tools/inlining.h>
@@ -5673,4 +5674,339 @@ TEST_F(HopperMatmulTest, HSS_NT_SplitKTMAStore) {
       cg_outputs[0].as<at::Tensor>(), out_ref, 1e-6 * K, 1e-6 * K));
 }
 
+// Distribute the K loop of each output tile across two CTAs along BIDz, whose
+// partial results are summed through a global workspace.
+TEST_F(HopperMatmulTest, HSS_NT_StreamKDistributeStages) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  constexpr int64_t M = 2048, N = 1024, K = 8192;
+  const auto dtype = DataType::Half;
+
+  auto tv0 = makeContigConcreteTensor({-1, -1, 1}, dtype); // K, M
+  auto tv1 = makeContigConcreteTensor({-1, 1, -1}, dtype); // K, N
+  fusion.addInput(tv0);
+  fusion.addInput(tv1);
+
+  auto tv2 = fusedMultiplySum(tv0, tv1, {0});
+
+  // Reorder the accumulator as [M, N, K]
+  // [K, M, N] -> [M, N, K]
+  tv2->reorder({{-3, -1}});
+  tv2->commitLeafToLogical();
+
+  fusion.addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kHalf).device(at::kCUDA);
+  auto t0 = at::randn({K, M, 1}, options);
+  auto t1 = at::randn({K, 1, N}, options);
+  auto out_ref =
+      at::matmul(t0.squeeze().t().to(at::kFloat), t1.squeeze().to(at::kFloat));
+
+  MatmulParams mparams = defaultHopperParams();
+  mparams.tiling_strategy =
+      MatmulParams::TilingStrategy::DistributeStagesAcrossSMs;
+  mparams.splitk_factor = 2;
+
+  SchedulerEntry::makeSchedulerInstance(SchedulerType::Matmul)
+      ->schedule(&fusion, &mparams);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0, t1});
+  auto cg_outputs = ke.run({t0, t1});
+  EXPECT_EQ(ke.lastLaunchParams().gdimz(), 2);
+
+  // Relax tolerance for larger sum due to large K
+  NVF_CHECK(at::allclose(
+      cg_outputs[0].as<at::Tensor>(), out_ref, 1e-6 * K, 1e-6 * K));
+}
+
+// Scale the rows of A before the matmul. The prologue is computed by the math
+// warp groups and written to swizzled shared memory that is read by wgmma.
+TEST_F(HopperMatmulTest, HSH_NN_RowScalePrologue) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  constexpr int64_t M = 2048, N = 2048, K = 1024;
+  const auto dtype = DataType::BFloat16;
+
+  auto tv0 = makeContigTensor(2, dtype); // M, K
+  auto tv1 = makeContigTensor(2, dtype); // K, N
+  auto tv2 = makeContigTensor(1, DataType::Float); // M
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addInput(tv2);
+
+  auto tv3 = mul(castOp(DataType::Float, tv0), broadcast(tv2, {false, true}));
+  auto tv4 = matmul(castOp(dtype, tv3), tv1);
+  fusion->addOutput(tv4);
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA);
+  auto t0 = at::randn({M, K}, options);
+  auto t1 = at::randn({K, N}, options);
+  auto t2 = at::randn({M}, options.dtype(at::kFloat));
+
+  EnableOptionsGuard eog;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmul);
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmulPrologue);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1, t2});
+
+  const FusionKernelRuntime* runtime =
+      executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  EXPECT_EQ(
+      runtime->schedulerHeuristics()->heuristicsList().at(0)->scheduler_type,
+      SchedulerType::Matmul);
+
+  auto out_ref = at::matmul(
+      (t0.to(at::kFloat) * t2.unsqueeze(1)).to(at::kBFloat16).to(at::kFloat),
+      t1.to(at::kFloat));
+  NVF_CHECK(at::allclose(
+      outputs[0].as<at::Tensor>().to(at::kFloat), out_ref, 1e-2, 1e-2));
+}
+
+// Weights quantized to fp8 with a scale per group of G elements along K are
+// dequantized in the prologue, so they are loaded from global memory in fp8.
+// The scales are expanded to [N, K] with a reshape of their group dim.
+TEST_F(HopperMatmulTest, HSH_NT_GroupScaledFp8WeightPrologue) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  constexpr int64_t M = 2048, N = 2048, K = 1024, G = 128;
+  const auto dtype = DataType::BFloat16;
+
+  auto tv0 = makeContigTensor(2, dtype); // M, K
+  auto tv1 = makeContigTensor(2, DataType::Float8_e4m3fn); // N, K
+  auto tv2 = makeContigConcreteTensor({N, K / G}, DataType::Float);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addInput(tv2);
+
+  auto tv3 = broadcast(tv2, {false, false, true});
+  auto tv4 = expand(
+      tv3,
+      {IrBuilder::create<Val>(N),
+       IrBuilder::create<Val>(K / G),
+       IrBuilder::create<Val>(G)});
+  auto tv5 = reshape(tv4, {N, K / G, G}, {N, K});
+  auto tv6 = mul(castOp(DataType::Float, tv1), tv5);
+  auto tv7 = linear(tv0, castOp(dtype, tv6));
+  fusion->addOutput(tv7);
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA);
+  auto t0 = at::randn({M, K}, options);
+  auto t1 = at::randn({N, K}, options.dtype(at::kFloat))
+                .to(at::kFloat8_e4m3fn);
+  auto t2 = at::rand({N, K / G}, options.dtype(at::kFloat));
+
+  EnableOptionsGuard eog;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmul);
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmulPrologue);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1, t2});
+
+  const FusionKernelRuntime* runtime =
+      executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  EXPECT_EQ(
+      runtime->schedulerHeuristics()->heuristicsList().at(0)->scheduler_type,
+      SchedulerType::Matmul);
+
+  auto w_ref = (t1.to(at::kFloat) * t2.repeat_interleave(G, 1))
+                   .to(at::kBFloat16)
+                   .to(at::kFloat);
+  auto out_ref = at::linear(t0.to(at::kFloat), w_ref);
+  NVF_CHECK(at::allclose(
+      outputs[0].as<at::Tensor>().to(at::kFloat), out_ref, 1e-2, 1e-2));
+}
+
+// The SMs reserved for concurrent kernels, e.g., communications, bound the
+// number of CTAs of the persistent kernel
+TEST_F(HopperMatmulTest, HSH_NT_ReservedSMs) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  constexpr int64_t M = 4096, N = 4096, K = 1024;
+  constexpr int64_t reserved_sms = 16;
+  auto tv0 = makeContigTensor(2, DataType::BFloat16);
+  auto tv1 = makeContigTensor(2, DataType::BFloat16);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  auto tv2 = matmul(tv0, tv1);
+  fusion->addOutput(tv2);
+  fusion->manage(matmul_utils::kReservedSMsKey, reserved_sms);
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA);
+  auto t0 = at::randn({M, K}, options);
+  auto t1 = at::randn({K, N}, options);
+
+  EnableOptionsGuard eog;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmul);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+
+  const FusionKernelRuntime* runtime =
+      executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const auto* mparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<MatmulParams>();
+  ASSERT_EQ(
+      mparams->tiling_strategy,
+      MatmulParams::TilingStrategy::DistributeTilesAcrossSMs);
+  const int64_t num_sms =
+      at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
+  EXPECT_GT(mparams->sm_budget, 0);
+  EXPECT_LE(mparams->sm_budget, num_sms - reserved_sms);
+
+  auto out_ref = at::matmul(t0.to(at::kFloat), t1.to(at::kFloat));
+  NVF_CHECK(at::allclose(
+      outputs[0].as<at::Tensor>().to(at::kFloat), out_ref, 1e-2, 1e-2));
+}
+
+// The operand tiles shared by the CTAs of a cluster are multicast by TMA.
+// With M parallelized on BIDx, B is the same for the two CTAs of a {2, 1, 1}
+// cluster.
+TEST_F(HopperMatmulTest, HSH_TN_MulticastOperands) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  constexpr int64_t M = 2048, N = 2048, K = 8192;
+  const auto dtype = DataType::Half;
+
+  auto tv0 = makeContigConcreteTensor({-1, 1, -1}, dtype); // M, K
+  auto tv1 = makeContigConcreteTensor({1, -1, -1}, dtype); // N, K
+  fusion.addInput(tv0);
+  fusion.addInput(tv1);
+
+  auto tv2 = fusedMultiplySum(tv0, tv1, {-1});
+
+  auto tv3 = castOp(DataType::Half, tv2);
+  fusion.addOutput(tv3);
+
+  auto options = at::TensorOptions().dtype(at::kHalf).device(at::kCUDA);
+  auto t0 = at::randn({M, 1, K}, options);
+  auto t1 = at::randn({1, N, K}, options);
+  auto out_ref = at::matmul(t0.squeeze(), t1.squeeze().t()).to(at::kHalf);
+
+  MatMulTileOptions gemm_tile;
+  gemm_tile.cta_tile = GemmTile(128, 256, 64);
+  gemm_tile.warp_tile = GemmTile(64, 256, 64);
+
+  MatmulParams mparams;
+  mparams.supported_vec_size = {8, 8, 8};
+  mparams.mma_macro = MmaMacro::Hopper_64_256_16;
+  mparams.tile_sizes = gemm_tile;
+  mparams.cta_order = MatmulParams::TileRasterizationOrder::ColumnMajor;
+  mparams.async_gmem_load_operands = true;
+  mparams.circular_buffering_strategy =
+      MatmulParams::CircularBufferingStrategy::WarpSpecialized;
+  mparams.tiling_strategy = MatmulParams::TilingStrategy::OneTilePerCTA;
+  mparams.circular_buffer_options.circular_buffer_smem_write = true;
+  mparams.circular_buffer_options.circular_buffer_smem_read = false;
+  mparams.circular_buffer_options.smem_circular_buffer_stage = 4;
+  mparams.circular_buffer_options.smem_circular_buffer_prefetch_gap = 1;
+  mparams.splitk_factor = 1;
+  mparams.use_smem_epilogue = true;
+  mparams.cluster_dims = {2, 1, 1};
+  mparams.multicast_operands = true;
+
+  SchedulerEntry::makeSchedulerInstance(SchedulerType::Matmul)
+      ->schedule(&fusion, &mparams);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0, t1});
+  const auto& multicast_dims =
+      ke.compiledKernel()->kernel()->summary().tma_multicast_dims;
+  ASSERT_EQ(multicast_dims.size(), 1);
+  EXPECT_EQ(multicast_dims.begin()->second, 1);
+  EXPECT_THAT(
+      ke.compiledKernel()->kernelString(),
+      ::testing::HasSubstr("Hopper::cpAsyncBulkTensorTileG2SMulticast<1>"));
+
+  auto cg_outputs = ke.run({t0, t1});
+  NVF_CHECK(at::allclose(
+      cg_outputs[0].as<at::Tensor>(), out_ref, 1e-6 * K, 1e-6 * K));
+}
+
+// In a persistent kernel, the TMA store of the output of a tile is waited for
+// before the epilogue of the next tile instead of at the end of the tile, so
+// the store overlaps with the mainloop of the next tile.
+TEST_F(HopperMatmulTest, HSH_NT_OverlapEpilogueStorePersistent) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  constexpr int64_t M = 2048, N = 2048, K = 8192;
+  const auto dtype = DataType::Half;
+
+  auto tv0 = makeContigConcreteTensor({-1, 1, -1}, dtype); // M, K
+  auto tv1 = makeContigConcreteTensor({1, -1, -1}, dtype); // N, K
+  fusion.addInput(tv0);
+  fusion.addInput(tv1);
+
+  auto tv2 = fusedMultiplySum(tv0, tv1, {-1});
+
+  auto tv3 = castOp(DataType::Half, tv2);
+  fusion.addOutput(tv3);
+
+  auto options = at::TensorOptions().dtype(at::kHalf).device(at::kCUDA);
+  auto t0 = at::randn({M, 1, K}, options);
+  auto t1 = at::randn({1, N, K}, options);
+  auto out_ref = at::matmul(t0.squeeze(), t1.squeeze().t()).to(at::kHalf);
+
+  MatMulTileOptions gemm_tile;
+  gemm_tile.cta_tile = GemmTile(128, 256, 64);
+  gemm_tile.warp_tile = GemmTile(64, 256, 64);
+
+  MatmulParams mparams;
+  mparams.supported_vec_size = {8, 8, 8};
+  mparams.mma_macro = MmaMacro::Hopper_64_256_16;
+  mparams.tile_sizes = gemm_tile;
+  mparams.cta_order = MatmulParams::TileRasterizationOrder::ColumnMajor;
+  mparams.async_gmem_load_operands = true;
+  mparams.circular_buffering_strategy =
+      MatmulParams::CircularBufferingStrategy::WarpSpecialized;
+  mparams.tiling_strategy =
+      MatmulParams::TilingStrategy::DistributeTilesAcrossSMs;
+  mparams.circular_buffer_options.circular_buffer_smem_write = true;
+  mparams.circular_buffer_options.circular_buffer_smem_read = false;
+  mparams.circular_buffer_options.smem_circular_buffer_stage = 3;
+  mparams.circular_buffer_options.smem_circular_buffer_prefetch_gap = 1;
+  mparams.splitk_factor = 1;
+  mparams.use_smem_epilogue = true;
+  mparams.overlap_epilogue_store = true;
+
+  SchedulerEntry::makeSchedulerInstance(SchedulerType::Matmul)
+      ->schedule(&fusion, &mparams);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0, t1});
+
+  // The wait for the stores precedes their commit in the tile loop
+  Expr* first_store_sync = nullptr;
+  for (Expr* expr : ir_utils::flattenScopedExprs(
+           ke.compiledKernel()->kernel()->topLevelExprs())) {
+    if ((expr->isA<kir::AsyncWait>() &&
+         expr->as<kir::AsyncWait>()->asyncOpType() ==
+             AsyncOpType::CpAsyncBulk) ||
+        (expr->isA<kir::AsyncCommit>() &&
+         expr->as<kir::AsyncCommit>()->asyncOpType() ==
+             AsyncOpType::CpAsyncBulk)) {
+      first_store_sync = expr;
+      break;
+    }
+  }
+  ASSERT_NE(first_store_sync, nullptr);
+  EXPECT_TRUE(first_store_sync->isA<kir::AsyncWait>());
+
+  auto cg_outputs = ke.run({t0, t1});
+  NVF_CHECK(at::allclose(
+      cg_outputs[0].as<at::Tensor>(), out_ref, 1e-6 * K, 1e-6 * K));
+}
+
 } // namespace nvfuser
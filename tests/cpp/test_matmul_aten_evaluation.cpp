@@ -6,6 +6,7 @@
  */
 // clang-format on
 #include <csrc/exceptions.h>
+#include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
 #include <fusion.h>
@@ -368,4 +369,151 @@ INSTANTIATE_TEST_SUITE_P(
         testing::Values(Sizes({n, 1})),
         testing::Values(Sizes({n}))));
 
+using GroupedMmaTest = NVFuserTest;
+
+// Grouped GEMM of a Mixture-of-Experts layer, where the rows of the tokens
+// are grouped by the expert they are routed to. All groups are computed by a
+// single grouped kernel that reads the group offsets from device memory, and
+// the epilogue is fused into a separate pointwise kernel.
+TEST_F(GroupedMmaTest, GroupedMByOffsetsWithEpilogue) {
+#if NVF_TORCH_VERSION_NO_LESS(2, 8, 0)
+  NVFUSER_TEST_CUDA_ARCH_RANGE_GUARD(9, 0, 10, 0);
+
+  constexpr int64_t g = 4, m = 512, k = 256, n = 128;
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* mat1 = makeContigTensor(2, DataType::BFloat16);
+  TensorView* mat2 = makeContigTensor(3, DataType::BFloat16);
+  TensorView* offsets = makeContigTensor(1, DataType::Int32);
+  fusion->addInput(mat1);
+  fusion->addInput(mat2);
+  fusion->addInput(offsets);
+
+  TensorView* out = grouped_mm(mat1, mat2, offsets);
+  out = relu(castOp(DataType::Float, out));
+  fusion->addOutput(out);
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA);
+  at::Tensor t0 = at::randn({m, k}, options);
+  // at::_grouped_mm expects the k dimension of mat2 to be the fastest
+  at::Tensor t1 = at::randn({g, n, k}, options).transpose(-1, -2);
+  at::Tensor t2 = at::tensor({64, 192, 320, 512}, options.dtype(at::kInt));
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1, t2});
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_THAT(
+      runtime->fusionSegments()->groups(),
+      testing::UnorderedElementsAre(
+          HeuristicIs(SchedulerType::ExprEval),
+          HeuristicIs(SchedulerType::PointWise)));
+
+  std::vector<at::Tensor> group_outs;
+  int64_t start = 0;
+  for (auto i : arange(g)) {
+    const int64_t end = t2[i].item<int64_t>();
+    group_outs.push_back(
+        at::matmul(t0.slice(0, start, end), t1[i]).to(at::kFloat));
+    start = end;
+  }
+  at::Tensor expected = at::relu(at::cat(group_outs));
+  EXPECT_TRUE(at::allclose(
+      outputs[0].as<at::Tensor>(), expected, /*rtol=*/1e-2, /*atol=*/1e-2));
+#else
+  GTEST_SKIP() << "GroupedMmaOp requires PyTorch 2.8 or newer";
+#endif
+}
+
+using LinearActivationTest = NVFuserTest;
+
+// Linear layers with a bias followed by a GELU or a ReLU run as a single
+// segment, with the bias and the activation in the epilogue of the matmul
+TEST_F(LinearActivationTest, BiasGeluAndRelu) {
+  constexpr int64_t b = 4, m = 128, k = 256, n = 512;
+
+  for (bool gelu : {true, false}) {
+    auto fusion = std::make_unique<Fusion>();
+    FusionGuard fg(fusion.get());
+
+    TensorView* in = makeContigTensor(3, DataType::BFloat16);
+    TensorView* weight = makeContigTensor(2, DataType::BFloat16);
+    TensorView* bias = makeContigTensor(1, DataType::BFloat16);
+    fusion->addInput(in);
+    fusion->addInput(weight);
+    fusion->addInput(bias);
+
+    TensorView* out = castOp(DataType::Float, linear(in, weight, bias));
+    out = gelu ? tanh_gelu(out) : relu(out);
+    out = castOp(DataType::BFloat16, out);
+    fusion->addOutput(out);
+
+    auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA);
+    at::Tensor t0 = at::randn({b, m, k}, options);
+    at::Tensor t1 = at::randn({n, k}, options);
+    at::Tensor t2 = at::randn({n}, options);
+
+    FusionExecutorCache executor_cache(std::move(fusion));
+    auto outputs = executor_cache.runFusionWithInputs({t0, t1, t2});
+
+    FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+    EXPECT_THAT(
+        runtime->fusionSegments()->groups(),
+        testing::ElementsAre(HeuristicIs(SchedulerType::ExprEval)));
+
+    at::Tensor expected = at::linear(t0, t1, t2).to(at::kFloat);
+    expected = gelu ? at::gelu(expected, "tanh") : at::relu(expected);
+    EXPECT_TRUE(at::allclose(
+        outputs[0].as<at::Tensor>().to(at::kFloat),
+        expected,
+        /*rtol=*/1e-2,
+        /*atol=*/1e-1));
+  }
+}
+
+using MatmulPlanCacheTest = NVFuserTest;
+
+// Matmuls are run with a cuBLASLt plan per problem, which is reused by the
+// matmuls of the same sizes and layouts
+TEST_F(MatmulPlanCacheTest, ReusePlans) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::MatmulPlanCache);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* a = makeSymbolicTensor(2, DataType::Half);
+  TensorView* b = makeSymbolicTensor(2, DataType::Half);
+  fusion->addInput(a);
+  fusion->addInput(b);
+  fusion->addOutput(matmul(a, b));
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kHalf).device(at::kCUDA);
+  auto run = [&](const at::Tensor& t0, const at::Tensor& t1) {
+    auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+    EXPECT_TRUE(at::allclose(
+        outputs[0].as<at::Tensor>(),
+        at::matmul(t0, t1),
+        /*rtol=*/1e-2,
+        /*atol=*/1e-2));
+    const auto& executors =
+        executor_cache.getMostRecentKernelRuntime()->executors();
+    EXPECT_EQ(executors.size(), 1);
+    const MatmulPlanCache* plans =
+        executors.front()->as<ExprEvalExecutor>()->matmulPlanCache();
+    EXPECT_NE(plans, nullptr);
+    return plans == nullptr ? 0 : plans->numPlans();
+  };
+
+  at::Tensor t0 = at::randn({128, 64}, options);
+  at::Tensor t1 = at::randn({64, 256}, options);
+  EXPECT_EQ(run(t0, t1), 1);
+  EXPECT_EQ(run(at::randn({128, 64}, options), t1), 1);
+  // Column-major operands are another problem
+  EXPECT_EQ(run(t0, at::randn({256, 64}, options).t()), 2);
+}
+
 } // namespace nvfuser
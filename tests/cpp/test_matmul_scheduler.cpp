@@ -17,6 +17,7 @@
 #include <scheduler/all_schedulers.h>
 #include <scheduler/matmul_heuristic_plugin.h>
 #include <scheduler/matmul_heuristic_plugin_api.h>
+#include <scheduler/matmul_utils.h>
 #include <scheduler/mma_utils.h>
 #include <tests/cpp/utils.h>
 #include <tests/cpp/validator.h>
@@ -3249,6 +3250,130 @@ TEST_F(MatmulSchedulerTest, OperandOrderIssue2434) {
   NVF_CHECK(at::allclose(cg_outputs[0].as<at::Tensor>(), tref, 0.0001, 0.0001));
 }
 
+// A tall-skinny matmul, like the GEMMs of decoding, has fewer output tiles
+// than SMs, so the default heuristic splits its long K loop across CTAs
+TEST_F(MatmulSchedulerTest, SplitKTallSkinny) {
+  NVFUSER_TEST_CUDA_ARCH_RANGE_GUARD(8, 0, 9, 0);
+  EnableOptionsGuard eog;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmul);
+
+  const int64_t M = 16, N = 1024, K = 8192;
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeContigConcreteTensor({-1, -1}, DataType::Half);
+  auto tv1 = makeContigConcreteTensor({-1, -1}, DataType::Half);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  auto tv2 = matmul(tv0, tv1);
+  fusion->addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kHalf).device(at::kCUDA);
+  at::Tensor t0 = at::randn({M, K}, options);
+  at::Tensor t1 = at::randn({K, N}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const MatmulParams* params = runtime->schedulerHeuristics()
+                                   ->heuristicsList()
+                                   .front()
+                                   ->as<MatmulParams>();
+  EXPECT_GT(params->splitk_factor, 1);
+
+  auto tref = at::matmul(t0.to(at::kFloat), t1.to(at::kFloat));
+  NVF_CHECK(at::allclose(
+      outputs[0].as<at::Tensor>().to(at::kFloat), tref, 1e-6 * K, 1e-6 * K));
+}
+
+// A mul-sum matmul with a small M is computed as a GEMV by the reduction
+// scheduler, while the same fusion with a large M uses the matmul scheduler
+TEST_F(MatmulSchedulerTest, SmallMMulSumScheduledAsReduction) {
+  NVFUSER_TEST_CUDA_ARCH_RANGE_GUARD(8, 0, 9, 0);
+  const int64_t N = 4096, K = 4096;
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeContigTensor(2, DataType::BFloat16); // M, K
+  auto tv1 = makeContigTensor(2, DataType::BFloat16); // N, K
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  auto tv2 = broadcast(tv0, {false, true, false});
+  auto tv3 = broadcast(tv1, {true, false, false});
+  auto tv4 = sum(mul(tv2, tv3), {-1});
+  fusion->addOutput(tv4);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA);
+  for (const int64_t M : {matmul_utils::kMaxGemvRows, (int64_t)512}) {
+    at::Tensor t0 = at::randn({M, K}, options);
+    at::Tensor t1 = at::randn({N, K}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+
+    FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+    EXPECT_FALSE(runtime->isSegmented());
+    EXPECT_EQ(
+        isSchedulerInUse(runtime, SchedulerType::Reduction),
+        M <= matmul_utils::kMaxGemvRows);
+
+    auto tref = at::linear(t0.to(at::kFloat), t1.to(at::kFloat));
+    NVF_CHECK(at::allclose(
+        outputs[0].as<at::Tensor>(), tref, 1e-6 * K, 1e-6 * K));
+  }
+}
+
+// The default heuristic of Blackwell uses a 128-row tcgen05 macro, keeps the
+// accumulators of the CTA tile within the 512 columns of TMem and pairs the
+// CTAs of a cluster along M
+TEST_F(MatmulSchedulerTest, BlackwellDefaultHeuristic) {
+  NVFUSER_TEST_CUDA_ARCH_RANGE_GUARD(10, 0, 11, 0);
+  EnableOptionsGuard eog;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FuseMatmul);
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::BlackwellMatmulHeuristic);
+
+  const int64_t M = 2048, N = 2048, K = 4096;
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeContigConcreteTensor({-1, -1}, DataType::BFloat16);
+  auto tv1 = makeContigConcreteTensor({-1, -1}, DataType::BFloat16);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  auto tv2 = matmul(tv0, tv1);
+  fusion->addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA);
+  at::Tensor t0 = at::randn({M, K}, options);
+  at::Tensor t1 = at::randn({K, N}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const MatmulParams* params = runtime->schedulerHeuristics()
+                                   ->heuristicsList()
+                                   .front()
+                                   ->as<MatmulParams>();
+  EXPECT_TRUE(isBlackwell1CTA(params->mma_macro));
+  EXPECT_EQ(getM(params->mma_macro), 128);
+  const GemmTile& cta_tile = params->tile_sizes.cta_tile;
+  EXPECT_LE(cta_tile.m / 128 * cta_tile.n, 512);
+  EXPECT_EQ(
+      params->cta_order, MatmulParams::TileRasterizationOrder::ColumnMajor);
+  EXPECT_EQ(params->cluster_dims.x, 2);
+
+  auto tref = at::matmul(t0.to(at::kFloat), t1.to(at::kFloat));
+  NVF_CHECK(at::allclose(
+      outputs[0].as<at::Tensor>().to(at::kFloat), tref, 1e-6 * K, 1e-6 * K));
+}
+
 // Matmul test for Hopper+ (Hopper, Blackwell)
 
 using HopperPlusMatmulSchedulerTestParams = std::tuple<
@@ -19,6 +19,8 @@
 #include <ops/arith.h>
 #include <ops/utils.h>
 #include <options.h>
+#include <runtime/fusion_executor_cache.h>
+#include <runtime/l2_persistence.h>
 #include <scheduler/cache_policy_refiner.h>
 #include <scheduler/mma_utils.h>
 #include <scheduler/tools/inlining.h>
@@ -176,6 +178,161 @@ TEST_F(MemoryTest, RefineCachePolicy) {
   testValidate(&fusion, actual_outputs, {a, b}, {c}, __LINE__, __FILE__);
 }
 
+// With L2 persistence, the expanded operand is loaded with an evict_last
+// policy instead of ld.ca.
+TEST_F(MemoryTest, RefineCachePolicyEvictLast) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(8, 0);
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::L2Persistence);
+
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv_a = makeContigTensor(2);
+  TensorView* tv_b = makeContigTensor(1);
+  fusion.addInput(tv_a);
+  fusion.addInput(tv_b);
+  TensorView* tv_a2 = set(tv_a);
+  TensorView* tv_b2 = set(tv_b);
+  TensorView* tv_c = add(tv_a2, tv_b2);
+  TensorView* tv_c2 = set(tv_c);
+  fusion.addOutput(tv_c2);
+
+  tv_a2->merge(0);
+  tv_a2->split(0, 4);
+  tv_a2->split(0, 32);
+  TransformPropagatorWithCheck propagator(tv_a2);
+  MaxLogicalDomainInfoSpanningTree(tv_a2).traverse(&propagator);
+
+  tv_a2->axis(0)->parallelize(ParallelType::BIDx);
+  tv_a2->axis(1)->parallelize(ParallelType::TIDx);
+  tv_a2->axis(2)->parallelize(ParallelType::Vectorize);
+  tv_b2->axis(2)->parallelize(ParallelType::Vectorize);
+  tv_c2->axis(2)->parallelize(ParallelType::Vectorize);
+
+  refineCachePolicy(&fusion);
+  EXPECT_EQ(
+      tv_b2->definition()->as<LoadStoreOp>()->cacheOp(), CacheOp::EvictLast);
+  EXPECT_EQ(
+      tv_a2->definition()->as<LoadStoreOp>()->cacheOp(), CacheOp::Streaming);
+
+  inlineMost();
+
+  at::Tensor a = at::randn(
+      {1024, 1024}, at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0));
+  at::Tensor b = at::randn(
+      {1024}, at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0));
+  at::Tensor c = a + b;
+
+  KernelExecutor ke;
+  {
+    DebugDumpOptionsGuard debug_dump_options_guard;
+    DebugDumpOptionsGuard::getCurOptions().set(DebugDumpOption::Ptx);
+    ke.compile(&fusion, {a, b});
+  }
+
+  const executor_utils::CudaExecutable* compiled_kernel =
+      ke.compiledKernel()->cudaExecutable().get();
+  std::string ptx(compiled_kernel->ptx.begin(), compiled_kernel->ptx.end());
+  expectMatchCount(ptx, R"(createpolicy\.fractional\.L2::evict_last)", 1);
+  expectMatchCount(ptx, R"(ld\.global\.L2::cache_hint\.v4\.\S+)", 1);
+  expectMatchCount(ptx, R"(ld\.global\.cs\.v4\.\S+)", 1);
+
+  debug() << "Removing " << compiled_kernel->ptx_filename << std::endl;
+  std::filesystem::remove(compiled_kernel->ptx_filename);
+
+  auto actual_outputs = ke.run({a, b});
+  testValidate(&fusion, actual_outputs, {a, b}, {c}, __LINE__, __FILE__);
+}
+
+// The intermediate written by the first segment and read by the second is
+// handed off through the persisting L2 carve-out.
+TEST_F(MemoryTest, L2PersistenceHandoff) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::L2Persistence);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* in = makeContigTensor(2);
+  fusion->addInput(in);
+  TensorView* t0 = relu(in);
+  TensorView* t1 = segment_set(t0);
+  TensorView* t2 = sum(t1, {1});
+  fusion->addOutput(t2);
+
+  at::Tensor in_tensor = at::randn(
+      {1024, 1024}, at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0));
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({in_tensor});
+  testValidate(
+      executor_cache.fusion(), outputs, {in_tensor}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_TRUE(runtime->isSegmented());
+  SegmentedFusion* segmented_fusion = runtime->fusionSegments();
+  std::vector<SegmentedGroup*> run_order;
+  for (SegmentedGroup* group : segmented_fusion->groups()) {
+    if (group->producer_edges.empty()) {
+      run_order.insert(run_order.begin(), group);
+    } else {
+      run_order.push_back(group);
+    }
+  }
+  ASSERT_EQ(run_order.size(), 2);
+
+  const std::vector<std::vector<int64_t>> handoff_outputs =
+      l2_persistence::findHandoffOutputs(segmented_fusion, run_order);
+  ASSERT_EQ(handoff_outputs.size(), 2);
+  ASSERT_EQ(handoff_outputs.at(0).size(), 1);
+  Val* handoff = run_order.at(0)->outputs().at(handoff_outputs.at(0).front());
+  EXPECT_TRUE(run_order.at(1)->inputs().front() == handoff);
+  EXPECT_FALSE(segmented_fusion->completeFusion()->isOutput(handoff));
+  EXPECT_TRUE(handoff_outputs.at(1).empty());
+}
+
+TEST_F(MemoryTest, InlinePtxPatterns) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(8, 0);
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::InlinePtxPatterns);
+
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(1);
+  fusion.addInput(tv0);
+  TensorView* tv1 = set(tv0);
+  TensorView* tv2 = castOp(DataType::BFloat16, tv1);
+  TensorView* tv3 = set(tv2);
+  fusion.addOutput(tv3);
+
+  tv3->split(0, 4);
+  tv3->split(0, 128);
+  TransformPropagatorWithCheck propagator(tv3);
+  MaxLogicalDomainInfoSpanningTree(tv3).traverse(&propagator);
+  tv3->axis(0)->parallelize(ParallelType::BIDx);
+  tv3->axis(1)->parallelize(ParallelType::TIDx);
+  scheduler_utils::parallelizeAllLike(tv3);
+  tv1->axis(2)->parallelize(ParallelType::Vectorize);
+  tv3->axis(2)->parallelize(ParallelType::Vectorize);
+  inlineMost();
+
+  at::Tensor t0 = at::randn(
+      {1024 * 1024},
+      at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0));
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  const std::string kernel_string = ke.compiledKernel()->kernelString();
+  // The input is loaded without allocating it in L1
+  EXPECT_THAT(kernel_string, ::testing::HasSubstr("CacheOp::NoAllocate"));
+  // Pairs of elements are converted by a single instruction
+  EXPECT_THAT(kernel_string, ::testing::HasSubstr("cvt.rn.bf16x2.f32"));
+
+  auto outputs = ke.run({t0});
+  testValidate(&fusion, outputs, {t0}, __LINE__, __FILE__);
+}
+
 // Begin TMA tests
 
 using TMATest = TmaBase;
@@ -1343,6 +1500,57 @@ TEST_F(TMAMiscTest, AdvancedThreadParallelizationLoad) {
   testValidate(&fusion, cg_outputs, {t0}, {t0}, __LINE__, __FILE__);
 }
 
+TEST_F(TMAMiscTest, TensorMapCache) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  const DataType dtype = DataType::Float;
+
+  auto tv0 = makeContigTensor(1, dtype);
+  fusion.addInput(tv0);
+  auto tv1 = set(tv0);
+  auto tv2 = set(tv1);
+  fusion.addOutput(tv2);
+
+  tv1->setMemoryType(MemoryType::Shared);
+  tv1->definition()->as<LoadStoreOp>()->setOpType(
+      LoadStoreOpType::CpAsyncBulkTensorTile);
+
+  tv1->split(0, 128);
+  tv1->axis(1)->parallelize(ParallelType::Bulk);
+  tv1->axis(0)->parallelize(ParallelType::BIDx);
+
+  tv2->split(0, 128);
+  tv2->axis(0)->parallelize(ParallelType::BIDx);
+  tv2->axis(1)->parallelize(ParallelType::TIDx);
+
+  auto options =
+      at::TensorOptions().dtype(data_type_to_aten(dtype)).device(at::kCUDA, 0);
+  auto t0 = at::randn({100000}, options);
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0}, {}, matmul_cparams);
+
+  auto cg_outputs = ke.run({t0});
+  testValidate(&fusion, cg_outputs, {t0}, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(ke.tensorMapCache().numEncodes(), 1);
+
+  // Another tensor of the same shape only replaces the global address
+  auto t1 = at::randn({100000}, options);
+  cg_outputs = ke.run({t1});
+  testValidate(&fusion, cg_outputs, {t1}, {t1}, __LINE__, __FILE__);
+  EXPECT_EQ(ke.tensorMapCache().numEncodes(), 1);
+
+  // A new shape is encoded
+  auto t2 = at::randn({50000}, options);
+  cg_outputs = ke.run({t2});
+  testValidate(&fusion, cg_outputs, {t2}, {t2}, __LINE__, __FILE__);
+  EXPECT_EQ(ke.tensorMapCache().numEncodes(), 2);
+
+  cg_outputs = ke.run({t0});
+  testValidate(&fusion, cg_outputs, {t0}, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(ke.tensorMapCache().numEncodes(), 2);
+}
+
 TEST_F(TMAMiscTest, AdvancedThreadParallelizationStore) {
   Fusion fusion;
   FusionGuard fg(&fusion);
@@ -9,6 +9,7 @@
 
 #include <fusion.h>
 #include <ir/builder.h>
+#include <kernel_ir.h>
 #include <multidevice/communication.h>
 #include <multidevice/communicator.h>
 #include <tests/cpp/multidevice.h>
@@ -364,6 +365,77 @@ TEST_P(CommunicationTest, Allreduce) {
   }
 }
 
+TEST_P(CommunicationTest, Allreduce_WaitOnCurrentStream) {
+  hir::HostIrContainer container;
+  FusionGuard fg(&container);
+  auto* in = makeContigTensor(2);
+  in->setDeviceMesh(full_mesh_);
+  auto* out = newForReduction(in, {0});
+  auto communication = IrBuilder::create<Communication>(
+      CommunicationType::Allreduce,
+      out,
+      in,
+      all_ranks_,
+      /*root=*/-1,
+      kReductionOp);
+
+  // The host posts all the repetitions before any of them completes, and
+  // only the current stream orders them.
+  std::vector<at::Tensor> output_tensors;
+  for (auto repetition : arange(kNumRepetitions)) {
+    at::Tensor input_tensor =
+        at::arange(kTensorSize, tensor_options).unsqueeze(0) +
+        (communicator_->deviceId() + 1) * repetition;
+    at::Tensor output_tensor = at::empty({kTensorSize}, tensor_options);
+    waitOnCurrentStream(postSingleCommunication(
+        communication,
+        communicator_->deviceId(),
+        backend_,
+        input_tensor,
+        output_tensor));
+    // Consumes the output on the current stream
+    output_tensors.push_back(output_tensor + 0);
+  }
+
+  const int s = communicator_->size();
+  for (auto&& [repetition, output_tensor] : enumerate(output_tensors)) {
+    auto ref = at::arange(kTensorSize, tensor_options) * s +
+        s * (s + 1) / 2 * static_cast<int64_t>(repetition);
+    validate(output_tensor, ref);
+  }
+}
+
+TEST_P(CommunicationTest, AllToAllV) {
+  const int64_t s = communicator_->size();
+  const int64_t rank = communicator_->deviceId();
+
+  // Rank r sends r + p + 1 rows filled with r * 1000 + p to rank p. The counts
+  // are computed on the device.
+  at::Tensor send_counts =
+      at::arange(s, tensor_options.dtype(at::kLong)) + rank + 1;
+  std::vector<at::Tensor> send_chunks;
+  for (auto peer : arange(s)) {
+    send_chunks.push_back(at::full(
+        {rank + peer + 1, 2},
+        static_cast<double>(rank * 1000 + peer),
+        tensor_options));
+  }
+  at::Tensor input_tensor = at::cat(send_chunks);
+
+  AllToAllVResult result = postAllToAllV(backend_, input_tensor, send_counts);
+  waitOnCurrentStream(result.work);
+
+  std::vector<at::Tensor> recv_chunks;
+  for (auto peer : arange(s)) {
+    EXPECT_EQ(result.recv_counts.at(peer), peer + rank + 1);
+    recv_chunks.push_back(at::full(
+        {peer + rank + 1, 2},
+        static_cast<double>(peer * 1000 + rank),
+        tensor_options));
+  }
+  validate(result.output, at::cat(recv_chunks));
+}
+
 TEST_P(CommunicationTest, ReduceScatter) {
   hir::HostIrContainer container;
   FusionGuard fg(&container);
@@ -485,4 +557,297 @@ TEST_F(P2PCommunicationTest, CudaComm) {
   }
 }
 
+// Runs the collectives of the kCuda backend through HostIrEvaluator, which
+// exchanges the IPC handles of the buffers on the first run.
+class CudaCollectiveTest : public MultiDeviceTest {
+ protected:
+  void SetUp() override {
+    MultiDeviceTest::SetUp();
+    if (communicator_->size() < 2 ||
+        torch::cuda::device_count() < communicator_->size()) {
+      GTEST_SKIP() << "This test needs one GPU per rank and at least 2 ranks.";
+    }
+  }
+
+  std::unique_ptr<hir::HostIrEvaluator> makeEvaluator(
+      std::unique_ptr<hir::HostIrContainer> container,
+      Communication* communication) {
+    container->addInput(communication->in());
+    container->addInput(communication->out());
+    container->pushBackTopLevelExprs(communication);
+    container->pushBackTopLevelExprs(
+        IrBuilder::create<hir::Wait>(communication));
+    return std::make_unique<hir::HostIrEvaluator>(
+        std::move(container), communicator_);
+  }
+
+  static constexpr int kTensorSize = 1024;
+  static constexpr int kNumRepetitions = 8;
+};
+
+TEST_F(CudaCollectiveTest, Allgather) {
+  auto container = std::make_unique<hir::HostIrContainer>();
+  FusionGuard fg(container.get());
+  const auto mesh = DeviceMesh::createForNumDevices(communicator_->size());
+  auto* in = makeContigTensor(2);
+  in->setDeviceMesh(mesh);
+  auto* out = ops::newValLike(in, in->dtype())->as<TensorView>();
+  auto* communication = IrBuilder::create<Communication>(
+      CommunicationType::Allgather,
+      out,
+      in,
+      mesh.vector(),
+      /*root=*/-1,
+      RedOpType::UNUSED,
+      CommunicatorBackend::kCuda);
+  auto evaluator = makeEvaluator(std::move(container), communication);
+
+  at::Tensor input_tensor = at::empty({1, kTensorSize}, tensor_options);
+  at::Tensor output_tensor =
+      at::empty({communicator_->size(), kTensorSize}, tensor_options);
+  for (auto repetition : arange(kNumRepetitions)) {
+    input_tensor.copy_(
+        at::arange(kTensorSize, tensor_options).unsqueeze(0) +
+        (communicator_->deviceId() + 1) * repetition);
+
+    evaluator->runWithInput({{in, input_tensor}, {out, output_tensor}});
+
+    at::Tensor ref = at::arange(kTensorSize, tensor_options).unsqueeze(0) +
+        at::arange(1, communicator_->size() + 1, tensor_options).unsqueeze(1) *
+            repetition;
+    EXPECT_TRUE(output_tensor.equal(ref))
+        << "Device " << communicator_->deviceId() << " expected " << ref
+        << " but obtained " << output_tensor;
+  }
+}
+
+TEST_F(CudaCollectiveTest, ReduceScatter) {
+  auto container = std::make_unique<hir::HostIrContainer>();
+  FusionGuard fg(container.get());
+  const auto mesh = DeviceMesh::createForNumDevices(communicator_->size());
+  auto* in = makeContigTensor(3);
+  in->setDeviceMesh(mesh);
+  auto* out = newForReduction(in, {0});
+  auto* communication = IrBuilder::create<Communication>(
+      CommunicationType::ReduceScatter,
+      out,
+      in,
+      mesh.vector(),
+      /*root=*/-1,
+      RedOpType::SUM,
+      CommunicatorBackend::kCuda);
+  auto evaluator = makeEvaluator(std::move(container), communication);
+
+  const int64_t num_devices = communicator_->size();
+  const int64_t device_id = communicator_->deviceId();
+  at::Tensor input_tensor =
+      at::empty({1, num_devices, kTensorSize}, tensor_options);
+  at::Tensor output_tensor = at::empty({1, kTensorSize}, tensor_options);
+  for (auto repetition : arange(kNumRepetitions)) {
+    // Chunk i of device d holds arange + 10 * d + i + repetition.
+    input_tensor.copy_(
+        at::arange(kTensorSize, tensor_options).view({1, 1, kTensorSize}) +
+        at::arange(num_devices, tensor_options).view({1, num_devices, 1}) +
+        10 * device_id + repetition);
+
+    evaluator->runWithInput({{in, input_tensor}, {out, output_tensor}});
+
+    at::Tensor ref =
+        at::arange(kTensorSize, tensor_options).unsqueeze(0) * num_devices +
+        5 * num_devices * (num_devices - 1) +
+        num_devices * (device_id + repetition);
+    EXPECT_TRUE(output_tensor.equal(ref))
+        << "Device " << device_id << " expected " << ref << " but obtained "
+        << output_tensor;
+  }
+}
+
+TEST_F(CudaCollectiveTest, Allreduce) {
+  auto container = std::make_unique<hir::HostIrContainer>();
+  FusionGuard fg(container.get());
+  const auto mesh = DeviceMesh::createForNumDevices(communicator_->size());
+  auto* in = makeContigTensor(2);
+  in->setDeviceMesh(mesh);
+  auto* out = newForReduction(in, {0});
+  auto* communication = IrBuilder::create<Communication>(
+      CommunicationType::Allreduce,
+      out,
+      in,
+      mesh.vector(),
+      /*root=*/-1,
+      RedOpType::SUM,
+      CommunicatorBackend::kCuda);
+  auto evaluator = makeEvaluator(std::move(container), communication);
+
+  const int64_t num_devices = communicator_->size();
+  at::Tensor input_tensor = at::empty({1, kTensorSize}, tensor_options);
+  at::Tensor output_tensor = at::empty({kTensorSize}, tensor_options);
+  for (auto repetition : arange(kNumRepetitions)) {
+    input_tensor.copy_(
+        at::arange(kTensorSize, tensor_options).unsqueeze(0) +
+        (communicator_->deviceId() + 1) * repetition);
+
+    evaluator->runWithInput({{in, input_tensor}, {out, output_tensor}});
+
+    at::Tensor ref = at::arange(kTensorSize, tensor_options) * num_devices +
+        num_devices * (num_devices + 1) / 2 * repetition;
+    EXPECT_TRUE(output_tensor.equal(ref))
+        << "Device " << communicator_->deviceId() << " expected " << ref
+        << " but obtained " << output_tensor;
+  }
+}
+
+TEST_F(CudaCollectiveTest, AllreduceSymmetricMemory) {
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::SymmetricMemory);
+
+  auto container = std::make_unique<hir::HostIrContainer>();
+  FusionGuard fg(container.get());
+  const auto mesh = DeviceMesh::createForNumDevices(communicator_->size());
+  auto* x = makeContigConcreteTensor({1, kTensorSize});
+  x->setDeviceMesh(mesh);
+  auto* in = makeContigConcreteTensor({1, kTensorSize});
+  in->setDeviceMesh(mesh);
+  in->setMemoryType(MemoryType::Global);
+  auto* out = newForReduction(in, {0});
+  out->setMemoryType(MemoryType::Global);
+  auto* communication = IrBuilder::create<Communication>(
+      CommunicationType::Allreduce,
+      out,
+      in,
+      mesh.vector(),
+      /*root=*/-1,
+      RedOpType::SUM,
+      CommunicatorBackend::kCuda);
+  container->addInput(x);
+  container->addOutput(out);
+  // in is allocated by the host program, so it is kept across runs and its
+  // IPC handles are exchanged only once.
+  container->pushBackTopLevelExprs(
+      IrBuilder::create<kir::Allocate>(in, MemoryType::Global));
+  container->pushBackTopLevelExprs(
+      IrBuilder::create<kir::Allocate>(out, MemoryType::Global));
+  container->pushBackTopLevelExprs(
+      IrBuilder::create<BinaryOp>(BinaryOpType::Add, in, x, x));
+  container->pushBackTopLevelExprs(communication);
+  container->pushBackTopLevelExprs(
+      IrBuilder::create<hir::Wait>(communication));
+  container->pushBackTopLevelExprs(IrBuilder::create<hir::Deallocate>(in));
+  hir::HostIrEvaluator evaluator(std::move(container), communicator_);
+
+  const int64_t num_devices = communicator_->size();
+  at::Tensor x_tensor = at::empty({1, kTensorSize}, tensor_options);
+  for (auto repetition : arange(kNumRepetitions)) {
+    x_tensor.copy_(
+        at::arange(kTensorSize, tensor_options).unsqueeze(0) +
+        (communicator_->deviceId() + 1) * repetition);
+
+    KernelArgumentHolder outputs = evaluator.runWithInput({{x, x_tensor}});
+
+    at::Tensor ref = at::arange(kTensorSize, tensor_options) * 2 * num_devices +
+        num_devices * (num_devices + 1) * repetition;
+    EXPECT_TRUE(outputs[0].as<at::Tensor>().equal(ref))
+        << "Device " << communicator_->deviceId() << " expected " << ref
+        << " but obtained " << outputs[0].as<at::Tensor>();
+  }
+}
+
+class HierarchicalCollectiveTest : public MultiDeviceTest {
+ protected:
+  void SetUp() override {
+    MultiDeviceTest::SetUp();
+    if (communicator_->size() < 4 || communicator_->size() % 2 != 0) {
+      GTEST_SKIP() << "This test needs an even number of at least 4 ranks.";
+    }
+    if (!communicator_->isBackendAvailable(CommunicatorBackend::kNccl)) {
+      GTEST_SKIP() << "Backend not available: " << CommunicatorBackend::kNccl;
+    }
+    // Emulate two NVLink domains
+    EnableOptionsGuard::getCurOptions().set(
+        EnableOption::HierarchicalCollectives,
+        {std::to_string(communicator_->size() / 2)});
+  }
+
+  std::unique_ptr<hir::HostIrEvaluator> makeEvaluator(
+      std::unique_ptr<hir::HostIrContainer> container,
+      Communication* communication) {
+    EXPECT_TRUE(canPostHierarchically(communication, communicator_));
+    container->addInput(communication->in());
+    container->addInput(communication->out());
+    container->pushBackTopLevelExprs(communication);
+    container->pushBackTopLevelExprs(
+        IrBuilder::create<hir::Wait>(communication));
+    return std::make_unique<hir::HostIrEvaluator>(
+        std::move(container), communicator_);
+  }
+
+  static constexpr int kTensorSize = 1024;
+  EnableOptionsGuard opt_guard_;
+};
+
+TEST_F(HierarchicalCollectiveTest, Allreduce) {
+  auto container = std::make_unique<hir::HostIrContainer>();
+  FusionGuard fg(container.get());
+  const auto mesh = DeviceMesh::createForNumDevices(communicator_->size());
+  auto* in = makeContigTensor(2);
+  in->setDeviceMesh(mesh);
+  auto* out = newForReduction(in, {0});
+  auto* communication = IrBuilder::create<Communication>(
+      CommunicationType::Allreduce,
+      out,
+      in,
+      mesh.vector(),
+      /*root=*/-1,
+      RedOpType::SUM);
+  auto evaluator = makeEvaluator(std::move(container), communication);
+
+  const int64_t num_devices = communicator_->size();
+  at::Tensor input_tensor =
+      at::arange(kTensorSize, tensor_options).unsqueeze(0) +
+      communicator_->deviceId();
+  at::Tensor output_tensor = at::empty({kTensorSize}, tensor_options);
+
+  evaluator->runWithInput({{in, input_tensor}, {out, output_tensor}});
+
+  at::Tensor ref = at::arange(kTensorSize, tensor_options) * num_devices +
+      num_devices * (num_devices - 1) / 2;
+  EXPECT_TRUE(output_tensor.equal(ref))
+      << "Device " << communicator_->deviceId() << " expected " << ref
+      << " but obtained " << output_tensor;
+}
+
+TEST_F(HierarchicalCollectiveTest, ReduceScatter) {
+  auto container = std::make_unique<hir::HostIrContainer>();
+  FusionGuard fg(container.get());
+  const auto mesh = DeviceMesh::createForNumDevices(communicator_->size());
+  auto* in = makeContigTensor(3);
+  in->setDeviceMesh(mesh);
+  auto* out = newForReduction(in, {0});
+  auto* communication = IrBuilder::create<Communication>(
+      CommunicationType::ReduceScatter,
+      out,
+      in,
+      mesh.vector(),
+      /*root=*/-1,
+      RedOpType::SUM);
+  auto evaluator = makeEvaluator(std::move(container), communication);
+
+  const int64_t num_devices = communicator_->size();
+  const int64_t device_id = communicator_->deviceId();
+  // Integer values so that the result doesn't depend on the reduction order
+  at::Tensor unsharded_input_tensor = at::randint(
+      2, {num_devices, num_devices, kTensorSize}, tensor_options);
+  at::Tensor input_tensor =
+      unsharded_input_tensor.slice(0, device_id, device_id + 1);
+  at::Tensor output_tensor = at::empty({1, kTensorSize}, tensor_options);
+
+  evaluator->runWithInput({{in, input_tensor}, {out, output_tensor}});
+
+  at::Tensor ref =
+      unsharded_input_tensor.sum({0}).slice(0, device_id, device_id + 1);
+  EXPECT_TRUE(output_tensor.equal(ref))
+      << "Device " << device_id << " expected " << ref << " but obtained "
+      << output_tensor;
+}
+
 } // namespace nvfuser
@@ -9,11 +9,14 @@
 #include <fusion.h>
 #include <host_ir/container.h>
 #include <host_ir/executor.h>
+#include <host_ir/pass/prefetch_allgathers.h>
+#include <host_ir/pass/ring_attention.h>
 #include <host_ir/pass/stream_parallel_type.h>
 #include <ir/all_nodes.h>
 #include <ops/all_ops.h>
 #include <preseg_passes/reorder_sharded_axis.h>
 #include <tests/cpp/multidevice.h>
+#include <tests/cpp/validator.h>
 
 namespace nvfuser {
 
@@ -432,6 +435,255 @@ TEST_F(MultiDeviceTest, ShareIpcMemHandles) {
   }
 }
 
+TEST_F(MultiDeviceTest, CoalesceIndependentAllgathers) {
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::CoalesceCommunications);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  TensorView* tv1 = set(tv0);
+  TensorView* tv2 = makeContigTensor(2);
+  TensorView* tv3 = set(tv2);
+  fusion->addInput(tv0);
+  fusion->addInput(tv2);
+  fusion->addOutput(tv1);
+  fusion->addOutput(tv3);
+
+  const DeviceMesh mesh =
+      DeviceMesh::createForNumDevices(communicator_->size());
+  for (auto* tv : {tv0, tv1, tv2, tv3}) {
+    tv->setDeviceMesh(mesh);
+  }
+  tv0->axis(0)->parallelize(ParallelType::DIDx);
+  tv2->axis(0)->parallelize(ParallelType::DIDx);
+
+  MultiDeviceExecutor executor(std::move(fusion), *communicator_);
+
+  HostIrContainer* container = executor.hostIrEvaluator()->container();
+  EXPECT_THAT(
+      container->topLevelExprs(),
+      testing::ElementsAre(
+          IsA<kir::Allocate>(),
+          IsA<kir::Allocate>(),
+          IsA<StartCoalescing>(),
+          IsA<Communication>(),
+          IsA<Communication>(),
+          IsA<EndCoalescing>(),
+          IsA<Wait>()));
+
+  auto options =
+      at::TensorOptions().device(at::kCUDA, communicator_->deviceId());
+  at::Tensor unsharded_in0 = at::randn({communicator_->size(), 4}, options);
+  at::Tensor unsharded_in2 = at::randn({communicator_->size(), 8}, options);
+  KernelArgumentHolder outputs = executor.runWithInput(KernelArgumentHolder(
+      {shardTensor(unsharded_in0, /*axis=*/0, mesh),
+       shardTensor(unsharded_in2, /*axis=*/0, mesh)}));
+
+  EXPECT_TRUE(outputs[0].as<at::Tensor>().equal(unsharded_in0));
+  EXPECT_TRUE(outputs[1].as<at::Tensor>().equal(unsharded_in2));
+}
+
+TEST_F(MultiDeviceTest, PrefetchAllgather) {
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::PrefetchAllgathers);
+
+  constexpr int64_t kTensorSize = 1024;
+  const DeviceMesh mesh =
+      DeviceMesh::createForNumDevices(communicator_->size());
+
+  auto hic = std::make_unique<HostIrContainer>();
+  FusionGuard fg(hic.get());
+  TensorView* x = makeContigConcreteTensor({kTensorSize});
+  TensorView* y = makeContigConcreteTensor({kTensorSize});
+  TensorView* w = makeContigTensor(2);
+  TensorView* w_full =
+      makeContigConcreteTensor({communicator_->size(), kTensorSize});
+  for (auto* tv : {x, y, w, w_full}) {
+    tv->setDeviceMesh(mesh);
+    tv->setMemoryType(MemoryType::Global);
+  }
+  w->axis(0)->parallelize(ParallelType::DIDx);
+  auto* allgather = IrBuilder::create<Communication>(
+      CommunicationType::Allgather, w_full, w, mesh.vector());
+  hic->addInput(x);
+  hic->addInput(w);
+  hic->addOutput(y);
+  hic->addOutput(w_full);
+  // The addition stands for the compute of the previous layer
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<kir::Allocate>(y, MemoryType::Global));
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<BinaryOp>(BinaryOpType::Add, y, x, x));
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<kir::Allocate>(w_full, MemoryType::Global));
+  hic->pushBackTopLevelExprs(allgather);
+  hic->pushBackTopLevelExprs(IrBuilder::create<Wait>(allgather));
+
+  hir_pass::PrefetchAllgathers().runPass(hic.get());
+
+  EXPECT_THAT(
+      hic->topLevelExprs(),
+      testing::ElementsAre(
+          IsA<GetCurrentStream>(),
+          IsA<kir::Allocate>(),
+          IsA<kir::Allocate>(),
+          IsA<SetCurrentStream>(),
+          IsA<Communication>(),
+          IsA<Wait>(),
+          IsA<SetCurrentStream>(),
+          IsA<BinaryOp>(),
+          IsA<Synchronize>()));
+
+  HostIrEvaluator hie(std::move(hic), communicator_);
+  auto options = at::TensorOptions().device(communicator_->device());
+  at::Tensor x_tensor = at::randn({kTensorSize}, options);
+  at::Tensor unsharded_w =
+      at::randn({communicator_->size(), kTensorSize}, options);
+  KernelArgumentHolder outputs = hie.runWithInput(
+      {{x, x_tensor}, {w, shardTensor(unsharded_w, /*axis=*/0, mesh)}});
+
+  EXPECT_TRUE(outputs[0].as<at::Tensor>().equal(x_tensor + x_tensor));
+  EXPECT_TRUE(outputs[1].as<at::Tensor>().equal(unsharded_w));
+}
+
+TEST_F(MultiDeviceTest, WarmUpBackends) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  TensorView* tv1 = set(tv0);
+  fusion->addInput(tv0);
+  fusion->addOutput(tv1);
+
+  const DeviceMesh mesh =
+      DeviceMesh::createForNumDevices(communicator_->size());
+  for (auto* tv : {tv0, tv1}) {
+    tv->setDeviceMesh(mesh);
+  }
+  tv0->axis(0)->parallelize(ParallelType::DIDx);
+
+  MultiDeviceExecutorParams params;
+  params.warm_up_backends = true;
+  MultiDeviceExecutor executor(std::move(fusion), *communicator_, params);
+
+  // All the backends are created at instantiation, so running the host
+  // program doesn't go through a rendezvous.
+  const int64_t num_creations = communicator_->numBackendCreations();
+  auto options =
+      at::TensorOptions().device(at::kCUDA, communicator_->deviceId());
+  at::Tensor unsharded_in = at::randn({communicator_->size(), 4}, options);
+  KernelArgumentHolder outputs = executor.runWithInput(
+      KernelArgumentHolder({shardTensor(unsharded_in, /*axis=*/0, mesh)}));
+  EXPECT_EQ(communicator_->numBackendCreations(), num_creations);
+  EXPECT_TRUE(outputs[0].as<at::Tensor>().equal(unsharded_in));
+}
+
+TEST_F(MultiDeviceTest, RingAttention) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(8, 0);
+  if (communicator_->size() < 2) {
+    GTEST_SKIP() << "This test needs at least 2 ranks.";
+  }
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::RingAttention);
+
+  constexpr int64_t kBatch = 2;
+  constexpr int64_t kHeads = 4;
+  constexpr int64_t kSeqPerDevice = 128;
+  constexpr int64_t kHeadDim = 64;
+  const int64_t d = communicator_->size();
+  const DeviceMesh mesh = DeviceMesh::createForNumDevices(d);
+
+  auto hic = std::make_unique<HostIrContainer>();
+  FusionGuard fg(hic.get());
+  auto make_tensor = [&](bool sharded) {
+    TensorView* tv = makeContigConcreteTensor(
+        {d, kBatch, kHeads, kSeqPerDevice, kHeadDim}, DataType::BFloat16);
+    tv->setDeviceMesh(mesh);
+    if (sharded) {
+      tv->axis(0)->parallelize(ParallelType::DIDx);
+    }
+    return tv;
+  };
+  TensorView* q = make_tensor(/*sharded=*/true);
+  TensorView* k = make_tensor(/*sharded=*/true);
+  TensorView* v = make_tensor(/*sharded=*/true);
+  TensorView* k_full = make_tensor(/*sharded=*/false);
+  TensorView* v_full = make_tensor(/*sharded=*/false);
+  auto* k_gather = IrBuilder::create<Communication>(
+      CommunicationType::Allgather, k_full, k, mesh.vector());
+  auto* v_gather = IrBuilder::create<Communication>(
+      CommunicationType::Allgather, v_full, v, mesh.vector());
+  SdpfaFwdResult attn = sdpfa_fwd(
+      q,
+      k_full,
+      v_full,
+      /*dropout_p=*/nullptr,
+      /*is_causal=*/nullptr,
+      /*scale=*/nullptr);
+  for (TensorView* tv : {attn.output, attn.log_sumexp}) {
+    tv->setDeviceMesh(mesh);
+    tv->axis(0)->parallelize(ParallelType::DIDx);
+  }
+  for (TensorView* tv : hic->allTvs()) {
+    tv->setMemoryType(MemoryType::Global);
+  }
+
+  hic->addInput(q);
+  hic->addInput(k);
+  hic->addInput(v);
+  hic->addOutput(attn.output);
+  hic->addOutput(attn.log_sumexp);
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<kir::Allocate>(k_full, MemoryType::Global));
+  hic->pushBackTopLevelExprs(k_gather);
+  hic->pushBackTopLevelExprs(IrBuilder::create<Wait>(k_gather));
+  hic->pushBackTopLevelExprs(
+      IrBuilder::create<kir::Allocate>(v_full, MemoryType::Global));
+  hic->pushBackTopLevelExprs(v_gather);
+  hic->pushBackTopLevelExprs(IrBuilder::create<Wait>(v_gather));
+  hic->pushBackTopLevelExprs(attn.output->definition());
+
+  hir_pass::RingAttention().runPass(hic.get());
+  EXPECT_THAT(
+      hic->topLevelExprs(),
+      testing::Not(testing::Contains(IsA<Communication>())));
+  EXPECT_EQ(
+      std::count_if(
+          hic->topLevelExprs().begin(),
+          hic->topLevelExprs().end(),
+          [](Expr* e) { return e->isA<P2PCommunication>(); }),
+      4 * (d - 1));
+
+  HostIrEvaluator evaluator(std::move(hic), communicator_);
+  auto options = at::TensorOptions()
+                     .dtype(at::kBFloat16)
+                     .device(at::kCUDA, communicator_->deviceId());
+  const std::vector<int64_t> shape = {
+      d, kBatch, kHeads, kSeqPerDevice, kHeadDim};
+  at::Tensor unsharded_q = at::randn(shape, options);
+  at::Tensor unsharded_k = at::randn(shape, options);
+  at::Tensor unsharded_v = at::randn(shape, options);
+  KernelArgumentHolder outputs = evaluator.runWithInput(
+      {{q, shardTensor(unsharded_q, /*axis=*/0, mesh)},
+       {k, shardTensor(unsharded_k, /*axis=*/0, mesh)},
+       {v, shardTensor(unsharded_v, /*axis=*/0, mesh)}});
+
+  // Attend the local query shard to the keys of all devices
+  auto gather_sequence = [&](at::Tensor t) {
+    return t.permute({1, 2, 0, 3, 4})
+        .reshape({kBatch, kHeads, d * kSeqPerDevice, kHeadDim});
+  };
+  at::Tensor ref = at::scaled_dot_product_attention(
+      unsharded_q[communicator_->deviceId()],
+      gather_sequence(unsharded_k),
+      gather_sequence(unsharded_v));
+  EXPECT_TRUE(at::allclose(
+      outputs[0].as<at::Tensor>().squeeze(0),
+      ref,
+      /*rtol=*/1e-2,
+      /*atol=*/1e-2));
+}
+
 } // namespace hir
 
 } // namespace nvfuser
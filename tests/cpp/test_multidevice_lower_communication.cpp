@@ -9,6 +9,7 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
+#include <fusion_profiler.h>
 #include <ops/all_ops.h>
 #include <preseg_passes/mark_aliases_prepare.h>
 #include <preseg_passes/optimization_pass.h>
@@ -269,6 +270,46 @@ TEST_P(LowerCollectiveTest, Allgather) {
   EXPECT_TRUE(at::equal(out_tensor, unsharded_tensor));
 }
 
+TEST_P(LowerCollectiveTest, Allgather_Profile) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  const auto num_devices = communicator_->size();
+  TensorView* in = makeContigTensor(2);
+  TensorView* out = set(in);
+  fusion->addInput(in);
+  fusion->addOutput(out);
+
+  auto mesh = DeviceMesh::createForNumDevices(num_devices);
+  in->setDeviceMesh(mesh);
+  out->setDeviceMesh(mesh);
+  in->axis(0)->parallelize(ParallelType::DIDx);
+
+  at::Tensor unsharded_tensor =
+      at::randn({num_devices, kTensorSize}, tensor_options);
+  at::Tensor in_tensor = shardTensor(unsharded_tensor, in);
+
+  ProfilerOptionsGuard options_guard;
+  ProfilerOptionsGuard::getCurOptions().set(ProfilerOption::EnableNocupti);
+  FusionExecutorCache executor_cache(std::move(fusion));
+  at::Tensor out_tensor =
+      executor_cache.runFusionWithInputs({in_tensor})[0].as<at::Tensor>();
+  EXPECT_TRUE(at::equal(out_tensor, unsharded_tensor));
+
+  const std::vector<CommunicationProfile>& profiles =
+      FusionProfiler::profile().communication_profiles;
+  ASSERT_EQ(profiles.size(), 1);
+  const CommunicationProfile& prof = profiles.front();
+  EXPECT_EQ(prof.name, "Allgather");
+  EXPECT_EQ(prof.team_size, num_devices);
+  EXPECT_EQ(prof.bytes, unsharded_tensor.numel() * sizeof(float));
+  EXPECT_DOUBLE_EQ(
+      prof.bus_factor, static_cast<double>(num_devices - 1) / num_devices);
+  EXPECT_GT(prof.time_ms, 0.0);
+  EXPECT_DOUBLE_EQ(
+      prof.bus_bandwidth_gbs, prof.algorithm_bandwidth_gbs * prof.bus_factor);
+}
+
 TEST_P(LowerCollectiveTest, Allgather_LoopSplit) {
   auto fusion = std::make_unique<Fusion>();
   FusionGuard fg(fusion.get());
@@ -754,6 +795,85 @@ TEST_P(LowerCollectiveTest, Allgather_NoncontiguousOutput) {
           HeuristicIs(SchedulerType::Communication)));
 }
 
+TEST_P(LowerCollectiveTest, Allgather_NonOutermostGatheredAxis_Strided) {
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::StridedCommunication);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  const auto d = communicator_->size();
+  auto mesh = DeviceMesh::createForNumDevices(d);
+
+  TensorView* tv0 = makeConcreteTensor({5, d * 3});
+  TensorView* tv1 = set(tv0);
+
+  tv0->setDeviceMesh(mesh);
+  tv0->outer_split(1, d);
+  tv0->axis(1)->parallelize(ParallelType::DIDx);
+
+  tv1->setDeviceMesh(mesh);
+
+  fusion->addInput(tv0);
+  fusion->addOutput(tv1);
+
+  at::Tensor unsharded_in_tensor = at::randn({5, d * 3}, tensor_options);
+  at::Tensor in_tensor = shardTensor(unsharded_in_tensor, 1, mesh);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  at::Tensor out_tensor =
+      executor_cache.runFusionWithInputs({in_tensor})[0].as<at::Tensor>();
+
+  EXPECT_TRUE(out_tensor.is_contiguous());
+  EXPECT_TRUE(at::equal(out_tensor, unsharded_in_tensor));
+
+  // Unlike Allgather_NonCompliantAllocation, the gathered axis is sent in
+  // segments and no transpose is needed around the communication.
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_THAT(
+      runtime->fusionSegments()->groups(),
+      UnorderedElementsAre(HeuristicIs(SchedulerType::Communication)));
+}
+
+TEST_P(LowerCollectiveTest, AllToAll) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  const auto d = communicator_->size();
+  auto mesh = DeviceMesh::createForNumDevices(d);
+
+  // [experts, tokens, hidden] moves from sharding tokens to sharding experts
+  TensorView* tv0 = makeConcreteTensor({d * 2, d * 3, 4});
+  TensorView* tv1 = set(tv0);
+
+  tv0->setDeviceMesh(mesh);
+  tv0->outer_split(1, d);
+  tv0->axis(1)->parallelize(ParallelType::DIDx);
+
+  tv1->setDeviceMesh(mesh);
+  tv1->outer_split(0, d);
+  tv1->axis(0)->parallelize(ParallelType::DIDx);
+
+  fusion->addInput(tv0);
+  fusion->addOutput(tv1);
+
+  at::Tensor unsharded_tensor = at::randn({d * 2, d * 3, 4}, tensor_options);
+  at::Tensor in_tensor = shardTensor(unsharded_tensor, 1, mesh);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  at::Tensor out_tensor =
+      executor_cache.runFusionWithInputs({in_tensor})[0].as<at::Tensor>();
+
+  EXPECT_TRUE(at::equal(out_tensor, shardTensor(unsharded_tensor, 0, mesh)));
+
+  // The tokens aren't outermost in the output, so the received chunks are
+  // staged by the communication instead of transposed by another segment.
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_THAT(
+      runtime->fusionSegments()->groups(),
+      UnorderedElementsAre(HeuristicIs(SchedulerType::Communication)));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ,
     LowerCollectiveTest,
@@ -26,6 +26,7 @@
 #include <iter_visitor.h>
 #include <kernel_ir.h>
 #include <logical_domain_map.h>
+#include <multidevice/pipeline.h>
 #include <ops/all_ops.h>
 #include <preseg_passes/optimization_pass.h>
 #include <preseg_passes/reorder_sharded_axis.h>
@@ -463,4 +464,111 @@ INSTANTIATE_TEST_SUITE_P(
         testing::Values(0, 1),
         testing::Values(true)));
 
+namespace {
+// Stage i computes y = x * w_i. Its backward computes the gradients of x and
+// w_i, so the pipeline computes the gradients of sum(x * w_0 * ... * w_n-1).
+PipelineStage makeScaleStage(bool with_backward) {
+  PipelineStage stage;
+  stage.forward = std::make_unique<Fusion>();
+  {
+    FusionGuard fg(stage.forward.get());
+    TensorView* x = makeContigTensor(2);
+    TensorView* w = makeContigTensor(1);
+    TensorView* y = mul(x, broadcast(w, {true, false}));
+    stage.forward->addInput(x);
+    stage.forward->addInput(w);
+    stage.forward->addOutput(y);
+  }
+  if (!with_backward) {
+    return stage;
+  }
+  stage.backward = std::make_unique<Fusion>();
+  {
+    FusionGuard fg(stage.backward.get());
+    TensorView* x = makeContigTensor(2);
+    TensorView* w = makeContigTensor(1);
+    TensorView* grad_y = makeContigTensor(2);
+    TensorView* grad_x = mul(grad_y, broadcast(w, {true, false}));
+    TensorView* grad_w = sum(mul(grad_y, x), {0});
+    stage.backward->addInput(x);
+    stage.backward->addInput(w);
+    stage.backward->addInput(grad_y);
+    stage.backward->addOutput(grad_x);
+    stage.backward->addOutput(grad_w);
+  }
+  return stage;
+}
+} // namespace
+
+class PipelineExecutorTest : public MultiDeviceTest,
+                             public testing::WithParamInterface<bool> {};
+
+TEST_P(PipelineExecutorTest, Scale) {
+  const bool with_backward = GetParam();
+  constexpr int64_t kBatch = 8;
+  constexpr int64_t kHidden = 16;
+  constexpr int64_t kMicroBatches = 4;
+  const int64_t num_stages = communicator_->size();
+  const int64_t rank = communicator_->deviceId();
+
+  std::vector<PipelineStage> stages;
+  for ([[maybe_unused]] auto i : arange(num_stages)) {
+    stages.push_back(makeScaleStage(with_backward));
+  }
+  PipelineExecutorParams params;
+  params.num_micro_batches = kMicroBatches;
+  PipelineExecutor executor(
+      std::move(stages),
+      DeviceMesh::createForNumDevices(num_stages),
+      *communicator_,
+      params);
+  EXPECT_EQ(executor.stage(), rank);
+
+  // All devices generate the same tensors
+  at::manual_seed(0);
+  at::Tensor x = at::randn({kBatch, kHidden}, tensor_options);
+  std::vector<at::Tensor> ws;
+  for ([[maybe_unused]] auto i : arange(num_stages)) {
+    ws.push_back(at::randn({kHidden}, tensor_options));
+  }
+
+  KernelArgumentHolder outputs = executor.runWithInput({x}, {ws.at(rank)});
+
+  at::Tensor prod_w = at::ones({kHidden}, tensor_options);
+  for (const at::Tensor& w : ws) {
+    prod_w = prod_w * w;
+  }
+  int64_t num_outputs = with_backward ? 1 : 0;
+  if (rank == num_stages - 1) {
+    num_outputs += kMicroBatches;
+  }
+  ASSERT_EQ(outputs.size(), num_outputs);
+  if (rank == num_stages - 1) {
+    at::Tensor y = at::cat(
+        {outputs[0].as<at::Tensor>(),
+         outputs[1].as<at::Tensor>(),
+         outputs[2].as<at::Tensor>(),
+         outputs[3].as<at::Tensor>()});
+    EXPECT_TRUE(at::allclose(y, x * prod_w, 1e-4, 1e-5));
+  }
+  if (with_backward) {
+    at::Tensor expected_grad_w = x.sum(0);
+    for (auto i : arange(num_stages)) {
+      if (i != rank) {
+        expected_grad_w = expected_grad_w * ws.at(i);
+      }
+    }
+    EXPECT_TRUE(at::allclose(
+        outputs.back().as<at::Tensor>(), expected_grad_w, 1e-4, 1e-4));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    PipelineExecutorTest,
+    testing::Bool(),
+    [](const testing::TestParamInfo<bool>& info) -> std::string {
+      return info.param ? "1F1B" : "ForwardOnly";
+    });
+
 } // namespace nvfuser
@@ -59,6 +59,41 @@ TEST_F(MultiDeviceStreamParallelTypeTest, Allgather) {
       << "Output: " << output << "\nExpected: " << unsharded_input;
 }
 
+// Each run uses a different number of streams until the fastest is found
+TEST_F(MultiDeviceStreamParallelTypeTest, Allgather_AutotuneNumberOfStreams) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::Autotune, {"2"});
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  TensorView* tv1 = set(tv0);
+  fusion->addInput(tv0);
+  fusion->addOutput(tv1);
+
+  const DeviceMesh mesh =
+      DeviceMesh::createForNumDevices(communicator_->size());
+  tv0->setDeviceMesh(mesh);
+  tv1->setDeviceMesh(mesh);
+  tv0->axis(1)->parallelize(ParallelType::DIDx);
+  tv1->axis(0)->parallelize(ParallelType::Stream);
+
+  MultiDeviceExecutor executor(std::move(fusion), *communicator_);
+
+  auto options =
+      at::TensorOptions().device(at::kCUDA, communicator_->deviceId());
+  at::Tensor unsharded_input = at::rand({8, communicator_->size()}, options);
+  at::Tensor input = shardTensor(unsharded_input, /*axis=*/1, mesh);
+  // One untimed run and three rounds of the two candidates, then the tuned
+  // number of streams
+  for ([[maybe_unused]] auto i : arange(8)) {
+    auto output = executor.runWithInput(KernelArgumentHolder({input}))[0]
+                      .as<at::Tensor>();
+    EXPECT_TRUE(torch::allclose(output, unsharded_input, 1e-2, 1e-2))
+        << "Output: " << output << "\nExpected: " << unsharded_input;
+  }
+}
+
 TEST_F(MultiDeviceStreamParallelTypeTest, Allreduce) {
   auto fusion = std::make_unique<Fusion>();
   FusionGuard fg(fusion.get());
@@ -334,6 +369,79 @@ TEST_F(MultiDeviceStreamParallelTypeTest, matmul_RS_through_bcast) {
       << "Output: " << t2 << " Expected: " << t2_ref;
 }
 
+// Row-parallel matmul whose partial sums are reduce-scattered. The scattered
+// axis is chosen as stream axis by OverlapCollectiveMatmulPass, so that each
+// chunk is reduced to the device owning it as soon as it is computed.
+TEST_F(MultiDeviceStreamParallelTypeTest, matmul_RS_ByDestination_Automatic) {
+  constexpr int64_t M = 64;
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 8;
+  const int64_t D = communicator_->size();
+  if (M % D != 0 || K % D != 0) {
+    GTEST_SKIP() << "M and K must be multiples of D, but got M = " << M
+                 << ", K = " << K << ", D = " << D;
+  }
+
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::CollectiveMatmul, {"0"});
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(4); //[DIDx(D), D, M/D, K/D]
+  TensorView* tv1 = makeContigTensor(3); //[DIDx(D), K/D, N]
+  TensorView* tv1b =
+      broadcast(tv1, {false, true, false, false}); //[DIDx(D), 1, K/D, N]
+  TensorView* tv2_unreduced =
+      matmul(tv0, tv1b); //[DIDx(D), Stream(D), M/D, N]
+  TensorView* tv2 = sum(tv2_unreduced, {0}); //[r(D), DIDx(D), M/D, N]
+
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addOutput(tv2);
+
+  auto mesh = DeviceMesh::createForNumDevices(D);
+  tv0->setDeviceMesh(mesh);
+  tv1->setDeviceMesh(mesh);
+  tv2_unreduced->setDeviceMesh(mesh);
+  tv2->setDeviceMesh(mesh);
+
+  tv0->axis(0)->parallelize(ParallelType::DIDx);
+  tv1->axis(0)->parallelize(ParallelType::DIDx);
+  tv2_unreduced->axis(0)->parallelize(ParallelType::DIDx);
+  tv2->axis(1)->parallelize(ParallelType::DIDx);
+
+  MultiDeviceExecutor executor(std::move(fusion), *communicator_);
+
+  hir::HostIrContainer* container = executor.hostIrEvaluator()->container();
+  EXPECT_THAT(
+      container->topLevelExprs(),
+      ElementsAre(
+          IsA<hir::PostOnStream>(),
+          IsA<kir::Allocate>(),
+          IsA<kir::Allocate>(),
+          IsA<hir::GetCurrentStream>(),
+          IsA<ForLoop>(),
+          IsA<ForLoop>()));
+
+  auto tensor_options =
+      at::TensorOptions().dtype(at::kFloat).device(communicator_->device());
+  auto t0_unsharded = at::randn({D, D, M / D, K / D}, tensor_options);
+  auto t1_unsharded = at::randn({D, K / D, N}, tensor_options);
+  auto t0 = shardTensor(t0_unsharded, /*axis=*/0, mesh);
+  auto t1 = shardTensor(t1_unsharded, /*axis=*/0, mesh);
+
+  auto t2 = executor.runWithInput({t0, t1})[0].as<at::Tensor>();
+
+  auto t2_unreduced_unsharded =
+      at::matmul(t0_unsharded, t1_unsharded.unsqueeze(1)); // {D, D, M/D, N}
+  auto t2_ref = shardTensor(
+      at::sum(t2_unreduced_unsharded, {0}), /*axis=*/0, mesh); // {1, M/D, N}
+  EXPECT_TRUE(torch::allclose(t2_ref, t2, 1e-1, 1e-1))
+      << "Output: " << t2 << " Expected: " << t2_ref;
+}
+
 TEST_F(MultiDeviceStreamParallelTypeTest, AllgatherP2p) {
   auto fusion = std::make_unique<Fusion>();
   FusionGuard fg(fusion.get());
@@ -425,4 +533,63 @@ TEST_F(MultiDeviceStreamParallelTypeTest, AG_matmul_P2p) {
   EXPECT_TRUE(torch::allclose(t2_ref, t2, 1e-2, 1e-2));
 }
 
+// Same as AG_matmul_P2p, but the stream axes are chosen by
+// OverlapCollectiveMatmulPass instead of the user
+TEST_F(MultiDeviceStreamParallelTypeTest, AG_matmul_P2p_Automatic) {
+  constexpr int64_t M = 32768;
+  constexpr int64_t K = 32768;
+  constexpr int64_t N = 1024;
+  const int64_t D = communicator_->size();
+  if (M % D != 0) {
+    GTEST_SKIP() << "M must be a multiple of D, but got M = " << M
+                 << ", D = " << D;
+  }
+
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::CollectiveMatmul, {"0"});
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(3); //[DIDx(D), M/D, K]
+  TensorView* tv1 = makeContigTensor(2); //[K, N]
+  TensorView* tv2 = matmul(tv0, tv1); //[D, M/D, N]
+
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addOutput(tv2);
+
+  auto mesh = DeviceMesh::createForNumDevices(D);
+  tv0->setDeviceMesh(mesh);
+  tv1->setDeviceMesh(mesh);
+  tv2->setDeviceMesh(mesh);
+
+  tv0->axis(0)->parallelize(ParallelType::DIDx);
+
+  MultiDeviceExecutor executor(std::move(fusion), *communicator_);
+
+  hir::HostIrContainer* container = executor.hostIrEvaluator()->container();
+  EXPECT_THAT(
+      container->topLevelExprs(),
+      ElementsAre(
+          IsA<kir::Allocate>(),
+          IsA<kir::Allocate>(),
+          IsA<hir::GetCurrentStream>(),
+          IsA<ForLoop>(),
+          IsA<ForLoop>()));
+
+  auto tensor_options =
+      at::TensorOptions().dtype(at::kFloat).device(communicator_->device());
+  auto t0_unsharded = at::randn({D, M / D, K}, tensor_options);
+  auto t0 = t0_unsharded.slice(
+      0, communicator_->deviceId(), communicator_->deviceId() + 1);
+  auto t1 = at::randn({K, N}, tensor_options);
+
+  auto t2 = executor.runWithInput({t0, t1})[0].as<at::Tensor>();
+
+  auto t2_ref = at::matmul(t0_unsharded, t1);
+  EXPECT_TRUE(torch::allclose(t2_ref, t2, 1e-2, 1e-2));
+}
+
 } // namespace nvfuser
@@ -1908,4 +1908,105 @@ TEST_F(PersistentBufferTest, BroadcastSyncInputsHasBcast) {
       ke.run({t0, t1}, {}, heuristic_params->as<ReductionParams>()->lparams);
   testValidate(&unscheduled_fusion_copy, outputs, {t0, t1}, __LINE__, __FILE__);
 }
+
+// Forward normalizations on Hopper load the persistent buffers with 1D TMA
+// and circular buffer them across rows. The inputs are float so that they
+// are the persistent buffers without projection.
+TEST_F(PersistentBufferTest, TmaWarpSpecializedLayerNorm) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(9, 0);
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::WarpSpecializedNormalization);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  const float kEps = 1e-5;
+  constexpr int64_t dim0 = 2048;
+  constexpr int64_t hidden_size = 8192;
+  std::vector<int64_t> norm_shape{hidden_size};
+
+  auto input = makeContigTensor(2);
+  auto weight = makeContigTensor(1);
+  auto bias = makeContigTensor(1);
+  fusion.addInput(input);
+  fusion.addInput(weight);
+  fusion.addInput(bias);
+  auto result = layer_norm(
+      input, norm_shape, weight, bias, IrBuilder::create<Val>(kEps));
+  fusion.addOutput(result.output);
+  auto fusion_copy = fusion;
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({dim0, hidden_size}, options);
+  at::Tensor t1 = at::randn({hidden_size}, options);
+  at::Tensor t2 = at::randn({hidden_size}, options);
+
+  auto cg_results =
+      scheduleAndRun(&fusion, SchedulerType::InnerPersistent, {t0, t1, t2});
+  auto rparams = cg_results.heuristic_params->as<ReductionParams>();
+  EXPECT_TRUE(rparams->tma_warp_specialized);
+  EXPECT_GT(rparams->circular_buffer_options.stage, 1);
+  testValidate(
+      &fusion_copy, cg_results.outputs, {t0, t1, t2}, __LINE__, __FILE__);
+}
+
+TEST_F(PersistentBufferTest, TmaWarpSpecializedSoftmax) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(9, 0);
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::WarpSpecializedNormalization);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  constexpr int64_t dim0 = 4096;
+  constexpr int64_t dim1 = 4096;
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = softmax(tv0, 1);
+  fusion.addOutput(tv1);
+  auto fusion_copy = fusion;
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({dim0, dim1}, options);
+
+  auto cg_results =
+      scheduleAndRun(&fusion, SchedulerType::InnerPersistent, {t0});
+  auto rparams = cg_results.heuristic_params->as<ReductionParams>();
+  EXPECT_TRUE(rparams->tma_warp_specialized);
+  testValidate(&fusion_copy, cg_results.outputs, {t0}, __LINE__, __FILE__);
+}
+
+// Rows too large for the registers and shared memory of a block are split
+// across the blocks of a cluster
+TEST_F(PersistentBufferTest, ClusterInnerPersistentSoftmax) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(9, 0);
+  EnableOptionsGuard opt_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::ClusterReduction);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  constexpr int64_t dim0 = 1024;
+  constexpr int64_t dim1 = 128 * 1024;
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = softmax(tv0, 1);
+  fusion.addOutput(tv1);
+  auto fusion_copy = fusion;
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({dim0, dim1}, options);
+
+  auto cg_results =
+      scheduleAndRun(&fusion, SchedulerType::InnerPersistent, {t0});
+  auto rparams = cg_results.heuristic_params->as<ReductionParams>();
+  EXPECT_TRUE(rparams->cluster_inner_reduction);
+  EXPECT_GT(rparams->lparams.gdimx(), 1);
+  testValidate(&fusion_copy, cg_results.outputs, {t0}, __LINE__, __FILE__);
+}
 } // namespace nvfuser
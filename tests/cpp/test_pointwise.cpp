@@ -14,7 +14,10 @@
 #include <preseg_passes/mark_aliases_prepare.h>
 #include <preseg_passes/optimization_pass.h>
 #include <runtime/fusion_executor_cache.h>
+#include <scheduler/autotune.h>
+#include <scheduler/heuristic_plugin.h>
 #include <scheduler/tools/domain_map.h>
+#include <scheduler/utils.h>
 #include <tests/cpp/utils.h>
 #include <tests/cpp/validator.h>
 
@@ -1435,4 +1438,298 @@ TEST_F(
   }
 }
 
+namespace {
+
+// Problem description seen by TestHeuristicConfig
+struct TestHeuristicProblem {
+  heuristic_plugin::KernelConfig::ProblemDescription::SchedulerType
+      scheduler_type;
+  std::vector<int64_t> extents;
+  std::string input_dtypes;
+  std::string output_dtypes;
+  int64_t supported_vec_size = 0;
+} test_heuristic_problem;
+
+class TestHeuristicConfig : public heuristic_plugin::KernelConfig {
+  void configure() override {
+    test_heuristic_problem.scheduler_type = problem.scheduler_type;
+    test_heuristic_problem.extents.assign(
+        problem.extents, problem.extents + problem.num_dims);
+    test_heuristic_problem.input_dtypes = problem.input_dtypes;
+    test_heuristic_problem.output_dtypes = problem.output_dtypes;
+    test_heuristic_problem.supported_vec_size =
+        problem.supported_vec_size.group1;
+
+    // The default heuristic vectorizes by 4 and doesn't unroll
+    pointwise.vectorization_factor = 2;
+    pointwise.unroll_factor_inner = 2;
+  }
+};
+
+} // namespace
+
+TEST_F(PointwiseTest, HeuristicPlugin) {
+  heuristic_plugin::KernelConfigFactoryGuard factory_guard([]() {
+    return std::unique_ptr<heuristic_plugin::KernelConfig>(
+        new TestHeuristicConfig);
+  });
+  EXPECT_TRUE(heuristic_plugin::hasPlugin());
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeContigTensor(2);
+  auto tv1 = makeContigTensor(2, DataType::Half);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  auto tv2 = add(tv0, castOp(DataType::Float, tv1));
+  fusion->addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({128, 1024}, options);
+  auto t1 = at::randn({128, 1024}, options.dtype(at::kHalf));
+
+  auto cg_results =
+      scheduleAndRun(fusion.get(), SchedulerType::PointWise, {t0, t1});
+  auto pparams = cg_results.heuristic_params->as<PointwiseParams>();
+  EXPECT_EQ(pparams->vectorization_factor, 2);
+  EXPECT_EQ(pparams->unroll_factor_inner, 2);
+
+  EXPECT_EQ(
+      test_heuristic_problem.scheduler_type,
+      heuristic_plugin::KernelConfig::ProblemDescription::SchedulerType::
+          PointWise);
+  EXPECT_THAT(test_heuristic_problem.extents, testing::ElementsAre(128, 1024));
+  EXPECT_EQ(test_heuristic_problem.input_dtypes, "SH");
+  EXPECT_EQ(test_heuristic_problem.output_dtypes, "S");
+  EXPECT_EQ(test_heuristic_problem.supported_vec_size, 4);
+
+  testValidate(fusion.get(), cg_results.outputs, {t0, t1}, __LINE__, __FILE__);
+}
+
+TEST_F(PointwiseTest, Autotune) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::Autotune, {"4"});
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto fusion = fusion_ptr.get();
+  FusionGuard fg(fusion);
+
+  auto tv0 = makeContigTensor(1);
+  fusion->addInput(tv0);
+  auto tv1 = sin(tv0);
+  fusion->addOutput(tv1);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({1 << 20}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  // The winner is recorded in the tuning database and the runtime compiled
+  // the segment with it.
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  SegmentedGroup* group = runtime->fusionSegments()->groups().at(0);
+  const HeuristicParams* params =
+      runtime->schedulerHeuristics()->at(group->groupId()).get();
+  FusionGuard group_fg(group->getFusion());
+  KernelArgumentHolder args({t0});
+  SchedulerRuntimeInfo runtime_info(group->getFusion(), args);
+  std::optional<autotune::TuningKnobs> knobs = autotune::queryTunedKnobs(
+      autotune::tuningKey(params, group->getFusion(), runtime_info));
+  ASSERT_TRUE(knobs.has_value());
+  auto tuned_params = params->clone();
+  autotune::applyKnobs(tuned_params.get(), *knobs);
+  EXPECT_TRUE(tuned_params->sameAs(params));
+}
+
+TEST_F(PointwiseTest, TmaLoadAndStore) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(9, 0);
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::TmaPointwise);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto fusion = fusion_ptr.get();
+  FusionGuard fg(fusion);
+
+  // tv0 and tv1 are loaded with TMA. The broadcast input tv2 is loaded to
+  // registers.
+  auto tv0 = makeContigTensor(2);
+  auto tv1 = makeContigTensor(2);
+  auto tv2 = makeContigTensor(1);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addInput(tv2);
+  auto tv3 = mul(add(tv0, tv1), broadcast(tv2, {false, true}));
+  fusion->addOutput(tv3);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  // The inner extent isn't a multiple of the tile
+  auto t0 = at::randn({1000, 2056}, options);
+  auto t1 = at::randn({1000, 2056}, options);
+  auto t2 = at::randn({1000}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1, t2});
+  testValidate(
+      executor_cache.fusion(), outputs, {t0, t1, t2}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const auto* pparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<PointwiseParams>();
+  EXPECT_TRUE(pparams->use_tma_load);
+  EXPECT_TRUE(pparams->use_tma_store);
+  EXPECT_GE(pparams->circular_buffer_stages, 2);
+}
+
+TEST_F(PointwiseTest, TmaBulkCopy) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(9, 0);
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::TmaPointwise);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto fusion = fusion_ptr.get();
+  FusionGuard fg(fusion);
+
+  auto tv0 = makeContigTensor(2, DataType::BFloat16);
+  auto tv1 = makeContigTensor(2, DataType::BFloat16);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addOutput(set(tv0));
+  fusion->addOutput(set(tv1));
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA, 0);
+  // The inner extent isn't a multiple of the tile
+  auto t0 = at::randn({1000, 2056}, options);
+  auto t1 = at::randn({1000, 2056}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+  testValidate(executor_cache.fusion(), outputs, {t0, t1}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const auto* pparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<PointwiseParams>();
+  EXPECT_TRUE(pparams->tma_bulk_copy);
+  EXPECT_TRUE(pparams->use_tma_store);
+  // A single thread per block issues the copies
+  auto ke = runtime->executors().at(0)->as<KernelExecutor>();
+  EXPECT_EQ(ke->lastLaunchParams().nThreads(), 1);
+}
+
+TEST_F(PointwiseTest, PersistentGrid) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::PersistentGrid);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto fusion = fusion_ptr.get();
+  FusionGuard fg(fusion);
+
+  auto tv0 = makeContigTensor(1);
+  auto tv1 = makeContigTensor(1);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  auto tv2 = add(tv0, tv1);
+  fusion->addOutput(tv2);
+
+  // Many more tiles than resident blocks, and not a multiple of the tile size
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({(1L << 26) + 7}, options);
+  auto t1 = at::randn({(1L << 26) + 7}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+  testValidate(executor_cache.fusion(), outputs, {t0, t1}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  const auto* pparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<PointwiseParams>();
+  EXPECT_TRUE(pparams->persistent_grid);
+  EXPECT_EQ(
+      pparams->lparams.gdimx(),
+      scheduler_utils::maxResidentBlocks(pparams->threads_per_block_1d));
+}
+
+TEST_F(PointwiseTest, MixedVectorization) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::MixedVectorization);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto fusion = fusion_ptr.get();
+  FusionGuard fg(fusion);
+
+  auto tv0 = makeContigTensor(2, DataType::BFloat16);
+  auto tv1 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  auto tv2 = add(castOp(DataType::Float, tv0), tv1);
+  auto tv3 = castOp(DataType::BFloat16, tv2);
+  fusion->addOutput(tv3);
+
+  auto t0 = at::randn(
+      {1024, 1024}, at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA));
+  auto t1 = at::randn(
+      {1024, 1024}, at::TensorOptions().dtype(at::kFloat).device(at::kCUDA));
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+  testValidate(executor_cache.fusion(), outputs, {t0, t1}, __LINE__, __FILE__);
+
+  // The bf16 tensors move 16 bytes per access, and the fp32 input is read
+  // by two accesses of 4 elements
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  const auto* pparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<PointwiseParams>();
+  EXPECT_EQ(pparams->vectorization_factor, 8);
+  EXPECT_EQ(pparams->input_vectorization_factors, std::vector<int64_t>({8, 4}));
+  EXPECT_EQ(pparams->output_vectorization_factors, std::vector<int64_t>({8}));
+}
+
+TEST_F(PointwiseTest, RegisterSpillFeedbackCandidates) {
+  PointwiseParams pparams;
+  pparams.cparams.index_type = PrimDataType::Int;
+  pparams.cparams.maxrregcount = 64;
+  pparams.unroll_factor_inner = 4;
+
+  // The register limit of the heuristic is lifted first, then the unroll
+  // factor is halved until there's nothing left to try.
+  std::optional<autotune::TuningCandidate> candidate =
+      autotune::spillFeedbackCandidate(&pparams, autotune::TuningKnobs{});
+  ASSERT_TRUE(candidate.has_value());
+  EXPECT_EQ(candidate->knobs.max_registers, 255);
+  EXPECT_EQ(candidate->knobs.unroll_factor, 0);
+  EXPECT_EQ(candidate->params->cparams.maxrregcount, 255);
+
+  for (int64_t unroll_factor : {2, 1}) {
+    candidate = autotune::spillFeedbackCandidate(
+        candidate->params.get(), candidate->knobs);
+    ASSERT_TRUE(candidate.has_value());
+    EXPECT_EQ(candidate->knobs.max_registers, 255);
+    EXPECT_EQ(candidate->knobs.unroll_factor, unroll_factor);
+    EXPECT_EQ(
+        candidate->params->as<PointwiseParams>()->unroll_factor_inner,
+        unroll_factor);
+  }
+  EXPECT_FALSE(autotune::spillFeedbackCandidate(
+                   candidate->params.get(), candidate->knobs)
+                   .has_value());
+
+  // The knobs round-trip through the tuning database
+  std::optional<autotune::TuningKnobs> knobs =
+      autotune::TuningKnobs::fromString(candidate->knobs.toString());
+  ASSERT_TRUE(knobs.has_value());
+  EXPECT_EQ(*knobs, candidate->knobs);
+}
+
 } // namespace nvfuser
@@ -13,6 +13,7 @@
 #include <ir/utils.h>
 #include <ops/all_ops.h>
 #include <preseg_passes/consecutive_cast.h>
+#include <preseg_passes/eliminate_common_subexpressions.h>
 #include <preseg_passes/move_gather.h>
 #include <preseg_passes/optimization_pass.h>
 #include <preseg_passes/pre_segmenter.h>
@@ -1259,6 +1260,120 @@ TEST_F(PresegTest, FusionTestCastOptimizationMetaOp6) {
   testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
 }
 
+TEST_F(PresegTest, EliminateCommonSubexpressions) {
+  auto fusion_ptr = std::make_unique<Fusion>();
+  Fusion& fusion = *fusion_ptr;
+  FusionGuard fg(&fusion);
+
+  // A LayerNorm decomposed with the mean and `x - mean` computed twice
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto mean = [&]() {
+    return div(sum(tv0, {1}, /*keep_dim=*/true), tv0->axis(1)->extent());
+  };
+  auto centered = sub(tv0, mean());
+  auto var = div(
+      sum(mul(centered, centered), {1}, /*keep_dim=*/true),
+      tv0->axis(1)->extent());
+  auto eps = IrBuilder::create<Val>(1e-5);
+  auto tv1 = mul(sub(tv0, mean()), rsqrt(add(var, eps)));
+  fusion.addOutput(tv1);
+
+  auto num_reductions = [](Fusion& fusion) {
+    auto exprs = fusion.exprs();
+    return std::count_if(exprs.begin(), exprs.end(), [](Expr* expr) {
+      return expr->isA<ReductionOp>();
+    });
+  };
+  {
+    Fusion fusion_copy = fusion;
+    EXPECT_EQ(num_reductions(fusion_copy), 3);
+    OptimizationPass<EliminateCommonSubexpressionsPass>::runPass(&fusion_copy);
+    EXPECT_EQ(num_reductions(fusion_copy), 2);
+  }
+
+  auto options = at::TensorOptions().device(at::kCUDA, 0);
+  auto t0 = at::randn({128, 1024}, options);
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+}
+
+TEST_F(PresegTest, EliminateCastRoundTripAcrossBroadcast) {
+  auto fusion_ptr = std::make_unique<Fusion>();
+  Fusion& fusion = *fusion_ptr;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeContigTensor(1, DataType::BFloat16);
+  fusion.addInput(tv0);
+  auto tv1 = makeContigTensor(2, DataType::BFloat16);
+  fusion.addInput(tv1);
+  auto tv2 = castOp(DataType::Float, tv0);
+  auto tv3 = broadcast(tv2, {false, true});
+  auto tv4 = castOp(DataType::BFloat16, tv3);
+  auto tv5 = add(tv4, tv1);
+  fusion.addOutput(tv5);
+
+  {
+    Fusion fusion_copy = fusion;
+    OptimizationPass<EliminateCommonSubexpressionsPass>::runPass(&fusion_copy);
+    // tv0 is broadcast without being cast
+    Val* in = fusion_copy.inputs().at(0);
+    auto exprs = fusion_copy.exprs();
+    EXPECT_TRUE(std::none_of(exprs.begin(), exprs.end(), [&](Expr* expr) {
+      return expr->isA<UnaryOp>() && expr->input(0) == in;
+    }));
+    EXPECT_TRUE(std::any_of(exprs.begin(), exprs.end(), [&](Expr* expr) {
+      return expr->isA<BroadcastOp>() && expr->input(0) == in;
+    }));
+  }
+
+  auto options = at::TensorOptions().device(at::kCUDA, 0).dtype(at::kBFloat16);
+  auto t0 = at::randn({128}, options);
+  auto t1 = at::randn({128, 64}, options);
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+  testValidate(executor_cache.fusion(), outputs, {t0, t1}, __LINE__, __FILE__);
+}
+
+// A narrowing round trip rounds its input and must be kept
+TEST_F(PresegTest, KeepLossyCastRoundTripAcrossBroadcast) {
+  auto fusion_ptr = std::make_unique<Fusion>();
+  Fusion& fusion = *fusion_ptr;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeContigTensor(1);
+  fusion.addInput(tv0);
+  auto tv1 = makeContigTensor(2);
+  fusion.addInput(tv1);
+  auto tv2 = castOp(DataType::BFloat16, tv0);
+  auto tv3 = broadcast(tv2, {false, true});
+  auto tv4 = castOp(DataType::Float, tv3);
+  auto tv5 = add(tv4, tv1);
+  fusion.addOutput(tv5);
+
+  {
+    Fusion fusion_copy = fusion;
+    OptimizationPass<EliminateCommonSubexpressionsPass>::runPass(&fusion_copy);
+    // tv0 is still cast to bfloat16 before being broadcast
+    Val* in = fusion_copy.inputs().at(0);
+    auto exprs = fusion_copy.exprs();
+    EXPECT_TRUE(std::any_of(exprs.begin(), exprs.end(), [&](Expr* expr) {
+      return expr->isA<UnaryOp>() && expr->input(0) == in;
+    }));
+    EXPECT_TRUE(std::none_of(exprs.begin(), exprs.end(), [&](Expr* expr) {
+      return expr->isA<BroadcastOp>() && expr->input(0) == in;
+    }));
+  }
+
+  auto options = at::TensorOptions().device(at::kCUDA, 0);
+  auto t0 = at::randn({128}, options);
+  auto t1 = at::randn({128, 64}, options);
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+  testValidate(executor_cache.fusion(), outputs, {t0, t1}, __LINE__, __FILE__);
+}
+
 struct MatmulInputShape {
   std::vector<int64_t> shape_a;
   std::vector<int64_t> shape_b;
@@ -1450,6 +1565,46 @@ TEST_F(PresegTest, MoveGatherOverSqueezeAndCast) {
   EXPECT_EQ(new_squeeze_ops.size(), 1);
 }
 
+TEST_F(PresegTest, MoveGatherOverLogSoftmax) {
+  auto fusion_ptr = std::make_unique<Fusion>();
+  Fusion& fusion = *fusion_ptr.get();
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeContigTensor(2, DataType::BFloat16);
+  fusion.addInput(tv0);
+  auto tv1 = makeContigTensor(1, DataType::Int);
+  fusion.addInput(tv1);
+
+  // The cross-entropy loss of the logits tv0 for the labels tv1
+  auto tv2 = castOp(DataType::Float, tv0);
+  auto tv3 = log_softmax(tv2, -1);
+  auto tv4 = broadcast(tv1, {false, true});
+  auto tv5 = takeAlongAxis(tv3, tv4, -1);
+  auto tv6 = neg(squeeze(tv5, {1}));
+  auto tv7 = mean(tv6, {0}, /*keepdim=*/false);
+  fusion.addOutput(tv7);
+
+  OptimizationPass<MoveGatherPass>::runPass(&fusion);
+
+  // The labels are gathered from the logits, so the log-probs have no use and
+  // aren't computed.
+  auto gather_ops = ir_utils::getOpsOfType<GatherOp>(&fusion);
+  ASSERT_EQ(gather_ops.size(), 1);
+  EXPECT_EQ(gather_ops.at(0)->lookupTv(), tv0);
+  EXPECT_TRUE(tv3->uses().empty());
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA, 0);
+  auto t0 = at::randn({64, 1000}, options);
+  auto t1 = at::randint(0, 1000, {64}, options.dtype(at::kLong));
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+
+  auto ref = at::cross_entropy_loss(t0.to(at::kFloat), t1);
+  testValidate(
+      executor_cache.fusion(), outputs, {t0, t1}, {ref}, __LINE__, __FILE__);
+}
+
 using TranslateNoReductionMatmulTest =
     NVFuserFixtureParamTest<MatmulInputShape>;
 
@@ -260,4 +260,57 @@ TEST_F(NVFuserTest, ReductionSchedulerWithAdditionalIDOuterNormalization) {
   testValidate(&fusion, outputs, inputs, __LINE__, __FILE__);
 }
 
+// The amax of delayed-scaling FP8 training is reduced across the grid with
+// atomics next to the quantized output, without a work buffer or a grid sync,
+// with EnableOption::AtomicMaxReduction
+TEST_F(PointwiseFusedReductionTest, Fp8QuantizeWithAmax) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(8, 9);
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::AtomicMaxReduction);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeContigTensor(2);
+  auto scale = IrBuilder::create<Val>(DataType::Double);
+  fusion->addInput(tv0);
+  fusion->addInput(scale);
+  auto tv1 = castOp(DataType::Float8_e4m3fn, mul(tv0, scale));
+  auto tv2 = max(abs(tv0), {0, 1});
+  fusion->addOutput(tv1);
+  fusion->addOutput(tv2);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({8192, 1024}, options);
+  KernelArgumentHolder inputs = {t0, 2.0};
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  // The amax is reset before each launch
+  for ([[maybe_unused]] auto i : arange(2)) {
+    auto outputs = executor_cache.runFusionWithInputs(inputs);
+    EXPECT_TRUE(at::equal(
+        outputs[0].as<at::Tensor>().to(at::kFloat),
+        (t0 * 2.0).to(at::kFloat8_e4m3fn).to(at::kFloat)));
+    EXPECT_TRUE(at::equal(outputs[1].as<at::Tensor>(), t0.abs().amax()));
+  }
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_FALSE(runtime->isSegmented());
+  const auto* rparams = runtime->schedulerHeuristics()
+                            ->heuristicsList()
+                            .at(0)
+                            ->as<ReductionParams>();
+  ASSERT_TRUE(rparams->cross_grid_inner_reduction);
+  EXPECT_TRUE(rparams->atomic_inner_reduction);
+
+  const auto& summary = runtime->executors()
+                            .at(0)
+                            ->as<KernelExecutor>()
+                            ->compiledKernel()
+                            ->kernel()
+                            ->summary();
+  EXPECT_FALSE(summary.has_grid_reductions);
+  EXPECT_EQ(summary.atomic_reduction_outputs.size(), 1);
+}
+
 } // namespace nvfuser
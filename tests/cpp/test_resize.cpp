@@ -16,6 +16,7 @@
 #include <runtime/executor.h>
 #include <runtime/executor_utils.h>
 #include <runtime/fusion_executor_cache.h>
+#include <scheduler/resize_heuristic.h>
 #include <scheduler/tools/inlining.h>
 #include <scheduler/tools/loop_domain_scheduler.h>
 #include <scheduler/tools/resize_utils.h>
@@ -5892,6 +5893,47 @@ TEST_F(ResizeTest, VectorizeInnermostWithReshapeMerge) {
   EXPECT_EQ(tv3->getLoopDomain().back()->extent()->evaluate(), 4);
 }
 
+// A slice offset that isn't divisible by the vectorization factor
+// only prevents vectorizing the sliced input. The other input and
+// the output are still vectorized.
+TEST_F(ResizeTest, VectorizeWithMisalignedSliceOffset) {
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  std::vector<int64_t> shape1{1024, 130};
+  std::vector<int64_t> shape2{1024, 128};
+
+  auto tv0 = makeContigConcreteTensor(shape1);
+  fusion.addInput(tv0);
+  auto tv1 = makeContigConcreteTensor(shape2);
+  fusion.addInput(tv1);
+
+  auto tv2 = slice(
+      tv0,
+      {{IrBuilder::create<Val>(0L), IrBuilder::create<Val>(shape1[0])},
+       {IrBuilder::create<Val>(1L), IrBuilder::create<Val>(129L)}});
+  auto tv3 = add(tv2, tv1);
+  fusion.addOutput(tv3);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn(shape1, options);
+  auto t1 = at::randn(shape2, options);
+
+  auto outputs = scheduleAndRun(&fusion, SchedulerType::Resize, {t0, t1});
+  testValidate(&fusion, outputs.outputs, {t0, t1}, __LINE__, __FILE__);
+
+  auto rparams = outputs.heuristic_params->as<ResizeParams>();
+  EXPECT_EQ(rparams->vectorization_factor, 4);
+  EXPECT_THAT(rparams->unvectorized_inputs, testing::ElementsAre(0));
+  EXPECT_TRUE(rparams->unvectorized_outputs.empty());
+
+  EXPECT_EQ(
+      tv3->getLoopDomain().back()->getParallelType(), ParallelType::Vectorize);
+  EXPECT_NE(
+      tv2->getLoopDomain().back()->getParallelType(), ParallelType::Vectorize);
+}
+
 TEST_F(ResizeTest, AvoidCachingSliceInput) {
   auto fusion = std::make_unique<Fusion>();
   FusionGuard fg(fusion.get());
@@ -6211,4 +6253,59 @@ TEST_F(ResizeTest, ReorderLikeInputShouldNotMoveInnermostID) {
   testValidate(&fusion, outputs.outputs, {t0}, __LINE__, __FILE__);
 }
 
+
+// The rotation of the halves of RoPE is computed by the same thread for
+// both halves unless disabled
+TEST_F(ResizeTest, RotaryPairs) {
+  const std::vector<int64_t> shape{2, 8, 64, 128};
+  const int64_t half = shape.back() / 2;
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn(shape, options);
+  auto t1 = at::randn({shape[2], shape[3]}, options);
+  auto t2 = at::randn({shape[2], shape[3]}, options);
+
+  for (bool disabled : {false, true}) {
+    auto fusion_ptr = std::make_unique<Fusion>();
+    Fusion& fusion = *fusion_ptr;
+    FusionGuard fg(fusion_ptr.get());
+
+    auto tv0 = makeContigConcreteTensor(shape);
+    fusion.addInput(tv0);
+    auto tv1 = makeContigConcreteTensor({shape[2], shape[3]});
+    fusion.addInput(tv1);
+    auto tv2 = makeContigConcreteTensor({shape[2], shape[3]});
+    fusion.addInput(tv2);
+
+    auto slice_last = [&](int64_t start, int64_t stop) {
+      std::vector<Slice> ranges;
+      for (auto id : tv0->getLogicalDomain()) {
+        ranges.push_back({fusion.zeroVal(), id->extent()});
+      }
+      ranges.back() = {
+          IrBuilder::create<Val>(start), IrBuilder::create<Val>(stop)};
+      return slice(tv0, ranges);
+    };
+    auto tv3 = cat(
+        {neg(slice_last(half, shape.back())), slice_last(0, half)}, -1);
+    auto tv4 = add(
+        mul(tv0, broadcast(tv1, {true, true, false, false})),
+        mul(tv3, broadcast(tv2, {true, true, false, false})));
+    fusion.addOutput(tv4);
+
+    DisableOptionsGuard disable_options_guard;
+    if (disabled) {
+      DisableOptionsGuard::getCurOptions().set(
+          DisableOption::ResizeRotaryPairs);
+    }
+    auto outputs =
+        scheduleAndRun(&fusion, SchedulerType::Resize, {t0, t1, t2});
+    testValidate(&fusion, outputs.outputs, {t0, t1, t2}, __LINE__, __FILE__);
+
+    auto rparams = outputs.heuristic_params->as<ResizeParams>();
+    EXPECT_EQ(rparams->rotary_pairs, !disabled);
+    EXPECT_EQ(rparams->vectorization_factor, 4);
+  }
+}
+
 } // namespace nvfuser
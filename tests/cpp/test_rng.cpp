@@ -558,4 +558,35 @@ TEST_F(RNGTest, DifferentOffsets) {
   }
 }
 
+TEST_F(RNGTest, InterleavedSequences) {
+  // RNGOps of different sequences in the same loop keep the outputs of their
+  // own Philox calls, and match the RNGOps computed alone.
+  auto make_fusion = [](int64_t num_sequences) {
+    auto fusion_ptr = std::make_unique<Fusion>();
+    FusionGuard fg(fusion_ptr.get());
+    TensorView* tv0 = makeContigTensor(1);
+    fusion_ptr->addInput(tv0);
+    Val* seed = IrBuilder::create<Val>(DataType::Int);
+    fusion_ptr->addInput(seed);
+    for ([[maybe_unused]] auto i : arange(num_sequences)) {
+      Val* offset = IrBuilder::create<Val>(DataType::Int);
+      fusion_ptr->addInput(offset);
+      fusion_ptr->addOutput(rand_like(tv0, seed, offset));
+    }
+    return fusion_ptr;
+  };
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::zeros({10001}, options);
+
+  FusionExecutorCache interleaved(make_fusion(2));
+  auto outputs = interleaved.runFusionWithInputs({t0, 7L, 4L, 8L});
+
+  FusionExecutorCache alone(make_fusion(1));
+  auto ref0 = alone.runFusionWithInputs({t0, 7L, 4L});
+  auto ref1 = alone.runFusionWithInputs({t0, 7L, 8L});
+  EXPECT_TRUE(at::equal(outputs[0].as<at::Tensor>(), ref0[0].as<at::Tensor>()));
+  EXPECT_TRUE(at::equal(outputs[1].as<at::Tensor>(), ref1[0].as<at::Tensor>()));
+}
+
 } // namespace nvfuser
@@ -8,17 +8,34 @@
 
 // delete intermediate tensors between segments to reduce memory usage of large
 // segmented graphs
+#include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
 #include <c10/util/env.h>
 
 #include <fusion.h>
 #include <fusion_guard.h>
 #include <global_allocator.h>
+#include <ops/alias.h>
 #include <ops/arith.h>
+#include <runtime/compile_thread_pool.h>
+#include <runtime/compiled_kernel.h>
+#include <runtime/executor_kernel_arg.h>
+#include <runtime/fusion_cache_utils.h>
+#include <runtime/fusion_executor_cache.h>
+#include <scheduler/matmul_heuristic.h>
+#include <scheduler/transpose_heuristic.h>
+#include <serde/heuristic_params.h>
 #include <tests/cpp/utils.h>
 #include <tests/cpp/validator.h>
 
+#include <chrono>
+#include <string_view>
+#include <thread>
+
 namespace nvfuser {
 
 using RuntimeTest = NVFuserTest;
@@ -72,4 +89,1080 @@ TEST_F(RuntimeTest, ClearGmemBetweenSegments) {
          "when executing group 1.";
 }
 
+TEST_F(RuntimeTest, HeuristicSignature) {
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 1024}, options);
+  at::Tensor t1 = at::randn({256, 1024}, options);
+  at::Tensor t2 = at::randn({256, 1023}, options);
+
+  // Only the outer extent differs, which doesn't affect vectorization
+  EXPECT_EQ(computeHeuristicSignature({t0}), computeHeuristicSignature({t1}));
+  // An odd inner extent limits the vectorization factor
+  EXPECT_NE(computeHeuristicSignature({t1}), computeHeuristicSignature({t2}));
+  // A misaligned data pointer limits the vectorization factor
+  EXPECT_NE(
+      computeHeuristicSignature({t1}),
+      computeHeuristicSignature({t1.flatten().narrow(0, 1, 1024 * 255)}));
+  // Forcing the index type changes the signature
+  EXPECT_NE(
+      computeHeuristicSignature({t1}, PrimDataType::Int),
+      computeHeuristicSignature({t1}, PrimDataType::Int32));
+}
+
+// Runtimes are looked up by heuristic signature first, but falling back to
+// runtimes with a different signature must still allow reuse.
+TEST_F(RuntimeTest, ReuseRuntimeAcrossSignatures) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  auto tv0 = makeSymbolicTensor(1);
+  fusion->addInput(tv0);
+  auto tv1 = add(tv0, tv0);
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  // 8 and 16 share a signature, 6 does not
+  for (int64_t size : {8, 16, 6}) {
+    at::Tensor t0 = at::randn({size}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  }
+  EXPECT_EQ(executor_cache.countRuntimes(), 1);
+}
+
+TEST_F(RuntimeTest, BucketExtent) {
+  // Small extents are kept
+  EXPECT_EQ(bucketExtent(1, 0), 1);
+  EXPECT_EQ(bucketExtent(64, 0), 64);
+  // Rounded to a power of two plus the power-of-two divisor below 64
+  EXPECT_EQ(bucketExtent(1000, 0), 1024 + 8);
+  EXPECT_EQ(bucketExtent(1016, 0), 1024 + 8);
+  EXPECT_EQ(bucketExtent(1023, 0), 1024 + 1);
+  EXPECT_EQ(bucketExtent(768, 0), 1024);
+  // Rounded to a multiple of the bucket width, then of 64
+  EXPECT_EQ(bucketExtent(1000, 64), 1024 + 8);
+  EXPECT_EQ(bucketExtent(1000, 100), 1024 + 8);
+  EXPECT_EQ(bucketExtent(1100, 64), 1152 + 4);
+}
+
+// Inputs whose extents have the same bucket representative share one runtime
+TEST_F(RuntimeTest, ShapeBuckets) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::ShapeBuckets, {"64"});
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  TensorView* tv1 = makeContigTensor(1);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  TensorView* tv2 = add(tv0, broadcast(tv1, {true, false}));
+  fusion->addOutput(tv2);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t1 = at::randn({256}, options);
+  for (int64_t size : {1000, 1016, 1016}) {
+    at::Tensor t0 = at::randn({size, 256}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0, t1});
+    testValidate(
+        executor_cache.fusion(), outputs, {t0, t1}, __LINE__, __FILE__);
+  }
+  EXPECT_EQ(executor_cache.countRuntimes(), 1);
+
+  const RuntimeCacheStats& stats = executor_cache.runtimeCacheStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.recompiles, 1);
+}
+
+// A new runtime of a concretization copies the compile-time heuristic data of
+// the segments it shares with the previous runtime
+TEST_F(RuntimeTest, ShareHeuristicDataAcrossRuntimes) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  std::vector<int64_t> num_shared_entries;
+  for (auto&& [outer, inner] :
+       std::vector<std::pair<int64_t, int64_t>>{{1024, 32}, {16, 65536}}) {
+    at::Tensor t0 = at::randn({outer, inner}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+    num_shared_entries.push_back(executor_cache.getMostRecentKernelRuntime()
+                                     ->fusionSegments()
+                                     ->numSharedHeuristicDataEntries());
+  }
+  ASSERT_EQ(executor_cache.countRuntimes(), 2);
+  EXPECT_EQ(num_shared_entries.at(0), 0);
+  EXPECT_GT(num_shared_entries.at(1), 0);
+}
+
+// A new runtime for inputs of the same shape class as an earlier runtime of
+// the concretization reuses its segmentation
+TEST_F(RuntimeTest, ReuseSegmentationAcrossShapes) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  TensorView* tv2 = segment_set(tv1);
+  TensorView* tv3 = add(tv2, IrBuilder::create<Val>(1.0));
+  fusion->addOutput(tv3);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  // 33 and 40 round up to the same power of two but allow different
+  // vectorization factors, so they need different heuristics
+  for (int64_t inner : {33, 40}) {
+    at::Tensor t0 = at::randn({128, inner}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+    EXPECT_TRUE(executor_cache.getMostRecentKernelRuntime()->isSegmented());
+  }
+  EXPECT_EQ(executor_cache.countRuntimes(), 2);
+
+  const RuntimeCacheStats& stats = executor_cache.runtimeCacheStats();
+  EXPECT_EQ(stats.recompiles, 2);
+  EXPECT_EQ(stats.segmentation_reuses, 1);
+}
+
+// A fusion run on two devices of the same kind is segmented and compiled once
+TEST_F(RuntimeTest, ShareSegmentationAcrossDevices) {
+  if (at::cuda::getNumGPUs() < 2) {
+    GTEST_SKIP() << "Requires at least 2 GPUs";
+  }
+  const cudaDeviceProp* prop0 = at::cuda::getDeviceProperties(0);
+  const cudaDeviceProp* prop1 = at::cuda::getDeviceProperties(1);
+  if (std::string_view(prop0->name) != prop1->name ||
+      prop0->multiProcessorCount != prop1->multiProcessorCount) {
+    GTEST_SKIP() << "Requires the first 2 GPUs to be of the same kind";
+  }
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  TensorView* tv2 = segment_set(tv1);
+  TensorView* tv3 = add(tv2, IrBuilder::create<Val>(1.0));
+  fusion->addOutput(tv3);
+
+  KernelBinaryCache& binary_cache = KernelBinaryCache::get();
+  binary_cache.clear();
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  for (int8_t device : {0, 1}) {
+    auto options =
+        at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, device);
+    at::Tensor t0 = at::randn({128, 256}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+    EXPECT_TRUE(executor_cache.getMostRecentKernelRuntime()->isSegmented());
+    EXPECT_EQ(executor_cache.countRuntimes(device), 1);
+  }
+
+  const RuntimeCacheStats& stats = executor_cache.runtimeCacheStats();
+  EXPECT_EQ(stats.segmentation_reuses, 1);
+  EXPECT_EQ(binary_cache.size(), 2);
+  EXPECT_EQ(binary_cache.hits(), 2);
+}
+
+// New extents of a tensor that is not reshaped reuse the concretization info
+// computed for the first inputs, while new reshape sizes compute a new one
+TEST_F(RuntimeTest, ReuseConcretizationInfo) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  TensorView* tv1 = makeContigTensor(1);
+  Val* s0 = IrBuilder::create<Val>(DataType::Int);
+  Val* s1 = IrBuilder::create<Val>(DataType::Int);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addInput(s0);
+  fusion->addInput(s1);
+  fusion->addOutput(reshape(tv0, {s0, s1}));
+  fusion->addOutput(add(tv1, IrBuilder::create<Val>(1.0)));
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({4, 6}, options);
+  for (int64_t size : {128, 256, 512}) {
+    at::Tensor t1 = at::randn({size}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0, t1, 6, 4});
+    testValidate(
+        executor_cache.fusion(), outputs, {t0, t1, 6, 4}, __LINE__, __FILE__);
+  }
+  EXPECT_EQ(executor_cache.runtimeCacheStats().conc_info_reuses, 2);
+
+  at::Tensor t1 = at::randn({128}, options);
+  auto outputs = executor_cache.runFusionWithInputs({t0, t1, 3, 8});
+  testValidate(
+      executor_cache.fusion(), outputs, {t0, t1, 3, 8}, __LINE__, __FILE__);
+  EXPECT_EQ(executor_cache.runtimeCacheStats().conc_info_reuses, 2);
+}
+
+// Run the same segmented fusion from multiple threads, each on its own stream
+TEST_F(RuntimeTest, ConcurrentRunsFromMultipleThreads) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  auto tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  auto tv1 = sum(tv0, {1});
+  auto tv2 = segment_set(tv1);
+  auto tv3 = add(tv2, IrBuilder::create<Val>(1.0));
+  fusion->addOutput(tv3);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+
+  // Compile once so that threads exercise the cached launch path
+  executor_cache.runFusionWithInputs({t0});
+
+  constexpr int num_threads = 4;
+  constexpr int num_iterations = 10;
+  std::vector<at::Tensor> inputs;
+  std::vector<std::vector<at::Tensor>> outputs(num_threads);
+  for (auto i : arange(num_threads)) {
+    (void)i;
+    inputs.push_back(at::randn({128, 256}, options));
+  }
+
+  std::vector<std::thread> threads;
+  for (auto i : arange(num_threads)) {
+    threads.emplace_back([&, i]() {
+      c10::cuda::CUDAStreamGuard stream_guard(
+          c10::cuda::getStreamFromPool(/*isHighPriority=*/false, 0));
+      for (auto j : arange(num_iterations)) {
+        (void)j;
+        auto out = executor_cache.runFusionWithInputs({inputs.at(i)});
+        outputs.at(i).push_back(out[0].as<at::Tensor>());
+      }
+      c10::cuda::getCurrentCUDAStream().synchronize();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(executor_cache.countRuntimes(), 1);
+  for (auto i : arange(num_threads)) {
+    for (const auto& out : outputs.at(i)) {
+      testValidate(
+          executor_cache.fusion(), {out}, {inputs.at(i)}, __LINE__, __FILE__);
+    }
+  }
+}
+
+// Launch a kernel from multiple threads while they recompile it for larger
+// blocks, which must keep the kernels of pending launches loaded
+TEST_F(RuntimeTest, ConcurrentRunsWithRecompile) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+  TensorView* tv0 = makeSymbolicTensor(1);
+  fusion.addInput(tv0);
+  TensorView* tv1 = add(tv0, IrBuilder::create<Val>(1.0));
+  fusion.addOutput(tv1);
+  tv1->axis(0)->parallelize(ParallelType::TIDx);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  KernelExecutor ke;
+  ke.compile(&fusion, {at::randn({32}, options)});
+
+  constexpr int64_t num_threads = 4;
+  constexpr int64_t num_iterations = 8;
+  std::vector<std::vector<std::pair<at::Tensor, at::Tensor>>> runs(
+      num_threads);
+  std::vector<std::thread> threads;
+  for (auto i : arange(num_threads)) {
+    threads.emplace_back([&, i]() {
+      c10::cuda::CUDAStreamGuard stream_guard(
+          c10::cuda::getStreamFromPool(/*isHighPriority=*/false, 0));
+      for (auto j : arange(num_iterations)) {
+        // Each round of runs needs larger blocks than the one before
+        const int64_t size = 32 * (1 + j * num_threads + i);
+        at::Tensor t0 = at::randn({size}, options);
+        auto outputs = ke.run({t0});
+        runs.at(i).emplace_back(t0, outputs[0].as<at::Tensor>());
+      }
+      c10::cuda::getCurrentCUDAStream().synchronize();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(
+      ke.compiledKernel()->blockSizeHighWaterMark(),
+      32 * num_threads * num_iterations);
+  for (const auto& thread_runs : runs) {
+    for (const auto& [t0, out] : thread_runs) {
+      testValidate(&fusion, {out}, {t0}, __LINE__, __FILE__);
+    }
+  }
+}
+
+TEST_F(RuntimeTest, CudaGraphReplay) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::CudaGraph);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  TensorView* tv2 = segment_set(tv1);
+  TensorView* tv3 = add(tv2, tv2);
+  fusion->addOutput(tv3);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+
+  // The first run warms up, the second one captures, and the rest replay.
+  std::vector<std::pair<at::Tensor, KernelArgumentHolder>> runs;
+  for (auto i : arange(4)) {
+    (void)i;
+    at::Tensor t0 = at::randn({128, 256}, options);
+    runs.emplace_back(t0, executor_cache.runFusionWithInputs({t0}));
+  }
+  EXPECT_EQ(executor_cache.countRuntimes(), 1);
+
+  // Later replays must not overwrite the outputs returned earlier
+  EXPECT_NE(
+      runs[2].second[0].as<at::Tensor>().data_ptr(),
+      runs[3].second[0].as<at::Tensor>().data_ptr());
+  for (const auto& [t0, outputs] : runs) {
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  }
+}
+
+// Threads replaying the same graph on their own streams take turns with the
+// static buffers
+TEST_F(RuntimeTest, CudaGraphReplayOnMultipleStreams) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::CudaGraph);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  TensorView* tv2 = segment_set(tv1);
+  TensorView* tv3 = add(tv2, tv2);
+  fusion->addOutput(tv3);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+
+  // Warm up and capture
+  for (auto i : arange(2)) {
+    (void)i;
+    executor_cache.runFusionWithInputs({at::randn({128, 256}, options)});
+  }
+
+  constexpr int64_t num_threads = 4;
+  constexpr int64_t num_iterations = 8;
+  std::vector<std::vector<std::pair<at::Tensor, KernelArgumentHolder>>> runs(
+      num_threads);
+  std::vector<std::thread> threads;
+  for (auto i : arange(num_threads)) {
+    threads.emplace_back([&, i]() {
+      c10::cuda::CUDAStreamGuard stream_guard(
+          c10::cuda::getStreamFromPool(/*isHighPriority=*/false, 0));
+      for (auto j : arange(num_iterations)) {
+        (void)j;
+        at::Tensor t0 = at::randn({128, 256}, options);
+        runs.at(i).emplace_back(t0, executor_cache.runFusionWithInputs({t0}));
+      }
+      c10::cuda::getCurrentCUDAStream().synchronize();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(executor_cache.countRuntimes(), 1);
+  for (const auto& thread_runs : runs) {
+    for (const auto& [t0, outputs] : thread_runs) {
+      testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+    }
+  }
+}
+
+// Grid reductions synchronize through zeroed semaphores. The captured graph
+// must not point into the zeroed memory arena of the capture stream, which is
+// freed here between replays.
+TEST_F(RuntimeTest, CudaGraphReplayWithZeroedMemory) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::CudaGraph);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {0});
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+
+  for (auto i : arange(4)) {
+    (void)i;
+    at::Tensor t0 = at::randn({16384, 256}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+    releaseZeroedMemory();
+  }
+}
+
+TEST_F(RuntimeTest, AsyncCompile) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::AsyncCompile);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(sin(tv0), {1});
+  TensorView* tv2 = segment_set(tv1);
+  TensorView* tv3 = mul(tv2, tv2);
+  fusion->addOutput(tv3);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+
+  // The first run doesn't wait for the kernels to be compiled
+  at::Tensor t0 = at::randn({128, 256}, options);
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_TRUE(runtime->canRunWithFallback());
+  while (runtime->isCompiling()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(runtime->isCompiled());
+
+  // Subsequent runs launch the compiled kernels
+  t0 = at::randn({128, 256}, options);
+  outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(executor_cache.countRuntimes(), 1);
+}
+
+TEST_F(RuntimeTest, TieredCompile) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::TieredCompile, {"3"});
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(sin(tv0), {1});
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+
+  // The first two runs with the same inputs don't compile any kernel
+  for ([[maybe_unused]] auto i : arange(2)) {
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+    FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+    EXPECT_FALSE(runtime->isCompiling());
+    EXPECT_FALSE(runtime->isCompiled());
+  }
+
+  // The third run starts compiling in the background
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  while (runtime->isCompiling()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(runtime->isCompiled());
+
+  outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(executor_cache.countRuntimes(), 1);
+}
+
+TEST_F(RuntimeTest, DeterministicSkipsFallback) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::TieredCompile);
+  EnableOptionsGuard::getCurOptions().set(EnableOption::Deterministic);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(sin(tv0), {0});
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({4096, 256}, options);
+
+  // The first run already launches the compiled kernels, so all runs reduce
+  // in the same order
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_FALSE(runtime->isCompiling());
+  EXPECT_TRUE(runtime->isCompiled());
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  auto outputs2 = executor_cache.runFusionWithInputs({t0});
+  EXPECT_TRUE(
+      at::equal(outputs[0].as<at::Tensor>(), outputs2[0].as<at::Tensor>()));
+}
+
+TEST_F(RuntimeTest, KernelBinaryCacheAcrossFusions) {
+  auto make_fusion = []() {
+    auto fusion = std::make_unique<Fusion>();
+    FusionGuard fg(fusion.get());
+    TensorView* tv0 = makeContigTensor(2);
+    fusion->addInput(tv0);
+    TensorView* tv1 = add(tv0, tv0);
+    fusion->addOutput(tv1);
+    return fusion;
+  };
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+
+  KernelBinaryCache& binary_cache = KernelBinaryCache::get();
+  binary_cache.clear();
+
+  // The kernels of the two caches have different names because their fusion
+  // IDs differ, but the second one reuses the binary of the first one.
+  FusionExecutorCache executor_cache0(make_fusion(), /*fusion_id=*/0);
+  auto outputs = executor_cache0.runFusionWithInputs({t0});
+  testValidate(executor_cache0.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(binary_cache.size(), 1);
+  EXPECT_EQ(binary_cache.hits(), 0);
+
+  FusionExecutorCache executor_cache1(make_fusion(), /*fusion_id=*/1);
+  outputs = executor_cache1.runFusionWithInputs({t0});
+  testValidate(executor_cache1.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(binary_cache.size(), 1);
+  EXPECT_EQ(binary_cache.hits(), 1);
+
+  // Identical cubins are loaded into one module
+  auto get_executable = [](FusionExecutorCache& executor_cache) {
+    const auto& executors =
+        executor_cache.getMostRecentKernelRuntime()->executors();
+    EXPECT_EQ(executors.size(), 1);
+    auto* ke = dynamic_cast<KernelExecutor*>(executors.at(0).get());
+    EXPECT_NE(ke, nullptr);
+    return ke->compiledKernel()->cudaExecutable().get();
+  };
+  executor_utils::CudaExecutable* executable0 = get_executable(executor_cache0);
+  executor_utils::CudaExecutable* executable1 = get_executable(executor_cache1);
+  if (!executable0->cubin.empty()) {
+    EXPECT_NE(executable0->shared_module, nullptr);
+    EXPECT_EQ(executable0->shared_module, executable1->shared_module);
+    EXPECT_EQ(executable0->function, executable1->function);
+  }
+}
+
+// The least recently used binaries are evicted beyond the byte bound
+TEST_F(RuntimeTest, KernelBinaryCacheEviction) {
+  auto make_fusion = [](bool use_add) {
+    auto fusion = std::make_unique<Fusion>();
+    FusionGuard fg(fusion.get());
+    TensorView* tv0 = makeContigTensor(2);
+    fusion->addInput(tv0);
+    TensorView* tv1 = use_add ? add(tv0, tv0) : mul(tv0, tv0);
+    fusion->addOutput(tv1);
+    return fusion;
+  };
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+
+  KernelBinaryCache& binary_cache = KernelBinaryCache::get();
+  binary_cache.clear();
+  const int64_t max_bytes = binary_cache.maxBytes();
+
+  FusionExecutorCache executor_cache0(make_fusion(true), /*fusion_id=*/0);
+  executor_cache0.runFusionWithInputs({t0});
+  EXPECT_EQ(binary_cache.size(), 1);
+
+  // Only room for one binary of about the same size
+  binary_cache.setMaxBytes(binary_cache.numBytes() * 3 / 2);
+  FusionExecutorCache executor_cache1(make_fusion(false), /*fusion_id=*/1);
+  auto outputs = executor_cache1.runFusionWithInputs({t0});
+  testValidate(executor_cache1.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(binary_cache.size(), 1);
+  EXPECT_LE(binary_cache.numBytes(), binary_cache.maxBytes());
+
+  // The binary of the first fusion was evicted, so it's compiled again
+  FusionExecutorCache executor_cache2(make_fusion(true), /*fusion_id=*/2);
+  outputs = executor_cache2.runFusionWithInputs({t0});
+  testValidate(executor_cache2.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  EXPECT_EQ(binary_cache.hits(), 0);
+
+  binary_cache.setMaxBytes(max_bytes);
+  binary_cache.clear();
+}
+
+// Kernels sharing a module share the dynamic shared memory attribute of its
+// function, which one needing less must not lower for another
+TEST_F(RuntimeTest, SharedModuleDynamicSmem) {
+  auto make_fusion = []() {
+    auto fusion = std::make_unique<Fusion>();
+    FusionGuard fg(fusion.get());
+    TensorView* tv0 = makeContigTensor(2);
+    fusion->addInput(tv0);
+    TensorView* tv1 = add(tv0, tv0);
+    fusion->addOutput(tv1);
+    return fusion;
+  };
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+  KernelBinaryCache::get().clear();
+
+  FusionExecutorCache executor_cache0(make_fusion(), /*fusion_id=*/0);
+  executor_cache0.runFusionWithInputs({t0});
+  FusionExecutorCache executor_cache1(make_fusion(), /*fusion_id=*/1);
+  executor_cache1.runFusionWithInputs({t0});
+
+  auto get_compiled_kernel = [](FusionExecutorCache& executor_cache) {
+    const auto& executors =
+        executor_cache.getMostRecentKernelRuntime()->executors();
+    return executors.at(0)->as<KernelExecutor>()->compiledKernel().get();
+  };
+  CompiledKernel* compiled_kernel0 = get_compiled_kernel(executor_cache0);
+  CompiledKernel* compiled_kernel1 = get_compiled_kernel(executor_cache1);
+  if (compiled_kernel0->cudaExecutable()->shared_module == nullptr) {
+    GTEST_SKIP() << "Requires the kernels to share a module";
+  }
+  ASSERT_EQ(
+      compiled_kernel0->cudaExecutable()->function,
+      compiled_kernel1->cudaExecutable()->function);
+
+  const int64_t large_smem = 64 << 10;
+  const int64_t small_smem = 56 << 10;
+  if (at::cuda::getCurrentDeviceProperties()->sharedMemPerBlockOptin <
+      (size_t)large_smem + compiled_kernel0->staticSmemSize()) {
+    GTEST_SKIP() << "Requires at least 64 KB of dynamic shared memory";
+  }
+
+  // The second kernel caches the attribute before the first one raises it
+  const int64_t initial_smem = compiled_kernel1->availableDynamicSmemSize();
+  ASSERT_LT(initial_smem, small_smem);
+  EXPECT_GE(
+      compiled_kernel0->ensureAvailableDynamicSmemSize(large_smem),
+      large_smem);
+  EXPECT_GE(
+      compiled_kernel1->ensureAvailableDynamicSmemSize(small_smem),
+      large_smem);
+
+  int attribute = 0;
+  NVFUSER_CUDA_SAFE_CALL(cuFuncGetAttribute(
+      &attribute,
+      CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES,
+      compiled_kernel0->cudaExecutable()->function));
+  EXPECT_EQ(attribute, large_smem);
+}
+
+// With compile_for_archs, a kernel also carries a cubin for each listed
+// architecture other than the current one
+TEST_F(RuntimeTest, CompileForArchs) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::CompileForArchs, {"80", "90"});
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = mul(tv0, IrBuilder::create<Val>(2.0));
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  const auto& executors =
+      executor_cache.getMostRecentKernelRuntime()->executors();
+  ASSERT_EQ(executors.size(), 1);
+  auto* ke = dynamic_cast<KernelExecutor*>(executors.at(0).get());
+  ASSERT_NE(ke, nullptr);
+  executor_utils::CudaExecutable* executable =
+      ke->compiledKernel()->cudaExecutable().get();
+  if (executable->cubin.empty()) {
+    GTEST_SKIP() << "Kernel is not compiled to SASS";
+  }
+
+  const cudaDeviceProp* prop = at::cuda::getCurrentDeviceProperties();
+  const int64_t arch = prop->major * 10 + prop->minor;
+  std::vector<int64_t> image_archs;
+  for (const executor_utils::CudaKernelImage& image : executable->images) {
+    EXPECT_FALSE(image.cubin.empty());
+    EXPECT_NE(image.compile_args, executable->compile_args);
+    image_archs.push_back(image.arch);
+  }
+  std::vector<int64_t> expected_archs;
+  for (int64_t listed : {80, 90}) {
+    if (listed != arch) {
+      expected_archs.push_back(listed);
+    }
+  }
+  EXPECT_EQ(image_archs, expected_archs);
+}
+
+TEST_F(RuntimeTest, Megakernel) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::Megakernel);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigConcreteTensor({1024});
+  fusion->addInput(tv0);
+  TensorView* tv1 = sin(tv0);
+  // Two pointwise kernels with the same small grid
+  tv1 = segment_set(tv1);
+  TensorView* tv2 = cos(tv1);
+  fusion->addOutput(tv2);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({1024}, options);
+  // The second run reuses the megakernel compiled by the first
+  for ([[maybe_unused]] auto i : arange(2)) {
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  }
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_EQ(runtime->fusionSegments()->groups().size(), 2);
+  EXPECT_EQ(runtime->megakernels().numLaunches(), 2);
+}
+
+TEST_F(RuntimeTest, ProgrammaticDependentLaunch) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(
+      EnableOption::ProgrammaticDependentLaunch);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  tv1 = segment_set(tv1);
+  TensorView* tv2 = mul(tv1, tv1);
+  fusion->addOutput(tv2);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({1024, 1024}, options);
+  // The second segment reads the output of the first one, which it may start
+  // before on sm_90+
+  for ([[maybe_unused]] auto i : arange(3)) {
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  }
+
+  for (const auto& executor :
+       executor_cache.getMostRecentKernelRuntime()->executors()) {
+    auto* ke = dynamic_cast<KernelExecutor*>(executor.get());
+    ASSERT_NE(ke, nullptr);
+    EXPECT_TRUE(ke->compiledKernel()
+                    ->kernel()
+                    ->summary()
+                    .uses_programmatic_dependent_launch);
+    EXPECT_THAT(
+        ke->compiledKernel()->kernelString(),
+        testing::HasSubstr("grid_sync::waitForPrerequisiteGrids();"));
+  }
+}
+
+TEST_F(RuntimeTest, LaunchParamsFormula) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+  TensorView* tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+  TensorView* tv1 = mul(tv0, IrBuilder::create<Val>(2.0));
+  fusion.addOutput(tv1);
+  tv1->split(1, 128);
+  tv1->axis(0)->parallelize(ParallelType::BIDy);
+  tv1->axis(1)->parallelize(ParallelType::BIDx);
+  tv1->axis(2)->parallelize(ParallelType::TIDx);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({3, 1000}, options);
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+
+  executor_utils::caching::LaunchParamsFormula formula(
+      ke.compiledKernel()->kernel(), {});
+  ASSERT_TRUE(formula.available());
+  for (const std::vector<int64_t>& sizes :
+       std::vector<std::vector<int64_t>>{{3, 1000}, {5, 300}, {1, 129}}) {
+    at::Tensor t = at::randn(sizes, options);
+    auto outputs = ke.run({t});
+    testValidate(&fusion, outputs, {t}, __LINE__, __FILE__);
+
+    LaunchParams launch_params;
+    ASSERT_TRUE(formula.evaluate({t}, LaunchParams(), launch_params));
+    EXPECT_EQ(launch_params.gdimx(), ke.lastLaunchParams().gdimx());
+    EXPECT_EQ(launch_params.gdimy(), ke.lastLaunchParams().gdimy());
+    EXPECT_EQ(launch_params.bdimx(), ke.lastLaunchParams().bdimx());
+  }
+}
+
+TEST_F(RuntimeTest, IntermediateBufferPool) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::IntermediateBufferPool);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  // A large outer reduction is scheduled as a grid reduction, which needs a
+  // work buffer and a semaphore buffer.
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {0});
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+
+  // Later runs reuse the buffers retained by the first run. The semaphores
+  // must have been reset to zero by the previous kernel.
+  for (auto i : arange(3)) {
+    (void)i;
+    at::Tensor t0 = at::randn({16384, 128}, options);
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  }
+}
+
+TEST_F(RuntimeTest, ZeroedMemoryArenaPerStream) {
+  releaseZeroedMemory();
+  const c10::Device device(c10::DeviceType::CUDA, 0);
+
+  at::Tensor t0 = contigZeroedTensor({32}, at::kInt, device);
+  resetZeroedMemory(device);
+  // The arena stays allocated across resets, so the same memory is handed out
+  // again without zeroing it.
+  at::Tensor t1 = contigZeroedTensor({32}, at::kInt, device);
+  EXPECT_EQ(t0.data_ptr(), t1.data_ptr());
+  resetZeroedMemory(device);
+
+  // Memory that kernels don't reset to zero is cleared by the arena
+  t1 = contigZeroedTensor({32}, at::kInt, device, /*resets_to_zero=*/false);
+  t1.fill_(1);
+  resetZeroedMemory(device);
+  at::Tensor t2 = contigZeroedTensor({32}, at::kInt, device);
+  EXPECT_EQ(t2.data_ptr(), t1.data_ptr());
+  EXPECT_EQ(at::count_nonzero(t2).item<int64_t>(), 0);
+  resetZeroedMemory(device);
+
+  // Each stream has its own arena
+  {
+    c10::cuda::CUDAStreamGuard stream_guard(
+        c10::cuda::getStreamFromPool(/*isHighPriority=*/false, 0));
+    at::Tensor t3 = contigZeroedTensor({32}, at::kInt, device);
+    EXPECT_NE(t3.data_ptr(), t0.data_ptr());
+    resetZeroedMemory(device);
+  }
+  releaseZeroedMemory();
+}
+
+TEST_F(RuntimeTest, KernelArgumentHolderBeyondInlineCapacity) {
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  KernelArgumentHolder args;
+  std::vector<at::Tensor> tensors;
+  const int64_t num_args = KernelArgumentHolder::inline_capacity + 4;
+  for (auto i : arange(num_args)) {
+    tensors.push_back(at::randn({i + 1}, options));
+    args.push(tensors.back());
+  }
+  ASSERT_EQ(args.size(), num_args);
+
+  KernelArgumentHolder copied = args;
+  KernelArgumentHolder moved = std::move(copied);
+  ASSERT_EQ(moved.size(), num_args);
+  for (auto i : arange(num_args)) {
+    EXPECT_EQ(moved[i].as<at::Tensor>().data_ptr(), tensors.at(i).data_ptr());
+  }
+
+  moved.erase(moved[0]);
+  EXPECT_EQ(moved.size(), num_args - 1);
+  EXPECT_EQ(moved[0].as<at::Tensor>().data_ptr(), tensors.at(1).data_ptr());
+}
+
+TEST_F(RuntimeTest, KernelRemarks) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::KernelRemarks);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sin(tv0);
+  fusion->addOutput(tv1);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  const std::string remarks = executor_cache.getMostRecentRemarks();
+  EXPECT_NE(remarks.find("\"scheduler\": \"pointwise\""), std::string::npos)
+      << remarks;
+  EXPECT_NE(remarks.find("\"pass\": \"vectorization\""), std::string::npos)
+      << remarks;
+  EXPECT_NE(remarks.find("\"pass\": \"registers\""), std::string::npos)
+      << remarks;
+}
+
+namespace {
+
+std::unique_ptr<HeuristicParams> serdeRoundTrip(
+    const HeuristicParams* params,
+    Fusion* segment_fusion) {
+  flatbuffers::FlatBufferBuilder builder;
+  builder.Finish(serde::serializeHeuristicParams(builder, params));
+  return serde::deserializeHeuristicParams(
+      flatbuffers::GetRoot<serde::HeuristicParams>(builder.GetBufferPointer()),
+      segment_fusion);
+}
+
+} // namespace
+
+TEST_F(RuntimeTest, HeuristicParamsSerde) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = sum(tv0, {1});
+  TensorView* tv2 = segment_set(tv1);
+  TensorView* tv3 = sin(tv2);
+  fusion->addOutput(tv3);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 1024}, options);
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  ASSERT_EQ(runtime->fusionSegments()->groups().size(), 2);
+  for (SegmentedGroup* group : runtime->fusionSegments()->groups()) {
+    const HeuristicParams* params =
+        runtime->schedulers().at(group->groupId()).get();
+    std::unique_ptr<HeuristicParams> restored =
+        serdeRoundTrip(params, group->getFusion());
+    EXPECT_EQ(restored->scheduler_type, params->scheduler_type);
+    EXPECT_TRUE(restored->sameAs(params)) << restored->toString();
+    EXPECT_EQ(restored->lparams, params->lparams);
+  }
+
+  TransposeParams tparams;
+  tparams.cparams.index_type = PrimDataType::Int32;
+  tparams.split_before_tiling = {{0, 4}, {2, 8}};
+  tparams.dims_merged_with_1 = {1};
+  tparams.dims_merged_with_2 = {3};
+  tparams.vectorize_factor1 = 4;
+  tparams.tile_size2 = 64;
+  EXPECT_TRUE(serdeRoundTrip(&tparams, nullptr)->sameAs(&tparams));
+
+  MatmulParams mparams;
+  mparams.cparams.index_type = PrimDataType::Int;
+  mparams.supported_vec_size = {8, 8, 4};
+  mparams.tile_sizes = {GemmTile(256, 128, 64), GemmTile(64, 128, 64)};
+  mparams.circular_buffer_options.circular_buffer_smem_write = true;
+  mparams.circular_buffer_options.smem_circular_buffer_stage = 4;
+  mparams.grid_traversal_factor = {2, 1};
+  mparams.splitk_factor = 2;
+  mparams.cluster_dims = {2, 1, 1};
+  EXPECT_TRUE(serdeRoundTrip(&mparams, nullptr)->sameAs(&mparams));
+}
+
+TEST_F(RuntimeTest, MultiStream) {
+  // A diamond puts the second branch on a side stream and joins the
+  // consumer to the first, while a chain stays on one stream
+  EXPECT_THAT(
+      assignGroupStreams({{}, {}, {0, 1}}, 2), testing::ElementsAre(0, 1, 0));
+  EXPECT_THAT(
+      assignGroupStreams({{}, {0}, {1}}, 2), testing::ElementsAre(0, 0, 0));
+  EXPECT_THAT(
+      assignGroupStreams({{}, {}, {}}, 2), testing::ElementsAre(0, 1, 0));
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::MultiStream, {"2"});
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = segment_set(sum(tv0, {0}));
+  TensorView* tv2 = segment_set(sum(tv0, {1}));
+  TensorView* tv3 =
+      add(broadcast(tv1, {true, false}), broadcast(tv2, {false, true}));
+  fusion->addOutput(tv3);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({1024, 2048}, options);
+  for ([[maybe_unused]] auto i : arange(3)) {
+    auto outputs = executor_cache.runFusionWithInputs({t0});
+    testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+  }
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_GE(runtime->fusionSegments()->groups().size(), 3);
+}
+
+TEST_F(RuntimeTest, CompileThreadPoolStats) {
+  CompileThreadPool* pool = getThreadPool();
+  const CompileThreadPoolStats before = pool->stats();
+  EXPECT_GE(before.num_threads, 1);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  TensorView* tv0 = makeContigTensor(2);
+  fusion->addInput(tv0);
+  TensorView* tv1 = segment_set(sum(tv0, {1}));
+  TensorView* tv2 = sin(tv1);
+  fusion->addOutput(tv2);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({128, 256}, options);
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+
+  // The segments are compiled by the pool, which is idle once they are
+  const CompileThreadPoolStats after = pool->stats();
+  EXPECT_GE(after.completed, before.completed + 2);
+  EXPECT_EQ(after.queued, 0);
+  EXPECT_EQ(after.running, 0);
+  EXPECT_GE(after.max_queued, 1);
+
+  // The pool can't be reconfigured once it's in use
+  EXPECT_ANY_THROW(setCompileThreadPoolOptions({.num_threads = 1}));
+}
+
 } // namespace nvfuser
@@ -7,7 +7,10 @@
 // clang-format on
 #include <gtest/gtest.h>
 
+#include <device_lower/lower2device.h>
+#include <device_lower/utils.h>
 #include <fusion.h>
+#include <kernel_ir.h>
 #include <ops/all_ops.h>
 #include <runtime/executor.h>
 #include <scheduler/tools/inlining.h>
@@ -296,7 +299,7 @@ TEST_F(ScalarHoistTest, IndexHoist3) {
 
   const std::string expected_kernel = R"(
 // Codegen generated code
-__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 2> T2) {
+__global__ void CUDAGeneratedKernel(Tensor<float, 2, 2> T0, Tensor<float, 2, 0> T2) {
   nvfuser_index_t i0;
   i0 = ((nvfuser_index_t)threadIdx.x) + (256LL * ((nvfuser_index_t)blockIdx.x));
   Tensor<float, 2, 2> s1;
@@ -376,7 +379,7 @@ TEST_F(ScalarHoistTest, ARange) {
 
   const std::string expected_kernel = R"(
 // Codegen generated code
-__global__ void CUDAGeneratedKernel(int64_t i0, int64_t i1, int64_t i2, Tensor<int64_t, 1, 1> T0, Tensor<int64_t, 1, 1> T1) {
+__global__ void CUDAGeneratedKernel(int64_t i0, int64_t i1, int64_t i2, Tensor<int64_t, 1, 0> T0, Tensor<int64_t, 1, 0> T1) {
   int64_t i3;
   i3 = i1 - i0;
   int64_t i4;
@@ -406,4 +409,56 @@ __global__ void CUDAGeneratedKernel(int64_t i0, int64_t i1, int64_t i2, Tensor<i
       fusion.get(), cg_outputs, {start, end, step}, __LINE__, __FILE__);
 }
 
+TEST_F(ScalarHoistTest, StrengthReduceIndices) {
+  if (isOptionDisabled(DisableOption::IndexHoist)) {
+    GTEST_SKIP() << "Index hoisting disabled";
+  }
+
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  auto tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = set(tv0);
+  auto tv2 = add(tv1, IrBuilder::create<Val>(1.0));
+  fusion.addOutput(tv2);
+
+  // Both loops are serial, so the indices hoisted to the outer loop are
+  // linear in its index
+  tv2->split(-1, 4);
+  TransformPropagatorWithCheck propagator(tv2);
+  MaxLogicalDomainInfoSpanningTree(tv2).traverse(&propagator);
+  inlineMost();
+
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::StrengthReduceIndices);
+
+  GpuLower gpulw(&fusion);
+  kir::Kernel* kernel = gpulw.run();
+  auto exprs = ir_utils::flattenScopedExprs(kernel->topLevelExprs());
+  auto inc_it = std::find_if(exprs.begin(), exprs.end(), [](Expr* expr) {
+    return expr->isA<kir::IncrementScalar>();
+  });
+  ASSERT_NE(inc_it, exprs.end()) << kernel->toString();
+  // The incremented scalar is initialized before the outer loop
+  Val* value = (*inc_it)->as<kir::IncrementScalar>()->value();
+  ASSERT_NE(value->definition(), nullptr);
+  EXPECT_TRUE(value->definition()->isA<LoadStoreOp>());
+  EXPECT_NE(
+      std::find(
+          kernel->topLevelExprs().begin(),
+          kernel->topLevelExprs().end(),
+          value->definition()),
+      kernel->topLevelExprs().end());
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor t0 = at::randn({13, 29}, options);
+
+  KernelExecutor ke;
+  ke.compile(&fusion, {t0});
+  auto cg_outputs = ke.run({t0});
+
+  testValidate(&fusion, cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
 } // namespace nvfuser
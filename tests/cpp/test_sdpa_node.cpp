@@ -1022,4 +1022,52 @@ TEST_F(SDPATest, ComputeAt) {
   validateSdpaFwdOutputs(nvf_out, aten_out);
 }
 
+// An attention decomposed into matmul, softmax and matmul is translated to a
+// single SdpaFwdOp instead of segmenting at each matmul
+TEST_F(SDPATest, TranslateDecomposedAttn) {
+  NVFUSER_TEST_CUDA_ARCH_GUARD(8, 0);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+  std::vector<int64_t> q_shape({n, h, l, e});
+  std::vector<int64_t> kv_shape({n, h, s, e});
+  const double scale = 1.0 / std::sqrt(e);
+
+  auto tvq = makeConcreteTensor(q_shape, DataType::Half);
+  auto tvk = makeConcreteTensor(kv_shape, DataType::Half);
+  auto tvv = makeConcreteTensor(kv_shape, DataType::Half);
+
+  fusion->addInput(tvq);
+  fusion->addInput(tvk);
+  fusion->addInput(tvv);
+
+  auto scores = matmul(tvq, transpose(tvk, -2, -1));
+  scores = mul(castOp(DataType::Float, scores), IrBuilder::create<Val>(scale));
+  auto probs = castOp(DataType::Half, softmax(scores, -1));
+  fusion->addOutput(matmul(probs, tvv));
+
+  auto options = at::TensorOptions().dtype(at::kHalf).device(at::kCUDA, 0);
+  at::Tensor q = at::randn(q_shape, options);
+  at::Tensor k = at::randn(kv_shape, options);
+  at::Tensor v = at::randn(kv_shape, options);
+
+  EnableOptionsGuard eog;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::TranslateSdpa);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto nvf_out = executor_cache.runFusionWithInputs({q, k, v});
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_FALSE(runtime->isSegmented());
+  EXPECT_EQ(
+      runtime->schedulerHeuristics()->heuristicsList().at(0)->scheduler_type,
+      SchedulerType::ExprEval);
+
+  at::Tensor ref_scores =
+      at::matmul(q.to(at::kFloat), k.to(at::kFloat).transpose(-2, -1)) * scale;
+  at::Tensor ref = at::softmax(ref_scores, -1).matmul(v.to(at::kFloat));
+  EXPECT_TRUE(at::allclose(
+      nvf_out[0].as<at::Tensor>().to(at::kFloat), ref, 1e-2, 1e-2));
+}
+
 } // namespace nvfuser
@@ -12,11 +12,16 @@
 #include <ops/all_ops.h>
 #include <preseg_passes/mark_aliases_prepare.h>
 #include <preseg_passes/optimization_pass.h>
+#include <runtime/fusion_cache_utils.h>
+#include <scheduler/cost_model.h>
+#include <scheduler/registry.h>
+#include <scheduler/runtime_info.h>
 #include <tests/cpp/utils.h>
 #include <tests/cpp/validator.h>
 
 namespace nvfuser {
 
+using testing::IsEmpty;
 using testing::SizeIs;
 
 using SegmentationTest = NVFuserTest;
@@ -609,6 +614,105 @@ TEST_F(SegmentationTest, EraseReductionsInSegmentationEdges) {
   }
 }
 
+// Test that the fusion of a segment only has the statements of the segment,
+// not a copy of the complete fusion
+TEST_F(SegmentationTest, MakeFusionCopiesOnlySegment) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeSymbolicTensor(2, DataType::Float);
+  fusion->addInput(tv0);
+
+  auto* tv1 = sin(tv0);
+  auto* tv2 = segment_set(tv1);
+  auto* tv3 = cos(tv2);
+  auto* tv4 = sum(tv3, {1});
+  fusion->addOutput(tv4);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto in0 = at::randn({8, 16}, options);
+  auto outputs = executor_cache.runFusionWithInputs({in0});
+
+  testValidate(executor_cache.fusion(), outputs, {in0}, __LINE__, __FILE__);
+
+  const FusionKernelRuntime* runtime =
+      executor_cache.getMostRecentKernelRuntime();
+  ASSERT_TRUE(runtime != nullptr);
+
+  SegmentedFusion* segmented_fusion = runtime->fusionSegments();
+  EXPECT_EQ(segmented_fusion->groups().size(), 2);
+
+  for (SegmentedGroup* group : segmented_fusion->groups()) {
+    std::unordered_set<Val*> group_tvs;
+    for (Expr* expr : group->exprs()) {
+      for (auto* tv : ir_utils::filterByType<TensorView>(expr->inputs())) {
+        group_tvs.insert(tv);
+      }
+      for (auto* tv : ir_utils::filterByType<TensorView>(expr->outputs())) {
+        group_tvs.insert(tv);
+      }
+    }
+
+    std::unique_ptr<Fusion> segment_fusion =
+        segmented_fusion->makeFusion(group).second;
+
+    // Inputs may be replaced by new TensorViews, but none of the other
+    // segment is copied.
+    EXPECT_LE(
+        ir_utils::filterByType<TensorView>(segment_fusion->vals()).size(),
+        group_tvs.size());
+    EXPECT_EQ(segment_fusion->unordered_exprs().size(), group->exprs().size());
+  }
+}
+
+// Test that the runtime facts of tensor arguments are shared through a
+// TensorArgInfoCache
+TEST_F(SegmentationTest, SharedTensorArgInfo) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  auto tv0 = makeSymbolicTensor(2, DataType::Float);
+  auto tv1 = makeSymbolicTensor(2, DataType::Float);
+  fusion->addInput(tv0);
+  fusion->addInput(tv1);
+  fusion->addOutput(add(tv0, tv1));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  // t1 is discontiguous and misaligned
+  auto t0 = at::randn({8, 16}, options);
+  auto t1 = at::randn({8, 17}, options).narrow(1, 1, 16);
+  KernelArgumentHolder args({t0, t1});
+
+  std::vector<Val*> keys = fusion->inputs();
+  TensorArgInfoCache arg_info_cache;
+  SchedulerRuntimeInfo runtime_info(
+      fusion.get(), args, nullptr, {}, std::nullopt, &arg_info_cache, keys);
+  ASSERT_EQ(arg_info_cache.size(), 2);
+  EXPECT_EQ(runtime_info.getAlignmentSize(tv0), 16);
+  EXPECT_EQ(runtime_info.getAlignmentSize(tv1), 4);
+
+  // Another fusion taking the same arguments, e.g., another segment, reuses
+  // the facts computed for them.
+  Fusion other_fusion(*fusion);
+  FusionGuard other_fg(&other_fusion);
+  arg_info_cache.at(tv1).alignment = 8;
+  SchedulerRuntimeInfo other_runtime_info(
+      &other_fusion,
+      args,
+      nullptr,
+      {},
+      std::nullopt,
+      &arg_info_cache,
+      keys);
+  EXPECT_EQ(arg_info_cache.size(), 2);
+  EXPECT_EQ(
+      other_runtime_info.getAlignmentSize(
+          other_fusion.inputs().at(1)->as<TensorView>()),
+      8);
+}
+
 TEST_F(SegmentationTest, AliasedOutputOnSegmentation) {
   auto fusion = std::make_unique<Fusion>();
   FusionGuard fg(fusion.get());
@@ -807,6 +911,175 @@ TEST_F(SegmentationTest, RevertPrivatizedUpcast) {
   }
 }
 
+// Like PrivatizeUpcast, but the cast is followed by another pointwise op, so
+// each reduction segment recomputes both from the pre-upcast tensor
+TEST_F(SegmentationTest, RecomputeCheapProducers) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::RecomputeProducers);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  auto tv0 = makeSymbolicTensor(2, DataType::BFloat16);
+  fusion.addInput(tv0);
+
+  auto tv1 = segment_set(tv0);
+  auto tv2 = castOp(DataType::Float, tv1);
+  auto tv3 = mul(tv2, IrBuilder::create<Val>(2.0));
+
+  auto tv4 = sum(tv3, {0});
+  fusion.addOutput(tv4);
+
+  auto tv5 = sum(tv3, {1});
+  fusion.addOutput(tv5);
+
+  auto options = at::TensorOptions().dtype(at::kBFloat16).device(at::kCUDA, 0);
+  auto t0 = at::randn({16, 32}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+  testValidate(&fusion, outputs, {t0}, __LINE__, __FILE__);
+
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_THAT(runtime->fusionSegments()->groups(), SizeIs(3));
+
+  for (const auto& executor : runtime->executors()) {
+    if (executor.get()->isA<ExprEvalExecutor>()) {
+      continue;
+    }
+    // Both reductions read tv1 rather than the output of the multiplication
+    auto ke = dynamic_cast<KernelExecutor*>(executor.get());
+    ASSERT_NE(ke, nullptr);
+    kir::Kernel* kernel = ke->compiledKernel()->kernel();
+    EXPECT_EQ(kernel->inputs().size(), 1);
+    EXPECT_EQ(kernel->inputs().at(0)->name(), 1);
+  }
+}
+
+TEST_F(SegmentationTest, RegenerateDropoutMask) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::RecomputeProducers);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  auto tv0 = makeSymbolicTensor(2);
+  fusion.addInput(tv0);
+  auto seed = IrBuilder::create<Val>(DataType::Int);
+  fusion.addInput(seed);
+  auto offset = IrBuilder::create<Val>(DataType::Int);
+  fusion.addInput(offset);
+
+  auto tv1 = rand_like(tv0, seed, offset);
+  auto tv2 = lt(tv1, IrBuilder::create<Val>(0.9));
+  auto tv3 = where(tv2, tv0, fusion.zeroVal(DataType::Float));
+
+  auto tv4 = sum(tv3, {0});
+  fusion.addOutput(tv4);
+  auto tv5 = sum(tv3, {1});
+  fusion.addOutput(tv5);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({128, 256}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0, 42L, 0L});
+
+  // Both segments regenerate the same mask instead of reading it
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  EXPECT_THAT(runtime->fusionSegments()->groups(), SizeIs(2));
+  for (const auto& executor : runtime->executors()) {
+    auto ke = dynamic_cast<KernelExecutor*>(executor.get());
+    ASSERT_NE(ke, nullptr);
+    for (Val* in : ke->compiledKernel()->kernel()->inputs()) {
+      EXPECT_NE(in->dtype(), DataType::Bool);
+    }
+  }
+  EXPECT_TRUE(at::allclose(
+      outputs[0].as<at::Tensor>().sum(),
+      outputs[1].as<at::Tensor>().sum(),
+      /*rtol=*/1e-4,
+      /*atol=*/1e-2));
+}
+
+TEST_F(SegmentationTest, InplaceSegmentOutputs) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::InplaceSegmentOutputs);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = relu(tv0);
+  auto tv2 = segment_set(tv1);
+  auto tv3 = mul(tv2, IrBuilder::create<Val>(2.0));
+  auto tv4 = segment_set(tv3);
+  auto tv5 = add(tv4, fusion.oneVal(DataType::Float));
+  fusion.addOutput(tv5);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({128, 256}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+
+  // The second and the third segments overwrite their input
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  RuntimeWorkSpace workspace;
+  prepareRuntimeOrder(runtime->fusionSegments(), workspace);
+  ASSERT_THAT(workspace.group_run_order, SizeIs(3));
+  auto inplace_outputs = findInplaceOutputs(
+      runtime->fusionSegments(), workspace.group_run_order);
+  EXPECT_THAT(inplace_outputs.at(0), IsEmpty());
+  EXPECT_THAT(inplace_outputs.at(1), SizeIs(1));
+  EXPECT_THAT(inplace_outputs.at(2), SizeIs(1));
+
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+}
+
+TEST_F(SegmentationTest, ZeroCopyCat) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::ZeroCopyCat);
+
+  auto fusion_ptr = std::make_unique<Fusion>();
+  auto& fusion = *fusion_ptr;
+  FusionGuard fg(fusion_ptr.get());
+
+  auto tv0 = makeContigTensor(2);
+  fusion.addInput(tv0);
+  auto tv1 = segment_set(relu(tv0));
+  auto tv2 = segment_set(exp(tv0));
+  auto tv3 = cat({tv1, tv0, tv2}, 0);
+  fusion.addOutput(tv3);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({128, 256}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion_ptr));
+  auto outputs = executor_cache.runFusionWithInputs({t0});
+
+  // The intermediates are written into the output of the CatOp, and the
+  // fusion input is copied into it.
+  FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+  RuntimeWorkSpace workspace;
+  prepareRuntimeOrder(runtime->fusionSegments(), workspace);
+  auto cat_output_slices = findCatOutputSlices(
+      runtime->fusionSegments(), workspace.group_run_order);
+  ASSERT_THAT(cat_output_slices, SizeIs(1));
+  const std::vector<std::pair<int64_t, int64_t>>& producers =
+      cat_output_slices.front().producers;
+  ASSERT_THAT(producers, SizeIs(3));
+  EXPECT_NE(producers.at(0).first, -1);
+  EXPECT_EQ(producers.at(1).first, -1);
+  EXPECT_NE(producers.at(2).first, -1);
+
+  testValidate(executor_cache.fusion(), outputs, {t0}, __LINE__, __FILE__);
+}
+
 TEST_F(SegmentationTest, ForwardFull) {
   auto fusion_ptr = std::make_unique<Fusion>();
   auto& fusion = *fusion_ptr;
@@ -862,4 +1135,119 @@ TEST_F(SegmentationTest, ForwardFull) {
   }
 }
 
+// Independent reductions of the same shape are launched as one kernel
+TEST_F(SegmentationTest, HorizontalFusion) {
+  auto make_fusion = []() {
+    auto fusion = std::make_unique<Fusion>();
+    FusionGuard fg(fusion.get());
+    std::vector<TensorView*> ins;
+    for (auto i : arange(3)) {
+      (void)i;
+      ins.push_back(makeContigTensor(2));
+      fusion->addInput(ins.back());
+    }
+    fusion->addOutput(sum(ins.at(0), {1}));
+    fusion->addOutput(sum(ins.at(1), {1}));
+    // Reduces another axis so that the fusion needs to be segmented
+    fusion->addOutput(sum(ins.at(2), {0}));
+    return fusion;
+  };
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  KernelArgumentHolder args;
+  for (auto i : arange(3)) {
+    (void)i;
+    args.push(at::randn({128, 256}, options));
+  }
+
+  for (bool horizontal_fusion : {false, true}) {
+    EnableOptionsGuard enable_options_guard;
+    if (horizontal_fusion) {
+      EnableOptionsGuard::getCurOptions().set(EnableOption::HorizontalFusion);
+    }
+    FusionExecutorCache executor_cache(make_fusion());
+    auto outputs = executor_cache.runFusionWithInputs(args);
+    testValidate(executor_cache.fusion(), outputs, args, __LINE__, __FILE__);
+    FusionKernelRuntime* runtime = executor_cache.getMostRecentKernelRuntime();
+    EXPECT_THAT(
+        runtime->fusionSegments()->groups(), SizeIs(horizontal_fusion ? 2 : 3));
+  }
+}
+
+TEST_F(SegmentationTest, PredictCost) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* in = makeContigTensor(2);
+  TensorView* out = add(in, IrBuilder::create<Val>(1.0));
+  fusion.addInput(in);
+  fusion.addOutput(out);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor in_tensor = at::randn({1024, 1024}, options);
+
+  SchedulerRuntimeInfo runtime_info(&fusion, {in_tensor});
+  auto scheduler =
+      SchedulerEntry::makeSchedulerInstance(SchedulerType::PointWise);
+  auto params = scheduler->computeHeuristics(&fusion, runtime_info);
+  cost_model::KernelCost cost =
+      scheduler->predictCost(&fusion, runtime_info, params.get());
+  EXPECT_EQ(cost.bytes, 2 * 1024 * 1024 * 4);
+  EXPECT_EQ(cost.flops, 1024 * 1024);
+  EXPECT_FALSE(cost.spills);
+  EXPECT_GT(cost.occupancy, 0.0);
+  EXPECT_GT(cost.time_us, 0.0);
+}
+
+// Kernels that can't vectorize their accesses are predicted to be slower
+TEST_F(SegmentationTest, PredictCostOfUnvectorizedKernel) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* in = makeContigTensor(2);
+  TensorView* out = add(in, IrBuilder::create<Val>(1.0));
+  fusion.addInput(in);
+  fusion.addOutput(out);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto scheduler =
+      SchedulerEntry::makeSchedulerInstance(SchedulerType::PointWise);
+  std::vector<cost_model::KernelCost> costs;
+  // An odd inner extent prevents vectorization
+  for (int64_t inner : {1024, 1023}) {
+    at::Tensor in_tensor = at::randn({1024, inner}, options);
+    SchedulerRuntimeInfo runtime_info(&fusion, {in_tensor});
+    auto params = scheduler->computeHeuristics(&fusion, runtime_info);
+    costs.push_back(
+        scheduler->predictCost(&fusion, runtime_info, params.get()));
+  }
+  EXPECT_EQ(costs.at(0).access_bytes, 16);
+  EXPECT_EQ(costs.at(1).access_bytes, 4);
+  EXPECT_GT(costs.at(1).time_us, costs.at(0).time_us);
+}
+
+TEST_F(SegmentationTest, CostModel) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::CostModel);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* in = makeContigTensor(2);
+  fusion->addInput(in);
+  TensorView* max_val = max(in, {1});
+  TensorView* exp_val = exp(sub(in, broadcast(max_val, {false, true})));
+  TensorView* sum_val = sum(exp_val, {1});
+  TensorView* out = div(exp_val, broadcast(sum_val, {false, true}));
+  fusion->addOutput(out);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor in_tensor = at::randn({128, 4096}, options);
+
+  FusionExecutorCache executor_cache(std::move(fusion));
+  auto outputs = executor_cache.runFusionWithInputs({in_tensor});
+  testValidate(
+      executor_cache.fusion(), outputs, {in_tensor}, __LINE__, __FILE__);
+}
+
 } // namespace nvfuser
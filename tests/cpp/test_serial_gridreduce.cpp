@@ -142,4 +142,62 @@ TEST_F(SerialGridReductionTest, Scheduling) {
   }
 }
 
+// Split the serialized blocks of each reduction segment into chains. The
+// number of blocks is not divisible by the number of chains, so the last chain
+// is shorter than the others.
+TEST_F(SerialGridReductionTest, Chains) {
+  std::unique_ptr<Fusion> fusion_ptr = std::make_unique<Fusion>();
+  auto fusion = fusion_ptr.get();
+  FusionGuard fg(fusion);
+
+  int64_t blocks_x = 8;
+  int64_t blocks_z = 7;
+  int64_t num_chains = 3;
+  int64_t H = blocks_z;
+  int64_t W = blocks_x * 128;
+
+  TensorView* tv0 = TensorViewBuilder()
+                        .shape({H, W})
+                        .dtype(DataType::Float)
+                        .contiguity(true)
+                        .build();
+  fusion->addInput(tv0);
+
+  auto tv1 = sum(tv0, {0});
+  fusion->addOutput(tv1);
+
+  // [ iBIDx{blocks_x}, iTIDx{128}, rBIDz{blocks_z} ]
+  auto tv2 = tv1->cacheBefore();
+  tv2->reorder({{1, 0}, {0, 1}});
+  tv2->split(0, 128);
+  tv2->axis(0)->parallelize(ParallelType::BIDx);
+  tv2->axis(1)->parallelize(ParallelType::TIDx);
+  tv2->axis(2)->parallelize(ParallelType::BIDz);
+
+  TransformPropagator propagator(tv2);
+  MaxLogicalDomainInfoSpanningTree(tv2).traverse(&propagator);
+  scheduler_utils::parallelizeAllLike(tv2);
+  inlineMost();
+
+  auto rop = tv2->definition()->as<ReductionOp>();
+  rop->requestSerialGridReduction();
+  rop->setSerialGridReductionChains(num_chains);
+
+  KernelExecutor ke;
+  ke.compile(fusion);
+  EXPECT_THAT(
+      ke.compiledKernel()->kernelString(),
+      testing::HasSubstr("grid_sync::blockSerializeWaitChained"));
+
+  auto input = at::randn(
+      {H, W}, at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0));
+  auto outputs = ke.run({input});
+  testValidate(fusion, outputs, {input}, __LINE__, __FILE__);
+
+  // The chains are combined in a fixed order
+  auto outputs2 = ke.run({input});
+  EXPECT_TRUE(
+      at::equal(outputs[0].as<at::Tensor>(), outputs2[0].as<at::Tensor>()));
+}
+
 } // namespace nvfuser
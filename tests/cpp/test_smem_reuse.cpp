@@ -217,6 +217,42 @@ TEST_F(SmemReuseTest, NeedsReorderedPush) {
   }
 }
 
+// Same as NeedsReorderedPush but with interval packing enabled, which must
+// never use more memory than the stack-based allocation
+TEST_F(SmemReuseTest, PackSharedMemory) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  int64_t H = 5;
+  auto [tv0, tv3] = needsReorderedPushDefinition(H);
+
+  auto get_smem_usage = [&fusion]() {
+    GpuLower gpulw(fusion.get());
+    ExpressionEvaluator ee;
+    int64_t smem_usage = 0;
+    for (auto alloc : gpulw.run()->summary().dynamic_smem_allocations) {
+      EXPECT_NE(alloc->address(), nullptr);
+      auto addr = ee.evaluate(alloc->address()).as<int64_t>();
+      EXPECT_EQ(addr % 16, 0);
+      auto size = ee.evaluate(alloc->size()).as<int64_t>() *
+          dataTypeSizeByte(alloc->buffer()->dtype());
+      smem_usage = std::max(smem_usage, addr + size);
+    }
+    return smem_usage;
+  };
+
+  for (bool sync : {false, true}) {
+    if (sync) {
+      tv3->axis(0)->parallelize(ParallelType::TIDx);
+    }
+    const int64_t stack_usage = get_smem_usage();
+
+    EnableOptionsGuard enable_options_guard;
+    EnableOptionsGuard::getCurOptions().set(EnableOption::PackSharedMemory);
+    EXPECT_LE(get_smem_usage(), stack_usage);
+  }
+}
+
 // Same as NeedsReorderedPush but C requests to reuse A instead of pre-existing
 // sync
 TEST_F(SmemReuseTest, PromoteReuse) {
@@ -630,6 +666,53 @@ TEST_F(SmemReuseTest, RegisterReuseWithDifferentVectorizationFactor) {
   }
 }
 
+// A bf16 register buffer can reuse the registers of an fp32 buffer with the
+// same number of elements once the fp32 buffer is no longer live
+TEST_F(SmemReuseTest, RegisterReuseWithSmallerDtype) {
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  constexpr int64_t n_element = 16;
+  auto tv0 = makeContigConcreteTensor({n_element});
+  fusion->addInput(tv0);
+
+  auto tv1 = set(tv0);
+  auto tv2 = exp(tv1);
+  auto tv3 = castOp(DataType::BFloat16, tv2);
+  auto tv4 = neg(tv3);
+  auto tv5 = neg(tv4);
+  auto tv6 = castOp(DataType::Float, tv5);
+  fusion->addOutput(tv6);
+
+  auto aliases_float_buffer = [&fusion](bool reuse_mismatched_types) {
+    DisableOptionsGuard disable_options_guard;
+    if (!reuse_mismatched_types) {
+      DisableOptionsGuard::getCurOptions().set(
+          DisableOption::ReuseMismatchedTypeRegisters);
+    }
+    GpuLower gpulw(fusion.get());
+    for (auto expr : gpulw.run()->topLevelExprs()) {
+      auto alloc = dynamic_cast<kir::Allocate*>(expr);
+      if (alloc != nullptr && alloc->alias() != nullptr &&
+          alloc->buffer()->dtype() == DataType::BFloat16 &&
+          alloc->alias()->buffer()->dtype() == DataType::Float) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  EXPECT_TRUE(aliases_float_buffer(true));
+  EXPECT_FALSE(aliases_float_buffer(false));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  auto t0 = at::randn({n_element}, options);
+  KernelExecutor ke;
+  ke.compile(fusion.get());
+  auto cg_outputs = ke.run({t0});
+  testValidate(fusion.get(), cg_outputs, {t0}, __LINE__, __FILE__);
+}
+
 TEST_F(SmemReuseTest, ExpandInterferes) {
   auto testExpand = [](bool is_concrete) {
     auto fusion = std::make_unique<Fusion>();
@@ -5,12 +5,15 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 // clang-format on
+#include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
 #include <limits>
 
 #include <fusion.h>
 #include <ops/arith.h>
+#include <options.h>
+#include <runtime/executor.h>
 #include <runtime/fusion_executor_cache.h>
 #include <tests/cpp/utils.h>
 #include <tests/cpp/validator.h>
@@ -71,6 +74,37 @@ TEST_P(UnaryTest, Neg) {
       __FILE__);
 }
 
+using FastMathTest = NVFuserTest;
+
+TEST_F(FastMathTest, Transcendentals) {
+  EnableOptionsGuard enable_options_guard;
+  EnableOptionsGuard::getCurOptions().set(EnableOption::FastMath);
+
+  auto fusion = std::make_unique<Fusion>();
+  FusionGuard fg(fusion.get());
+
+  TensorView* in = makeContigTensor(2);
+  fusion->addInput(in);
+  fusion->addOutput(tanh(in));
+  fusion->addOutput(exp(in));
+  fusion->addOutput(sigmoid(in));
+  // Doubles are never approximated.
+  fusion->addOutput(tanh(castOp(DataType::Double, in)));
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  at::Tensor in_tensor = at::randn({32, 64}, options);
+  KernelExecutor ke;
+  ke.compile(fusion.get(), {in_tensor});
+  const std::string& kernel = ke.compiledKernel()->kernelString();
+  EXPECT_THAT(kernel, testing::HasSubstr("fast_tanh("));
+  EXPECT_THAT(kernel, testing::HasSubstr("fast_exp("));
+  EXPECT_THAT(kernel, testing::HasSubstr("fast_sigmoid("));
+  EXPECT_THAT(kernel, testing::HasSubstr(" tanh("));
+
+  auto out_tensors = ke.run({in_tensor});
+  testValidate(fusion.get(), out_tensors, {in_tensor}, __LINE__, __FILE__);
+}
+
 namespace {
 
 std::string sanitizeTestName(std::string&& name) {
@@ -11,12 +11,14 @@ using nvfuser_index_t = int64_t;
 
 #include <tests/cpp/topk_test_helper.h>
 
-// Need to be included before argsort because of the dependency
-// from argsort
+// Need to be included before topk because of the dependency
+// from topk
 namespace nvf {
 #include <runtime/index_utils.cu>
 } // namespace nvf
 
+#include <runtime/sort_utils.cu>
+
 #include <runtime/topk.cu>
 
 // Standard C++ headers
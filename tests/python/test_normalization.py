@@ -199,3 +199,32 @@ def test_issue2702():
     outs = fd.execute(ins)
 
     torch.testing.assert_close(outs[0], ins[0].view(8, 4, 8192, 128).sum(1))
+
+
+def test_ragged_rows():
+    from nvfuser.contrib import (
+        RaggedTensor,
+        ragged_apply,
+        ragged_layer_norm,
+        ragged_softmax,
+    )
+
+    rows = [torch.randn(n, device="cuda") for n in [5, 1, 300, 0, 64]]
+    x = RaggedTensor.from_tensors(rows)
+
+    (scaled,) = ragged_apply(
+        lambda fd, values, scalars: [fd.ops.mul(values[0], scalars[0])], [x], [2.0]
+    )
+    torch.testing.assert_close(scaled.values, x.values * 2.0)
+
+    softmax = ragged_softmax(x)
+    torch.testing.assert_close(
+        softmax.values, torch.cat([torch.softmax(r, dim=0) for r in rows])
+    )
+
+    layer_norm = ragged_layer_norm(x, eps=1e-5)
+    assert layer_norm.offsets is x.offsets
+    torch.testing.assert_close(
+        layer_norm.values,
+        torch.cat([nn.functional.layer_norm(r, r.shape, eps=1e-5) for r in rows]),
+    )
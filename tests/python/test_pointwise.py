@@ -425,3 +425,38 @@ def test_single_segment_multi_device():
         RuntimeError, match="KernelExecutor does not support the Fusion provided."
     ):
         _ = fd.execute(inputs)
+
+
+# An SGD step with momentum over parameters of different sizes, in place
+def test_multi_tensor_apply():
+    from nvfuser.contrib import multi_tensor_apply
+
+    shapes = [(1000,), (33, 17), (8, 4, 5), (1,), (4096,)]
+    params = [torch.randn(s, device="cuda") for s in shapes]
+    grads = [torch.randn(s, device="cuda") for s in shapes]
+    momenta = [torch.randn(s, device="cuda") for s in shapes]
+    lr, momentum = 0.1, 0.9
+
+    ref_momenta = [m * momentum + g for m, g in zip(momenta, grads)]
+    ref_params = [p - lr * m for p, m in zip(params, ref_momenta)]
+
+    def sgd(fd: FusionDefinition, tensors, scalars):
+        p, g, m = tensors
+        lr, momentum = scalars
+        m = fd.ops.add(fd.ops.mul(m, momentum), g)
+        p = fd.ops.sub(p, fd.ops.mul(m, lr))
+        return [p, m]
+
+    outs = multi_tensor_apply(
+        sgd,
+        [params, grads, momenta],
+        [lr, momentum],
+        alias_outputs=[0, 2],
+        max_tensors_per_kernel=3,
+    )
+    assert all(o is p for o, p in zip(outs[0], params))
+    assert all(o is m for o, m in zip(outs[1], momenta))
+    for p, ref in zip(params, ref_params):
+        torch.testing.assert_close(p, ref)
+    for m, ref in zip(momenta, ref_momenta):
+        torch.testing.assert_close(m, ref)
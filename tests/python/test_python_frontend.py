@@ -7,9 +7,11 @@ from functools import partial
 import itertools
 import io
 import math
+import os
 import re
 import random
 import sys
+import tempfile
 from typing import List
 
 import torch
@@ -25,6 +27,7 @@ from nvfuser import (
     version,
     compute_contiguity,
     compute_tensor_descriptor,
+    serialize_bundle,
 )
 from nvfuser.pytorch_utils import torch_dtype_to_nvfuser_dtype
 
@@ -503,6 +506,88 @@ class TestNvFuserFrontend(NVFuserTest):
         )
         self.assertEqual(eager_out, nvf_out[0])
 
+    def test_compile(self):
+        inputs = [torch.randn(4, 8, device="cuda"), 2.0]
+
+        with FusionDefinition() as fd:
+            t0 = fd.from_pytorch(inputs[0])
+            s0 = fd.define_scalar(dtype=DataType.Double)
+            t1 = fd.ops.mul(t0, s0)
+            fd.add_output(fd.ops.sum(t1, dims=[1]))
+
+        compiled = fd.compile()
+        self.assertEqual(compiled.num_args, 2)
+        (nvf_out,) = compiled(*inputs)
+        self.assertEqual(nvf_out, torch.sum(inputs[0] * 2.0, dim=1))
+
+        # The sizes and scalars can change between calls
+        t0 = torch.randn(3, 5, device="cuda")
+        (nvf_out,) = compiled(t0, 3.0)
+        self.assertEqual(nvf_out, torch.sum(t0 * 3.0, dim=1))
+
+        with self.assertRaisesRegex(RuntimeError, "Expected 2 arguments"):
+            compiled(t0)
+
+    def test_execute_out(self):
+        inputs = [torch.randn(4, 8, device="cuda")]
+
+        with FusionDefinition() as fd:
+            t0 = fd.from_pytorch(inputs[0])
+            t1 = fd.ops.exp(t0)
+            # The sum is in a different segment than the exp
+            t2 = fd.ops.sum(fd.ops.segment_set(t1), dims=[1])
+            fd.add_output(t1)
+            fd.add_output(t2)
+            fd.add_output(fd.ops.reshape(t0, [32]))
+
+        # Slices of a larger buffer, like the slots of a KV cache
+        buffer = torch.empty(2, 4, 8, device="cuda")
+        out = [
+            buffer[1],
+            torch.empty(4, device="cuda"),
+            torch.empty(32, device="cuda"),
+        ]
+        nvf_out = fd.execute(inputs, out=out)
+        for nvf_t, out_t in zip(nvf_out, out):
+            self.assertEqual(nvf_t.data_ptr(), out_t.data_ptr())
+        self.assertEqual(buffer[1], torch.exp(inputs[0]))
+        self.assertEqual(out[1], torch.sum(torch.exp(inputs[0]), dim=1))
+        self.assertEqual(out[2], inputs[0].reshape(32))
+
+        out[0] = torch.empty(8, 4, device="cuda").t()
+        with self.assertRaisesRegex(RuntimeError, "has sizes"):
+            fd.execute(inputs, out=out)
+        with self.assertRaisesRegex(RuntimeError, "must be given a tensor"):
+            fd.execute(inputs, out=[out[0], out[1].half(), out[2]])
+        with self.assertRaisesRegex(RuntimeError, "for each output"):
+            fd.execute(inputs, out=out[:2])
+
+    def test_execute_is_stream_ordered(self):
+        inputs = [
+            torch.randn(64, 64, device="cuda"),
+            torch.randn(64, 64, device="cuda"),
+        ]
+
+        with FusionDefinition() as fd:
+            t0 = fd.from_pytorch(inputs[0])
+            t1 = fd.from_pytorch(inputs[1])
+            # The matmul is evaluated with ATen and the rest by a kernel
+            t2 = fd.ops.matmul(t0, t1)
+            fd.add_output(fd.ops.relu(fd.ops.add(t2, t0)))
+
+        fd.execute(inputs)
+        torch.cuda.synchronize()
+
+        stream = torch.cuda.Stream()
+        with torch.cuda.stream(stream):
+            # Anything waiting for the stream would wait for the sleep
+            torch.cuda._sleep(1 << 30)
+            (nvf_out,) = fd.execute(inputs)
+            self.assertFalse(stream.query())
+        self.assertTrue(torch.cuda.current_stream().query())
+        stream.synchronize()
+        self.assertEqual(nvf_out, torch.relu(inputs[0] @ inputs[1] + inputs[0]))
+
     # Testing a scenario where a broadcast requires a symbolic output shape
     def test_tensor_shape(self):
         inputs = [
@@ -4971,6 +5056,32 @@ fd.execute(inputs)
         self.assertEqual(nvf_out[0], inputs[0])
         self.assertEqual(nvf_out[0], ref_inp.relu())
 
+    def test_serialize_bundle(self):
+        inputs = [torch.randn(4, 4, device="cuda")]
+
+        def fusion_func(fd: FusionDefinition) -> None:
+            t0 = fd.from_pytorch(inputs[0])
+            t1 = fd.ops.relu(t0)
+            fd.add_output(t1)
+
+        with FusionDefinition() as fd:
+            fusion_func(fd)
+        fd.execute(inputs)
+
+        with tempfile.TemporaryDirectory() as bundle_dir:
+            serialize_bundle(bundle_dir)
+            bundle_files = os.listdir(bundle_dir)
+            assert len(bundle_files) == 1
+            assert bundle_files[0].startswith("nvf_serde")
+
+            FusionCache.reset()
+            FusionCache.get().deserialize(os.path.join(bundle_dir, bundle_files[0]))
+
+        with FusionDefinition() as fd:
+            fusion_func(fd)
+        nvf_out = fd.execute(inputs)
+        self.assertEqual(nvf_out[0], inputs[0].relu())
+
     def test_import_conflict_nvfuser_then_direct(self):
         try:
             import nvfuser  # noqa: F401
@@ -0,0 +1,61 @@
+# SPDX-FileCopyrightText: Copyright (c) 2025-present NVIDIA CORPORATION & AFFILIATES.
+# All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# "build_fusion_cache_bundle.py -h" for help.
+#
+# Builds an ahead-of-time compiled FusionCache bundle from repro scripts, e.g.,
+# those printed by FusionDefinition.repro_script_for. Each script defines a
+# fusion and executes it with representative inputs, so every input shape
+# class to be served should be executed by at least one script. The compiled
+# kernels are then serialized to the bundle directory in a file named after
+# the device architecture and the CUDA version. Run this tool on each target
+# GPU architecture with the same output directory to build a multi-arch
+# bundle, and point NVFUSER_FUSION_CACHE_BUNDLE at that directory to load it.
+
+import argparse
+import runpy
+
+import nvfuser
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Build an ahead-of-time compiled FusionCache bundle."
+    )
+    parser.add_argument(
+        "scripts",
+        nargs="+",
+        help="Python scripts defining and executing fusions",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        required=True,
+        help="Bundle directory",
+    )
+    parser.add_argument(
+        "--device",
+        type=int,
+        default=None,
+        help="Device whose FusionCache is serialized",
+    )
+    args = parser.parse_args()
+
+    # Start from an empty cache so that only the given fusions are bundled.
+    nvfuser.FusionCache.get(
+        selected_device=args.device, load_from_default_workspace=False
+    )
+
+    for script in args.scripts:
+        print(f"Compiling {script}")
+        runpy.run_path(script, run_name="__main__")
+
+    nvfuser.serialize_bundle(args.output)
+    print(
+        f"Wrote {nvfuser.FusionCache.get().num_fusions()} fusions to {args.output}"
+    )
+
+
+if __name__ == "__main__":
+    main()
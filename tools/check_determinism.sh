@@ -4,17 +4,29 @@ set -e
 set -o pipefail
 
 usage() {
-  echo "Usage: $0 [-h] [-n NUMREPS=10] -- command to run]"
+  echo "Usage: $0 [-h] [-b] [-n NUMREPS=10] -- command to run]"
+  echo ""
+  echo "By default, checks that the command generates the same kernels in each"
+  echo "of NUMREPS repetitions."
+  echo ""
+  echo "With -b, instead runs the command NUMREPS times with and NUMREPS times"
+  echo "without NVFUSER_ENABLE=deterministic and reports the total kernel time"
+  echo "of each scheduler in both modes."
 }
 
+NUMREPS=10
+BENCHMARK=0
 
-while getopts "n:h" arg
+while getopts "n:bh" arg
 do
   case $arg in
     n)
       NUMREPS=$OPTARG
       shift
       ;;
+    b)
+      BENCHMARK=1
+      ;;
     h | ?)
       usage
       exit 1
@@ -33,6 +45,71 @@ do
 done
 CMD=$*
 
+# Prints "scheduler total_kernel_time_ms" for each scheduler from the
+# NVFUSER_PROF=print.verbose tables in the given log. Columns are located by
+# the positions of their headers.
+sum_kernel_times() {
+  awk '
+    index($0, "S-Sched") && index($0, "S-KerTm(ms)") {
+      sched_col = index($0, "S-Sched")
+      time_col = index($0, "S-KerTm(ms)")
+      next
+    }
+    sched_col > 0 && length($0) >= sched_col {
+      sched = substr($0, sched_col, 15)
+      gsub(/ /, "", sched)
+      time = substr($0, time_col, 11)
+      gsub(/ /, "", time)
+      if (sched != "" && time ~ /^[0-9.]+$/) {
+        total[sched] += time
+      }
+    }
+    END {
+      for (sched in total) {
+        printf "%s %.3f\n", sched, total[sched]
+      }
+    }
+  ' "$1"
+}
+
+if [[ $BENCHMARK -ne 0 ]]
+then
+  LOGDIR=$(mktemp -d)
+  trap 'rm -rf "$LOGDIR"' EXIT
+  for mode in default deterministic
+  do
+    for _ in $(seq 1 "$NUMREPS")
+    do
+      if [[ $mode == deterministic ]]
+      then
+        ENABLE="${NVFUSER_ENABLE:+$NVFUSER_ENABLE,}deterministic"
+      else
+        ENABLE="${NVFUSER_ENABLE:-}"
+      fi
+      # $CMD does not need to succeed for us to analyze it
+      set +e
+      NVFUSER_ENABLE="$ENABLE" NVFUSER_PROF=print.verbose $CMD \
+        >> "$LOGDIR/$mode.log" 2>&1
+      set -e
+    done
+    sum_kernel_times "$LOGDIR/$mode.log" | sort > "$LOGDIR/$mode.txt"
+  done
+  echo "Total kernel time over $NUMREPS repetitions"
+  join -a 1 -a 2 -e 0 -o 0,1.2,2.2 \
+    "$LOGDIR/default.txt" "$LOGDIR/deterministic.txt" |
+    awk '
+      BEGIN {
+        printf "%-16s %14s %18s %10s\n", "Scheduler", "Default(ms)",
+          "Deterministic(ms)", "Overhead"
+      }
+      {
+        overhead = $2 > 0 ? sprintf("%.1f%%", ($3 / $2 - 1) * 100) : "n/a"
+        printf "%-16s %14.3f %18.3f %10s\n", $1, $2, $3, overhead
+      }
+    '
+  exit 0
+fi
+
 export NVFUSER_DUMP=cuda_to_file
 
 KERNELDIR=$(mktemp -d)